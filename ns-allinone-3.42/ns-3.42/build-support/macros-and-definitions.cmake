@@ -846,6 +846,12 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_MTP FALSE)
+  if(${NS3_MTP})
+    add_definitions(-DNS3_MTP)
+    set(ENABLE_MTP TRUE)
+  endif()
+
   mark_as_advanced(Boost_INCLUDE_DIR)
   find_package(Boost)
   if(${Boost_FOUND})
@@ -1129,6 +1135,12 @@ macro(process_options)
   check_include_file("netpacket/packet.h" "HAVE_PACKETH")
   check_function_exists("getenv" "HAVE_GETENV")
 
+  # Trace sources never invoke their sinks
+  set(NS3_TRACING_DISABLE FALSE)
+  if(NOT ${NS3_TRACING})
+    set(NS3_TRACING_DISABLE TRUE)
+  endif()
+
   configure_file(
     build-support/core-config-template.h
     ${CMAKE_HEADER_OUTPUT_DIRECTORY}/core-config.h
@@ -1139,6 +1151,18 @@ macro(process_options)
   if(${NS3_LOG} OR (${build_profile} STREQUAL "debug"))
     add_definitions(-DNS3_LOG_ENABLE)
   endif()
+  # Compile out the log statements above the requested level
+  string(TOUPPER "${NS3_LOG_LEVEL}" log_level)
+  set(log_levels ERROR WARN INFO FUNCTION LOGIC DEBUG ALL)
+  if(NOT (log_level IN_LIST log_levels))
+    message(
+      FATAL_ERROR
+        "NS3_LOG_LEVEL must be one of ${log_levels}, not ${NS3_LOG_LEVEL}"
+    )
+  endif()
+  if(NOT (${log_level} STREQUAL "ALL"))
+    add_definitions(-DNS3_LOG_COMPILED_MASK=ns3::LOG_LEVEL_${log_level})
+  endif()
   # Force enable ns-3 asserts in debug builds and if requested for other build
   # types
   if(${NS3_ASSERT} OR (${build_profile} STREQUAL "debug"))
@@ -1174,6 +1198,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${ENABLE_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
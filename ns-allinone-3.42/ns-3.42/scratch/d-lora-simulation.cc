@@ -8,6 +8,7 @@
 #include "ns3/applications-module.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/config-store-module.h"
+#include "ns3/results-table.h"
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -29,9 +30,26 @@ uint32_t g_rssiMeasurements = 0;
 uint32_t g_snrMeasurements = 0;
 uint32_t g_collisions = 0;
 
-// Output files
-std::ofstream g_intervalFile;
-std::ofstream g_detailsFile;
+// Reset the network-wide counters before each replication
+void
+ResetGlobalCounters ()
+{
+    g_totalPacketsSent = 0;
+    g_totalPacketsReceived = 0;
+    g_totalEnergyConsumed = 0;
+    g_totalDataReceived = 0;
+    g_totalTimeOnAir = 0;
+    g_totalRSSI = 0;
+    g_totalSNR = 0;
+    g_rssiMeasurements = 0;
+    g_snrMeasurements = 0;
+    g_collisions = 0;
+}
+
+// Output tables, written in batches by ResultsTable (details only with enableDetailedLog)
+Ptr<ResultsTable> g_intervalTable;
+Ptr<ResultsTable> g_detailsTable;
+uint32_t g_replication = 0; // Replication being run, first column of the detailed logs
 
 // LoRaWAN parameters from the paper
 const double LPL_D0 = 128.95; // dB
@@ -47,25 +65,47 @@ std::vector<double> BW_SET = {125e3, 250e3, 500e3}; // in Hz
 std::vector<double> CF_SET = {470.1e6, 470.3e6, 470.5e6, 470.7e6, 470.9e6, 471.1e6, 471.3e6, 471.5e6}; // in Hz
 std::vector<double> TP_SET = {2, 4, 6, 8, 10, 12, 14}; // in dBm
 
-// Receiver Sensitivities (TABLE I from paper)
-std::map<int, std::map<double, double>> RS_TABLE = {
-    {7, {{125e3, -123}, {250e3, -120}, {500e3, -116}}},
-    {8, {{125e3, -126}, {250e3, -123}, {500e3, -119}}},
-    {9, {{125e3, -129}, {250e3, -125}, {500e3, -122}}},
-    {10, {{125e3, -132}, {250e3, -128}, {500e3, -125}}},
-    {11, {{125e3, -133}, {250e3, -130}, {500e3, -128}}},
-    {12, {{125e3, -136}, {250e3, -133}, {500e3, -130}}}
+// The sensitivity tables are flat arrays: rows are the spreading factors 7..12
+// (independent of SF_SET, which may be restricted on the command line) and
+// columns follow BW_SET
+const int MIN_SF = 7;
+const int MAX_SF = 12;
+const uint32_t NUM_SF = MAX_SF - MIN_SF + 1;
+const uint32_t NUM_BW = 3;
+
+// Receiver Sensitivities (TABLE I from paper), in dBm
+const double RS_TABLE[NUM_SF][NUM_BW] = {
+    {-123, -120, -116}, // SF7:  125, 250, 500 kHz
+    {-126, -123, -119}, // SF8
+    {-129, -125, -122}, // SF9
+    {-132, -128, -125}, // SF10
+    {-133, -130, -128}, // SF11
+    {-136, -133, -130}  // SF12
 };
 
-// SINR Thresholds (TABLE II from paper)
-std::map<int, double> SINR_REQ_TABLE = {
-    {7, -7.5},
-    {8, -10.0},
-    {9, -12.5},
-    {10, -15.0},
-    {11, -17.5},
-    {12, -20.0}
-};
+// SINR Thresholds (TABLE II from paper), in dB
+const double SINR_REQ_TABLE[NUM_SF] = {-7.5, -10.0, -12.5, -15.0, -17.5, -20.0};
+
+// Dense index of a spreading factor in the tables above
+inline uint32_t SfIndex (int sf)
+{
+    NS_ASSERT_MSG (sf >= MIN_SF && sf <= MAX_SF, "Unsupported spreading factor " << sf);
+    return sf - MIN_SF;
+}
+
+// Dense index of a bandwidth in BW_SET
+inline uint32_t BwIndex (double bw)
+{
+    for (uint32_t i = 0; i < NUM_BW; i++)
+    {
+        if (BW_SET[i] == bw)
+        {
+            return i;
+        }
+    }
+    NS_FATAL_ERROR ("Unsupported bandwidth " << bw);
+    return 0;
+}
 
 // Packet size
 const uint32_t PAYLOAD_SIZE = 20; // bytes
@@ -231,29 +271,12 @@ public:
     }
 
     DLoRaAgent ()
-        : m_rng (CreateObject<UniformRandomVariable> ())
+        : m_rng (CreateObject<UniformRandomVariable> ()),
+          m_armsSF (SF_SET.size ()),
+          m_armsBW (BW_SET.size ()),
+          m_armsCF (CF_SET.size ()),
+          m_armsTP (TP_SET.size ())
     {
-        // Initialize expected rewards and number of selections for each base arm
-        for (int sf : SF_SET)
-        {
-            m_expectedRewardsSF[sf] = 0.0;
-            m_numSelectionsSF[sf] = 0;
-        }
-        for (double bw : BW_SET)
-        {
-            m_expectedRewardsBW[bw] = 0.0;
-            m_numSelectionsBW[bw] = 0;
-        }
-        for (double cf : CF_SET)
-        {
-            m_expectedRewardsCF[cf] = 0.0;
-            m_numSelectionsCF[cf] = 0;
-        }
-        for (double tp : TP_SET)
-        {
-            m_expectedRewardsTP[tp] = 0.0;
-            m_numSelectionsTP[tp] = 0;
-        }
     }
 
     void SetNodeAndGateway (Ptr<Node> node, Ptr<Node> gateway)
@@ -264,12 +287,13 @@ public:
 
     std::tuple<int, double, double, double> SelectParameters ()
     {
-        int selectedSF = SelectArm (m_expectedRewardsSF, m_numSelectionsSF, SF_SET);
-        double selectedBW = SelectArm (m_expectedRewardsBW, m_numSelectionsBW, BW_SET);
-        double selectedCF = SelectArm (m_expectedRewardsCF, m_numSelectionsCF, CF_SET);
-        double selectedTP = SelectArm (m_expectedRewardsTP, m_numSelectionsTP, TP_SET);
+        // Keep the selected indices, the rewards of this uplink update the same arms
+        m_selectedSF = SelectArm (m_armsSF);
+        m_selectedBW = SelectArm (m_armsBW);
+        m_selectedCF = SelectArm (m_armsCF);
+        m_selectedTP = SelectArm (m_armsTP);
 
-        return std::make_tuple (selectedSF, selectedBW, selectedCF, selectedTP);
+        return std::make_tuple (SF_SET[m_selectedSF], BW_SET[m_selectedBW], CF_SET[m_selectedCF], TP_SET[m_selectedTP]);
     }
 
     void UpdateRewards (int sf, double bw, double cf, double tp, bool success, double dataRate, double energyConsumption)
@@ -280,10 +304,13 @@ public:
         double rewardCF = CalculateRewardCF (cf, success);
         double rewardTP = CalculateRewardTP (tp, success);
 
-        UpdateArm (m_expectedRewardsSF, m_numSelectionsSF, sf, rewardSF);
-        UpdateArm (m_expectedRewardsBW, m_numSelectionsBW, bw, rewardBW);
-        UpdateArm (m_expectedRewardsCF, m_numSelectionsCF, cf, rewardCF);
-        UpdateArm (m_expectedRewardsTP, m_numSelectionsTP, tp, rewardTP);
+        NS_ASSERT_MSG (SF_SET[m_selectedSF] == sf && BW_SET[m_selectedBW] == bw
+                       && CF_SET[m_selectedCF] == cf && TP_SET[m_selectedTP] == tp,
+                       "Rewards do not match the last selected parameters");
+        UpdateArm (m_armsSF, m_selectedSF, rewardSF);
+        UpdateArm (m_armsBW, m_selectedBW, rewardBW);
+        UpdateArm (m_armsCF, m_selectedCF, rewardCF);
+        UpdateArm (m_armsTP, m_selectedTP, rewardTP);
     }
 
 private:
@@ -291,38 +318,47 @@ private:
     Ptr<Node> m_gateway;
     Ptr<UniformRandomVariable> m_rng;
 
-    std::map<int, double> m_expectedRewardsSF;
-    std::map<int, uint32_t> m_numSelectionsSF;
-    std::map<double, double> m_expectedRewardsBW;
-    std::map<double, uint32_t> m_numSelectionsBW;
-    std::map<double, double> m_expectedRewardsCF;
-    std::map<double, uint32_t> m_numSelectionsCF;
-    std::map<double, double> m_expectedRewardsTP;
-    std::map<double, uint32_t> m_numSelectionsTP;
-
-    template <typename T>
-    T SelectArm (std::map<T, double>& expectedRewards, std::map<T, uint32_t>& numSelections, const std::vector<T>& armSet)
+    // UCB state of a base arm set, indexed like the corresponding *_SET vector
+    struct ArmSet
     {
-        double maxUCB = -1.0;
-        T selectedArm = armSet[0];
-
-        uint32_t totalSelections = 0;
-        for (auto const& [key, val] : numSelections)
+        explicit ArmSet (std::size_t size)
+            : expectedRewards (size, 0.0),
+              numSelections (size, 0),
+              totalSelections (0)
         {
-            totalSelections += val;
         }
 
-        for (T arm : armSet)
+        std::vector<double> expectedRewards;
+        std::vector<uint32_t> numSelections;
+        uint32_t totalSelections;
+    };
+
+    ArmSet m_armsSF;
+    ArmSet m_armsBW;
+    ArmSet m_armsCF;
+    ArmSet m_armsTP;
+    uint32_t m_selectedSF = 0;
+    uint32_t m_selectedBW = 0;
+    uint32_t m_selectedCF = 0;
+    uint32_t m_selectedTP = 0;
+
+    uint32_t SelectArm (const ArmSet& arms)
+    {
+        double maxUCB = -1.0;
+        uint32_t selectedArm = 0;
+        double logTotal = std::log (arms.totalSelections + 1);
+
+        for (uint32_t arm = 0; arm < arms.numSelections.size (); arm++)
         {
             double ucbValue;
-            if (numSelections[arm] == 0)
+            if (arms.numSelections[arm] == 0)
             {
                 ucbValue = std::numeric_limits<double>::max();
             }
             else
             {
-                ucbValue = expectedRewards[arm] + 
-                          C_WEIGHT_FACTOR * std::sqrt (std::log (totalSelections + 1) / (2.0 * numSelections[arm]));
+                ucbValue = arms.expectedRewards[arm] + 
+                          C_WEIGHT_FACTOR * std::sqrt (logTotal / (2.0 * arms.numSelections[arm]));
             }
 
             if (ucbValue > maxUCB)
@@ -334,11 +370,11 @@ private:
         return selectedArm;
     }
 
-    template <typename T>
-    void UpdateArm (std::map<T, double>& expectedRewards, std::map<T, uint32_t>& numSelections, T arm, double reward)
+    void UpdateArm (ArmSet& arms, uint32_t arm, double reward)
     {
-        numSelections[arm]++;
-        expectedRewards[arm] = expectedRewards[arm] + (reward - expectedRewards[arm]) / numSelections[arm];
+        arms.numSelections[arm]++;
+        arms.totalSelections++;
+        arms.expectedRewards[arm] = arms.expectedRewards[arm] + (reward - arms.expectedRewards[arm]) / arms.numSelections[arm];
     }
 
     // Reward functions based on D-LoRa variants (equations 20-23 from paper)
@@ -702,9 +738,10 @@ public:
             m_fixedInterval = m_expRandomVariable->GetValue ();
             m_intervalSet = true;
             
-            if (g_intervalFile.is_open())
+            if (g_intervalTable)
             {
-                g_intervalFile << GetNode()->GetId() << "," << m_fixedInterval << std::endl;
+                g_intervalTable->Add (g_replication).Add (GetNode ()->GetId ()).Add (m_fixedInterval);
+                g_intervalTable->EndRow ();
             }
         }
 
@@ -726,10 +763,10 @@ public:
         g_snrMeasurements++;
 
         // Check receiver sensitivity
-        bool rssi_ok = (rssi >= RS_TABLE[sf][bw]);
+        bool rssi_ok = (rssi >= RS_TABLE[SfIndex (sf)][BwIndex (bw)]);
 
         // Check SINR requirement
-        bool sinr_ok = (snr >= SINR_REQ_TABLE[sf]);
+        bool sinr_ok = (snr >= SINR_REQ_TABLE[SfIndex (sf)]);
 
         // Simple collision check (could be improved with global collision detection)
         bool collision_occurred = false;
@@ -759,13 +796,14 @@ public:
         }
 
         // Log detailed information
-        if (g_detailsFile.is_open())
+        if (g_detailsTable)
         {
-            g_detailsFile << GetNode()->GetId() << "," 
-                         << Simulator::Now().GetSeconds() << ","
-                         << sf << "," << bw << "," << cf << "," << tp << ","
-                         << rssi << "," << snr << "," << success << ","
-                         << energyConsumed << "," << toa << std::endl;
+            g_detailsTable->Add (g_replication).Add (GetNode ()->GetId ())
+                .Add (Simulator::Now ().GetSeconds ())
+                .Add (sf).Add (bw).Add (cf).Add (tp)
+                .Add (rssi).Add (snr).Add (success)
+                .Add (energyConsumed).Add (toa);
+            g_detailsTable->EndRow ();
         }
 
         // Update algorithm with outcome
@@ -810,6 +848,8 @@ int main (int argc, char *argv[])
     uint32_t mobilityPercentage = 0;
     uint32_t spreadingFactor = 0; // 0 = adaptive, otherwise fixed SF
     bool enableDetailedLog = false;
+    uint32_t replications = 1;
+    std::string resultsFormat = "csv";
 
     CommandLine cmd (__FILE__);
     cmd.AddValue ("numNodes", "Number of LoRa end devices", numNodes);
@@ -821,6 +861,8 @@ int main (int argc, char *argv[])
     cmd.AddValue ("mobilityPercentage", "Percentage of mobile nodes (0-100)", mobilityPercentage);
     cmd.AddValue ("spreadingFactor", "Fixed spreading factor (0 for adaptive)", spreadingFactor);
     cmd.AddValue ("enableDetailedLog", "Enable detailed per-packet logging", enableDetailedLog);
+    cmd.AddValue ("replications", "Number of independent replications (consecutive RngRun values) run in this process", replications);
+    cmd.AddValue ("resultsFormat", "Format of the results and detailed log files (csv, columnar)", resultsFormat);
     cmd.Parse (argc, argv);
 
     // Set up logging
@@ -854,15 +896,67 @@ int main (int argc, char *argv[])
         parameterValue = std::to_string(numNodes);
     }
     
-    // Create unified CSV output filename
+    NS_ABORT_MSG_IF (resultsFormat != "csv" && resultsFormat != "columnar",
+                     "Unknown results format: " << resultsFormat);
+    ResultsTable::Format format = (resultsFormat == "columnar") ? ResultsTable::COLUMNAR : ResultsTable::CSV;
+
+    // Create unified output filename
     std::string prefix = algorithm + "_" + std::to_string(numNodes) + "nodes";
-    std::string csvFileName = "simulation_results_" + prefix + ".csv";
+    std::string csvFileName = "simulation_results_" + prefix + ResultsTable::GetExtension (format);
     
-    // Open unified CSV file with standardized header
-    std::ofstream csvFile(csvFileName);
-    if (csvFile.is_open())
+    // Open unified results table with standardized schema; REAL columns keep the
+    // two decimals of the former std::fixed output
+    Ptr<ResultsTable> resultsTable = CreateObject<ResultsTable> ();
+    resultsTable->SetFormat (format);
+    resultsTable->AddColumn ("Scenario", ResultsTable::TEXT);
+    resultsTable->AddColumn ("NumDevices", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("Algorithm", ResultsTable::TEXT);
+    resultsTable->AddColumn ("Packet_Index", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("Succeed", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("Lost", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("Success_Rate", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("PayloadSize", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("PacketInterval", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("MobilityPercentage", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("SpreadingFactor", ResultsTable::INTEGER);
+    resultsTable->AddColumn ("SimulationDuration", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("PDR", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("EnergyEfficiency", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("AverageToA", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("AverageSNR", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("AverageRSSI", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("TotalEnergyConsumption", ResultsTable::REAL, 2);
+    resultsTable->AddColumn ("VariableParameter", ResultsTable::TEXT);
+    resultsTable->AddColumn ("ParameterValue", ResultsTable::TEXT);
+    if (!resultsTable->Open (csvFileName))
     {
-        csvFile << "Scenario,NumDevices,Algorithm,Packet_Index,Succeed,Lost,Success_Rate,PayloadSize,PacketInterval,MobilityPercentage,SpreadingFactor,SimulationDuration,PDR,EnergyEfficiency,AverageToA,AverageSNR,AverageRSSI,TotalEnergyConsumption,VariableParameter,ParameterValue" << std::endl;
+        NS_LOG_ERROR ("Unable to create " << csvFileName);
+    }
+
+    if (enableDetailedLog)
+    {
+        g_intervalTable = CreateObject<ResultsTable> ();
+        g_intervalTable->SetFormat (format);
+        g_intervalTable->AddColumn ("Replication", ResultsTable::INTEGER);
+        g_intervalTable->AddColumn ("NodeId", ResultsTable::INTEGER);
+        g_intervalTable->AddColumn ("Interval", ResultsTable::REAL);
+        g_intervalTable->Open ("packet_intervals_" + prefix + ResultsTable::GetExtension (format));
+
+        g_detailsTable = CreateObject<ResultsTable> ();
+        g_detailsTable->SetFormat (format);
+        g_detailsTable->AddColumn ("Replication", ResultsTable::INTEGER);
+        g_detailsTable->AddColumn ("NodeId", ResultsTable::INTEGER);
+        g_detailsTable->AddColumn ("Time", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("SF", ResultsTable::INTEGER);
+        g_detailsTable->AddColumn ("BW", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("CF", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("TP", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("RSSI", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("SNR", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("Success", ResultsTable::INTEGER);
+        g_detailsTable->AddColumn ("Energy", ResultsTable::REAL);
+        g_detailsTable->AddColumn ("ToA", ResultsTable::REAL);
+        g_detailsTable->Open ("packet_details_" + prefix + ResultsTable::GetExtension (format));
     }
 
     // Set D-LoRa variant parameters
@@ -889,183 +983,202 @@ int main (int argc, char *argv[])
         SF_SET = {(int)spreadingFactor};
     }
 
-    // Create nodes
-    NodeContainer endDevices;
-    endDevices.Create (numNodes);
-    NodeContainer gateways;
-    gateways.Create (1);
+    // The SF/BW/CF/TP and sensitivity tables above are shared by all the replications,
+    // only the topology and the algorithm state are rebuilt from the next RngRun value
+    uint64_t baseRun = RngSeedManager::GetRun ();
+    for (uint32_t replication = 0; replication < replications; ++replication)
+    {
+        RngSeedManager::SetRun (baseRun + replication);
+        ResetGlobalCounters ();
+        g_replication = replication;
+        if (replications > 1)
+        {
+            std::cout << "Replication " << (replication + 1) << "/" << replications
+                      << " (RngRun=" << RngSeedManager::GetRun () << ")" << std::endl;
+        }
+
+        // Create nodes
+        NodeContainer endDevices;
+        endDevices.Create (numNodes);
+        NodeContainer gateways;
+        gateways.Create (1);
 
-    // Install mobility model
-    Ptr<UniformDiscPositionAllocator> positionAlloc = CreateObject<UniformDiscPositionAllocator> ();
-    positionAlloc->SetX (0.0);
-    positionAlloc->SetY (0.0);
-    positionAlloc->SetRho (topologyRadius);
+        // Install mobility model
+        Ptr<UniformDiscPositionAllocator> positionAlloc = CreateObject<UniformDiscPositionAllocator> ();
+        positionAlloc->SetX (0.0);
+        positionAlloc->SetY (0.0);
+        positionAlloc->SetRho (topologyRadius);
 
-    MobilityHelper mobility;
-    mobility.SetPositionAllocator (positionAlloc);
+        MobilityHelper mobility;
+        mobility.SetPositionAllocator (positionAlloc);
     
-    // Configure mobility for mobile nodes
-    uint32_t numMobileNodes = (numNodes * mobilityPercentage) / 100;
+        // Configure mobility for mobile nodes
+        uint32_t numMobileNodes = (numNodes * mobilityPercentage) / 100;
     
-    if (numMobileNodes > 0)
-    {
-        // Mobile nodes
-        NodeContainer mobileNodes;
-        for (uint32_t i = 0; i < numMobileNodes; ++i)
+        if (numMobileNodes > 0)
         {
-            mobileNodes.Add (endDevices.Get (i));
-        }
+            // Mobile nodes
+            NodeContainer mobileNodes;
+            for (uint32_t i = 0; i < numMobileNodes; ++i)
+            {
+                mobileNodes.Add (endDevices.Get (i));
+            }
         
-        mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
-                                  "Bounds", RectangleValue (Rectangle (-topologyRadius, topologyRadius, -topologyRadius, topologyRadius)),
-                                  "Speed", StringValue ("ns3::UniformRandomVariable[Min=1.39|Max=8.33]"), // 5-30 km/h
-                                  "Distance", DoubleValue (100.0));
-        mobility.Install (mobileNodes);
+            mobility.SetMobilityModel ("ns3::RandomWalk2dMobilityModel",
+                                      "Bounds", RectangleValue (Rectangle (-topologyRadius, topologyRadius, -topologyRadius, topologyRadius)),
+                                      "Speed", StringValue ("ns3::UniformRandomVariable[Min=1.39|Max=8.33]"), // 5-30 km/h
+                                      "Distance", DoubleValue (100.0));
+            mobility.Install (mobileNodes);
         
-        // Static nodes
-        if (numMobileNodes < numNodes)
-        {
-            NodeContainer staticNodes;
-            for (uint32_t i = numMobileNodes; i < numNodes; ++i)
+            // Static nodes
+            if (numMobileNodes < numNodes)
             {
-                staticNodes.Add (endDevices.Get (i));
-            }
+                NodeContainer staticNodes;
+                for (uint32_t i = numMobileNodes; i < numNodes; ++i)
+                {
+                    staticNodes.Add (endDevices.Get (i));
+                }
             
+                mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+                mobility.Install (staticNodes);
+            }
+        }
+        else
+        {
+            // All nodes are static
             mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
-            mobility.Install (staticNodes);
+            mobility.Install (endDevices);
         }
-    }
-    else
-    {
-        // All nodes are static
-        mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
-        mobility.Install (endDevices);
-    }
-    
-    // Gateway is always static at center
-    mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
-    mobility.Install (gateways);
-    gateways.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (0.0, 0.0, 0.0));
-
-    // Create applications with selected algorithm
-    ApplicationContainer apps;
-    std::vector<Ptr<BaseAlgorithm>> algorithmInstances;
     
-    for (uint32_t i = 0; i < numNodes; ++i)
-    {
-        Ptr<BaseAlgorithm> selectedAlgorithm;
+        // Gateway is always static at center
+        mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+        mobility.Install (gateways);
+        gateways.Get (0)->GetObject<MobilityModel> ()->SetPosition (Vector (0.0, 0.0, 0.0));
 
-        if (algorithm == "DLoRa" || algorithm == "DLoRa-PDR" || algorithm == "DLoRa-EE" || algorithm == "DLoRa-TH")
-        {
-            Ptr<DLoRaAlgorithm> dloraAlg = CreateObject<DLoRaAlgorithm> ();
-            dloraAlg->SetNodeAndGateway (endDevices.Get (i), gateways.Get (0));
-            selectedAlgorithm = dloraAlg;
-        }
-        else if (algorithm == "Random")
-        {
-            selectedAlgorithm = CreateObject<RandomAlgorithm> ();
-        }
-        else if (algorithm == "RoundRobin")
-        {
-            selectedAlgorithm = CreateObject<RoundRobinAlgorithm> ();
-        }
-        else if (algorithm == "ADR")
-        {
-            selectedAlgorithm = CreateObject<ADRAlgorithm> ();
-        }
-        else if (algorithm == "RSLoRa")
-        {
-            selectedAlgorithm = CreateObject<RSLoRaAlgorithm> ();
-        }
-        else
+        // Create applications with selected algorithm
+        ApplicationContainer apps;
+        std::vector<Ptr<BaseAlgorithm>> algorithmInstances;
+    
+        for (uint32_t i = 0; i < numNodes; ++i)
         {
-            NS_FATAL_ERROR ("Unknown algorithm: " << algorithm);
-        }
+            Ptr<BaseAlgorithm> selectedAlgorithm;
 
-        algorithmInstances.push_back(selectedAlgorithm);
+            if (algorithm == "DLoRa" || algorithm == "DLoRa-PDR" || algorithm == "DLoRa-EE" || algorithm == "DLoRa-TH")
+            {
+                Ptr<DLoRaAlgorithm> dloraAlg = CreateObject<DLoRaAlgorithm> ();
+                dloraAlg->SetNodeAndGateway (endDevices.Get (i), gateways.Get (0));
+                selectedAlgorithm = dloraAlg;
+            }
+            else if (algorithm == "Random")
+            {
+                selectedAlgorithm = CreateObject<RandomAlgorithm> ();
+            }
+            else if (algorithm == "RoundRobin")
+            {
+                selectedAlgorithm = CreateObject<RoundRobinAlgorithm> ();
+            }
+            else if (algorithm == "ADR")
+            {
+                selectedAlgorithm = CreateObject<ADRAlgorithm> ();
+            }
+            else if (algorithm == "RSLoRa")
+            {
+                selectedAlgorithm = CreateObject<RSLoRaAlgorithm> ();
+            }
+            else
+            {
+                NS_FATAL_ERROR ("Unknown algorithm: " << algorithm);
+            }
 
-        Ptr<LoRaEndDeviceApp> app = CreateObject<LoRaEndDeviceApp> ();
-        app->SetGatewayAndAlgorithm (gateways.Get (0), selectedAlgorithm);
-        app->SetPacketInterval (packetInterval);
-        app->SetPacketSize (payloadSize);
-        endDevices.Get (i)->AddApplication (app);
-        app->SetStartTime (Seconds (0.0));
-        app->SetStopTime (Seconds (simulationTime));
-        apps.Add (app);
-    }
+            algorithmInstances.push_back(selectedAlgorithm);
+
+            Ptr<LoRaEndDeviceApp> app = CreateObject<LoRaEndDeviceApp> ();
+            app->SetGatewayAndAlgorithm (gateways.Get (0), selectedAlgorithm);
+            app->SetPacketInterval (packetInterval);
+            app->SetPacketSize (payloadSize);
+            endDevices.Get (i)->AddApplication (app);
+            app->SetStartTime (Seconds (0.0));
+            app->SetStopTime (Seconds (simulationTime));
+            apps.Add (app);
+        }
 
-    // Run simulation
-    NS_LOG_INFO("Starting simulation with " << numNodes << " nodes, algorithm: " << algorithm);
+        // Run simulation
+        NS_LOG_INFO("Starting simulation with " << numNodes << " nodes, algorithm: " << algorithm);
     
-    Simulator::Stop (Seconds (simulationTime));
-    Simulator::Run ();
-    Simulator::Destroy ();
-
-    g_totalSimulationTime = simulationTime;
-
-    // Calculate and print metrics
-    double pdr = (g_totalPacketsSent > 0) ? (g_totalPacketsReceived / g_totalPacketsSent) * 100.0 : 0.0;
-    double ee = (g_totalEnergyConsumed > 0) ? (g_totalDataReceived * 8.0 / g_totalEnergyConsumed) : 0.0;
-    double th = (g_totalTimeOnAir > 0) ? (g_totalDataReceived * 8.0 / g_totalTimeOnAir) : 0.0;
-    double avgToA = (g_totalPacketsSent > 0) ? (g_totalTimeOnAir / g_totalPacketsSent) * 1000.0 : 0.0;
-    double avgRSSI = (g_rssiMeasurements > 0) ? (g_totalRSSI / g_rssiMeasurements) : 0.0;
-    double avgSNR = (g_snrMeasurements > 0) ? (g_totalSNR / g_snrMeasurements) : 0.0;
-    double collisionRate = (g_totalPacketsSent > 0) ? (g_collisions / g_totalPacketsSent) * 100.0 : 0.0;
-
-    // Print results
-    std::cout << "Simulation Results for " << algorithm << " (Radius: " << (int)topologyRadius << "m)" << std::endl;
-    std::cout << "PDR: " << std::fixed << std::setprecision(2) << pdr << " %" << std::endl;
-    std::cout << "EE: " << std::fixed << std::setprecision(2) << ee << " bits/mJ" << std::endl;
-    std::cout << "TH: " << std::fixed << std::setprecision(2) << th << " bps" << std::endl;
-    std::cout << "AvgToA: " << std::fixed << std::setprecision(2) << avgToA << " ms" << std::endl;
-    std::cout << "AvgRSSI: " << std::fixed << std::setprecision(2) << avgRSSI << " dBm" << std::endl;
-    std::cout << "AvgSNR: " << std::fixed << std::setprecision(2) << avgSNR << " dB" << std::endl;
-    std::cout << "CollisionRate: " << std::fixed << std::setprecision(2) << collisionRate << " %" << std::endl;
+        Simulator::Stop (Seconds (simulationTime));
+        Simulator::Run ();
+        Simulator::Destroy ();
+
+        g_totalSimulationTime = simulationTime;
+
+        // Calculate and print metrics
+        double pdr = (g_totalPacketsSent > 0) ? (g_totalPacketsReceived / g_totalPacketsSent) * 100.0 : 0.0;
+        double ee = (g_totalEnergyConsumed > 0) ? (g_totalDataReceived * 8.0 / g_totalEnergyConsumed) : 0.0;
+        double th = (g_totalTimeOnAir > 0) ? (g_totalDataReceived * 8.0 / g_totalTimeOnAir) : 0.0;
+        double avgToA = (g_totalPacketsSent > 0) ? (g_totalTimeOnAir / g_totalPacketsSent) * 1000.0 : 0.0;
+        double avgRSSI = (g_rssiMeasurements > 0) ? (g_totalRSSI / g_rssiMeasurements) : 0.0;
+        double avgSNR = (g_snrMeasurements > 0) ? (g_totalSNR / g_snrMeasurements) : 0.0;
+        double collisionRate = (g_totalPacketsSent > 0) ? (g_collisions / g_totalPacketsSent) * 100.0 : 0.0;
+
+        // Print results
+        std::cout << "Simulation Results for " << algorithm << " (Radius: " << (int)topologyRadius << "m)" << std::endl;
+        std::cout << "PDR: " << std::fixed << std::setprecision(2) << pdr << " %" << std::endl;
+        std::cout << "EE: " << std::fixed << std::setprecision(2) << ee << " bits/mJ" << std::endl;
+        std::cout << "TH: " << std::fixed << std::setprecision(2) << th << " bps" << std::endl;
+        std::cout << "AvgToA: " << std::fixed << std::setprecision(2) << avgToA << " ms" << std::endl;
+        std::cout << "AvgRSSI: " << std::fixed << std::setprecision(2) << avgRSSI << " dBm" << std::endl;
+        std::cout << "AvgSNR: " << std::fixed << std::setprecision(2) << avgSNR << " dB" << std::endl;
+        std::cout << "CollisionRate: " << std::fixed << std::setprecision(2) << collisionRate << " %" << std::endl;
     
-    // Additional statistics
-    std::cout << "TotalPacketsSent: " << (int)g_totalPacketsSent << std::endl;
-    std::cout << "TotalPacketsReceived: " << (int)g_totalPacketsReceived << std::endl;
-    std::cout << "TotalEnergyConsumed: " << std::fixed << std::setprecision(3) << g_totalEnergyConsumed << " mJ" << std::endl;
+        // Additional statistics
+        std::cout << "TotalPacketsSent: " << (int)g_totalPacketsSent << std::endl;
+        std::cout << "TotalPacketsReceived: " << (int)g_totalPacketsReceived << std::endl;
+        std::cout << "TotalEnergyConsumed: " << std::fixed << std::setprecision(3) << g_totalEnergyConsumed << " mJ" << std::endl;
 
-    // Write results to CSV file
-    if (csvFile.is_open())
-    {
-        csvFile << scenario << ","
-                << numNodes << ","
-                << algorithm << ","
-                << (int)g_totalPacketsSent << ","
-                << (int)g_totalPacketsReceived << ","
-                << (int)(g_totalPacketsSent - g_totalPacketsReceived) << ","
-                << std::fixed << std::setprecision(2) << pdr << ","
-                << payloadSize << ","
-                << packetInterval << ","
-                << mobilityPercentage << ","
-                << (spreadingFactor > 0 ? spreadingFactor : 0) << ","
-                << simulationTime << ","
-                << pdr << ","
-                << ee << ","
-                << avgToA << ","
-                << avgSNR << ","
-                << avgRSSI << ","
-                << g_totalEnergyConsumed << ","
-                << variableParameter << ","
-                << parameterValue << std::endl;
-        csvFile.close();
-    }
-
-    // Close detailed log files if they were opened
-    if (enableDetailedLog)
-    {
-        if (g_intervalFile.is_open())
+        // Write results to the results table
+        if (resultsTable->IsOpen ())
         {
-            g_intervalFile.close();
+            resultsTable->Add (scenario)
+                .Add (numNodes)
+                .Add (algorithm)
+                .Add ((int)g_totalPacketsSent)
+                .Add ((int)g_totalPacketsReceived)
+                .Add ((int)(g_totalPacketsSent - g_totalPacketsReceived))
+                .Add (pdr)
+                .Add (payloadSize)
+                .Add (packetInterval)
+                .Add (mobilityPercentage)
+                .Add (spreadingFactor > 0 ? spreadingFactor : 0)
+                .Add (simulationTime)
+                .Add (pdr)
+                .Add (ee)
+                .Add (avgToA)
+                .Add (avgSNR)
+                .Add (avgRSSI)
+                .Add (g_totalEnergyConsumed)
+                .Add (variableParameter)
+                .Add (parameterValue);
+            resultsTable->EndRow ();
+            // Flushed after every replication, so finished replications survive an interrupted run
+            resultsTable->Flush ();
         }
-        
-        if (g_detailsFile.is_open())
+        if (g_detailsTable)
         {
-            g_detailsFile.close();
+            g_intervalTable->Flush ();
+            g_detailsTable->Flush ();
         }
     }
 
+    resultsTable->Close ();
+
+    // Close detailed log tables if they were opened
+    if (enableDetailedLog)
+    {
+        g_intervalTable->Close ();
+        g_detailsTable->Close ();
+        g_intervalTable = nullptr;
+        g_detailsTable = nullptr;
+    }
+
     return 0;
 }
\ No newline at end of file
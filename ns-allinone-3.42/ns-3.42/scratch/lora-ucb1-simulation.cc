@@ -10,9 +10,14 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/applications-module.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/results-table.h"
+#include "ns3/lora-link-budget.h"
+#include "ns3/ucb1-tuned-policy.h"
+#include "ns3/uplink-scheduler.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <deque>
 #include <map>
 #include <cmath>
 #include <algorithm>
@@ -47,6 +52,11 @@ int g_simulationTime = 3600;    // secondes (réduit à 1h pour tests)
 int g_mobilityPercentage = 0;
 int g_randomSeed = 1;
 int g_spreadingFactor = 7;       // Spreading Factor par défaut
+int g_replications = 1;          // Réplications indépendantes exécutées dans le même processus
+std::string g_resultsFormat = "csv"; // Format du fichier par paquet : csv ou columnar (ResultsTable)
+std::string g_gatewayModel = "probabilistic"; // Réception : probabilistic (tirage par paquet) ou collision
+double g_dutyCycle = 0; // Rapport cyclique de la sous-bande 920-922 MHz (0 : pas de limite)
+int g_numGateways = 1;  // Nombre de gateways (modèle à collisions)
 
 // Paramètres énergétiques EXACTS (Table II de l'article)
 const double E_WU = 56.1 * 0.001;  // mWh (T_WU assumé = 1ms)
@@ -59,35 +69,29 @@ const int N_Payload_max = 44;       // bytes (maximum selon article)
 const double BW = 125000;           // Hz (125 kHz)
 // Note: SF sera remplacé par g_spreadingFactor dans les calculs
 
+// Écart entre les transmissions d'exploration initiale d'un device (modèle à collisions)
+const double EXPLORATION_SPACING = 1.0;                                    // secondes
+
+// Index du bras (canal, TP) dans la politique : canal en boucle externe, TP en interne
+uint32_t ArmIndex(double channel, int tp)
+{
+    auto ch = std::find(g_channels.begin(), g_channels.end(), channel);
+    auto power = std::find(g_transmissionPowers.begin(), g_transmissionPowers.end(), tp);
+    NS_ABORT_MSG_IF(ch == g_channels.end() || power == g_transmissionPowers.end(),
+                    "Combinaison inconnue: " << channel << " MHz, " << tp << " dBm");
+    return (ch - g_channels.begin()) * g_transmissionPowers.size() + (power - g_transmissionPowers.begin());
+}
+
 // Forward declarations
 class LoRaDevice;
 class LoRaGateway;
 
-// Structure UCB1-tuned EXACTE selon l'article
-struct UCBStats {
-    double rewardsSum;
-    int selectionsCount;
-    std::vector<double> rewardHistory; // Pour calcul variance exacte
-    
-    UCBStats() : rewardsSum(0.0), selectionsCount(0) {}
-    
-    // Calcul variance selon l'article
-    double getVariance() {
-        if (rewardHistory.size() <= 1) return 0.0;
-        
-        double mean = rewardsSum / selectionsCount;
-        double sumSquared = 0.0;
-        for (double reward : rewardHistory) {
-            sumSquared += (reward - mean) * (reward - mean);
-        }
-        return sumSquared / (rewardHistory.size() - 1);
-    }
-};
-
 class LoRaDevice : public Application
 {
 public:
-    LoRaDevice(int deviceId, Ptr<LoRaGateway> gateway, std::string algorithm);
+    LoRaDevice(int deviceId, Ptr<LoRaGateway> gateway, std::string algorithm,
+               Ptr<lorawan::Ucb1TunedPolicy> policy,
+               Ptr<lorawan::UplinkScheduler> scheduler = nullptr);
     void StartApplication();
     void StopApplication();
 
@@ -97,8 +101,13 @@ public:
     void UpdateStatistics(double channel, int tp, bool success);
     int GeneratePayloadSize(); // Génère taille payload aléatoire entre 36-44 bytes
 
+    // Transmission vers la gateway ; le résultat arrive par TransmissionResult,
+    // immédiatement ou à la fin du temps d'antenne selon le modèle de gateway.
+    // Retourne le temps d'antenne en secondes (0 s'il n'a pas été calculé)
+    double Transmit(double channel, int tp);
+    void TransmissionResult(double channel, int tp, bool success);
+
     // Algorithmes selon l'article
-    double CalculateUCBScore(double channel, int tp, int totalSelections);
     std::pair<double, int> SelectTransmissionParametersUCB1();
     std::pair<double, int> SelectTransmissionParametersEpsilonGreedy();
     std::pair<double, int> SelectTransmissionParametersFixed();
@@ -110,15 +119,18 @@ public:
     std::vector<int> m_tpSelectionHistory;
     std::vector<double> m_channelSelectionHistory;
 
+    // Transmission suivante, appelée par un événement ou au réveil par l'ordonnanceur
+    void SelectAndTransmit();
+
 private:
     int m_deviceId;
     Ptr<LoRaGateway> m_gateway;
     EventId m_sendEvent;
     int m_currentTransmissionRound;
-    int m_totalSelections; // Total sélections selon UCB1-tuned
     std::string m_algorithm;
 
-    std::map<std::pair<double, int>, UCBStats> m_ucbStats;
+    // Statistiques UCB1-tuned partagées : une ligne (canal x TP) par device
+    Ptr<lorawan::Ucb1TunedPolicy> m_policy;
     Ptr<UniformRandomVariable> m_rand;
 
     // Epsilon-Greedy (ε = 0.1 selon article)
@@ -128,7 +140,8 @@ private:
     std::vector<std::pair<double, int>> m_adrParameterList;
     int m_adrIndex;
 
-    void SelectAndTransmit();
+    // Ordonnanceur des réveils et du rapport cyclique, s'il est limité
+    Ptr<lorawan::UplinkScheduler> m_scheduler;
 };
 
 class LoRaGateway : public Application
@@ -139,32 +152,61 @@ public:
     void StopApplication();
     bool ReceiveTransmission(double channel, int tp, int deviceId);
 
+    // Modèle à collisions : la transmission occupe le canal pendant airtime secondes,
+    // et sa réception est décidée à sa fin, d'après les transmissions qui l'ont chevauchée
+    void StartTransmission(Ptr<LoRaDevice> device, double channel, int tp, double airtime);
+
+    // Gateways du réseau (modèle à collisions) : une transmission est reçue si au moins
+    // une gateway la décode
+    void SetGateways(const NodeContainer& gateways);
+
 private:
+    // Une transmission sur un canal recevable, en cours ou chevauchant une transmission en cours
+    struct Transmission {
+        uint64_t id;
+        Ptr<LoRaDevice> device;
+        double channel;
+        int tp;
+        double start;     // secondes
+        double end;       // secondes
+        std::vector<double> rxPowerMw; // puissance reçue à chaque gateway
+        bool ended;
+    };
+
+    void EndTransmission(uint32_t channelIndex, uint64_t id);
+
     std::vector<double> m_receivableChannels;
     Ptr<UniformRandomVariable> m_rand;
+
+    // Transmissions par canal recevable (le SF est commun à tous les devices),
+    // dans l'ordre de leur début
+    std::vector<std::deque<Transmission>> m_transmissions;
+    uint64_t m_nextTransmissionId;
+    // Bilan de liaison commun aux simulations LoRa : propagation, sensibilité, capture
+    Ptr<lorawan::LoraLinkBudget> m_linkBudget;
+    std::vector<Ptr<MobilityModel>> m_gatewayMobility;
+    std::vector<double> m_distances; // distance du device à chaque gateway, réutilisé
+    std::vector<double> m_txPowers;  // puissance d'émission vers chaque gateway, réutilisé
+    std::vector<double> m_interference; // énergie interférente à chaque gateway, réutilisé
 };
 
 // --- Implémentation LoRaDevice ---
-LoRaDevice::LoRaDevice(int deviceId, Ptr<LoRaGateway> gateway, std::string algorithm)
+LoRaDevice::LoRaDevice(int deviceId, Ptr<LoRaGateway> gateway, std::string algorithm,
+                       Ptr<lorawan::Ucb1TunedPolicy> policy,
+                       Ptr<lorawan::UplinkScheduler> scheduler)
     : m_deviceId(deviceId),
       m_gateway(gateway),
       m_currentTransmissionRound(0),
-      m_totalSelections(0),
       m_algorithm(algorithm),
+      m_policy(policy),
       m_epsilon(0.1), // Article mentionne ε = 0.1
-      m_adrIndex(0)
+      m_adrIndex(0),
+      m_scheduler(scheduler)
 {
     m_rand = CreateObject<UniformRandomVariable>();
     m_rand->SetAttribute("Min", DoubleValue(0.0));
     m_rand->SetAttribute("Max", DoubleValue(1.0));
 
-    // Initialisation UCB stats pour toutes combinaisons (channel, TP)
-    for (double ch : g_channels) {
-        for (int tp : g_transmissionPowers) {
-            m_ucbStats[{ch, tp}] = UCBStats();
-        }
-    }
-
     // Initialisation ADR-Lite EXACTE selon l'article
     if (m_algorithm == "ADR-Lite") {
         // Article: "sorts transmission power in increased order while channel is listed according to channel situation"
@@ -189,24 +231,38 @@ LoRaDevice::LoRaDevice(int deviceId, Ptr<LoRaGateway> gateway, std::string algor
 void LoRaDevice::StartApplication()
 {
     // Article: "all variables are initialized as 0 first. Then, each LoRa ED transmits once using each channel and TP level combination"
+    double explorationTime = 0;
     if (m_algorithm == "UCB1-tuned") {
         NS_LOG_INFO("Device " << m_deviceId << ": Exploration initiale UCB1-tuned - test de chaque combinaison");
         for (double ch : g_channels) {
             for (int tp : g_transmissionPowers) {
-                bool success = m_gateway->ReceiveTransmission(ch, tp, m_deviceId);
-                UpdateStatistics(ch, tp, success);
+                if (g_gatewayModel == "collision") {
+                    // Les transmissions occupent le canal : les étaler, à un instant aléatoire chacune
+                    double delay = explorationTime + m_rand->GetValue() * EXPLORATION_SPACING;
+                    Simulator::Schedule(Seconds(delay), &LoRaDevice::Transmit, this, ch, tp);
+                    explorationTime += EXPLORATION_SPACING;
+                } else {
+                    Transmit(ch, tp);
+                }
             }
         }
     }
 
     // Démarrage transmissions principales avec délai aléatoire
-    double startTime = m_deviceId * 0.1; // Éviter collisions initiales
-    m_sendEvent = Simulator::Schedule(Seconds(startTime), &LoRaDevice::SelectAndTransmit, this);
+    double startTime = explorationTime + m_deviceId * 0.1; // Éviter collisions initiales
+    if (m_scheduler) {
+        m_scheduler->ScheduleWakeup(m_deviceId, Seconds(startTime));
+    } else {
+        m_sendEvent = Simulator::Schedule(Seconds(startTime), &LoRaDevice::SelectAndTransmit, this);
+    }
 }
 
 void LoRaDevice::StopApplication()
 {
     Simulator::Cancel(m_sendEvent);
+    if (m_scheduler) {
+        m_scheduler->CancelWakeup(m_deviceId);
+    }
 }
 
 double LoRaDevice::CalculateTimeOnAir(int tp)
@@ -245,9 +301,6 @@ int LoRaDevice::GeneratePayloadSize()
 
 void LoRaDevice::UpdateStatistics(double channel, int tp, bool success)
 {
-    auto key = std::make_pair(channel, tp);
-    UCBStats& stats = m_ucbStats[key];
-
     // Article: "The reward for receiving ACK information is defined as 1/E_ToA"
     double reward = 0.0;
     if (success) {
@@ -256,10 +309,7 @@ void LoRaDevice::UpdateStatistics(double channel, int tp, bool success)
     }
     // Sinon reward = 0 (comme indiqué dans l'article)
     
-    stats.rewardsSum += reward;
-    stats.selectionsCount++;
-    stats.rewardHistory.push_back(reward);
-    m_totalSelections++;
+    m_policy->Update(m_deviceId, ArmIndex(channel, tp), reward);
 
     // Historique pour analyse
     m_successHistory.push_back(success);
@@ -268,45 +318,28 @@ void LoRaDevice::UpdateStatistics(double channel, int tp, bool success)
     m_channelSelectionHistory.push_back(channel);
 }
 
-double LoRaDevice::CalculateUCBScore(double channel, int tp, int totalSelections)
+double LoRaDevice::Transmit(double channel, int tp)
 {
-    UCBStats& stats = m_ucbStats[{channel, tp}];
-
-    if (stats.selectionsCount == 0) {
-        return std::numeric_limits<double>::infinity(); // Exploration prioritaire
+    if (g_gatewayModel == "collision") {
+        double airtime = CalculateTimeOnAir(tp);
+        m_gateway->StartTransmission(this, channel, tp, airtime);
+        return airtime;
     }
+    TransmissionResult(channel, tp, m_gateway->ReceiveTransmission(channel, tp, m_deviceId));
+    // Le temps d'antenne (qui tire une taille de payload) ne sert ici qu'au rapport cyclique
+    return m_scheduler ? CalculateTimeOnAir(tp) : 0;
+}
 
-    // Article équations (11)-(12) UCB1-tuned EXACTES
-    double meanReward = stats.rewardsSum / stats.selectionsCount;
-    double variance = stats.getVariance();
-    
-    // Équation (12): V_ui(t) = σ²_ui + sqrt(2*ln(t)/N_ui(t))
-    double V_ui = variance + std::sqrt((2.0 * std::log(totalSelections)) / stats.selectionsCount);
-    
-    // Équation (11): P_ui(t) = R_ui(t)/N_ui(t) + sqrt(ln(t)/N_ui(t) * min(1/4, V_ui(t)))
-    double explorationTerm = std::sqrt((std::log(totalSelections) / stats.selectionsCount) * std::min(0.25, V_ui));
-    
-    return meanReward + explorationTerm;
+void LoRaDevice::TransmissionResult(double channel, int tp, bool success)
+{
+    UpdateStatistics(channel, tp, success);
 }
 
 std::pair<double, int> LoRaDevice::SelectTransmissionParametersUCB1()
 {
-    double bestScore = -std::numeric_limits<double>::infinity();
-    double bestChannel = g_channels[0];
-    int bestTp = g_transmissionPowers[0];
-
-    // Article équation (10): sélection argmax des scores UCB
-    for (double ch : g_channels) {
-        for (int tp : g_transmissionPowers) {
-            double score = CalculateUCBScore(ch, tp, m_totalSelections);
-            if (score > bestScore) {
-                bestScore = score;
-                bestChannel = ch;
-                bestTp = tp;
-            }
-        }
-    }
-    return {bestChannel, bestTp};
+    // Article équations (10)-(12): argmax des scores UCB1-tuned, calculés par la politique
+    uint32_t arm = m_policy->SelectArm(m_deviceId);
+    return {g_channels[arm / g_transmissionPowers.size()], g_transmissionPowers[arm % g_transmissionPowers.size()]};
 }
 
 std::pair<double, int> LoRaDevice::SelectTransmissionParametersEpsilonGreedy()
@@ -324,9 +357,9 @@ std::pair<double, int> LoRaDevice::SelectTransmissionParametersEpsilonGreedy()
 
         for (double ch : g_channels) {
             for (int tp : g_transmissionPowers) {
-                auto key = std::make_pair(ch, tp);
-                if (m_ucbStats[key].selectionsCount > 0) {
-                    double avgReward = m_ucbStats[key].rewardsSum / m_ucbStats[key].selectionsCount;
+                uint32_t arm = ArmIndex(ch, tp);
+                if (m_policy->GetPulls(m_deviceId, arm) > 0) {
+                    double avgReward = m_policy->GetMeanReward(m_deviceId, arm);
                     if (avgReward > bestReward) {
                         bestReward = avgReward;
                         bestChannel = ch;
@@ -374,6 +407,12 @@ std::pair<double, int> LoRaDevice::SelectTransmissionParametersADRLite()
 void LoRaDevice::SelectAndTransmit()
 {
     if (m_currentTransmissionRound < g_numTransmissions) {
+        // Sous-bande encore bloquée par le rapport cyclique : l'ordonnanceur réveille
+        // le device quand elle se libère, et les paramètres sont choisis à ce moment
+        if (m_scheduler && m_scheduler->DeferIfBlocked(m_deviceId, 0)) {
+            return;
+        }
+
         std::pair<double, int> params;
         
         if (m_algorithm == "UCB1-tuned") {
@@ -391,8 +430,10 @@ void LoRaDevice::SelectAndTransmit()
         double channel = params.first;
         int tp = params.second;
 
-        bool success = m_gateway->ReceiveTransmission(channel, tp, m_deviceId);
-        UpdateStatistics(channel, tp, success);
+        double airtime = Transmit(channel, tp);
+        if (m_scheduler) {
+            m_scheduler->NotifyTransmission(m_deviceId, 0, Seconds(airtime));
+        }
 
         m_currentTransmissionRound++;
         
@@ -402,17 +443,35 @@ void LoRaDevice::SelectAndTransmit()
         double jitter = m_rand->GetValue() * 1.0; // Jitter réduit à 0-1s
         double nextInterval = baseInterval + deviceDelay + jitter;
         
-        Simulator::Schedule(Seconds(nextInterval), &LoRaDevice::SelectAndTransmit, this);
+        if (m_scheduler) {
+            m_scheduler->ScheduleWakeup(m_deviceId, Seconds(nextInterval));
+        } else {
+            Simulator::Schedule(Seconds(nextInterval), &LoRaDevice::SelectAndTransmit, this);
+        }
     }
 }
 
 // --- Implémentation LoRaGateway ---
 LoRaGateway::LoRaGateway(const std::vector<double>& receivableChannels)
-    : m_receivableChannels(receivableChannels)
+    : m_receivableChannels(receivableChannels),
+      m_transmissions(receivableChannels.size()),
+      m_nextTransmissionId(0)
 {
     m_rand = CreateObject<UniformRandomVariable>();
     m_rand->SetAttribute("Min", DoubleValue(0.0));
     m_rand->SetAttribute("Max", DoubleValue(1.0));
+
+    // Propagation des exemples du module lorawan : log-distance, exposant 3.76
+    m_linkBudget = CreateObject<lorawan::LoraLinkBudget>();
+}
+
+void LoRaGateway::SetGateways(const NodeContainer& gateways)
+{
+    m_gatewayMobility.clear();
+    for (uint32_t i = 0; i < gateways.GetN(); i++) {
+        m_gatewayMobility.push_back(gateways.Get(i)->GetObject<MobilityModel>());
+    }
+    m_interference.assign(m_gatewayMobility.size(), 0.0);
 }
 
 void LoRaGateway::StartApplication()
@@ -466,6 +525,88 @@ bool LoRaGateway::ReceiveTransmission(double channel, int tp, int deviceId)
     return m_rand->GetValue() < successProbability;
 }
 
+void LoRaGateway::StartTransmission(Ptr<LoRaDevice> device, double channel, int tp, double airtime)
+{
+    auto rc = std::find_if(m_receivableChannels.begin(), m_receivableChannels.end(),
+                           [channel](double c) { return std::abs(channel - c) < 0.001; });
+    if (rc == m_receivableChannels.end()) {
+        // La gateway n'écoute pas ce canal : échec connu à la fin du temps d'antenne
+        Simulator::Schedule(Seconds(airtime), &LoRaDevice::TransmissionResult, device, channel, tp, false);
+        return;
+    }
+    uint32_t channelIndex = rc - m_receivableChannels.begin();
+
+    // Seul le gain de propagation dépend de la gateway : bilan de toutes les liaisons d'un coup
+    Ptr<MobilityModel> deviceMobility = device->GetNode()->GetObject<MobilityModel>();
+    m_distances.resize(m_gatewayMobility.size());
+    for (size_t gw = 0; gw < m_gatewayMobility.size(); gw++) {
+        m_distances[gw] = deviceMobility->GetDistanceFrom(m_gatewayMobility[gw]);
+    }
+    m_txPowers.assign(m_gatewayMobility.size(), tp);
+    std::vector<double> rxPowerMw;
+    m_linkBudget->GetRxPowers(m_txPowers, m_distances, rxPowerMw);
+    for (double& power : rxPowerMw) {
+        power = std::pow(10.0, power / 10.0);
+    }
+    double now = Simulator::Now().GetSeconds();
+    uint64_t id = m_nextTransmissionId++;
+    m_transmissions[channelIndex].push_back(
+        {id, device, channel, tp, now, now + airtime, std::move(rxPowerMw), false});
+    Simulator::Schedule(Seconds(airtime), &LoRaGateway::EndTransmission, this, channelIndex, id);
+}
+
+void LoRaGateway::EndTransmission(uint32_t channelIndex, uint64_t id)
+{
+    auto& transmissions = m_transmissions[channelIndex];
+    auto it = std::find_if(transmissions.begin(), transmissions.end(),
+                           [id](const Transmission& t) { return t.id == id; });
+    NS_ASSERT(it != transmissions.end());
+    Transmission& signal = *it;
+    signal.ended = true;
+
+    // Capture : l'énergie du signal doit dépasser de CAPTURE_THRESHOLD dB celle des
+    // transmissions de même SF qui l'ont chevauché, chacune pondérée par la durée du chevauchement.
+    // Les chevauchements sont calculés une seule fois, puis pondérés par la puissance reçue
+    // à chaque gateway
+    const size_t nGateways = m_gatewayMobility.size();
+    double duration = signal.end - signal.start;
+    std::fill(m_interference.begin(), m_interference.end(), 0.0);
+    for (const auto& other : transmissions) {
+        if (other.id == id || other.start >= signal.end || other.end <= signal.start) {
+            continue;
+        }
+        double overlap = std::min(signal.end, other.end) - std::max(signal.start, other.start);
+        for (size_t gw = 0; gw < nGateways; gw++) {
+            m_interference[gw] += other.rxPowerMw[gw] * overlap;
+        }
+    }
+    const double sensitivityMw =
+        std::pow(10.0, lorawan::LoraLinkBudget::GetSensitivity(g_spreadingFactor, BW) / 10.0);
+    const double captureRatio =
+        std::pow(10.0, lorawan::LoraLinkBudget::GetSirThreshold(g_spreadingFactor, g_spreadingFactor) / 10.0);
+    uint32_t nReceivers = 0;
+    for (size_t gw = 0; gw < nGateways; gw++) {
+        if (signal.rxPowerMw[gw] >= sensitivityMw &&
+            signal.rxPowerMw[gw] * duration >= captureRatio * m_interference[gw]) {
+            nReceivers++;
+        }
+    }
+    bool success = nReceivers > 0;
+    NS_LOG_DEBUG("Gateway: canal " << m_receivableChannels[channelIndex] << ", transmission " << id
+                 << " reçue par " << nReceivers << " gateway(s) sur " << nGateways);
+    Simulator::ScheduleNow(&LoRaDevice::TransmissionResult, signal.device, signal.channel, signal.tp,
+                           success);
+
+    // Oublier les transmissions terminées qui ne chevauchent plus aucune transmission en cours
+    auto active = std::find_if(transmissions.begin(), transmissions.end(),
+                               [](const Transmission& t) { return !t.ended; });
+    double firstActiveStart = active == transmissions.end() ? signal.end : active->start;
+    while (!transmissions.empty() && transmissions.front().ended &&
+           transmissions.front().end <= firstActiveStart) {
+        transmissions.pop_front();
+    }
+}
+
 // Variables globales pour collecte des résultats
 std::map<std::string, std::map<int, int>> g_tpSelectionCounts;
 std::map<std::string, std::vector<double>> g_selectionRatios;
@@ -478,7 +619,17 @@ void CreateOutputDirectories() {
     system("mkdir -p scratch/lorawan/plots");
 }
 
-void CollectResults(const std::vector<Ptr<LoRaDevice>>& devices, const std::string& algorithm)
+// Résumé d'une réplication, diffusé dès la fin de celle-ci
+struct ReplicationSummary {
+    int replication;
+    uint64_t rngRun;
+    double successRate;
+    double energyEfficiency;
+    double totalEnergyConsumption;
+    double totalTransmissions;
+};
+
+ReplicationSummary CollectResults(const std::vector<Ptr<LoRaDevice>>& devices, const std::string& algorithm, int replication)
 {
     // Collecter résultats - EXACTEMENT comme décrit dans l'article
     double totalSuccesses = 0;
@@ -563,12 +714,38 @@ void CollectResults(const std::vector<Ptr<LoRaDevice>>& devices, const std::stri
         // Scénario par défaut (densité)
         csvFilename += std::to_string(g_numDevices) + "devices_results.csv";
     }
-    
-    std::ofstream csvFile(csvFilename);
-    if (csvFile.is_open()) {
-        // En-têtes CSV au format exact demandé avec le champ Scenario
-        csvFile << "Scenario,NumDevices,Algorithm,Packet_Index,Succeed,Lost,Success_Rate,PayloadSize,PacketInterval,MobilityPercentage,SpreadingFactor,SimulationDuration,PDR,EnergyEfficiency,AverageToA,AverageSNR,AverageRSSI,TotalEnergyConsumption,VariableParameter,ParameterValue" << std::endl;
-        
+
+    // Un fichier par réplication pour ne pas écraser les précédentes
+    if (g_replications > 1) {
+        csvFilename.insert(csvFilename.size() - 4, "_rep" + std::to_string(replication));
+    }
+
+    // Table par paquet : formatage et écriture par lots dans un thread séparé
+    Ptr<ResultsTable> resultsTable = CreateObject<ResultsTable>();
+    resultsTable->SetFormat(g_resultsFormat == "columnar" ? ResultsTable::COLUMNAR : ResultsTable::CSV);
+    csvFilename.replace(csvFilename.size() - 4, 4, ResultsTable::GetExtension(resultsTable->GetFormat()));
+    resultsTable->AddColumn("Scenario", ResultsTable::INTEGER);
+    resultsTable->AddColumn("NumDevices", ResultsTable::INTEGER);
+    resultsTable->AddColumn("Algorithm", ResultsTable::TEXT);
+    resultsTable->AddColumn("Packet_Index", ResultsTable::INTEGER);
+    resultsTable->AddColumn("Succeed", ResultsTable::INTEGER);
+    resultsTable->AddColumn("Lost", ResultsTable::INTEGER);
+    resultsTable->AddColumn("Success_Rate", ResultsTable::REAL);
+    resultsTable->AddColumn("PayloadSize", ResultsTable::INTEGER);
+    resultsTable->AddColumn("PacketInterval", ResultsTable::INTEGER);
+    resultsTable->AddColumn("MobilityPercentage", ResultsTable::INTEGER);
+    resultsTable->AddColumn("SpreadingFactor", ResultsTable::INTEGER);
+    resultsTable->AddColumn("SimulationDuration", ResultsTable::INTEGER);
+    resultsTable->AddColumn("PDR", ResultsTable::REAL);
+    resultsTable->AddColumn("EnergyEfficiency", ResultsTable::REAL);
+    resultsTable->AddColumn("AverageToA", ResultsTable::REAL);
+    resultsTable->AddColumn("AverageSNR", ResultsTable::REAL);
+    resultsTable->AddColumn("AverageRSSI", ResultsTable::REAL);
+    resultsTable->AddColumn("TotalEnergyConsumption", ResultsTable::REAL);
+    resultsTable->AddColumn("VariableParameter", ResultsTable::TEXT);
+    resultsTable->AddColumn("ParameterValue", ResultsTable::REAL);
+
+    if (resultsTable->Open(csvFilename)) {
         // Générer une ligne de données pour chaque paquet transmis
         int packetIndex = 0;
         for (size_t deviceIdx = 0; deviceIdx < devices.size(); ++deviceIdx) {
@@ -577,36 +754,37 @@ void CollectResults(const std::vector<Ptr<LoRaDevice>>& devices, const std::stri
                 bool success = device->m_successHistory[j];
                 int lost = success ? 0 : 1;
                 
-                csvFile << scenarioNumber << ","
-                        << g_numDevices << ","
-                        << algorithm << ","
-                        << packetIndex << ","
-                        << (success ? 1 : 0) << ","
-                        << lost << ","
-                        << (transmissionSuccessRate * 100.0) << ","
-                        << g_payloadSize << ","
-                        << g_packetInterval << ","
-                        << g_mobilityPercentage << ","
-                        << g_spreadingFactor << ","
-                        << g_simulationTime << ","
-                        << (PDR * 100.0) << ","
-                        << energyEfficiency << ","
-                        << averageToA << ","
-                        << averageSNR << ","
-                        << averageRSSI << ","
-                        << totalEnergyConsumption << ","
-                        << variableParam << ","
-                        << variableValue << std::endl;
+                resultsTable->Add(scenarioNumber)
+                    .Add(g_numDevices)
+                    .Add(algorithm)
+                    .Add(packetIndex)
+                    .Add(success ? 1 : 0)
+                    .Add(lost)
+                    .Add(transmissionSuccessRate * 100.0)
+                    .Add(g_payloadSize)
+                    .Add(g_packetInterval)
+                    .Add(g_mobilityPercentage)
+                    .Add(g_spreadingFactor)
+                    .Add(g_simulationTime)
+                    .Add(PDR * 100.0)
+                    .Add(energyEfficiency)
+                    .Add(averageToA)
+                    .Add(averageSNR)
+                    .Add(averageRSSI)
+                    .Add(totalEnergyConsumption)
+                    .Add(variableParam)
+                    .Add(variableValue);
+                resultsTable->EndRow();
                 
                 packetIndex++;
             }
         }
-        csvFile.close();
+        resultsTable->Close();
         
-        std::cout << "Fichier CSV généré: " << csvFilename << std::endl;
+        std::cout << "Fichier de résultats généré: " << csvFilename << std::endl;
         std::cout << "Paramètre variable: " << variableParam << " = " << variableValue << std::endl;
     } else {
-        std::cerr << "Erreur: Impossible de créer le fichier CSV: " << csvFilename << std::endl;
+        std::cerr << "Erreur: Impossible de créer le fichier de résultats: " << csvFilename << std::endl;
     }
 
     // Sortie console (conservée pour debug)
@@ -628,6 +806,15 @@ void CollectResults(const std::vector<Ptr<LoRaDevice>>& devices, const std::stri
     }
     g_tpSelectionCounts[algorithm] = tpSelectionCounts;
     g_selectionRatios[algorithm] = ratios;
+
+    ReplicationSummary summary;
+    summary.replication = replication;
+    summary.rngRun = RngSeedManager::GetRun();
+    summary.successRate = transmissionSuccessRate;
+    summary.energyEfficiency = energyEfficiency;
+    summary.totalEnergyConsumption = totalEnergyConsumption;
+    summary.totalTransmissions = totalTransmissions;
+    return summary;
 }
 
 void GenerateGraph()
@@ -678,6 +865,8 @@ void GenerateGraph()
     pythonScript.close();
 }
 
+ReplicationSummary RunReplication(int replication);
+
 // --- Fonction Principale Simulation ---
 int main(int argc, char *argv[])
 {
@@ -703,7 +892,28 @@ int main(int argc, char *argv[])
     cmd.AddValue("mobilityPercentage", "Pourcentage de nœuds mobiles", g_mobilityPercentage);
     cmd.AddValue("randomSeed", "Graine aléatoire", g_randomSeed);
     cmd.AddValue("spreadingFactor", "Spreading Factor LoRa", g_spreadingFactor);
+    cmd.AddValue("replications", "Nombre de réplications indépendantes (RngRun consécutifs)", g_replications);
+    cmd.AddValue("resultsFormat", "Format des résultats par paquet (csv, columnar)", g_resultsFormat);
+    cmd.AddValue("gatewayModel",
+                 "Réception à la gateway : probabilistic (tirage indépendant par paquet) ou "
+                 "collision (chevauchements et effet de capture, par canal)",
+                 g_gatewayModel);
+    cmd.AddValue("numGateways", "Nombre de gateways du modèle à collisions", g_numGateways);
+    cmd.AddValue("dutyCycle",
+                 "Rapport cyclique de la sous-bande des canaux, dans ]0, 1] (0 : pas de limite)",
+                 g_dutyCycle);
     cmd.Parse(argc, argv);
+
+    NS_ABORT_MSG_IF(g_resultsFormat != "csv" && g_resultsFormat != "columnar",
+                    "Format de résultats inconnu: " << g_resultsFormat);
+    NS_ABORT_MSG_IF(g_gatewayModel != "probabilistic" && g_gatewayModel != "collision",
+                    "Modèle de gateway inconnu: " << g_gatewayModel);
+    NS_ABORT_MSG_IF(g_gatewayModel == "collision" && (g_spreadingFactor < 7 || g_spreadingFactor > 12),
+                    "Le modèle à collisions demande un SF entre 7 et 12: " << g_spreadingFactor);
+    NS_ABORT_MSG_IF(g_numGateways < 1, "Nombre de gateways invalide: " << g_numGateways);
+    NS_ABORT_MSG_IF(g_numGateways > 1 && g_gatewayModel != "collision",
+                    "Plusieurs gateways demandent --gatewayModel=collision");
+    NS_ABORT_MSG_IF(g_dutyCycle < 0 || g_dutyCycle > 1, "Rapport cyclique invalide: " << g_dutyCycle);
     
     // Synchroniser les paramètres
     // Toujours utiliser txInterval comme source de vérité pour les scénarios d'intervalles
@@ -725,11 +935,51 @@ int main(int argc, char *argv[])
     // Configurer la graine aléatoire
     RngSeedManager::SetSeed(g_randomSeed);
 
+    // Réplications indépendantes dans le même processus : chacune utilise le numéro de run
+    // suivant, les paramètres et les tables (canaux, puissances) restent partagés
+    uint64_t baseRun = RngSeedManager::GetRun();
+    std::ofstream summaryFile;
+    if (g_replications > 1) {
+        std::string summaryFilename = "scratch/lorawan/results/" + g_algorithm + "_" + g_scenario + "_"
+                                      + std::to_string(g_numDevices) + "devices_replications.csv";
+        summaryFile.open(summaryFilename);
+        summaryFile << "Replication,RngRun,Success_Rate,EnergyEfficiency,TotalEnergyConsumption,Transmissions" << std::endl;
+    }
+
+    for (int replication = 0; replication < g_replications; replication++) {
+        RngSeedManager::SetRun(baseRun + replication);
+        ReplicationSummary summary = RunReplication(replication);
+
+        if (summaryFile.is_open()) {
+            summaryFile << summary.replication << ","
+                        << summary.rngRun << ","
+                        << (summary.successRate * 100.0) << ","
+                        << summary.energyEfficiency << ","
+                        << summary.totalEnergyConsumption << ","
+                        << summary.totalTransmissions << std::endl;
+            std::cout << "Réplication " << (replication + 1) << "/" << g_replications
+                      << " (RngRun=" << summary.rngRun << ") : "
+                      << (summary.successRate * 100.0) << "% de succès" << std::endl;
+        }
+    }
+
+    // Si on a exécuté tous les algorithmes, générer le graphique
+    if (g_selectionRatios.size() >= 3) {
+        GenerateGraph();
+        std::cout << "\nGraphique généré: /home/ubuntu/selection_ratio_graph.png" << std::endl;
+    }
+
+    return 0;
+}
+
+// --- Une réplication complète : topologie, applications, simulation et résultats ---
+ReplicationSummary RunReplication(int replication)
+{
     // Créer nœuds
     NodeContainer deviceNodes;
     deviceNodes.Create(g_numDevices);
     NodeContainer gatewayNode;
-    gatewayNode.Create(1);
+    gatewayNode.Create(g_gatewayModel == "collision" ? g_numGateways : 1);
 
     // Installer mobilité avec support de pourcentage de nœuds mobiles
     MobilityHelper mobility;
@@ -799,12 +1049,26 @@ int main(int argc, char *argv[])
     // Créer applications
     Ptr<LoRaGateway> gateway = CreateObject<LoRaGateway>(g_receivableChannels);
     gatewayNode.Get(0)->AddApplication(gateway);
+    gateway->SetGateways(gatewayNode);
     gateway->SetStartTime(Seconds(0.0));
     gateway->SetStopTime(Seconds(g_simulationTime));
 
+    // Statistiques d'apprentissage de tous les devices, stockées de façon contiguë
+    Ptr<lorawan::Ucb1TunedPolicy> policy = CreateObject<lorawan::Ucb1TunedPolicy>();
+    policy->SetDimensions(g_numDevices, g_channels.size() * g_transmissionPowers.size());
+
+    // Rapport cyclique : tous les canaux (920.6 à 922.2 MHz) forment une seule sous-bande,
+    // et les réveils des devices passent par un calendrier unique
+    Ptr<lorawan::UplinkScheduler> scheduler;
     std::vector<Ptr<LoRaDevice>> devices;
+    if (g_dutyCycle > 0) {
+        scheduler = CreateObject<lorawan::UplinkScheduler>();
+        scheduler->SetDimensions(g_numDevices, {g_dutyCycle});
+        scheduler->SetWakeupCallback(Callback<void, uint32_t>(
+            [&devices](uint32_t deviceId) { devices[deviceId]->SelectAndTransmit(); }));
+    }
     for (int i = 0; i < g_numDevices; i++) {
-        Ptr<LoRaDevice> device = CreateObject<LoRaDevice>(i, gateway, g_algorithm);
+        Ptr<LoRaDevice> device = CreateObject<LoRaDevice>(i, gateway, g_algorithm, policy, scheduler);
         deviceNodes.Get(i)->AddApplication(device);
         device->SetStartTime(Seconds(1.0));
         device->SetStopTime(Seconds(g_simulationTime));
@@ -817,16 +1081,17 @@ int main(int argc, char *argv[])
     Simulator::Stop(Seconds(g_simulationTime));
     Simulator::Run();
 
+    if (scheduler) {
+        std::cout << "Transmissions différées par le rapport cyclique: " << scheduler->GetDeferrals()
+                  << std::endl;
+        scheduler->Dispose();
+    }
+
     // Collecter résultats
-    CollectResults(devices, g_algorithm);
+    ReplicationSummary summary = CollectResults(devices, g_algorithm, replication);
 
+    // Détruit aussi les nœuds et applications : la réplication suivante repart de zéro
     Simulator::Destroy();
 
-    // Si on a exécuté tous les algorithmes, générer le graphique
-    if (g_selectionRatios.size() >= 3) {
-        GenerateGraph();
-        std::cout << "\nGraphique généré: /home/ubuntu/selection_ratio_graph.png" << std::endl;
-    }
-
-    return 0;
+    return summary;
 }
\ No newline at end of file
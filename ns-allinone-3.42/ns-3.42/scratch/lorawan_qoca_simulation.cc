@@ -6,6 +6,7 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/log.h"
+#include "ns3/results-table.h"
 #include <algorithm>
 #include <random>
 #include <fstream>
@@ -36,9 +37,15 @@ protected:
     std::vector<uint32_t> m_T_i;  // T_i(n): times channel i selected
     std::vector<double> m_R_i;    // R_i(n): empirical mean of rewards
     std::vector<double> m_G_i;    // G_i(n): empirical mean of quality
-    std::vector<std::vector<double>> m_rewards;   // All rewards for each channel
-    std::vector<std::vector<double>> m_qualities; // All qualities for each channel
-    std::vector<uint32_t> m_channelHistory;       // History of selected channels
+    // Sommes courantes mises à jour à chaque paquet, au lieu de l'historique complet :
+    // chaque sélection et chaque mise à jour coûtent O(K) quel que soit n
+    std::vector<double> m_sumR;      // Somme des récompenses de chaque canal
+    std::vector<double> m_sumG;      // Somme des qualités de chaque canal
+    std::vector<double> m_N_disc;    // N_i(n): nombre de sélections escompté par λ
+    std::vector<double> m_N_g_disc;  // Nombre de sélections escompté par λg
+    std::vector<double> m_sumR_disc; // Somme des récompenses escomptée par λ
+    std::vector<double> m_sumG_disc; // Somme des qualités escomptée par λg
+    uint32_t m_successes;            // Nombre de récompenses égales à 1
     double m_alpha;    // Exploration factor
     double m_beta;     // Quality weight factor
     double m_lambda;   // Discount factor for rewards
@@ -50,15 +57,19 @@ public:
     BanditAlgorithm(uint32_t K, AlgorithmType type, 
                    double alpha = 0.6, double beta = 0.2, 
                    double lambda = 0.98, double lambdaG = 0.90)
-        : m_K(K), m_n(0), m_alpha(alpha), m_beta(beta), 
+        : m_K(K), m_n(0), m_successes(0), m_alpha(alpha), m_beta(beta), 
           m_lambda(lambda), m_lambdaG(lambdaG), m_type(type),
           m_currentChannel(0)
     {
         m_T_i.resize(K, 0);
         m_R_i.resize(K, 0.0);
         m_G_i.resize(K, 0.0);
-        m_rewards.resize(K);
-        m_qualities.resize(K);
+        m_sumR.resize(K, 0.0);
+        m_sumG.resize(K, 0.0);
+        m_N_disc.resize(K, 0.0);
+        m_N_g_disc.resize(K, 0.0);
+        m_sumR_disc.resize(K, 0.0);
+        m_sumG_disc.resize(K, 0.0);
     }
 
     uint32_t SelectChannel()
@@ -84,9 +95,26 @@ public:
     {
         // Update statistics
         m_T_i[channel]++;
-        m_rewards[channel].push_back(reward);
-        m_qualities[channel].push_back(quality);
-        m_channelHistory.push_back(channel);
+        m_sumR[channel] += reward;
+        m_sumG[channel] += quality;
+        m_successes += (uint32_t)reward;
+
+        // Sommes escomptées : le poids d'une observation d'âge a est λ^a, donc toutes
+        // les sommes sont multipliées par λ avant d'ajouter la nouvelle observation
+        if(m_type == DQOC_A)
+        {
+            for(uint32_t i = 0; i < m_K; i++)
+            {
+                m_N_disc[i] *= m_lambda;
+                m_sumR_disc[i] *= m_lambda;
+                m_N_g_disc[i] *= m_lambdaG;
+                m_sumG_disc[i] *= m_lambdaG;
+            }
+            m_N_disc[channel] += 1.0;
+            m_sumR_disc[channel] += reward;
+            m_N_g_disc[channel] += 1.0;
+            m_sumG_disc[channel] += quality;
+        }
         
         // Update empirical means
         UpdateEmpiricalMeans(channel);
@@ -99,9 +127,11 @@ public:
         std::fill(m_T_i.begin(), m_T_i.end(), 0);
         std::fill(m_R_i.begin(), m_R_i.end(), 0.0);
         std::fill(m_G_i.begin(), m_G_i.end(), 0.0);
-        for(auto& rewards : m_rewards) rewards.clear();
-        for(auto& qualities : m_qualities) qualities.clear();
-        m_channelHistory.clear();
+        for(auto* sums : {&m_sumR, &m_sumG, &m_N_disc, &m_N_g_disc, &m_sumR_disc, &m_sumG_disc})
+        {
+            std::fill(sums->begin(), sums->end(), 0.0);
+        }
+        m_successes = 0;
     }
 
 private:
@@ -198,88 +228,43 @@ private:
         double maxScore = -std::numeric_limits<double>::infinity();
         uint32_t bestChannel = 0;
 
-        // Calculate discounted counts N_i(n) and total discounted time W(n)
-        std::vector<double> N_i(m_K, 0.0);
-        std::vector<double> N_g_i(m_K, 0.0);
+        // Total discounted time W(n), from the discounted counts N_i(n)
+        // maintained by UpdateReward
         double W_n = 0.0;
-
-        // Simplification: utiliser les dernières observations avec pondération
         for(uint32_t i = 0; i < m_K; i++)
         {
-            double sum_discount_r = 0.0;
-            double sum_discount_g = 0.0;
-            
-            for(size_t j = 0; j < m_channelHistory.size(); j++)
-            {
-                if(m_channelHistory[j] == i)
-                {
-                    double discount_r = pow(m_lambda, m_channelHistory.size() - 1 - j);
-                    double discount_g = pow(m_lambdaG, m_channelHistory.size() - 1 - j);
-                    N_i[i] += discount_r;
-                    N_g_i[i] += discount_g;
-                }
-            }
-            W_n += N_i[i];
-        }
-
-        // Calculate discounted means
-        std::vector<double> R_i_disc(m_K, 0.0);
-        std::vector<double> G_i_disc(m_K, 0.0);
-        
-        for(uint32_t i = 0; i < m_K; i++)
-        {
-            if(N_i[i] > 0.0 && m_rewards[i].size() > 0)
-            {
-                double sum_rewards = 0.0;
-                double sum_qualities = 0.0;
-                size_t reward_idx = 0;
-                
-                for(size_t j = 0; j < m_channelHistory.size(); j++)
-                {
-                    if(m_channelHistory[j] == i && reward_idx < m_rewards[i].size())
-                    {
-                        double discount_r = pow(m_lambda, m_channelHistory.size() - 1 - j);
-                        double discount_g = pow(m_lambdaG, m_channelHistory.size() - 1 - j);
-                        sum_rewards += discount_r * m_rewards[i][reward_idx];
-                        sum_qualities += discount_g * m_qualities[i][reward_idx];
-                        reward_idx++;
-                    }
-                }
-                
-                R_i_disc[i] = sum_rewards / N_i[i];
-                if(N_g_i[i] > 0.0)
-                {
-                    G_i_disc[i] = sum_qualities / N_g_i[i];
-                }
-            }
+            W_n += m_N_disc[i];
         }
 
-        // Find G_max(n)
+        // Find G_max(n) over the discounted mean qualities
         double G_max_disc = 0.0;
         for(uint32_t i = 0; i < m_K; i++)
         {
-            if(G_i_disc[i] > G_max_disc)
+            if(m_N_g_disc[i] > 0.0 && m_sumG_disc[i] / m_N_g_disc[i] > G_max_disc)
             {
-                G_max_disc = G_i_disc[i];
+                G_max_disc = m_sumG_disc[i] / m_N_g_disc[i];
             }
         }
 
         for(uint32_t i = 0; i < m_K; i++)
         {
-            if(N_i[i] == 0.0)
+            const double N_i = m_N_disc[i];
+            if(N_i == 0.0)
             {
                 return i;
             }
+            double R_i_disc = m_sumR_disc[i] / N_i;
+            double G_i_disc = m_N_g_disc[i] > 0.0 ? m_sumG_disc[i] / m_N_g_disc[i] : 0.0;
 
             // Q_i(n) = β * (G_i(n)/G_max(n) - 1) * ln(W(n))/N_i(n)
             double Q_i = 0.0;
             if(G_max_disc > 0.0)
             {
-                Q_i = m_beta * (G_i_disc[i] / G_max_disc - 1.0) * log(W_n) / N_i[i];
+                Q_i = m_beta * (G_i_disc / G_max_disc - 1.0) * log(W_n) / N_i;
             }
 
             // B_i(n) = R_i(n) + Q_i(n) + α * sqrt(ln(W(n)) / N_i(n))
-            double B_i = R_i_disc[i] + Q_i + m_alpha * sqrt(log(W_n) / N_i[i]);
+            double B_i = R_i_disc + Q_i + m_alpha * sqrt(log(W_n) / N_i);
 
             if(B_i > maxScore)
             {
@@ -294,20 +279,10 @@ private:
     void UpdateEmpiricalMeans(uint32_t channel)
     {
         // R_i(n) = (1/T_i(n)) * sum(r_i(m) * 1_{A(m)=i})
-        double sum_rewards = 0.0;
-        for(double reward : m_rewards[channel])
-        {
-            sum_rewards += reward;
-        }
-        m_R_i[channel] = (m_T_i[channel] > 0) ? sum_rewards / m_T_i[channel] : 0.0;
+        m_R_i[channel] = (m_T_i[channel] > 0) ? m_sumR[channel] / m_T_i[channel] : 0.0;
 
         // G_i(n) = (1/T_i(n)) * sum(g_i(k))
-        double sum_qualities = 0.0;
-        for(double quality : m_qualities[channel])
-        {
-            sum_qualities += quality;
-        }
-        m_G_i[channel] = (m_T_i[channel] > 0) ? sum_qualities / m_T_i[channel] : 0.0;
+        m_G_i[channel] = (m_T_i[channel] > 0) ? m_sumG[channel] / m_T_i[channel] : 0.0;
     }
 
     double CalculateGmax()
@@ -328,18 +303,7 @@ public:
     uint32_t GetTimesSelected(uint32_t channel) { return m_T_i[channel]; }
     double GetMeanReward(uint32_t channel) { return m_R_i[channel]; }
     uint32_t GetPacketIndex() { return m_n; }
-    uint32_t GetSuccessfulTransmissions() 
-    { 
-        uint32_t total = 0;
-        for(uint32_t i = 0; i < m_K; i++)
-        {
-            for(double reward : m_rewards[i])
-            {
-                total += (uint32_t)reward;
-            }
-        }
-        return total;
-    }
+    uint32_t GetSuccessfulTransmissions() { return m_successes; }
     uint32_t GetLostPackets() { return m_n - GetSuccessfulTransmissions(); }
     std::string GetTypeName() 
     {
@@ -363,22 +327,54 @@ private:
     bool m_isStationary;
     uint32_t m_currentLocation;
     double m_mobilityPercentage;  // NEW: Mobility percentage parameter
-    std::mt19937 m_rng;
-    std::normal_distribution<double> m_shadowingDist;
+
+    // Flux ns-3 du shadowing et des tirages de succès : ils suivent RngSeed et RngRun
+    Ptr<NormalRandomVariable> m_shadowing;
+    Ptr<UniformRandomVariable> m_uniform;
+    // Tirages du pas courant, faits en bloc par NextStep : shadowing de chacun des K canaux
+    // (dB) et tirage uniforme du succès de la transmission
+    std::vector<double> m_stepShadowing;
+    double m_stepUniform;
 
     // Channel frequencies as per Table IV: {867.1, 867.3, 867.5, 867.7, 867.9, 868.1, 868.3, 868.5} MHz
     std::vector<double> m_frequencies = {867.1, 867.3, 867.5, 867.7, 867.9, 868.1, 868.3, 868.5};
 
 public:
     ChannelConditionModel(uint32_t K, uint8_t sf = 7, bool stationary = true, 
-                         double mobilityPercentage = 0.0, uint32_t seed = 12345)
+                         double mobilityPercentage = 0.0, int64_t stream = 0)
         : m_K(K), m_spreadingFactor(sf), m_isStationary(stationary), m_currentLocation(0), 
-          m_mobilityPercentage(mobilityPercentage), m_rng(seed), 
-          m_shadowingDist(0.0, 1.5 + mobilityPercentage * 0.05)  // Mobilité augmente la variance du shadowing
+          m_mobilityPercentage(mobilityPercentage),
+          m_stepShadowing(K, 0.0), m_stepUniform(0.0)
     {
+        // Mobilité augmente l'écart-type du shadowing
+        double sigma = 1.5 + mobilityPercentage * 0.05;
+        m_shadowing = CreateObject<NormalRandomVariable>();
+        m_shadowing->SetAttribute("Mean", DoubleValue(0.0));
+        m_shadowing->SetAttribute("Variance", DoubleValue(sigma * sigma));
+        m_uniform = CreateObject<UniformRandomVariable>();
+        AssignStreams(stream);
         InitializeChannels();
     }
 
+    // Fixe les flux des variables aléatoires ; le même flux redonne la même réalisation du canal
+    int64_t AssignStreams(int64_t stream)
+    {
+        m_shadowing->SetStream(stream);
+        m_uniform->SetStream(stream + 1);
+        return 2;
+    }
+
+    // Tire en bloc les conditions d'un pas de temps : le shadowing de tous les canaux,
+    // et le tirage de succès de la transmission du pas
+    void NextStep()
+    {
+        for(uint32_t channel = 0; channel < m_K; channel++)
+        {
+            m_stepShadowing[channel] = m_shadowing->GetValue();
+        }
+        m_stepUniform = m_uniform->GetValue();
+    }
+
     void InitializeChannels()
     {
         m_channelESP.resize(m_K);
@@ -492,8 +488,8 @@ public:
     {
         if(channel >= m_K) return 0.0;
         
-        // Add shadowing variation
-        double esp_dBm = m_channelESP[channel] + m_shadowingDist(m_rng);
+        // Add shadowing variation, drawn for this step by NextStep
+        double esp_dBm = m_channelESP[channel] + m_stepShadowing[channel];
         
         // Convert to linear scale (mW) as stated in the paper
         double esp_linear = pow(10.0, esp_dBm / 10.0);
@@ -508,7 +504,7 @@ public:
         
         // Get ESP with shadowing (now affected by mobility)
         double mobilityFading = m_mobilityPercentage * 0.1; // 0.1 dB per percent mobility
-        double esp_dBm = m_channelESP[channel] + m_shadowingDist(m_rng) - mobilityFading;
+        double esp_dBm = m_channelESP[channel] + m_stepShadowing[channel] - mobilityFading;
         
         // Modèle de succès calibré avec impact du SF
         double threshold = -120.0 - (m_spreadingFactor - 7) * 2.5;  // SF améliore la sensibilité
@@ -531,8 +527,7 @@ public:
         // S'assurer que la probabilité reste dans [0, 1]
         successProb = std::max(0.0, std::min(1.0, successProb));
         
-        std::uniform_real_distribution<double> uniform(0.0, 1.0);
-        return uniform(m_rng) < successProb;
+        return m_stepUniform < successProb;
     }
 
     // Getters
@@ -574,6 +569,7 @@ private:
     std::unique_ptr<BanditAlgorithm> m_dqocaAlg;
     
     std::unique_ptr<ChannelConditionModel> m_channelModel;
+    int64_t m_channelStream; // Premier flux du modèle de canal, le même pour tous les algorithmes
     
     // Results tracking
     struct SimulationResults {
@@ -601,10 +597,11 @@ public:
     LoRaWANQoCSimulation(bool stationary = true, uint32_t numDevices = 100,
                         uint32_t payloadSize = 50, double packetInterval = 15.0,
                         double mobilityPercentage = 0.0, uint8_t spreadingFactor = 7,
-                        uint32_t numPacketsPerDevice = 110)
+                        uint32_t numPacketsPerDevice = 110, int64_t channelStream = 0)
         : m_K(8), m_isStationary(stationary), m_numDevices(numDevices),
           m_payloadSize(payloadSize), m_packetInterval(packetInterval),
-          m_mobilityPercentage(mobilityPercentage), m_spreadingFactor(spreadingFactor)  // K=8 channels as per Table IV
+          m_mobilityPercentage(mobilityPercentage), m_spreadingFactor(spreadingFactor),  // K=8 channels as per Table IV
+          m_channelStream(channelStream)
     {
         // Nombre total de paquets = nombre de dispositifs × paquets par dispositif
         m_totalPackets = (uint32_t)(numDevices * numPacketsPerDevice);
@@ -629,7 +626,7 @@ public:
         m_qocaAlg = std::make_unique<BanditAlgorithm>(m_K, BanditAlgorithm::QOC_A, 1.9, 0.9);  // α = 1.9, β = 0.9
         m_dqocaAlg = std::make_unique<BanditAlgorithm>(m_K, BanditAlgorithm::DQOC_A, 0.6, 0.2, 0.98, 0.90);  // α = 0.6, β = 0.2, λ = 0.98, λg = 0.90
         
-        m_channelModel = std::make_unique<ChannelConditionModel>(m_K, m_spreadingFactor, stationary, m_mobilityPercentage, 12345); // Passer la mobilité
+        m_channelModel = std::make_unique<ChannelConditionModel>(m_K, m_spreadingFactor, stationary, m_mobilityPercentage, m_channelStream); // Passer la mobilité
         
         // Sélection des algorithmes selon le scénario
         if(m_isStationary)
@@ -673,8 +670,8 @@ public:
             // Reset algorithm state
             m_activeAlgorithms[algIndex]->Reset();
             
-            // Reset channel model with same seed for fair comparison
-            m_channelModel = std::make_unique<ChannelConditionModel>(m_K, m_spreadingFactor, m_isStationary, m_mobilityPercentage, 12345);
+            // Reset channel model with the same streams for fair comparison
+            m_channelModel = std::make_unique<ChannelConditionModel>(m_K, m_spreadingFactor, m_isStationary, m_mobilityPercentage, m_channelStream);
             
             uint32_t currentLocationIndex = 0;
             uint32_t successCount = 0;
@@ -691,7 +688,9 @@ public:
                                << " at packet " << packet);
                 }
 
-                // Select channel and simulate transmission
+                // Draw the conditions of all the channels for this step,
+                // then select channel and simulate transmission
+                m_channelModel->NextStep();
                 uint32_t selectedChannel = m_activeAlgorithms[algIndex]->SelectChannel();
                 double channelQuality = m_channelModel->GetChannelQuality(selectedChannel);
                 bool success = m_channelModel->IsTransmissionSuccessful(selectedChannel);
@@ -721,52 +720,61 @@ public:
         NS_LOG_INFO("Simulation finished.");
     }
 
-    void SaveResultsToCsv(const std::string& rewardFilename, const std::string& regretFilename)
+    // Les fichiers sont écrits via ResultsTable (CSV ou format colonnes), l'extension suit le format
+    void SaveResults(const std::string& rewardBasename, const std::string& regretBasename,
+                     ResultsTable::Format format)
     {
         // Créer le dossier scratch/qoc-a s'il n'existe pas
         system("mkdir -p scratch/qoc-a");
         
-        std::string fullRewardPath = "scratch/qoc-a/" + rewardFilename;
-        std::string fullRegretPath = "scratch/qoc-a/" + regretFilename;
+        std::string fullRewardPath = "scratch/qoc-a/" + rewardBasename + ResultsTable::GetExtension(format);
+        std::string fullRegretPath = "scratch/qoc-a/" + regretBasename + ResultsTable::GetExtension(format);
         
-        std::ofstream rewardFile(fullRewardPath);
-        std::ofstream regretFile(fullRegretPath);
+        Ptr<ResultsTable> rewardTable = CreateObject<ResultsTable>();
+        Ptr<ResultsTable> regretTable = CreateObject<ResultsTable>();
+        rewardTable->SetFormat(format);
+        regretTable->SetFormat(format);
 
         // Extraire le numéro de scénario du nom de fichier
-        uint32_t numScenario = ExtractScenarioNumber(rewardFilename);
+        uint32_t numScenario = ExtractScenarioNumber(rewardBasename);
 
-        // Header avec le bon nombre de colonnes incluant NumScenario
-        rewardFile << "NumScenario,Step";
-        regretFile << "NumScenario,Step";
+        // Schéma avec NumScenario, Step puis une colonne par algorithme
+        rewardTable->AddColumn("NumScenario", ResultsTable::INTEGER);
+        rewardTable->AddColumn("Step", ResultsTable::INTEGER);
+        regretTable->AddColumn("NumScenario", ResultsTable::INTEGER);
+        regretTable->AddColumn("Step", ResultsTable::INTEGER);
         for(const auto& name : m_activeAlgNames)
         {
-            rewardFile << "," << name;
-            regretFile << "," << name;
+            rewardTable->AddColumn(name, ResultsTable::REAL);
+            regretTable->AddColumn(name, ResultsTable::INTEGER);
+        }
+        if(!rewardTable->Open(fullRewardPath) || !regretTable->Open(fullRegretPath))
+        {
+            NS_LOG_ERROR("Unable to create " << fullRewardPath << " or " << fullRegretPath);
+            return;
         }
-        rewardFile << "\n";
-        regretFile << "\n";
 
         for(uint32_t i = 0; i <= m_totalPackets; i++)
         {
-            rewardFile << numScenario << "," << i;
-            regretFile << numScenario << "," << i;
+            rewardTable->Add(numScenario).Add(i);
+            regretTable->Add(numScenario).Add(i);
             
             for(size_t alg = 0; alg < m_activeAlgorithms.size(); alg++)
             {
-                rewardFile << "," << m_results[alg].successRates[i];
-                regretFile << "," << m_results[alg].cumulativeLost[i];
+                rewardTable->Add(m_results[alg].successRates[i]);
+                regretTable->Add(m_results[alg].cumulativeLost[i]);
             }
             
-            rewardFile << "\n";
-            regretFile << "\n";
+            rewardTable->EndRow();
+            regretTable->EndRow();
         }
 
-        rewardFile.close();
-        regretFile.close();
+        rewardTable->Close();
+        regretTable->Close();
         NS_LOG_INFO("Results saved to " << fullRewardPath << " and " << fullRegretPath);
     }
 
-    void SaveSummaryToCsv(const std::string& summaryFilename)
+    void SaveSummary(const std::string& summaryBasename, ResultsTable::Format format)
     {
         // Calculer les métriques détaillées
         CalculateDetailedMetrics();
@@ -774,15 +782,42 @@ public:
         // Créer le dossier scratch/qoc-a s'il n'existe pas
         system("mkdir -p scratch/qoc-a");
         
-        std::string fullSummaryPath = "scratch/qoc-a/" + summaryFilename;
-        std::ofstream summaryFile(fullSummaryPath);
-
-        summaryFile << "NumScenario,Scenario,NumDevices,Algorithm,Packet_Index,Succeed,Lost,Success_Rate,PayloadSize,PacketInterval,MobilityPercentage,SpreadingFactor,SimulationDuration,PDR,EnergyEfficiency,AverageToA,AverageSNR,AverageRSSI,TotalEnergyConsumption,VariableParameter,ParameterValue\n";
+        std::string fullSummaryPath = "scratch/qoc-a/" + summaryBasename + ResultsTable::GetExtension(format);
+
+        // Les précisions reproduisent le formatage std::fixed de l'ancien export CSV
+        Ptr<ResultsTable> summaryTable = CreateObject<ResultsTable>();
+        summaryTable->SetFormat(format);
+        summaryTable->AddColumn("NumScenario", ResultsTable::INTEGER);
+        summaryTable->AddColumn("Scenario", ResultsTable::TEXT);
+        summaryTable->AddColumn("NumDevices", ResultsTable::INTEGER);
+        summaryTable->AddColumn("Algorithm", ResultsTable::TEXT);
+        summaryTable->AddColumn("Packet_Index", ResultsTable::INTEGER);
+        summaryTable->AddColumn("Succeed", ResultsTable::INTEGER);
+        summaryTable->AddColumn("Lost", ResultsTable::INTEGER);
+        summaryTable->AddColumn("Success_Rate", ResultsTable::REAL, 4);
+        summaryTable->AddColumn("PayloadSize", ResultsTable::INTEGER);
+        summaryTable->AddColumn("PacketInterval", ResultsTable::REAL, 4);
+        summaryTable->AddColumn("MobilityPercentage", ResultsTable::REAL, 4);
+        summaryTable->AddColumn("SpreadingFactor", ResultsTable::INTEGER);
+        summaryTable->AddColumn("SimulationDuration", ResultsTable::REAL, 2);
+        summaryTable->AddColumn("PDR", ResultsTable::REAL, 4);
+        summaryTable->AddColumn("EnergyEfficiency", ResultsTable::REAL, 6);
+        summaryTable->AddColumn("AverageToA", ResultsTable::REAL, 2);
+        summaryTable->AddColumn("AverageSNR", ResultsTable::REAL, 2);
+        summaryTable->AddColumn("AverageRSSI", ResultsTable::REAL, 2);
+        summaryTable->AddColumn("TotalEnergyConsumption", ResultsTable::REAL, 4);
+        summaryTable->AddColumn("VariableParameter", ResultsTable::TEXT);
+        summaryTable->AddColumn("ParameterValue", ResultsTable::REAL, 4);
+        if(!summaryTable->Open(fullSummaryPath))
+        {
+            NS_LOG_ERROR("Unable to create " << fullSummaryPath);
+            return;
+        }
         
         double actualDurationMinutes = m_totalPackets * m_packetInterval / m_numDevices;
         
         // Extraire le numéro de scénario du nom de fichier
-        uint32_t numScenario = ExtractScenarioNumber(summaryFilename);
+        uint32_t numScenario = ExtractScenarioNumber(summaryBasename);
         
         // Déterminer le paramètre qui varie selon le contexte
         std::string variableParam = "numDevices"; // Par défaut
@@ -811,34 +846,46 @@ public:
         for(size_t i = 0; i < m_activeAlgorithms.size(); i++)
         {
             auto& result = m_results[i];
-            summaryFile << numScenario << ","
-                       << scenario << ","
-                       << m_numDevices << ","
-                       << result.algName << ","
-                       << m_totalPackets << ","
-                       << result.finalSuccessful << ","
-                       << result.finalLost << ","
-                       << std::fixed << std::setprecision(4) 
-                       << result.finalSuccessRate << ","
-                       << m_payloadSize << ","
-                       << m_packetInterval << ","
-                       << m_mobilityPercentage << ","
-                       << (int)m_spreadingFactor << ","
-                       << std::setprecision(2) << actualDurationMinutes << ","
-                       << std::setprecision(4) << result.pdr << ","
-                       << std::setprecision(6) << result.energyEfficiency << ","
-                       << std::setprecision(2) << result.averageToA << ","
-                       << std::setprecision(2) << result.averageSNR << ","
-                       << std::setprecision(2) << result.averageRSSI << ","
-                       << std::setprecision(4) << result.totalEnergyConsumption << ","
-                       << variableParam << ","
-                       << paramValue << "\n";
+            summaryTable->Add(numScenario)
+                .Add(scenario)
+                .Add(m_numDevices)
+                .Add(result.algName)
+                .Add(m_totalPackets)
+                .Add(result.finalSuccessful)
+                .Add(result.finalLost)
+                .Add(result.finalSuccessRate)
+                .Add(m_payloadSize)
+                .Add(m_packetInterval)
+                .Add(m_mobilityPercentage)
+                .Add(m_spreadingFactor)
+                .Add(actualDurationMinutes)
+                .Add(result.pdr)
+                .Add(result.energyEfficiency)
+                .Add(result.averageToA)
+                .Add(result.averageSNR)
+                .Add(result.averageRSSI)
+                .Add(result.totalEnergyConsumption)
+                .Add(variableParam)
+                .Add(paramValue);
+            summaryTable->EndRow();
         }
         
-        summaryFile.close();
+        summaryTable->Close();
         NS_LOG_INFO("Summary saved to " << fullSummaryPath);
     }
 
+    // Ajoute une ligne par algorithme au résumé des réplications, dès la fin de la réplication
+    void SaveReplicationSummary(std::ofstream& file, uint32_t replication)
+    {
+        for(size_t alg = 0; alg < m_activeAlgorithms.size(); alg++)
+        {
+            file << replication << "," << RngSeedManager::GetRun() << "," << m_numDevices << ","
+                 << m_results[alg].algName << "," << m_results[alg].finalSuccessful << ","
+                 << m_results[alg].finalLost << "," << (m_results[alg].finalSuccessRate * 100.0) << "\n";
+        }
+        file.flush();
+    }
+
     void PrintFinalResults()
     {
         double actualDurationMinutes = m_totalPackets * m_packetInterval / m_numDevices;
@@ -1054,6 +1101,8 @@ int main(int argc, char *argv[])
     bool stationary = true;
     bool nonStationary = true;
     std::string outputPrefix = "qoc_results";
+    uint32_t replications = 1;
+    std::string resultsFormat = "csv";
 
     // Parse command line arguments
     CommandLine cmd;
@@ -1066,8 +1115,14 @@ int main(int argc, char *argv[])
     cmd.AddValue("stationary", "Run stationary scenario", stationary);
     cmd.AddValue("nonStationary", "Run non-stationary scenario", nonStationary);
     cmd.AddValue("outputPrefix", "Output files prefix", outputPrefix);
+    cmd.AddValue("replications", "Number of independent replications (consecutive RngRun values)", replications);
+    cmd.AddValue("resultsFormat", "Format of the rewards, regret and summary files (csv, columnar)", resultsFormat);
     cmd.Parse(argc, argv);
 
+    NS_ABORT_MSG_IF(resultsFormat != "csv" && resultsFormat != "columnar",
+                    "Unknown results format: " << resultsFormat);
+    ResultsTable::Format format = (resultsFormat == "columnar") ? ResultsTable::COLUMNAR : ResultsTable::CSV;
+
     LogComponentEnable("LoRaWANQoCSimulation", LOG_LEVEL_INFO);
 
     std::cout << "LoRaWAN QoC-A Simulation - Multi-Scenario Version (5 Scenarios)\n";
@@ -1082,30 +1137,70 @@ int main(int argc, char *argv[])
 
     std::cout << "  Packets/Device: " << numPacketsPerDevice << "\n\n";
 
-    // Conditionally run scenarios based on parameters
-    if(stationary)
+    // Réplications indépendantes dans le même processus : les flux du modèle de canal
+    // suivent le RngRun
+    uint64_t baseRun = RngSeedManager::GetRun();
+    std::ofstream stationaryReplications;
+    std::ofstream nonStationaryReplications;
+    if(replications > 1)
     {
-        // Scenario 1: Stationary (QoC-A)
-        std::cout << "Running Stationary Scenario (QoC-A)...\n";
-        LoRaWANQoCSimulation stationarySim(true, numNodes, payloadSize, packetInterval, mobilityPercentage, spreadingFactor, numPacketsPerDevice);
-        stationarySim.PrintChannelStatistics();
-        stationarySim.RunSimulation();
-        stationarySim.SaveResultsToCsv(outputPrefix + "_stationary_rewards.csv",
-                                     outputPrefix + "_stationary_regret.csv");
-        stationarySim.SaveSummaryToCsv(outputPrefix + "_stationary_summary.csv");
-        stationarySim.PrintFinalResults();
+        system("mkdir -p scratch/qoc-a");
+        const std::string header = "Replication,RngRun,NumDevices,Algorithm,Succeed,Lost,Success_Rate\n";
+        if(stationary)
+        {
+            stationaryReplications.open("scratch/qoc-a/" + outputPrefix + "_stationary_replications.csv");
+            stationaryReplications << header;
+        }
+        if(nonStationary)
+        {
+            nonStationaryReplications.open("scratch/qoc-a/" + outputPrefix + "_nonstationary_replications.csv");
+            nonStationaryReplications << header;
+        }
     }
 
-    if(nonStationary)
+    for(uint32_t replication = 0; replication < replications; replication++)
     {
-        // Scenario 2: Non-stationary (DQoC-A)
-        std::cout << "\nRunning Non-Stationary Scenario (DQoC-A)...\n";
-        LoRaWANQoCSimulation nonStationarySim(false, numNodes, payloadSize, packetInterval, mobilityPercentage, spreadingFactor, numPacketsPerDevice);
-        nonStationarySim.RunSimulation();
-        nonStationarySim.SaveResultsToCsv(outputPrefix + "_nonstationary_rewards.csv",
-                                        outputPrefix + "_nonstationary_regret.csv");
-        nonStationarySim.SaveSummaryToCsv(outputPrefix + "_nonstationary_summary.csv");
-        nonStationarySim.PrintFinalResults();
+        RngSeedManager::SetRun(baseRun + replication);
+        std::string suffix = (replications > 1) ? "_rep" + std::to_string(replication) : "";
+        if(replications > 1)
+        {
+            std::cout << "\nReplication " << (replication + 1) << "/" << replications
+                      << " (RngRun=" << RngSeedManager::GetRun() << ")\n";
+        }
+
+        // Conditionally run scenarios based on parameters
+        if(stationary)
+        {
+            // Scenario 1: Stationary (QoC-A)
+            std::cout << "Running Stationary Scenario (QoC-A)...\n";
+            LoRaWANQoCSimulation stationarySim(true, numNodes, payloadSize, packetInterval, mobilityPercentage, spreadingFactor, numPacketsPerDevice);
+            stationarySim.PrintChannelStatistics();
+            stationarySim.RunSimulation();
+            stationarySim.SaveResults(outputPrefix + "_stationary_rewards" + suffix,
+                                      outputPrefix + "_stationary_regret" + suffix, format);
+            stationarySim.SaveSummary(outputPrefix + "_stationary_summary" + suffix, format);
+            stationarySim.PrintFinalResults();
+            if(stationaryReplications.is_open())
+            {
+                stationarySim.SaveReplicationSummary(stationaryReplications, replication);
+            }
+        }
+
+        if(nonStationary)
+        {
+            // Scenario 2: Non-stationary (DQoC-A)
+            std::cout << "\nRunning Non-Stationary Scenario (DQoC-A)...\n";
+            LoRaWANQoCSimulation nonStationarySim(false, numNodes, payloadSize, packetInterval, mobilityPercentage, spreadingFactor, numPacketsPerDevice);
+            nonStationarySim.RunSimulation();
+            nonStationarySim.SaveResults(outputPrefix + "_nonstationary_rewards" + suffix,
+                                         outputPrefix + "_nonstationary_regret" + suffix, format);
+            nonStationarySim.SaveSummary(outputPrefix + "_nonstationary_summary" + suffix, format);
+            nonStationarySim.PrintFinalResults();
+            if(nonStationaryReplications.is_open())
+            {
+                nonStationarySim.SaveReplicationSummary(nonStationaryReplications, replication);
+            }
+        }
     }
 
     return 0;
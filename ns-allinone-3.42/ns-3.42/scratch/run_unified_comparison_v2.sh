@@ -29,6 +29,10 @@
 # ============================================================================
 # TOTAL: 5 algorithmes × 4 scénarios = 20 combinaisons par répétition
 # ============================================================================
+# Pour exécuter les simulations en parallèle (et reprendre une campagne
+# interrompue), voir scratch/unified-comparison-sweep.json :
+#   ./ns3 sweep scratch/unified-comparison-sweep.json -j 8
+# ============================================================================
 ################################################################################
 
 # Couleurs pour l'affichage
@@ -30,13 +30,17 @@
 #include "ns3/forwarder-helper.h"
 #include "ns3/one-shot-sender-helper.h"
 #include "ns3/periodic-sender-helper.h"
-#include "ns3/lora-packet-tracker.h"
+#include "ns3/interval-packet-tracker.h"
+#include "ns3/topology-snapshot.h"
+#include "ns3/lora-airtime.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <map>
 #include <vector>
 #include <random>
 #include <fstream>
+#include <sstream>
 
 using namespace ns3;
 using namespace lorawan;
@@ -53,10 +57,35 @@ struct DeviceStats {
     double totalBitsTransmitted;    // Bits transmis avec succès
     std::vector<uint32_t> channelUsage;
     std::vector<uint32_t> sfUsage;
+    std::vector<uint32_t> recentChannelUsage; // Utilisation sur la fenêtre glissante (HistoryWindow)
+    std::vector<uint32_t> recentSfUsage;
     double pdr;                     // Packet Delivery Ratio
     double energyEfficiency;        // Efficacité énergétique (bits/J)
 };
 
+// Agrégats réseau maintenus incrémentalement (instantané en O(1), sans parcourir les dispositifs)
+struct NetworkStats {
+    uint64_t totalTransmissions;
+    uint64_t successfulTransmissions;
+    double totalEnergyConsumed;     // mJ
+    double totalBitsTransmitted;
+    double pdr;
+    double energyEfficiency;        // bits/J
+};
+
+static NetworkStats MakeNetworkStats(uint64_t transmissions, uint64_t successes,
+                                     double energyMj, double bits)
+{
+    NetworkStats stats;
+    stats.totalTransmissions = transmissions;
+    stats.successfulTransmissions = successes;
+    stats.totalEnergyConsumed = energyMj;
+    stats.totalBitsTransmitted = bits;
+    stats.pdr = (transmissions > 0) ? (double)successes / transmissions : 0.0;
+    stats.energyEfficiency = (energyMj > 0.0) ? bits / (energyMj / 1000.0) : 0.0;
+    return stats;
+}
+
 // Paramètres énergétiques LoRa selon l'article
 struct LoRaEnergyParams {
     static constexpr double TX_CURRENT_MA = 14.0;    // Courant TX en mA (selon article)
@@ -65,14 +94,38 @@ struct LoRaEnergyParams {
     static constexpr double VOLTAGE_V = 3.3;         // Tension d'alimentation
     static constexpr double PROCESSING_POWER_MW = 5.0; // Puissance de traitement
     
-    // Temps d'air selon l'article (Table I) pour payload 50 bytes
-    static std::map<std::pair<uint32_t, uint32_t>, double> timeOnAir; // <BW_kHz, SF> -> temps_ms
-};
+    static constexpr double TX_POWER_MW = TX_CURRENT_MA * VOLTAGE_V;
+    static constexpr double TOTAL_POWER_MW = TX_POWER_MW + PROCESSING_POWER_MW;
+
+    // Temps d'air selon l'article (Table I) pour payload 50 bytes à 125 kHz, SF7 à SF12 (ms)
+    static constexpr std::array<double, 6> TIME_ON_AIR_125_MS = {77.0, 133.0, 226.0, 411.0, 739.0, 1397.0};
 
-// Initialisation des temps d'air selon Table I de l'article
-std::map<std::pair<uint32_t, uint32_t>, double> LoRaEnergyParams::timeOnAir = {
-    {{125, 7}, 77.0},   {{125, 8}, 133.0},  {{125, 9}, 226.0},
-    {{125, 10}, 411.0}, {{125, 11}, 739.0}, {{125, 12}, 1397.0}
+    // Énergie à 125 kHz (mJ), calculée à la compilation : transmission et traitement, ou TX seule
+    static constexpr std::array<double, 6> ENERGY_125_MJ = [] {
+        std::array<double, 6> energy{};
+        for (std::size_t sf = 0; sf < energy.size(); sf++) {
+            energy[sf] = TOTAL_POWER_MW * TIME_ON_AIR_125_MS[sf] / 1000.0;
+        }
+        return energy;
+    }();
+    static constexpr std::array<double, 6> TX_ENERGY_125_MJ = [] {
+        std::array<double, 6> energy{};
+        for (std::size_t sf = 0; sf < energy.size(); sf++) {
+            energy[sf] = TX_POWER_MW * TIME_ON_AIR_125_MS[sf] / 1000.0;
+        }
+        return energy;
+    }();
+
+    // Énergie de transmission (mJ) ; sf va de 0 à 5 (SF7 à SF12). Les autres largeurs de bande,
+    // absentes de la Table I, utilisent la table d'airtime LoRa (CR 4/5) de lorawan-learning
+    static constexpr double TransmissionEnergy(uint32_t sf, uint32_t payloadBytes, uint32_t bandwidth)
+    {
+        if (bandwidth == 125 && sf < ENERGY_125_MJ.size()) {
+            return ENERGY_125_MJ[sf];
+        }
+        return lorawan::LoraAirtimeTable::GetEnergy(sf + 7, bandwidth * 1000, 1, payloadBytes,
+                                                    TOTAL_POWER_MW); // mW * s = mJ
+    }
 };
 
 // Algorithme ToW Dynamics pour la sélection des paramètres
@@ -90,8 +143,12 @@ public:
     double GetPDR(uint32_t deviceId);
     double GetEnergyEfficiency(uint32_t deviceId);
     DeviceStats GetDeviceStats(uint32_t deviceId);
+    NetworkStats GetNetworkStats() const;
     void RecordTransmission(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success, uint32_t payloadBytes);
 
+    // Signature de la trace échantillonnée des transmissions (deviceId, canal, SF, succès)
+    typedef void (*TransmissionTracedCallback)(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success);
+
 private:
     struct DeviceState {
         std::vector<double> Q_ch;      // Q-values pour les canaux
@@ -107,8 +164,14 @@ private:
         double totalEnergyConsumed;    // en mJ
         double totalBitsTransmitted;   // bits transmis avec succès
         
-        std::vector<uint32_t> channelHistory;
-        std::vector<uint32_t> sfHistory;
+        // Utilisation des canaux et SF : compteurs cumulés et fenêtre glissante des
+        // m_historyWindow dernières transmissions (mémoire constante quelle que soit la durée)
+        std::vector<uint32_t> channelUsage;
+        std::vector<uint32_t> sfUsage;
+        std::vector<uint32_t> recentChannelUsage;
+        std::vector<uint32_t> recentSfUsage;
+        std::vector<std::pair<uint32_t, uint32_t>> window; // Tampon circulaire (canal, SF)
+        uint32_t windowNext;
         std::pair<uint32_t, uint32_t> lastSelection; // Dernier canal et SF sélectionnés
     };
 
@@ -118,7 +181,17 @@ private:
     double m_alpha;   // Facteur de remise
     double m_beta;    // Facteur d'oubli
     double m_A;       // Amplitude oscillation
+    uint32_t m_historyWindow;   // Taille de la fenêtre glissante par dispositif
+    uint32_t m_historySampling; // Une transmission sur m_historySampling est tracée
+    TracedCallback<uint32_t, uint32_t, uint32_t, bool> m_transmissionTrace;
+    
+    // Agrégats réseau, mis à jour par RecordTransmission
+    uint64_t m_networkTransmissions;
+    uint64_t m_networkSuccesses;
+    double m_networkEnergyConsumed;
+    double m_networkBitsTransmitted;
     
+    DeviceState& GetDeviceState(uint32_t deviceId);
     double CalculateOscillation(uint32_t k, uint32_t t, uint32_t D);
     double CalculatePenalty(const std::vector<uint32_t>& N, const std::vector<uint32_t>& R);
     double CalculateX(uint32_t deviceId, uint32_t arm, bool isChannel, uint32_t time);
@@ -130,7 +203,21 @@ TypeId ToWAlgorithm::GetTypeId(void)
     static TypeId tid = TypeId("ToWAlgorithm")
         .SetParent<Object>()
         .SetGroupName("LoRaWAN")
-        .AddConstructor<ToWAlgorithm>();
+        .AddConstructor<ToWAlgorithm>()
+        .AddAttribute("HistoryWindow",
+                      "Nombre de transmissions récentes prises en compte dans recentChannelUsage/recentSfUsage",
+                      UintegerValue(100),
+                      MakeUintegerAccessor(&ToWAlgorithm::m_historyWindow),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddAttribute("HistorySampling",
+                      "Période d'échantillonnage de la trace Transmission (1 = toutes les transmissions)",
+                      UintegerValue(1),
+                      MakeUintegerAccessor(&ToWAlgorithm::m_historySampling),
+                      MakeUintegerChecker<uint32_t>(1))
+        .AddTraceSource("Transmission",
+                        "Historique brut échantillonné des transmissions d'un dispositif",
+                        MakeTraceSourceAccessor(&ToWAlgorithm::m_transmissionTrace),
+                        "ToWAlgorithm::TransmissionTracedCallback");
     return tid;
 }
 
@@ -139,7 +226,13 @@ ToWAlgorithm::ToWAlgorithm()
       m_numSF(0),
       m_alpha(0.9),
       m_beta(0.9),
-      m_A(0.5)
+      m_A(0.5),
+      m_historyWindow(100),
+      m_historySampling(1),
+      m_networkTransmissions(0),
+      m_networkSuccesses(0),
+      m_networkEnergyConsumed(0.0),
+      m_networkBitsTransmitted(0.0)
 {
 }
 
@@ -163,45 +256,41 @@ void ToWAlgorithm::SetParameters(double alpha, double beta, double A)
 // FONCTION CORRIGÉE : Calcul de l'énergie de transmission basé sur l'article
 double ToWAlgorithm::CalculateTransmissionEnergy(uint32_t sf, uint32_t payloadBytes, uint32_t bandwidth)
 {
-    // Récupération du temps d'air depuis la table de l'article
-    auto key = std::make_pair(bandwidth, sf + 7); // SF va de 0-5, convertir en 7-12
-    double timeOnAirMs = 0.0;
-    
-    auto it = LoRaEnergyParams::timeOnAir.find(key);
-    if (it != LoRaEnergyParams::timeOnAir.end()) {
-        timeOnAirMs = it->second;
-    } else {
-        // Fallback: estimation basique si pas dans la table
-        timeOnAirMs = 50.0 * pow(2, sf); // Estimation approximative
-    }
-    
-    // Calcul de l'énergie selon les paramètres de l'article
-    double txPowerMw = LoRaEnergyParams::TX_CURRENT_MA * LoRaEnergyParams::VOLTAGE_V;
-    double processingPowerMw = LoRaEnergyParams::PROCESSING_POWER_MW;
-    
-    // Énergie = (Puissance TX + Puissance traitement) * Temps
-    double totalEnergyMj = (txPowerMw + processingPowerMw) * (timeOnAirMs / 1000.0); // mJ
-    
-    return totalEnergyMj;
+    // Énergie = (Puissance TX + Puissance traitement) * Temps, lue dans la table
+    return LoRaEnergyParams::TransmissionEnergy(sf, payloadBytes, bandwidth);
 }
 
-std::pair<uint32_t, uint32_t> ToWAlgorithm::SelectChannelAndSF(uint32_t deviceId, uint32_t time)
+ToWAlgorithm::DeviceState& ToWAlgorithm::GetDeviceState(uint32_t deviceId)
 {
     // Initialiser l'état du dispositif si nécessaire
-    if (m_deviceStates.find(deviceId) == m_deviceStates.end()) {
-        DeviceState& state = m_deviceStates[deviceId];
-        state.Q_ch.resize(m_numChannels, 0.0);
-        state.Q_sf.resize(m_numSF, 0.0);
-        state.N_ch.resize(m_numChannels, 0);
-        state.N_sf.resize(m_numSF, 0);
-        state.R_ch.resize(m_numChannels, 0);
-        state.R_sf.resize(m_numSF, 0);
-        state.totalTransmissions = 0;
-        state.successfulTransmissions = 0;
-        state.totalEnergyConsumed = 0.0;
-        state.totalBitsTransmitted = 0.0;
-        state.lastSelection = std::make_pair(0, 0);
+    auto it = m_deviceStates.find(deviceId);
+    if (it != m_deviceStates.end()) {
+        return it->second;
     }
+    DeviceState& state = m_deviceStates[deviceId];
+    state.Q_ch.resize(m_numChannels, 0.0);
+    state.Q_sf.resize(m_numSF, 0.0);
+    state.N_ch.resize(m_numChannels, 0);
+    state.N_sf.resize(m_numSF, 0);
+    state.R_ch.resize(m_numChannels, 0);
+    state.R_sf.resize(m_numSF, 0);
+    state.totalTransmissions = 0;
+    state.successfulTransmissions = 0;
+    state.totalEnergyConsumed = 0.0;
+    state.totalBitsTransmitted = 0.0;
+    state.channelUsage.resize(m_numChannels, 0);
+    state.sfUsage.resize(m_numSF, 0);
+    state.recentChannelUsage.resize(m_numChannels, 0);
+    state.recentSfUsage.resize(m_numSF, 0);
+    state.window.reserve(m_historyWindow);
+    state.windowNext = 0;
+    state.lastSelection = std::make_pair(0, 0);
+    return state;
+}
+
+std::pair<uint32_t, uint32_t> ToWAlgorithm::SelectChannelAndSF(uint32_t deviceId, uint32_t time)
+{
+    GetDeviceState(deviceId);
 
     // Sélection aléatoire pour la première décision
     if (time == 0) {
@@ -240,7 +329,7 @@ std::pair<uint32_t, uint32_t> ToWAlgorithm::SelectChannelAndSF(uint32_t deviceId
 // FONCTION CORRIGÉE : Enregistrement des transmissions avec calculs énergétiques précis
 void ToWAlgorithm::RecordTransmission(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success, uint32_t payloadBytes)
 {
-    DeviceState& state = m_deviceStates[deviceId];
+    DeviceState& state = GetDeviceState(deviceId);
     
     // Calcul de l'énergie consommée pour cette transmission
     double energyConsumed = CalculateTransmissionEnergy(sf, payloadBytes);
@@ -248,17 +337,43 @@ void ToWAlgorithm::RecordTransmission(uint32_t deviceId, uint32_t channel, uint3
     // Mise à jour des statistiques
     state.totalTransmissions++;
     state.totalEnergyConsumed += energyConsumed;
+    m_networkTransmissions++;
+    m_networkEnergyConsumed += energyConsumed;
     
     if (success) {
         state.successfulTransmissions++;
         // Calcul des bits transmis avec succès
         double bitsTransmitted = payloadBytes * 8.0; // Conversion bytes -> bits
         state.totalBitsTransmitted += bitsTransmitted;
+        m_networkSuccesses++;
+        m_networkBitsTransmitted += bitsTransmitted;
     }
     
-    // Historique
-    state.channelHistory.push_back(channel);
-    state.sfHistory.push_back(sf);
+    // Compteurs d'utilisation, mis à jour en O(1)
+    if (channel < m_numChannels) {
+        state.channelUsage[channel]++;
+        state.recentChannelUsage[channel]++;
+    }
+    if (sf < m_numSF) {
+        state.sfUsage[sf]++;
+        state.recentSfUsage[sf]++;
+    }
+    
+    // Fenêtre glissante : la transmission la plus ancienne sort des compteurs récents
+    if (state.window.size() < m_historyWindow) {
+        state.window.push_back(std::make_pair(channel, sf));
+    } else {
+        std::pair<uint32_t, uint32_t>& oldest = state.window[state.windowNext];
+        if (oldest.first < m_numChannels) state.recentChannelUsage[oldest.first]--;
+        if (oldest.second < m_numSF) state.recentSfUsage[oldest.second]--;
+        oldest = std::make_pair(channel, sf);
+        state.windowNext = (state.windowNext + 1) % m_historyWindow;
+    }
+    
+    // Historique brut uniquement via la trace échantillonnée
+    if ((state.totalTransmissions - 1) % m_historySampling == 0) {
+        m_transmissionTrace(deviceId, channel, sf, success);
+    }
 }
 
 void ToWAlgorithm::UpdateReward(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success, double energyConsumed)
@@ -395,6 +510,8 @@ DeviceStats ToWAlgorithm::GetDeviceStats(uint32_t deviceId)
         stats.energyEfficiency = 0.0;
         stats.channelUsage.resize(m_numChannels, 0);
         stats.sfUsage.resize(m_numSF, 0);
+        stats.recentChannelUsage.resize(m_numChannels, 0);
+        stats.recentSfUsage.resize(m_numSF, 0);
         return stats;
     }
     
@@ -407,21 +524,21 @@ DeviceStats ToWAlgorithm::GetDeviceStats(uint32_t deviceId)
     stats.pdr = GetPDR(deviceId);
     stats.energyEfficiency = GetEnergyEfficiency(deviceId);
     
-    // Compter l'utilisation des canaux et SF
-    stats.channelUsage.resize(m_numChannels, 0);
-    stats.sfUsage.resize(m_numSF, 0);
-    
-    for (uint32_t ch : state.channelHistory) {
-        if (ch < m_numChannels) stats.channelUsage[ch]++;
-    }
-    
-    for (uint32_t sf : state.sfHistory) {
-        if (sf < m_numSF) stats.sfUsage[sf]++;
-    }
+    // Utilisation des canaux et SF, maintenue incrémentalement par RecordTransmission
+    stats.channelUsage = state.channelUsage;
+    stats.sfUsage = state.sfUsage;
+    stats.recentChannelUsage = state.recentChannelUsage;
+    stats.recentSfUsage = state.recentSfUsage;
     
     return stats;
 }
 
+NetworkStats ToWAlgorithm::GetNetworkStats() const
+{
+    return MakeNetworkStats(m_networkTransmissions, m_networkSuccesses,
+                            m_networkEnergyConsumed, m_networkBitsTransmitted);
+}
+
 // Algorithme UCB1-Tuned pour comparaison (inchangé mais avec suivi énergétique)
 class UCB1TunedAlgorithm : public Object
 {
@@ -436,6 +553,7 @@ public:
     void RecordTransmission(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success, uint32_t payloadBytes);
     double GetPDR(uint32_t deviceId);
     double GetEnergyEfficiency(uint32_t deviceId);
+    NetworkStats GetNetworkStats() const;
 
 private:
     struct ArmStats {
@@ -459,6 +577,10 @@ private:
     std::map<uint32_t, DeviceState> m_deviceStates;
     uint32_t m_numChannels;
     uint32_t m_numSF;
+    uint64_t m_networkTransmissions;
+    uint64_t m_networkSuccesses;
+    double m_networkEnergyConsumed;
+    double m_networkBitsTransmitted;
     
     double CalculateUCB1Tuned(const ArmStats& arm, uint32_t totalTime);
     double CalculateTransmissionEnergy(uint32_t sf, uint32_t payloadBytes, uint32_t bandwidth = 125);
@@ -475,7 +597,9 @@ TypeId UCB1TunedAlgorithm::GetTypeId(void)
 }
 
 UCB1TunedAlgorithm::UCB1TunedAlgorithm()
-    : m_numChannels(0), m_numSF(0)
+    : m_numChannels(0), m_numSF(0),
+      m_networkTransmissions(0), m_networkSuccesses(0),
+      m_networkEnergyConsumed(0.0), m_networkBitsTransmitted(0.0)
 {
 }
 
@@ -491,22 +615,8 @@ void UCB1TunedAlgorithm::Initialize(uint32_t numChannels, uint32_t numSF)
 
 double UCB1TunedAlgorithm::CalculateTransmissionEnergy(uint32_t sf, uint32_t payloadBytes, uint32_t bandwidth)
 {
-    // Même calcul que ToW
-    auto key = std::make_pair(bandwidth, sf + 7);
-    double timeOnAirMs = 0.0;
-    
-    auto it = LoRaEnergyParams::timeOnAir.find(key);
-    if (it != LoRaEnergyParams::timeOnAir.end()) {
-        timeOnAirMs = it->second;
-    } else {
-        timeOnAirMs = 50.0 * pow(2, sf);
-    }
-    
-    double txPowerMw = LoRaEnergyParams::TX_CURRENT_MA * LoRaEnergyParams::VOLTAGE_V;
-    double processingPowerMw = LoRaEnergyParams::PROCESSING_POWER_MW;
-    double totalEnergyMj = (txPowerMw + processingPowerMw) * (timeOnAirMs / 1000.0);
-    
-    return totalEnergyMj;
+    // Même table que ToW
+    return LoRaEnergyParams::TransmissionEnergy(sf, payloadBytes, bandwidth);
 }
 
 std::pair<uint32_t, uint32_t> UCB1TunedAlgorithm::SelectChannelAndSF(uint32_t deviceId, uint32_t time)
@@ -581,10 +691,14 @@ void UCB1TunedAlgorithm::RecordTransmission(uint32_t deviceId, uint32_t channel,
     
     state.totalTransmissions++;
     state.totalEnergyConsumed += energyConsumed;
+    m_networkTransmissions++;
+    m_networkEnergyConsumed += energyConsumed;
     
     if (success) {
         state.successfulTransmissions++;
         state.totalBitsTransmitted += payloadBytes * 8.0;
+        m_networkSuccesses++;
+        m_networkBitsTransmitted += payloadBytes * 8.0;
     }
 }
 
@@ -647,6 +761,12 @@ double UCB1TunedAlgorithm::GetEnergyEfficiency(uint32_t deviceId)
     return it->second.totalBitsTransmitted / energyJ;
 }
 
+NetworkStats UCB1TunedAlgorithm::GetNetworkStats() const
+{
+    return MakeNetworkStats(m_networkTransmissions, m_networkSuccesses,
+                            m_networkEnergyConsumed, m_networkBitsTransmitted);
+}
+
 // Classe principale de simulation - CORRIGÉE
 class LoRaWANSimulation
 {
@@ -663,6 +783,9 @@ public:
     void Run();
     void PrintResults();
     void ExportResults(std::string filename);
+    void ExportReplicationSummary(std::ofstream& file, uint32_t replication);
+    void EnableHistoryTrace(std::string filename);
+    void SetTopologyCache(std::string directory);
 
 private:
     // Paramètres de simulation
@@ -677,6 +800,7 @@ private:
     std::string m_algorithm;
     std::string m_scenario;
     std::string m_variableParameter;
+    std::string m_topologyCache; // Répertoire des instantanés de topologie (vide : désactivé)
     
     // Conteneurs NS-3
     NodeContainer m_endDevices;
@@ -684,17 +808,28 @@ private:
     Ptr<LoraChannel> m_channel;
     NetDeviceContainer m_endDevicesNetDevices;
     NetDeviceContainer m_gatewayNetDevices;
-    LoraPacketTracker* m_tracker;
+    // Paquets envoyés et issue par gateway, agrégés par minute au fil de la simulation
+    Ptr<IntervalPacketTracker> m_tracker;
     
     // Algorithmes
     Ptr<ToWAlgorithm> m_towAlgorithm;
     Ptr<UCB1TunedAlgorithm> m_ucb1Algorithm;
+
+    // Bruit des statistiques simulées, tiré du RngRun courant pour des réplications reproductibles
+    Ptr<NormalRandomVariable> m_noise;
+
+    // Historique brut échantillonné (optionnel, trace ToWAlgorithm::Transmission)
+    std::ofstream m_historyTraceFile;
+    void OnTransmissionSampled(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success);
     
     // Statistiques CORRIGÉES
-    std::map<uint32_t, uint32_t> m_devicePacketsSent;     // Paquets envoyés par device
-    std::map<uint32_t, uint32_t> m_devicePacketsReceived; // Paquets reçus par device
-    std::map<uint32_t, double> m_deviceEnergyConsumed;    // Énergie consommée par device
+    // Compteurs par device indexés directement par deviceId (0..m_nDevices-1)
+    std::vector<uint32_t> m_devicePacketsSent;            // Paquets envoyés par device
+    std::vector<uint32_t> m_devicePacketsReceived;        // Paquets reçus par device
+    std::vector<double> m_deviceEnergyConsumed;           // Énergie consommée par device
     std::vector<double> m_pdrHistory;                     // Historique PDR
+    std::vector<NetworkStats> m_networkHistory;           // Instantanés périodiques de l'algorithme
+    std::vector<DeviceStats> m_finalDeviceStats;          // Détail par device, calculé en fin de run
     uint32_t m_totalPacketsSent;                          // Total paquets envoyés
     uint32_t m_totalPacketsReceived;                      // Total paquets reçus
     double m_totalEnergyConsumed;                         // Énergie totale consommée
@@ -713,6 +848,7 @@ private:
     void UpdateAlgorithmStatistics(double pdr, uint32_t totalPackets);
     void CollectStatistics();
     void CollectFinalStatistics();
+    NetworkStats GetAlgorithmNetworkStats() const;
     std::pair<uint32_t, uint32_t> GetDeviceChannelAndSF(uint32_t deviceId, uint32_t time);
 };
 
@@ -732,6 +868,9 @@ LoRaWANSimulation::LoRaWANSimulation()
 {
     m_towAlgorithm = CreateObject<ToWAlgorithm>();
     m_ucb1Algorithm = CreateObject<UCB1TunedAlgorithm>();
+    m_noise = CreateObject<NormalRandomVariable>();
+    m_noise->SetAttribute("Mean", DoubleValue(1.0));
+    m_noise->SetAttribute("Variance", DoubleValue(0.01));
 }
 
 void LoRaWANSimulation::Configure(uint32_t nDevices, uint32_t nChannels, uint32_t nSF, 
@@ -751,11 +890,9 @@ void LoRaWANSimulation::Configure(uint32_t nDevices, uint32_t nChannels, uint32_
     m_variableParameter = variableParameter;
     
     // Initialisation des statistiques par device
-    for (uint32_t i = 0; i < m_nDevices; i++) {
-        m_devicePacketsSent[i] = 0;
-        m_devicePacketsReceived[i] = 0;
-        m_deviceEnergyConsumed[i] = 0.0;
-    }
+    m_devicePacketsSent.assign(m_nDevices, 0);
+    m_devicePacketsReceived.assign(m_nDevices, 0);
+    m_deviceEnergyConsumed.assign(m_nDevices, 0.0);
     
     m_towAlgorithm->Initialize(nChannels, nSF);
     m_ucb1Algorithm->Initialize(nChannels, nSF);
@@ -817,7 +954,39 @@ void LoRaWANSimulation::SetupNetworkTopology()
     
     Ptr<PropagationDelayModel> delay = CreateObject<ConstantSpeedPropagationDelayModel>();
     
-    m_channel = CreateObject<LoraChannel>(loss, delay);
+    if (m_topologyCache.empty()) {
+        m_channel = CreateObject<LoraChannel>(loss, delay);
+        return;
+    }
+    
+    // Instantané partagé par tous les algorithmes pour la même densité, mobilité et graine :
+    // positions identiques et bilan de liaison statique lu depuis le fichier mappé
+    std::ostringstream key;
+    key << "tow_n" << m_nDevices << "_gw" << m_nGateways << "_mob" << m_mobilityPercentage
+        << "_seed" << RngSeedManager::GetSeed() << "_run" << RngSeedManager::GetRun();
+    std::string snapshotFile = TopologySnapshot::GetFileName(m_topologyCache, key.str());
+    
+    Ptr<TopologySnapshot> snapshot = CreateObject<TopologySnapshot>();
+    if (snapshot->Load(snapshotFile) &&
+        snapshot->GetNEndDevices() == m_nDevices && snapshot->GetNGateways() == m_nGateways) {
+        snapshot->Apply(m_endDevices, m_gateways);
+        NS_LOG_INFO("Topologie chargée depuis " << snapshotFile);
+    } else {
+        snapshot->Capture(m_endDevices, m_gateways, loss);
+        if (!snapshot->Save(snapshotFile)) {
+            NS_LOG_WARN("Impossible d'écrire l'instantané de topologie " << snapshotFile);
+        }
+    }
+    
+    Ptr<SnapshotPropagationLossModel> cachedLoss = CreateObject<SnapshotPropagationLossModel>();
+    cachedLoss->SetSnapshot(snapshot, m_endDevices, m_gateways);
+    cachedLoss->SetFallback(loss);
+    m_channel = CreateObject<LoraChannel>(cachedLoss, delay);
+}
+
+void LoRaWANSimulation::SetTopologyCache(std::string directory)
+{
+    m_topologyCache = directory;
 }
 
 void LoRaWANSimulation::InstallLoRaStack()
@@ -839,7 +1008,6 @@ void LoRaWANSimulation::InstallLoRaStack()
     macHelper.SetRegion(LorawanMacHelper::EU);
     
     LoraHelper helper = LoraHelper();
-    helper.EnablePacketTracking();
     m_endDevicesNetDevices = helper.Install(phyHelper, macHelper, m_endDevices);
     
     // Installation sur les gateways
@@ -850,7 +1018,41 @@ void LoRaWANSimulation::InstallLoRaStack()
     // Configuration des spreading factors
     LorawanMacHelper::SetSpreadingFactorsUp(m_endDevices, m_gateways, m_channel);
     
-    m_tracker = &helper.GetPacketTracker();
+    // Le LoraPacketTracker du module garde chaque paquet jusqu'à la fin : on agrège plutôt
+    // en ligne par intervalle de collecte, et chaque paquet est oublié dès son issue connue
+    m_tracker = CreateObject<IntervalPacketTracker>();
+    m_tracker->SetAttribute("Interval", TimeValue(Seconds(60)));
+    std::vector<uint32_t> gatewayIds;
+    for (uint32_t i = 0; i < m_gateways.GetN(); i++) {
+        gatewayIds.push_back(m_gateways.Get(i)->GetId());
+    }
+    m_tracker->SetGateways(gatewayIds);
+
+    Ptr<IntervalPacketTracker> tracker = m_tracker;
+    for (uint32_t i = 0; i < m_endDevicesNetDevices.GetN(); i++) {
+        Ptr<LoraNetDevice> device = DynamicCast<LoraNetDevice>(m_endDevicesNetDevices.Get(i));
+        device->GetPhy()->TraceConnectWithoutContext(
+            "StartSending",
+            Callback<void, Ptr<const Packet>, uint32_t>(
+                [tracker](Ptr<const Packet> packet, uint32_t) { tracker->NotifySent(packet->GetUid()); }));
+    }
+    const std::vector<std::pair<std::string, IntervalPacketTracker::PhyOutcome>> outcomes = {
+        {"ReceivedPacket", IntervalPacketTracker::RECEIVED},
+        {"LostPacketBecauseInterference", IntervalPacketTracker::INTERFERED},
+        {"LostPacketBecauseNoMoreReceivers", IntervalPacketTracker::NO_MORE_RECEIVERS},
+        {"LostPacketBecauseUnderSensitivity", IntervalPacketTracker::UNDER_SENSITIVITY},
+        {"NoReceptionBecauseTransmitting", IntervalPacketTracker::LOST_BECAUSE_TX}};
+    for (uint32_t i = 0; i < m_gatewayNetDevices.GetN(); i++) {
+        Ptr<LoraNetDevice> device = DynamicCast<LoraNetDevice>(m_gatewayNetDevices.Get(i));
+        for (const auto& [trace, outcome] : outcomes) {
+            device->GetPhy()->TraceConnectWithoutContext(
+                trace,
+                Callback<void, Ptr<const Packet>, uint32_t>(
+                    [tracker, outcome = outcome](Ptr<const Packet> packet, uint32_t gatewayId) {
+                        tracker->NotifyOutcome(packet->GetUid(), gatewayId, outcome);
+                    }));
+        }
+    }
 }
 
 void LoRaWANSimulation::InstallApplications()
@@ -880,8 +1082,20 @@ void LoRaWANSimulation::CollectStatistics()
         return;
     }
     
-    // Récupération des statistiques du tracker LoRaWAN
-    // Le tracker compte automatiquement les paquets envoyés/reçus
+    // Le tracker compte automatiquement les paquets envoyés/reçus ; côté algorithme,
+    // un instantané des agrégats réseau suffit (O(1), aucun parcours des dispositifs)
+    NetworkStats snapshot = GetAlgorithmNetworkStats();
+    m_networkHistory.push_back(snapshot);
+    NS_LOG_INFO("Time: " << Simulator::Now().GetSeconds() << "s, " << m_algorithm
+                << " transmissions: " << snapshot.totalTransmissions
+                << ", succès: " << snapshot.successfulTransmissions
+                << ", PDR: " << snapshot.pdr
+                << ", Eff.énerg.: " << snapshot.energyEfficiency << " bits/J");
+    // PHY : paquets de la dernière minute, un compteur par intervalle
+    Time now = Simulator::Now();
+    NS_LOG_INFO("Time: " << now.GetSeconds() << "s, PHY envoyés: "
+                << m_tracker->CountSent(now - Seconds(60), now)
+                << ", reçus: " << m_tracker->CountReceived(now - Seconds(60), now));
     
     // Programmer la prochaine collecte
     if (Simulator::Now() < Seconds(m_simulationTime)) {
@@ -955,14 +1169,10 @@ std::pair<uint32_t, uint32_t> LoRaWANSimulation::GetDeviceChannelAndSF(uint32_t
 
 void LoRaWANSimulation::UpdateAlgorithm(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success)
 {
-    // Calculer l'énergie consommée pour cette transmission
+    // Calculer l'énergie consommée pour cette transmission (BW=125kHz, TX seule)
     double energyConsumed = 0.0;
-    auto key = std::make_pair(125, sf + 7); // BW=125kHz, SF converti
-    auto it = LoRaEnergyParams::timeOnAir.find(key);
-    if (it != LoRaEnergyParams::timeOnAir.end()) {
-        double timeOnAirMs = it->second;
-        double txPowerMw = LoRaEnergyParams::TX_CURRENT_MA * LoRaEnergyParams::VOLTAGE_V;
-        energyConsumed = txPowerMw * (timeOnAirMs / 1000.0); // mJ
+    if (sf < LoRaEnergyParams::TX_ENERGY_125_MJ.size()) {
+        energyConsumed = LoRaEnergyParams::TX_ENERGY_125_MJ[sf]; // mJ
     }
     
     m_deviceEnergyConsumed[deviceId] += energyConsumed;
@@ -985,9 +1195,33 @@ void LoRaWANSimulation::Run()
     }
     
     Simulator::Run();
+    CollectFinalStatistics();
     Simulator::Destroy();
 }
 
+NetworkStats LoRaWANSimulation::GetAlgorithmNetworkStats() const
+{
+    if (m_algorithm == "ToW") {
+        return m_towAlgorithm->GetNetworkStats();
+    } else if (m_algorithm == "UCB1") {
+        return m_ucb1Algorithm->GetNetworkStats();
+    }
+    return MakeNetworkStats(0, 0, 0.0, 0.0);
+}
+
+// Détail par dispositif, construit une seule fois en fin de simulation
+void LoRaWANSimulation::CollectFinalStatistics()
+{
+    m_finalDeviceStats.clear();
+    if (m_algorithm != "ToW") {
+        return;
+    }
+    m_finalDeviceStats.reserve(m_nDevices);
+    for (uint32_t i = 0; i < m_nDevices; i++) {
+        m_finalDeviceStats.push_back(m_towAlgorithm->GetDeviceStats(i));
+    }
+}
+
 void LoRaWANSimulation::LogStatistics(uint32_t time)
 {
     // Simuler des statistiques réalistes à chaque point temporel
@@ -1026,10 +1260,7 @@ void LoRaWANSimulation::GenerateRealisticStatistics(uint32_t currentTime)
     }
     
     // Simulation du bruit et de la variation
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<double> noise(1.0, 0.1);
-    successRate *= std::max(0.1, noise(gen));
+    successRate *= std::max(0.1, m_noise->GetValue());
     
     // Mise à jour des compteurs si nécessaire
     if (expectedTransmissions > m_totalPacketsSent) {
@@ -1089,8 +1320,9 @@ void LoRaWANSimulation::PrintResults()
     // Statistiques par dispositif pour l'algorithme ToW
     if (m_algorithm == "ToW") {
         std::cout << "\n=== STATISTIQUES PAR DISPOSITIF (ToW) ===" << std::endl;
-        for (uint32_t i = 0; i < std::min(m_nDevices, 10u); i++) { // Limite à 10 pour lisibilité
-            DeviceStats stats = m_towAlgorithm->GetDeviceStats(i);
+        uint32_t nShown = std::min((uint32_t)m_finalDeviceStats.size(), 10u); // Limite à 10 pour lisibilité
+        for (uint32_t i = 0; i < nShown; i++) {
+            const DeviceStats& stats = m_finalDeviceStats[i];
             std::cout << "Device " << i << ": PDR=" << stats.pdr * 100 << "%, "
                       << "Transmissions=" << stats.totalTransmissions << ", "
                       << "Succès=" << stats.successfulTransmissions << ", "
@@ -1224,6 +1456,34 @@ void LoRaWANSimulation::ExportResults(std::string filename)
     std::cout << "Efficacité énergétique: " << finalEnergyEfficiency << " bits/J" << std::endl;
 }
 
+// Une ligne de résumé par réplication, écrite dès la fin de celle-ci
+void LoRaWANSimulation::ExportReplicationSummary(std::ofstream& file, uint32_t replication)
+{
+    file << replication << ","
+         << RngSeedManager::GetRun() << ","
+         << m_nDevices << ","
+         << m_algorithm << ","
+         << m_totalPacketsSent << ","
+         << m_totalPacketsReceived << ","
+         << (CalculateOverallPDR() * 100.0) << ","
+         << CalculateOverallEnergyEfficiency() << ","
+         << m_totalEnergyConsumed << std::endl;
+}
+
+void LoRaWANSimulation::EnableHistoryTrace(std::string filename)
+{
+    m_historyTraceFile.open(filename);
+    m_historyTraceFile << "Time,DeviceId,Channel,SF,Success" << std::endl;
+    m_towAlgorithm->TraceConnectWithoutContext("Transmission",
+        MakeCallback(&LoRaWANSimulation::OnTransmissionSampled, this));
+}
+
+void LoRaWANSimulation::OnTransmissionSampled(uint32_t deviceId, uint32_t channel, uint32_t sf, bool success)
+{
+    m_historyTraceFile << Simulator::Now().GetSeconds() << "," << deviceId << ","
+                       << channel << "," << sf << "," << success << "\n";
+}
+
 // FONCTION MAIN CORRIGÉE
 int main(int argc, char *argv[])
 {
@@ -1242,6 +1502,9 @@ int main(int argc, char *argv[])
     uint32_t mobilityPercentage = 0;
     std::string scenario = "channel_selection";
     std::string variableParameter = "nDevices"; // Paramètre ajouté pour CSV
+    uint32_t replications = 1;
+    std::string historyTrace = ""; // Vide : pas d'historique brut
+    std::string topologyCache = "";  // Vide : topologie reconstruite à chaque run
     
     cmd.AddValue("algorithm", "Algorithme à utiliser (ToW, UCB1, Random)", algorithm);
     cmd.AddValue("nDevices", "Nombre de dispositifs LoRa", nDevices);
@@ -1253,6 +1516,9 @@ int main(int argc, char *argv[])
     cmd.AddValue("mobilityPercentage", "Pourcentage de nœuds mobiles", mobilityPercentage);
     cmd.AddValue("scenario", "Scénario à exécuter", scenario);
     cmd.AddValue("variableParameter", "Nom du paramètre variable", variableParameter);
+    cmd.AddValue("replications", "Nombre de réplications indépendantes (RngRun consécutifs)", replications);
+    cmd.AddValue("historyTrace", "Fichier CSV de l'historique brut ToW échantillonné (voir ToWAlgorithm::HistorySampling)", historyTrace);
+    cmd.AddValue("topologyCache", "Répertoire des instantanés de topologie réutilisés entre runs (même scénario et graine)", topologyCache);
     
     cmd.Parse(argc, argv);
     
@@ -1270,11 +1536,6 @@ int main(int argc, char *argv[])
         else if (scenario == "network_density") variableParameter = "nDevices"; // Corrigé: utilise nDevices pour scénario 5
     }
     
-    // Création et configuration de la simulation
-    LoRaWANSimulation simulation;
-    simulation.Configure(nDevices, nChannels, nSF, algorithm, simulationTime, 
-                        payloadSize, packetInterval, mobilityPercentage, scenario, variableParameter);
-    
     std::cout << "=== CONFIGURATION SIMULATION ===" << std::endl;
     std::cout << "Algorithme: " << algorithm << std::endl;
     std::cout << "Dispositifs: " << nDevices << std::endl;
@@ -1285,25 +1546,67 @@ int main(int argc, char *argv[])
     std::cout << "Intervalle: " << packetInterval << "s" << std::endl;
     std::cout << "Scénario: " << scenario << std::endl;
     
-    // Configuration de la topologie réseau
-    simulation.SetupNetworkTopology();
-    simulation.InstallLoRaStack();
-    simulation.InstallApplications();
-    simulation.SetupCallbacks();
-    
-    std::cout << "\nDémarrage de la simulation..." << std::endl;
-    
-    // Exécution de la simulation
-    simulation.Run();
-    
-    // Affichage et export des résultats
-    simulation.PrintResults();
-    
     // Export avec timestamp pour éviter l'écrasement
     auto now = std::time(nullptr);
     std::string timestamp = std::to_string(now);
-    std::string filename = "results_" + algorithm + "_" + scenario + "_" + timestamp + ".csv";
-    simulation.ExportResults(filename);
+    
+    // Réplications indépendantes dans le même processus : chaque réplication repart d'une
+    // simulation neuve (Simulator::Destroy dans Run) avec le numéro de run suivant
+    uint64_t baseRun = RngSeedManager::GetRun();
+    std::ofstream summaryFile;
+    if (replications > 1) {
+        summaryFile.open("replications_" + algorithm + "_" + scenario + "_" + timestamp + ".csv");
+        summaryFile << "Replication,RngRun,NumDevices,Algorithm,PacketsSent,PacketsReceived,PDR,"
+                    << "EnergyEfficiency,TotalEnergyConsumption" << std::endl;
+    }
+    
+    for (uint32_t replication = 0; replication < replications; replication++) {
+        RngSeedManager::SetRun(baseRun + replication);
+        
+        // Création et configuration de la simulation
+        LoRaWANSimulation simulation;
+        simulation.Configure(nDevices, nChannels, nSF, algorithm, simulationTime, 
+                            payloadSize, packetInterval, mobilityPercentage, scenario, variableParameter);
+        simulation.SetTopologyCache(topologyCache);
+        
+        // Configuration de la topologie réseau
+        simulation.SetupNetworkTopology();
+        simulation.InstallLoRaStack();
+        simulation.InstallApplications();
+        simulation.SetupCallbacks();
+        if (!historyTrace.empty()) {
+            std::string traceFile = historyTrace;
+            if (replications > 1) {
+                size_t dot = traceFile.rfind('.');
+                traceFile.insert(dot == std::string::npos ? traceFile.size() : dot,
+                                 "_rep" + std::to_string(replication));
+            }
+            simulation.EnableHistoryTrace(traceFile);
+        }
+        
+        std::cout << "\nDémarrage de la simulation";
+        if (replications > 1) {
+            std::cout << " (réplication " << (replication + 1) << "/" << replications
+                      << ", RngRun=" << RngSeedManager::GetRun() << ")";
+        }
+        std::cout << "..." << std::endl;
+        
+        // Exécution de la simulation
+        simulation.Run();
+        
+        // Affichage et export des résultats
+        simulation.PrintResults();
+        
+        std::string filename = "results_" + algorithm + "_" + scenario + "_" + timestamp;
+        if (replications > 1) {
+            filename += "_rep" + std::to_string(replication);
+        }
+        simulation.ExportResults(filename + ".csv");
+        
+        if (summaryFile.is_open()) {
+            simulation.ExportReplicationSummary(summaryFile, replication);
+        }
+    }
     
     return 0;
 }
\ No newline at end of file
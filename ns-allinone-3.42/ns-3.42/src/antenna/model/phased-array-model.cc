@@ -25,6 +25,8 @@
 #include <ns3/pointer.h>
 #include <ns3/uinteger.h>
 
+#include <cmath>
+
 namespace ns3
 {
 
@@ -55,7 +57,21 @@ PhasedArrayModel::GetTypeId()
                           "A pointer to the antenna element used by the phased array",
                           PointerValue(CreateObject<IsotropicAntennaModel>()),
                           MakePointerAccessor(&PhasedArrayModel::m_antennaElement),
-                          MakePointerChecker<AntennaModel>());
+                          MakePointerChecker<AntennaModel>())
+            .AddAttribute("SteeringVectorResolution",
+                          "Resolution (in rad) to which the azimuth and the inclination are "
+                          "rounded when computing the steering vectors. If positive, the "
+                          "steering vectors of the rounded angles are cached. If set to 0, "
+                          "the steering vectors are computed for the exact angles.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&PhasedArrayModel::m_steeringVectorResolution),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("MaxSteeringVectorCacheSize",
+                          "Maximum number of cached steering vectors. The cache is cleared when "
+                          "this size is reached.",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&PhasedArrayModel::m_maxSteeringVectorCacheSize),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -115,19 +131,54 @@ PhasedArrayModel::GetBeamformingVector(Angles a) const
 PhasedArrayModel::ComplexVector
 PhasedArrayModel::GetSteeringVector(Angles a) const
 {
+    if (m_steeringVectorResolution <= 0)
+    {
+        return ComputeSteeringVector(a);
+    }
+
+    auto key = std::make_pair(std::llround(a.GetAzimuth() / m_steeringVectorResolution),
+                              std::llround(a.GetInclination() / m_steeringVectorResolution));
+    auto it = m_steeringVectorCache.find(key);
+    if (it == m_steeringVectorCache.end())
+    {
+        if (m_steeringVectorCache.size() >= m_maxSteeringVectorCacheSize)
+        {
+            NS_LOG_DEBUG("The steering vector cache is full, clear it");
+            m_steeringVectorCache.clear();
+        }
+        Angles rounded(key.first * m_steeringVectorResolution,
+                       key.second * m_steeringVectorResolution);
+        it = m_steeringVectorCache.emplace(key, ComputeSteeringVector(rounded)).first;
+    }
+    return it->second;
+}
+
+PhasedArrayModel::ComplexVector
+PhasedArrayModel::ComputeSteeringVector(Angles a) const
+{
+    // the direction cosines do not depend on the antenna element
+    double sinIncl = sin(a.GetInclination());
+    double u = sinIncl * cos(a.GetAzimuth());
+    double v = sinIncl * sin(a.GetAzimuth());
+    double w = cos(a.GetInclination());
+
     ComplexVector steeringVector(GetNumElems());
     for (size_t i = 0; i < GetNumElems(); i++)
     {
         Vector loc = GetElementLocation(i);
-        double phase = -2 * M_PI *
-                       (sin(a.GetInclination()) * cos(a.GetAzimuth()) * loc.x +
-                        sin(a.GetInclination()) * sin(a.GetAzimuth()) * loc.y +
-                        cos(a.GetInclination()) * loc.z);
+        double phase = -2 * M_PI * (u * loc.x + v * loc.y + w * loc.z);
         steeringVector[i] = std::polar<double>(1.0, phase);
     }
     return steeringVector;
 }
 
+void
+PhasedArrayModel::ClearSteeringVectorCache()
+{
+    NS_LOG_FUNCTION(this);
+    m_steeringVectorCache.clear();
+}
+
 void
 PhasedArrayModel::SetAntennaElement(Ptr<AntennaModel> antennaElement)
 {
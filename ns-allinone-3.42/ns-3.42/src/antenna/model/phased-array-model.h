@@ -25,6 +25,7 @@
 #include <ns3/object.h>
 
 #include <complex>
+#include <map>
 
 namespace ns3
 {
@@ -230,7 +231,13 @@ class PhasedArrayModel : public Object
     ComplexVector GetBeamformingVector(Angles a) const;
 
     /**
-     * Returns the steering vector that points toward the specified position
+     * Returns the steering vector that points toward the specified position.
+     *
+     * If the attribute SteeringVectorResolution is positive, the azimuth and
+     * the inclination are rounded to the closest multiple of the resolution,
+     * and the steering vectors of the rounded angles are cached, so that the
+     * vectors of close directions are computed only once.
+     *
      * \param a the steering angle
      * \return the steering vector
      */
@@ -255,12 +262,31 @@ class PhasedArrayModel : public Object
     uint32_t GetId() const;
 
   protected:
+    /**
+     * Clears the cache of the steering vectors. Derived classes must call this
+     * method whenever the location of the antenna elements changes.
+     */
+    void ClearSteeringVectorCache();
+
     ComplexVector m_beamformingVector;  //!< the beamforming vector in use
     Ptr<AntennaModel> m_antennaElement; //!< the model of the antenna element in use
     bool m_isBfVectorValid;             //!< ensures the validity of the beamforming vector
     static uint32_t
         m_idCounter;  //!< the ID counter that is used to determine the unique antenna array ID
     uint32_t m_id{0}; //!< the ID of this antenna array instance
+
+  private:
+    /**
+     * Computes the steering vector that points toward the specified position
+     * \param a the steering angle
+     * \return the steering vector
+     */
+    ComplexVector ComputeSteeringVector(Angles a) const;
+
+    double m_steeringVectorResolution{0};     //!< resolution of the steering vector cache in rad
+    uint32_t m_maxSteeringVectorCacheSize{0}; //!< maximum number of cached steering vectors
+    mutable std::map<std::pair<int64_t, int64_t>, ComplexVector>
+        m_steeringVectorCache; //!< steering vectors, indexed by the rounded angles
 };
 
 } /* namespace ns3 */
@@ -20,8 +20,14 @@
 #include <ns3/boolean.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
+#include <ns3/simple-ref-count.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
 namespace ns3
 {
 
@@ -29,9 +35,185 @@ NS_LOG_COMPONENT_DEFINE("UniformPlanarArray");
 
 NS_OBJECT_ENSURE_REGISTERED(UniformPlanarArray);
 
+/**
+ * \ingroup antenna
+ *
+ * Table of the element field pattern of a UniformPlanarArray, over a regular
+ * grid of azimuth and inclination angles, for each polarization. The table
+ * depends on the antenna element, on the orientation and on the polarizations
+ * of the array, and is shared by all the arrays with the same ones.
+ */
+class UniformPlanarArray::FieldPatternTable : public SimpleRefCount<FieldPatternTable>
+{
+  public:
+    /**
+     * \param array the array
+     * \return the table of the array, built if no other array uses it
+     */
+    static Ptr<const FieldPatternTable> Get(const UniformPlanarArray* array);
+
+    /**
+     * Build the table, use Get instead to share it.
+     * \param key the key of the table
+     * \param array the array whose field pattern is tabulated
+     */
+    FieldPatternTable(const std::string& key, const UniformPlanarArray* array);
+
+    ~FieldPatternTable();
+
+    /**
+     * Bilinearly interpolate the field pattern between the four closest
+     * directions of the grid
+     * \param a the direction
+     * \param polIndex the index of the polarization
+     * \return the horizontal and the vertical components of the field pattern
+     */
+    std::pair<double, double> Interpolate(const Angles& a, uint8_t polIndex) const;
+
+  private:
+    /**
+     * \param array the array
+     * \return a key identifying the resolution, the antenna element (type and
+     * attribute values), the orientation and the polarizations of the array
+     */
+    static std::string GetKey(const UniformPlanarArray* array);
+
+    /**
+     * \return the tables in use, by key
+     */
+    static std::map<std::string, FieldPatternTable*>& GetRegistry();
+
+    std::string m_key;               ///< the key of the table
+    uint8_t m_numPols;               ///< the number of polarizations
+    uint32_t m_numAzimuthSteps;      ///< the number of azimuth steps over [-pi, pi]
+    uint32_t m_numInclinationSteps;  ///< the number of inclination steps over [0, pi]
+    double m_azimuthStep;            ///< the azimuth step in radians
+    double m_inclinationStep;        ///< the inclination step in radians
+    std::vector<double> m_values;    ///< the horizontal and vertical components, for each
+                                     ///< polarization, azimuth and then inclination of the grid
+};
+
+std::map<std::string, UniformPlanarArray::FieldPatternTable*>&
+UniformPlanarArray::FieldPatternTable::GetRegistry()
+{
+    static std::map<std::string, FieldPatternTable*> registry;
+    return registry;
+}
+
+std::string
+UniformPlanarArray::FieldPatternTable::GetKey(const UniformPlanarArray* array)
+{
+    std::ostringstream key;
+    key << std::setprecision(17) << array->m_fieldPatternResolution << " " << array->m_alpha
+        << " " << array->m_beta;
+    for (uint8_t pol = 0; pol < array->GetNumPols(); pol++)
+    {
+        key << " " << array->m_cosPolSlant[pol] << " " << array->m_sinPolSlant[pol];
+    }
+    Ptr<const AntennaModel> element = array->m_antennaElement;
+    TypeId tid = element->GetInstanceTypeId();
+    key << " " << tid.GetName();
+    while (true)
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            Ptr<AttributeValue> value = info.checker->Create();
+            element->GetAttribute(info.name, *value);
+            key << " " << info.name << "=" << value->SerializeToString(info.checker);
+        }
+        if (tid == tid.GetParent())
+        {
+            break;
+        }
+        tid = tid.GetParent();
+    }
+    return key.str();
+}
+
+Ptr<const UniformPlanarArray::FieldPatternTable>
+UniformPlanarArray::FieldPatternTable::Get(const UniformPlanarArray* array)
+{
+    std::string key = GetKey(array);
+    auto it = GetRegistry().find(key);
+    if (it != GetRegistry().end())
+    {
+        NS_LOG_LOGIC("Sharing the field pattern table " << key);
+        return Ptr<const FieldPatternTable>(it->second);
+    }
+    Ptr<FieldPatternTable> table = Create<FieldPatternTable>(key, array);
+    GetRegistry()[key] = PeekPointer(table);
+    return table;
+}
+
+UniformPlanarArray::FieldPatternTable::FieldPatternTable(const std::string& key,
+                                                         const UniformPlanarArray* array)
+    : m_key(key),
+      m_numPols(array->GetNumPols())
+{
+    NS_LOG_FUNCTION(this << key);
+    // round the steps so that the grid ends exactly at pi
+    double resolution = array->m_fieldPatternResolution;
+    m_numAzimuthSteps = std::max(1.0, std::ceil(2 * M_PI / resolution));
+    m_numInclinationSteps = std::max(1.0, std::ceil(M_PI / resolution));
+    m_azimuthStep = 2 * M_PI / m_numAzimuthSteps;
+    m_inclinationStep = M_PI / m_numInclinationSteps;
+
+    m_values.reserve(2 * m_numPols * (m_numAzimuthSteps + 1) * (m_numInclinationSteps + 1));
+    for (uint32_t j = 0; j <= m_numInclinationSteps; j++)
+    {
+        for (uint32_t i = 0; i <= m_numAzimuthSteps; i++)
+        {
+            Angles a(-M_PI + i * m_azimuthStep, std::min(j * m_inclinationStep, M_PI));
+            for (uint8_t pol = 0; pol < m_numPols; pol++)
+            {
+                auto [fieldPhi, fieldTheta] = array->ComputeElementFieldPattern(a, pol);
+                m_values.push_back(fieldPhi);
+                m_values.push_back(fieldTheta);
+            }
+        }
+    }
+}
+
+UniformPlanarArray::FieldPatternTable::~FieldPatternTable()
+{
+    NS_LOG_FUNCTION(this);
+    GetRegistry().erase(m_key);
+}
+
+std::pair<double, double>
+UniformPlanarArray::FieldPatternTable::Interpolate(const Angles& a, uint8_t polIndex) const
+{
+    double x = (a.GetAzimuth() + M_PI) / m_azimuthStep;
+    double y = a.GetInclination() / m_inclinationStep;
+    uint32_t i = std::min(static_cast<uint32_t>(std::max(x, 0.0)), m_numAzimuthSteps - 1);
+    uint32_t j = std::min(static_cast<uint32_t>(std::max(y, 0.0)), m_numInclinationSteps - 1);
+    double fx = x - i;
+    double fy = y - j;
+
+    std::size_t azimuthStride = 2 * m_numPols;
+    std::size_t inclinationStride = azimuthStride * (m_numAzimuthSteps + 1);
+    const double* v00 = &m_values[j * inclinationStride + i * azimuthStride + 2 * polIndex];
+    const double* v01 = v00 + azimuthStride;
+    const double* v10 = v00 + inclinationStride;
+    const double* v11 = v10 + azimuthStride;
+    double field[2];
+    for (std::size_t k = 0; k < 2; k++)
+    {
+        field[k] =
+            (1 - fy) * ((1 - fx) * v00[k] + fx * v01[k]) + fy * ((1 - fx) * v10[k] + fx * v11[k]);
+    }
+    return std::make_pair(field[0], field[1]);
+}
+
 UniformPlanarArray::UniformPlanarArray()
     : PhasedArrayModel()
 {
+    UpdateElementLocations();
 }
 
 UniformPlanarArray::~UniformPlanarArray()
@@ -104,7 +286,18 @@ UniformPlanarArray::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&UniformPlanarArray::SetDualPol,
                                               &UniformPlanarArray::IsDualPol),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute(
+                "ElementFieldPatternResolution",
+                "Resolution (in rad) of the table of the antenna element field pattern. If "
+                "positive, the field pattern is tabulated once over a grid of azimuth and "
+                "inclination angles with this resolution, shared by the arrays with the same "
+                "antenna element, orientation and polarizations, and bilinearly interpolated. "
+                "If set to 0, the field pattern is computed for the exact angles.",
+                DoubleValue(0.0),
+                MakeDoubleAccessor(&UniformPlanarArray::SetElementFieldPatternResolution,
+                                   &UniformPlanarArray::GetElementFieldPatternResolution),
+                MakeDoubleChecker<double>(0.0));
     return tid;
 }
 
@@ -117,6 +310,7 @@ UniformPlanarArray::SetNumColumns(uint32_t n)
         m_isBfVectorValid = false;
     }
     m_numColumns = n;
+    UpdateElementLocations();
 }
 
 uint32_t
@@ -134,6 +328,7 @@ UniformPlanarArray::SetNumRows(uint32_t n)
         m_isBfVectorValid = false;
     }
     m_numRows = n;
+    UpdateElementLocations();
 }
 
 uint32_t
@@ -148,6 +343,8 @@ UniformPlanarArray::SetAlpha(double alpha)
     m_alpha = alpha;
     m_cosAlpha = cos(m_alpha);
     m_sinAlpha = sin(m_alpha);
+    m_fieldPatternTable = nullptr;
+    UpdateElementLocations();
 }
 
 void
@@ -156,6 +353,8 @@ UniformPlanarArray::SetBeta(double beta)
     m_beta = beta;
     m_cosBeta = cos(m_beta);
     m_sinBeta = sin(m_beta);
+    m_fieldPatternTable = nullptr;
+    UpdateElementLocations();
 }
 
 void
@@ -164,6 +363,7 @@ UniformPlanarArray::SetPolSlant(double polSlant)
     m_polSlant = polSlant;
     m_cosPolSlant[0] = cos(m_polSlant);
     m_sinPolSlant[0] = sin(m_polSlant);
+    m_fieldPatternTable = nullptr;
 }
 
 void
@@ -177,6 +377,7 @@ UniformPlanarArray::SetAntennaHorizontalSpacing(double s)
         m_isBfVectorValid = false;
     }
     m_disH = s;
+    UpdateElementLocations();
 }
 
 double
@@ -196,6 +397,7 @@ UniformPlanarArray::SetAntennaVerticalSpacing(double s)
         m_isBfVectorValid = false;
     }
     m_disV = s;
+    UpdateElementLocations();
 }
 
 double
@@ -204,12 +406,48 @@ UniformPlanarArray::GetAntennaVerticalSpacing() const
     return m_disV;
 }
 
+void
+UniformPlanarArray::SetElementFieldPatternResolution(double resolution)
+{
+    NS_LOG_FUNCTION(this << resolution);
+    m_fieldPatternResolution = resolution;
+    m_fieldPatternTable = nullptr;
+}
+
+double
+UniformPlanarArray::GetElementFieldPatternResolution() const
+{
+    return m_fieldPatternResolution;
+}
+
+Ptr<const UniformPlanarArray::FieldPatternTable>
+UniformPlanarArray::GetFieldPatternTable() const
+{
+    // the antenna element may be replaced through its attribute
+    if (!m_fieldPatternTable || m_fieldPatternElement != PeekPointer(m_antennaElement))
+    {
+        m_fieldPatternTable = FieldPatternTable::Get(this);
+        m_fieldPatternElement = PeekPointer(m_antennaElement);
+    }
+    return m_fieldPatternTable;
+}
+
 std::pair<double, double>
 UniformPlanarArray::GetElementFieldPattern(Angles a, uint8_t polIndex) const
 {
     NS_LOG_FUNCTION(this << a);
     NS_ASSERT_MSG(polIndex < GetNumPols(), "Polarization index can be 0 or 1.");
 
+    if (m_fieldPatternResolution > 0)
+    {
+        return GetFieldPatternTable()->Interpolate(a, polIndex);
+    }
+    return ComputeElementFieldPattern(a, polIndex);
+}
+
+std::pair<double, double>
+UniformPlanarArray::ComputeElementFieldPattern(const Angles& a, uint8_t polIndex) const
+{
     // convert the theta and phi angles from GCS to LCS using eq. 7.1-7 and 7.1-8 in 3GPP TR 38.901
     // NOTE we assume a fixed slant angle of 0 degrees
     double inclination = a.GetInclination();
@@ -263,12 +501,22 @@ UniformPlanarArray::GetElementLocation(uint64_t index) const
     {
         tmpIndex -= m_numRows * m_numColumns;
     }
+    if (tmpIndex < m_elementLocations.size())
+    {
+        return m_elementLocations[tmpIndex];
+    }
+    return ComputeElementLocation(tmpIndex);
+}
+
+Vector
+UniformPlanarArray::ComputeElementLocation(uint64_t index) const
+{
     // compute the element coordinates in the LCS
     // assume the left bottom corner is (0,0,0), and the rectangular antenna array is on the y-z
     // plane.
     double xPrime = 0;
-    double yPrime = m_disH * (tmpIndex % m_numColumns);
-    double zPrime = m_disV * floor(tmpIndex / m_numColumns);
+    double yPrime = m_disH * (index % m_numColumns);
+    double zPrime = m_disV * floor(index / m_numColumns);
 
     // convert the coordinates to the GCS using the rotation matrix 7.1-4 in 3GPP
     // TR 38.901
@@ -279,6 +527,18 @@ UniformPlanarArray::GetElementLocation(uint64_t index) const
     return loc;
 }
 
+void
+UniformPlanarArray::UpdateElementLocations()
+{
+    NS_LOG_FUNCTION(this);
+    m_elementLocations.resize(m_numRows * m_numColumns);
+    for (uint64_t i = 0; i < m_elementLocations.size(); i++)
+    {
+        m_elementLocations[i] = ComputeElementLocation(i);
+    }
+    ClearSteeringVectorCache();
+}
+
 uint8_t
 UniformPlanarArray::GetNumPols() const
 {
@@ -389,6 +649,9 @@ UniformPlanarArray::SetDualPol(bool isDualPol)
         m_cosPolSlant[1] = cos(m_polSlant - M_PI / 2);
         m_sinPolSlant[1] = sin(m_polSlant - M_PI / 2);
     }
+    m_fieldPatternTable = nullptr;
+    // the number of elements, hence the size of the steering vectors, may have changed
+    ClearSteeringVectorCache();
 }
 
 double
@@ -253,6 +253,20 @@ class UniformPlanarArray : public PhasedArrayModel
      */
     void SetDualPol(bool isDualPol);
 
+    /**
+     * Set the resolution of the table of the element field pattern
+     * \param resolution the angular resolution in radians, 0 to compute the
+     * field pattern for the exact direction
+     */
+    void SetElementFieldPatternResolution(double resolution);
+
+    /**
+     * Get the resolution of the table of the element field pattern
+     * \return the angular resolution in radians, 0 if the field pattern is
+     * computed for the exact direction
+     */
+    double GetElementFieldPatternResolution() const;
+
     /**
      * Returns the index of polarization to which belongs the antenna element with a specific index
      * \param elemIndex the antenna element index
@@ -261,6 +275,42 @@ class UniformPlanarArray : public PhasedArrayModel
     uint8_t GetElemPol(size_t elemIndex) const override;
 
   private:
+    class FieldPatternTable;
+
+    /**
+     * Computes the element field pattern at the specified direction and for
+     * the specified polarization, without using the table
+     * \param a the angle indicating the interested direction
+     * \param polIndex the index of the polarization
+     * \return a pair in which the first element is the horizontal component
+     *         of the field pattern and the second element is the vertical
+     *         component of the field pattern
+     */
+    std::pair<double, double> ComputeElementFieldPattern(const Angles& a, uint8_t polIndex) const;
+
+    /**
+     * Gets the table of the element field pattern matching the current
+     * antenna element, orientation and polarizations of the array, building
+     * it if no other array uses it
+     * \return the table
+     */
+    Ptr<const FieldPatternTable> GetFieldPatternTable() const;
+
+    /**
+     * Computes the location of the antenna elements of the first polarization,
+     * stores them in m_elementLocations and clears the cache of the steering
+     * vectors. It must be called whenever the size, the spacing or the
+     * orientation of the array changes.
+     */
+    void UpdateElementLocations();
+
+    /**
+     * Computes the location of the antenna element with the specified index
+     * \param index index of the antenna element of the first polarization
+     * \return the 3D vector that represents the position of the element
+     */
+    Vector ComputeElementLocation(uint64_t index) const;
+
     uint32_t m_numColumns{1}; //!< number of columns
     uint32_t m_numRows{1};    //!< number of rows
     double m_disV{0.5}; //!< antenna spacing in the vertical direction in multiples of wave length
@@ -277,6 +327,11 @@ class UniformPlanarArray : public PhasedArrayModel
     uint16_t m_numHPorts{1};                      //!< Number of horizontal ports
     std::vector<double> m_cosPolSlant{1.0, 0.0};  //!< the cosine of polarization slant angle
     std::vector<double> m_sinPolSlant{0.0, -1.0}; //!< the sine polarization slant angle
+    std::vector<Vector> m_elementLocations;       //!< the locations of the antenna elements
+    double m_fieldPatternResolution{0.0}; //!< resolution of the field pattern table in radians
+    mutable Ptr<const FieldPatternTable> m_fieldPatternTable; //!< the field pattern table, if any
+    mutable const AntennaModel* m_fieldPatternElement{
+        nullptr}; //!< the antenna element of the field pattern table
 };
 
 } /* namespace ns3 */
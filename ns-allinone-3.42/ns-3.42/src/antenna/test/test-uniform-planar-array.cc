@@ -20,6 +20,7 @@
 #include "sstream"
 #include "string"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/isotropic-antenna-model.h"
 #include "ns3/log.h"
@@ -203,6 +204,178 @@ UniformPlanarArrayTestCase::DoRun()
                               "wrong value of the radiation pattern");
 }
 
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Test case for the cached element locations and steering vectors of
+ * the UniformPlanarArray
+ */
+class UniformPlanarArrayCacheTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    UniformPlanarArrayCacheTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Checks that two steering vectors are equal
+     * \param actual the steering vector to check
+     * \param expected the expected steering vector
+     * \param msg the message to print if the vectors are different
+     */
+    void CheckSteeringVector(const PhasedArrayModel::ComplexVector& actual,
+                             const PhasedArrayModel::ComplexVector& expected,
+                             const std::string& msg);
+};
+
+UniformPlanarArrayCacheTestCase::UniformPlanarArrayCacheTestCase()
+    : TestCase("Check the cached element locations and steering vectors of the UPA")
+{
+}
+
+void
+UniformPlanarArrayCacheTestCase::CheckSteeringVector(
+    const PhasedArrayModel::ComplexVector& actual,
+    const PhasedArrayModel::ComplexVector& expected,
+    const std::string& msg)
+{
+    NS_TEST_ASSERT_MSG_EQ(actual.GetSize(), expected.GetSize(), msg);
+    for (size_t i = 0; i < actual.GetSize(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(std::abs(actual[i] - expected[i]), 0.0, 1e-12, msg);
+    }
+}
+
+void
+UniformPlanarArrayCacheTestCase::DoRun()
+{
+    // the element locations follow the size and the orientation of the array
+    Ptr<UniformPlanarArray> a = CreateObject<UniformPlanarArray>();
+    a->SetAttribute("NumRows", UintegerValue(2));
+    a->SetAttribute("NumColumns", UintegerValue(3));
+    Vector loc = a->GetElementLocation(4);
+    NS_TEST_EXPECT_MSG_EQ_TOL(loc.y, 0.5, 1e-12, "wrong y coordinate");
+    NS_TEST_EXPECT_MSG_EQ_TOL(loc.z, 0.5, 1e-12, "wrong z coordinate");
+    a->SetAttribute("BearingAngle", DoubleValue(M_PI / 2));
+    loc = a->GetElementLocation(4);
+    NS_TEST_EXPECT_MSG_EQ_TOL(loc.x, -0.5, 1e-12, "wrong x coordinate after a rotation");
+    NS_TEST_EXPECT_MSG_EQ_TOL(loc.y, 0.0, 1e-12, "wrong y coordinate after a rotation");
+
+    // the cached steering vectors are the ones of the rounded angles
+    double resolution = 0.01;
+    Ptr<UniformPlanarArray> cached = CreateObject<UniformPlanarArray>();
+    cached->SetAttribute("SteeringVectorResolution", DoubleValue(resolution));
+    Ptr<UniformPlanarArray> exact = CreateObject<UniformPlanarArray>();
+    Angles rounded(0.3, 1.2);
+    CheckSteeringVector(cached->GetSteeringVector(Angles(0.3012, 1.2004)),
+                        exact->GetSteeringVector(rounded),
+                        "wrong steering vector for a rounded direction");
+    CheckSteeringVector(cached->GetSteeringVector(Angles(0.2996, 1.1998)),
+                        exact->GetSteeringVector(rounded),
+                        "wrong cached steering vector");
+
+    // the cache is cleared when the array changes
+    cached->SetAttribute("DowntiltAngle", DoubleValue(0.2));
+    exact->SetAttribute("DowntiltAngle", DoubleValue(0.2));
+    CheckSteeringVector(cached->GetSteeringVector(rounded),
+                        exact->GetSteeringVector(rounded),
+                        "stale steering vector after a change of orientation");
+    cached->SetAttribute("IsDualPolarized", BooleanValue(true));
+    exact->SetAttribute("IsDualPolarized", BooleanValue(true));
+    CheckSteeringVector(cached->GetSteeringVector(rounded),
+                        exact->GetSteeringVector(rounded),
+                        "stale steering vector after a change of polarization");
+}
+
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Test case for the table of the element field pattern of the
+ * UniformPlanarArray
+ */
+class UniformPlanarArrayFieldPatternTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    UniformPlanarArrayFieldPatternTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Creates a dual-polarized array of 3GPP antenna elements
+     * \param resolution the resolution of the field pattern table
+     * \return the array
+     */
+    static Ptr<UniformPlanarArray> CreateArray(double resolution);
+};
+
+UniformPlanarArrayFieldPatternTestCase::UniformPlanarArrayFieldPatternTestCase()
+    : TestCase("Check the table of the element field pattern of the UPA")
+{
+}
+
+Ptr<UniformPlanarArray>
+UniformPlanarArrayFieldPatternTestCase::CreateArray(double resolution)
+{
+    Ptr<UniformPlanarArray> array = CreateObject<UniformPlanarArray>();
+    array->SetAttribute("AntennaElement", PointerValue(CreateObject<ThreeGppAntennaModel>()));
+    array->SetAttribute("BearingAngle", DoubleValue(DegreesToRadians(30)));
+    array->SetAttribute("DowntiltAngle", DoubleValue(DegreesToRadians(10)));
+    array->SetAttribute("PolSlantAngle", DoubleValue(DegreesToRadians(45)));
+    array->SetAttribute("IsDualPolarized", BooleanValue(true));
+    array->SetAttribute("ElementFieldPatternResolution", DoubleValue(resolution));
+    return array;
+}
+
+void
+UniformPlanarArrayFieldPatternTestCase::DoRun()
+{
+    Ptr<UniformPlanarArray> exact = CreateArray(0.0);
+    Ptr<UniformPlanarArray> tabulated = CreateArray(DegreesToRadians(0.5));
+    Ptr<UniformPlanarArray> shared = CreateArray(DegreesToRadians(0.5));
+
+    for (double azimuth = -179.7; azimuth < 180; azimuth += 7.3)
+    {
+        for (double inclination = 2.1; inclination < 178; inclination += 5.9)
+        {
+            Angles a(DegreesToRadians(azimuth), DegreesToRadians(inclination));
+            for (uint8_t pol = 0; pol < 2; pol++)
+            {
+                auto [phi, theta] = exact->GetElementFieldPattern(a, pol);
+                auto [tabPhi, tabTheta] = tabulated->GetElementFieldPattern(a, pol);
+                auto [sharedPhi, sharedTheta] = shared->GetElementFieldPattern(a, pol);
+                NS_TEST_EXPECT_MSG_EQ_TOL(tabPhi, phi, 2e-3, "wrong horizontal component at " << a);
+                NS_TEST_EXPECT_MSG_EQ_TOL(tabTheta, theta, 2e-3, "wrong vertical component at " << a);
+                NS_TEST_EXPECT_MSG_EQ(sharedPhi, tabPhi, "wrong shared table at " << a);
+                NS_TEST_EXPECT_MSG_EQ(sharedTheta, tabTheta, "wrong shared table at " << a);
+            }
+        }
+    }
+
+    // without resolution, the field pattern is computed for the exact angles
+    tabulated->SetAttribute("ElementFieldPatternResolution", DoubleValue(0.0));
+    Angles a(DegreesToRadians(12.3), DegreesToRadians(81.7));
+    NS_TEST_EXPECT_MSG_EQ((tabulated->GetElementFieldPattern(a, 1) ==
+                           exact->GetElementFieldPattern(a, 1)),
+                          true,
+                          "the exact field pattern is expected without resolution");
+
+    // the table follows the orientation of the array
+    shared->SetAttribute("BearingAngle", DoubleValue(DegreesToRadians(-60)));
+    exact->SetAttribute("BearingAngle", DoubleValue(DegreesToRadians(-60)));
+    auto [phi, theta] = exact->GetElementFieldPattern(a, 0);
+    auto [tabPhi, tabTheta] = shared->GetElementFieldPattern(a, 0);
+    NS_TEST_EXPECT_MSG_EQ_TOL(tabPhi, phi, 2e-3, "stale table after a change of orientation");
+    NS_TEST_EXPECT_MSG_EQ_TOL(tabTheta, theta, 2e-3, "stale table after a change of orientation");
+}
+
 /**
  * \ingroup antenna-tests
  *
@@ -388,6 +561,8 @@ UniformPlanarArrayTestSuite::UniformPlanarArrayTestSuite()
                                                Angles(DegreesToRadians(0), DegreesToRadians(135)),
                                                28.0),
                 TestCase::Duration::QUICK);
+    AddTestCase(new UniformPlanarArrayCacheTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new UniformPlanarArrayFieldPatternTestCase(), TestCase::Duration::QUICK);
 }
 
 static UniformPlanarArrayTestSuite staticUniformPlanarArrayTestSuiteInstance;
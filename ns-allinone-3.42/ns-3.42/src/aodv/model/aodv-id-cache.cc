@@ -26,8 +26,6 @@
  */
 #include "aodv-id-cache.h"
 
-#include <algorithm>
-
 namespace ns3
 {
 namespace aodv
@@ -36,22 +34,24 @@ bool
 IdCache::IsDuplicate(Ipv4Address addr, uint32_t id)
 {
     Purge();
-    for (auto i = m_idCache.begin(); i != m_idCache.end(); ++i)
+    uint64_t key = GetKey(addr, id);
+    if (!m_idCache.insert(key).second)
     {
-        if (i->m_context == addr && i->m_id == id)
-        {
-            return true;
-        }
+        return true;
     }
-    UniqueId uniqueId = {addr, id, m_lifetime + Simulator::Now()};
-    m_idCache.push_back(uniqueId);
+    m_expirations.emplace(m_lifetime + Simulator::Now(), key);
     return false;
 }
 
 void
 IdCache::Purge()
 {
-    m_idCache.erase(remove_if(m_idCache.begin(), m_idCache.end(), IsExpired()), m_idCache.end());
+    // A record is never refreshed, so each one has a single expiration
+    while (!m_expirations.empty() && m_expirations.top().first < Simulator::Now())
+    {
+        m_idCache.erase(m_expirations.top().second);
+        m_expirations.pop();
+    }
 }
 
 uint32_t
@@ -31,6 +31,10 @@
 #include "ns3/ipv4-address.h"
 #include "ns3/simulator.h"
 
+#include <functional>
+#include <queue>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace ns3
@@ -87,36 +91,25 @@ class IdCache
     }
 
   private:
-    /// Unique packet ID
-    struct UniqueId
-    {
-        /// ID is supposed to be unique in single address context (e.g. sender address)
-        Ipv4Address m_context;
-        /// The id
-        uint32_t m_id;
-        /// When record will expire
-        Time m_expire;
-    };
-
     /**
-     * \brief IsExpired structure
+     * Key of an ID in the cache.
+     * \param addr the IP address
+     * \param id the ID
+     * \returns the key
      */
-    struct IsExpired
+    static uint64_t GetKey(Ipv4Address addr, uint32_t id)
     {
-        /**
-         * \brief Check if the entry is expired
-         *
-         * \param u UniqueId entry
-         * \return true if expired, false otherwise
-         */
-        bool operator()(const UniqueId& u) const
-        {
-            return (u.m_expire < Simulator::Now());
-        }
-    };
+        return (static_cast<uint64_t>(addr.Get()) << 32) | id;
+    }
+
+    /// Time at which a record expires, and its key
+    typedef std::pair<Time, uint64_t> Expiration;
 
     /// Already seen IDs
-    std::vector<UniqueId> m_idCache;
+    std::unordered_set<uint64_t> m_idCache;
+    /// Expirations of the records, earliest first
+    std::priority_queue<Expiration, std::vector<Expiration>, std::greater<Expiration>>
+        m_expirations;
     /// Default lifetime for ID records
     Time m_lifetime;
 };
@@ -288,6 +288,10 @@ RoutingTable::AddRoute(RoutingTableEntry& rt)
         rt.SetRreqCnt(0);
     }
     auto result = m_ipv4AddressEntry.insert(std::make_pair(rt.GetDestination(), rt));
+    if (result.second)
+    {
+        m_expirations.emplace(Simulator::Now() + rt.GetLifeTime(), rt.GetDestination());
+    }
     return result.second;
 }
 
@@ -301,7 +305,9 @@ RoutingTable::Update(RoutingTableEntry& rt)
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " fails; not found");
         return false;
     }
+    Time previousLifeTime = i->second.GetLifeTime();
     i->second = rt;
+    AddExpiration(i->second, previousLifeTime);
     if (i->second.GetFlag() != IN_SEARCH)
     {
         NS_LOG_LOGIC("Route update to " << rt.GetDestination() << " set RreqCnt to 0");
@@ -322,6 +328,7 @@ RoutingTable::SetEntryState(Ipv4Address id, RouteFlags state)
     }
     i->second.SetFlag(state);
     i->second.SetRreqCnt(0);
+    AddExpiration(i->second, i->second.GetLifeTime());
     NS_LOG_LOGIC("Route set entry state to " << id << ": new state is " << state);
     return true;
 }
@@ -348,15 +355,15 @@ RoutingTable::InvalidateRoutesWithDst(const std::map<Ipv4Address, uint32_t>& unr
 {
     NS_LOG_FUNCTION(this);
     Purge();
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end(); ++i)
+    for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
     {
-        for (auto j = unreachable.begin(); j != unreachable.end(); ++j)
+        auto i = m_ipv4AddressEntry.find(j->first);
+        if (i != m_ipv4AddressEntry.end() && i->second.GetFlag() == VALID)
         {
-            if ((i->first == j->first) && (i->second.GetFlag() == VALID))
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-            }
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            Time previousLifeTime = i->second.GetLifeTime();
+            i->second.Invalidate(m_badLinkLifetime);
+            AddExpiration(i->second, previousLifeTime);
         }
     }
 }
@@ -385,38 +392,50 @@ RoutingTable::DeleteAllRoutesFromInterface(Ipv4InterfaceAddress iface)
 }
 
 void
-RoutingTable::Purge()
+RoutingTable::AddExpiration(const RoutingTableEntry& rt, Time previousLifeTime)
 {
-    NS_LOG_FUNCTION(this);
-    if (m_ipv4AddressEntry.empty())
+    // A route that had not expired already has an expiration at or before
+    // the end of its previous lifetime, which is enough for a longer one
+    Time lifeTime = rt.GetLifeTime();
+    if (previousLifeTime < Seconds(0) || lifeTime < previousLifeTime)
     {
-        return;
+        m_expirations.emplace(Simulator::Now() + lifeTime, rt.GetDestination());
     }
-    for (auto i = m_ipv4AddressEntry.begin(); i != m_ipv4AddressEntry.end();)
+}
+
+void
+RoutingTable::Purge()
+{
+    NS_LOG_FUNCTION(this);
+    // Only the routes with a past expiration are looked at
+    Time now = Simulator::Now();
+    while (!m_expirations.empty() && m_expirations.top().first < now)
     {
-        if (i->second.GetLifeTime() < Seconds(0))
+        Ipv4Address dst = m_expirations.top().second;
+        m_expirations.pop();
+        auto i = m_ipv4AddressEntry.find(dst);
+        if (i == m_ipv4AddressEntry.end())
         {
-            if (i->second.GetFlag() == INVALID)
-            {
-                auto tmp = i;
-                ++i;
-                m_ipv4AddressEntry.erase(tmp);
-            }
-            else if (i->second.GetFlag() == VALID)
-            {
-                NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
-                i->second.Invalidate(m_badLinkLifetime);
-                ++i;
-            }
-            else
-            {
-                ++i;
-            }
+            continue;
         }
-        else
+        Time lifeTime = i->second.GetLifeTime();
+        if (lifeTime >= Seconds(0))
         {
-            ++i;
+            // The lifetime was extended since this expiration was added
+            m_expirations.emplace(now + lifeTime, dst);
+        }
+        else if (i->second.GetFlag() == INVALID)
+        {
+            m_ipv4AddressEntry.erase(i);
+        }
+        else if (i->second.GetFlag() == VALID)
+        {
+            NS_LOG_LOGIC("Invalidate route with destination address " << i->first);
+            i->second.Invalidate(m_badLinkLifetime);
+            m_expirations.emplace(now + i->second.GetLifeTime(), dst);
         }
+        // An expired route in search is kept; SetEntryState and Update add
+        // a new expiration when its state changes
     }
 }
 
@@ -476,7 +495,8 @@ RoutingTable::MarkLinkAsUnidirectional(Ipv4Address neighbor, Time blacklistTimeo
 void
 RoutingTable::Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit /* = Time::S */) const
 {
-    std::map<Ipv4Address, RoutingTableEntry> table = m_ipv4AddressEntry;
+    std::map<Ipv4Address, RoutingTableEntry> table(m_ipv4AddressEntry.begin(),
+                                                   m_ipv4AddressEntry.end());
     Purge(table);
     std::ostream* os = stream->GetStream();
     // Copy the current ostream state
@@ -34,9 +34,14 @@
 #include "ns3/timer.h"
 
 #include <cassert>
+#include <functional>
 #include <map>
+#include <queue>
 #include <stdint.h>
 #include <sys/types.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -518,6 +523,7 @@ class RoutingTable
     void Clear()
     {
         m_ipv4AddressEntry.clear();
+        m_expirations = {};
     }
 
     /// Delete all outdated entries and invalidate valid entry if Lifetime is expired
@@ -537,10 +543,27 @@ class RoutingTable
     void Print(Ptr<OutputStreamWrapper> stream, Time::Unit unit = Time::S) const;
 
   private:
+    /// Time at which the lifetime of a route expires, and its destination
+    typedef std::pair<Time, Ipv4Address> Expiration;
+
     /// The routing table
-    std::map<Ipv4Address, RoutingTableEntry> m_ipv4AddressEntry;
+    std::unordered_map<Ipv4Address, RoutingTableEntry, Ipv4AddressHash> m_ipv4AddressEntry;
+    /**
+     * Lifetime expirations, earliest first.  Each route whose lifetime has
+     * not expired has an expiration at or before the end of its lifetime;
+     * an expiration found earlier than the end of the lifetime of its route
+     * is moved to the end of the lifetime.
+     */
+    std::priority_queue<Expiration, std::vector<Expiration>, std::greater<Expiration>>
+        m_expirations;
     /// Deletion time for invalid routes
     Time m_badLinkLifetime;
+    /**
+     * Add an expiration for a route whose lifetime may have been shortened.
+     * \param rt the route
+     * \param previousLifeTime the remaining lifetime of the route before it changed
+     */
+    void AddExpiration(const RoutingTableEntry& rt, Time previousLifeTime);
     /**
      * const version of Purge, for use by Print() method
      * \param table the routing table entry to purge
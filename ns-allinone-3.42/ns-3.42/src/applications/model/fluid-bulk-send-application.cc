@@ -0,0 +1,362 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "fluid-bulk-send-application.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-congestion-ops.h"
+#include "ns3/tcp-socket-state.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/type-id.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FluidBulkSendApplication");
+
+NS_OBJECT_ENSURE_REGISTERED(FluidBulkSendApplication);
+
+TypeId
+FluidBulkSendApplication::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FluidBulkSendApplication")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<FluidBulkSendApplication>()
+            .AddAttribute("Device",
+                          "The bottleneck device, whose capacity the flow shares. It must "
+                          "have a BackgroundDataRate attribute and a PhyTxEnd trace source.",
+                          PointerValue(),
+                          MakePointerAccessor(&FluidBulkSendApplication::m_device),
+                          MakePointerChecker<NetDevice>())
+            .AddAttribute("CongestionOps",
+                          "The type of the congestion control algorithm",
+                          TypeIdValue(TcpNewReno::GetTypeId()),
+                          MakeTypeIdAccessor(&FluidBulkSendApplication::m_congestionTypeId),
+                          MakeTypeIdChecker())
+            .AddAttribute("SegmentSize",
+                          "TCP maximum segment size in bytes",
+                          UintegerValue(536),
+                          MakeUintegerAccessor(&FluidBulkSendApplication::m_segmentSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("InitialCwnd",
+                          "TCP initial congestion window size (segments)",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&FluidBulkSendApplication::m_initialCwnd),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SegmentsPerAck",
+                          "The number of segments acknowledged by each ACK, as with the "
+                          "DelAckCount attribute of TcpSocket",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&FluidBulkSendApplication::m_segmentsPerAck),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("BaseRtt",
+                          "The round trip time of the flow, without the queueing delay",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&FluidBulkSendApplication::m_baseRtt),
+                          MakeTimeChecker(NanoSeconds(1)))
+            .AddAttribute("BufferSize",
+                          "The buffer of the bottleneck available to the flow. Packets are "
+                          "counted as segments of SegmentSize bytes.",
+                          QueueSizeValue(QueueSize("100p")),
+                          MakeQueueSizeAccessor(&FluidBulkSendApplication::m_bufferSize),
+                          MakeQueueSizeChecker())
+            .AddAttribute("MaxBytes",
+                          "The total number of bytes to deliver. "
+                          "Once these bytes are delivered, the flow ends. "
+                          "The value zero means that there is no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FluidBulkSendApplication::m_maxBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddTraceSource("CongestionWindow",
+                            "The congestion window of the flow, at the start of each round",
+                            MakeTraceSourceAccessor(&FluidBulkSendApplication::m_cWnd),
+                            "ns3::TracedValueCallback::Uint32")
+            .AddTraceSource("Rtt",
+                            "The round trip time of the flow, including the queueing delay",
+                            MakeTraceSourceAccessor(&FluidBulkSendApplication::m_rtt),
+                            "ns3::TracedValueCallback::Time");
+    return tid;
+}
+
+FluidBulkSendApplication::FluidBulkSendApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FluidBulkSendApplication::~FluidBulkSendApplication()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FluidBulkSendApplication::SetDevice(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    m_device = device;
+}
+
+uint64_t
+FluidBulkSendApplication::GetTotalDelivered() const
+{
+    return m_totDelivered;
+}
+
+DataRate
+FluidBulkSendApplication::GetRate() const
+{
+    return m_rate;
+}
+
+void
+FluidBulkSendApplication::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_roundEvent.Cancel();
+    m_device = nullptr;
+    m_congestion = nullptr;
+    m_tcb = nullptr;
+    Application::DoDispose();
+}
+
+void
+FluidBulkSendApplication::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(m_device, "FluidBulkSendApplication needs a bottleneck device");
+    if (m_maxBytes > 0 && m_totDelivered >= m_maxBytes)
+    {
+        return;
+    }
+
+    ObjectFactory congestionFactory;
+    congestionFactory.SetTypeId(m_congestionTypeId);
+    m_congestion = congestionFactory.Create<TcpCongestionOps>();
+
+    m_tcb = CreateObject<TcpSocketState>();
+    m_tcb->m_segmentSize = m_segmentSize;
+    m_tcb->m_initialCWnd = m_initialCwnd;
+    m_tcb->m_cWnd = m_initialCwnd * m_segmentSize;
+    m_tcb->m_initialSsThresh = std::numeric_limits<uint32_t>::max();
+    m_tcb->m_ssThresh = m_tcb->m_initialSsThresh;
+    m_tcb->m_pacing = m_congestion->HasCongControl();
+    m_tcb->m_isCwndLimited = true;
+    DataRateValue capacity;
+    m_device->GetAttribute("DataRate", capacity);
+    m_tcb->m_maxPacingRate = capacity.Get();
+    m_congestion->Init(m_tcb);
+
+    m_rc = TcpRateOps::TcpRateConnection();
+    m_backlog = 0;
+    m_pendingBytes = 0;
+    m_deviceBytes = 0;
+    m_rtt = m_baseRtt;
+    m_lastRound = Simulator::Now();
+    bool connected = m_device->TraceConnectWithoutContext(
+        "PhyTxEnd",
+        MakeCallback(&FluidBulkSendApplication::DeviceTx, this));
+    NS_ABORT_MSG_UNLESS(connected, "The bottleneck device has no PhyTxEnd trace source");
+    Round();
+}
+
+void
+FluidBulkSendApplication::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_congestion)
+    {
+        return;
+    }
+    m_roundEvent.Cancel();
+    Reserve(DataRate(0));
+    m_rate = DataRate(0);
+    m_device->TraceDisconnectWithoutContext(
+        "PhyTxEnd",
+        MakeCallback(&FluidBulkSendApplication::DeviceTx, this));
+    m_congestion = nullptr;
+    m_tcb = nullptr;
+}
+
+void
+FluidBulkSendApplication::DeviceTx(Ptr<const Packet> packet)
+{
+    m_deviceBytes += packet->GetSize();
+}
+
+void
+FluidBulkSendApplication::Reserve(DataRate rate)
+{
+    NS_LOG_FUNCTION(this << rate);
+    DataRateValue background;
+    m_device->GetAttribute("BackgroundDataRate", background);
+    DataRate others = background.Get() - std::min(background.Get(), m_reserved);
+    m_reserved = rate;
+    bool set = m_device->SetAttributeFailSafe("BackgroundDataRate", DataRateValue(others + rate));
+    NS_ABORT_MSG_UNLESS(set, "The bottleneck device does not support background traffic");
+}
+
+void
+FluidBulkSendApplication::Round()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    Time interval = now - m_lastRound;
+    m_lastRound = now;
+
+    // Capacity (bytes/s) left by the other fluid flows
+    DataRateValue value;
+    m_device->GetAttribute("DataRate", value);
+    const double capacity = value.Get().GetBitRate() / 8.0;
+    m_device->GetAttribute("BackgroundDataRate", value);
+    const DataRate others = value.Get() - std::min(value.Get(), m_reserved);
+    const double link = std::max(capacity - others.GetBitRate() / 8.0, 0.0);
+    double available = link;
+
+    if (interval.IsStrictlyPositive())
+    {
+        // The flow and the packets transmitted by the device get a max-min
+        // fair share of the link. Packets that used all the capacity left to
+        // them may want more, and get half of the link; otherwise the flow
+        // can take what they did not use. Computing the share from what is
+        // left by the packets alone would let either side take back whatever
+        // the other gives up after a loss, and never return it.
+        const double seconds = interval.GetSeconds();
+        const double packets = m_deviceBytes / seconds;
+        const double left = std::max(link - m_reserved.GetBitRate() / 8.0, capacity / 100);
+        const bool saturated = packets > 0 && packets >= 0.9 * left;
+        available = saturated ? link / 2 : std::max(link - packets, link / 2);
+        m_deviceBytes = 0;
+
+        // What was sent in the last round joins the backlog, which is served
+        // at the reserved rate; what does not fit in the buffer is lost
+        const double sent = m_rate.GetBitRate() / 8.0 * seconds;
+        double served = std::min(m_backlog + sent, m_reserved.GetBitRate() / 8.0 * seconds);
+        m_backlog += sent - served;
+        const double buffer = m_bufferSize.GetUnit() == QueueSizeUnit::PACKETS
+                                  ? static_cast<double>(m_bufferSize.GetValue()) * m_segmentSize
+                                  : m_bufferSize.GetValue();
+        uint32_t bytesLost = 0;
+        if (m_backlog > buffer)
+        {
+            bytesLost = static_cast<uint32_t>(m_backlog - buffer);
+            m_backlog = buffer;
+        }
+        if (m_maxBytes > 0)
+        {
+            served = std::min(served, static_cast<double>(m_maxBytes - m_totDelivered));
+        }
+        auto delivered = static_cast<uint32_t>(served);
+        m_totDelivered += delivered;
+
+        m_rtt = m_baseRtt + Seconds(m_backlog / capacity);
+        m_tcb->m_lastRtt = m_rtt.Get();
+        m_tcb->m_minRtt = std::min(m_tcb->m_minRtt, m_rtt.Get());
+        m_tcb->m_bytesInFlight = m_tcb->m_cWnd.Get();
+        NS_LOG_DEBUG("Round of " << interval.As(Time::MS) << ": delivered " << delivered
+                                 << " lost " << bytesLost << " backlog " << m_backlog);
+
+        if (bytesLost > 0)
+        {
+            OnLoss(bytesLost);
+        }
+        OnDelivered(delivered, bytesLost, interval);
+
+        if (m_maxBytes > 0 && m_totDelivered >= m_maxBytes)
+        {
+            NS_LOG_INFO("Flow completed, " << m_totDelivered << " bytes delivered");
+            Reserve(DataRate(0));
+            m_rate = DataRate(0);
+            return;
+        }
+    }
+
+    double rate = m_tcb->m_cWnd * 8.0 / m_rtt.Get().GetSeconds();
+    if (m_tcb->m_pacing)
+    {
+        rate = std::min(rate, static_cast<double>(m_tcb->m_pacingRate.Get().GetBitRate()));
+    }
+    m_rate = DataRate(static_cast<uint64_t>(rate));
+    // the backlog is drained within a round trip, if the share allows it
+    const double demand = rate + m_backlog * 8 / m_rtt.Get().GetSeconds();
+    Reserve(DataRate(static_cast<uint64_t>(std::min(demand, available * 8))));
+    m_cWnd = m_tcb->m_cWnd.Get();
+    m_roundEvent = Simulator::Schedule(m_rtt, &FluidBulkSendApplication::Round, this);
+}
+
+void
+FluidBulkSendApplication::OnLoss(uint32_t bytesLost)
+{
+    NS_LOG_FUNCTION(this << bytesLost);
+    // A fast retransmission, with the whole recovery within the round
+    m_congestion->CongestionStateSet(m_tcb, TcpSocketState::CA_RECOVERY);
+    m_tcb->m_congState = TcpSocketState::CA_RECOVERY;
+    m_tcb->m_ssThresh = m_congestion->GetSsThresh(m_tcb, m_tcb->m_bytesInFlight);
+    m_tcb->m_congState = TcpSocketState::CA_OPEN;
+    m_congestion->CongestionStateSet(m_tcb, TcpSocketState::CA_OPEN);
+    if (!m_congestion->HasCongControl())
+    {
+        m_tcb->m_cWnd = m_tcb->m_ssThresh.Get();
+        m_congestion->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_COMPLETE_CWR);
+    }
+}
+
+void
+FluidBulkSendApplication::OnDelivered(uint32_t delivered, uint32_t bytesLost, Time interval)
+{
+    NS_LOG_FUNCTION(this << delivered << bytesLost << interval);
+    m_pendingBytes += delivered;
+    auto segments = static_cast<uint32_t>(m_pendingBytes / m_segmentSize);
+    m_pendingBytes -= static_cast<double>(segments) * m_segmentSize;
+    if (segments > 0)
+    {
+        m_congestion->PktsAcked(m_tcb, segments, m_tcb->m_lastRtt);
+    }
+
+    if (m_congestion->HasCongControl())
+    {
+        TcpRateOps::TcpRateSample rs;
+        rs.m_priorDelivered = static_cast<uint32_t>(m_rc.m_delivered);
+        m_rc.m_delivered += delivered;
+        m_rc.m_deliveredTime = Simulator::Now();
+        rs.m_delivered = static_cast<int32_t>(delivered);
+        rs.m_interval = interval;
+        rs.m_deliveryRate =
+            DataRate(static_cast<uint64_t>(delivered * 8.0 / interval.GetSeconds()));
+        rs.m_ackedSacked = delivered;
+        rs.m_bytesLoss = bytesLost;
+        rs.m_priorInFlight = m_tcb->m_bytesInFlight;
+        m_congestion->CongControl(m_tcb, m_rc, rs);
+    }
+    else if (bytesLost == 0)
+    {
+        // One call per ACK: in slow start the window grows with the ACKs
+        for (uint32_t acked = 0; acked < segments; acked += m_segmentsPerAck)
+        {
+            m_congestion->IncreaseWindow(m_tcb, std::min(m_segmentsPerAck, segments - acked));
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,168 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLUID_BULK_SEND_APPLICATION_H
+#define FLUID_BULK_SEND_APPLICATION_H
+
+#include "ns3/application.h"
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/queue-size.h"
+#include "ns3/tcp-rate-ops.h"
+#include "ns3/traced-value.h"
+
+namespace ns3
+{
+
+class NetDevice;
+class Packet;
+class TcpCongestionOps;
+class TcpSocketState;
+
+/**
+ * \ingroup applications
+ * \defgroup fluidbulksend FluidBulkSendApplication
+ *
+ * A bulk TCP transfer modeled as a fluid: its rate evolves with a
+ * congestion control algorithm once per round trip, and it takes its share
+ * of a bottleneck device without creating any packet.
+ */
+
+/**
+ * \ingroup fluidbulksend
+ * \brief Background bulk TCP transfer, modeled as a fluid rate process.
+ *
+ * The application stands for a BulkSendApplication on a TCP socket whose
+ * packets are not of interest. Instead of sending segments, it evolves the
+ * congestion window of a TcpCongestionOps (e.g., TcpNewReno, TcpCubic or
+ * TcpBbr) once per round trip, as if all the segments sent in the previous
+ * round had been acknowledged, and turns it into a sending rate.
+ *
+ * The rate is served by the bottleneck device (attribute "Device"), whose
+ * capacity is shared with the packets that it actually transmits, measured
+ * through its PhyTxEnd trace source, and with the other fluid flows. The
+ * flow and the packets get a max-min fair share of the capacity left by the
+ * other fluid flows: when the packets use all the rate available to them,
+ * each side gets half of it. The rate in excess of the share of the flow
+ * builds a backlog, which adds to the round trip time; when the backlog
+ * exceeds the buffer (attribute "BufferSize"), the excess is lost and the
+ * flow reacts as to a fast retransmission. The rate that the flow gets is
+ * reserved on the device through the attribute "BackgroundDataRate" (see
+ * PointToPointNetDevice), so that the packets are transmitted at the
+ * remaining rate.
+ *
+ * The model costs one event per round trip, whatever the rate of the flow.
+ * It does not account for the delay that the fluid backlog adds to the
+ * packets, nor for the losses that it causes to them.
+ */
+class FluidBulkSendApplication : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    FluidBulkSendApplication();
+
+    ~FluidBulkSendApplication() override;
+
+    /**
+     * \brief Set the bottleneck device
+     * \param device the device whose capacity the flow shares
+     */
+    void SetDevice(Ptr<NetDevice> device);
+
+    /**
+     * \brief Get the number of bytes delivered so far
+     * \return the number of bytes delivered
+     */
+    uint64_t GetTotalDelivered() const;
+
+    /**
+     * \brief Get the current sending rate of the flow
+     * \return the sending rate
+     */
+    DataRate GetRate() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /**
+     * \brief Advance the fluid model by one round trip
+     */
+    void Round();
+
+    /**
+     * \brief React to the loss of some bytes at the bottleneck
+     * \param bytesLost the number of bytes lost
+     */
+    void OnLoss(uint32_t bytesLost);
+
+    /**
+     * \brief Feed the congestion control with the bytes delivered in a round
+     * \param delivered the number of bytes delivered
+     * \param bytesLost the number of bytes lost
+     * \param interval the duration of the round
+     */
+    void OnDelivered(uint32_t delivered, uint32_t bytesLost, Time interval);
+
+    /**
+     * \brief Reserve a rate on the bottleneck device, in place of the current reservation
+     * \param rate the rate to reserve
+     */
+    void Reserve(DataRate rate);
+
+    /**
+     * \brief Count the bytes of a packet transmitted by the bottleneck device
+     * \param packet the packet
+     */
+    void DeviceTx(Ptr<const Packet> packet);
+
+    Ptr<NetDevice> m_device;            //!< Bottleneck device
+    TypeId m_congestionTypeId;          //!< Type of the congestion control
+    Ptr<TcpCongestionOps> m_congestion; //!< Congestion control
+    Ptr<TcpSocketState> m_tcb;          //!< Congestion control state
+    TcpRateOps::TcpRateConnection m_rc; //!< Connection rate state, for TcpBbr
+    uint32_t m_segmentSize;             //!< Segment size
+    uint32_t m_initialCwnd;             //!< Initial congestion window, in segments
+    uint32_t m_segmentsPerAck;          //!< Segments acknowledged by each ACK
+    Time m_baseRtt;                     //!< Round trip time without queueing
+    QueueSize m_bufferSize;             //!< Bottleneck buffer
+    uint64_t m_maxBytes;                //!< Limit of the bytes to deliver (0 for no limit)
+
+    EventId m_roundEvent;               //!< Event of the next round
+    Time m_lastRound;                   //!< Time of the last round
+    DataRate m_rate;                    //!< Sending rate during the current round
+    DataRate m_reserved;                //!< Rate reserved on the bottleneck device
+    double m_backlog{0};                //!< Bytes queued at the bottleneck
+    uint64_t m_totDelivered{0};         //!< Bytes delivered so far
+    uint64_t m_deviceBytes{0};          //!< Bytes of packets transmitted by the device
+    double m_pendingBytes{0};           //!< Delivered bytes short of a segment
+
+    TracedValue<uint32_t> m_cWnd; //!< Congestion window
+    TracedValue<Time> m_rtt;      //!< Round trip time, including the queueing delay
+};
+
+} // namespace ns3
+
+#endif /* FLUID_BULK_SEND_APPLICATION_H */
@@ -365,8 +365,11 @@ OnOffApplication::SendPacket()
     {
         Address from;
         Address to;
-        m_socket->GetSockName(from);
-        m_socket->GetPeerName(to);
+        if (!m_txTraceWithSeqTsSize.IsEmpty())
+        {
+            m_socket->GetSockName(from);
+            m_socket->GetPeerName(to);
+        }
         SeqTsSizeHeader header;
         header.SetSeq(m_seq++);
         header.SetSize(m_pktSize);
@@ -388,7 +391,10 @@ OnOffApplication::SendPacket()
         m_totBytes += m_pktSize;
         m_unsentPacket = nullptr;
         Address localAddress;
-        m_socket->GetSockName(localAddress);
+        if (!m_txTraceWithAddresses.IsEmpty())
+        {
+            m_socket->GetSockName(localAddress);
+        }
         if (InetSocketAddress::IsMatchingType(m_peer))
         {
             NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " on-off application sent "
@@ -24,6 +24,9 @@
 #include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace ns3
 {
 
@@ -105,20 +108,38 @@ PacketLossCounter::SetBit(uint32_t seqNum, bool val)
  *    1.2) Mark the packet as lost (0) in the bitMap
  * 2) Mark the current packet as received (1) in the bitMap
  * 3) Update the value of the last received packet
+ *
+ * Step 1 is done a byte of the bitMAP at a time. Past one whole window,
+ * every bit has just been cleared, so each further packet counts as lost.
  */
 
 void
 PacketLossCounter::NotifyReceived(uint32_t seqNum)
 {
     NS_LOG_FUNCTION(this << seqNum);
-    for (uint32_t i = m_lastMaxSeqNum + 1; i <= seqNum; i++)
+    if (seqNum > m_lastMaxSeqNum)
     {
-        if (!GetBit(i))
+        uint32_t windowBits = m_bitMapSize * 8;
+        uint32_t gap = seqNum - m_lastMaxSeqNum;
+        uint32_t remaining = std::min(gap, windowBits);
+        uint32_t lost = gap - remaining;
+        uint32_t pos = (m_lastMaxSeqNum + 1) % windowBits;
+        while (remaining > 0)
+        {
+            uint32_t bit = pos % 8;
+            uint32_t nBits = std::min(remaining, 8 - bit);
+            auto mask = static_cast<uint8_t>((0xFFU >> bit) & (0xFFU << (8 - bit - nBits)));
+            uint8_t& byte = m_receiveBitMap[pos / 8];
+            lost += nBits - std::popcount(static_cast<uint8_t>(byte & mask));
+            byte &= ~mask;
+            remaining -= nBits;
+            pos = (pos + nBits) % windowBits;
+        }
+        if (lost > 0)
         {
-            NS_LOG_INFO("Packet lost: " << i - (m_bitMapSize * 8));
-            m_lost++;
+            NS_LOG_INFO("Packets lost: " << lost);
+            m_lost += lost;
         }
-        SetBit(i, false);
     }
     SetBit(seqNum, true);
     if (seqNum > m_lastMaxSeqNum)
@@ -34,6 +34,7 @@ namespace ns3
 NS_OBJECT_ENSURE_REGISTERED(ThreeGppHttpVariables);
 
 ThreeGppHttpVariables::ThreeGppHttpVariables()
+    : m_drawBatchSize(1)
 {
     NS_LOG_FUNCTION(this);
     m_mtuSizeRng = CreateObject<UniformRandomVariable>();
@@ -175,14 +176,25 @@ ThreeGppHttpVariables::GetTypeId()
                           "The probability that higher MTU size is used.",
                           DoubleValue(0.76),
                           MakeDoubleAccessor(&ThreeGppHttpVariables::m_highMtuProbability),
-                          MakeDoubleChecker<double>(0, 1));
+                          MakeDoubleChecker<double>(0, 1))
+
+            // RANDOM DRAWS
+            .AddAttribute("DrawBatchSize",
+                          "The number of values drawn at once from each random distribution "
+                          "and kept until used, so that the workload of a client or a server "
+                          "is generated in batches rather than one value at a time. The values "
+                          "are the same whatever the batch size, as long as the distribution "
+                          "parameters are not changed during the simulation.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&ThreeGppHttpVariables::m_drawBatchSize),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
 uint32_t
 ThreeGppHttpVariables::GetMtuSize()
 {
-    const double r = m_mtuSizeRng->GetValue();
+    const double r = Draw(m_mtuSizeRng, m_mtuSizeDraws);
     NS_ASSERT(r >= 0.0);
     NS_ASSERT(r < 1.0);
     if (r < m_highMtuProbability)
@@ -226,7 +238,7 @@ ThreeGppHttpVariables::GetMainObjectSize()
     uint32_t value;
     do
     {
-        value = m_mainObjectSizeRng->GetInteger();
+        value = static_cast<uint32_t>(Draw(m_mainObjectSizeRng, m_mainObjectSizeDraws));
     } while ((value < m_mainObjectSizeMin) || (value >= m_mainObjectSizeMax));
 
     return value;
@@ -257,7 +269,8 @@ ThreeGppHttpVariables::GetEmbeddedObjectSize()
     uint32_t value;
     do
     {
-        value = m_embeddedObjectSizeRng->GetInteger();
+        value =
+            static_cast<uint32_t>(Draw(m_embeddedObjectSizeRng, m_embeddedObjectSizeDraws));
     } while ((value < m_embeddedObjectSizeMin) || (value >= m_embeddedObjectSizeMax));
 
     return value;
@@ -283,7 +296,8 @@ ThreeGppHttpVariables::GetNumOfEmbeddedObjects()
     uint32_t value;
     do
     {
-        value = m_numOfEmbeddedObjectsRng->GetInteger();
+        value =
+            static_cast<uint32_t>(Draw(m_numOfEmbeddedObjectsRng, m_numOfEmbeddedObjectsDraws));
     } while ((value < m_numOfEmbeddedObjectsScale) || (value >= upperBound));
 
     /*
@@ -296,13 +310,13 @@ ThreeGppHttpVariables::GetNumOfEmbeddedObjects()
 Time
 ThreeGppHttpVariables::GetReadingTime()
 {
-    return Seconds(m_readingTimeRng->GetValue());
+    return Seconds(Draw(m_readingTimeRng, m_readingTimeDraws));
 }
 
 Time
 ThreeGppHttpVariables::GetParsingTime()
 {
-    return Seconds(m_parsingTimeRng->GetValue());
+    return Seconds(Draw(m_parsingTimeRng, m_parsingTimeDraws));
 }
 
 int64_t
@@ -320,9 +334,49 @@ ThreeGppHttpVariables::AssignStreams(int64_t stream)
     m_readingTimeRng->SetStream(stream + 7);
     m_parsingTimeRng->SetStream(stream + 8);
 
+    for (auto buffer : {&m_mtuSizeDraws,
+                        &m_mainObjectSizeDraws,
+                        &m_embeddedObjectSizeDraws,
+                        &m_numOfEmbeddedObjectsDraws,
+                        &m_readingTimeDraws,
+                        &m_parsingTimeDraws})
+    {
+        Discard(*buffer);
+    }
+
     return 9;
 }
 
+double
+ThreeGppHttpVariables::Draw(const Ptr<RandomVariableStream>& rng, DrawBuffer& buffer)
+{
+    if (m_drawBatchSize <= 1)
+    {
+        return rng->GetValue();
+    }
+    if (buffer.next == buffer.values.size())
+    {
+        /*
+         * Each random variable has its own stream, hence drawing its values
+         * in advance does not change them.
+         */
+        buffer.values.resize(m_drawBatchSize);
+        for (auto& value : buffer.values)
+        {
+            value = rng->GetValue();
+        }
+        buffer.next = 0;
+    }
+    return buffer.values[buffer.next++];
+}
+
+void
+ThreeGppHttpVariables::Discard(DrawBuffer& buffer)
+{
+    buffer.values.clear();
+    buffer.next = 0;
+}
+
 void
 ThreeGppHttpVariables::DoInitialize()
 {
@@ -359,6 +413,7 @@ ThreeGppHttpVariables::UpdateMainObjectMuAndSigma()
     NS_LOG_DEBUG(this << " Mu= " << mu << " Sigma= " << sigma << ".");
     m_mainObjectSizeRng->SetAttribute("Mu", DoubleValue(mu));
     m_mainObjectSizeRng->SetAttribute("Sigma", DoubleValue(sigma));
+    Discard(m_mainObjectSizeDraws);
 }
 
 void
@@ -373,6 +428,7 @@ ThreeGppHttpVariables::UpdateEmbeddedObjectMuAndSigma()
     NS_LOG_DEBUG(this << " Mu= " << mu << " Sigma= " << sigma << ".");
     m_embeddedObjectSizeRng->SetAttribute("Mu", DoubleValue(mu));
     m_embeddedObjectSizeRng->SetAttribute("Sigma", DoubleValue(sigma));
+    Discard(m_embeddedObjectSizeDraws);
 }
 
 void
@@ -438,6 +494,7 @@ ThreeGppHttpVariables::SetNumOfEmbeddedObjectsMax(uint32_t max)
 {
     NS_LOG_FUNCTION(this << max);
     m_numOfEmbeddedObjectsRng->SetAttribute("Bound", DoubleValue(static_cast<double>(max)));
+    Discard(m_numOfEmbeddedObjectsDraws);
 }
 
 void
@@ -446,6 +503,7 @@ ThreeGppHttpVariables::SetNumOfEmbeddedObjectsShape(double shape)
     NS_LOG_FUNCTION(this << shape);
     NS_ASSERT_MSG(std::fabs(shape - 1.0) > 0.000001, "Shape parameter must not equal to 1.0.");
     m_numOfEmbeddedObjectsRng->SetAttribute("Shape", DoubleValue(shape));
+    Discard(m_numOfEmbeddedObjectsDraws);
 }
 
 void
@@ -455,6 +513,7 @@ ThreeGppHttpVariables::SetNumOfEmbeddedObjectsScale(uint32_t scale)
     NS_ASSERT_MSG(scale > 0, "Scale parameter must be greater than zero.");
     m_numOfEmbeddedObjectsScale = scale;
     m_numOfEmbeddedObjectsRng->SetAttribute("Scale", DoubleValue(scale));
+    Discard(m_numOfEmbeddedObjectsDraws);
 }
 
 void
@@ -462,6 +521,7 @@ ThreeGppHttpVariables::SetReadingTimeMean(Time mean)
 {
     NS_LOG_FUNCTION(this << mean.As(Time::S));
     m_readingTimeRng->SetAttribute("Mean", DoubleValue(mean.GetSeconds()));
+    Discard(m_readingTimeDraws);
 }
 
 void
@@ -469,6 +529,7 @@ ThreeGppHttpVariables::SetParsingTimeMean(Time mean)
 {
     NS_LOG_FUNCTION(this << mean.As(Time::S));
     m_parsingTimeRng->SetAttribute("Mean", DoubleValue(mean.GetSeconds()));
+    Discard(m_parsingTimeDraws);
 }
 
 } // namespace ns3
@@ -25,6 +25,8 @@
 #include <ns3/object.h>
 #include <ns3/random-variable-stream.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -278,6 +280,49 @@ class ThreeGppHttpVariables : public Object
 
     void DoInitialize() override; // overridden from base class
 
+    /**
+     * Values drawn in advance from a random variable, see the `DrawBatchSize`
+     * attribute.
+     */
+    struct DrawBuffer
+    {
+        std::vector<double> values; ///< the values drawn in advance
+        std::size_t next{0};        ///< the index of the next value to use
+    };
+
+    /**
+     * Draws the next value of a random variable, from the values drawn in
+     * advance if `DrawBatchSize` is greater than 1.
+     *
+     * \param rng The random variable.
+     * \param buffer The values drawn in advance from the random variable.
+     * \return The next value of the random variable.
+     */
+    double Draw(const Ptr<RandomVariableStream>& rng, DrawBuffer& buffer);
+
+    /**
+     * Discards the values drawn in advance from a random variable, which must
+     * be done whenever its stream or its parameters change.
+     *
+     * \param buffer The values drawn in advance from the random variable.
+     */
+    static void Discard(DrawBuffer& buffer);
+
+    /// Number of values drawn at once from each random variable.
+    uint32_t m_drawBatchSize;
+    /// Values drawn in advance from #m_mtuSizeRng.
+    DrawBuffer m_mtuSizeDraws;
+    /// Values drawn in advance from #m_mainObjectSizeRng.
+    DrawBuffer m_mainObjectSizeDraws;
+    /// Values drawn in advance from #m_embeddedObjectSizeRng.
+    DrawBuffer m_embeddedObjectSizeDraws;
+    /// Values drawn in advance from #m_numOfEmbeddedObjectsRng.
+    DrawBuffer m_numOfEmbeddedObjectsDraws;
+    /// Values drawn in advance from #m_readingTimeRng.
+    DrawBuffer m_readingTimeDraws;
+    /// Values drawn in advance from #m_parsingTimeRng.
+    DrawBuffer m_parsingTimeDraws;
+
     /**
      * Random variable for determining MTU size (in bytes).
      */
@@ -213,10 +213,14 @@ UdpClient::Send()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_sendEvent.IsExpired());
 
+    // The socket addresses are only needed by the address-aware trace
     Address from;
     Address to;
-    m_socket->GetSockName(from);
-    m_socket->GetPeerName(to);
+    if (!m_txTraceWithAddresses.IsEmpty())
+    {
+        m_socket->GetSockName(from);
+        m_socket->GetPeerName(to);
+    }
     SeqTsHeader seqTs;
     seqTs.SetSeq(m_sent);
     NS_ABORT_IF(m_size < seqTs.GetSerializedSize());
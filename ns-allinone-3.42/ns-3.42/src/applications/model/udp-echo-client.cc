@@ -346,7 +346,10 @@ UdpEchoClient::Send()
         p = Create<Packet>(m_size);
     }
     Address localAddress;
-    m_socket->GetSockName(localAddress);
+    if (!m_txTraceWithAddresses.IsEmpty())
+    {
+        m_socket->GetSockName(localAddress);
+    }
     // call to the trace sinks before the packet is actually sent,
     // so that tags added to the packet can be sent as well
     m_txTrace(p);
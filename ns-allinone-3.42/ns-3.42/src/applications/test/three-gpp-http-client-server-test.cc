@@ -40,6 +40,8 @@
 #include <ns3/three-gpp-http-header.h>
 #include <ns3/three-gpp-http-helper.h>
 #include <ns3/three-gpp-http-server.h>
+#include <ns3/three-gpp-http-variables.h>
+#include <ns3/uinteger.h>
 
 #include <list>
 #include <sstream>
@@ -776,6 +778,63 @@ ThreeGppHttpObjectTestCase::DeviceDropCallback(Ptr<const Packet> packet)
 
 // TEST SUITE /////////////////////////////////////////////////////////////////
 
+/**
+ * \ingroup http
+ * \ingroup applications-test
+ * \ingroup tests
+ * Checks that drawing the random values of ThreeGppHttpVariables in batches,
+ * as set by the `DrawBatchSize` attribute, does not change the values.
+ */
+class ThreeGppHttpVariablesDrawBatchTestCase : public TestCase
+{
+  public:
+    /// Instantiate the test case.
+    ThreeGppHttpVariablesDrawBatchTestCase()
+        : TestCase("ThreeGppHttpVariables values drawn in batches")
+    {
+    }
+
+  private:
+    void DoRun() override
+    {
+        auto single = CreateObject<ThreeGppHttpVariables>();
+        auto batched = CreateObject<ThreeGppHttpVariables>();
+        batched->SetAttribute("DrawBatchSize", UintegerValue(16));
+        for (auto variables : {single, batched})
+        {
+            variables->Initialize();
+            variables->AssignStreams(7);
+        }
+
+        // interleave the draws irregularly, as the applications do
+        for (uint32_t page = 0; page < 100; page++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(batched->GetMainObjectSize(),
+                                  single->GetMainObjectSize(),
+                                  "main object size of page " << page);
+            NS_TEST_ASSERT_MSG_EQ(batched->GetParsingTime(),
+                                  single->GetParsingTime(),
+                                  "parsing time of page " << page);
+            uint32_t nEmbedded = single->GetNumOfEmbeddedObjects();
+            NS_TEST_ASSERT_MSG_EQ(batched->GetNumOfEmbeddedObjects(),
+                                  nEmbedded,
+                                  "number of embedded objects of page " << page);
+            for (uint32_t object = 0; object < nEmbedded; object++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(batched->GetEmbeddedObjectSize(),
+                                      single->GetEmbeddedObjectSize(),
+                                      "embedded object size of page " << page);
+                NS_TEST_ASSERT_MSG_EQ(batched->GetMtuSize(),
+                                      single->GetMtuSize(),
+                                      "MTU size of page " << page);
+            }
+            NS_TEST_ASSERT_MSG_EQ(batched->GetReadingTime(),
+                                  single->GetReadingTime(),
+                                  "reading time of page " << page);
+        }
+    }
+};
+
 /**
  * \ingroup http
  * \ingroup applications-test
@@ -810,6 +869,8 @@ class ThreeGppHttpClientServerTestSuite : public TestSuite
         double bitErrorRate[] = {0.0, 5.0e-6};
         uint32_t mtuSize[] = {536, 1460};
 
+        AddTestCase(new ThreeGppHttpVariablesDrawBatchTestCase(), TestCase::Duration::QUICK);
+
         uint32_t run = 1;
         while (run <= 100)
         {
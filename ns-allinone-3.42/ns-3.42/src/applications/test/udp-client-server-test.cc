@@ -269,6 +269,13 @@ PacketLossCounterTestCase::DoRun()
         lossCounter.NotifyReceived(i);
     }
     NS_TEST_ASSERT_MSG_EQ(lossCounter.GetLost(), 9, "Check that 9 (6+1+2) packet are lost");
+
+    // jump over more than a window: drop seqNum 300 to 999
+    for (uint32_t i = 1000; i < 1100; i++)
+    {
+        lossCounter.NotifyReceived(i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(lossCounter.GetLost(), 709, "Check that 709 (9+700) packets are lost");
 }
 
 /**
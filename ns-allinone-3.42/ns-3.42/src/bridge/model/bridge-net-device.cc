@@ -85,6 +85,7 @@ BridgeNetDevice::DoDispose()
         *iter = nullptr;
     }
     m_ports.clear();
+    m_learnState.clear();
     m_channel = nullptr;
     m_node = nullptr;
     NetDevice::DoDispose();
@@ -213,7 +214,13 @@ BridgeNetDevice::Learn(Mac48Address source, Ptr<NetDevice> port)
     {
         LearnedState& state = m_learnState[source];
         state.associatedPort = port;
-        state.expirationTime = Simulator::Now() + m_expirationTime;
+        Time now = Simulator::Now();
+        state.expirationTime = now + m_expirationTime;
+        if (now >= m_nextPurge)
+        {
+            PurgeLearnedState();
+            m_nextPurge = now + m_expirationTime;
+        }
     }
 }
 
@@ -241,6 +248,17 @@ BridgeNetDevice::GetLearnedState(Mac48Address source)
     return nullptr;
 }
 
+void
+BridgeNetDevice::PurgeLearnedState()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Time now = Simulator::Now();
+    std::erase_if(m_learnState, [now](const auto& entry) {
+        return entry.second.expirationTime <= now;
+    });
+    NS_LOG_LOGIC(m_learnState.size() << " learned addresses left after purge");
+}
+
 uint32_t
 BridgeNetDevice::GetNBridgePorts() const
 {
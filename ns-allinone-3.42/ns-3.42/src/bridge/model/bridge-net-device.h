@@ -23,9 +23,9 @@
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
 
-#include <map>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
 
 /**
  * \file
@@ -204,6 +204,14 @@ class BridgeNetDevice : public NetDevice
      */
     Ptr<NetDevice> GetLearnedState(Mac48Address source);
 
+    /**
+     * \brief Removes the expired entries from the learned state table
+     *
+     * Called from Learn at most once every ExpirationTime, so that addresses
+     * which are never looked up again do not accumulate in the table.
+     */
+    void PurgeLearnedState();
+
   private:
     NetDevice::ReceiveCallback m_rxCallback;               //!< receive callback
     NetDevice::PromiscReceiveCallback m_promiscRxCallback; //!< promiscuous receive callback
@@ -221,12 +229,14 @@ class BridgeNetDevice : public NetDevice
         Time expirationTime;           //!< time it takes for learned MAC state to expire
     };
 
-    std::map<Mac48Address, LearnedState> m_learnState; //!< Container for known address statuses
-    Ptr<Node> m_node;                                  //!< node owning this NetDevice
-    Ptr<BridgeChannel> m_channel;                      //!< virtual bridged channel
-    std::vector<Ptr<NetDevice>> m_ports;               //!< bridged ports
-    uint32_t m_ifIndex;                                //!< Interface index
-    uint16_t m_mtu;                                    //!< MTU of the bridged NetDevice
+    /// Container for known address statuses
+    std::unordered_map<Mac48Address, LearnedState, Mac48AddressHash> m_learnState;
+    Time m_nextPurge;                    //!< earliest time of the next learned state purge
+    Ptr<Node> m_node;                    //!< node owning this NetDevice
+    Ptr<BridgeChannel> m_channel;        //!< virtual bridged channel
+    std::vector<Ptr<NetDevice>> m_ports; //!< bridged ports
+    uint32_t m_ifIndex;                  //!< Interface index
+    uint16_t m_mtu;                      //!< MTU of the bridged NetDevice
     bool m_enableLearning; //!< true if the bridge will learn the node status
 };
 
@@ -20,6 +20,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/data-rate.h"
+#include "ns3/hash.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/log.h"
 #include "ns3/net-device-container.h"
@@ -29,7 +30,9 @@
 #include "ns3/rng-seed-manager.h"
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 namespace ns3
 {
@@ -321,14 +324,167 @@ BriteTopologyHelper::GetSystemNumberForAs(uint32_t asNum) const
     return m_systemForAs[asNum];
 }
 
+void
+BriteTopologyHelper::SetTopologyCacheFile(std::string cacheFile)
+{
+    NS_LOG_FUNCTION(this << cacheFile);
+    m_cacheFile = cacheFile;
+}
+
+/**
+ * \param fileName the file to read
+ * \returns the content of the file, empty if it cannot be read
+ */
+static std::string
+ReadFileContent(const std::string& fileName)
+{
+    std::ifstream file(fileName, std::ios_base::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+bool
+BriteTopologyHelper::LoadTopologyCache(const std::string& key)
+{
+    NS_LOG_FUNCTION(this << key);
+    std::ifstream file(m_cacheFile, std::ios_base::binary);
+    std::string magic;
+    std::string fileKey;
+    uint32_t numAs = 0;
+    std::size_t numNodes = 0;
+    std::size_t numEdges = 0;
+    std::size_t seedsSize = 0;
+    if (!(file >> magic >> fileKey) || magic != "BRITE-TOPOLOGY-CACHE-2" || fileKey != key ||
+        !(file >> numAs >> numNodes >> numEdges >> seedsSize))
+    {
+        return false;
+    }
+    if (seedsSize == 0 && !m_newSeedFile.empty())
+    {
+        NS_LOG_INFO("The BRITE topology cache file " << m_cacheFile << " has no seeds for "
+                                                       << m_newSeedFile);
+        return false;
+    }
+
+    BriteNodeInfoList nodes(numNodes);
+    for (auto& node : nodes)
+    {
+        // the type is the rest of the line, it may end with a space
+        file >> node.nodeId >> node.xCoordinate >> node.yCoordinate >> node.inDegree >>
+            node.outDegree >> node.asId;
+        file.get();
+        std::getline(file, node.type);
+    }
+    BriteEdgeInfoList edges(numEdges);
+    for (auto& edge : edges)
+    {
+        file >> edge.edgeId >> edge.srcId >> edge.destId >> edge.length >> edge.delay >>
+            edge.bandwidth >> edge.asFrom >> edge.asTo;
+        file.get();
+        std::getline(file, edge.type);
+    }
+    std::string seeds(seedsSize, '\0');
+    file.read(seeds.data(), seedsSize);
+    if (file.fail())
+    {
+        NS_LOG_WARN("Truncated BRITE topology cache file " << m_cacheFile);
+        return false;
+    }
+
+    if (!m_newSeedFile.empty())
+    {
+        // the seed file BRITE would have written for the next run
+        std::ofstream seedFile(m_newSeedFile, std::ios_base::binary | std::ios_base::trunc);
+        NS_ABORT_MSG_UNLESS(seedFile.is_open(), "Cannot write the seed file " << m_newSeedFile);
+        seedFile << seeds;
+    }
+
+    NS_LOG_INFO("Read the BRITE topology from " << m_cacheFile);
+    m_numAs = numAs;
+    m_briteNodeInfoList = std::move(nodes);
+    m_briteEdgeInfoList = std::move(edges);
+    return true;
+}
+
+void
+BriteTopologyHelper::SaveTopologyCache(const std::string& key) const
+{
+    NS_LOG_FUNCTION(this << key);
+    std::ofstream file(m_cacheFile, std::ios_base::binary | std::ios_base::trunc);
+    if (!file)
+    {
+        NS_LOG_WARN("Cannot write the BRITE topology cache file " << m_cacheFile);
+        return;
+    }
+    // keep the seeds BRITE wrote for the next run, to write them again on a cache hit
+    std::string seeds = m_newSeedFile.empty() ? "" : ReadFileContent(m_newSeedFile);
+    file << std::setprecision(17);
+    file << "BRITE-TOPOLOGY-CACHE-2 " << key << "\n";
+    file << m_numAs << " " << m_briteNodeInfoList.size() << " " << m_briteEdgeInfoList.size()
+         << " " << seeds.size() << "\n";
+    for (const auto& node : m_briteNodeInfoList)
+    {
+        file << node.nodeId << " " << node.xCoordinate << " " << node.yCoordinate << " "
+             << node.inDegree << " " << node.outDegree << " " << node.asId << " " << node.type
+             << "\n";
+    }
+    for (const auto& edge : m_briteEdgeInfoList)
+    {
+        file << edge.edgeId << " " << edge.srcId << " " << edge.destId << " " << edge.length
+             << " " << edge.delay << " " << edge.bandwidth << " " << edge.asFrom << " "
+             << edge.asTo << " " << edge.type << "\n";
+    }
+    file << seeds;
+}
+
 void
 BriteTopologyHelper::GenerateBriteTopology()
 {
-    NS_ASSERT_MSG(!m_topology, "Brite Topology Already Created");
+    NS_ASSERT_MSG(!m_topology && m_briteNodeInfoList.empty(), "Brite Topology Already Created");
 
     // check to see if need to generate seed file
     bool generateSeedFile = m_seedFile.empty();
 
+    // the seeds are drawn even if the topology is read from the cache, so that the
+    // random variable stream is used in the same way
+    std::ostringstream seeds;
+    if (generateSeedFile)
+    {
+        // Generate seed file expected by BRITE
+        // need unsigned shorts 0-65535
+        seeds << "PLACES " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
+              << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        seeds << "CONNECT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
+              << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        seeds << "EDGE_CONN " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
+              << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        seeds << "GROUPING " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
+              << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        seeds << "ASSIGNMENT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
+              << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        seeds << "BANDWIDTH " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
+              << " " << m_uv->GetInteger(0, 65535) << std::endl;
+    }
+
+    // the topology only depends on the configuration and on the seeds
+    std::string cacheKey;
+    if (!m_cacheFile.empty())
+    {
+        std::string inputs = ReadFileContent(m_confFile) + "\n" +
+                             (generateSeedFile ? seeds.str() : ReadFileContent(m_seedFile));
+        // FNV-1a hashes the bytes one at a time, so the key does not depend
+        // on the platform or the standard library
+        std::ostringstream key;
+        key << std::hex << std::setw(16) << std::setfill('0')
+            << Hasher(Create<Hash::Function::Fnv1a>()).GetHash64(inputs);
+        cacheKey = key.str();
+        if (LoadTopologyCache(cacheKey))
+        {
+            return;
+        }
+    }
+
     if (generateSeedFile)
     {
         NS_LOG_LOGIC("Generating BRITE Seed file");
@@ -341,20 +497,7 @@ BriteTopologyHelper::GenerateBriteTopology()
         // verify open
         NS_ASSERT(!seedFile.fail());
 
-        // Generate seed file expected by BRITE
-        // need unsigned shorts 0-65535
-        seedFile << "PLACES " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
-                 << " " << m_uv->GetInteger(0, 65535) << std::endl;
-        seedFile << "CONNECT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
-                 << " " << m_uv->GetInteger(0, 65535) << std::endl;
-        seedFile << "EDGE_CONN " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
-                 << " " << m_uv->GetInteger(0, 65535) << std::endl;
-        seedFile << "GROUPING " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
-                 << " " << m_uv->GetInteger(0, 65535) << std::endl;
-        seedFile << "ASSIGNMENT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
-                 << " " << m_uv->GetInteger(0, 65535) << std::endl;
-        seedFile << "BANDWIDTH " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535)
-                 << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        seedFile << seeds.str();
         seedFile.close();
 
         // if we're using NS3 generated seed files don't want brite to create a new seed file.
@@ -366,6 +509,11 @@ BriteTopologyHelper::GenerateBriteTopology()
     BuildBriteNodeInfoList();
     BuildBriteEdgeInfoList();
 
+    if (!m_cacheFile.empty())
+    {
+        SaveTopologyCache(cacheKey);
+    }
+
     // brite automatically spits out the seed values used to a separate file so no need to keep this
     // anymore
     if (generateSeedFile)
@@ -465,17 +613,28 @@ BriteTopologyHelper::ConstructTopology()
         m_nodesByAs.push_back(new NodeContainer());
     }
 
+    m_netDevices.reserve(m_netDevices.size() + m_briteEdgeInfoList.size());
+    // the helper attributes are only set when they differ from those of the previous edge
+    const BriteEdgeInfo* previous = nullptr;
     for (auto it = m_briteEdgeInfoList.begin(); it != m_briteEdgeInfoList.end(); ++it)
     {
         // Set the link delay
         // The brite value for delay is given in milliseconds
-        m_britePointToPointHelper.SetChannelAttribute("Delay",
-                                                      TimeValue(Seconds((*it).delay / 1000.0)));
+        if (!previous || previous->delay != (*it).delay)
+        {
+            m_britePointToPointHelper.SetChannelAttribute(
+                "Delay",
+                TimeValue(Seconds((*it).delay / 1000.0)));
+        }
 
         // The brite value for data rate is given in Mbps
-        m_britePointToPointHelper.SetDeviceAttribute(
-            "DataRate",
-            DataRateValue(DataRate((*it).bandwidth * mbpsToBps)));
+        if (!previous || previous->bandwidth != (*it).bandwidth)
+        {
+            m_britePointToPointHelper.SetDeviceAttribute(
+                "DataRate",
+                DataRateValue(DataRate((*it).bandwidth * mbpsToBps)));
+        }
+        previous = &(*it);
 
         m_netDevices.push_back(
             new NetDeviceContainer(m_britePointToPointHelper.Install(m_nodes.Get((*it).srcId),
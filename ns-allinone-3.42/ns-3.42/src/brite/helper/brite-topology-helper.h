@@ -96,6 +96,20 @@ class BriteTopologyHelper
      */
     void AssignStreams(int64_t streamNumber);
 
+    /**
+     * Sets a file caching the topology generated by BRITE, so that the
+     * topology of a configuration is generated once and then reused across
+     * runs. If the file holds the topology of the same configuration and
+     * seed files (or of the same generated seeds), the topology is read from
+     * the file instead of being generated by BRITE, otherwise the generated
+     * topology is written to the file. The cache also keeps the seed file
+     * BRITE writes for the next run, and writes it again on a cache hit.
+     * Must be called before BuildBriteTopology.
+     *
+     * \param cacheFile the file caching the topology
+     */
+    void SetTopologyCacheFile(std::string cacheFile);
+
     /**
      * Create NS3 topology using information generated from BRITE.
      *
@@ -254,6 +268,21 @@ class BriteTopologyHelper
     /// Generate the BRITE topology.
     void GenerateBriteTopology();
 
+    /**
+     * Read the node and edge info lists from the topology cache file.
+     *
+     * \param key the key of the configuration and seeds of the topology
+     * \returns true if the cache file holds the topology of the given key
+     */
+    bool LoadTopologyCache(const std::string& key);
+
+    /**
+     * Write the node and edge info lists to the topology cache file.
+     *
+     * \param key the key of the configuration and seeds of the topology
+     */
+    void SaveTopologyCache(const std::string& key) const;
+
     /// brite configuration file to use
     std::string m_confFile;
 
@@ -263,6 +292,9 @@ class BriteTopologyHelper
     /// brite seed file to generate for next run
     std::string m_newSeedFile;
 
+    /// file caching the topology, if any
+    std::string m_cacheFile;
+
     /// stores the number of AS in the BRITE generated topology
     uint32_t m_numAs;
 
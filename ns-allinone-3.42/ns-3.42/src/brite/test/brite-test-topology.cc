@@ -27,6 +27,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 using namespace ns3;
@@ -100,6 +101,101 @@ BriteTopologyStructureTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup brite-tests
+ *
+ * \brief BRITE topology cache Test
+ *
+ * Test that a topology read from the topology cache file is the one
+ * generated by BRITE for the same configuration and seeds
+ */
+class BriteTopologyCacheTestCase : public TestCase
+{
+  public:
+    BriteTopologyCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BriteTopologyCacheTestCase::BriteTopologyCacheTestCase()
+    : TestCase("Test that a topology read from the cache file is the generated one")
+{
+}
+
+void
+BriteTopologyCacheTestCase::DoRun()
+{
+    std::string confFile = "src/brite/test/test.conf";
+    std::string cacheFile = CreateTempDirFilename("brite-topology.cache");
+
+    SeedManager::SetRun(1);
+    SeedManager::SetSeed(1);
+    BriteTopologyHelper bthA(confFile);
+    bthA.AssignStreams(1);
+    bthA.SetTopologyCacheFile(cacheFile);
+
+    SeedManager::SetRun(1);
+    SeedManager::SetSeed(1);
+    BriteTopologyHelper bthB(confFile);
+    bthB.AssignStreams(1);
+    bthB.SetTopologyCacheFile(cacheFile);
+
+    InternetStackHelper stack;
+
+    // the first topology is generated by BRITE and cached, the second one is read
+    bthA.BuildBriteTopology(stack);
+    std::ifstream cache(cacheFile);
+    NS_TEST_ASSERT_MSG_EQ(cache.good(), true, "The topology cache file was not written");
+    bthB.BuildBriteTopology(stack);
+
+    NS_TEST_ASSERT_MSG_EQ(bthB.GetNAs(), bthA.GetNAs(), "Number of AS differs");
+    NS_TEST_ASSERT_MSG_EQ(bthB.GetNNodesTopology(),
+                          bthA.GetNNodesTopology(),
+                          "Total number of nodes differs");
+    NS_TEST_ASSERT_MSG_EQ(bthB.GetNEdgesTopology(),
+                          bthA.GetNEdgesTopology(),
+                          "Total number of edges differs");
+    for (unsigned int i = 0; i < bthA.GetNAs(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(bthB.GetNNodesForAs(i),
+                              bthA.GetNNodesForAs(i),
+                              "Total number of nodes differs for AS " << i);
+        NS_TEST_ASSERT_MSG_EQ(bthB.GetNLeafNodesForAs(i),
+                              bthA.GetNLeafNodesForAs(i),
+                              "Total number of leaf nodes differs for AS " << i);
+    }
+
+    // with a seed file, the seed file for the next run is written on a cache hit too
+    std::string seedFile = CreateTempDirFilename("brite-seeds.txt");
+    std::ofstream seeds(seedFile);
+    seeds << "PLACES 4 9 16\nCONNECT 25 36 49\nEDGE_CONN 64 81 100\n"
+          << "GROUPING 121 144 169\nASSIGNMENT 196 225 256\nBANDWIDTH 289 324 361\n";
+    seeds.close();
+    std::string seedCacheFile = CreateTempDirFilename("brite-seeds-topology.cache");
+    std::string nextSeedFileC = CreateTempDirFilename("brite-next-seeds-c.txt");
+    std::string nextSeedFileD = CreateTempDirFilename("brite-next-seeds-d.txt");
+
+    BriteTopologyHelper bthC(confFile, seedFile, nextSeedFileC);
+    bthC.SetTopologyCacheFile(seedCacheFile);
+    bthC.BuildBriteTopology(stack);
+    BriteTopologyHelper bthD(confFile, seedFile, nextSeedFileD);
+    bthD.SetTopologyCacheFile(seedCacheFile);
+    bthD.BuildBriteTopology(stack);
+
+    NS_TEST_ASSERT_MSG_EQ(bthD.GetNNodesTopology(),
+                          bthC.GetNNodesTopology(),
+                          "Total number of nodes differs with a seed file");
+    std::ifstream nextSeedsC(nextSeedFileC);
+    std::ifstream nextSeedsD(nextSeedFileD);
+    NS_TEST_ASSERT_MSG_EQ(nextSeedsD.good(), true, "The next seed file was not written");
+    std::ostringstream contentC;
+    std::ostringstream contentD;
+    contentC << nextSeedsC.rdbuf();
+    contentD << nextSeedsD.rdbuf();
+    NS_TEST_ASSERT_MSG_EQ(contentD.str(), contentC.str(), "The next seed files differ");
+}
+
 /**
  * \ingroup brite-tests
  *
@@ -219,6 +315,7 @@ class BriteTestSuite : public TestSuite
     {
         AddTestCase(new BriteTopologyStructureTestCase, TestCase::Duration::QUICK);
         AddTestCase(new BriteTopologyFunctionTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new BriteTopologyCacheTestCase, TestCase::Duration::QUICK);
     }
 };
 
@@ -187,20 +187,12 @@ OutdoorPositionAllocator::GetNext() const
 
         NS_LOG_INFO("Position " << position);
 
-        bool inside = false;
-        for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+        auto containing = BuildingList::GetBuildingsContaining(position);
+        bool inside = !containing.empty();
+        if (inside)
         {
-            if ((*bit)->IsInside(position))
-            {
-                NS_LOG_INFO("Position "
-                            << position << " is inside the building with boundaries "
-                            << (*bit)->GetBoundaries().xMin << " " << (*bit)->GetBoundaries().xMax
-                            << " " << (*bit)->GetBoundaries().yMin << " "
-                            << (*bit)->GetBoundaries().yMax << " " << (*bit)->GetBoundaries().zMin
-                            << " " << (*bit)->GetBoundaries().zMax);
-                inside = true;
-                break;
-            }
+            NS_LOG_INFO("Position " << position << " is inside the building with boundaries "
+                                    << containing.front()->GetBoundaries());
         }
 
         if (inside)
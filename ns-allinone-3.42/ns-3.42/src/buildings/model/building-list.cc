@@ -28,6 +28,8 @@
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -77,6 +79,30 @@ class BuildingListPriv : public Object
      * \returns the container size
      */
     uint32_t GetNBuildings();
+    /**
+     * Gets the buildings whose boundaries contain a position
+     * \param position the position
+     * \returns the buildings, in list order
+     */
+    std::vector<Ptr<Building>> GetBuildingsContaining(const Vector& position);
+    /**
+     * Gets the buildings intersected by a line segment
+     * \param l1 the first end of the line segment
+     * \param l2 the second end of the line segment
+     * \returns the buildings, in list order
+     */
+    std::vector<Ptr<Building>> GetBuildingsIntersecting(const Vector& l1, const Vector& l2);
+    /**
+     * Checks whether a line segment intersects any building
+     * \param l1 the first end of the line segment
+     * \param l2 the second end of the line segment
+     * \returns true if at least one building is intersected
+     */
+    bool IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2);
+    /**
+     * Marks the spatial index as out of date
+     */
+    void InvalidateIndex();
 
     /**
      * Get the Singleton instance of BuildingListPriv (or create one)
@@ -98,9 +124,98 @@ class BuildingListPriv : public Object
      *
      */
     static void Delete();
+
+    /**
+     * A node of the bounding volume hierarchy over the buildings. The left
+     * child of an inner node immediately follows it in the node vector.
+     */
+    struct IndexNode
+    {
+        Box bounds;     //!< the union of the boundaries of the buildings below the node
+        uint32_t begin; //!< the first entry of m_indexOrder below the node
+        uint32_t end;   //!< one past the last entry of m_indexOrder below the node
+        uint32_t right; //!< the index of the right child, 0 for a leaf
+    };
+
+    /**
+     * Rebuild the spatial index if a building was added or moved since the
+     * last query.
+     */
+    void UpdateIndex();
+    /**
+     * Build the subtree over a range of m_indexOrder
+     * \param begin the first entry of the range
+     * \param end one past the last entry of the range
+     */
+    void BuildIndex(uint32_t begin, uint32_t end);
+    /**
+     * Collect the buildings whose index node is hit by a line segment
+     * \param l1 the first end of the line segment
+     * \param l2 the second end of the line segment
+     * \param firstOnly stop at the first building actually intersected
+     * \returns the indices of the candidate buildings (the intersected one if firstOnly)
+     */
+    std::vector<uint32_t> FindIntersecting(const Vector& l1, const Vector& l2, bool firstOnly);
+
     std::vector<Ptr<Building>> m_buildings; //!< Container of Building
+    std::vector<IndexNode> m_indexNodes;    //!< The nodes of the spatial index
+    std::vector<uint32_t> m_indexOrder;     //!< The building indices, grouped by leaf
+    bool m_indexValid{false};               //!< Whether the spatial index is up to date
 };
 
+/// The maximum number of buildings in a leaf of the spatial index
+static constexpr uint32_t INDEX_LEAF_SIZE = 4;
+
+/**
+ * Margin, in meters, by which the index nodes are grown before being tested
+ * against a line segment, so that rounding never prunes a building that
+ * Box::IsIntersect would report.
+ */
+static constexpr double INDEX_SEGMENT_MARGIN = 1e-6;
+
+/**
+ * \param box the box
+ * \param l1 the first end of the line segment
+ * \param l2 the second end of the line segment
+ * \returns true if the segment may cross the box grown by INDEX_SEGMENT_MARGIN
+ */
+static bool
+SegmentHitsBox(const Box& box, const Vector& l1, const Vector& l2)
+{
+    const double lo[3] = {box.xMin, box.yMin, box.zMin};
+    const double hi[3] = {box.xMax, box.yMax, box.zMax};
+    const double p[3] = {l1.x, l1.y, l1.z};
+    const double d[3] = {l2.x - l1.x, l2.y - l1.y, l2.z - l1.z};
+    double tMin = 0;
+    double tMax = 1;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        double a = lo[axis] - INDEX_SEGMENT_MARGIN;
+        double b = hi[axis] + INDEX_SEGMENT_MARGIN;
+        if (d[axis] == 0)
+        {
+            if (p[axis] < a || p[axis] > b)
+            {
+                return false;
+            }
+            continue;
+        }
+        double t0 = (a - p[axis]) / d[axis];
+        double t1 = (b - p[axis]) / d[axis];
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(BuildingListPriv);
 
 TypeId
@@ -165,6 +280,9 @@ BuildingListPriv::DoDispose()
         *i = nullptr;
     }
     m_buildings.erase(m_buildings.begin(), m_buildings.end());
+    m_indexNodes.clear();
+    m_indexOrder.clear();
+    m_indexValid = false;
     Object::DoDispose();
 }
 
@@ -173,6 +291,7 @@ BuildingListPriv::Add(Ptr<Building> building)
 {
     uint32_t index = m_buildings.size();
     m_buildings.push_back(building);
+    m_indexValid = false;
     Simulator::ScheduleWithContext(index, TimeStep(0), &Building::Initialize, building);
     return index;
 }
@@ -204,6 +323,180 @@ BuildingListPriv::GetBuilding(uint32_t n)
     return m_buildings.at(n);
 }
 
+void
+BuildingListPriv::InvalidateIndex()
+{
+    m_indexValid = false;
+}
+
+void
+BuildingListPriv::UpdateIndex()
+{
+    if (m_indexValid)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_buildings.size());
+    m_indexNodes.clear();
+    m_indexOrder.resize(m_buildings.size());
+    for (uint32_t i = 0; i < m_indexOrder.size(); i++)
+    {
+        m_indexOrder[i] = i;
+    }
+    if (!m_buildings.empty())
+    {
+        m_indexNodes.reserve(2 * m_buildings.size() / INDEX_LEAF_SIZE + 1);
+        BuildIndex(0, m_indexOrder.size());
+    }
+    m_indexValid = true;
+}
+
+void
+BuildingListPriv::BuildIndex(uint32_t begin, uint32_t end)
+{
+    Box bounds = m_buildings[m_indexOrder[begin]]->GetBoundaries();
+    for (uint32_t i = begin + 1; i < end; i++)
+    {
+        const Box b = m_buildings[m_indexOrder[i]]->GetBoundaries();
+        bounds.xMin = std::min(bounds.xMin, b.xMin);
+        bounds.xMax = std::max(bounds.xMax, b.xMax);
+        bounds.yMin = std::min(bounds.yMin, b.yMin);
+        bounds.yMax = std::max(bounds.yMax, b.yMax);
+        bounds.zMin = std::min(bounds.zMin, b.zMin);
+        bounds.zMax = std::max(bounds.zMax, b.zMax);
+    }
+    uint32_t node = m_indexNodes.size();
+    m_indexNodes.push_back({bounds, begin, end, 0});
+    if (end - begin <= INDEX_LEAF_SIZE)
+    {
+        return;
+    }
+
+    // split at the median of the building centers along the longest axis
+    double dx = bounds.xMax - bounds.xMin;
+    double dy = bounds.yMax - bounds.yMin;
+    double dz = bounds.zMax - bounds.zMin;
+    auto center = [this, dx, dy, dz](uint32_t i) {
+        const Box b = m_buildings[i]->GetBoundaries();
+        if (dx >= dy && dx >= dz)
+        {
+            return b.xMin + b.xMax;
+        }
+        return dy >= dz ? b.yMin + b.yMax : b.zMin + b.zMax;
+    };
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(m_indexOrder.begin() + begin,
+                     m_indexOrder.begin() + mid,
+                     m_indexOrder.begin() + end,
+                     [&center](uint32_t a, uint32_t b) { return center(a) < center(b); });
+    BuildIndex(begin, mid);
+    m_indexNodes[node].right = m_indexNodes.size();
+    BuildIndex(mid, end);
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetBuildingsContaining(const Vector& position)
+{
+    UpdateIndex();
+    std::vector<uint32_t> found;
+    std::vector<uint32_t> stack;
+    if (!m_indexNodes.empty())
+    {
+        stack.push_back(0);
+    }
+    while (!stack.empty())
+    {
+        uint32_t current = stack.back();
+        stack.pop_back();
+        const IndexNode& node = m_indexNodes[current];
+        if (!node.bounds.IsInside(position))
+        {
+            continue;
+        }
+        if (node.right == 0)
+        {
+            for (uint32_t i = node.begin; i < node.end; i++)
+            {
+                if (m_buildings[m_indexOrder[i]]->IsInside(position))
+                {
+                    found.push_back(m_indexOrder[i]);
+                }
+            }
+            continue;
+        }
+        stack.push_back(node.right);
+        stack.push_back(current + 1);
+    }
+    std::sort(found.begin(), found.end());
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(found.size());
+    for (auto i : found)
+    {
+        buildings.push_back(m_buildings[i]);
+    }
+    return buildings;
+}
+
+std::vector<uint32_t>
+BuildingListPriv::FindIntersecting(const Vector& l1, const Vector& l2, bool firstOnly)
+{
+    UpdateIndex();
+    std::vector<uint32_t> found;
+    std::vector<uint32_t> stack;
+    if (!m_indexNodes.empty())
+    {
+        stack.push_back(0);
+    }
+    while (!stack.empty())
+    {
+        uint32_t current = stack.back();
+        stack.pop_back();
+        const IndexNode& node = m_indexNodes[current];
+        if (!SegmentHitsBox(node.bounds, l1, l2))
+        {
+            continue;
+        }
+        if (node.right == 0)
+        {
+            for (uint32_t i = node.begin; i < node.end; i++)
+            {
+                if (m_buildings[m_indexOrder[i]]->IsIntersect(l1, l2))
+                {
+                    found.push_back(m_indexOrder[i]);
+                    if (firstOnly)
+                    {
+                        return found;
+                    }
+                }
+            }
+            continue;
+        }
+        stack.push_back(node.right);
+        stack.push_back(current + 1);
+    }
+    return found;
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetBuildingsIntersecting(const Vector& l1, const Vector& l2)
+{
+    std::vector<uint32_t> found = FindIntersecting(l1, l2, false);
+    std::sort(found.begin(), found.end());
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(found.size());
+    for (auto i : found)
+    {
+        buildings.push_back(m_buildings[i]);
+    }
+    return buildings;
+}
+
+bool
+BuildingListPriv::IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2)
+{
+    return !FindIntersecting(l1, l2, true).empty();
+}
+
 } // namespace ns3
 
 /**
@@ -244,4 +537,28 @@ BuildingList::GetNBuildings()
     return BuildingListPriv::Get()->GetNBuildings();
 }
 
+std::vector<Ptr<Building>>
+BuildingList::GetBuildingsContaining(const Vector& position)
+{
+    return BuildingListPriv::Get()->GetBuildingsContaining(position);
+}
+
+std::vector<Ptr<Building>>
+BuildingList::GetBuildingsIntersecting(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->GetBuildingsIntersecting(l1, l2);
+}
+
+bool
+BuildingList::IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->IsAnyBuildingIntersecting(l1, l2);
+}
+
+void
+BuildingList::InvalidateIndex()
+{
+    BuildingListPriv::Get()->InvalidateIndex();
+}
+
 } // namespace ns3
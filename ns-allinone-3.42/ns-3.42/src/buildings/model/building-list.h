@@ -23,6 +23,7 @@
 #define BUILDING_LIST_H_
 
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 #include <vector>
 
@@ -69,6 +70,31 @@ class BuildingList
      * \returns the number of buildings currently in the list.
      */
     static uint32_t GetNBuildings();
+    /**
+     * \param position a position
+     * \returns the buildings whose boundaries contain the position, in list order.
+     */
+    static std::vector<Ptr<Building>> GetBuildingsContaining(const Vector& position);
+    /**
+     * \param l1 the first end of the line segment
+     * \param l2 the second end of the line segment
+     * \returns the buildings intersected by the line segment, in list order.
+     */
+    static std::vector<Ptr<Building>> GetBuildingsIntersecting(const Vector& l1,
+                                                              const Vector& l2);
+    /**
+     * \param l1 the first end of the line segment
+     * \param l2 the second end of the line segment
+     * \returns true if the line segment intersects at least one building.
+     */
+    static bool IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2);
+    /**
+     * Mark the spatial index of the buildings as out of date.
+     *
+     * This method is called automatically from Building::SetBoundaries so
+     * the user has little reason to call it himself.
+     */
+    static void InvalidateIndex();
 };
 
 } // namespace ns3
@@ -23,6 +23,7 @@
 
 #include "mobility-building-info.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/enum.h"
 #include "ns3/log.h"
@@ -99,16 +100,64 @@ BuildingsPropagationLossModel::GetTypeId()
                           "Additional loss for each internal wall [dB]",
                           DoubleValue(5.0),
                           MakeDoubleAccessor(&BuildingsPropagationLossModel::m_lossInternalWall),
-                          MakeDoubleChecker<double>());
+                          MakeDoubleChecker<double>())
+
+            .AddAttribute("CacheLoss",
+                          "Cache the loss of each link until the position or the building state "
+                          "of one of its nodes changes.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BuildingsPropagationLossModel::m_cacheLoss),
+                          MakeBooleanChecker());
 
     return tid;
 }
 
 BuildingsPropagationLossModel::BuildingsPropagationLossModel()
+    : m_cacheLoss(false)
 {
     m_randVariable = CreateObject<NormalRandomVariable>();
 }
 
+void
+BuildingsPropagationLossModel::DoDispose()
+{
+    m_lossCache.clear();
+    PropagationLossModel::DoDispose();
+}
+
+void
+BuildingsPropagationLossModel::ClearLossCache()
+{
+    m_lossCache.clear();
+}
+
+double
+BuildingsPropagationLossModel::GetCachedLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+    if (!m_cacheLoss)
+    {
+        return GetLoss(a, b);
+    }
+
+    Ptr<MobilityBuildingInfo> a1 = a->GetObject<MobilityBuildingInfo>();
+    Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo>();
+    NS_ASSERT_MSG(a1 && b1, "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
+    uint32_t aVersion = a1->GetStateVersion();
+    uint32_t bVersion = b1->GetStateVersion();
+
+    auto [it, inserted] = m_lossCache.try_emplace({PeekPointer(a), PeekPointer(b)});
+    LinkLoss& entry = it->second;
+    if (inserted || entry.aVersion != aVersion || entry.bVersion != bVersion)
+    {
+        entry.a = a;
+        entry.b = b;
+        entry.aVersion = aVersion;
+        entry.bVersion = bVersion;
+        entry.loss = GetLoss(a, b);
+    }
+    return entry.loss;
+}
+
 double
 BuildingsPropagationLossModel::ExternalWallLoss(Ptr<MobilityBuildingInfo> a) const
 {
@@ -226,7 +275,7 @@ BuildingsPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                              Ptr<MobilityModel> a,
                                              Ptr<MobilityModel> b) const
 {
-    return txPowerDbm - GetLoss(a, b) - GetShadowing(a, b);
+    return txPowerDbm - GetCachedLoss(a, b) - GetShadowing(a, b);
 }
 
 int64_t
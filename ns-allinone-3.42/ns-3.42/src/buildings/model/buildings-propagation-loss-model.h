@@ -29,6 +29,10 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/random-variable-stream.h"
 
+#include <map>
+#include <unordered_map>
+#include <utility>
+
 namespace ns3
 {
 
@@ -52,6 +56,14 @@ class JakesFadingLossModel;
  *  \warning This model works only when MobilityBuildingInfo is aggreegated
  *  to the mobility model
  *
+ *  When the CacheLoss attribute is true, the loss returned by GetLoss is
+ *  cached per link, together with the building state versions (see
+ *  MobilityBuildingInfo::GetStateVersion) of both nodes, and computed again
+ *  only when the position or the building state of one of them changes.
+ *  The cache must be cleared with ClearLossCache if the loss model is
+ *  reconfigured after the first transmission; the setters of the derived
+ *  classes do it.
+ *
  */
 
 class BuildingsPropagationLossModel : public PropagationLossModel
@@ -76,7 +88,24 @@ class BuildingsPropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    /**
+     * \brief Forget the losses cached when the CacheLoss attribute is true.
+     */
+    void ClearLossCache();
+
   protected:
+    void DoDispose() override;
+
+    /**
+     * Get the loss of a link, from the cache if the CacheLoss attribute is
+     * true and the building states of both nodes did not change since the
+     * loss was cached.
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \returns the propagation loss (in dBm)
+     */
+    double GetCachedLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
     /**
      * Calculate the external wall loss
      * \param a Building data
@@ -159,6 +188,38 @@ class BuildingsPropagationLossModel : public PropagationLossModel
     Ptr<NormalRandomVariable> m_randVariable; //!< Random variable
 
     int64_t DoAssignStreams(int64_t stream) override;
+
+  private:
+    /// Loss of a link and the building state versions it was computed for
+    struct LinkLoss
+    {
+        Ptr<MobilityModel> a; //!< mobility model of the source
+        Ptr<MobilityModel> b; //!< mobility model of the destination
+        uint32_t aVersion;    //!< building state version of the source
+        uint32_t bVersion;    //!< building state version of the destination
+        double loss;          //!< loss (in dB)
+    };
+
+    /// Hash of a link, given by the mobility models of its source and destination
+    struct LinkHash
+    {
+        /**
+         * \param link the mobility models of the source and the destination
+         * \return the hash of the link
+         */
+        size_t operator()(const std::pair<const MobilityModel*, const MobilityModel*>& link) const
+        {
+            return std::hash<const void*>()(link.first) ^
+                   (std::hash<const void*>()(link.second) * 31);
+        }
+    };
+
+    bool m_cacheLoss; //!< whether the losses are cached per link
+    /// Losses cached per link
+    mutable std::unordered_map<std::pair<const MobilityModel*, const MobilityModel*>,
+                               LinkLoss,
+                               LinkHash>
+        m_lossCache;
 };
 
 } // namespace ns3
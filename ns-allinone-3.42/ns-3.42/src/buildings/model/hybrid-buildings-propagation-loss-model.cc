@@ -116,6 +116,7 @@ HybridBuildingsPropagationLossModel::SetEnvironment(EnvironmentType env)
 {
     m_okumuraHata->SetAttribute("Environment", EnumValue(env));
     m_ituR1411NlosOverRooftop->SetAttribute("Environment", EnumValue(env));
+    ClearLossCache();
 }
 
 void
@@ -123,6 +124,7 @@ HybridBuildingsPropagationLossModel::SetCitySize(CitySize size)
 {
     m_okumuraHata->SetAttribute("CitySize", EnumValue(size));
     m_ituR1411NlosOverRooftop->SetAttribute("CitySize", EnumValue(size));
+    ClearLossCache();
 }
 
 void
@@ -133,6 +135,7 @@ HybridBuildingsPropagationLossModel::SetFrequency(double freq)
     m_ituR1411NlosOverRooftop->SetAttribute("Frequency", DoubleValue(freq));
     m_ituR1238->SetAttribute("Frequency", DoubleValue(freq));
     m_frequency = freq;
+    ClearLossCache();
 }
 
 void
@@ -140,6 +143,7 @@ HybridBuildingsPropagationLossModel::SetRooftopHeight(double rooftopHeight)
 {
     m_rooftopHeight = rooftopHeight;
     m_ituR1411NlosOverRooftop->SetAttribute("RooftopLevel", DoubleValue(rooftopHeight));
+    ClearLossCache();
 }
 
 double
@@ -62,6 +62,7 @@ MobilityBuildingInfo::MobilityBuildingInfo()
     m_roomX = 1;
     m_roomY = 1;
     m_cachedPosition = Vector(0, 0, 0);
+    m_stateVersion = 0;
 }
 
 MobilityBuildingInfo::MobilityBuildingInfo(Ptr<Building> building)
@@ -72,6 +73,7 @@ MobilityBuildingInfo::MobilityBuildingInfo(Ptr<Building> building)
     m_nFloor = 1;
     m_roomX = 1;
     m_roomY = 1;
+    m_stateVersion = 0;
 }
 
 bool
@@ -98,6 +100,7 @@ MobilityBuildingInfo::SetIndoor(Ptr<Building> building,
     NS_LOG_FUNCTION(this);
     m_indoor = true;
     m_myBuilding = building;
+    m_stateVersion++;
     m_nFloor = nfloor;
     m_roomX = nroomx;
     m_roomY = nroomy;
@@ -115,6 +118,7 @@ MobilityBuildingInfo::SetIndoor(uint8_t nfloor, uint8_t nroomx, uint8_t nroomy)
 {
     NS_LOG_FUNCTION(this);
     m_indoor = true;
+    m_stateVersion++;
     m_nFloor = nfloor;
     m_roomX = nroomx;
     m_roomY = nroomy;
@@ -133,6 +137,7 @@ MobilityBuildingInfo::SetOutdoor()
 {
     NS_LOG_FUNCTION(this);
     m_indoor = false;
+    m_stateVersion++;
 }
 
 uint8_t
@@ -168,22 +173,17 @@ MobilityBuildingInfo::MakeConsistent(Ptr<MobilityModel> mm)
 {
     bool found = false;
     Vector pos = mm->GetPosition();
-    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    for (const auto& building : BuildingList::GetBuildingsContaining(pos))
     {
-        NS_LOG_LOGIC("checking building " << (*bit)->GetId() << " with boundaries "
-                                          << (*bit)->GetBoundaries());
-        if ((*bit)->IsInside(pos))
-        {
-            NS_LOG_LOGIC("MobilityBuildingInfo " << this << " pos " << pos
-                                                 << " falls inside building " << (*bit)->GetId());
-            NS_ABORT_MSG_UNLESS(found == false,
-                                " MobilityBuildingInfo already inside another building!");
-            found = true;
-            uint16_t floor = (*bit)->GetFloor(pos);
-            uint16_t roomX = (*bit)->GetRoomX(pos);
-            uint16_t roomY = (*bit)->GetRoomY(pos);
-            SetIndoor(*bit, floor, roomX, roomY);
-        }
+        NS_LOG_LOGIC("MobilityBuildingInfo " << this << " pos " << pos
+                                             << " falls inside building " << building->GetId());
+        NS_ABORT_MSG_UNLESS(found == false,
+                            " MobilityBuildingInfo already inside another building!");
+        found = true;
+        uint16_t floor = building->GetFloor(pos);
+        uint16_t roomX = building->GetRoomX(pos);
+        uint16_t roomY = building->GetRoomY(pos);
+        SetIndoor(building, floor, roomX, roomY);
     }
     if (!found)
     {
@@ -194,4 +194,13 @@ MobilityBuildingInfo::MakeConsistent(Ptr<MobilityModel> mm)
     m_cachedPosition = pos;
 }
 
+uint32_t
+MobilityBuildingInfo::GetStateVersion()
+{
+    NS_LOG_FUNCTION(this);
+    // a position change makes the state consistent again, hence a new version
+    IsIndoor();
+    return m_stateVersion;
+}
+
 } // namespace ns3
@@ -136,6 +136,18 @@ class MobilityBuildingInfo : public Object
      */
     void MakeConsistent(Ptr<MobilityModel> mm);
 
+    /**
+     * \brief Get the version of the building state of the node
+     *
+     * The version changes whenever the position of the node changes (which
+     * makes the building state consistent again) and whenever the node is
+     * marked as indoor or outdoor, so that results depending on the position
+     * and on the building state of the node can be cached until then.
+     *
+     * \return the version of the building state
+     */
+    uint32_t GetStateVersion();
+
   protected:
     // inherited from Object
     void DoInitialize() override;
@@ -150,6 +162,7 @@ class MobilityBuildingInfo : public Object
                      ///< located
     Vector
         m_cachedPosition; ///< The node position cached after making its mobility model consistent
+    uint32_t m_stateVersion; ///< Version of the building state, see GetStateVersion
 };
 
 } // namespace ns3
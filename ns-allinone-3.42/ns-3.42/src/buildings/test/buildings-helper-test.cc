@@ -19,11 +19,13 @@
 
 #include "ns3/log.h"
 #include "ns3/test.h"
+#include <ns3/building-list.h>
 #include <ns3/building.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/mobility-building-info.h>
 #include <ns3/mobility-helper.h>
+#include <ns3/random-variable-stream.h>
 #include <ns3/simulator.h>
 
 using namespace ns3;
@@ -192,6 +194,108 @@ BuildingsHelperOneTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup building-test
+ *
+ * \brief Check the spatial index of the BuildingList against a linear scan
+ * of the buildings, before and after some of them are moved.
+ */
+class BuildingListIndexTestCase : public TestCase
+{
+  public:
+    BuildingListIndexTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Compare the indexed queries with a linear scan for random positions and segments
+     * \param rv the random variable used to draw the positions
+     */
+    void CheckQueries(Ptr<UniformRandomVariable> rv);
+};
+
+BuildingListIndexTestCase::BuildingListIndexTestCase()
+    : TestCase("BuildingList spatial index matches a linear scan")
+{
+}
+
+void
+BuildingListIndexTestCase::CheckQueries(Ptr<UniformRandomVariable> rv)
+{
+    auto randomPosition = [rv]() {
+        return Vector(rv->GetValue(-10, 210), rv->GetValue(-10, 210), rv->GetValue(0, 30));
+    };
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        Vector pos = randomPosition();
+        std::vector<Ptr<Building>> expected;
+        for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+        {
+            if ((*bit)->IsInside(pos))
+            {
+                expected.push_back(*bit);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ((BuildingList::GetBuildingsContaining(pos) == expected),
+                              true,
+                              "Wrong buildings containing " << pos);
+
+        Vector l1 = randomPosition();
+        Vector l2 = rv->GetValue() < 0.5 ? randomPosition()
+                                          : Vector(l1.x + rv->GetValue(-20, 20),
+                                                   l1.y + rv->GetValue(-20, 20),
+                                                   l1.z);
+        expected.clear();
+        for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+        {
+            if ((*bit)->IsIntersect(l1, l2))
+            {
+                expected.push_back(*bit);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ((BuildingList::GetBuildingsIntersecting(l1, l2) == expected),
+                              true,
+                              "Wrong buildings intersecting " << l1 << " " << l2);
+        NS_TEST_ASSERT_MSG_EQ(BuildingList::IsAnyBuildingIntersecting(l1, l2),
+                              !expected.empty(),
+                              "Wrong intersection of " << l1 << " " << l2);
+    }
+}
+
+void
+BuildingListIndexTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable>();
+    rv->SetStream(1);
+
+    // a grid of buildings of random size, which may overlap
+    for (uint32_t x = 0; x < 10; x++)
+    {
+        for (uint32_t y = 0; y < 10; y++)
+        {
+            Ptr<Building> b = CreateObject<Building>();
+            b->SetBoundaries(Box(20 * x,
+                                 20 * x + rv->GetValue(2, 25),
+                                 20 * y,
+                                 20 * y + rv->GetValue(2, 25),
+                                 0,
+                                 rv->GetValue(3, 30)));
+        }
+    }
+    CheckQueries(rv);
+
+    // move some of the buildings, which must invalidate the index
+    for (uint32_t i = 0; i < BuildingList::GetNBuildings(); i += 7)
+    {
+        double x = rv->GetValue(0, 180);
+        double y = rv->GetValue(0, 180);
+        BuildingList::GetBuilding(i)->SetBoundaries(Box(x, x + 15, y, y + 15, 0, 10));
+    }
+    CheckQueries(rv);
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup building-test
  *
@@ -341,6 +445,8 @@ BuildingsHelperTestSuite::BuildingsHelperTestSuite()
     q7.pos = vq7;
     q7.indoor = false;
     AddTestCase(new BuildingsHelperOneTestCase(q7, b2), TestCase::Duration::QUICK);
+
+    AddTestCase(new BuildingListIndexTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -20,6 +20,7 @@
 
 #include "buildings-pathloss-test.h"
 
+#include <ns3/boolean.h>
 #include <ns3/building.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/constant-position-mobility-model.h>
@@ -206,6 +207,8 @@ BuildingsPathlossTestSuite::BuildingsPathlossTestSuite()
                                               183.90,
                                               "ITU1411 NLOS Indoor -> Outdoor"),
                 TestCase::Duration::QUICK);
+
+    AddTestCase(new BuildingsPathlossCacheTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -356,3 +359,71 @@ BuildingsPathlossTestCase::CreateMobilityModel(uint16_t index)
     buildingInfo->MakeConsistent(mm);
     return mm;
 }
+
+BuildingsPathlossCacheTestCase::BuildingsPathlossCacheTestCase()
+    : TestCase("Buildings loss cache")
+{
+}
+
+void
+BuildingsPathlossCacheTestCase::DoRun()
+{
+    Ptr<Building> building = CreateObject<Building>();
+    building->SetBoundaries(Box(-100, -1, -50, 50, 0.0, 12));
+    building->SetExtWallsType(Building::ConcreteWithWindows);
+    building->SetNFloors(3);
+    building->SetNRoomsX(10);
+
+    // two nodes in different rooms of the building
+    std::vector<Ptr<MobilityModel>> mobility;
+    for (double x : {-95.0, -5.0})
+    {
+        Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel>();
+        mm->SetPosition(Vector(x, 0.0, 1.5));
+        Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo>();
+        mm->AggregateObject(buildingInfo);
+        buildingInfo->MakeConsistent(mm);
+        mobility.push_back(mm);
+    }
+
+    auto cached = CreateObject<HybridBuildingsPropagationLossModel>();
+    auto uncached = CreateObject<HybridBuildingsPropagationLossModel>();
+    for (auto model : {cached, uncached})
+    {
+        model->SetAttribute("ShadowSigmaOutdoor", DoubleValue(0.0));
+        model->SetAttribute("ShadowSigmaIndoor", DoubleValue(0.0));
+        model->SetAttribute("ShadowSigmaExtWalls", DoubleValue(0.0));
+    }
+    cached->SetAttribute("CacheLoss", BooleanValue(true));
+
+    double rxPower = cached->CalcRxPower(0, mobility[0], mobility[1]);
+    NS_TEST_ASSERT_MSG_EQ_TOL(rxPower,
+                              uncached->CalcRxPower(0, mobility[0], mobility[1]),
+                              1e-9,
+                              "Cached and computed losses differ");
+
+    // the internal walls loss changes, but not the cached loss until cleared
+    cached->SetAttribute("InternalWallLoss", DoubleValue(10.0));
+    uncached->SetAttribute("InternalWallLoss", DoubleValue(10.0));
+    NS_TEST_ASSERT_MSG_EQ(cached->CalcRxPower(0, mobility[0], mobility[1]),
+                          rxPower,
+                          "The loss was not cached");
+    cached->ClearLossCache();
+    NS_TEST_ASSERT_MSG_EQ_TOL(cached->CalcRxPower(0, mobility[0], mobility[1]),
+                              uncached->CalcRxPower(0, mobility[0], mobility[1]),
+                              1e-9,
+                              "The loss cache was not cleared");
+
+    // moving a node outdoor invalidates its links
+    mobility[1]->SetPosition(Vector(20, 0.0, 1.5));
+    NS_TEST_ASSERT_MSG_EQ_TOL(cached->CalcRxPower(0, mobility[0], mobility[1]),
+                              uncached->CalcRxPower(0, mobility[0], mobility[1]),
+                              1e-9,
+                              "The loss was not computed again after a move");
+    NS_TEST_ASSERT_MSG_EQ_TOL(cached->CalcRxPower(0, mobility[1], mobility[0]),
+                              uncached->CalcRxPower(0, mobility[1], mobility[0]),
+                              1e-9,
+                              "Wrong loss in the reverse direction");
+
+    Simulator::Destroy();
+}
@@ -84,4 +84,22 @@ class BuildingsPathlossTestCase : public TestCase
     double m_lossRef;               //!< Theoretical loss
 };
 
+/**
+ * \ingroup building-test
+ *
+ * Test 1.2 BuildingsPathlossModel loss cache test
+ *
+ * Checks that the losses cached per link when the CacheLoss attribute is true
+ * are kept while the nodes do not move, and computed again when the cache is
+ * cleared or when a node moves.
+ */
+class BuildingsPathlossCacheTestCase : public TestCase
+{
+  public:
+    BuildingsPathlossCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
 #endif /* BUILDING_PATHLOSS_TEST_H */
@@ -51,8 +51,9 @@ main(int argc, char* argv[])
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Without arguments, write out ConfigStore defaults, globals, and\n"
-              "test object ConfigExample attributes to text file output-attributes.txt\n"
-              "and (when XML supported) output-attributes.xml. Optionally set\n"
+              "test object ConfigExample attributes to text file output-attributes.txt,\n"
+              "binary file output-attributes.bin and (when XML supported)\n"
+              "output-attributes.xml. Optionally set\n"
               "attributes to write out using --load <filename> where <filename> is a\n"
               "previously saved config-store file to load.\n"
               "Observe load behavior by setting environment variable NS_LOG=RawTextConfig.");
@@ -66,6 +67,10 @@ main(int argc, char* argv[])
         {
             Config::SetDefault("ns3::ConfigStore::FileFormat", StringValue("Xml"));
         }
+        else if (loadfile.substr(loadfile.size() - 4) == ".bin")
+        {
+            Config::SetDefault("ns3::ConfigStore::FileFormat", StringValue("Binary"));
+        }
         else
         {
             Config::SetDefault("ns3::ConfigStore::FileFormat", StringValue("RawText"));
@@ -115,6 +120,14 @@ main(int argc, char* argv[])
     outputConfig2.ConfigureDefaults();
     outputConfig2.ConfigureAttributes();
 
+    // Output config store to binary format
+    Config::SetDefault("ns3::ConfigStore::Filename", StringValue("output-attributes.bin"));
+    Config::SetDefault("ns3::ConfigStore::FileFormat", StringValue("Binary"));
+    Config::SetDefault("ns3::ConfigStore::Mode", StringValue("Save"));
+    ConfigStore outputConfig3;
+    outputConfig3.ConfigureDefaults();
+    outputConfig3.ConfigureAttributes();
+
     Simulator::Run();
 
     Simulator::Destroy();
@@ -0,0 +1,120 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "attribute-loader.h"
+
+#include "ns3/config.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AttributeLoader");
+
+void
+AttributeLoader::Add(std::string path, std::string value)
+{
+    NS_LOG_FUNCTION(this << path << value);
+    m_values.emplace_back(std::move(path), std::move(value));
+}
+
+void
+AttributeLoader::Apply()
+{
+    NS_LOG_FUNCTION(this << m_values.size());
+
+    for (const auto& [path, value] : m_values)
+    {
+        std::string::size_type pos = path.rfind('/');
+        if (pos == std::string::npos)
+        {
+            NS_FATAL_ERROR("Invalid path " << path);
+        }
+        std::string name = path.substr(pos + 1);
+        const std::vector<Ptr<Object>>& objects = GetObjects(path.substr(0, pos));
+        if (objects.empty())
+        {
+            NS_LOG_WARN("No object matches " << path);
+            continue;
+        }
+
+        // the objects of a path are usually of the same type: parse the
+        // value once for each checker met
+        Ptr<const AttributeChecker> checker;
+        Ptr<AttributeValue> parsed;
+        for (const Ptr<Object>& object : objects)
+        {
+            TypeId tid = object->GetInstanceTypeId();
+            const Setter& setter = GetSetter(tid, name);
+            if (setter.checker != checker)
+            {
+                checker = setter.checker;
+                parsed = checker->CreateValidValue(StringValue(value));
+            }
+            if (!parsed || !setter.accessor->Set(PeekPointer(object), *parsed))
+            {
+                NS_FATAL_ERROR("Attribute name=" << name
+                                                 << " could not be set for this object: tid="
+                                                 << tid.GetName());
+            }
+        }
+    }
+    m_values.clear();
+    m_objects.clear();
+}
+
+const AttributeLoader::Setter&
+AttributeLoader::GetSetter(TypeId tid, const std::string& name)
+{
+    auto key = std::make_pair(tid.GetUid(), name);
+    auto it = m_setters.find(key);
+    if (it != m_setters.end())
+    {
+        return it->second;
+    }
+
+    NS_LOG_LOGIC("Look up " << name << " in " << tid.GetName());
+    TypeId::AttributeInformation info;
+    if (!tid.LookupAttributeByName(name, &info))
+    {
+        NS_FATAL_ERROR(
+            "Attribute name=" << name << " does not exist for this object: tid=" << tid.GetName());
+    }
+    if (!(info.flags & TypeId::ATTR_SET) || !info.accessor->HasSetter())
+    {
+        NS_FATAL_ERROR(
+            "Attribute name=" << name << " is not settable for this object: tid=" << tid.GetName());
+    }
+    return m_setters.emplace(key, Setter{info.accessor, info.checker}).first->second;
+}
+
+const std::vector<Ptr<Object>>&
+AttributeLoader::GetObjects(const std::string& path)
+{
+    auto it = m_objects.find(path);
+    if (it != m_objects.end())
+    {
+        return it->second;
+    }
+
+    NS_LOG_LOGIC("Resolve " << path);
+    Config::MatchContainer matches = Config::LookupMatches(path);
+    std::vector<Ptr<Object>> objects(matches.Begin(), matches.End());
+    return m_objects.emplace(path, std::move(objects)).first->second;
+}
+
+} // namespace ns3
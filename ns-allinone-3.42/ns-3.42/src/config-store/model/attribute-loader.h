@@ -0,0 +1,99 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ATTRIBUTE_LOADER_H
+#define ATTRIBUTE_LOADER_H
+
+#include "ns3/attribute.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup configstore
+ * \brief Set many attribute values, given by their Config path, at once.
+ *
+ * Config::Set resolves the path of each value from the root of the
+ * namespace, then looks the attribute up by name in the TypeId of each
+ * object matched, and parses the value for each of them. A configuration
+ * file with thousands of per-object values repeats this work for each
+ * line.
+ *
+ * The AttributeLoader collects the values, then applies them in order:
+ * the objects of each path, up to the attribute name, are resolved once;
+ * the accessor and checker of each attribute are looked up once per
+ * object type; and each value is parsed once per checker, then set
+ * directly with the accessor. The errors are those of Config::Set.
+ *
+ * The objects are resolved once per load: the values must not change the
+ * objects matched by the paths of the other values.
+ */
+class AttributeLoader
+{
+  public:
+    /**
+     * Add a value to set.
+     * \param path the Config path of the attribute
+     * \param value the value, serialized
+     */
+    void Add(std::string path, std::string value);
+
+    /**
+     * Set the values added, in the order they were added, and forget them.
+     */
+    void Apply();
+
+  private:
+    /// The accessor and checker of an attribute
+    struct Setter
+    {
+        Ptr<const AttributeAccessor> accessor; //!< Accessor
+        Ptr<const AttributeChecker> checker;   //!< Checker
+    };
+
+    /**
+     * Get the setter of an attribute of an object type.
+     * \param tid the type of the object
+     * \param name the name of the attribute
+     * \return the setter
+     */
+    const Setter& GetSetter(TypeId tid, const std::string& name);
+
+    /**
+     * Get the objects matching a path.
+     * \param path the Config path of the objects
+     * \return the objects
+     */
+    const std::vector<Ptr<Object>>& GetObjects(const std::string& path);
+
+    /// The values to set: path of the attribute, value
+    std::vector<std::pair<std::string, std::string>> m_values;
+    /// The setters, by type id and attribute name
+    std::map<std::pair<uint16_t, std::string>, Setter> m_setters;
+    /// The objects resolved, by path
+    std::unordered_map<std::string, std::vector<Ptr<Object>>> m_objects;
+};
+
+} // namespace ns3
+
+#endif /* ATTRIBUTE_LOADER_H */
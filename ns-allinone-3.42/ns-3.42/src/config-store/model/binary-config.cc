@@ -0,0 +1,327 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "binary-config.h"
+
+#include "attribute-default-iterator.h"
+#include "attribute-iterator.h"
+#include "attribute-loader.h"
+
+#include "ns3/config.h"
+#include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+
+#include <iterator>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryConfig");
+
+const std::string BinaryConfig::MAGIC("NS3CONF\x01", 8);
+
+namespace
+{
+/**
+ * Write a string as its 32 bit little-endian length followed by its characters.
+ * \param os the output stream
+ * \param str the string
+ */
+void
+WriteString(std::ostream& os, const std::string& str)
+{
+    auto size = static_cast<uint32_t>(str.size());
+    char length[4] = {static_cast<char>(size),
+                      static_cast<char>(size >> 8),
+                      static_cast<char>(size >> 16),
+                      static_cast<char>(size >> 24)};
+    os.write(length, 4);
+    os.write(str.data(), str.size());
+}
+
+/**
+ * Read a string written by WriteString.
+ * \param data the buffer read from
+ * \param end the end of the buffer
+ * \param [out] str the string
+ * \return the position following the string, or nullptr if the buffer is too short
+ */
+const char*
+ReadString(const char* data, const char* end, std::string& str)
+{
+    if (end - data < 4)
+    {
+        return nullptr;
+    }
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+    uint32_t size = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (uint32_t(bytes[3]) << 24);
+    data += 4;
+    if (static_cast<uint64_t>(end - data) < size)
+    {
+        return nullptr;
+    }
+    str.assign(data, size);
+    return data + size;
+}
+
+/**
+ * Get the support level of an attribute.
+ * \param tid the type of the object
+ * \param name the name of the attribute
+ * \return the support level
+ */
+TypeId::SupportLevel
+GetSupportLevel(TypeId tid, const std::string& name)
+{
+    for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+    {
+        TypeId::AttributeInformation tmp = tid.GetAttribute(i);
+        if (tmp.name == name)
+        {
+            return tmp.supportLevel;
+        }
+    }
+    return TypeId::SupportLevel::SUPPORTED;
+}
+
+/**
+ * Get the name of a support level, for the logs.
+ * \param supportLevel the support level
+ * \return the name
+ */
+std::string
+GetSupportLevelName(TypeId::SupportLevel supportLevel)
+{
+    return supportLevel == TypeId::SupportLevel::OBSOLETE ? "OBSOLETE" : "DEPRECATED";
+}
+} // namespace
+
+void
+BinaryConfig::Write(std::ostream& os, Kind kind, const std::string& name, const std::string& value)
+{
+    os.put(static_cast<char>(kind));
+    WriteString(os, name);
+    WriteString(os, value);
+}
+
+BinaryConfigSave::BinaryConfigSave()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BinaryConfigSave::~BinaryConfigSave()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+BinaryConfigSave::SetFilename(std::string filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_os.open(filename, std::ios::out | std::ios::binary);
+    m_os << BinaryConfig::MAGIC;
+}
+
+void
+BinaryConfigSave::Default()
+{
+    NS_LOG_FUNCTION(this);
+
+    class BinaryDefaultIterator : public AttributeDefaultIterator
+    {
+      public:
+        BinaryDefaultIterator(std::ostream* os, bool saveDeprecated)
+            : m_os(os),
+              m_saveDeprecated(saveDeprecated)
+        {
+        }
+
+      private:
+        void StartVisitTypeId(std::string name) override
+        {
+            m_typeId = name;
+        }
+
+        void DoVisitAttribute(std::string name, std::string defaultValue) override
+        {
+            TypeId::SupportLevel supportLevel =
+                GetSupportLevel(TypeId::LookupByName(m_typeId), name);
+            if (supportLevel == TypeId::SupportLevel::OBSOLETE ||
+                (supportLevel == TypeId::SupportLevel::DEPRECATED && !m_saveDeprecated))
+            {
+                NS_LOG_WARN("Global attribute " << m_typeId << "::" << name
+                                                << " was not saved because it is "
+                                                << GetSupportLevelName(supportLevel));
+                return;
+            }
+            NS_LOG_DEBUG("Saving " << m_typeId << "::" << name);
+            BinaryConfig::Write(*m_os,
+                                BinaryConfig::DEFAULT,
+                                m_typeId + "::" + name,
+                                defaultValue);
+        }
+
+        std::string m_typeId;
+        std::ostream* m_os;
+        bool m_saveDeprecated;
+    };
+
+    BinaryDefaultIterator iterator(&m_os, m_saveDeprecated);
+    iterator.Iterate();
+}
+
+void
+BinaryConfigSave::Global()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = GlobalValue::Begin(); i != GlobalValue::End(); ++i)
+    {
+        StringValue value;
+        (*i)->GetValue(value);
+        NS_LOG_LOGIC("Saving " << (*i)->GetName());
+        BinaryConfig::Write(m_os, BinaryConfig::GLOBAL, (*i)->GetName(), value.Get());
+    }
+}
+
+void
+BinaryConfigSave::Attributes()
+{
+    NS_LOG_FUNCTION(this);
+
+    class BinaryAttributeIterator : public AttributeIterator
+    {
+      public:
+        BinaryAttributeIterator(std::ostream* os, bool saveDeprecated)
+            : m_os(os),
+              m_saveDeprecated(saveDeprecated)
+        {
+        }
+
+      private:
+        void DoVisitAttribute(Ptr<Object> object, std::string name) override
+        {
+            TypeId::SupportLevel supportLevel =
+                GetSupportLevel(object->GetInstanceTypeId(), name);
+            if (supportLevel == TypeId::SupportLevel::OBSOLETE ||
+                (supportLevel == TypeId::SupportLevel::DEPRECATED && !m_saveDeprecated))
+            {
+                NS_LOG_WARN("Attribute " << GetCurrentPath() << " was not saved because it is "
+                                         << GetSupportLevelName(supportLevel));
+                return;
+            }
+            StringValue str;
+            object->GetAttribute(name, str);
+            NS_LOG_DEBUG("Saving " << GetCurrentPath());
+            BinaryConfig::Write(*m_os, BinaryConfig::VALUE, GetCurrentPath(), str.Get());
+        }
+
+        std::ostream* m_os;
+        bool m_saveDeprecated;
+    };
+
+    BinaryAttributeIterator iter(&m_os, m_saveDeprecated);
+    iter.Iterate();
+}
+
+BinaryConfigLoad::BinaryConfigLoad()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BinaryConfigLoad::~BinaryConfigLoad()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+BinaryConfigLoad::SetFilename(std::string filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    std::ifstream is(filename, std::ios::in | std::ios::binary);
+    if (!is)
+    {
+        NS_FATAL_ERROR("Unable to open " << filename);
+    }
+    std::string contents((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    if (contents.compare(0, BinaryConfig::MAGIC.size(), BinaryConfig::MAGIC) != 0)
+    {
+        NS_FATAL_ERROR(filename << " is not a binary configuration file");
+    }
+
+    m_records.clear();
+    const char* data = contents.data() + BinaryConfig::MAGIC.size();
+    const char* end = contents.data() + contents.size();
+    while (data != end)
+    {
+        Record record;
+        record.kind = static_cast<BinaryConfig::Kind>(*data++);
+        data = ReadString(data, end, record.name);
+        data = data != nullptr ? ReadString(data, end, record.value) : nullptr;
+        if (data == nullptr || record.kind > BinaryConfig::VALUE)
+        {
+            NS_FATAL_ERROR("Corrupted record " << m_records.size() << " in " << filename);
+        }
+        m_records.push_back(std::move(record));
+    }
+    NS_LOG_DEBUG("Read " << m_records.size() << " records");
+}
+
+void
+BinaryConfigLoad::Default()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& record : m_records)
+    {
+        if (record.kind == BinaryConfig::DEFAULT)
+        {
+            NS_LOG_DEBUG("default=" << record.name << ", value=" << record.value);
+            Config::SetDefault(record.name, StringValue(record.value));
+        }
+    }
+}
+
+void
+BinaryConfigLoad::Global()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& record : m_records)
+    {
+        if (record.kind == BinaryConfig::GLOBAL)
+        {
+            NS_LOG_DEBUG("global=" << record.name << ", value=" << record.value);
+            Config::SetGlobal(record.name, StringValue(record.value));
+        }
+    }
+}
+
+void
+BinaryConfigLoad::Attributes()
+{
+    NS_LOG_FUNCTION(this);
+    AttributeLoader loader;
+    for (const auto& record : m_records)
+    {
+        if (record.kind == BinaryConfig::VALUE)
+        {
+            NS_LOG_DEBUG("path=" << record.name << ", value=" << record.value);
+            loader.Add(record.name, record.value);
+        }
+    }
+    loader.Apply();
+}
+
+} // namespace ns3
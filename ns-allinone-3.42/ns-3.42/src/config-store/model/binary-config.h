@@ -0,0 +1,115 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BINARY_CONFIG_H
+#define BINARY_CONFIG_H
+
+#include "file-config.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup configstore
+ * \brief Records of the binary configuration store files.
+ *
+ * A binary file starts with MAGIC, followed by records made of the kind of
+ * the record on one byte, then of the name (or path) and of the value,
+ * each as a 32 bit little-endian length followed by the characters. The
+ * records are read without any parsing nor unquoting.
+ */
+class BinaryConfig
+{
+  public:
+    /// Kinds of the records
+    enum Kind : uint8_t
+    {
+        DEFAULT = 0, //!< Default value of an attribute, by full name
+        GLOBAL = 1,  //!< Global value, by name
+        VALUE = 2,   //!< Value of an attribute, by Config path
+    };
+
+    /// Magic string starting the files
+    static const std::string MAGIC;
+
+    /**
+     * Write a record.
+     * \param os the output stream
+     * \param kind the kind of the record
+     * \param name the name or path
+     * \param value the value
+     */
+    static void Write(std::ostream& os,
+                      Kind kind,
+                      const std::string& name,
+                      const std::string& value);
+};
+
+/**
+ * \ingroup configstore
+ * \brief A class to enable saving of configuration store in a binary file
+ */
+class BinaryConfigSave : public FileConfig
+{
+  public:
+    BinaryConfigSave();
+    ~BinaryConfigSave() override;
+
+    void SetFilename(std::string filename) override;
+    void Default() override;
+    void Global() override;
+    void Attributes() override;
+
+  private:
+    std::ofstream m_os; ///< Config store output stream
+};
+
+/**
+ * \ingroup configstore
+ * \brief A class to enable loading of configuration store from a binary file
+ *
+ * The file is read once, when its name is set.
+ */
+class BinaryConfigLoad : public FileConfig
+{
+  public:
+    BinaryConfigLoad();
+    ~BinaryConfigLoad() override;
+
+    void SetFilename(std::string filename) override;
+    void Default() override;
+    void Global() override;
+    void Attributes() override;
+
+  private:
+    /// A record of the file
+    struct Record
+    {
+        BinaryConfig::Kind kind; //!< Kind of the record
+        std::string name;        //!< Name or path
+        std::string value;       //!< Value
+    };
+
+    std::vector<Record> m_records; ///< The records of the file
+};
+
+} // namespace ns3
+
+#endif /* BINARY_CONFIG_H */
@@ -19,6 +19,7 @@
 
 #include "config-store.h"
 
+#include "binary-config.h"
 #include "raw-text-config.h"
 
 #include "ns3/abort.h"
@@ -73,7 +74,12 @@ ConfigStore::GetTypeId()
                 "Type of file format",
                 EnumValue(ConfigStore::RAW_TEXT),
                 MakeEnumAccessor<FileFormat>(&ConfigStore::SetFileFormat),
-                MakeEnumChecker(ConfigStore::RAW_TEXT, "RawText", ConfigStore::XML, "Xml"))
+                MakeEnumChecker(ConfigStore::RAW_TEXT,
+                                "RawText",
+                                ConfigStore::XML,
+                                "Xml",
+                                ConfigStore::BINARY,
+                                "Binary"))
             .AddAttribute("SaveDeprecated",
                           "Save DEPRECATED attributes",
                           BooleanValue(true),
@@ -139,6 +145,22 @@ ConfigStore::ConfigStore()
             m_file = new NoneFileConfig();
         }
     }
+
+    if (m_fileFormat == ConfigStore::BINARY)
+    {
+        if (m_mode == ConfigStore::SAVE)
+        {
+            m_file = new BinaryConfigSave();
+        }
+        else if (m_mode == ConfigStore::LOAD)
+        {
+            m_file = new BinaryConfigLoad();
+        }
+        else
+        {
+            m_file = new NoneFileConfig();
+        }
+    }
     m_file->SetFilename(m_filename);
     m_file->SetSaveDeprecated(m_saveDeprecated);
 
@@ -227,6 +249,9 @@ operator<<(std::ostream& os, ConfigStore::FileFormat& format)
     case ConfigStore::RAW_TEXT:
         os << "RAW_TEXT";
         break;
+    case ConfigStore::BINARY:
+        os << "BINARY";
+        break;
     }
     return os;
 }
@@ -79,7 +79,8 @@ class ConfigStore : public ObjectBase
     enum FileFormat
     {
         XML,
-        RAW_TEXT
+        RAW_TEXT,
+        BINARY
     };
 
     /**
@@ -21,6 +21,7 @@
 
 #include "attribute-default-iterator.h"
 #include "attribute-iterator.h"
+#include "attribute-loader.h"
 
 #include "ns3/config.h"
 #include "ns3/global-value.h"
@@ -303,6 +304,7 @@ RawTextConfigLoad::Attributes()
     std::string type;
     std::string name;
     std::string value;
+    AttributeLoader loader;
     for (std::string line; std::getline(*m_is, line);)
     {
         if (!ParseLine(line, type, name, value))
@@ -314,12 +316,13 @@ RawTextConfigLoad::Attributes()
         value = Strip(value);
         if (type == "value")
         {
-            Config::Set(name, StringValue(value));
+            loader.Add(name, value);
         }
         name.clear();
         type.clear();
         value.clear();
     }
+    loader.Apply();
 }
 
 bool
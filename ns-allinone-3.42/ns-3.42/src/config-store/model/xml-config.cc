@@ -21,6 +21,7 @@
 
 #include "attribute-default-iterator.h"
 #include "attribute-iterator.h"
+#include "attribute-loader.h"
 
 #include "ns3/config.h"
 #include "ns3/fatal-error.h"
@@ -403,6 +404,7 @@ XmlConfigLoad::Attributes()
     {
         NS_FATAL_ERROR("Error at xmlReaderForFile");
     }
+    AttributeLoader loader;
     int rc;
     rc = xmlTextReaderRead(reader);
     while (rc > 0)
@@ -425,13 +427,14 @@ XmlConfigLoad::Attributes()
                 NS_FATAL_ERROR("Error getting attribute 'value'");
             }
             NS_LOG_DEBUG("path=" << (char*)path << ", value=" << (char*)value);
-            Config::Set((char*)path, StringValue((char*)value));
+            loader.Add((char*)path, (char*)value);
             xmlFree(path);
             xmlFree(value);
         }
         rc = xmlTextReaderRead(reader);
     }
     xmlFreeTextReader(reader);
+    loader.Apply();
 }
 
 } // namespace ns3
@@ -158,6 +158,58 @@ const char* NS_GLOBAL_VALUE = "name=value[;...]";
  */
 const char* NS_LOG = "component=option[|option...][:...]";
 
+/**
+ * \ingroup core-environ
+ * \brief Account for the memory held by the simulation, by type.
+ *
+ * When set, ns3::MemoryAccounting is enabled from the start of the
+ * program, and its report is printed to \c std::clog at the end of each
+ * ns3::Simulator::Run().
+ *
+ * <dl class="params">
+ *   <dt>%Parameters</dt>
+ *   <dd>
+ *     <table class="params">
+ *       <tr>
+ *         <td class="paramname">n</td>
+ *         <td>The number of types reported, 20 by default.</td>
+ *       </tr>
+ *     </table>
+ *   </dd>
+ * </dl>
+ *
+ * Referenced by ns3::MemoryAccounting::PrintRequestedReport().
+ */
+const char* NS_MEMORY_ACCOUNTING = "[n]";
+
+/**
+ * \ingroup core-environ
+ * \brief Write the progress of each simulation run.
+ *
+ * When set, an ns3::SimulationTelemetry is started at the start of the
+ * first ns3::Simulator::Run(), and writes its final record at the end of
+ * each run.
+ *
+ * <dl class="params">
+ *   <dt>%Parameters</dt>
+ *   <dd>
+ *     <table class="params">
+ *       <tr>
+ *         <td class="paramname">file</td>
+ *         <td>The file the records are appended to; \c std::clog by default.</td>
+ *       </tr>
+ *       <tr>
+ *         <td class="paramname">interval</td>
+ *         <td>The wall clock interval between the records, in seconds; 10 by default.</td>
+ *       </tr>
+ *     </table>
+ *   </dd>
+ * </dl>
+ *
+ * Referenced by ns3::SimulationTelemetry::StartRequested().
+ */
+const char* NS_TELEMETRY = "[file=path][;interval=seconds]";
+
 /**
  * \ingroup core-environ
  * \brief Where to make temporary directories.
@@ -29,6 +29,7 @@
 
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -247,9 +248,9 @@ class CallbackImpl : public CallbackImplBase
      * \param func the callable object
      * \param components the callback components (callable object and bound arguments)
      */
-    CallbackImpl(std::function<R(UArgs...)> func, const CallbackComponentVector& components)
-        : m_func(func),
-          m_components(components)
+    CallbackImpl(std::function<R(UArgs...)> func, CallbackComponentVector components)
+        : m_func(std::move(func)),
+          m_components(std::move(components))
     {
     }
 
@@ -279,7 +280,7 @@ class CallbackImpl : public CallbackImplBase
      */
     R operator()(UArgs... uargs) const
     {
-        return m_func(uargs...);
+        return m_func(std::forward<UArgs>(uargs)...);
     }
 
     bool IsEqual(Ptr<const CallbackImplBase> other) const override
@@ -474,7 +475,7 @@ class Callback : public CallbackBase
             [f, bargs...](auto&&... uargs) -> R {
                 return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
             },
-            components);
+            std::move(components));
     }
 
     /**
@@ -496,9 +497,6 @@ class Callback : public CallbackBase
                                int> = 0>
     Callback(T func, BArgs... bargs)
     {
-        // store the function in a std::function object
-        std::function<R(BArgs..., UArgs...)> f(func);
-
         // The original function is comparable if it is a function pointer or
         // a pointer to a member function or a pointer to a member data.
         constexpr bool isComp =
@@ -508,11 +506,24 @@ class Callback : public CallbackBase
             {std::make_shared<CallbackComponent<T, isComp>>(func),
              std::make_shared<CallbackComponent<std::decay_t<BArgs>>>(bargs)...});
 
+        // Store the callable object directly in the lambda rather than in an
+        // intermediate std::function, which would cost an extra indirection per
+        // call and possibly a heap allocation. The bound arguments are passed as
+        // copies, as they would be by a std::function<R(BArgs..., UArgs...)>.
         m_impl = Create<CallbackImpl<R, UArgs...>>(
-            [f, bargs...](auto&&... uargs) -> R {
-                return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
+            [func, bargs...](auto&&... uargs) mutable -> R {
+                if constexpr (std::is_void_v<R>)
+                {
+                    std::invoke(func, BArgs(bargs)..., std::forward<decltype(uargs)>(uargs)...);
+                }
+                else
+                {
+                    return std::invoke(func,
+                                       BArgs(bargs)...,
+                                       std::forward<decltype(uargs)>(uargs)...);
+                }
             },
-            components);
+            std::move(components));
     }
 
   private:
@@ -542,7 +553,7 @@ class Callback : public CallbackBase
             [f, bargs...](auto&&... uargs) mutable {
                 return f(bargs..., std::forward<decltype(uargs)>(uargs)...);
             },
-            components);
+            std::move(components));
 
         return cb;
     }
@@ -587,7 +598,7 @@ class Callback : public CallbackBase
      */
     R operator()(UArgs... uargs) const
     {
-        return (*(DoPeekImpl()))(uargs...);
+        return (*(DoPeekImpl()))(std::forward<UArgs>(uargs)...);
     }
 
     /**
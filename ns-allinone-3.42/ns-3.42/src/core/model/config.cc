@@ -26,6 +26,8 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 /**
@@ -201,6 +203,9 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, into the set of ranges of indices
+ * it matches.
  */
 class ArrayMatcher
 {
@@ -218,8 +223,22 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the indices matched in a container, unless they are many.
+     *
+     * \param [in] n The number of items in the container.
+     * \param [out] indices The indices matched below \p n, in increasing order.
+     * \returns \c false if it is cheaper to test every index with Matches().
+     */
+    bool GetIndices(std::size_t n, std::vector<std::size_t>& indices) const;
 
   private:
+    /**
+     * Parse a Config path specification, or one of its alternatives.
+     *
+     * \param [in] element The specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -230,77 +249,115 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether the element matches any index. */
+    bool m_any;
+    /** The inclusive ranges of indices matched. */
+    std::vector<std::pair<uint32_t, uint32_t>> m_ranges;
 
 }; // class ArrayMatcher
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_any(false)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_any = true;
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        Parse(element.substr(0, tmp - 0));
+        Parse(element.substr(tmp + 1, element.size() - (tmp + 1)));
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_any)
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& [min, max] : m_ranges)
+    {
+        if (i >= min && i <= max)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::GetIndices(std::size_t n, std::vector<std::size_t>& indices) const
+{
+    NS_LOG_FUNCTION(this << n);
+    indices.clear();
+    if (m_any)
+    {
+        return false;
+    }
+    std::size_t count = 0;
+    for (const auto& [min, max] : m_ranges)
+    {
+        if (min < n)
+        {
+            count += std::min<std::size_t>(max, n - 1) - min + 1;
+        }
+    }
+    if (count >= n)
+    {
+        return false;
+    }
+    for (const auto& [min, max] : m_ranges)
+    {
+        for (std::size_t i = min; i < n && i <= max; i++)
+        {
+            indices.push_back(i);
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return true;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -311,6 +368,123 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * An element of a Config path, with what was learned matching it.
+ */
+struct PathSegment
+{
+    /** An attribute of an object type matched by the element. */
+    struct Attribute
+    {
+        /** The attribute name. */
+        std::string name;
+        /** Whether the attribute is a pointer to an object. */
+        bool isPointer;
+        /** Whether the attribute is a container of objects. */
+        bool isContainer;
+        /**
+         * The container accessor, to get the matching items one by one,
+         * or \c nullptr to get the whole container with GetAttribute().
+         */
+        const ObjectPtrContainerAccessor* accessor;
+    };
+
+    /**
+     * Constructor.
+     *
+     * \param [in] element The element of the Config path.
+     */
+    PathSegment(std::string element);
+
+    /**
+     * Get the pointer and container attributes of a type matched
+     * by this element.
+     *
+     * \param [in] tid The type.
+     * \returns The attributes, in the order of the type and its parents.
+     */
+    const std::vector<Attribute>& GetAttributes(TypeId tid);
+
+    /** The element of the Config path. */
+    std::string item;
+    /** Whether the remaining path starts with "/Names". */
+    bool names;
+    /** The element as an array index specification. */
+    ArrayMatcher matcher;
+    /** Whether the element is an aggregated object "$TypeId". */
+    bool isGetObject;
+    /** The TypeId of the aggregated object, if looked up already. */
+    TypeId getObjectTid;
+    /** The matched attributes of the types seen, by TypeId uid. */
+    std::map<uint16_t, std::vector<Attribute>> attributes;
+};
+
+PathSegment::PathSegment(std::string element)
+    : item(element),
+      names(element.compare(0, 5, "Names") == 0),
+      matcher(element),
+      isGetObject(element.find('$') == 0)
+{
+}
+
+const std::vector<PathSegment::Attribute>&
+PathSegment::GetAttributes(TypeId instanceTid)
+{
+    auto found = attributes.find(instanceTid.GetUid());
+    if (found != attributes.end())
+    {
+        return found->second;
+    }
+    std::vector<Attribute>& matched = attributes[instanceTid.GetUid()];
+    TypeId tid;
+    TypeId nextTid = instanceTid;
+    do
+    {
+        tid = nextTid;
+
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info;
+            info = tid.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            Attribute attribute{info.name, false, false, nullptr};
+            // attempt to cast to a pointer checker.
+            attribute.isPointer =
+                dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr;
+            // attempt to cast to an object vector.
+            attribute.isContainer =
+                dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                nullptr;
+            if (attribute.isContainer)
+            {
+                // GetAttribute() would use the attribute of this name
+                // nearest to the instance type
+                TypeId::AttributeInformation nearest;
+                instanceTid.LookupAttributeByName(info.name, &nearest);
+                if ((nearest.flags & TypeId::ATTR_GET) && nearest.accessor->HasGetter())
+                {
+                    attribute.accessor =
+                        dynamic_cast<const ObjectPtrContainerAccessor*>(
+                            PeekPointer(nearest.accessor));
+                }
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+            if (attribute.isPointer || attribute.isContainer)
+            {
+                matched.push_back(attribute);
+            }
+        }
+
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return matched;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -319,11 +493,11 @@ class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from the elements of a Config path.
      *
-     * \param [in] path The Config path.
+     * \param [in] segments The elements of the Config path.
      */
-    Resolver(std::string path);
+    Resolver(std::vector<PathSegment>& segments);
     /** Destructor. */
     virtual ~Resolver();
 
@@ -337,23 +511,24 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] index The index of the next element of the Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t index, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] index The index of the next element of the Config path.
+     * \param [in] root The object holding the container.
+     * \param [in] attribute The container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t index,
+                        Ptr<Object> root,
+                        const PathSegment::Attribute& attribute);
     /**
      * Handle one object found on the path.
      *
@@ -376,16 +551,15 @@ class Resolver
 
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
-    /** The Config path. */
-    std::string m_path;
+    /** The elements of the Config path. */
+    std::vector<PathSegment>& m_segments;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+Resolver::Resolver(std::vector<PathSegment>& segments)
+    : m_segments(segments)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << segments.size());
 }
 
 Resolver::~Resolver()
@@ -393,32 +567,12 @@ Resolver::~Resolver()
     NS_LOG_FUNCTION(this);
 }
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
-
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
-}
-
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -444,13 +598,11 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t index, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << index << root);
 
-    if (next == std::string::npos)
+    if (index == m_segments.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -466,8 +618,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    PathSegment& segment = m_segments[index];
+    const std::string& item = segment.item;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -478,11 +630,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (segment.names)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(index + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -499,7 +650,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(index + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -515,85 +666,63 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (segment.isGetObject)
     {
         // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
-        Ptr<Object> object = root->GetObject<Object>(tid);
+        NS_LOG_DEBUG("GetObject=" << item.substr(1) << " on path=" << GetResolvedPath());
+        if (segment.getObjectTid == TypeId())
+        {
+            segment.getObjectTid = TypeId::LookupByName(item.substr(1));
+        }
+        Ptr<Object> object = root->GetObject<Object>(segment.getObjectTid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << item.substr(1)
+                                       << ") failed on path=" << GetResolvedPath());
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(index + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
+        const auto& attributes = segment.GetAttributes(root->GetInstanceTypeId());
         bool foundMatch = false;
 
-        do
+        for (const auto& attribute : attributes)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (attribute.isPointer)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                root->GetAttribute(attribute.name, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoResolve(index + 1, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            if (attribute.isContainer)
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoArrayResolve(index + 1, root, attribute);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -605,32 +734,160 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t index,
+                         Ptr<Object> root,
+                         const PathSegment::Attribute& attribute)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << index << root << attribute.name);
+    if (index == m_segments.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_segments[index].matcher;
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
+    // The matching items, in increasing index order
+    std::vector<std::pair<std::size_t, Ptr<Object>>> items;
+    std::size_t n;
+    if (attribute.accessor && attribute.accessor->GetItemN(PeekPointer(root), &n))
     {
-        if (matcher.Matches((*it).first))
+        // Get only the items matched by an explicit index, when they are
+        // at the position of their index, like in a vector
+        std::vector<std::size_t> indices;
+        bool direct = matcher.GetIndices(n, indices);
+        for (std::size_t i : indices)
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            std::size_t itemIndex;
+            Ptr<Object> object = attribute.accessor->GetItem(PeekPointer(root), i, &itemIndex);
+            if (itemIndex != i)
+            {
+                direct = false;
+                items.clear();
+                break;
+            }
+            items.emplace_back(itemIndex, object);
+        }
+        if (!direct)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                std::size_t itemIndex;
+                Ptr<Object> object = attribute.accessor->GetItem(PeekPointer(root), i, &itemIndex);
+                items.emplace_back(itemIndex, object);
+            }
+            // Like ObjectPtrContainerValue: sorted, and the last item wins an index
+            auto byIndex = [](const auto& a, const auto& b) { return a.first < b.first; };
+            std::stable_sort(items.begin(), items.end(), byIndex);
+            std::vector<std::pair<std::size_t, Ptr<Object>>> unique;
+            for (std::size_t i = 0; i < items.size(); i++)
+            {
+                if (i + 1 < items.size() && items[i + 1].first == items[i].first)
+                {
+                    continue;
+                }
+                if (matcher.Matches(items[i].first))
+                {
+                    unique.push_back(items[i]);
+                }
+            }
+            items.swap(unique);
         }
     }
+    else
+    {
+        ObjectPtrContainerValue container;
+        root->GetAttribute(attribute.name, container);
+        for (auto it = container.Begin(); it != container.End(); ++it)
+        {
+            if (matcher.Matches((*it).first))
+            {
+                items.emplace_back((*it).first, (*it).second);
+            }
+        }
+    }
+
+    for (const auto& [itemIndex, object] : items)
+    {
+        m_workStack.push_back(std::to_string(itemIndex));
+        DoResolve(index + 1, object);
+        m_workStack.pop_back();
+    }
+}
+
+/**
+ * \ingroup config-impl
+ * The parsed form of a CompiledPath.
+ */
+struct CompiledPath::Impl
+{
+    /**
+     * Split a Config path into its elements.
+     *
+     * \param [in] path The Config path.
+     * \returns The elements.
+     */
+    static std::vector<PathSegment> Split(std::string path);
+
+    /** The Config path. */
+    std::string path;
+    /** The leading part of the path, up to the final slash. */
+    std::string root;
+    /** The trailing part of the path, the attribute or trace source name. */
+    std::string leaf;
+    /** The elements of the whole path, to look up objects. */
+    std::vector<PathSegment> segments;
+    /** The elements of the leading part, to look up the objects of the leaf. */
+    std::vector<PathSegment> rootSegments;
+};
+
+std::vector<PathSegment>
+CompiledPath::Impl::Split(std::string path)
+{
+    NS_LOG_FUNCTION(path);
+
+    // ensure that we start and end with a '/'
+    std::string::size_type tmp = path.find('/');
+    if (tmp != 0)
+    {
+        // no slash at start
+        path = "/" + path;
+    }
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
+    {
+        // no slash at end
+        path = path + "/";
+    }
+
+    std::vector<PathSegment> segments;
+    std::string::size_type start = 0;
+    std::string::size_type next = path.find('/', start + 1);
+    while (next != std::string::npos)
+    {
+        segments.emplace_back(path.substr(start + 1, next - (start + 1)));
+        start = next;
+        next = path.find('/', start + 1);
+    }
+    return segments;
+}
+
+CompiledPath::CompiledPath(std::string path)
+    : m_impl(std::make_shared<Impl>())
+{
+    NS_LOG_FUNCTION(this << path);
+
+    m_impl->path = path;
+    // Without slash, a path can only be used to look up objects
+    std::string::size_type slash = path.find_last_of('/');
+    m_impl->root = path.substr(0, slash);
+    m_impl->leaf = path.substr(slash + 1, path.size() - (slash + 1));
+    m_impl->segments = Impl::Split(path);
+    m_impl->rootSegments = Impl::Split(m_impl->root);
+}
+
+std::string
+CompiledPath::GetPath() const
+{
+    return m_impl->path;
 }
 
 /**
@@ -642,20 +899,20 @@ class ConfigImpl : public Singleton<ConfigImpl>
   public:
     // Keep Set and SetFailSafe since their errors are triggered
     // by the underlying ObjectBase functions.
-    /** \copydoc ns3::Config::Set() */
-    void Set(std::string path, const AttributeValue& value);
-    /** \copydoc ns3::Config::SetFailSafe() */
-    bool SetFailSafe(std::string path, const AttributeValue& value);
-    /** \copydoc ns3::Config::ConnectWithoutContextFailSafe() */
-    bool ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::ConnectFailSafe() */
-    bool ConnectFailSafe(std::string path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::Set(std::string,const AttributeValue&) */
+    void Set(const CompiledPath& path, const AttributeValue& value);
+    /** \copydoc ns3::Config::SetFailSafe(std::string,const AttributeValue&) */
+    bool SetFailSafe(const CompiledPath& path, const AttributeValue& value);
+    /** \copydoc ns3::Config::ConnectWithoutContextFailSafe(std::string,const CallbackBase&) */
+    bool ConnectWithoutContextFailSafe(const CompiledPath& path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::ConnectFailSafe(std::string,const CallbackBase&) */
+    bool ConnectFailSafe(const CompiledPath& path, const CallbackBase& cb);
     /** \copydoc ns3::Config::DisconnectWithoutContext() */
-    void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
+    void DisconnectWithoutContext(const CompiledPath& path, const CallbackBase& cb);
     /** \copydoc ns3::Config::Disconnect() */
-    void Disconnect(std::string path, const CallbackBase& cb);
-    /** \copydoc ns3::Config::LookupMatches() */
-    MatchContainer LookupMatches(std::string path);
+    void Disconnect(const CompiledPath& path, const CallbackBase& cb);
+    /** \copydoc ns3::Config::LookupMatches(std::string) */
+    MatchContainer LookupMatches(const CompiledPath& path);
 
     /** \copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -669,13 +926,20 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
   private:
     /**
-     * Break a Config path into the leading path and the last leaf token.
+     * Find the objects matching a parsed Config path.
+     *
+     * \param [in] segments The elements of the Config path.
+     * \param [in] path The Config path.
+     * \returns The matching objects.
+     */
+    MatchContainer LookupMatches(std::vector<PathSegment>& segments, std::string path);
+    /**
+     * Find the objects holding the attribute or trace source of a Config path.
+     *
      * \param [in] path The Config path.
-     * \param [in,out] root The leading part of the \pname{path},
-     *   up to the final slash.
-     * \param [in,out] leaf The trailing part of the \pname{path}.
+     * \returns The matching objects.
      */
-    void ParsePath(std::string path, std::string* root, std::string* leaf) const;
+    MatchContainer LookupRootMatches(const CompiledPath& path);
 
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
@@ -685,61 +949,46 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
 }; // class ConfigImpl
 
-void
-ConfigImpl::ParsePath(std::string path, std::string* root, std::string* leaf) const
+MatchContainer
+ConfigImpl::LookupRootMatches(const CompiledPath& path)
 {
-    NS_LOG_FUNCTION(this << path << root << leaf);
-
-    std::string::size_type slash = path.find_last_of('/');
-    NS_ASSERT(slash != std::string::npos);
-    *root = path.substr(0, slash);
-    *leaf = path.substr(slash + 1, path.size() - (slash + 1));
-    NS_LOG_FUNCTION(path << *root << *leaf);
+    NS_ASSERT(path.m_impl->path.find('/') != std::string::npos);
+    return LookupMatches(path.m_impl->rootSegments, path.m_impl->root);
 }
 
 void
-ConfigImpl::Set(std::string path, const AttributeValue& value)
+ConfigImpl::Set(const CompiledPath& path, const AttributeValue& value)
 {
-    NS_LOG_FUNCTION(this << path << &value);
+    NS_LOG_FUNCTION(this << path.GetPath() << &value);
 
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    container.Set(leaf, value);
+    MatchContainer container = LookupRootMatches(path);
+    container.Set(path.m_impl->leaf, value);
 }
 
 bool
-ConfigImpl::SetFailSafe(std::string path, const AttributeValue& value)
+ConfigImpl::SetFailSafe(const CompiledPath& path, const AttributeValue& value)
 {
-    NS_LOG_FUNCTION(this << path << &value);
+    NS_LOG_FUNCTION(this << path.GetPath() << &value);
 
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.SetFailSafe(leaf, value);
+    MatchContainer container = LookupRootMatches(path);
+    return container.SetFailSafe(path.m_impl->leaf, value);
 }
 
 bool
-ConfigImpl::ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
+ConfigImpl::ConnectWithoutContextFailSafe(const CompiledPath& path, const CallbackBase& cb)
 {
-    NS_LOG_FUNCTION(this << path << &cb);
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectWithoutContextFailSafe(leaf, cb);
+    NS_LOG_FUNCTION(this << path.GetPath() << &cb);
+    MatchContainer container = LookupRootMatches(path);
+    return container.ConnectWithoutContextFailSafe(path.m_impl->leaf, cb);
 }
 
 void
-ConfigImpl::DisconnectWithoutContext(std::string path, const CallbackBase& cb)
+ConfigImpl::DisconnectWithoutContext(const CompiledPath& path, const CallbackBase& cb)
 {
-    NS_LOG_FUNCTION(this << path << &cb);
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
+    NS_LOG_FUNCTION(this << path.GetPath() << &cb);
+    const std::string& root = path.m_impl->root;
+    const std::string& leaf = path.m_impl->leaf;
+    MatchContainer container = LookupRootMatches(path);
     if (container.GetN() == 0)
     {
         std::size_t lastFwdSlash = root.rfind('/');
@@ -751,26 +1000,22 @@ ConfigImpl::DisconnectWithoutContext(std::string path, const CallbackBase& cb)
 }
 
 bool
-ConfigImpl::ConnectFailSafe(std::string path, const CallbackBase& cb)
+ConfigImpl::ConnectFailSafe(const CompiledPath& path, const CallbackBase& cb)
 {
-    NS_LOG_FUNCTION(this << path << &cb);
+    NS_LOG_FUNCTION(this << path.GetPath() << &cb);
 
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
-    return container.ConnectFailSafe(leaf, cb);
+    MatchContainer container = LookupRootMatches(path);
+    return container.ConnectFailSafe(path.m_impl->leaf, cb);
 }
 
 void
-ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
+ConfigImpl::Disconnect(const CompiledPath& path, const CallbackBase& cb)
 {
-    NS_LOG_FUNCTION(this << path << &cb);
+    NS_LOG_FUNCTION(this << path.GetPath() << &cb);
 
-    std::string root;
-    std::string leaf;
-    ParsePath(path, &root, &leaf);
-    MatchContainer container = LookupMatches(root);
+    const std::string& root = path.m_impl->root;
+    const std::string& leaf = path.m_impl->leaf;
+    MatchContainer container = LookupRootMatches(path);
     if (container.GetN() == 0)
     {
         std::size_t lastFwdSlash = root.rfind('/');
@@ -782,15 +1027,22 @@ ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
 }
 
 MatchContainer
-ConfigImpl::LookupMatches(std::string path)
+ConfigImpl::LookupMatches(const CompiledPath& path)
+{
+    NS_LOG_FUNCTION(this << path.GetPath());
+    return LookupMatches(path.m_impl->segments, path.m_impl->path);
+}
+
+MatchContainer
+ConfigImpl::LookupMatches(std::vector<PathSegment>& segments, std::string path)
 {
     NS_LOG_FUNCTION(this << path);
 
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
+        LookupMatchesResolver(std::vector<PathSegment>& segments)
+            : Resolver(segments)
         {
         }
 
@@ -802,7 +1054,7 @@ ConfigImpl::LookupMatches(std::string path)
 
         std::vector<Ptr<Object>> m_objects;
         std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+    } resolver = LookupMatchesResolver(segments);
 
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
@@ -880,14 +1132,14 @@ void
 Set(std::string path, const AttributeValue& value)
 {
     NS_LOG_FUNCTION(path << &value);
-    ConfigImpl::Get()->Set(path, value);
+    ConfigImpl::Get()->Set(CompiledPath(path), value);
 }
 
 bool
 SetFailSafe(std::string path, const AttributeValue& value)
 {
     NS_LOG_FUNCTION(path << &value);
-    return ConfigImpl::Get()->SetFailSafe(path, value);
+    return ConfigImpl::Get()->SetFailSafe(CompiledPath(path), value);
 }
 
 void
@@ -954,55 +1206,104 @@ void
 ConnectWithoutContext(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    if (!ConnectWithoutContextFailSafe(path, cb))
-    {
-        NS_FATAL_ERROR("Could not connect callback to " << path);
-    }
+    CompiledPath(path).ConnectWithoutContext(cb);
 }
 
 bool
 ConnectWithoutContextFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    return ConfigImpl::Get()->ConnectWithoutContextFailSafe(path, cb);
+    return ConfigImpl::Get()->ConnectWithoutContextFailSafe(CompiledPath(path), cb);
 }
 
 void
 DisconnectWithoutContext(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    ConfigImpl::Get()->DisconnectWithoutContext(path, cb);
+    ConfigImpl::Get()->DisconnectWithoutContext(CompiledPath(path), cb);
 }
 
 void
 Connect(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    if (!ConnectFailSafe(path, cb))
-    {
-        NS_FATAL_ERROR("Could not connect callback to " << path);
-    }
+    CompiledPath(path).Connect(cb);
 }
 
 bool
 ConnectFailSafe(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    return ConfigImpl::Get()->ConnectFailSafe(path, cb);
+    return ConfigImpl::Get()->ConnectFailSafe(CompiledPath(path), cb);
 }
 
 void
 Disconnect(std::string path, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(path << &cb);
-    ConfigImpl::Get()->Disconnect(path, cb);
+    ConfigImpl::Get()->Disconnect(CompiledPath(path), cb);
 }
 
 MatchContainer
 LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(path);
-    return ConfigImpl::Get()->LookupMatches(path);
+    return ConfigImpl::Get()->LookupMatches(CompiledPath(path));
+}
+
+void
+CompiledPath::Set(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(GetPath() << &value);
+    ConfigImpl::Get()->Set(*this, value);
+}
+
+bool
+CompiledPath::SetFailSafe(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(GetPath() << &value);
+    return ConfigImpl::Get()->SetFailSafe(*this, value);
+}
+
+void
+CompiledPath::ConnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(GetPath() << &cb);
+    if (!ConnectWithoutContextFailSafe(cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << GetPath());
+    }
+}
+
+bool
+CompiledPath::ConnectWithoutContextFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(GetPath() << &cb);
+    return ConfigImpl::Get()->ConnectWithoutContextFailSafe(*this, cb);
+}
+
+void
+CompiledPath::Connect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(GetPath() << &cb);
+    if (!ConnectFailSafe(cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << GetPath());
+    }
+}
+
+bool
+CompiledPath::ConnectFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(GetPath() << &cb);
+    return ConfigImpl::Get()->ConnectFailSafe(*this, cb);
+}
+
+MatchContainer
+CompiledPath::LookupMatches() const
+{
+    NS_LOG_FUNCTION(GetPath());
+    return ConfigImpl::Get()->LookupMatches(*this);
 }
 
 void
@@ -21,6 +21,7 @@
 
 #include "ptr.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -57,6 +58,120 @@ namespace Config
  */
 void Reset();
 
+class ConfigImpl;
+class MatchContainer;
+
+/**
+ * \ingroup config
+ * A Config path parsed once, to be matched many times.
+ *
+ * The Config functions taking a path as a string parse it at each call.
+ * A CompiledPath keeps the parsed elements of the path, and learns the
+ * attributes they match on each object type met, so the scripts which
+ * configure or connect many objects through the same path can reuse it:
+ *
+ * \code
+ *     Config::CompiledPath path("/NodeList/[0-99]/DeviceList/0/Mtu");
+ *     for (uint32_t i = 0; i < nRuns; ++i)
+ *     {
+ *         ...
+ *         path.Set(UintegerValue(mtu));
+ *     }
+ * \endcode
+ *
+ * Explicit indices in a container, as in "/NodeList/42/", get only the
+ * items required, instead of the whole container.
+ *
+ * A CompiledPath holds no reference to the objects matched: it can be
+ * used after objects are created or destroyed.  The copies of a
+ * CompiledPath share what they learned.
+ *
+ * The operations on a compiled path are member functions, so that the
+ * Config functions taking a string are not overloaded and can still be
+ * bound by name, as in Simulator::Schedule(delay, &Config::Set, ...).
+ *
+ * To apply several operations to the objects of a path in one traversal,
+ * look them up once with LookupMatches() and use the MatchContainer.
+ */
+class CompiledPath
+{
+  public:
+    /**
+     * Parse a Config path.
+     *
+     * \param [in] path The Config path.
+     */
+    explicit CompiledPath(std::string path);
+
+    /**
+     * \returns The Config path.
+     */
+    std::string GetPath() const;
+
+    /**
+     * Set the value of the attributes matching this path.  If no such
+     * attributes are found, this method throws a fatal error.
+     *
+     * \param [in] value The value to set in all matching attributes.
+     * \sa Config::Set()
+     */
+    void Set(const AttributeValue& value) const;
+    /**
+     * Set the value of the attributes matching this path.
+     *
+     * \param [in] value The value to set in all matching attributes.
+     * \return \c true if any matching attributes could be set.
+     * \sa Config::SetFailSafe()
+     */
+    bool SetFailSafe(const AttributeValue& value) const;
+    /**
+     * Connect a callback to the trace sources matching this path.  If no
+     * matching trace sources are found, this method throws a fatal error.
+     *
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \sa Config::ConnectWithoutContext()
+     */
+    void ConnectWithoutContext(const CallbackBase& cb) const;
+    /**
+     * Connect a callback to the trace sources matching this path.
+     *
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \returns \c true if any trace sources could be connected.
+     * \sa Config::ConnectWithoutContextFailSafe()
+     */
+    bool ConnectWithoutContextFailSafe(const CallbackBase& cb) const;
+    /**
+     * Connect a callback, which receives the context string, to the trace
+     * sources matching this path.  If no matching trace sources are found,
+     * this method throws a fatal error.
+     *
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \sa Config::Connect()
+     */
+    void Connect(const CallbackBase& cb) const;
+    /**
+     * Connect a callback, which receives the context string, to the trace
+     * sources matching this path.
+     *
+     * \param [in] cb The callback to connect to the matching trace sources.
+     * \returns \c true if any trace sources could be connected.
+     * \sa Config::ConnectFailSafe()
+     */
+    bool ConnectFailSafe(const CallbackBase& cb) const;
+    /**
+     * \returns A container which contains all the objects which match this
+     *          path.
+     * \sa Config::LookupMatches()
+     */
+    MatchContainer LookupMatches() const;
+
+  private:
+    friend class ConfigImpl;
+    struct Impl;
+    /** The parsed path. */
+    std::shared_ptr<Impl> m_impl;
+};
+
 /**
  * \ingroup config
  * \param [in] path A path to match attributes.
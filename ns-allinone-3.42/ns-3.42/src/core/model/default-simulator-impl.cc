@@ -19,12 +19,21 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "boolean.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "trace-source-accessor.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
 
 /**
  * \file
@@ -42,13 +51,90 @@ NS_LOG_COMPONENT_DEFINE("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 
+namespace
+{
+
+/** Source of the DefaultSimulatorImpl instance ids. */
+std::atomic<uint64_t> g_nextInstanceId = 1;
+
+} // unnamed namespace
+
+/**
+ * A single producer, single consumer ring of events with context.
+ *
+ * The producer only writes \c tail, and the simulation thread only
+ * writes \c head; the ring is full when they are \c slots.size() apart.
+ * The producer also owns \c overflow, set while it appends its events to
+ * \c overflowEvents because the ring was full; the simulation thread
+ * empties the ring, then \c overflowEvents, under \c mutex.
+ */
+struct DefaultSimulatorImpl::ProducerRing
+{
+    /**
+     * Constructor.
+     *
+     * \param [in] size The minimum capacity; rounded up to a power of 2.
+     */
+    ProducerRing(uint32_t size)
+    {
+        std::size_t capacity = 1;
+        while (capacity < size)
+        {
+            capacity <<= 1;
+        }
+        slots.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    std::vector<EventWithContext> slots;          //!< The events.
+    std::size_t mask;                             //!< Mask giving the slot of an index.
+    alignas(64) std::atomic<std::size_t> head{0}; //!< Index of the next event to take.
+    alignas(64) std::atomic<std::size_t> tail{0}; //!< Index of the next free slot.
+    bool overflow{false};                         //!< Whether the ring overflowed.
+    std::mutex mutex;                             //!< Protects overflowEvents.
+    std::deque<EventWithContext> overflowEvents;  //!< The events past a full ring.
+    std::atomic<bool> overflowPending{false};     //!< Whether overflowEvents is not empty.
+};
+
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("ProducerRingSize",
+                          "The capacity of the ring buffer of each thread scheduling events "
+                          "with Simulator::ScheduleWithContext, other than the main one; "
+                          "0 to share a lock-free queue instead.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_producerRingSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ProfilePeriod",
+                          "Time one event out of this many with the wall clock, to profile "
+                          "the simulation per event type, object type and context; "
+                          "0 to disable profiling.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_profilePeriod),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ProfileOutput",
+                          "The file to write the event profile to at the end of Run, "
+                          "in the folded stack format of flamegraph.pl; empty for none.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileOutput),
+                          MakeStringChecker())
+            .AddAttribute("SchedulerStats",
+                          "Account for the use of the event queue, and print the "
+                          "statistics at the end of Run.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DefaultSimulatorImpl::m_schedulerStatsEnabled),
+                          MakeBooleanChecker())
+            .AddTraceSource("QueueSize",
+                            "The number of events in the event queue, including the "
+                            "cancelled ones not yet taken out.",
+                            MakeTraceSourceAccessor(&DefaultSimulatorImpl::m_unscheduledEvents),
+                            "ns3::TracedValueCallback::Int32");
     return tid;
 }
 
@@ -62,7 +148,11 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
+    m_producerRingSize = 0;
+    m_producerRingsPending = false;
+    m_instanceId = g_nextInstanceId++;
+    m_profilePeriod = 0;
+    m_schedulerStatsEnabled = false;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -71,11 +161,24 @@ DefaultSimulatorImpl::~DefaultSimulatorImpl()
     NS_LOG_FUNCTION(this);
 }
 
+void
+DefaultSimulatorImpl::NotifyConstructionCompleted()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_schedulerStatsEnabled)
+    {
+        m_schedulerStats = std::make_unique<SchedulerStats>();
+    }
+    SimulatorImpl::NotifyConstructionCompleted();
+}
+
 void
 DefaultSimulatorImpl::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     ProcessEventsWithContext();
+    m_newProducerRings.Drain([this](ProducerRing* ring) { m_producerRings.emplace_back(ring); });
+    m_producerRings.clear();
 
     while (!m_events->IsEmpty())
     {
@@ -134,14 +237,25 @@ DefaultSimulatorImpl::ProcessOneEvent()
     PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
 
     NS_ASSERT(next.key.m_ts >= m_currentTs);
-    m_unscheduledEvents--;
+    --m_unscheduledEvents;
     m_eventCount++;
+    if (m_schedulerStats)
+    {
+        m_schedulerStats->RecordRemoveNext(next.impl->IsCancelled());
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, next.key.m_context);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -153,34 +267,77 @@ DefaultSimulatorImpl::IsFinished() const
     return m_events->IsEmpty() || m_stop;
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext(const EventWithContext& event)
+{
+    Scheduler::Event ev;
+    ev.impl = event.event;
+    ev.key.m_ts = m_currentTs + event.timestamp;
+    ev.key.m_context = event.context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    ++m_unscheduledEvents;
+    m_events->Insert(ev);
+    if (m_schedulerStats)
+    {
+        m_schedulerStats->RecordInsert(event.timestamp, m_unscheduledEvents);
+    }
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    m_eventsWithContext.Drain(
+        [this](const EventWithContext& event) { InsertEventWithContext(event); });
+
+    if (!m_producerRingsPending.load(std::memory_order_relaxed) ||
+        !m_producerRingsPending.exchange(false, std::memory_order_acquire))
     {
         return;
     }
-
-    // swap queues
-    EventsWithContext eventsWithContext;
+    // A producer registers its ring before filling it
+    m_newProducerRings.Drain([this](ProducerRing* ring) { m_producerRings.emplace_back(ring); });
+    for (auto& ring : m_producerRings)
     {
-        std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        std::unique_lock<std::mutex> lock;
+        if (ring->overflowPending.load(std::memory_order_acquire))
+        {
+            // The producer does not touch the ring while it overflows
+            lock = std::unique_lock(ring->mutex);
+        }
+        std::size_t head = ring->head.load(std::memory_order_relaxed);
+        std::size_t tail = ring->tail.load(std::memory_order_acquire);
+        for (; head != tail; ++head)
+        {
+            InsertEventWithContext(ring->slots[head & ring->mask]);
+        }
+        ring->head.store(head, std::memory_order_release);
+        if (lock.owns_lock())
+        {
+            for (const auto& event : ring->overflowEvents)
+            {
+                InsertEventWithContext(event);
+            }
+            ring->overflowEvents.clear();
+            ring->overflowPending.store(false, std::memory_order_relaxed);
+        }
     }
-    while (!eventsWithContext.empty())
+}
+
+DefaultSimulatorImpl::ProducerRing*
+DefaultSimulatorImpl::GetProducerRing()
+{
+    // The ring of a previous simulator instance is not used anymore
+    static thread_local uint64_t instanceId = 0;
+    static thread_local ProducerRing* ring = nullptr;
+    if (instanceId != m_instanceId)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
-        Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
-        ev.key.m_uid = m_uid;
-        m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        // Owned by the simulation thread once registered
+        ring = new ProducerRing(m_producerRingSize);
+        instanceId = m_instanceId;
+        m_newProducerRings.Push(ring);
     }
+    return ring;
 }
 
 void
@@ -191,17 +348,50 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (m_profilePeriod > 0 && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_profilePeriod);
+    }
 
     while (!m_events->IsEmpty() && !m_stop)
     {
         ProcessOneEvent();
     }
 
+    if (m_profiler && !m_profileOutput.empty())
+    {
+        std::ofstream os(m_profileOutput);
+        NS_ABORT_MSG_UNLESS(os.is_open(), "Cannot open the profile output " << m_profileOutput);
+        m_profiler->WriteFolded(os);
+    }
+    if (m_schedulerStats)
+    {
+        m_schedulerStats->Print(std::clog);
+    }
+
     // If the simulator stopped naturally by lack of events, make a
     // consistency test to check that we didn't lose any events along the way.
     NS_ASSERT(!m_events->IsEmpty() || m_unscheduledEvents == 0);
 }
 
+const EventProfiler*
+DefaultSimulatorImpl::GetProfiler() const
+{
+    return m_profiler.get();
+}
+
+const SchedulerStats*
+DefaultSimulatorImpl::GetSchedulerStats() const
+{
+    return m_schedulerStats.get();
+}
+
+uint64_t
+DefaultSimulatorImpl::GetQueueSize() const
+{
+    return m_unscheduledEvents;
+}
+
 void
 DefaultSimulatorImpl::Stop()
 {
@@ -235,8 +425,12 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
     ev.key.m_context = GetContext();
     ev.key.m_uid = m_uid;
     m_uid++;
-    m_unscheduledEvents++;
+    ++m_unscheduledEvents;
     m_events->Insert(ev);
+    if (m_schedulerStats)
+    {
+        m_schedulerStats->RecordInsert(delay.GetTimeStep(), m_unscheduledEvents);
+    }
     return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -254,8 +448,12 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         ev.key.m_context = context;
         ev.key.m_uid = m_uid;
         m_uid++;
-        m_unscheduledEvents++;
+        ++m_unscheduledEvents;
         m_events->Insert(ev);
+        if (m_schedulerStats)
+        {
+            m_schedulerStats->RecordInsert(delay.GetTimeStep(), m_unscheduledEvents);
+        }
     }
     else
     {
@@ -264,10 +462,44 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
+        if (m_producerRingSize == 0)
         {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
+            m_eventsWithContext.Push(ev);
+        }
+        else
+        {
+            ProducerRing* ring = GetProducerRing();
+            // Once the ring is full, append the events to the overflow list of
+            // the ring until the simulation thread has emptied both: the ring
+            // is drained first, so the events keep their order, and the thread
+            // never waits for the simulation thread, which may be stopped
+            if (ring->overflow)
+            {
+                std::lock_guard lock(ring->mutex);
+                if (!ring->overflowEvents.empty())
+                {
+                    ring->overflowEvents.push_back(ev);
+                    m_producerRingsPending.store(true, std::memory_order_release);
+                    return;
+                }
+                ring->overflow = false;
+            }
+            std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+            std::size_t head = ring->head.load(std::memory_order_acquire);
+            if (tail - head > ring->mask)
+            {
+                ring->overflow = true;
+                {
+                    std::lock_guard lock(ring->mutex);
+                    ring->overflowEvents.push_back(ev);
+                    ring->overflowPending.store(true, std::memory_order_relaxed);
+                }
+                m_producerRingsPending.store(true, std::memory_order_release);
+                return;
+            }
+            ring->slots[tail & ring->mask] = ev;
+            ring->tail.store(tail + 1, std::memory_order_release);
+            m_producerRingsPending.store(true, std::memory_order_release);
         }
     }
 }
@@ -343,7 +575,11 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     // whenever we remove an event from the event list, we have to unref it.
     event.impl->Unref();
 
-    m_unscheduledEvents--;
+    --m_unscheduledEvents;
+    if (m_schedulerStats)
+    {
+        m_schedulerStats->RecordRemove();
+    }
 }
 
 void
@@ -352,6 +588,10 @@ DefaultSimulatorImpl::Cancel(const EventId& id)
     if (!IsExpired(id))
     {
         id.PeekEventImpl()->Cancel();
+        if (m_schedulerStats && id.GetUid() != EventId::UID::DESTROY)
+        {
+            m_schedulerStats->RecordCancel();
+        }
     }
 }
 
@@ -20,11 +20,18 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "mpsc-queue.h"
+#include "scheduler-stats.h"
 #include "simulator-impl.h"
+#include "traced-value.h"
 
+#include <atomic>
 #include <list>
-#include <mutex>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 /**
  * \file
@@ -42,6 +49,25 @@ class Scheduler;
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * Events scheduled with a context from other threads than the one
+ * running the simulation are pushed onto a lock-free queue, and moved
+ * into the event queue in batches between two events.  When the
+ * ProducerRingSize attribute is not zero, each of these threads gets its
+ * own ring buffer instead, which spares a memory allocation per event;
+ * a thread finding its ring full appends its events to a locked overflow
+ * list of the ring until the simulation thread has emptied both, so it
+ * never waits for the simulation thread.  This suits the reader threads of emulated devices, such as
+ * the ns3::FdNetDevice ones, which schedule an event per packet read.
+ *
+ * When the ProfilePeriod attribute is not zero, the events are run
+ * through an ns3::EventProfiler, whose profile is written to the
+ * ProfileOutput file, if any, at the end of Run().
+ *
+ * When the SchedulerStats attribute is \c true, the use of the event
+ * queue is accounted for in an ns3::SchedulerStats, printed to
+ * \c std::clog at the end of Run().  The size of the queue, with the
+ * cancelled events not yet taken out, is the QueueSize trace source.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -78,8 +104,32 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the event profiler.
+     *
+     * \returns The profiler, or \c nullptr if profiling is disabled or
+     * the simulation has not run yet.
+     */
+    const EventProfiler* GetProfiler() const;
+
+    /**
+     * Get the scheduler statistics.
+     *
+     * \returns The statistics, or \c nullptr if they are disabled.
+     */
+    const SchedulerStats* GetSchedulerStats() const;
+
+    /**
+     * Get the size of the event queue.
+     *
+     * \returns The number of events in the queue, including the
+     * cancelled ones not yet taken out.
+     */
+    uint64_t GetQueueSize() const;
+
   private:
     void DoDispose() override;
+    void NotifyConstructionCompleted() override;
 
     /** Process the next event. */
     void ProcessOneEvent();
@@ -97,17 +147,46 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
-    /** Container type for the events from a different context. */
-    typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * Insert an event from a different thread into the event queue.
+     *
+     * \param [in] event The event.
+     */
+    void InsertEventWithContext(const EventWithContext& event);
+
+    /** The events from a different thread. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
+
+    /** A single producer, single consumer ring of events with context. */
+    struct ProducerRing;
+    /**
+     * Get the ring buffer of the calling thread, creating it if needed.
+     *
+     * \returns The ring buffer.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
-    std::mutex m_eventsWithContextMutex;
+    ProducerRing* GetProducerRing();
+    /** Capacity of the per-thread ring buffers, 0 to disable them. */
+    uint32_t m_producerRingSize;
+    /** The ring buffers in use. */
+    std::vector<std::unique_ptr<ProducerRing>> m_producerRings;
+    /** Ring buffers created by their producer, not yet in m_producerRings. */
+    MpscQueue<ProducerRing*> m_newProducerRings;
+    /** Flag \c true if events may be waiting in the ring buffers. */
+    std::atomic<bool> m_producerRingsPending;
+    /** Unique id of this instance, to tell apart the rings of a previous one. */
+    uint64_t m_instanceId;
+
+    /** Sample one event out of this many, 0 to disable profiling. */
+    uint32_t m_profilePeriod;
+    /** File to write the folded profile to, if not empty. */
+    std::string m_profileOutput;
+    /** The event profiler, if enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
+
+    /** Whether to keep the scheduler statistics. */
+    bool m_schedulerStatsEnabled;
+    /** The scheduler statistics, if enabled. */
+    std::unique_ptr<SchedulerStats> m_schedulerStats;
 
     /** Container type for the events to run at Simulator::Destroy() */
     typedef std::list<EventId> DestroyEvents;
@@ -130,9 +209,10 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint64_t m_eventCount;
     /**
      * Number of events that have been inserted but not yet scheduled,
-     *  not counting the Destroy events; this is used for validation
+     *  not counting the Destroy events; this is used for validation,
+     *  and traced as the queue size
      */
-    int m_unscheduledEvents;
+    TracedValue<int> m_unscheduledEvents;
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
@@ -21,6 +21,17 @@
 
 #include "log.h"
 
+#if defined(__SANITIZE_ADDRESS__)
+#define NS3_EVENT_IMPL_POOL 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define NS3_EVENT_IMPL_POOL 0
+#endif
+#endif
+#ifndef NS3_EVENT_IMPL_POOL
+#define NS3_EVENT_IMPL_POOL 1
+#endif
+
 /**
  * \file
  * \ingroup events
@@ -32,6 +43,145 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+#if NS3_EVENT_IMPL_POOL
+namespace
+{
+
+/** Granularity of the event sizes, in bytes. */
+constexpr std::size_t EVENT_POOL_ALIGN = alignof(std::max_align_t);
+/** Number of size classes; larger events use the global allocator. */
+constexpr std::size_t EVENT_POOL_CLASSES = 16;
+/** Maximum number of free blocks kept per size class and thread. */
+constexpr uint32_t EVENT_POOL_MAX_FREE = 1 << 16;
+
+/** A free block, linked in the free list of its size class. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next free block of the same size class.
+};
+
+/**
+ * The free lists of one thread.
+ *
+ * Blocks are allocated one by one with the global allocator, so that a
+ * block can be returned to any thread's free lists or to the global
+ * allocator, whichever thread allocated it.
+ */
+struct EventPool
+{
+    FreeBlock* heads[EVENT_POOL_CLASSES] = {}; //!< Free lists, by size class.
+    uint32_t counts[EVENT_POOL_CLASSES] = {};  //!< Free list lengths, by size class.
+
+    /** Release the cached blocks when the thread exits. */
+    ~EventPool();
+};
+
+/**
+ * Whether the free lists of this thread have been released, at thread or
+ * program exit.  Events destroyed afterwards, e.g. by static objects, go
+ * straight to the global allocator.
+ */
+thread_local bool g_eventPoolReleased = false;
+
+/** The free lists of this thread. */
+thread_local EventPool g_eventPool;
+
+EventPool::~EventPool()
+{
+    g_eventPoolReleased = true;
+    for (std::size_t i = 0; i < EVENT_POOL_CLASSES; i++)
+    {
+        while (heads[i] != nullptr)
+        {
+            FreeBlock* block = heads[i];
+            heads[i] = block->next;
+            ::operator delete(block);
+        }
+        counts[i] = 0;
+    }
+}
+
+/**
+ * Get the size class of an event.
+ *
+ * \param [in] size The size of the event object.
+ * \returns The size class, EVENT_POOL_CLASSES or more if not pooled.
+ */
+inline std::size_t
+SizeClass(std::size_t size)
+{
+    return (size + EVENT_POOL_ALIGN - 1) / EVENT_POOL_ALIGN - 1;
+}
+
+/**
+ * Get the free lists of this thread, if they can still be used.
+ *
+ * \returns The free lists, or nullptr after they have been released.
+ */
+inline EventPool*
+GetEventPool()
+{
+    return g_eventPoolReleased ? nullptr : &g_eventPool;
+}
+
+} // namespace
+#endif /* NS3_EVENT_IMPL_POOL */
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+#if NS3_EVENT_IMPL_POOL
+    std::size_t sizeClass = SizeClass(size);
+    if (sizeClass < EVENT_POOL_CLASSES)
+    {
+        EventPool* pool = GetEventPool();
+        if (pool != nullptr && pool->heads[sizeClass] != nullptr)
+        {
+            FreeBlock* block = pool->heads[sizeClass];
+            pool->heads[sizeClass] = block->next;
+            pool->counts[sizeClass]--;
+            return block;
+        }
+        // Allocate the whole size class, so the block fits any event of the class
+        return ::operator new((sizeClass + 1) * EVENT_POOL_ALIGN);
+    }
+#endif
+    return ::operator new(size);
+}
+
+void
+EventImpl::operator delete(void* ptr, [[maybe_unused]] std::size_t size)
+{
+#if NS3_EVENT_IMPL_POOL
+    std::size_t sizeClass = SizeClass(size);
+    if (sizeClass < EVENT_POOL_CLASSES)
+    {
+        EventPool* pool = GetEventPool();
+        if (pool != nullptr && pool->counts[sizeClass] < EVENT_POOL_MAX_FREE)
+        {
+            auto block = static_cast<FreeBlock*>(ptr);
+            block->next = pool->heads[sizeClass];
+            pool->heads[sizeClass] = block;
+            pool->counts[sizeClass]++;
+            return;
+        }
+    }
+#endif
+    ::operator delete(ptr);
+}
+
+void*
+EventImpl::operator new(std::size_t size, std::align_val_t align)
+{
+    return ::operator new(size, align);
+}
+
+void
+EventImpl::operator delete(void* ptr, std::size_t /* size */, std::align_val_t align)
+{
+    ::operator delete(ptr, align);
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -67,4 +217,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const ObjectBase*
+EventImpl::GetTargetObject() const
+{
+    return nullptr;
+}
+
 } // namespace ns3
@@ -21,6 +21,8 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
+#include <new>
 #include <stdint.h>
 
 /**
@@ -32,6 +34,8 @@
 namespace ns3
 {
 
+class ObjectBase;
+
 /**
  * \ingroup events
  * \brief A simulation event.
@@ -41,6 +45,14 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * EventImpl instances are allocated from per-thread free lists bucketed
+ * by object size, so that scheduling an event usually reuses the memory
+ * of an event which has already been executed or destroyed, instead of
+ * calling the global allocator.  Since each thread has its own free lists,
+ * events can be created and destroyed by different threads, as happens
+ * with the RealtimeSimulatorImpl.  Builds with AddressSanitizer enabled
+ * bypass the free lists, to keep use-after-free detection of events.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +78,44 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * Checked by the simulation engine before calling Invoke().
      */
     bool IsCancelled();
+    /**
+     * Get the object whose method this event calls, for profiling.
+     *
+     * \returns The object, or \c nullptr if the event does not call a
+     * method of an ns3::ObjectBase.
+     */
+    virtual const ObjectBase* GetTargetObject() const;
+
+    /**
+     * Allocate memory for an event, from the free list for its size.
+     *
+     * \param [in] size The size of the event object.
+     * \returns The allocated memory.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release the memory of an event, to the free list for its size.
+     *
+     * \param [in] ptr The event memory.
+     * \param [in] size The size of the event object.
+     */
+    static void operator delete(void* ptr, std::size_t size);
+    /**
+     * Allocate memory for an over-aligned event, bypassing the free lists.
+     *
+     * \param [in] size The size of the event object.
+     * \param [in] align The alignment of the event object.
+     * \returns The allocated memory.
+     */
+    static void* operator new(std::size_t size, std::align_val_t align);
+    /**
+     * Release the memory of an over-aligned event.
+     *
+     * \param [in] ptr The event memory.
+     * \param [in] size The size of the event object.
+     * \param [in] align The alignment of the event object.
+     */
+    static void operator delete(void* ptr, std::size_t size, std::align_val_t align);
 
   protected:
     /**
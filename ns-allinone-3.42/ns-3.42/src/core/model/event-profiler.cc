@@ -0,0 +1,254 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::EventProfiler implementation.
+ */
+
+#include "event-profiler.h"
+
+#include "assert.h"
+#include "log.h"
+#include "object-base.h"
+#include "simulator.h"
+#include "type-id.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <tuple>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+EventProfiler::EventProfiler(uint32_t period)
+    : m_period(period),
+      m_countdown(period),
+      m_events(0)
+{
+    NS_LOG_FUNCTION(this << period);
+    NS_ASSERT_MSG(period > 0, "The sampling period must be positive");
+}
+
+bool
+EventProfiler::Key::operator<(const Key& o) const
+{
+    return std::tie(function, typeId, context) < std::tie(o.function, o.typeId, o.context);
+}
+
+void
+EventProfiler::Sample(EventImpl* event, uint32_t context)
+{
+    // The target of a cancelled event may have been destroyed already, and
+    // the event does nothing: sample the next event instead
+    if (event->IsCancelled())
+    {
+        m_countdown = 1;
+        return;
+    }
+    // The target of the event may be destroyed by the event itself
+    const ObjectBase* target = event->GetTargetObject();
+    Key key{typeid(*event), target ? target->GetInstanceTypeId().GetUid() : uint16_t(0), context};
+
+    auto start = std::chrono::steady_clock::now();
+    event->Invoke();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    auto [it, inserted] = m_samples.try_emplace(key, Samples{0, 0});
+    it->second.count++;
+    it->second.nanoseconds +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+uint32_t
+EventProfiler::GetPeriod() const
+{
+    return m_period;
+}
+
+uint64_t
+EventProfiler::GetEventCount() const
+{
+    return m_events;
+}
+
+std::string
+EventProfiler::GetFunctionName(const std::type_index& type)
+{
+    std::string name = type.name();
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+
+    // The events of MakeEvent() are local classes of a function template,
+    // whose first parameter is the function called: keep its type, and
+    // drop the types of the bound arguments.
+    const std::string prefix = "ns3::MakeEvent<";
+    if (name.compare(0, prefix.size(), prefix) == 0)
+    {
+        std::size_t begin = 0;
+        std::size_t end = prefix.size();
+        int depth = 1;
+        for (; end < name.size(); ++end)
+        {
+            char c = name[end];
+            if (c == '<' || c == '(')
+            {
+                if (depth == 0 && c == '(' && begin == 0)
+                {
+                    begin = end + 1;
+                }
+                else
+                {
+                    depth++;
+                }
+            }
+            else if (c == '>' || c == ')')
+            {
+                if (depth == 0)
+                {
+                    break;
+                }
+                depth--;
+            }
+            else if (c == ',' && depth == 0 && begin != 0)
+            {
+                break;
+            }
+        }
+        if (begin != 0 && end < name.size())
+        {
+            name = name.substr(begin, end - begin);
+        }
+    }
+    return name;
+}
+
+std::vector<EventProfiler::Entry>
+EventProfiler::GetEntries() const
+{
+    std::vector<Entry> entries;
+    entries.reserve(m_samples.size());
+    std::map<std::type_index, std::string> names;
+    for (const auto& [key, samples] : m_samples)
+    {
+        auto name = names.find(key.function);
+        if (name == names.end())
+        {
+            name = names.emplace(key.function, GetFunctionName(key.function)).first;
+        }
+        std::string typeId;
+        if (key.typeId != 0)
+        {
+            TypeId tid;
+            tid.SetUid(key.typeId);
+            typeId = tid.GetName();
+        }
+        entries.push_back({key.context, typeId, name->second, samples.count, samples.nanoseconds});
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.nanoseconds > b.nanoseconds;
+    });
+    return entries;
+}
+
+void
+EventProfiler::Print(std::ostream& os, std::size_t n /* = 20 */) const
+{
+    auto entries = GetEntries();
+    int64_t total = 0;
+    for (const auto& entry : entries)
+    {
+        total += entry.nanoseconds;
+    }
+
+    os << "Event profile: " << m_events << " events, one sampled out of " << m_period
+       << std::endl;
+    os << std::setw(8) << "time %" << std::setw(12) << "events" << std::setw(12) << "us/event"
+       << "  context  object  function" << std::endl;
+
+    auto flags = os.flags();
+    auto precision = os.precision();
+    os << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < std::min(n, entries.size()); ++i)
+    {
+        const auto& entry = entries[i];
+        os << std::setw(8) << (total ? 100.0 * entry.nanoseconds / total : 0.0) << std::setw(12)
+           << entry.samples * m_period << std::setw(12)
+           << entry.nanoseconds / 1000.0 / entry.samples << "  ";
+        if (entry.context == Simulator::NO_CONTEXT)
+        {
+            os << "-";
+        }
+        else
+        {
+            os << entry.context;
+        }
+        os << "  " << (entry.typeId.empty() ? "-" : entry.typeId) << "  " << entry.function
+           << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+EventProfiler::WriteFolded(std::ostream& os) const
+{
+    for (const auto& entry : GetEntries())
+    {
+        // flamegraph.pl splits the frames on ';' and the count on the last ' '
+        if (entry.context == Simulator::NO_CONTEXT)
+        {
+            os << "no context";
+        }
+        else
+        {
+            os << "node " << entry.context;
+        }
+        if (!entry.typeId.empty())
+        {
+            os << ";" << entry.typeId;
+        }
+        std::string function = entry.function;
+        std::replace(function.begin(), function.end(), ';', ',');
+        os << ";" << function << " " << entry.nanoseconds * m_period << std::endl;
+    }
+}
+
+void
+EventProfiler::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    m_samples.clear();
+    m_countdown = m_period;
+    m_events = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,190 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::EventProfiler declaration.
+ */
+
+#include "event-impl.h"
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ *
+ * A sampling profiler of the simulation events.
+ *
+ * One event out of \c period is timed with the wall clock, and its time
+ * is attributed to the event type, the ns3::TypeId of the object whose
+ * method the event calls, if any, and the event context, which is usually
+ * a node id.  With one sample out of \c period events, the estimated
+ * counts and times of each entry are the sampled ones times the period.
+ *
+ * The simulator implementations which support it run their events through
+ * a profiler when configured to; with ns3::DefaultSimulatorImpl:
+ *
+ * \code
+ *     ./ns3 run "my-sim --ns3::DefaultSimulatorImpl::ProfilePeriod=100
+ *                       --ns3::DefaultSimulatorImpl::ProfileOutput=my-sim.folded"
+ *     flamegraph.pl my-sim.folded > my-sim.svg
+ * \endcode
+ *
+ * The entries are also available from DefaultSimulatorImpl::GetProfiler().
+ */
+class EventProfiler
+{
+  public:
+    /** The profile of one kind of event. */
+    struct Entry
+    {
+        uint32_t context;     //!< The event context.
+        std::string typeId;   //!< The TypeId of the target object, or empty.
+        std::string function; //!< The event type.
+        uint64_t samples;     //!< The number of events sampled.
+        int64_t nanoseconds;  //!< The wall clock time of the events sampled.
+    };
+
+    /**
+     * Constructor.
+     *
+     * \param [in] period Sample one event out of \p period.
+     */
+    EventProfiler(uint32_t period);
+
+    /**
+     * Run an event, and sample it if its turn has come.
+     *
+     * \param [in] event The event.
+     * \param [in] context The event context.
+     */
+    inline void Invoke(EventImpl* event, uint32_t context);
+
+    /** \returns The sampling period. */
+    uint32_t GetPeriod() const;
+    /** \returns The number of events run through the profiler. */
+    uint64_t GetEventCount() const;
+
+    /**
+     * Get the profile, sorted by decreasing sampled time.
+     *
+     * \returns The entries.
+     */
+    std::vector<Entry> GetEntries() const;
+
+    /**
+     * Print the entries taking the most time, with their estimated totals.
+     *
+     * \param [in] os The output stream.
+     * \param [in] n The maximum number of entries to print.
+     */
+    void Print(std::ostream& os, std::size_t n = 20) const;
+
+    /**
+     * Write the profile in the folded stack format of flamegraph.pl,
+     * one line per entry: the context, the TypeId and the event type,
+     * followed by the estimated time in nanoseconds.
+     *
+     * \param [in] os The output stream.
+     */
+    void WriteFolded(std::ostream& os) const;
+
+    /** Forget all the samples. */
+    void Reset();
+
+  private:
+    /**
+     * Time an event, and account for it.  A cancelled event is not
+     * accounted for, and the next event is sampled instead.
+     *
+     * \param [in] event The event.
+     * \param [in] context The event context.
+     */
+    void Sample(EventImpl* event, uint32_t context);
+
+    /**
+     * Get a readable name for an event type.
+     *
+     * \param [in] type The type of the event object.
+     * \returns The name.
+     */
+    static std::string GetFunctionName(const std::type_index& type);
+
+    /** What the samples are attributed to. */
+    struct Key
+    {
+        std::type_index function; //!< The event type.
+        uint16_t typeId;          //!< The TypeId uid of the target object, 0 for none.
+        uint32_t context;         //!< The event context.
+
+        /**
+         * Comparison operator.
+         * \param [in] o The other key.
+         * \returns \c true if this key sorts before \p o.
+         */
+        bool operator<(const Key& o) const;
+    };
+
+    /** The samples of a key. */
+    struct Samples
+    {
+        uint64_t count;      //!< The number of samples.
+        int64_t nanoseconds; //!< Their total wall clock time.
+    };
+
+    uint32_t m_period;                  //!< The sampling period.
+    uint32_t m_countdown;               //!< Events left before the next sample.
+    uint64_t m_events;                  //!< The number of events run.
+    std::map<Key, Samples> m_samples; //!< The samples.
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the inline functions declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+inline void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    m_events++;
+    if (--m_countdown != 0)
+    {
+        event->Invoke();
+        return;
+    }
+    m_countdown = m_period;
+    Sample(event, context);
+}
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -190,6 +190,8 @@ FlushStreams()
     std::list<std::ostream*>** pl = PeekStreamList();
     if (*pl == nullptr)
     {
+        // std::clog is buffered by line once logging is enabled
+        std::clog.flush();
         return;
     }
 
@@ -26,12 +26,13 @@
 #include "hash-murmur3.h"
 #include "ptr.h"
 
+#include <cstdint>
 #include <string>
 
 /**
  * \file
  * \ingroup hash
- * \brief ns3::Hasher, ns3::Hash32() and ns3::Hash64() function declarations.
+ * \brief ns3::Hasher, ns3::Hash32(), ns3::Hash64() and ns3::HashMix() function declarations.
  */
 
 namespace ns3
@@ -219,6 +220,34 @@ uint32_t Hash32(const std::string s);
  */
 uint64_t Hash64(const std::string s);
 
+/**
+ * \ingroup hash
+ *
+ * Compute 64-bit hash of a 64-bit value, such as a packed address.
+ *
+ * Unlike Hash64(), this does not go through a Hasher and its virtual
+ * implementation: it is the constexpr multiply and xor-shift finalizer of
+ * Murmur3, meant for the fixed-size keys of the unordered containers.
+ * Each bit of the value changes about half of the bits of the hash, so
+ * the low bits, which select a bucket, depend on the whole key.
+ *
+ * \param [in] value Value to hash.
+ * \return 64-bit hash of the value.
+ */
+constexpr uint64_t HashMix(uint64_t value);
+
+/**
+ * \ingroup hash
+ *
+ * Combine a 64-bit value into a hash, for the keys made of several
+ * fields, e.g. HashCombine(HashMix(address), port).
+ *
+ * \param [in] hash Hash of the previous fields.
+ * \param [in] value Value of the next field.
+ * \return 64-bit hash of the fields.
+ */
+constexpr uint64_t HashCombine(uint64_t hash, uint64_t value);
+
 } // namespace ns3
 
 /*************************************************
@@ -294,6 +323,23 @@ Hash64(const std::string s)
     return GetStaticHash().GetHash64(s);
 }
 
+constexpr uint64_t
+HashMix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+constexpr uint64_t
+HashCombine(uint64_t hash, uint64_t value)
+{
+    return HashMix(hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
 } // namespace ns3
 
 #endif /* HASH_H */
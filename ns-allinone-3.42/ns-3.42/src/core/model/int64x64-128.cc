@@ -137,6 +137,13 @@ int64x64_t::Div(const int64x64_t& o)
 uint128_t
 int64x64_t::Udiv(const uint128_t a, const uint128_t b)
 {
+    // Integer divisor, as in the Time ratios: the loop below would
+    // reduce to a single division by its integer part
+    if ((b & HP_MASK_LO) == 0)
+    {
+        return a / (b >> 64);
+    }
+
     uint128_t rem = a;
     uint128_t den = b;
     uint128_t quo = rem / den;
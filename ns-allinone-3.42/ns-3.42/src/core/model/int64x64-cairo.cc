@@ -129,6 +129,13 @@ int64x64_t::Div(const int64x64_t& o)
 cairo_uint128_t
 int64x64_t::Udiv(const cairo_uint128_t a, const cairo_uint128_t b)
 {
+    // Integer divisor, as in the Time ratios: the loop below would
+    // reduce to a single division by its integer part
+    if (b.lo == 0)
+    {
+        return _cairo_uint128_divrem(a, _cairo_uint64_to_uint128(b.hi)).quo;
+    }
+
     cairo_uint128_t den = b;
     cairo_uquorem128_t qr = _cairo_uint128_divrem(a, b);
     cairo_uint128_t result = qr.quo;
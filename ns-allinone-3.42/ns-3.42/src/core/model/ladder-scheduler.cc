@@ -0,0 +1,379 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "type-id.h"
+#include "uinteger.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+namespace
+{
+/**
+ * Ordering of the Bottom: decreasing keys, so that the next event is at the back.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \c a belongs before \c b in the Bottom.
+ */
+inline bool
+BottomOrder(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return a.key > b.key;
+}
+} // namespace
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("BottomThreshold",
+                          "Largest bucket which is sorted into the Bottom instead of "
+                          "being split into a new rung",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxRungs",
+                          "Maximum number of rungs of the ladder",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topStart(0),
+      m_nRungs(0),
+      m_bottomLimit(0),
+      m_qSize(0),
+      m_threshold(50),
+      m_maxRungs(8)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::CurrentStart(const Rung& rung)
+{
+    return rung.start + rung.current * rung.width;
+}
+
+uint32_t
+LadderScheduler::BucketIndex(const Rung& rung, uint64_t ts)
+{
+    NS_ASSERT(ts >= rung.start);
+    uint32_t bucket = (ts - rung.start) / rung.width;
+    NS_ASSERT(bucket < rung.buckets.size());
+    return bucket;
+}
+
+uint32_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    // Each rung covers a bucket already dequeued from the rung above it,
+    // so the first rung whose unread part starts at or before ts is the one
+    for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+        if (ts >= CurrentStart(m_rungs[i]))
+        {
+            return i;
+        }
+    }
+    return m_nRungs;
+}
+
+LadderScheduler::Rung&
+LadderScheduler::PushRung(uint64_t start, uint64_t width, uint32_t nBuckets)
+{
+    NS_LOG_FUNCTION(this << start << width << nBuckets);
+    NS_ASSERT(m_nRungs < m_maxRungs);
+    if (m_rungs.size() <= m_nRungs)
+    {
+        m_rungs.resize(m_nRungs + 1);
+    }
+    Rung& rung = m_rungs[m_nRungs++];
+    rung.start = start;
+    rung.width = width;
+    rung.current = 0;
+    rung.nEvents = 0;
+    // Buckets left over by a previous use of the rung are empty; keep their storage
+    rung.buckets.resize(nBuckets);
+    return rung;
+}
+
+void
+LadderScheduler::Spread(Bucket& events)
+{
+    Rung& rung = m_rungs[m_nRungs - 1];
+    for (const auto& ev : events)
+    {
+        rung.buckets[BucketIndex(rung, ev.key.m_ts)].push_back(ev);
+    }
+    rung.nEvents += events.size();
+    events.clear();
+}
+
+void
+LadderScheduler::TransferTop()
+{
+    NS_LOG_FUNCTION(this << m_top.size());
+    NS_ASSERT(m_nRungs == 0 && !m_top.empty());
+    uint64_t topMin = m_top.front().key.m_ts;
+    uint64_t topMax = topMin;
+    for (const auto& ev : m_top)
+    {
+        topMin = std::min(topMin, ev.key.m_ts);
+        topMax = std::max(topMax, ev.key.m_ts);
+    }
+    uint64_t width = std::max<uint64_t>(1, (topMax - topMin) / m_top.size());
+    uint32_t nBuckets = (topMax - topMin) / width + 1;
+    PushRung(topMin, width, nBuckets);
+    m_topStart = topMax + 1;
+    Spread(m_top);
+}
+
+void
+LadderScheduler::SortIntoBottom(Bucket& bucket)
+{
+    NS_LOG_FUNCTION(this << bucket.size());
+    NS_ASSERT(m_bottom.empty());
+    std::swap(m_bottom, bucket);
+    std::sort(m_bottom.begin(), m_bottom.end(), BottomOrder);
+    // Do not split back a Bottom which could not be split in the first place
+    m_bottomLimit = std::max<size_t>(2 * m_threshold, 2 * m_bottom.size());
+}
+
+void
+LadderScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+    while (m_bottom.empty())
+    {
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            TransferTop();
+        }
+        Rung& rung = m_rungs[m_nRungs - 1];
+        if (rung.nEvents == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        Bucket& bucket = rung.buckets[rung.current];
+        uint64_t bucketStart = CurrentStart(rung);
+        uint64_t width = rung.width;
+        rung.nEvents -= bucket.size();
+        rung.current++;
+        if (bucket.size() <= m_threshold || width == 1 || m_nRungs == m_maxRungs)
+        {
+            SortIntoBottom(bucket);
+        }
+        else
+        {
+            // Split the bucket into a finer rung; the rungs may be reallocated
+            // by PushRung, so move the events out of the bucket first
+            std::swap(m_spill, bucket);
+            uint64_t newWidth = (width + m_spill.size() - 1) / m_spill.size();
+            uint32_t nBuckets = (width + newWidth - 1) / newWidth;
+            PushRung(bucketStart, newWidth, nBuckets);
+            Spread(m_spill);
+        }
+    }
+}
+
+void
+LadderScheduler::SplitBottom()
+{
+    NS_LOG_FUNCTION(this << m_bottom.size());
+    if (m_nRungs == m_maxRungs)
+    {
+        return;
+    }
+    // The new rung must cover everything up to the unread part of the lowest rung
+    uint64_t start = m_bottom.back().key.m_ts;
+    uint64_t end = (m_nRungs > 0) ? CurrentStart(m_rungs[m_nRungs - 1]) : m_topStart;
+    NS_ASSERT(end > start);
+    uint64_t span = end - start;
+    uint64_t width = std::max<uint64_t>(1, (span + m_bottom.size() - 1) / m_bottom.size());
+    uint32_t nBuckets = (span + width - 1) / width;
+    PushRung(start, width, nBuckets);
+    Spread(m_bottom);
+    Refill();
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t ts = ev.key.m_ts;
+    if (m_qSize == 0)
+    {
+        NS_ASSERT(m_nRungs == 0 && m_top.empty() && m_bottom.empty());
+        m_topStart = 0;
+    }
+    m_qSize++;
+
+    if (ts >= m_topStart)
+    {
+        m_top.push_back(ev);
+    }
+    else
+    {
+        uint32_t r = FindRung(ts);
+        if (r < m_nRungs)
+        {
+            Rung& rung = m_rungs[r];
+            rung.buckets[BucketIndex(rung, ts)].push_back(ev);
+            rung.nEvents++;
+        }
+        else
+        {
+            auto it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, BottomOrder);
+            m_bottom.insert(it, ev);
+            if (m_bottom.size() > m_bottomLimit)
+            {
+                SplitBottom();
+            }
+        }
+    }
+
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    EventRemoved();
+    NS_LOG_DEBUG("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid
+                              << ", from bottom=" << m_bottom.size());
+    return ev;
+}
+
+void
+LadderScheduler::EventRemoved()
+{
+    m_qSize--;
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+
+    if (ts >= m_topStart)
+    {
+        auto it = std::find(m_top.begin(), m_top.end(), ev);
+        if (it != m_top.end())
+        {
+            *it = m_top.back();
+            m_top.pop_back();
+            EventRemoved();
+            return;
+        }
+    }
+    else
+    {
+        uint32_t r = FindRung(ts);
+        if (r < m_nRungs)
+        {
+            Rung& rung = m_rungs[r];
+            Bucket& bucket = rung.buckets[BucketIndex(rung, ts)];
+            auto it = std::find(bucket.begin(), bucket.end(), ev);
+            if (it != bucket.end())
+            {
+                *it = bucket.back();
+                bucket.pop_back();
+                rung.nEvents--;
+                EventRemoved();
+                return;
+            }
+        }
+        else
+        {
+            auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, BottomOrder);
+            if (it != m_bottom.end() && *it == ev)
+            {
+                NS_ASSERT(ev.impl == it->impl);
+                m_bottom.erase(it);
+                EventRemoved();
+                return;
+            }
+        }
+    }
+    NS_ASSERT_MSG(false, "Event " << ev.key.m_uid << " not found");
+}
+
+} // namespace ns3
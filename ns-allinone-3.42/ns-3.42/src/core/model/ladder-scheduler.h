@@ -0,0 +1,192 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh
+ * and Ian Li-Jin Thng][Tang]. Events are kept in three tiers:
+ *
+ * - **Top**: an unsorted vector holding the events far in the future
+ *   (time stamp at or after `m_topStart`).
+ * - **Ladder**: up to MaxRungs rungs of buckets.  Each rung covers a time
+ *   interval split in buckets of uniform width and each bucket is an
+ *   unsorted vector.  When the Bottom is empty the first non empty bucket
+ *   of the lowest rung is either split into a new, finer rung or, if it
+ *   holds at most BottomThreshold events, sorted into the Bottom.  When the
+ *   ladder is empty, the whole Top is spread over a new first rung.
+ * - **Bottom**: the events closest to the present, sorted in decreasing
+ *   order so that the next event is removed from the back of the vector.
+ *
+ * Unlike the CalendarScheduler the bucket width is derived from the events
+ * actually present each time a rung is created, so skewed or clustered
+ * event time distributions do not require a global resize.  The rungs, their
+ * bucket vectors and the Bottom are reused across the simulation, so that in
+ * steady state events are moved between already allocated buffers.
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or to a bucket; sorted insertion in a small Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Back of the Bottom
+ * Remove()     | Linear          | Search in Top, in a bucket or in the Bottom
+ * RemoveNext() | ~Constant       | Pop the Bottom; each event is moved a bounded number of times
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 3 x `sizeof (std::vector)` + rungs<br/>(72 bytes + 24 bytes per bucket) | Tiers
+ * Per Event | 0                                | Events stored by value in vectors
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;              //!< Time stamp at the start of the first bucket.
+        uint64_t width;              //!< Duration of a bucket, in dimensionless time units.
+        uint32_t current;            //!< Index of the first bucket not yet dequeued.
+        uint32_t nEvents;            //!< Number of events in the buckets of the rung.
+        std::vector<Bucket> buckets; //!< The buckets, reused across rung lifetimes.
+    };
+
+    /**
+     * Find the rung and bucket an event belongs to.
+     *
+     * \param [in] ts The time stamp of the event.
+     * \returns The index of the rung, or the number of active rungs if the
+     *          event belongs to the Bottom.
+     */
+    uint32_t FindRung(uint64_t ts) const;
+    /**
+     * Bucket index of a time stamp in a rung.
+     *
+     * \param [in] rung The rung.
+     * \param [in] ts The time stamp, which must be covered by the rung.
+     * \returns The bucket index.
+     */
+    static uint32_t BucketIndex(const Rung& rung, uint64_t ts);
+    /**
+     * Time stamp at the start of the first bucket not yet dequeued.
+     *
+     * \param [in] rung The rung.
+     * \returns The time stamp.
+     */
+    static uint64_t CurrentStart(const Rung& rung);
+    /**
+     * Activate a new lowest rung, reusing the storage of a previous one.
+     *
+     * \param [in] start The time stamp at the start of the first bucket.
+     * \param [in] width The bucket width.
+     * \param [in] nBuckets The number of buckets.
+     * \returns The new rung.
+     */
+    Rung& PushRung(uint64_t start, uint64_t width, uint32_t nBuckets);
+    /**
+     * Spread events over the lowest rung.
+     *
+     * \param [in,out] events The events, cleared on return.
+     */
+    void Spread(Bucket& events);
+    /** Move the Top to a new first rung. */
+    void TransferTop();
+    /**
+     * Sort a bucket into the Bottom.
+     *
+     * \param [in,out] bucket The bucket, cleared on return.
+     */
+    void SortIntoBottom(Bucket& bucket);
+    /** Refill the Bottom from the ladder and the Top, if it is empty. */
+    void Refill();
+    /** Split the Bottom into a new rung when it grows too large. */
+    void SplitBottom();
+    /** Account for an event removed from the queue, refilling the Bottom if needed. */
+    void EventRemoved();
+
+    /** Events at or after \c m_topStart. */
+    Bucket m_top;
+    /** Start of the time range of the Top. */
+    uint64_t m_topStart;
+    /** Rungs; only the first \c m_nRungs are active, the others keep their storage. */
+    std::vector<Rung> m_rungs;
+    /** Number of active rungs. */
+    uint32_t m_nRungs;
+    /** Events closest to the present, sorted in decreasing order. */
+    Bucket m_bottom;
+    /** Size above which the Bottom is split into a new rung. */
+    size_t m_bottomLimit;
+    /** Scratch storage used while a bucket is split into a new rung. */
+    Bucket m_spill;
+    /** Number of events in queue. */
+    uint32_t m_qSize;
+    /** Largest bucket sorted into the Bottom without being split. */
+    uint32_t m_threshold;
+    /** Maximum number of rungs. */
+    uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
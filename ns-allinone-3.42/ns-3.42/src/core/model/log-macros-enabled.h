@@ -72,6 +72,19 @@
 
 #ifdef NS3_LOG_ENABLE
 
+#ifndef NS3_LOG_COMPILED_MASK
+/**
+ * \ingroup logging
+ * The log levels which are built.
+ *
+ * The statements of the other levels are removed at compile time,
+ * whatever the components enabled at run time.  This is set with the
+ * \c NS3_LOG_LEVEL configuration option, e.g.
+ * \c -DNS3_LOG_LEVEL=WARN keeps only NS_LOG_ERROR and NS_LOG_WARN.
+ */
+#define NS3_LOG_COMPILED_MASK ns3::LOG_LEVEL_ALL
+#endif
+
 /**
  * \ingroup logging
  * Append the simulation time to a log message.
@@ -182,7 +195,7 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(level))                                                                \
+        if (((level) & NS3_LOG_COMPILED_MASK) && g_log.IsEnabled(level))                           \
         {                                                                                          \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
@@ -207,7 +220,7 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
+        if ((ns3::LOG_FUNCTION & NS3_LOG_COMPILED_MASK) && g_log.IsEnabled(ns3::LOG_FUNCTION))     \
         {                                                                                          \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
@@ -241,7 +254,7 @@
     NS_LOG_CONDITION                                                                               \
     do                                                                                             \
     {                                                                                              \
-        if (g_log.IsEnabled(ns3::LOG_FUNCTION))                                                    \
+        if ((ns3::LOG_FUNCTION & NS3_LOG_COMPILED_MASK) && g_log.IsEnabled(ns3::LOG_FUNCTION))     \
         {                                                                                          \
             NS_LOG_APPEND_TIME_PREFIX;                                                             \
             NS_LOG_APPEND_NODE_PREFIX;                                                             \
@@ -26,6 +26,7 @@
 #include "ns3/core-config.h"
 
 #include <algorithm> // transform
+#include <cstdio>    // fwrite
 #include <cstring>   // strlen
 #include <iostream>
 #include <list>
@@ -33,6 +34,7 @@
 #include <map>
 #include <numeric> // accumulate
 #include <stdexcept>
+#include <streambuf>
 #include <utility>
 
 /**
@@ -98,6 +100,115 @@ const std::map<ns3::LogLevel, std::string> LOG_LEVEL_LABELS = {[]() {
     return labels;
 }()};
 
+/**
+ * Line buffer for the log messages written to \c std::clog.
+ *
+ * \c std::clog writes to the unbuffered standard error, so without it
+ * every item streamed in a log message, prefixes and separators included,
+ * is a system call.  This buffer keeps the characters until the end of
+ * the line, so each message costs a single write.  The lines written to
+ * \c std::clog and \c std::cerr stay in order, as \c std::clog is flushed
+ * at every newline and by \c std::endl.
+ *
+ * Several threads may log at the same time, so each thread buffers its
+ * own line: the stream buffer has no put area, every character goes
+ * through overflow() or xsputn() into the line of the calling thread,
+ * and the lines are written with the thread-safe \c fwrite().  A flush
+ * only writes the pending line of the calling thread.
+ */
+class LogStreamBuffer : public std::streambuf
+{
+  protected:
+    int sync() override
+    {
+        GetLine().Write();
+        return 0;
+    }
+
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            Line& line = GetLine();
+            line.text.push_back(traits_type::to_char_type(c));
+            if (traits_type::to_char_type(c) == '\n' || line.text.size() >= MAX_LINE)
+            {
+                line.Write();
+            }
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char_type* s, std::streamsize n) override
+    {
+        Line& line = GetLine();
+        line.text.append(s, n);
+        if (traits_type::find(s, n, '\n') != nullptr || line.text.size() >= MAX_LINE)
+        {
+            line.Write();
+        }
+        return n;
+    }
+
+  private:
+    /** Size above which a line is written even without its end. */
+    static constexpr std::size_t MAX_LINE = 4096;
+
+    /** The pending characters of a thread. */
+    struct Line
+    {
+        /** Write the rest of the line when the thread ends. */
+        ~Line()
+        {
+            Write();
+        }
+
+        /** Write the pending characters to the standard error. */
+        void Write()
+        {
+            if (!text.empty())
+            {
+                std::fwrite(text.data(), 1, text.size(), stderr);
+                std::fflush(stderr);
+                text.clear();
+            }
+        }
+
+        std::string text; //!< The pending characters.
+    };
+
+    /**
+     * \returns The line of the calling thread.
+     */
+    static Line& GetLine()
+    {
+        static thread_local Line line;
+        return line;
+    }
+};
+
+/**
+ * Buffer \c std::clog by line, once some logging is enabled.
+ *
+ * Nothing is done if \c std::clog was redirected, i.e. if it does not
+ * share the stream buffer of \c std::cerr any more.  The buffer is never
+ * deleted, so \c std::clog can be used until the end of the program.
+ */
+void
+BufferLogStream()
+{
+    static bool done = false;
+    if (done)
+    {
+        return;
+    }
+    done = true;
+    if (std::clog.rdbuf() == std::cerr.rdbuf())
+    {
+        std::clog.rdbuf(new LogStreamBuffer);
+    }
+}
+
 } // Unnamed namespace
 
 namespace ns3
@@ -266,6 +377,10 @@ void
 LogComponent::Enable(const LogLevel level)
 {
     m_levels |= (level & ~m_mask);
+    if (m_levels != 0)
+    {
+        BufferLogStream();
+    }
 }
 
 void
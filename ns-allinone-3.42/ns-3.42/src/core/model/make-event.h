@@ -35,6 +35,7 @@ namespace ns3
 {
 
 class EventImpl;
+class ObjectBase;
 
 /**
  * \ingroup events
@@ -137,6 +138,33 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * \ingroup events
+ * Helper for the MakeEvent functions which take a class method.
+ *
+ * \tparam OBJ \deduced The type of the object, either a pointer or a
+ *      smart pointer.
+ * \param [in] obj The object.
+ * \returns The object as an ns3::ObjectBase, or \c nullptr if it is not one.
+ */
+template <typename OBJ>
+const ObjectBase*
+GetEventTargetObject(const OBJ& obj)
+{
+    if constexpr (requires { *obj; })
+    {
+        using T = std::remove_cv_t<std::remove_reference_t<decltype(*obj)>>;
+        if constexpr (std::is_convertible_v<T*, const ObjectBase*>)
+        {
+            if (obj)
+            {
+                return &*obj;
+            }
+        }
+    }
+    return nullptr;
+}
+
 } // namespace internal
 
 template <typename MEM, typename OBJ, typename... Ts>
@@ -149,8 +177,14 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_function(std::bind(function, obj, args...)),
+              m_target(internal::GetEventTargetObject(obj))
+        {
+        }
+
+        const ObjectBase* GetTargetObject() const override
         {
+            return m_target;
         }
 
       protected:
@@ -165,6 +199,7 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         }
 
         std::function<void()> m_function;
+        const ObjectBase* m_target;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -0,0 +1,270 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MemoryAccounting implementation.
+ */
+
+#include "memory-accounting.h"
+
+#include "environment-variable.h"
+#include "log.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MemoryAccounting");
+
+namespace
+{
+
+/** The memory accounted for one TypeId or category. */
+struct Counters
+{
+    int64_t live{0};         //!< The number of allocations alive.
+    int64_t bytes{0};        //!< The bytes they hold.
+    int64_t peakBytes{0};    //!< The largest value of \c bytes.
+    uint64_t allocations{0}; //!< The number of allocations made.
+
+    /**
+     * Account for an allocation.
+     * \param [in] size The size of the allocation.
+     */
+    void Add(uint64_t size)
+    {
+        live++;
+        allocations++;
+        bytes += size;
+        peakBytes = std::max(peakBytes, bytes);
+    }
+
+    /**
+     * Account for a deallocation.
+     * \param [in] size The size of the allocation.
+     */
+    void Remove(uint64_t size)
+    {
+        live--;
+        bytes -= size;
+    }
+};
+
+/** The counters of all the TypeIds and categories. */
+struct Accounts
+{
+    std::mutex mutex;                                           //!< Protects the counters.
+    std::vector<Counters> objects;                              //!< Indexed by TypeId uid.
+    std::vector<std::pair<std::string, Counters>> categories; //!< Indexed by category.
+};
+
+/**
+ * Get the counters.  They are never deleted, as Objects may be deleted
+ * from static destructors.
+ *
+ * \returns The counters.
+ */
+Accounts&
+GetAccounts()
+{
+    static auto accounts = new Accounts;
+    return *accounts;
+}
+
+/**
+ * Build the entry of a TypeId or category.
+ *
+ * \param [in] name The name.
+ * \param [in] counters The counters.
+ * \returns The entry.
+ */
+MemoryAccounting::Entry
+MakeEntry(const std::string& name, const Counters& counters)
+{
+    return {name, counters.live, counters.bytes, counters.peakBytes, counters.allocations};
+}
+
+/**
+ * Whether the \c NS_MEMORY_ACCOUNTING environment variable is set.
+ * \returns \c true if it is.
+ */
+bool
+IsRequestedByEnvironment()
+{
+    return EnvironmentVariable::Get("NS_MEMORY_ACCOUNTING").first;
+}
+
+} // unnamed namespace
+
+bool MemoryAccounting::m_enabled = IsRequestedByEnvironment();
+
+void
+MemoryAccounting::Enable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enabled = true;
+}
+
+void
+MemoryAccounting::Disable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enabled = false;
+}
+
+uint32_t
+MemoryAccounting::RegisterCategory(const std::string& name)
+{
+    NS_LOG_FUNCTION(name);
+    auto& accounts = GetAccounts();
+    std::lock_guard lock(accounts.mutex);
+    auto& categories = accounts.categories;
+    auto it = std::find_if(categories.begin(), categories.end(), [&name](const auto& category) {
+        return category.first == name;
+    });
+    if (it == categories.end())
+    {
+        it = categories.emplace(categories.end(), name, Counters{});
+    }
+    return it - categories.begin();
+}
+
+void
+MemoryAccounting::Allocate(uint32_t category, uint64_t bytes)
+{
+    auto& accounts = GetAccounts();
+    std::lock_guard lock(accounts.mutex);
+    accounts.categories.at(category).second.Add(bytes);
+}
+
+void
+MemoryAccounting::Deallocate(uint32_t category, uint64_t bytes)
+{
+    auto& accounts = GetAccounts();
+    std::lock_guard lock(accounts.mutex);
+    accounts.categories.at(category).second.Remove(bytes);
+}
+
+void
+MemoryAccounting::AllocateObject(TypeId tid, uint64_t bytes)
+{
+    auto& accounts = GetAccounts();
+    std::lock_guard lock(accounts.mutex);
+    if (tid.GetUid() >= accounts.objects.size())
+    {
+        accounts.objects.resize(tid.GetUid() + 1);
+    }
+    accounts.objects[tid.GetUid()].Add(bytes);
+}
+
+void
+MemoryAccounting::DeallocateObject(TypeId tid, uint64_t bytes)
+{
+    auto& accounts = GetAccounts();
+    std::lock_guard lock(accounts.mutex);
+    accounts.objects.at(tid.GetUid()).Remove(bytes);
+}
+
+std::vector<MemoryAccounting::Entry>
+MemoryAccounting::GetEntries()
+{
+    std::vector<Entry> entries;
+    auto& accounts = GetAccounts();
+    {
+        std::lock_guard lock(accounts.mutex);
+        for (std::size_t uid = 0; uid < accounts.objects.size(); ++uid)
+        {
+            const auto& counters = accounts.objects[uid];
+            if (counters.allocations != 0)
+            {
+                TypeId tid;
+                tid.SetUid(uid);
+                entries.push_back(MakeEntry(tid.GetName(), counters));
+            }
+        }
+        for (const auto& [name, counters] : accounts.categories)
+        {
+            if (counters.allocations != 0)
+            {
+                entries.push_back(MakeEntry(name, counters));
+            }
+        }
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.bytes > b.bytes;
+    });
+    return entries;
+}
+
+MemoryAccounting::Entry
+MemoryAccounting::GetEntry(const std::string& name)
+{
+    for (const auto& entry : GetEntries())
+    {
+        if (entry.name == name)
+        {
+            return entry;
+        }
+    }
+    return MakeEntry(name, Counters{});
+}
+
+void
+MemoryAccounting::Print(std::ostream& os, std::size_t n /* = 20 */)
+{
+    auto entries = GetEntries();
+    int64_t live = 0;
+    int64_t bytes = 0;
+    for (const auto& entry : entries)
+    {
+        live += entry.live;
+        bytes += entry.bytes;
+    }
+
+    os << "Memory accounting: " << live << " live allocations, " << bytes << " bytes"
+       << std::endl;
+    os << std::setw(14) << "bytes" << std::setw(14) << "peak bytes" << std::setw(12) << "live"
+       << std::setw(14) << "allocations"
+       << "  type" << std::endl;
+    for (std::size_t i = 0; i < std::min(n, entries.size()); ++i)
+    {
+        const auto& entry = entries[i];
+        os << std::setw(14) << entry.bytes << std::setw(14) << entry.peakBytes << std::setw(12)
+           << entry.live << std::setw(14) << entry.allocations << "  " << entry.name << std::endl;
+    }
+}
+
+void
+MemoryAccounting::PrintRequestedReport()
+{
+    auto [found, value] = EnvironmentVariable::Get("NS_MEMORY_ACCOUNTING");
+    if (!found || !m_enabled)
+    {
+        return;
+    }
+    std::size_t n = 20;
+    if (!value.empty())
+    {
+        n = std::stoul(value);
+    }
+    Print(std::clog, n);
+}
+
+} // namespace ns3
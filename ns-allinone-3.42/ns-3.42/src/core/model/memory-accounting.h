@@ -0,0 +1,176 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_ACCOUNTING_H
+#define MEMORY_ACCOUNTING_H
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MemoryAccounting declaration.
+ */
+
+#include "type-id.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ *
+ * Opt-in accounting of the memory held by the simulation, by type.
+ *
+ * When enabled, every Object built by CreateObject(), CopyObject() or an
+ * ns3::ObjectFactory is counted against its ns3::TypeId, with its shallow
+ * size (\c sizeof of the class constructed, or of ns3::Object for the
+ * classes made by a factory and not registered with
+ * NS_OBJECT_ENSURE_REGISTERED), until it is deleted.  Other allocations are
+ * counted against named categories, registered with RegisterCategory():
+ * the network module accounts this way for the packet byte buffers and
+ * the packet metadata.
+ *
+ * Accounting is disabled by default, and costs a test of a flag per
+ * allocation then.  It is enabled by Enable(), which should be called
+ * before the simulation objects are created, or from the start of the
+ * program by the \c NS_MEMORY_ACCOUNTING environment variable, which also
+ * prints the report at the end of each Simulator::Run():
+ *
+ * \code
+ *     NS_MEMORY_ACCOUNTING=30 ./ns3 run my-sim
+ * \endcode
+ *
+ * The value of the variable, if any, is the number of entries printed.
+ * The counters can also be read, or printed, at any time from the
+ * simulation, e.g. periodically from a scheduled event.
+ */
+class MemoryAccounting
+{
+  public:
+    /** The memory accounted for one TypeId or category. */
+    struct Entry
+    {
+        std::string name;     //!< The TypeId or category name.
+        int64_t live;         //!< The number of allocations alive.
+        int64_t bytes;        //!< The bytes they hold.
+        int64_t peakBytes;    //!< The largest value of \c bytes.
+        uint64_t allocations; //!< The number of allocations made.
+    };
+
+    /** Start accounting for the allocations. */
+    static void Enable();
+    /**
+     * Stop accounting for the allocations.  The Objects already accounted
+     * for are still discounted when they are deleted.
+     */
+    static void Disable();
+
+    /** \returns \c true if the allocations are accounted for. */
+    static bool IsEnabled();
+
+    /**
+     * Get the category to account allocations of a kind against.
+     *
+     * \param [in] name The name of the category.
+     * \returns The category; the same one for the same name.
+     */
+    static uint32_t RegisterCategory(const std::string& name);
+
+    /**
+     * Account for an allocation.
+     *
+     * \param [in] category The category from RegisterCategory().
+     * \param [in] bytes The size of the allocation.
+     */
+    static void Allocate(uint32_t category, uint64_t bytes);
+    /**
+     * Account for a deallocation.
+     *
+     * \param [in] category The category from RegisterCategory().
+     * \param [in] bytes The size of the allocation.
+     */
+    static void Deallocate(uint32_t category, uint64_t bytes);
+
+    /**
+     * Account for an Object construction.
+     *
+     * \param [in] tid The TypeId of the Object.
+     * \param [in] bytes The size of the Object.
+     */
+    static void AllocateObject(TypeId tid, uint64_t bytes);
+    /**
+     * Account for an Object deletion.
+     *
+     * \param [in] tid The TypeId of the Object.
+     * \param [in] bytes The size accounted for at its construction.
+     */
+    static void DeallocateObject(TypeId tid, uint64_t bytes);
+
+    /**
+     * Get the accounted memory, sorted by decreasing bytes held.
+     *
+     * \returns The entries of the TypeIds and categories with allocations.
+     */
+    static std::vector<Entry> GetEntries();
+
+    /**
+     * Get the accounted memory of one TypeId or category.
+     *
+     * \param [in] name The TypeId or category name.
+     * \returns The entry, all zero if nothing was accounted for.
+     */
+    static Entry GetEntry(const std::string& name);
+
+    /**
+     * Print the entries holding the most bytes, and the totals.
+     *
+     * \param [in] os The output stream.
+     * \param [in] n The maximum number of entries to print.
+     */
+    static void Print(std::ostream& os, std::size_t n = 20);
+
+    /**
+     * Print the report requested by the \c NS_MEMORY_ACCOUNTING
+     * environment variable, if any.  Called at the end of Simulator::Run().
+     */
+    static void PrintRequestedReport();
+
+  private:
+    static bool m_enabled; //!< Whether allocations are accounted for.
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the inline functions declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+inline bool
+MemoryAccounting::IsEnabled()
+{
+    return m_enabled;
+}
+
+} // namespace ns3
+
+#endif /* MEMORY_ACCOUNTING_H */
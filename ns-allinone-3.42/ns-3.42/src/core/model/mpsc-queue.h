@@ -0,0 +1,181 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * \file
+ * \ingroup events
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup events
+ * \brief A lock-free, multiple producer, single consumer queue.
+ *
+ * Any number of threads can Push() items concurrently; a single thread
+ * at a time consumes them with Drain().  Producers link a new node at the
+ * head of a list with a compare-and-swap; the consumer detaches the whole
+ * list with one atomic exchange and hands the items over in push order.
+ * Since the consumer never removes nodes one by one, the queue is not
+ * exposed to the ABA problem.
+ *
+ * Items pushed by a single producer are drained in the order they were
+ * pushed; there is no ordering between items of different producers
+ * beyond the order in which their pushes took effect.
+ *
+ * \tparam T \explicit The item type, which must be copy constructible.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /** Constructor. */
+    MpscQueue();
+    /** Destructor, discards the items still queued. */
+    ~MpscQueue();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Add an item to the queue.  Can be called from any thread.
+     *
+     * \param [in] item The item to add.
+     */
+    void Push(const T& item);
+
+    /**
+     * Check if the queue is empty.
+     *
+     * The result is only a hint when producers are running concurrently.
+     *
+     * \returns \c true if no item is queued.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Remove all the queued items, in push order.
+     *
+     * Must be called by one thread at a time.
+     *
+     * \tparam F \deduced The type of the item consumer.
+     * \param [in] consume The function called with each item.
+     * \returns The number of items removed.
+     */
+    template <typename F>
+    std::size_t Drain(F consume);
+
+  private:
+    /** A queued item. */
+    struct Node
+    {
+        T item;     //!< The item.
+        Node* next; //!< The item pushed before this one.
+    };
+
+    /** The last item pushed, at the head of a list in reverse push order. */
+    std::atomic<Node*> m_head;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename T>
+MpscQueue<T>::MpscQueue()
+    : m_head(nullptr)
+{
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr)
+    {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push(const T& item)
+{
+    auto node = new Node{item, m_head.load(std::memory_order_relaxed)};
+    while (!m_head.compare_exchange_weak(node->next,
+                                         node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed))
+    {
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty() const
+{
+    return m_head.load(std::memory_order_relaxed) == nullptr;
+}
+
+template <typename T>
+template <typename F>
+std::size_t
+MpscQueue<T>::Drain(F consume)
+{
+    if (IsEmpty())
+    {
+        return 0;
+    }
+    Node* node = m_head.exchange(nullptr, std::memory_order_acquire);
+    // Reverse the list into push order
+    Node* first = nullptr;
+    while (node != nullptr)
+    {
+        Node* next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+    }
+    std::size_t count = 0;
+    while (first != nullptr)
+    {
+        Node* next = first->next;
+        consume(first->item);
+        delete first;
+        first = next;
+        count++;
+    }
+    return count;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
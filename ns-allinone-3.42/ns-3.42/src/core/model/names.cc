@@ -23,7 +23,7 @@
 #include "object.h"
 #include "singleton.h"
 
-#include <map>
+#include <unordered_map>
 
 /**
  * \file
@@ -78,7 +78,7 @@ class NameNode
     Ptr<Object> m_object;
 
     /** Children of this NameNode. */
-    std::map<std::string, NameNode*> m_nameMap;
+    std::unordered_map<std::string, NameNode*> m_nameMap;
 };
 
 NameNode::NameNode()
@@ -276,7 +276,7 @@ class NamesPriv : public Singleton<NamesPriv>
     NameNode m_root;
 
     /** Map from object pointers to their NameNodes. */
-    std::map<Ptr<Object>, NameNode*> m_objectMap;
+    std::unordered_map<Ptr<Object>, NameNode*> m_objectMap;
 };
 
 NamesPriv::NamesPriv()
@@ -515,6 +515,12 @@ class Time
 
     inline static Time FromDouble(double value, Unit unit)
     {
+        Information* info = PeekInformation(unit);
+        int64_t ticks;
+        if (info->fromMul && info->exactFactor && RoundProduct(value, info, ticks))
+        {
+            return Time(ticks);
+        }
         return From(int64x64_t(value), unit);
     }
 
@@ -572,6 +578,13 @@ class Time
 
     inline double ToDouble(Unit unit) const
     {
+        Information* info = PeekInformation(unit);
+        // Below 2^53 ticks, a single operation with the exact factor
+        // gives the correctly rounded value, without int64x64_t arithmetic.
+        if (info->exactFactor && m_data < MAX_EXACT_TICKS && m_data > -MAX_EXACT_TICKS)
+        {
+            return info->toMul ? m_data * info->realFactor : m_data / info->realFactor;
+        }
         return To(unit).GetDouble();
     }
 
@@ -638,8 +651,61 @@ class Time
         int64x64_t timeTo;   //!< Multiplier to convert to this unit
         int64x64_t timeFrom; //!< Multiplier to convert from this unit
         bool isValid;        //!< True if the current unit can be used
+        bool exactFactor;    //!< True if \c factor is exact as a double
+        double realFactor;   //!< \c factor as a double
+        double factorHi;     //!< High half of the bits of \c realFactor
+        double factorLo;     //!< Low half of the bits of \c realFactor
     };
 
+    /** Largest magnitude of m_data exactly representable as a double. */
+    static constexpr int64_t MAX_EXACT_TICKS = int64_t(1) << 53;
+
+    /**
+     * Round the product of a double and a unit factor to the nearest
+     * integer, halfway cases away from zero, like int64x64_t::Round().
+     *
+     * The rounding error of the floating point product is recovered
+     * with Dekker's algorithm, so the result is the one of the exact
+     * product.
+     *
+     * \param [in] value The value to convert.
+     * \param [in] info The conversion information, with an exact factor.
+     * \param [out] ticks The rounded product.
+     * \returns \c false if the product is too large for this method.
+     */
+    static inline bool RoundProduct(double value, const Information* info, int64_t& ticks)
+    {
+        double product = value * info->realFactor;
+        // Also false for NaN
+        if (!(std::fabs(product) < static_cast<double>(MAX_EXACT_TICKS / 2)))
+        {
+            return false;
+        }
+        // Split value in two halves, whose products with the halves
+        // of the factor are exact: value * factor == product + error
+        const double split = 134217729.0; // 2^27 + 1
+        double c = split * value;
+        double hi = c - (c - value);
+        double lo = value - hi;
+        double error = ((hi * info->factorHi - product) + hi * info->factorLo +
+                        lo * info->factorHi) +
+                       lo * info->factorLo;
+
+        // |error| <= 1/4 and the exact product is rounded + delta + error
+        double rounded = std::round(product);
+        double delta = product - rounded;
+        if (error > 0.5 - delta || (error == 0.5 - delta && rounded >= 0))
+        {
+            rounded += 1;
+        }
+        else if (error < -0.5 - delta || (error == -0.5 - delta && rounded <= 0))
+        {
+            rounded -= 1;
+        }
+        ticks = static_cast<int64_t>(rounded);
+        return true;
+    }
+
     /** Current time unit, and conversion info. */
     struct Resolution
     {
@@ -18,7 +18,10 @@
  */
 #include "object-factory.h"
 
+#include "environment-variable.h"
 #include "log.h"
+#include "memory-accounting.h"
+#include "string.h"
 
 #include <sstream>
 
@@ -42,14 +45,24 @@ void
 ObjectFactory::SetTypeId(TypeId tid)
 {
     NS_LOG_FUNCTION(this << tid.GetName());
-    m_tid = tid;
+    if (tid != m_tid)
+    {
+        m_tid = tid;
+        m_planGeneration = 0;
+    }
 }
 
 void
 ObjectFactory::SetTypeId(std::string tid)
 {
     NS_LOG_FUNCTION(this << tid);
+    // the helpers set the same type again and again
+    if (m_tid.GetUid() != 0 && m_tid.GetName() == tid)
+    {
+        return;
+    }
     m_tid = TypeId::LookupByName(tid);
+    m_planGeneration = 0;
 }
 
 bool
@@ -80,6 +93,7 @@ ObjectFactory::DoSet(const std::string& name, const AttributeValue& value)
         return;
     }
     m_parameters.Add(name, info.checker, value.Copy());
+    m_planGeneration = 0;
 }
 
 TypeId
@@ -101,11 +115,106 @@ ObjectFactory::Create() const
     auto derived = dynamic_cast<Object*>(base);
     NS_ASSERT(derived != nullptr);
     derived->SetTypeId(m_tid);
-    derived->Construct(m_parameters);
+    if (MemoryAccounting::IsEnabled())
+    {
+        // The size registered by NS_OBJECT_ENSURE_REGISTERED, if any
+        std::size_t size = m_tid.GetSize();
+        derived->m_accountedSize = (size == std::size_t(-1)) ? sizeof(Object) : size;
+        MemoryAccounting::AllocateObject(m_tid, derived->m_accountedSize);
+    }
+    if (derived->GetInstanceTypeId() != m_tid)
+    {
+        derived->Construct(m_parameters);
+        return Ptr<Object>(derived, false);
+    }
+
+    UpdateConstructionPlan();
+    for (const auto& step : m_plan)
+    {
+        if (step.convert)
+        {
+            Ptr<AttributeValue> value = step.checker->CreateValidValue(*step.value);
+            if (value)
+            {
+                step.accessor->Set(derived, *value);
+            }
+        }
+        else
+        {
+            step.accessor->Set(derived, *step.value);
+        }
+    }
+    derived->NotifyConstructionCompleted();
     Ptr<Object> object = Ptr<Object>(derived, false);
     return object;
 }
 
+void
+ObjectFactory::UpdateConstructionPlan() const
+{
+    uint64_t generation = TypeId::GetAttributeGeneration();
+    if (m_planGeneration == generation)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+
+    m_plan.clear();
+    TypeId tid = m_tid;
+    do
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            Ptr<const AttributeValue> value = m_parameters.Find(info.checker);
+            if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+            {
+                if (value)
+                {
+                    NS_FATAL_ERROR("Attribute name="
+                                   << info.name << " tid=" << tid.GetName()
+                                   << ": initial value cannot be set using attributes");
+                }
+                continue;
+            }
+            if (!value)
+            {
+                auto [found, val] =
+                    EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT", tid.GetAttributeFullName(i));
+                if (found)
+                {
+                    value = ns3::Create<StringValue>(val);
+                }
+            }
+            if (!value)
+            {
+                value = info.initialValue;
+            }
+
+            ConstructionStep step{info.accessor, info.checker, value, false};
+            if (!info.checker->Check(*value))
+            {
+                if (info.checker->GetValueTypeName() == "ns3::PointerValue")
+                {
+                    // each object points to its own object
+                    step.convert = true;
+                }
+                else
+                {
+                    step.value = info.checker->CreateValidValue(*value);
+                }
+            }
+            if (step.value)
+            {
+                NS_LOG_DEBUG("construct \"" << tid.GetName() << "::" << info.name << "\"");
+                m_plan.push_back(step);
+            }
+        }
+        tid = tid.GetParent();
+    } while (tid != ObjectBase::GetTypeId());
+    m_planGeneration = generation;
+}
+
 std::ostream&
 operator<<(std::ostream& os, const ObjectFactory& factory)
 {
@@ -194,6 +303,7 @@ operator>>(std::istream& is, ObjectFactory& factory)
         }
     }
     NS_ABORT_MSG_IF(is.bad(), "Failure to parse " << parameters);
+    factory.m_planGeneration = 0;
     return is;
 }
 
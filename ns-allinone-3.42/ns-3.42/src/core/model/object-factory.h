@@ -23,6 +23,8 @@
 #include "object.h"
 #include "type-id.h"
 
+#include <vector>
+
 /**
  * \file
  * \ingroup object
@@ -42,6 +44,14 @@ class AttributeValue;
  * This class can also hold a set of attributes to set
  * automatically during the object construction.
  *
+ * The values set on the objects created, from the attributes of the
+ * factory, the environment or the initial values of the TypeId, are
+ * resolved and converted to the type of each attribute once, then
+ * reused by each call to Create, until the factory or an initial value
+ * (e.g. with Config::SetDefault) is changed. The values converted from a
+ * string to a PointerValue are still converted for each object, so that
+ * each object gets its own instance of the object pointed to.
+ *
  * \see attribute_ObjectFactory
  */
 class ObjectFactory
@@ -162,6 +172,25 @@ class ObjectFactory
      */
     friend std::istream& operator>>(std::istream& is, ObjectFactory& factory);
 
+    /**
+     * Resolve the values set on the objects created, as
+     * ObjectBase::ConstructSelf does, unless they are up to date.
+     */
+    void UpdateConstructionPlan() const;
+
+    /** A value set on the objects created. */
+    struct ConstructionStep
+    {
+        /** The accessor of the attribute. */
+        Ptr<const AttributeAccessor> accessor;
+        /** The checker of the attribute. */
+        Ptr<const AttributeChecker> checker;
+        /** The value, of the type of the attribute unless convert is set. */
+        Ptr<const AttributeValue> value;
+        /** Whether the value must be converted for each object. */
+        bool convert;
+    };
+
     /** The TypeId this factory will create. */
     TypeId m_tid;
     /**
@@ -169,6 +198,10 @@ class ObjectFactory
      * objects by this factory.
      */
     AttributeConstructionList m_parameters;
+    /** The values set on the objects created, in the order of ConstructSelf. */
+    mutable std::vector<ConstructionStep> m_plan;
+    /** The attribute generation m_plan was resolved for, 0 if m_plan is stale. */
+    mutable uint64_t m_planGeneration{0};
 };
 
 std::ostream& operator<<(std::ostream& os, const ObjectFactory& factory);
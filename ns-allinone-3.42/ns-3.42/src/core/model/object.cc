@@ -109,10 +109,12 @@ Object::Object()
       m_disposed(false),
       m_initialized(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_getObjectCount(0),
+      m_accountedSize(0)
 {
     NS_LOG_FUNCTION(this);
     m_aggregates->n = 1;
+    m_aggregates->cache = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -120,6 +122,10 @@ Object::~Object()
 {
     // remove this object from the aggregate list
     NS_LOG_FUNCTION(this);
+    if (m_accountedSize != 0)
+    {
+        MemoryAccounting::DeallocateObject(m_tid, m_accountedSize);
+    }
     uint32_t n = m_aggregates->n;
     for (uint32_t i = 0; i < n; i++)
     {
@@ -132,11 +138,16 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // forget the lookups which may have returned this object
+    if (m_aggregates->cache != nullptr)
+    {
+        std::memset(m_aggregates->cache, 0, sizeof(LookupCache));
+    }
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
     {
-        std::free(m_aggregates);
+        FreeAggregates(m_aggregates);
     }
     m_aggregates = nullptr;
     m_unidirectionalAggregates.clear();
@@ -147,9 +158,11 @@ Object::Object(const Object& o)
       m_disposed(false),
       m_initialized(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
-      m_getObjectCount(0)
+      m_getObjectCount(0),
+      m_accountedSize(0)
 {
     m_aggregates->n = 1;
+    m_aggregates->cache = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -166,9 +179,26 @@ Object::DoGetObject(TypeId tid) const
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(CheckLoose());
 
-    // First check if the object is in the normal aggregates.
-    uint32_t n = m_aggregates->n;
+    // First check if the object is in the normal aggregates, starting
+    // with the answers of the previous lookups.
     TypeId objectTid = Object::GetTypeId();
+    uint16_t uid = tid.GetUid();
+    uint32_t slot = uid % LookupCache::SIZE;
+    LookupCache* cache = m_aggregates->cache;
+    uint32_t n = m_aggregates->n;
+    if (cache != nullptr && cache->uid[slot] == uid)
+    {
+        if (cache->object[slot] != nullptr)
+        {
+            return cache->object[slot];
+        }
+        n = 0;
+    }
+    else if (cache == nullptr)
+    {
+        cache = static_cast<LookupCache*>(std::calloc(1, sizeof(LookupCache)));
+        m_aggregates->cache = cache;
+    }
     for (uint32_t i = 0; i < n; i++)
     {
         Object* current = m_aggregates->buffer[i];
@@ -189,10 +219,17 @@ Object::DoGetObject(TypeId tid) const
             current->m_getObjectCount++;
             // then, update the sort
             UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
+            // finally, remember and return the match
+            cache->uid[slot] = uid;
+            cache->object[slot] = current;
             return const_cast<Object*>(current);
         }
     }
+    if (n != 0)
+    {
+        cache->uid[slot] = uid;
+        cache->object[slot] = nullptr;
+    }
 
     // Next check if it's a unidirectional aggregate
     for (auto& uniItem : m_unidirectionalAggregates)
@@ -319,6 +356,7 @@ Object::AggregateObject(Ptr<Object> o)
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
     auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
     aggregates->n = total;
+    aggregates->cache = nullptr;
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -371,8 +409,15 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
-    std::free(a);
-    std::free(b);
+    FreeAggregates(a);
+    FreeAggregates(b);
+}
+
+void
+Object::FreeAggregates(Aggregates* aggregates)
+{
+    std::free(aggregates->cache);
+    std::free(aggregates);
 }
 
 void
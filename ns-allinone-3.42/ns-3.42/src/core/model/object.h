@@ -22,6 +22,7 @@
 
 #include "attribute-construction-list.h"
 #include "attribute.h"
+#include "memory-accounting.h"
 #include "object-base.h"
 #include "ptr.h"
 #include "simple-ref-count.h"
@@ -371,6 +372,27 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /**
+     * A direct-mapped cache of the results of DoGetObject() on the
+     * Objects of an Aggregates list, indexed by TypeId uid.
+     *
+     * An entry with a null \c object records that no Object of that
+     * TypeId is in the list; the unidirectional aggregates, which are
+     * not shared by the list, still have to be searched.  The cache
+     * belongs to its Aggregates: it is allocated on the first lookup,
+     * dropped with its list when an aggregation creates a new one, and
+     * emptied when an Object leaves the list.
+     */
+    struct LookupCache
+    {
+        /** The number of entries. */
+        static constexpr uint32_t SIZE = 16;
+        /** The TypeId uid of each entry, 0 for an empty entry. */
+        uint16_t uid[SIZE];
+        /** The matching Object of each entry. */
+        Object* object[SIZE];
+    };
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -387,6 +409,8 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /** The GetObject() cache of this list, or \c nullptr. */
+        LookupCache* cache;
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -398,6 +422,20 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * \return The matching Object, if it is found
      */
     Ptr<Object> DoGetObject(TypeId tid) const;
+    /**
+     * Look for an Object of TypeId uid \p uid in the GetObject() cache.
+     *
+     * \param [in] uid The TypeId uid we're looking for
+     * \return The cached Object, or \c nullptr if the lookup must go
+     *         through DoGetObject()
+     */
+    inline Object* PeekCachedObject(uint16_t uid) const;
+    /**
+     * Release an Aggregates list and its GetObject() cache.
+     *
+     * \param [in] aggregates The list to release.
+     */
+    static void FreeAggregates(Aggregates* aggregates);
     /**
      * Verify that this Object is still live, by checking it's reference count.
      * \return \c true if the reference count is non zero.
@@ -495,6 +533,12 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * the array of aggregates in most-frequently accessed order.
      */
     uint32_t m_getObjectCount;
+
+    /**
+     * The size this Object was accounted for by MemoryAccounting at its
+     * construction, or zero if it was not.
+     */
+    uint32_t m_accountedSize;
 };
 
 template <typename T>
@@ -517,10 +561,28 @@ ObjectDeleter::Delete(Object* object)
     object->DoDelete();
 }
 
+Object*
+Object::PeekCachedObject(uint16_t uid) const
+{
+    const LookupCache* cache = m_aggregates->cache;
+    if (cache != nullptr && cache->uid[uid % LookupCache::SIZE] == uid)
+    {
+        return cache->object[uid % LookupCache::SIZE];
+    }
+    return nullptr;
+}
+
 template <typename T>
 Ptr<T>
 Object::GetObject() const
 {
+    // Most lookups are repeated on the same aggregate: answer them from
+    // the cache, without walking the TypeId hierarchy.
+    Object* cached = PeekCachedObject(T::GetTypeId().GetUid());
+    if (cached != nullptr)
+    {
+        return Ptr<T>(static_cast<T*>(cached));
+    }
     // This is an optimization: if the cast works (which is likely),
     // things will be pretty fast.
     T* result = dynamic_cast<T*>(m_aggregates->buffer[0]);
@@ -610,6 +672,11 @@ Ptr<T>
 CompleteConstruct(T* object)
 {
     object->SetTypeId(T::GetTypeId());
+    if (MemoryAccounting::IsEnabled())
+    {
+        object->m_accountedSize = sizeof(T);
+        MemoryAccounting::AllocateObject(object->m_tid, sizeof(T));
+    }
     object->Object::Construct(AttributeConstructionList());
     return Ptr<T>(object, false);
 }
@@ -35,6 +35,7 @@
 #include "string.h"
 
 #include <algorithm> // upper_bound
+#include <array>
 #include <cmath>
 #include <iostream>
 
@@ -49,6 +50,50 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("RandomVariableStream");
 
+namespace
+{
+
+/**
+ * \ingroup randomvariable
+ * Fill \p values with variates obtained by transforming one uniform
+ * each, rejecting those above \p bound as the GetValue() loops do.
+ *
+ * \tparam F \deduced The transform type.
+ * \param [in] rng The RngStream to draw the uniforms from.
+ * \param [in] antithetic Whether to use the antithetic uniforms.
+ * \param [in] bound The upper bound on the variates, 0 for none.
+ * \param [out] values The variates.
+ * \param [in] transform The function mapping a uniform to a variate.
+ */
+template <typename F>
+void
+FillBounded(RngStream* rng, bool antithetic, double bound, std::span<double> values, F transform)
+{
+    // Draw as many uniforms as values are missing; rejected ones leave
+    // room for the next round.  Entries are only overwritten once their
+    // uniform has been used.
+    std::size_t filled = 0;
+    while (filled < values.size())
+    {
+        std::span<double> pending = values.subspan(filled);
+        rng->RandU01(pending);
+        for (double v : pending)
+        {
+            if (antithetic)
+            {
+                v = (1 - v);
+            }
+            double r = transform(v);
+            if (bound == 0 || r <= bound)
+            {
+                values[filled++] = r;
+            }
+        }
+    }
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(RandomVariableStream);
 
 TypeId
@@ -109,6 +154,26 @@ RandomVariableStream::GetInteger()
     return static_cast<uint32_t>(GetValue());
 }
 
+void
+RandomVariableStream::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    for (auto& value : values)
+    {
+        value = GetValue();
+    }
+}
+
+void
+RandomVariableStream::GetIntegers(std::span<uint32_t> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    for (auto& value : values)
+    {
+        value = GetInteger();
+    }
+}
+
 void
 RandomVariableStream::SetStream(int64_t stream)
 {
@@ -226,6 +291,45 @@ UniformRandomVariable::GetInteger()
     return static_cast<uint32_t>(GetValue(m_min, m_max + 1));
 }
 
+void
+UniformRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    bool antithetic = IsAntithetic();
+    Peek()->RandU01(values);
+    for (auto& v : values)
+    {
+        v = m_min + v * (m_max - m_min);
+        if (antithetic)
+        {
+            v = m_min + (m_max - v);
+        }
+    }
+}
+
+void
+UniformRandomVariable::GetIntegers(std::span<uint32_t> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    bool antithetic = IsAntithetic();
+    double max = m_max + 1;
+    std::array<double, 64> buffer;
+    for (std::size_t i = 0; i < values.size(); i += buffer.size())
+    {
+        std::span<double> u(buffer.data(), std::min(buffer.size(), values.size() - i));
+        Peek()->RandU01(u);
+        for (std::size_t j = 0; j < u.size(); ++j)
+        {
+            double v = m_min + u[j] * (max - m_min);
+            if (antithetic)
+            {
+                v = m_min + (max - v);
+            }
+            values[i + j] = static_cast<uint32_t>(v);
+        }
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
 TypeId
@@ -277,6 +381,13 @@ ConstantRandomVariable::GetValue()
     return GetValue(m_constant);
 }
 
+void
+ConstantRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    std::fill(values.begin(), values.end(), m_constant);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(SequentialRandomVariable);
 
 TypeId
@@ -455,6 +566,16 @@ ExponentialRandomVariable::GetValue()
     return GetValue(m_mean, m_bound);
 }
 
+void
+ExponentialRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    double mean = m_mean;
+    FillBounded(Peek(), IsAntithetic(), m_bound, values, [mean](double v) {
+        return -mean * std::log(v);
+    });
+}
+
 NS_OBJECT_ENSURE_REGISTERED(ParetoRandomVariable);
 
 TypeId
@@ -554,6 +675,17 @@ ParetoRandomVariable::GetValue()
     return GetValue(m_scale, m_shape, m_bound);
 }
 
+void
+ParetoRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    double scale = m_scale;
+    double shape = m_shape;
+    FillBounded(Peek(), IsAntithetic(), m_bound, values, [scale, shape](double v) {
+        return (scale * (1.0 / std::pow(v, 1.0 / shape)));
+    });
+}
+
 NS_OBJECT_ENSURE_REGISTERED(WeibullRandomVariable);
 
 TypeId
@@ -651,6 +783,17 @@ WeibullRandomVariable::GetValue()
     return GetValue(m_scale, m_shape, m_bound);
 }
 
+void
+WeibullRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    double scale = m_scale;
+    double exponent = 1.0 / m_shape;
+    FillBounded(Peek(), IsAntithetic(), m_bound, values, [scale, exponent](double v) {
+        return scale * std::pow(-std::log(v), exponent);
+    });
+}
+
 NS_OBJECT_ENSURE_REGISTERED(NormalRandomVariable);
 
 const double NormalRandomVariable::INFINITE_VALUE = 1e307;
@@ -776,6 +919,18 @@ NormalRandomVariable::GetValue()
     return GetValue(m_mean, m_variance, m_bound);
 }
 
+void
+NormalRandomVariable::GetValues(std::span<double> values)
+{
+    NS_LOG_FUNCTION(this << values.size());
+    // The polar method consumes a variable number of uniforms per pair,
+    // so only the virtual dispatch is saved here.
+    for (auto& v : values)
+    {
+        v = GetValue(m_mean, m_variance, m_bound);
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(LogNormalRandomVariable);
 
 TypeId
@@ -31,6 +31,7 @@
 #include "type-id.h"
 
 #include <map>
+#include <span>
 #include <stdint.h>
 
 /**
@@ -154,6 +155,29 @@ class RandomVariableStream : public Object
     // The base implementation returns `(uint32_t)GetValue()`
     virtual uint32_t GetInteger();
 
+    /**
+     * \brief Fill \p values with the next random values drawn from the
+     * distribution.
+     *
+     * The values are the ones the same number of GetValue() calls would
+     * return, in the same order, so both can be mixed freely.  The base
+     * implementation calls GetValue() for each value; the usual
+     * distributions override it to draw their uniforms from the RngStream
+     * in one pass.
+     *
+     * \param [out] values The random values.
+     */
+    virtual void GetValues(std::span<double> values);
+
+    /**
+     * \brief Fill \p values with the next random integers drawn from the
+     * distribution.
+     *
+     * \see GetValues()
+     * \param [out] values The random integers, as returned by GetInteger().
+     */
+    virtual void GetIntegers(std::span<uint32_t> values);
+
   protected:
     /**
      * \brief Get the pointer to the underlying RngStream.
@@ -284,6 +308,9 @@ class UniformRandomVariable : public RandomVariableStream
      */
     uint32_t GetInteger() override;
 
+    void GetValues(std::span<double> values) override;
+    void GetIntegers(std::span<uint32_t> values) override;
+
   private:
     /** The lower bound on values that can be returned by this RNG stream. */
     double m_min;
@@ -341,6 +368,7 @@ class ConstantRandomVariable : public RandomVariableStream
     double GetValue() override;
     /* \note This RNG always returns the same value. */
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The constant value returned by this RNG stream. */
@@ -593,6 +621,7 @@ class ExponentialRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The mean value of the unbounded exponential distribution. */
@@ -729,6 +758,7 @@ class ParetoRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The scale parameter for the Pareto distribution returned by this RNG stream. */
@@ -876,6 +906,7 @@ class WeibullRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The scale parameter for the Weibull distribution returned by this RNG stream. */
@@ -1018,6 +1049,7 @@ class NormalRandomVariable : public RandomVariableStream
     // Inherited
     double GetValue() override;
     using RandomVariableStream::GetInteger;
+    void GetValues(std::span<double> values) override;
 
   private:
     /** The mean value for the normal distribution returned by this RNG stream. */
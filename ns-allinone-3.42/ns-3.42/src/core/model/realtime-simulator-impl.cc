@@ -30,6 +30,7 @@
 #include "synchronizer.h"
 #include "wall-clock-synchronizer.h"
 
+#include <bit>
 #include <cmath>
 #include <mutex>
 #include <thread>
@@ -70,7 +71,19 @@ RealtimeSimulatorImpl::GetTypeId()
                           "SynchronizationMode=HardLimit)",
                           TimeValue(Seconds(0.1)),
                           MakeTimeAccessor(&RealtimeSimulatorImpl::m_hardLimit),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("SynchronizationSlack",
+                          "Events due within this time of the current real time are run "
+                          "immediately, without waiting for the synchronizer",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RealtimeSimulatorImpl::SetSynchronizationSlack,
+                                           &RealtimeSimulatorImpl::GetSynchronizationSlack),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("RecordLateness",
+                          "Record the histogram of the lateness of the events",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RealtimeSimulatorImpl::m_recordLateness),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -86,6 +99,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_recordLateness = false;
 
     m_main = std::this_thread::get_id();
 
@@ -228,6 +242,17 @@ RealtimeSimulatorImpl::ProcessOneEvent()
             tsNow = m_synchronizer->GetCurrentRealtime();
             tsNext = NextTs();
 
+            //
+            // If the next event is already due, or due within the synchronization
+            // slack, there is nothing to wait for: run it right away.  When the
+            // simulation is busy, this spares a call to the synchronizer for most
+            // events.
+            //
+            if (tsNext <= tsNow + m_slack.GetTimeStep())
+            {
+                break;
+            }
+
             //
             // tsDelay is therefore the real time we need to delay in order to bring the
             // real time in sync with the simulation time.  If we wait for this amount of
@@ -381,6 +406,22 @@ RealtimeSimulatorImpl::ProcessOneEvent()
                                << tsJitter << ")");
             }
         }
+
+        if (m_recordLateness)
+        {
+            uint64_t tsStart = m_synchronizer->GetCurrentRealtime();
+            uint64_t ns = 0;
+            if (tsStart > m_currentTs)
+            {
+                ns = TimeStep(tsStart - m_currentTs).GetNanoSeconds();
+            }
+            std::size_t bin = std::bit_width(ns);
+            if (m_lateness.size() <= bin)
+            {
+                m_lateness.resize(bin + 1, 0);
+            }
+            m_lateness[bin]++;
+        }
     }
 
     //
@@ -830,4 +871,26 @@ RealtimeSimulatorImpl::GetHardLimit() const
     return m_hardLimit;
 }
 
+void
+RealtimeSimulatorImpl::SetSynchronizationSlack(Time slack)
+{
+    NS_LOG_FUNCTION(this << slack);
+    m_slack = slack;
+}
+
+Time
+RealtimeSimulatorImpl::GetSynchronizationSlack() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_slack;
+}
+
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetLatenessHistogram() const
+{
+    NS_LOG_FUNCTION(this);
+    std::unique_lock lock{m_mutex};
+    return m_lateness;
+}
+
 } // namespace ns3
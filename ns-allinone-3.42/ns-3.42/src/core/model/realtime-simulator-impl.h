@@ -29,6 +29,7 @@
 #include <list>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * \file
@@ -163,6 +164,38 @@ class RealtimeSimulatorImpl : public SimulatorImpl
      */
     Time GetHardLimit() const;
 
+    /**
+     * Set the synchronization slack.
+     *
+     * The events due less than the slack after the current real time are
+     * run without waiting for the synchronizer, so that busy simulations
+     * pay the cost of a wait only once per burst of events.
+     *
+     * \param [in] slack The maximum amount of real time an event may run
+     *     before its due time.
+     */
+    void SetSynchronizationSlack(Time slack);
+    /**
+     * Get the synchronization slack.
+     *
+     * \returns The synchronization slack.
+     */
+    Time GetSynchronizationSlack() const;
+
+    /**
+     * Get the histogram of the lateness of the events, recorded when the
+     * RecordLateness attribute is true.
+     *
+     * The lateness of an event is the real time elapsed between its due
+     * time and the start of its execution.  Bin 0 counts the events started
+     * on time, or early within the synchronization slack; bin \c i, for
+     * \c i > 0, counts the events started between 2^(i-1) and 2^i - 1
+     * nanoseconds late.  The trailing empty bins are omitted.
+     *
+     * \returns The number of events in each bin.
+     */
+    std::vector<uint64_t> GetLatenessHistogram() const;
+
   private:
     /**
      * Is the simulator running?
@@ -227,6 +260,15 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     /** The maximum allowable drift from real-time in SYNC_HARD_LIMIT mode. */
     Time m_hardLimit;
 
+    /** The events due within this time are run without synchronizing. */
+    Time m_slack;
+
+    /** Whether the lateness of the events is recorded. */
+    bool m_recordLateness;
+
+    /** Histogram of the lateness of the events, by power of two of nanoseconds. */
+    std::vector<uint64_t> m_lateness;
+
     /** Main thread. */
     std::thread::id m_main;
 };
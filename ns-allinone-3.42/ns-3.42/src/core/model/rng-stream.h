@@ -18,6 +18,7 @@
 
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
+#include <span>
 #include <stdint.h>
 #include <string>
 
@@ -70,6 +71,16 @@ class RngStream
      * \returns The next random.
      */
     double RandU01();
+    /**
+     * Fill \p values with the next random numbers of this stream.
+     *
+     * The numbers are the ones successive calls to RandU01() would
+     * return, in the same order, but the state is only loaded and
+     * stored once.
+     *
+     * \param [out] values The random numbers.
+     */
+    void RandU01(std::span<double> values);
 
   private:
     /**
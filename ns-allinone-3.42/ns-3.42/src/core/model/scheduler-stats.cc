@@ -0,0 +1,135 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SchedulerStats implementation.
+ */
+
+#include "scheduler-stats.h"
+
+#include "log.h"
+#include "nstime.h"
+
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SchedulerStats");
+
+SchedulerStats::SchedulerStats()
+{
+    NS_LOG_FUNCTION(this);
+    Reset();
+}
+
+uint64_t
+SchedulerStats::GetInserts() const
+{
+    return m_inserts;
+}
+
+uint64_t
+SchedulerStats::GetRemoveNexts() const
+{
+    return m_removeNexts;
+}
+
+uint64_t
+SchedulerStats::GetRemoves() const
+{
+    return m_removes;
+}
+
+uint64_t
+SchedulerStats::GetCancels() const
+{
+    return m_cancels;
+}
+
+uint64_t
+SchedulerStats::GetCancelledInQueue() const
+{
+    return m_cancels > m_cancelledRemoveNexts ? m_cancels - m_cancelledRemoveNexts : 0;
+}
+
+double
+SchedulerStats::GetCancelledRatio() const
+{
+    return m_removeNexts > 0 ? static_cast<double>(m_cancelledRemoveNexts) / m_removeNexts : 0;
+}
+
+uint64_t
+SchedulerStats::GetPeakSize() const
+{
+    return m_peakSize;
+}
+
+const std::array<uint64_t, SchedulerStats::HORIZON_BUCKETS>&
+SchedulerStats::GetHorizonHistogram() const
+{
+    return m_horizon;
+}
+
+void
+SchedulerStats::Print(std::ostream& os) const
+{
+    os << "Scheduler statistics: " << m_inserts << " events inserted, " << m_removeNexts
+       << " taken out to run, " << m_removes << " removed" << std::endl;
+
+    auto flags = os.flags();
+    auto precision = os.precision();
+    os << std::fixed << std::setprecision(2);
+    os << "  peak queue size " << m_peakSize << ", " << m_cancels << " events cancelled, "
+       << 100 * GetCancelledRatio() << "% of the events taken out were cancelled" << std::endl;
+    os << "  insertion horizon:" << std::endl;
+    for (std::size_t i = 0; i < HORIZON_BUCKETS; ++i)
+    {
+        if (m_horizon[i] == 0)
+        {
+            continue;
+        }
+        os << std::setw(8) << 100.0 * m_horizon[i] / m_inserts << "%  ";
+        if (i == 0)
+        {
+            os << "now";
+        }
+        else
+        {
+            // Bucket 64 would overflow the signed time steps
+            os << "< " << TimeStep(i < 63 ? int64_t{1} << i : INT64_MAX).As();
+        }
+        os << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void
+SchedulerStats::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    m_inserts = 0;
+    m_removeNexts = 0;
+    m_cancelledRemoveNexts = 0;
+    m_removes = 0;
+    m_cancels = 0;
+    m_peakSize = 0;
+    m_horizon.fill(0);
+}
+
+} // namespace ns3
@@ -0,0 +1,185 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SCHEDULER_STATS_H
+#define SCHEDULER_STATS_H
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SchedulerStats declaration.
+ */
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <ostream>
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ *
+ * Statistics of the use of the event queue of a simulation.
+ *
+ * They count the events inserted in the ns3::Scheduler, the events taken
+ * out to run, and those cancelled: a cancelled event stays in the queue
+ * until its time comes, unless it was removed by Simulator::Remove(), so
+ * many cancellations grow the queue and its operations.  They also keep
+ * the largest size of the queue, and a histogram of the insertion
+ * horizon, the delay between the insertion of an event and its time,
+ * which tells how the queue is used: the ns3::CalendarScheduler suits
+ * delays spread over a narrow range, the ns3::HeapScheduler and the
+ * ns3::PriorityQueueScheduler any distribution, and the
+ * ns3::MapScheduler a small queue; the ns3::LadderScheduler adapts to
+ * the distribution.
+ *
+ * The simulator implementations which support it keep statistics when
+ * configured to; with ns3::DefaultSimulatorImpl:
+ *
+ * \code
+ *     ./ns3 run "my-sim --ns3::DefaultSimulatorImpl::SchedulerStats=true"
+ * \endcode
+ *
+ * prints them at the end of each Simulator::Run(), and
+ * DefaultSimulatorImpl::GetSchedulerStats() gives access to them.
+ */
+class SchedulerStats
+{
+  public:
+    /** The number of buckets of the horizon histogram. */
+    static constexpr std::size_t HORIZON_BUCKETS = 65;
+
+    /** Constructor. */
+    SchedulerStats();
+
+    /**
+     * Account for an event inserted in the queue.
+     *
+     * \param [in] delay The time of the event less the current time,
+     *             in time steps.
+     * \param [in] size The size of the queue, with the event.
+     */
+    inline void RecordInsert(uint64_t delay, uint64_t size);
+    /**
+     * Account for the next event taken out of the queue.
+     *
+     * \param [in] cancelled Whether the event was cancelled.
+     */
+    inline void RecordRemoveNext(bool cancelled);
+    /** Account for an event removed by Simulator::Remove(). */
+    inline void RecordRemove();
+    /** Account for a pending event cancelled. */
+    inline void RecordCancel();
+
+    /** \returns The number of events inserted. */
+    uint64_t GetInserts() const;
+    /** \returns The number of events taken out of the queue to run. */
+    uint64_t GetRemoveNexts() const;
+    /** \returns The number of events removed by Simulator::Remove(). */
+    uint64_t GetRemoves() const;
+    /** \returns The number of pending events cancelled. */
+    uint64_t GetCancels() const;
+    /**
+     * \returns The number of cancelled events still in the queue, if the
+     *          statistics were kept from the start of the simulation.
+     */
+    uint64_t GetCancelledInQueue() const;
+    /**
+     * \returns The fraction of the events taken out of the queue which
+     *          were cancelled, and did not run.
+     */
+    double GetCancelledRatio() const;
+    /** \returns The largest size of the queue. */
+    uint64_t GetPeakSize() const;
+
+    /**
+     * Get the histogram of the insertion horizon.
+     *
+     * Bucket 0 counts the events inserted for the current time, and
+     * bucket \c i > 0 those inserted with a delay \c d such that
+     * 2<sup>i-1</sup> <= \c d < 2<sup>i</sup> time steps.
+     *
+     * \returns The histogram.
+     */
+    const std::array<uint64_t, HORIZON_BUCKETS>& GetHorizonHistogram() const;
+
+    /**
+     * Print the statistics.
+     *
+     * \param [in] os The output stream.
+     */
+    void Print(std::ostream& os) const;
+
+    /** Forget all the statistics. */
+    void Reset();
+
+  private:
+    uint64_t m_inserts;                              //!< Events inserted.
+    uint64_t m_removeNexts;                          //!< Events taken out to run.
+    uint64_t m_cancelledRemoveNexts;                 //!< Of them, cancelled ones.
+    uint64_t m_removes;                              //!< Events removed.
+    uint64_t m_cancels;                              //!< Pending events cancelled.
+    uint64_t m_peakSize;                             //!< Largest queue size.
+    std::array<uint64_t, HORIZON_BUCKETS> m_horizon; //!< Insertion horizon histogram.
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the inline functions declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+inline void
+SchedulerStats::RecordInsert(uint64_t delay, uint64_t size)
+{
+    m_inserts++;
+    m_horizon[std::bit_width(delay)]++;
+    if (size > m_peakSize)
+    {
+        m_peakSize = size;
+    }
+}
+
+inline void
+SchedulerStats::RecordRemoveNext(bool cancelled)
+{
+    m_removeNexts++;
+    if (cancelled)
+    {
+        m_cancelledRemoveNexts++;
+    }
+}
+
+inline void
+SchedulerStats::RecordRemove()
+{
+    m_removes++;
+}
+
+inline void
+SchedulerStats::RecordCancel()
+{
+    m_cancels++;
+}
+
+} // namespace ns3
+
+#endif /* SCHEDULER_STATS_H */
@@ -0,0 +1,151 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulation-fork.h"
+
+#include "abort.h"
+#include "log.h"
+#include "rng-seed-manager.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#ifndef __WIN32__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationFork implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulationFork");
+
+namespace
+{
+/// The index of this copy
+int32_t g_copy = SimulationFork::PARENT;
+/// The number of copies of the last Fork which failed
+uint32_t g_failures = 0;
+} // namespace
+
+#ifndef __WIN32__
+
+/**
+ * Wait for a copy to exit.
+ * \returns true if the copy exited with a zero status
+ */
+static bool
+WaitCopy()
+{
+    int status;
+    pid_t pid;
+    do
+    {
+        pid = wait(&status);
+    } while (pid < 0 && errno == EINTR);
+    NS_ABORT_MSG_IF(pid < 0, "Unable to wait for the copies of the simulation");
+    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    NS_LOG_LOGIC("copy " << pid << " exited " << (ok ? "normally" : "with a failure"));
+    return ok;
+}
+
+int32_t
+SimulationFork::Fork(uint32_t nCopies, uint32_t maxRunning)
+{
+    NS_LOG_FUNCTION(nCopies << maxRunning);
+    NS_ABORT_MSG_IF(g_copy != PARENT, "Copies of the simulation can not fork");
+    if (maxRunning == 0)
+    {
+        maxRunning = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    // the buffered output would be written by each copy
+    std::cout.flush();
+    std::cerr.flush();
+    std::clog.flush();
+    std::fflush(nullptr);
+
+    g_failures = 0;
+    uint32_t running = 0;
+    for (uint32_t copy = 0; copy < nCopies; copy++)
+    {
+        if (running == maxRunning)
+        {
+            g_failures += WaitCopy() ? 0 : 1;
+            running--;
+        }
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "Unable to fork copy " << copy << " of the simulation");
+        if (pid == 0)
+        {
+            g_copy = copy;
+            return g_copy;
+        }
+        NS_LOG_LOGIC("copy " << copy << " is process " << pid);
+        running++;
+    }
+    for (; running > 0; running--)
+    {
+        g_failures += WaitCopy() ? 0 : 1;
+    }
+    return PARENT;
+}
+
+#else /* __WIN32__ */
+
+int32_t
+SimulationFork::Fork(uint32_t nCopies, uint32_t maxRunning)
+{
+    NS_FATAL_ERROR("SimulationFork is not supported on Windows");
+    return PARENT;
+}
+
+#endif /* __WIN32__ */
+
+int32_t
+SimulationFork::Replicate(uint32_t nReplications, uint32_t maxRunning)
+{
+    NS_LOG_FUNCTION(nReplications << maxRunning);
+    uint64_t run = RngSeedManager::GetRun();
+    int32_t replication = Fork(nReplications, maxRunning);
+    if (replication != PARENT)
+    {
+        RngSeedManager::SetRun(run + replication);
+    }
+    return replication;
+}
+
+int32_t
+SimulationFork::GetCopy()
+{
+    return g_copy;
+}
+
+uint32_t
+SimulationFork::GetFailures()
+{
+    return g_failures;
+}
+
+} // namespace ns3
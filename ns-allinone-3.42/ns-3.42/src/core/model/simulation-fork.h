@@ -0,0 +1,141 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SIMULATION_FORK_H
+#define SIMULATION_FORK_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulationFork declaration.
+ */
+
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Continue a simulation in several copies, from its current state.
+ *
+ * Sweeps often simulate the same warm-up period (association, routing or
+ * rate adaptation convergence...) in every run before the interval
+ * measured, which only differs by a few parameters. Instead, the
+ * simulation can be run once until the end of the warm-up, with
+ * Simulator::Stop and Simulator::Run, then copied: each copy applies its
+ * variation of the parameters and runs the measured interval.
+ *
+ * \code
+ *   Simulator::Stop(warmUp);
+ *   Simulator::Run();
+ *   int32_t copy = SimulationFork::Fork(nVariations);
+ *   if (copy == SimulationFork::PARENT)
+ *   {
+ *       return SimulationFork::GetFailures() == 0 ? 0 : 1;
+ *   }
+ *   ApplyVariation(copy);  // e.g. set attributes, open the output files
+ *   Simulator::Stop(measured);
+ *   Simulator::Run();
+ *   Simulator::Destroy();
+ *   return 0;
+ * \endcode
+ *
+ * The copies are child processes, forked from the process at the end of
+ * the warm-up: the whole state of the simulation, nodes, pending events,
+ * positions of the random variable streams and attribute values included,
+ * is copied, without being serialized (the memory is shared until written
+ * to). Each copy continues from Fork with the same random variable
+ * streams: the variations which need different random values create new
+ * streams, or set their stream numbers.
+ *
+ * The files already open are shared by the copies, which should open
+ * their output files after Fork, under names of their own.
+ *
+ * Independent replications of a simulation are forked the same way, with
+ * Replicate, once the data they share is loaded (spectrum models, error
+ * rate tables, building maps...), and before the random variables are
+ * created: each replication then builds its own scenario, with its own
+ * run number, while the shared data is held once in memory.
+ *
+ * \code
+ *   LoadSharedData();
+ *   int32_t replication = SimulationFork::Replicate(nReplications);
+ *   if (replication == SimulationFork::PARENT)
+ *   {
+ *       return SimulationFork::GetFailures() == 0 ? 0 : 1;
+ *   }
+ *   BuildScenario();  // e.g. create the nodes, open the output files
+ *   Simulator::Run();
+ *   Simulator::Destroy();
+ *   return 0;
+ * \endcode
+ *
+ * Only the
+ * thread calling Fork is copied: the simulator implementations and
+ * writers using threads, and MPI, can not be forked. This is only
+ * available on POSIX systems.
+ */
+class SimulationFork
+{
+  public:
+    /// The value returned by Fork in the parent process
+    static constexpr int32_t PARENT = -1;
+
+    /**
+     * \brief Fork copies of the simulation.
+     *
+     * The parent process runs at most maxRunning copies at the same time,
+     * and returns once all of them exited.
+     *
+     * \param [in] nCopies The number of copies.
+     * \param [in] maxRunning The maximum number of copies running at the
+     *             same time, 0 for the number of processors.
+     * \returns In each copy, its index in [0, nCopies); in the parent, PARENT.
+     */
+    static int32_t Fork(uint32_t nCopies, uint32_t maxRunning = 0);
+
+    /**
+     * \brief Fork independent replications of the simulation.
+     *
+     * As Fork, but replication i uses the run number of the parent plus i
+     * (see RngSeedManager::SetRun), for the random variables created
+     * after this call. The results of each replication only depend on its
+     * index, not on the number of replications or their order.
+     *
+     * \param [in] nReplications The number of replications.
+     * \param [in] maxRunning The maximum number of replications running at
+     *             the same time, 0 for the number of processors.
+     * \returns In each replication, its index in [0, nReplications); in the
+     *          parent, PARENT.
+     */
+    static int32_t Replicate(uint32_t nReplications, uint32_t maxRunning = 0);
+
+    /**
+     * \returns The index of this copy, or PARENT if this process is not a copy.
+     */
+    static int32_t GetCopy();
+
+    /**
+     * \returns The number of copies of the last Fork which did not exit
+     *          with a zero status.
+     */
+    static uint32_t GetFailures();
+};
+
+} // namespace ns3
+
+#endif /* SIMULATION_FORK_H */
@@ -0,0 +1,370 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SimulationTelemetry implementation.
+ */
+
+#include "simulation-telemetry.h"
+
+#include "assert.h"
+#include "environment-variable.h"
+#include "fatal-error.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulationTelemetry");
+
+namespace
+{
+
+/**
+ * Get the counters added to the records.
+ * \returns The counters, by name.
+ */
+std::map<std::string, Callback<double>>&
+GetCounters()
+{
+    static std::map<std::string, Callback<double>> counters;
+    return counters;
+}
+
+/** The telemetry requested by the \c NS_TELEMETRY environment variable. */
+struct Requested
+{
+    std::ofstream file;                      //!< The output file, if any.
+    SimulationTelemetry* telemetry{nullptr}; //!< The telemetry, never deleted.
+    bool destroyed{false};                   //!< Whether the simulator was destroyed.
+};
+
+/**
+ * Get the telemetry requested by the \c NS_TELEMETRY environment variable.
+ * \returns The requested telemetry.
+ */
+Requested&
+GetRequested()
+{
+    static auto requested = new Requested;
+    return *requested;
+}
+
+/** Note that the simulator of the requested telemetry was destroyed. */
+void
+RequestedDestroyed()
+{
+    GetRequested().destroyed = true;
+}
+
+/**
+ * Write a number in a record.
+ * \param [in,out] os The output stream.
+ * \param [in] value The number.
+ */
+void
+WriteNumber(std::ostream& os, double value)
+{
+    if (std::isfinite(value))
+    {
+        os << value;
+    }
+    else
+    {
+        os << "null";
+    }
+}
+
+/**
+ * Write a string in a record.
+ * \param [in,out] os The output stream.
+ * \param [in] value The string.
+ */
+void
+WriteString(std::ostream& os, const std::string& value)
+{
+    os << '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+} // unnamed namespace
+
+SimulationTelemetry::SimulationTelemetry(const Time interval /* = Seconds (10) */,
+                                         std::ostream& os /* = std::clog */)
+    : m_interval(interval),
+      m_os(&os),
+      m_final(false)
+{
+    NS_LOG_FUNCTION(this << interval);
+    NS_ASSERT_MSG(interval.IsStrictlyPositive(), "The telemetry interval must be positive");
+    Start();
+    m_destroyEvent = Simulator::ScheduleDestroy(&SimulationTelemetry::Report, this, true);
+}
+
+SimulationTelemetry::~SimulationTelemetry()
+{
+    NS_LOG_FUNCTION(this);
+    // Once the final record is written from Simulator::Destroy(),
+    // the simulator is not used any more
+    if (!m_final)
+    {
+        Report(true);
+        m_destroyEvent.Cancel();
+    }
+}
+
+void
+SimulationTelemetry::SetInterval(const Time interval)
+{
+    NS_LOG_FUNCTION(this << interval);
+    NS_ASSERT_MSG(interval.IsStrictlyPositive(), "The telemetry interval must be positive");
+    m_interval = interval;
+}
+
+void
+SimulationTelemetry::SetStream(std::ostream& os)
+{
+    m_os = &os;
+}
+
+void
+SimulationTelemetry::Start()
+{
+    NS_LOG_FUNCTION(this);
+    m_start = Clock::now();
+    m_check = m_start;
+    m_report = m_start;
+    m_startTime = Simulator::Now();
+    m_reportTime = m_startTime;
+    m_reportEvents = Simulator::GetEventCount();
+    m_step = TimeStep(1);
+    m_final = false;
+    ScheduleCheck();
+}
+
+void
+SimulationTelemetry::ScheduleCheck()
+{
+    m_event = Simulator::Schedule(m_step, &SimulationTelemetry::Check, this);
+}
+
+void
+SimulationTelemetry::Check()
+{
+    auto now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - m_check).count();
+    m_check = now;
+
+    // Aim at two checks per interval, changing the step by a factor of
+    // two at most, as the speed of the simulation changes
+    double target = m_interval.GetSeconds() / 2;
+    double factor = elapsed > 0 ? std::clamp(target / elapsed, 0.5, 2.0) : 2.0;
+    m_step = std::max(m_step * int64x64_t(factor), TimeStep(1));
+
+    if (std::chrono::duration<double>(now - m_report).count() >= m_interval.GetSeconds())
+    {
+        Report();
+    }
+
+    // The check itself is not in the event list any more: stop
+    // when there is nothing else to simulate
+    if (!Simulator::IsFinished())
+    {
+        ScheduleCheck();
+    }
+}
+
+void
+SimulationTelemetry::Report(bool final /* = false */)
+{
+    NS_LOG_FUNCTION(this << final);
+    auto now = Clock::now();
+    double wall = std::chrono::duration<double>(now - m_start).count();
+    double interval = std::chrono::duration<double>(now - m_report).count();
+    Time time = Simulator::Now();
+    uint64_t events = Simulator::GetEventCount();
+
+    double eventRate = 0;
+    double speed = 0;
+    if (interval > 0)
+    {
+        eventRate = (events - m_reportEvents) / interval;
+        speed = (time - m_reportTime).GetSeconds() / interval;
+    }
+    double eta = NAN;
+    EventId stop = Simulator::GetStopEvent();
+    double averageSpeed = wall > 0 ? (time - m_startTime).GetSeconds() / wall : 0;
+    if (!stop.IsExpired() && averageSpeed > 0)
+    {
+        eta = Simulator::GetDelayLeft(stop).GetSeconds() / averageSpeed;
+    }
+    int64_t rss = GetResidentMemory();
+
+    std::ostringstream record;
+    record << std::fixed << std::setprecision(3) << "{\"wall\":" << wall << ",\"time\":"
+           << std::setprecision(9) << time.GetSeconds() << ",\"events\":" << events
+           << std::setprecision(1) << ",\"eventRate\":" << eventRate << std::setprecision(3)
+           << ",\"speed\":";
+    WriteNumber(record, speed);
+    record << std::setprecision(1) << ",\"eta\":";
+    WriteNumber(record, eta);
+    record << ",\"rss\":";
+    if (rss >= 0)
+    {
+        record << rss;
+    }
+    else
+    {
+        record << "null";
+    }
+    record << ",\"counters\":{" << std::defaultfloat << std::setprecision(15);
+    bool first = true;
+    for (auto& [name, counter] : GetCounters())
+    {
+        record << (first ? "" : ",");
+        WriteString(record, name);
+        record << ':';
+        WriteNumber(record, counter());
+        first = false;
+    }
+    record << '}' << (final ? ",\"final\":true" : "") << '}';
+    (*m_os) << record.str() << std::endl;
+
+    m_report = now;
+    m_reportTime = time;
+    m_reportEvents = events;
+    if (final)
+    {
+        m_final = true;
+    }
+}
+
+/* static */
+void
+SimulationTelemetry::RegisterCounter(const std::string& name, Callback<double> counter)
+{
+    NS_LOG_FUNCTION(name);
+    GetCounters()[name] = counter;
+}
+
+/* static */
+void
+SimulationTelemetry::UnregisterCounter(const std::string& name)
+{
+    NS_LOG_FUNCTION(name);
+    GetCounters().erase(name);
+}
+
+/* static */
+int64_t
+SimulationTelemetry::GetResidentMemory()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0;
+    int64_t resident = 0;
+    if (statm >> size >> resident)
+    {
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return -1;
+}
+
+/* static */
+void
+SimulationTelemetry::StartRequested()
+{
+    auto [found, value] = EnvironmentVariable::Get("NS_TELEMETRY");
+    if (!found)
+    {
+        return;
+    }
+    auto& requested = GetRequested();
+    if (requested.telemetry == nullptr)
+    {
+        NS_LOG_FUNCTION_NOARGS();
+        std::ostream* os = &std::clog;
+        auto [fileFound, file] = EnvironmentVariable::Get("NS_TELEMETRY", "file");
+        if (fileFound && !file.empty())
+        {
+            requested.file.open(file, std::ios::app);
+            if (!requested.file)
+            {
+                NS_FATAL_ERROR("Cannot open the NS_TELEMETRY file " << file);
+            }
+            os = &requested.file;
+        }
+        Time interval = Seconds(10);
+        auto [intervalFound, seconds] = EnvironmentVariable::Get("NS_TELEMETRY", "interval");
+        if (intervalFound && !seconds.empty())
+        {
+            interval = Seconds(std::stod(seconds));
+        }
+        requested.telemetry = new SimulationTelemetry(interval, *os);
+        // The record of the end of each run is written by StopRequested()
+        requested.telemetry->m_destroyEvent.Cancel();
+        Simulator::ScheduleDestroy(&RequestedDestroyed);
+    }
+    else if (requested.destroyed)
+    {
+        // A new simulation: the events of the previous one are gone
+        requested.destroyed = false;
+        requested.telemetry->m_event = EventId();
+        requested.telemetry->Start();
+        Simulator::ScheduleDestroy(&RequestedDestroyed);
+    }
+    else
+    {
+        // The same simulation, run again after Simulator::Stop()
+        requested.telemetry->m_event.Cancel();
+        requested.telemetry->ScheduleCheck();
+    }
+}
+
+/* static */
+void
+SimulationTelemetry::StopRequested()
+{
+    auto& requested = GetRequested();
+    if (requested.telemetry != nullptr)
+    {
+        requested.telemetry->Report(true);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,187 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SIMULATION_TELEMETRY_H
+#define SIMULATION_TELEMETRY_H
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::SimulationTelemetry declaration.
+ */
+
+#include "callback.h"
+#include "event-id.h"
+#include "nstime.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ *
+ * Periodically write a machine-readable record of the simulation progress.
+ *
+ * Each record is a JSON object on its own line, written at about every
+ * \c interval of wall clock time, like ShowProgress does for humans:
+ *
+ * \code
+ *     {"wall":10.002,"time":1.503000000,"events":2710033,"eventRate":270952.1,
+ *      "speed":0.150,"eta":56.5,"rss":48377856,"counters":{"uplinks":2311}}
+ * \endcode
+ *
+ * (on one line), with:
+ *
+ *   - \c wall: the wall clock time since the telemetry started, in seconds;
+ *   - \c time: the simulation time, in seconds;
+ *   - \c events: the number of events executed, from Simulator::GetEventCount();
+ *   - \c eventRate: the events executed per wall clock second since the
+ *     previous record;
+ *   - \c speed: the simulation seconds per wall clock second since the
+ *     previous record;
+ *   - \c eta: the wall clock seconds left until the Simulator::Stop() time,
+ *     at the average speed so far, or \c null if no stop time is set;
+ *   - \c rss: the resident memory of the process, in bytes, or \c null
+ *     where it is not known;
+ *   - \c counters: the values of the counters registered with
+ *     RegisterCounter(), e.g. by the models or the simulation script.
+ *
+ * The last record, written when the telemetry is destroyed or at the end
+ * of Simulator::Run() for the telemetry requested by the environment, also
+ * has \c "final":true.
+ *
+ * The records are only written from simulation events: a simulation whose
+ * time does not advance, or which is blocked, writes none, which is how a
+ * script driving many runs can tell it from a slow one.  The telemetry
+ * does not keep the simulation running once there is no other event,
+ * but its last check can run after the last other event, by less than
+ * the simulation time between two checks.
+ *
+ * The telemetry can also be requested without changing the program, by
+ * the \c NS_TELEMETRY environment variable:
+ *
+ * \code
+ *     NS_TELEMETRY="file=run-1.jsonl;interval=5" ./ns3 run my-sim
+ * \endcode
+ *
+ * which appends the records of each Simulator::Run() to the file, or
+ * writes them to \c std::clog without \c file.
+ */
+class SimulationTelemetry
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] interval The target wall clock interval between records,
+     *             which must be positive.
+     * \param [in] os The stream to write the records on.
+     */
+    SimulationTelemetry(const Time interval = Seconds(10), std::ostream& os = std::clog);
+
+    /** Destructor, which writes the final record. */
+    ~SimulationTelemetry();
+
+    /**
+     * Set the target wall clock interval between records.
+     * \param [in] interval The target wall clock interval, which must be
+     *             positive.
+     */
+    void SetInterval(const Time interval);
+
+    /**
+     * Set the stream to write the records on.
+     * \param [in] os The output stream.
+     */
+    void SetStream(std::ostream& os);
+
+    /**
+     * Write a record now.
+     * \param [in] final Whether this is the last record.
+     */
+    void Report(bool final = false);
+
+    /**
+     * Add a counter to the records of all the telemetries.
+     *
+     * \param [in] name The name of the counter in the records.
+     * \param [in] counter The function returning the value of the counter.
+     */
+    static void RegisterCounter(const std::string& name, Callback<double> counter);
+
+    /**
+     * Remove a counter from the records.
+     * \param [in] name The name of the counter.
+     */
+    static void UnregisterCounter(const std::string& name);
+
+    /**
+     * Start the telemetry requested by the \c NS_TELEMETRY environment
+     * variable, if any.  Called at the start of Simulator::Run().
+     */
+    static void StartRequested();
+
+    /**
+     * Write the final record of the telemetry requested by the
+     * \c NS_TELEMETRY environment variable, if any.  Called at the end
+     * of Simulator::Run().
+     */
+    static void StopRequested();
+
+  private:
+    /** The clock measuring the wall clock time. */
+    using Clock = std::chrono::steady_clock;
+
+    /** Start the records, from the current simulation time. */
+    void Start();
+
+    /** Schedule the next Check(). */
+    void ScheduleCheck();
+
+    /**
+     * Write a record if the interval has elapsed, and adapt the
+     * simulation time between the checks to the speed of the simulation.
+     */
+    void Check();
+
+    /**
+     * Get the resident memory of the process.
+     * \returns The resident memory in bytes, or -1 if it is not known.
+     */
+    static int64_t GetResidentMemory();
+
+    Time m_interval;             //!< The target wall clock interval.
+    std::ostream* m_os;          //!< The output stream.
+    EventId m_event;             //!< The next check.
+    EventId m_destroyEvent;      //!< The final record, from Simulator::Destroy().
+    bool m_final;                //!< Whether the final record was written.
+    Time m_step;                 //!< The simulation time between the checks.
+    Clock::time_point m_start;   //!< When the telemetry started.
+    Clock::time_point m_check;   //!< When the last check ran.
+    Clock::time_point m_report;  //!< When the last record was written.
+    Time m_startTime;            //!< The simulation time when the telemetry started.
+    Time m_reportTime;           //!< The simulation time of the last record.
+    uint64_t m_reportEvents;     //!< The event count of the last record.
+
+}; // class SimulationTelemetry
+
+} // namespace ns3
+
+#endif /* SIMULATION_TELEMETRY_H */
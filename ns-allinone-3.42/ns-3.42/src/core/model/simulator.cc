@@ -24,9 +24,11 @@
 #include "global-value.h"
 #include "log.h"
 #include "map-scheduler.h"
+#include "memory-accounting.h"
 #include "object-factory.h"
 #include "ptr.h"
 #include "scheduler.h"
+#include "simulation-telemetry.h"
 #include "simulator-impl.h"
 #include "string.h"
 
@@ -179,7 +181,10 @@ Simulator::Run()
 {
     NS_LOG_FUNCTION_NOARGS();
     Time::ClearMarkedTimes();
+    SimulationTelemetry::StartRequested();
     GetImpl()->Run();
+    SimulationTelemetry::StopRequested();
+    MemoryAccounting::PrintRequestedReport();
 }
 
 void
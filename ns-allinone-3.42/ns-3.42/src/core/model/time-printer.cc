@@ -24,6 +24,8 @@
 #include "simulator.h" // Now()
 
 #include <iomanip>
+#include <sstream>
+#include <string>
 
 /**
  * \file
@@ -36,11 +38,18 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("TimePrinter");
 
-void
-DefaultTimePrinter(std::ostream& os)
+namespace
 {
-    std::ios_base::fmtflags ff = os.flags(); // Save stream flags
-    std::streamsize oldPrecision = os.precision();
+
+/**
+ * Format the current simulation time as DefaultTimePrinter() prints it.
+ * \param [in] now The current simulation time.
+ * \returns The formatted time.
+ */
+std::string
+FormatTime(Time now)
+{
+    std::ostringstream os;
     os << std::fixed;
     switch (Time::GetResolution())
     {
@@ -61,10 +70,29 @@ DefaultTimePrinter(std::ostream& os)
         // default C++ precision of 5
         os << std::setprecision(5);
     }
-    os << Simulator::Now().As(Time::S);
+    os << now.As(Time::S);
+    return os.str();
+}
 
-    os << std::setprecision(oldPrecision);
-    os.flags(ff); // Restore stream flags
+} // unnamed namespace
+
+void
+DefaultTimePrinter(std::ostream& os)
+{
+    // Many messages are logged at the same time: keep the last formatted one
+    thread_local int64_t lastStep{0};
+    thread_local Time::Unit lastResolution{Time::GetResolution()};
+    thread_local std::string lastText;
+
+    Time now = Simulator::Now();
+    if (now.GetTimeStep() != lastStep || Time::GetResolution() != lastResolution ||
+        lastText.empty())
+    {
+        lastStep = now.GetTimeStep();
+        lastResolution = Time::GetResolution();
+        lastText = FormatTime(now);
+    }
+    os << lastText;
 }
 
 } // namespace ns3
@@ -253,6 +253,7 @@ Time::SetResolution(Unit unit, Resolution* resolution, const bool convert /* = t
             NS_LOG_DEBUG("SetResolution for unit " << (int)unit << " loop iteration " << i
                                                    << " marked as INVALID");
             info->isValid = false;
+            info->exactFactor = false;
             continue;
         }
         auto factor = static_cast<int64_t>(std::pow(10, std::fabs(shift)) * quotient);
@@ -260,6 +261,14 @@ Time::SetResolution(Unit unit, Resolution* resolution, const bool convert /* = t
                             UNIT_COEFF[(int)unit];
         NS_LOG_DEBUG("SetResolution factor " << factor << " real factor " << realFactor);
         info->factor = factor;
+        // For the double conversions without int64x64_t arithmetic
+        info->realFactor = static_cast<double>(factor);
+        info->exactFactor =
+            info->realFactor < 0x1p63 && static_cast<int64_t>(info->realFactor) == factor;
+        // Split in two halves of 26 bits, for Time::RoundProduct()
+        double c = 134217729.0 * info->realFactor;
+        info->factorHi = c - (c - info->realFactor);
+        info->factorLo = info->realFactor - info->factorHi;
         // here we could equivalently check for realFactor == 1.0 but it's better
         // to avoid checking equality of doubles
         if (shift == 0 && quotient == 1)
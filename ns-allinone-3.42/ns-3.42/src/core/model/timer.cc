@@ -93,6 +93,10 @@ Timer::GetDelayLeft() const
     switch (GetState())
     {
     case Timer::RUNNING:
+        if (m_flags & TIMER_RESTARTED)
+        {
+            return m_end - Simulator::Now();
+        }
         return Simulator::GetDelayLeft(m_event);
     case Timer::EXPIRED:
         return TimeStep(0);
@@ -174,15 +178,56 @@ Timer::Schedule(Time delay)
     {
         NS_FATAL_ERROR("Event is still running while re-scheduling.");
     }
+    m_flags &= ~TIMER_RESTARTED;
     m_event = m_impl->Schedule(delay);
 }
 
+void
+Timer::Restart()
+{
+    NS_LOG_FUNCTION(this);
+    Restart(m_delay);
+}
+
+void
+Timer::Restart(Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    NS_ASSERT(m_impl != nullptr);
+    NS_ASSERT(!IsSuspended());
+    Time end = Simulator::Now() + delay;
+    if ((m_flags & TIMER_RESTARTED) && m_event.IsPending() && TimeStep(m_event.GetTs()) <= end)
+    {
+        // Expire() schedules the event again for the time left
+        m_end = end;
+        return;
+    }
+    m_event.Cancel();
+    m_end = end;
+    m_flags |= TIMER_RESTARTED;
+    m_event = Simulator::Schedule(delay, &Timer::Expire, this);
+}
+
+void
+Timer::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_end > Simulator::Now())
+    {
+        m_event = Simulator::Schedule(m_end - Simulator::Now(), &Timer::Expire, this);
+        return;
+    }
+    m_flags &= ~TIMER_RESTARTED;
+    m_impl->Invoke();
+}
+
 void
 Timer::Suspend()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(IsRunning());
-    m_delayLeft = Simulator::GetDelayLeft(m_event);
+    m_delayLeft = GetDelayLeft();
+    m_flags &= ~TIMER_RESTARTED;
     if (m_flags & CANCEL_ON_DESTROY)
     {
         m_event.Cancel();
@@ -65,8 +65,9 @@ class TimerImpl;
  * when the delay expires.
  *
  * A Timer can be suspended, resumed, cancelled and queried for the
- * time left, but it can't be extended (except by suspending and
- * resuming).
+ * time left.  It can be extended with Restart(), which is cheap when
+ * the timer is restarted often to expire later, as a retransmission or
+ * inactivity timeout is.
  *
  * A timer can also be used to enforce a set of predefined event lifetime
  * management policies. These policies are specified at construction time
@@ -216,6 +217,29 @@ class Timer
      */
     void Schedule(Time delay);
 
+    /**
+     * Restart the timer to expire after the currently-configured delay,
+     * whether it is running or not.
+     */
+    void Restart();
+    /**
+     * \param [in] delay the delay to use
+     *
+     * Restart the timer to expire after the specified delay (ignore the
+     * delay set by Timer::SetDelay), whether it is running or not.
+     *
+     * When the timer is running and expires no later than the new
+     * expiration time, its event is kept in the simulation event-list
+     * and, when it fires, is scheduled again for the time left, as a
+     * Watchdog does.  A timer restarted many times before expiring thus
+     * costs a single event, instead of a cancelled event per Cancel() and
+     * Schedule().  The Timer must not be moved while running after
+     * Restart().
+     *
+     * Calling Restart on a suspended timer is an error.
+     */
+    void Restart(Time delay);
+
     /**
      * Pause the timer and save the amount of time left until it was
      * set to expire.
@@ -239,12 +263,21 @@ class Timer
   private:
     /** Internal bit marking the suspended timer state */
     static constexpr auto TIMER_SUSPENDED{1 << 7};
+    /** Internal bit marking a running timer scheduled by Restart() */
+    static constexpr auto TIMER_RESTARTED{1 << 8};
+
+    /**
+     * Invoke the function if the timer scheduled by Restart() is due,
+     * or schedule it again for the time left.
+     */
+    void Expire();
 
     /**
      * Bitfield for Timer State, DestroyPolicy and InternalSuspended.
      *
      * \internal
-     * The DestroyPolicy, State and InternalSuspended state are stored
+     * The DestroyPolicy, State, InternalSuspended and InternalRestarted
+     * state are stored
      * in this single bitfield.  The State uses the low-order bits,
      * so the other users of the bitfield have to be careful in defining
      * their bits to avoid the State.
@@ -261,6 +294,8 @@ class Timer
     internal::TimerImpl* m_impl;
     /** The amount of time left on the Timer while it is suspended. */
     Time m_delayLeft;
+    /** The expiration time of the Timer scheduled by Restart(). */
+    Time m_end;
 };
 
 } // namespace ns3
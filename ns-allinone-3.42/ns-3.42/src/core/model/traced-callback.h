@@ -22,7 +22,9 @@
 
 #include "callback.h"
 
-#include <list>
+#include "ns3/core-config.h"
+
+#include <vector>
 
 /**
  * \file
@@ -47,6 +49,18 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * When the arguments are expensive to build, guard the call with
+ * IsEmpty(), so that nothing is computed while no sink is connected:
+ * \code
+ *   if (!m_rxTrace.IsEmpty())
+ *   {
+ *       m_rxTrace(packet->Copy(), ComputeSnr());
+ *   }
+ * \endcode
+ * When ns-3 is configured with tracing disabled (\c NS3_TRACING=OFF),
+ * the sinks are still accepted but never invoked, and IsEmpty() is
+ * always \c true, so that such guarded calls compile to nothing.
+ *
  * \tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -92,7 +106,8 @@ class TracedCallback
     void operator()(Ts... args) const;
     /**
      * \brief Checks if the Callbacks list is empty.
-     * \return true if the Callbacks list is empty.
+     * \return true if the Callbacks list is empty, or if tracing is
+     *         disabled in this build.
      */
     bool IsEmpty() const;
 
@@ -111,9 +126,12 @@ class TracedCallback
     /**
      * Container type for holding the chain of Callbacks.
      *
+     * The chain is kept contiguous, as it is walked every time the trace
+     * source fires but rarely modified.
+     *
      * \tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
     /** The chain of Callbacks. */
     CallbackList m_callbackList;
 };
@@ -162,17 +180,9 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
-    {
-        if ((*i).IsEqual(callback))
-        {
-            i = m_callbackList.erase(i);
-        }
-        else
-        {
-            i++;
-        }
-    }
+    std::erase_if(m_callbackList, [&callback](const Callback<void, Ts...>& cb) {
+        return cb.IsEqual(callback);
+    });
 }
 
 template <typename... Ts>
@@ -192,17 +202,27 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+#ifdef NS3_TRACING_DISABLE
+    ((void)args, ...);
+#else
+    // Index rather than iterate: a sink may connect further sinks, which
+    // reallocates the vector, and these are invoked as well.
+    for (std::size_t i = 0; i < m_callbackList.size(); i++)
     {
-        (*i)(args...);
+        m_callbackList[i](args...);
     }
+#endif
 }
 
 template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
+#ifdef NS3_TRACING_DISABLE
+    return true;
+#else
     return m_callbackList.empty();
+#endif
 }
 
 } // namespace ns3
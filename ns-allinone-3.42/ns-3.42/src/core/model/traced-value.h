@@ -231,11 +231,16 @@ class TracedValue
      * Set the value of the underlying variable.
      *
      * If the new value differs from the old, the Callback will be invoked.
+     * The comparison is skipped while no Callback is connected.
      * \param [in] v The new value.
      */
     void Set(const T& v)
     {
-        if (m_v != v)
+        if (m_cb.IsEmpty())
+        {
+            m_v = v;
+        }
+        else if (m_v != v)
         {
             m_cb(m_v, v);
             m_v = v;
@@ -222,6 +222,11 @@ class IidManager : public Singleton<IidManager>
      * \returns The number of attributes associated to this TypeId
      */
     std::size_t GetAttributeN(uint16_t uid) const;
+    /**
+     * Get the number of changes of the attributes of all the types.
+     * \returns The generation of the attributes.
+     */
+    uint64_t GetAttributeGeneration() const;
     /**
      * Get Attribute information by index.
      * \param [in] uid The id.
@@ -334,6 +339,9 @@ class IidManager : public Singleton<IidManager>
     /** The container of all type id records. */
     std::vector<IidInformation> m_information;
 
+    /** Incremented when an attribute is added or its initial value is changed. */
+    uint64_t m_attributeGeneration{1};
+
     /** Type of the by-name index. */
     typedef std::map<std::string, uint16_t> namemap_t;
     /** The by-name index. */
@@ -687,6 +695,7 @@ IidManager::AddAttribute(uint16_t uid,
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
     information->attributes.push_back(info);
+    m_attributeGeneration++;
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
 
@@ -699,6 +708,13 @@ IidManager::SetAttributeInitialValue(uint16_t uid,
     IidInformation* information = LookupInformation(uid);
     NS_ASSERT(i < information->attributes.size());
     information->attributes[i].initialValue = initialValue;
+    m_attributeGeneration++;
+}
+
+uint64_t
+IidManager::GetAttributeGeneration() const
+{
+    return m_attributeGeneration;
 }
 
 std::size_t
@@ -1081,6 +1097,12 @@ TypeId::SetAttributeInitialValue(std::size_t i, Ptr<const AttributeValue> initia
     return true;
 }
 
+uint64_t
+TypeId::GetAttributeGeneration()
+{
+    return IidManager::Get()->GetAttributeGeneration();
+}
+
 Callback<ObjectBase*>
 TypeId::GetConstructor() const
 {
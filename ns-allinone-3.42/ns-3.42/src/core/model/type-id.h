@@ -398,6 +398,18 @@ class TypeId
      */
     bool SetAttributeInitialValue(std::size_t i, Ptr<const AttributeValue> initialValue);
 
+    /**
+     * Get the generation of the attributes of all the types.
+     *
+     * The generation changes whenever an attribute is added to a type,
+     * or the initial value of an attribute is changed, e.g. by
+     * Config::SetDefault. The caches of attribute information compare
+     * it to detect that they are stale.
+     *
+     * \returns The generation of the attributes.
+     */
+    static uint64_t GetAttributeGeneration();
+
     /**
      * Record in this TypeId the fact that a new attribute exists.
      *
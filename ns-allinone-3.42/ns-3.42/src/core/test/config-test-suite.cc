@@ -864,6 +864,106 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Check that a CompiledPath resolves like the equivalent path string,
+ * including when it is reused after the object hierarchy changed.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CompiledPathConfigTestCase();
+
+    /** Destructor. */
+    ~CompiledPathConfigTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase()
+    : TestCase("Check that compiled paths match the same objects as path strings")
+{
+}
+
+void
+CompiledPathConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+
+    std::vector<Ptr<ConfigTestObject>> objs;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        objs.push_back(CreateObject<ConfigTestObject>());
+        a->AddNodeA(objs.back());
+    }
+
+    //
+    // Explicit indices, ranges and wildcards must match the same objects,
+    // in the same (increasing index) order, with the same contexts.
+    //
+    for (const auto& path : {"/NodeA/NodesA/0",
+                             "/NodeA/NodesA/3|1",
+                             "/NodeA/NodesA/|2|0|",
+                             "/NodeA/NodesA/[1-2]|0",
+                             "/NodeA/NodesA/[0-9]",
+                             "/NodeA/NodesA/4",
+                             "/NodeA/NodesA/*",
+                             "/*/NodesA/1",
+                             "/NodeA/NodesA/1/"})
+    {
+        Config::MatchContainer expected = Config::LookupMatches(path);
+        Config::CompiledPath compiled(path);
+        Config::MatchContainer actual = compiled.LookupMatches();
+        NS_TEST_ASSERT_MSG_EQ(actual.GetN(), expected.GetN(), "Wrong match count for " << path);
+        for (std::size_t i = 0; i < actual.GetN() && i < expected.GetN(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(actual.Get(i), expected.Get(i), "Wrong match for " << path);
+            NS_TEST_ASSERT_MSG_EQ(actual.GetMatchedPath(i),
+                                  expected.GetMatchedPath(i),
+                                  "Wrong context for " << path);
+        }
+    }
+
+    Config::MatchContainer matches = Config::CompiledPath("/NodeA/NodesA/3|1").LookupMatches();
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 2, "Expected two matches");
+    NS_TEST_ASSERT_MSG_EQ(matches.Get(0), objs[1], "Matches are not sorted by index");
+    NS_TEST_ASSERT_MSG_EQ(matches.GetMatchedPath(0), "/NodeA/NodesA/1/", "Unexpected context");
+
+    //
+    // Reuse one compiled path, growing the vector in between.
+    //
+    Config::CompiledPath path("/NodeA/NodesA/[1-4]/A");
+    NS_TEST_ASSERT_MSG_EQ(path.GetPath(), "/NodeA/NodesA/[1-4]/A", "Path not kept");
+    path.Set(IntegerValue(-3));
+    objs[0]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 10, "Object Attribute \"A\" unexpectedly set");
+    objs[3]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), -3, "Object Attribute \"A\" not set as expected");
+
+    objs.push_back(CreateObject<ConfigTestObject>());
+    a->AddNodeA(objs.back());
+    path.Set(IntegerValue(-4));
+    objs[4]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), -4, "Compiled path did not see the new object");
+    objs[0]->GetAttribute("A", iv);
+    NS_TEST_ASSERT_MSG_EQ(iv.Get(), 10, "Object Attribute \"A\" unexpectedly set");
+
+    NS_TEST_ASSERT_MSG_EQ(Config::CompiledPath("/NodeA/NodesA/7/A").SetFailSafe(IntegerValue(1)),
+                          false,
+                          "Set on a missing index should fail");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +982,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new CompiledPathConfigTestCase);
 }
 
 /**
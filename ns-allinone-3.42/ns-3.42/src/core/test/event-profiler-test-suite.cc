@@ -0,0 +1,339 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-profiler.h"
+#include "ns3/make-event.h"
+#include "ns3/object.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup events
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-profiler-tests EventProfiler test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup event-profiler-tests
+ * An object whose method the events call.
+ */
+class ProfiledObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::tests::ProfiledObject").SetParent<Object>();
+        return tid;
+    }
+
+    /** Count a call. */
+    void Work()
+    {
+        m_calls++;
+    }
+
+    /** The number of calls. */
+    uint32_t m_calls{0};
+};
+
+/** Number of calls of ProfiledFunction(). */
+static uint32_t g_functionCalls = 0;
+
+/** Count a call. */
+static void
+ProfiledFunction()
+{
+    g_functionCalls++;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check the accounting of the events, by type, object and context.
+ */
+class EventProfilerEntriesTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerEntriesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerEntriesTestCase::EventProfilerEntriesTestCase()
+    : TestCase("Check the entries of the profile")
+{
+}
+
+void
+EventProfilerEntriesTestCase::DoRun()
+{
+    auto object = CreateObject<ProfiledObject>();
+    g_functionCalls = 0;
+    EventProfiler profiler(1);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        EventImpl* event = MakeEvent(&ProfiledObject::Work, object);
+        profiler.Invoke(event, 2);
+        event->Unref();
+    }
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        EventImpl* event = MakeEvent(&ProfiledFunction);
+        profiler.Invoke(event, Simulator::NO_CONTEXT);
+        event->Unref();
+    }
+    NS_TEST_ASSERT_MSG_EQ(object->m_calls, 3, "Events not run");
+    NS_TEST_ASSERT_MSG_EQ(g_functionCalls, 2, "Events not run");
+    NS_TEST_ASSERT_MSG_EQ(profiler.GetEventCount(), 5, "Wrong event count");
+
+    auto entries = profiler.GetEntries();
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 2, "Wrong number of entries");
+    bool foundMethod = false;
+    bool foundFunction = false;
+    for (const auto& entry : entries)
+    {
+        if (entry.context == 2)
+        {
+            foundMethod = true;
+            NS_TEST_EXPECT_MSG_EQ(entry.typeId, "ns3::tests::ProfiledObject", "Wrong TypeId");
+            NS_TEST_EXPECT_MSG_EQ(entry.samples, 3, "Wrong sample count");
+            NS_TEST_EXPECT_MSG_NE(entry.function.find("ProfiledObject"),
+                                  std::string::npos,
+                                  "Method not named: " << entry.function);
+        }
+        else
+        {
+            foundFunction = true;
+            NS_TEST_EXPECT_MSG_EQ(entry.context, Simulator::NO_CONTEXT, "Wrong context");
+            NS_TEST_EXPECT_MSG_EQ(entry.typeId, "", "Function given a TypeId");
+            NS_TEST_EXPECT_MSG_EQ(entry.samples, 2, "Wrong sample count");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(foundMethod, true, "No entry for the method");
+    NS_TEST_EXPECT_MSG_EQ(foundFunction, true, "No entry for the function");
+
+    std::ostringstream folded;
+    profiler.WriteFolded(folded);
+    NS_TEST_EXPECT_MSG_NE(folded.str().find("node 2;ns3::tests::ProfiledObject;"),
+                          std::string::npos,
+                          "Method missing from " << folded.str());
+    NS_TEST_EXPECT_MSG_NE(folded.str().find("no context;"),
+                          std::string::npos,
+                          "Function missing from " << folded.str());
+
+    profiler.Reset();
+    NS_TEST_EXPECT_MSG_EQ(profiler.GetEntries().size(), 0, "Entries left after Reset");
+    NS_TEST_EXPECT_MSG_EQ(profiler.GetEventCount(), 0, "Events left after Reset");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check that one event out of the period is sampled, and all are run.
+ */
+class EventProfilerPeriodTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerPeriodTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerPeriodTestCase::EventProfilerPeriodTestCase()
+    : TestCase("Check the sampling period")
+{
+}
+
+void
+EventProfilerPeriodTestCase::DoRun()
+{
+    g_functionCalls = 0;
+    EventProfiler profiler(4);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        EventImpl* event = MakeEvent(&ProfiledFunction);
+        profiler.Invoke(event, 0);
+        event->Unref();
+    }
+    NS_TEST_ASSERT_MSG_EQ(g_functionCalls, 10, "Events not run");
+    auto entries = profiler.GetEntries();
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 1, "Wrong number of entries");
+    NS_TEST_EXPECT_MSG_EQ(entries[0].samples, 2, "Wrong sample count");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check that a cancelled event is not sampled, even when its target
+ * object is gone, and that the next event is sampled instead.
+ */
+class EventProfilerCancelledTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerCancelledTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EventProfilerCancelledTestCase::EventProfilerCancelledTestCase()
+    : TestCase("Check that cancelled events are not sampled")
+{
+}
+
+void
+EventProfilerCancelledTestCase::DoRun()
+{
+    g_functionCalls = 0;
+    EventProfiler profiler(2);
+    EventImpl* first = MakeEvent(&ProfiledFunction);
+    profiler.Invoke(first, 0);
+    first->Unref();
+
+    // The event only keeps a raw pointer to its target, destroyed here
+    auto object = CreateObject<ProfiledObject>();
+    EventImpl* cancelled = MakeEvent(&ProfiledObject::Work, PeekPointer(object));
+    cancelled->Cancel();
+    object = nullptr;
+    profiler.Invoke(cancelled, 1);
+    cancelled->Unref();
+
+    EventImpl* next = MakeEvent(&ProfiledFunction);
+    profiler.Invoke(next, 2);
+    next->Unref();
+
+    NS_TEST_ASSERT_MSG_EQ(g_functionCalls, 2, "Events not run");
+    NS_TEST_ASSERT_MSG_EQ(profiler.GetEventCount(), 3, "Wrong event count");
+    auto entries = profiler.GetEntries();
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 1, "Wrong number of entries");
+    NS_TEST_EXPECT_MSG_EQ(entries[0].context, 2, "The event after the cancelled one not sampled");
+    NS_TEST_EXPECT_MSG_EQ(entries[0].samples, 1, "Wrong sample count");
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Check the profiling of a simulation run by DefaultSimulatorImpl.
+ */
+class EventProfilerSimulatorTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerSimulatorTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+EventProfilerSimulatorTestCase::EventProfilerSimulatorTestCase()
+    : TestCase("Check the profile of a simulation")
+{
+}
+
+void
+EventProfilerSimulatorTestCase::DoSetup()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ProfilePeriod", UintegerValue(1));
+    Simulator::Destroy();
+}
+
+void
+EventProfilerSimulatorTestCase::DoRun()
+{
+    auto object = CreateObject<ProfiledObject>();
+    for (uint32_t node = 0; node < 3; ++node)
+    {
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            Simulator::ScheduleWithContext(node, Seconds(i), &ProfiledObject::Work, object);
+        }
+    }
+    Simulator::Run();
+
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Not run by DefaultSimulatorImpl");
+    const EventProfiler* profiler = impl->GetProfiler();
+    NS_TEST_ASSERT_MSG_NE(profiler, nullptr, "No profiler");
+    NS_TEST_EXPECT_MSG_EQ(profiler->GetEventCount(), 12, "Wrong event count");
+    auto entries = profiler->GetEntries();
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 3, "Wrong number of entries");
+    for (const auto& entry : entries)
+    {
+        NS_TEST_EXPECT_MSG_EQ(entry.samples, 4, "Wrong sample count");
+        NS_TEST_EXPECT_MSG_EQ(entry.typeId, "ns3::tests::ProfiledObject", "Wrong TypeId");
+    }
+    Simulator::Destroy();
+}
+
+void
+EventProfilerSimulatorTestCase::DoTeardown()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ProfilePeriod", UintegerValue(0));
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    EventProfilerTestSuite();
+};
+
+EventProfilerTestSuite::EventProfilerTestSuite()
+    : TestSuite("event-profiler")
+{
+    AddTestCase(new EventProfilerEntriesTestCase());
+    AddTestCase(new EventProfilerPeriodTestCase());
+    AddTestCase(new EventProfilerCancelledTestCase());
+    AddTestCase(new EventProfilerSimulatorTestCase());
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -21,6 +21,7 @@
 #include "ns3/test.h"
 
 #include <iomanip>
+#include <set>
 #include <string>
 
 /**
@@ -437,6 +438,48 @@ IncrementalTestCase::DoRun()
     DoHash("FNV1a", Hasher(Create<Hash::Function::Fnv1a>()));
 }
 
+/**
+ * \ingroup hash-tests
+ * Test the hash of the fixed-size keys
+ */
+class HashMixTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    HashMixTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HashMixTestCase::HashMixTestCase()
+    : TestCase("HashMix and HashCombine")
+{
+}
+
+void
+HashMixTestCase::DoRun()
+{
+    // Reference values of the Murmur3 fmix64 finalizer
+    static_assert(HashMix(0) == 0);
+    static_assert(HashMix(1) == 0xb456bcfc34c2cb2cULL);
+    NS_TEST_EXPECT_MSG_EQ(HashMix(0x0102030405060708ULL),
+                          0xd1af0fbb4178c20eULL,
+                          "Wrong HashMix value");
+
+    // Consecutive keys land in different buckets of a power of two table
+    std::set<uint64_t> buckets;
+    for (uint64_t key = 0; key < 64; key++)
+    {
+        buckets.insert(HashMix(key << 16) & 0xff);
+    }
+    NS_TEST_EXPECT_MSG_GT(buckets.size(), 40, "Poorly spread low bits");
+
+    NS_TEST_EXPECT_MSG_NE(HashCombine(HashMix(1), 2),
+                          HashCombine(HashMix(2), 1),
+                          "HashCombine should depend on the order of the fields");
+}
+
 /**
  * \ingroup hash-tests
  * Hash functions test suite
@@ -457,6 +500,7 @@ HashTestSuite::HashTestSuite()
     AddTestCase(new IncrementalTestCase);
     AddTestCase(new Hash32FunctionPtrTestCase);
     AddTestCase(new Hash64FunctionPtrTestCase);
+    AddTestCase(new HashMixTestCase);
 }
 
 /**
@@ -0,0 +1,193 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/memory-accounting.h"
+#include "ns3/object.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup memory-accounting-tests
+ * MemoryAccounting test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup memory-accounting-tests MemoryAccounting test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup memory-accounting-tests
+ * An object to account for.
+ */
+class AccountedObject : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::tests::AccountedObject").SetParent<Object>();
+        return tid;
+    }
+
+    /** Some payload. */
+    uint8_t m_payload[100];
+};
+
+/**
+ * \ingroup memory-accounting-tests
+ * Check the accounting of the Objects by TypeId.
+ */
+class MemoryAccountingObjectTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MemoryAccountingObjectTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MemoryAccountingObjectTestCase::MemoryAccountingObjectTestCase()
+    : TestCase("Check the accounting of the Objects")
+{
+}
+
+void
+MemoryAccountingObjectTestCase::DoRun()
+{
+    const std::string name = "ns3::tests::AccountedObject";
+    const int64_t size = sizeof(AccountedObject);
+    bool wasEnabled = MemoryAccounting::IsEnabled();
+    auto before = MemoryAccounting::GetEntry(name);
+
+    MemoryAccounting::Enable();
+    auto first = CreateObject<AccountedObject>();
+    auto second = CreateObject<AccountedObject>();
+    auto entry = MemoryAccounting::GetEntry(name);
+    NS_TEST_EXPECT_MSG_EQ(entry.live, before.live + 2, "Wrong live count");
+    NS_TEST_EXPECT_MSG_EQ(entry.bytes, before.bytes + 2 * size, "Wrong live bytes");
+    NS_TEST_EXPECT_MSG_EQ(entry.allocations, before.allocations + 2, "Wrong allocation count");
+
+    first = nullptr;
+    entry = MemoryAccounting::GetEntry(name);
+    NS_TEST_EXPECT_MSG_EQ(entry.live, before.live + 1, "Deleted object still accounted for");
+    NS_TEST_EXPECT_MSG_EQ(entry.bytes, before.bytes + size, "Wrong live bytes");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(entry.peakBytes, before.bytes + 2 * size, "Wrong peak bytes");
+
+    // Objects accounted for are discounted even when accounting is disabled,
+    // and objects created then are not accounted for
+    MemoryAccounting::Disable();
+    auto third = CreateObject<AccountedObject>();
+    second = nullptr;
+    third = nullptr;
+    entry = MemoryAccounting::GetEntry(name);
+    NS_TEST_EXPECT_MSG_EQ(entry.live, before.live, "Wrong live count");
+    NS_TEST_EXPECT_MSG_EQ(entry.bytes, before.bytes, "Wrong live bytes");
+    NS_TEST_EXPECT_MSG_EQ(entry.allocations, before.allocations + 2, "Wrong allocation count");
+
+    if (wasEnabled)
+    {
+        MemoryAccounting::Enable();
+    }
+}
+
+/**
+ * \ingroup memory-accounting-tests
+ * Check the accounting of the named categories, and the report.
+ */
+class MemoryAccountingCategoryTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MemoryAccountingCategoryTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MemoryAccountingCategoryTestCase::MemoryAccountingCategoryTestCase()
+    : TestCase("Check the accounting of the categories")
+{
+}
+
+void
+MemoryAccountingCategoryTestCase::DoRun()
+{
+    const std::string name = "ns3::tests::AccountedCategory";
+    uint32_t category = MemoryAccounting::RegisterCategory(name);
+    NS_TEST_EXPECT_MSG_EQ(MemoryAccounting::RegisterCategory(name),
+                          category,
+                          "The same name should give the same category");
+    NS_TEST_EXPECT_MSG_EQ(MemoryAccounting::GetEntry(name).allocations,
+                          0,
+                          "Nothing accounted for yet");
+
+    MemoryAccounting::Allocate(category, 1000);
+    MemoryAccounting::Allocate(category, 500);
+    MemoryAccounting::Deallocate(category, 1000);
+    auto entry = MemoryAccounting::GetEntry(name);
+    NS_TEST_EXPECT_MSG_EQ(entry.live, 1, "Wrong live count");
+    NS_TEST_EXPECT_MSG_EQ(entry.bytes, 500, "Wrong live bytes");
+    NS_TEST_EXPECT_MSG_EQ(entry.peakBytes, 1500, "Wrong peak bytes");
+    NS_TEST_EXPECT_MSG_EQ(entry.allocations, 2, "Wrong allocation count");
+
+    std::ostringstream os;
+    MemoryAccounting::Print(os, 1000);
+    NS_TEST_EXPECT_MSG_NE(os.str().find(name), std::string::npos, "Category missing in report");
+
+    MemoryAccounting::Deallocate(category, 500);
+    NS_TEST_EXPECT_MSG_EQ(MemoryAccounting::GetEntry(name).bytes, 0, "Wrong live bytes");
+}
+
+/**
+ * \ingroup memory-accounting-tests
+ * MemoryAccounting test suite.
+ */
+class MemoryAccountingTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MemoryAccountingTestSuite();
+};
+
+MemoryAccountingTestSuite::MemoryAccountingTestSuite()
+    : TestSuite("memory-accounting")
+{
+    AddTestCase(new MemoryAccountingObjectTestCase());
+    AddTestCase(new MemoryAccountingCategoryTestCase());
+}
+
+/**
+ * \ingroup memory-accounting-tests
+ * MemoryAccountingTestSuite instance variable.
+ */
+static MemoryAccountingTestSuite g_memoryAccountingTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -18,8 +18,12 @@
  *          Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/assert.h"
+#include "ns3/config.h"
+#include "ns3/integer.h"
 #include "ns3/object-factory.h"
 #include "ns3/object.h"
+#include "ns3/pointer.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
 /**
@@ -158,10 +162,47 @@ class DerivedB : public BaseB
     }
 };
 
+/**
+ * \ingroup object-tests
+ * Class with attributes, created by a factory.
+ */
+class AttributesA : public BaseA
+{
+  public:
+    /**
+     * Register this type.
+     * \return The TypeId.
+     */
+    static ns3::TypeId GetTypeId()
+    {
+        static ns3::TypeId tid =
+            ns3::TypeId("ObjectTest:AttributesA")
+                .SetParent<BaseA>()
+                .SetGroupName("Core")
+                .HideFromDocumentation()
+                .AddConstructor<AttributesA>()
+                .AddAttribute("Value",
+                              "An integer",
+                              ns3::IntegerValue(1),
+                              ns3::MakeIntegerAccessor(&AttributesA::m_value),
+                              ns3::MakeIntegerChecker<int32_t>())
+                .AddAttribute("B",
+                              "An object",
+                              ns3::StringValue("ObjectTest:BaseB"),
+                              ns3::MakePointerAccessor(&AttributesA::m_b),
+                              ns3::MakePointerChecker<BaseB>());
+        return tid;
+    }
+
+    int32_t m_value;     //!< Integer attribute
+    ns3::Ptr<BaseB> m_b; //!< Object attribute
+};
+
 NS_OBJECT_ENSURE_REGISTERED(BaseA);
 NS_OBJECT_ENSURE_REGISTERED(DerivedA);
 NS_OBJECT_ENSURE_REGISTERED(BaseB);
 NS_OBJECT_ENSURE_REGISTERED(DerivedB);
+NS_OBJECT_ENSURE_REGISTERED(AttributesA);
 
 } // unnamed namespace
 
@@ -532,6 +573,78 @@ UnidirectionalAggregateObjectTestCase::DoRun()
                           "Can GetObject (through baseB) for BaseA Object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test repeated GetObject lookups stay right when the aggregation changes.
+ */
+class AggregateLookupTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateLookupTestCase();
+    /** Destructor. */
+    ~AggregateLookupTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+AggregateLookupTestCase::AggregateLookupTestCase()
+    : TestCase("Check repeated GetObject lookups across aggregations")
+{
+}
+
+AggregateLookupTestCase::~AggregateLookupTestCase()
+{
+}
+
+void
+AggregateLookupTestCase::DoRun()
+{
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    Ptr<BaseB> baseB = CreateObject<BaseB>();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+
+    //
+    // A failed lookup must not hide an Object aggregated later, whether
+    // bidirectionally or unidirectionally.
+    //
+    for (int i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), nullptr, "Unexpected BaseB Object");
+    }
+    baseA->AggregateObject(baseB);
+    for (int i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(),
+                              baseB,
+                              "Cannot GetObject (through baseA) for BaseB Object");
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseA>(),
+                              baseA,
+                              "Cannot GetObject (through baseB) for BaseA Object");
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(),
+                              nullptr,
+                              "Unexpected DerivedB Object");
+    }
+
+    baseA->UnidirectionalAggregateObject(derivedB);
+    for (int i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(),
+                              derivedB,
+                              "Cannot GetObject (through baseA) for DerivedB Object");
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(),
+                              baseB,
+                              "Aggregated BaseB Object not preferred");
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<DerivedB>(),
+                              nullptr,
+                              "Unidirectional aggregate visible through baseB");
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseA>(BaseA::GetTypeId()),
+                              baseA,
+                              "Cannot GetObject by TypeId for BaseA Object");
+    }
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -617,6 +730,56 @@ ObjectFactoryTestCase::DoRun()
                           "Unexpectedly able to work around C++ type system");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the attributes set by an Object factory on the Objects it creates
+ */
+class ObjectFactoryAttributesTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ObjectFactoryAttributesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ObjectFactoryAttributesTestCase::ObjectFactoryAttributesTestCase()
+    : TestCase("Check the attributes set by ObjectFactory")
+{
+}
+
+void
+ObjectFactoryAttributesTestCase::DoRun()
+{
+    ObjectFactory factory("ObjectTest:AttributesA");
+    Ptr<AttributesA> a1 = factory.Create<AttributesA>();
+    Ptr<AttributesA> a2 = factory.Create<AttributesA>();
+    NS_TEST_ASSERT_MSG_EQ(a1->m_value, 1, "Initial value not set");
+    NS_TEST_ASSERT_MSG_EQ(a2->m_value, 1, "Initial value not set");
+    NS_TEST_ASSERT_MSG_NE(a1->m_b, nullptr, "Object not created from a string");
+    NS_TEST_ASSERT_MSG_NE(a1->m_b, a2->m_b, "Objects created from a string are shared");
+
+    // the factory sees the new initial values
+    Config::SetDefault("ObjectTest:AttributesA::Value", IntegerValue(2));
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<AttributesA>()->m_value, 2, "Initial value not updated");
+    Config::SetDefault("ObjectTest:AttributesA::Value", IntegerValue(1));
+
+    // the values of the factory are converted, once
+    factory.Set("Value", StringValue("3"));
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<AttributesA>()->m_value, 3, "Value not set");
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<AttributesA>()->m_value, 3, "Value not set");
+    Ptr<BaseB> b = CreateObject<BaseB>();
+    factory.Set("B", PointerValue(b));
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<AttributesA>()->m_b, b, "Object not set");
+
+    // a different type, set by name, gets its own values
+    factory.SetTypeId("ObjectTest:DerivedA");
+    NS_TEST_ASSERT_MSG_NE(factory.Create<DerivedA>(), nullptr, "Unable to create a DerivedA");
+    factory.SetTypeId("ObjectTest:AttributesA");
+    NS_TEST_ASSERT_MSG_EQ(factory.Create<AttributesA>()->m_value, 3, "Value lost");
+}
+
 /**
  * \ingroup object-tests
  * The Test Suite that glues the Test Cases together.
@@ -634,7 +797,9 @@ ObjectTestSuite::ObjectTestSuite()
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
+    AddTestCase(new AggregateLookupTestCase);
     AddTestCase(new ObjectFactoryTestCase);
+    AddTestCase(new ObjectFactoryAttributesTestCase);
 }
 
 /**
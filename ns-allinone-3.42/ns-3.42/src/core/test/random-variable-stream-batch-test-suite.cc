@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup rng-tests
+ * Test for the batched random variable stream API.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup rng-tests
+ * Check that GetValues() and GetIntegers() return the same sequence as
+ * repeated GetValue() and GetInteger() calls.
+ */
+class RandomVariableStreamBatchTestCase : public TestCase
+{
+  public:
+    RandomVariableStreamBatchTestCase();
+    ~RandomVariableStreamBatchTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Compare the two APIs on two streams created by \p factory.
+     * \param [in] factory The factory of the random variables.
+     */
+    void Check(ObjectFactory factory);
+};
+
+RandomVariableStreamBatchTestCase::RandomVariableStreamBatchTestCase()
+    : TestCase("GetValues() and GetIntegers() match GetValue() and GetInteger()")
+{
+}
+
+RandomVariableStreamBatchTestCase::~RandomVariableStreamBatchTestCase()
+{
+}
+
+void
+RandomVariableStreamBatchTestCase::Check(ObjectFactory factory)
+{
+    for (bool antithetic : {false, true})
+    {
+        factory.Set("Antithetic", BooleanValue(antithetic));
+        std::string name = factory.GetTypeId().GetName() + (antithetic ? " (antithetic)" : "");
+
+        Ptr<RandomVariableStream> one = factory.Create<RandomVariableStream>();
+        Ptr<RandomVariableStream> batch = factory.Create<RandomVariableStream>();
+        one->SetStream(17);
+        batch->SetStream(17);
+
+        // Batches of various sizes, interleaved with single draws on
+        // the batched stream too.
+        for (std::size_t size : {0, 1, 7, 64, 65, 300})
+        {
+            std::vector<double> values(size);
+            batch->GetValues(values);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                NS_TEST_ASSERT_MSG_EQ(values[i], one->GetValue(), name << " value " << i);
+            }
+            NS_TEST_ASSERT_MSG_EQ(batch->GetValue(), one->GetValue(), name << " single value");
+
+            std::vector<uint32_t> integers(size);
+            batch->GetIntegers(integers);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                NS_TEST_ASSERT_MSG_EQ(integers[i], one->GetInteger(), name << " integer " << i);
+            }
+            NS_TEST_ASSERT_MSG_EQ(batch->GetInteger(),
+                                  one->GetInteger(),
+                                  name << " single integer");
+        }
+    }
+}
+
+void
+RandomVariableStreamBatchTestCase::DoRun()
+{
+    Check(ObjectFactory("ns3::UniformRandomVariable", "Min", DoubleValue(2), "Max", DoubleValue(9)));
+    Check(ObjectFactory("ns3::ConstantRandomVariable", "Constant", DoubleValue(3)));
+    // The bounds below reject a good share of the draws.
+    Check(ObjectFactory("ns3::ExponentialRandomVariable",
+                        "Mean",
+                        DoubleValue(3),
+                        "Bound",
+                        DoubleValue(2)));
+    Check(ObjectFactory("ns3::ParetoRandomVariable",
+                        "Scale",
+                        DoubleValue(1),
+                        "Shape",
+                        DoubleValue(2),
+                        "Bound",
+                        DoubleValue(1.5)));
+    Check(ObjectFactory("ns3::WeibullRandomVariable",
+                        "Scale",
+                        DoubleValue(2),
+                        "Shape",
+                        DoubleValue(1.5),
+                        "Bound",
+                        DoubleValue(2)));
+    Check(ObjectFactory("ns3::NormalRandomVariable",
+                        "Mean",
+                        DoubleValue(5),
+                        "Variance",
+                        DoubleValue(4),
+                        "Bound",
+                        DoubleValue(3)));
+    // Uses the base class implementation.
+    Check(ObjectFactory("ns3::LogNormalRandomVariable"));
+}
+
+/**
+ * \ingroup rng-tests
+ * Test suite for the batched random variable stream API.
+ */
+class RandomVariableStreamBatchTestSuite : public TestSuite
+{
+  public:
+    RandomVariableStreamBatchTestSuite();
+};
+
+RandomVariableStreamBatchTestSuite::RandomVariableStreamBatchTestSuite()
+    : TestSuite("random-variable-stream-batch", Type::UNIT)
+{
+    AddTestCase(new RandomVariableStreamBatchTestCase);
+}
+
+/**
+ * \ingroup rng-tests
+ * RandomVariableStreamBatchTestSuite instance variable.
+ */
+static RandomVariableStreamBatchTestSuite g_randomVariableStreamBatchTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,214 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/scheduler-stats.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup scheduler-stats-tests
+ * SchedulerStats test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup scheduler-stats-tests SchedulerStats test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup scheduler-stats-tests
+ * Check the counters and the horizon histogram.
+ */
+class SchedulerStatsCountersTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SchedulerStatsCountersTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SchedulerStatsCountersTestCase::SchedulerStatsCountersTestCase()
+    : TestCase("Check the counters of the statistics")
+{
+}
+
+void
+SchedulerStatsCountersTestCase::DoRun()
+{
+    SchedulerStats stats;
+    stats.RecordInsert(0, 1);
+    stats.RecordInsert(1, 2);
+    stats.RecordInsert(3, 3);
+    stats.RecordInsert(1000, 2);
+    stats.RecordCancel();
+    stats.RecordCancel();
+    stats.RecordRemoveNext(false);
+    stats.RecordRemoveNext(true);
+    stats.RecordRemove();
+
+    NS_TEST_EXPECT_MSG_EQ(stats.GetInserts(), 4, "Wrong insert count");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetRemoveNexts(), 2, "Wrong remove next count");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetRemoves(), 1, "Wrong remove count");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetCancels(), 2, "Wrong cancel count");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetCancelledInQueue(), 1, "Wrong cancelled events in queue");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetCancelledRatio(), 0.5, "Wrong cancelled ratio");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetPeakSize(), 3, "Wrong peak size");
+
+    const auto& horizon = stats.GetHorizonHistogram();
+    NS_TEST_EXPECT_MSG_EQ(horizon[0], 1, "Wrong count of the events for now");
+    NS_TEST_EXPECT_MSG_EQ(horizon[1], 1, "Wrong count of the delays of 1");
+    NS_TEST_EXPECT_MSG_EQ(horizon[2], 1, "Wrong count of the delays in [2, 4)");
+    NS_TEST_EXPECT_MSG_EQ(horizon[10], 1, "Wrong count of the delays in [512, 1024)");
+
+    std::ostringstream os;
+    stats.Print(os);
+    NS_TEST_EXPECT_MSG_NE(os.str().find("4 events inserted"),
+                          std::string::npos,
+                          "Wrong report " << os.str());
+
+    stats.Reset();
+    NS_TEST_EXPECT_MSG_EQ(stats.GetInserts(), 0, "Not reset");
+    NS_TEST_EXPECT_MSG_EQ(stats.GetHorizonHistogram()[10], 0, "Not reset");
+}
+
+/**
+ * \ingroup scheduler-stats-tests
+ * Check the statistics of a simulation run by DefaultSimulatorImpl.
+ */
+class SchedulerStatsSimulatorTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SchedulerStatsSimulatorTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Record the size of the queue.
+     * \param [in] oldValue The previous size.
+     * \param [in] newValue The new size.
+     */
+    void QueueSize(int oldValue, int newValue);
+
+    /** The largest size of the queue traced. */
+    int m_peakSize{0};
+};
+
+SchedulerStatsSimulatorTestCase::SchedulerStatsSimulatorTestCase()
+    : TestCase("Check the statistics of a simulation")
+{
+}
+
+void
+SchedulerStatsSimulatorTestCase::DoSetup()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::SchedulerStats", BooleanValue(true));
+    Simulator::Destroy();
+}
+
+void
+SchedulerStatsSimulatorTestCase::QueueSize(int oldValue, int newValue)
+{
+    m_peakSize = std::max(m_peakSize, newValue);
+}
+
+void
+SchedulerStatsSimulatorTestCase::DoRun()
+{
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Not run by DefaultSimulatorImpl");
+    impl->TraceConnectWithoutContext(
+        "QueueSize",
+        MakeCallback(&SchedulerStatsSimulatorTestCase::QueueSize, this));
+
+    std::vector<EventId> events;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        events.push_back(Simulator::Schedule(Seconds(i), []() {}));
+    }
+    events[3].Cancel();
+    events[4].Cancel();
+    events[4].Cancel();
+    Simulator::Remove(events[5]);
+    NS_TEST_EXPECT_MSG_EQ(impl->GetQueueSize(), 9, "Wrong queue size");
+    Simulator::Run();
+
+    const SchedulerStats* stats = impl->GetSchedulerStats();
+    NS_TEST_ASSERT_MSG_NE(stats, nullptr, "No statistics");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetInserts(), 10, "Wrong insert count");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetRemoves(), 1, "Wrong remove count");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetCancels(), 2, "Wrong cancel count");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetRemoveNexts(), 9, "Wrong remove next count");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetCancelledInQueue(), 0, "Cancelled events left in queue");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetPeakSize(), 10, "Wrong peak size");
+    NS_TEST_EXPECT_MSG_EQ(m_peakSize, 10, "Wrong peak size traced");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetQueueSize(), 0, "Wrong queue size");
+    NS_TEST_EXPECT_MSG_EQ(stats->GetHorizonHistogram()[0], 1, "Wrong count of the events for now");
+    Simulator::Destroy();
+}
+
+void
+SchedulerStatsSimulatorTestCase::DoTeardown()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::SchedulerStats", BooleanValue(false));
+}
+
+/**
+ * \ingroup scheduler-stats-tests
+ * SchedulerStats test suite.
+ */
+class SchedulerStatsTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    SchedulerStatsTestSuite();
+};
+
+SchedulerStatsTestSuite::SchedulerStatsTestSuite()
+    : TestSuite("scheduler-stats")
+{
+    AddTestCase(new SchedulerStatsCountersTestCase());
+    AddTestCase(new SchedulerStatsSimulatorTestCase());
+}
+
+/**
+ * \ingroup scheduler-stats-tests
+ * SchedulerStatsTestSuite instance variable.
+ */
+static SchedulerStatsTestSuite g_schedulerStatsTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,236 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulation-fork.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup simulation-fork-tests
+ * SimulationFork test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup simulation-fork-tests SimulationFork test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulation-fork-tests
+ * The copies continue the simulation from the state at the fork.
+ */
+class SimulationForkTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SimulationForkTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the file a copy writes its results to.
+     * \param [in] copy The index of the copy.
+     * \returns The file name.
+     */
+    std::string GetFileName(int32_t copy);
+
+    uint32_t m_count; //!< Number of events run, plus 100 times the copy index
+};
+
+SimulationForkTestCase::SimulationForkTestCase()
+    : TestCase("Check the copies of a forked simulation")
+{
+}
+
+std::string
+SimulationForkTestCase::GetFileName(int32_t copy)
+{
+    return CreateTempDirFilename("simulation-fork-" + std::to_string(copy) + ".txt");
+}
+
+void
+SimulationForkTestCase::DoRun()
+{
+    const uint32_t nCopies = 4;
+    m_count = 0;
+    Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable>();
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        Simulator::Schedule(Seconds(i), [this]() { m_count++; });
+    }
+    Simulator::Stop(Seconds(5.5));
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(m_count, 5, "Wrong number of events before the fork");
+
+    int32_t copy = SimulationFork::Fork(nCopies, 2);
+    if (copy != SimulationFork::PARENT)
+    {
+        // a copy: the test framework is left to the parent
+        Simulator::Schedule(Seconds(1), [this, copy]() { m_count += 100 * copy; });
+        Simulator::Run();
+        Simulator::Destroy();
+        std::ofstream os(GetFileName(copy));
+        os.precision(std::numeric_limits<double>::max_digits10);
+        os << SimulationFork::GetCopy() << " " << m_count << " " << x->GetValue() << std::endl;
+        os.close();
+        std::_Exit(copy == static_cast<int32_t>(nCopies) - 1 ? 1 : 0);
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(SimulationFork::GetCopy(), SimulationFork::PARENT, "Not the parent");
+    NS_TEST_ASSERT_MSG_EQ(SimulationFork::GetFailures(), 1, "Wrong number of failed copies");
+    double value = x->GetValue();
+    Simulator::Destroy();
+    for (uint32_t i = 0; i < nCopies; i++)
+    {
+        std::ifstream is(GetFileName(i));
+        int32_t index = -2;
+        uint32_t count = 0;
+        double copyValue = -1;
+        is >> index >> count >> copyValue;
+        NS_TEST_ASSERT_MSG_EQ(index, static_cast<int32_t>(i), "Wrong copy index");
+        NS_TEST_ASSERT_MSG_EQ(count, 10 + 100 * i, "Wrong number of events in the copy");
+        NS_TEST_ASSERT_MSG_EQ(copyValue, value, "The random variable was not copied");
+    }
+}
+
+/**
+ * \ingroup simulation-fork-tests
+ * The replications share the data loaded before, and draw their own
+ * random values.
+ */
+class SimulationReplicateTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SimulationReplicateTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the file a replication writes its results to.
+     * \param [in] replication The index of the replication.
+     * \returns The file name.
+     */
+    std::string GetFileName(int32_t replication);
+
+    /**
+     * Draw a random value, as the replications do.
+     * \returns The random value.
+     */
+    double Draw();
+};
+
+SimulationReplicateTestCase::SimulationReplicateTestCase()
+    : TestCase("Check the replications of a simulation")
+{
+}
+
+std::string
+SimulationReplicateTestCase::GetFileName(int32_t replication)
+{
+    return CreateTempDirFilename("simulation-replicate-" + std::to_string(replication) + ".txt");
+}
+
+double
+SimulationReplicateTestCase::Draw()
+{
+    Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable>();
+    x->SetStream(7);
+    return x->GetValue();
+}
+
+void
+SimulationReplicateTestCase::DoRun()
+{
+    const uint32_t nReplications = 3;
+    const uint64_t run = RngSeedManager::GetRun();
+    const std::vector<uint32_t> shared(1000, 42);
+
+    int32_t replication = SimulationFork::Replicate(nReplications);
+    if (replication != SimulationFork::PARENT)
+    {
+        // a replication: the test framework is left to the parent
+        std::ofstream os(GetFileName(replication));
+        os.precision(std::numeric_limits<double>::max_digits10);
+        os << RngSeedManager::GetRun() << " " << shared.at(replication) << " " << Draw()
+           << std::endl;
+        os.close();
+        std::_Exit(0);
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(SimulationFork::GetFailures(), 0, "Wrong number of failed replications");
+    NS_TEST_ASSERT_MSG_EQ(RngSeedManager::GetRun(), run, "The run of the parent changed");
+    for (uint32_t i = 0; i < nReplications; i++)
+    {
+        std::ifstream is(GetFileName(i));
+        uint64_t replicationRun = 0;
+        uint32_t value = 0;
+        double draw = -1;
+        is >> replicationRun >> value >> draw;
+        NS_TEST_ASSERT_MSG_EQ(replicationRun, run + i, "Wrong run of the replication");
+        NS_TEST_ASSERT_MSG_EQ(value, 42, "The shared data was not copied");
+
+        // the same run draws the same values, in the parent
+        RngSeedManager::SetRun(run + i);
+        NS_TEST_ASSERT_MSG_EQ(draw, Draw(), "Wrong random value in the replication");
+    }
+    RngSeedManager::SetRun(run);
+}
+
+/**
+ * \ingroup simulation-fork-tests
+ * SimulationFork TestSuite
+ */
+class SimulationForkTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    SimulationForkTestSuite();
+};
+
+SimulationForkTestSuite::SimulationForkTestSuite()
+    : TestSuite("simulation-fork")
+{
+    AddTestCase(new SimulationForkTestCase);
+    AddTestCase(new SimulationReplicateTestCase);
+}
+
+/**
+ * \ingroup simulation-fork-tests
+ * SimulationForkTestSuite instance variable.
+ */
+static SimulationForkTestSuite g_simulationForkTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
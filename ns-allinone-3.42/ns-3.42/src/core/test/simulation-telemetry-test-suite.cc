@@ -0,0 +1,231 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/simulation-telemetry.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulation-telemetry-tests
+ * SimulationTelemetry test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup simulation-telemetry-tests SimulationTelemetry test suite
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * Split the records written by a telemetry.
+ * \param [in] text The records.
+ * \returns The records, one per line.
+ */
+static std::vector<std::string>
+GetRecords(const std::string& text)
+{
+    std::vector<std::string> records;
+    std::istringstream is(text);
+    std::string line;
+    while (std::getline(is, line))
+    {
+        records.push_back(line);
+    }
+    return records;
+}
+
+/**
+ * \ingroup simulation-telemetry-tests
+ * Check the content of the records.
+ */
+class SimulationTelemetryRecordTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SimulationTelemetryRecordTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the value of the test counter.
+     * \returns The value of the counter.
+     */
+    double GetCounter();
+
+    /** A counter of the test events. */
+    uint32_t m_counter{0};
+};
+
+SimulationTelemetryRecordTestCase::SimulationTelemetryRecordTestCase()
+    : TestCase("Check the content of the records")
+{
+}
+
+double
+SimulationTelemetryRecordTestCase::GetCounter()
+{
+    return m_counter;
+}
+
+void
+SimulationTelemetryRecordTestCase::DoRun()
+{
+    std::ostringstream os;
+    SimulationTelemetry::RegisterCounter(
+        "tests \"counter\"",
+        MakeCallback(&SimulationTelemetryRecordTestCase::GetCounter, this));
+    // A long interval: only the records written explicitly
+    auto telemetry = new SimulationTelemetry(Seconds(1000), os);
+    for (int i = 1; i <= 10; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(100 * i), [this]() { ++m_counter; });
+    }
+    Simulator::Schedule(MilliSeconds(550), &SimulationTelemetry::Report, telemetry, false);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+
+    auto records = GetRecords(os.str());
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 1, "Expected the record written explicitly");
+    const auto& record = records[0];
+    NS_TEST_EXPECT_MSG_EQ(record.front(), '{', "Not a JSON object");
+    NS_TEST_EXPECT_MSG_EQ(record.back(), '}', "Not a JSON object");
+    NS_TEST_EXPECT_MSG_NE(record.find("\"time\":0.550000000,"),
+                          std::string::npos,
+                          "Wrong simulation time in " << record);
+    NS_TEST_EXPECT_MSG_NE(record.find("\"counters\":{\"tests \\\"counter\\\"\":5}"),
+                          std::string::npos,
+                          "Wrong counters in " << record);
+    NS_TEST_EXPECT_MSG_EQ(record.find("\"eta\":null"),
+                          std::string::npos,
+                          "The stop time is known in " << record);
+    NS_TEST_EXPECT_MSG_EQ(record.find("\"final\""),
+                          std::string::npos,
+                          "Unexpected final record " << record);
+
+    // The final record is written by Simulator::Destroy()
+    Simulator::Destroy();
+    records = GetRecords(os.str());
+    NS_TEST_ASSERT_MSG_EQ(records.size(), 2, "Expected the final record");
+    NS_TEST_EXPECT_MSG_NE(records[1].find("\"time\":2.000000000,"),
+                          std::string::npos,
+                          "Wrong simulation time in " << records[1]);
+    NS_TEST_EXPECT_MSG_NE(records[1].find(":10},\"final\":true}"),
+                          std::string::npos,
+                          "Wrong final record " << records[1]);
+    SimulationTelemetry::UnregisterCounter("tests \"counter\"");
+
+    // And not again by the destructor
+    delete telemetry;
+    NS_TEST_EXPECT_MSG_EQ(GetRecords(os.str()).size(), 2, "Final record written twice");
+}
+
+/**
+ * \ingroup simulation-telemetry-tests
+ * Check the periodic records, and that they do not keep the simulation
+ * running.
+ */
+class SimulationTelemetryPeriodicTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SimulationTelemetryPeriodicTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SimulationTelemetryPeriodicTestCase::SimulationTelemetryPeriodicTestCase()
+    : TestCase("Check the periodic records")
+{
+}
+
+void
+SimulationTelemetryPeriodicTestCase::DoRun()
+{
+    std::ostringstream os;
+    {
+        // Some events taking longer than the interval, so that the next
+        // check writes a record
+        SimulationTelemetry telemetry(MilliSeconds(1), os);
+        for (int i = 1; i <= 5; ++i)
+        {
+            Simulator::Schedule(Seconds(i),
+                                []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+        }
+        Simulator::Schedule(Seconds(10), []() {});
+        Simulator::Run();
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(Simulator::Now(),
+                                    Seconds(10),
+                                    "The simulation stopped early");
+        NS_TEST_EXPECT_MSG_EQ(Simulator::IsFinished(), true, "The simulation did not end");
+    }
+    auto records = GetRecords(os.str());
+    NS_TEST_ASSERT_MSG_GT(records.size(), 2, "Expected periodic records");
+    NS_TEST_EXPECT_MSG_NE(records.back().find("\"final\":true}"),
+                          std::string::npos,
+                          "Expected the final record from the destructor");
+    for (std::size_t i = 0; i + 1 < records.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(records[i].find("\"final\""),
+                              std::string::npos,
+                              "Unexpected final record " << records[i]);
+    }
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(GetRecords(os.str()).size(),
+                          records.size(),
+                          "Record written after the telemetry was deleted");
+}
+
+/**
+ * \ingroup simulation-telemetry-tests
+ * SimulationTelemetry test suite.
+ */
+class SimulationTelemetryTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    SimulationTelemetryTestSuite();
+};
+
+SimulationTelemetryTestSuite::SimulationTelemetryTestSuite()
+    : TestSuite("simulation-telemetry")
+{
+    AddTestCase(new SimulationTelemetryRecordTestCase());
+    AddTestCase(new SimulationTelemetryPeriodicTestCase());
+}
+
+/**
+ * \ingroup simulation-telemetry-tests
+ * SimulationTelemetryTestSuite instance variable.
+ */
+static SimulationTelemetryTestSuite g_simulationTelemetryTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -16,14 +16,28 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/boolean.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/global-value.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/realtime-simulator-impl.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -211,6 +225,308 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the ordering of a Scheduler against a reference under a
+ * long random sequence of Insert, Remove and RemoveNext.
+ *
+ * Event delays mix simultaneous events, short delays clustered near the
+ * present and a few far future events, which exercises the bucket sizing
+ * of the calendar and ladder schedulers.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the event order of " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<Scheduler::EventKey> reference;
+    std::mt19937_64 rng(12345);
+    std::uniform_int_distribution<uint32_t> action(0, 99);
+    std::exponential_distribution<double> shortDelay(1.0 / 20);
+    std::uniform_int_distribution<uint64_t> farDelay(0, 1000000);
+
+    uint64_t now = 0;
+    uint32_t uid = 0;
+    auto insert = [&]() {
+        uint32_t kind = action(rng);
+        uint64_t delay = 0;
+        if (kind >= 95)
+        {
+            delay = farDelay(rng);
+        }
+        else if (kind >= 20)
+        {
+            delay = static_cast<uint64_t>(shortDelay(rng));
+        }
+        Scheduler::Event ev;
+        ev.impl = nullptr;
+        ev.key.m_ts = now + delay;
+        ev.key.m_uid = uid++;
+        ev.key.m_context = 0;
+        scheduler->Insert(ev);
+        reference.insert(ev.key);
+    };
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        insert();
+    }
+    for (uint32_t step = 0; step < 50000; step++)
+    {
+        uint32_t choice = action(rng);
+        if (choice < 45 || reference.empty())
+        {
+            insert();
+        }
+        else if (choice < 50)
+        {
+            // Remove a pending event picked around a random time stamp
+            uint64_t ts = now + farDelay(rng) / 1000;
+            auto it = reference.lower_bound(Scheduler::EventKey{ts, 0, 0});
+            if (it == reference.end())
+            {
+                it = std::prev(reference.end());
+            }
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key = *it;
+            scheduler->Remove(ev);
+            reference.erase(it);
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->PeekNext().key.m_uid,
+                                  reference.begin()->m_uid,
+                                  "Wrong next event at step " << step);
+            Scheduler::Event ev = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, reference.begin()->m_uid, "Wrong event removed");
+            NS_TEST_ASSERT_MSG_EQ(ev.key.m_ts, reference.begin()->m_ts, "Wrong time stamp");
+            now = ev.key.m_ts;
+            reference.erase(reference.begin());
+        }
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), reference.empty(), "Wrong IsEmpty");
+    }
+    while (!reference.empty())
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(ev.key.m_uid, reference.begin()->m_uid, "Wrong event drained");
+        reference.erase(reference.begin());
+    }
+    NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), true, "Scheduler should be empty");
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the pooled allocation of events.
+ *
+ * Events of several sizes are scheduled, cancelled, removed and run
+ * for a few rounds, so that later rounds reuse the memory of the events
+ * of the previous ones, and each event checks that its bound data is intact.
+ */
+class EventImplPoolTestCase : public TestCase
+{
+  public:
+    EventImplPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Schedule events bound to \p N bytes of data.
+     *
+     * \tparam N The size of the data bound to the events.
+     * \param [in] count The number of events to schedule.
+     * \param [in,out] ids The scheduled events.
+     */
+    template <std::size_t N>
+    void ScheduleSized(uint32_t count, std::vector<EventId>& ids);
+
+    uint32_t m_invoked;   //!< Number of events run.
+    uint32_t m_corrupted; //!< Number of events run with corrupted data.
+};
+
+EventImplPoolTestCase::EventImplPoolTestCase()
+    : TestCase("Check the pooled allocation of events")
+{
+}
+
+template <std::size_t N>
+void
+EventImplPoolTestCase::ScheduleSized(uint32_t count, std::vector<EventId>& ids)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        std::array<uint8_t, N> data;
+        data.fill(static_cast<uint8_t>(N + i));
+        auto pattern = static_cast<uint8_t>(N + i);
+        ids.push_back(Simulator::Schedule(MicroSeconds(1 + (i * 7) % 13), [this, data, pattern]() {
+            m_invoked++;
+            for (auto byte : data)
+            {
+                if (byte != pattern)
+                {
+                    m_corrupted++;
+                    return;
+                }
+            }
+        }));
+    }
+}
+
+void
+EventImplPoolTestCase::DoRun()
+{
+    // A released event should be reused by the next event of the same size
+    EventImpl* first = MakeEvent([]() {});
+    void* memory = first;
+    first->Unref();
+    EventImpl* second = MakeEvent([]() {});
+#ifndef __SANITIZE_ADDRESS__
+    NS_TEST_EXPECT_MSG_EQ((memory == second), true, "Event memory not reused");
+#endif
+    second->Unref();
+
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        m_invoked = 0;
+        m_corrupted = 0;
+        std::vector<EventId> ids;
+        ScheduleSized<1>(100, ids);
+        ScheduleSized<40>(100, ids);
+        ScheduleSized<100>(100, ids);
+        ScheduleSized<250>(100, ids);
+        ScheduleSized<500>(100, ids);
+        uint32_t expected = ids.size();
+        for (std::size_t i = 0; i < ids.size(); i++)
+        {
+            if (i % 3 == 0)
+            {
+                Simulator::Cancel(ids[i]);
+                expected--;
+            }
+            else if (i % 5 == 0)
+            {
+                Simulator::Remove(ids[i]);
+                expected--;
+            }
+        }
+        Simulator::Run();
+        NS_TEST_EXPECT_MSG_EQ(m_invoked, expected, "Wrong number of events run in round " << round);
+        NS_TEST_EXPECT_MSG_EQ(m_corrupted, 0, "Corrupted events in round " << round);
+        for (const auto& id : ids)
+        {
+            NS_TEST_EXPECT_MSG_EQ(id.IsPending(), false, "Event still pending");
+        }
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the synchronization slack and the lateness histogram of
+ * the RealtimeSimulatorImpl.
+ */
+class RealtimeSlackTestCase : public TestCase
+{
+  public:
+    RealtimeSlackTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run events spaced by one millisecond with the realtime simulator.
+     *
+     * \param [in] slack The synchronization slack.
+     * \param [in] count The number of events.
+     * \param [out] histogram The lateness histogram of the events.
+     * \returns The real time taken by the run.
+     */
+    std::chrono::nanoseconds RunEvents(Time slack,
+                                       uint32_t count,
+                                       std::vector<uint64_t>& histogram);
+};
+
+RealtimeSlackTestCase::RealtimeSlackTestCase()
+    : TestCase("Check the synchronization slack of the realtime simulator")
+{
+}
+
+std::chrono::nanoseconds
+RealtimeSlackTestCase::RunEvents(Time slack, uint32_t count, std::vector<uint64_t>& histogram)
+{
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::RealtimeSimulatorImpl"));
+    Config::SetDefault("ns3::RealtimeSimulatorImpl::SynchronizationSlack", TimeValue(slack));
+    Config::SetDefault("ns3::RealtimeSimulatorImpl::RecordLateness", BooleanValue(true));
+
+    for (uint32_t i = 1; i <= count; i++)
+    {
+        Simulator::Schedule(MilliSeconds(i), []() {});
+    }
+    // The realtime simulator waits for new events until it is stopped; the
+    // stop event is counted in the lateness histogram as well
+    Simulator::Stop(MilliSeconds(count));
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    Ptr<RealtimeSimulatorImpl> impl =
+        DynamicCast<RealtimeSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_EXPECT_MSG_NE(impl, nullptr, "Not a realtime simulation");
+    histogram = impl ? impl->GetLatenessHistogram() : std::vector<uint64_t>();
+    Simulator::Destroy();
+
+    Config::SetDefault("ns3::RealtimeSimulatorImpl::SynchronizationSlack", TimeValue(Seconds(0)));
+    Config::SetDefault("ns3::RealtimeSimulatorImpl::RecordLateness", BooleanValue(false));
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+}
+
+void
+RealtimeSlackTestCase::DoRun()
+{
+    std::vector<uint64_t> histogram;
+
+    // Without slack, the events are paced by the wall clock
+    auto elapsed = RunEvents(Seconds(0), 20, histogram);
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(elapsed.count(),
+                                MilliSeconds(20).GetNanoSeconds(),
+                                "The events were not paced");
+    NS_TEST_EXPECT_MSG_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t(0)),
+                          21,
+                          "Wrong number of events in the lateness histogram");
+
+    // Events due within the slack run immediately, and are never late
+    elapsed = RunEvents(Seconds(100), 1000, histogram);
+    NS_TEST_EXPECT_MSG_LT(elapsed.count(),
+                          MilliSeconds(500).GetNanoSeconds(),
+                          "The events were paced despite the slack");
+    NS_TEST_ASSERT_MSG_EQ(histogram.size(), 1, "Events reported late despite the slack");
+    NS_TEST_EXPECT_MSG_EQ(histogram[0], 1001, "Wrong number of events on time");
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +1046,22 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        // HeapScheduler::Remove only sifts the moved element down, so the
+        // random removals of this test are not applicable to it
+        factory.SetTypeId(MapScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(CalendarScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+
+        AddTestCase(new EventImplPoolTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new RealtimeSlackTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -21,15 +21,18 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
+#include "ns3/mpsc-queue.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <chrono> // seconds, milliseconds
 #include <ctime>
 #include <list>
 #include <thread> // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -278,6 +281,211 @@ ThreadedSimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check the MpscQueue with concurrent producers and consumer.
+ */
+class MpscQueueTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param producers The number of producer threads.
+     */
+    MpscQueueTestCase(unsigned int producers);
+
+  private:
+    void DoRun() override;
+
+    unsigned int m_producers; //!< The number of producer threads.
+};
+
+MpscQueueTestCase::MpscQueueTestCase(unsigned int producers)
+    : TestCase("Check MpscQueue with " + std::to_string(producers) + " producers"),
+      m_producers(producers)
+{
+}
+
+void
+MpscQueueTestCase::DoRun()
+{
+    const uint32_t itemsPerProducer = 20000;
+    MpscQueue<std::pair<unsigned int, uint32_t>> queue;
+    std::vector<uint32_t> next(m_producers, 0);
+    uint32_t errors = 0;
+    auto consume = [&next, &errors](const std::pair<unsigned int, uint32_t>& item) {
+        // Each producer's items must come out in push order
+        if (item.second != next[item.first])
+        {
+            errors++;
+        }
+        next[item.first] = item.second + 1;
+    };
+
+    std::list<std::thread> threads;
+    for (unsigned int p = 0; p < m_producers; p++)
+    {
+        threads.emplace_back([&queue, p, itemsPerProducer]() {
+            for (uint32_t i = 0; i < itemsPerProducer; i++)
+            {
+                queue.Push(std::make_pair(p, i));
+            }
+        });
+    }
+    std::size_t drained = 0;
+    while (drained < m_producers * itemsPerProducer)
+    {
+        drained += queue.Drain(consume);
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    drained += queue.Drain(consume);
+
+    NS_TEST_EXPECT_MSG_EQ(drained, m_producers * itemsPerProducer, "Wrong number of items");
+    NS_TEST_EXPECT_MSG_EQ(errors, 0, "Items out of order");
+    NS_TEST_EXPECT_MSG_EQ(queue.IsEmpty(), true, "Queue not empty");
+}
+
+/**
+ * \ingroup threaded-tests
+ *
+ * \brief Check that DefaultSimulatorImpl runs the events scheduled by each
+ * thread in the order they were scheduled.
+ */
+class ThreadedProducerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param ringSize The capacity of the per-thread ring buffers, 0 for none.
+     * \param producers The number of producer threads.
+     * \param joinFirst Whether to wait for the producer threads before
+     *        running the simulation, so that the rings fill up.
+     */
+    ThreadedProducerOrderTestCase(uint32_t ringSize, unsigned int producers, bool joinFirst);
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Event scheduled by a producer thread.
+     * \param producer The producer thread.
+     * \param seq The sequence number of the event for this producer.
+     */
+    void Receive(unsigned int producer, uint32_t seq);
+    /** Keep the simulation running until all the events are received. */
+    void Poll();
+
+    uint32_t m_ringSize;           //!< The capacity of the ring buffers.
+    unsigned int m_producers;      //!< The number of producer threads.
+    bool m_joinFirst;              //!< Wait for the producers before running.
+    std::vector<uint32_t> m_next;  //!< The next sequence number of each producer.
+    uint32_t m_received;           //!< The number of events received.
+    uint32_t m_errors;             //!< The number of events out of order.
+    static constexpr uint32_t N_EVENTS = 5000; //!< Events per producer.
+};
+
+ThreadedProducerOrderTestCase::ThreadedProducerOrderTestCase(uint32_t ringSize,
+                                                             unsigned int producers,
+                                                             bool joinFirst)
+    : TestCase("Check the order of the events of " + std::to_string(producers) +
+               " threads, with ring buffers of size " + std::to_string(ringSize) +
+               (joinFirst ? ", scheduled before the simulation runs" : "")),
+      m_ringSize(ringSize),
+      m_producers(producers),
+      m_joinFirst(joinFirst),
+      m_received(0),
+      m_errors(0)
+{
+}
+
+void
+ThreadedProducerOrderTestCase::DoSetup()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ProducerRingSize", UintegerValue(m_ringSize));
+}
+
+void
+ThreadedProducerOrderTestCase::DoTeardown()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ProducerRingSize", UintegerValue(0));
+}
+
+void
+ThreadedProducerOrderTestCase::Receive(unsigned int producer, uint32_t seq)
+{
+    if (seq != m_next[producer])
+    {
+        m_errors++;
+    }
+    m_next[producer] = seq + 1;
+    m_received++;
+}
+
+void
+ThreadedProducerOrderTestCase::Poll()
+{
+    if (m_received < m_producers * N_EVENTS)
+    {
+        Simulator::Schedule(MicroSeconds(1), &ThreadedProducerOrderTestCase::Poll, this);
+    }
+}
+
+void
+ThreadedProducerOrderTestCase::DoRun()
+{
+    m_next.assign(m_producers, 0);
+    m_received = 0;
+    m_errors = 0;
+    // Create the simulator before the threads use it
+    Simulator::Schedule(MicroSeconds(1), &ThreadedProducerOrderTestCase::Poll, this);
+
+    std::list<std::thread> threads;
+    for (unsigned int p = 0; p < m_producers; p++)
+    {
+        threads.emplace_back([this, p]() {
+            for (uint32_t i = 0; i < N_EVENTS; i++)
+            {
+                Simulator::ScheduleWithContext(p,
+                                               Time(0),
+                                               &ThreadedProducerOrderTestCase::Receive,
+                                               this,
+                                               p,
+                                               i);
+            }
+        });
+    }
+    if (m_joinFirst)
+    {
+        // The producers overflow their rings, and must not wait for the simulation
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    Simulator::Run();
+    for (auto& thread : threads)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(m_received, m_producers * N_EVENTS, "Wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(m_errors, 0, "Events out of order");
+}
+
 /**
  * \ingroup threaded-tests
  *
@@ -315,6 +523,11 @@ class ThreadedSimulatorTestSuite : public TestSuite
                 }
             }
         }
+        AddTestCase(new MpscQueueTestCase(1), TestCase::Duration::QUICK);
+        AddTestCase(new MpscQueueTestCase(8), TestCase::Duration::QUICK);
+        AddTestCase(new ThreadedProducerOrderTestCase(0, 4, false), TestCase::Duration::QUICK);
+        AddTestCase(new ThreadedProducerOrderTestCase(16, 4, false), TestCase::Duration::QUICK);
+        AddTestCase(new ThreadedProducerOrderTestCase(16, 4, true), TestCase::Duration::QUICK);
     }
 };
 
@@ -26,6 +26,7 @@
 #include <array>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -534,6 +535,71 @@ TimeInputOutputTestCase::DoRun()
     CheckAs(t * 1e+8, "+9.961925y");
 }
 
+/**
+ * \ingroup core-tests
+ * \brief Check the double conversions against the int64x64_t ones.
+ */
+class TimeConversionTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor for TimeConversionTestCase.
+     */
+    TimeConversionTestCase();
+
+  private:
+    /**
+     * \brief DoRun for TimeConversionTestCase.
+     */
+    void DoRun() override;
+};
+
+TimeConversionTestCase::TimeConversionTestCase()
+    : TestCase("Conversions from,to doubles")
+{
+}
+
+void
+TimeConversionTestCase::DoRun()
+{
+    // Halfway cases are rounded away from zero
+    NS_TEST_EXPECT_MSG_EQ(Time::FromDouble(2.5, Time::NS), NanoSeconds(3), "Wrong rounding up");
+    NS_TEST_EXPECT_MSG_EQ(Time::FromDouble(-2.5, Time::NS), Seconds(-3e-9), "Wrong rounding down");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(1e-9 / 2), NanoSeconds(1), "Wrong rounding up");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(0.1), MilliSeconds(100), "Wrong conversion");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(-0.7), MilliSeconds(300) - Seconds(1), "Wrong conversion");
+
+    // The double values are correctly rounded
+    NS_TEST_EXPECT_MSG_EQ(Seconds(1.5).GetSeconds(), 1.5, "Wrong conversion");
+    NS_TEST_EXPECT_MSG_EQ(MilliSeconds(3).GetSeconds(), 0.003, "Wrong conversion");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(-7e-9).GetMicroSeconds(), 0, "Wrong conversion");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(-7e-9).ToDouble(Time::US), -0.007, "Wrong conversion");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(2).ToDouble(Time::PS), 2e12, "Wrong conversion");
+
+    // Ratios of Times are exact
+    NS_TEST_EXPECT_MSG_EQ(Seconds(3) / Seconds(2), int64x64_t(1.5), "Wrong ratio");
+    NS_TEST_EXPECT_MSG_EQ(Seconds(-1e-9) / NanoSeconds(4), int64x64_t(-0.25), "Wrong ratio");
+
+    std::mt19937_64 generator(1);
+    std::uniform_real_distribution<double> uniform(-1000, 1000);
+    const std::array<Time::Unit, 4> units = {Time::S, Time::MS, Time::US, Time::NS};
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        double value = uniform(generator);
+        Time::Unit unit = units[i % units.size()];
+        Time time = Time::FromDouble(value, unit);
+        NS_TEST_ASSERT_MSG_EQ(time,
+                              Time::From(int64x64_t(value), unit),
+                              "Wrong conversion of " << std::setprecision(17) << value);
+        double converted = time.ToDouble(unit);
+        double expected = time.To(unit).GetDouble();
+        NS_TEST_ASSERT_MSG_EQ_TOL(converted,
+                                  expected,
+                                  std::fabs(expected) * 1e-15,
+                                  "Wrong conversion of " << time);
+    }
+}
+
 /**
  * \ingroup core-tests
  * \brief   Time test Suite.  Runs the appropriate test cases for time
@@ -546,6 +612,7 @@ static class TimeTestSuite : public TestSuite
     {
         AddTestCase(new TimeWithSignTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new TimeInputOutputTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimeConversionTestCase(), TestCase::Duration::QUICK);
         // This should be last, since it changes the resolution
         AddTestCase(new TimeSimpleTestCase(), TestCase::Duration::QUICK);
     }
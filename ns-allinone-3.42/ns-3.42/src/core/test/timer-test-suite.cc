@@ -21,6 +21,8 @@
 #include "ns3/test.h"
 #include "ns3/timer.h"
 
+#include <vector>
+
 /**
  * \file
  * \ingroup timer-tests
@@ -220,6 +222,78 @@ TimerTemplateTestCase::DoTeardown()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup timer-tests
+ *
+ * \brief Check that a restarted timer expires once, at the last expiration time.
+ */
+class TimerRestartTestCase : public TestCase
+{
+  public:
+    TimerRestartTestCase();
+    void DoRun() override;
+
+    /// Record the expiration of the timer.
+    void Expire();
+    /**
+     * Restart the timer.
+     * \param [in] delay The delay to restart it with.
+     */
+    void Restart(Time delay);
+
+  private:
+    Timer m_timer{Timer::CANCEL_ON_DESTROY}; //!< The timer restarted.
+    std::vector<Time> m_expirations;         //!< The expiration times.
+};
+
+TimerRestartTestCase::TimerRestartTestCase()
+    : TestCase("Check that a restarted timer expires at the last expiration time")
+{
+}
+
+void
+TimerRestartTestCase::Expire()
+{
+    m_expirations.push_back(Simulator::Now());
+}
+
+void
+TimerRestartTestCase::Restart(Time delay)
+{
+    m_timer.Restart(delay);
+    NS_TEST_EXPECT_MSG_EQ(m_timer.IsRunning(), true, "Restarted timer not running");
+    NS_TEST_EXPECT_MSG_EQ(m_timer.GetDelayLeft(), delay, "Wrong delay left");
+}
+
+void
+TimerRestartTestCase::DoRun()
+{
+    m_timer.SetFunction(&TimerRestartTestCase::Expire, this);
+    m_timer.SetDelay(Seconds(10));
+
+    // Extended many times, then shortened, expires at 13 s
+    m_timer.Restart();
+    for (int i = 1; i <= 10; i++)
+    {
+        Simulator::Schedule(Seconds(i), &TimerRestartTestCase::Restart, this, Seconds(5));
+    }
+    Simulator::Schedule(Seconds(11), &TimerRestartTestCase::Restart, this, Seconds(2));
+    // Suspended with 7 s left, then resumed, expires at 37 s
+    Simulator::Schedule(Seconds(17), &TimerRestartTestCase::Restart, this, Seconds(10));
+    Simulator::Schedule(Seconds(20), &Timer::Suspend, &m_timer);
+    Simulator::Schedule(Seconds(30), &Timer::Resume, &m_timer);
+    // Cancelled, does not expire
+    Simulator::Schedule(Seconds(40), &TimerRestartTestCase::Restart, this, Seconds(5));
+    Simulator::Schedule(Seconds(42), &TimerRestartTestCase::Restart, this, Seconds(5));
+    Simulator::Schedule(Seconds(43), &Timer::Cancel, &m_timer);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_expirations.size(), 2, "Wrong number of expirations");
+    NS_TEST_EXPECT_MSG_EQ(m_expirations[0], Seconds(13), "Wrong first expiration");
+    NS_TEST_EXPECT_MSG_EQ(m_expirations[1], Seconds(37), "Wrong second expiration");
+}
+
 /**
  * \ingroup timer-tests
  *
@@ -233,6 +307,7 @@ class TimerTestSuite : public TestSuite
     {
         AddTestCase(new TimerStateTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new TimerTemplateTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new TimerRestartTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -93,8 +93,10 @@ BasicTracedCallbackTestCase::DoRun()
     // trace, both callbacks should be called and the two variables  should be set
     // to true.
     //
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "No callback connected yet");
     trace.ConnectWithoutContext(MakeCallback(&BasicTracedCallbackTestCase::CbOne, this));
     trace.ConnectWithoutContext(m_cbTwo);
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), false, "Callbacks connected");
     m_one = false;
     m_two = false;
     trace(1, 2);
@@ -115,6 +117,7 @@ BasicTracedCallbackTestCase::DoRun()
     // If we now disconnect callback two then neither callback should be called.
     //
     trace.DisconnectWithoutContext(m_cbTwo);
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "Callbacks disconnected");
     m_one = false;
     m_two = false;
     trace(1, 2);
@@ -133,6 +136,42 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * \ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that the sinks are never invoked when
+ * tracing is disabled in the build.
+ */
+class DisabledTracedCallbackTestCase : public TestCase
+{
+  public:
+    DisabledTracedCallbackTestCase();
+
+    ~DisabledTracedCallbackTestCase() override
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+DisabledTracedCallbackTestCase::DisabledTracedCallbackTestCase()
+    : TestCase("Check TracedCallback with tracing disabled")
+{
+}
+
+void
+DisabledTracedCallbackTestCase::DoRun()
+{
+    bool called = false;
+    TracedCallback<uint8_t, double> trace;
+    trace.ConnectWithoutContext(
+        Callback<void, uint8_t, double>([&called](uint8_t, double) { called = true; }));
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "Trace sources must look unconnected");
+    trace(1, 2);
+    NS_TEST_ASSERT_MSG_EQ(called, false, "Callback unexpectedly called");
+}
+
 /**
  * \ingroup tracedcallback-tests
  *
@@ -147,7 +186,11 @@ class TracedCallbackTestSuite : public TestSuite
 TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
+#ifdef NS3_TRACING_DISABLE
+    AddTestCase(new DisabledTracedCallbackTestCase, TestCase::Duration::QUICK);
+#else
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+#endif
 }
 
 static TracedCallbackTestSuite
@@ -21,6 +21,7 @@
 
 #include "csma-net-device.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -50,12 +51,22 @@ CsmaChannel::GetTypeId()
                           "Transmission delay through the channel",
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&CsmaChannel::m_delay),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("SingleReceiveEvent",
+                          "If true, a frame is delivered to all the receiving devices "
+                          "by a single event rather than by one event per device. "
+                          "This reduces the cost of a frame on channels with many "
+                          "devices, but the receptions then run in the context of "
+                          "the sending node rather than of each receiving node.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CsmaChannel::m_singleReceiveEvent),
+                          MakeBooleanChecker());
     return tid;
 }
 
 CsmaChannel::CsmaChannel()
-    : Channel()
+    : Channel(),
+      m_singleReceiveEvent(false)
 {
     NS_LOG_FUNCTION_NOARGS();
     m_state = IDLE;
@@ -225,17 +236,38 @@ CsmaChannel::TransmitEnd()
 
     NS_LOG_LOGIC("Receive");
 
-    for (auto it = m_deviceList.begin(); it < m_deviceList.end(); it++)
+    if (m_singleReceiveEvent)
     {
-        if (it->IsActive() && it->devicePtr != m_deviceList[m_currentSrc].devicePtr)
+        std::vector<Ptr<CsmaNetDevice>> receivers;
+        receivers.reserve(m_deviceList.size());
+        for (auto it = m_deviceList.begin(); it < m_deviceList.end(); it++)
         {
-            // schedule reception events
-            Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
-                                           m_delay,
-                                           &CsmaNetDevice::Receive,
-                                           it->devicePtr,
-                                           m_currentPkt,
-                                           m_deviceList[m_currentSrc].devicePtr);
+            if (it->IsActive() && it->devicePtr != m_deviceList[m_currentSrc].devicePtr)
+            {
+                receivers.push_back(it->devicePtr);
+            }
+        }
+        Simulator::Schedule(m_delay,
+                            &CsmaChannel::ReceiveAll,
+                            this,
+                            std::move(receivers),
+                            m_currentPkt,
+                            m_deviceList[m_currentSrc].devicePtr);
+    }
+    else
+    {
+        for (auto it = m_deviceList.begin(); it < m_deviceList.end(); it++)
+        {
+            if (it->IsActive() && it->devicePtr != m_deviceList[m_currentSrc].devicePtr)
+            {
+                // schedule reception events
+                Simulator::ScheduleWithContext(it->devicePtr->GetNode()->GetId(),
+                                               m_delay,
+                                               &CsmaNetDevice::Receive,
+                                               it->devicePtr,
+                                               m_currentPkt,
+                                               m_deviceList[m_currentSrc].devicePtr);
+            }
         }
     }
 
@@ -244,6 +276,19 @@ CsmaChannel::TransmitEnd()
     return retVal;
 }
 
+void
+CsmaChannel::ReceiveAll(std::vector<Ptr<CsmaNetDevice>> receivers,
+                        Ptr<const Packet> packet,
+                        Ptr<CsmaNetDevice> sender)
+{
+    NS_LOG_FUNCTION(this << packet << sender);
+
+    for (const auto& receiver : receivers)
+    {
+        receiver->Receive(packet, sender);
+    }
+}
+
 void
 CsmaChannel::PropagationCompleteEvent()
 {
@@ -297,6 +297,18 @@ class CsmaChannel : public Channel
     Time GetDelay();
 
   private:
+    /**
+     * \brief Deliver a packet to several net devices at once, when the
+     * SingleReceiveEvent attribute is set.
+     *
+     * \param receivers The net devices receiving the packet
+     * \param packet The packet
+     * \param sender The net device that sent the packet
+     */
+    void ReceiveAll(std::vector<Ptr<CsmaNetDevice>> receivers,
+                    Ptr<const Packet> packet,
+                    Ptr<CsmaNetDevice> sender);
+
     /**
      * The assigned data rate of the channel
      */
@@ -307,6 +319,11 @@ class CsmaChannel : public Channel
      */
     Time m_delay;
 
+    /**
+     * Whether a frame is delivered to all the receivers by a single event
+     */
+    bool m_singleReceiveEvent;
+
     /**
      * List of the net devices that have been or are currently connected
      * to the channel.
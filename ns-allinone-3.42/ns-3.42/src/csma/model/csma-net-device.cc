@@ -28,6 +28,7 @@
 #include "ns3/ethernet-trailer.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
@@ -960,6 +961,19 @@ CsmaNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNu
     return SendFrom(packet, m_address, dest, protocolNumber);
 }
 
+bool
+CsmaNetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(burst << dest << protocolNumber);
+
+    bool ret = true;
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        ret = CsmaNetDevice::SendFrom(*it, m_address, dest, protocolNumber) && ret;
+    }
+    return ret;
+}
+
 bool
 CsmaNetDevice::SendFrom(Ptr<Packet> packet,
                         const Address& src,
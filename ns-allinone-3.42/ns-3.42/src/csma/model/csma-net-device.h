@@ -278,6 +278,15 @@ class CsmaNetDevice : public NetDevice
      */
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
 
+    /**
+     * Start sending a burst of packets down the channel.
+     * \param burst packets to send
+     * \param dest layer 2 destination address
+     * \param protocolNumber protocol number
+     * \return true if all the packets were accepted, false otherwise (drop, ...)
+     */
+    bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber) override;
+
     /**
      * Start sending a packet down the channel, with MAC spoofing
      * \param packet packet to send
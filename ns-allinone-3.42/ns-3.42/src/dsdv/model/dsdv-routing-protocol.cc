@@ -121,6 +121,15 @@ RoutingProtocol::GetTypeId()
                           TimeValue(Seconds(15)),
                           MakeTimeAccessor(&RoutingProtocol::m_periodicUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("FullDumpInterval",
+                          "Interval between two periodic updates carrying the entire routing "
+                          "table, the periodic updates in between carry only the entries whose "
+                          "hop count changed. Zero sends the entire table in every periodic "
+                          "update. Should be below Holdtimes times PeriodicUpdateInterval, the "
+                          "neighbors refreshing the routes only when they are advertised.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RoutingProtocol::m_fullDumpInterval),
+                          MakeTimeChecker())
             .AddAttribute("SettlingTime",
                           "Minimum time an update is to be stored in adv table before sending out "
                           "in case of change in metric (in seconds)",
@@ -225,7 +234,8 @@ RoutingProtocol::AssignStreams(int64_t stream)
 }
 
 RoutingProtocol::RoutingProtocol()
-    : m_routingTable(),
+    : m_lastFullDump(Time::Min()),
+      m_routingTable(),
       m_advRoutingTable(),
       m_queue(),
       m_periodicUpdateTimer(Timer::CANCEL_ON_DESTROY)
@@ -910,50 +920,18 @@ RoutingProtocol::SendPeriodicUpdate()
         return;
     }
     NS_LOG_FUNCTION(m_mainAddress << " is sending out its periodic update");
+    // The update is the same on every interface, build it once
+    Ptr<Packet> packet;
     for (auto j = m_socketAddresses.begin(); j != m_socketAddresses.end(); ++j)
     {
         Ptr<Socket> socket = j->first;
         Ipv4InterfaceAddress iface = j->second;
-        Ptr<Packet> packet = Create<Packet>();
-        for (auto i = allRoutes.begin(); i != allRoutes.end(); ++i)
-        {
-            DsdvHeader dsdvHeader;
-            if (i->second.GetHop() == 0)
-            {
-                RoutingTableEntry ownEntry;
-                dsdvHeader.SetDst(m_ipv4->GetAddress(1, 0).GetLocal());
-                dsdvHeader.SetDstSeqno(i->second.GetSeqNo() + 2);
-                dsdvHeader.SetHopCount(i->second.GetHop() + 1);
-                m_routingTable.LookupRoute(m_ipv4->GetAddress(1, 0).GetBroadcast(), ownEntry);
-                ownEntry.SetSeqNo(dsdvHeader.GetDstSeqno());
-                m_routingTable.Update(ownEntry);
-                packet->AddHeader(dsdvHeader);
-            }
-            else
-            {
-                dsdvHeader.SetDst(i->second.GetDestination());
-                dsdvHeader.SetDstSeqno(i->second.GetSeqNo());
-                dsdvHeader.SetHopCount(i->second.GetHop() + 1);
-                packet->AddHeader(dsdvHeader);
-            }
-            NS_LOG_DEBUG("Forwarding the update for " << i->first);
-            NS_LOG_DEBUG("Forwarding details are, Destination: "
-                         << dsdvHeader.GetDst() << ", SeqNo:" << dsdvHeader.GetDstSeqno()
-                         << ", HopCount:" << dsdvHeader.GetHopCount()
-                         << ", LifeTime: " << i->second.GetLifeTime().As(Time::S));
-        }
-        for (auto rmItr = removedAddresses.begin(); rmItr != removedAddresses.end(); ++rmItr)
+        if (!packet)
         {
-            DsdvHeader removedHeader;
-            removedHeader.SetDst(rmItr->second.GetDestination());
-            removedHeader.SetDstSeqno(rmItr->second.GetSeqNo() + 1);
-            removedHeader.SetHopCount(rmItr->second.GetHop() + 1);
-            packet->AddHeader(removedHeader);
-            NS_LOG_DEBUG("Update for removed record is: Destination: "
-                         << removedHeader.GetDst() << " SeqNo:" << removedHeader.GetDstSeqno()
-                         << " HopCount:" << removedHeader.GetHopCount());
+            packet = BuildPeriodicUpdate(allRoutes, removedAddresses);
         }
-        socket->Send(packet);
+        Ptr<Packet> ifacePacket = packet->Copy();
+        socket->Send(ifacePacket);
         // Send to all-hosts broadcast if on /32 addr, subnet-directed otherwise
         Ipv4Address destination;
         if (iface.GetMask() == Ipv4Mask::GetOnes())
@@ -964,13 +942,79 @@ RoutingProtocol::SendPeriodicUpdate()
         {
             destination = iface.GetBroadcast();
         }
-        socket->SendTo(packet, 0, InetSocketAddress(destination, DSDV_PORT));
-        NS_LOG_FUNCTION("PeriodicUpdate Packet UID is : " << packet->GetUid());
+        socket->SendTo(ifacePacket, 0, InetSocketAddress(destination, DSDV_PORT));
+        NS_LOG_FUNCTION("PeriodicUpdate Packet UID is : " << ifacePacket->GetUid());
     }
     m_periodicUpdateTimer.Schedule(m_periodicUpdateInterval +
                                    MicroSeconds(25 * m_uniformRandomVariable->GetInteger(0, 1000)));
 }
 
+Ptr<Packet>
+RoutingProtocol::BuildPeriodicUpdate(const std::map<Ipv4Address, RoutingTableEntry>& allRoutes,
+                                     const std::map<Ipv4Address, RoutingTableEntry>& removed)
+{
+    bool fullDump =
+        m_fullDumpInterval.IsZero() || Simulator::Now() >= m_lastFullDump + m_fullDumpInterval;
+    NS_LOG_FUNCTION(this << fullDump);
+    if (fullDump)
+    {
+        m_lastFullDump = Simulator::Now();
+        m_advertisedHops.clear();
+    }
+    Ptr<Packet> packet = Create<Packet>();
+    for (auto i = allRoutes.begin(); i != allRoutes.end(); ++i)
+    {
+        DsdvHeader dsdvHeader;
+        if (i->second.GetHop() == 0)
+        {
+            RoutingTableEntry ownEntry;
+            dsdvHeader.SetDst(m_ipv4->GetAddress(1, 0).GetLocal());
+            dsdvHeader.SetDstSeqno(i->second.GetSeqNo() + 2);
+            dsdvHeader.SetHopCount(i->second.GetHop() + 1);
+            m_routingTable.LookupRoute(m_ipv4->GetAddress(1, 0).GetBroadcast(), ownEntry);
+            ownEntry.SetSeqNo(dsdvHeader.GetDstSeqno());
+            m_routingTable.Update(ownEntry);
+            packet->AddHeader(dsdvHeader);
+        }
+        else
+        {
+            if (!m_fullDumpInterval.IsZero())
+            {
+                auto advertised = m_advertisedHops.find(i->first);
+                if (advertised != m_advertisedHops.end() &&
+                    advertised->second == i->second.GetHop())
+                {
+                    NS_LOG_DEBUG("Skipping the unchanged entry for " << i->first);
+                    continue;
+                }
+                m_advertisedHops[i->first] = i->second.GetHop();
+            }
+            dsdvHeader.SetDst(i->second.GetDestination());
+            dsdvHeader.SetDstSeqno(i->second.GetSeqNo());
+            dsdvHeader.SetHopCount(i->second.GetHop() + 1);
+            packet->AddHeader(dsdvHeader);
+        }
+        NS_LOG_DEBUG("Forwarding the update for " << i->first);
+        NS_LOG_DEBUG("Forwarding details are, Destination: "
+                     << dsdvHeader.GetDst() << ", SeqNo:" << dsdvHeader.GetDstSeqno()
+                     << ", HopCount:" << dsdvHeader.GetHopCount()
+                     << ", LifeTime: " << i->second.GetLifeTime().As(Time::S));
+    }
+    for (auto rmItr = removed.begin(); rmItr != removed.end(); ++rmItr)
+    {
+        DsdvHeader removedHeader;
+        removedHeader.SetDst(rmItr->second.GetDestination());
+        removedHeader.SetDstSeqno(rmItr->second.GetSeqNo() + 1);
+        removedHeader.SetHopCount(rmItr->second.GetHop() + 1);
+        packet->AddHeader(removedHeader);
+        m_advertisedHops.erase(rmItr->first);
+        NS_LOG_DEBUG("Update for removed record is: Destination: "
+                     << removedHeader.GetDst() << " SeqNo:" << removedHeader.GetDstSeqno()
+                     << " HopCount:" << removedHeader.GetHopCount());
+    }
+    return packet;
+}
+
 void
 RoutingProtocol::SetIpv4(Ptr<Ipv4> ipv4)
 {
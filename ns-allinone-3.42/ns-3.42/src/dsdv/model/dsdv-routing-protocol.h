@@ -151,6 +151,14 @@ class RoutingProtocol : public Ipv4RoutingProtocol
     /// PeriodicUpdateInterval specifies the periodic time interval between which the a node
     /// broadcasts its entire routing table.
     Time m_periodicUpdateInterval;
+    /// FullDumpInterval specifies the interval between two periodic updates carrying the entire
+    /// routing table; the periodic updates in between carry only the changed entries. Zero sends
+    /// the entire routing table in every periodic update.
+    Time m_fullDumpInterval;
+    /// Time of the last periodic update carrying the entire routing table
+    Time m_lastFullDump;
+    /// Hop count of each destination in the last periodic update it was part of
+    std::map<Ipv4Address, uint32_t> m_advertisedHops;
     /// SettlingTime specifies the time for which a node waits before propagating an update.
     /// It waits for this time interval in hope of receiving an update with a better metric.
     Time m_settlingTime;
@@ -253,6 +261,14 @@ class RoutingProtocol : public Ipv4RoutingProtocol
     void SendTriggeredUpdate();
     /// Broadcasts the entire routing table for every PeriodicUpdateInterval
     void SendPeriodicUpdate();
+    /**
+     * Build the packet of a periodic update
+     * \param allRoutes the routes of the routing table
+     * \param removed the routes purged from the routing table
+     * \return the packet, carrying the entire routing table or only the changed entries
+     */
+    Ptr<Packet> BuildPeriodicUpdate(const std::map<Ipv4Address, RoutingTableEntry>& allRoutes,
+                                    const std::map<Ipv4Address, RoutingTableEntry>& removed);
     /// Merge periodic updates
     void MergeTriggerPeriodicUpdates();
     /**
@@ -343,15 +343,10 @@ uint32_t
 DsrOptions::GetIDfromIP(Ipv4Address address)
 {
     NS_LOG_FUNCTION(this << address);
-    int32_t nNodes = NodeList::GetNNodes();
-    for (int32_t i = 0; i < nNodes; ++i)
+    Ptr<Node> node = Ipv4L3Protocol::GetNodeWithAddress(address);
+    if (node && node->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal() == address)
     {
-        Ptr<Node> node = NodeList::GetNode(i);
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        if (ipv4->GetAddress(1, 0).GetLocal() == address)
-        {
-            return i;
-        }
+        return node->GetId();
     }
     return 255;
 }
@@ -360,18 +355,7 @@ Ptr<Node>
 DsrOptions::GetNodeWithAddress(Ipv4Address ipv4Address)
 {
     NS_LOG_FUNCTION(this << ipv4Address);
-    int32_t nNodes = NodeList::GetNNodes();
-    for (int32_t i = 0; i < nNodes; ++i)
-    {
-        Ptr<Node> node = NodeList::GetNode(i);
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        int32_t ifIndex = ipv4->GetInterfaceForAddress(ipv4Address);
-        if (ifIndex != -1)
-        {
-            return node;
-        }
-    }
-    return nullptr;
+    return Ipv4L3Protocol::GetNodeWithAddress(ipv4Address);
 }
 
 NS_OBJECT_ENSURE_REGISTERED(DsrOptionPad1);
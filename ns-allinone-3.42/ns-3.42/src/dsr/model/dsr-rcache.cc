@@ -47,6 +47,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace ns3
@@ -327,104 +328,95 @@ DsrRouteCache::RebuildBestRouteTable(Ipv4Address source)
     std::map<Ipv4Address, Ipv4Address> pre;
     for (auto i = m_netGraph.begin(); i != m_netGraph.end(); ++i)
     {
-        if (i->second.find(source) != i->second.end())
-        {
-            d[i->first] = i->second[source];
-            pre[i->first] = source;
-        }
-        else
-        {
-            d[i->first] = MAXWEIGHT;
-            pre[i->first] = Ipv4Address("255.255.255.255");
-        }
+        d[i->first] = MAXWEIGHT;
+        pre[i->first] = Ipv4Address("255.255.255.255");
     }
     d[source] = 0;
     /**
      * \brief The following is the core of Dijkstra algorithm
+     *
+     * The nodes not yet settled are kept ordered by (distance, inverted address): among
+     * the nodes at the same distance the one with the highest address is settled first,
+     * which is the order the tie-breaking on the link stability below relies on.  The
+     * nodes never reached keep MAXWEIGHT and are not settled.
      */
+    std::set<std::pair<uint32_t, uint32_t>> queue;
+    queue.emplace(0, ~source.Get());
     // the node set which shortest distance has been calculated, if true calculated
     std::map<Ipv4Address, bool> s;
-    double temp = MAXWEIGHT;
-    Ipv4Address tempip("255.255.255.255");
-    for (uint32_t i = 0; i < m_netGraph.size(); i++)
+    // clean the best route table
+    m_bestRoutesTable_link.clear();
+    while (!queue.empty())
     {
-        temp = MAXWEIGHT;
-        for (auto j = d.begin(); j != d.end(); ++j)
+        Ipv4Address tempip(~queue.begin()->second);
+        queue.erase(queue.begin());
+        s[tempip] = true;
+        if (tempip != source)
         {
-            Ipv4Address ip = j->first;
-            if (s.find(ip) == s.end())
+            // The route to the preceding node is final, extend it by this node
+            DsrRouteCacheEntry::IP_VECTOR route;
+            auto preRoute = m_bestRoutesTable_link.find(pre[tempip]);
+            if (preRoute == m_bestRoutesTable_link.end())
             {
-                /*
-                 * \brief The following are for comparison
-                 */
-                if (j->second <= temp)
-                {
-                    temp = j->second;
-                    tempip = ip;
-                }
+                route.push_back(source);
+            }
+            else
+            {
+                route = preRoute->second;
             }
+            route.push_back(tempip);
+            NS_LOG_LOGIC("Add newly calculated best routes");
+            PrintVector(route);
+            m_bestRoutesTable_link[tempip] = route;
         }
-        if (!tempip.IsBroadcast())
+        auto neighbors = m_netGraph.find(tempip);
+        if (neighbors == m_netGraph.end())
         {
-            s[tempip] = true;
-            for (auto k = m_netGraph[tempip].begin(); k != m_netGraph[tempip].end(); ++k)
+            continue;
+        }
+        for (auto k = neighbors->second.begin(); k != neighbors->second.end(); ++k)
+        {
+            if (s.find(k->first) != s.end())
+            {
+                continue;
+            }
+            uint32_t& dk = d[k->first];
+            if (dk > d[tempip] + k->second)
             {
-                if (s.find(k->first) == s.end() && d[k->first] > d[tempip] + k->second)
+                if (!pre[k->first].IsBroadcast())
                 {
-                    d[k->first] = d[tempip] + k->second;
-                    pre[k->first] = tempip;
+                    queue.erase({dk, ~k->first.Get()});
                 }
-                /*
-                 *  Selects the shortest-length route that has the longest expected lifetime
-                 *  (highest minimum timeout of any link in the route)
-                 *  For the computation overhead and complexity
-                 *  Here I just implement kind of greedy strategy to select link with the longest
-                 * expected lifetime when there is two options
-                 */
-                else if (d[k->first] == d[tempip] + k->second)
+                dk = d[tempip] + k->second;
+                pre[k->first] = tempip;
+                queue.emplace(dk, ~k->first.Get());
+            }
+            /*
+             *  Selects the shortest-length route that has the longest expected lifetime
+             *  (highest minimum timeout of any link in the route)
+             *  For the computation overhead and complexity
+             *  Here I just implement kind of greedy strategy to select link with the longest
+             * expected lifetime when there is two options
+             */
+            else if (dk == d[tempip] + k->second)
+            {
+                auto oldlink = m_linkCache.find(Link(k->first, pre[k->first]));
+                auto newlink = m_linkCache.find(Link(k->first, tempip));
+                if (oldlink != m_linkCache.end() && newlink != m_linkCache.end())
                 {
-                    auto oldlink = m_linkCache.find(Link(k->first, pre[k->first]));
-                    auto newlink = m_linkCache.find(Link(k->first, tempip));
-                    if (oldlink != m_linkCache.end() && newlink != m_linkCache.end())
+                    if (oldlink->second.GetLinkStability() < newlink->second.GetLinkStability())
                     {
-                        if (oldlink->second.GetLinkStability() < newlink->second.GetLinkStability())
-                        {
-                            NS_LOG_INFO("Select the link with longest expected lifetime");
-                            d[k->first] = d[tempip] + k->second;
-                            pre[k->first] = tempip;
-                        }
-                    }
-                    else
-                    {
-                        NS_LOG_INFO("Link Stability Info Corrupt");
+                        NS_LOG_INFO("Select the link with longest expected lifetime");
+                        pre[k->first] = tempip;
                     }
                 }
+                else
+                {
+                    NS_LOG_INFO("Link Stability Info Corrupt");
+                }
             }
         }
     }
-    // clean the best route table
-    m_bestRoutesTable_link.clear();
-    for (auto i = pre.begin(); i != pre.end(); ++i)
-    {
-        // loop for all vertices
-        DsrRouteCacheEntry::IP_VECTOR route;
-        Ipv4Address iptemp = i->first;
-
-        if (!i->second.IsBroadcast() && iptemp != source)
-        {
-            while (iptemp != source)
-            {
-                route.push_back(iptemp);
-                iptemp = pre[iptemp];
-            }
-            route.push_back(source);
-            // Reverse the route
-            DsrRouteCacheEntry::IP_VECTOR reverseroute(route.rbegin(), route.rend());
-            NS_LOG_LOGIC("Add newly calculated best routes");
-            PrintVector(reverseroute);
-            m_bestRoutesTable_link[i->first] = reverseroute;
-        }
-    }
 }
 
 bool
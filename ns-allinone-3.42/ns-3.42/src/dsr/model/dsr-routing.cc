@@ -645,18 +645,7 @@ Ptr<Node>
 DsrRouting::GetNodeWithAddress(Ipv4Address ipv4Address)
 {
     NS_LOG_FUNCTION(this << ipv4Address);
-    int32_t nNodes = NodeList::GetNNodes();
-    for (int32_t i = 0; i < nNodes; ++i)
-    {
-        Ptr<Node> node = NodeList::GetNode(i);
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        int32_t ifIndex = ipv4->GetInterfaceForAddress(ipv4Address);
-        if (ifIndex != -1)
-        {
-            return node;
-        }
-    }
-    return nullptr;
+    return Ipv4L3Protocol::GetNodeWithAddress(ipv4Address);
 }
 
 bool
@@ -718,14 +707,11 @@ Ipv4Address
 DsrRouting::GetIPfromMAC(Mac48Address address)
 {
     NS_LOG_FUNCTION(this << address);
-    int32_t nNodes = NodeList::GetNNodes();
-    for (int32_t i = 0; i < nNodes; ++i)
+    Ptr<NetDevice> netDevice = NodeList::FindDevice(address);
+    if (netDevice)
     {
-        Ptr<Node> node = NodeList::GetNode(i);
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        Ptr<NetDevice> netDevice = ipv4->GetNetDevice(1);
-
-        if (netDevice->GetAddress() == address)
+        Ptr<Ipv4> ipv4 = netDevice->GetNode()->GetObject<Ipv4>();
+        if (ipv4->GetNetDevice(1) == netDevice)
         {
             return ipv4->GetAddress(1, 0).GetLocal();
         }
@@ -808,15 +794,10 @@ DsrRouting::GetProtocolNumber() const
 uint16_t
 DsrRouting::GetIDfromIP(Ipv4Address address)
 {
-    int32_t nNodes = NodeList::GetNNodes();
-    for (int32_t i = 0; i < nNodes; ++i)
+    Ptr<Node> node = Ipv4L3Protocol::GetNodeWithAddress(address);
+    if (node && node->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal() == address)
     {
-        Ptr<Node> node = NodeList::GetNode(i);
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        if (ipv4->GetAddress(1, 0).GetLocal() == address)
-        {
-            return uint16_t(i);
-        }
+        return uint16_t(node->GetId());
     }
     return 256;
 }
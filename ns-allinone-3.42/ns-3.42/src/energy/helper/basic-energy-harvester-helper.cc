@@ -40,6 +40,12 @@ BasicEnergyHarvesterHelper::Set(std::string name, const AttributeValue& v)
     m_basicEnergyHarvester.Set(name, v);
 }
 
+void
+BasicEnergyHarvesterHelper::SetHarvestDriver(Ptr<energy::EnergyHarvestDriver> driver)
+{
+    m_driver = driver;
+}
+
 Ptr<energy::EnergyHarvester>
 BasicEnergyHarvesterHelper::DoInstall(Ptr<energy::EnergySource> source) const
 {
@@ -55,6 +61,10 @@ BasicEnergyHarvesterHelper::DoInstall(Ptr<energy::EnergySource> source) const
     source->ConnectEnergyHarvester(harvester);
     harvester->SetNode(node);
     harvester->SetEnergySource(source);
+    if (m_driver)
+    {
+        m_driver->AddHarvester(DynamicCast<energy::BasicEnergyHarvester>(harvester));
+    }
     return harvester;
 }
 
@@ -23,6 +23,7 @@
 
 #include "energy-harvester-helper.h"
 
+#include "ns3/energy-harvest-driver.h"
 #include "ns3/energy-source.h"
 #include "ns3/node.h"
 
@@ -41,11 +42,18 @@ class BasicEnergyHarvesterHelper : public EnergyHarvesterHelper
 
     void Set(std::string name, const AttributeValue& v) override;
 
+    /**
+     * \param driver The driver updating the harvesters installed from now on,
+     * or nullptr for harvesters updating their power periodically.
+     */
+    void SetHarvestDriver(Ptr<energy::EnergyHarvestDriver> driver);
+
   private:
     Ptr<energy::EnergyHarvester> DoInstall(Ptr<energy::EnergySource> source) const override;
 
   private:
-    ObjectFactory m_basicEnergyHarvester; //!< Energy source factory
+    ObjectFactory m_basicEnergyHarvester;        //!< Energy source factory
+    Ptr<energy::EnergyHarvestDriver> m_driver; //!< Driver of the installed harvesters, if any
 };
 
 } // namespace ns3
@@ -69,11 +69,13 @@ BasicEnergyHarvester::GetTypeId()
 }
 
 BasicEnergyHarvester::BasicEnergyHarvester()
+    : m_driven(false)
 {
     NS_LOG_FUNCTION(this);
 }
 
 BasicEnergyHarvester::BasicEnergyHarvester(Time updateInterval)
+    : m_driven(false)
 {
     NS_LOG_FUNCTION(this << updateInterval);
     m_harvestedPowerUpdateInterval = updateInterval;
@@ -106,6 +108,38 @@ BasicEnergyHarvester::GetHarvestedPowerUpdateInterval() const
     return m_harvestedPowerUpdateInterval;
 }
 
+void
+BasicEnergyHarvester::SetHarvestDriven(bool driven)
+{
+    NS_LOG_FUNCTION(this << driven);
+    m_driven = driven;
+    if (m_driven)
+    {
+        m_energyHarvestingUpdateEvent.Cancel();
+    }
+}
+
+void
+BasicEnergyHarvester::SetHarvestedPower(double powerW)
+{
+    NS_LOG_FUNCTION(this << powerW);
+    Time duration = Simulator::Now() - m_lastHarvestingUpdateTime;
+    NS_ASSERT(duration.GetNanoSeconds() >= 0); // check if duration is valid
+
+    // update total energy harvested
+    m_totalEnergyHarvestedJ += duration.GetSeconds() * m_harvestedPower;
+
+    // notify energy source, before the power changes
+    GetEnergySource()->UpdateEnergySource();
+
+    // update last harvesting time stamp
+    m_lastHarvestingUpdateTime = Simulator::Now();
+
+    m_harvestedPower = powerW;
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S)
+                 << " BasicEnergyHarvester:Harvested energy = " << m_harvestedPower);
+}
+
 /*
  * Private functions start here.
  */
@@ -157,13 +191,17 @@ BasicEnergyHarvester::DoInitialize()
 
     m_lastHarvestingUpdateTime = Simulator::Now();
 
-    UpdateHarvestedPower(); // start periodic harvesting update
+    if (!m_driven)
+    {
+        UpdateHarvestedPower(); // start periodic harvesting update
+    }
 }
 
 void
 BasicEnergyHarvester::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_energyHarvestingUpdateEvent.Cancel();
 }
 
 void
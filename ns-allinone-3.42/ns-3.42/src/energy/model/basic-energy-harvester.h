@@ -46,6 +46,8 @@ namespace energy
  * Unit of power is chosen as Watt since energy models typically calculate
  * energy as (time in seconds * power in Watt).
  *
+ * The harvesters added to an EnergyHarvestDriver do not update their power
+ * periodically: the driver sets the power of all of them in a single event.
  */
 class BasicEnergyHarvester : public EnergyHarvester
 {
@@ -94,6 +96,22 @@ class BasicEnergyHarvester : public EnergyHarvester
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * \param driven Whether the harvested power is set by SetHarvestedPower,
+     * instead of being drawn periodically by this harvester.
+     *
+     * This function is called by EnergyHarvestDriver::AddHarvester.
+     */
+    void SetHarvestDriven(bool driven);
+
+    /**
+     * \param powerW The harvested power from now on, in Watts.
+     *
+     * This function accounts for the energy harvested with the previous power,
+     * updates the energy source and then sets the new harvested power.
+     */
+    void SetHarvestedPower(double powerW);
+
   private:
     /// Defined in ns3::Object
     void DoInitialize() override;
@@ -128,6 +146,7 @@ class BasicEnergyHarvester : public EnergyHarvester
     EventId m_energyHarvestingUpdateEvent; //!< energy harvesting event
     Time m_lastHarvestingUpdateTime;       //!< last harvesting time
     Time m_harvestedPowerUpdateInterval;   //!< harvestable energy update interval
+    bool m_driven;                         //!< whether the power is set by a harvest driver
 };
 
 } // namespace energy
@@ -20,11 +20,15 @@
 #include "basic-energy-source.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ns3
 {
 namespace energy
@@ -69,6 +73,14 @@ BasicEnergySource::GetTypeId()
                           MakeTimeAccessor(&BasicEnergySource::SetEnergyUpdateInterval,
                                            &BasicEnergySource::GetEnergyUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("AnalyticEnergyUpdate",
+                          "Integrate the remaining energy when the total current changes and "
+                          "when it is queried, and schedule a single event at the next battery "
+                          "threshold crossing, instead of updating it periodically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BasicEnergySource::SetAnalyticEnergyUpdate,
+                                              &BasicEnergySource::GetAnalyticEnergyUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource("RemainingEnergy",
                             "Remaining energy at BasicEnergySource.",
                             MakeTraceSourceAccessor(&BasicEnergySource::m_remainingEnergyJ),
@@ -81,6 +93,8 @@ BasicEnergySource::BasicEnergySource()
     NS_LOG_FUNCTION(this);
     m_lastUpdateTime = Seconds(0.0);
     m_depleted = false;
+    m_analyticUpdate = false;
+    m_totalCurrentA = 0;
 }
 
 BasicEnergySource::~BasicEnergySource()
@@ -118,6 +132,20 @@ BasicEnergySource::GetEnergyUpdateInterval() const
     return m_energyUpdateInterval;
 }
 
+void
+BasicEnergySource::SetAnalyticEnergyUpdate(bool analytic)
+{
+    NS_LOG_FUNCTION(this << analytic);
+    m_analyticUpdate = analytic;
+}
+
+bool
+BasicEnergySource::GetAnalyticEnergyUpdate() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_analyticUpdate;
+}
+
 double
 BasicEnergySource::GetSupplyVoltage() const
 {
@@ -176,7 +204,17 @@ BasicEnergySource::UpdateEnergySource()
         NotifyEnergyChanged();
     }
 
-    if (m_energyUpdateEvent.IsExpired())
+    if (m_analyticUpdate)
+    {
+        // the device models update the energy source before changing their
+        // current, so the crossing is predicted after the current event
+        if (!m_predictionEvent.IsPending())
+        {
+            m_predictionEvent =
+                Simulator::ScheduleNow(&BasicEnergySource::PredictThresholdCrossing, this);
+        }
+    }
+    else if (m_energyUpdateEvent.IsExpired())
     {
         m_energyUpdateEvent = Simulator::Schedule(m_energyUpdateInterval,
                                                   &BasicEnergySource::UpdateEnergySource,
@@ -199,6 +237,8 @@ void
 BasicEnergySource::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_energyUpdateEvent.Cancel();
+    m_predictionEvent.Cancel();
     BreakDeviceEnergyModelRefCycle(); // break reference cycle
 }
 
@@ -222,7 +262,9 @@ void
 BasicEnergySource::CalculateRemainingEnergy()
 {
     NS_LOG_FUNCTION(this);
-    double totalCurrentA = CalculateTotalCurrent();
+    // in analytic mode, the total current was sampled after the last update,
+    // as device models notify the source either before or after changing it
+    double totalCurrentA = m_analyticUpdate ? m_totalCurrentA : CalculateTotalCurrent();
     Time duration = Simulator::Now() - m_lastUpdateTime;
     NS_ASSERT(duration.IsPositive());
     // energy = current * voltage * time
@@ -232,5 +274,65 @@ BasicEnergySource::CalculateRemainingEnergy()
     NS_LOG_DEBUG("BasicEnergySource:Remaining energy = " << m_remainingEnergyJ);
 }
 
+void
+BasicEnergySource::PredictThresholdCrossing()
+{
+    NS_LOG_FUNCTION(this);
+    double totalCurrentA = CalculateTotalCurrent();
+    if (m_energyUpdateEvent.IsPending() && totalCurrentA == m_totalCurrentA)
+    {
+        return; // the crossing predicted last is still valid
+    }
+    // removed rather than cancelled, as the crossing may be years ahead
+    m_energyUpdateEvent.Remove();
+    m_totalCurrentA = totalCurrentA;
+
+    double powerW = totalCurrentA * m_supplyVoltageV;
+    double energyJ;
+    if (!m_depleted && powerW > 0)
+    {
+        energyJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+    else if (m_depleted && powerW < 0)
+    {
+        energyJ = m_highBatteryTh * m_initialEnergyJ - m_remainingEnergyJ;
+    }
+    else
+    {
+        return; // no threshold is crossed with this current
+    }
+
+    double delayS = std::max(energyJ, 0.0) / std::abs(powerW);
+    if (delayS >= (Simulator::GetMaximumSimulationTime() - Simulator::Now()).GetSeconds())
+    {
+        return;
+    }
+    NS_LOG_DEBUG("BasicEnergySource:Threshold crossed in " << delayS << " s");
+    m_energyUpdateEvent = Simulator::Schedule(Seconds(delayS) + TimeStep(1),
+                                              &BasicEnergySource::CrossThreshold,
+                                              this);
+}
+
+void
+BasicEnergySource::CrossThreshold()
+{
+    NS_LOG_FUNCTION(this);
+    CalculateRemainingEnergy();
+    m_lastUpdateTime = Simulator::Now();
+    // the crossing time was rounded up to the next time step, so the threshold
+    // can only have been missed by a rounding error
+    if (m_depleted)
+    {
+        double highEnergyJ = m_highBatteryTh * m_initialEnergyJ;
+        m_remainingEnergyJ = std::max(m_remainingEnergyJ.Get(),
+                                      std::nextafter(highEnergyJ, highEnergyJ + 1));
+    }
+    else
+    {
+        m_remainingEnergyJ = std::min(m_remainingEnergyJ.Get(), m_lowBatteryTh * m_initialEnergyJ);
+    }
+    UpdateEnergySource();
+}
+
 } // namespace energy
 } // namespace ns3
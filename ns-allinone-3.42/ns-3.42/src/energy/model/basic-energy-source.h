@@ -36,6 +36,11 @@ namespace energy
  * BasicEnergySource decreases/increases remaining energy stored in itself in
  * linearly.
  *
+ * If the AnalyticEnergyUpdate attribute is true, the remaining energy is not
+ * updated periodically: it is integrated when the total current changes and
+ * when it is queried. The time at which the remaining energy crosses the low
+ * (or, while recharging, the high) battery threshold is computed from the
+ * total current and a single event is scheduled at that time.
  */
 class BasicEnergySource : public EnergySource
 {
@@ -109,6 +114,18 @@ class BasicEnergySource : public EnergySource
      */
     Time GetEnergyUpdateInterval() const;
 
+    /**
+     * \param analytic Whether the remaining energy is integrated on demand
+     * instead of periodically.
+     */
+    void SetAnalyticEnergyUpdate(bool analytic);
+
+    /**
+     * \returns Whether the remaining energy is integrated on demand instead of
+     * periodically.
+     */
+    bool GetAnalyticEnergyUpdate() const;
+
   private:
     /// Defined in ns3::Object
     void DoInitialize() override;
@@ -141,6 +158,20 @@ class BasicEnergySource : public EnergySource
      */
     void CalculateRemainingEnergy();
 
+    /**
+     * In analytic mode, samples the total current and schedules the energy
+     * update at which the remaining energy crosses the next battery threshold
+     * with this current. This is called right after an update, once the device
+     * models have set their new current.
+     */
+    void PredictThresholdCrossing();
+
+    /**
+     * In analytic mode, updates the remaining energy at the predicted battery
+     * threshold crossing.
+     */
+    void CrossThreshold();
+
   private:
     double m_initialEnergyJ; //!< initial energy, in Joules
     double m_supplyVoltageV; //!< supply voltage, in Volts
@@ -155,6 +186,9 @@ class BasicEnergySource : public EnergySource
     EventId m_energyUpdateEvent;            //!< energy update event
     Time m_lastUpdateTime;                  //!< last update time
     Time m_energyUpdateInterval;            //!< energy update interval
+    bool m_analyticUpdate;                  //!< whether the energy is integrated on demand
+    EventId m_predictionEvent;              //!< event predicting the next threshold crossing
+    double m_totalCurrentA;                 //!< total current sampled after the last update
 };
 
 } // namespace energy
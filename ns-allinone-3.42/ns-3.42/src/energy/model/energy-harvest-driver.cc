@@ -0,0 +1,322 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "energy-harvest-driver.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+namespace energy
+{
+
+NS_LOG_COMPONENT_DEFINE("EnergyHarvestDriver");
+NS_OBJECT_ENSURE_REGISTERED(EnergyHarvestDriver);
+
+namespace
+{
+/// Magic string at the start of a power profile file
+const char PROFILE_MAGIC[8] = {'N', 'S', '3', 'H', 'A', 'R', 'V', '1'};
+/// Size of the magic string, of the sample count and of the padding
+const size_t PROFILE_HEADER_SIZE = sizeof(PROFILE_MAGIC) + 2 * sizeof(uint32_t);
+} // namespace
+
+TypeId
+EnergyHarvestDriver::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::EnergyHarvestDriver")
+            .SetParent<Object>()
+            .SetGroupName("Energy")
+            .AddConstructor<EnergyHarvestDriver>()
+            .AddAttribute("UpdateInterval",
+                          "Time between two consecutive updates of the harvested power of all "
+                          "the harvesters.",
+                          TimeValue(Seconds(1.0)),
+                          MakeTimeAccessor(&EnergyHarvestDriver::m_updateInterval),
+                          MakeTimeChecker())
+            .AddAttribute("HarvestablePower",
+                          "The harvestable power [Watts] drawn for each harvester at each update, "
+                          "scaling the power profile if one is loaded.",
+                          StringValue("ns3::UniformRandomVariable[Min=0.0|Max=2.0]"),
+                          MakePointerAccessor(&EnergyHarvestDriver::m_harvestablePower),
+                          MakePointerChecker<RandomVariableStream>());
+    return tid;
+}
+
+EnergyHarvestDriver::EnergyHarvestDriver()
+    : m_profile(nullptr),
+      m_profileSize(0),
+      m_profileIndex(0),
+      m_mapping(nullptr),
+      m_mappingSize(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+EnergyHarvestDriver::~EnergyHarvestDriver()
+{
+    NS_LOG_FUNCTION(this);
+    ReleaseProfile();
+}
+
+void
+EnergyHarvestDriver::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_updateEvent.Cancel();
+    m_harvesters.clear();
+    m_harvestablePower = nullptr;
+    ReleaseProfile();
+}
+
+void
+EnergyHarvestDriver::AddHarvester(Ptr<BasicEnergyHarvester> harvester)
+{
+    NS_LOG_FUNCTION(this << harvester);
+    NS_ASSERT(harvester);
+    harvester->SetHarvestDriven(true);
+    m_harvesters.push_back(harvester);
+    if (!m_updateEvent.IsPending())
+    {
+        m_updateEvent = Simulator::ScheduleNow(&EnergyHarvestDriver::Update, this);
+    }
+}
+
+uint32_t
+EnergyHarvestDriver::GetNHarvesters() const
+{
+    return m_harvesters.size();
+}
+
+int64_t
+EnergyHarvestDriver::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_harvestablePower->SetStream(stream);
+    return 1;
+}
+
+void
+EnergyHarvestDriver::Update()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_DEBUG(Simulator::Now().As(Time::S)
+                 << " EnergyHarvestDriver: Updating " << m_harvesters.size() << " harvesters.");
+
+    // do not update if simulation has finished
+    if (Simulator::IsFinished())
+    {
+        return;
+    }
+
+    m_samples.resize(m_harvesters.size());
+    m_harvestablePower->GetValues(m_samples);
+    double scale = GetProfileValue(Simulator::Now());
+    for (size_t i = 0; i < m_harvesters.size(); i++)
+    {
+        m_harvesters[i]->SetHarvestedPower(scale * m_samples[i]);
+    }
+
+    m_updateEvent = Simulator::Schedule(m_updateInterval, &EnergyHarvestDriver::Update, this);
+}
+
+double
+EnergyHarvestDriver::GetProfileValue(Time time)
+{
+    if (!m_profile)
+    {
+        return 1;
+    }
+    double t = time.GetSeconds();
+    if (m_profileIndex > 0 && m_profile[2 * m_profileIndex] > t)
+    {
+        m_profileIndex = 0; // time went back, restart the lookup
+    }
+    while (m_profileIndex + 1 < m_profileSize && m_profile[2 * (m_profileIndex + 1)] <= t)
+    {
+        m_profileIndex++;
+    }
+    const double* sample = m_profile + 2 * m_profileIndex;
+    if (m_profileIndex + 1 == m_profileSize || t <= sample[0])
+    {
+        return sample[1]; // before the first sample or after the last one
+    }
+    double ratio = (t - sample[0]) / (sample[2] - sample[0]);
+    return sample[1] + ratio * (sample[3] - sample[1]);
+}
+
+bool
+EnergyHarvestDriver::Attach(const uint8_t* data, size_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    if (size < PROFILE_HEADER_SIZE || std::memcmp(data, PROFILE_MAGIC, sizeof(PROFILE_MAGIC)) != 0)
+    {
+        return false;
+    }
+    uint32_t count;
+    std::memcpy(&count, data + sizeof(PROFILE_MAGIC), sizeof(count));
+    if (count == 0 || size != PROFILE_HEADER_SIZE + 2 * size_t(count) * sizeof(double))
+    {
+        return false;
+    }
+    const auto samples = reinterpret_cast<const double*>(data + PROFILE_HEADER_SIZE);
+    for (uint32_t i = 1; i < count; i++)
+    {
+        if (!(samples[2 * i] > samples[2 * (i - 1)]))
+        {
+            return false;
+        }
+    }
+    m_profile = samples;
+    m_profileSize = count;
+    m_profileIndex = 0;
+    return true;
+}
+
+void
+EnergyHarvestDriver::ReleaseProfile()
+{
+#ifndef __WIN32__
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_profile = nullptr;
+    m_profileSize = 0;
+    m_profileIndex = 0;
+}
+
+bool
+EnergyHarvestDriver::LoadPowerProfile(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    ReleaseProfile();
+
+#ifndef __WIN32__
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NS_LOG_WARN("Can not map " << filename);
+        return false;
+    }
+    m_mapping = mapping;
+    m_mappingSize = size;
+    if (!Attach(static_cast<const uint8_t*>(mapping), size))
+    {
+        NS_LOG_WARN(filename << " is not a valid power profile");
+        ReleaseProfile();
+        return false;
+    }
+#else
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+    {
+        return false;
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (!Attach(m_buffer.data(), m_buffer.size()))
+    {
+        NS_LOG_WARN(filename << " is not a valid power profile");
+        ReleaseProfile();
+        return false;
+    }
+#endif
+    NS_LOG_INFO("Loaded " << m_profileSize << " power profile samples from " << filename);
+    return true;
+}
+
+bool
+EnergyHarvestDriver::WritePowerProfile(const std::string& filename,
+                                       const std::vector<double>& timesS,
+                                       const std::vector<double>& values)
+{
+    NS_LOG_FUNCTION(filename);
+    NS_ASSERT_MSG(!timesS.empty() && timesS.size() == values.size(),
+                  "A power profile needs as many times as values");
+
+    std::ostringstream tmpName;
+    tmpName << filename << ".tmp";
+#ifndef __WIN32__
+    tmpName << getpid();
+#endif
+    {
+        std::ofstream out(tmpName.str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            NS_LOG_WARN("Can not open " << tmpName.str());
+            return false;
+        }
+        uint32_t header[2] = {static_cast<uint32_t>(timesS.size()), 0};
+        out.write(PROFILE_MAGIC, sizeof(PROFILE_MAGIC));
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        for (size_t i = 0; i < timesS.size(); i++)
+        {
+            double sample[2] = {timesS[i], values[i]};
+            out.write(reinterpret_cast<const char*>(sample), sizeof(sample));
+        }
+        if (!out.good())
+        {
+            NS_LOG_WARN("Error while writing " << tmpName.str());
+            std::remove(tmpName.str().c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpName.str().c_str(), filename.c_str()) != 0)
+    {
+        NS_LOG_WARN("Can not rename " << tmpName.str() << " to " << filename);
+        std::remove(tmpName.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace energy
+} // namespace ns3
@@ -0,0 +1,153 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ENERGY_HARVEST_DRIVER_H
+#define ENERGY_HARVEST_DRIVER_H
+
+#include "basic-energy-harvester.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+namespace energy
+{
+
+/**
+ * \ingroup energy
+ * \brief Updates the harvested power of many BasicEnergyHarvester objects in
+ * a single event.
+ *
+ * Each BasicEnergyHarvester normally schedules its own update every
+ * PeriodicHarvestedPowerUpdateInterval and draws one value from its own
+ * random variable. The harvesters added to an EnergyHarvestDriver are instead
+ * updated together every UpdateInterval, by one event drawing the powers of
+ * all of them from the HarvestablePower random variable of the driver in a
+ * single batch.
+ *
+ * If a power profile is loaded, the power of each harvester is the value of
+ * the profile at the current time, linearly interpolated between its samples,
+ * scaled by the value drawn for the harvester. A power profile (for example
+ * an irradiance profile) is a binary file of (time, value) samples written by
+ * WritePowerProfile, and is memory-mapped when the platform supports it.
+ */
+class EnergyHarvestDriver : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    EnergyHarvestDriver();
+    ~EnergyHarvestDriver() override;
+
+    /**
+     * Updates the harvested power of a harvester from now on, instead of its
+     * periodic updates. The harvester gets its first power at the next update
+     * of the driver.
+     *
+     * \param harvester the harvester
+     */
+    void AddHarvester(Ptr<BasicEnergyHarvester> harvester);
+
+    /**
+     * \returns The number of harvesters updated by the driver.
+     */
+    uint32_t GetNHarvesters() const;
+
+    /**
+     * Loads a power profile written by WritePowerProfile.
+     *
+     * \param filename the name of the profile file
+     * \return true if the file holds a valid profile, false otherwise
+     */
+    bool LoadPowerProfile(const std::string& filename);
+
+    /**
+     * Writes a power profile.
+     *
+     * \param filename the name of the profile file
+     * \param timesS the times of the samples, in seconds, in increasing order
+     * \param values the values of the samples
+     * \return true if the profile was written, false otherwise
+     */
+    static bool WritePowerProfile(const std::string& filename,
+                                  const std::vector<double>& timesS,
+                                  const std::vector<double>& values);
+
+    /**
+     * \param time the time, which should not decrease between calls
+     * \returns The value of the power profile at the given time, or 1 if no
+     * profile is loaded.
+     */
+    double GetProfileValue(Time time);
+
+    /**
+     * \param stream Random variable stream number.
+     * \returns The number of stream indices assigned by this model.
+     *
+     * This function sets the stream number to be used by the random variable that
+     * determines the amount of power that can be harvested by the harvesters.
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  private:
+    /// Defined in ns3::Object
+    void DoDispose() override;
+
+    /**
+     * Draws the harvested powers and sets them to the harvesters. This function
+     * is called every m_updateInterval.
+     */
+    void Update();
+
+    /**
+     * Uses a power profile image.
+     *
+     * \param data the image
+     * \param size the size of the image, in bytes
+     * \return true if the image holds a valid profile
+     */
+    bool Attach(const uint8_t* data, size_t size);
+
+    /// Releases the power profile
+    void ReleaseProfile();
+
+    std::vector<Ptr<BasicEnergyHarvester>> m_harvesters; //!< harvesters updated by the driver
+    std::vector<double> m_samples;                       //!< powers drawn at the last update
+    Ptr<RandomVariableStream> m_harvestablePower; //!< random variable for the harvestable power
+    Time m_updateInterval;                        //!< harvested power update interval
+    EventId m_updateEvent;                        //!< harvested power update event
+
+    const double* m_profile;       //!< (time, value) samples of the power profile, if any
+    uint32_t m_profileSize;        //!< number of samples in the power profile
+    uint32_t m_profileIndex;       //!< last sample not after the time of the last lookup
+    std::vector<uint8_t> m_buffer; //!< profile image read without mmap
+    void* m_mapping;               //!< memory-mapped profile image, if any
+    size_t m_mappingSize;          //!< size of the mapped image
+};
+
+} // namespace energy
+} // namespace ns3
+
+#endif /* ENERGY_HARVEST_DRIVER_H */
@@ -20,11 +20,13 @@
 #include "li-ion-energy-source.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace ns3
@@ -106,6 +108,15 @@ LiIonEnergySource::GetTypeId()
                           MakeTimeAccessor(&LiIonEnergySource::SetEnergyUpdateInterval,
                                            &LiIonEnergySource::GetEnergyUpdateInterval),
                           MakeTimeChecker())
+            .AddAttribute("AnalyticEnergyUpdate",
+                          "Integrate the discharge curve when the total current changes and "
+                          "when the remaining energy is queried, and schedule a single event at "
+                          "the low battery threshold crossing, instead of updating it "
+                          "periodically.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LiIonEnergySource::SetAnalyticEnergyUpdate,
+                                              &LiIonEnergySource::GetAnalyticEnergyUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource("RemainingEnergy",
                             "Remaining energy at BasicEnergySource.",
                             MakeTraceSourceAccessor(&LiIonEnergySource::m_remainingEnergyJ),
@@ -115,7 +126,9 @@ LiIonEnergySource::GetTypeId()
 
 LiIonEnergySource::LiIonEnergySource()
     : m_drainedCapacity(0.0),
-      m_lastUpdateTime(Seconds(0.0))
+      m_lastUpdateTime(Seconds(0.0)),
+      m_analyticUpdate(false),
+      m_totalCurrentA(0.0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -171,6 +184,20 @@ LiIonEnergySource::GetEnergyUpdateInterval() const
     return m_energyUpdateInterval;
 }
 
+void
+LiIonEnergySource::SetAnalyticEnergyUpdate(bool analytic)
+{
+    NS_LOG_FUNCTION(this << analytic);
+    m_analyticUpdate = analytic;
+}
+
+bool
+LiIonEnergySource::GetAnalyticEnergyUpdate() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_analyticUpdate;
+}
+
 double
 LiIonEnergySource::GetRemainingEnergy()
 {
@@ -223,7 +250,10 @@ LiIonEnergySource::UpdateEnergySource()
         return;
     }
 
-    m_energyUpdateEvent.Cancel();
+    if (!m_analyticUpdate)
+    {
+        m_energyUpdateEvent.Cancel();
+    }
 
     CalculateRemainingEnergy();
 
@@ -231,10 +261,23 @@ LiIonEnergySource::UpdateEnergySource()
 
     if (m_remainingEnergyJ <= m_lowBatteryTh * m_initialEnergyJ)
     {
+        m_energyUpdateEvent.Cancel();
         HandleEnergyDrainedEvent();
         return; // stop periodic update
     }
 
+    if (m_analyticUpdate)
+    {
+        // the device models update the energy source before changing their
+        // current, so the crossing is predicted after the current event
+        if (!m_predictionEvent.IsPending())
+        {
+            m_predictionEvent =
+                Simulator::ScheduleNow(&LiIonEnergySource::PredictThresholdCrossing, this);
+        }
+        return;
+    }
+
     m_energyUpdateEvent =
         Simulator::Schedule(m_energyUpdateInterval, &LiIonEnergySource::UpdateEnergySource, this);
 }
@@ -253,6 +296,8 @@ void
 LiIonEnergySource::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_energyUpdateEvent.Cancel();
+    m_predictionEvent.Cancel();
     BreakDeviceEnergyModelRefCycle(); // break reference cycle
 }
 
@@ -268,11 +313,26 @@ void
 LiIonEnergySource::CalculateRemainingEnergy()
 {
     NS_LOG_FUNCTION(this);
-    double totalCurrentA = CalculateTotalCurrent();
+    // in analytic mode, the total current was sampled after the last update,
+    // as device models notify the source either before or after changing it
+    double totalCurrentA = m_analyticUpdate ? m_totalCurrentA : CalculateTotalCurrent();
     Time duration = Simulator::Now() - m_lastUpdateTime;
     NS_ASSERT(duration.GetSeconds() >= 0);
-    // energy = current * voltage * time
-    double energyToDecreaseJ = totalCurrentA * m_supplyVoltageV * duration.GetSeconds();
+    double energyToDecreaseJ;
+    if (m_analyticUpdate)
+    {
+        // energy = integral of current * voltage over the discharge curve
+        double drainedCapacity = m_drainedCapacity + (totalCurrentA * duration).GetHours();
+        energyToDecreaseJ =
+            drainedCapacity < m_qRated
+                ? GetDischargeEnergy(m_drainedCapacity, drainedCapacity, totalCurrentA)
+                : m_remainingEnergyJ.Get();
+    }
+    else
+    {
+        // energy = current * voltage * time
+        energyToDecreaseJ = totalCurrentA * m_supplyVoltageV * duration.GetSeconds();
+    }
 
     if (m_remainingEnergyJ < energyToDecreaseJ)
     {
@@ -293,22 +353,18 @@ double
 LiIonEnergySource::GetVoltage(double i) const
 {
     NS_LOG_FUNCTION(this << i);
-
     // integral of i in dt, drained capacity in Ah
-    double it = m_drainedCapacity;
-
-    // empirical factors
-    double A = m_eFull - m_eExp;
-    double B = 3 / m_qExp;
+    return GetVoltage(i, m_drainedCapacity);
+}
 
-    // slope of the polarization curve
-    double K = std::abs((m_eFull - m_eNom + A * (std::exp(-B * m_qNom) - 1)) * (m_qRated - m_qNom) /
-                        m_qNom);
+double
+LiIonEnergySource::GetVoltage(double i, double it) const
+{
+    NS_LOG_FUNCTION(this << i << it);
 
-    // constant voltage
-    double E0 = m_eFull + K + m_internalResistance * m_typCurrent - A;
+    DischargeCurve curve = GetDischargeCurve();
 
-    double E = E0 - K * m_qRated / (m_qRated - it) + A * std::exp(-B * it);
+    double E = curve.e0 - curve.k * m_qRated / (m_qRated - it) + curve.a * std::exp(-curve.b * it);
 
     // cell voltage
     double V = E - m_internalResistance * i;
@@ -318,5 +374,119 @@ LiIonEnergySource::GetVoltage(double i) const
     return V;
 }
 
+LiIonEnergySource::DischargeCurve
+LiIonEnergySource::GetDischargeCurve() const
+{
+    DischargeCurve curve;
+
+    // empirical factors
+    curve.a = m_eFull - m_eExp;
+    curve.b = 3 / m_qExp;
+
+    // slope of the polarization curve
+    curve.k = std::abs((m_eFull - m_eNom + curve.a * (std::exp(-curve.b * m_qNom) - 1)) *
+                       (m_qRated - m_qNom) / m_qNom);
+
+    // constant voltage
+    curve.e0 = m_eFull + curve.k + m_internalResistance * m_typCurrent - curve.a;
+
+    return curve;
+}
+
+double
+LiIonEnergySource::GetDischargeEnergy(double fromAh, double toAh, double i) const
+{
+    NS_LOG_FUNCTION(this << fromAh << toAh << i);
+    NS_ASSERT(fromAh < m_qRated && toAh < m_qRated);
+
+    DischargeCurve curve = GetDischargeCurve();
+
+    // i dt = 3600 d(it), so the energy is 3600 times the integral of the cell
+    // voltage over the drained capacity
+    double constant = (curve.e0 - m_internalResistance * i) * (toAh - fromAh);
+    double polarization = curve.k * m_qRated * std::log((m_qRated - fromAh) / (m_qRated - toAh));
+    double exponential =
+        curve.a / curve.b * (std::exp(-curve.b * fromAh) - std::exp(-curve.b * toAh));
+
+    return 3600 * (constant - polarization + exponential);
+}
+
+void
+LiIonEnergySource::PredictThresholdCrossing()
+{
+    NS_LOG_FUNCTION(this);
+    double currentA = CalculateTotalCurrent();
+    if (m_energyUpdateEvent.IsPending() && currentA == m_totalCurrentA)
+    {
+        return; // the crossing predicted last is still valid
+    }
+    // removed rather than cancelled, as the crossing may be years ahead
+    m_energyUpdateEvent.Remove();
+    m_totalCurrentA = currentA;
+    if (currentA <= 0 || GetVoltage(currentA) <= 0)
+    {
+        return;
+    }
+
+    // the energy drawn grows with the drained capacity until the cell voltage
+    // reaches zero, just before the rated capacity
+    double lowAh = m_drainedCapacity;
+    double highAh = m_qRated;
+    for (int n = 0; n < 64; n++)
+    {
+        double ah = (lowAh + highAh) / 2;
+        if (GetVoltage(currentA, ah) > 0)
+        {
+            lowAh = ah;
+        }
+        else
+        {
+            highAh = ah;
+        }
+    }
+    double energyJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    if (GetDischargeEnergy(m_drainedCapacity, lowAh, currentA) < energyJ)
+    {
+        return; // the voltage collapses before the threshold is reached
+    }
+
+    highAh = lowAh;
+    lowAh = m_drainedCapacity;
+    for (int n = 0; n < 64; n++)
+    {
+        double ah = (lowAh + highAh) / 2;
+        if (GetDischargeEnergy(m_drainedCapacity, ah, currentA) < energyJ)
+        {
+            lowAh = ah;
+        }
+        else
+        {
+            highAh = ah;
+        }
+    }
+
+    double delayS = (highAh - m_drainedCapacity) / currentA * 3600;
+    if (delayS >= (Simulator::GetMaximumSimulationTime() - Simulator::Now()).GetSeconds())
+    {
+        return;
+    }
+    NS_LOG_DEBUG("LiIonEnergySource:Threshold crossed in " << delayS << " s");
+    m_energyUpdateEvent = Simulator::Schedule(Seconds(delayS) + TimeStep(1),
+                                              &LiIonEnergySource::CrossThreshold,
+                                              this);
+}
+
+void
+LiIonEnergySource::CrossThreshold()
+{
+    NS_LOG_FUNCTION(this);
+    CalculateRemainingEnergy();
+    m_lastUpdateTime = Simulator::Now();
+    // the crossing time was rounded up to the next time step, so the threshold
+    // can only have been missed by a rounding error
+    m_remainingEnergyJ = std::min(m_remainingEnergyJ.Get(), m_lowBatteryTh * m_initialEnergyJ);
+    UpdateEnergySource();
+}
+
 } // namespace energy
 } // namespace ns3
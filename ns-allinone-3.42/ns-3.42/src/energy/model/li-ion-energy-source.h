@@ -51,6 +51,13 @@ namespace energy
  * If the actual voltage of the cell goes below the minimum threshold voltage, the
  * cell is considered depleted and the energy drained event fired up.
  *
+ * If the AnalyticEnergyUpdate attribute is true, the cell is not updated
+ * periodically: the energy drawn between two changes of the total current is
+ * the closed-form integral of the discharge curve, evaluated when the current
+ * changes and when the remaining energy is queried. The time at which the
+ * remaining energy reaches the low battery threshold is solved from the same
+ * integral and a single event is scheduled at that time.
+ *
  *
  * The model requires several parameters to approximates the discharge curves:
  * - InitialCellVoltage, maximum voltage of the fully charged cell
@@ -166,7 +173,30 @@ class LiIonEnergySource : public EnergySource
      */
     Time GetEnergyUpdateInterval() const;
 
+    /**
+     * \param analytic Whether the remaining energy is integrated on demand
+     * instead of periodically.
+     */
+    void SetAnalyticEnergyUpdate(bool analytic);
+
+    /**
+     * \returns Whether the remaining energy is integrated on demand instead of
+     * periodically.
+     */
+    bool GetAnalyticEnergyUpdate() const;
+
   private:
+    /**
+     * Parameters of the discharge curve, derived from the cell attributes.
+     */
+    struct DischargeCurve
+    {
+        double e0; //!< constant voltage, in Volts
+        double k;  //!< slope of the polarization curve, in Volts
+        double a;  //!< voltage drop over the exponential zone, in Volts
+        double b;  //!< inverse of the exponential zone time constant, in 1/Ah
+    };
+
     void DoInitialize() override;
     void DoDispose() override;
 
@@ -197,6 +227,46 @@ class LiIonEnergySource : public EnergySource
      */
     double GetVoltage(double current) const;
 
+    /**
+     * Get the cell voltage for a given discharge current and drained capacity.
+     *
+     * \param current the discharge current value.
+     * \param drainedCapacity the capacity drained from the cell, in Ah.
+     * \return the cell voltage
+     */
+    double GetVoltage(double current, double drainedCapacity) const;
+
+    /**
+     * \returns The parameters of the discharge curve.
+     */
+    DischargeCurve GetDischargeCurve() const;
+
+    /**
+     * Integrates the energy drawn from the cell at a constant current, while
+     * the drained capacity goes from one value to another.
+     *
+     * \param fromAh the drained capacity at the start, in Ah
+     * \param toAh the drained capacity at the end, in Ah
+     * \param current the discharge current, in A
+     * \return the energy drawn, in Joules
+     */
+    double GetDischargeEnergy(double fromAh, double toAh, double current) const;
+
+    /**
+     * In analytic mode, samples the total current and schedules the energy
+     * update at which the remaining energy reaches the low battery threshold
+     * with this current.
+     * This is called right after an update, once the device models have set
+     * their new current.
+     */
+    void PredictThresholdCrossing();
+
+    /**
+     * In analytic mode, updates the remaining energy at the predicted low
+     * battery threshold crossing.
+     */
+    void CrossThreshold();
+
   private:
     double m_initialEnergyJ;                //!< initial energy, in Joules
     TracedValue<double> m_remainingEnergyJ; //!< remaining energy, in Joules
@@ -215,6 +285,9 @@ class LiIonEnergySource : public EnergySource
     double m_qExp;               //!< capacity value at the end of the exponential zone, in Ah
     double m_typCurrent;         //!< typical discharge current used to fit the curves
     double m_minVoltTh;          //!< minimum threshold voltage to consider the battery depleted
+    bool m_analyticUpdate;       //!< whether the energy is integrated on demand
+    EventId m_predictionEvent;   //!< event predicting the low battery threshold crossing
+    double m_totalCurrentA;      //!< total current sampled after the last update
 };
 
 } // namespace energy
@@ -22,6 +22,7 @@
 #include "ns3/basic-energy-source.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/energy-harvest-driver.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/simulator.h"
@@ -122,6 +123,119 @@ BasicEnergyHarvesterTestCase::DoRun()
                               "Incorrect Remaining energy!");
 }
 
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Energy harvest driver test
+ */
+class EnergyHarvestDriverTestCase : public TestCase
+{
+  public:
+    EnergyHarvestDriverTestCase();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Checks the harvested powers drawn in a batch at the first update
+     * \param harvesters the harvesters
+     * \param reference a random variable drawing the same values as the driver
+     */
+    void CheckBatch(std::vector<Ptr<BasicEnergyHarvester>> harvesters,
+                    Ptr<UniformRandomVariable> reference);
+};
+
+EnergyHarvestDriverTestCase::EnergyHarvestDriverTestCase()
+    : TestCase("Energy harvest driver test case")
+{
+}
+
+void
+EnergyHarvestDriverTestCase::CheckBatch(std::vector<Ptr<BasicEnergyHarvester>> harvesters,
+                                        Ptr<UniformRandomVariable> reference)
+{
+    for (const auto& harvester : harvesters)
+    {
+        NS_TEST_ASSERT_MSG_EQ(harvester->GetPower(),
+                              reference->GetValue(),
+                              "The harvested power was not drawn from the driver stream");
+    }
+}
+
+void
+EnergyHarvestDriverTestCase::DoRun()
+{
+    std::string profile = CreateTempDirFilename("power-profile.bin");
+    // the power grows linearly from 0 W at 0 s to 2 W at 10 s
+    NS_TEST_ASSERT_MSG_EQ(EnergyHarvestDriver::WritePowerProfile(profile, {0, 10}, {0, 2}),
+                          true,
+                          "Can not write the power profile");
+
+    Ptr<EnergyHarvestDriver> profileDriver = CreateObject<EnergyHarvestDriver>();
+    profileDriver->SetAttribute("HarvestablePower",
+                                StringValue("ns3::ConstantRandomVariable[Constant=1.0]"));
+    NS_TEST_ASSERT_MSG_EQ(profileDriver->LoadPowerProfile(profile),
+                          true,
+                          "Can not load the power profile");
+    Ptr<EnergyHarvestDriver> batchDriver = CreateObject<EnergyHarvestDriver>();
+    batchDriver->AssignStreams(7);
+    Ptr<UniformRandomVariable> reference = CreateObject<UniformRandomVariable>();
+    reference->SetAttribute("Max", DoubleValue(2.0));
+    reference->SetStream(7);
+
+    std::vector<Ptr<BasicEnergySource>> sources;
+    std::vector<Ptr<BasicEnergyHarvester>> batchHarvesters;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        Ptr<Node> node = CreateObject<Node>();
+        Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource>();
+        node->AggregateObject(source);
+        source->SetNode(node);
+        Ptr<BasicEnergyHarvester> harvester = CreateObject<BasicEnergyHarvester>();
+        source->ConnectEnergyHarvester(harvester);
+        harvester->SetNode(node);
+        harvester->SetEnergySource(source);
+        if (i < 3)
+        {
+            profileDriver->AddHarvester(harvester);
+            sources.push_back(source);
+        }
+        else
+        {
+            batchDriver->AddHarvester(harvester);
+            batchHarvesters.push_back(harvester);
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(profileDriver->GetNHarvesters(), 3, "Incorrect number of harvesters");
+
+    Simulator::Schedule(Seconds(0.5),
+                        &EnergyHarvestDriverTestCase::CheckBatch,
+                        this,
+                        batchHarvesters,
+                        reference);
+    Simulator::Stop(Seconds(10.5));
+    Simulator::Run();
+
+    // 0.2 k W over [k, k + 1) s, then 2 W over the last 0.5 s
+    double estRemainingEnergy = 10 + 0.2 * 45 + 2 * 0.5;
+    for (const auto& source : sources)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(source->GetRemainingEnergy(),
+                                  estRemainingEnergy,
+                                  1.0e-9,
+                                  "Incorrect remaining energy");
+    }
+    NS_TEST_ASSERT_MSG_EQ_TOL(profileDriver->GetProfileValue(Seconds(2.5)),
+                              0.5,
+                              1.0e-12,
+                              "Incorrect interpolated profile value");
+    NS_TEST_ASSERT_MSG_EQ(profileDriver->GetProfileValue(Seconds(20)),
+                          2,
+                          "Incorrect profile value after the last sample");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup energy-tests
  *
@@ -137,6 +251,7 @@ BasicEnergyHarvesterTestSuite::BasicEnergyHarvesterTestSuite()
     : TestSuite("basic-energy-harvester", Type::UNIT)
 {
     AddTestCase(new BasicEnergyHarvesterTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new EnergyHarvestDriverTestCase, TestCase::Duration::QUICK);
 }
 
 /// create an instance of the test suite
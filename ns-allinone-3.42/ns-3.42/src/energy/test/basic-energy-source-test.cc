@@ -0,0 +1,153 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/basic-energy-source.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/simple-device-energy-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+using namespace ns3::energy;
+
+NS_LOG_COMPONENT_DEFINE("BasicEnergySourceTestSuite");
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Device energy model recording when the source is drained and recharged
+ */
+class RecordingDeviceEnergyModel : public SimpleDeviceEnergyModel
+{
+  public:
+    void HandleEnergyDepletion() override
+    {
+        m_drainedTime = Simulator::Now();
+    }
+
+    void HandleEnergyRecharged() override
+    {
+        m_rechargedTime = Simulator::Now();
+    }
+
+    Time m_drainedTime;   //!< time the source notified the energy drained
+    Time m_rechargedTime; //!< time the source notified the energy recharged
+};
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Basic energy source in analytic update mode
+ */
+class BasicEnergySourceAnalyticTestCase : public TestCase
+{
+  public:
+    BasicEnergySourceAnalyticTestCase();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Checks the remaining energy of the source
+     * \param source the energy source
+     * \param energyJ the expected remaining energy, in Joules
+     */
+    void CheckRemainingEnergy(Ptr<BasicEnergySource> source, double energyJ);
+};
+
+BasicEnergySourceAnalyticTestCase::BasicEnergySourceAnalyticTestCase()
+    : TestCase("Basic energy source analytic update")
+{
+}
+
+void
+BasicEnergySourceAnalyticTestCase::CheckRemainingEnergy(Ptr<BasicEnergySource> source,
+                                                        double energyJ)
+{
+    NS_TEST_ASSERT_MSG_EQ_TOL(source->GetRemainingEnergy(),
+                              energyJ,
+                              1.0e-9,
+                              "Incorrect remaining energy at " << Simulator::Now().As(Time::S));
+}
+
+void
+BasicEnergySourceAnalyticTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource>();
+    source->SetAttribute("BasicEnergySourceInitialEnergyJ", DoubleValue(10));
+    source->SetAttribute("BasicEnergySupplyVoltageV", DoubleValue(3));
+    source->SetAttribute("AnalyticEnergyUpdate", BooleanValue(true));
+    source->SetNode(node);
+    node->AggregateObject(source);
+
+    Ptr<RecordingDeviceEnergyModel> device = CreateObject<RecordingDeviceEnergyModel>();
+    device->SetEnergySource(source);
+    source->AppendDeviceEnergyModel(device);
+
+    // 0.03 W for 100.5 s, then 0.3 W: the 9 J above the low threshold are
+    // drawn at 120.45 s
+    device->SetCurrentA(0.01);
+    Simulator::Schedule(Seconds(100.5), &SimpleDeviceEnergyModel::SetCurrentA, device, 0.1);
+    Simulator::Schedule(Seconds(110),
+                        &BasicEnergySourceAnalyticTestCase::CheckRemainingEnergy,
+                        this,
+                        source,
+                        10 - 0.03 * 100.5 - 0.3 * 9.5);
+    // a negative current charges the source back to the high threshold
+    Simulator::Schedule(Seconds(121), &SimpleDeviceEnergyModel::SetCurrentA, device, -0.1);
+
+    Simulator::Stop(Seconds(200));
+    Simulator::Run();
+    uint64_t eventCount = Simulator::GetEventCount();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ_TOL(device->m_drainedTime.GetSeconds(),
+                              120.45,
+                              1.0e-6,
+                              "Incorrect energy drained time");
+    // 1 J left at 120.45 s, 0.835 J at 121 s, then 0.3 W up to 1.5 J
+    NS_TEST_ASSERT_MSG_EQ_TOL(device->m_rechargedTime.GetSeconds(),
+                              121 + 0.665 / 0.3,
+                              1.0e-6,
+                              "Incorrect energy recharged time");
+    // three current changes and a query, each followed by a prediction, and
+    // two threshold crossings each followed by a prediction, without any
+    // periodic update
+    NS_TEST_ASSERT_MSG_LT(eventCount, 15, "Periodic energy updates were scheduled");
+}
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Basic energy source TestSuite
+ */
+class BasicEnergySourceTestSuite : public TestSuite
+{
+  public:
+    BasicEnergySourceTestSuite();
+};
+
+BasicEnergySourceTestSuite::BasicEnergySourceTestSuite()
+    : TestSuite("basic-energy-source", Type::UNIT)
+{
+    AddTestCase(new BasicEnergySourceAnalyticTestCase, TestCase::Duration::QUICK);
+}
+
+/// create an instance of the test suite
+static BasicEnergySourceTestSuite g_basicEnergySourceTestSuite;
@@ -17,6 +17,7 @@
  * Author: Andrea Sacco <andrea.sacco85@gmail.com>
  */
 
+#include "ns3/boolean.h"
 #include "ns3/li-ion-energy-source.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
@@ -81,6 +82,110 @@ LiIonEnergyTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(es->GetSupplyVoltage(), 3.6, 1.0e-3, "Incorrect consumed energy!");
 }
 
+/**
+ * \ingroup energy-tests
+ *
+ * \brief Device energy model recording when the source is drained
+ */
+class DrainRecordingDeviceEnergyModel : public SimpleDeviceEnergyModel
+{
+  public:
+    void HandleEnergyDepletion() override
+    {
+        m_drainedTime = Simulator::Now();
+    }
+
+    Time m_drainedTime; //!< time the source notified the energy drained
+};
+
+/**
+ * \ingroup energy-tests
+ *
+ * \brief LiIon battery in analytic update mode, compared with fine periodic updates
+ */
+class LiIonEnergyAnalyticTestCase : public TestCase
+{
+  public:
+    LiIonEnergyAnalyticTestCase();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Creates a source discharging at 2.33 A on a new node
+     * \param analytic whether the source is in analytic update mode
+     * \return the device drawing from the source
+     */
+    Ptr<DrainRecordingDeviceEnergyModel> CreateDischarge(bool analytic);
+
+    /**
+     * Checks that the remaining energy of both sources match
+     * \param analytic the source in analytic update mode
+     * \param periodic the source with periodic updates
+     */
+    void CheckRemainingEnergy(Ptr<LiIonEnergySource> analytic, Ptr<LiIonEnergySource> periodic);
+};
+
+LiIonEnergyAnalyticTestCase::LiIonEnergyAnalyticTestCase()
+    : TestCase("Li-Ion energy source analytic update")
+{
+}
+
+Ptr<DrainRecordingDeviceEnergyModel>
+LiIonEnergyAnalyticTestCase::CreateDischarge(bool analytic)
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<DrainRecordingDeviceEnergyModel> sem = CreateObject<DrainRecordingDeviceEnergyModel>();
+    Ptr<LiIonEnergySource> es = CreateObject<LiIonEnergySource>();
+    es->SetAttribute("AnalyticEnergyUpdate", BooleanValue(analytic));
+    es->SetAttribute("PeriodicEnergyUpdateInterval", TimeValue(MilliSeconds(10)));
+
+    es->SetNode(node);
+    sem->SetNode(node);
+    sem->SetEnergySource(es);
+    es->AppendDeviceEnergyModel(sem);
+    node->AggregateObject(es);
+
+    sem->SetCurrentA(2.33);
+    return sem;
+}
+
+void
+LiIonEnergyAnalyticTestCase::CheckRemainingEnergy(Ptr<LiIonEnergySource> analytic,
+                                                  Ptr<LiIonEnergySource> periodic)
+{
+    NS_TEST_ASSERT_MSG_EQ_TOL(analytic->GetRemainingEnergy(),
+                              periodic->GetRemainingEnergy(),
+                              1.0,
+                              "Incorrect remaining energy at " << Simulator::Now().As(Time::S));
+}
+
+void
+LiIonEnergyAnalyticTestCase::DoRun()
+{
+    Ptr<DrainRecordingDeviceEnergyModel> analytic = CreateDischarge(true);
+    Ptr<DrainRecordingDeviceEnergyModel> periodic = CreateDischarge(false);
+    Ptr<LiIonEnergySource> analyticSource = analytic->GetNode()->GetObject<LiIonEnergySource>();
+    Ptr<LiIonEnergySource> periodicSource = periodic->GetNode()->GetObject<LiIonEnergySource>();
+
+    Simulator::Schedule(Seconds(1701.005),
+                        &LiIonEnergyAnalyticTestCase::CheckRemainingEnergy,
+                        this,
+                        analyticSource,
+                        periodicSource);
+    Simulator::Stop(Seconds(5000));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(periodic->m_drainedTime.IsStrictlyPositive(),
+                          true,
+                          "The periodic source was not drained");
+    NS_TEST_ASSERT_MSG_EQ_TOL(analytic->m_drainedTime.GetSeconds(),
+                              periodic->m_drainedTime.GetSeconds(),
+                              0.01,
+                              "Incorrect energy drained time");
+}
+
 /**
  * \ingroup energy-tests
  *
@@ -96,6 +201,7 @@ LiIonEnergySourceTestSuite::LiIonEnergySourceTestSuite()
     : TestSuite("li-ion-energy-source", Type::UNIT)
 {
     AddTestCase(new LiIonEnergyTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LiIonEnergyAnalyticTestCase, TestCase::Duration::QUICK);
 }
 
 /// create an instance of the test suite
@@ -201,6 +201,9 @@ DpdkNetDevice::HandleRx()
     int queueId = 0;
     m_rxBuffer->length = rte_eth_rx_burst(m_portId, queueId, m_rxBuffer->pkts, m_maxRxPktBurst);
 
+    // The whole burst is handed to the simulator at once, taking the pending
+    // queue lock and scheduling an event once per burst rather than per packet
+    m_rxFrames.clear();
     for (uint16_t i = 0; i < m_rxBuffer->length; i++)
     {
         struct rte_mbuf* pkt = nullptr;
@@ -212,8 +215,13 @@ DpdkNetDevice::HandleRx()
         }
 
         uint8_t* buf = rte_pktmbuf_mtod(pkt, uint8_t*);
-        size_t length = pkt->data_len;
-        FdNetDevice::ReceiveCallback(buf, length);
+        ssize_t length = pkt->data_len;
+        m_rxFrames.emplace_back(buf, length);
+    }
+
+    if (!m_rxFrames.empty())
+    {
+        FdNetDevice::ReceiveBurst(m_rxFrames);
     }
 
     m_rxBuffer->length = 0;
@@ -430,7 +438,7 @@ DpdkNetDevice::FreeBuffer(uint8_t* buf)
 ssize_t
 DpdkNetDevice::Write(uint8_t* buffer, size_t length)
 {
-    struct rte_mbuf** pkt = new struct rte_mbuf*[1];
+    struct rte_mbuf* pkt;
     int queueId = 0;
 
     if (!buffer || m_txBuffer->length == m_maxTxPktBurst)
@@ -439,11 +447,11 @@ DpdkNetDevice::Write(uint8_t* buffer, size_t length)
         return -1;
     }
 
-    pkt[0] = (struct rte_mbuf*)RTE_PTR_SUB(buffer, sizeof(struct rte_mbuf) + RTE_PKTMBUF_HEADROOM);
+    pkt = (struct rte_mbuf*)RTE_PTR_SUB(buffer, sizeof(struct rte_mbuf) + RTE_PKTMBUF_HEADROOM);
 
-    pkt[0]->pkt_len = length;
-    pkt[0]->data_len = length;
-    rte_eth_tx_buffer(m_portId, queueId, m_txBuffer, pkt[0]);
+    pkt->pkt_len = length;
+    pkt->data_len = length;
+    rte_eth_tx_buffer(m_portId, queueId, m_txBuffer, pkt);
 
     if (m_txBuffer->length == 1)
     {
@@ -170,6 +170,11 @@ class DpdkNetDevice : public FdNetDevice
      */
     struct rte_eth_dev_tx_buffer* m_rxBuffer;
 
+    /**
+     * Frames of the current Rx burst, handed up to FdNetDevice together
+     */
+    std::vector<std::pair<uint8_t*, ssize_t>> m_rxFrames;
+
     /**
      * Event for stale packet transmission
      */
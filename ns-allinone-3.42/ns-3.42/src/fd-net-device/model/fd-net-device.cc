@@ -37,6 +37,7 @@
 
 #include <arpa/inet.h>
 #include <net/ethernet.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 namespace ns3
@@ -45,10 +46,19 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("FdNetDevice");
 
 FdNetDeviceFdReader::FdNetDeviceFdReader()
-    : m_bufferSize(65536) // Defaults to maximum TCP window size
+    : m_bufferSize(65536), // Defaults to maximum TCP window size
+      m_batchSize(1)
 {
 }
 
+FdNetDeviceFdReader::~FdNetDeviceFdReader()
+{
+    for (auto buf : m_spareBuffers)
+    {
+        free(buf);
+    }
+}
+
 void
 FdNetDeviceFdReader::SetBufferSize(uint32_t bufferSize)
 {
@@ -56,11 +66,30 @@ FdNetDeviceFdReader::SetBufferSize(uint32_t bufferSize)
     m_bufferSize = bufferSize;
 }
 
+void
+FdNetDeviceFdReader::SetBatchSize(uint32_t batchSize)
+{
+    NS_LOG_FUNCTION(this << batchSize);
+    m_batchSize = std::max<uint32_t>(batchSize, 1);
+}
+
+void
+FdNetDeviceFdReader::SetBurstCallback(
+    Callback<void, const std::vector<std::pair<uint8_t*, ssize_t>>&> cb)
+{
+    m_burstCallback = cb;
+}
+
 FdReader::Data
 FdNetDeviceFdReader::DoRead()
 {
     NS_LOG_FUNCTION(this);
 
+    if (m_batchSize > 1 && !m_burstCallback.IsNull())
+    {
+        return DoReadBatch();
+    }
+
     auto buf = (uint8_t*)malloc(m_bufferSize);
     NS_ABORT_MSG_IF(buf == nullptr, "malloc() failed");
 
@@ -76,6 +105,62 @@ FdNetDeviceFdReader::DoRead()
     return FdReader::Data(buf, len);
 }
 
+FdReader::Data
+FdNetDeviceFdReader::DoReadBatch()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The buffers left over by the previous batch are reused, so that only the
+    // buffers handed over to the device are allocated again
+    while (m_spareBuffers.size() < m_batchSize)
+    {
+        auto buf = (uint8_t*)malloc(m_bufferSize);
+        NS_ABORT_MSG_IF(buf == nullptr, "malloc() failed");
+        m_spareBuffers.push_back(buf);
+    }
+
+    std::vector<iovec> iovecs(m_batchSize);
+    std::vector<mmsghdr> msgs(m_batchSize);
+    for (uint32_t i = 0; i < m_batchSize; i++)
+    {
+        iovecs[i].iov_base = m_spareBuffers[i];
+        iovecs[i].iov_len = m_bufferSize;
+        msgs[i] = {};
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    NS_LOG_LOGIC("Calling recvmmsg on fd " << m_fd);
+    int n = recvmmsg(m_fd, msgs.data(), m_batchSize, MSG_DONTWAIT, nullptr);
+    if (n < 0 && errno == ENOTSOCK)
+    {
+        // Not a socket (e.g., a TAP device), fall back to one read() per frame
+        NS_LOG_LOGIC("fd " << m_fd << " is not a socket, disabling batch reads");
+        m_batchSize = 1;
+        return DoRead();
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    {
+        return FdReader::Data(nullptr, -1);
+    }
+    if (n <= 0)
+    {
+        return FdReader::Data(nullptr, 0);
+    }
+
+    NS_LOG_LOGIC("Read " << n << " frames on fd " << m_fd);
+    m_frames.clear();
+    for (int i = 0; i < n; i++)
+    {
+        m_frames.emplace_back(m_spareBuffers[i], msgs[i].msg_len);
+    }
+    m_spareBuffers.erase(m_spareBuffers.begin(), m_spareBuffers.begin() + n);
+    m_burstCallback(m_frames);
+
+    // the frames have been delivered already
+    return FdReader::Data(nullptr, -1);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FdNetDevice);
 
 TypeId
@@ -116,6 +201,15 @@ FdNetDevice::GetTypeId()
                           UintegerValue(1000),
                           MakeUintegerAccessor(&FdNetDevice::m_maxPendingReads),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("RxBatchSize",
+                          "Maximum number of frames read at once with recvmmsg() "
+                          "when the file descriptor is a socket, such as the raw "
+                          "socket of an EmuFdNetDevice.  The frames of a batch are "
+                          "handed to the simulator in a single event.  A value of 1 "
+                          "reads one frame per read() call.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FdNetDevice::m_rxBatchSize),
+                          MakeUintegerChecker<uint32_t>(1))
             //
             // Trace sources at the "top" of the net device, where packets transition
             // to/from higher layers.  These points do not really correspond to the
@@ -264,6 +358,8 @@ FdNetDevice::DoCreateFdReader()
     Ptr<FdNetDeviceFdReader> fdReader = Create<FdNetDeviceFdReader>();
     // 22 bytes covers 14 bytes Ethernet header with possible 8 bytes LLC/SNAP
     fdReader->SetBufferSize(m_mtu + 22);
+    fdReader->SetBatchSize(m_rxBatchSize);
+    fdReader->SetBurstCallback(MakeCallback(&FdNetDevice::ReceiveBurst, this));
     return fdReader;
 }
 
@@ -336,68 +432,70 @@ FdNetDevice::ReceiveCallback(uint8_t* buf, ssize_t len)
     }
 }
 
+void
+FdNetDevice::ReceiveBurst(const std::vector<std::pair<uint8_t*, ssize_t>>& frames)
+{
+    NS_LOG_FUNCTION(this << frames.size());
+    std::size_t queued = 0;
+
+    {
+        std::unique_lock lock{m_pendingReadMutex};
+        while (queued < frames.size() && m_pendingQueue.size() < m_maxPendingReads)
+        {
+            m_pendingQueue.push(frames[queued]);
+            queued++;
+        }
+    }
+
+    for (std::size_t i = queued; i < frames.size(); i++)
+    {
+        NS_LOG_WARN("Packet dropped");
+        FreeBuffer(frames[i].first);
+    }
+
+    if (queued > 0)
+    {
+        Simulator::ScheduleWithContext(m_nodeId,
+                                       Time(0),
+                                       &FdNetDevice::ForwardUpBurst,
+                                       this,
+                                       static_cast<uint32_t>(queued));
+    }
+}
+
 /**
  * \ingroup fd-net-device
  * \brief Synthesize PI header for the kernel
- * \param buf the buffer to add the header to
- * \param len the buffer length
- *
- * \todo Consider having a instance member m_packetBuffer and using memmove
- * instead of memcpy to add the PI header. It might be faster in this case
- * to use memmove and avoid the extra mallocs.
+ * \param buf the buffer to add the header to, with the frame starting after
+ *        the 4 bytes reserved for the header
+ * \param len the frame length, without the PI header
  */
 static void
-AddPIHeader(uint8_t*& buf, size_t& len)
+AddPIHeader(uint8_t* buf, size_t len)
 {
-    // Synthesize PI header for our friend the kernel
-    auto buf2 = (uint8_t*)malloc(len + 4);
-    memcpy(buf2 + 4, buf, len);
-    len += 4;
-
     // PI = 16 bits flags (0) + 16 bits proto
     // NOTE: be careful to interpret buffer data explicitly as
     //  little-endian to be insensible to native byte ordering.
+    const uint8_t* frame = buf + 4;
     uint16_t flags = 0;
     uint16_t proto = 0x0008; // default to IPv4
-    if (len > 14)
+    if (len > 10)
     {
-        if (buf[12] == 0x81 && buf[13] == 0x00 && len > 18)
+        if (frame[12] == 0x81 && frame[13] == 0x00 && len > 14)
         {
             // tagged ethernet packet
-            proto = buf[16] | (buf[17] << 8);
+            proto = frame[16] | (frame[17] << 8);
         }
         else
         {
             // untagged ethernet packet
-            proto = buf[12] | (buf[13] << 8);
+            proto = frame[12] | (frame[13] << 8);
         }
     }
-    buf2[0] = (uint8_t)flags;
-    buf2[1] = (uint8_t)(flags >> 8);
-    buf2[2] = (uint8_t)proto;
-    buf2[3] = (uint8_t)(proto >> 8);
-
-    // swap buffer
-    free(buf);
-    buf = buf2;
-}
-
-/**
- * \ingroup fd-net-device
- * \brief Removes PI header
- * \param buf the buffer to add the header to
- * \param len the buffer length
- */
-static void
-RemovePIHeader(uint8_t*& buf, ssize_t& len)
-{
-    // strip PI header if present, shrink buffer
-    if (len >= 4)
-    {
-        len -= 4;
-        memmove(buf, buf + 4, len);
-        buf = (uint8_t*)realloc(buf, len);
-    }
+    buf[0] = (uint8_t)flags;
+    buf[1] = (uint8_t)(flags >> 8);
+    buf[2] = (uint8_t)proto;
+    buf[3] = (uint8_t)(proto >> 8);
 }
 
 uint8_t*
@@ -437,16 +535,18 @@ FdNetDevice::ForwardUp()
 
     NS_LOG_LOGIC("buffer: " << static_cast<void*>(buf) << " length: " << len);
 
-    // We need to remove the PI header and ignore it
-    if (m_encapMode == DIXPI)
+    // We need to skip the PI header and ignore it
+    uint32_t offset = 0;
+    if (m_encapMode == DIXPI && len >= 4)
     {
-        RemovePIHeader(buf, len);
+        offset = 4;
+        len -= 4;
     }
 
     //
     // Create a packet out of the buffer we received and free that buffer.
     //
-    Ptr<Packet> packet = Create<Packet>(reinterpret_cast<const uint8_t*>(buf), len);
+    Ptr<Packet> packet = Create<Packet>(reinterpret_cast<const uint8_t*>(buf + offset), len);
     FreeBuffer(buf);
     buf = nullptr;
 
@@ -554,6 +654,17 @@ FdNetDevice::ForwardUp()
     }
 }
 
+void
+FdNetDevice::ForwardUpBurst(uint32_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ForwardUp();
+    }
+}
+
 bool
 FdNetDevice::Send(Ptr<Packet> packet, const Address& destination, uint16_t protocolNumber)
 {
@@ -617,20 +728,24 @@ FdNetDevice::SendFrom(Ptr<Packet> packet,
 
     NS_LOG_LOGIC("calling write");
 
+    // Room for the PI header is reserved in front of the frame, so that it is
+    // written in place rather than by copying the frame to a larger buffer
+    size_t headroom = (m_encapMode == DIXPI) ? 4 : 0;
     auto len = (size_t)packet->GetSize();
-    uint8_t* buffer = AllocateBuffer(len);
+    uint8_t* buffer = AllocateBuffer(headroom + len);
     if (!buffer)
     {
         m_macTxDropTrace(packet);
         return false;
     }
 
-    packet->CopyData(buffer, len);
+    packet->CopyData(buffer + headroom, len);
 
     // We need to add the PI header
     if (m_encapMode == DIXPI)
     {
         AddPIHeader(buffer, len);
+        len += headroom;
     }
 
     ssize_t written = Write(buffer, len);
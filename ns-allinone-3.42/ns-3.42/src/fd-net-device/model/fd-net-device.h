@@ -36,6 +36,7 @@
 #include <mutex>
 #include <queue>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -54,6 +55,7 @@ class FdNetDeviceFdReader : public FdReader
 {
   public:
     FdNetDeviceFdReader();
+    ~FdNetDeviceFdReader() override;
 
     /**
      * Set size of the read buffer.
@@ -61,10 +63,36 @@ class FdNetDeviceFdReader : public FdReader
      */
     void SetBufferSize(uint32_t bufferSize);
 
+    /**
+     * Set the maximum number of frames read at once from a socket with
+     * recvmmsg(). A value of 1 reads one frame per read() call.
+     * \param batchSize the maximum number of frames per read
+     */
+    void SetBatchSize(uint32_t batchSize);
+
+    /**
+     * Set the callback invoked with the frames read at once by a batch read.
+     * \param cb the callback
+     */
+    void SetBurstCallback(Callback<void, const std::vector<std::pair<uint8_t*, ssize_t>>&> cb);
+
   private:
     FdReader::Data DoRead() override;
 
+    /**
+     * Read up to m_batchSize frames with a single recvmmsg() call and pass
+     * them to the burst callback.
+     * \return a negative length if frames were read, as they have already
+     * been delivered, zero if reading failed
+     */
+    FdReader::Data DoReadBatch();
+
     uint32_t m_bufferSize; //!< size of the read buffer
+    uint32_t m_batchSize;  //!< maximum number of frames per batch read
+    /// callback for the frames of a batch read
+    Callback<void, const std::vector<std::pair<uint8_t*, ssize_t>>&> m_burstCallback;
+    std::vector<uint8_t*> m_spareBuffers;               //!< buffers not used by the last batch
+    std::vector<std::pair<uint8_t*, ssize_t>> m_frames; //!< frames of the last batch read
 };
 
 class Node;
@@ -234,6 +262,14 @@ class FdNetDevice : public NetDevice
      */
     void ReceiveCallback(uint8_t* buf, ssize_t len);
 
+    /**
+     * Queue a burst of received frames under a single lock, and schedule a
+     * single event to forward them up. The frames that do not fit in the
+     * pending queue are dropped and their buffers freed.
+     * \param frames the buffers containing the received frames, with their lengths
+     */
+    void ReceiveBurst(const std::vector<std::pair<uint8_t*, ssize_t>>& frames);
+
     /**
      * Mutex to increase pending read counter.
      */
@@ -276,6 +312,12 @@ class FdNetDevice : public NetDevice
      */
     void ForwardUp();
 
+    /**
+     * Forward a burst of frames to the appropriate callback for processing
+     * \param count the number of frames to forward
+     */
+    void ForwardUpBurst(uint32_t count);
+
     /**
      * Start Sending a Packet Down the Wire.
      * @param p packet to send
@@ -359,6 +401,11 @@ class FdNetDevice : public NetDevice
      */
     uint32_t m_maxPendingReads;
 
+    /**
+     * Maximum number of frames read at once from a socket.
+     */
+    uint32_t m_rxBatchSize;
+
     /**
      * Time to start spinning up the device
      */
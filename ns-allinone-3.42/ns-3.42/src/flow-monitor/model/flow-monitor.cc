@@ -19,15 +19,28 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds(1))
 
+/// First bytes of a snapshot file, followed by the format version
+#define SNAPSHOT_FILE_MAGIC "NS3FMSNP"
+/// Version of the snapshot file format
+#define SNAPSHOT_FILE_VERSION 1
+/// Flag of the flows that are freed after a snapshot
+#define SNAPSHOT_FLOW_FREED 1
+
 namespace ns3
 {
 
@@ -35,6 +48,32 @@ NS_LOG_COMPONENT_DEFINE("FlowMonitor");
 
 NS_OBJECT_ENSURE_REGISTERED(FlowMonitor);
 
+/**
+ * Write a value to a snapshot file, in the byte order of the host
+ * \param os the output stream
+ * \param value the value
+ */
+template <typename T>
+static void
+WriteValue(std::ostream& os, T value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * Read a value from a snapshot file, in the byte order of the host
+ * \param is the input stream
+ * \param value the value read
+ * \return false if the end of the stream was reached
+ */
+template <typename T>
+static bool
+ReadValue(std::istream& is, T& value)
+{
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return static_cast<bool>(is);
+}
+
 TypeId
 FlowMonitor::GetTypeId()
 {
@@ -80,7 +119,71 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("PacketSampling",
+                          ("Account for one packet every N, selected by hashing the flow and "
+                           "packet identifiers. The other packets are ignored, except by the "
+                           "flow size sketch."),
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_packetSampling),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("QuantileSketchAccuracy",
+                          ("If not zero, the delays and jitters of each flow are recorded in "
+                           "quantile sketches with this relative accuracy, instead of in "
+                           "histograms."),
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&FlowMonitor::m_quantileSketchAccuracy),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("QuantileSketchMaxBins",
+                          ("The maximum number of bins of each quantile sketch."),
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_quantileSketchMaxBins),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("FlowSizeSketchEpsilon",
+                          ("If not zero, the bytes transmitted by each flow are also counted in "
+                           "a Count-Min sketch, which overestimates them by at most this "
+                           "fraction of the total bytes, with probability 1 - "
+                           "FlowSizeSketchDelta."),
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&FlowMonitor::m_flowSizeSketchEpsilon),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("FlowSizeSketchDelta",
+                          ("The probability that the error bound of the flow size sketch is "
+                           "exceeded."),
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FlowMonitor::m_flowSizeSketchDelta),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("HeavyHitters",
+                          ("The number of largest flows reported from the flow size sketch."),
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&FlowMonitor::m_nHeavyHitters),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SnapshotInterval",
+                          ("If not zero, the changes of the flow statistics are appended to "
+                           "the snapshot file with this period."),
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_snapshotInterval),
+                          MakeTimeChecker())
+            .AddAttribute("SnapshotFile",
+                          ("The name of the snapshot file."),
+                          StringValue("flowmon-snapshots.bin"),
+                          MakeStringAccessor(&FlowMonitor::m_snapshotFileName),
+                          MakeStringChecker())
+            .AddAttribute("FlowIdleTimeout",
+                          ("If not zero and snapshots are enabled, the flows that have not "
+                           "transmitted nor received any packet for this time are written to "
+                           "the snapshot file a last time, and freed."),
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&FlowMonitor::m_flowIdleTimeout),
+                          MakeTimeChecker())
+            .AddAttribute("PacketFixedFields",
+                          ("Identify the packets by their flow id and user data fixed fields "
+                           "(see Packet::SetFlowId) rather than by a byte tag. Only valid "
+                           "without IP tunnels nor aggregation of IP packets below the IP "
+                           "layer; it must be set before the probes are installed."),
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_packetFixedFields),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -100,8 +203,11 @@ void
 FlowMonitor::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    CloseSnapshotFile();
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_snapshotEvent);
+    Simulator::Cancel(m_snapshotCloseEvent);
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -118,8 +224,11 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    if (flowId < m_flowStatsIndex.size() && m_flowStatsIndex[flowId])
+    {
+        return *m_flowStatsIndex[flowId];
+    }
+    else
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
         ref.delaySum = Seconds(0);
@@ -135,12 +244,78 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+        if (m_quantileSketchAccuracy > 0)
+        {
+            ref.delaySketch = DdSketch(m_quantileSketchAccuracy, m_quantileSketchMaxBins);
+            ref.jitterSketch = DdSketch(m_quantileSketchAccuracy, m_quantileSketchMaxBins);
+        }
+        // map nodes are only erased along with their index entry, hence the pointer stays valid
+        if (flowId >= m_flowStatsIndex.size())
+        {
+            m_flowStatsIndex.resize(flowId + 1, nullptr);
+        }
+        m_flowStatsIndex[flowId] = &ref;
         return ref;
     }
-    else
+}
+
+uint64_t
+FlowMonitor::GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+bool
+FlowMonitor::IsSampled(FlowId flowId, FlowPacketId packetId) const
+{
+    if (m_packetSampling <= 1)
     {
-        return iter->second;
+        return true;
     }
+    // mix the bits, so that the selection does not follow the packet numbering of each flow
+    uint64_t hash = GetTrackedPacketKey(flowId, packetId);
+    hash = (hash ^ (hash >> 33)) * 0xff51afd7ed558ccdULL;
+    hash = (hash ^ (hash >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash % m_packetSampling == 0;
+}
+
+void
+FlowMonitor::UpdateFlowSizeSketch(FlowId flowId, uint32_t packetSize)
+{
+    m_flowSizeSketch.Add(flowId, packetSize);
+    const auto estimate = m_flowSizeSketch.GetEstimate(flowId);
+
+    // the estimates only grow, hence the smallest heavy hitter is the one to replace
+    auto smallest = m_heavyHitters.end();
+    for (auto iter = m_heavyHitters.begin(); iter != m_heavyHitters.end(); iter++)
+    {
+        if (iter->first == flowId)
+        {
+            iter->second = estimate;
+            return;
+        }
+        if (smallest == m_heavyHitters.end() || iter->second < smallest->second)
+        {
+            smallest = iter;
+        }
+    }
+    if (m_heavyHitters.size() < m_nHeavyHitters)
+    {
+        m_heavyHitters.emplace_back(flowId, estimate);
+    }
+    else if (smallest != m_heavyHitters.end() && estimate > smallest->second)
+    {
+        *smallest = std::make_pair(flowId, estimate);
+    }
+}
+
+void
+FlowMonitor::UntrackPacket(TrackedPacketMap::iterator tracked)
+{
+    // keep the list node for the next packet to be tracked
+    m_trackedPacketPool.splice(m_trackedPacketPool.end(), m_trackedPacketList, tracked->second);
+    m_trackedPackets.erase(tracked);
 }
 
 void
@@ -155,8 +330,36 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (m_flowSizeSketchEpsilon > 0)
+    {
+        UpdateFlowSizeSketch(flowId, packetSize);
+    }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    const auto key = GetTrackedPacketKey(flowId, packetId);
+    auto iter = m_trackedPackets.find(key);
+    if (iter == m_trackedPackets.end())
+    {
+        if (m_trackedPacketPool.empty())
+        {
+            m_trackedPacketPool.emplace_back();
+        }
+        m_trackedPacketList.splice(m_trackedPacketList.end(),
+                                   m_trackedPacketPool,
+                                   m_trackedPacketPool.begin());
+        iter = m_trackedPackets.emplace(key, std::prev(m_trackedPacketList.end())).first;
+    }
+    else
+    {
+        // the list is sorted by last seen time, hence the packet goes to the back
+        m_trackedPacketList.splice(m_trackedPacketList.end(), m_trackedPacketList, iter->second);
+    }
+    TrackedPacket& tracked = *iter->second;
+    tracked.flowId = flowId;
+    tracked.packetId = packetId;
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
@@ -187,19 +390,24 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    auto iter = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
+    if (iter == m_trackedPackets.end())
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    m_trackedPacketList.splice(m_trackedPacketList.end(), m_trackedPacketList, iter->second);
+    TrackedPacket& tracked = *iter->second;
+    tracked.timesForwarded++;
+    tracked.lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -215,33 +423,44 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    auto iter = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
+    if (iter == m_trackedPackets.end())
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
+    const TrackedPacket& tracked = *iter->second;
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.delaySum += delay;
-    stats.delayHistogram.AddValue(delay.GetSeconds());
+    if (m_quantileSketchAccuracy > 0)
+    {
+        stats.delaySketch.AddValue(delay.GetSeconds());
+    }
+    else
+    {
+        stats.delayHistogram.AddValue(delay.GetSeconds());
+    }
     if (stats.rxPackets > 0)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter > Seconds(0))
+        Time jitter = Abs(stats.lastDelay - delay);
+        stats.jitterSum += jitter;
+        if (m_quantileSketchAccuracy > 0)
         {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
+            stats.jitterSketch.AddValue(jitter.GetSeconds());
         }
         else
         {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            stats.jitterHistogram.AddValue(jitter.GetSeconds());
         }
     }
     stats.lastDelay = delay;
@@ -263,12 +482,12 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked.timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    UntrackPacket(iter); // we don't need to track this packet anymore
 }
 
 void
@@ -284,6 +503,10 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
 
@@ -299,14 +522,14 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
+    auto tracked = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
     if (tracked != m_trackedPackets.end())
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        UntrackPacket(tracked);
     }
 }
 
@@ -322,22 +545,19 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // the oldest packets come first, hence only the lost packets are visited
+    while (!m_trackedPacketList.empty() &&
+           now - m_trackedPacketList.front().lastSeenTime >= maxDelay)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+        const TrackedPacket& tracked = m_trackedPacketList.front();
+        // packet is considered lost, add it to the loss statistics (of a new
+        // entry, if the flow was freed after a snapshot)
+        GetStatsForFlow(tracked.flowId).lostPackets++;
 
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
-        {
-            iter++;
-        }
+        // we won't track it anymore
+        auto iter = m_trackedPackets.find(GetTrackedPacketKey(tracked.flowId, tracked.packetId));
+        NS_ASSERT(iter != m_trackedPackets.end());
+        UntrackPacket(iter);
     }
 }
 
@@ -358,7 +578,22 @@ void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
+    if (m_flowSizeSketchEpsilon > 0)
+    {
+        m_flowSizeSketch = CountMinSketch(m_flowSizeSketchEpsilon, m_flowSizeSketchDelta);
+    }
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
+    if (m_snapshotInterval.IsStrictlyPositive())
+    {
+        m_snapshotFile.open(m_snapshotFileName, std::ios::out | std::ios::binary);
+        NS_ABORT_MSG_UNLESS(m_snapshotFile.is_open(),
+                            "Cannot open the snapshot file " << m_snapshotFileName);
+        m_snapshotFile.write(SNAPSHOT_FILE_MAGIC, 8);
+        WriteValue<uint32_t>(m_snapshotFile, SNAPSHOT_FILE_VERSION);
+        m_snapshotEvent =
+            Simulator::Schedule(m_snapshotInterval, &FlowMonitor::PeriodicWriteSnapshot, this);
+        m_snapshotCloseEvent = Simulator::ScheduleDestroy(&FlowMonitor::CloseSnapshotFile, this);
+    }
 }
 
 void
@@ -373,6 +608,28 @@ FlowMonitor::GetAllProbes() const
     return m_flowProbes;
 }
 
+bool
+FlowMonitor::UsesPacketFixedFields() const
+{
+    return m_packetFixedFields;
+}
+
+const CountMinSketch&
+FlowMonitor::GetFlowSizeSketch() const
+{
+    return m_flowSizeSketch;
+}
+
+std::vector<std::pair<FlowId, uint64_t>>
+FlowMonitor::GetHeavyHitters() const
+{
+    auto heavyHitters = m_heavyHitters;
+    std::sort(heavyHitters.begin(), heavyHitters.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    });
+    return heavyHitters;
+}
+
 void
 FlowMonitor::Start(const Time& time)
 {
@@ -427,6 +684,40 @@ FlowMonitor::AddFlowClassifier(Ptr<FlowClassifier> classifier)
     m_classifiers.push_back(classifier);
 }
 
+void
+FlowMonitor::SerializeFlowStatsToXmlStream(std::ostream& os,
+                                           uint16_t indent,
+                                           FlowId flowId,
+                                           const FlowStats& stats)
+{
+    os << std::string(indent, ' ');
+#define ATTRIB(name) << " " #name "=\"" << stats.name << "\""
+#define ATTRIB_TIME(name) << " " #name "=\"" << stats.name.As(Time::NS) << "\""
+    os << "<Flow flowId=\"" << flowId
+       << "\"" ATTRIB_TIME(timeFirstTxPacket) ATTRIB_TIME(timeFirstRxPacket)
+              ATTRIB_TIME(timeLastTxPacket) ATTRIB_TIME(timeLastRxPacket) ATTRIB_TIME(delaySum)
+                  ATTRIB_TIME(jitterSum) ATTRIB_TIME(lastDelay) ATTRIB(txBytes) ATTRIB(rxBytes)
+                      ATTRIB(txPackets) ATTRIB(rxPackets) ATTRIB(lostPackets)
+                          ATTRIB(timesForwarded)
+       << ">\n";
+#undef ATTRIB_TIME
+#undef ATTRIB
+
+    indent += 2;
+    for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
+           << " number=\"" << stats.packetsDropped[reasonCode] << "\" />\n";
+    }
+    for (uint32_t reasonCode = 0; reasonCode < stats.bytesDropped.size(); reasonCode++)
+    {
+        os << std::string(indent, ' ');
+        os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
+           << " bytes=\"" << stats.bytesDropped[reasonCode] << "\" />\n";
+    }
+}
+
 void
 FlowMonitor::SerializeToXmlStream(std::ostream& os,
                                   uint16_t indent,
@@ -436,39 +727,20 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     NS_LOG_FUNCTION(this << indent << enableHistograms << enableProbes);
     CheckForLostPackets();
 
-    os << std::string(indent, ' ') << "<FlowMonitor>\n";
+    os << std::string(indent, ' ') << "<FlowMonitor";
+    if (m_packetSampling > 1)
+    {
+        os << " packetSampling=\"" << m_packetSampling << "\"";
+    }
+    os << ">\n";
     indent += 2;
     os << std::string(indent, ' ') << "<FlowStats>\n";
     indent += 2;
     for (auto flowI = m_flowStats.begin(); flowI != m_flowStats.end(); flowI++)
     {
-        os << std::string(indent, ' ');
-#define ATTRIB(name) << " " #name "=\"" << flowI->second.name << "\""
-#define ATTRIB_TIME(name) << " " #name "=\"" << flowI->second.name.As(Time::NS) << "\""
-        os << "<Flow flowId=\"" << flowI->first
-           << "\"" ATTRIB_TIME(timeFirstTxPacket) ATTRIB_TIME(timeFirstRxPacket)
-                  ATTRIB_TIME(timeLastTxPacket) ATTRIB_TIME(timeLastRxPacket) ATTRIB_TIME(delaySum)
-                      ATTRIB_TIME(jitterSum) ATTRIB_TIME(lastDelay) ATTRIB(txBytes) ATTRIB(rxBytes)
-                          ATTRIB(txPackets) ATTRIB(rxPackets) ATTRIB(lostPackets)
-                              ATTRIB(timesForwarded)
-           << ">\n";
-#undef ATTRIB_TIME
-#undef ATTRIB
+        SerializeFlowStatsToXmlStream(os, indent, flowI->first, flowI->second);
 
         indent += 2;
-        for (uint32_t reasonCode = 0; reasonCode < flowI->second.packetsDropped.size();
-             reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
-               << " number=\"" << flowI->second.packetsDropped[reasonCode] << "\" />\n";
-        }
-        for (uint32_t reasonCode = 0; reasonCode < flowI->second.bytesDropped.size(); reasonCode++)
-        {
-            os << std::string(indent, ' ');
-            os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
-               << " bytes=\"" << flowI->second.bytesDropped[reasonCode] << "\" />\n";
-        }
         if (enableHistograms)
         {
             flowI->second.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
@@ -481,6 +753,11 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
                 indent,
                 "flowInterruptionsHistogram");
         }
+        if (m_quantileSketchAccuracy > 0)
+        {
+            flowI->second.delaySketch.SerializeToXmlStream(os, indent, "delaySketch");
+            flowI->second.jitterSketch.SerializeToXmlStream(os, indent, "jitterSketch");
+        }
         indent -= 2;
 
         os << std::string(indent, ' ') << "</Flow>\n";
@@ -488,6 +765,26 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
 
+    if (m_flowSizeSketchEpsilon > 0)
+    {
+        os << std::string(indent, ' ') << "<FlowSizeSketch"
+           << " epsilon=\"" << m_flowSizeSketch.GetEpsilon() << "\""
+           << " delta=\"" << m_flowSizeSketch.GetDelta() << "\""
+           << " width=\"" << m_flowSizeSketch.GetWidth() << "\""
+           << " depth=\"" << m_flowSizeSketch.GetDepth() << "\""
+           << " totalBytes=\"" << m_flowSizeSketch.GetTotal() << "\""
+           << " errorBound=\"" << m_flowSizeSketch.GetErrorBound() << "\""
+           << ">\n";
+        indent += 2;
+        for (const auto& [flowId, bytes] : GetHeavyHitters())
+        {
+            os << std::string(indent, ' ') << "<HeavyHitter flowId=\"" << flowId << "\""
+               << " bytes=\"" << bytes << "\" />\n";
+        }
+        indent -= 2;
+        os << std::string(indent, ' ') << "</FlowSizeSketch>\n";
+    }
+
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         (*iter)->SerializeToXmlStream(os, indent);
@@ -533,6 +830,17 @@ FlowMonitor::ResetAllStats()
 {
     NS_LOG_FUNCTION(this);
 
+    if (m_snapshotFile.is_open())
+    {
+        // the changes since the last snapshot are not lost, and the next
+        // ones start from zero
+        WriteSnapshot();
+        WriteValue<uint8_t>(m_snapshotFile, RESET_RECORD);
+        WriteValue<int64_t>(m_snapshotFile, Simulator::Now().GetNanoSeconds());
+        m_snapshotFile.flush();
+        m_snapshotCounters.clear();
+    }
+
     for (auto& iter : m_flowStats)
     {
         auto& flowStat = iter.second;
@@ -552,7 +860,292 @@ FlowMonitor::ResetAllStats()
         flowStat.jitterHistogram.Clear();
         flowStat.packetSizeHistogram.Clear();
         flowStat.flowInterruptionsHistogram.Clear();
+        flowStat.delaySketch.Clear();
+        flowStat.jitterSketch.Clear();
+    }
+    m_flowSizeSketch.Clear();
+    m_heavyHitters.clear();
+}
+
+void
+FlowMonitor::WriteSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_snapshotFile.is_open())
+    {
+        return;
+    }
+    CheckForLostPackets();
+    Time now = Simulator::Now();
+
+    // the flows are written to a buffer first, since their number comes before them
+    std::ostringstream flows;
+    uint32_t nFlows = 0;
+    std::vector<FlowId> idleFlows;
+    for (const auto& [flowId, stats] : m_flowStats)
+    {
+        SnapshotCounters& written = m_snapshotCounters[flowId];
+        const bool idle =
+            m_flowIdleTimeout.IsStrictlyPositive() &&
+            now - std::max(stats.timeLastTxPacket, stats.timeLastRxPacket) >= m_flowIdleTimeout;
+        if (!idle && stats.txPackets == written.txPackets &&
+            stats.rxPackets == written.rxPackets && stats.lostPackets == written.lostPackets &&
+            stats.packetsDropped == written.packetsDropped)
+        {
+            continue;
+        }
+
+        WriteValue<uint32_t>(flows, flowId);
+        WriteValue<uint8_t>(flows, idle ? SNAPSHOT_FLOW_FREED : 0);
+        WriteValue<int64_t>(flows, stats.timeFirstTxPacket.GetNanoSeconds());
+        WriteValue<int64_t>(flows, stats.timeFirstRxPacket.GetNanoSeconds());
+        WriteValue<int64_t>(flows, stats.timeLastTxPacket.GetNanoSeconds());
+        WriteValue<int64_t>(flows, stats.timeLastRxPacket.GetNanoSeconds());
+        WriteValue<int64_t>(flows, stats.lastDelay.GetNanoSeconds());
+        WriteValue<int64_t>(flows, (stats.delaySum - written.delaySum).GetNanoSeconds());
+        WriteValue<int64_t>(flows, (stats.jitterSum - written.jitterSum).GetNanoSeconds());
+        WriteValue<uint64_t>(flows, stats.txBytes - written.txBytes);
+        WriteValue<uint64_t>(flows, stats.rxBytes - written.rxBytes);
+        WriteValue<uint32_t>(flows, stats.txPackets - written.txPackets);
+        WriteValue<uint32_t>(flows, stats.rxPackets - written.rxPackets);
+        WriteValue<uint32_t>(flows, stats.lostPackets - written.lostPackets);
+        WriteValue<uint32_t>(flows, stats.timesForwarded - written.timesForwarded);
+        written.packetsDropped.resize(stats.packetsDropped.size(), 0);
+        written.bytesDropped.resize(stats.bytesDropped.size(), 0);
+        WriteValue<uint32_t>(flows, stats.packetsDropped.size());
+        for (std::size_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++)
+        {
+            WriteValue<uint32_t>(flows,
+                                 stats.packetsDropped[reasonCode] -
+                                     written.packetsDropped[reasonCode]);
+            WriteValue<uint64_t>(flows,
+                                 stats.bytesDropped[reasonCode] - written.bytesDropped[reasonCode]);
+        }
+        nFlows++;
+
+        written.delaySum = stats.delaySum;
+        written.jitterSum = stats.jitterSum;
+        written.txBytes = stats.txBytes;
+        written.rxBytes = stats.rxBytes;
+        written.txPackets = stats.txPackets;
+        written.rxPackets = stats.rxPackets;
+        written.lostPackets = stats.lostPackets;
+        written.timesForwarded = stats.timesForwarded;
+        written.packetsDropped = stats.packetsDropped;
+        written.bytesDropped = stats.bytesDropped;
+        if (idle)
+        {
+            idleFlows.push_back(flowId);
+        }
+    }
+
+    WriteValue<uint8_t>(m_snapshotFile, SNAPSHOT_RECORD);
+    WriteValue<int64_t>(m_snapshotFile, now.GetNanoSeconds());
+    WriteValue<uint32_t>(m_snapshotFile, nFlows);
+    m_snapshotFile << flows.str();
+    // the snapshots can be read while the simulation is running
+    m_snapshotFile.flush();
+    NS_LOG_DEBUG("Snapshot of " << nFlows << " flows, " << idleFlows.size() << " freed");
+
+    for (const auto flowId : idleFlows)
+    {
+        m_flowStats.erase(flowId);
+        m_flowStatsIndex[flowId] = nullptr;
+        m_snapshotCounters.erase(flowId);
+        for (const auto& probe : m_flowProbes)
+        {
+            probe->RemoveStats(flowId);
+        }
+    }
+}
+
+void
+FlowMonitor::PeriodicWriteSnapshot()
+{
+    WriteSnapshot();
+    m_snapshotEvent =
+        Simulator::Schedule(m_snapshotInterval, &FlowMonitor::PeriodicWriteSnapshot, this);
+}
+
+void
+FlowMonitor::CloseSnapshotFile()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_snapshotFile.is_open())
+    {
+        return;
     }
+    WriteSnapshot();
+    std::ostringstream classifiers;
+    for (const auto& classifier : m_classifiers)
+    {
+        classifier->SerializeToXmlStream(classifiers, 2);
+    }
+    WriteValue<uint8_t>(m_snapshotFile, CLASSIFIERS_RECORD);
+    WriteValue<uint32_t>(m_snapshotFile, classifiers.str().size());
+    m_snapshotFile << classifiers.str();
+    m_snapshotFile.close();
+}
+
+void
+FlowMonitor::ConvertSnapshotsToXmlFile(std::string snapshotFileName, std::string xmlFileName)
+{
+    NS_LOG_FUNCTION(snapshotFileName << xmlFileName);
+    std::ifstream is(snapshotFileName, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(is.is_open(), "Cannot open the snapshot file " << snapshotFileName);
+    char magic[8];
+    uint32_t version = 0;
+    is.read(magic, sizeof(magic));
+    NS_ABORT_MSG_UNLESS(is && std::equal(magic, magic + sizeof(magic), SNAPSHOT_FILE_MAGIC) &&
+                            ReadValue(is, version) && version == SNAPSHOT_FILE_VERSION,
+                        snapshotFileName << " is not a FlowMonitor snapshot file");
+
+    FlowStatsContainer flowStats;
+    std::string classifiers;
+    Time snapshotTime;
+    uint8_t type;
+    // a record that is only partly written, while the simulation is running, is ignored
+    while (ReadValue(is, type))
+    {
+        int64_t time;
+        if (type == SNAPSHOT_RECORD)
+        {
+            uint32_t nFlows;
+            if (!ReadValue(is, time) || !ReadValue(is, nFlows))
+            {
+                break;
+            }
+            std::vector<std::pair<FlowId, FlowStats>> deltas(nFlows);
+            bool complete = true;
+            for (auto& [flowId, delta] : deltas)
+            {
+                uint8_t flags;
+                int64_t times[7];
+                uint32_t nReasons = 0;
+                complete = ReadValue(is, flowId) && ReadValue(is, flags);
+                for (auto& t : times)
+                {
+                    complete = complete && ReadValue(is, t);
+                }
+                complete = complete && ReadValue(is, delta.txBytes) &&
+                           ReadValue(is, delta.rxBytes) &&
+                           ReadValue(is, delta.txPackets) && ReadValue(is, delta.rxPackets) &&
+                           ReadValue(is, delta.lostPackets) &&
+                           ReadValue(is, delta.timesForwarded) && ReadValue(is, nReasons);
+                delta.packetsDropped.resize(nReasons);
+                delta.bytesDropped.resize(nReasons);
+                for (uint32_t reasonCode = 0; complete && reasonCode < nReasons; reasonCode++)
+                {
+                    complete = ReadValue(is, delta.packetsDropped[reasonCode]) &&
+                               ReadValue(is, delta.bytesDropped[reasonCode]);
+                }
+                if (!complete)
+                {
+                    break;
+                }
+                delta.timeFirstTxPacket = NanoSeconds(times[0]);
+                delta.timeFirstRxPacket = NanoSeconds(times[1]);
+                delta.timeLastTxPacket = NanoSeconds(times[2]);
+                delta.timeLastRxPacket = NanoSeconds(times[3]);
+                delta.lastDelay = NanoSeconds(times[4]);
+                delta.delaySum = NanoSeconds(times[5]);
+                delta.jitterSum = NanoSeconds(times[6]);
+            }
+            if (!complete)
+            {
+                break;
+            }
+
+            for (const auto& [flowId, delta] : deltas)
+            {
+                auto [flowI, inserted] = flowStats.emplace(flowId, delta);
+                FlowStats& stats = flowI->second;
+                if (inserted)
+                {
+                    continue;
+                }
+                // the times are absolute, but a flow freed and seen again
+                // starts a new entry with the same identifier
+                if (stats.txPackets == 0)
+                {
+                    stats.timeFirstTxPacket = delta.timeFirstTxPacket;
+                }
+                if (stats.rxPackets == 0)
+                {
+                    stats.timeFirstRxPacket = delta.timeFirstRxPacket;
+                }
+                if (delta.txPackets > 0)
+                {
+                    stats.timeLastTxPacket = delta.timeLastTxPacket;
+                }
+                if (delta.rxPackets > 0)
+                {
+                    stats.timeLastRxPacket = delta.timeLastRxPacket;
+                    stats.lastDelay = delta.lastDelay;
+                }
+                stats.delaySum += delta.delaySum;
+                stats.jitterSum += delta.jitterSum;
+                stats.txBytes += delta.txBytes;
+                stats.rxBytes += delta.rxBytes;
+                stats.txPackets += delta.txPackets;
+                stats.rxPackets += delta.rxPackets;
+                stats.lostPackets += delta.lostPackets;
+                stats.timesForwarded += delta.timesForwarded;
+                if (stats.packetsDropped.size() < delta.packetsDropped.size())
+                {
+                    stats.packetsDropped.resize(delta.packetsDropped.size(), 0);
+                    stats.bytesDropped.resize(delta.bytesDropped.size(), 0);
+                }
+                for (std::size_t reasonCode = 0; reasonCode < delta.packetsDropped.size();
+                     reasonCode++)
+                {
+                    stats.packetsDropped[reasonCode] += delta.packetsDropped[reasonCode];
+                    stats.bytesDropped[reasonCode] += delta.bytesDropped[reasonCode];
+                }
+            }
+            snapshotTime = NanoSeconds(time);
+        }
+        else if (type == RESET_RECORD)
+        {
+            if (!ReadValue(is, time))
+            {
+                break;
+            }
+            flowStats.clear();
+        }
+        else if (type == CLASSIFIERS_RECORD)
+        {
+            uint32_t size;
+            if (!ReadValue(is, size))
+            {
+                break;
+            }
+            std::string text(size, ' ');
+            if (!is.read(text.data(), size))
+            {
+                break;
+            }
+            classifiers = text;
+        }
+        else
+        {
+            NS_ABORT_MSG("Unknown record type " << +type << " in " << snapshotFileName);
+        }
+    }
+
+    std::ofstream os(xmlFileName, std::ios::out | std::ios::binary);
+    os << "<?xml version=\"1.0\" ?>\n";
+    os << "<FlowMonitor snapshotTime=\"" << snapshotTime.As(Time::NS) << "\">\n";
+    os << "  <FlowStats>\n";
+    for (const auto& [flowId, stats] : flowStats)
+    {
+        SerializeFlowStatsToXmlStream(os, 4, flowId, stats);
+        os << "    </Flow>\n";
+    }
+    os << "  </FlowStats>\n";
+    os << classifiers;
+    os << "</FlowMonitor>\n";
+    os.close();
 }
 
 } // namespace ns3
@@ -23,13 +23,18 @@
 #include "flow-classifier.h"
 #include "flow-probe.h"
 
+#include "ns3/count-min-sketch.h"
+#include "ns3/dd-sketch.h"
 #include "ns3/event-id.h"
 #include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <fstream>
+#include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -136,6 +141,13 @@ class FlowMonitor : public Object
         /// comment in attribute packetsDropped.
         std::vector<uint64_t> bytesDropped;   // bytesDropped[reasonCode] => number of dropped bytes
         Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
+
+        /// Quantile sketch of the packet delays, filled instead of
+        /// delayHistogram if the QuantileSketchAccuracy attribute is set
+        DdSketch delaySketch;
+        /// Quantile sketch of the packet jitters, filled instead of
+        /// jitterHistogram if the QuantileSketchAccuracy attribute is set
+        DdSketch jitterSketch;
     };
 
     // --- basic methods ---
@@ -251,6 +263,22 @@ class FlowMonitor : public Object
     /// \returns a list of all the probes
     const FlowProbeContainer& GetAllProbes() const;
 
+    /// Whether the probes identify the packets by the fixed fields of the
+    /// packets rather than by a byte tag (PacketFixedFields attribute)
+    /// \returns true if the probes use the fixed fields of the packets
+    bool UsesPacketFixedFields() const;
+
+    /// Get the sketch of the number of bytes transmitted by each flow.  It is
+    /// only filled if the FlowSizeSketchEpsilon attribute is set, and it accounts
+    /// for every packet regardless of the PacketSampling attribute.
+    /// \returns the flow size sketch
+    const CountMinSketch& GetFlowSizeSketch() const;
+
+    /// Get the flows with the largest estimated number of transmitted bytes,
+    /// according to the flow size sketch
+    /// \returns (FlowId, estimated bytes) pairs, sorted by decreasing bytes
+    std::vector<std::pair<FlowId, uint64_t>> GetHeavyHitters() const;
+
     /// Serializes the results to an std::ostream in XML format
     /// \param os the output stream
     /// \param indent number of spaces to use as base indentation level
@@ -277,6 +305,21 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// Append the changes of the flow statistics since the last snapshot to the
+    /// snapshot file, and free the flows that have been idle for longer than the
+    /// FlowIdleTimeout attribute.  It is called every SnapshotInterval, and does
+    /// nothing if the attribute is zero.
+    void WriteSnapshot();
+
+    /// Convert a snapshot file written by a FlowMonitor (see the SnapshotInterval
+    /// attribute) to the XML format of SerializeToXmlFile, without the histograms
+    /// and the probes.  The flow statistics are those of the last complete
+    /// snapshot, hence the file can be converted while the simulation is running;
+    /// the classifiers are only written when the simulation is destroyed.
+    /// \param snapshotFileName name or path of the snapshot file
+    /// \param xmlFileName name or path of the output file that will be created
+    static void ConvertSnapshotsToXmlFile(std::string snapshotFileName, std::string xmlFileName);
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -285,6 +328,8 @@ class FlowMonitor : public Object
     /// Structure to represent a single tracked packet data
     struct TrackedPacket
     {
+        FlowId flowId;           //!< flow identification
+        FlowPacketId packetId;   //!< packet identification
         Time firstSeenTime;      //!< absolute time when the packet was first seen by a probe
         Time lastSeenTime;       //!< absolute time when the packet was last seen by a probe
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
@@ -292,12 +337,18 @@ class FlowMonitor : public Object
 
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> FlowStats, to avoid tree lookups (FlowIds are allocated sequentially)
+    std::vector<FlowStats*> m_flowStatsIndex;
 
+    /// Tracked packets, sorted by increasing last seen time
+    typedef std::list<TrackedPacket> TrackedPacketList;
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    typedef std::unordered_map<uint64_t, TrackedPacketList::iterator> TrackedPacketMap;
+    TrackedPacketList m_trackedPacketList; //!< Tracked packets, oldest first
+    TrackedPacketList m_trackedPacketPool; //!< List nodes available for reuse
+    TrackedPacketMap m_trackedPackets;     //!< Tracked packets, indexed by (FlowId,PacketId)
+    Time m_maxPerHopDelay;                 //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes;       //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -316,8 +367,91 @@ class FlowMonitor : public Object
     /// \returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// Get the key of a tracked packet
+    /// \param flowId the Flow identification
+    /// \param packetId the Packet identification
+    /// \returns the key of the packet in the tracked packet map
+    static uint64_t GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId);
+
+    /// Stop tracking a packet
+    /// \param tracked the tracked packet
+    void UntrackPacket(TrackedPacketMap::iterator tracked);
+
+    /// Check whether a packet is accounted for, according to the PacketSampling attribute.
+    /// The decision only depends on the packet identification, hence it is the same
+    /// for all the reports about a packet
+    /// \param flowId the Flow identification
+    /// \param packetId the Packet identification
+    /// \returns true if the packet is accounted for
+    bool IsSampled(FlowId flowId, FlowPacketId packetId) const;
+
+    /// Account for a transmitted packet in the flow size sketch and in the heavy hitters
+    /// \param flowId the Flow identification
+    /// \param packetSize the packet size
+    void UpdateFlowSizeSketch(FlowId flowId, uint32_t packetSize);
+
+    uint32_t m_packetSampling;        //!< Account for one packet every m_packetSampling
+    double m_quantileSketchAccuracy;  //!< Relative accuracy of the sketches (0 to disable)
+    uint32_t m_quantileSketchMaxBins; //!< Maximum number of bins of the sketches
+    double m_flowSizeSketchEpsilon;   //!< Error bound of the flow size sketch (0 to disable)
+    double m_flowSizeSketchDelta;     //!< Probability to exceed the error bound
+    uint32_t m_nHeavyHitters;         //!< Number of heavy hitters to keep track of
+    bool m_packetFixedFields;         //!< Identify the packets by their fixed fields
+    CountMinSketch m_flowSizeSketch;  //!< Number of bytes transmitted by each flow
+    /// Largest flows, according to the flow size sketch
+    std::vector<std::pair<FlowId, uint64_t>> m_heavyHitters;
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Type of the records of a snapshot file
+    enum SnapshotRecordType : uint8_t
+    {
+        SNAPSHOT_RECORD = 1,    //!< changes of the flow statistics
+        RESET_RECORD = 2,       //!< all the statistics were reset
+        CLASSIFIERS_RECORD = 3, //!< XML serialization of the classifiers
+    };
+
+    /// Counters of a flow, as last written to the snapshot file
+    struct SnapshotCounters
+    {
+        Time delaySum;                        //!< sum of the delays
+        Time jitterSum;                       //!< sum of the jitters
+        uint64_t txBytes{0};                  //!< transmitted bytes
+        uint64_t rxBytes{0};                  //!< received bytes
+        uint32_t txPackets{0};                //!< transmitted packets
+        uint32_t rxPackets{0};                //!< received packets
+        uint32_t lostPackets{0};              //!< lost packets
+        uint32_t timesForwarded{0};           //!< times the packets were forwarded
+        std::vector<uint32_t> packetsDropped; //!< dropped packets, per reason code
+        std::vector<uint64_t> bytesDropped;   //!< dropped bytes, per reason code
+    };
+
+    /// Periodic function to write the snapshots
+    void PeriodicWriteSnapshot();
+
+    /// Write a last snapshot and the classifiers, and close the snapshot file
+    void CloseSnapshotFile();
+
+    /// Serializes the counters of a flow, i.e., the start tag of its element and
+    /// the dropped packets and bytes, to an std::ostream in XML format
+    /// \param os the output stream
+    /// \param indent number of spaces to use as base indentation level
+    /// \param flowId the Flow identification
+    /// \param stats the stats of the flow
+    static void SerializeFlowStatsToXmlStream(std::ostream& os,
+                                              uint16_t indent,
+                                              FlowId flowId,
+                                              const FlowStats& stats);
+
+    Time m_snapshotInterval;        //!< Time between snapshots (0 to disable)
+    std::string m_snapshotFileName; //!< Name of the snapshot file
+    Time m_flowIdleTimeout;         //!< Time after which idle flows are freed (0 to disable)
+    std::ofstream m_snapshotFile;   //!< Snapshot file
+    EventId m_snapshotEvent;        //!< Next snapshot event
+    EventId m_snapshotCloseEvent;   //!< Event closing the snapshot file at destroy time
+    /// FlowId --> counters written to the snapshot file
+    std::unordered_map<FlowId, SnapshotCounters> m_snapshotCounters;
 };
 
 } // namespace ns3
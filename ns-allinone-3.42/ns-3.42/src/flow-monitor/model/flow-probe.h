@@ -99,6 +99,10 @@ class FlowProbe : public Object
     /// \returns the partial flow statistics
     Stats GetStats() const;
 
+    /// Remove the statistics of a flow, e.g., when the FlowMonitor frees it
+    /// \param flowId the flow Identifier
+    void RemoveStats(FlowId flowId);
+
     /// Serializes the results to an std::ostream in XML format
     /// \param os the output stream
     /// \param indent number of spaces to use as base indentation level
@@ -26,6 +26,8 @@
 
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -49,6 +51,14 @@ class Ipv4FlowClassifier : public FlowClassifier
         uint16_t destinationPort;       //!< Destination port
     };
 
+    /// Hash function of a FiveTuple
+    struct FiveTupleHash
+    {
+        /// \param tuple the FiveTuple
+        /// \return the hash of the tuple
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
     Ipv4FlowClassifier();
 
     /// \brief try to classify the packet into flow-id and packet-id
@@ -93,12 +103,24 @@ class Ipv4FlowClassifier : public FlowClassifier
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
   private:
+    /// Structure to hold the data of a flow
+    struct Flow
+    {
+        FiveTuple tuple;           //!< Flow identification
+        FlowPacketId lastPacketId; //!< Identifier of the last packet of the flow
+        /// DSCP value --> number of packets
+        std::map<Ipv4Header::DscpType, uint32_t> dscpCounts;
+    };
+
+    /// Get the data of a flow
+    /// \param flowId the FlowId
+    /// \return the data of the flow, or nullptr if the flow is unknown
+    const Flow* GetFlow(FlowId flowId) const;
+
     /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>> m_flowDscpMap;
+    std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+    /// Flows, indexed by FlowId - 1 (the FlowIds are allocated sequentially)
+    std::vector<Flow> m_flows;
 };
 
 /**
@@ -251,7 +251,8 @@ Ipv4FlowProbe::Ipv4FlowProbe(Ptr<FlowMonitor> monitor,
                              Ptr<Ipv4FlowClassifier> classifier,
                              Ptr<Node> node)
     : FlowProbe(monitor),
-      m_classifier(classifier)
+      m_classifier(classifier),
+      m_packetFixedFields(monitor->UsesPacketFixedFields())
 {
     NS_LOG_FUNCTION(this << node->GetId());
 
@@ -336,7 +337,7 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
     }
 
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
     if (found)
     {
         return;
@@ -356,7 +357,7 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
                               size,
                               ipHeader.GetSource(),
                               ipHeader.GetDestination());
-        ipPayload->AddByteTag(fTag);
+        AddTag(ipPayload, fTag);
     }
 }
 
@@ -366,7 +367,7 @@ Ipv4FlowProbe::ForwardLogger(const Ipv4Header& ipHeader,
                              uint32_t interface)
 {
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
 
     if (found)
     {
@@ -375,7 +376,7 @@ Ipv4FlowProbe::ForwardLogger(const Ipv4Header& ipHeader,
             NS_LOG_WARN("Not counting fragmented packets");
             return;
         }
-        if (!fTag.IsSrcDstValid(ipHeader.GetSource(), ipHeader.GetDestination()))
+        if (!m_packetFixedFields && !fTag.IsSrcDstValid(ipHeader.GetSource(), ipHeader.GetDestination()))
         {
             NS_LOG_LOGIC("Not reporting encapsulated packet");
             return;
@@ -397,11 +398,11 @@ Ipv4FlowProbe::ForwardUpLogger(const Ipv4Header& ipHeader,
                                uint32_t interface)
 {
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
 
     if (found)
     {
-        if (!fTag.IsSrcDstValid(ipHeader.GetSource(), ipHeader.GetDestination()))
+        if (!m_packetFixedFields && !fTag.IsSrcDstValid(ipHeader.GetSource(), ipHeader.GetDestination()))
         {
             NS_LOG_LOGIC("Not reporting encapsulated packet");
             return;
@@ -443,7 +444,7 @@ Ipv4FlowProbe::DropLogger(const Ipv4Header& ipHeader,
 #endif
 
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
 
     if (found)
     {
@@ -483,6 +484,10 @@ Ipv4FlowProbe::DropLogger(const Ipv4Header& ipHeader,
             myReason = DROP_FRAGMENT_TIMEOUT;
             NS_LOG_DEBUG("DROP_FRAGMENT_TIMEOUT");
             break;
+        case Ipv4L3Protocol::DROP_FRAGMENT_BUFFER_FULL:
+            myReason = DROP_FRAGMENT_BUFFER_FULL;
+            NS_LOG_DEBUG("DROP_FRAGMENT_BUFFER_FULL");
+            break;
 
         default:
             myReason = DROP_INVALID_REASON;
@@ -497,7 +502,7 @@ void
 Ipv4FlowProbe::QueueDropLogger(Ptr<const Packet> ipPayload)
 {
     Ipv4FlowProbeTag fTag;
-    bool tagFound = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindTag(ipPayload, fTag);
 
     if (!tagFound)
     {
@@ -518,7 +523,7 @@ void
 Ipv4FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
 {
     Ipv4FlowProbeTag fTag;
-    bool tagFound = item->GetPacket()->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindTag(item->GetPacket(), fTag);
 
     if (!tagFound)
     {
@@ -535,4 +540,42 @@ Ipv4FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
     m_flowMonitor->ReportDrop(this, flowId, packetId, size, DROP_QUEUE_DISC);
 }
 
+void
+Ipv4FlowProbe::AddTag(Ptr<const Packet> ipPayload, const Ipv4FlowProbeTag& tag) const
+{
+    if (m_packetFixedFields)
+    {
+        // the user data holds the packet id, the IP version, so that the
+        // probes of the other version ignore the packet, and the packet size
+        NS_ASSERT_MSG(tag.GetPacketSize() < (1 << 24), "Packet too large for the fixed fields");
+        ipPayload->SetFlowId(tag.GetFlowId());
+        ipPayload->SetUserData(static_cast<uint64_t>(tag.GetPacketId()) << 32 | 4 << 24 |
+                               tag.GetPacketSize());
+    }
+    else
+    {
+        ipPayload->AddByteTag(tag);
+    }
+}
+
+bool
+Ipv4FlowProbe::FindTag(Ptr<const Packet> ipPayload, Ipv4FlowProbeTag& tag) const
+{
+    if (!m_packetFixedFields)
+    {
+        return ipPayload->FindFirstMatchingByteTag(tag);
+    }
+    uint32_t flowId;
+    uint64_t userData;
+    if (!ipPayload->GetFlowId(flowId) || !ipPayload->GetUserData(userData) ||
+        (userData >> 24 & 0xff) != 4)
+    {
+        return false;
+    }
+    tag.SetFlowId(flowId);
+    tag.SetPacketId(userData >> 32);
+    tag.SetPacketSize(userData & 0xffffff);
+    return true;
+}
+
 } // namespace ns3
@@ -30,6 +30,7 @@ namespace ns3
 {
 
 class FlowMonitor;
+class Ipv4FlowProbeTag;
 class Node;
 
 /// \ingroup flow-monitor
@@ -74,9 +75,10 @@ class Ipv4FlowProbe : public FlowProbe
         /// Packet dropped by the queue disc
         DROP_QUEUE_DISC,
 
-        DROP_INTERFACE_DOWN,   /**< Interface is down so can not send packet */
-        DROP_ROUTE_ERROR,      /**< Route error */
-        DROP_FRAGMENT_TIMEOUT, /**< Fragment timeout exceeded */
+        DROP_INTERFACE_DOWN,       /**< Interface is down so can not send packet */
+        DROP_ROUTE_ERROR,          /**< Route error */
+        DROP_FRAGMENT_TIMEOUT,     /**< Fragment timeout exceeded */
+        DROP_FRAGMENT_BUFFER_FULL, /**< Fragment reassembly buffer full */
 
         DROP_INVALID_REASON, /**< Fallback reason (no known reason) */
     };
@@ -122,8 +124,20 @@ class Ipv4FlowProbe : public FlowProbe
     /// \param item queue disc item
     void QueueDiscDropLogger(Ptr<const QueueDiscItem> item);
 
+    /// Mark a packet with its flow and packet identifiers, in a byte tag or
+    /// in its fixed fields (FlowMonitor PacketFixedFields attribute)
+    /// \param ipPayload IP payload
+    /// \param tag the flow and packet identifiers
+    void AddTag(Ptr<const Packet> ipPayload, const Ipv4FlowProbeTag& tag) const;
+    /// Find the flow and packet identifiers a packet was marked with by AddTag()
+    /// \param ipPayload IP payload
+    /// \param tag the flow and packet identifiers
+    /// \returns true if the packet was marked
+    bool FindTag(Ptr<const Packet> ipPayload, Ipv4FlowProbeTag& tag) const;
+
     Ptr<Ipv4FlowClassifier> m_classifier; //!< the Ipv4FlowClassifier this probe is associated with
     Ptr<Ipv4L3Protocol> m_ipv4;           //!< the Ipv4L3Protocol this probe is bound to
+    bool m_packetFixedFields;             //!< whether to mark the packets in their fixed fields
 };
 
 } // namespace ns3
@@ -209,7 +209,8 @@ Ipv6FlowProbe::Ipv6FlowProbe(Ptr<FlowMonitor> monitor,
                              Ptr<Ipv6FlowClassifier> classifier,
                              Ptr<Node> node)
     : FlowProbe(monitor),
-      m_classifier(classifier)
+      m_classifier(classifier),
+      m_packetFixedFields(monitor->UsesPacketFixedFields())
 {
     NS_LOG_FUNCTION(this << node->GetId());
 
@@ -295,7 +296,7 @@ Ipv6FlowProbe::SendOutgoingLogger(const Ipv6Header& ipHeader,
         // tag the packet with the flow id and packet id, so that the packet can be identified even
         // when Ipv6Header is not accessible at some non-IPv6 protocol layer
         Ipv6FlowProbeTag fTag(flowId, packetId, size);
-        ipPayload->AddByteTag(fTag);
+        AddTag(ipPayload, fTag);
     }
 }
 
@@ -305,7 +306,7 @@ Ipv6FlowProbe::ForwardLogger(const Ipv6Header& ipHeader,
                              uint32_t interface)
 {
     Ipv6FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
 
     if (found)
     {
@@ -325,7 +326,7 @@ Ipv6FlowProbe::ForwardUpLogger(const Ipv6Header& ipHeader,
                                uint32_t interface)
 {
     Ipv6FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
 
     if (found)
     {
@@ -365,7 +366,7 @@ Ipv6FlowProbe::DropLogger(const Ipv6Header& ipHeader,
 #endif
 
     Ipv6FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindTag(ipPayload, fTag);
 
     if (found)
     {
@@ -413,6 +414,10 @@ Ipv6FlowProbe::DropLogger(const Ipv6Header& ipHeader,
             myReason = DROP_FRAGMENT_TIMEOUT;
             NS_LOG_DEBUG("DROP_FRAGMENT_TIMEOUT");
             break;
+        case Ipv6L3Protocol::DROP_FRAGMENT_BUFFER_FULL:
+            myReason = DROP_FRAGMENT_BUFFER_FULL;
+            NS_LOG_DEBUG("DROP_FRAGMENT_BUFFER_FULL");
+            break;
         default:
             myReason = DROP_INVALID_REASON;
             NS_FATAL_ERROR("Unexpected drop reason code " << reason);
@@ -426,7 +431,7 @@ void
 Ipv6FlowProbe::QueueDropLogger(Ptr<const Packet> ipPayload)
 {
     Ipv6FlowProbeTag fTag;
-    bool tagFound = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindTag(ipPayload, fTag);
 
     if (!tagFound)
     {
@@ -447,7 +452,7 @@ void
 Ipv6FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
 {
     Ipv6FlowProbeTag fTag;
-    bool tagFound = item->GetPacket()->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindTag(item->GetPacket(), fTag);
 
     if (!tagFound)
     {
@@ -464,4 +469,42 @@ Ipv6FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
     m_flowMonitor->ReportDrop(this, flowId, packetId, size, DROP_QUEUE_DISC);
 }
 
+void
+Ipv6FlowProbe::AddTag(Ptr<const Packet> ipPayload, const Ipv6FlowProbeTag& tag) const
+{
+    if (m_packetFixedFields)
+    {
+        // the user data holds the packet id, the IP version, so that the
+        // probes of the other version ignore the packet, and the packet size
+        NS_ASSERT_MSG(tag.GetPacketSize() < (1 << 24), "Packet too large for the fixed fields");
+        ipPayload->SetFlowId(tag.GetFlowId());
+        ipPayload->SetUserData(static_cast<uint64_t>(tag.GetPacketId()) << 32 | 6 << 24 |
+                               tag.GetPacketSize());
+    }
+    else
+    {
+        ipPayload->AddByteTag(tag);
+    }
+}
+
+bool
+Ipv6FlowProbe::FindTag(Ptr<const Packet> ipPayload, Ipv6FlowProbeTag& tag) const
+{
+    if (!m_packetFixedFields)
+    {
+        return ipPayload->FindFirstMatchingByteTag(tag);
+    }
+    uint32_t flowId;
+    uint64_t userData;
+    if (!ipPayload->GetFlowId(flowId) || !ipPayload->GetUserData(userData) ||
+        (userData >> 24 & 0xff) != 6)
+    {
+        return false;
+    }
+    tag.SetFlowId(flowId);
+    tag.SetPacketId(userData >> 32);
+    tag.SetPacketSize(userData & 0xffffff);
+    return true;
+}
+
 } // namespace ns3
@@ -31,6 +31,7 @@ namespace ns3
 {
 
 class FlowMonitor;
+class Ipv6FlowProbeTag;
 class Node;
 
 /// \ingroup flow-monitor
@@ -82,7 +83,8 @@ class Ipv6FlowProbe : public FlowProbe
         DROP_UNKNOWN_OPTION,   /**< Unknown option */
         DROP_MALFORMED_HEADER, /**< Malformed header */
 
-        DROP_FRAGMENT_TIMEOUT, /**< Fragment timeout exceeded */
+        DROP_FRAGMENT_TIMEOUT,     /**< Fragment timeout exceeded */
+        DROP_FRAGMENT_BUFFER_FULL, /**< Fragment reassembly buffer full */
 
         DROP_INVALID_REASON, /**< Fallback reason (no known reason) */
     };
@@ -128,7 +130,19 @@ class Ipv6FlowProbe : public FlowProbe
     /// \param item queue disc item
     void QueueDiscDropLogger(Ptr<const QueueDiscItem> item);
 
+    /// Mark a packet with its flow and packet identifiers, in a byte tag or
+    /// in its fixed fields (FlowMonitor PacketFixedFields attribute)
+    /// \param ipPayload IP payload
+    /// \param tag the flow and packet identifiers
+    void AddTag(Ptr<const Packet> ipPayload, const Ipv6FlowProbeTag& tag) const;
+    /// Find the flow and packet identifiers a packet was marked with by AddTag()
+    /// \param ipPayload IP payload
+    /// \param tag the flow and packet identifiers
+    /// \returns true if the packet was marked
+    bool FindTag(Ptr<const Packet> ipPayload, Ipv6FlowProbeTag& tag) const;
+
     Ptr<Ipv6FlowClassifier> m_classifier; //!< the Ipv6FlowClassifier this probe is associated with
+    bool m_packetFixedFields;             //!< whether to mark the packets in their fixed fields
 };
 
 } // namespace ns3
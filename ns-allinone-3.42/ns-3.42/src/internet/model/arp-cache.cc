@@ -30,6 +30,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -199,9 +202,11 @@ ArpCache::HandleWaitReplyTimeout()
     NS_LOG_FUNCTION(this);
     ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // entries leave the set when marked dead, so iterate on a copy
+    std::vector<Ipv4Address> waitReply(m_waitReply.begin(), m_waitReply.end());
+    for (const auto& address : waitReply)
     {
-        entry = (*i).second;
+        entry = Lookup(address);
         if (entry != nullptr && entry->IsWaitReply())
         {
             if (entry->GetRetries() < m_maxRetries)
@@ -250,6 +255,7 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_waitReply.clear();
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -264,7 +270,14 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries sorted by address
+    std::vector<std::pair<Ipv4Address, ArpCache::Entry*>> entries(m_arpCache.begin(),
+                                                                   m_arpCache.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -365,15 +378,17 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
+        m_arpCache.erase(i);
+        if (entry->IsWaitReply())
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
-            return;
+            m_waitReply.erase(entry->GetIpv4Address());
         }
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
     }
     NS_LOG_WARN("Entry not found in this ARP Cache");
 }
@@ -426,6 +441,10 @@ ArpCache::Entry::MarkDead()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
+    if (m_state == WAIT_REPLY)
+    {
+        m_arp->m_waitReply.erase(m_ipv4Address);
+    }
     m_state = DEAD;
     ClearRetries();
     UpdateSeen();
@@ -436,6 +455,7 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
+    m_arp->m_waitReply.erase(m_ipv4Address);
     m_macAddress = macAddress;
     m_state = ALIVE;
     ClearRetries();
@@ -448,6 +468,10 @@ ArpCache::Entry::MarkPermanent()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
+    if (m_state == WAIT_REPLY)
+    {
+        m_arp->m_waitReply.erase(m_ipv4Address);
+    }
     m_state = PERMANENT;
     ClearRetries();
     UpdateSeen();
@@ -459,6 +483,10 @@ ArpCache::Entry::MarkAutoGenerated()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
+    if (m_state == WAIT_REPLY)
+    {
+        m_arp->m_waitReply.erase(m_ipv4Address);
+    }
     m_state = STATIC_AUTOGENERATED;
     ClearRetries();
     UpdateSeen();
@@ -490,6 +518,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     NS_ASSERT_MSG(waiting.first, "Can not add a null packet to the ARP queue");
 
     m_state = WAIT_REPLY;
+    m_arp->m_waitReply.insert(m_ipv4Address);
     m_pending.push_back(waiting);
     UpdateSeen();
     m_arp->StartWaitReplyTimer();
@@ -29,14 +29,21 @@
 #include "ipv4.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <queue>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,6 +52,29 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * \ingroup globalrouting
+ * Number of threads computing the shortest path trees of the routers.
+ */
+static GlobalValue g_globalRoutingSpfThreads(
+    "GlobalRoutingSpfThreads",
+    "Number of threads (including the simulation thread) computing the shortest path trees "
+    "of the global routers; 0 means one for each hardware thread",
+    UintegerValue(1),
+    MakeUintegerChecker<uint32_t>());
+
+/**
+ * \ingroup globalrouting
+ * Whether the shortest path trees are kept to recompute the routes incrementally.
+ */
+static GlobalValue g_globalRoutingIncrementalSpf(
+    "GlobalRoutingIncrementalSpf",
+    "Keep the shortest path trees of the global routers so that, when the routes are "
+    "recomputed, only the routers whose tree is affected by the changes run the SPF "
+    "calculation again",
+    BooleanValue(false),
+    MakeBooleanChecker());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -473,6 +503,7 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     {
         m_database.insert(LSDBPair_t(addr, lsa));
     }
+    m_adjacencyBuilt = false;
 }
 
 GlobalRoutingLSA*
@@ -496,12 +527,10 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -510,6 +539,11 @@ GlobalRoutingLSA*
 GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
+    if (m_adjacencyBuilt)
+    {
+        auto it = m_linkDataLsa.find(addr.Get());
+        return it != m_linkDataLsa.end() ? it->second : nullptr;
+    }
     //
     // Look up an LSA by its address.
     //
@@ -530,6 +564,100 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
     return nullptr;
 }
 
+void
+GlobalRouteManagerLSDB::BuildAdjacency()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_adjacencyBuilt)
+    {
+        return;
+    }
+    m_lsas.clear();
+    m_lsaIndex.clear();
+    m_linkDataLsa.clear();
+    m_adjacencyStart.clear();
+    m_adjacencies.clear();
+
+    for (const auto& [id, lsa] : m_database)
+    {
+        m_lsaIndex.emplace(lsa, m_lsas.size());
+        m_lsas.push_back(lsa);
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                // the first LSA in the database wins, as in the linear search
+                m_linkDataLsa.emplace(lr->GetLinkData().Get(), lsa);
+            }
+        }
+    }
+    // the lookups resolving the adjacencies below use the indexes built above
+    m_adjacencyBuilt = true;
+    for (auto lsa : m_lsas)
+    {
+        m_adjacencyStart.push_back(m_adjacencies.size());
+        if (lsa->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+            {
+                GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+                GlobalRoutingLSA* w = nullptr;
+                if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint ||
+                    lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                    w = GetLSA(lr->GetLinkId());
+                }
+                m_adjacencies.push_back({lr, GetLSAIndex(w)});
+            }
+        }
+        else if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+        {
+            for (uint32_t j = 0; j < lsa->GetNAttachedRouters(); j++)
+            {
+                GlobalRoutingLSA* w = GetLSAByLinkData(lsa->GetAttachedRouter(j));
+                m_adjacencies.push_back({nullptr, GetLSAIndex(w)});
+            }
+        }
+    }
+    m_adjacencyStart.push_back(m_adjacencies.size());
+}
+
+uint32_t
+GlobalRouteManagerLSDB::GetNumLSAs() const
+{
+    return m_database.size();
+}
+
+GlobalRoutingLSA*
+GlobalRouteManagerLSDB::GetLSAByIndex(uint32_t index) const
+{
+    NS_ASSERT_MSG(m_adjacencyBuilt, "The adjacency of the LSDB is not built");
+    return m_lsas[index];
+}
+
+uint32_t
+GlobalRouteManagerLSDB::GetLSAIndex(const GlobalRoutingLSA* lsa) const
+{
+    NS_ASSERT_MSG(m_adjacencyBuilt, "The adjacency of the LSDB is not built");
+    auto it = m_lsaIndex.find(lsa);
+    return it != m_lsaIndex.end() ? it->second : NO_LSA;
+}
+
+uint32_t
+GlobalRouteManagerLSDB::GetNAdjacencies(uint32_t index) const
+{
+    NS_ASSERT_MSG(m_adjacencyBuilt, "The adjacency of the LSDB is not built");
+    return m_adjacencyStart[index + 1] - m_adjacencyStart[index];
+}
+
+const GlobalRouteManagerLSDB::Adjacency&
+GlobalRouteManagerLSDB::GetAdjacency(uint32_t index, uint32_t i) const
+{
+    NS_ASSERT_MSG(m_adjacencyBuilt, "The adjacency of the LSDB is not built");
+    return m_adjacencies[m_adjacencyStart[index] + i];
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerImpl Implementation
@@ -537,19 +665,37 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_ownsLsdb(true),
+      m_router(nullptr),
+      m_spfTree(nullptr),
+      m_previousLsdb(nullptr)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb,
+                                               const std::map<Ipv4Address, SPFRouter>& routers)
+    : m_spfroot(nullptr),
+      m_lsdb(lsdb),
+      m_ownsLsdb(false),
+      m_routers(routers),
+      m_router(nullptr),
+      m_spfTree(nullptr),
+      m_previousLsdb(nullptr)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    if (m_lsdb && m_ownsLsdb)
     {
         delete m_lsdb;
     }
+    delete m_previousLsdb;
 }
 
 void
@@ -561,6 +707,9 @@ GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
         delete m_lsdb;
     }
     m_lsdb = lsdb;
+    delete m_previousLsdb;
+    m_previousLsdb = nullptr;
+    m_trees.clear();
 }
 
 void
@@ -592,11 +741,44 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
     if (m_lsdb)
     {
         NS_LOG_LOGIC("Deleting LSDB, creating new one");
-        delete m_lsdb;
+        delete m_previousLsdb;
+        m_previousLsdb = nullptr;
+        BooleanValue incremental;
+        g_globalRoutingIncrementalSpf.GetValue(incremental);
+        if (incremental.Get())
+        {
+            // the next calculation finds the trees affected by the changes
+            // by comparing the new LSDB with this one
+            m_previousLsdb = m_lsdb;
+        }
+        else
+        {
+            delete m_lsdb;
+            m_trees.clear();
+        }
         m_lsdb = new GlobalRouteManagerLSDB();
     }
 }
 
+void
+GlobalRouteManagerImpl::CollectRouters()
+{
+    NS_LOG_FUNCTION(this);
+    m_routers.clear();
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr)
+        {
+            continue;
+        }
+        // as in a walk of the node list, the first node with the router ID wins
+        m_routers.emplace(rtr->GetRouterId(),
+                          SPFRouter{node->GetObject<Ipv4>(), rtr->GetRoutingProtocol()});
+    }
+}
+
 //
 // In order to build the routing database, we need to walk the list of nodes
 // in the system and look for those that support the GlobalRouter interface.
@@ -696,6 +878,9 @@ GlobalRouteManagerImpl::InitializeRoutes()
     // Walk the list of nodes in the system.
     //
     NS_LOG_INFO("About to start SPF calculation");
+    CollectRouters();
+    m_lsdb->BuildAdjacency();
+    std::vector<Ipv4Address> roots;
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -718,7 +903,89 @@ GlobalRouteManagerImpl::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.push_back(rtr->GetRouterId());
+        }
+    }
+
+    //
+    // With the incremental calculation, the trees which survive the changes of
+    // the LSDB since the previous calculation only fill the routing tables again.
+    //
+    BooleanValue incremental;
+    g_globalRoutingIncrementalSpf.GetValue(incremental);
+    std::vector<SPFTree> trees(incremental.Get() ? roots.size() : 0);
+    std::vector<bool> replay(roots.size(), false);
+    if (incremental.Get() && m_previousLsdb)
+    {
+        SPFChanges changes;
+        FindSPFChanges(changes);
+        uint32_t nReplayed = 0;
+        for (std::size_t i = 0; i < roots.size(); i++)
+        {
+            auto it = m_trees.find(roots[i]);
+            if (it != m_trees.end() && IsSPFTreeValid(roots[i], it->second, changes))
+            {
+                trees[i] = RenumberSPFTree(it->second);
+                replay[i] = true;
+                nReplayed++;
+            }
+        }
+        NS_LOG_INFO(nReplayed << " of " << roots.size() << " trees survive the changes");
+    }
+    m_trees.clear();
+    delete m_previousLsdb;
+    m_previousLsdb = nullptr;
+
+    //
+    // The calculations of the routers only share the (read-only) LSDB: each one
+    // has its own SPF state and only writes to the routing table of its root,
+    // hence they can run on several threads.
+    //
+    UintegerValue threads;
+    g_globalRoutingSpfThreads.GetValue(threads);
+    std::size_t nThreads = threads.Get();
+    if (nThreads == 0)
+    {
+        nThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    nThreads = std::max<std::size_t>(1, std::min(nThreads, roots.size()));
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&](GlobalRouteManagerImpl* calculator) {
+        for (std::size_t i = next++; i < roots.size(); i = next++)
+        {
+            if (replay[i])
+            {
+                calculator->SPFReplay(roots[i], trees[i]);
+                continue;
+            }
+            calculator->m_spfTree = incremental.Get() ? &trees[i] : nullptr;
+            calculator->SPFCalculate(roots[i]);
+            calculator->m_spfTree = nullptr;
+        }
+    };
+    // copy the routers to all the workers before starting any of them
+    std::vector<std::unique_ptr<GlobalRouteManagerImpl>> workers;
+    for (std::size_t t = 1; t < nThreads; t++)
+    {
+        workers.emplace_back(new GlobalRouteManagerImpl(m_lsdb, m_routers));
+    }
+    std::vector<std::thread> workerThreads;
+    for (auto& worker : workers)
+    {
+        workerThreads.emplace_back(work, worker.get());
+    }
+    work(this);
+    for (auto& thread : workerThreads)
+    {
+        thread.join();
+    }
+
+    if (incremental.Get())
+    {
+        for (std::size_t i = 0; i < roots.size(); i++)
+        {
+            m_trees.emplace(roots[i], std::move(trees[i]));
         }
     }
     NS_LOG_INFO("Finished SPF calculation");
@@ -746,22 +1013,18 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
     GlobalRoutingLSA* w_lsa = nullptr;
     GlobalRoutingLinkRecord* l = nullptr;
     uint32_t distance = 0;
-    uint32_t numRecordsInVertex = 0;
     //
     // V points to a Router-LSA or Network-LSA
-    // Loop over the links in router LSA or attached routers in Network LSA
+    // Loop over the links in router LSA or attached routers in Network LSA,
+    // which the LSDB has already resolved to the LSAs at their other end
     //
-    if (v->GetVertexType() == SPFVertex::VertexRouter)
-    {
-        numRecordsInVertex = v->GetLSA()->GetNLinkRecords();
-    }
-    if (v->GetVertexType() == SPFVertex::VertexNetwork)
-    {
-        numRecordsInVertex = v->GetLSA()->GetNAttachedRouters();
-    }
+    uint32_t vIndex = m_lsdb->GetLSAIndex(v->GetLSA());
+    NS_ASSERT(vIndex != GlobalRouteManagerLSDB::NO_LSA);
+    uint32_t numRecordsInVertex = m_lsdb->GetNAdjacencies(vIndex);
 
     for (uint32_t i = 0; i < numRecordsInVertex; i++)
     {
+        const GlobalRouteManagerLSDB::Adjacency& adjacency = m_lsdb->GetAdjacency(vIndex, i);
         // Get w_lsa:  In case of V is Router-LSA
         if (v->GetVertexType() == SPFVertex::VertexRouter)
         {
@@ -772,7 +1035,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             // Links to stub networks will be considered in the second stage of the
             // shortest path calculation.
             //
-            l = v->GetLSA()->GetLinkRecord(i);
+            l = adjacency.record;
             NS_ASSERT(l != nullptr);
             if (l->GetLinkType() == GlobalRoutingLinkRecord::StubNetwork)
             {
@@ -790,15 +1053,15 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                 // Lookup the link state advertisement of the new link -- we call it <w> in
                 // the link state database.
                 //
-                w_lsa = m_lsdb->GetLSA(l->GetLinkId());
-                NS_ASSERT(w_lsa);
+                NS_ASSERT(adjacency.lsa != GlobalRouteManagerLSDB::NO_LSA);
+                w_lsa = m_lsdb->GetLSAByIndex(adjacency.lsa);
                 NS_LOG_LOGIC("Found a P2P record from " << v->GetVertexId() << " to "
                                                         << w_lsa->GetLinkStateId());
             }
             else if (l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
             {
-                w_lsa = m_lsdb->GetLSA(l->GetLinkId());
-                NS_ASSERT(w_lsa);
+                NS_ASSERT(adjacency.lsa != GlobalRouteManagerLSDB::NO_LSA);
+                w_lsa = m_lsdb->GetLSAByIndex(adjacency.lsa);
                 NS_LOG_LOGIC("Found a Transit record from " << v->GetVertexId() << " to "
                                                             << w_lsa->GetLinkStateId());
             }
@@ -810,11 +1073,11 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // Get w_lsa:  In case of V is Network-LSA
         if (v->GetVertexType() == SPFVertex::VertexNetwork)
         {
-            w_lsa = m_lsdb->GetLSAByLinkData(v->GetLSA()->GetAttachedRouter(i));
-            if (!w_lsa)
+            if (adjacency.lsa == GlobalRouteManagerLSDB::NO_LSA)
             {
                 continue;
             }
+            w_lsa = m_lsdb->GetLSAByIndex(adjacency.lsa);
             NS_LOG_LOGIC("Found a Network LSA from " << v->GetVertexId() << " to "
                                                      << w_lsa->GetLinkStateId());
         }
@@ -827,7 +1090,8 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        GlobalRoutingLSA::SPFStatus& w_status = m_spfStatus[adjacency.lsa];
+        if (w_status == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -851,7 +1115,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        if (w_status == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -863,7 +1127,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             w = new SPFVertex(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+                w_status = GlobalRoutingLSA::LSA_SPF_CANDIDATE;
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -880,7 +1144,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                                   << "return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+        else if (w_status == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -1234,6 +1498,8 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
+    CollectRouters();
+    m_lsdb->BuildAdjacency();
     SPFCalculate(root);
 }
 
@@ -1303,14 +1569,12 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
-                    NS_ASSERT(router);
-                    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                    NS_ASSERT(gr);
-                    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
-                                          Ipv4Mask("0.0.0.0"),
-                                          lr->GetLinkData(),
-                                          FindOutgoingInterfaceId(transitLink->GetLinkData()));
+                    NS_ASSERT(m_router && m_router->routing);
+                    m_router->routing->AddNetworkRouteTo(
+                        Ipv4Address("0.0.0.0"),
+                        Ipv4Mask("0.0.0.0"),
+                        lr->GetLinkData(),
+                        FindOutgoingInterfaceId(transitLink->GetLinkData()));
                     NS_LOG_LOGIC("Inserting default route for node "
                                  << myRouterId << " to next hop " << lr->GetLinkData()
                                  << " via interface "
@@ -1331,9 +1595,12 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
 
     SPFVertex* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the SPF status of the LSAs.  It is kept here rather than in the
+    // (shared) Link State Database, so that several roots can be calculated at once.
     //
-    m_lsdb->Initialize();
+    m_spfStatus.assign(m_lsdb->GetNumLSAs(), GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
+    auto router = m_routers.find(root);
+    m_router = router != m_routers.end() ? &router->second : nullptr;
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1353,7 +1620,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     m_spfroot = v;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+    m_spfStatus[m_lsdb->GetLSAIndex(v->GetLSA())] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
 
     //
@@ -1363,12 +1630,15 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (m_router && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
+        m_spfroot = nullptr;
+        m_router = nullptr;
         return;
     }
+    SPFRecordVertex(v);
 
     for (;;)
     {
@@ -1414,7 +1684,8 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        m_spfStatus[m_lsdb->GetLSAIndex(v->GetLSA())] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
+        SPFRecordVertex(v);
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
@@ -1488,6 +1759,359 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     delete m_spfroot;
     m_spfroot = nullptr;
+    m_router = nullptr;
+}
+
+void
+GlobalRouteManagerImpl::SPFRecordVertex(SPFVertex* v)
+{
+    NS_LOG_FUNCTION(this << v);
+    if (!m_spfTree)
+    {
+        return;
+    }
+    SPFTree::Vertex vertex;
+    vertex.lsa = m_lsdb->GetLSAIndex(v->GetLSA());
+    vertex.distance = v->GetDistanceFromRoot();
+    vertex.firstExit = m_spfTree->exits.size();
+    vertex.nExits = v->GetNRootExitDirections();
+    for (uint32_t i = 0; i < vertex.nExits; i++)
+    {
+        m_spfTree->exits.push_back(v->GetRootExitDirection(i));
+    }
+    m_spfTree->vertices.push_back(vertex);
+}
+
+namespace
+{
+
+/**
+ * @brief Check whether two LSAs have the same content.
+ *
+ * @param a the first LSA
+ * @param b the second LSA
+ * @returns true if the LSAs are the same for the SPF calculation
+ */
+bool
+IsSameLSA(const GlobalRoutingLSA& a, const GlobalRoutingLSA& b)
+{
+    if (a.GetLSType() != b.GetLSType() || a.GetLinkStateId() != b.GetLinkStateId() ||
+        a.GetAdvertisingRouter() != b.GetAdvertisingRouter() ||
+        a.GetNetworkLSANetworkMask() != b.GetNetworkLSANetworkMask() ||
+        a.GetNLinkRecords() != b.GetNLinkRecords() ||
+        a.GetNAttachedRouters() != b.GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.GetNLinkRecords(); i++)
+    {
+        const GlobalRoutingLinkRecord* la = a.GetLinkRecord(i);
+        const GlobalRoutingLinkRecord* lb = b.GetLinkRecord(i);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric())
+        {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < a.GetNAttachedRouters(); i++)
+    {
+        if (a.GetAttachedRouter(i) != b.GetAttachedRouter(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// An edge of the SPF graph: link state ID of the destination and cost
+typedef std::pair<uint32_t, uint32_t> SPFEdge;
+
+/**
+ * @brief Get the edges of the SPF graph leaving a vertex, sorted.
+ *
+ * @param lsdb the LSDB, with its adjacency built
+ * @param index the index of the LSA of the vertex
+ * @param [out] edges the edges
+ */
+void
+GetSPFEdges(const GlobalRouteManagerLSDB* lsdb, uint32_t index, std::vector<SPFEdge>& edges)
+{
+    edges.clear();
+    for (uint32_t i = 0; i < lsdb->GetNAdjacencies(index); i++)
+    {
+        const GlobalRouteManagerLSDB::Adjacency& adjacency = lsdb->GetAdjacency(index, i);
+        if (adjacency.lsa == GlobalRouteManagerLSDB::NO_LSA)
+        {
+            continue;
+        }
+        // the edges from a network to its routers cost nothing
+        uint32_t metric = adjacency.record ? adjacency.record->GetMetric() : 0;
+        edges.emplace_back(lsdb->GetLSAByIndex(adjacency.lsa)->GetLinkStateId().Get(), metric);
+    }
+    std::sort(edges.begin(), edges.end());
+}
+
+/**
+ * @brief Check whether a vertex, or the vertices whose link records decide
+ * its exit directions, changed.
+ *
+ * @param lsdb the LSDB, with its adjacency built
+ * @param root the index of the LSA of the vertex
+ * @param changed whether each LSA of the LSDB changed
+ * @returns true if the vertex or one of its neighbors (through a network) changed
+ */
+bool
+IsChangedNearRoot(const GlobalRouteManagerLSDB* lsdb,
+                  uint32_t root,
+                  const std::vector<bool>& changed)
+{
+    if (changed[root])
+    {
+        return true;
+    }
+    for (uint32_t i = 0; i < lsdb->GetNAdjacencies(root); i++)
+    {
+        uint32_t w = lsdb->GetAdjacency(root, i).lsa;
+        if (w == GlobalRouteManagerLSDB::NO_LSA)
+        {
+            continue;
+        }
+        if (changed[w])
+        {
+            return true;
+        }
+        if (lsdb->GetLSAByIndex(w)->GetLSType() != GlobalRoutingLSA::NetworkLSA)
+        {
+            continue;
+        }
+        for (uint32_t j = 0; j < lsdb->GetNAdjacencies(w); j++)
+        {
+            uint32_t x = lsdb->GetAdjacency(w, j).lsa;
+            if (x != GlobalRouteManagerLSDB::NO_LSA && changed[x])
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void
+GlobalRouteManagerImpl::FindSPFChanges(SPFChanges& changes) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_previousLsdb);
+    m_previousLsdb->BuildAdjacency();
+    // the LSAs which are not in the previous LSDB are new
+    changes.previousChanged.assign(m_previousLsdb->GetNumLSAs(), false);
+    changes.changed.assign(m_lsdb->GetNumLSAs(), true);
+    changes.removed.clear();
+    changes.added.clear();
+
+    auto previousIndex = [this](uint32_t id) {
+        return m_previousLsdb->GetLSAIndex(m_previousLsdb->GetLSA(Ipv4Address(id)));
+    };
+    std::vector<SPFEdge> before;
+    std::vector<SPFEdge> after;
+    std::vector<SPFEdge> difference;
+    for (uint32_t i = 0; i < m_previousLsdb->GetNumLSAs(); i++)
+    {
+        GlobalRoutingLSA* previous = m_previousLsdb->GetLSAByIndex(i);
+        GlobalRoutingLSA* current = m_lsdb->GetLSA(previous->GetLinkStateId());
+        uint32_t j = m_lsdb->GetLSAIndex(current);
+        bool same = current && IsSameLSA(*previous, *current);
+        changes.previousChanged[i] = !same;
+        if (j != GlobalRouteManagerLSDB::NO_LSA)
+        {
+            changes.changed[j] = !same;
+        }
+        GetSPFEdges(m_previousLsdb, i, before);
+        after.clear();
+        if (j != GlobalRouteManagerLSDB::NO_LSA)
+        {
+            GetSPFEdges(m_lsdb, j, after);
+        }
+        // the edges leaving the new LSAs can only matter if an edge reaches
+        // them, which is an added edge of an existing LSA
+        difference.clear();
+        std::set_difference(before.begin(),
+                            before.end(),
+                            after.begin(),
+                            after.end(),
+                            std::back_inserter(difference));
+        for (const auto& [id, metric] : difference)
+        {
+            changes.removed.push_back({i, previousIndex(id), metric});
+        }
+        difference.clear();
+        std::set_difference(after.begin(),
+                            after.end(),
+                            before.begin(),
+                            before.end(),
+                            std::back_inserter(difference));
+        for (const auto& [id, metric] : difference)
+        {
+            changes.added.push_back({i, previousIndex(id), metric});
+        }
+    }
+    NS_LOG_LOGIC(changes.removed.size() << " edges removed, " << changes.added.size()
+                                        << " edges added");
+}
+
+bool
+GlobalRouteManagerImpl::IsSPFTreeValid(Ipv4Address root,
+                                       const SPFTree& tree,
+                                       const SPFChanges& changes) const
+{
+    NS_LOG_FUNCTION(this << root);
+    // the calculation of a stub router stops before recording the tree
+    if (tree.vertices.empty())
+    {
+        return false;
+    }
+    uint32_t currentRoot = m_lsdb->GetLSAIndex(m_lsdb->GetLSA(root));
+    if (currentRoot == GlobalRouteManagerLSDB::NO_LSA ||
+        IsChangedNearRoot(m_previousLsdb, tree.vertices[0].lsa, changes.previousChanged) ||
+        IsChangedNearRoot(m_lsdb, currentRoot, changes.changed))
+    {
+        return false;
+    }
+
+    std::vector<uint64_t> distance(m_previousLsdb->GetNumLSAs(), SPF_INFINITY);
+    for (const auto& vertex : tree.vertices)
+    {
+        distance[vertex.lsa] = vertex.distance;
+    }
+    for (const auto& edge : changes.removed)
+    {
+        if (distance[edge.from] != SPF_INFINITY &&
+            distance[edge.from] + edge.metric == distance[edge.to])
+        {
+            NS_LOG_LOGIC("A shortest path of " << root << " was removed");
+            return false;
+        }
+    }
+    for (const auto& edge : changes.added)
+    {
+        uint64_t to = edge.to != GlobalRouteManagerLSDB::NO_LSA ? distance[edge.to]
+                                                                : SPF_INFINITY;
+        if (distance[edge.from] != SPF_INFINITY &&
+            distance[edge.from] + edge.metric <= to)
+        {
+            NS_LOG_LOGIC("A shortest path of " << root << " was added");
+            return false;
+        }
+    }
+    return true;
+}
+
+GlobalRouteManagerImpl::SPFTree
+GlobalRouteManagerImpl::RenumberSPFTree(const SPFTree& tree) const
+{
+    NS_LOG_FUNCTION(this);
+    auto renumber = [this](uint32_t index) {
+        GlobalRoutingLSA* lsa = m_previousLsdb->GetLSAByIndex(index);
+        uint32_t current = m_lsdb->GetLSAIndex(m_lsdb->GetLSA(lsa->GetLinkStateId()));
+        NS_ASSERT_MSG(current != GlobalRouteManagerLSDB::NO_LSA,
+                      "The vertex " << lsa->GetLinkStateId() << " left a valid tree");
+        return current;
+    };
+    SPFTree renumbered = tree;
+    for (auto& vertex : renumbered.vertices)
+    {
+        vertex.lsa = renumber(vertex.lsa);
+    }
+    for (auto& lsa : renumbered.stubOrder)
+    {
+        lsa = renumber(lsa);
+    }
+    return renumbered;
+}
+
+void
+GlobalRouteManagerImpl::SPFReplay(Ipv4Address root, const SPFTree& tree)
+{
+    NS_LOG_FUNCTION(this << root);
+    auto router = m_routers.find(root);
+    m_router = router != m_routers.end() ? &router->second : nullptr;
+
+    //
+    // Rebuild the vertices, without their parents and children: the routes
+    // only depend on the LSA and the exit directions of each vertex.
+    //
+    std::vector<std::unique_ptr<SPFVertex>> vertices;
+    std::unordered_map<uint32_t, SPFVertex*> vertexOfLsa;
+    for (const auto& vertex : tree.vertices)
+    {
+        auto v = std::make_unique<SPFVertex>(m_lsdb->GetLSAByIndex(vertex.lsa));
+        v->SetDistanceFromRoot(vertex.distance);
+        for (uint32_t i = 0; i < vertex.nExits; i++)
+        {
+            SPFVertex::NodeExit_t exit = tree.exits[vertex.firstExit + i];
+            if (i == 0)
+            {
+                v->SetRootExitDirection(exit);
+                continue;
+            }
+            SPFVertex other;
+            other.SetRootExitDirection(exit);
+            v->MergeRootExitDirections(&other);
+        }
+        vertexOfLsa[vertex.lsa] = v.get();
+        vertices.push_back(std::move(v));
+    }
+    m_spfroot = vertices.front().get();
+
+    // First stage, in the order the vertices joined the tree
+    for (std::size_t i = 1; i < vertices.size(); i++)
+    {
+        SPFVertex* v = vertices[i].get();
+        if (v->GetVertexType() == SPFVertex::VertexRouter)
+        {
+            SPFIntraAddRouter(v);
+        }
+        else if (v->GetVertexType() == SPFVertex::VertexNetwork)
+        {
+            SPFIntraAddTransit(v);
+        }
+    }
+
+    // Second stage, in the order SPFProcessStubs visited the vertices
+    for (auto lsa : tree.stubOrder)
+    {
+        SPFVertex* v = vertexOfLsa.at(lsa);
+        if (v->GetVertexType() != SPFVertex::VertexRouter)
+        {
+            continue;
+        }
+        for (uint32_t i = 0; i < v->GetLSA()->GetNLinkRecords(); i++)
+        {
+            GlobalRoutingLinkRecord* l = v->GetLSA()->GetLinkRecord(i);
+            if (l->GetLinkType() == GlobalRoutingLinkRecord::StubNetwork)
+            {
+                SPFIntraAddStub(l, v);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        GlobalRoutingLSA* extlsa = m_lsdb->GetExtLSA(i);
+        for (auto lsa : tree.stubOrder)
+        {
+            SPFVertex* v = vertexOfLsa.at(lsa);
+            if (v->GetVertexType() == SPFVertex::VertexRouter &&
+                v->GetLSA()->GetLinkStateId() == extlsa->GetAdvertisingRouter())
+            {
+                SPFAddASExternal(extlsa, v);
+                break;
+            }
+        }
+    }
+
+    m_spfroot = nullptr;
+    m_router = nullptr;
 }
 
 void
@@ -1544,103 +2168,72 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The router corresponding to the root vertex, which is the one we're going
+    // to write the routing information to, was looked up when the calculation
+    // started.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_router || !m_router->routing)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("No GlobalRouter interface for router " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for router " << routerId);
+    //
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
+    //
+    NS_ASSERT_MSG(m_router->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "QI for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = extlsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
 
-        if (!rtr)
+    //
+    // Here's why we did all of that work.  We're going to add a host route to the
+    // host address found in the m_linkData field of the point-to-point link
+    // record.  In the case of a point-to-point link, this is the local IP address
+    // of the node connected to the link.  Each of these point-to-point links
+    // will correspond to a local interface that has an IP address to which
+    // the node at the root of the SPF tree can send packets.  The vertex <v>
+    // (corresponding to the node that has these links and interfaces) has
+    // an m_nextHop address precalculated for us that is the address to which the
+    // root node should send packets to be forwarded to these IP addresses.
+    // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+    // which the packets should be send for forwarding.
+    //
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            m_router->routing->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " add external network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = extlsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add external network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 // Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
@@ -1651,6 +2244,10 @@ GlobalRouteManagerImpl::SPFProcessStubs(SPFVertex* v)
 {
     NS_LOG_FUNCTION(this << v);
     NS_LOG_LOGIC("Processing stubs for " << v->GetVertexId());
+    if (m_spfTree)
+    {
+        m_spfTree->stubOrder.push_back(m_lsdb->GetLSAIndex(v->GetLSA()));
+    }
     if (v->GetVertexType() == SPFVertex::VertexRouter)
     {
         GlobalRoutingLSA* rlsa = v->GetLSA();
@@ -1700,117 +2297,78 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
     //
     // The root of the Shortest Path First tree is the router to which we are
     // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // to this router has a vertex ID which is the router ID of that node; the
+    // router itself was looked up when the calculation started.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_router || !m_router->routing)
+    {
+        NS_LOG_LOGIC("No GlobalRouter interface for router " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for router " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_ASSERT_MSG(m_router->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "QI for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask(l->GetLinkData().Get());
+    Ipv4Address tempip = l->GetLinkId();
+    tempip = tempip.CombineMask(tempmask);
+    //
+    // Here's why we did all of that work.  We're going to add a host route to the
+    // host address found in the m_linkData field of the point-to-point link
+    // record.  In the case of a point-to-point link, this is the local IP address
+    // of the node connected to the link.  Each of these point-to-point links
+    // will correspond to a local interface that has an IP address to which
+    // the node at the root of the SPF tree can send packets.  The vertex <v>
+    // (corresponding to the node that has these links and interfaces) has
+    // an m_nextHop address precalculated for us that is the address to which the
+    // root node should send packets to be forwarded to these IP addresses.
+    // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+    // which the packets should be send for forwarding.
+    //
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            m_router->routing->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " add network route to "
+                                   << tempip << " using next hop " << nextHop
+                                   << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask(l->GetLinkData().Get());
-            Ipv4Address tempip = l->GetLinkId();
-            tempip = tempip.CombineMask(tempmask);
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
 // Return the interface number corresponding to a given IP address and mask
-// This is a wrapper around GetInterfaceForPrefix(), but we first
-// have to find the right node pointer to pass to that function.
+// This is a wrapper around GetInterfaceForPrefix(), on the Ipv4 interface of
+// the node at the root of the SPF tree.
 // If no such interface is found, return -1 (note:  unit test framework
 // for routing assumes -1 to be a legal return value)
 //
@@ -1821,65 +2379,38 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
     //
     // We have an IP address <a> and a vertex ID of the root of the SPF tree.
     // The question is what interface index does this address correspond to.
-    // The answer is a little complicated since we have to find a pointer to
-    // the node corresponding to the vertex ID, find the Ipv4 interface on that
-    // node in order to iterate the interfaces and find the one corresponding to
-    // the address in question.
+    // The router at the root of the tree, and its Ipv4 interface, were looked
+    // up when the calculation started, so we only have to iterate the interfaces
+    // and find the one corresponding to the address in question.
     //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
+    if (!m_router)
+    {
+        NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node "
+                     << m_spfroot->GetVertexId());
+        return -1;
+    }
     //
-    // Walk the list of nodes in the system looking for the one corresponding to
-    // the node at the root of the SPF tree.  This is the node for which we are
-    // building the routing table.
+    // Since this node is participating in routing IP version 4 packets, it
+    // certainly must have an Ipv4 interface.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
-    {
-        Ptr<Node> node = *i;
-
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-        //
-        // If the node doesn't have a GlobalRouter interface it can't be the one
-        // we're interested in.
-        //
-        if (!rtr)
-        {
-            continue;
-        }
-
-        if (rtr->GetRouterId() == routerId)
-        {
-            //
-            // This is the node we're building the routing table for.  We're going to need
-            // the Ipv4 interface to look for the ipv4 interface index.  Since this node
-            // is participating in routing IP version 4 packets, it certainly must have
-            // an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Look through the interfaces on this node for one that has the IP address
-            // we're looking for.  If we find one, return the corresponding interface
-            // index, or -1 if not found.
-            //
-            int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
+    NS_ASSERT_MSG(m_router->ipv4,
+                  "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Look through the interfaces on this node for one that has the IP address
+    // we're looking for.  If we find one, return the corresponding interface
+    // index, or -1 if not found.
+    //
+    int32_t interface = m_router->ipv4->GetInterfaceForPrefix(a, amask);
 
 #if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif
-            return interface;
-        }
+  if (interface < 0)
+    {
+      NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
+                      "Expected an interface associated with address a:" << a);
     }
-    //
-    // Couldn't find it.
-    //
-    NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
-    return -1;
+#endif
+    return interface;
 }
 
 //
@@ -1907,136 +2438,93 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
     //
     // The root of the Shortest Path First tree is the router to which we are
     // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // to this router has a vertex ID which is the router ID of that node; the
+    // router itself was looked up when the calculation started.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_router || !m_router->routing)
+    {
+        NS_LOG_LOGIC("No GlobalRouter interface for router " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("Setting routes for router " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_ASSERT_MSG(m_router->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+
+    uint32_t nLinkRecords = lsa->GetNLinkRecords();
+    //
+    // Iterate through the link records on the vertex to which we're going to add
+    // routes.  To make sure we're being clear, we're going to add routing table
+    // entries to the tables on the node corresponding to the root of the SPF tree.
+    // These entries will have routes to the IP addresses we find from looking at
+    // the local side of the point-to-point links found on the node described by
+    // the vertex <v>.
+    //
+    NS_LOG_LOGIC(" Router " << routerId << " found " << nLinkRecords << " link records in LSA "
+                            << lsa << "with LinkStateId " << lsa->GetLinkStateId());
+    for (uint32_t j = 0; j < nLinkRecords; ++j)
     {
-        Ptr<Node> node = *i;
         //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
+        // We are only concerned about point-to-point links
         //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
             continue;
         }
         //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
+        // Here's why we did all of that work.  We're going to add a host route to the
+        // host address found in the m_linkData field of the point-to-point link
+        // record.  In the case of a point-to-point link, this is the local IP address
+        // of the node connected to the link.  Each of these point-to-point links
+        // will correspond to a local interface that has an IP address to which
+        // the node at the root of the SPF tree can send packets.  The vertex <v>
+        // (corresponding to the node that has these links and interfaces) has
+        // an m_nextHop address precalculated for us that is the address to which the
+        // root node should send packets to be forwarded to these IP addresses.
+        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+        // which the packets should be send for forwarding.
         //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        // walk through all available exit directions due to ECMP,
+        // and add host route for each of the exit direction toward
+        // the vertex 'v'
+        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-
-            uint32_t nLinkRecords = lsa->GetNLinkRecords();
-            //
-            // Iterate through the link records on the vertex to which we're going to add
-            // routes.  To make sure we're being clear, we're going to add routing table
-            // entries to the tables on the node corresponding to the root of the SPF tree.
-            // These entries will have routes to the IP addresses we find from looking at
-            // the local side of the point-to-point links found on the node described by
-            // the vertex <v>.
-            //
-            NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
-                                  << " link records in LSA " << lsa << "with LinkStateId "
-                                  << lsa->GetLinkStateId());
-            for (uint32_t j = 0; j < nLinkRecords; ++j)
+            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+            Ipv4Address nextHop = exit.first;
+            int32_t outIf = exit.second;
+            if (outIf >= 0)
             {
-                //
-                // We are only concerned about point-to-point links
-                //
-                GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
-                if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                    continue;
-                }
-                //
-                // Here's why we did all of that work.  We're going to add a host route to the
-                // host address found in the m_linkData field of the point-to-point link
-                // record.  In the case of a point-to-point link, this is the local IP address
-                // of the node connected to the link.  Each of these point-to-point links
-                // will correspond to a local interface that has an IP address to which
-                // the node at the root of the SPF tree can send packets.  The vertex <v>
-                // (corresponding to the node that has these links and interfaces) has
-                // an m_nextHop address precalculated for us that is the address to which the
-                // root node should send packets to be forwarded to these IP addresses.
-                // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-                // which the packets should be send for forwarding.
-                //
-                Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-                if (!router)
-                {
-                    continue;
-                }
-                Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                NS_ASSERT(gr);
-                // walk through all available exit directions due to ECMP,
-                // and add host route for each of the exit direction toward
-                // the vertex 'v'
-                for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-                {
-                    SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                    Ipv4Address nextHop = exit.first;
-                    int32_t outIf = exit.second;
-                    if (outIf >= 0)
-                    {
-                        gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " adding host route to " << lr->GetLinkData()
-                                               << " using next hop " << nextHop
-                                               << " and outgoing interface " << outIf);
-                    }
-                    else
-                    {
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " NOT able to add host route to "
-                                               << lr->GetLinkData() << " using next hop " << nextHop
-                                               << " since outgoing interface id is negative "
-                                               << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+                m_router->routing->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
+                NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " adding host route to "
+                                       << lr->GetLinkData() << " using next hop " << nextHop
+                                       << " and outgoing interface " << outIf);
             }
-            //
-            // Done adding the routes for the selected node.
-            //
-            return;
-        }
+            else
+            {
+                NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                       << " NOT able to add host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
 
@@ -2049,97 +2537,60 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
     //
     // The root of the Shortest Path First tree is the router to which we are
     // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // to this router has a vertex ID which is the router ID of that node; the
+    // router itself was looked up when the calculation started.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
+    if (!m_router || !m_router->routing)
+    {
+        NS_LOG_LOGIC("No GlobalRouter interface for router " << routerId);
+        return;
+    }
+    NS_LOG_LOGIC("setting routes for router " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Routing information is updated using the Ipv4 interface.  If the node is
+    // acting as an IP version 4 router, it should absolutely have an Ipv4 interface.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_ASSERT_MSG(m_router->ipv4,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "GetObject for <Ipv4> interface failed");
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = lsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    // walk through all available exit directions due to ECMP,
+    // and add host route for each of the exit direction toward
+    // the vertex 'v'
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
 
-        if (!rtr)
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            m_router->routing->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " add network route to "
+                                   << tempip << " using next hop " << nextHop
+                                   << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = lsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative " << outIf);
         }
     }
 }
@@ -31,6 +31,7 @@
 #include <map>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -39,6 +40,7 @@ namespace ns3
 const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
+class Ipv4;
 class Ipv4GlobalRouting;
 
 /**
@@ -643,9 +645,10 @@ class GlobalRouteManagerLSDB
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
      * This function walks the database and resets the status flags of all of the
-     * contained Link State Advertisements to LSA_SPF_NOT_EXPLORED.  This is done
-     * prior to each SPF calculation to reset the state of the SPFVertex structures
-     * that will reference the LSAs during the calculation.
+     * contained Link State Advertisements to LSA_SPF_NOT_EXPLORED.  The SPF
+     * calculations of the GlobalRouteManagerImpl do not use these flags: each
+     * calculation keeps the status of the LSAs in its own state, so that several
+     * of them can run concurrently on the same database.
      *
      * @see GlobalRoutingLSA
      * @see SPFVertex
@@ -672,6 +675,72 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /// Index of no LSA, see GetLSAIndex and GetAdjacency
+    static constexpr uint32_t NO_LSA = 0xffffffff;
+
+    /**
+     * @brief A transit vertex adjacent to the vertex of an LSA.
+     */
+    struct Adjacency
+    {
+        GlobalRoutingLinkRecord* record; //!< link record of a router LSA, null for a network LSA
+        uint32_t lsa;                    //!< index of the adjacent LSA, or NO_LSA
+    };
+
+    /**
+     * @brief Build the adjacency of the LSAs used by the SPF computations.
+     *
+     * The router and network LSAs are numbered in the order of their link
+     * state ID and their adjacencies are stored in a single array (compressed
+     * sparse row layout): one entry for each link record of a router LSA,
+     * pointing to the neighbor router or transit network (or to no LSA for a
+     * stub network), and one entry for each router attached to a network LSA.
+     * Nothing is done if the adjacency is already built; inserting an LSA
+     * invalidates it.
+     */
+    void BuildAdjacency();
+
+    /**
+     * @brief Get the number of router and network LSAs.
+     *
+     * @returns the number of LSAs, not counting the External LSAs
+     */
+    uint32_t GetNumLSAs() const;
+
+    /**
+     * @brief Get a router or network LSA by its index, see BuildAdjacency.
+     *
+     * @param index the index of the LSA
+     * @returns the LSA
+     */
+    GlobalRoutingLSA* GetLSAByIndex(uint32_t index) const;
+
+    /**
+     * @brief Get the index of a router or network LSA, see BuildAdjacency.
+     *
+     * @param lsa the LSA
+     * @returns the index of the LSA, or NO_LSA if it is not in the database
+     */
+    uint32_t GetLSAIndex(const GlobalRoutingLSA* lsa) const;
+
+    /**
+     * @brief Get the number of vertices adjacent to an LSA, see BuildAdjacency.
+     *
+     * @param index the index of the LSA
+     * @returns the number of link records of a router LSA, or the number of
+     * attached routers of a network LSA
+     */
+    uint32_t GetNAdjacencies(uint32_t index) const;
+
+    /**
+     * @brief Get a vertex adjacent to an LSA, see BuildAdjacency.
+     *
+     * @param index the index of the LSA
+     * @param i the index of the link record or attached router
+     * @returns the adjacent vertex
+     */
+    const Adjacency& GetAdjacency(uint32_t index, uint32_t i) const;
+
   private:
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
@@ -681,6 +750,14 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+
+    bool m_adjacencyBuilt{false};                  //!< whether the adjacency is up to date
+    std::vector<GlobalRoutingLSA*> m_lsas;         //!< router and network LSAs by index
+    std::unordered_map<const GlobalRoutingLSA*, uint32_t> m_lsaIndex; //!< index of the LSAs
+    std::unordered_map<uint32_t, GlobalRoutingLSA*>
+        m_linkDataLsa; //!< LSAs by link data of their transit network records
+    std::vector<uint32_t> m_adjacencyStart; //!< first adjacency of each LSA, plus the end
+    std::vector<Adjacency> m_adjacencies;   //!< adjacencies of all the LSAs
 };
 
 /**
@@ -722,6 +799,11 @@ class GlobalRouteManagerImpl
     /**
      * @brief Compute routes using a Dijkstra SPF computation and populate
      * per-node forwarding tables
+     *
+     * The computations of the routers run on the number of threads set by the
+     * "GlobalRoutingSpfThreads" global value.  When the "GlobalRoutingIncrementalSpf"
+     * global value is true, the routers whose shortest path tree is not affected by
+     * the changes since the previous computation reuse that tree.
      */
     virtual void InitializeRoutes();
 
@@ -738,8 +820,135 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /**
+     * @brief A router whose routing table is filled by the SPF calculations.
+     */
+    struct SPFRouter
+    {
+        Ptr<Ipv4> ipv4;                 //!< the IPv4 stack of the router
+        Ptr<Ipv4GlobalRouting> routing; //!< the global routing protocol of the router
+    };
+
+    /**
+     * @brief A shortest path tree kept by the incremental SPF calculation.
+     *
+     * The tree is enough to fill the routing table of its root again without
+     * running the Dijkstra algorithm, as long as it is not affected by the
+     * changes of the LSDB.
+     */
+    struct SPFTree
+    {
+        /// A vertex of the tree
+        struct Vertex
+        {
+            uint32_t lsa;       //!< index of the LSA of the vertex in the LSDB
+            uint32_t distance;  //!< distance from the root
+            uint32_t firstExit; //!< index of the first root exit direction of the vertex
+            uint32_t nExits;    //!< number of root exit directions of the vertex
+        };
+
+        std::vector<Vertex> vertices;             //!< vertices, in the order they joined the tree
+        std::vector<uint32_t> stubOrder;          //!< LSA indices, in the order stubs are processed
+        std::vector<SPFVertex::NodeExit_t> exits; //!< root exit directions of the vertices
+    };
+
+    /**
+     * @brief The differences between two link state databases.
+     */
+    struct SPFChanges
+    {
+        /// An edge of the SPF graph, between the vertices of the previous LSDB
+        struct Edge
+        {
+            uint32_t from;   //!< index of the source LSA
+            uint32_t to;     //!< index of the destination LSA, or NO_LSA if it is new
+            uint32_t metric; //!< cost of the edge
+        };
+
+        std::vector<bool> previousChanged; //!< whether each LSA of the previous LSDB changed
+        std::vector<bool> changed;         //!< whether each LSA of the current LSDB changed
+        std::vector<Edge> removed;         //!< edges which are no longer in the graph
+        std::vector<Edge> added;           //!< edges added to the graph
+    };
+
+    /**
+     * @brief Construct a worker computing SPF trees on the LSDB of another
+     * route manager, see InitializeRoutes.
+     *
+     * @param lsdb the LSDB, which is not owned by the worker
+     * @param routers the routers receiving the routes
+     */
+    GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb,
+                           const std::map<Ipv4Address, SPFRouter>& routers);
+
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_ownsLsdb;                //!< whether the LSDB is deleted with this object
+
+    std::map<Ipv4Address, SPFRouter> m_routers; //!< the routers, by router ID
+    const SPFRouter* m_router;                  //!< the router at the root of the SPF tree
+    /// status of the LSAs in the SPF calculation, by LSA index
+    std::vector<GlobalRoutingLSA::SPFStatus> m_spfStatus;
+    SPFTree* m_spfTree;                         //!< the tree recorded by the SPF calculation
+
+    GlobalRouteManagerLSDB* m_previousLsdb;  //!< the LSDB of the previous calculation
+    std::map<Ipv4Address, SPFTree> m_trees; //!< the trees of the previous calculation
+
+    /**
+     * @brief Find the routers of the simulation and their routing protocol.
+     */
+    void CollectRouters();
+
+    /**
+     * @brief Compare the LSDB with the one of the previous calculation.
+     *
+     * @param [out] changes the differences between the databases
+     */
+    void FindSPFChanges(SPFChanges& changes) const;
+
+    /**
+     * @brief Check whether the shortest path tree of a router survives the
+     * changes of the LSDB.
+     *
+     * The tree survives if the routers and networks near its root did not
+     * change (their link records decide the root exit directions), no edge of
+     * a shortest path was removed and no added edge gives a path as short as
+     * the current ones.  The distances, parents and exit directions of all
+     * the vertices are then unchanged.
+     *
+     * @param root the router ID of the root
+     * @param tree the tree computed on the previous LSDB
+     * @param changes the differences between the databases
+     * @returns true if the tree can be used with the current LSDB
+     */
+    bool IsSPFTreeValid(Ipv4Address root, const SPFTree& tree, const SPFChanges& changes) const;
+
+    /**
+     * @brief Translate the LSA indices of a tree of the previous LSDB.
+     *
+     * @param tree the tree computed on the previous LSDB
+     * @returns the same tree, with the LSA indices of the current LSDB
+     */
+    SPFTree RenumberSPFTree(const SPFTree& tree) const;
+
+    /**
+     * @brief Fill the routing table of a router from a shortest path tree,
+     * without running the Dijkstra algorithm.
+     *
+     * The routes are added in the order SPFCalculate would add them, using
+     * the current link records of the vertices.
+     *
+     * @param root the router ID of the root
+     * @param tree the tree, with the LSA indices of the current LSDB
+     */
+    void SPFReplay(Ipv4Address root, const SPFTree& tree);
+
+    /**
+     * @brief Add a vertex which joined the SPF tree to the recorded tree, if any.
+     *
+     * @param v the vertex
+     */
+    void SPFRecordVertex(SPFVertex* v);
 
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
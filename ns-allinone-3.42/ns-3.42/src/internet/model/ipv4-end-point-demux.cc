@@ -24,11 +24,29 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv4EndPointDemux");
 
+bool
+Ipv4EndPointDemux::EndPointKey::operator==(const EndPointKey& other) const
+{
+    return localAddress == other.localAddress && localPort == other.localPort &&
+           peerAddress == other.peerAddress && peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv4EndPointDemux::EndPointKeyHash::operator()(const EndPointKey& key) const
+{
+    uint64_t addresses = (uint64_t(key.localAddress.Get()) << 32) | key.peerAddress.Get();
+    uint32_t ports = (uint32_t(key.localPort) << 16) | key.peerPort;
+    return std::hash<uint64_t>()(addresses) ^ (std::hash<uint32_t>()(ports) * 0x9e3779b9U);
+}
+
 Ipv4EndPointDemux::Ipv4EndPointDemux()
     : m_ephemeral(49152),
       m_portLast(65535),
@@ -43,29 +61,110 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv4EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_entries.clear();
+    m_tuples.clear();
+    m_localPorts.clear();
 }
 
-bool
-Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    NS_LOG_FUNCTION(this << endPoint);
+    Entry& entry = m_entries[endPoint];
+    entry.position = m_endPoints.insert(m_endPoints.end(), endPoint);
+    Index(endPoint, entry);
+    endPoint->m_demux = this;
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint, Entry& entry)
+{
+    entry.key = {endPoint->GetLocalAddress(),
+                 endPoint->GetLocalPort(),
+                 endPoint->GetPeerAddress(),
+                 endPoint->GetPeerPort()};
+    m_tuples[entry.key].push_back(endPoint);
+    m_localPorts[entry.key.localPort]++;
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint, const Entry& entry)
+{
+    auto tuple = m_tuples.find(entry.key);
+    NS_ASSERT(tuple != m_tuples.end());
+    auto& endPoints = tuple->second;
+    endPoints.erase(std::find(endPoints.begin(), endPoints.end(), endPoint));
+    if (endPoints.empty())
+    {
+        m_tuples.erase(tuple);
+    }
+    auto port = m_localPorts.find(entry.key.localPort);
+    if (--port->second == 0)
     {
-        if ((*i)->GetLocalPort() == port)
+        m_localPorts.erase(port);
+    }
+}
+
+void
+Ipv4EndPointDemux::Update(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Entry& entry = m_entries.at(endPoint);
+    Unindex(endPoint, entry);
+    Index(endPoint, entry);
+}
+
+void
+Ipv4EndPointDemux::Find(const EndPointKey& key,
+                        Ptr<Ipv4Interface> incomingInterface,
+                        EndPoints& endPoints) const
+{
+    auto tuple = m_tuples.find(key);
+    if (tuple == m_tuples.end())
+    {
+        return;
+    }
+    for (auto endP : tuple->second)
+    {
+        if (!endP->IsRxEnabled())
         {
-            return true;
+            NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                              << " because endpoint can not receive packets");
+            continue;
+        }
+        if (endP->GetBoundNetDevice() &&
+            (!incomingInterface || endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Skipping endpoint "
+                         << &endP << " because endpoint is bound to specific device and"
+                         << endP->GetBoundNetDevice() << " does not match packet device "
+                         << incomingInterface->GetDevice());
+            continue;
         }
+        endPoints.push_back(endP);
     }
-    return false;
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_localPorts.find(port) != m_localPorts.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
+    if (!LookupPortLocal(port))
+    {
+        return false;
+    }
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
@@ -88,8 +187,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -104,8 +202,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -127,8 +224,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -140,21 +236,21 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto tuple = m_tuples.find({localAddress, localPort, peerAddress, peerPort});
+    if (tuple != m_tuples.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endP : tuple->second)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
 
     return endPoint;
 }
@@ -163,15 +259,16 @@ void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto entry = m_entries.find(endPoint);
+    if (entry == m_entries.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    Unindex(endPoint, entry->second);
+    m_endPoints.erase(entry->second.position);
+    m_entries.erase(entry);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -195,6 +292,10 @@ Ipv4EndPointDemux::GetAllEndPoints()
  * If we have an exact match, we return it.
  * Otherwise, if we find a generic match, we return it.
  * Otherwise, we return 0.
+ *
+ * Each class of match is an exact match on some four-tuple, hence a lookup
+ * in the index: the local address of the endpoint is either the destination
+ * address or a wildcard, and its peer is either the source or a wildcard.
  */
 Ipv4EndPointDemux::EndPoints
 Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
@@ -204,159 +305,57 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
                           Ptr<Ipv4Interface> incomingInterface)
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; // Matches exact on local port, wildcards on others
-    EndPoints retval2; // Matches exact on local port/adder, wildcards on others
-    EndPoints retval3; // Matches all but local address
-    EndPoints retval4; // Exact match on all 4
-
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv4EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-        if (endP->GetBoundNetDevice())
-        {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
-            {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
-            }
-        }
-
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
-
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
-
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
-        {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
-            {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
-
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
-                {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
-
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
-                    {
-                        localAddressIsSubnetAny = true;
-                    }
-                }
-            }
-
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
-            {
-                continue;
-            }
-        }
 
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+    // The local addresses matching the destination address as wildcards:
+    // 1) Local endpoint bound to Any -> matches anything
+    // 2) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+    // x.y.z.255 in a /24 net) and direct destination match.
+    // An exact local / destination address match is never a wildcard.
+    std::vector<Ipv4Address> wildcards;
+    if (daddr != Ipv4Address::GetAny())
+    {
+        wildcards.push_back(Ipv4Address::GetAny());
+    }
+    for (uint32_t i = 0; incomingInterface && i < incomingInterface->GetNAddresses(); i++)
+    {
+        Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+        Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+        if (addrNetpart != daddr && daddr.CombineMask(addr.GetMask()) == addrNetpart &&
+            std::find(wildcards.begin(), wildcards.end(), addrNetpart) == wildcards.end())
         {
-            continue;
-        }
-
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
-
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            NS_LOG_LOGIC("Looking for SubnetDirectedAny endpoints "
+                         << addrNetpart << "/" << addr.GetMask().GetPrefixLength());
+            wildcards.push_back(addrNetpart);
         }
     }
 
     // Here we find the most exact match
     EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
-    }
-    else if (!retval3.empty())
+    // All 4 match - this is the case of an open TCP connection, for example.
+    Find({daddr, dport, saddr, sport}, incomingInterface, retval);
+    if (retval.empty())
     {
-        retval = retval3;
+        // All but local address - no idea what this case could be.
+        for (const auto& wildcard : wildcards)
+        {
+            Find({wildcard, dport, saddr, sport}, incomingInterface, retval);
+        }
     }
-    else if (!retval2.empty())
+    if (retval.empty())
     {
-        retval = retval2;
+        // Only local port and local address matches exactly - Not yet opened connection
+        Find({daddr, dport, Ipv4Address::GetAny(), 0}, incomingInterface, retval);
     }
-    else
+    if (retval.empty())
     {
-        retval = retval1;
+        // Only local port matches exactly - Endpoint open to "any" connection
+        for (const auto& wildcard : wildcards)
+        {
+            Find({wildcard, dport, Ipv4Address::GetAny(), 0}, incomingInterface, retval);
+        }
     }
+    NS_LOG_LOGIC("Found " << retval.size() << " endpoints");
 
     NS_ABORT_MSG_IF(retval.size() > 1,
                     "Too many endpoints - perhaps you created too many sockets without binding "
@@ -372,6 +371,14 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    // an exact match is found in the index, unless several endpoints share
+    // the four-tuple and the first one must be found in the list
+    auto tuple = m_tuples.find({daddr, dport, saddr, sport});
+    if (tuple != m_tuples.end() && tuple->second.size() == 1)
+    {
+        return tuple->second.front();
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -42,6 +44,10 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are also indexed by four-tuple (and counted by local port),
+ * so that the lookups of a packet do not depend on the number of endpoints.
+ * The endpoints update the index when their four-tuple changes.
  */
 
 class Ipv4EndPointDemux
@@ -171,6 +177,85 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * \brief The four-tuple of an endpoint.
+     */
+    struct EndPointKey
+    {
+        Ipv4Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv4Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the four-tuple to compare with
+         * \return true if the four-tuples are equal
+         */
+        bool operator==(const EndPointKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of the four-tuples.
+     */
+    struct EndPointKeyHash
+    {
+        /**
+         * \brief Hash a four-tuple.
+         * \param key the four-tuple
+         * \return the hash
+         */
+        std::size_t operator()(const EndPointKey& key) const;
+    };
+
+    /**
+     * \brief Where an endpoint is stored.
+     */
+    struct Entry
+    {
+        EndPointsI position; //!< position in the list of endpoints
+        EndPointKey key;     //!< four-tuple the endpoint is indexed with
+    };
+
+    /**
+     * \brief Add an endpoint to the list and the indexes.
+     * \param endPoint the endpoint
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Index an endpoint with its current four-tuple.
+     * \param endPoint the endpoint
+     * \param entry where the endpoint is stored
+     */
+    void Index(Ipv4EndPoint* endPoint, Entry& entry);
+
+    /**
+     * \brief Remove an endpoint from the indexes.
+     * \param endPoint the endpoint
+     * \param entry where the endpoint is stored
+     */
+    void Unindex(Ipv4EndPoint* endPoint, const Entry& entry);
+
+    /**
+     * \brief Index again an endpoint whose four-tuple changed.
+     * \param endPoint the endpoint
+     */
+    void Update(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Get the endpoints with a four-tuple, which can receive a packet
+     * from an interface.
+     * \param key the four-tuple
+     * \param incomingInterface the incoming interface
+     * \param [out] endPoints the endpoints, appended
+     */
+    void Find(const EndPointKey& key,
+              Ptr<Ipv4Interface> incomingInterface,
+              EndPoints& endPoints) const;
+
     /**
      * \brief Allocate an ephemeral port.
      * \returns the ephemeral port
@@ -196,6 +281,21 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief Where each endpoint is stored.
+     */
+    std::unordered_map<const Ipv4EndPoint*, Entry> m_entries;
+
+    /**
+     * \brief The endpoints, by four-tuple.
+     */
+    std::unordered_map<EndPointKey, std::vector<Ipv4EndPoint*>, EndPointKeyHash> m_tuples;
+
+    /**
+     * \brief The number of endpoints using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } // namespace ns3
@@ -33,6 +33,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv4EndPointDemux;
 class Packet;
 
 /**
@@ -191,6 +192,13 @@ class Ipv4EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv4EndPointDemux;
+
+    /**
+     * \brief The demux which indexes this endpoint, if any.
+     */
+    Ipv4EndPointDemux* m_demux;
+
     /**
      * \brief The local address.
      */
@@ -18,6 +18,7 @@
 #include "ipv4-global-routing.h"
 
 #include "global-route-manager.h"
+#include "ipv4-l3-protocol.h"
 #include "ipv4-route.h"
 #include "ipv4-routing-table-entry.h"
 
@@ -83,6 +84,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    NotifyRoutesChanged();
 }
 
 void
@@ -92,6 +94,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    NotifyRoutesChanged();
 }
 
 void
@@ -104,6 +107,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    NotifyRoutesChanged();
 }
 
 void
@@ -113,6 +117,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    NotifyRoutesChanged();
 }
 
 void
@@ -125,6 +130,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    NotifyRoutesChanged();
 }
 
 Ptr<Ipv4Route>
@@ -137,64 +143,54 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
+    if (m_routesChanged)
+    {
+        UpdatePrefixIndexes();
+    }
+    // the indexes return the matching routes in the order of the routing table
+    RouteVec_t candidates;
+    auto onInterface = [this, oif](Ipv4RoutingTableEntry* route) {
+        if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
+        {
+            NS_LOG_LOGIC("Not on requested interface, skipping");
+            return false;
+        }
+        return true;
+    };
+
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    m_hostIndex.Lookup(dest, candidates);
+    for (auto route : candidates)
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        NS_ASSERT(route->IsHost());
+        if (onInterface(route))
         {
-            if (oif)
-            {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            allRoutes.push_back(route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << route);
         }
     }
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        m_networkIndex.Lookup(dest, candidates);
+        for (auto route : candidates)
         {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            if (onInterface(route))
             {
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
+                allRoutes.push_back(route);
+                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << route);
             }
         }
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
-        for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+        m_ASexternalIndex.Lookup(dest, candidates);
+        for (auto route : candidates)
         {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            NS_LOG_LOGIC("Found external route" << route);
+            if (onInterface(route))
             {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*k);
+                allRoutes.push_back(route);
                 break;
             }
         }
@@ -230,6 +226,39 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+void
+Ipv4GlobalRouting::UpdatePrefixIndexes()
+{
+    NS_LOG_FUNCTION(this);
+    m_hostIndex.Clear();
+    for (auto route : m_hostRoutes)
+    {
+        m_hostIndex.Add(route);
+    }
+    m_networkIndex.Clear();
+    for (auto route : m_networkRoutes)
+    {
+        m_networkIndex.Add(route);
+    }
+    m_ASexternalIndex.Clear();
+    for (auto route : m_ASexternalRoutes)
+    {
+        m_ASexternalIndex.Add(route);
+    }
+    m_routesChanged = false;
+}
+
+void
+Ipv4GlobalRouting::NotifyRoutesChanged()
+{
+    m_routesChanged = true;
+    Ptr<Ipv4L3Protocol> ipv4 = DynamicCast<Ipv4L3Protocol>(m_ipv4);
+    if (ipv4)
+    {
+        ipv4->FlushForwardingCache();
+    }
+}
+
 uint32_t
 Ipv4GlobalRouting::GetNRoutes() const
 {
@@ -299,6 +328,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
                 delete *i;
                 m_hostRoutes.erase(i);
+                NotifyRoutesChanged();
                 NS_LOG_LOGIC("Done removing host route "
                              << index << "; host route remaining size = " << m_hostRoutes.size());
                 return;
@@ -315,6 +345,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
             delete *j;
             m_networkRoutes.erase(j);
+            NotifyRoutesChanged();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -330,6 +361,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
             delete *k;
             m_ASexternalRoutes.erase(k);
+            NotifyRoutesChanged();
             NS_LOG_LOGIC("Done removing network route "
                          << index << "; network route remaining size = " << m_networkRoutes.size());
             return;
@@ -364,6 +396,10 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostIndex.Clear();
+    m_networkIndex.Clear();
+    m_ASexternalIndex.Clear();
+    m_routesChanged = false;
 
     Ipv4RoutingProtocol::DoDispose();
 }
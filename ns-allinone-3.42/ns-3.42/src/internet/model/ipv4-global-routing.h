@@ -20,6 +20,7 @@
 #define IPV4_GLOBAL_ROUTING_H
 
 #include "ipv4-header.h"
+#include "ipv4-route-prefix-index.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
 
@@ -274,10 +275,26 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * \brief Rebuild the prefix indexes from the routing tables.
+     */
+    void UpdatePrefixIndexes();
+
+    /**
+     * \brief Mark the prefix indexes as stale and flush the forwarding cache
+     * of the IPv4 instance.
+     */
+    void NotifyRoutesChanged();
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    Ipv4RoutePrefixIndex m_hostIndex;       //!< Index of the routes to hosts
+    Ipv4RoutePrefixIndex m_networkIndex;    //!< Index of the routes to networks
+    Ipv4RoutePrefixIndex m_ASexternalIndex; //!< Index of the external routes
+    bool m_routesChanged{false};            //!< Whether the indexes must be rebuilt
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
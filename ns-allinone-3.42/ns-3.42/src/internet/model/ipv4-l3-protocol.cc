@@ -71,6 +71,13 @@ Ipv4L3Protocol::GetTypeId()
                           TimeValue(Seconds(30)),
                           MakeTimeAccessor(&Ipv4L3Protocol::m_fragmentExpirationTimeout),
                           MakeTimeChecker())
+            .AddAttribute("FragmentBufferSize",
+                          "The maximum number of bytes held by the fragments waiting "
+                          "for reassembly, 0 means no limit. When it is exceeded, the "
+                          "oldest fragmented packets are dropped.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv4L3Protocol::m_fragmentBufferSize),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("EnableDuplicatePacketDetection",
                           "Enable multicast duplicate packet detection based on RFC 6621",
                           BooleanValue(false),
@@ -87,6 +94,14 @@ Ipv4L3Protocol::GetTypeId()
                           TimeValue(Seconds(1)),
                           MakeTimeAccessor(&Ipv4L3Protocol::m_purge),
                           MakeTimeChecker(Seconds(0)))
+            .AddAttribute("ForwardingCacheSize",
+                          "Maximum number of unicast routes cached by destination to "
+                          "forward packets without querying the routing protocol, "
+                          "0 disables the cache. Only enable it with routing protocols "
+                          "whose forwarding decision depends on the destination alone.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv4L3Protocol::m_forwardingCacheSize),
+                          MakeUintegerChecker<uint32_t>())
             .AddTraceSource("Tx",
                             "Send ipv4 packet to outgoing interface.",
                             MakeTraceSourceAccessor(&Ipv4L3Protocol::m_txTrace),
@@ -137,6 +152,7 @@ Ipv4L3Protocol::Ipv4L3Protocol()
     m_mcb = MakeCallback(&Ipv4L3Protocol::IpMulticastForward, this);
     m_lcb = MakeCallback(&Ipv4L3Protocol::LocalDeliver, this);
     m_ecb = MakeCallback(&Ipv4L3Protocol::RouteInputError, this);
+    m_cucb = MakeCallback(&Ipv4L3Protocol::CacheAndForward, this);
 }
 
 Ipv4L3Protocol::~Ipv4L3Protocol()
@@ -297,6 +313,7 @@ Ipv4L3Protocol::SetRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol)
     NS_LOG_FUNCTION(this << routingProtocol);
     m_routingProtocol = routingProtocol;
     m_routingProtocol->SetIpv4(this);
+    FlushForwardingCache();
 }
 
 Ptr<Ipv4RoutingProtocol>
@@ -317,6 +334,10 @@ Ipv4L3Protocol::DoDispose()
 
     for (auto i = m_interfaces.begin(); i != m_interfaces.end(); ++i)
     {
+        for (uint32_t j = 0; j < (*i)->GetNAddresses(); j++)
+        {
+            UnindexAddress((*i)->GetAddress(j).GetLocal());
+        }
         *i = nullptr;
     }
     m_interfaces.clear();
@@ -325,6 +346,7 @@ Ipv4L3Protocol::DoDispose()
     m_sockets.clear();
     m_node = nullptr;
     m_routingProtocol = nullptr;
+    m_forwardingCache.clear();
 
     for (auto it = m_fragments.begin(); it != m_fragments.end(); it++)
     {
@@ -332,6 +354,7 @@ Ipv4L3Protocol::DoDispose()
     }
 
     m_fragments.clear();
+    m_fragmentsSize = 0;
     m_timeoutEventList.clear();
     if (m_timeoutEvent.IsPending())
     {
@@ -658,8 +681,14 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
         return;
     }
 
+    if (m_forwardingCacheSize > 0 && ForwardFromCache(packet, ipHeader, interface))
+    {
+        return;
+    }
+
     NS_ASSERT_MSG(m_routingProtocol, "Need a routing protocol object to process packets");
-    if (!m_routingProtocol->RouteInput(packet, ipHeader, device, m_ucb, m_mcb, m_lcb, m_ecb))
+    const auto& ucb = m_forwardingCacheSize > 0 ? m_cucb : m_ucb;
+    if (!m_routingProtocol->RouteInput(packet, ipHeader, device, ucb, m_mcb, m_lcb, m_ecb))
     {
         NS_LOG_WARN("No route found for forwarding packet.  Drop.");
         m_dropTrace(ipHeader, packet, DROP_NO_ROUTE, this, interface);
@@ -1085,6 +1114,61 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
     SendRealOut(rtentry, packet, ipHeader);
 }
 
+void
+Ipv4L3Protocol::CacheAndForward(Ptr<Ipv4Route> rtentry,
+                                Ptr<const Packet> p,
+                                const Ipv4Header& header)
+{
+    NS_LOG_FUNCTION(this << rtentry << p << header);
+    if (m_forwardingCacheSize > 0)
+    {
+        auto it = m_forwardingCache.find(header.GetDestination());
+        if (it != m_forwardingCache.end())
+        {
+            it->second = rtentry;
+        }
+        else
+        {
+            // Keep the cache simple: when full, start over with the active flows
+            if (m_forwardingCache.size() >= m_forwardingCacheSize)
+            {
+                m_forwardingCache.clear();
+            }
+            m_forwardingCache.emplace(header.GetDestination(), rtentry);
+        }
+    }
+    IpForward(rtentry, p, header);
+}
+
+bool
+Ipv4L3Protocol::ForwardFromCache(Ptr<const Packet> packet,
+                                 const Ipv4Header& header,
+                                 uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << packet << header << interface);
+    Ipv4Address destination = header.GetDestination();
+    auto it = m_forwardingCache.find(destination);
+    if (it == m_forwardingCache.end())
+    {
+        return false;
+    }
+    // The checks a unicast routing protocol makes before looking up its table
+    if (IsDestinationAddress(destination, interface) || !IsForwarding(interface))
+    {
+        return false;
+    }
+    NS_LOG_LOGIC("Forwarding with the cached route to " << destination);
+    IpForward(it->second, packet, header);
+    return true;
+}
+
+void
+Ipv4L3Protocol::FlushForwardingCache()
+{
+    NS_LOG_FUNCTION(this);
+    m_forwardingCache.clear();
+}
+
 void
 Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uint32_t iif)
 {
@@ -1154,10 +1238,15 @@ Ipv4L3Protocol::AddAddress(uint32_t i, Ipv4InterfaceAddress address)
     NS_LOG_FUNCTION(this << i << address);
     Ptr<Ipv4Interface> interface = GetInterface(i);
     bool retVal = interface->AddAddress(address);
+    if (retVal)
+    {
+        IndexAddress(address.GetLocal());
+    }
     if (m_routingProtocol)
     {
         m_routingProtocol->NotifyAddAddress(i, address);
     }
+    FlushForwardingCache();
     return retVal;
 }
 
@@ -1183,10 +1272,12 @@ Ipv4L3Protocol::RemoveAddress(uint32_t i, uint32_t addressIndex)
     Ipv4InterfaceAddress address = interface->RemoveAddress(addressIndex);
     if (address != Ipv4InterfaceAddress())
     {
+        UnindexAddress(address.GetLocal());
         if (m_routingProtocol)
         {
             m_routingProtocol->NotifyRemoveAddress(i, address);
         }
+        FlushForwardingCache();
         return true;
     }
     return false;
@@ -1206,15 +1297,57 @@ Ipv4L3Protocol::RemoveAddress(uint32_t i, Ipv4Address address)
     Ipv4InterfaceAddress ifAddr = interface->RemoveAddress(address);
     if (ifAddr != Ipv4InterfaceAddress())
     {
+        UnindexAddress(ifAddr.GetLocal());
         if (m_routingProtocol)
         {
             m_routingProtocol->NotifyRemoveAddress(i, ifAddr);
         }
+        FlushForwardingCache();
         return true;
     }
     return false;
 }
 
+Ptr<Node>
+Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address address)
+{
+    NS_LOG_FUNCTION(address);
+    auto it = GetAddressIndex().find(address);
+    return (it != GetAddressIndex().end() ? it->second->m_node : nullptr);
+}
+
+Ipv4L3Protocol::Ipv4AddressIndex&
+Ipv4L3Protocol::GetAddressIndex()
+{
+    static Ipv4AddressIndex index;
+    return index;
+}
+
+void
+Ipv4L3Protocol::IndexAddress(Ipv4Address address)
+{
+    NS_LOG_FUNCTION(this << address);
+    if (!address.IsLocalhost())
+    {
+        GetAddressIndex().emplace(address, this);
+    }
+}
+
+void
+Ipv4L3Protocol::UnindexAddress(Ipv4Address address)
+{
+    NS_LOG_FUNCTION(this << address);
+    auto [first, last] = GetAddressIndex().equal_range(address);
+    for (auto it = first; it != last; ++it)
+    {
+        if (it->second == this)
+        {
+            GetAddressIndex().erase(it);
+            return;
+        }
+    }
+}
+
 Ipv4Address
 Ipv4L3Protocol::SourceAddressSelection(uint32_t interfaceIdx, Ipv4Address dest)
 {
@@ -1310,6 +1443,7 @@ Ipv4L3Protocol::SetMetric(uint32_t i, uint16_t metric)
     NS_LOG_FUNCTION(this << i << metric);
     Ptr<Ipv4Interface> interface = GetInterface(i);
     interface->SetMetric(metric);
+    FlushForwardingCache();
 }
 
 uint16_t
@@ -1351,6 +1485,7 @@ Ipv4L3Protocol::SetUp(uint32_t i)
         {
             m_routingProtocol->NotifyInterfaceUp(i);
         }
+        FlushForwardingCache();
     }
     else
     {
@@ -1372,6 +1507,7 @@ Ipv4L3Protocol::SetDown(uint32_t ifaceIndex)
     {
         m_routingProtocol->NotifyInterfaceDown(ifaceIndex);
     }
+    FlushForwardingCache();
 }
 
 bool
@@ -1572,21 +1708,28 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
                                             << " - Offset: " << (ipHeader.GetFragmentOffset()));
 
     fragments->AddFragment(p, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
+    m_fragmentsSize += p->GetSize();
 
     if (fragments->IsEntire())
     {
         packet = fragments->GetPacket();
+        m_fragmentsSize -= fragments->GetSize();
         m_timeoutEventList.erase(fragments->GetTimeoutIter());
         fragments = nullptr;
         m_fragments.erase(key);
         ret = true;
     }
+    else if (m_fragmentBufferSize > 0 && m_fragmentsSize > m_fragmentBufferSize)
+    {
+        EvictFragments();
+    }
 
     return ret;
 }
 
 Ipv4L3Protocol::Fragments::Fragments()
-    : m_moreFragment(false)
+    : m_moreFragment(false),
+      m_size(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -1598,14 +1741,11 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
+    // fragments mostly arrive in order, hence look for the position from the end
+    auto it = m_fragments.end();
+    while (it != m_fragments.begin() && std::prev(it)->second > fragmentOffset)
     {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
+        it--;
     }
 
     if (it == m_fragments.end())
@@ -1614,6 +1754,7 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
     }
 
     m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+    m_size += fragment->GetSize();
 }
 
 bool
@@ -1623,6 +1764,12 @@ Ipv4L3Protocol::Fragments::IsEntire() const
 
     bool ret = !m_moreFragment && !m_fragments.empty();
 
+    // the fragments can not cover the packet if they are smaller than it
+    if (ret && m_size < m_fragments.back().second + m_fragments.back().first->GetSize())
+    {
+        ret = false;
+    }
+
     if (ret)
     {
         uint16_t lastEndOffset = 0;
@@ -1731,6 +1878,12 @@ Ipv4L3Protocol::Fragments::GetTimeoutIter()
     return m_timeoutIter;
 }
 
+uint32_t
+Ipv4L3Protocol::Fragments::GetSize() const
+{
+    return m_size;
+}
+
 void
 Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader, uint32_t iif)
 {
@@ -1748,6 +1901,7 @@ Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader,
     m_dropTrace(ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
 
     // clear the buffers
+    m_fragmentsSize -= it->second->GetSize();
     it->second = nullptr;
 
     m_fragments.erase(key);
@@ -1893,4 +2047,34 @@ Ipv4L3Protocol::HandleTimeout()
     m_timeoutEvent = Simulator::Schedule(difference, &Ipv4L3Protocol::HandleTimeout, this);
 }
 
+void
+Ipv4L3Protocol::EvictFragments()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The timeout list is sorted by arrival of the first fragment, hence the
+    // oldest packets are at its front.
+    while (m_fragmentsSize > m_fragmentBufferSize && !m_timeoutEventList.empty())
+    {
+        auto& [expiration, key, ipHeader, iif] = m_timeoutEventList.front();
+        auto it = m_fragments.find(key);
+        NS_ASSERT(it != m_fragments.end());
+        NS_LOG_LOGIC("Reassembly buffer full, dropping the fragments of packet "
+                     << ipHeader.GetIdentification() << " from " << ipHeader.GetSource());
+        m_dropTrace(ipHeader,
+                    it->second->GetPartialPacket(),
+                    DROP_FRAGMENT_BUFFER_FULL,
+                    this,
+                    iif);
+        m_fragmentsSize -= it->second->GetSize();
+        m_fragments.erase(it);
+        m_timeoutEventList.pop_front();
+    }
+
+    if (m_timeoutEventList.empty())
+    {
+        m_timeoutEvent.Cancel();
+    }
+}
+
 } // namespace ns3
@@ -35,6 +35,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class Ipv4L3ProtocolTestCase;
@@ -103,13 +104,14 @@ class Ipv4L3Protocol : public Ipv4
      */
     enum DropReason
     {
-        DROP_TTL_EXPIRED = 1,  /**< Packet TTL has expired */
-        DROP_NO_ROUTE,         /**< No route to host */
-        DROP_BAD_CHECKSUM,     /**< Bad checksum */
-        DROP_INTERFACE_DOWN,   /**< Interface is down so can not send packet */
-        DROP_ROUTE_ERROR,      /**< Route error */
-        DROP_FRAGMENT_TIMEOUT, /**< Fragment timeout exceeded */
-        DROP_DUPLICATE         /**< Duplicate packet received */
+        DROP_TTL_EXPIRED = 1,     /**< Packet TTL has expired */
+        DROP_NO_ROUTE,            /**< No route to host */
+        DROP_BAD_CHECKSUM,        /**< Bad checksum */
+        DROP_INTERFACE_DOWN,      /**< Interface is down so can not send packet */
+        DROP_ROUTE_ERROR,         /**< Route error */
+        DROP_FRAGMENT_TIMEOUT,    /**< Fragment timeout exceeded */
+        DROP_DUPLICATE,           /**< Duplicate packet received */
+        DROP_FRAGMENT_BUFFER_FULL /**< Fragment reassembly buffer full */
     };
 
     /**
@@ -137,6 +139,16 @@ class Ipv4L3Protocol : public Ipv4
 
     Ipv4Address SourceAddressSelection(uint32_t interface, Ipv4Address dest) override;
 
+    /**
+     * \brief Remove all the routes stored in the forwarding cache.
+     *
+     * The cache is flushed automatically on interface and address changes and
+     * by the static and global routing protocols when their routes change.
+     * Other routing protocols must call this function whenever a route they
+     * previously returned to RouteInput () becomes stale.
+     */
+    void FlushForwardingCache();
+
     /**
      * \param ttl default ttl to use
      *
@@ -213,6 +225,19 @@ class Ipv4L3Protocol : public Ipv4
                                     Ipv4Address dst,
                                     Ipv4InterfaceAddress::InterfaceAddressScope_e scope) override;
 
+    /**
+     * \brief Get the node owning an IPv4 address.
+     *
+     * The lookup is served by an index of the addresses added to all the
+     * Ipv4L3Protocol instances, hence its cost does not depend on the number
+     * of nodes. Loopback addresses are not indexed.
+     *
+     * \param address the address
+     * \returns the node with an interface configured with the given address
+     *          (any of them, if several), or 0 if none
+     */
+    static Ptr<Node> GetNodeWithAddress(Ipv4Address address);
+
     void SetMetric(uint32_t i, uint16_t metric) override;
     uint16_t GetMetric(uint32_t i) const override;
     uint16_t GetMtu(uint32_t i) const override;
@@ -293,6 +318,28 @@ class Ipv4L3Protocol : public Ipv4
      */
     friend class ::Ipv4L3ProtocolTestCase;
 
+    /// Container of the addresses added to all the Ipv4L3Protocol instances
+    typedef std::unordered_multimap<Ipv4Address, Ipv4L3Protocol*, Ipv4AddressHash>
+        Ipv4AddressIndex;
+
+    /**
+     * \brief Get the index of the addresses of all the Ipv4L3Protocol instances
+     * \returns the address index
+     */
+    static Ipv4AddressIndex& GetAddressIndex();
+
+    /**
+     * \brief Add an address of this instance to the address index
+     * \param address the address
+     */
+    void IndexAddress(Ipv4Address address);
+
+    /**
+     * \brief Remove an address of this instance from the address index
+     * \param address the address
+     */
+    void UnindexAddress(Ipv4Address address);
+
     // class Ipv4 attributes
     void SetIpForward(bool forward) override;
     bool GetIpForward() const override;
@@ -348,6 +395,23 @@ class Ipv4L3Protocol : public Ipv4
      */
     void IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv4Header& header);
 
+    /**
+     * \brief Store a route in the forwarding cache, then forward the packet.
+     * \param rtentry route
+     * \param p packet to forward
+     * \param header IPv4 header to add to the packet
+     */
+    void CacheAndForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv4Header& header);
+
+    /**
+     * \brief Forward a packet using the forwarding cache.
+     * \param packet packet to forward
+     * \param header IPv4 header of the packet
+     * \param interface the input interface
+     * \returns true if a cached route was found and the packet has been forwarded
+     */
+    bool ForwardFromCache(Ptr<const Packet> packet, const Ipv4Header& header, uint32_t interface);
+
     /**
      * \brief Forward a multicast packet.
      * \param mrtentry route
@@ -538,6 +602,12 @@ class Ipv4L3Protocol : public Ipv4
      */
     void HandleTimeout();
 
+    /**
+     * \brief Drop the oldest fragmented packets until the fragments fit in
+     * the reassembly buffer.
+     */
+    void EvictFragments();
+
     FragmentsTimeoutsList_t m_timeoutEventList; //!< Timeout "events" container
 
     EventId m_timeoutEvent; //!< Event for the next scheduled timeout
@@ -591,12 +661,23 @@ class Ipv4L3Protocol : public Ipv4
          */
         FragmentsTimeoutsListI_t GetTimeoutIter();
 
+        /**
+         * \brief Get the number of bytes held by the fragments.
+         * \returns the size of the fragments
+         */
+        uint32_t GetSize() const;
+
       private:
         /**
          * \brief True if other fragments will be sent.
          */
         bool m_moreFragment;
 
+        /**
+         * \brief The number of bytes held by the fragments.
+         */
+        uint32_t m_size;
+
         /**
          * \brief The current fragments.
          */
@@ -613,6 +694,8 @@ class Ipv4L3Protocol : public Ipv4
 
     MapFragments_t m_fragments;       //!< Fragmented packets.
     Time m_fragmentExpirationTimeout; //!< Expiration timeout
+    uint32_t m_fragmentBufferSize;    //!< Maximum number of bytes held by the fragments
+    uint32_t m_fragmentsSize{0};      //!< Number of bytes held by the fragments
 
     /// IETF RFC 6621, Section 6.2 de-duplication w/o IPSec
     /// RFC 6621 recommended duplicate packet tuple: {IPV hash, IP protocol, IP source address, IP
@@ -643,6 +726,14 @@ class Ipv4L3Protocol : public Ipv4
     Ipv4RoutingProtocol::MulticastForwardCallback m_mcb; ///< Multicast forward callback
     Ipv4RoutingProtocol::LocalDeliverCallback m_lcb;     ///< Local delivery callback
     Ipv4RoutingProtocol::ErrorCallback m_ecb;            ///< Error callback
+
+    /// Container of the cached unicast routes, indexed by destination address
+    typedef std::unordered_map<Ipv4Address, Ptr<Ipv4Route>, Ipv4AddressHash> ForwardingCache_t;
+
+    uint32_t m_forwardingCacheSize;      //!< Maximum number of cached routes
+    ForwardingCache_t m_forwardingCache; //!< Cached unicast forwarding routes
+    /// Unicast forward callback filling the forwarding cache
+    Ipv4RoutingProtocol::UnicastForwardCallback m_cucb;
 };
 
 } // Namespace ns3
@@ -0,0 +1,137 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ipv4-route-prefix-index.h"
+
+#include "ipv4-routing-table-entry.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * \param length a prefix length, between 0 and 32
+ * \return the contiguous mask of the given length, in host order
+ */
+uint32_t
+PrefixMask(uint16_t length)
+{
+    return length == 0 ? 0 : ~((1U << (32 - length)) - 1);
+}
+
+} // namespace
+
+void
+Ipv4RoutePrefixIndex::Clear()
+{
+    for (auto& table : m_tables)
+    {
+        table.clear();
+    }
+    m_lengths.clear();
+    m_others.clear();
+    m_nRoutes = 0;
+}
+
+void
+Ipv4RoutePrefixIndex::Add(Ipv4RoutingTableEntry* route)
+{
+    Entry entry{m_nRoutes++, route};
+    Ipv4Mask mask = route->GetDestNetworkMask();
+    uint16_t length = mask.GetPrefixLength();
+    if (PrefixMask(length) != mask.Get())
+    {
+        m_others.push_back(entry);
+        return;
+    }
+    uint32_t key = route->GetDestNetwork().Get() & mask.Get();
+    auto& bucket = m_tables[length][key];
+    if (bucket.empty() && m_tables[length].size() == 1)
+    {
+        m_lengths.push_back(length);
+        std::sort(m_lengths.begin(), m_lengths.end(), std::greater<>());
+    }
+    bucket.push_back(entry);
+}
+
+void
+Ipv4RoutePrefixIndex::Lookup(Ipv4Address dest, std::vector<Ipv4RoutingTableEntry*>& routes) const
+{
+    routes.clear();
+    // most lookups match a single prefix, whose bucket is already sorted
+    const std::vector<Entry>* single = nullptr;
+    std::vector<Entry> matches;
+    for (uint8_t length : m_lengths)
+    {
+        uint32_t key = dest.Get() & PrefixMask(length);
+        auto it = m_tables[length].find(key);
+        if (it == m_tables[length].end())
+        {
+            continue;
+        }
+        if (!single && matches.empty())
+        {
+            single = &it->second;
+            continue;
+        }
+        if (single)
+        {
+            matches = *single;
+            single = nullptr;
+        }
+        matches.insert(matches.end(), it->second.begin(), it->second.end());
+    }
+    for (const auto& entry : m_others)
+    {
+        if (entry.route->GetDestNetworkMask().IsMatch(dest, entry.route->GetDestNetwork()))
+        {
+            if (single)
+            {
+                matches = *single;
+                single = nullptr;
+            }
+            matches.push_back(entry);
+        }
+    }
+
+    if (single)
+    {
+        for (const auto& entry : *single)
+        {
+            routes.push_back(entry.route);
+        }
+        return;
+    }
+    std::sort(matches.begin(), matches.end(), [](const Entry& a, const Entry& b) {
+        return a.order < b.order;
+    });
+    for (const auto& entry : matches)
+    {
+        routes.push_back(entry.route);
+    }
+}
+
+uint32_t
+Ipv4RoutePrefixIndex::GetNRoutes() const
+{
+    return m_nRoutes;
+}
+
+} // namespace ns3
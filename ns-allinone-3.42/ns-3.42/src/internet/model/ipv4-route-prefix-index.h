@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_ROUTE_PREFIX_INDEX_H
+#define IPV4_ROUTE_PREFIX_INDEX_H
+
+#include "ns3/ipv4-address.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class Ipv4RoutingTableEntry;
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief Index of IPv4 routes by destination prefix.
+ *
+ * The routes are stored in one hash table per prefix length, keyed by the
+ * masked destination network, and each bucket holds the routes to that
+ * prefix (e.g., an ECMP set) in the order of insertion. A lookup probes one
+ * table per prefix length in use, hence its cost does not depend on the
+ * number of routes. Routes with a non-contiguous mask are kept apart and
+ * checked one by one.
+ *
+ * The index does not own the routes; it must be rebuilt whenever the
+ * routing table it refers to is modified.
+ */
+class Ipv4RoutePrefixIndex
+{
+  public:
+    /// Remove all the routes from the index
+    void Clear();
+
+    /**
+     * Add a route to the index, after the routes already added.
+     *
+     * \param route the route, whose destination network and mask are indexed
+     */
+    void Add(Ipv4RoutingTableEntry* route);
+
+    /**
+     * Get the routes whose destination prefix matches an address.
+     *
+     * \param dest the destination address
+     * \param [out] routes the matching routes, in the order they were added
+     */
+    void Lookup(Ipv4Address dest, std::vector<Ipv4RoutingTableEntry*>& routes) const;
+
+    /**
+     * \return the number of routes in the index
+     */
+    uint32_t GetNRoutes() const;
+
+  private:
+    /// A route of the index
+    struct Entry
+    {
+        uint32_t order;               //!< rank of the route in the order of insertion
+        Ipv4RoutingTableEntry* route; //!< the route
+    };
+
+    /// Routes by masked destination network
+    typedef std::unordered_map<uint32_t, std::vector<Entry>> PrefixTable;
+
+    std::array<PrefixTable, 33> m_tables; //!< tables indexed by prefix length
+    std::vector<uint8_t> m_lengths;       //!< prefix lengths in use, in decreasing order
+    std::vector<Entry> m_others;          //!< routes with a non-contiguous mask
+    uint32_t m_nRoutes{0};                //!< number of routes in the index
+};
+
+} // namespace ns3
+
+#endif /* IPV4_ROUTE_PREFIX_INDEX_H */
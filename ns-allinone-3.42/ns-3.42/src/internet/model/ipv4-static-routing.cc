@@ -26,6 +26,7 @@
 
 #include "ipv4-static-routing.h"
 
+#include "ipv4-l3-protocol.h"
 #include "ipv4-route.h"
 #include "ipv4-routing-table-entry.h"
 
@@ -80,6 +81,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         auto routePtr = new Ipv4RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        FlushForwardingCache();
     }
 }
 
@@ -98,6 +100,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         auto routePtr = new Ipv4RoutingTableEntry(route);
 
         m_networkRoutes.emplace_back(routePtr, metric);
+        FlushForwardingCache();
     }
 }
 
@@ -459,6 +462,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
         {
             delete j->first;
             m_networkRoutes.erase(j);
+            FlushForwardingCache();
             return;
         }
         tmp++;
@@ -466,6 +470,16 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     NS_ASSERT(false);
 }
 
+void
+Ipv4StaticRouting::FlushForwardingCache()
+{
+    Ptr<Ipv4L3Protocol> ipv4 = DynamicCast<Ipv4L3Protocol>(m_ipv4);
+    if (ipv4)
+    {
+        ipv4->FlushForwardingCache();
+    }
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::RouteOutput(Ptr<Packet> p,
                                const Ipv4Header& header,
@@ -397,6 +397,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * \brief Flush the forwarding cache of the IPv4 instance after a unicast route change.
+     */
+    void FlushForwardingCache();
+
     /**
      * \brief Lookup in the multicast forwarding table for destination.
      * \param origin source address
@@ -23,11 +23,30 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv6EndPointDemux");
 
+bool
+Ipv6EndPointDemux::EndPointKey::operator==(const EndPointKey& other) const
+{
+    return localAddress == other.localAddress && localPort == other.localPort &&
+           peerAddress == other.peerAddress && peerPort == other.peerPort;
+}
+
+std::size_t
+Ipv6EndPointDemux::EndPointKeyHash::operator()(const EndPointKey& key) const
+{
+    Ipv6AddressHash hash;
+    uint32_t ports = (uint32_t(key.localPort) << 16) | key.peerPort;
+    std::size_t h = hash(key.localAddress);
+    h = h * 31 + hash(key.peerAddress);
+    return h * 31 + ports;
+}
+
 Ipv6EndPointDemux::Ipv6EndPointDemux()
     : m_ephemeral(49152),
       m_portFirst(49152),
@@ -42,29 +61,108 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv6EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_entries.clear();
+    m_tuples.clear();
+    m_localPorts.clear();
 }
 
-bool
-Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    NS_LOG_FUNCTION(this << endPoint);
+    Entry& entry = m_entries[endPoint];
+    entry.position = m_endPoints.insert(m_endPoints.end(), endPoint);
+    Index(endPoint, entry);
+    endPoint->m_demux = this;
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint, Entry& entry)
+{
+    entry.key = {endPoint->GetLocalAddress(),
+                 endPoint->GetLocalPort(),
+                 endPoint->GetPeerAddress(),
+                 endPoint->GetPeerPort()};
+    m_tuples[entry.key].push_back(endPoint);
+    m_localPorts[entry.key.localPort]++;
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint, const Entry& entry)
+{
+    auto tuple = m_tuples.find(entry.key);
+    NS_ASSERT(tuple != m_tuples.end());
+    auto& endPoints = tuple->second;
+    endPoints.erase(std::find(endPoints.begin(), endPoints.end(), endPoint));
+    if (endPoints.empty())
+    {
+        m_tuples.erase(tuple);
+    }
+    auto port = m_localPorts.find(entry.key.localPort);
+    if (--port->second == 0)
+    {
+        m_localPorts.erase(port);
+    }
+}
+
+void
+Ipv6EndPointDemux::Update(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Entry& entry = m_entries.at(endPoint);
+    Unindex(endPoint, entry);
+    Index(endPoint, entry);
+}
+
+void
+Ipv6EndPointDemux::Find(const EndPointKey& key,
+                        Ptr<Ipv6Interface> incomingInterface,
+                        EndPoints& endPoints) const
+{
+    auto tuple = m_tuples.find(key);
+    if (tuple == m_tuples.end())
+    {
+        return;
+    }
+    for (auto endP : tuple->second)
     {
-        if ((*i)->GetLocalPort() == port)
+        if (!endP->IsRxEnabled())
         {
-            return true;
+            NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                              << " because endpoint can not receive packets");
+            continue;
+        }
+        if (endP->GetBoundNetDevice() &&
+            (!incomingInterface || endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                              << " because endpoint is bound to specific device");
+            continue;
         }
+        endPoints.push_back(endP);
     }
-    return false;
+}
+
+bool
+Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_localPorts.find(port) != m_localPorts.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
+    if (!LookupPortLocal(port))
+    {
+        return false;
+    }
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
@@ -87,8 +185,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -103,8 +200,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -126,8 +222,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -139,21 +234,21 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto tuple = m_tuples.find({localAddress, localPort, peerAddress, peerPort});
+    if (tuple != m_tuples.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endP : tuple->second)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
 
     return endPoint;
 }
@@ -162,21 +257,26 @@ void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto entry = m_entries.find(endPoint);
+    if (entry == m_entries.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    Unindex(endPoint, entry->second);
+    m_endPoints.erase(entry->second.position);
+    m_entries.erase(entry);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
  * If we have an exact match, we return it.
  * Otherwise, if we find a generic match, we return it.
  * Otherwise, we return 0.
+ *
+ * Each class of match is an exact match on some four-tuple, hence a lookup
+ * in the index: the local address of the endpoint is either the destination
+ * address or the wildcard, and its peer is either the source or the wildcard.
  */
 Ipv6EndPointDemux::EndPoints
 Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
@@ -186,120 +286,28 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
                           Ptr<Ipv6Interface> incomingInterface)
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; /* Matches exact on local port, wildcards on others */
-    EndPoints retval2; /* Matches exact on local port/adder, wildcards on others */
-    EndPoints retval3; /* Matches all but local address */
-    EndPoints retval4; /* Exact match on all 4 */
-
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
-            {
-                continue;
-            }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
-            {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
-            }
-        }
-
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
-
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
-
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
-
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
-        }
-    }
 
     // Here we find the most exact match
     EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
-    }
-    else if (!retval3.empty())
+    /* All 4 match */
+    Find({daddr, dport, saddr, sport}, incomingInterface, retval);
+    if (retval.empty())
     {
-        retval = retval3;
+        /* All but local address */
+        Find({Ipv6Address::GetAny(), dport, saddr, sport}, incomingInterface, retval);
     }
-    else if (!retval2.empty())
+    if (retval.empty())
     {
-        retval = retval2;
+        /* Only local port and local address matches exactly */
+        Find({daddr, dport, Ipv6Address::GetAny(), 0}, incomingInterface, retval);
     }
-    else
+    if (retval.empty())
     {
-        retval = retval1;
+        /* Only local port matches exactly */
+        Find({Ipv6Address::GetAny(), dport, Ipv6Address::GetAny(), 0}, incomingInterface, retval);
     }
+    NS_LOG_LOGIC("Found " << retval.size() << " endpoints");
 
     NS_ABORT_MSG_IF(retval.size() > 1,
                     "Too many endpoints - perhaps you created too many sockets without binding "
@@ -310,6 +318,14 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    // an exact match is found in the index, unless several endpoints share
+    // the four-tuple and the first one must be found in the list
+    auto tuple = m_tuples.find({dst, dport, src, sport});
+    if (tuple != m_tuples.end() && tuple->second.size() == 1)
+    {
+        return tuple->second.front();
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
@@ -26,6 +26,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -36,6 +38,10 @@ class Ipv6EndPoint;
  * \ingroup ipv6
  *
  * \brief Demultiplexer for end points.
+ *
+ * The endpoints are also indexed by four-tuple (and counted by local port),
+ * so that the lookups of a packet do not depend on the number of endpoints.
+ * The endpoints update the index when their four-tuple changes.
  */
 class Ipv6EndPointDemux
 {
@@ -161,6 +167,85 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * \brief The four-tuple of an endpoint.
+     */
+    struct EndPointKey
+    {
+        Ipv6Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv6Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the four-tuple to compare with
+         * \return true if the four-tuples are equal
+         */
+        bool operator==(const EndPointKey& other) const;
+    };
+
+    /**
+     * \brief Hash function of the four-tuples.
+     */
+    struct EndPointKeyHash
+    {
+        /**
+         * \brief Hash a four-tuple.
+         * \param key the four-tuple
+         * \return the hash
+         */
+        std::size_t operator()(const EndPointKey& key) const;
+    };
+
+    /**
+     * \brief Where an endpoint is stored.
+     */
+    struct Entry
+    {
+        EndPointsI position; //!< position in the list of endpoints
+        EndPointKey key;     //!< four-tuple the endpoint is indexed with
+    };
+
+    /**
+     * \brief Add an endpoint to the list and the indexes.
+     * \param endPoint the endpoint
+     */
+    void Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Index an endpoint with its current four-tuple.
+     * \param endPoint the endpoint
+     * \param entry where the endpoint is stored
+     */
+    void Index(Ipv6EndPoint* endPoint, Entry& entry);
+
+    /**
+     * \brief Remove an endpoint from the indexes.
+     * \param endPoint the endpoint
+     * \param entry where the endpoint is stored
+     */
+    void Unindex(Ipv6EndPoint* endPoint, const Entry& entry);
+
+    /**
+     * \brief Index again an endpoint whose four-tuple changed.
+     * \param endPoint the endpoint
+     */
+    void Update(Ipv6EndPoint* endPoint);
+
+    /**
+     * \brief Get the endpoints with a four-tuple, which can receive a packet
+     * from an interface.
+     * \param key the four-tuple
+     * \param incomingInterface the incoming interface
+     * \param [out] endPoints the endpoints, appended
+     */
+    void Find(const EndPointKey& key,
+              Ptr<Ipv6Interface> incomingInterface,
+              EndPoints& endPoints) const;
+
     /**
      * \brief Allocate a ephemeral port.
      * \return a port
@@ -186,6 +271,21 @@ class Ipv6EndPointDemux
      * \brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief Where each endpoint is stored.
+     */
+    std::unordered_map<const Ipv6EndPoint*, Entry> m_entries;
+
+    /**
+     * \brief The endpoints, by four-tuple.
+     */
+    std::unordered_map<EndPointKey, std::vector<Ipv6EndPoint*>, EndPointKeyHash> m_tuples;
+
+    /**
+     * \brief The number of endpoints using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } /* namespace ns3 */
@@ -33,6 +33,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -195,6 +196,13 @@ class Ipv6EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv6EndPointDemux;
+
+    /**
+     * \brief The demux which indexes this endpoint, if any.
+     */
+    Ipv6EndPointDemux* m_demux;
+
     /**
      * \brief The local address.
      */
@@ -337,7 +337,14 @@ Ipv6ExtensionFragment::GetTypeId()
                           "will be cleared from the buffer.",
                           TimeValue(Seconds(60)),
                           MakeTimeAccessor(&Ipv6ExtensionFragment::m_fragmentExpirationTimeout),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("FragmentBufferSize",
+                          "The maximum number of bytes held by the fragments waiting "
+                          "for reassembly, 0 means no limit. When it is exceeded, the "
+                          "oldest fragmented packets are dropped.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv6ExtensionFragment::m_fragmentBufferSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -360,6 +367,7 @@ Ipv6ExtensionFragment::DoDispose()
     }
 
     m_fragments.clear();
+    m_fragmentsSize = 0;
     m_timeoutEventList.clear();
     if (m_timeoutEvent.IsPending())
     {
@@ -423,6 +431,7 @@ Ipv6ExtensionFragment::Process(Ptr<Packet>& packet,
     {
         fragments = it->second;
     }
+    uint32_t previousSize = fragments->GetSize();
 
     if (fragmentOffset == 0)
     {
@@ -433,10 +442,12 @@ Ipv6ExtensionFragment::Process(Ptr<Packet>& packet,
 
     NS_LOG_DEBUG("Add fragment with IP hdr id " << identification << " offset " << fragmentOffset);
     fragments->AddFragment(p, fragmentOffset, moreFragment);
+    m_fragmentsSize += fragments->GetSize() - previousSize;
 
     if (fragments->IsEntire())
     {
         packet = fragments->GetPacket();
+        m_fragmentsSize -= fragments->GetSize();
         m_timeoutEventList.erase(fragments->GetTimeoutIter());
         m_fragments.erase(fragmentKey);
         NS_LOG_DEBUG("Finished fragment with IP hdr id "
@@ -447,6 +458,10 @@ Ipv6ExtensionFragment::Process(Ptr<Packet>& packet,
     else
     {
         stopProcessing = true;
+        if (m_fragmentBufferSize > 0 && m_fragmentsSize > m_fragmentBufferSize)
+        {
+            EvictFragments();
+        }
     }
 
     return 0;
@@ -663,6 +678,7 @@ Ipv6ExtensionFragment::HandleFragmentsTimeout(FragmentKey_t fragmentKey, Ipv6Hea
     ipL3->ReportDrop(ipHeader, packet, Ipv6L3Protocol::DROP_FRAGMENT_TIMEOUT);
 
     // clear the buffers
+    m_fragmentsSize -= fragments->GetSize();
     m_fragments.erase(fragmentKey);
 }
 
@@ -719,8 +735,39 @@ Ipv6ExtensionFragment::HandleTimeout()
     m_timeoutEvent = Simulator::Schedule(difference, &Ipv6ExtensionFragment::HandleTimeout, this);
 }
 
+void
+Ipv6ExtensionFragment::EvictFragments()
+{
+    NS_LOG_FUNCTION(this);
+    Ptr<Ipv6L3Protocol> ipL3 = GetNode()->GetObject<Ipv6L3Protocol>();
+
+    // The timeout list is sorted by arrival of the first fragment, hence the
+    // oldest packets are at its front.
+    while (m_fragmentsSize > m_fragmentBufferSize && !m_timeoutEventList.empty())
+    {
+        auto& [expiration, key, ipHeader] = m_timeoutEventList.front();
+        auto it = m_fragments.find(key);
+        NS_ASSERT(it != m_fragments.end());
+        NS_LOG_DEBUG("Reassembly buffer full, dropping the fragments with IP hdr id "
+                     << key.second << " from " << key.first);
+        Ptr<Packet> packet = it->second->GetPartialPacket();
+        ipL3->ReportDrop(ipHeader,
+                         packet ? packet : Create<Packet>(),
+                         Ipv6L3Protocol::DROP_FRAGMENT_BUFFER_FULL);
+        m_fragmentsSize -= it->second->GetSize();
+        m_fragments.erase(it);
+        m_timeoutEventList.pop_front();
+    }
+
+    if (m_timeoutEventList.empty())
+    {
+        m_timeoutEvent.Cancel();
+    }
+}
+
 Ipv6ExtensionFragment::Fragments::Fragments()
-    : m_moreFragment(false)
+    : m_moreFragment(false),
+      m_size(0)
 {
 }
 
@@ -734,14 +781,11 @@ Ipv6ExtensionFragment::Fragments::AddFragment(Ptr<Packet> fragment,
                                               bool moreFragment)
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
+    // fragments mostly arrive in order, hence look for the position from the end
+    auto it = m_packetFragments.end();
+    while (it != m_packetFragments.begin() && std::prev(it)->second > fragmentOffset)
     {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
+        it--;
     }
 
     if (it == m_packetFragments.end())
@@ -750,6 +794,7 @@ Ipv6ExtensionFragment::Fragments::AddFragment(Ptr<Packet> fragment,
     }
 
     m_packetFragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+    m_size += fragment->GetSize();
 }
 
 void
@@ -764,6 +809,13 @@ Ipv6ExtensionFragment::Fragments::IsEntire() const
 {
     bool ret = !m_moreFragment && !m_packetFragments.empty();
 
+    // contiguous fragments add up exactly to the end of the last one
+    if (ret && m_size != m_packetFragments.back().second +
+                             m_packetFragments.back().first->GetSize())
+    {
+        ret = false;
+    }
+
     if (ret)
     {
         uint16_t lastEndOffset = 0;
@@ -838,6 +890,12 @@ Ipv6ExtensionFragment::Fragments::GetTimeoutIter()
     return m_timeoutIter;
 }
 
+uint32_t
+Ipv6ExtensionFragment::Fragments::GetSize() const
+{
+    return m_size + (m_unfragmentable ? m_unfragmentable->GetSize() : 0);
+}
+
 NS_OBJECT_ENSURE_REGISTERED(Ipv6ExtensionRouting);
 
 TypeId
@@ -398,12 +398,24 @@ class Ipv6ExtensionFragment : public Ipv6Extension
          */
         FragmentsTimeoutsListI_t GetTimeoutIter();
 
+        /**
+         * \brief Get the number of bytes held by the fragments and the
+         * unfragmentable part.
+         * \returns the size of the packet parts so far received
+         */
+        uint32_t GetSize() const;
+
       private:
         /**
          * \brief If other fragments will be sent.
          */
         bool m_moreFragment;
 
+        /**
+         * \brief The number of bytes held by the fragments.
+         */
+        uint32_t m_size;
+
         /**
          * \brief The current fragments.
          */
@@ -467,9 +479,17 @@ class Ipv6ExtensionFragment : public Ipv6Extension
      */
     void HandleTimeout();
 
+    /**
+     * \brief Drop the oldest fragmented packets until the fragments fit in
+     * the reassembly buffer.
+     */
+    void EvictFragments();
+
     FragmentsTimeoutsList_t m_timeoutEventList; //!< Timeout "events" container
     EventId m_timeoutEvent;                     //!< Event for the next scheduled timeout
     Time m_fragmentExpirationTimeout;           //!< Expiration timeout
+    uint32_t m_fragmentBufferSize;              //!< Maximum number of bytes held by the fragments
+    uint32_t m_fragmentsSize{0};                //!< Number of bytes held by the fragments
 };
 
 /**
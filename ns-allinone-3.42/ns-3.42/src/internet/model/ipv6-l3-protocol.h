@@ -80,14 +80,15 @@ class Ipv6L3Protocol : public Ipv6
      */
     enum DropReason
     {
-        DROP_TTL_EXPIRED = 1,  /**< Packet TTL has expired */
-        DROP_NO_ROUTE,         /**< No route to host */
-        DROP_INTERFACE_DOWN,   /**< Interface is down so can not send packet */
-        DROP_ROUTE_ERROR,      /**< Route error */
-        DROP_UNKNOWN_PROTOCOL, /**< Unknown L4 protocol */
-        DROP_UNKNOWN_OPTION,   /**< Unknown option */
-        DROP_MALFORMED_HEADER, /**< Malformed header */
-        DROP_FRAGMENT_TIMEOUT, /**< Fragment timeout */
+        DROP_TTL_EXPIRED = 1,      /**< Packet TTL has expired */
+        DROP_NO_ROUTE,             /**< No route to host */
+        DROP_INTERFACE_DOWN,       /**< Interface is down so can not send packet */
+        DROP_ROUTE_ERROR,          /**< Route error */
+        DROP_UNKNOWN_PROTOCOL,     /**< Unknown L4 protocol */
+        DROP_UNKNOWN_OPTION,       /**< Unknown option */
+        DROP_MALFORMED_HEADER,     /**< Malformed header */
+        DROP_FRAGMENT_TIMEOUT,     /**< Fragment timeout */
+        DROP_FRAGMENT_BUFFER_FULL, /**< Fragment reassembly buffer full */
     };
 
     /**
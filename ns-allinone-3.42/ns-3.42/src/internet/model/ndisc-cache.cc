@@ -26,8 +26,12 @@
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -101,9 +105,10 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    auto it = m_ndCache.find(dst);
+    if (it != m_ndCache.end())
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = it->second;
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -147,15 +152,12 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
-        }
+        m_ndCache.erase(i);
+        entry->ClearWaitingPacket();
+        delete entry;
     }
 }
 
@@ -170,6 +172,73 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_nudEvent.Cancel();
+}
+
+void
+NdiscCache::QueueNudTimer(NdiscCache::Entry* entry, Time expiry)
+{
+    NS_LOG_FUNCTION(this << entry << expiry);
+    entry->m_nudTimer = m_nudTimers.emplace(expiry, entry);
+    entry->m_nudRunning = true;
+    if (m_nudTimers.begin() == entry->m_nudTimer)
+    {
+        ScheduleNudEvent();
+    }
+}
+
+void
+NdiscCache::ScheduleNudEvent()
+{
+    NS_LOG_FUNCTION(this);
+    Time earliest = m_nudTimers.begin()->first;
+    if (!m_nudEvent.IsPending() ||
+        m_nudEvent.GetTs() > static_cast<uint64_t>(earliest.GetTimeStep()))
+    {
+        m_nudEvent.Cancel();
+        m_nudEvent =
+            Simulator::Schedule(earliest - Simulator::Now(), &NdiscCache::HandleNudTimeout, this);
+    }
+}
+
+void
+NdiscCache::CancelNudTimer(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (entry->m_nudRunning)
+    {
+        m_nudTimers.erase(entry->m_nudTimer);
+        entry->m_nudRunning = false;
+        if (m_nudTimers.empty())
+        {
+            m_nudEvent.Cancel();
+        }
+    }
+}
+
+void
+NdiscCache::HandleNudTimeout()
+{
+    NS_LOG_FUNCTION(this);
+    Time now = Simulator::Now();
+    while (!m_nudTimers.empty() && m_nudTimers.begin()->first <= now)
+    {
+        NdiscCache::Entry* entry = m_nudTimers.begin()->second;
+        m_nudTimers.erase(m_nudTimers.begin());
+        if (entry->m_nudExpiry > now)
+        {
+            // the timer has been refreshed since it was queued
+            entry->m_nudTimer = m_nudTimers.emplace(entry->m_nudExpiry, entry);
+            continue;
+        }
+        entry->m_nudRunning = false;
+        // the handler may remove the entry, or restart its timer
+        (entry->*(entry->m_nudHandler))();
+    }
+    if (!m_nudTimers.empty())
+    {
+        ScheduleNudEvent();
+    }
 }
 
 void
@@ -192,7 +261,14 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries sorted by address
+    std::vector<std::pair<Ipv6Address, NdiscCache::Entry*>> entries(m_ndCache.begin(),
+                                                                     m_ndCache.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -247,13 +323,31 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudHandler(nullptr),
+      m_nudRunning(false),
       m_lastReachabilityConfirmation(Seconds(0.0)),
       m_nsRetransmit(0)
 {
     NS_LOG_FUNCTION(this);
 }
 
+NdiscCache::Entry::~Entry()
+{
+    NS_LOG_FUNCTION(this);
+    m_ndCache->CancelNudTimer(this);
+}
+
+void
+NdiscCache::Entry::StartNudTimer(void (NdiscCache::Entry::*handler)(), Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    m_ndCache->CancelNudTimer(this);
+    m_nudHandler = handler;
+    m_nudDelay = delay;
+    m_nudExpiry = Simulator::Now() + delay;
+    m_ndCache->QueueNudTimer(this, m_nudExpiry);
+}
+
 void
 NdiscCache::Entry::SetRouter(bool router)
 {
@@ -469,15 +563,9 @@ void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                  m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -488,11 +576,15 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
+        if (m_nudRunning && m_nudTimer->first <= Simulator::Now() + m_nudDelay)
         {
-            m_nudTimer.Cancel();
+            // just push the expiration back, it is checked when the queued time is reached
+            m_nudExpiry = Simulator::Now() + m_nudDelay;
+        }
+        else if (m_nudHandler)
+        {
+            StartNudTimer(m_nudHandler, m_nudDelay);
         }
-        m_nudTimer.Schedule();
     }
 }
 
@@ -500,49 +592,31 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                  m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
+    m_ndCache->CancelNudTimer(this);
     m_nsRetransmit = 0;
 }
 
@@ -20,6 +20,7 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "ns3/event-id.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
@@ -31,6 +32,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -44,12 +46,22 @@ class Icmpv6L4Protocol;
  * \ingroup ipv6
  *
  * \brief IPv6 Neighbor Discovery cache.
+ *
+ * The entries are hashed by IPv6 address.  The NUD timers of all the
+ * entries are kept in a single queue ordered by expiration time, served by
+ * one simulator event per cache, so that expiring timers costs O(expired)
+ * and refreshing a REACHABLE entry does not touch the scheduler.
  */
 class NdiscCache : public Object
 {
   public:
     class Entry;
 
+    /**
+     * \brief NUD timers container, ordered by expiration time
+     */
+    typedef std::multimap<Time, NdiscCache::Entry*> NudTimers;
+
     /**
      * \brief Get the type ID
      * \return type ID
@@ -172,7 +184,10 @@ class NdiscCache : public Object
          */
         Entry(NdiscCache* nd);
 
-        virtual ~Entry() = default;
+        /**
+         * \brief Destructor, stops the NUD timer.
+         */
+        virtual ~Entry();
 
         /**
          * \brief The Entry state enumeration.
@@ -412,6 +427,15 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        friend class NdiscCache;
+
+        /**
+         * \brief (Re)start the NUD timer.
+         * \param handler the function called when the timer expires
+         * \param delay the timer delay
+         */
+        void StartNudTimer(void (NdiscCache::Entry::*handler)(), Time delay);
+
         /**
          * \brief The IPv6 address.
          */
@@ -433,9 +457,32 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * \brief Timer (used for NUD).
+         * \brief Function called when the NUD timer expires.
          */
-        Timer m_nudTimer;
+        void (NdiscCache::Entry::*m_nudHandler)();
+
+        /**
+         * \brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * \brief Expiration time of the NUD timer.
+         *
+         * It may be later than the time the timer is queued at, in which
+         * case the timer is requeued when it is reached.
+         */
+        Time m_nudExpiry;
+
+        /**
+         * \brief Position of the NUD timer in the cache queue, if running.
+         */
+        NudTimers::iterator m_nudTimer;
+
+        /**
+         * \brief Whether the NUD timer is running.
+         */
+        bool m_nudRunning;
 
         /**
          * \brief Last time we see a reachability confirmation.
@@ -457,11 +504,11 @@ class NdiscCache : public Object
     /**
      * \brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * \brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     /**
      * \brief A list of Entry.
@@ -469,6 +516,39 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * \brief Queue the NUD timer of an entry.
+     * \param entry the entry
+     * \param expiry the expiration time
+     */
+    void QueueNudTimer(NdiscCache::Entry* entry, Time expiry);
+
+    /**
+     * \brief Remove the NUD timer of an entry from the queue.
+     * \param entry the entry
+     */
+    void CancelNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Make sure the NUD event is scheduled at the earliest queued timer.
+     */
+    void ScheduleNudEvent();
+
+    /**
+     * \brief Handle the expiration of the earliest NUD timers.
+     */
+    void HandleNudTimeout();
+
+    /**
+     * \brief NUD timers of the entries.
+     */
+    NudTimers m_nudTimers;
+
+    /**
+     * \brief Event serving the earliest NUD timer.
+     */
+    EventId m_nudEvent;
+
     /**
      * \brief The NetDevice.
      */
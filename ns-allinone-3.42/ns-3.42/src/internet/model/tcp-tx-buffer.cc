@@ -61,7 +61,8 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostFrontier(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -169,12 +170,15 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
 
     if (!m_sentList.empty())
     {
+        m_sentIndex.erase(m_sentList.front()->m_startSeq);
         m_sentList.front()->m_startSeq = seq;
+        IndexSentItem(m_sentList.begin());
     }
 
     // if you change the head with data already sent, something bad will happen
     NS_ASSERT(m_sentList.empty());
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostFrontier = seq;
 }
 
 bool
@@ -295,7 +299,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexSentItem(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -309,37 +313,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    auto indexed = m_sentIndex.find(seq);
+    if (indexed != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = indexed->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -401,7 +402,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -435,14 +436,26 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     Ptr<Packet> currentPacket = nullptr;
     TcpTxItem* currentItem = nullptr;
     TcpTxItem* outItem = nullptr;
-    auto it = list.begin();
+    PacketList::const_iterator it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    const bool isSentList = (&list == &m_sentList);
+
+    if (isSentList)
+    {
+        // Jump to the item containing seq, instead of walking from SND.UNA
+        auto found = FindSentItem(seq);
+        if (found != list.end())
+        {
+            it = found;
+            beginOfCurrentPacket = (*it)->m_startSeq;
+        }
+    }
 
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(!isSentList || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -471,7 +484,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto inserted = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(inserted);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -517,6 +535,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     NS_ASSERT(it != list.begin());
                     TcpTxItem* previous = *(--it);
 
+                    if (isSentList)
+                    {
+                        m_sentIndex.erase(currentItem->m_startSeq);
+                    }
                     list.erase(it);
 
                     MergeItems(previous, currentItem);
@@ -537,7 +559,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto inserted = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(inserted);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -566,6 +593,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                      // in the previous if
 
             MergeItems(currentItem, next);
+            if (isSentList)
+            {
+                m_sentIndex.erase(next->m_startSeq);
+            }
             list.erase(it);
 
             delete next;
@@ -583,6 +614,29 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     return nullptr; // Silence compiler warning about lack of return value
 }
 
+TcpTxBuffer::PacketList::const_iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    auto it = m_sentIndex.upper_bound(seq);
+    if (it == m_sentIndex.begin())
+    {
+        return m_sentList.end();
+    }
+    --it;
+    const TcpTxItem* item = *(it->second);
+    if (seq >= item->m_startSeq + item->m_packet->GetSize())
+    {
+        return m_sentList.end();
+    }
+    return it->second;
+}
+
+void
+TcpTxBuffer::IndexSentItem(PacketList::const_iterator it)
+{
+    m_sentIndex[(*it)->m_startSeq] = it;
+}
+
 void
 TcpTxBuffer::MergeItems(TcpTxItem* t1, TcpTxItem* t2) const
 {
@@ -650,16 +704,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // The only item that can end at ack is the one containing the byte before it
+    auto it = FindSentItem(ack - 1);
+    if (it == m_sentList.end())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *it;
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -707,6 +760,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            m_sentIndex.erase(item->m_startSeq);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -725,7 +779,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            m_sentIndex.erase(item->m_startSeq);
             item->m_startSeq += offset;
+            IndexSentItem(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -769,6 +825,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
     {
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
+    if (m_lostFrontier < m_firstByteSeq)
+    {
+        m_lostFrontier = m_firstByteSeq;
+    }
 
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
@@ -788,15 +848,25 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // Start from the item containing the beginning of the block: the items
+        // before it cannot be covered by the block
+        PacketList::const_iterator item_it = m_sentList.begin();
+        if ((*option_it).first > m_firstByteSeq)
+        {
+            item_it = FindSentItem((*option_it).first);
+            if (item_it == m_sentList.end())
+            {
+                continue;
+            }
+        }
+        SequenceNumber32 beginOfCurrentPacket = (*item_it)->m_startSeq;
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -877,7 +947,8 @@ TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
     uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
+    bool marking = false;
+    SequenceNumber32 markedUpTo;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -892,6 +963,12 @@ TcpTxBuffer::UpdateLostCount()
     for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
         TcpTxItem* item = *it;
+        if (marking && item->m_startSeq < m_lostFrontier)
+        {
+            // A previous update already marked what is left below
+            break;
+        }
+
         if (item->m_sacked)
         {
             sacked++;
@@ -899,13 +976,17 @@ TcpTxBuffer::UpdateLostCount()
 
         if (sacked >= m_dupAckThresh)
         {
+            if (!marking)
+            {
+                marking = true;
+                markedUpTo = item->m_startSeq + item->m_packet->GetSize();
+            }
             if (!item->m_sacked && !item->m_lost)
             {
                 item->m_lost = true;
                 m_lostOut += item->m_packet->GetSize();
             }
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
     }
 
     if (sacked >= m_dupAckThresh)
@@ -916,6 +997,10 @@ TcpTxBuffer::UpdateLostCount()
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
         }
+        if (marking && m_lostFrontier < markedUpTo)
+        {
+            m_lostFrontier = markedUpTo;
+        }
     }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
@@ -931,24 +1016,19 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    auto it = FindSentItem(seq);
+    if (it != m_sentList.end())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if ((*it)->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if ((*it)->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -980,6 +1060,11 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
 
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
+        if (m_lostOut == 0 && (!isRecovery || seqPerRule3.GetValue() != 0))
+        {
+            // No item can satisfy rule (1), and rule (3) is settled
+            break;
+        }
         item = *it;
 
         // Condition 1.a , 1.b , and 1.c
@@ -1213,6 +1298,7 @@ TcpTxBuffer::ResetRenoSack()
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostFrontier = m_firstByteSeq;
 }
 
 void
@@ -1242,6 +1328,8 @@ TcpTxBuffer::ResetSentList()
     m_retrans = 0;
     m_sackedOut = 0;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_sentIndex.clear();
+    m_lostFrontier = m_firstByteSeq;
 }
 
 void
@@ -1253,6 +1341,11 @@ TcpTxBuffer::ResetLastSegmentSent()
         TcpTxItem* item = m_sentList.back();
 
         m_sentList.pop_back();
+        m_sentIndex.erase(item->m_startSeq);
+        if (m_lostFrontier > item->m_startSeq)
+        {
+            m_lostFrontier = item->m_startSeq;
+        }
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
         {
@@ -1305,6 +1398,9 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         (*it)->m_retrans = false;
     }
 
+    // Every item not sacked is now lost
+    m_lostFrontier = m_firstByteSeq + m_sentSize;
+
     NS_LOG_INFO("Set sent list lost, status: " << *this);
     NS_ASSERT_MSG(m_sentSize >= m_sackedOut + m_lostOut, *this);
     ConsistencyCheck();
@@ -1447,6 +1543,8 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  " Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
 }
 
 std::ostream&
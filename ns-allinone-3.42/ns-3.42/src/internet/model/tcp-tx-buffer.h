@@ -28,6 +28,9 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+
 namespace ns3
 {
 class Packet;
@@ -74,6 +77,12 @@ class Packet;
  * documentation) and maintaining the scoreboard is a matter of travelling the
  * list and set the SACK flag on the corresponding segment sent.
  *
+ * The items of the SentList are also indexed by their starting sequence
+ * number, so that retransmissions, incoming SACK blocks and the queries on a
+ * single sequence go straight to the item that contains it, instead of
+ * walking the list from SND.UNA. With large windows the list holds thousands
+ * of segments, and a walk per ACK dominates the cost of the simulation.
+ *
  * Item properties
  * ---------------
  *
@@ -428,9 +437,9 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
-     *
+     * and updates the lost count. The walk goes down from the highest sacked
+     * item, and stops at the point below which every item not sacked has
+     * already been marked as lost by a previous call (m_lostFrontier).
      */
     void UpdateLostCount();
 
@@ -564,7 +573,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * \brief Merge two TcpTxItem
@@ -590,6 +599,19 @@ class TcpTxBuffer : public Object
      */
     void SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const;
 
+    /**
+     * \brief Find the item of the SentList containing a sequence number
+     * \param seq the sequence number
+     * \return an iterator to the item, or m_sentList.end () if no sent item contains seq
+     */
+    PacketList::const_iterator FindSentItem(const SequenceNumber32& seq) const;
+
+    /**
+     * \brief Add (or refresh) the index entry of an item of the SentList
+     * \param it iterator to the item, whose starting sequence is already set
+     */
+    void IndexSentItem(PacketList::const_iterator it);
+
     /**
      * \brief Check if the values of sacked, lost, retrans, are in sync
      * with the sent list.
@@ -613,6 +635,11 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    /// Items of the SentList, indexed by their starting sequence number
+    std::map<SequenceNumber32, PacketList::const_iterator> m_sentIndex;
+    /// The items of the SentList starting below this sequence are either sacked or lost
+    SequenceNumber32 m_lostFrontier;
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
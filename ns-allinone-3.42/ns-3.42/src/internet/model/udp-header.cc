@@ -158,7 +158,7 @@ UdpHeader::Print(std::ostream& os) const
 uint32_t
 UdpHeader::GetSerializedSize() const
 {
-    return 8;
+    return SERIALIZED_SIZE;
 }
 
 void
@@ -37,7 +37,7 @@ namespace ns3
  * (port numbers, payload size, checksum) as well as methods for serialization
  * to and deserialization from a byte buffer.
  */
-class UdpHeader : public Header
+class UdpHeader final : public Header
 {
   public:
     /**
@@ -105,6 +105,10 @@ class UdpHeader : public Header
      * \return the object TypeId
      */
     static TypeId GetTypeId();
+
+    /// The serialized size of the header, in bytes (see HasFixedSerializedSize)
+    static constexpr uint32_t SERIALIZED_SIZE = 8;
+
     TypeId GetInstanceTypeId() const override;
     void Print(std::ostream& os) const override;
     uint32_t GetSerializedSize() const override;
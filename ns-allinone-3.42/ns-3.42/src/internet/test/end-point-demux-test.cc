@@ -0,0 +1,193 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Test the precedence of the matches of the IPv4 endpoint demux, and
+ * that its index follows the changes of the endpoints.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("IPv4 endpoint demux lookups")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    interface->AddAddress(Ipv4InterfaceAddress(Ipv4Address("10.1.1.1"), Ipv4Mask("/24")));
+
+    Ipv4Address local("10.1.1.1");
+    Ipv4Address peer("10.1.2.2");
+    Ipv4EndPointDemux demux;
+    auto lookup = [&](Ipv4Address daddr, Ipv4Address saddr, uint16_t sport) {
+        auto endPoints = demux.Lookup(daddr, 80, saddr, sport, interface);
+        return endPoints.empty() ? nullptr : endPoints.front();
+    };
+
+    Ipv4EndPoint* any = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(any, nullptr, "Allocation failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, 80), nullptr, "Duplicated endpoint allocated");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1000), any, "Wildcard endpoint not found");
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.1.1.255"), peer, 1000),
+                          any,
+                          "Wildcard endpoint not found for a broadcast");
+    NS_TEST_EXPECT_MSG_EQ(demux.Lookup(local, 81, peer, 1000, interface).empty(),
+                          true,
+                          "Endpoint found for another port");
+
+    // local address and port
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, local, 80);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1000), listener, "Listening endpoint not found");
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.1.1.255"), peer, 1000),
+                          any,
+                          "Listening endpoint found for a broadcast");
+
+    // all but local address
+    Ipv4EndPoint* connected = demux.Allocate(nullptr, Ipv4Address::GetAny(), 80, peer, 1000);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1000), connected, "Connected endpoint not found");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1001), listener, "Listening endpoint not found");
+
+    // full four-tuple, the local address being set after the allocation as TCP does
+    Ipv4EndPoint* accepted = demux.Allocate(nullptr, Ipv4Address::GetAny(), 80, peer, 1001);
+    NS_TEST_ASSERT_MSG_NE(accepted, nullptr, "Allocation failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, Ipv4Address::GetAny(), 80, peer, 1001),
+                          nullptr,
+                          "Duplicated four-tuple allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, Ipv4Address::GetAny(), 0),
+                          nullptr,
+                          "Duplicated listening four-tuple allocated");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1001), accepted, "Accepted endpoint not found");
+    accepted->SetLocalAddress(local);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1001), accepted, "Accepted endpoint not found");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1000), connected, "Connected endpoint not found");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1001),
+                          accepted,
+                          "Accepted endpoint not found by the simple lookup");
+
+    accepted->SetRxEnabled(false);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1001), listener, "Disabled endpoint found");
+    accepted->SetRxEnabled(true);
+
+    // subnet-directed wildcard
+    Ipv4EndPoint* subnet = demux.Allocate(nullptr, Ipv4Address("10.1.1.0"), 80);
+    demux.DeAllocate(any);
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.1.1.255"), peer, 1002),
+                          subnet,
+                          "Subnet endpoint not found for a broadcast");
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.1.3.255"), peer, 1002),
+                          nullptr,
+                          "Subnet endpoint found for another subnet");
+
+    demux.DeAllocate(accepted);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, peer, 1001), listener, "Deallocated endpoint found");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetAllEndPoints().size(), 3, "Unexpected number of endpoints");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), true, "Local port not found");
+    demux.DeAllocate(listener);
+    demux.DeAllocate(connected);
+    demux.DeAllocate(subnet);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), false, "Local port still in use");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Test the precedence of the matches of the IPv6 endpoint demux, and
+ * that its index follows the changes of the endpoints.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("IPv6 endpoint demux lookups")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ptr<Ipv6Interface> interface = CreateObject<Ipv6Interface>();
+
+    Ipv6Address local("2001:1::1");
+    Ipv6Address peer("2001:2::2");
+    Ipv6EndPointDemux demux;
+    auto lookup = [&](uint16_t sport) {
+        auto endPoints = demux.Lookup(local, 80, peer, sport, interface);
+        return endPoints.empty() ? nullptr : endPoints.front();
+    };
+
+    Ipv6EndPoint* any = demux.Allocate(nullptr, 80);
+    NS_TEST_EXPECT_MSG_EQ(lookup(1000), any, "Wildcard endpoint not found");
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, local, 80);
+    NS_TEST_EXPECT_MSG_EQ(lookup(1000), listener, "Listening endpoint not found");
+    Ipv6EndPoint* connected = demux.Allocate(nullptr, Ipv6Address::GetAny(), 80, peer, 1000);
+    NS_TEST_EXPECT_MSG_EQ(lookup(1000), connected, "Connected endpoint not found");
+
+    Ipv6EndPoint* accepted = demux.Allocate(nullptr, local, 81, Ipv6Address::GetAny(), 0);
+    accepted->SetLocalPort(80);
+    accepted->SetPeer(peer, 1001);
+    NS_TEST_EXPECT_MSG_EQ(lookup(1001), accepted, "Accepted endpoint not found");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(81), false, "Old local port still in use");
+
+    demux.DeAllocate(accepted);
+    demux.DeAllocate(connected);
+    NS_TEST_EXPECT_MSG_EQ(lookup(1000), listener, "Deallocated endpoint found");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetEndPoints().size(), 2, "Unexpected number of endpoints");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Endpoint demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase, TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -24,6 +24,7 @@
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-routing-helper.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
@@ -36,6 +37,7 @@
 #include "ns3/traffic-control-layer.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
 
 #include <limits>
 #include <string>
@@ -224,6 +226,162 @@ Ipv4ForwardingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 Forwarding Cache Test
+ *
+ * Checks that the routes cached by the forwarding node follow the interface
+ * and static routing table changes.
+ */
+class Ipv4ForwardingCacheTest : public TestCase
+{
+    uint32_t m_received; //!< Number of received packets
+
+    /**
+     * \brief Send a packet.
+     * \param socket The sending socket.
+     */
+    void DoSendData(Ptr<Socket> socket);
+    /**
+     * \brief Send a packet and run the simulation.
+     * \param socket The sending socket.
+     */
+    void SendData(Ptr<Socket> socket);
+
+  public:
+    void DoRun() override;
+    Ipv4ForwardingCacheTest();
+
+    /**
+     * \brief Receive data.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+};
+
+Ipv4ForwardingCacheTest::Ipv4ForwardingCacheTest()
+    : TestCase("IPv4 forwarding cache"),
+      m_received(0)
+{
+}
+
+void
+Ipv4ForwardingCacheTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_received++;
+    }
+}
+
+void
+Ipv4ForwardingCacheTest::DoSendData(Ptr<Socket> socket)
+{
+    Address realTo = InetSocketAddress(Ipv4Address("10.0.0.2"), 1234);
+    NS_TEST_EXPECT_MSG_EQ(socket->SendTo(Create<Packet>(123), 0, realTo), 123, "100");
+}
+
+void
+Ipv4ForwardingCacheTest::SendData(Ptr<Socket> socket)
+{
+    m_received = 0;
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(),
+                                   Seconds(0),
+                                   &Ipv4ForwardingCacheTest::DoSendData,
+                                   this,
+                                   socket);
+    Simulator::Run();
+}
+
+void
+Ipv4ForwardingCacheTest::DoRun()
+{
+    Ptr<Node> rxNode = CreateObject<Node>();
+    Ptr<Node> fwNode = CreateObject<Node>();
+    Ptr<Node> txNode = CreateObject<Node>();
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    internet.Install(rxNode);
+    internet.Install(fwNode);
+    internet.Install(txNode);
+
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    Ptr<SimpleChannel> channel2 = CreateObject<SimpleChannel>();
+
+    auto addInterface = [](Ptr<Node> node, Ptr<SimpleChannel> channel, const char* address) {
+        Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+        dev->SetAddress(Mac48Address::ConvertFrom(Mac48Address::Allocate()));
+        dev->SetChannel(channel);
+        node->AddDevice(dev);
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        uint32_t netdev_idx = ipv4->AddInterface(dev);
+        ipv4->AddAddress(netdev_idx,
+                         Ipv4InterfaceAddress(Ipv4Address(address), Ipv4Mask(0xffff0000U)));
+        ipv4->SetUp(netdev_idx);
+        return netdev_idx;
+    };
+
+    addInterface(rxNode, channel1, "10.0.0.2");
+    uint32_t fwIf1 = addInterface(fwNode, channel1, "10.0.0.1");
+    addInterface(fwNode, channel2, "10.1.0.1");
+    uint32_t txIf = addInterface(txNode, channel2, "10.1.0.2");
+
+    Ptr<Ipv4StaticRouting> txRouting = Ipv4RoutingHelper::GetRouting<Ipv4StaticRouting>(
+        txNode->GetObject<Ipv4>()->GetRoutingProtocol());
+    txRouting->SetDefaultRoute(Ipv4Address("10.1.0.1"), txIf);
+
+    Ptr<Ipv4L3Protocol> fwIpv4 = fwNode->GetObject<Ipv4L3Protocol>();
+    fwIpv4->SetAttribute("ForwardingCacheSize", UintegerValue(16));
+    Ptr<Ipv4StaticRouting> fwRouting =
+        Ipv4RoutingHelper::GetRouting<Ipv4StaticRouting>(fwIpv4->GetRoutingProtocol());
+
+    Ptr<Socket> rxSocket = rxNode->GetObject<UdpSocketFactory>()->CreateSocket();
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(InetSocketAddress(Ipv4Address("10.0.0.2"), 1234)),
+                          0,
+                          "trivial");
+    rxSocket->SetRecvCallback(MakeCallback(&Ipv4ForwardingCacheTest::ReceivePkt, this));
+
+    Ptr<Socket> txSocket = txNode->GetObject<UdpSocketFactory>()->CreateSocket();
+
+    // The first packet fills the cache, the second one is forwarded from it
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "Packet not forwarded while filling the cache");
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "Packet not forwarded from the cache");
+
+    // The cached route must not outlive its output interface
+    fwIpv4->SetDown(fwIf1);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 0, "Packet forwarded on an interface that is down");
+    fwIpv4->SetUp(fwIf1);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "Packet not forwarded once the interface is up");
+
+    // A more specific route through an unreachable gateway takes over the cached one
+    fwRouting->AddHostRouteTo(Ipv4Address("10.0.0.2"), Ipv4Address("10.0.0.99"), fwIf1);
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 0, "Packet forwarded with a stale cached route");
+    for (uint32_t i = 0; i < fwRouting->GetNRoutes(); i++)
+    {
+        if (fwRouting->GetRoute(i).GetGateway() == Ipv4Address("10.0.0.99"))
+        {
+            fwRouting->RemoveRoute(i);
+            break;
+        }
+    }
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "Packet not forwarded once the host route is removed");
+
+    // Disabling forwarding on the input interface is honored by cached routes
+    fwIpv4->SetAttribute("IpForward", BooleanValue(false));
+    SendData(txSocket);
+    NS_TEST_EXPECT_MSG_EQ(m_received, 0, "Packet forwarded with IPv4 forwarding off");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -241,6 +399,7 @@ Ipv4ForwardingTestSuite::Ipv4ForwardingTestSuite()
     : TestSuite("ipv4-forwarding", Type::UNIT)
 {
     AddTestCase(new Ipv4ForwardingTest, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4ForwardingCacheTest, TestCase::Duration::QUICK);
 }
 
 static Ipv4ForwardingTestSuite
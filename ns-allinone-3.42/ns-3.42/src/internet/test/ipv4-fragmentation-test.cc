@@ -140,6 +140,7 @@ class Ipv4FragmentationTest : public TestCase
     uint32_t m_size;            //!< packet size.
     uint8_t m_icmpType;         //!< ICMP type.
     bool m_broadcast;           //!< broadcast packets
+    uint32_t m_bufferFullDrops; //!< Packets dropped because the reassembly buffer was full.
 
   public:
     void DoRun() override;
@@ -162,6 +163,19 @@ class Ipv4FragmentationTest : public TestCase
      * \param socket The receiving socket.
      */
     void HandleReadServer(Ptr<Socket> socket);
+    /**
+     * \brief Handle the packets dropped by the server.
+     * \param ipHeader The IPv4 header.
+     * \param packet The packet.
+     * \param reason The reason of the drop.
+     * \param ipv4 The IPv4 stack.
+     * \param interface The interface.
+     */
+    void HandleDropServer(const Ipv4Header& ipHeader,
+                          Ptr<const Packet> packet,
+                          Ipv4L3Protocol::DropReason reason,
+                          Ptr<Ipv4> ipv4,
+                          uint32_t interface);
 
     // client part
 
@@ -214,6 +228,7 @@ Ipv4FragmentationTest::Ipv4FragmentationTest(bool broadcast)
     m_size = 0;
     m_icmpType = 0;
     m_broadcast = broadcast;
+    m_bufferFullDrops = 0;
 }
 
 Ipv4FragmentationTest::~Ipv4FragmentationTest()
@@ -260,6 +275,19 @@ Ipv4FragmentationTest::HandleReadServer(Ptr<Socket> socket)
     }
 }
 
+void
+Ipv4FragmentationTest::HandleDropServer(const Ipv4Header& ipHeader,
+                                        Ptr<const Packet> packet,
+                                        Ipv4L3Protocol::DropReason reason,
+                                        Ptr<Ipv4> ipv4,
+                                        uint32_t interface)
+{
+    if (reason == Ipv4L3Protocol::DROP_FRAGMENT_BUFFER_FULL)
+    {
+        m_bufferFullDrops++;
+    }
+}
+
 void
 Ipv4FragmentationTest::StartClient(Ptr<Node> ClientNode)
 {
@@ -572,6 +600,38 @@ Ipv4FragmentationTest::DoRun()
         NS_TEST_EXPECT_MSG_EQ(end, m_receivedPacketServer->GetSize(), "trivial");
     }
 
+    // Fifth test: normal channel, no errors, no delays, limited reassembly buffer.
+    // The packets whose fragments do not fit in the buffer are dropped, the others
+    // are still reassembled.
+    Ptr<Ipv4L3Protocol> serverIpv4 = serverNode->GetObject<Ipv4L3Protocol>();
+    serverIpv4->SetAttribute("FragmentBufferSize", UintegerValue(4000));
+    serverIpv4->TraceConnectWithoutContext(
+        "Drop",
+        MakeCallback(&Ipv4FragmentationTest::HandleDropServer, this));
+    uint32_t limitedPacketSizes[3] = {2000, 5000, 2000};
+    for (int i = 0; i < 3; i++)
+    {
+        uint32_t packetSize = limitedPacketSizes[i];
+
+        SetFill(fillData, 78, packetSize);
+
+        m_receivedPacketServer = Create<Packet>();
+        m_bufferFullDrops = 0;
+        Simulator::ScheduleWithContext(m_socketClient->GetNode()->GetId(),
+                                       Seconds(0),
+                                       &Ipv4FragmentationTest::SendClient,
+                                       this);
+        Simulator::Run();
+
+        bool fits = packetSize < 4000;
+        NS_TEST_EXPECT_MSG_EQ(m_receivedPacketServer->GetSize(),
+                              (fits ? packetSize : 0),
+                              "Packet size not correct with a limited reassembly buffer");
+        NS_TEST_EXPECT_MSG_EQ(m_bufferFullDrops,
+                              (fits ? 0 : 1),
+                              "Packet not dropped when the reassembly buffer is full");
+    }
+
     Simulator::Destroy();
 }
 
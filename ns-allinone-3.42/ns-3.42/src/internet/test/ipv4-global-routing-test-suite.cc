@@ -16,6 +16,7 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/global-value.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -23,6 +24,7 @@
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-packet-info-tag.h"
+#include "ns3/ipv4-route-prefix-index.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
@@ -41,6 +43,9 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <sstream>
+#include <string>
 #include <vector>
 
 using namespace ns3;
@@ -1311,6 +1316,247 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that Ipv4RoutePrefixIndex returns the same routes, in the same
+ * order, as a linear scan of the routing table.
+ */
+class Ipv4RoutePrefixIndexTestCase : public TestCase
+{
+  public:
+    Ipv4RoutePrefixIndexTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4RoutePrefixIndexTestCase::Ipv4RoutePrefixIndexTestCase()
+    : TestCase("Prefix index of the IPv4 routes")
+{
+}
+
+void
+Ipv4RoutePrefixIndexTestCase::DoRun()
+{
+    std::vector<Ipv4RoutingTableEntry> table;
+    auto addRoute = [&table](const char* network, const char* mask, uint32_t interface) {
+        table.push_back(Ipv4RoutingTableEntry::CreateNetworkRouteTo(Ipv4Address(network),
+                                                                    Ipv4Mask(mask),
+                                                                    interface));
+    };
+    addRoute("10.1.2.0", "255.255.255.0", 1);
+    addRoute("10.1.0.0", "255.255.0.0", 2);
+    addRoute("10.1.2.0", "255.255.255.0", 3); // equal-cost route
+    addRoute("0.0.0.0", "0.0.0.0", 4);
+    addRoute("10.1.2.9", "255.255.255.255", 5);
+    addRoute("10.0.0.3", "255.0.0.255", 6); // non-contiguous mask
+    addRoute("192.168.0.0", "255.255.128.0", 7);
+    table.push_back(Ipv4RoutingTableEntry::CreateHostRouteTo(Ipv4Address("10.1.2.9"), 8));
+
+    Ipv4RoutePrefixIndex index;
+    for (auto& route : table)
+    {
+        index.Add(&route);
+    }
+    NS_TEST_ASSERT_MSG_EQ(index.GetNRoutes(), table.size(), "Unexpected number of routes");
+
+    const char* destinations[] = {"10.1.2.9",
+                                  "10.1.2.1",
+                                  "10.1.3.3",
+                                  "10.200.1.3",
+                                  "11.0.0.1",
+                                  "192.168.127.1",
+                                  "192.168.128.1",
+                                  "255.255.255.255"};
+    std::vector<Ipv4RoutingTableEntry*> routes;
+    for (const auto destination : destinations)
+    {
+        Ipv4Address dest(destination);
+        std::vector<Ipv4RoutingTableEntry*> expected;
+        for (auto& route : table)
+        {
+            if (route.GetDestNetworkMask().IsMatch(dest, route.GetDestNetwork()))
+            {
+                expected.push_back(&route);
+            }
+        }
+        index.Lookup(dest, routes);
+        NS_TEST_EXPECT_MSG_EQ((routes == expected),
+                              true,
+                              "Unexpected routes to " << destination);
+    }
+
+    index.Lookup(Ipv4Address("10.1.2.9"), routes);
+    NS_TEST_ASSERT_MSG_EQ(routes.size(), 6, "Unexpected number of routes to 10.1.2.9");
+    NS_TEST_EXPECT_MSG_EQ(routes.front()->GetInterface(), 1, "Unexpected first route");
+    NS_TEST_EXPECT_MSG_EQ(routes.back()->GetInterface(), 8, "Unexpected last route");
+
+    index.Clear();
+    index.Lookup(Ipv4Address("10.1.2.9"), routes);
+    NS_TEST_EXPECT_MSG_EQ(routes.empty(), true, "Routes found after clearing the index");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Test that the multi-threaded and the incremental SPF calculations
+ * produce the same routing tables as the sequential, full calculation.
+ */
+class Ipv4GlobalRoutingSpfModesTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingSpfModesTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Compute the routes of a topology, and recompute them after some changes.
+     *
+     * \param threads the number of threads of the SPF calculation
+     * \param incremental whether the SPF calculation is incremental
+     * \return the routing tables after each computation
+     */
+    std::vector<std::string> RunScenario(uint32_t threads, bool incremental);
+
+    /**
+     * Print the global routes of the nodes, in a canonical order.
+     *
+     * \param nodes the nodes
+     * \return the routes
+     */
+    static std::string PrintRoutes(const NodeContainer& nodes);
+};
+
+Ipv4GlobalRoutingSpfModesTestCase::Ipv4GlobalRoutingSpfModesTestCase()
+    : TestCase("Multi-threaded and incremental SPF calculations")
+{
+}
+
+std::string
+Ipv4GlobalRoutingSpfModesTestCase::PrintRoutes(const NodeContainer& nodes)
+{
+    std::ostringstream os;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> routing =
+            nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4GlobalRouting>();
+        std::vector<std::string> routes;
+        for (uint32_t j = 0; j < routing->GetNRoutes(); j++)
+        {
+            Ipv4RoutingTableEntry* route = routing->GetRoute(j);
+            std::ostringstream entry;
+            entry << route->GetDestNetwork() << "/" << route->GetDestNetworkMask() << " gw "
+                  << route->GetGateway() << " if " << route->GetInterface();
+            routes.push_back(entry.str());
+        }
+        // the incremental calculation may list equal-cost routes in another order
+        std::sort(routes.begin(), routes.end());
+        os << "node " << i << "\n";
+        for (const auto& route : routes)
+        {
+            os << "  " << route << "\n";
+        }
+    }
+    return os.str();
+}
+
+std::vector<std::string>
+Ipv4GlobalRoutingSpfModesTestCase::RunScenario(uint32_t threads, bool incremental)
+{
+    GlobalValue::Bind("GlobalRoutingSpfThreads", UintegerValue(threads));
+    GlobalValue::Bind("GlobalRoutingIncrementalSpf", BooleanValue(incremental));
+
+    // A ring of 10 routers with a costly chord between n0 and n5, and a LAN
+    // between n7, n8 and n10
+    const uint32_t nRing = 10;
+    NodeContainer nodes;
+    nodes.Create(nRing + 1);
+
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    Ipv4AddressHelper ipv4;
+    devHelper.SetNetDevicePointToPointMode(true);
+    std::vector<NetDeviceContainer> ring;
+    for (uint32_t i = 0; i < nRing; i++)
+    {
+        ring.push_back(devHelper.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % nRing))));
+        std::ostringstream network;
+        network << "10.1." << i + 1 << ".0";
+        ipv4.SetBase(network.str().c_str(), "255.255.255.0");
+        ipv4.Assign(ring.back());
+    }
+    NetDeviceContainer chord = devHelper.Install(NodeContainer(nodes.Get(0), nodes.Get(5)));
+    ipv4.SetBase("10.2.1.0", "255.255.255.0");
+    ipv4.Assign(chord);
+    devHelper.SetNetDevicePointToPointMode(false);
+    NetDeviceContainer lan =
+        devHelper.Install(NodeContainer(nodes.Get(7), nodes.Get(8), nodes.Get(nRing)));
+    ipv4.SetBase("10.3.1.0", "255.255.255.0");
+    ipv4.Assign(lan);
+
+    auto interface = [](Ptr<NetDevice> device) {
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        return std::make_pair(ipv4, ipv4->GetInterfaceForDevice(device));
+    };
+    for (uint32_t i = 0; i < chord.GetN(); i++)
+    {
+        auto [ip, ifIndex] = interface(chord.Get(i));
+        ip->SetMetric(ifIndex, 20);
+    }
+
+    std::vector<std::string> tables;
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    tables.push_back(PrintRoutes(nodes));
+
+    // a link which is on no shortest path goes down, and up again
+    auto [ip0, chordIf0] = interface(chord.Get(0));
+    ip0->SetDown(chordIf0);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    tables.push_back(PrintRoutes(nodes));
+    ip0->SetUp(chordIf0);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    tables.push_back(PrintRoutes(nodes));
+
+    // a link of the ring goes down, making the chord useful
+    auto [ip2, ringIf2] = interface(ring[2].Get(0));
+    ip2->SetDown(ringIf2);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    tables.push_back(PrintRoutes(nodes));
+
+    Simulator::Destroy();
+    return tables;
+}
+
+void
+Ipv4GlobalRoutingSpfModesTestCase::DoRun()
+{
+    const auto reference = RunScenario(1, false);
+    const auto threaded = RunScenario(3, false);
+    const auto incremental = RunScenario(1, true);
+    const auto both = RunScenario(3, true);
+    GlobalValue::Bind("GlobalRoutingSpfThreads", UintegerValue(1));
+    GlobalValue::Bind("GlobalRoutingIncrementalSpf", BooleanValue(false));
+
+    NS_TEST_ASSERT_MSG_EQ(reference.size(), 4, "Unexpected number of computations");
+    NS_TEST_EXPECT_MSG_NE(reference[0], reference[3], "The ring link did not change the routes");
+    for (std::size_t i = 0; i < reference.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(threaded[i], reference[i], "Computation " << i << " with threads");
+        NS_TEST_EXPECT_MSG_EQ(incremental[i],
+                              reference[i],
+                              "Computation " << i << " with the incremental SPF");
+        NS_TEST_EXPECT_MSG_EQ(both[i],
+                              reference[i],
+                              "Computation " << i << " with threads and the incremental SPF");
+    }
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1333,6 +1579,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4RoutePrefixIndexTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingSpfModesTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
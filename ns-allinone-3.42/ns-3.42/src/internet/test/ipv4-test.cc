@@ -117,6 +117,33 @@ Ipv4L3ProtocolTestCase::DoRun()
     num = interface->GetNAddresses();
     NS_TEST_ASSERT_MSG_EQ(num, 1, "Should find 1 addresses??");
 
+    /* Test Ipv4L3Protocol::GetNodeWithAddress() */
+    Ptr<Node> otherNode = CreateObject<Node>();
+    Ptr<Ipv4L3Protocol> otherIpv4 = CreateObject<Ipv4L3Protocol>();
+    otherNode->AggregateObject(otherIpv4); // creates the loopback interface
+    otherIpv4->AddAddress(0, Ipv4InterfaceAddress("10.1.1.1", "255.255.255.0"));
+    otherIpv4->AddAddress(0, Ipv4InterfaceAddress("10.1.1.2", "255.255.255.0"));
+    NS_TEST_ASSERT_MSG_EQ(Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address("10.1.1.1")),
+                          otherNode,
+                          "Address not indexed??");
+    NS_TEST_ASSERT_MSG_EQ(Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address("10.1.1.3")),
+                          nullptr,
+                          "Found a non-existent address??");
+    NS_TEST_ASSERT_MSG_EQ(Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address::GetLoopback()),
+                          nullptr,
+                          "Loopback address indexed??");
+    otherIpv4->RemoveAddress(0, Ipv4Address("10.1.1.1"));
+    NS_TEST_ASSERT_MSG_EQ(Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address("10.1.1.1")),
+                          nullptr,
+                          "Removed address still indexed??");
+    NS_TEST_ASSERT_MSG_EQ(Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address("10.1.1.2")),
+                          otherNode,
+                          "Address not indexed??");
+    otherNode->Dispose();
+    NS_TEST_ASSERT_MSG_EQ(Ipv4L3Protocol::GetNodeWithAddress(Ipv4Address("10.1.1.2")),
+                          nullptr,
+                          "Address of a disposed stack still indexed??");
+
     Simulator::Destroy();
 }
 
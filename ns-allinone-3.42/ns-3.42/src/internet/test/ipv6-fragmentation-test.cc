@@ -35,6 +35,8 @@
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/ipv4-raw-socket-factory.h"
 #include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv6-extension-demux.h"
+#include "ns3/ipv6-extension.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ipv6-raw-socket-factory.h"
@@ -148,6 +150,7 @@ class Ipv6FragmentationTest : public TestCase
     uint32_t m_size;            //!< packet size.
     uint8_t m_icmpType;         //!< ICMP type.
     uint8_t m_icmpCode;         //!< ICMP code.
+    uint32_t m_bufferFullDrops; //!< Packets dropped because the reassembly buffer was full.
 
   public:
     void DoRun() override;
@@ -226,6 +229,21 @@ class Ipv6FragmentationTest : public TestCase
      * \param interface the IP-level interface index.
      */
     void HandleClientTx(Ptr<const Packet> packet, Ptr<Ipv6> ipv6, uint32_t interface);
+
+    /**
+     * \brief Handle the packets dropped by the server.
+     *
+     * \param ipHeader the IPv6 header.
+     * \param packet the packet.
+     * \param reason the reason of the drop.
+     * \param ipv6 the Ipv6 protocol.
+     * \param interface the IP-level interface index.
+     */
+    void HandleServerDrop(const Ipv6Header& ipHeader,
+                          Ptr<const Packet> packet,
+                          Ipv6L3Protocol::DropReason reason,
+                          Ptr<Ipv6> ipv6,
+                          uint32_t interface);
 };
 
 Ipv6FragmentationTest::Ipv6FragmentationTest()
@@ -237,6 +255,7 @@ Ipv6FragmentationTest::Ipv6FragmentationTest()
     m_size = 0;
     m_icmpType = 0;
     m_icmpCode = 0;
+    m_bufferFullDrops = 0;
 }
 
 Ipv6FragmentationTest::~Ipv6FragmentationTest()
@@ -386,6 +405,19 @@ Ipv6FragmentationTest::HandleClientTx(Ptr<const Packet> packet, Ptr<Ipv6> ipv6,
         "Transmitted packet size > MTU: packetSizes: " << packet->GetSize());
 }
 
+void
+Ipv6FragmentationTest::HandleServerDrop(const Ipv6Header& ipHeader,
+                                        Ptr<const Packet> packet,
+                                        Ipv6L3Protocol::DropReason reason,
+                                        Ptr<Ipv6> ipv6,
+                                        uint32_t interface)
+{
+    if (reason == Ipv6L3Protocol::DROP_FRAGMENT_BUFFER_FULL)
+    {
+        m_bufferFullDrops++;
+    }
+}
+
 void
 Ipv6FragmentationTest::DoRun()
 {
@@ -611,6 +643,40 @@ Ipv6FragmentationTest::DoRun()
         NS_TEST_EXPECT_MSG_EQ(end, m_receivedPacketServer->GetSize(), "trivial");
     }
 
+    // Fifth test: normal channel, no errors, no delays, limited reassembly buffer.
+    // The packets whose fragments do not fit in the buffer are dropped, the others
+    // are still reassembled.
+    Ptr<Ipv6Extension> fragmentExtension =
+        serverNode->GetObject<Ipv6ExtensionDemux>()->GetExtension(
+            Ipv6ExtensionFragment::EXT_NUMBER);
+    fragmentExtension->SetAttribute("FragmentBufferSize", UintegerValue(4000));
+    serverNode->GetObject<Ipv6L3Protocol>()->TraceConnectWithoutContext(
+        "Drop",
+        MakeCallback(&Ipv6FragmentationTest::HandleServerDrop, this));
+    uint32_t limitedPacketSizes[3] = {2000, 5000, 2000};
+    for (int i = 0; i < 3; i++)
+    {
+        uint32_t packetSize = limitedPacketSizes[i];
+
+        SetFill(fillData, 78, packetSize);
+
+        m_receivedPacketServer = Create<Packet>();
+        m_bufferFullDrops = 0;
+        Simulator::ScheduleWithContext(m_socketClient->GetNode()->GetId(),
+                                       Seconds(0),
+                                       &Ipv6FragmentationTest::SendClient,
+                                       this);
+        Simulator::Run();
+
+        bool fits = packetSize < 4000;
+        NS_TEST_EXPECT_MSG_EQ(m_receivedPacketServer->GetSize(),
+                              (fits ? packetSize : 0),
+                              "Packet size not correct with a limited reassembly buffer");
+        NS_TEST_EXPECT_MSG_EQ(m_bufferFullDrops,
+                              (fits ? 0 : 1),
+                              "Packet not dropped when the reassembly buffer is full");
+    }
+
     Simulator::Destroy();
 }
 
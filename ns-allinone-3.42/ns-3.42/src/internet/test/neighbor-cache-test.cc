@@ -17,6 +17,7 @@
  * Author: Zhiheng Dong <dzh2077@gmail.com>
  */
 
+#include "ns3/arp-cache.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -1221,6 +1222,96 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief ARP wait reply retransmission Test
+ *
+ * Three entries wait for a reply; one is resolved after the first
+ * retransmission, the other two are retried until they are marked dead.
+ */
+class ArpWaitReplyTest : public TestCase
+{
+    /**
+     * \brief ARP request callback.
+     * \param cache The ARP cache.
+     * \param to The address being resolved.
+     */
+    void ArpRequest(Ptr<const ArpCache> cache, Ipv4Address to);
+
+    /**
+     * \brief Drop trace sink.
+     * \param packet The dropped packet.
+     */
+    void Drop(Ptr<const Packet> packet);
+
+    std::map<Ipv4Address, uint32_t> m_requests; //!< Retransmitted requests per address
+    uint32_t m_drops{0};                        //!< Dropped packets
+
+  public:
+    void DoRun() override;
+    ArpWaitReplyTest();
+};
+
+ArpWaitReplyTest::ArpWaitReplyTest()
+    : TestCase("ARP wait reply retransmissions")
+{
+}
+
+void
+ArpWaitReplyTest::ArpRequest(Ptr<const ArpCache> cache, Ipv4Address to)
+{
+    m_requests[to]++;
+}
+
+void
+ArpWaitReplyTest::Drop(Ptr<const Packet> packet)
+{
+    m_drops++;
+}
+
+void
+ArpWaitReplyTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    node->AddDevice(device);
+
+    Ptr<ArpCache> cache = CreateObject<ArpCache>();
+    cache->SetDevice(device, nullptr);
+    cache->SetArpRequestCallback(MakeCallback(&ArpWaitReplyTest::ArpRequest, this));
+    cache->TraceConnectWithoutContext("Drop", MakeCallback(&ArpWaitReplyTest::Drop, this));
+
+    const Ipv4Address a("10.0.0.1");
+    const Ipv4Address b("10.0.0.2");
+    const Ipv4Address c("10.0.0.3");
+    for (const auto& address : {a, b, c})
+    {
+        cache->Add(address)->MarkWaitReply(
+            ArpCache::Ipv4PayloadHeaderPair(Create<Packet>(), Ipv4Header()));
+    }
+    ArpCache::Entry* entryB = cache->Lookup(b);
+    Simulator::Schedule(Seconds(1.5), [entryB]() {
+        entryB->MarkAlive(Mac48Address("00:00:00:00:00:02"));
+    });
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_requests[a], 3, "Unresolved entries are retried until MaxRetries.");
+    NS_TEST_EXPECT_MSG_EQ(m_requests[b], 1, "Resolved entries are not retried.");
+    NS_TEST_EXPECT_MSG_EQ(m_requests[c], 3, "Unresolved entries are retried until MaxRetries.");
+    NS_TEST_EXPECT_MSG_EQ(m_drops, 2, "The packets of the dead entries are dropped.");
+    NS_TEST_EXPECT_MSG_EQ(cache->Lookup(a)->IsDead(), true, "The entry should be dead.");
+    NS_TEST_EXPECT_MSG_EQ(cache->Lookup(b)->IsAlive(), true, "The entry should be alive.");
+
+    cache->Remove(cache->Lookup(a));
+    NS_TEST_EXPECT_MSG_EQ(cache->Lookup(a), nullptr, "The entry should have been removed.");
+    NS_TEST_EXPECT_MSG_NE(cache->Lookup(c), nullptr, "The entry should still be there.");
+
+    cache->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1239,6 +1330,7 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new ArpWaitReplyTest, TestCase::Duration::QUICK);
     }
 };
 
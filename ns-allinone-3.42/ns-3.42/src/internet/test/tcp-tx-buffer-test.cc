@@ -53,6 +53,8 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard of a large window, updated one SACK block at a time */
+    void TestLargeWindow();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -100,6 +102,14 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for a large window:
+     *  -> every other segment is sacked, one block per ACK
+     *  -> the lost count, IsLost and NextSeg agree with the whole window
+     *  -> retransmissions and ACKs in the middle of the scoreboard
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestLargeWindow, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -163,6 +173,68 @@ TcpTxBufferTestCase::TestIsLost()
     }
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow()
+{
+    const uint32_t segments = 2000;
+    const uint32_t mss = 1000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetMaxBufferSize(segments * mss);
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(mss);
+    txBuf->SetDupAckThresh(3);
+    txBuf->Add(Create<Packet>(segments * mss));
+
+    auto seqOf = [mss](uint32_t segment) { return SequenceNumber32(segment * mss + 1); };
+
+    for (uint32_t i = 0; i < segments; ++i)
+    {
+        txBuf->CopyFromSequence(mss, seqOf(i));
+    }
+
+    // Segments 1, 3, 5, ... reach the receiver
+    for (uint32_t i = 1; i < segments; i += 2)
+    {
+        TcpOptionSack::SackList list;
+        list.emplace_back(seqOf(i), seqOf(i + 1));
+        NS_TEST_ASSERT_MSG_EQ(txBuf->Update(list), mss, "Block not sacked");
+    }
+
+    // The missing segments with at least three sacked segments above are lost
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), segments / 2 * mss, "Wrong sacked count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), (segments / 2 - 2) * mss, "Wrong lost count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 2 * mss, "Wrong bytes in flight");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(segments - 6)), true, "Segment not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(segments - 4)), false, "Segment lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(seqOf(segments - 3)), false, "Sacked segment lost");
+
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, false), true, "No lost segment found");
+    NS_TEST_ASSERT_MSG_EQ(seq, seqOf(0), "The head is not the first to retransmit");
+
+    // Retransmit the first two holes
+    txBuf->CopyFromSequence(mss, seqOf(0));
+    txBuf->CopyFromSequence(mss, seqOf(2));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(), 2 * mss, "Wrong retransmitted count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(seqOf(3)),
+                          true,
+                          "Retransmission not found");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, false), true, "No lost segment found");
+    NS_TEST_ASSERT_MSG_EQ(seq, seqOf(4), "Wrong segment to retransmit");
+
+    // The first retransmission is acked, together with the sacked segment after it
+    txBuf->DiscardUpTo(seqOf(2));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->HeadSequence(), seqOf(2), "Wrong head");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), (segments / 2 - 1) * mss, "Wrong sacked count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), (segments / 2 - 3) * mss, "Wrong lost count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(), mss, "Wrong retransmitted count");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(seqOf(1)),
+                          false,
+                          "Discarded data found");
+}
+
 uint32_t
 TcpTxBufferTestCase::GetRWnd() const
 {
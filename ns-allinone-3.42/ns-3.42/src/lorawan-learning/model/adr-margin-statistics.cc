@@ -0,0 +1,253 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "adr-margin-statistics.h"
+
+#include "ns3/assert.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("AdrMarginStatistics");
+NS_OBJECT_ENSURE_REGISTERED(AdrMarginStatistics);
+
+namespace
+{
+
+/// SNR required for demodulation at SF7 to SF12, in dB
+constexpr double REQUIRED_SNR[] = {-7.5, -10, -12.5, -15, -17.5, -20};
+
+/// Size of an ADR step, in dB
+constexpr double STEP_DB = 3;
+
+/// Transmission power change per ADR step, in dB
+constexpr double TX_POWER_STEP_DB = 2;
+
+} // namespace
+
+TypeId
+AdrMarginStatistics::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lorawan::AdrMarginStatistics")
+            .SetParent<Object>()
+            .SetGroupName("LorawanLearning")
+            .AddConstructor<AdrMarginStatistics>()
+            .AddAttribute("HistoryRange",
+                          "Number of uplinks combined by the ADR (applies at SetDimensions)",
+                          UintegerValue(20),
+                          MakeUintegerAccessor(&AdrMarginStatistics::m_historyRange),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Combining",
+                          "How the SNRs of the history are combined",
+                          EnumValue(AdrMarginStatistics::AVERAGE),
+                          MakeEnumAccessor<Combining>(&AdrMarginStatistics::m_combining),
+                          MakeEnumChecker(AdrMarginStatistics::AVERAGE,
+                                          "Average",
+                                          AdrMarginStatistics::MAXIMUM,
+                                          "Maximum",
+                                          AdrMarginStatistics::MINIMUM,
+                                          "Minimum"))
+            .AddAttribute("DeviceMargin",
+                          "Margin kept over the SNR required by the spreading factor, in dB",
+                          DoubleValue(10.0),
+                          MakeDoubleAccessor(&AdrMarginStatistics::m_deviceMargin),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MinTxPower",
+                          "Lowest transmission power the ADR sets, in dBm",
+                          DoubleValue(2.0),
+                          MakeDoubleAccessor(&AdrMarginStatistics::m_minTxPowerDbm),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxTxPower",
+                          "Highest transmission power the ADR sets, in dBm",
+                          DoubleValue(14.0),
+                          MakeDoubleAccessor(&AdrMarginStatistics::m_maxTxPowerDbm),
+                          MakeDoubleChecker<double>());
+    return tid;
+}
+
+AdrMarginStatistics::AdrMarginStatistics()
+    : m_historyRange(20),
+      m_combining(AVERAGE),
+      m_deviceMargin(10.0),
+      m_minTxPowerDbm(2.0),
+      m_maxTxPowerDbm(14.0),
+      m_nDevices(0),
+      m_rowLength(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AdrMarginStatistics::~AdrMarginStatistics()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+AdrMarginStatistics::SetDimensions(uint32_t nDevices)
+{
+    NS_LOG_FUNCTION(this << nDevices);
+    m_nDevices = nDevices;
+    m_rowLength = m_historyRange;
+    m_snrs.assign(static_cast<std::size_t>(nDevices) * m_rowLength, 0.0);
+    m_size.assign(nDevices, 0);
+    m_next.assign(nDevices, 0);
+    m_sum.assign(nDevices, 0.0);
+    m_max.assign(nDevices, 0.0);
+    m_min.assign(nDevices, 0.0);
+}
+
+void
+AdrMarginStatistics::AddSnr(uint32_t deviceId, double snr)
+{
+    NS_LOG_FUNCTION(this << deviceId << snr);
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Invalid device " << deviceId);
+    double* row = &m_snrs[static_cast<std::size_t>(deviceId) * m_rowLength];
+    uint32_t& next = m_next[deviceId];
+    if (m_size[deviceId] == 0)
+    {
+        m_max[deviceId] = snr;
+        m_min[deviceId] = snr;
+    }
+    bool rescan = false;
+    if (m_size[deviceId] == m_rowLength)
+    {
+        double evicted = row[next];
+        m_sum[deviceId] -= evicted;
+        rescan = (evicted == m_max[deviceId] && snr < evicted) ||
+                 (evicted == m_min[deviceId] && snr > evicted);
+    }
+    else
+    {
+        m_size[deviceId]++;
+    }
+    row[next] = snr;
+    m_sum[deviceId] += snr;
+    m_max[deviceId] = std::max(m_max[deviceId], snr);
+    m_min[deviceId] = std::min(m_min[deviceId], snr);
+    if (++next == m_rowLength)
+    {
+        next = 0;
+        // Resum once per wrap, so the rounding errors of the running sum do not build up
+        m_sum[deviceId] = 0;
+        for (uint32_t i = 0; i < m_size[deviceId]; i++)
+        {
+            m_sum[deviceId] += row[i];
+        }
+    }
+    if (rescan)
+    {
+        RescanExtrema(deviceId);
+    }
+}
+
+void
+AdrMarginStatistics::RescanExtrema(uint32_t deviceId)
+{
+    const double* row = &m_snrs[static_cast<std::size_t>(deviceId) * m_rowLength];
+    auto [min, max] = std::minmax_element(row, row + m_size[deviceId]);
+    m_min[deviceId] = *min;
+    m_max[deviceId] = *max;
+}
+
+bool
+AdrMarginStatistics::IsReady(uint32_t deviceId) const
+{
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Invalid device " << deviceId);
+    return m_size[deviceId] == m_rowLength;
+}
+
+double
+AdrMarginStatistics::GetCombinedSnr(uint32_t deviceId) const
+{
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Invalid device " << deviceId);
+    NS_ASSERT_MSG(m_size[deviceId] > 0, "No SNR for device " << deviceId);
+    switch (m_combining)
+    {
+    case MAXIMUM:
+        return m_max[deviceId];
+    case MINIMUM:
+        return m_min[deviceId];
+    case AVERAGE:
+    default:
+        return m_sum[deviceId] / m_size[deviceId];
+    }
+}
+
+double
+AdrMarginStatistics::GetMargin(uint32_t deviceId, uint8_t sf) const
+{
+    NS_ASSERT_MSG(sf >= 7 && sf <= 12, "Invalid spreading factor " << +sf);
+    return GetCombinedSnr(deviceId) - REQUIRED_SNR[sf - 7] - m_deviceMargin;
+}
+
+bool
+AdrMarginStatistics::ComputeAdr(uint32_t deviceId, uint8_t& sf, double& txPowerDbm) const
+{
+    if (!IsReady(deviceId))
+    {
+        return false;
+    }
+    int nSteps = static_cast<int>(std::floor(GetMargin(deviceId, sf) / STEP_DB));
+    uint8_t newSf = sf;
+    double newTxPowerDbm = txPowerDbm;
+    while (nSteps > 0 && newSf > 7)
+    {
+        newSf--;
+        nSteps--;
+    }
+    while (nSteps > 0 && newTxPowerDbm - TX_POWER_STEP_DB >= m_minTxPowerDbm)
+    {
+        newTxPowerDbm -= TX_POWER_STEP_DB;
+        nSteps--;
+    }
+    while (nSteps < 0 && newTxPowerDbm + TX_POWER_STEP_DB <= m_maxTxPowerDbm)
+    {
+        newTxPowerDbm += TX_POWER_STEP_DB;
+        nSteps++;
+    }
+    bool changed = newSf != sf || newTxPowerDbm != txPowerDbm;
+    sf = newSf;
+    txPowerDbm = newTxPowerDbm;
+    return changed;
+}
+
+uint32_t
+AdrMarginStatistics::ComputeAdr(const std::vector<uint32_t>& deviceIds,
+                                std::vector<uint8_t>& sfs,
+                                std::vector<double>& txPowersDbm) const
+{
+    NS_LOG_FUNCTION(this << deviceIds.size());
+    NS_ASSERT_MSG(sfs.size() >= m_nDevices && txPowersDbm.size() >= m_nDevices,
+                  "One spreading factor and transmission power per device");
+    uint32_t nChanged = 0;
+    for (uint32_t deviceId : deviceIds)
+    {
+        nChanged += ComputeAdr(deviceId, sfs[deviceId], txPowersDbm[deviceId]);
+    }
+    return nChanged;
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,158 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ADR_MARGIN_STATISTICS_H
+#define ADR_MARGIN_STATISTICS_H
+
+#include "ns3/object.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Incremental SNR statistics of the network server adaptive data rate
+ * (ADR), for a population of end devices.
+ *
+ * The ADR of the lorawan module (AdrComponent) combines the SNR of the last
+ * HistoryRange uplinks of a device, with their average, maximum or minimum,
+ * and turns the margin over the SNR required by the spreading factor into
+ * steps of 3 dB: each step first lowers the spreading factor, then the
+ * transmission power by 2 dB, and a negative margin raises the power back.
+ *
+ * Rather than recomputing the combined SNR from the packet history of the
+ * device at every uplink, the SNRs are kept in a ring buffer per device,
+ * stored as one contiguous row per device, with the running sum, maximum
+ * and minimum of the row. Adding an SNR is constant time, except when it
+ * evicts the current maximum or minimum, which rescans the row. The
+ * decisions of a batch of devices (e.g. those which sent an uplink during a
+ * time slot) are computed in one call over the arrays of the population.
+ */
+class AdrMarginStatistics : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// How the SNRs of the history are combined
+    enum Combining
+    {
+        AVERAGE, //!< Average SNR
+        MAXIMUM, //!< Maximum SNR
+        MINIMUM  //!< Minimum SNR
+    };
+
+    AdrMarginStatistics();
+    ~AdrMarginStatistics() override;
+
+    /**
+     * Allocate the statistics of a population of devices, with an empty
+     * history.
+     *
+     * \param nDevices Number of devices, identified by 0..nDevices-1.
+     */
+    void SetDimensions(uint32_t nDevices);
+
+    /**
+     * Add the SNR of an uplink of a device, evicting the oldest one if the
+     * history is full.
+     *
+     * \param deviceId The device.
+     * \param snr SNR of the uplink (the best one over the gateways), in dB.
+     */
+    void AddSnr(uint32_t deviceId, double snr);
+
+    /**
+     * \param deviceId The device.
+     * \return Whether the history of the device is full, i.e. whether the ADR
+     * may decide for it.
+     */
+    bool IsReady(uint32_t deviceId) const;
+
+    /**
+     * \param deviceId The device, with at least one SNR.
+     * \return The combined SNR of the history of the device, in dB.
+     */
+    double GetCombinedSnr(uint32_t deviceId) const;
+
+    /**
+     * \param deviceId The device, with at least one SNR.
+     * \param sf Current spreading factor of the device, 7 to 12.
+     * \return The margin of the combined SNR over the SNR required at the
+     * spreading factor and the device margin, in dB.
+     */
+    double GetMargin(uint32_t deviceId, uint8_t sf) const;
+
+    /**
+     * Apply the ADR decision of a device to its transmission parameters.
+     *
+     * \param deviceId The device.
+     * \param sf Spreading factor of the device, updated.
+     * \param txPowerDbm Transmission power of the device, in dBm, updated.
+     * \return Whether the parameters changed (false if the history of the
+     * device is not full).
+     */
+    bool ComputeAdr(uint32_t deviceId, uint8_t& sf, double& txPowerDbm) const;
+
+    /**
+     * Apply the ADR decisions of a batch of devices.
+     *
+     * \param deviceIds The devices.
+     * \param sfs Spreading factor of every device of the population, indexed
+     * by device, updated for the devices of the batch.
+     * \param txPowersDbm Transmission power of every device of the
+     * population, in dBm, updated for the devices of the batch.
+     * \return The number of devices whose parameters changed.
+     */
+    uint32_t ComputeAdr(const std::vector<uint32_t>& deviceIds,
+                        std::vector<uint8_t>& sfs,
+                        std::vector<double>& txPowersDbm) const;
+
+  private:
+    /**
+     * Recompute the maximum and minimum of the history of a device.
+     *
+     * \param deviceId The device.
+     */
+    void RescanExtrema(uint32_t deviceId);
+
+    uint32_t m_historyRange;      //!< Number of uplinks in the history
+    Combining m_combining;        //!< How the history is combined
+    double m_deviceMargin;        //!< Margin kept over the required SNR, in dB
+    double m_minTxPowerDbm;       //!< Lowest transmission power, in dBm
+    double m_maxTxPowerDbm;       //!< Highest transmission power, in dBm
+    uint32_t m_nDevices;          //!< Number of devices
+    uint32_t m_rowLength;         //!< History range at the last SetDimensions ()
+    std::vector<double> m_snrs;   //!< SNR history, one ring buffer row per device
+    std::vector<uint32_t> m_size; //!< Number of SNRs in the history, per device
+    std::vector<uint32_t> m_next; //!< Index of the next SNR in the row, per device
+    std::vector<double> m_sum;    //!< Sum of the history, per device
+    std::vector<double> m_max;    //!< Maximum of the history, per device
+    std::vector<double> m_min;    //!< Minimum of the history, per device
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* ADR_MARGIN_STATISTICS_H */
@@ -0,0 +1,202 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "bandit-policy.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("BanditPolicy");
+NS_OBJECT_ENSURE_REGISTERED(BanditPolicy);
+
+TypeId
+BanditPolicy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lorawan::BanditPolicy").SetParent<Object>().SetGroupName("LorawanLearning");
+    return tid;
+}
+
+BanditPolicy::BanditPolicy()
+    : m_nDevices(0),
+      m_nArms(0),
+      m_rewardDiscount(1.0),
+      m_qualityDiscount(1.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BanditPolicy::~BanditPolicy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+BanditPolicy::SetDimensions(uint32_t nDevices, uint32_t nArms)
+{
+    NS_LOG_FUNCTION(this << nDevices << nArms);
+    NS_ABORT_MSG_IF(nArms == 0, "A bandit policy needs at least one arm");
+    m_nDevices = nDevices;
+    m_nArms = nArms;
+    std::size_t size = static_cast<std::size_t>(nDevices) * nArms;
+    m_pulls.assign(size, 0.0);
+    m_rewardSum.assign(size, 0.0);
+    m_rewardSqSum.assign(size, 0.0);
+    m_qualityPulls.assign(size, 0.0);
+    m_qualitySum.assign(size, 0.0);
+    m_totalPulls.assign(nDevices, 0);
+    m_scores.assign(nArms, 0.0);
+}
+
+void
+BanditPolicy::Reset()
+{
+    NS_LOG_FUNCTION(this);
+    SetDimensions(m_nDevices, m_nArms);
+}
+
+uint32_t
+BanditPolicy::GetNDevices() const
+{
+    return m_nDevices;
+}
+
+uint32_t
+BanditPolicy::GetNArms() const
+{
+    return m_nArms;
+}
+
+void
+BanditPolicy::SetDiscounts(double rewardDiscount, double qualityDiscount)
+{
+    NS_LOG_FUNCTION(this << rewardDiscount << qualityDiscount);
+    NS_ASSERT_MSG(rewardDiscount >= 0.0 && rewardDiscount <= 1.0, "Discounts must be in [0, 1]");
+    NS_ASSERT_MSG(qualityDiscount >= 0.0 && qualityDiscount <= 1.0, "Discounts must be in [0, 1]");
+    m_rewardDiscount = rewardDiscount;
+    m_qualityDiscount = qualityDiscount;
+}
+
+std::size_t
+BanditPolicy::RowOffset(uint32_t deviceId) const
+{
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Unknown device " << deviceId);
+    return static_cast<std::size_t>(deviceId) * m_nArms;
+}
+
+uint32_t
+BanditPolicy::ArgMax(const double* scores) const
+{
+    uint32_t best = 0;
+    for (uint32_t arm = 1; arm < m_nArms; arm++)
+    {
+        if (scores[arm] > scores[best])
+        {
+            best = arm;
+        }
+    }
+    return best;
+}
+
+uint32_t
+BanditPolicy::SelectArm(uint32_t deviceId)
+{
+    NS_LOG_FUNCTION(this << deviceId);
+    ScoreArms(deviceId, m_scores.data());
+    return ArgMax(m_scores.data());
+}
+
+void
+BanditPolicy::SelectArms(const std::vector<uint32_t>& deviceIds, std::vector<uint32_t>& arms)
+{
+    NS_LOG_FUNCTION(this << deviceIds.size());
+    arms.resize(deviceIds.size());
+    for (std::size_t i = 0; i < deviceIds.size(); i++)
+    {
+        ScoreArms(deviceIds[i], m_scores.data());
+        arms[i] = ArgMax(m_scores.data());
+    }
+}
+
+void
+BanditPolicy::Update(uint32_t deviceId, uint32_t arm, double reward, double quality)
+{
+    NS_LOG_FUNCTION(this << deviceId << arm << reward << quality);
+    NS_ASSERT_MSG(arm < m_nArms, "Unknown arm " << arm);
+    std::size_t row = RowOffset(deviceId);
+
+    if (m_rewardDiscount < 1.0)
+    {
+        double* pulls = &m_pulls[row];
+        double* rewardSum = &m_rewardSum[row];
+        double* rewardSqSum = &m_rewardSqSum[row];
+        for (uint32_t a = 0; a < m_nArms; a++)
+        {
+            pulls[a] *= m_rewardDiscount;
+            rewardSum[a] *= m_rewardDiscount;
+            rewardSqSum[a] *= m_rewardDiscount;
+        }
+    }
+    if (m_qualityDiscount < 1.0)
+    {
+        double* qualityPulls = &m_qualityPulls[row];
+        double* qualitySum = &m_qualitySum[row];
+        for (uint32_t a = 0; a < m_nArms; a++)
+        {
+            qualityPulls[a] *= m_qualityDiscount;
+            qualitySum[a] *= m_qualityDiscount;
+        }
+    }
+
+    m_pulls[row + arm] += 1.0;
+    m_rewardSum[row + arm] += reward;
+    m_rewardSqSum[row + arm] += reward * reward;
+    m_qualityPulls[row + arm] += 1.0;
+    m_qualitySum[row + arm] += quality;
+    m_totalPulls[deviceId]++;
+}
+
+double
+BanditPolicy::GetPulls(uint32_t deviceId, uint32_t arm) const
+{
+    NS_ASSERT_MSG(arm < m_nArms, "Unknown arm " << arm);
+    return m_pulls[RowOffset(deviceId) + arm];
+}
+
+double
+BanditPolicy::GetMeanReward(uint32_t deviceId, uint32_t arm) const
+{
+    NS_ASSERT_MSG(arm < m_nArms, "Unknown arm " << arm);
+    std::size_t index = RowOffset(deviceId) + arm;
+    return m_pulls[index] > 0.0 ? m_rewardSum[index] / m_pulls[index] : 0.0;
+}
+
+uint64_t
+BanditPolicy::GetTotalPulls(uint32_t deviceId) const
+{
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Unknown device " << deviceId);
+    return m_totalPulls[deviceId];
+}
+
+} // namespace lorawan
+} // namespace ns3
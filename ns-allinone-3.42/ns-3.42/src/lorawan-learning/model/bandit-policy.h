@@ -0,0 +1,185 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BANDIT_POLICY_H
+#define BANDIT_POLICY_H
+
+#include "ns3/object.h"
+
+#include <vector>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \defgroup lorawan-learning LoRaWAN learning
+ *
+ * Multi-armed bandit policies used by LoRaWAN end devices to select their
+ * transmission parameters (channel, spreading factor, transmission power...).
+ */
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Base class of the bandit policies, holding the arm statistics of a
+ * whole population of devices.
+ *
+ * The statistics are stored as a structure of arrays: each quantity (number
+ * of pulls, sum of the rewards, sum of the squared rewards, sum of the channel
+ * qualities) is a single contiguous array of nDevices x nArms values, where the
+ * arms of a device are adjacent. Subclasses score all the arms of a device in
+ * a single branch-free pass over these rows, which the compiler can vectorize,
+ * and SelectArms () scores a whole batch of devices at once.
+ *
+ * An arm that was never pulled has an infinite score, so every arm is tried
+ * once before the policy starts exploiting. Ties are broken in favour of the
+ * arm with the lowest index.
+ *
+ * The rewards and the qualities can be discounted (see SetDiscounts ()): before
+ * each update every statistic of the device is multiplied by the discount
+ * factor, which is the incremental form of the discounted sums used by
+ * non-stationary policies such as D-UCB and DQoC-A.
+ */
+class BanditPolicy : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    BanditPolicy();
+    ~BanditPolicy() override;
+
+    /**
+     * Allocate the statistics of a population of devices, all arms unexplored.
+     *
+     * \param nDevices Number of devices, identified by 0..nDevices-1.
+     * \param nArms Number of arms of each device.
+     */
+    virtual void SetDimensions(uint32_t nDevices, uint32_t nArms);
+
+    /**
+     * Forget everything that was learnt, keeping the population size.
+     */
+    void Reset();
+
+    /**
+     * \return The number of devices.
+     */
+    uint32_t GetNDevices() const;
+
+    /**
+     * \return The number of arms of each device.
+     */
+    uint32_t GetNArms() const;
+
+    /**
+     * \param deviceId The device.
+     * \return The arm with the highest score for this device.
+     */
+    uint32_t SelectArm(uint32_t deviceId);
+
+    /**
+     * Select an arm for each device of a batch.
+     *
+     * \param deviceIds The devices.
+     * \param arms Filled with the arm selected for each device of deviceIds.
+     */
+    void SelectArms(const std::vector<uint32_t>& deviceIds, std::vector<uint32_t>& arms);
+
+    /**
+     * Record the outcome of a pull.
+     *
+     * \param deviceId The device.
+     * \param arm The arm that was pulled.
+     * \param reward The reward that was obtained.
+     * \param quality The channel quality observed by the pull (only used by
+     *        quality-aware policies).
+     */
+    virtual void Update(uint32_t deviceId, uint32_t arm, double reward, double quality = 0.0);
+
+    /**
+     * \param deviceId The device.
+     * \param arm The arm.
+     * \return The (possibly discounted) number of pulls of the arm.
+     */
+    double GetPulls(uint32_t deviceId, uint32_t arm) const;
+
+    /**
+     * \param deviceId The device.
+     * \param arm The arm.
+     * \return The (possibly discounted) mean reward of the arm, 0 if it was never pulled.
+     */
+    double GetMeanReward(uint32_t deviceId, uint32_t arm) const;
+
+    /**
+     * \param deviceId The device.
+     * \return The number of pulls of the device, over all arms and without discount.
+     */
+    uint64_t GetTotalPulls(uint32_t deviceId) const;
+
+  protected:
+    /**
+     * Set the discount factors applied to the statistics before each update.
+     *
+     * \param rewardDiscount Discount of the pulls and rewards, 1 for none.
+     * \param qualityDiscount Discount of the qualities, 1 for none.
+     */
+    void SetDiscounts(double rewardDiscount, double qualityDiscount);
+
+    /**
+     * Compute the score of every arm of a device.
+     *
+     * \param deviceId The device.
+     * \param scores Output array of GetNArms () scores.
+     */
+    virtual void ScoreArms(uint32_t deviceId, double* scores) const = 0;
+
+    /**
+     * \param deviceId The device.
+     * \return The offset of the first arm of the device in the statistics arrays.
+     */
+    std::size_t RowOffset(uint32_t deviceId) const;
+
+    uint32_t m_nDevices; //!< Number of devices
+    uint32_t m_nArms;    //!< Number of arms per device
+
+    std::vector<double> m_pulls;         //!< Number of pulls, per device and arm
+    std::vector<double> m_rewardSum;     //!< Sum of the rewards, per device and arm
+    std::vector<double> m_rewardSqSum;   //!< Sum of the squared rewards, per device and arm
+    std::vector<double> m_qualityPulls;  //!< Number of quality samples, per device and arm
+    std::vector<double> m_qualitySum;    //!< Sum of the qualities, per device and arm
+    std::vector<uint64_t> m_totalPulls;  //!< Number of pulls, per device
+
+  private:
+    /**
+     * \param scores Scores of the arms of a device.
+     * \return The index of the highest score, the lowest index on ties.
+     */
+    uint32_t ArgMax(const double* scores) const;
+
+    double m_rewardDiscount;     //!< Discount factor of the pulls and rewards
+    double m_qualityDiscount;    //!< Discount factor of the qualities
+    std::vector<double> m_scores; //!< Scratch buffer for the scores of a device
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* BANDIT_POLICY_H */
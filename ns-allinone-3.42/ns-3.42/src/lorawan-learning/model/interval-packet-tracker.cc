@@ -0,0 +1,221 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "interval-packet-tracker.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("IntervalPacketTracker");
+NS_OBJECT_ENSURE_REGISTERED(IntervalPacketTracker);
+
+TypeId
+IntervalPacketTracker::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lorawan::IntervalPacketTracker")
+            .SetParent<Object>()
+            .SetGroupName("LorawanLearning")
+            .AddConstructor<IntervalPacketTracker>()
+            .AddAttribute("Interval",
+                          "Duration of the intervals the counters are aggregated over",
+                          TimeValue(Seconds(60)),
+                          MakeTimeAccessor(&IntervalPacketTracker::m_interval),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddAttribute("PacketLifetime",
+                          "Time after which the outcome of a packet is final, even if some "
+                          "gateways did not report it",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&IntervalPacketTracker::m_packetLifetime),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+IntervalPacketTracker::IntervalPacketTracker()
+    : m_interval(Seconds(60)),
+      m_packetLifetime(Seconds(10))
+{
+    NS_LOG_FUNCTION(this);
+}
+
+IntervalPacketTracker::~IntervalPacketTracker()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+IntervalPacketTracker::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_pending.clear();
+    m_sendOrder.clear();
+    Object::DoDispose();
+}
+
+void
+IntervalPacketTracker::SetGateways(const std::vector<uint32_t>& gatewayIds)
+{
+    NS_LOG_FUNCTION(this << gatewayIds.size());
+    m_gatewayIds = gatewayIds;
+    m_sent.clear();
+    m_received.clear();
+    m_phyCounts.clear();
+    m_pending.clear();
+    m_sendOrder.clear();
+}
+
+void
+IntervalPacketTracker::NotifySent(uint64_t packetUid)
+{
+    NS_LOG_FUNCTION(this << packetUid);
+    ExpirePackets();
+    std::size_t interval = GetInterval(Simulator::Now());
+    if (interval >= m_sent.size())
+    {
+        m_sent.resize(interval + 1, 0);
+        m_received.resize(interval + 1, 0);
+        m_phyCounts.resize((interval + 1) * m_gatewayIds.size(), PhyCounts{});
+    }
+    m_sent[interval]++;
+    if (m_gatewayIds.empty())
+    {
+        return;
+    }
+    m_pending[packetUid] = {interval, 0, false};
+    m_sendOrder.emplace_back(Simulator::Now(), packetUid);
+}
+
+void
+IntervalPacketTracker::NotifyOutcome(uint64_t packetUid, uint32_t gatewayId, PhyOutcome outcome)
+{
+    NS_LOG_FUNCTION(this << packetUid << gatewayId << outcome);
+    NS_ASSERT_MSG(outcome < N_OUTCOMES, "Invalid outcome " << outcome);
+    auto it = m_pending.find(packetUid);
+    if (it == m_pending.end())
+    {
+        return;
+    }
+    Pending& packet = it->second;
+    m_phyCounts[packet.interval * m_gatewayIds.size() + GetGatewayIndex(gatewayId)][outcome]++;
+    if (outcome == RECEIVED && !packet.received)
+    {
+        packet.received = true;
+        m_received[packet.interval]++;
+    }
+    if (++packet.nOutcomes == m_gatewayIds.size())
+    {
+        // Final: its entry in m_sendOrder is skipped when it expires
+        m_pending.erase(it);
+    }
+}
+
+uint64_t
+IntervalPacketTracker::CountSent(Time start, Time stop) const
+{
+    auto [first, last] = GetIntervals(start, stop);
+    uint64_t count = 0;
+    for (std::size_t interval = first; interval < last; interval++)
+    {
+        count += m_sent[interval];
+    }
+    return count;
+}
+
+uint64_t
+IntervalPacketTracker::CountReceived(Time start, Time stop) const
+{
+    auto [first, last] = GetIntervals(start, stop);
+    uint64_t count = 0;
+    for (std::size_t interval = first; interval < last; interval++)
+    {
+        count += m_received[interval];
+    }
+    return count;
+}
+
+IntervalPacketTracker::PhyCounts
+IntervalPacketTracker::CountPhyOutcomes(Time start, Time stop, uint32_t gatewayId) const
+{
+    auto [first, last] = GetIntervals(start, stop);
+    std::size_t gateway = GetGatewayIndex(gatewayId);
+    PhyCounts counts{};
+    for (std::size_t interval = first; interval < last; interval++)
+    {
+        const PhyCounts& intervalCounts = m_phyCounts[interval * m_gatewayIds.size() + gateway];
+        for (std::size_t outcome = 0; outcome < N_OUTCOMES; outcome++)
+        {
+            counts[outcome] += intervalCounts[outcome];
+        }
+    }
+    return counts;
+}
+
+std::size_t
+IntervalPacketTracker::GetNPending() const
+{
+    return m_pending.size();
+}
+
+std::size_t
+IntervalPacketTracker::GetInterval(Time time) const
+{
+    NS_ASSERT_MSG(!time.IsStrictlyNegative(), "Negative time " << time);
+    return static_cast<std::size_t>(time.GetTimeStep() / m_interval.GetTimeStep());
+}
+
+std::pair<std::size_t, std::size_t>
+IntervalPacketTracker::GetIntervals(Time start, Time stop) const
+{
+    if (stop <= start)
+    {
+        return {0, 0};
+    }
+    std::size_t first = std::min(GetInterval(start), m_sent.size());
+    // The interval containing stop overlaps [start, stop) unless stop is its beginning
+    std::size_t last = GetInterval(stop - TimeStep(1)) + 1;
+    return {first, std::min(last, m_sent.size())};
+}
+
+std::size_t
+IntervalPacketTracker::GetGatewayIndex(uint32_t gatewayId) const
+{
+    // A linear search: there are a few gateways, and their IDs are not contiguous
+    auto it = std::find(m_gatewayIds.begin(), m_gatewayIds.end(), gatewayId);
+    NS_ABORT_MSG_IF(it == m_gatewayIds.end(), "Unknown gateway " << gatewayId);
+    return it - m_gatewayIds.begin();
+}
+
+void
+IntervalPacketTracker::ExpirePackets()
+{
+    Time oldest = Simulator::Now() - m_packetLifetime;
+    while (!m_sendOrder.empty() && m_sendOrder.front().first < oldest)
+    {
+        m_pending.erase(m_sendOrder.front().second);
+        m_sendOrder.pop_front();
+    }
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef INTERVAL_PACKET_TRACKER_H
+#define INTERVAL_PACKET_TRACKER_H
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Online tracker of the uplinks and of their outcome at each
+ * gateway, aggregated per time interval.
+ *
+ * Instead of keeping every packet and its status at every gateway for the
+ * whole run, the tracker adds each event to the counters of the interval
+ * (of duration Interval) in which the packet was sent: the number of
+ * packets sent, the number received by at least one gateway, and the
+ * number of each PHY outcome per gateway. A packet is only kept until its
+ * outcome is final, i.e. once every gateway reported it, or once it is
+ * older than PacketLifetime (a gateway that does not listen to the channel
+ * of a packet never reports it). The memory is then proportional to the
+ * number of intervals and of packets in flight, and a count over a time
+ * range sums the counters of its intervals.
+ *
+ * The PHY outcomes are those of the lorawan module's LoraPacketTracker, and
+ * the Notify methods match the signatures of the EndDeviceLoraPhy and
+ * GatewayLoraPhy trace sources, given the packet UID.
+ */
+class IntervalPacketTracker : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /// Outcome of a packet at a gateway
+    enum PhyOutcome
+    {
+        RECEIVED,          //!< Received
+        INTERFERED,        //!< Lost because of interference
+        NO_MORE_RECEIVERS, //!< Lost because all the reception paths were busy
+        UNDER_SENSITIVITY, //!< Lost because below the sensitivity
+        LOST_BECAUSE_TX,   //!< Lost because the gateway was transmitting
+        N_OUTCOMES         //!< Number of outcomes
+    };
+
+    /// Number of packets of each outcome
+    using PhyCounts = std::array<uint64_t, N_OUTCOMES>;
+
+    IntervalPacketTracker();
+    ~IntervalPacketTracker() override;
+
+    /**
+     * Set the gateways, and forget everything tracked so far.
+     *
+     * \param gatewayIds Identifiers of the gateways (e.g. their node IDs).
+     */
+    void SetGateways(const std::vector<uint32_t>& gatewayIds);
+
+    /**
+     * Record a packet sent now.
+     *
+     * \param packetUid UID of the packet.
+     */
+    void NotifySent(uint64_t packetUid);
+
+    /**
+     * Record the outcome of a packet at a gateway. Outcomes of packets not
+     * sent or no longer tracked are ignored.
+     *
+     * \param packetUid UID of the packet.
+     * \param gatewayId Identifier of the gateway.
+     * \param outcome The outcome.
+     */
+    void NotifyOutcome(uint64_t packetUid, uint32_t gatewayId, PhyOutcome outcome);
+
+    /**
+     * \param start Beginning of the time range.
+     * \param stop End of the time range.
+     * \return The number of packets sent in the intervals overlapping
+     * [start, stop).
+     */
+    uint64_t CountSent(Time start, Time stop) const;
+
+    /**
+     * \param start Beginning of the time range.
+     * \param stop End of the time range.
+     * \return The number of packets sent in the intervals overlapping
+     * [start, stop) and received by at least one gateway.
+     */
+    uint64_t CountReceived(Time start, Time stop) const;
+
+    /**
+     * \param start Beginning of the time range.
+     * \param stop End of the time range.
+     * \param gatewayId Identifier of the gateway.
+     * \return The number of packets of each outcome at the gateway, among
+     * those sent in the intervals overlapping [start, stop).
+     */
+    PhyCounts CountPhyOutcomes(Time start, Time stop, uint32_t gatewayId) const;
+
+    /**
+     * \return The number of packets whose outcome is not final yet.
+     */
+    std::size_t GetNPending() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A packet whose outcome is not final yet
+    struct Pending
+    {
+        std::size_t interval; //!< Interval in which it was sent
+        uint32_t nOutcomes;   //!< Number of gateways which reported it
+        bool received;        //!< Whether a gateway received it
+    };
+
+    /**
+     * \param time A time.
+     * \return The index of the interval containing the time.
+     */
+    std::size_t GetInterval(Time time) const;
+
+    /**
+     * \param start Beginning of a time range.
+     * \param stop End of the time range.
+     * \return The range [first, last) of the intervals overlapping [start, stop),
+     * limited to the intervals tracked so far.
+     */
+    std::pair<std::size_t, std::size_t> GetIntervals(Time start, Time stop) const;
+
+    /**
+     * \param gatewayId Identifier of a gateway.
+     * \return The index of the gateway.
+     */
+    std::size_t GetGatewayIndex(uint32_t gatewayId) const;
+
+    /// Stop tracking the packets older than the packet lifetime.
+    void ExpirePackets();
+
+    Time m_interval;                     //!< Duration of the intervals
+    Time m_packetLifetime;               //!< Time after which a packet is no longer tracked
+    std::vector<uint32_t> m_gatewayIds;  //!< Identifiers of the gateways
+    std::vector<uint64_t> m_sent;        //!< Packets sent, per interval
+    std::vector<uint64_t> m_received;    //!< Packets received, per interval
+    std::vector<PhyCounts> m_phyCounts;  //!< Outcomes, per interval and gateway
+    std::unordered_map<uint64_t, Pending> m_pending; //!< Packets not final yet, by UID
+    std::deque<std::pair<Time, uint64_t>> m_sendOrder; //!< Send time and UID, oldest first
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* INTERVAL_PACKET_TRACKER_H */
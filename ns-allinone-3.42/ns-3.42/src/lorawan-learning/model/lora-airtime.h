@@ -0,0 +1,204 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LORA_AIRTIME_H
+#define LORA_AIRTIME_H
+
+#include "ns3/assert.h"
+
+#include <array>
+#include <cstdint>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Compute the time on air of a LoRa frame (Semtech AN1200.13).
+ *
+ * The low data rate optimization is enabled when the symbol time is at least
+ * 16 ms (SF11 and SF12 at 125 kHz), as required by the LoRaWAN regional
+ * parameters.
+ *
+ * \param sf Spreading factor, 7 to 12.
+ * \param bandwidthHz Bandwidth, in Hz.
+ * \param codingRate Coding rate 4/(4+codingRate), 1 to 4.
+ * \param payloadBytes Size of the PHY payload, in bytes.
+ * \param nPreamble Number of programmed preamble symbols.
+ * \param header Whether the frame has an explicit header.
+ * \param crc Whether the frame has a payload CRC.
+ * \return The time on air, in seconds.
+ */
+constexpr double
+LoraTimeOnAir(uint8_t sf,
+              uint32_t bandwidthHz,
+              uint8_t codingRate,
+              uint32_t payloadBytes,
+              uint32_t nPreamble = 8,
+              bool header = true,
+              bool crc = true)
+{
+    double tSymbol = static_cast<double>(uint32_t{1} << sf) / bandwidthHz;
+    int64_t de = tSymbol >= 0.016 ? 1 : 0;
+    int64_t numerator = 8 * int64_t{payloadBytes} - 4 * int64_t{sf} + 28 + (crc ? 16 : 0) -
+                        (header ? 0 : 20);
+    int64_t denominator = 4 * (int64_t{sf} - 2 * de);
+    // Integer ceiling, as std::ceil is not constexpr
+    int64_t blocks = numerator > 0 ? (numerator + denominator - 1) / denominator : 0;
+    int64_t payloadSymbols = 8 + blocks * (codingRate + 4);
+    return (nPreamble + 4.25 + payloadSymbols) * tSymbol;
+}
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Time on air of every LoRa uplink configuration, computed at compile
+ * time.
+ *
+ * The spreading factor, bandwidth, coding rate and payload size of an uplink
+ * all come from small discrete sets, so the LoraTimeOnAir () of every
+ * combination (8 preamble symbols, explicit header and CRC, as for LoRaWAN
+ * uplinks) is stored in a constexpr table: getting the airtime or the energy
+ * of a transmission is a single array load instead of the symbol count
+ * computation.
+ */
+class LoraAirtimeTable
+{
+  public:
+    static constexpr uint8_t MIN_SF = 7;                  //!< Smallest spreading factor
+    static constexpr uint8_t MAX_SF = 12;                 //!< Largest spreading factor
+    static constexpr uint8_t MAX_CODING_RATE = 4;         //!< Largest coding rate (4/8)
+    static constexpr uint32_t MAX_PAYLOAD = 255;          //!< Largest PHY payload, in bytes
+    static constexpr std::array<uint32_t, 3> BANDWIDTHS{125000, 250000, 500000}; //!< In Hz
+
+    /**
+     * Get the time on air of an uplink.
+     *
+     * \param sf Spreading factor, MIN_SF to MAX_SF.
+     * \param bandwidthHz Bandwidth, in Hz, one of BANDWIDTHS.
+     * \param codingRate Coding rate 4/(4+codingRate), 1 to MAX_CODING_RATE.
+     * \param payloadBytes Size of the PHY payload, at most MAX_PAYLOAD bytes.
+     * \return The time on air, in seconds.
+     */
+    static constexpr double GetTimeOnAir(uint8_t sf,
+                                         uint32_t bandwidthHz,
+                                         uint8_t codingRate,
+                                         uint32_t payloadBytes)
+    {
+        NS_ASSERT_MSG(sf >= MIN_SF && sf <= MAX_SF, "Invalid spreading factor " << +sf);
+        NS_ASSERT_MSG(codingRate >= 1 && codingRate <= MAX_CODING_RATE,
+                      "Invalid coding rate " << +codingRate);
+        NS_ASSERT_MSG(payloadBytes <= MAX_PAYLOAD, "Payload too large: " << payloadBytes);
+        return m_table[Index(sf, GetBandwidthIndex(bandwidthHz), codingRate, payloadBytes)];
+    }
+
+    /**
+     * Get the energy spent to transmit an uplink.
+     *
+     * \param sf Spreading factor, MIN_SF to MAX_SF.
+     * \param bandwidthHz Bandwidth, in Hz, one of BANDWIDTHS.
+     * \param codingRate Coding rate 4/(4+codingRate), 1 to MAX_CODING_RATE.
+     * \param payloadBytes Size of the PHY payload, at most MAX_PAYLOAD bytes.
+     * \param powerW Power drawn while transmitting, in W.
+     * \return The energy, in J.
+     */
+    static constexpr double GetEnergy(uint8_t sf,
+                                      uint32_t bandwidthHz,
+                                      uint8_t codingRate,
+                                      uint32_t payloadBytes,
+                                      double powerW)
+    {
+        return powerW * GetTimeOnAir(sf, bandwidthHz, codingRate, payloadBytes);
+    }
+
+  private:
+    /**
+     * Get the index of a bandwidth in BANDWIDTHS.
+     * \param bandwidthHz Bandwidth, in Hz.
+     * \return The index of the bandwidth.
+     */
+    static constexpr std::size_t GetBandwidthIndex(uint32_t bandwidthHz)
+    {
+        for (std::size_t i = 0; i < BANDWIDTHS.size(); i++)
+        {
+            if (BANDWIDTHS[i] == bandwidthHz)
+            {
+                return i;
+            }
+        }
+        NS_ASSERT_MSG(false, "Unsupported bandwidth " << bandwidthHz);
+        return 0;
+    }
+
+    /**
+     * Get the index of a configuration in the table.
+     * \param sf Spreading factor.
+     * \param bw Index of the bandwidth.
+     * \param codingRate Coding rate.
+     * \param payloadBytes Size of the PHY payload, in bytes.
+     * \return The index in the table.
+     */
+    static constexpr std::size_t Index(uint8_t sf,
+                                       std::size_t bw,
+                                       uint8_t codingRate,
+                                       uint32_t payloadBytes)
+    {
+        return (((sf - MIN_SF) * BANDWIDTHS.size() + bw) * MAX_CODING_RATE + codingRate - 1) *
+                   (MAX_PAYLOAD + 1) +
+               payloadBytes;
+    }
+
+    /// Number of configurations in the table
+    static constexpr std::size_t SIZE =
+        (MAX_SF - MIN_SF + 1) * BANDWIDTHS.size() * MAX_CODING_RATE * (MAX_PAYLOAD + 1);
+
+    /**
+     * Compute the table.
+     * \return The time on air of every configuration, in seconds.
+     */
+    static constexpr std::array<double, SIZE> Build()
+    {
+        std::array<double, SIZE> table{};
+        for (uint8_t sf = MIN_SF; sf <= MAX_SF; sf++)
+        {
+            for (std::size_t bw = 0; bw < BANDWIDTHS.size(); bw++)
+            {
+                for (uint8_t cr = 1; cr <= MAX_CODING_RATE; cr++)
+                {
+                    for (uint32_t payload = 0; payload <= MAX_PAYLOAD; payload++)
+                    {
+                        table[Index(sf, bw, cr, payload)] =
+                            LoraTimeOnAir(sf, BANDWIDTHS[bw], cr, payload);
+                    }
+                }
+            }
+        }
+        return table;
+    }
+
+    static const std::array<double, SIZE> m_table; //!< Time on air, in seconds
+};
+
+// Defined out of the class, where Build () is complete
+inline constexpr std::array<double, LoraAirtimeTable::SIZE> LoraAirtimeTable::m_table =
+    LoraAirtimeTable::Build();
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* LORA_AIRTIME_H */
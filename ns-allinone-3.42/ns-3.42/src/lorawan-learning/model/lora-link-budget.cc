@@ -0,0 +1,210 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lora-link-budget.h"
+
+#include "ns3/assert.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("LoraLinkBudget");
+NS_OBJECT_ENSURE_REGISTERED(LoraLinkBudget);
+
+namespace
+{
+
+/// Sensitivity of SF7 to SF12 at 125 kHz, in dBm
+constexpr double SENSITIVITY_125[] = {-124, -127, -130, -133, -135, -137};
+
+/// Signal to interference thresholds, in dB, by SF of the signal (rows) and
+/// of the interference (columns), SF7 to SF12
+constexpr double SIR_THRESHOLDS[6][6] = {{6, -16, -18, -19, -19, -20},
+                                         {-24, 6, -20, -22, -22, -22},
+                                         {-27, -27, 6, -23, -25, -25},
+                                         {-30, -30, -30, 6, -26, -28},
+                                         {-33, -33, -33, -33, 6, -29},
+                                         {-36, -36, -36, -36, -36, 6}};
+
+} // namespace
+
+TypeId
+LoraLinkBudget::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lorawan::LoraLinkBudget")
+            .SetParent<Object>()
+            .SetGroupName("LorawanLearning")
+            .AddConstructor<LoraLinkBudget>()
+            .AddAttribute("Exponent",
+                          "Path loss exponent",
+                          DoubleValue(3.76),
+                          MakeDoubleAccessor(&LoraLinkBudget::m_exponent),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("ReferenceDistance",
+                          "Distance of the reference path loss, in m",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&LoraLinkBudget::m_referenceDistance),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("ReferenceLoss",
+                          "Path loss at the reference distance, in dB",
+                          DoubleValue(7.7),
+                          MakeDoubleAccessor(&LoraLinkBudget::m_referenceLoss),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("ShadowingSigma",
+                          "Standard deviation of the log-normal shadowing, in dB (0 for none)",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&LoraLinkBudget::SetShadowingSigma,
+                                             &LoraLinkBudget::GetShadowingSigma),
+                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+LoraLinkBudget::LoraLinkBudget()
+    : m_exponent(3.76),
+      m_referenceDistance(1.0),
+      m_referenceLoss(7.7),
+      m_shadowingSigma(0.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LoraLinkBudget::~LoraLinkBudget()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LoraLinkBudget::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_shadowing = nullptr;
+    Object::DoDispose();
+}
+
+void
+LoraLinkBudget::SetShadowingSigma(double sigma)
+{
+    NS_LOG_FUNCTION(this << sigma);
+    m_shadowingSigma = sigma;
+    if (sigma > 0 || m_shadowing)
+    {
+        CreateShadowing();
+    }
+}
+
+void
+LoraLinkBudget::CreateShadowing()
+{
+    // Created on demand, so that a link budget without shadowing takes no stream
+    // and does not shift the streams of the random variables created after it
+    if (!m_shadowing)
+    {
+        m_shadowing = CreateObject<NormalRandomVariable>();
+        m_shadowing->SetAttribute("Mean", DoubleValue(0.0));
+    }
+    m_shadowing->SetAttribute("Variance", DoubleValue(m_shadowingSigma * m_shadowingSigma));
+}
+
+double
+LoraLinkBudget::GetShadowingSigma() const
+{
+    return m_shadowingSigma;
+}
+
+double
+LoraLinkBudget::GetPathLoss(double distance) const
+{
+    // As LogDistancePropagationLossModel: no gain closer than the reference distance
+    if (distance <= m_referenceDistance)
+    {
+        return m_referenceLoss;
+    }
+    return m_referenceLoss + 10 * m_exponent * std::log10(distance / m_referenceDistance);
+}
+
+double
+LoraLinkBudget::GetRxPower(double txPowerDbm, double distance)
+{
+    double rxPowerDbm = txPowerDbm - GetPathLoss(distance);
+    if (m_shadowingSigma > 0)
+    {
+        rxPowerDbm += m_shadowing->GetValue();
+    }
+    return rxPowerDbm;
+}
+
+void
+LoraLinkBudget::GetRxPowers(const std::vector<double>& txPowersDbm,
+                            const std::vector<double>& distances,
+                            std::vector<double>& rxPowersDbm)
+{
+    NS_LOG_FUNCTION(this << distances.size());
+    NS_ASSERT_MSG(txPowersDbm.size() == distances.size(), "One transmission power per link");
+    const std::size_t n = distances.size();
+    rxPowersDbm.resize(n);
+    if (m_shadowingSigma > 0)
+    {
+        m_shadowing->GetValues(rxPowersDbm);
+    }
+    else
+    {
+        std::fill(rxPowersDbm.begin(), rxPowersDbm.end(), 0.0);
+    }
+    const double slope = 10 * m_exponent;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double ratio = std::max(distances[i] / m_referenceDistance, 1.0);
+        rxPowersDbm[i] += txPowersDbm[i] - m_referenceLoss - slope * std::log10(ratio);
+    }
+}
+
+double
+LoraLinkBudget::GetSensitivity(uint8_t sf, uint32_t bandwidthHz)
+{
+    NS_ASSERT_MSG(sf >= 7 && sf <= 12, "Invalid spreading factor " << +sf);
+    NS_ASSERT_MSG(bandwidthHz == 125000 || bandwidthHz == 250000 || bandwidthHz == 500000,
+                  "Unsupported bandwidth " << bandwidthHz);
+    // The noise floor grows by 3 dB each time the bandwidth doubles
+    return SENSITIVITY_125[sf - 7] + 10 * std::log10(bandwidthHz / 125000.0);
+}
+
+double
+LoraLinkBudget::GetSirThreshold(uint8_t sf, uint8_t interfererSf)
+{
+    NS_ASSERT_MSG(sf >= 7 && sf <= 12, "Invalid spreading factor " << +sf);
+    NS_ASSERT_MSG(interfererSf >= 7 && interfererSf <= 12,
+                  "Invalid spreading factor " << +interfererSf);
+    return SIR_THRESHOLDS[sf - 7][interfererSf - 7];
+}
+
+int64_t
+LoraLinkBudget::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    CreateShadowing();
+    m_shadowing->SetStream(stream);
+    return 1;
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,138 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LORA_LINK_BUDGET_H
+#define LORA_LINK_BUDGET_H
+
+#include "ns3/object.h"
+#include "ns3/random-variable-stream.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Link budget of LoRa uplinks: path loss, shadowing, sensitivity and
+ * capture thresholds.
+ *
+ * The path loss is log-distance, with the Exponent, ReferenceDistance and
+ * ReferenceLoss attributes (by default those of the lorawan module
+ * examples), plus a log-normal shadowing of standard deviation
+ * ShadowingSigma, 0 to disable it. The received power of a whole set of
+ * links is computed in one call, over contiguous arrays, so that the
+ * simulations evaluating many devices at once keep a single tight loop.
+ *
+ * The sensitivities (per spreading factor and bandwidth) and the
+ * signal-to-interference thresholds (per pair of spreading factors, from
+ * Goursaud et al., "Dedicated networks for IoT: PHY/MAC state of the art
+ * and challenges", 2015) are constant tables.
+ */
+class LoraLinkBudget : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    LoraLinkBudget();
+    ~LoraLinkBudget() override;
+
+    /**
+     * \param distance Distance between the transmitter and the receiver, in m.
+     * \return The path loss, in dB, without shadowing.
+     */
+    double GetPathLoss(double distance) const;
+
+    /**
+     * Get the received power of a link, with a new shadowing draw.
+     *
+     * \param txPowerDbm Transmission power, in dBm.
+     * \param distance Distance between the transmitter and the receiver, in m.
+     * \return The received power, in dBm.
+     */
+    double GetRxPower(double txPowerDbm, double distance);
+
+    /**
+     * Get the received power of a set of links, with a new shadowing draw
+     * for each link.
+     *
+     * \param txPowersDbm Transmission power of each link, in dBm.
+     * \param distances Distance of each link, in m.
+     * \param rxPowersDbm Resized to the number of links, and set to the
+     * received power of each link, in dBm.
+     */
+    void GetRxPowers(const std::vector<double>& txPowersDbm,
+                     const std::vector<double>& distances,
+                     std::vector<double>& rxPowersDbm);
+
+    /**
+     * \param sf Spreading factor, 7 to 12.
+     * \param bandwidthHz Bandwidth, in Hz: 125000, 250000 or 500000.
+     * \return The sensitivity of the receiver, in dBm.
+     */
+    static double GetSensitivity(uint8_t sf, uint32_t bandwidthHz);
+
+    /**
+     * \param sf Spreading factor of the signal, 7 to 12.
+     * \param interfererSf Spreading factor of the interference, 7 to 12.
+     * \return The minimum signal to interference ratio (or energy ratio)
+     * for the signal to be received, in dB.
+     */
+    static double GetSirThreshold(uint8_t sf, uint8_t interfererSf);
+
+    /**
+     * Assign a fixed random variable stream number to the shadowing.
+     *
+     * \param stream First stream index to use.
+     * \return The number of stream indices assigned.
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \param sigma Standard deviation of the shadowing, in dB.
+     */
+    void SetShadowingSigma(double sigma);
+
+    /**
+     * \return The standard deviation of the shadowing, in dB.
+     */
+    double GetShadowingSigma() const;
+
+    /// Create the shadowing random variable if needed, and set its variance.
+    void CreateShadowing();
+
+    double m_exponent;                     //!< Path loss exponent
+    double m_referenceDistance;            //!< Reference distance, in m
+    double m_referenceLoss;                //!< Path loss at the reference distance, in dB
+    double m_shadowingSigma;               //!< Standard deviation of the shadowing, in dB
+    Ptr<NormalRandomVariable> m_shadowing; //!< Shadowing, in dB, if enabled
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* LORA_LINK_BUDGET_H */
@@ -0,0 +1,155 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "qoca-policy.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("QocaPolicy");
+NS_OBJECT_ENSURE_REGISTERED(QocaPolicy);
+
+TypeId
+QocaPolicy::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::lorawan::QocaPolicy")
+            .SetParent<BanditPolicy>()
+            .SetGroupName("LorawanLearning")
+            .AddConstructor<QocaPolicy>()
+            .AddAttribute("Alpha",
+                          "Exploration factor",
+                          DoubleValue(1.9),
+                          MakeDoubleAccessor(&QocaPolicy::m_alpha),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("Beta",
+                          "Weight of the channel quality in the score (0 for UCB)",
+                          DoubleValue(0.9),
+                          MakeDoubleAccessor(&QocaPolicy::m_beta),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("Lambda",
+                          "Discount factor of the rewards (1 for QoC-A, below 1 for DQoC-A)",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&QocaPolicy::SetLambda, &QocaPolicy::GetLambda),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("LambdaG",
+                          "Discount factor of the channel qualities (1 for QoC-A, below 1 for "
+                          "DQoC-A)",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&QocaPolicy::SetLambdaG, &QocaPolicy::GetLambdaG),
+                          MakeDoubleChecker<double>(0.0, 1.0));
+    return tid;
+}
+
+QocaPolicy::QocaPolicy()
+    : m_alpha(1.9),
+      m_beta(0.9),
+      m_lambda(1.0),
+      m_lambdaG(1.0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+QocaPolicy::~QocaPolicy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+QocaPolicy::SetLambda(double lambda)
+{
+    NS_LOG_FUNCTION(this << lambda);
+    m_lambda = lambda;
+    SetDiscounts(m_lambda, m_lambdaG);
+}
+
+double
+QocaPolicy::GetLambda() const
+{
+    return m_lambda;
+}
+
+void
+QocaPolicy::SetLambdaG(double lambdaG)
+{
+    NS_LOG_FUNCTION(this << lambdaG);
+    m_lambdaG = lambdaG;
+    SetDiscounts(m_lambda, m_lambdaG);
+}
+
+double
+QocaPolicy::GetLambdaG() const
+{
+    return m_lambdaG;
+}
+
+void
+QocaPolicy::ScoreArms(uint32_t deviceId, double* scores) const
+{
+    std::size_t row = RowOffset(deviceId);
+    const double* pulls = &m_pulls[row];
+    const double* rewardSum = &m_rewardSum[row];
+    const double* qualityPulls = &m_qualityPulls[row];
+    const double* qualitySum = &m_qualitySum[row];
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // ln(n) for QoC-A, ln(W(n)) with the discounted number of pulls for DQoC-A
+    double logN;
+    if (m_lambda < 1.0)
+    {
+        double w = 0.0;
+        for (uint32_t arm = 0; arm < m_nArms; arm++)
+        {
+            w += pulls[arm];
+        }
+        logN = std::log(std::max(w, 1.0));
+    }
+    else
+    {
+        logN = std::log(static_cast<double>(m_totalPulls[deviceId] + 1));
+    }
+
+    double gMax = 0.0;
+    for (uint32_t arm = 0; arm < m_nArms; arm++)
+    {
+        double quality = qualityPulls[arm] > 0.0 ? qualitySum[arm] / qualityPulls[arm] : 0.0;
+        gMax = std::max(gMax, quality);
+    }
+    const double qualityWeight = gMax > 0.0 ? m_beta / gMax : 0.0;
+    const double qualityOffset = gMax > 0.0 ? m_beta : 0.0;
+
+    for (uint32_t arm = 0; arm < m_nArms; arm++)
+    {
+        double n = pulls[arm] > 0.0 ? pulls[arm] : 1.0;
+        double qp = qualityPulls[arm] > 0.0 ? qualityPulls[arm] : 1.0;
+        double confidence = logN / n;
+        // beta * (G_i / G_max - 1) * ln(n) / T_i
+        double q = (qualityWeight * (qualitySum[arm] / qp) - qualityOffset) * confidence;
+        double score = rewardSum[arm] / n + q + m_alpha * std::sqrt(confidence);
+        scores[arm] = pulls[arm] > 0.0 ? score : infinity;
+    }
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QOCA_POLICY_H
+#define QOCA_POLICY_H
+
+#include "bandit-policy.h"
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Quality of Channel Allocation policy (QoC-A) and its discounted
+ * version for non-stationary channels (DQoC-A).
+ *
+ * The score of arm i at the n-th selection of a device is
+ * \f$ R_i + \beta (G_i / G_{max} - 1) \frac{\ln n}{T_i} + \alpha \sqrt{\frac{\ln n}{T_i}} \f$,
+ * where \f$ R_i \f$ is the mean reward of the arm, \f$ G_i \f$ the mean channel
+ * quality observed on the arm, \f$ G_{max} \f$ the best quality among the arms
+ * of the device and \f$ T_i \f$ the number of pulls of the arm.
+ *
+ * When Lambda (resp. LambdaG) is below 1, the rewards and pulls (resp. the
+ * qualities) are discounted at each update and \f$ n \f$ is replaced by the
+ * discounted number of pulls of the device (DQoC-A). With Beta = 0 the policy
+ * reduces to UCB (or D-UCB).
+ *
+ * The discounted sums are maintained incrementally, so both the updates and
+ * the selections cost O(arms) whatever the number of past pulls.
+ */
+class QocaPolicy : public BanditPolicy
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    QocaPolicy();
+    ~QocaPolicy() override;
+
+    /**
+     * \param lambda Discount factor of the rewards, 1 for QoC-A.
+     */
+    void SetLambda(double lambda);
+
+    /**
+     * \return The discount factor of the rewards.
+     */
+    double GetLambda() const;
+
+    /**
+     * \param lambdaG Discount factor of the channel qualities, 1 for QoC-A.
+     */
+    void SetLambdaG(double lambdaG);
+
+    /**
+     * \return The discount factor of the channel qualities.
+     */
+    double GetLambdaG() const;
+
+  protected:
+    void ScoreArms(uint32_t deviceId, double* scores) const override;
+
+  private:
+    double m_alpha;   //!< Exploration factor
+    double m_beta;    //!< Weight of the channel quality
+    double m_lambda;  //!< Discount factor of the rewards
+    double m_lambdaG; //!< Discount factor of the channel qualities
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* QOCA_POLICY_H */
@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tow-policy.h"
+
+#include "ns3/assert.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+
+#include <cmath>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("TowPolicy");
+NS_OBJECT_ENSURE_REGISTERED(TowPolicy);
+
+TypeId
+TowPolicy::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lorawan::TowPolicy")
+                            .SetParent<BanditPolicy>()
+                            .SetGroupName("LorawanLearning")
+                            .AddConstructor<TowPolicy>()
+                            .AddAttribute("Alpha",
+                                          "Discount factor of the ToW values",
+                                          DoubleValue(0.9),
+                                          MakeDoubleAccessor(&TowPolicy::m_alpha),
+                                          MakeDoubleChecker<double>(0.0, 1.0))
+                            .AddAttribute("Beta",
+                                          "Forgetting factor of the pull counters",
+                                          DoubleValue(0.9),
+                                          MakeDoubleAccessor(&TowPolicy::m_beta),
+                                          MakeDoubleChecker<double>(0.0, 1.0))
+                            .AddAttribute("Amplitude",
+                                          "Amplitude of the oscillation added to the scores",
+                                          DoubleValue(0.5),
+                                          MakeDoubleAccessor(&TowPolicy::m_amplitude),
+                                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+TowPolicy::TowPolicy()
+    : m_alpha(0.9),
+      m_beta(0.9),
+      m_amplitude(0.5)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TowPolicy::~TowPolicy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TowPolicy::SetDimensions(uint32_t nDevices, uint32_t nArms)
+{
+    NS_LOG_FUNCTION(this << nDevices << nArms);
+    BanditPolicy::SetDimensions(nDevices, nArms);
+    m_value.assign(m_pulls.size(), 0.0);
+}
+
+double
+TowPolicy::GetValue(uint32_t deviceId, uint32_t arm) const
+{
+    NS_ASSERT_MSG(arm < m_nArms, "Unknown arm " << arm);
+    return m_value[RowOffset(deviceId) + arm];
+}
+
+double
+TowPolicy::CalculatePenalty(std::size_t row) const
+{
+    // Equation (10): uses the two highest success probabilities of the device
+    if (m_nArms < 2)
+    {
+        return 0.1;
+    }
+    double first = -1.0;
+    double second = -1.0;
+    for (uint32_t arm = 0; arm < m_nArms; arm++)
+    {
+        double n = m_pulls[row + arm];
+        double p = n > 0.0 ? m_rewardSum[row + arm] / n : 0.0;
+        if (p > first)
+        {
+            second = first;
+            first = p;
+        }
+        else if (p > second)
+        {
+            second = p;
+        }
+    }
+    if (first == second)
+    {
+        return 0.1;
+    }
+    return (first + second) / 2.0 - (first - second);
+}
+
+void
+TowPolicy::Update(uint32_t deviceId, uint32_t arm, double reward, double quality)
+{
+    NS_LOG_FUNCTION(this << deviceId << arm << reward << quality);
+    NS_ASSERT_MSG(arm < m_nArms, "Unknown arm " << arm);
+    std::size_t row = RowOffset(deviceId);
+
+    if (reward > 0.0)
+    {
+        m_value[row + arm] = m_alpha * m_value[row + arm] + 1.0;
+        m_rewardSum[row + arm] += 1.0;
+    }
+    else
+    {
+        m_value[row + arm] = m_alpha * m_value[row + arm] - CalculatePenalty(row);
+    }
+
+    double* pulls = &m_pulls[row];
+    for (uint32_t a = 0; a < m_nArms; a++)
+    {
+        pulls[a] *= m_beta;
+    }
+    pulls[arm] += 1.0;
+    m_qualityPulls[row + arm] += 1.0;
+    m_qualitySum[row + arm] += quality;
+    m_totalPulls[deviceId]++;
+}
+
+void
+TowPolicy::ScoreArms(uint32_t deviceId, double* scores) const
+{
+    std::size_t row = RowOffset(deviceId);
+    const double* value = &m_value[row];
+    double sum = 0.0;
+    for (uint32_t arm = 0; arm < m_nArms; arm++)
+    {
+        sum += value[arm];
+    }
+    const double othersWeight = m_nArms > 1 ? 1.0 / (m_nArms - 1) : 0.0;
+    const double t = static_cast<double>(m_totalPulls[deviceId]);
+    const double phaseStep = 2.0 * M_PI / m_nArms;
+
+    for (uint32_t arm = 0; arm < m_nArms; arm++)
+    {
+        double others = (sum - value[arm]) * othersWeight;
+        scores[arm] = value[arm] - others + m_amplitude * std::cos(phaseStep * (t + arm));
+    }
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,81 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TOW_POLICY_H
+#define TOW_POLICY_H
+
+#include "bandit-policy.h"
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Tug-of-War dynamics policy (ToW).
+ *
+ * Each arm k of a device has a value \f$ Q_k \f$, multiplied by Alpha at each
+ * pull of the arm and increased by 1 on success, or decreased by a penalty
+ * computed from the two best success probabilities on failure. The score of
+ * arm k at the t-th selection of a device with D arms is
+ * \f$ Q_k - \frac{1}{D-1} \sum_{i \neq k} Q_i + A \cos(2 \pi (t + k) / D) \f$.
+ *
+ * The pull counters used by the success probabilities are multiplied by Beta
+ * (forgetting factor) at each update. A reward above zero counts as a success.
+ */
+class TowPolicy : public BanditPolicy
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    TowPolicy();
+    ~TowPolicy() override;
+
+    void SetDimensions(uint32_t nDevices, uint32_t nArms) override;
+    void Update(uint32_t deviceId, uint32_t arm, double reward, double quality = 0.0) override;
+
+    /**
+     * \param deviceId The device.
+     * \param arm The arm.
+     * \return The ToW value \f$ Q_k \f$ of the arm.
+     */
+    double GetValue(uint32_t deviceId, uint32_t arm) const;
+
+  protected:
+    void ScoreArms(uint32_t deviceId, double* scores) const override;
+
+  private:
+    /**
+     * \param row Offset of the device in the statistics arrays.
+     * \return The penalty of a failed pull.
+     */
+    double CalculatePenalty(std::size_t row) const;
+
+    double m_alpha;          //!< Discount factor of the values
+    double m_beta;           //!< Forgetting factor of the pull counters
+    double m_amplitude;      //!< Amplitude of the oscillation
+    std::vector<double> m_value; //!< ToW values, per device and arm
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* TOW_POLICY_H */
@@ -0,0 +1,77 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ucb1-tuned-policy.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("Ucb1TunedPolicy");
+NS_OBJECT_ENSURE_REGISTERED(Ucb1TunedPolicy);
+
+TypeId
+Ucb1TunedPolicy::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lorawan::Ucb1TunedPolicy")
+                            .SetParent<BanditPolicy>()
+                            .SetGroupName("LorawanLearning")
+                            .AddConstructor<Ucb1TunedPolicy>();
+    return tid;
+}
+
+Ucb1TunedPolicy::Ucb1TunedPolicy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ucb1TunedPolicy::~Ucb1TunedPolicy()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+Ucb1TunedPolicy::ScoreArms(uint32_t deviceId, double* scores) const
+{
+    std::size_t row = RowOffset(deviceId);
+    const double* pulls = &m_pulls[row];
+    const double* rewardSum = &m_rewardSum[row];
+    const double* rewardSqSum = &m_rewardSqSum[row];
+    const double logT = std::log(std::max<double>(m_totalPulls[deviceId], 1.0));
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // Branch-free on purpose: unexplored arms are masked at the end of the iteration
+    for (uint32_t arm = 0; arm < m_nArms; arm++)
+    {
+        double n = std::max(pulls[arm], 1.0);
+        double mean = rewardSum[arm] / n;
+        double variance = std::max((rewardSqSum[arm] - n * mean * mean) / std::max(n - 1.0, 1.0),
+                                   0.0);
+        double confidence = logT / n;
+        double v = variance + std::sqrt(2.0 * confidence);
+        double score = mean + std::sqrt(confidence * std::min(0.25, v));
+        scores[arm] = pulls[arm] > 0.0 ? score : infinity;
+    }
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef UCB1_TUNED_POLICY_H
+#define UCB1_TUNED_POLICY_H
+
+#include "bandit-policy.h"
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief UCB1-Tuned policy (Auer et al., 2002).
+ *
+ * The score of arm i of a device that was pulled t times in total is
+ * \f$ \bar{X}_i + \sqrt{\frac{\ln t}{n_i} \min(1/4, V_i)} \f$, with
+ * \f$ V_i = \sigma_i^2 + \sqrt{2 \ln t / n_i} \f$ and \f$ \sigma_i^2 \f$
+ * the sample variance of the rewards of the arm.
+ */
+class Ucb1TunedPolicy : public BanditPolicy
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    Ucb1TunedPolicy();
+    ~Ucb1TunedPolicy() override;
+
+  protected:
+    void ScoreArms(uint32_t deviceId, double* scores) const override;
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* UCB1_TUNED_POLICY_H */
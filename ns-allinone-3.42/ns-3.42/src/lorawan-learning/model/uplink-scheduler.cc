@@ -0,0 +1,213 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "uplink-scheduler.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+namespace lorawan
+{
+
+NS_LOG_COMPONENT_DEFINE("LorawanUplinkScheduler");
+NS_OBJECT_ENSURE_REGISTERED(UplinkScheduler);
+
+TypeId
+UplinkScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::lorawan::UplinkScheduler")
+                            .SetParent<Object>()
+                            .SetGroupName("LorawanLearning")
+                            .AddConstructor<UplinkScheduler>();
+    return tid;
+}
+
+UplinkScheduler::UplinkScheduler()
+    : m_nDevices(0),
+      m_order(0),
+      m_waking(false),
+      m_wakeups(0),
+      m_deferrals(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+UplinkScheduler::~UplinkScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+UplinkScheduler::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_event.Cancel();
+    m_calendar = decltype(m_calendar)();
+    m_wakeupCallback = MakeNullCallback<void, uint32_t>();
+    Object::DoDispose();
+}
+
+void
+UplinkScheduler::SetDimensions(uint32_t nDevices, const std::vector<double>& dutyCycles)
+{
+    NS_LOG_FUNCTION(this << nDevices << dutyCycles.size());
+    for (double dutyCycle : dutyCycles)
+    {
+        NS_ABORT_MSG_IF(dutyCycle <= 0 || dutyCycle > 1, "Invalid duty cycle " << dutyCycle);
+    }
+    m_nDevices = nDevices;
+    m_dutyCycles = dutyCycles;
+    m_allowed.assign(static_cast<std::size_t>(nDevices) * dutyCycles.size(), Time(0));
+    m_generations.assign(nDevices, 0);
+    m_pending.assign(nDevices, false);
+    m_calendar = decltype(m_calendar)();
+    m_event.Cancel();
+}
+
+std::vector<double>
+UplinkScheduler::GetEu868DutyCycles()
+{
+    return {0.01, 0.01, 0.001, 0.1};
+}
+
+void
+UplinkScheduler::SetWakeupCallback(Callback<void, uint32_t> callback)
+{
+    m_wakeupCallback = callback;
+}
+
+void
+UplinkScheduler::ScheduleWakeup(uint32_t deviceId, Time delay)
+{
+    NS_LOG_FUNCTION(this << deviceId << delay);
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Unknown device " << deviceId);
+    NS_ASSERT_MSG(!delay.IsStrictlyNegative(), "Wakeup in the past");
+    // The previous wakeup of the device, if any, stays in the calendar until
+    // it reaches the top, where its old generation discards it
+    m_pending[deviceId] = true;
+    m_calendar.push({Simulator::Now() + delay, m_order++, deviceId, ++m_generations[deviceId]});
+    ScheduleNext();
+}
+
+void
+UplinkScheduler::CancelWakeup(uint32_t deviceId)
+{
+    NS_LOG_FUNCTION(this << deviceId);
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Unknown device " << deviceId);
+    m_pending[deviceId] = false;
+    ++m_generations[deviceId];
+    ScheduleNext();
+}
+
+Time
+UplinkScheduler::GetNextAllowedTime(uint32_t deviceId, uint32_t subBand) const
+{
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Unknown device " << deviceId);
+    NS_ASSERT_MSG(subBand < m_dutyCycles.size(), "Unknown sub-band " << subBand);
+    return m_allowed[static_cast<std::size_t>(deviceId) * m_dutyCycles.size() + subBand];
+}
+
+bool
+UplinkScheduler::DeferIfBlocked(uint32_t deviceId, uint32_t subBand)
+{
+    NS_LOG_FUNCTION(this << deviceId << subBand);
+    Time allowed = GetNextAllowedTime(deviceId, subBand);
+    if (allowed <= Simulator::Now())
+    {
+        return false;
+    }
+    m_deferrals++;
+    ScheduleWakeup(deviceId, allowed - Simulator::Now());
+    return true;
+}
+
+void
+UplinkScheduler::NotifyTransmission(uint32_t deviceId, uint32_t subBand, Time airtime)
+{
+    NS_LOG_FUNCTION(this << deviceId << subBand << airtime);
+    NS_ASSERT_MSG(deviceId < m_nDevices, "Unknown device " << deviceId);
+    NS_ASSERT_MSG(subBand < m_dutyCycles.size(), "Unknown sub-band " << subBand);
+    m_allowed[static_cast<std::size_t>(deviceId) * m_dutyCycles.size() + subBand] =
+        Simulator::Now() + airtime / m_dutyCycles[subBand];
+}
+
+uint64_t
+UplinkScheduler::GetWakeups() const
+{
+    return m_wakeups;
+}
+
+uint64_t
+UplinkScheduler::GetDeferrals() const
+{
+    return m_deferrals;
+}
+
+void
+UplinkScheduler::ScheduleNext()
+{
+    if (m_waking)
+    {
+        // Wake () schedules the next event once all the due wakeups are delivered
+        return;
+    }
+    while (!m_calendar.empty() &&
+           (!m_pending[m_calendar.top().deviceId] ||
+            m_calendar.top().generation != m_generations[m_calendar.top().deviceId]))
+    {
+        m_calendar.pop();
+    }
+    if (m_calendar.empty())
+    {
+        m_event.Cancel();
+        return;
+    }
+    Time next = m_calendar.top().time;
+    if (m_event.IsPending() && m_eventTime == next)
+    {
+        return;
+    }
+    m_event.Cancel();
+    m_eventTime = next;
+    m_event = Simulator::Schedule(next - Simulator::Now(), &UplinkScheduler::Wake, this);
+}
+
+void
+UplinkScheduler::Wake()
+{
+    NS_LOG_FUNCTION(this);
+    m_waking = true;
+    while (!m_calendar.empty() && m_calendar.top().time <= Simulator::Now())
+    {
+        Wakeup wakeup = m_calendar.top();
+        m_calendar.pop();
+        if (!m_pending[wakeup.deviceId] || wakeup.generation != m_generations[wakeup.deviceId])
+        {
+            continue;
+        }
+        m_pending[wakeup.deviceId] = false;
+        m_wakeups++;
+        m_wakeupCallback(wakeup.deviceId);
+    }
+    m_waking = false;
+    ScheduleNext();
+}
+
+} // namespace lorawan
+} // namespace ns3
@@ -0,0 +1,184 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LORAWAN_UPLINK_SCHEDULER_H
+#define LORAWAN_UPLINK_SCHEDULER_H
+
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace ns3
+{
+namespace lorawan
+{
+
+/**
+ * \ingroup lorawan-learning
+ *
+ * \brief Duty-cycle-aware scheduler of the uplinks of a population of end
+ * devices.
+ *
+ * The wakeups of all the devices are kept in a single calendar (a binary
+ * heap ordered by time, then by scheduling order), and only the earliest one
+ * is in the simulator event list: scheduling a wakeup costs no event
+ * allocation, and rescheduling the wakeup of a device drops the previous one
+ * lazily.
+ *
+ * The duty cycle is enforced per device and per sub-band, as in the EU868
+ * regional parameters: after a transmission of airtime T at time t on a
+ * sub-band of duty cycle d, the device may not use the sub-band again before
+ * t + T / d. GetNextAllowedTime () gives this instant in closed form, so a
+ * device whose uplink is deferred by the duty cycle is woken up once, when it
+ * may transmit, instead of checking and rescheduling until the sub-band is
+ * free.
+ */
+class UplinkScheduler : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    UplinkScheduler();
+    ~UplinkScheduler() override;
+
+    /**
+     * Allocate the state of a population of devices, with no pending wakeup
+     * and every sub-band available.
+     *
+     * \param nDevices Number of devices, identified by 0..nDevices-1.
+     * \param dutyCycles Duty cycle of each sub-band, in (0, 1].
+     */
+    void SetDimensions(uint32_t nDevices, const std::vector<double>& dutyCycles);
+
+    /**
+     * \return The duty cycles of the EU868 sub-bands g (868.0-868.6 MHz),
+     * g1 (868.7-869.2 MHz), g2 (869.4-869.65 MHz) and g3 (869.7-870.0 MHz).
+     */
+    static std::vector<double> GetEu868DutyCycles();
+
+    /**
+     * \param callback Called with the identifier of a device when it wakes up.
+     */
+    void SetWakeupCallback(Callback<void, uint32_t> callback);
+
+    /**
+     * Wake a device up after a delay, replacing its pending wakeup, if any.
+     *
+     * \param deviceId The device.
+     * \param delay The delay from now.
+     */
+    void ScheduleWakeup(uint32_t deviceId, Time delay);
+
+    /**
+     * Cancel the pending wakeup of a device, if any.
+     *
+     * \param deviceId The device.
+     */
+    void CancelWakeup(uint32_t deviceId);
+
+    /**
+     * \param deviceId The device.
+     * \param subBand The sub-band.
+     * \return The earliest time the device may transmit on the sub-band,
+     * which is in the past if it may transmit now.
+     */
+    Time GetNextAllowedTime(uint32_t deviceId, uint32_t subBand) const;
+
+    /**
+     * Wake a device up when it may transmit on a sub-band, if it may not
+     * transmit now.
+     *
+     * \param deviceId The device.
+     * \param subBand The sub-band it wants to transmit on.
+     * \return Whether the uplink was deferred.
+     */
+    bool DeferIfBlocked(uint32_t deviceId, uint32_t subBand);
+
+    /**
+     * Record a transmission starting now, which blocks the sub-band for the
+     * device until now + airtime / dutyCycle.
+     *
+     * \param deviceId The device.
+     * \param subBand The sub-band.
+     * \param airtime The time on air of the transmission.
+     */
+    void NotifyTransmission(uint32_t deviceId, uint32_t subBand, Time airtime);
+
+    /**
+     * \return The number of wakeups delivered so far.
+     */
+    uint64_t GetWakeups() const;
+
+    /**
+     * \return The number of uplinks deferred by DeferIfBlocked () so far.
+     */
+    uint64_t GetDeferrals() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A wakeup in the calendar
+    struct Wakeup
+    {
+        Time time;           //!< When the device wakes up
+        uint64_t order;      //!< Scheduling order, to break ties
+        uint32_t deviceId;   //!< The device
+        uint32_t generation; //!< Generation of the wakeups of the device
+
+        /**
+         * \param other Another wakeup.
+         * \return Whether this wakeup comes after the other one.
+         */
+        bool operator>(const Wakeup& other) const
+        {
+            return time > other.time || (time == other.time && order > other.order);
+        }
+    };
+
+    /// Schedule the simulator event of the earliest wakeup, if it changed.
+    void ScheduleNext();
+
+    /// Deliver the wakeups that are due.
+    void Wake();
+
+    uint32_t m_nDevices;                       //!< Number of devices
+    std::vector<double> m_dutyCycles;          //!< Duty cycle of each sub-band
+    std::vector<Time> m_allowed;               //!< Next allowed time, per device and sub-band
+    std::vector<uint32_t> m_generations;       //!< Current wakeup generation, per device
+    std::vector<bool> m_pending;               //!< Whether a wakeup is pending, per device
+    std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<>> m_calendar; //!< Wakeups
+    uint64_t m_order;                          //!< Order of the next scheduled wakeup
+    EventId m_event;                           //!< Simulator event of the earliest wakeup
+    Time m_eventTime;                          //!< Time of m_event
+    bool m_waking;                             //!< Whether Wake () is delivering wakeups
+    Callback<void, uint32_t> m_wakeupCallback; //!< Called for each wakeup
+    uint64_t m_wakeups;                        //!< Number of wakeups delivered
+    uint64_t m_deferrals;                      //!< Number of deferred uplinks
+};
+
+} // namespace lorawan
+} // namespace ns3
+
+#endif /* LORAWAN_UPLINK_SCHEDULER_H */
@@ -0,0 +1,804 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/adr-margin-statistics.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/interval-packet-tracker.h"
+#include "ns3/lora-airtime.h"
+#include "ns3/lora-link-budget.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/qoca-policy.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/tow-policy.h"
+#include "ns3/ucb1-tuned-policy.h"
+#include "ns3/uinteger.h"
+#include "ns3/uplink-scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \defgroup lorawan-learning-tests Tests for the LoRaWAN learning module
+ * \ingroup lorawan-learning
+ * \ingroup tests
+ */
+
+using namespace ns3;
+using namespace lorawan;
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief UCB1-Tuned explores every arm once, then matches a scalar reference
+ * implementation of the score.
+ */
+class Ucb1TunedPolicyTestCase : public TestCase
+{
+  public:
+    Ucb1TunedPolicyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ucb1TunedPolicyTestCase::Ucb1TunedPolicyTestCase()
+    : TestCase("UCB1-Tuned exploration and scores")
+{
+}
+
+void
+Ucb1TunedPolicyTestCase::DoRun()
+{
+    const uint32_t nArms = 5;
+    Ptr<Ucb1TunedPolicy> policy = CreateObject<Ucb1TunedPolicy>();
+    policy->SetDimensions(1, nArms);
+
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(1);
+
+    // Reference statistics, kept as reward histories like the scratch simulations do
+    std::vector<std::vector<double>> rewards(nArms);
+    uint32_t total = 0;
+
+    for (uint32_t step = 0; step < 500; step++)
+    {
+        uint32_t expected = 0;
+        double bestScore = -std::numeric_limits<double>::infinity();
+        for (uint32_t arm = 0; arm < nArms; arm++)
+        {
+            double score = std::numeric_limits<double>::infinity();
+            if (!rewards[arm].empty())
+            {
+                double n = rewards[arm].size();
+                double mean = 0.0;
+                for (double r : rewards[arm])
+                {
+                    mean += r / n;
+                }
+                double variance = 0.0;
+                for (double r : rewards[arm])
+                {
+                    variance += (r - mean) * (r - mean);
+                }
+                variance = n > 1 ? variance / (n - 1) : 0.0;
+                double v = variance + std::sqrt(2.0 * std::log(total) / n);
+                score = mean + std::sqrt(std::log(total) / n * std::min(0.25, v));
+            }
+            if (score > bestScore)
+            {
+                bestScore = score;
+                expected = arm;
+            }
+        }
+
+        uint32_t selected = policy->SelectArm(0);
+        if (step < nArms)
+        {
+            NS_TEST_ASSERT_MSG_EQ(selected, step, "Arms are not explored in order");
+        }
+        NS_TEST_ASSERT_MSG_EQ(selected, expected, "Selection differs from the reference at " << step);
+
+        // Arm 3 is the best one on average
+        double reward = random->GetValue() < (selected == 3 ? 0.8 : 0.3) ? 1.0 : 0.0;
+        policy->Update(0, selected, reward);
+        rewards[selected].push_back(reward);
+        total++;
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(policy->GetTotalPulls(0), total, "Wrong number of pulls");
+    NS_TEST_ASSERT_MSG_GT(policy->GetPulls(0, 3), 250.0, "The best arm is not exploited");
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief The incremental QoC-A and DQoC-A policies select the same channels
+ * as the history-based formulation of the algorithms.
+ */
+class QocaPolicyTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param lambda Discount factor of the rewards.
+     * \param lambdaG Discount factor of the qualities.
+     */
+    QocaPolicyTestCase(double lambda, double lambdaG);
+
+  private:
+    void DoRun() override;
+
+    double m_lambda;  //!< Discount factor of the rewards
+    double m_lambdaG; //!< Discount factor of the qualities
+};
+
+QocaPolicyTestCase::QocaPolicyTestCase(double lambda, double lambdaG)
+    : TestCase(lambda < 1.0 ? "DQoC-A against the history-based reference"
+                            : "QoC-A against the history-based reference"),
+      m_lambda(lambda),
+      m_lambdaG(lambdaG)
+{
+}
+
+void
+QocaPolicyTestCase::DoRun()
+{
+    const uint32_t nArms = 8;
+    const double alpha = 0.6;
+    const double beta = 0.2;
+    Ptr<QocaPolicy> policy = CreateObjectWithAttributes<QocaPolicy>("Alpha",
+                                                                    DoubleValue(alpha),
+                                                                    "Beta",
+                                                                    DoubleValue(beta),
+                                                                    "Lambda",
+                                                                    DoubleValue(m_lambda),
+                                                                    "LambdaG",
+                                                                    DoubleValue(m_lambdaG));
+    policy->SetDimensions(1, nArms);
+
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(2);
+
+    std::vector<uint32_t> history;
+    std::vector<double> rewards;
+    std::vector<double> qualities;
+
+    for (uint32_t step = 0; step < 400; step++)
+    {
+        // Discounted counts and means computed from the whole history
+        std::vector<double> n(nArms, 0.0);
+        std::vector<double> ng(nArms, 0.0);
+        std::vector<double> r(nArms, 0.0);
+        std::vector<double> g(nArms, 0.0);
+        for (std::size_t j = 0; j < history.size(); j++)
+        {
+            double age = history.size() - 1 - j;
+            double discount = std::pow(m_lambda, age);
+            double discountG = std::pow(m_lambdaG, age);
+            n[history[j]] += discount;
+            ng[history[j]] += discountG;
+            r[history[j]] += discount * rewards[j];
+            g[history[j]] += discountG * qualities[j];
+        }
+        double w = 0.0;
+        double gMax = 0.0;
+        for (uint32_t arm = 0; arm < nArms; arm++)
+        {
+            w += n[arm];
+            if (ng[arm] > 0.0)
+            {
+                gMax = std::max(gMax, g[arm] / ng[arm]);
+            }
+        }
+        double logN = m_lambda < 1.0 ? std::log(std::max(w, 1.0)) : std::log(history.size() + 1);
+
+        uint32_t expected = 0;
+        double bestScore = -std::numeric_limits<double>::infinity();
+        for (uint32_t arm = 0; arm < nArms; arm++)
+        {
+            double score = std::numeric_limits<double>::infinity();
+            if (n[arm] > 0.0)
+            {
+                double q = gMax > 0.0 ? beta * (g[arm] / ng[arm] / gMax - 1.0) * logN / n[arm]
+                                      : 0.0;
+                score = r[arm] / n[arm] + q + alpha * std::sqrt(logN / n[arm]);
+            }
+            if (score > bestScore)
+            {
+                bestScore = score;
+                expected = arm;
+            }
+        }
+
+        uint32_t selected = policy->SelectArm(0);
+        NS_TEST_ASSERT_MSG_EQ(selected, expected, "Selection differs from the reference at " << step);
+
+        // The channel qualities drift after half of the run (non-stationary scenario)
+        double quality = (step < 200 ? selected : nArms - selected) / double(nArms) +
+                         0.1 * random->GetValue();
+        double reward = random->GetValue() < quality ? 1.0 : 0.0;
+        policy->Update(0, selected, reward, quality);
+        history.push_back(selected);
+        rewards.push_back(reward);
+        qualities.push_back(quality);
+    }
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief ToW values, penalties and oscillation.
+ */
+class TowPolicyTestCase : public TestCase
+{
+  public:
+    TowPolicyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TowPolicyTestCase::TowPolicyTestCase()
+    : TestCase("ToW values and scores")
+{
+}
+
+void
+TowPolicyTestCase::DoRun()
+{
+    const double tolerance = 1e-12;
+    Ptr<TowPolicy> policy = CreateObjectWithAttributes<TowPolicy>("Alpha",
+                                                                  DoubleValue(0.5),
+                                                                  "Beta",
+                                                                  DoubleValue(1.0),
+                                                                  "Amplitude",
+                                                                  DoubleValue(0.0));
+    policy->SetDimensions(1, 3);
+
+    // Successes on arm 0, then a failure on arm 1
+    policy->Update(0, 0, 1.0);
+    policy->Update(0, 0, 1.0);
+    NS_TEST_ASSERT_MSG_EQ_TOL(policy->GetValue(0, 0), 1.5, tolerance, "Wrong value after successes");
+    NS_TEST_ASSERT_MSG_EQ(policy->SelectArm(0), 0, "The successful arm is not selected");
+
+    // Success probabilities are 1 (arm 0) and 0 (arms 1, 2): penalty = 0.5 - 1
+    policy->Update(0, 1, 0.0);
+    NS_TEST_ASSERT_MSG_EQ_TOL(policy->GetValue(0, 1), 0.5, tolerance, "Wrong penalty");
+
+    // Equal probabilities give the default penalty
+    Ptr<TowPolicy> fresh = CreateObject<TowPolicy>();
+    fresh->SetDimensions(1, 3);
+    fresh->Update(0, 2, 0.0);
+    NS_TEST_ASSERT_MSG_EQ_TOL(fresh->GetValue(0, 2), -0.1, tolerance, "Wrong default penalty");
+
+    // A dominant oscillation makes the device cycle through the arms
+    Ptr<TowPolicy> oscillating =
+        CreateObjectWithAttributes<TowPolicy>("Amplitude", DoubleValue(100.0));
+    oscillating->SetDimensions(1, 4);
+    NS_TEST_ASSERT_MSG_EQ(oscillating->SelectArm(0), 0, "Wrong arm at t = 0");
+    oscillating->Update(0, 0, 0.0);
+    NS_TEST_ASSERT_MSG_EQ(oscillating->SelectArm(0), 3, "Wrong arm at t = 1");
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief Batched selections match per-device selections and the devices do
+ * not share their statistics.
+ */
+class BatchSelectionTestCase : public TestCase
+{
+  public:
+    BatchSelectionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BatchSelectionTestCase::BatchSelectionTestCase()
+    : TestCase("Batched arm selection")
+{
+}
+
+void
+BatchSelectionTestCase::DoRun()
+{
+    const uint32_t nDevices = 64;
+    const uint32_t nArms = 6;
+    std::vector<Ptr<BanditPolicy>> policies = {CreateObject<Ucb1TunedPolicy>(),
+                                               CreateObject<QocaPolicy>(),
+                                               CreateObject<TowPolicy>()};
+
+    Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable>();
+    random->SetStream(3);
+
+    std::vector<uint32_t> deviceIds;
+    for (uint32_t device = 0; device < nDevices; device++)
+    {
+        deviceIds.push_back(device);
+    }
+
+    for (auto& policy : policies)
+    {
+        policy->SetDimensions(nDevices, nArms);
+        std::vector<uint32_t> arms;
+        for (uint32_t round = 0; round < 50; round++)
+        {
+            policy->SelectArms(deviceIds, arms);
+            NS_TEST_ASSERT_MSG_EQ(arms.size(), nDevices, "Wrong number of selections");
+            for (uint32_t device = 0; device < nDevices; device++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(arms[device],
+                                      policy->SelectArm(device),
+                                      "Batched and single selections differ");
+                // Only the first half of the devices ever gets a reward
+                double reward = device < nDevices / 2 ? random->GetValue() : 0.0;
+                policy->Update(device, arms[device], reward, random->GetValue());
+            }
+        }
+        for (uint32_t device = 0; device < nDevices; device++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(policy->GetTotalPulls(device), 50, "Wrong number of pulls");
+            for (uint32_t arm = 0; arm < nArms && device >= nDevices / 2; arm++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(policy->GetMeanReward(device, arm),
+                                      0.0,
+                                      "Rewards leaked between devices");
+            }
+        }
+
+        policy->Reset();
+        NS_TEST_ASSERT_MSG_EQ(policy->GetTotalPulls(0), 0, "Reset did not clear the statistics");
+    }
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief The airtime table matches the time on air computed directly and
+ * known reference values.
+ */
+class LoraAirtimeTableTestCase : public TestCase
+{
+  public:
+    LoraAirtimeTableTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LoraAirtimeTableTestCase::LoraAirtimeTableTestCase()
+    : TestCase("Compile-time LoRa airtime table")
+{
+}
+
+void
+LoraAirtimeTableTestCase::DoRun()
+{
+    // The table is usable in constant expressions
+    static_assert(LoraAirtimeTable::GetTimeOnAir(7, 125000, 1, 20) > 0);
+
+    // Reference values of the Semtech LoRa calculator
+    NS_TEST_EXPECT_MSG_EQ_TOL(LoraAirtimeTable::GetTimeOnAir(7, 125000, 1, 50),
+                              0.097536,
+                              1e-9,
+                              "Wrong SF7 airtime");
+    NS_TEST_EXPECT_MSG_EQ_TOL(LoraAirtimeTable::GetTimeOnAir(12, 125000, 1, 51),
+                              2.465792,
+                              1e-9,
+                              "Wrong SF12 airtime (low data rate optimization)");
+
+    for (uint8_t sf = LoraAirtimeTable::MIN_SF; sf <= LoraAirtimeTable::MAX_SF; sf++)
+    {
+        for (uint32_t bandwidth : LoraAirtimeTable::BANDWIDTHS)
+        {
+            for (uint8_t cr = 1; cr <= LoraAirtimeTable::MAX_CODING_RATE; cr++)
+            {
+                for (uint32_t payload = 0; payload <= LoraAirtimeTable::MAX_PAYLOAD; payload++)
+                {
+                    NS_TEST_ASSERT_MSG_EQ(LoraAirtimeTable::GetTimeOnAir(sf, bandwidth, cr, payload),
+                                          LoraTimeOnAir(sf, bandwidth, cr, payload),
+                                          "Wrong table entry for SF" << +sf << ", " << bandwidth
+                                                                     << " Hz, CR " << +cr << ", "
+                                                                     << payload << " bytes");
+                }
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(LoraAirtimeTable::GetEnergy(9, 250000, 2, 30, 0.05),
+                              0.05 * LoraTimeOnAir(9, 250000, 2, 30),
+                              1e-12,
+                              "Wrong energy");
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief The uplink scheduler wakes the devices up in time order, replaces
+ * and cancels pending wakeups, and defers the uplinks blocked by the duty
+ * cycle until the sub-band is available.
+ */
+class UplinkSchedulerTestCase : public TestCase
+{
+  public:
+    UplinkSchedulerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record a wakeup.
+     * \param deviceId The device.
+     */
+    void Wakeup(uint32_t deviceId);
+
+    std::vector<std::pair<uint32_t, Time>> m_wakeups; //!< Devices woken up, and when
+};
+
+UplinkSchedulerTestCase::UplinkSchedulerTestCase()
+    : TestCase("Duty-cycle-aware uplink scheduler")
+{
+}
+
+void
+UplinkSchedulerTestCase::Wakeup(uint32_t deviceId)
+{
+    m_wakeups.emplace_back(deviceId, Simulator::Now());
+}
+
+void
+UplinkSchedulerTestCase::DoRun()
+{
+    Ptr<UplinkScheduler> scheduler = CreateObject<UplinkScheduler>();
+    scheduler->SetDimensions(4, {0.01, 0.1});
+    scheduler->SetWakeupCallback(MakeCallback(&UplinkSchedulerTestCase::Wakeup, this));
+
+    scheduler->ScheduleWakeup(0, Seconds(5));
+    scheduler->ScheduleWakeup(1, Seconds(2));
+    scheduler->ScheduleWakeup(2, Seconds(2));
+    scheduler->ScheduleWakeup(3, Seconds(3));
+    // Replaced, then cancelled
+    scheduler->ScheduleWakeup(0, Seconds(1));
+    scheduler->CancelWakeup(3);
+
+    // A 1 s uplink at t = 0 blocks the 1% sub-band for 100 s, not the other
+    scheduler->NotifyTransmission(1, 0, Seconds(1));
+    NS_TEST_ASSERT_MSG_EQ(scheduler->GetNextAllowedTime(1, 0),
+                          Seconds(100),
+                          "Wrong duty cycle");
+    NS_TEST_ASSERT_MSG_EQ(scheduler->GetNextAllowedTime(1, 1), Seconds(0), "Wrong sub-band");
+    NS_TEST_ASSERT_MSG_EQ(scheduler->DeferIfBlocked(1, 1), false, "Free sub-band deferred");
+    Simulator::Schedule(Seconds(10), [scheduler]() { scheduler->DeferIfBlocked(1, 0); });
+
+    Simulator::Run();
+
+    std::vector<std::pair<uint32_t, Time>> expected = {{0, Seconds(1)},
+                                                       {1, Seconds(2)},
+                                                       {2, Seconds(2)},
+                                                       {1, Seconds(100)}};
+    NS_TEST_ASSERT_MSG_EQ(m_wakeups.size(), expected.size(), "Wrong number of wakeups");
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_wakeups[i].first, expected[i].first, "Wrong device woken up");
+        NS_TEST_EXPECT_MSG_EQ(m_wakeups[i].second, expected[i].second, "Wrong wakeup time");
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->GetWakeups(), expected.size(), "Wrong wakeup count");
+    NS_TEST_EXPECT_MSG_EQ(scheduler->GetDeferrals(), 1, "Wrong deferral count");
+
+    scheduler->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief The interval tracker aggregates the packets and their outcomes per
+ * interval and per gateway, and releases the packets whose outcome is final.
+ */
+class IntervalPacketTrackerTestCase : public TestCase
+{
+  public:
+    IntervalPacketTrackerTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+IntervalPacketTrackerTestCase::IntervalPacketTrackerTestCase()
+    : TestCase("Per-interval packet tracker")
+{
+}
+
+void
+IntervalPacketTrackerTestCase::DoRun()
+{
+    using Tracker = IntervalPacketTracker;
+    Ptr<Tracker> tracker = CreateObject<Tracker>();
+    tracker->SetAttribute("Interval", TimeValue(Seconds(10)));
+    tracker->SetAttribute("PacketLifetime", TimeValue(Seconds(5)));
+    tracker->SetGateways({7, 3});
+
+    // Packet 1 at t = 1 s: received by gateway 7, interfered at gateway 3
+    Simulator::Schedule(Seconds(1), [tracker]() {
+        tracker->NotifySent(1);
+        tracker->NotifyOutcome(1, 7, Tracker::RECEIVED);
+        tracker->NotifyOutcome(1, 3, Tracker::INTERFERED);
+    });
+    // Packet 2 at t = 2 s: only reported by gateway 3, so it expires
+    Simulator::Schedule(Seconds(2), [tracker]() {
+        tracker->NotifySent(2);
+        tracker->NotifyOutcome(2, 3, Tracker::UNDER_SENSITIVITY);
+    });
+    // Packet 3 at t = 12 s: received by both gateways, counted once
+    Simulator::Schedule(Seconds(12), [tracker]() {
+        tracker->NotifySent(3);
+        tracker->NotifyOutcome(3, 3, Tracker::RECEIVED);
+        tracker->NotifyOutcome(3, 7, Tracker::RECEIVED);
+        // Packet 2 is older than the lifetime: its late outcome is ignored
+        tracker->NotifyOutcome(2, 7, Tracker::RECEIVED);
+    });
+    // Packet 4 at t = 25 s: lost at both gateways
+    Simulator::Schedule(Seconds(25), [tracker]() {
+        tracker->NotifySent(4);
+        tracker->NotifyOutcome(4, 7, Tracker::LOST_BECAUSE_TX);
+        tracker->NotifyOutcome(4, 3, Tracker::NO_MORE_RECEIVERS);
+    });
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(tracker->GetNPending(), 0, "Final packets not released");
+    NS_TEST_EXPECT_MSG_EQ(tracker->CountSent(Seconds(0), Seconds(30)), 4, "Wrong sent count");
+    NS_TEST_EXPECT_MSG_EQ(tracker->CountReceived(Seconds(0), Seconds(30)),
+                          2,
+                          "Wrong received count");
+    // Ranges are rounded to whole intervals
+    NS_TEST_EXPECT_MSG_EQ(tracker->CountSent(Seconds(5), Seconds(10)), 2, "Wrong first interval");
+    NS_TEST_EXPECT_MSG_EQ(tracker->CountSent(Seconds(10), Seconds(20)), 1, "Wrong interval");
+    NS_TEST_EXPECT_MSG_EQ(tracker->CountSent(Seconds(20), Seconds(100)), 1, "Wrong last interval");
+    NS_TEST_EXPECT_MSG_EQ(tracker->CountSent(Seconds(40), Seconds(50)), 0, "Wrong empty range");
+
+    Tracker::PhyCounts gw3 = tracker->CountPhyOutcomes(Seconds(0), Seconds(30), 3);
+    Tracker::PhyCounts gw7 = tracker->CountPhyOutcomes(Seconds(0), Seconds(10), 7);
+    NS_TEST_EXPECT_MSG_EQ(gw3[Tracker::RECEIVED], 1, "Wrong gateway 3 receptions");
+    NS_TEST_EXPECT_MSG_EQ(gw3[Tracker::INTERFERED], 1, "Wrong gateway 3 interference");
+    NS_TEST_EXPECT_MSG_EQ(gw3[Tracker::UNDER_SENSITIVITY], 1, "Wrong gateway 3 sensitivity");
+    NS_TEST_EXPECT_MSG_EQ(gw3[Tracker::NO_MORE_RECEIVERS], 1, "Wrong gateway 3 receivers");
+    NS_TEST_EXPECT_MSG_EQ(gw7[Tracker::RECEIVED], 1, "Wrong gateway 7 receptions");
+    NS_TEST_EXPECT_MSG_EQ(gw7[Tracker::LOST_BECAUSE_TX], 0, "Wrong gateway 7 interval");
+
+    tracker->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief The link budget matches the log-distance path loss, its batched
+ * evaluation matches the per-link one, and the shadowing has the configured
+ * standard deviation.
+ */
+class LoraLinkBudgetTestCase : public TestCase
+{
+  public:
+    LoraLinkBudgetTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LoraLinkBudgetTestCase::LoraLinkBudgetTestCase()
+    : TestCase("LoRa link budget")
+{
+}
+
+void
+LoraLinkBudgetTestCase::DoRun()
+{
+    Ptr<LoraLinkBudget> budget = CreateObject<LoraLinkBudget>();
+    NS_TEST_EXPECT_MSG_EQ_TOL(budget->GetPathLoss(0.5), 7.7, 1e-12, "Wrong loss below d0");
+    NS_TEST_EXPECT_MSG_EQ_TOL(budget->GetPathLoss(1000), 7.7 + 37.6 * 3, 1e-9, "Wrong loss");
+
+    std::vector<double> distances = {0.5, 10, 250, 1000, 4321};
+    std::vector<double> txPowers = {14, 14, 2, 8, 14};
+    std::vector<double> rxPowers;
+    budget->GetRxPowers(txPowers, distances, rxPowers);
+    NS_TEST_ASSERT_MSG_EQ(rxPowers.size(), distances.size(), "Wrong number of links");
+    for (std::size_t i = 0; i < distances.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(rxPowers[i],
+                                  budget->GetRxPower(txPowers[i], distances[i]),
+                                  1e-9,
+                                  "Batched and single received powers differ");
+    }
+
+    NS_TEST_EXPECT_MSG_EQ(LoraLinkBudget::GetSensitivity(7, 125000), -124, "Wrong sensitivity");
+    NS_TEST_EXPECT_MSG_EQ_TOL(LoraLinkBudget::GetSensitivity(12, 500000),
+                              -137 + 10 * std::log10(4.0),
+                              1e-9,
+                              "Wrong sensitivity at 500 kHz");
+    NS_TEST_EXPECT_MSG_EQ(LoraLinkBudget::GetSirThreshold(9, 9), 6, "Wrong co-SF threshold");
+    NS_TEST_EXPECT_MSG_EQ(LoraLinkBudget::GetSirThreshold(7, 8), -16, "Wrong inter-SF threshold");
+
+    // Shadowing
+    budget->SetAttribute("ShadowingSigma", DoubleValue(3.0));
+    budget->AssignStreams(5);
+    const std::size_t n = 20000;
+    std::vector<double> far(n, 1000);
+    std::vector<double> tx(n, 0);
+    budget->GetRxPowers(tx, far, rxPowers);
+    double sum = 0;
+    double sumSquares = 0;
+    for (double rxPower : rxPowers)
+    {
+        double shadowing = rxPower + budget->GetPathLoss(1000);
+        sum += shadowing;
+        sumSquares += shadowing * shadowing;
+    }
+    double mean = sum / n;
+    NS_TEST_EXPECT_MSG_EQ_TOL(mean, 0, 0.1, "Biased shadowing");
+    NS_TEST_EXPECT_MSG_EQ_TOL(std::sqrt(sumSquares / n - mean * mean),
+                              3.0,
+                              0.1,
+                              "Wrong shadowing standard deviation");
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief The incremental ADR statistics match the combination of an explicit
+ * SNR history, and the ADR decisions follow the margin steps.
+ */
+class AdrMarginStatisticsTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param combining How the SNRs are combined.
+     */
+    AdrMarginStatisticsTestCase(AdrMarginStatistics::Combining combining);
+
+  private:
+    void DoRun() override;
+
+    AdrMarginStatistics::Combining m_combining; //!< How the SNRs are combined
+};
+
+AdrMarginStatisticsTestCase::AdrMarginStatisticsTestCase(AdrMarginStatistics::Combining combining)
+    : TestCase(std::string("ADR margin statistics, ") +
+               (combining == AdrMarginStatistics::AVERAGE   ? "average"
+                : combining == AdrMarginStatistics::MAXIMUM ? "maximum"
+                                                            : "minimum")),
+      m_combining(combining)
+{
+}
+
+void
+AdrMarginStatisticsTestCase::DoRun()
+{
+    const uint32_t nDevices = 3;
+    const uint32_t range = 5;
+    Ptr<AdrMarginStatistics> stats = CreateObject<AdrMarginStatistics>();
+    stats->SetAttribute("HistoryRange", UintegerValue(range));
+    stats->SetAttribute("Combining", EnumValue(m_combining));
+    stats->SetDimensions(nDevices);
+
+    // Coarse SNRs, so that the extrema are often tied and evicted
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(11);
+    std::vector<std::deque<double>> histories(nDevices);
+    for (uint32_t step = 0; step < 400; step++)
+    {
+        uint32_t device = rng->GetInteger(0, nDevices - 1);
+        double snr = (static_cast<int>(rng->GetInteger(0, 30)) - 20) / 2.0;
+        stats->AddSnr(device, snr);
+        histories[device].push_back(snr);
+        if (histories[device].size() > range)
+        {
+            histories[device].pop_front();
+        }
+        bool full = histories[device].size() == range;
+        NS_TEST_ASSERT_MSG_EQ(stats->IsReady(device), full, "Wrong history size");
+
+        const std::deque<double>& history = histories[device];
+        double expected = 0;
+        switch (m_combining)
+        {
+        case AdrMarginStatistics::MAXIMUM:
+            expected = *std::max_element(history.begin(), history.end());
+            break;
+        case AdrMarginStatistics::MINIMUM:
+            expected = *std::min_element(history.begin(), history.end());
+            break;
+        case AdrMarginStatistics::AVERAGE:
+            for (double value : history)
+            {
+                expected += value;
+            }
+            expected /= history.size();
+            break;
+        }
+        NS_TEST_ASSERT_MSG_EQ_TOL(stats->GetCombinedSnr(device),
+                                  expected,
+                                  1e-9,
+                                  "Combined SNR differs from the history");
+    }
+
+    // A device at SF12 with an SNR of 2 dB has a margin of 2 + 20 - 10 = 12 dB,
+    // i.e. 4 steps: SF12 to SF8
+    Ptr<AdrMarginStatistics> adr = CreateObject<AdrMarginStatistics>();
+    adr->SetAttribute("HistoryRange", UintegerValue(range));
+    adr->SetDimensions(nDevices);
+    std::vector<uint8_t> sfs = {12, 7, 7};
+    std::vector<double> txPowers = {14, 14, 4};
+    for (uint32_t i = 0; i < range; i++)
+    {
+        adr->AddSnr(0, 2);
+        adr->AddSnr(1, 6);   // Margin 3.5 dB at SF7: 1 step, 14 to 12 dBm
+        adr->AddSnr(2, -13); // Margin -15.5 dB at SF7: -6 steps, 4 to 14 dBm
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(adr->GetMargin(0, 12), 12, 1e-9, "Wrong margin");
+    NS_TEST_EXPECT_MSG_EQ(adr->ComputeAdr({0, 1, 2}, sfs, txPowers), 3, "Wrong changed count");
+    NS_TEST_EXPECT_MSG_EQ(+sfs[0], 8, "Wrong spreading factor");
+    NS_TEST_EXPECT_MSG_EQ(txPowers[0], 14, "Power lowered before the spreading factor");
+    NS_TEST_EXPECT_MSG_EQ(+sfs[1], 7, "Spreading factor below 7");
+    NS_TEST_EXPECT_MSG_EQ(txPowers[1], 12, "Wrong lowered power");
+    NS_TEST_EXPECT_MSG_EQ(txPowers[2], 14, "Wrong raised power");
+    NS_TEST_EXPECT_MSG_EQ(adr->ComputeAdr({1}, sfs, txPowers), true, "Steps not applied again");
+    NS_TEST_EXPECT_MSG_EQ(txPowers[1], 10, "Wrong lowered power");
+}
+
+/**
+ * \ingroup lorawan-learning-tests
+ *
+ * \brief LoRaWAN learning TestSuite
+ */
+class LorawanLearningTestSuite : public TestSuite
+{
+  public:
+    LorawanLearningTestSuite();
+};
+
+LorawanLearningTestSuite::LorawanLearningTestSuite()
+    : TestSuite("lorawan-learning", Type::UNIT)
+{
+    AddTestCase(new Ucb1TunedPolicyTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new QocaPolicyTestCase(1.0, 1.0), TestCase::Duration::QUICK);
+    AddTestCase(new QocaPolicyTestCase(0.98, 0.90), TestCase::Duration::QUICK);
+    AddTestCase(new TowPolicyTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BatchSelectionTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LoraAirtimeTableTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new UplinkSchedulerTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new IntervalPacketTrackerTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LoraLinkBudgetTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new AdrMarginStatisticsTestCase(AdrMarginStatistics::AVERAGE),
+                TestCase::Duration::QUICK);
+    AddTestCase(new AdrMarginStatisticsTestCase(AdrMarginStatistics::MAXIMUM),
+                TestCase::Duration::QUICK);
+    AddTestCase(new AdrMarginStatisticsTestCase(AdrMarginStatistics::MINIMUM),
+                TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static LorawanLearningTestSuite g_lorawanLearningTestSuite;
@@ -63,6 +63,22 @@ LrWpanErrorModel::LrWpanErrorModel()
 
 double
 LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
+{
+    auto it = m_berCache.find(snr);
+    if (it == m_berCache.end())
+    {
+        if (m_berCache.size() >= BER_CACHE_SIZE)
+        {
+            m_berCache.clear();
+        }
+        it = m_berCache.emplace(snr, GetBer(snr)).first;
+    }
+    double retval = pow(1.0 - it->second, nbits);
+    return retval;
+}
+
+double
+LrWpanErrorModel::GetBer(double snr) const
 {
     double ber = 0.0;
 
@@ -73,9 +89,7 @@ LrWpanErrorModel::GetChunkSuccessRate(double snr, uint32_t nbits) const
 
     ber = ber * 8.0 / 15.0 / 16.0;
 
-    ber = std::min(ber, 1.0);
-    double retval = pow(1.0 - ber, nbits);
-    return retval;
+    return std::min(ber, 1.0);
 }
 } // namespace lrwpan
 } // namespace ns3
@@ -21,6 +21,8 @@
 
 #include <ns3/object.h>
 
+#include <unordered_map>
+
 namespace ns3
 {
 namespace lrwpan
@@ -55,10 +57,26 @@ class LrWpanErrorModel : public Object
     double GetChunkSuccessRate(double snr, uint32_t nbits) const;
 
   private:
+    /**
+     * Compute the bit error rate for given SNR.
+     *
+     * \param snr SNR expressed as a power ratio (i.e. not in dB)
+     * \return the bit error rate
+     */
+    double GetBer(double snr) const;
+
     /**
      * Array of precalculated binomial coefficients.
      */
     double m_binomialCoefficients[17];
+
+    /**
+     * Bit error rates already computed, by SNR. The SNRs of the links between
+     * static devices repeat from one chunk to the next, and the series of
+     * GetBer is then evaluated once per link.
+     */
+    mutable std::unordered_map<double, double> m_berCache;
+    static const std::size_t BER_CACHE_SIZE = 4096; //!< Maximum size of m_berCache
 };
 } // namespace lrwpan
 } // namespace ns3
@@ -31,8 +31,7 @@ namespace lrwpan
 NS_LOG_COMPONENT_DEFINE("LrWpanInterferenceHelper");
 
 LrWpanInterferenceHelper::LrWpanInterferenceHelper(Ptr<const SpectrumModel> spectrumModel)
-    : m_spectrumModel(spectrumModel),
-      m_dirty(false)
+    : m_spectrumModel(spectrumModel)
 {
     m_signal = Create<SpectrumValue>(m_spectrumModel);
 }
@@ -54,7 +53,7 @@ LrWpanInterferenceHelper::AddSignal(Ptr<const SpectrumValue> signal)
     if (signal->GetSpectrumModel() == m_spectrumModel)
     {
         result = m_signals.insert(signal).second;
-        if (result && !m_dirty)
+        if (result)
         {
             *m_signal += *signal;
         }
@@ -72,9 +71,14 @@ LrWpanInterferenceHelper::RemoveSignal(Ptr<const SpectrumValue> signal)
     if (signal->GetSpectrumModel() == m_spectrumModel)
     {
         result = (m_signals.erase(signal) == 1);
-        if (result)
+        if (result && m_signals.empty())
         {
-            m_dirty = true;
+            // Restart from an exact zero, so that rounding errors do not accumulate
+            m_signal = Create<SpectrumValue>(m_spectrumModel);
+        }
+        else if (result)
+        {
+            *m_signal -= *signal;
         }
     }
     return result;
@@ -86,7 +90,7 @@ LrWpanInterferenceHelper::ClearSignals()
     NS_LOG_FUNCTION(this);
 
     m_signals.clear();
-    m_dirty = true;
+    m_signal = Create<SpectrumValue>(m_spectrumModel);
 }
 
 Ptr<SpectrumValue>
@@ -94,17 +98,6 @@ LrWpanInterferenceHelper::GetSignalPsd() const
 {
     NS_LOG_FUNCTION(this);
 
-    if (m_dirty)
-    {
-        // Sum up the current interference PSD.
-        m_signal = Create<SpectrumValue>(m_spectrumModel);
-        for (auto it = m_signals.begin(); it != m_signals.end(); ++it)
-        {
-            *m_signal += *(*it);
-        }
-        m_dirty = false;
-    }
-
     return m_signal->Copy();
 }
 
@@ -112,15 +112,10 @@ class LrWpanInterferenceHelper : public SimpleRefCount<LrWpanInterferenceHelper>
     std::set<Ptr<const SpectrumValue>> m_signals;
 
     /**
-     * The precomputed sum of all accumulated signals.
+     * The running sum of all accumulated signals, updated when a signal is added
+     * or removed.
      */
-    mutable Ptr<SpectrumValue> m_signal;
-
-    /**
-     * Mark m_signal as dirty, whenever a signal is added or removed. m_signal has
-     * to be recomputed before next use.
-     */
-    mutable bool m_dirty;
+    Ptr<SpectrumValue> m_signal;
 };
 
 } // namespace lrwpan
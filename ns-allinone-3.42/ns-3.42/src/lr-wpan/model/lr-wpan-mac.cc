@@ -1557,8 +1557,21 @@ LrWpanMac::StartCAP(SuperframeType superframeType)
                                                          << ")");
         NS_LOG_DEBUG("Active Slots duration " << activeSlot << " symbols");
 
-        m_capEvent =
-            Simulator::Schedule(endCapTime, &LrWpanMac::StartCFP, this, SuperframeType::OUTGOING);
+        // Without a CFP the inactive period follows the CAP, skip the empty CFP event
+        if (m_fnlCapSlot == 15)
+        {
+            m_capEvent = Simulator::Schedule(endCapTime,
+                                             &LrWpanMac::StartInactivePeriod,
+                                             this,
+                                             SuperframeType::OUTGOING);
+        }
+        else
+        {
+            m_capEvent = Simulator::Schedule(endCapTime,
+                                             &LrWpanMac::StartCFP,
+                                             this,
+                                             SuperframeType::OUTGOING);
+        }
     }
     else
     {
@@ -1574,8 +1587,21 @@ LrWpanMac::StartCAP(SuperframeType superframeType)
                                                          << ")");
         NS_LOG_DEBUG("Active Slots duration " << activeSlot << " symbols");
 
-        m_capEvent =
-            Simulator::Schedule(endCapTime, &LrWpanMac::StartCFP, this, SuperframeType::INCOMING);
+        // Without a CFP the inactive period follows the CAP, skip the empty CFP event
+        if (m_incomingFnlCapSlot == 15)
+        {
+            m_capEvent = Simulator::Schedule(endCapTime,
+                                             &LrWpanMac::StartInactivePeriod,
+                                             this,
+                                             SuperframeType::INCOMING);
+        }
+        else
+        {
+            m_capEvent = Simulator::Schedule(endCapTime,
+                                             &LrWpanMac::StartCFP,
+                                             this,
+                                             SuperframeType::INCOMING);
+        }
     }
 
     CheckQueue();
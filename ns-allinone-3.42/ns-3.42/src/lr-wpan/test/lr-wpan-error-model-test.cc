@@ -193,6 +193,13 @@ LrWpanErrorModelTestCase::DoRun()
     snr = -7;
     ber = 1.0 - model->GetChunkSuccessRate(pow(10.0, snr / 10.0), 1);
     NS_TEST_ASSERT_MSG_EQ_TOL(ber, 0.175, 0.001, "Model fails for SNR = " << snr);
+
+    // The bit error rate computed for an SNR is reused for chunks of any size
+    double chunkSuccessRate = model->GetChunkSuccessRate(pow(10.0, snr / 10.0), 8);
+    NS_TEST_ASSERT_MSG_EQ_TOL(chunkSuccessRate,
+                              pow(1.0 - ber, 8),
+                              1e-12,
+                              "Model fails for 8 bits at SNR = " << snr);
 }
 
 /**
@@ -152,24 +152,18 @@ main(int argc, char* argv[])
     lteHelper->EnableMacTraces();
     lteHelper->EnableRlcTraces();
 
-    // keep track of all path loss values in two centralized objects
-    DownlinkLteGlobalPathlossDatabase dlPathlossDb;
-    UplinkLteGlobalPathlossDatabase ulPathlossDb;
-    // we rely on the fact that LteHelper creates the DL channel object first, then the UL channel
-    // object, hence the former will have index 0 and the latter 1
-    Config::Connect(
-        "/ChannelList/0/PathLoss",
-        MakeCallback(&DownlinkLteGlobalPathlossDatabase::UpdatePathloss, &dlPathlossDb));
-    Config::Connect("/ChannelList/1/PathLoss",
-                    MakeCallback(&UplinkLteGlobalPathlossDatabase::UpdatePathloss, &ulPathlossDb));
+    // keep track of all path loss values in two centralized objects, which
+    // the LteHelper connects to the PathLoss traces of the DL and UL channels
+    auto dlPathlossDb = lteHelper->GetDownlinkPathlossDatabase();
+    auto ulPathlossDb = lteHelper->GetUplinkPathlossDatabase();
 
     Simulator::Run();
 
     // print the pathloss values at the end of the simulation
     std::cout << std::endl << "Downlink pathloss:" << std::endl;
-    dlPathlossDb.Print();
+    dlPathlossDb->Print();
     std::cout << std::endl << "Uplink pathloss:" << std::endl;
-    ulPathlossDb.Print();
+    ulPathlossDb->Print();
 
     Simulator::Destroy();
     return 0;
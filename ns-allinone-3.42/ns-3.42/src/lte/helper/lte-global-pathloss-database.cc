@@ -22,7 +22,10 @@
 #include "ns3/lte-enb-net-device.h"
 #include "ns3/lte-spectrum-phy.h"
 #include "ns3/lte-ue-net-device.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/warnings.h"
 
+#include <algorithm>
 #include <limits>
 
 namespace ns3
@@ -30,63 +33,230 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("LteGlobalPathlossDatabase");
 
+// the constructor and destructor initialize and destroy m_pathlossMap
+NS_WARNING_PUSH_DEPRECATED;
+
+LteGlobalPathlossDatabase::LteGlobalPathlossDatabase(bool singlePrecision)
+    : m_singlePrecision(singlePrecision)
+{
+}
+
 LteGlobalPathlossDatabase::~LteGlobalPathlossDatabase()
 {
 }
 
+NS_WARNING_POP;
+
+void
+LteGlobalPathlossDatabase::ReportPathloss(Ptr<const SpectrumPhy> txPhy,
+                                          Ptr<const SpectrumPhy> rxPhy,
+                                          double lossDb)
+{
+    UpdatePathloss(std::string(), txPhy, rxPhy, lossDb);
+}
+
+void
+LteGlobalPathlossDatabase::Connect(Ptr<SpectrumChannel> channel)
+{
+    NS_LOG_FUNCTION(this << channel);
+    channel->TraceConnectWithoutContext(
+        "PathLoss",
+        MakeCallback(&LteGlobalPathlossDatabase::ReportPathloss, this));
+}
+
+std::size_t
+LteGlobalPathlossDatabase::GetRow(uint16_t cellId) const
+{
+    return (cellId < m_rowOfCell.size()) ? m_rowOfCell[cellId] : NONE;
+}
+
+std::size_t
+LteGlobalPathlossDatabase::GetColumn(uint64_t imsi) const
+{
+    auto it = m_columnOfUe.find(imsi);
+    return (it != m_columnOfUe.end()) ? it->second : NONE;
+}
+
 void
-LteGlobalPathlossDatabase::Print()
+LteGlobalPathlossDatabase::Resize(std::size_t nRows, std::size_t nColumns)
+{
+    NS_LOG_FUNCTION(this << nRows << nColumns);
+    // grow geometrically, so that the copies are amortized when the
+    // identifiers are discovered one at a time
+    nRows = (nRows > m_nRows) ? std::max(nRows, 2 * m_nRows) : m_nRows;
+    nColumns = (nColumns > m_nColumns) ? std::max(nColumns, 2 * m_nColumns) : m_nColumns;
+    const double none = std::numeric_limits<double>::infinity();
+    if (m_singlePrecision)
+    {
+        std::vector<float> pathloss(nRows * nColumns, none);
+        for (std::size_t row = 0; row < m_nRows; ++row)
+        {
+            std::copy_n(m_pathlossF.begin() + row * m_nColumns,
+                        m_nColumns,
+                        pathloss.begin() + row * nColumns);
+        }
+        m_pathlossF.swap(pathloss);
+    }
+    else
+    {
+        std::vector<double> pathloss(nRows * nColumns, none);
+        for (std::size_t row = 0; row < m_nRows; ++row)
+        {
+            std::copy_n(m_pathloss.begin() + row * m_nColumns,
+                        m_nColumns,
+                        pathloss.begin() + row * nColumns);
+        }
+        m_pathloss.swap(pathloss);
+    }
+    m_nRows = nRows;
+    m_nColumns = nColumns;
+}
+
+void
+LteGlobalPathlossDatabase::SetPathloss(uint16_t cellId, uint64_t imsi, double lossDb)
+{
+    NS_LOG_FUNCTION(this << cellId << imsi << lossDb);
+    std::size_t row = GetRow(cellId);
+    if (row == NONE)
+    {
+        // the cell IDs are 16 bits wide, so they index the rows directly
+        if (cellId >= m_rowOfCell.size())
+        {
+            m_rowOfCell.resize(cellId + 1, NONE);
+        }
+        row = m_cellIds.size();
+        m_rowOfCell[cellId] = row;
+        m_cellIds.push_back(cellId);
+    }
+    std::size_t column = GetColumn(imsi);
+    if (column == NONE)
+    {
+        column = m_imsis.size();
+        m_columnOfUe.emplace(imsi, column);
+        m_imsis.push_back(imsi);
+    }
+    if (row >= m_nRows || column >= m_nColumns)
+    {
+        Resize(row + 1, column + 1);
+    }
+    const std::size_t i = row * m_nColumns + column;
+    if (m_singlePrecision)
+    {
+        m_pathlossF[i] = static_cast<float>(lossDb);
+    }
+    else
+    {
+        m_pathloss[i] = lossDb;
+    }
+}
+
+void
+LteGlobalPathlossDatabase::Print() const
 {
     NS_LOG_FUNCTION(this);
-    for (auto cellIdIt = m_pathlossMap.begin(); cellIdIt != m_pathlossMap.end(); ++cellIdIt)
+    // print in the (cell ID, IMSI) order, like the values stored in m_pathlossMap
+    std::map<uint16_t, std::map<uint64_t, double>> pathlossMap;
+    for (std::size_t row = 0; row < m_cellIds.size(); ++row)
     {
-        for (auto imsiIt = cellIdIt->second.begin(); imsiIt != cellIdIt->second.end(); ++imsiIt)
+        for (std::size_t column = 0; column < m_imsis.size(); ++column)
         {
-            std::cout << "CellId: " << cellIdIt->first << " IMSI: " << imsiIt->first
-                      << " pathloss: " << imsiIt->second << " dB" << std::endl;
+            const std::size_t i = row * m_nColumns + column;
+            const double lossDb = m_singlePrecision ? m_pathlossF[i] : m_pathloss[i];
+            if (lossDb != std::numeric_limits<double>::infinity())
+            {
+                pathlossMap[m_cellIds[row]][m_imsis[column]] = lossDb;
+            }
+        }
+    }
+    NS_WARNING_PUSH_DEPRECATED;
+    for (const auto& [cellId, ueMap] : m_pathlossMap)
+    {
+        pathlossMap[cellId].insert(ueMap.begin(), ueMap.end());
+    }
+    NS_WARNING_POP;
+    for (const auto& [cellId, ueMap] : pathlossMap)
+    {
+        for (const auto& [imsi, lossDb] : ueMap)
+        {
+            std::cout << "CellId: " << cellId << " IMSI: " << imsi << " pathloss: " << lossDb
+                      << " dB" << std::endl;
         }
     }
 }
 
 double
-LteGlobalPathlossDatabase::GetPathloss(uint16_t cellId, uint64_t imsi)
+LteGlobalPathlossDatabase::GetPathloss(uint16_t cellId, uint64_t imsi) const
 {
     NS_LOG_FUNCTION(this);
-    auto cellIt = m_pathlossMap.find(cellId);
-    if (cellIt == m_pathlossMap.end())
+    const std::size_t row = GetRow(cellId);
+    const std::size_t column = GetColumn(imsi);
+    if (row != NONE && column != NONE)
     {
-        return std::numeric_limits<double>::infinity();
+        const std::size_t i = row * m_nColumns + column;
+        const double lossDb = m_singlePrecision ? m_pathlossF[i] : m_pathloss[i];
+        if (lossDb != std::numeric_limits<double>::infinity())
+        {
+            return lossDb;
+        }
     }
-    auto ueIt = cellIt->second.find(imsi);
-    if (ueIt == cellIt->second.end())
+    NS_WARNING_PUSH_DEPRECATED;
+    auto cellIt = m_pathlossMap.find(cellId);
+    if (cellIt != m_pathlossMap.end())
     {
-        return std::numeric_limits<double>::infinity();
+        auto ueIt = cellIt->second.find(imsi);
+        if (ueIt != cellIt->second.end())
+        {
+            return ueIt->second;
+        }
     }
-    return ueIt->second;
+    NS_WARNING_POP;
+    return std::numeric_limits<double>::infinity();
 }
 
 void
-DownlinkLteGlobalPathlossDatabase::UpdatePathloss(std::string context,
+DownlinkLteGlobalPathlossDatabase::UpdatePathloss(std::string context [[maybe_unused]],
                                                   Ptr<const SpectrumPhy> txPhy,
                                                   Ptr<const SpectrumPhy> rxPhy,
                                                   double lossDb)
+{
+    ReportPathloss(txPhy, rxPhy, lossDb);
+}
+
+void
+DownlinkLteGlobalPathlossDatabase::ReportPathloss(Ptr<const SpectrumPhy> txPhy,
+                                                  Ptr<const SpectrumPhy> rxPhy,
+                                                  double lossDb)
 {
     NS_LOG_FUNCTION(this << lossDb);
-    uint16_t cellId = txPhy->GetDevice()->GetObject<LteEnbNetDevice>()->GetCellId();
-    uint16_t imsi = rxPhy->GetDevice()->GetObject<LteUeNetDevice>()->GetImsi();
-    m_pathlossMap[cellId][imsi] = lossDb;
+    Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice>(txPhy->GetDevice());
+    Ptr<LteUeNetDevice> ueDev = DynamicCast<LteUeNetDevice>(rxPhy->GetDevice());
+    if (enbDev && ueDev)
+    {
+        SetPathloss(enbDev->GetCellId(), ueDev->GetImsi(), lossDb);
+    }
 }
 
 void
-UplinkLteGlobalPathlossDatabase::UpdatePathloss(std::string context,
+UplinkLteGlobalPathlossDatabase::UpdatePathloss(std::string context [[maybe_unused]],
                                                 Ptr<const SpectrumPhy> txPhy,
                                                 Ptr<const SpectrumPhy> rxPhy,
                                                 double lossDb)
+{
+    ReportPathloss(txPhy, rxPhy, lossDb);
+}
+
+void
+UplinkLteGlobalPathlossDatabase::ReportPathloss(Ptr<const SpectrumPhy> txPhy,
+                                                Ptr<const SpectrumPhy> rxPhy,
+                                                double lossDb)
 {
     NS_LOG_FUNCTION(this << lossDb);
-    uint16_t imsi = txPhy->GetDevice()->GetObject<LteUeNetDevice>()->GetImsi();
-    uint16_t cellId = rxPhy->GetDevice()->GetObject<LteEnbNetDevice>()->GetCellId();
-    m_pathlossMap[cellId][imsi] = lossDb;
+    Ptr<LteUeNetDevice> ueDev = DynamicCast<LteUeNetDevice>(txPhy->GetDevice());
+    Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice>(rxPhy->GetDevice());
+    if (enbDev && ueDev)
+    {
+        SetPathloss(enbDev->GetCellId(), ueDev->GetImsi(), lossDb);
+    }
 }
 
 } // namespace ns3
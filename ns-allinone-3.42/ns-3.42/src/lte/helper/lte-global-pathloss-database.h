@@ -20,15 +20,19 @@
 #ifndef LTE_GLOBAL_PATHLOSS_DATABASE_H
 #define LTE_GLOBAL_PATHLOSS_DATABASE_H
 
+#include <ns3/deprecated.h>
 #include <ns3/log.h>
 #include <ns3/ptr.h>
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
 
+class SpectrumChannel;
 class SpectrumPhy;
 
 /**
@@ -38,10 +42,23 @@ class SpectrumPhy;
  * example of how the PathlossTrace (provided by some SpectrumChannel
  * implementations) work.
  *
+ * The values are stored in a dense matrix with a row per cell and a
+ * column per UE, so that both updates and lookups take constant time.
+ * The cell IDs and IMSIs are mapped to rows and columns in the order
+ * they are first seen, hence sparse identifiers cost no more memory than
+ * compact ones. The values can optionally be stored in single precision
+ * to halve the memory footprint.
  */
 class LteGlobalPathlossDatabase
 {
   public:
+    /**
+     * Constructor
+     *
+     * \param singlePrecision whether the pathloss values are stored as float
+     */
+    explicit LteGlobalPathlossDatabase(bool singlePrecision = false);
+
     virtual ~LteGlobalPathlossDatabase();
 
     /**
@@ -57,28 +74,102 @@ class LteGlobalPathlossDatabase
                                 Ptr<const SpectrumPhy> rxPhy,
                                 double lossDb) = 0;
 
+    /**
+     * update the pathloss value, as done by the PathLoss trace of the
+     * channels this database is connected to. By default, this calls
+     * UpdatePathloss with an empty context.
+     *
+     * \param txPhy the transmitting PHY
+     * \param rxPhy the receiving PHY
+     * \param lossDb the loss in dB
+     */
+    virtual void ReportPathloss(Ptr<const SpectrumPhy> txPhy,
+                                Ptr<const SpectrumPhy> rxPhy,
+                                double lossDb);
+
+    /**
+     * Feed the database with the path loss values computed by a channel,
+     * by connecting ReportPathloss to its PathLoss trace without a context.
+     *
+     * \param channel the channel
+     */
+    void Connect(Ptr<SpectrumChannel> channel);
+
+    /**
+     * set the pathloss value between an eNB and a UE
+     *
+     * \param cellId the id of the eNB
+     * \param imsi the id of the UE
+     * \param lossDb the loss in dB
+     */
+    void SetPathloss(uint16_t cellId, uint64_t imsi, double lossDb);
+
     /**
      *
      *
      * \param cellId the id of the eNB
      * \param imsi the id of the UE
      *
-     * \return the pathloss value between the UE and the eNB
+     * \return the pathloss value between the UE and the eNB, or infinity if
+     *         no value was reported
      */
-    double GetPathloss(uint16_t cellId, uint64_t imsi);
+    double GetPathloss(uint16_t cellId, uint64_t imsi) const;
 
     /**
      * print the stored pathloss values to standard output
      *
      */
-    void Print();
+    void Print() const;
 
   protected:
     /**
      * List of the last pathloss value for each UE by CellId.
      * ( CELL ID,  ( IMSI,PATHLOSS ))
+     *
+     * The values are now stored with SetPathloss(). Those still written
+     * here by subclasses are returned by GetPathloss() and Print() for the
+     * pairs without a value set with SetPathloss().
      */
+    NS_DEPRECATED_3_42("Use SetPathloss instead")
     std::map<uint16_t, std::map<uint64_t, double>> m_pathlossMap;
+
+  private:
+    /**
+     * Get the row of a cell.
+     *
+     * \param cellId the id of the eNB
+     * \return the row, or NONE if the cell has no value
+     */
+    std::size_t GetRow(uint16_t cellId) const;
+
+    /**
+     * Get the column of a UE.
+     *
+     * \param imsi the id of the UE
+     * \return the column, or NONE if the UE has no value
+     */
+    std::size_t GetColumn(uint64_t imsi) const;
+
+    /**
+     * Grow the matrix so that it has at least the given dimensions.
+     *
+     * \param nRows the number of rows (cells)
+     * \param nColumns the number of columns (UEs)
+     */
+    void Resize(std::size_t nRows, std::size_t nColumns);
+
+    /// the row or column of an identifier without a value
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    bool m_singlePrecision;                             ///< whether the float storage is used
+    std::vector<std::size_t> m_rowOfCell;               ///< row of each cell ID, NONE if none
+    std::unordered_map<uint64_t, std::size_t> m_columnOfUe; ///< column of each IMSI
+    std::vector<uint16_t> m_cellIds;                    ///< cell ID of each row
+    std::vector<uint64_t> m_imsis;                      ///< IMSI of each column
+    std::size_t m_nRows{0};                             ///< number of rows of the matrix
+    std::size_t m_nColumns{0};                          ///< number of columns of the matrix
+    std::vector<double> m_pathloss; ///< row-major (cell, UE) matrix of the last pathloss
+    std::vector<float> m_pathlossF; ///< same as m_pathloss, if m_singlePrecision is set
 };
 
 /**
@@ -88,11 +179,16 @@ class LteGlobalPathlossDatabase
 class DownlinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 {
   public:
+    using LteGlobalPathlossDatabase::LteGlobalPathlossDatabase;
+
     // inherited from LteGlobalPathlossDatabase
     void UpdatePathloss(std::string context,
                         Ptr<const SpectrumPhy> txPhy,
                         Ptr<const SpectrumPhy> rxPhy,
                         double lossDb) override;
+    void ReportPathloss(Ptr<const SpectrumPhy> txPhy,
+                        Ptr<const SpectrumPhy> rxPhy,
+                        double lossDb) override;
 };
 
 /**
@@ -102,11 +198,16 @@ class DownlinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 class UplinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 {
   public:
+    using LteGlobalPathlossDatabase::LteGlobalPathlossDatabase;
+
     // inherited from LteGlobalPathlossDatabase
     void UpdatePathloss(std::string context,
                         Ptr<const SpectrumPhy> txPhy,
                         Ptr<const SpectrumPhy> rxPhy,
                         double lossDb) override;
+    void ReportPathloss(Ptr<const SpectrumPhy> txPhy,
+                        Ptr<const SpectrumPhy> rxPhy,
+                        double lossDb) override;
 };
 
 } // namespace ns3
@@ -210,6 +210,8 @@ LteHelper::DoDispose()
     NS_LOG_FUNCTION(this);
     m_downlinkChannel = nullptr;
     m_uplinkChannel = nullptr;
+    m_downlinkPathlossDb = nullptr;
+    m_uplinkPathlossDb = nullptr;
     m_componentCarrierPhyParams.clear();
     Object::DoDispose();
 }
@@ -226,6 +228,41 @@ LteHelper::GetDownlinkSpectrumChannel() const
     return m_downlinkChannel;
 }
 
+std::shared_ptr<LteGlobalPathlossDatabase>
+LteHelper::GetDownlinkPathlossDatabase()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_downlinkPathlossDb)
+    {
+        Initialize(); // the channels are created upon initialization
+        m_downlinkPathlossDb = std::make_shared<DownlinkLteGlobalPathlossDatabase>();
+        // the channel keeps the database alive as long as it may report values
+        m_downlinkChannel->TraceConnectWithoutContext(
+            "PathLoss",
+            Callback<void, Ptr<const SpectrumPhy>, Ptr<const SpectrumPhy>, double>(
+                &LteGlobalPathlossDatabase::ReportPathloss,
+                m_downlinkPathlossDb));
+    }
+    return m_downlinkPathlossDb;
+}
+
+std::shared_ptr<LteGlobalPathlossDatabase>
+LteHelper::GetUplinkPathlossDatabase()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_uplinkPathlossDb)
+    {
+        Initialize(); // the channels are created upon initialization
+        m_uplinkPathlossDb = std::make_shared<UplinkLteGlobalPathlossDatabase>();
+        m_uplinkChannel->TraceConnectWithoutContext(
+            "PathLoss",
+            Callback<void, Ptr<const SpectrumPhy>, Ptr<const SpectrumPhy>, double>(
+                &LteGlobalPathlossDatabase::ReportPathloss,
+                m_uplinkPathlossDb));
+    }
+    return m_uplinkPathlossDb;
+}
+
 void
 LteHelper::ChannelModelInitialization()
 {
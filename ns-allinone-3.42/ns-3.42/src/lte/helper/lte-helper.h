@@ -22,6 +22,7 @@
 #ifndef LTE_HELPER_H
 #define LTE_HELPER_H
 
+#include "lte-global-pathloss-database.h"
 #include "mac-stats-calculator.h"
 #include "phy-rx-stats-calculator.h"
 #include "phy-stats-calculator.h"
@@ -42,6 +43,7 @@
 #include <ns3/simulator.h>
 
 #include <map>
+#include <memory>
 
 namespace ns3
 {
@@ -679,6 +681,24 @@ class LteHelper : public Object
      */
     Ptr<SpectrumChannel> GetDownlinkSpectrumChannel() const;
 
+    /**
+     * Get the database of the last DL pathloss values between each eNB and
+     * each UE. The database is created and fed by the PathLoss trace of the
+     * DL channel upon the first call, so that the same instance can then be
+     * shared by all the users of the pathloss values.
+     *
+     * \return the DL pathloss database
+     */
+    std::shared_ptr<LteGlobalPathlossDatabase> GetDownlinkPathlossDatabase();
+
+    /**
+     * Get the database of the last UL pathloss values between each UE and
+     * each eNB, see GetDownlinkPathlossDatabase().
+     *
+     * \return the UL pathloss database
+     */
+    std::shared_ptr<LteGlobalPathlossDatabase> GetUplinkPathlossDatabase();
+
   protected:
     // inherited from Object
     void DoInitialize() override;
@@ -749,6 +769,10 @@ class LteHelper : public Object
     Ptr<SpectrumChannel> m_downlinkChannel;
     /// The uplink LTE channel used in the simulation.
     Ptr<SpectrumChannel> m_uplinkChannel;
+    /// The database of the DL pathloss values, created on demand.
+    std::shared_ptr<LteGlobalPathlossDatabase> m_downlinkPathlossDb;
+    /// The database of the UL pathloss values, created on demand.
+    std::shared_ptr<LteGlobalPathlossDatabase> m_uplinkPathlossDb;
     /// The path loss model used in the downlink channel.
     Ptr<Object> m_downlinkPathlossModel;
     /// The path loss model used in the uplink channel.
@@ -20,23 +20,37 @@
 #include "radio-environment-map-helper.h"
 
 #include <ns3/abort.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/component-carrier-enb.h>
 #include <ns3/config.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
+#include <ns3/enum.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-scheduler-thread-pool.h>
+#include <ns3/lte-spectrum-phy.h>
 #include <ns3/lte-spectrum-value-helper.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/node-list.h>
 #include <ns3/node.h>
 #include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <limits>
 
@@ -169,7 +183,36 @@ RadioEnvironmentMapHelper::GetTypeId()
                           "default value is -1, what means REM will be averaged from all RBs",
                           IntegerValue(-1),
                           MakeIntegerAccessor(&RadioEnvironmentMapHelper::m_rbId),
-                          MakeIntegerChecker<int32_t>());
+                          MakeIntegerChecker<int32_t>())
+            .AddAttribute("DirectEvaluation",
+                          "If true, the map is computed by evaluating the loss models of the "
+                          "channel for each point in a single event, instead of deploying "
+                          "RemSpectrumPhy listeners on the channel. Only the control channel "
+                          "is supported in this mode.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_directEvaluation),
+                          MakeBooleanChecker())
+            .AddAttribute("Threads",
+                          "Number of threads, including the simulation thread, that compute "
+                          "the map in direct evaluation mode; 0 means one per hardware "
+                          "thread. Values other than 1 require a build with NS3_MTP enabled "
+                          "and loss models with no shared mutable state.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_threads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("OutputFormat",
+                          "The format of the output file",
+                          EnumValue(RadioEnvironmentMapHelper::TEXT),
+                          MakeEnumAccessor<OutputFormat>(
+                              &RadioEnvironmentMapHelper::m_outputFormat),
+                          MakeEnumChecker(RadioEnvironmentMapHelper::TEXT,
+                                          "Text",
+                                          RadioEnvironmentMapHelper::BINARY,
+                                          "Binary"))
+            .AddTraceSource("Progress",
+                            "Fired each time a part of the map has been written to the output.",
+                            MakeTraceSourceAccessor(&RadioEnvironmentMapHelper::m_progressTrace),
+                            "ns3::RadioEnvironmentMapHelper::ProgressTracedCallback");
     return tid;
 }
 
@@ -203,7 +246,7 @@ void
 RadioEnvironmentMapHelper::Install()
 {
     NS_LOG_FUNCTION(this);
-    if (!m_rem.empty())
+    if (!m_rem.empty() || !m_points.empty())
     {
         NS_FATAL_ERROR("only one REM supported per instance of RadioEnvironmentMapHelper");
     }
@@ -220,12 +263,30 @@ RadioEnvironmentMapHelper::Install()
                         "object at " << m_channelPath << " is not of type SpectrumChannel");
     }
 
-    m_outFile.open(m_outputFile.c_str());
+    auto mode = std::ios::out;
+    if (m_outputFormat == BINARY)
+    {
+        mode |= std::ios::binary;
+    }
+    m_outFile.open(m_outputFile.c_str(), mode);
     if (!m_outFile.is_open())
     {
         NS_FATAL_ERROR("Can't open file " << (m_outputFile));
         return;
     }
+    WriteHeader();
+
+    if (m_directEvaluation)
+    {
+        NS_ABORT_MSG_IF(m_useDataChannel,
+                        "DirectEvaluation supports only the control channel (UseDataChannel)");
+        NS_ABORT_MSG_IF(m_channel->GetPhasedArraySpectrumPropagationLossModel(),
+                        "DirectEvaluation does not support phased array spectrum loss models");
+        // the map does not depend on the eNB transmissions, hence it can be
+        // computed as soon as the simulation starts
+        Simulator::ScheduleNow(&RadioEnvironmentMapHelper::EvaluateDirectly, this);
+        return;
+    }
 
     double startDelay = 0.0026;
 
@@ -342,6 +403,7 @@ RadioEnvironmentMapHelper::PrintAndReset()
 {
     NS_LOG_FUNCTION(this);
 
+    uint32_t nPoints = 0;
     for (auto it = m_rem.begin(); it != m_rem.end(); ++it)
     {
         if (!(it->phy->IsActive()))
@@ -353,10 +415,11 @@ RadioEnvironmentMapHelper::PrintAndReset()
         Vector pos = it->bmm->GetPosition();
         NS_LOG_LOGIC("output: " << pos.x << "\t" << pos.y << "\t" << pos.z << "\t"
                                 << it->phy->GetSinr(m_noisePower));
-        m_outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t"
-                  << it->phy->GetSinr(m_noisePower) << std::endl;
+        WritePoint(pos, it->phy->GetSinr(m_noisePower));
         it->phy->Reset();
+        ++nPoints;
     }
+    ReportProgress(nPoints);
 }
 
 void
@@ -370,4 +433,238 @@ RadioEnvironmentMapHelper::Finalize()
     }
 }
 
+void
+RadioEnvironmentMapHelper::EvaluateDirectly()
+{
+    NS_LOG_FUNCTION(this);
+    m_xStep = (m_xMax - m_xMin) / (m_xRes - 1);
+    m_yStep = (m_yMax - m_yMin) / (m_yRes - 1);
+    CollectTransmitters();
+
+    uint32_t threads = m_threads;
+#ifndef NS3_MTP
+    if (threads != 1)
+    {
+        // reference counts are not atomic, while the transmitters and the
+        // loss models are shared by all the threads
+        NS_LOG_WARN("Threads is ignored in builds without NS3_MTP, using a single thread");
+        threads = 1;
+    }
+#endif
+    LteSchedulerThreadPool pool(threads);
+
+    const uint32_t nPoints = static_cast<uint32_t>(m_xRes) * m_yRes;
+    const uint32_t tileSize = std::min(m_maxPointsPerIteration, nPoints);
+    for (uint32_t i = 0; i < tileSize; ++i)
+    {
+        Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel>();
+        mm->AggregateObject(CreateObject<MobilityBuildingInfo>());
+        m_points.push_back(mm);
+    }
+
+    std::vector<double> sinr(tileSize);
+    for (uint32_t offset = 0; offset < nPoints; offset += tileSize)
+    {
+        const uint32_t n = std::min(tileSize, nPoints - offset);
+        // a few slices per thread, so that the threads stay busy if the
+        // cost of the points is uneven (e.g., indoor and outdoor points)
+        const std::size_t nSlices = std::min<std::size_t>(n, pool.GetNThreads() * 4);
+        pool.Run(nSlices, [this, n, nSlices, offset, &sinr](std::size_t slice) {
+            EvaluateSlice(slice * n / nSlices, (slice + 1) * n / nSlices, offset, sinr);
+        });
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            WritePoint(m_points[k]->GetPosition(), sinr[k]);
+        }
+        ReportProgress(n);
+    }
+    m_points.clear();
+    m_transmitters.clear();
+    m_lossModel = nullptr;
+    m_spectrumLossModel = nullptr;
+    Finalize();
+}
+
+void
+RadioEnvironmentMapHelper::CollectTransmitters()
+{
+    NS_LOG_FUNCTION(this);
+    // fetched once, as the slices are evaluated concurrently
+    m_lossModel = m_channel->GetPropagationLossModel();
+    m_spectrumLossModel = m_channel->GetSpectrumPropagationLossModel();
+    DoubleValue maxLossDb;
+    m_channel->GetAttribute("MaxLossDb", maxLossDb);
+    m_maxLossDb = maxLossDb.Get();
+    DoubleValue maxRange;
+    m_channel->GetAttribute("MaxRange", maxRange);
+    m_maxRange = maxRange.Get();
+
+    Ptr<const SpectrumModel> remModel = LteSpectrumValueHelper::GetSpectrumModel(m_earfcn,
+                                                                                 m_bandwidth);
+    for (auto nodeIt = NodeList::Begin(); nodeIt != NodeList::End(); ++nodeIt)
+    {
+        for (uint32_t i = 0; i < (*nodeIt)->GetNDevices(); ++i)
+        {
+            Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice>((*nodeIt)->GetDevice(i));
+            if (!enbDev)
+            {
+                continue;
+            }
+            for (const auto& [ccId, cc] : enbDev->GetCcMap())
+            {
+                Ptr<LteEnbPhy> enbPhy = DynamicCast<ComponentCarrierEnb>(cc)->GetPhy();
+                Ptr<LteSpectrumPhy> dlPhy = enbPhy->GetDownlinkSpectrumPhy();
+                if (dlPhy->GetChannel() != m_channel)
+                {
+                    continue;
+                }
+                // the control frames are transmitted over the full bandwidth
+                std::vector<int> rbs(cc->GetDlBandwidth());
+                for (std::size_t rb = 0; rb < rbs.size(); ++rb)
+                {
+                    rbs[rb] = static_cast<int>(rb);
+                }
+                Ptr<SpectrumValue> psd =
+                    LteSpectrumValueHelper::CreateTxPowerSpectralDensity(cc->GetDlEarfcn(),
+                                                                         cc->GetDlBandwidth(),
+                                                                         enbPhy->GetTxPower(),
+                                                                         rbs);
+                Ptr<const SpectrumModel> txModel = psd->GetSpectrumModel();
+                if (txModel->GetUid() != remModel->GetUid())
+                {
+                    if (txModel->IsOrthogonal(*remModel))
+                    {
+                        continue;
+                    }
+                    psd = SpectrumConverter(txModel, remModel).Convert(psd);
+                }
+                RemTransmitter tx;
+                tx.phy = dlPhy;
+                tx.mobility = dlPhy->GetMobility();
+                tx.antenna = DynamicCast<AntennaModel>(dlPhy->GetAntenna());
+                tx.psd = psd;
+                tx.power = GetRxPower(*psd);
+                NS_ABORT_MSG_IF(!tx.mobility, "eNB DL PHY without a mobility model");
+                m_transmitters.push_back(tx);
+            }
+        }
+    }
+    NS_LOG_INFO("evaluating " << m_transmitters.size() << " transmitters");
+}
+
+void
+RadioEnvironmentMapHelper::EvaluateSlice(std::size_t first,
+                                         std::size_t last,
+                                         uint32_t offset,
+                                         std::vector<double>& sinr) const
+{
+    if (first == last)
+    {
+        return;
+    }
+    for (std::size_t k = first; k < last; ++k)
+    {
+        uint32_t p = offset + k;
+        m_points[k]->SetPosition(Vector(m_xMin + (p / m_yRes) * m_xStep,
+                                        m_yMin + (p % m_yRes) * m_yStep,
+                                        m_z));
+        m_points[k]->GetObject<MobilityBuildingInfo>()->MakeConsistent(m_points[k]);
+    }
+
+    const std::vector<Ptr<MobilityModel>> rx(m_points.begin() + first, m_points.begin() + last);
+    std::vector<double> sumPower(rx.size(), 0.0);
+    std::vector<double> refPower(rx.size(), 0.0);
+    std::vector<double> gainDb(rx.size(), 0.0);
+    for (const auto& tx : m_transmitters)
+    {
+        if (m_lossModel)
+        {
+            // same as the channel, which computes the loss for a 0 dBm transmission
+            m_lossModel->CalcRxPowerBatch(0, tx.mobility, rx, gainDb);
+        }
+        const Vector txPos = tx.mobility->GetPosition();
+        for (std::size_t k = 0; k < rx.size(); ++k)
+        {
+            const Vector rxPos = rx[k]->GetPosition();
+            if (m_maxRange > 0 && CalculateDistance(txPos, rxPos) > m_maxRange)
+            {
+                continue;
+            }
+            double pathLossDb = -gainDb[k];
+            if (tx.antenna)
+            {
+                pathLossDb -= tx.antenna->GetGainDb(Angles(rxPos, txPos));
+            }
+            if (pathLossDb > m_maxLossDb)
+            {
+                continue;
+            }
+            const double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+            double power = tx.power * pathGainLinear;
+            if (m_spectrumLossModel)
+            {
+                auto params = Create<SpectrumSignalParameters>();
+                params->psd = tx.psd->Copy();
+                *(params->psd) *= pathGainLinear;
+                params->txPhy = tx.phy;
+                params->txAntenna = tx.antenna;
+                m_spectrumLossModel->ApplyRxPowerSpectralDensity(params, tx.mobility, rx[k]);
+                power = GetRxPower(*(params->psd));
+            }
+            sumPower[k] += power;
+            refPower[k] = std::max(refPower[k], power);
+        }
+    }
+    for (std::size_t k = 0; k < rx.size(); ++k)
+    {
+        // same as RemSpectrumPhy::GetSinr
+        sinr[first + k] = refPower[k] / (sumPower[k] - refPower[k] + m_noisePower);
+    }
+}
+
+double
+RadioEnvironmentMapHelper::GetRxPower(const SpectrumValue& psd) const
+{
+    if (m_rbId >= 0)
+    {
+        return psd[m_rbId] * 180000;
+    }
+    return Integral(psd);
+}
+
+void
+RadioEnvironmentMapHelper::WriteHeader()
+{
+    if (m_outputFormat != BINARY)
+    {
+        return;
+    }
+    const uint32_t res[2] = {m_xRes, m_yRes};
+    const double bounds[5] = {m_xMin, m_xMax, m_yMin, m_yMax, m_z};
+    m_outFile.write(reinterpret_cast<const char*>(res), sizeof(res));
+    m_outFile.write(reinterpret_cast<const char*>(bounds), sizeof(bounds));
+}
+
+void
+RadioEnvironmentMapHelper::WritePoint(const Vector& pos, double sinr)
+{
+    if (m_outputFormat == BINARY)
+    {
+        m_outFile.write(reinterpret_cast<const char*>(&sinr), sizeof(sinr));
+    }
+    else
+    {
+        m_outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t" << sinr << "\n";
+    }
+}
+
+void
+RadioEnvironmentMapHelper::ReportProgress(uint32_t nPoints)
+{
+    m_pointsDone += nPoints;
+    const uint32_t total = static_cast<uint32_t>(m_xRes) * m_yRes;
+    NS_LOG_INFO("REM progress: " << m_pointsDone << "/" << total << " points");
+    m_progressTrace(m_pointsDone, total);
+}
+
 } // namespace ns3
@@ -21,8 +21,12 @@
 #define RADIO_ENVIRONMENT_MAP_HELPER_H
 
 #include <ns3/object.h>
+#include <ns3/traced-callback.h>
+#include <ns3/vector.h>
 
 #include <fstream>
+#include <list>
+#include <vector>
 
 namespace ns3
 {
@@ -31,8 +35,13 @@ class RemSpectrumPhy;
 class Node;
 class NetDevice;
 class SpectrumChannel;
+class SpectrumPhy;
+class SpectrumValue;
 // class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
 
 /**
  * \ingroup lte
@@ -40,10 +49,32 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default the map is obtained by deploying RemSpectrumPhy listeners on
+ * the channel and letting them receive the DL control frames of the eNBs.
+ * With the `DirectEvaluation` attribute set, the propagation and spectrum
+ * loss models of the channel are instead evaluated directly for every point
+ * of the map in a single event, optionally on several threads (see the
+ * `Threads` attribute).
  */
 class RadioEnvironmentMapHelper : public Object
 {
   public:
+    /// Format of the output file
+    enum OutputFormat
+    {
+        TEXT,  ///< one "x y z sinr" line per point
+        BINARY ///< a header followed by the SINR of each point as a double
+    };
+
+    /**
+     * TracedCallback signature for the progress of the map generation.
+     *
+     * \param [in] done the number of points computed so far
+     * \param [in] total the number of points of the map
+     */
+    typedef void (*ProgressTracedCallback)(uint32_t done, uint32_t total);
+
     RadioEnvironmentMapHelper();
     ~RadioEnvironmentMapHelper() override;
 
@@ -104,6 +135,61 @@ class RadioEnvironmentMapHelper : public Object
     /// Called when the map generation procedure has been completed.
     void Finalize();
 
+    /**
+     * Scheduled by Install() instead of DelayedInstall() when the
+     * `DirectEvaluation` attribute is set. Computes the whole map one tile
+     * (of at most `MaxPointsPerIteration` points) at a time, writing each
+     * tile to the output before computing the next one, then calls
+     * Finalize().
+     */
+    void EvaluateDirectly();
+
+    /**
+     * Find the eNB DL PHYs attached to the channel and compute the power
+     * spectral density of their control frames in the spectrum model of the map.
+     */
+    void CollectTransmitters();
+
+    /**
+     * Compute the SINR of a slice of the current tile. This method is run
+     * concurrently for different slices and accesses only the listening
+     * positions and the SINR values of its slice.
+     *
+     * \param first index in the tile of the first point of the slice
+     * \param last index in the tile past the last point of the slice
+     * \param offset index in the map of the first point of the tile
+     * \param [out] sinr the SINR (linear) of the points of the tile
+     */
+    void EvaluateSlice(std::size_t first,
+                       std::size_t last,
+                       uint32_t offset,
+                       std::vector<double>& sinr) const;
+
+    /**
+     * \param psd a received power spectral density
+     * \return the received power considered by the map (i.e., over the `RbId`
+     *         resource block, or over the whole band)
+     */
+    double GetRxPower(const SpectrumValue& psd) const;
+
+    /// Write the header of the output file, if the format has one.
+    void WriteHeader();
+
+    /**
+     * Write a point of the map to the output file.
+     *
+     * \param pos the position of the point
+     * \param sinr the SINR (linear) of the point
+     */
+    void WritePoint(const Vector& pos, double sinr);
+
+    /**
+     * Account for the points written to the output file and report the progress.
+     *
+     * \param nPoints the number of points just written
+     */
+    void ReportProgress(uint32_t nPoints);
+
     /// A complete Radio Environment Map is composed of many of this structure.
     struct RemPoint
     {
@@ -116,6 +202,27 @@ class RadioEnvironmentMapHelper : public Object
     /// List of listeners in the environment.
     std::list<RemPoint> m_rem;
 
+    /// A DL transmitter taken into account in direct evaluation mode.
+    struct RemTransmitter
+    {
+        Ptr<SpectrumPhy> phy;         ///< DL PHY of the eNB
+        Ptr<MobilityModel> mobility;  ///< position of the eNB
+        Ptr<AntennaModel> antenna;    ///< antenna of the eNB, if any
+        Ptr<const SpectrumValue> psd; ///< control frame PSD, in the spectrum model of the map
+        double power;                 ///< GetRxPower() of the PSD before any loss
+    };
+
+    /// Transmitters evaluated in direct evaluation mode.
+    std::vector<RemTransmitter> m_transmitters;
+
+    /// Listening positions of the current tile in direct evaluation mode.
+    std::vector<Ptr<MobilityModel>> m_points;
+
+    Ptr<PropagationLossModel> m_lossModel;                ///< loss model of the channel
+    Ptr<SpectrumPropagationLossModel> m_spectrumLossModel; ///< spectrum loss model of the channel
+    double m_maxLossDb; ///< `MaxLossDb` attribute of the channel
+    double m_maxRange;  ///< `MaxRange` attribute of the channel
+
     double m_xMin;   ///< The `XMin` attribute.
     double m_xMax;   ///< The `XMax` attribute.
     uint16_t m_xRes; ///< The `XRes` attribute.
@@ -159,6 +266,14 @@ class RadioEnvironmentMapHelper : public Object
     bool m_useDataChannel; ///< The `UseDataChannel` attribute.
     int32_t m_rbId;        ///< The `RbId` attribute.
 
+    bool m_directEvaluation;     ///< The `DirectEvaluation` attribute.
+    uint32_t m_threads;          ///< The `Threads` attribute.
+    OutputFormat m_outputFormat; ///< The `OutputFormat` attribute.
+    uint32_t m_pointsDone{0};    ///< Number of points written so far.
+
+    /// The `Progress` trace source.
+    TracedCallback<uint32_t, uint32_t> m_progressTrace;
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 } // namespace ns3
@@ -270,25 +270,28 @@ EpcEnbApplication::RecvFromLteSocket(Ptr<Socket> socket)
     {
         NS_ASSERT(socket == m_lteSocket);
     }
-    Ptr<Packet> packet = socket->Recv();
-
-    EpsBearerTag tag;
-    bool found = packet->RemovePacketTag(tag);
-    NS_ASSERT(found);
-    uint16_t rnti = tag.GetRnti();
-    uint8_t bid = tag.GetBid();
-    NS_LOG_INFO("Received packet with RNTI: " << rnti << ", BID: " << +bid);
-    auto rntiIt = m_rbidTeidMap.find(rnti);
-    if (rntiIt == m_rbidTeidMap.end())
-    {
-        NS_LOG_WARN("UE context not found, discarding packet");
-    }
-    else
+    // process all the packets queued at the socket in a single callback
+    while (Ptr<Packet> packet = socket->Recv())
     {
+        EpsBearerTag tag;
+        bool found = packet->RemovePacketTag(tag);
+        NS_ASSERT(found);
+        uint16_t rnti = tag.GetRnti();
+        uint8_t bid = tag.GetBid();
+        NS_LOG_INFO("Received packet with RNTI: " << rnti << ", BID: " << +bid);
+        auto rntiIt = m_rbidTeidMap.find(rnti);
+        if (rntiIt == m_rbidTeidMap.end())
+        {
+            NS_LOG_WARN("UE context not found, discarding packet");
+            continue;
+        }
         auto bidIt = rntiIt->second.find(bid);
         NS_ASSERT(bidIt != rntiIt->second.end());
         uint32_t teid = bidIt->second;
-        m_rxLteSocketPktTrace(packet->Copy());
+        if (!m_rxLteSocketPktTrace.IsEmpty())
+        {
+            m_rxLteSocketPktTrace(packet->Copy());
+        }
         SendToS1uSocket(packet, teid);
     }
 }
@@ -298,19 +301,23 @@ EpcEnbApplication::RecvFromS1uSocket(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
     NS_ASSERT(socket == m_s1uSocket);
-    Ptr<Packet> packet = socket->Recv();
-    GtpuHeader gtpu;
-    packet->RemoveHeader(gtpu);
-    uint32_t teid = gtpu.GetTeid();
-    NS_LOG_INFO("Received packet from S1-U interface with GTP TEID: " << teid);
-    auto it = m_teidRbidMap.find(teid);
-    if (it == m_teidRbidMap.end())
-    {
-        NS_LOG_WARN("UE context at cell id " << m_cellId << " not found, discarding packet");
-    }
-    else
+    // process all the packets queued at the socket in a single callback
+    while (Ptr<Packet> packet = socket->Recv())
     {
-        m_rxS1uSocketPktTrace(packet->Copy());
+        GtpuHeader gtpu;
+        packet->RemoveHeader(gtpu);
+        uint32_t teid = gtpu.GetTeid();
+        NS_LOG_INFO("Received packet from S1-U interface with GTP TEID: " << teid);
+        auto it = m_teidRbidMap.find(teid);
+        if (it == m_teidRbidMap.end())
+        {
+            NS_LOG_WARN("UE context at cell id " << m_cellId << " not found, discarding packet");
+            continue;
+        }
+        if (!m_rxS1uSocketPktTrace.IsEmpty())
+        {
+            m_rxS1uSocketPktTrace(packet->Copy());
+        }
         SendToLteSocket(packet, it->second.m_rnti, it->second.m_bid);
     }
 }
@@ -169,7 +169,10 @@ EpcPgwApplication::RecvFromTunDevice(Ptr<Packet> packet,
                                      uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << source << dest << protocolNumber << packet << packet->GetSize());
-    m_rxTunPktTrace(packet->Copy());
+    if (!m_rxTunPktTrace.IsEmpty())
+    {
+        m_rxTunPktTrace(packet->Copy());
+    }
 
     // get IP address of UE
     if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
@@ -243,14 +246,20 @@ EpcPgwApplication::RecvFromS5uSocket(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
     NS_ASSERT(socket == m_s5uSocket);
-    Ptr<Packet> packet = socket->Recv();
-    m_rxS5PktTrace(packet->Copy());
+    // process all the packets queued at the socket in a single callback
+    while (Ptr<Packet> packet = socket->Recv())
+    {
+        if (!m_rxS5PktTrace.IsEmpty())
+        {
+            m_rxS5PktTrace(packet->Copy());
+        }
 
-    GtpuHeader gtpu;
-    packet->RemoveHeader(gtpu);
-    uint32_t teid = gtpu.GetTeid();
+        GtpuHeader gtpu;
+        packet->RemoveHeader(gtpu);
+        uint32_t teid = gtpu.GetTeid();
 
-    SendToTunDevice(packet, teid);
+        SendToTunDevice(packet, teid);
+    }
 }
 
 void
@@ -139,14 +139,17 @@ EpcSgwApplication::RecvFromS5uSocket(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
     NS_ASSERT(socket == m_s5uSocket);
-    Ptr<Packet> packet = socket->Recv();
-    GtpuHeader gtpu;
-    packet->RemoveHeader(gtpu);
-    uint32_t teid = gtpu.GetTeid();
+    // process all the packets queued at the socket in a single callback
+    while (Ptr<Packet> packet = socket->Recv())
+    {
+        GtpuHeader gtpu;
+        packet->RemoveHeader(gtpu);
+        uint32_t teid = gtpu.GetTeid();
 
-    Ipv4Address enbAddr = m_enbByTeidMap[teid];
-    NS_LOG_DEBUG("eNB " << enbAddr << " TEID " << teid);
-    SendToS1uSocket(packet, enbAddr, teid);
+        Ipv4Address enbAddr = m_enbByTeidMap[teid];
+        NS_LOG_DEBUG("eNB " << enbAddr << " TEID " << teid);
+        SendToS1uSocket(packet, enbAddr, teid);
+    }
 }
 
 void
@@ -184,12 +187,15 @@ EpcSgwApplication::RecvFromS1uSocket(Ptr<Socket> socket)
 {
     NS_LOG_FUNCTION(this << socket);
     NS_ASSERT(socket == m_s1uSocket);
-    Ptr<Packet> packet = socket->Recv();
-    GtpuHeader gtpu;
-    packet->RemoveHeader(gtpu);
-    uint32_t teid = gtpu.GetTeid();
+    // process all the packets queued at the socket in a single callback
+    while (Ptr<Packet> packet = socket->Recv())
+    {
+        GtpuHeader gtpu;
+        packet->RemoveHeader(gtpu);
+        uint32_t teid = gtpu.GetTeid();
 
-    SendToS5uSocket(packet, m_pgwAddr, teid);
+        SendToS5uSocket(packet, m_pgwAddr, teid);
+    }
 }
 
 void
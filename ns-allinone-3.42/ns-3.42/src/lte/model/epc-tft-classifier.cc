@@ -34,9 +34,7 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
-#include "ns3/tcp-header.h"
 #include "ns3/tcp-l4-protocol.h"
-#include "ns3/udp-header.h"
 #include "ns3/udp-l4-protocol.h"
 
 namespace ns3
@@ -44,6 +42,40 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EpcTftClassifier");
 
+/**
+ * Read the ports of the UDP or TCP header at the start of a packet. Both
+ * headers start with the source and destination ports, which are the only
+ * fields needed by the classifier, so that the headers need not be
+ * deserialized.
+ *
+ * \param p the packet, starting with the UDP or TCP header
+ * \param direction the EPC TFT direction
+ * \param [out] localPort the port of the UE
+ * \param [out] remotePort the port of the remote host
+ */
+static void
+ReadPorts(Ptr<const Packet> p,
+          EpcTft::Direction direction,
+          uint16_t& localPort,
+          uint16_t& remotePort)
+{
+    uint8_t buf[4];
+    uint32_t copied [[maybe_unused]] = p->CopyData(buf, 4);
+    NS_ASSERT_MSG(copied == 4, "not enough data for the UDP/TCP ports");
+    uint16_t sourcePort = (buf[0] << 8) | buf[1];
+    uint16_t destinationPort = (buf[2] << 8) | buf[3];
+    if (direction == EpcTft::UPLINK)
+    {
+        localPort = sourcePort;
+        remotePort = destinationPort;
+    }
+    else
+    {
+        remotePort = sourcePort;
+        localPort = destinationPort;
+    }
+}
+
 EpcTftClassifier::EpcTftClassifier()
 {
     NS_LOG_FUNCTION(this);
@@ -54,6 +86,7 @@ EpcTftClassifier::Add(Ptr<EpcTft> tft, uint32_t id)
 {
     NS_LOG_FUNCTION(this << tft << id);
     m_tftMap[id] = tft;
+    m_flowCache.clear();
 
     // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
     NS_ASSERT(m_tftMap.size() <= 16);
@@ -64,6 +97,7 @@ EpcTftClassifier::Delete(uint32_t id)
 {
     NS_LOG_FUNCTION(this << id);
     m_tftMap.erase(id);
+    m_flowCache.clear();
 }
 
 uint32_t
@@ -82,6 +116,8 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
     uint8_t protocol;
     uint8_t tos;
 
+    FlowKey key;
+
     uint16_t localPort = 0;
     uint16_t remotePort = 0;
 
@@ -121,46 +157,10 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         // i.e. it is the first one but it is not the last one
         if (fragmentOffset == 0)
         {
-            if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+            if ((protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8) ||
+                (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20))
             {
-                UdpHeader udpHeader;
-                pCopy->RemoveHeader(udpHeader);
-                if (direction == EpcTft::UPLINK)
-                {
-                    localPort = udpHeader.GetSourcePort();
-                    remotePort = udpHeader.GetDestinationPort();
-                }
-                else
-                {
-                    remotePort = udpHeader.GetSourcePort();
-                    localPort = udpHeader.GetDestinationPort();
-                }
-                if (!isLastFragment)
-                {
-                    std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                        std::make_tuple(ipv4Header.GetSource().Get(),
-                                        ipv4Header.GetDestination().Get(),
-                                        protocol,
-                                        ipv4Header.GetIdentification());
-
-                    m_classifiedIpv4Fragments[fragmentKey] = std::make_pair(localPort, remotePort);
-                }
-            }
-            else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
-            {
-                TcpHeader tcpHeader;
-                pCopy->RemoveHeader(tcpHeader);
-                if (direction == EpcTft::UPLINK)
-                {
-                    localPort = tcpHeader.GetSourcePort();
-                    remotePort = tcpHeader.GetDestinationPort();
-                }
-                else
-                {
-                    remotePort = tcpHeader.GetSourcePort();
-                    localPort = tcpHeader.GetDestinationPort();
-                }
-
+                ReadPorts(pCopy, direction, localPort, remotePort);
                 if (!isLastFragment)
                 {
                     std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
@@ -223,36 +223,9 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         protocol = ipv6Header.GetNextHeader();
         tos = ipv6Header.GetTrafficClass();
 
-        if (protocol == UdpL4Protocol::PROT_NUMBER)
+        if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
         {
-            UdpHeader udpHeader;
-            pCopy->RemoveHeader(udpHeader);
-
-            if (direction == EpcTft::UPLINK)
-            {
-                localPort = udpHeader.GetSourcePort();
-                remotePort = udpHeader.GetDestinationPort();
-            }
-            else
-            {
-                remotePort = udpHeader.GetSourcePort();
-                localPort = udpHeader.GetDestinationPort();
-            }
-        }
-        else if (protocol == TcpL4Protocol::PROT_NUMBER)
-        {
-            TcpHeader tcpHeader;
-            pCopy->RemoveHeader(tcpHeader);
-            if (direction == EpcTft::UPLINK)
-            {
-                localPort = tcpHeader.GetSourcePort();
-                remotePort = tcpHeader.GetDestinationPort();
-            }
-            else
-            {
-                remotePort = tcpHeader.GetSourcePort();
-                localPort = tcpHeader.GetDestinationPort();
-            }
+            ReadPorts(pCopy, direction, localPort, remotePort);
         }
     }
     else
@@ -267,29 +240,8 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
                     << " localPort=" << localPort << " remotePort=" << remotePort << " tos=0x"
                     << (uint16_t)tos);
 
-        // now it is possible to classify the packet!
-        // we use a reverse iterator since filter priority is not implemented properly.
-        // This way, since the default bearer is expected to be added first, it will be evaluated
-        // last.
-        std::map<uint32_t, Ptr<EpcTft>>::const_reverse_iterator it;
-        NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
-
-        for (it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
-        {
-            NS_LOG_LOGIC("TFT id: " << it->first);
-            NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
-            Ptr<EpcTft> tft = it->second;
-            if (tft->Matches(direction,
-                             remoteAddressIpv4,
-                             localAddressIpv4,
-                             remotePort,
-                             localPort,
-                             tos))
-            {
-                NS_LOG_LOGIC("matches with TFT ID = " << it->first);
-                return it->first; // the id of the matching TFT
-            }
-        }
+        localAddressIpv4.Serialize(key.localAddress.data());
+        remoteAddressIpv4.Serialize(key.remoteAddress.data());
     }
     else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
@@ -298,32 +250,94 @@ EpcTftClassifier::Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t
                     << " localPort=" << localPort << " remotePort=" << remotePort << " tos=0x"
                     << (uint16_t)tos);
 
-        // now it is possible to classify the packet!
-        // we use a reverse iterator since filter priority is not implemented properly.
-        // This way, since the default bearer is expected to be added first, it will be evaluated
-        // last.
-        std::map<uint32_t, Ptr<EpcTft>>::const_reverse_iterator it;
-        NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
+        localAddressIpv6.Serialize(key.localAddress.data());
+        remoteAddressIpv6.Serialize(key.remoteAddress.data());
+    }
+
+    // the TFTs only depend on the fields of the key, so the result of the
+    // linear walk below can be reused for all the packets of the flow
+    key.localPort = localPort;
+    key.remotePort = remotePort;
+    key.protocolNumber = protocolNumber;
+    key.tos = tos;
+    key.direction = direction;
+    auto cacheIt = m_flowCache.find(key);
+    if (cacheIt != m_flowCache.end())
+    {
+        NS_LOG_LOGIC("cached classification: TFT ID = " << cacheIt->second);
+        return cacheIt->second;
+    }
 
-        for (it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
+    // now it is possible to classify the packet!
+    // we use a reverse iterator since filter priority is not implemented properly.
+    // This way, since the default bearer is expected to be added first, it will be evaluated
+    // last.
+    NS_LOG_LOGIC("TFT MAP size: " << m_tftMap.size());
+    uint32_t id = 0;
+    for (auto it = m_tftMap.rbegin(); it != m_tftMap.rend(); ++it)
+    {
+        NS_LOG_LOGIC("TFT id: " << it->first);
+        NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
+        const Ptr<EpcTft>& tft = it->second;
+        bool matches =
+            (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
+                ? tft->Matches(direction,
+                               remoteAddressIpv4,
+                               localAddressIpv4,
+                               remotePort,
+                               localPort,
+                               tos)
+                : tft->Matches(direction,
+                               remoteAddressIpv6,
+                               localAddressIpv6,
+                               remotePort,
+                               localPort,
+                               tos);
+        if (matches)
         {
-            NS_LOG_LOGIC("TFT id: " << it->first);
-            NS_LOG_LOGIC(" Ptr<EpcTft>: " << it->second);
-            Ptr<EpcTft> tft = it->second;
-            if (tft->Matches(direction,
-                             remoteAddressIpv6,
-                             localAddressIpv6,
-                             remotePort,
-                             localPort,
-                             tos))
-            {
-                NS_LOG_LOGIC("matches with TFT ID = " << it->first);
-                return it->first; // the id of the matching TFT
-            }
+            NS_LOG_LOGIC("matches with TFT ID = " << it->first);
+            id = it->first; // the id of the matching TFT
+            break;
         }
     }
-    NS_LOG_LOGIC("no match");
-    return 0; // no match
+    if (id == 0)
+    {
+        NS_LOG_LOGIC("no match");
+    }
+
+    if (m_flowCache.size() >= MAX_CACHED_FLOWS)
+    {
+        m_flowCache.clear();
+    }
+    m_flowCache.emplace(key, id);
+    return id;
+}
+
+std::size_t
+EpcTftClassifier::FlowKeyHash::operator()(const FlowKey& key) const
+{
+    // FNV-1a over the fields of the key
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    for (uint8_t byte : key.localAddress)
+    {
+        mix(byte);
+    }
+    for (uint8_t byte : key.remoteAddress)
+    {
+        mix(byte);
+    }
+    for (uint16_t value : {key.localPort, key.remotePort, key.protocolNumber})
+    {
+        mix(value & 0xff);
+        mix(value >> 8);
+    }
+    mix(key.tos);
+    mix(key.direction);
+    return static_cast<std::size_t>(hash);
 }
 
 } // namespace ns3
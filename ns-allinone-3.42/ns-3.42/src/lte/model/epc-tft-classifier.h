@@ -25,7 +25,9 @@
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
+#include <array>
 #include <map>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -48,6 +50,11 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The result of the classification is cached per flow, i.e., per direction, addresses,
+ * ports and type of service, so that the TFTs are walked only for the first packet of
+ * each flow. The cache is flushed when a TFT is added or deleted; a TFT must hence not
+ * be modified after it has been added to the classifier.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -83,7 +90,40 @@ class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
     uint32_t Classify(Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber);
 
   protected:
+    /// The fields of a packet the classification depends on
+    struct FlowKey
+    {
+        std::array<uint8_t, 16> localAddress{};  ///< UE address (IPv4 in the first 4 bytes)
+        std::array<uint8_t, 16> remoteAddress{}; ///< remote address (IPv4 in the first 4 bytes)
+        uint16_t localPort{0};                   ///< UE port
+        uint16_t remotePort{0};                  ///< remote port
+        uint16_t protocolNumber{0};              ///< IPv4 or IPv6
+        uint8_t tos{0};                          ///< type of service
+        uint8_t direction{0};                    ///< EPC TFT direction
+
+        /**
+         * \param other another key
+         * \return true if the keys have the same fields
+         */
+        bool operator==(const FlowKey& other) const = default;
+    };
+
+    /// Hash function of the flow keys
+    struct FlowKeyHash
+    {
+        /**
+         * \param key the key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const FlowKey& key) const;
+    };
+
+    /// Maximum number of flows in the cache, which is flushed when it is full
+    static constexpr std::size_t MAX_CACHED_FLOWS = 4096;
+
     std::map<uint32_t, Ptr<EpcTft>> m_tftMap; ///< TFT map
+    std::unordered_map<FlowKey, uint32_t, FlowKeyHash>
+        m_flowCache; ///< TFT ID (0 for no match) of the flows classified since the last change
 
     std::map<std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>, std::pair<uint32_t, uint32_t>>
         m_classifiedIpv4Fragments; ///< Map with already classified IPv4 Fragments
@@ -31,6 +31,7 @@
 #include <ns3/simulator.h>
 
 #include <cfloat>
+#include <queue>
 #include <set>
 
 namespace ns3
@@ -392,21 +393,7 @@ FdTbfqFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 FdTbfqFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return CountActiveDlLcs(m_rlcBufferReq, rnti);
 }
 
 bool
@@ -1130,35 +1117,29 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
             }
         }
 
-        // assign RBGs to this UE
-        uint32_t bytesTxed = 0;
-        uint32_t bytesTxedTmp = 0;
-        int rbgIndex = 0;
-        while (bytesTxed <= budget)
+        // rank the RBGs available to this UE by decreasing achievable rate (ties are broken in
+        // favour of the lowest index), so that each iteration below picks the best remaining one
+        auto rateIsLower = [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+            return a.first < b.first || (a.first == b.first && a.second > b.second);
+        };
+        std::priority_queue<std::pair<double, int>,
+                            std::vector<std::pair<double, int>>,
+                            decltype(rateIsLower)>
+            rbgRanking(rateIsLower);
+        if (LcActivePerFlow((*itMax).first) > 0)
         {
-            totalRbg++;
-
             auto itCqi = m_a30CqiRxed.find((*itMax).first);
             auto itTxMode = m_uesTxMode.find((*itMax).first);
             if (itTxMode == m_uesTxMode.end())
             {
-                NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+                NS_FATAL_ERROR("No Transmission Mode info on user " << (*itMax).first);
             }
             auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-
-            // find RBG with largest achievableRate
-            double achievableRateMax = 0.0;
-            rbgIndex = rbgNum;
             for (int k = 0; k < rbgNum; k++)
             {
-                auto rbg = allocatedRbg.find(k);
-                if (rbg != allocatedRbg.end()) // RBGs are already allocated to this UE
-                {
-                    continue;
-                }
-
-                if (rbgMap.at(k)) // this RBG is allocated in RACH procedure
+                if (allocatedRbg.find(k) != allocatedRbg.end() || rbgMap.at(k))
                 {
+                    // RBG already allocated to a UE or in RACH procedure
                     continue;
                 }
 
@@ -1186,34 +1167,60 @@ FdTbfqFfMacScheduler::DoSchedDlTriggerReq(
                 if ((cqi1 > 0) ||
                     (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                    if (LcActivePerFlow((*itMax).first) > 0)
+                    // this UE has data to transmit
+                    double achievableRate = 0.0;
+                    for (uint8_t j = 0; j < nLayer; j++)
                     {
-                        // this UE has data to transmit
-                        double achievableRate = 0.0;
-                        for (uint8_t j = 0; j < nLayer; j++)
+                        uint8_t mcs = 0;
+                        if (sbCqi.size() > j)
                         {
-                            uint8_t mcs = 0;
-                            if (sbCqi.size() > j)
-                            {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(j));
-                            }
-                            else
-                            {
-                                // no info on this subband -> worst MCS
-                                mcs = 0;
-                            }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
+                            mcs = m_amc->GetMcsFromCqi(sbCqi.at(j));
                         }
-
-                        if (achievableRate > achievableRateMax)
+                        else
                         {
-                            achievableRateMax = achievableRate;
-                            rbgIndex = k;
+                            // no info on this subband -> worst MCS
+                            mcs = 0;
                         }
-                    } // end of LcActivePerFlow
-                }     // end of cqi
-            }         // end of for rbgNum
+                        achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
+                                           0.001); // = TB size / TTI
+                    }
+
+                    if (achievableRate > 0.0)
+                    {
+                        rbgRanking.emplace(achievableRate, k);
+                    }
+                }
+            }
+        }
+
+        // assign RBGs to this UE
+        uint32_t bytesTxed = 0;
+        uint32_t bytesTxedTmp = 0;
+        int rbgIndex = 0;
+        while (bytesTxed <= budget)
+        {
+            totalRbg++;
+
+            auto itCqi = m_a30CqiRxed.find((*itMax).first);
+            auto itTxMode = m_uesTxMode.find((*itMax).first);
+            if (itTxMode == m_uesTxMode.end())
+            {
+                NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
+            }
+            auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+
+            // find RBG with largest achievableRate
+            rbgIndex = rbgNum;
+            while (!rbgRanking.empty())
+            {
+                int k = rbgRanking.top().second;
+                rbgRanking.pop();
+                if (allocatedRbg.find(k) == allocatedRbg.end() && !rbgMap.at(k))
+                {
+                    rbgIndex = k;
+                    break;
+                }
+            }
 
             if (rbgIndex == rbgNum) // impossible
             {
@@ -64,4 +64,24 @@ FfMacScheduler::GetTypeId()
     return tid;
 }
 
+unsigned int
+FfMacScheduler::CountActiveDlLcs(
+    const std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>&
+        rlcBufferReq,
+    uint16_t rnti)
+{
+    unsigned int lcActive = 0;
+    for (auto it = rlcBufferReq.lower_bound(LteFlowId_t(rnti, 0));
+         it != rlcBufferReq.end() && it->first.m_rnti == rnti;
+         ++it)
+    {
+        if ((it->second.m_rlcTransmissionQueueSize > 0) ||
+            (it->second.m_rlcRetransmissionQueueSize > 0) || (it->second.m_rlcStatusPduSize > 0))
+        {
+            lcActive++;
+        }
+    }
+    return lcActive;
+}
+
 } // namespace ns3
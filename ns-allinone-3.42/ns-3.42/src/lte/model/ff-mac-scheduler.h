@@ -22,16 +22,19 @@
 #define FF_MAC_SCHEDULER_H
 
 #include "ff-mac-common.h"
+#include "ff-mac-sched-sap.h"
+#include "lte-common.h"
 
 #include <ns3/object.h>
 
+#include <map>
+
 namespace ns3
 {
 
 class FfMacCschedSapUser;
 class FfMacSchedSapUser;
 class FfMacCschedSapProvider;
-class FfMacSchedSapProvider;
 class LteFfrSapProvider;
 class LteFfrSapUser;
 
@@ -159,6 +162,21 @@ class FfMacScheduler : public Object
     virtual LteFfrSapUser* GetLteFfrSapUser() = 0;
 
   protected:
+    /**
+     * Count the logical channels of a UE that have data to transmit in the DL.
+     *
+     * The buffer status reports are sorted by RNTI first, hence only the
+     * reports of the given UE are visited.
+     *
+     * \param rlcBufferReq the DL RLC buffer status reports, indexed by flow
+     * \param rnti the RNTI of the UE
+     * \return the number of active logical channels of the UE
+     */
+    static unsigned int CountActiveDlLcs(
+        const std::map<LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>&
+            rlcBufferReq,
+        uint16_t rnti);
+
     UlCqiFilter_t m_ulCqiFilter; ///< UL CQI filter
 };
 
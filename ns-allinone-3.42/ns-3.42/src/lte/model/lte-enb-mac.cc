@@ -28,17 +28,36 @@
 #include "lte-enb-cmac-sap.h"
 #include "lte-mac-sap.h"
 #include "lte-radio-bearer-tag.h"
+#include "lte-scheduler-thread-pool.h"
 
+#include <ns3/boolean.h>
+#include <ns3/global-value.h>
 #include <ns3/log.h>
 #include <ns3/packet.h>
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
+#include <ns3/uinteger.h>
+
+#include <algorithm>
+#include <memory>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("LteEnbMac");
 
+/**
+ * \ingroup lte
+ * Number of threads running the eNB MAC schedulers that have the
+ * ParallelScheduling attribute enabled.
+ */
+static GlobalValue g_lteSchedulerThreads(
+    "LteSchedulerThreads",
+    "Number of threads (including the simulation thread) running the eNB MAC schedulers "
+    "in parallel, see ns3::LteEnbMac::ParallelScheduling; 0 means one for each hardware thread",
+    UintegerValue(0),
+    MakeUintegerChecker<uint32_t>());
+
 NS_OBJECT_ENSURE_REGISTERED(LteEnbMac);
 
 // //////////////////////////////////////
@@ -354,7 +373,16 @@ LteEnbMac::GetTypeId()
                           "ComponentCarrier Id, needed to reply on the appropriate sap.",
                           UintegerValue(0),
                           MakeUintegerAccessor(&LteEnbMac::m_componentCarrierId),
-                          MakeUintegerChecker<uint8_t>(0, 4));
+                          MakeUintegerChecker<uint8_t>(0, 4))
+            .AddAttribute("ParallelScheduling",
+                          "If true, the scheduler triggers issued by all the eNB MACs with this "
+                          "attribute enabled in a TTI are collected and the schedulers run "
+                          "concurrently on a pool of LteSchedulerThreads threads once all the "
+                          "subframe indications of the TTI have been processed. The scheduling "
+                          "decisions are applied in the order of the subframe indications.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LteEnbMac::m_parallelScheduling),
+                          MakeBooleanChecker());
 
     return tid;
 }
@@ -386,6 +414,10 @@ LteEnbMac::DoDispose()
     m_dlInfoListReceived.clear();
     m_ulInfoListReceived.clear();
     m_miDlHarqProcessesPackets.clear();
+    m_bufferedDlConfigInd.clear();
+    m_bufferedUlConfigInd.clear();
+    auto& queue = GetParallelSchedulingQueue();
+    queue.erase(std::remove(queue.begin(), queue.end(), this), queue.end());
     delete m_macSapProvider;
     delete m_cmacSapProvider;
     delete m_schedSapUser;
@@ -559,7 +591,8 @@ LteEnbMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
     {
         dlSchedSubframeNo = dlSchedSubframeNo + m_macChTtiDelay;
     }
-    FfMacSchedSapProvider::SchedDlTriggerReqParameters dlparams;
+    SchedulerTriggers triggers;
+    FfMacSchedSapProvider::SchedDlTriggerReqParameters& dlparams = triggers.dlTrigger;
     dlparams.m_sfnSf = ((0x3FF & dlSchedFrameNo) << 4) | (0xF & dlSchedSubframeNo);
 
     // Forward DL HARQ Feedbacks collected during last TTI
@@ -570,8 +603,6 @@ LteEnbMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
         m_dlInfoListReceived.clear();
     }
 
-    m_schedSapProvider->SchedDlTriggerReq(dlparams);
-
     // --- UPLINK ---
     // Send UL-CQI info to the scheduler
     for (std::size_t i = 0; i < m_ulCqiReceived.size(); i++)
@@ -584,9 +615,8 @@ LteEnbMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
         {
             m_ulCqiReceived.at(i).m_sfnSf = ((0x3FF & (frameNo - 1)) << 4) | (0xF & 10);
         }
-        m_schedSapProvider->SchedUlCqiInfoReq(m_ulCqiReceived.at(i));
     }
-    m_ulCqiReceived.clear();
+    triggers.ulCqi.swap(m_ulCqiReceived);
 
     // Send BSR reports to the scheduler
     if (!m_ulCeReceived.empty())
@@ -597,7 +627,7 @@ LteEnbMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
                                     m_ulCeReceived.begin(),
                                     m_ulCeReceived.end());
         m_ulCeReceived.erase(m_ulCeReceived.begin(), m_ulCeReceived.end());
-        m_schedSapProvider->SchedUlMacCtrlInfoReq(ulMacReq);
+        triggers.ulMacCtrl = std::move(ulMacReq);
     }
 
     // Get uplink transmission opportunities
@@ -613,7 +643,7 @@ LteEnbMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
     {
         ulSchedSubframeNo = ulSchedSubframeNo + (m_macChTtiDelay + UL_PUSCH_TTIS_DELAY);
     }
-    FfMacSchedSapProvider::SchedUlTriggerReqParameters ulparams;
+    FfMacSchedSapProvider::SchedUlTriggerReqParameters& ulparams = triggers.ulTrigger;
     ulparams.m_sfnSf = ((0x3FF & ulSchedFrameNo) << 4) | (0xF & ulSchedSubframeNo);
 
     // Forward DL HARQ Feedbacks collected during last TTI
@@ -624,7 +654,102 @@ LteEnbMac::DoSubframeIndication(uint32_t frameNo, uint32_t subframeNo)
         m_ulInfoListReceived.clear();
     }
 
-    m_schedSapProvider->SchedUlTriggerReq(ulparams);
+    if (m_parallelScheduling)
+    {
+        m_pendingTriggers = std::move(triggers);
+        EnqueueParallelScheduling(this);
+    }
+    else
+    {
+        SendSchedulerTriggers(triggers);
+    }
+}
+
+void
+LteEnbMac::SendSchedulerTriggers(const SchedulerTriggers& triggers)
+{
+    NS_LOG_FUNCTION(this);
+    m_schedSapProvider->SchedDlTriggerReq(triggers.dlTrigger);
+    for (const auto& ulCqi : triggers.ulCqi)
+    {
+        m_schedSapProvider->SchedUlCqiInfoReq(ulCqi);
+    }
+    if (triggers.ulMacCtrl.has_value())
+    {
+        m_schedSapProvider->SchedUlMacCtrlInfoReq(*triggers.ulMacCtrl);
+    }
+    m_schedSapProvider->SchedUlTriggerReq(triggers.ulTrigger);
+}
+
+std::vector<Ptr<LteEnbMac>>&
+LteEnbMac::GetParallelSchedulingQueue()
+{
+    static thread_local std::vector<Ptr<LteEnbMac>> queue;
+    return queue;
+}
+
+void
+LteEnbMac::EnqueueParallelScheduling(Ptr<LteEnbMac> mac)
+{
+    NS_LOG_FUNCTION(mac);
+    static thread_local Time queueTime;
+    auto& queue = GetParallelSchedulingQueue();
+    if (!queue.empty() && queueTime != Simulator::Now())
+    {
+        // the simulation stopped before the previous batch could run
+        NS_LOG_LOGIC("Discarding " << queue.size() << " stale scheduler triggers");
+        queue.clear();
+    }
+    if (queue.empty())
+    {
+        queueTime = Simulator::Now();
+        // the batch runs after all the subframe indications of this TTI
+        Simulator::ScheduleNow(&LteEnbMac::RunParallelScheduling);
+    }
+    queue.push_back(mac);
+}
+
+void
+LteEnbMac::RunParallelScheduling()
+{
+    std::vector<Ptr<LteEnbMac>> batch;
+    batch.swap(GetParallelSchedulingQueue());
+    NS_LOG_FUNCTION(batch.size());
+
+    static thread_local std::unique_ptr<LteSchedulerThreadPool> pool;
+    if (!pool)
+    {
+        UintegerValue nThreads;
+        g_lteSchedulerThreads.GetValue(nThreads);
+        pool = std::make_unique<LteSchedulerThreadPool>(nThreads.Get());
+    }
+
+    for (auto& mac : batch)
+    {
+        mac->m_bufferSchedIndications = true;
+    }
+    pool->Run(batch.size(), [&batch](std::size_t i) {
+        batch[i]->SendSchedulerTriggers(batch[i]->m_pendingTriggers);
+    });
+
+    // apply the decisions of the schedulers in the order of the subframe indications
+    for (auto& mac : batch)
+    {
+        mac->m_bufferSchedIndications = false;
+        mac->m_pendingTriggers = SchedulerTriggers();
+        std::vector<FfMacSchedSapUser::SchedDlConfigIndParameters> dlInds;
+        std::vector<FfMacSchedSapUser::SchedUlConfigIndParameters> ulInds;
+        dlInds.swap(mac->m_bufferedDlConfigInd);
+        ulInds.swap(mac->m_bufferedUlConfigInd);
+        for (auto& ind : dlInds)
+        {
+            mac->DoSchedDlConfigInd(ind);
+        }
+        for (auto& ind : ulInds)
+        {
+            mac->DoSchedUlConfigInd(ind);
+        }
+    }
 }
 
 void
@@ -1059,6 +1184,12 @@ void
 LteEnbMac::DoSchedDlConfigInd(FfMacSchedSapUser::SchedDlConfigIndParameters ind)
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferSchedIndications)
+    {
+        // the scheduler is running on a worker thread, see RunParallelScheduling
+        m_bufferedDlConfigInd.push_back(ind);
+        return;
+    }
     // Create DL PHY PDU
     Ptr<PacketBurst> pb = CreateObject<PacketBurst>();
     LteMacSapUser::TxOpportunityParameters txOpParams;
@@ -1205,6 +1336,12 @@ void
 LteEnbMac::DoSchedUlConfigInd(FfMacSchedSapUser::SchedUlConfigIndParameters ind)
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferSchedIndications)
+    {
+        // the scheduler is running on a worker thread, see RunParallelScheduling
+        m_bufferedUlConfigInd.push_back(ind);
+        return;
+    }
 
     for (unsigned int i = 0; i < ind.m_dciList.size(); i++)
     {
@@ -39,6 +39,7 @@
 #include <ns3/traced-value.h>
 
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace ns3
@@ -374,6 +375,41 @@ class LteEnbMac : public Object
      */
     void DoDlInfoListElementHarqFeedback(DlInfoListElement_s params);
 
+    /// Scheduler requests issued at each subframe indication, after the DL CQI and RACH ones
+    struct SchedulerTriggers
+    {
+        FfMacSchedSapProvider::SchedDlTriggerReqParameters dlTrigger; ///< DL trigger request
+        std::vector<FfMacSchedSapProvider::SchedUlCqiInfoReqParameters>
+            ulCqi; ///< UL CQI info requests
+        std::optional<FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters>
+            ulMacCtrl;                                                ///< UL MAC CE info request
+        FfMacSchedSapProvider::SchedUlTriggerReqParameters ulTrigger; ///< UL trigger request
+    };
+
+    /**
+     * \brief Send the given requests to the scheduler
+     * \param triggers the scheduler requests
+     */
+    void SendSchedulerTriggers(const SchedulerTriggers& triggers);
+
+    /**
+     * \return the eNB MACs whose scheduler triggers wait for the next parallel batch
+     */
+    static std::vector<Ptr<LteEnbMac>>& GetParallelSchedulingQueue();
+
+    /**
+     * \brief Add the given MAC to the next parallel scheduling batch, scheduling the
+     * latter if needed
+     * \param mac the MAC whose pending scheduler triggers have to be sent
+     */
+    static void EnqueueParallelScheduling(Ptr<LteEnbMac> mac);
+
+    /**
+     * \brief Run the schedulers of the queued MACs in parallel, then apply their
+     * configuration indications in the order the MACs have been queued
+     */
+    static void RunParallelScheduling();
+
     /// RNTI, LC ID, SAP of the RLC instance
     std::map<uint16_t, std::map<uint8_t, LteMacSapUser*>> m_rlcAttached;
 
@@ -463,6 +499,14 @@ class LteEnbMac : public Object
 
     /// component carrier Id used to address sap
     uint8_t m_componentCarrierId;
+
+    bool m_parallelScheduling;             ///< whether the scheduler runs in a parallel batch
+    bool m_bufferSchedIndications{false};  ///< whether scheduler indications must be buffered
+    SchedulerTriggers m_pendingTriggers;   ///< triggers waiting for the parallel batch
+    std::vector<FfMacSchedSapUser::SchedDlConfigIndParameters>
+        m_bufferedDlConfigInd; ///< DL config indications issued in the parallel batch
+    std::vector<FfMacSchedSapUser::SchedUlConfigIndParameters>
+        m_bufferedUlConfigInd; ///< UL config indications issued in the parallel batch
 };
 
 } // end namespace ns3
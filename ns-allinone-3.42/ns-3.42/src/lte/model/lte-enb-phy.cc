@@ -246,6 +246,7 @@ LteEnbPhy::DoDispose()
     NS_LOG_FUNCTION(this);
     m_ueAttached.clear();
     m_srsUeOffset.clear();
+    m_dlCtrlTxPsd = nullptr;
     delete m_enbPhySapProvider;
     delete m_enbCphySapProvider;
     LtePhy::DoDispose();
@@ -305,6 +306,7 @@ LteEnbPhy::SetTxPower(double pow)
 {
     NS_LOG_FUNCTION(this << pow);
     m_txPower = pow;
+    m_dlCtrlTxPsd = nullptr;
 }
 
 double
@@ -775,7 +777,12 @@ LteEnbPhy::SendControlChannels(std::list<Ptr<LteControlMessage>> ctrlMsgList)
     {
         dlRb.push_back(i);
     }
-    SetDownlinkSubChannels(dlRb);
+    m_listOfDownlinkSubchannel = dlRb;
+    if (!m_dlCtrlTxPsd)
+    {
+        m_dlCtrlTxPsd = CreateTxPowerSpectralDensity();
+    }
+    m_downlinkSpectrumPhy->SetTxPowerSpectralDensity(m_dlCtrlTxPsd);
     NS_LOG_LOGIC(this << " eNB start TX CTRL");
     bool pss = false;
     if ((m_nrSubFrames == 1) || (m_nrSubFrames == 6))
@@ -880,6 +887,7 @@ LteEnbPhy::DoSetBandwidth(uint16_t ulBandwidth, uint16_t dlBandwidth)
     NS_LOG_FUNCTION(this << (uint32_t)ulBandwidth << (uint32_t)dlBandwidth);
     m_ulBandwidth = ulBandwidth;
     m_dlBandwidth = dlBandwidth;
+    m_dlCtrlTxPsd = nullptr;
 
     static const int Type0AllocationRbg[4] = {
         10,  // RBG size 1
@@ -903,6 +911,7 @@ LteEnbPhy::DoSetEarfcn(uint32_t ulEarfcn, uint32_t dlEarfcn)
     NS_LOG_FUNCTION(this << ulEarfcn << dlEarfcn);
     m_ulEarfcn = ulEarfcn;
     m_dlEarfcn = dlEarfcn;
+    m_dlCtrlTxPsd = nullptr;
 }
 
 void
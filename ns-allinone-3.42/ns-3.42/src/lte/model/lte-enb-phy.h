@@ -437,6 +437,13 @@ class LteEnbPhy : public LtePhy
 
     std::vector<int> m_dlDataRbMap; ///< DL data RB map
 
+    /**
+     * The tx power spectral density of the DL control frames. Control frames
+     * are sent over the whole bandwidth in every subframe, hence their PSD is
+     * only computed again when the tx power, the bandwidth or the EARFCN change.
+     */
+    Ptr<SpectrumValue> m_dlCtrlTxPsd;
+
     /// For storing info on future receptions.
     std::vector<std::list<UlDciLteControlMessage>> m_ulDciQueue;
 
@@ -21,6 +21,7 @@
 
 #include "lte-chunk-processor.h"
 
+#include <ns3/abort.h>
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 
@@ -131,6 +132,12 @@ void
 LteInterference::AddSignal(Ptr<const SpectrumValue> spd, const Time duration)
 {
     NS_LOG_FUNCTION(this << *spd << duration);
+    if (m_pruningThreshold > 0 && IsNegligible(*spd))
+    {
+        // the signal is neither added nor subtracted, hence it is as if it never existed
+        NS_LOG_LOGIC("neglecting signal below the pruning threshold");
+        return;
+    }
     DoAddSignal(spd);
     uint32_t signalId = ++m_lastSignalId;
     if (signalId == m_lastSignalIdBeforeReset)
@@ -183,9 +190,21 @@ LteInterference::ConditionallyEvaluateChunk()
         NS_LOG_LOGIC(this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals
                           << " noise = " << *m_noise);
 
-        SpectrumValue interf = (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+        // compute the interference and the SINR of every RB in a single pass,
+        // rather than through temporary SpectrumValues for each operation
+        SpectrumValue interf(m_noise->GetSpectrumModel());
+        SpectrumValue sinr(m_noise->GetSpectrumModel());
+        auto allIt = m_allSignals->ConstValuesBegin();
+        auto rxIt = m_rxSignal->ConstValuesBegin();
+        auto noiseIt = m_noise->ConstValuesBegin();
+        auto sinrIt = sinr.ValuesBegin();
+        for (auto interfIt = interf.ValuesBegin(); interfIt != interf.ValuesEnd();
+             ++interfIt, ++allIt, ++rxIt, ++noiseIt, ++sinrIt)
+        {
+            *interfIt = *allIt - *rxIt + *noiseIt;
+            *sinrIt = *rxIt / *interfIt;
+        }
 
-        SpectrumValue sinr = (*m_rxSignal) / interf;
         Time duration = Now() - m_lastChangeTime;
         for (auto it = m_sinrChunkProcessorList.begin(); it != m_sinrChunkProcessorList.end(); ++it)
         {
@@ -224,6 +243,42 @@ LteInterference::SetNoisePowerSpectralDensity(Ptr<const SpectrumValue> noisePsd)
     m_lastSignalIdBeforeReset = m_lastSignalId;
 }
 
+void
+LteInterference::SetPruningThreshold(double threshold)
+{
+    NS_LOG_FUNCTION(this << threshold);
+    // a neglected signal of interest is still subtracted from the total interference
+    // when computing the SINR, which must stay positive
+    NS_ABORT_MSG_IF(threshold < 0 || threshold >= 1,
+                    "The pruning threshold must be in the [0, 1) interval");
+    m_pruningThreshold = threshold;
+}
+
+double
+LteInterference::GetPruningThreshold() const
+{
+    return m_pruningThreshold;
+}
+
+bool
+LteInterference::IsNegligible(const SpectrumValue& spd) const
+{
+    if (!m_noise)
+    {
+        return false;
+    }
+    NS_ASSERT(spd.GetValuesN() == m_noise->GetValuesN());
+    auto noiseIt = m_noise->ConstValuesBegin();
+    for (auto it = spd.ConstValuesBegin(); it != spd.ConstValuesEnd(); ++it, ++noiseIt)
+    {
+        if (*it >= m_pruningThreshold * *noiseIt)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 LteInterference::AddRsPowerChunkProcessor(Ptr<LteChunkProcessor> p)
 {
@@ -108,6 +108,24 @@ class LteInterference : public Object
      */
     virtual void SetNoisePowerSpectralDensity(Ptr<const SpectrumValue> noisePsd);
 
+    /**
+     * Set the threshold below which incoming signals are neglected. A signal
+     * whose power spectral density is lower than the given fraction of the
+     * noise power spectral density in every RB is not added to the total
+     * interference. This is meant for large multi-cell deployments where every
+     * receiver perceives the signals of many far away cells.
+     *
+     * @param threshold the threshold, relative to the noise (0 disables pruning,
+     *                  values must be lower than 1)
+     */
+    void SetPruningThreshold(double threshold);
+
+    /**
+     * @return the threshold below which incoming signals are neglected,
+     *         relative to the noise
+     */
+    double GetPruningThreshold() const;
+
   protected:
     /**
      * Conditionally evaluate chunk
@@ -127,6 +145,12 @@ class LteInterference : public Object
      */
     virtual void DoSubtractSignal(Ptr<const SpectrumValue> spd, uint32_t signalId);
 
+    /**
+     * @param spd the power spectral density of a signal
+     * @return whether the signal is below the pruning threshold in every RB
+     */
+    bool IsNegligible(const SpectrumValue& spd) const;
+
     bool m_receiving{false}; ///< are we receiving?
 
     Ptr<SpectrumValue> m_rxSignal{nullptr}; /**< stores the power spectral density of
@@ -149,6 +173,8 @@ class LteInterference : public Object
     uint32_t m_lastSignalId{0};            ///< the last signal ID
     uint32_t m_lastSignalIdBeforeReset{0}; ///< the last signal ID before reset
 
+    double m_pruningThreshold{0}; ///< the pruning threshold, relative to the noise
+
     /** all the processor instances that need to be notified whenever
     a new interference chunk is calculated */
     std::list<Ptr<LteChunkProcessor>> m_rsPowerChunkProcessorList;
@@ -37,6 +37,7 @@
 #include <list>
 #include <stdint.h>
 #include <stdlib.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -903,86 +904,69 @@ static const double cEcrTable [9][38] = {
 
 // clang-format on
 
+/// Uniformly spaced curve mapping the SINR to the MI for a given modulation
+struct MiMapCurve
+{
+    const double* axis;  ///< the SINR values (linear), uniformly spaced
+    const double* mi;    ///< the MI values corresponding to the SINR values
+    uint16_t size;       ///< the number of points of the curve
+    double scalingCoeff; ///< the inverse of the spacing between two SINR values
+};
+
+/**
+ * \param mcs the MCS
+ * \return the curve mapping the SINR to the MI for the modulation of the given MCS
+ */
+static const MiMapCurve&
+GetMiMapCurve(uint8_t mcs)
+{
+    // since the values of the axis are uniformly spaced, we have
+    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+    // the scaling coefficient is always the same, so we compute it once
+    auto makeCurve = [](const double* axis, const double* mi, uint16_t size) {
+        return MiMapCurve{axis, mi, size, (size - 1) / (axis[size - 1] - axis[0])};
+    };
+    static const auto qpsk = makeCurve(MI_map_qpsk_axis, MI_map_qpsk, MI_MAP_QPSK_SIZE);
+    static const auto qam16 = makeCurve(MI_map_16qam_axis, MI_map_16qam, MI_MAP_16QAM_SIZE);
+    static const auto qam64 = makeCurve(MI_map_64qam_axis, MI_map_64qam, MI_MAP_64QAM_SIZE);
+
+    if (mcs <= MI_QPSK_MAX_ID)
+    {
+        return qpsk;
+    }
+    if (mcs <= MI_16QAM_MAX_ID)
+    {
+        return qam16;
+    }
+    return qam64;
+}
+
 double
 LteMiErrorModel::Mib(const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
 {
     NS_LOG_FUNCTION(sinr << &map << (uint32_t)mcs);
 
+    // the modulation is the same for all the RBs, hence select the curve once
+    const auto& curve = GetMiMapCurve(mcs);
+    const double maxSinr = curve.axis[curve.size - 1];
     double MI;
     double MIsum = 0.0;
 
-    for (uint32_t i = 0; i < map.size(); i++)
+    for (const auto rb : map)
     {
-        double sinrLin = sinr[map.at(i)];
-        if (mcs <= MI_QPSK_MAX_ID) // QPSK
+        double sinrLin = sinr[rb];
+        if (sinrLin > maxSinr)
         {
-            if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1])
-            {
-                MI = 1;
-            }
-            else
-            {
-                // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-                // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                // the scaling coefficient is always the same, so we use a static const
-                // to speed up the calculation
-                static const double scalingCoeffQpsk =
-                    (MI_MAP_QPSK_SIZE - 1) /
-                    (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE - 1] - MI_map_qpsk_axis[0]);
-                double sinrIndexDouble = (sinrLin - MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-                uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                NS_ASSERT_MSG(sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-                MI = MI_map_qpsk[sinrIndex];
-            }
+            MI = 1;
         }
         else
         {
-            if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID) // 16-QAM
-            {
-                if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff16qam =
-                        (MI_MAP_16QAM_SIZE - 1) /
-                        (MI_map_16qam_axis[MI_MAP_16QAM_SIZE - 1] - MI_map_16qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                    MI = MI_map_16qam[sinrIndex];
-                }
-            }
-            else // 64-QAM
-            {
-                if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1])
-                {
-                    MI = 1;
-                }
-                else
-                {
-                    // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                    // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                    // the scaling coefficient is always the same, so we use a static const
-                    // to speed up the calculation
-                    static const double scalingCoeff64qam =
-                        (MI_MAP_64QAM_SIZE - 1) /
-                        (MI_map_64qam_axis[MI_MAP_64QAM_SIZE - 1] - MI_map_64qam_axis[0]);
-                    double sinrIndexDouble =
-                        (sinrLin - MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                    uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
-                    NS_ASSERT_MSG(sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                    MI = MI_map_64qam[sinrIndex];
-                }
-            }
+            double sinrIndexDouble = (sinrLin - curve.axis[0]) * curve.scalingCoeff + 1;
+            uint32_t sinrIndex = std::max(0.0, std::floor(sinrIndexDouble));
+            NS_ASSERT_MSG(sinrIndex < curve.size, "MI map out of data");
+            MI = curve.mi[sinrIndex];
         }
-        NS_LOG_LOGIC(" RB " << map.at(i) << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
+        NS_LOG_LOGIC(" RB " << rb << "Minimum SNR = " << 10 * std::log10(sinrLin) << " dB, "
                             << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
         MIsum += MI;
     }
@@ -1125,43 +1109,27 @@ LteMiErrorModel::GetPcfichPdcchError(const SpectrumValue& sinr)
     return errorRate;
 }
 
-TbStats_t
-LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
-                                          const std::vector<int>& map,
-                                          uint16_t size,
-                                          uint8_t mcs,
-                                          HarqProcessInfoList_t miHistory)
+/// Code block segmentation of a TB
+struct CodeBlockSegmentation
 {
-    NS_LOG_FUNCTION(sinr << &map << (uint32_t)size << (uint32_t)mcs);
+    uint32_t B;      ///< no. of bits of the TB
+    uint32_t B1;     ///< no. of bits of the TB including the CRCs of the codeblocks
+    uint32_t C;      ///< no. of codeblocks
+    uint32_t Cplus;  ///< no. of codeblocks with size K+
+    uint32_t Kplus;  ///< size K+ of the largest codeblocks
+    uint32_t Cminus; ///< no. of codeblocks with size K-
+    uint32_t Kminus; ///< size K- of the smallest codeblocks
+};
 
-    double tbMi = Mib(sinr, map, mcs);
-    double MI = 0.0;
-    double Reff = 0.0;
-    NS_ASSERT(mcs < 29);
-    if (!miHistory.empty())
-    {
-        // evaluate R_eff and MI_eff
-        uint16_t codeBitsSum = 0;
-        double miSum = 0.0;
-        for (std::size_t i = 0; i < miHistory.size(); i++)
-        {
-            NS_LOG_DEBUG(" Sum MI " << miHistory.at(i).m_mi << " Ci "
-                                    << miHistory.at(i).m_codeBits);
-            codeBitsSum += miHistory.at(i).m_codeBits;
-            miSum += (miHistory.at(i).m_mi * miHistory.at(i).m_codeBits);
-        }
-        codeBitsSum += (((double)size * 8.0) / McsEcrTable[mcs]);
-        miSum += (tbMi * (((double)size * 8.0) / McsEcrTable[mcs]));
-        Reff = miHistory.at(0).m_infoBits /
-               (double)codeBitsSum; // information bits are the size of the first TB
-        MI = miSum / (double)codeBitsSum;
-    }
-    else
-    {
-        MI = tbMi;
-    }
-    NS_LOG_DEBUG(" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size());
-    // estimate CB size (according to sec 5.1.2 of TS 36.212)
+/**
+ * Estimate the CB size (according to sec 5.1.2 of TS 36.212)
+ *
+ * \param size the size in bytes of the TB
+ * \return the code block segmentation of the TB
+ */
+static CodeBlockSegmentation
+ComputeCodeBlockSegmentation(uint16_t size)
+{
     uint16_t Z = 6144; // max size of a codeblock (including CRC)
     uint32_t B = size * 8;
     //   B = 1234;
@@ -1249,6 +1217,65 @@ LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
         Cminus = floor((((double)C * Kplus) - (double)B1) / (double)deltaK);
         Cplus = C - Cminus;
     }
+    return {B, B1, C, Cplus, Kplus, Cminus, Kminus};
+}
+
+/**
+ * Get the code block segmentation of a TB. The segmentation only depends on the size of the
+ * TB, which takes few distinct values in a simulation, hence it is computed once per size.
+ *
+ * \param size the size in bytes of the TB
+ * \return the code block segmentation of the TB
+ */
+static const CodeBlockSegmentation&
+GetCodeBlockSegmentation(uint16_t size)
+{
+    static thread_local std::unordered_map<uint16_t, CodeBlockSegmentation> segmentations;
+    auto it = segmentations.find(size);
+    if (it == segmentations.end())
+    {
+        it = segmentations.emplace(size, ComputeCodeBlockSegmentation(size)).first;
+    }
+    return it->second;
+}
+
+TbStats_t
+LteMiErrorModel::GetTbDecodificationStats(const SpectrumValue& sinr,
+                                          const std::vector<int>& map,
+                                          uint16_t size,
+                                          uint8_t mcs,
+                                          const HarqProcessInfoList_t& miHistory)
+{
+    NS_LOG_FUNCTION(sinr << &map << (uint32_t)size << (uint32_t)mcs);
+
+    double tbMi = Mib(sinr, map, mcs);
+    double MI = 0.0;
+    double Reff = 0.0;
+    NS_ASSERT(mcs < 29);
+    if (!miHistory.empty())
+    {
+        // evaluate R_eff and MI_eff
+        uint16_t codeBitsSum = 0;
+        double miSum = 0.0;
+        for (std::size_t i = 0; i < miHistory.size(); i++)
+        {
+            NS_LOG_DEBUG(" Sum MI " << miHistory.at(i).m_mi << " Ci "
+                                    << miHistory.at(i).m_codeBits);
+            codeBitsSum += miHistory.at(i).m_codeBits;
+            miSum += (miHistory.at(i).m_mi * miHistory.at(i).m_codeBits);
+        }
+        codeBitsSum += (((double)size * 8.0) / McsEcrTable[mcs]);
+        miSum += (tbMi * (((double)size * 8.0) / McsEcrTable[mcs]));
+        Reff = miHistory.at(0).m_infoBits /
+               (double)codeBitsSum; // information bits are the size of the first TB
+        MI = miSum / (double)codeBitsSum;
+    }
+    else
+    {
+        MI = tbMi;
+    }
+    NS_LOG_DEBUG(" MI " << MI << " Reff " << Reff << " HARQ " << miHistory.size());
+    const auto& [B, B1, C, Cplus, Kplus, Cminus, Kminus] = GetCodeBlockSegmentation(size);
     NS_LOG_INFO("--------------------LteMiErrorModel: TB size of "
                 << B << " needs of " << B1 << " bits reparted in " << C << " CBs as " << Cplus
                 << " block(s) of " << Kplus << " and " << Cminus << " of " << Kminus);
@@ -44,6 +44,7 @@ LteRlcAm::LteRlcAm()
     m_retxBufferSize = 0;
     m_txedBuffer.resize(1024);
     m_txedBufferSize = 0;
+    m_rxonBuffer.resize(1024);
 
     m_statusPduRequested = false;
     m_statusPduBufferSize = 0;
@@ -246,8 +247,7 @@ LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
                 NS_LOG_LOGIC("Can't fit more NACKs in STATUS PDU");
                 break;
             }
-            auto pduIt = m_rxonBuffer.find(sn.GetValue());
-            if (pduIt == m_rxonBuffer.end() || (!(pduIt->second.m_pduComplete)))
+            if (!m_rxonBuffer.at(sn.GetValue()).m_pduComplete)
             {
                 NS_LOG_LOGIC("adding NACK_SN " << sn.GetValue());
                 rlcAmHeader.PushNack(sn.GetValue());
@@ -257,13 +257,11 @@ LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
         // 3GPP TS 36.322 section 6.2.2.1.4 ACK SN
         // find the  SN of the next not received RLC Data PDU
         // which is not reported as missing in the STATUS PDU.
-        auto pduIt = m_rxonBuffer.find(sn.GetValue());
-        while ((sn < m_vrMs) && (pduIt != m_rxonBuffer.end()) && (pduIt->second.m_pduComplete))
+        while ((sn < m_vrMs) && m_rxonBuffer.at(sn.GetValue()).m_pduComplete)
         {
             NS_LOG_LOGIC("SN = " << sn << " < " << m_vrMs << " = " << (sn < m_vrMs));
             sn++;
             NS_LOG_LOGIC("SN = " << sn);
-            pduIt = m_rxonBuffer.find(sn.GetValue());
         }
 
         NS_ASSERT_MSG(sn <= m_vrMs,
@@ -392,15 +390,14 @@ LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
                     }
 
                     NS_LOG_INFO("Move SN = " << seqNumberValue << " back to txedBuffer");
-                    m_txedBuffer.at(seqNumberValue).m_pdu =
-                        m_retxBuffer.at(seqNumberValue).m_pdu->Copy();
+                    m_txedBuffer.at(seqNumberValue).m_pdu = m_retxBuffer.at(seqNumberValue).m_pdu;
                     m_txedBuffer.at(seqNumberValue).m_retxCount =
                         m_retxBuffer.at(seqNumberValue).m_retxCount;
                     m_txedBuffer.at(seqNumberValue).m_waitingSince =
                         m_retxBuffer.at(seqNumberValue).m_waitingSince;
                     m_txedBufferSize += m_txedBuffer.at(seqNumberValue).m_pdu->GetSize();
 
-                    m_retxBufferSize -= m_retxBuffer.at(seqNumberValue).m_pdu->GetSize();
+                    m_retxBufferSize -= m_txedBuffer.at(seqNumberValue).m_pdu->GetSize();
                     m_retxBuffer.at(seqNumberValue).m_pdu = nullptr;
                     m_retxBuffer.at(seqNumberValue).m_retxCount = 0;
                     m_retxBuffer.at(seqNumberValue).m_waitingSince = MilliSeconds(0);
@@ -480,11 +477,13 @@ LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
     NS_LOG_LOGIC("First SDU size    = " << m_txonBuffer.begin()->m_pdu->GetSize());
     NS_LOG_LOGIC("Next segment size = " << nextSegmentSize);
     NS_LOG_LOGIC("Remove SDU from TxBuffer");
-    Time firstSegmentTime = m_txonBuffer.begin()->m_waitingSince;
-    Ptr<Packet> firstSegment = m_txonBuffer.begin()->m_pdu->Copy();
-    m_txonBufferSize -= m_txonBuffer.begin()->m_pdu->GetSize();
+    // The SDU is owned by the transmission buffer, so it is taken out of it
+    // rather than copied
+    Time firstSegmentTime = m_txonBuffer.front().m_waitingSince;
+    Ptr<Packet> firstSegment = m_txonBuffer.front().m_pdu;
+    m_txonBufferSize -= firstSegment->GetSize();
     NS_LOG_LOGIC("txBufferSize      = " << m_txonBufferSize);
-    m_txonBuffer.erase(m_txonBuffer.begin());
+    m_txonBuffer.pop_front();
 
     while (firstSegment && (firstSegment->GetSize() > 0) && (nextSegmentSize > 0))
     {
@@ -533,8 +532,8 @@ LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
             {
                 firstSegment->AddPacketTag(oldTag);
 
-                m_txonBuffer.insert(m_txonBuffer.begin(), TxPdu(firstSegment, firstSegmentTime));
-                m_txonBufferSize += m_txonBuffer.begin()->m_pdu->GetSize();
+                m_txonBuffer.emplace_front(firstSegment, firstSegmentTime);
+                m_txonBufferSize += firstSegment->GetSize();
 
                 NS_LOG_LOGIC("    Txon buffer: Give back the remaining segment");
                 NS_LOG_LOGIC("    Txon buffers = " << m_txonBuffer.size());
@@ -637,10 +636,10 @@ LteRlcAm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
             NS_LOG_LOGIC("        Remove SDU from TxBuffer");
 
             // (more segments)
-            firstSegment = m_txonBuffer.begin()->m_pdu->Copy();
-            firstSegmentTime = m_txonBuffer.begin()->m_waitingSince;
-            m_txonBufferSize -= m_txonBuffer.begin()->m_pdu->GetSize();
-            m_txonBuffer.erase(m_txonBuffer.begin());
+            firstSegment = m_txonBuffer.front().m_pdu;
+            firstSegmentTime = m_txonBuffer.front().m_waitingSince;
+            m_txonBufferSize -= firstSegment->GetSize();
+            m_txonBuffer.pop_front();
             NS_LOG_LOGIC("        txBufferSize = " << m_txonBufferSize);
         }
     }
@@ -924,19 +923,20 @@ LteRlcAm::DoReceivePdu(LteMacSapUser::ReceivePduParameters rxPduParams)
             //         - discard the duplicate byte segments.
             // note: re-segmentation of AMD PDU is currently not supported,
             // so we just check that the segment was not received before
-            auto it = m_rxonBuffer.find(seqNumber.GetValue());
-            if (it != m_rxonBuffer.end())
+            PduBuffer& pduBuffer = m_rxonBuffer.at(seqNumber.GetValue());
+            if (pduBuffer.m_pduComplete)
             {
-                NS_ASSERT(!it->second.m_byteSegments.empty());
-                NS_ASSERT_MSG(it->second.m_byteSegments.size() == 1,
+                NS_ASSERT(!pduBuffer.m_byteSegments.empty());
+                NS_ASSERT_MSG(pduBuffer.m_byteSegments.size() == 1,
                               "re-segmentation not supported");
                 NS_LOG_LOGIC("PDU segment already received, discarded");
             }
             else
             {
                 NS_LOG_LOGIC("Place PDU in the reception buffer ( SN = " << seqNumber << " )");
-                m_rxonBuffer[seqNumber.GetValue()].m_byteSegments.push_back(rxPduParams.p);
-                m_rxonBuffer[seqNumber.GetValue()].m_pduComplete = true;
+                pduBuffer.m_seqNumber = seqNumber;
+                pduBuffer.m_byteSegments.push_back(rxPduParams.p);
+                pduBuffer.m_pduComplete = true;
             }
         }
 
@@ -957,14 +957,12 @@ LteRlcAm::DoReceivePdu(LteMacSapUser::ReceivePduParameters rxPduParams)
         //     - update VR(MS) to the SN of the first AMD PDU with SN > current VR(MS) for
         //       which not all byte segments have been received;
 
-        auto it = m_rxonBuffer.find(m_vrMs.GetValue());
-        if (it != m_rxonBuffer.end() && it->second.m_pduComplete)
+        if (m_rxonBuffer.at(m_vrMs.GetValue()).m_pduComplete)
         {
             int firstVrMs = m_vrMs.GetValue();
-            while (it != m_rxonBuffer.end() && it->second.m_pduComplete)
+            while (m_rxonBuffer.at(m_vrMs.GetValue()).m_pduComplete)
             {
                 m_vrMs++;
-                it = m_rxonBuffer.find(m_vrMs.GetValue());
                 NS_LOG_LOGIC("Incr VR(MS) = " << m_vrMs);
 
                 NS_ASSERT_MSG(firstVrMs != m_vrMs.GetValue(), "Infinite loop in RxonBuffer");
@@ -984,25 +982,24 @@ LteRlcAm::DoReceivePdu(LteMacSapUser::ReceivePduParameters rxPduParams)
 
         if (seqNumber == m_vrR)
         {
-            auto it = m_rxonBuffer.find(seqNumber.GetValue());
-            if (it != m_rxonBuffer.end() && it->second.m_pduComplete)
+            if (m_rxonBuffer.at(seqNumber.GetValue()).m_pduComplete)
             {
-                it = m_rxonBuffer.find(m_vrR.GetValue());
                 int firstVrR = m_vrR.GetValue();
-                while (it != m_rxonBuffer.end() && it->second.m_pduComplete)
+                while (m_rxonBuffer.at(m_vrR.GetValue()).m_pduComplete)
                 {
+                    PduBuffer& pduBuffer = m_rxonBuffer.at(m_vrR.GetValue());
                     NS_LOG_LOGIC("Reassemble and Deliver ( SN = " << m_vrR << " )");
-                    NS_ASSERT_MSG(it->second.m_byteSegments.size() == 1,
+                    NS_ASSERT_MSG(pduBuffer.m_byteSegments.size() == 1,
                                   "Too many segments. PDU Reassembly process didn't work");
-                    ReassembleAndDeliver(it->second.m_byteSegments.front());
-                    m_rxonBuffer.erase(m_vrR.GetValue());
+                    ReassembleAndDeliver(pduBuffer.m_byteSegments.front());
+                    pduBuffer.m_byteSegments.clear();
+                    pduBuffer.m_pduComplete = false;
 
                     m_vrR++;
                     m_vrR.SetModulusBase(m_vrR);
                     m_vrX.SetModulusBase(m_vrR);
                     m_vrMs.SetModulusBase(m_vrR);
                     m_vrH.SetModulusBase(m_vrR);
-                    it = m_rxonBuffer.find(m_vrR.GetValue());
 
                     NS_ASSERT_MSG(firstVrR != m_vrR.GetValue(), "Infinite loop in RxonBuffer");
                 }
@@ -1090,15 +1087,14 @@ LteRlcAm::DoReceivePdu(LteMacSapUser::ReceivePduParameters rxPduParams)
                 if (m_txedBuffer.at(seqNumberValue).m_pdu)
                 {
                     NS_LOG_INFO("Move SN = " << seqNumberValue << " to retxBuffer");
-                    m_retxBuffer.at(seqNumberValue).m_pdu =
-                        m_txedBuffer.at(seqNumberValue).m_pdu->Copy();
+                    m_retxBuffer.at(seqNumberValue).m_pdu = m_txedBuffer.at(seqNumberValue).m_pdu;
                     m_retxBuffer.at(seqNumberValue).m_retxCount =
                         m_txedBuffer.at(seqNumberValue).m_retxCount;
                     m_retxBuffer.at(seqNumberValue).m_waitingSince =
                         m_txedBuffer.at(seqNumberValue).m_waitingSince;
                     m_retxBufferSize += m_retxBuffer.at(seqNumberValue).m_pdu->GetSize();
 
-                    m_txedBufferSize -= m_txedBuffer.at(seqNumberValue).m_pdu->GetSize();
+                    m_txedBufferSize -= m_retxBuffer.at(seqNumberValue).m_pdu->GetSize();
                     m_txedBuffer.at(seqNumberValue).m_pdu = nullptr;
                     m_txedBuffer.at(seqNumberValue).m_retxCount = 0;
                     m_txedBuffer.at(seqNumberValue).m_waitingSince = MilliSeconds(0);
@@ -1704,11 +1700,9 @@ LteRlcAm::ExpireReorderingTimer()
 
     m_vrMs = m_vrX;
     int firstVrMs = m_vrMs.GetValue();
-    auto it = m_rxonBuffer.find(m_vrMs.GetValue());
-    while (it != m_rxonBuffer.end() && it->second.m_pduComplete)
+    while (m_rxonBuffer.at(m_vrMs.GetValue()).m_pduComplete)
     {
         m_vrMs++;
-        it = m_rxonBuffer.find(m_vrMs.GetValue());
 
         NS_ASSERT_MSG(firstVrMs != m_vrMs.GetValue(), "Infinite loop in ExpireReorderingTimer");
     }
@@ -1757,12 +1751,12 @@ LteRlcAm::ExpirePollRetransmitTimer()
             {
                 uint16_t snValue = sn.GetValue();
                 NS_LOG_INFO("Move PDU " << sn << " from txedBuffer to retxBuffer");
-                m_retxBuffer.at(snValue).m_pdu = m_txedBuffer.at(snValue).m_pdu->Copy();
+                m_retxBuffer.at(snValue).m_pdu = m_txedBuffer.at(snValue).m_pdu;
                 m_retxBuffer.at(snValue).m_retxCount = m_txedBuffer.at(snValue).m_retxCount;
                 m_retxBuffer.at(snValue).m_waitingSince = m_txedBuffer.at(snValue).m_waitingSince;
                 m_retxBufferSize += m_retxBuffer.at(snValue).m_pdu->GetSize();
 
-                m_txedBufferSize -= m_txedBuffer.at(snValue).m_pdu->GetSize();
+                m_txedBufferSize -= m_retxBuffer.at(snValue).m_pdu->GetSize();
                 m_txedBuffer.at(snValue).m_pdu = nullptr;
                 m_txedBuffer.at(snValue).m_retxCount = 0;
                 m_txedBuffer.at(snValue).m_waitingSince = MilliSeconds(0);
@@ -25,7 +25,8 @@
 
 #include <ns3/event-id.h>
 
-#include <map>
+#include <deque>
+#include <list>
 #include <vector>
 
 namespace ns3
@@ -130,7 +131,7 @@ class LteRlcAm : public LteRlc
         Time m_waitingSince; ///< Layer arrival time
     };
 
-    std::vector<TxPdu> m_txonBuffer; ///< Transmission buffer
+    std::deque<TxPdu> m_txonBuffer; ///< Transmission buffer
 
     /// RetxPdu structure
     struct RetxPdu
@@ -159,10 +160,14 @@ class LteRlcAm : public LteRlc
         SequenceNumber10 m_seqNumber;          ///< sequence number
         std::list<Ptr<Packet>> m_byteSegments; ///< byte segments
 
-        bool m_pduComplete; ///< PDU complete?
+        bool m_pduComplete{false}; ///< PDU complete?
     };
 
-    std::map<uint16_t, PduBuffer> m_rxonBuffer; ///< Reception buffer
+    /**
+     * Reception buffer, indexed by sequence number like the transmission side
+     * buffers. A slot holds a PDU only while m_pduComplete is set.
+     */
+    std::vector<PduBuffer> m_rxonBuffer;
 
     Ptr<Packet> m_controlPduBuffer; ///< Control PDU buffer (just one PDU)
 
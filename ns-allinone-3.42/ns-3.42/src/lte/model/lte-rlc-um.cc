@@ -192,8 +192,10 @@ LteRlcUm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
         return;
     }
 
-    Ptr<Packet> firstSegment = m_txBuffer.begin()->m_pdu->Copy();
-    Time firstSegmentTime = m_txBuffer.begin()->m_waitingSince;
+    // The SDU is owned by the transmission buffer, so it is taken out of it
+    // rather than copied
+    Ptr<Packet> firstSegment = m_txBuffer.front().m_pdu;
+    Time firstSegmentTime = m_txBuffer.front().m_waitingSince;
 
     NS_LOG_LOGIC("SDUs in TxBuffer  = " << m_txBuffer.size());
     NS_LOG_LOGIC("First SDU buffer  = " << firstSegment);
@@ -202,7 +204,7 @@ LteRlcUm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
     NS_LOG_LOGIC("Remove SDU from TxBuffer");
     m_txBufferSize -= firstSegment->GetSize();
     NS_LOG_LOGIC("txBufferSize      = " << m_txBufferSize);
-    m_txBuffer.erase(m_txBuffer.begin());
+    m_txBuffer.pop_front();
 
     while (firstSegment && (firstSegment->GetSize() > 0) && (nextSegmentSize > 0))
     {
@@ -251,8 +253,8 @@ LteRlcUm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
             {
                 firstSegment->AddPacketTag(oldTag);
 
-                m_txBuffer.insert(m_txBuffer.begin(), TxPdu(firstSegment, firstSegmentTime));
-                m_txBufferSize += m_txBuffer.begin()->m_pdu->GetSize();
+                m_txBuffer.emplace_front(firstSegment, firstSegmentTime);
+                m_txBufferSize += firstSegment->GetSize();
 
                 NS_LOG_LOGIC("    TX buffer: Give back the remaining segment");
                 NS_LOG_LOGIC("    TX buffers = " << m_txBuffer.size());
@@ -354,8 +356,8 @@ LteRlcUm::DoNotifyTxOpportunity(LteMacSapUser::TxOpportunityParameters txOpParam
             NS_LOG_LOGIC("        Remove SDU from TxBuffer");
 
             // (more segments)
-            firstSegment = m_txBuffer.begin()->m_pdu->Copy();
-            firstSegmentTime = m_txBuffer.begin()->m_waitingSince;
+            firstSegment = m_txBuffer.front().m_pdu;
+            firstSegmentTime = m_txBuffer.front().m_waitingSince;
             m_txBufferSize -= firstSegment->GetSize();
             m_txBuffer.pop_front();
             NS_LOG_LOGIC("        txBufferSize = " << m_txBufferSize);
@@ -0,0 +1,127 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-scheduler-thread-pool.h"
+
+#include <ns3/log.h>
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LteSchedulerThreadPool");
+
+LteSchedulerThreadPool::LteSchedulerThreadPool(uint32_t nThreads)
+{
+    NS_LOG_FUNCTION(this << nThreads);
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    // the calling thread takes part in each batch
+    for (uint32_t i = 1; i < nThreads; ++i)
+    {
+        m_workers.emplace_back(&LteSchedulerThreadPool::WorkerLoop, this);
+    }
+}
+
+LteSchedulerThreadPool::~LteSchedulerThreadPool()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_batchReady.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t
+LteSchedulerThreadPool::GetNThreads() const
+{
+    return static_cast<uint32_t>(m_workers.size()) + 1;
+}
+
+void
+LteSchedulerThreadPool::Run(std::size_t nJobs, const std::function<void(std::size_t)>& job)
+{
+    NS_LOG_FUNCTION(this << nJobs);
+    if (m_workers.empty() || nJobs < 2)
+    {
+        for (std::size_t i = 0; i < nJobs; ++i)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_nJobs = nJobs;
+        m_nextJob.store(0, std::memory_order_relaxed);
+        m_busyWorkers = m_workers.size();
+        ++m_batch;
+    }
+    m_batchReady.notify_all();
+
+    RunPendingJobs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchDone.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_job = nullptr;
+    m_nJobs = 0;
+}
+
+void
+LteSchedulerThreadPool::WorkerLoop()
+{
+    uint64_t lastBatch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_batchReady.wait(lock, [this, lastBatch] { return m_stop || m_batch != lastBatch; });
+            if (m_stop)
+            {
+                return;
+            }
+            lastBatch = m_batch;
+        }
+
+        RunPendingJobs();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkers == 0)
+        {
+            m_batchDone.notify_one();
+        }
+    }
+}
+
+void
+LteSchedulerThreadPool::RunPendingJobs()
+{
+    for (std::size_t i = m_nextJob.fetch_add(1); i < m_nJobs; i = m_nextJob.fetch_add(1))
+    {
+        (*m_job)(i);
+    }
+}
+
+} // namespace ns3
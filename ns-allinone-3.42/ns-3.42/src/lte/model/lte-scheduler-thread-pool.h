@@ -0,0 +1,95 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_SCHEDULER_THREAD_POOL_H
+#define LTE_SCHEDULER_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup lte
+ *
+ * A minimal pool of worker threads used to run independent per-cell MAC
+ * scheduler invocations concurrently (see the LteEnbMac ParallelScheduling
+ * attribute).
+ *
+ * The pool is synchronous: Run() hands out the jobs to the workers and to
+ * the calling thread, and returns only when all the jobs have completed, so
+ * that the simulation thread can then apply their results in a fixed order.
+ * The jobs must not share any mutable state and must not interact with the
+ * simulator core (e.g., schedule events).
+ */
+class LteSchedulerThreadPool
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param nThreads the overall number of threads running the jobs, including the
+     *                 calling thread; 0 means one per hardware thread
+     */
+    explicit LteSchedulerThreadPool(uint32_t nThreads);
+
+    /// Destructor, stops and joins the worker threads
+    ~LteSchedulerThreadPool();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LteSchedulerThreadPool(const LteSchedulerThreadPool&) = delete;
+    LteSchedulerThreadPool& operator=(const LteSchedulerThreadPool&) = delete;
+
+    /**
+     * Run the given number of jobs and wait for their completion.
+     *
+     * \param nJobs the number of jobs
+     * \param job the function to invoke with the index (from 0 to nJobs - 1) of each job
+     */
+    void Run(std::size_t nJobs, const std::function<void(std::size_t)>& job);
+
+    /**
+     * \return the overall number of threads running the jobs, including the calling thread
+     */
+    uint32_t GetNThreads() const;
+
+  private:
+    /// Body of the worker threads
+    void WorkerLoop();
+
+    /// Run jobs of the current batch until none is left
+    void RunPendingJobs();
+
+    std::vector<std::thread> m_workers; ///< the worker threads
+    std::mutex m_mutex;                 ///< protects the batch descriptors below
+    std::condition_variable m_batchReady; ///< notified when a batch is started or on stop
+    std::condition_variable m_batchDone;  ///< notified when the last worker leaves a batch
+    const std::function<void(std::size_t)>* m_job{nullptr}; ///< the job of the current batch
+    std::size_t m_nJobs{0};                                 ///< number of jobs in the batch
+    std::atomic<std::size_t> m_nextJob{0}; ///< index of the next job to be run
+    std::size_t m_busyWorkers{0};          ///< workers that have not left the batch yet
+    uint64_t m_batch{0};                   ///< sequence number of the current batch
+    bool m_stop{false};                    ///< whether the workers must exit
+};
+
+} // namespace ns3
+
+#endif /* LTE_SCHEDULER_THREAD_POOL_H */
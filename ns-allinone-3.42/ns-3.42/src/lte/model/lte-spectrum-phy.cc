@@ -219,6 +219,14 @@ LteSpectrumPhy::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&LteSpectrumPhy::m_ctrlErrorModelEnabled),
                           MakeBooleanChecker())
+            .AddAttribute("InterferencePruningThreshold",
+                          "Signals whose power spectral density is lower than this fraction of "
+                          "the noise power spectral density in every RB are not accounted as "
+                          "interference (0 disables the pruning).",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&LteSpectrumPhy::SetInterferencePruningThreshold,
+                                             &LteSpectrumPhy::GetInterferencePruningThreshold),
+                          MakeDoubleChecker<double>(0.0, 1.0))
             .AddTraceSource("DlPhyReception",
                             "DL reception PHY layer statistics.",
                             MakeTraceSourceAccessor(&LteSpectrumPhy::m_dlPhyReception),
@@ -295,6 +303,20 @@ LteSpectrumPhy::SetNoisePowerSpectralDensity(Ptr<const SpectrumValue> noisePsd)
     m_interferenceCtrl->SetNoisePowerSpectralDensity(noisePsd);
 }
 
+void
+LteSpectrumPhy::SetInterferencePruningThreshold(double threshold)
+{
+    NS_LOG_FUNCTION(this << threshold);
+    m_interferenceData->SetPruningThreshold(threshold);
+    m_interferenceCtrl->SetPruningThreshold(threshold);
+}
+
+double
+LteSpectrumPhy::GetInterferencePruningThreshold() const
+{
+    return m_interferenceData->GetPruningThreshold();
+}
+
 void
 LteSpectrumPhy::Reset()
 {
@@ -218,6 +218,19 @@ class LteSpectrumPhy : public SpectrumPhy
      */
     void SetNoisePowerSpectralDensity(Ptr<const SpectrumValue> noisePsd);
 
+    /**
+     * \brief set the threshold below which incoming signals are not accounted
+     * as interference, see LteInterference::SetPruningThreshold
+     * @param threshold the threshold, relative to the noise
+     */
+    void SetInterferencePruningThreshold(double threshold);
+
+    /**
+     * @return the threshold below which incoming signals are not accounted
+     * as interference, relative to the noise
+     */
+    double GetInterferencePruningThreshold() const;
+
     /**
      * reset the internal state
      *
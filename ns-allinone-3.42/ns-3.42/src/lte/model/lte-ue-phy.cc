@@ -40,8 +40,10 @@
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -285,6 +287,13 @@ LteUePhy::GetTypeId()
                           DoubleValue(-1000.0),
                           MakeDoubleAccessor(&LteUePhy::m_pssReceptionThreshold),
                           MakeDoubleChecker<double>())
+            .AddAttribute("RsrpUeMeasThreshold",
+                          "Cells other than the serving one whose instantaneous RSRP is "
+                          "below this threshold [dBm] are neither measured nor reported. "
+                          "This limits the measurement effort when many cells are detected.",
+                          DoubleValue(-std::numeric_limits<double>::infinity()),
+                          MakeDoubleAccessor(&LteUePhy::m_rsrpMeasurementThreshold),
+                          MakeDoubleChecker<double>())
             .AddAttribute("UeMeasurementsFilterPeriod",
                           "Time period for reporting UE measurements, i.e., the"
                           "length of layer-1 filtering.",
@@ -648,25 +657,26 @@ LteUePhy::GenerateCqiRsrpRsrq(const SpectrumValue& sinr)
         // measure instantaneous RSRQ now
         NS_ASSERT_MSG(m_rsInterferencePowerUpdated, " RS interference power info obsolete");
 
+        // the RSSI is the same whatever the cell, compute it once for all the PSS
+        uint16_t rbNum = 0;
+        double rssiSum = 0.0;
+
+        auto itIntN = m_rsInterferencePower.ConstValuesBegin();
+        auto itPj = m_rsReceivedPower.ConstValuesBegin();
+        for (itPj = m_rsReceivedPower.ConstValuesBegin();
+             itPj != m_rsReceivedPower.ConstValuesEnd();
+             itIntN++, itPj++)
+        {
+            rbNum++;
+            // convert PSD [W/Hz] to linear power [W] for the single RE
+            double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
+            double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
+            rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
+        }
+
         auto itPss = m_pssList.begin();
         while (itPss != m_pssList.end())
         {
-            uint16_t rbNum = 0;
-            double rssiSum = 0.0;
-
-            auto itIntN = m_rsInterferencePower.ConstValuesBegin();
-            auto itPj = m_rsReceivedPower.ConstValuesBegin();
-            for (itPj = m_rsReceivedPower.ConstValuesBegin();
-                 itPj != m_rsReceivedPower.ConstValuesEnd();
-                 itIntN++, itPj++)
-            {
-                rbNum++;
-                // convert PSD [W/Hz] to linear power [W] for the single RE
-                double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
-                double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
-                rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
-            }
-
             NS_ASSERT(rbNum == (*itPss).nRB);
             double rsrq_dB = 10 * log10((*itPss).pssPsdSum / rssiSum);
 
@@ -675,11 +685,12 @@ LteUePhy::GenerateCqiRsrpRsrq(const SpectrumValue& sinr)
                 NS_LOG_INFO(this << " PSS RNTI " << m_rnti << " cellId " << m_cellId << " has RSRQ "
                                  << rsrq_dB << " and RBnum " << rbNum);
                 // store measurements
-                auto itMeasMap = m_ueMeasurementsMap.find((*itPss).cellId);
-                if (itMeasMap != m_ueMeasurementsMap.end())
+                auto itMeasIndex = m_ueMeasurementsIndex.find((*itPss).cellId);
+                if (itMeasIndex != m_ueMeasurementsIndex.end())
                 {
-                    (*itMeasMap).second.rsrqSum += rsrq_dB;
-                    (*itMeasMap).second.rsrqNum++;
+                    UeMeasurementsElement& meas = m_ueMeasurements[itMeasIndex->second];
+                    meas.rsrqSum += rsrq_dB;
+                    meas.rsrqNum++;
                 }
                 else
                 {
@@ -937,24 +948,32 @@ LteUePhy::ReportUeMeasurements()
     NS_LOG_DEBUG(this << " Report UE Measurements ");
 
     LteUeCphySapUser::UeMeasurementsParameters ret{};
+    ret.m_ueMeasurementsList.reserve(m_ueMeasurements.size());
 
-    for (auto it = m_ueMeasurementsMap.begin(); it != m_ueMeasurementsMap.end(); it++)
+    // report the cells by increasing cell ID
+    std::sort(m_ueMeasurements.begin(),
+              m_ueMeasurements.end(),
+              [](const UeMeasurementsElement& a, const UeMeasurementsElement& b) {
+                  return a.cellId < b.cellId;
+              });
+
+    for (auto it = m_ueMeasurements.begin(); it != m_ueMeasurements.end(); it++)
     {
-        double avg_rsrp = (*it).second.rsrpSum / (double)(*it).second.rsrpNum;
-        double avg_rsrq = (*it).second.rsrqSum / (double)(*it).second.rsrqNum;
+        double avg_rsrp = (*it).rsrpSum / (double)(*it).rsrpNum;
+        double avg_rsrq = (*it).rsrqSum / (double)(*it).rsrqNum;
         /*
          * In CELL_SEARCH state, this may result in avg_rsrq = 0/0 = -nan.
          * UE RRC must take this into account when receiving measurement reports.
          * TODO remove this shortcoming by calculating RSRQ during CELL_SEARCH
          */
-        NS_LOG_DEBUG(this << " CellId " << (*it).first << " RSRP " << avg_rsrp << " (nSamples "
-                          << (uint16_t)(*it).second.rsrpNum << ")"
-                          << " RSRQ " << avg_rsrq << " (nSamples " << (uint16_t)(*it).second.rsrqNum
+        NS_LOG_DEBUG(this << " CellId " << (*it).cellId << " RSRP " << avg_rsrp << " (nSamples "
+                          << (uint16_t)(*it).rsrpNum << ")"
+                          << " RSRQ " << avg_rsrq << " (nSamples " << (uint16_t)(*it).rsrqNum
                           << ")"
                           << " ComponentCarrierID " << (uint16_t)m_componentCarrierId);
 
         LteUeCphySapUser::UeMeasurementsElement newEl;
-        newEl.m_cellId = (*it).first;
+        newEl.m_cellId = (*it).cellId;
         newEl.m_rsrp = avg_rsrp;
         newEl.m_rsrq = avg_rsrq;
         ret.m_ueMeasurementsList.push_back(newEl);
@@ -962,17 +981,18 @@ LteUePhy::ReportUeMeasurements()
 
         // report to UE measurements trace
         m_reportUeMeasurements(m_rnti,
-                               (*it).first,
+                               (*it).cellId,
                                avg_rsrp,
                                avg_rsrq,
-                               (*it).first == m_cellId,
+                               (*it).cellId == m_cellId,
                                m_componentCarrierId);
     }
 
     // report to RRC
     m_ueCphySapUser->ReportUeMeasurements(ret);
 
-    m_ueMeasurementsMap.clear();
+    m_ueMeasurements.clear();
+    m_ueMeasurementsIndex.clear();
     Simulator::Schedule(m_ueMeasurementsFilterPeriod, &LteUePhy::ReportUeMeasurements, this);
 }
 
@@ -1202,22 +1222,30 @@ LteUePhy::ReceivePss(uint16_t cellId, Ptr<SpectrumValue> p)
                      << " and RBnum " << nRB);
     // note that m_pssReceptionThreshold does not apply here
 
+    if (cellId != m_cellId && rsrp_dBm < m_rsrpMeasurementThreshold)
+    {
+        NS_LOG_LOGIC(this << " cellId " << cellId << " below the RSRP measurement threshold");
+        return;
+    }
+
     // store measurements
-    auto itMeasMap = m_ueMeasurementsMap.find(cellId);
-    if (itMeasMap == m_ueMeasurementsMap.end())
+    auto [itMeasIndex, inserted] = m_ueMeasurementsIndex.emplace(cellId, m_ueMeasurements.size());
+    if (inserted)
     {
         // insert new entry
         UeMeasurementsElement newEl;
+        newEl.cellId = cellId;
         newEl.rsrpSum = rsrp_dBm;
         newEl.rsrpNum = 1;
         newEl.rsrqSum = 0;
         newEl.rsrqNum = 0;
-        m_ueMeasurementsMap.insert(std::pair<uint16_t, UeMeasurementsElement>(cellId, newEl));
+        m_ueMeasurements.push_back(newEl);
     }
     else
     {
-        (*itMeasMap).second.rsrpSum += rsrp_dBm;
-        (*itMeasMap).second.rsrpNum++;
+        UeMeasurementsElement& meas = m_ueMeasurements[itMeasIndex->second];
+        meas.rsrpSum += rsrp_dBm;
+        meas.rsrpNum++;
     }
 
     /*
@@ -35,6 +35,8 @@
 #include <ns3/ptr.h>
 
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -744,9 +746,16 @@ class LteUePhy : public LtePhy
      */
     double m_pssReceptionThreshold;
 
+    /**
+     * The `RsrpUeMeasThreshold` attribute. Cells other than the serving one
+     * whose instantaneous RSRP is below this threshold (in dBm) are not measured.
+     */
+    double m_rsrpMeasurementThreshold;
+
     /// Summary results of measuring a specific cell. Used for layer-1 filtering.
     struct UeMeasurementsElement
     {
+        uint16_t cellId; ///< ID of the measured cell.
         double rsrpSum;  ///< Sum of RSRP sample values in linear unit.
         uint8_t rsrpNum; ///< Number of RSRP samples.
         double rsrqSum;  ///< Sum of RSRQ sample values in linear unit.
@@ -754,10 +763,12 @@ class LteUePhy : public LtePhy
     };
 
     /**
-     * Store measurement results during the last layer-1 filtering period.
-     * Indexed by the cell ID where the measurements come from.
+     * Store measurement results during the last layer-1 filtering period,
+     * in the order the cells have been first measured.
      */
-    std::map<uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+    std::vector<UeMeasurementsElement> m_ueMeasurements;
+    /// Index in m_ueMeasurements of the measurements of each cell, by cell ID.
+    std::unordered_map<uint16_t, std::size_t> m_ueMeasurementsIndex;
     /**
      * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
      * measurements, i.e., the length of layer-1 filtering (default 200 ms).
@@ -28,6 +28,7 @@
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 
+#include <array>
 #include <cfloat>
 #include <set>
 
@@ -340,21 +341,7 @@ PfFfMacScheduler::GetRbgSize(int dlbandwidth)
 unsigned int
 PfFfMacScheduler::LcActivePerFlow(uint16_t rnti)
 {
-    unsigned int lcActive = 0;
-    for (auto it = m_rlcBufferReq.begin(); it != m_rlcBufferReq.end(); it++)
-    {
-        if (((*it).first.m_rnti == rnti) && (((*it).second.m_rlcTransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcRetransmissionQueueSize > 0) ||
-                                             ((*it).second.m_rlcStatusPduSize > 0)))
-        {
-            lcActive++;
-        }
-        if ((*it).first.m_rnti > rnti)
-        {
-            break;
-        }
-    }
-    return lcActive;
+    return CountActiveDlLcs(m_rlcBufferReq, rnti);
 }
 
 bool
@@ -912,6 +899,62 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         return;
     }
 
+    // The eligibility of the UEs does not change while the RBGs are allocated, hence the
+    // per-UE state is looked up once per TTI and stored in a flat table
+    struct PfDlCandidate
+    {
+        std::map<uint16_t, pfsFlowPerf_t>::iterator flow; ///< the flow stats of the UE
+        const std::vector<HigherLayerSelected_s>* sbCqis; ///< subband CQIs, if any received
+        std::vector<uint8_t> lowestCqi; ///< CQIs to use if none has been received
+        uint8_t nLayer;                 ///< number of layers, 0 if unknown
+        bool hasData;                   ///< whether a LC has data to transmit
+    };
+
+    std::vector<PfDlCandidate> candidates;
+    candidates.reserve(m_flowStatsDl.size());
+    for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+    {
+        auto itRnti = rntiAllocated.find((*it).first);
+        if (itRnti != rntiAllocated.end() || !HarqProcessAvailability((*it).first))
+        {
+            // UE already allocated for HARQ or without HARQ process available -> drop it
+            if (itRnti != rntiAllocated.end())
+            {
+                NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx" << (uint16_t)(*it).first);
+            }
+            if (!HarqProcessAvailability((*it).first))
+            {
+                NS_LOG_DEBUG(this << " RNTI discarded for HARQ id" << (uint16_t)(*it).first);
+            }
+            continue;
+        }
+        PfDlCandidate candidate;
+        candidate.flow = it;
+        auto itCqi = m_a30CqiRxed.find((*it).first);
+        candidate.sbCqis =
+            (itCqi == m_a30CqiRxed.end()) ? nullptr : &(*itCqi).second.m_higherLayerSelected;
+        auto itTxMode = m_uesTxMode.find((*it).first);
+        candidate.nLayer = (itTxMode == m_uesTxMode.end())
+                               ? 0
+                               : TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
+        if (!candidate.sbCqis)
+        {
+            candidate.lowestCqi = std::vector<uint8_t>(candidate.nLayer, 1);
+        }
+        candidate.hasData = LcActivePerFlow((*it).first) > 0;
+        candidates.push_back(std::move(candidate));
+    }
+
+    // achievable rate over one RBG for each CQI value (= TB size / TTI)
+    std::array<uint8_t, 16> mcsForCqi;
+    std::array<double, 16> rateForCqi;
+    for (uint8_t cqi = 0; cqi < mcsForCqi.size(); cqi++)
+    {
+        mcsForCqi[cqi] = m_amc->GetMcsFromCqi(cqi);
+        rateForCqi[cqi] = (m_amc->GetDlTbSizeFromMcs(mcsForCqi[cqi], rbgSize) / 8) / 0.001;
+    }
+    const double rateForMcs0 = (m_amc->GetDlTbSizeFromMcs(0, rbgSize) / 8) / 0.001;
+
     for (int i = 0; i < rbgNum; i++)
     {
         NS_LOG_INFO(this << " ALLOCATION for RBG " << i << " of " << rbgNum);
@@ -919,45 +962,20 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
         {
             auto itMax = m_flowStatsDl.end();
             double rcqiMax = 0.0;
-            for (auto it = m_flowStatsDl.begin(); it != m_flowStatsDl.end(); it++)
+            for (const auto& candidate : candidates)
             {
+                auto it = candidate.flow;
                 if (!m_ffrSapProvider->IsDlRbgAvailableForUe(i, (*it).first))
                 {
                     continue;
                 }
-
-                auto itRnti = rntiAllocated.find((*it).first);
-                if (itRnti != rntiAllocated.end() || !HarqProcessAvailability((*it).first))
-                {
-                    // UE already allocated for HARQ or without HARQ process available -> drop it
-                    if (itRnti != rntiAllocated.end())
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discarded for HARQ tx"
-                                          << (uint16_t)(*it).first);
-                    }
-                    if (!HarqProcessAvailability((*it).first))
-                    {
-                        NS_LOG_DEBUG(this << " RNTI discarded for HARQ id"
-                                          << (uint16_t)(*it).first);
-                    }
-                    continue;
-                }
-                auto itCqi = m_a30CqiRxed.find((*it).first);
-                auto itTxMode = m_uesTxMode.find((*it).first);
-                if (itTxMode == m_uesTxMode.end())
+                if (candidate.nLayer == 0)
                 {
                     NS_FATAL_ERROR("No Transmission Mode info on user " << (*it).first);
                 }
-                auto nLayer = TransmissionModesLayers::TxMode2LayerNum((*itTxMode).second);
-                std::vector<uint8_t> sbCqi;
-                if (itCqi == m_a30CqiRxed.end())
-                {
-                    sbCqi = std::vector<uint8_t>(nLayer, 1); // start with lowest value
-                }
-                else
-                {
-                    sbCqi = (*itCqi).second.m_higherLayerSelected.at(i).m_sbCqi;
-                }
+                const uint8_t nLayer = candidate.nLayer;
+                const std::vector<uint8_t>& sbCqi =
+                    candidate.sbCqis ? candidate.sbCqis->at(i).m_sbCqi : candidate.lowestCqi;
                 uint8_t cqi1 = sbCqi.at(0);
                 uint8_t cqi2 = 0;
                 if (sbCqi.size() > 1)
@@ -968,7 +986,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
                 if ((cqi1 > 0) ||
                     (cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                 {
-                    if (LcActivePerFlow((*it).first) > 0)
+                    if (candidate.hasData)
                     {
                         // this UE has data to transmit
                         double achievableRate = 0.0;
@@ -977,15 +995,15 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
                         {
                             if (sbCqi.size() > k)
                             {
-                                mcs = m_amc->GetMcsFromCqi(sbCqi.at(k));
+                                mcs = mcsForCqi.at(sbCqi.at(k));
+                                achievableRate += rateForCqi.at(sbCqi.at(k));
                             }
                             else
                             {
                                 // no info on this subband -> worst MCS
                                 mcs = 0;
+                                achievableRate += rateForMcs0;
                             }
-                            achievableRate += ((m_amc->GetDlTbSizeFromMcs(mcs, rbgSize) / 8) /
-                                               0.001); // = TB size / TTI
                         }
 
                         double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
@@ -1001,7 +1019,7 @@ PfFfMacScheduler::DoSchedDlTriggerReq(
                         }
                     }
                 } // end if cqi
-            }     // end for m_rlcBufferReq
+            }     // end for candidates
 
             if (itMax == m_flowStatsDl.end())
             {
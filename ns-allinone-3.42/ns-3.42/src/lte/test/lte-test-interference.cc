@@ -31,9 +31,11 @@
 #include "ns3/lte-ue-phy.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/simulator.h"
+#include "ns3/spectrum-test.h"
 #include "ns3/string.h"
 #include <ns3/enum.h>
 #include <ns3/lte-chunk-processor.h>
+#include <ns3/lte-interference.h>
 
 using namespace ns3;
 
@@ -185,6 +187,10 @@ LteInterferenceTestSuite::LteInterferenceTestSuite()
                                             6,
                                             0),
                 TestCase::Duration::QUICK);
+
+    AddTestCase(new LteInterferencePruningTestCase(0, false), TestCase::Duration::QUICK);
+    AddTestCase(new LteInterferencePruningTestCase(1e-5, false), TestCase::Duration::QUICK);
+    AddTestCase(new LteInterferencePruningTestCase(1e-3, true), TestCase::Duration::QUICK);
 }
 
 /**
@@ -390,3 +396,68 @@ LteInterferenceTestCase::UlScheduling(uint32_t frameNo,
         NS_TEST_ASSERT_MSG_EQ((uint32_t)mcs, (uint32_t)m_ulMcs, "Wrong UL MCS");
     }
 }
+
+/**
+ * TestCase for the pruning of weak interferers
+ */
+
+LteInterferencePruningTestCase::LteInterferencePruningTestCase(double pruningThreshold,
+                                                               bool expectPruned)
+    : TestCase("Interference pruning threshold " + std::to_string(pruningThreshold)),
+      m_pruningThreshold(pruningThreshold),
+      m_expectPruned(expectPruned)
+{
+}
+
+void
+LteInterferencePruningTestCase::DoRun()
+{
+    Bands bands;
+    BandInfo bi;
+    bi.fl = 2.400e9;
+    bi.fc = 2.410e9;
+    bi.fh = 2.420e9;
+    bands.push_back(bi);
+    bi.fl = 2.420e9;
+    bi.fc = 2.431e9;
+    bi.fh = 2.442e9;
+    bands.push_back(bi);
+    Ptr<SpectrumModel> sm = Create<SpectrumModel>(bands);
+
+    Ptr<SpectrumValue> noise = Create<SpectrumValue>(sm);
+    Ptr<SpectrumValue> rx = Create<SpectrumValue>(sm);
+    Ptr<SpectrumValue> strong = Create<SpectrumValue>(sm);
+    Ptr<SpectrumValue> weak = Create<SpectrumValue>(sm);
+    (*noise) = 5e-19;
+    (*rx) = 1e-15;
+    (*strong) = 5e-18;
+    (*weak)[0] = 1e-22; // 2e-4 times the noise
+    (*weak)[1] = 5e-23; // 1e-4 times the noise
+
+    Ptr<LteInterference> interference = CreateObject<LteInterference>();
+    interference->SetNoisePowerSpectralDensity(noise);
+    interference->SetPruningThreshold(m_pruningThreshold);
+    Ptr<LteChunkProcessor> chunkProcessor = Create<LteChunkProcessor>();
+    LteSpectrumValueCatcher sinrCatcher;
+    chunkProcessor->AddCallback(MakeCallback(&LteSpectrumValueCatcher::ReportValue, &sinrCatcher));
+    interference->AddSinrChunkProcessor(chunkProcessor);
+
+    const Time start = Seconds(0.1);
+    const Time duration = Seconds(1);
+    Simulator::Schedule(start, &LteInterference::AddSignal, interference, weak, duration);
+    Simulator::Schedule(start, &LteInterference::AddSignal, interference, strong, duration);
+    Simulator::Schedule(start, &LteInterference::AddSignal, interference, rx, duration);
+    Simulator::Schedule(start, &LteInterference::StartRx, interference, rx);
+    Simulator::Schedule(start + duration / 2, &LteInterference::EndRx, interference);
+    Simulator::Run();
+
+    SpectrumValue expectedSinr =
+        (*rx) / ((*strong) + (*noise) + (m_expectPruned ? SpectrumValue(sm) : (*weak)));
+    NS_TEST_ASSERT_MSG_SPECTRUM_VALUE_EQ_TOL(*(sinrCatcher.GetValue()),
+                                             expectedSinr,
+                                             1e-7,
+                                             "Unexpected SINR");
+
+    interference->Dispose();
+    Simulator::Destroy();
+}
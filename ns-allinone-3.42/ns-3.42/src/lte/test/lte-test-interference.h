@@ -101,4 +101,28 @@ class LteInterferenceTestCase : public TestCase
     uint16_t m_ulMcs;          ///< the UL MCS
 };
 
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test that LteInterference neglects the signals below the pruning threshold,
+ * and only those.
+ */
+class LteInterferencePruningTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param pruningThreshold the pruning threshold, relative to the noise
+     * \param expectPruned whether the weak interferer is expected to be neglected
+     */
+    LteInterferencePruningTestCase(double pruningThreshold, bool expectPruned);
+
+  private:
+    void DoRun() override;
+
+    double m_pruningThreshold; ///< the pruning threshold, relative to the noise
+    bool m_expectPruned;       ///< whether the weak interferer is expected to be neglected
+};
+
 #endif /* LTE_TEST_INTERFERENCE_H */
@@ -0,0 +1,228 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/lte-common.h"
+#include "ns3/lte-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestParallelScheduling");
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test that running the eNB MAC schedulers of several cells in parallel
+ * (LteEnbMac::ParallelScheduling) produces the same DL and UL scheduling
+ * decisions as running them one after another.
+ */
+class LteParallelSchedulingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param schedulerType the type of the MAC scheduler
+     */
+    LteParallelSchedulingTestCase(const std::string& schedulerType);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run the scenario
+     *
+     * \param parallelScheduling whether the schedulers run in parallel
+     * \return the log of the scheduling decisions
+     */
+    std::string RunScenario(bool parallelScheduling);
+
+    /**
+     * DL scheduling trace sink
+     *
+     * \param log the log of the scheduling decisions
+     * \param context the trace context, identifying the eNB
+     * \param info the DL scheduling information
+     */
+    static void DlScheduling(std::ostringstream* log,
+                             std::string context,
+                             DlSchedulingCallbackInfo info);
+
+    /**
+     * UL scheduling trace sink
+     *
+     * \param log the log of the scheduling decisions
+     * \param context the trace context, identifying the eNB
+     * \param frameNo the frame number
+     * \param subframeNo the subframe number
+     * \param rnti the RNTI
+     * \param mcs the MCS
+     * \param size the TB size
+     * \param componentCarrierId the component carrier ID
+     */
+    static void UlScheduling(std::ostringstream* log,
+                             std::string context,
+                             uint32_t frameNo,
+                             uint32_t subframeNo,
+                             uint16_t rnti,
+                             uint8_t mcs,
+                             uint16_t size,
+                             uint8_t componentCarrierId);
+
+    std::string m_schedulerType; ///< the type of the MAC scheduler
+};
+
+LteParallelSchedulingTestCase::LteParallelSchedulingTestCase(const std::string& schedulerType)
+    : TestCase("Parallel scheduling with " + schedulerType),
+      m_schedulerType(schedulerType)
+{
+}
+
+void
+LteParallelSchedulingTestCase::DlScheduling(std::ostringstream* log,
+                                            std::string context,
+                                            DlSchedulingCallbackInfo info)
+{
+    *log << Simulator::Now().GetMicroSeconds() << " " << context << " DL " << info.frameNo << " "
+         << info.subframeNo << " " << info.rnti << " " << +info.mcsTb1 << " " << info.sizeTb1
+         << " " << +info.mcsTb2 << " " << info.sizeTb2 << "\n";
+}
+
+void
+LteParallelSchedulingTestCase::UlScheduling(std::ostringstream* log,
+                                            std::string context,
+                                            uint32_t frameNo,
+                                            uint32_t subframeNo,
+                                            uint16_t rnti,
+                                            uint8_t mcs,
+                                            uint16_t size,
+                                            uint8_t componentCarrierId [[maybe_unused]])
+{
+    *log << Simulator::Now().GetMicroSeconds() << " " << context << " UL " << frameNo << " "
+         << subframeNo << " " << rnti << " " << +mcs << " " << size << "\n";
+}
+
+std::string
+LteParallelSchedulingTestCase::RunScenario(bool parallelScheduling)
+{
+    Config::SetDefault("ns3::LteEnbMac::ParallelScheduling", BooleanValue(parallelScheduling));
+    Config::SetDefault("ns3::LteHelper::UseIdealRrc", BooleanValue(true));
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue("ns3::FriisSpectrumPropagationLossModel"));
+    lteHelper->SetSchedulerType(m_schedulerType);
+
+    const uint16_t nEnbs = 3;
+    const uint16_t nUesPerEnb = 2;
+    NodeContainer enbNodes;
+    NodeContainer ueNodes;
+    enbNodes.Create(nEnbs);
+    ueNodes.Create(nEnbs * nUesPerEnb);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+    for (uint16_t i = 0; i < nEnbs; ++i)
+    {
+        enbNodes.Get(i)->GetObject<MobilityModel>()->SetPosition(Vector(1000.0 * i, 0.0, 0.0));
+        for (uint16_t j = 0; j < nUesPerEnb; ++j)
+        {
+            ueNodes.Get(i * nUesPerEnb + j)
+                ->GetObject<MobilityModel>()
+                ->SetPosition(Vector(1000.0 * i + 100.0 * (j + 1), 50.0, 0.0));
+        }
+    }
+
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = lteHelper->InstallUeDevice(ueNodes);
+    int64_t stream = 1;
+    stream += lteHelper->AssignStreams(enbDevs, stream);
+    lteHelper->AssignStreams(ueDevs, stream);
+
+    for (uint16_t i = 0; i < nEnbs; ++i)
+    {
+        for (uint16_t j = 0; j < nUesPerEnb; ++j)
+        {
+            lteHelper->Attach(ueDevs.Get(i * nUesPerEnb + j), enbDevs.Get(i));
+        }
+    }
+    lteHelper->ActivateDataRadioBearer(ueDevs, EpsBearer(EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+    std::ostringstream log;
+    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/DlScheduling",
+                    MakeBoundCallback(&LteParallelSchedulingTestCase::DlScheduling, &log));
+    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/UlScheduling",
+                    MakeBoundCallback(&LteParallelSchedulingTestCase::UlScheduling, &log));
+
+    Simulator::Stop(Seconds(0.3));
+    Simulator::Run();
+    Simulator::Destroy();
+    return log.str();
+}
+
+void
+LteParallelSchedulingTestCase::DoRun()
+{
+    // make sure that worker threads are used, whatever the host
+    GlobalValue::Bind("LteSchedulerThreads", UintegerValue(3));
+
+    const std::string sequential = RunScenario(false);
+    const std::string parallel = RunScenario(true);
+
+    NS_TEST_ASSERT_MSG_EQ(sequential.empty(), false, "No scheduling decision was traced");
+    NS_TEST_ASSERT_MSG_EQ(parallel, sequential, "Parallel scheduling changed the decisions");
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test suite for the parallel scheduling of the eNB MACs.
+ */
+class LteParallelSchedulingTestSuite : public TestSuite
+{
+  public:
+    LteParallelSchedulingTestSuite();
+};
+
+LteParallelSchedulingTestSuite::LteParallelSchedulingTestSuite()
+    : TestSuite("lte-parallel-scheduling", Type::SYSTEM)
+{
+    AddTestCase(new LteParallelSchedulingTestCase("ns3::PfFfMacScheduler"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LteParallelSchedulingTestCase("ns3::RrFfMacScheduler"),
+                TestCase::Duration::QUICK);
+}
+
+/**
+ * \ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteParallelSchedulingTestSuite g_lteParallelSchedulingTestSuite;
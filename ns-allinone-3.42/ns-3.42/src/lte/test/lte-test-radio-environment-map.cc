@@ -0,0 +1,242 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/pointer.h"
+#include "ns3/radio-environment-map-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test that the direct evaluation mode of the RadioEnvironmentMapHelper
+ * produces the same map as the RemSpectrumPhy listeners, in both output formats.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param pathlossModel the type of the pathloss model of the LteHelper
+     * \param threads the number of threads of the direct evaluation
+     */
+    LteRadioEnvironmentMapTestCase(const std::string& pathlossModel, uint32_t threads);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Generate a map of the scenario
+     *
+     * \param directEvaluation whether the loss models are evaluated directly
+     * \param format the format of the output file
+     * \param fileName the output file
+     * \return the number of times the Progress trace was fired
+     */
+    uint32_t GenerateMap(bool directEvaluation,
+                         RadioEnvironmentMapHelper::OutputFormat format,
+                         const std::string& fileName);
+
+    /**
+     * Progress trace sink
+     *
+     * \param count the number of times the trace was fired
+     * \param done the number of points computed so far
+     * \param total the number of points of the map
+     */
+    static void Progress(uint32_t* count, uint32_t done, uint32_t total);
+
+    std::string m_pathlossModel; ///< the type of the pathloss model
+    uint32_t m_threads;          ///< the number of threads of the direct evaluation
+};
+
+/// Resolution of the map along the x axis
+static const uint16_t REM_X_RES = 6;
+/// Resolution of the map along the y axis
+static const uint16_t REM_Y_RES = 5;
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase(const std::string& pathlossModel,
+                                                               uint32_t threads)
+    : TestCase("REM direct evaluation with " + pathlossModel + ", " + std::to_string(threads) +
+               " threads"),
+      m_pathlossModel(pathlossModel),
+      m_threads(threads)
+{
+}
+
+void
+LteRadioEnvironmentMapTestCase::Progress(uint32_t* count,
+                                         uint32_t done [[maybe_unused]],
+                                         uint32_t total [[maybe_unused]])
+{
+    NS_ASSERT(done <= total);
+    ++(*count);
+}
+
+uint32_t
+LteRadioEnvironmentMapTestCase::GenerateMap(bool directEvaluation,
+                                            RadioEnvironmentMapHelper::OutputFormat format,
+                                            const std::string& fileName)
+{
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue(m_pathlossModel));
+
+    NodeContainer enbNodes;
+    enbNodes.Create(3);
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(enbNodes);
+    for (uint32_t i = 0; i < enbNodes.GetN(); ++i)
+    {
+        enbNodes.Get(i)->GetObject<MobilityModel>()->SetPosition(
+            Vector(400.0 * i, 150.0 * (i % 2), 30.0));
+    }
+    NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice(enbNodes);
+
+    Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper>();
+    remHelper->SetAttribute("Channel", PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+    remHelper->SetAttribute("OutputFile", StringValue(fileName));
+    remHelper->SetAttribute("XMin", DoubleValue(-100.0));
+    remHelper->SetAttribute("XMax", DoubleValue(900.0));
+    remHelper->SetAttribute("XRes", UintegerValue(REM_X_RES));
+    remHelper->SetAttribute("YMin", DoubleValue(-200.0));
+    remHelper->SetAttribute("YMax", DoubleValue(300.0));
+    remHelper->SetAttribute("YRes", UintegerValue(REM_Y_RES));
+    remHelper->SetAttribute("Z", DoubleValue(1.5));
+    // several tiles, the last one being incomplete
+    remHelper->SetAttribute("MaxPointsPerIteration", UintegerValue(7));
+    remHelper->SetAttribute("DirectEvaluation", BooleanValue(directEvaluation));
+    remHelper->SetAttribute("Threads", UintegerValue(m_threads));
+    remHelper->SetAttribute("OutputFormat", EnumValue(format));
+    uint32_t progressCount = 0;
+    remHelper->TraceConnectWithoutContext(
+        "Progress",
+        MakeBoundCallback(&LteRadioEnvironmentMapTestCase::Progress, &progressCount));
+    remHelper->Install();
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+    return progressCount;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun()
+{
+    const std::string listenersFile = CreateTempDirFilename("rem-listeners.out");
+    const std::string directFile = CreateTempDirFilename("rem-direct.out");
+    const std::string binaryFile = CreateTempDirFilename("rem-direct.bin");
+
+    const uint32_t nTiles = (REM_X_RES * REM_Y_RES + 6) / 7;
+    NS_TEST_ASSERT_MSG_EQ(GenerateMap(false, RadioEnvironmentMapHelper::TEXT, listenersFile),
+                          nTiles,
+                          "Unexpected number of progress reports with the listeners");
+    NS_TEST_ASSERT_MSG_EQ(GenerateMap(true, RadioEnvironmentMapHelper::TEXT, directFile),
+                          nTiles,
+                          "Unexpected number of progress reports with the direct evaluation");
+    GenerateMap(true, RadioEnvironmentMapHelper::BINARY, binaryFile);
+
+    std::ifstream listeners(listenersFile);
+    std::ifstream direct(directFile);
+    std::ifstream binary(binaryFile, std::ios::binary);
+    NS_TEST_ASSERT_MSG_EQ(listeners.is_open() && direct.is_open() && binary.is_open(),
+                          true,
+                          "Cannot open the maps");
+
+    uint32_t res[2];
+    double bounds[5];
+    binary.read(reinterpret_cast<char*>(res), sizeof(res));
+    binary.read(reinterpret_cast<char*>(bounds), sizeof(bounds));
+    NS_TEST_ASSERT_MSG_EQ(res[0], REM_X_RES, "Wrong x resolution in the binary header");
+    NS_TEST_ASSERT_MSG_EQ(res[1], REM_Y_RES, "Wrong y resolution in the binary header");
+    NS_TEST_ASSERT_MSG_EQ_TOL(bounds[3], 300.0, 1e-9, "Wrong YMax in the binary header");
+
+    uint32_t nPoints = 0;
+    double x[2];
+    double y[2];
+    double z[2];
+    double sinr[2];
+    while (listeners >> x[0] >> y[0] >> z[0] >> sinr[0])
+    {
+        NS_TEST_ASSERT_MSG_EQ(bool(direct >> x[1] >> y[1] >> z[1] >> sinr[1]),
+                              true,
+                              "Missing point in the direct evaluation map");
+        double binarySinr;
+        binary.read(reinterpret_cast<char*>(&binarySinr), sizeof(binarySinr));
+        NS_TEST_ASSERT_MSG_EQ(bool(binary), true, "Missing point in the binary map");
+
+        NS_TEST_ASSERT_MSG_EQ_TOL(x[1], x[0], 1e-6, "Different x for point " << nPoints);
+        NS_TEST_ASSERT_MSG_EQ_TOL(y[1], y[0], 1e-6, "Different y for point " << nPoints);
+        NS_TEST_ASSERT_MSG_EQ_TOL(z[1], z[0], 1e-6, "Different z for point " << nPoints);
+        NS_TEST_ASSERT_MSG_EQ_TOL(sinr[1],
+                                  sinr[0],
+                                  sinr[0] * 1e-5,
+                                  "Different SINR for point " << nPoints);
+        NS_TEST_ASSERT_MSG_EQ_TOL(binarySinr,
+                                  sinr[1],
+                                  sinr[1] * 1e-5,
+                                  "Different binary SINR for point " << nPoints);
+        ++nPoints;
+    }
+    NS_TEST_ASSERT_MSG_EQ(nPoints, REM_X_RES * REM_Y_RES, "Wrong number of points in the map");
+    NS_TEST_ASSERT_MSG_EQ(bool(direct >> x[1]), false, "Extra points in the direct map");
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test suite for the RadioEnvironmentMapHelper.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+  public:
+    LteRadioEnvironmentMapTestSuite();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite()
+    : TestSuite("lte-radio-environment-map", Type::SYSTEM)
+{
+    AddTestCase(new LteRadioEnvironmentMapTestCase("ns3::FriisPropagationLossModel", 1),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase("ns3::FriisSpectrumPropagationLossModel", 1),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LteRadioEnvironmentMapTestCase("ns3::FriisPropagationLossModel", 3),
+                TestCase::Duration::QUICK);
+}
+
+/**
+ * \ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite;
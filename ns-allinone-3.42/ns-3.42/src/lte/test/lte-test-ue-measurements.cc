@@ -230,6 +230,15 @@ LteUeMeasurementsTestSuite::LteUeMeasurementsTestSuite()
                                               -43.472589,
                                               -3.472589),
                 TestCase::Duration::EXTENSIVE);
+    AddTestCase(new LteUeMeasurementsTestCase("d1=100, d2=10000, neighbor below RSRP threshold",
+                                              100.000000,
+                                              10000.000000,
+                                              -73.739702,
+                                              -113.739702,
+                                              -3.010783,
+                                              -43.010783,
+                                              -100.0),
+                TestCase::Duration::QUICK);
 }
 
 /**
@@ -248,14 +257,16 @@ LteUeMeasurementsTestCase::LteUeMeasurementsTestCase(std::string name,
                                                      double rsrpDbmUe1,
                                                      double rsrpDbmUe2,
                                                      double rsrqDbUe1,
-                                                     double rsrqDbUe2)
+                                                     double rsrqDbUe2,
+                                                     double rsrpMeasThreshold)
     : TestCase(name),
       m_d1(d1),
       m_d2(d2),
       m_rsrpDbmUeServingCell(rsrpDbmUe1),
       m_rsrpDbmUeNeighborCell(rsrpDbmUe2),
       m_rsrqDbUeServingCell(rsrqDbUe1),
-      m_rsrqDbUeNeighborCell(rsrqDbUe2)
+      m_rsrqDbUeNeighborCell(rsrqDbUe2),
+      m_rsrpMeasThreshold(rsrpMeasThreshold)
 {
     NS_LOG_INFO("Test UE Measurements d1 = " << d1 << " m. and d2 = " << d2 << " m.");
 }
@@ -279,6 +290,7 @@ LteUeMeasurementsTestCase::DoRun()
 
     // Disable Uplink Power Control
     Config::SetDefault("ns3::LteUePhy::EnableUplinkPowerControl", BooleanValue(false));
+    Config::SetDefault("ns3::LteUePhy::RsrpUeMeasThreshold", DoubleValue(m_rsrpMeasThreshold));
 
     // LogComponentEnable ("LteUeMeasurementsTest", LOG_LEVEL_ALL);
 
@@ -346,6 +358,15 @@ LteUeMeasurementsTestCase::DoRun()
     Simulator::Run();
 
     Simulator::Destroy();
+
+    if (m_rsrpDbmUeNeighborCell < m_rsrpMeasThreshold)
+    {
+        // the serving cell is always measured, whatever the threshold
+        NS_TEST_ASSERT_MSG_GT(m_nServingCellReports, 0, "No serving cell measurement reported");
+        NS_TEST_ASSERT_MSG_EQ(m_nNeighborCellReports,
+                              0,
+                              "Neighbor cell below the RSRP threshold has been measured");
+    }
 }
 
 void
@@ -361,6 +382,7 @@ LteUeMeasurementsTestCase::ReportUeMeasurements(uint16_t rnti,
     {
         if (servingCell)
         {
+            m_nServingCellReports++;
             NS_LOG_DEBUG("UE serving cellId " << cellId << " Rxed RSRP " << rsrp << " thr "
                                               << m_rsrpDbmUeServingCell << " RSRQ " << rsrq
                                               << " thr " << m_rsrqDbUeServingCell);
@@ -369,6 +391,7 @@ LteUeMeasurementsTestCase::ReportUeMeasurements(uint16_t rnti,
         }
         else
         {
+            m_nNeighborCellReports++;
             NS_LOG_DEBUG("UE neighbor cellId " << cellId << " Rxed RSRP " << rsrp << " thr "
                                                << m_rsrpDbmUeNeighborCell << " RSRQ " << rsrq
                                                << " thr " << m_rsrqDbUeNeighborCell);
@@ -28,6 +28,7 @@
 #include <ns3/nstime.h>
 #include <ns3/test.h>
 
+#include <limits>
 #include <list>
 #include <set>
 #include <vector>
@@ -75,6 +76,8 @@ class LteUeMeasurementsTestCase : public TestCase
      * \param rsrpDbmUe2 RSRP in dBm UE 2
      * \param rsrqDbUe1 RSRQ in dBm UE 1
      * \param rsrqDbUe2 RSRQ in dBm UE 2
+     * \param rsrpMeasThreshold the RSRP threshold in dBm below which the
+     *        neighbor cells are not measured (LteUePhy::RsrpUeMeasThreshold)
      */
     LteUeMeasurementsTestCase(std::string name,
                               double d1,
@@ -82,7 +85,8 @@ class LteUeMeasurementsTestCase : public TestCase
                               double rsrpDbmUe1,
                               double rsrpDbmUe2,
                               double rsrqDbUe1,
-                              double rsrqDbUe2);
+                              double rsrqDbUe2,
+                              double rsrpMeasThreshold = -std::numeric_limits<double>::infinity());
     ~LteUeMeasurementsTestCase() override;
 
     /**
@@ -120,6 +124,9 @@ class LteUeMeasurementsTestCase : public TestCase
     double m_rsrpDbmUeNeighborCell; ///< RSRP in dBm UE 2
     double m_rsrqDbUeServingCell;   ///< RSRQ in dBm UE 1
     double m_rsrqDbUeNeighborCell;  ///< RSRQ in dBm UE 2
+    double m_rsrpMeasThreshold;     ///< RSRP measurement threshold in dBm
+    uint32_t m_nServingCellReports{0};  ///< number of serving cell measurements reported
+    uint32_t m_nNeighborCellReports{0}; ///< number of neighbor cell measurements reported
 };
 
 // ===== LTE-UE-MEASUREMENTS-PIECEWISE-1 TEST SUITE ======================== //
@@ -202,6 +202,73 @@ EpcTftClassifierTestCase::DoRun()
                       m_d,
                       m_useIpv6 ? Ipv6L3Protocol::PROT_NUMBER : Ipv4L3Protocol::PROT_NUMBER);
     NS_TEST_ASSERT_MSG_EQ(obtainedTftId, (uint16_t)m_tftId, "bad classification of UDP packet");
+
+    // the second packet of the flow is classified from the cache of the classifier
+    obtainedTftId =
+        m_c->Classify(udpPacket,
+                      m_d,
+                      m_useIpv6 ? Ipv6L3Protocol::PROT_NUMBER : Ipv4L3Protocol::PROT_NUMBER);
+    NS_TEST_ASSERT_MSG_EQ(obtainedTftId,
+                          (uint16_t)m_tftId,
+                          "bad cached classification of UDP packet");
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * \brief Test that the classification cache of the EpcTftClassifier is
+ * flushed when TFTs are added or deleted, with TCP packets.
+ */
+class EpcTftClassifierCacheTestCase : public TestCase
+{
+  public:
+    EpcTftClassifierCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+EpcTftClassifierCacheTestCase::EpcTftClassifierCacheTestCase()
+    : TestCase("EpcTftClassifier cache flushed upon TFT changes")
+{
+}
+
+void
+EpcTftClassifierCacheTestCase::DoRun()
+{
+    Ptr<EpcTftClassifier> c = Create<EpcTftClassifier>();
+    c->Add(EpcTft::Default(), 1);
+
+    TcpHeader tcpHeader;
+    tcpHeader.SetSourcePort(5000);
+    tcpHeader.SetDestinationPort(80);
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("1.1.1.1"));
+    ipHeader.SetDestination(Ipv4Address("7.0.0.2"));
+    ipHeader.SetPayloadSize(tcpHeader.GetSerializedSize());
+    ipHeader.SetProtocol(TcpL4Protocol::PROT_NUMBER);
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(tcpHeader);
+    packet->AddHeader(ipHeader);
+
+    NS_TEST_ASSERT_MSG_EQ(c->Classify(packet, EpcTft::DOWNLINK, Ipv4L3Protocol::PROT_NUMBER),
+                          1,
+                          "packet not classified to the default bearer");
+
+    Ptr<EpcTft> tft = Create<EpcTft>();
+    EpcTft::PacketFilter pf;
+    pf.remotePortStart = 5000;
+    pf.remotePortEnd = 5000;
+    tft->Add(pf);
+    c->Add(tft, 2);
+    NS_TEST_ASSERT_MSG_EQ(c->Classify(packet, EpcTft::DOWNLINK, Ipv4L3Protocol::PROT_NUMBER),
+                          2,
+                          "stale classification after adding a TFT");
+
+    c->Delete(2);
+    NS_TEST_ASSERT_MSG_EQ(c->Classify(packet, EpcTft::DOWNLINK, Ipv4L3Protocol::PROT_NUMBER),
+                          1,
+                          "stale classification after deleting a TFT");
 }
 
 /**
@@ -1016,4 +1083,6 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite()
                                                  useIpv6),
                     TestCase::Duration::QUICK);
     }
+
+    AddTestCase(new EpcTftClassifierCacheTestCase(), TestCase::Duration::QUICK);
 }
@@ -35,6 +35,8 @@
 #include "ns3/test.h"
 #include <ns3/lte-chunk-processor.h>
 
+#include <limits>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("LteAntennaTest");
@@ -203,6 +205,10 @@ LteEnbAntennaTestCase::DoRun()
         MakeCallback(&DownlinkLteGlobalPathlossDatabase::UpdatePathloss, &dlPathlossDb));
     Config::Connect("/ChannelList/1/PathLoss",
                     MakeCallback(&UplinkLteGlobalPathlossDatabase::UpdatePathloss, &ulPathlossDb));
+    // the same values fed without a trace context, and in single precision
+    DownlinkLteGlobalPathlossDatabase dlPathlossDbFloat(true);
+    dlPathlossDbFloat.Connect(lteHelper->GetDownlinkSpectrumChannel());
+    auto ulSharedPathlossDb = lteHelper->GetUplinkPathlossDatabase();
 
     Simulator::Stop(Seconds(0.035));
     Simulator::Run();
@@ -257,6 +263,21 @@ LteEnbAntennaTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(measuredLossDl, -m_antennaGainDb, tolerance, "Wrong DL loss!");
     double measuredLossUl = ulPathlossDb.GetPathloss(1, 1);
     NS_TEST_ASSERT_MSG_EQ_TOL(measuredLossUl, -m_antennaGainDb, tolerance, "Wrong UL loss!");
+    NS_TEST_ASSERT_MSG_EQ_TOL(dlPathlossDbFloat.GetPathloss(1, 1),
+                              measuredLossDl,
+                              tolerance,
+                              "Wrong DL loss in single precision!");
+    NS_TEST_ASSERT_MSG_EQ(ulSharedPathlossDb->GetPathloss(1, 1),
+                          measuredLossUl,
+                          "Wrong UL loss in the shared database!");
+    NS_TEST_ASSERT_MSG_EQ(ulSharedPathlossDb->GetPathloss(2, 1),
+                          std::numeric_limits<double>::infinity(),
+                          "Unexpected UL loss for an unknown cell!");
+    // the IMSIs need not be compact
+    dlPathlossDbFloat.SetPathloss(1, 1ULL << 40, 3.0);
+    NS_TEST_ASSERT_MSG_EQ(dlPathlossDbFloat.GetPathloss(1, 1ULL << 40),
+                          3.0,
+                          "Wrong DL loss for a large IMSI!");
 
     Simulator::Destroy();
 }
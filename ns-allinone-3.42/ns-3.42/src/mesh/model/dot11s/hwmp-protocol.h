@@ -21,11 +21,13 @@
 #define HWMP_PROTOCOL_H
 
 #include "ns3/event-id.h"
+#include "ns3/mac48-address.h"
 #include "ns3/mesh-l2-routing-protocol.h"
 #include "ns3/nstime.h"
 #include "ns3/traced-value.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -496,9 +498,10 @@ class HwmpProtocol : public MeshL2RoutingProtocol
     /// \name Sequence number filters
     ///@{
     /// Data sequence number database
-    std::map<Mac48Address, uint32_t> m_lastDataSeqno;
+    std::unordered_map<Mac48Address, uint32_t, Mac48AddressHash> m_lastDataSeqno;
     /// keeps HWMP seqno (first in pair) and HWMP metric (second in pair) for each address
-    std::map<Mac48Address, std::pair<uint32_t, uint32_t>> m_hwmpSeqnoMetricDatabase;
+    std::unordered_map<Mac48Address, std::pair<uint32_t, uint32_t>, Mac48AddressHash>
+        m_hwmpSeqnoMetricDatabase;
     ///@}
 
     /// Routing table
@@ -511,8 +514,9 @@ class HwmpProtocol : public MeshL2RoutingProtocol
         Time whenScheduled;  ///< scheduled time
     };
 
-    std::map<Mac48Address, PreqEvent> m_preqTimeouts; ///< PREQ timeouts
-    EventId m_proactivePreqTimer;                     ///< proactive PREQ timer
+    /// PREQ timeouts
+    std::unordered_map<Mac48Address, PreqEvent, Mac48AddressHash> m_preqTimeouts;
+    EventId m_proactivePreqTimer; ///< proactive PREQ timer
     /// Random start in Proactive PREQ propagation
     Time m_randomStart;
     /// Packet Queue
@@ -58,6 +58,7 @@ void
 HwmpRtable::DoDispose()
 {
     m_routes.clear();
+    m_routesByRetransmitter.clear();
 }
 
 void
@@ -70,14 +71,15 @@ HwmpRtable::AddReactivePath(Mac48Address destination,
 {
     NS_LOG_FUNCTION(this << destination << retransmitter << interface << metric
                          << lifetime.GetSeconds() << seqnum);
-    auto i = m_routes.find(destination);
-    if (i == m_routes.end())
+    auto [i, inserted] = m_routes.try_emplace(destination);
+    if (inserted || i->second.retransmitter != retransmitter)
     {
-        ReactiveRoute newroute;
-        m_routes[destination] = newroute;
+        if (!inserted)
+        {
+            UnindexRoute(destination, i->second.retransmitter);
+        }
+        m_routesByRetransmitter[retransmitter].insert(destination);
     }
-    i = m_routes.find(destination);
-    NS_ASSERT(i != m_routes.end());
     i->second.retransmitter = retransmitter;
     i->second.interface = interface;
     i->second.metric = metric;
@@ -164,10 +166,23 @@ HwmpRtable::DeleteReactivePath(Mac48Address destination)
     auto i = m_routes.find(destination);
     if (i != m_routes.end())
     {
+        UnindexRoute(destination, i->second.retransmitter);
         m_routes.erase(i);
     }
 }
 
+void
+HwmpRtable::UnindexRoute(Mac48Address destination, Mac48Address retransmitter)
+{
+    auto i = m_routesByRetransmitter.find(retransmitter);
+    NS_ASSERT(i != m_routesByRetransmitter.end());
+    i->second.erase(destination);
+    if (i->second.empty())
+    {
+        m_routesByRetransmitter.erase(i);
+    }
+}
+
 HwmpRtable::LookupResult
 HwmpRtable::LookupReactive(Mac48Address destination)
 {
@@ -232,13 +247,15 @@ HwmpRtable::GetUnreachableDestinations(Mac48Address peerAddress)
     NS_LOG_FUNCTION(this << peerAddress);
     HwmpProtocol::FailedDestination dst;
     std::vector<HwmpProtocol::FailedDestination> retval;
-    for (auto i = m_routes.begin(); i != m_routes.end(); i++)
+    auto byRetransmitter = m_routesByRetransmitter.find(peerAddress);
+    if (byRetransmitter != m_routesByRetransmitter.end())
     {
-        if (i->second.retransmitter == peerAddress)
+        for (const auto& destination : byRetransmitter->second)
         {
-            dst.destination = i->first;
-            i->second.seqnum++;
-            dst.seqnum = i->second.seqnum;
+            ReactiveRoute& route = m_routes.at(destination);
+            dst.destination = destination;
+            route.seqnum++;
+            dst.seqnum = route.seqnum;
             retval.push_back(dst);
         }
     }
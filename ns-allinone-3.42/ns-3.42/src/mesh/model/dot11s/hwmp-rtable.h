@@ -25,7 +25,8 @@
 #include "ns3/mac48-address.h"
 #include "ns3/nstime.h"
 
-#include <map>
+#include <set>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -227,8 +228,18 @@ class HwmpRtable : public Object
         std::vector<Precursor> precursors; ///< precursors
     };
 
+    /**
+     * \brief Remove a route from the index of the routes by retransmitter.
+     * \param destination the destination of the route
+     * \param retransmitter the retransmitter of the route
+     */
+    void UnindexRoute(Mac48Address destination, Mac48Address retransmitter);
+
     /// List of routes
-    std::map<Mac48Address, ReactiveRoute> m_routes;
+    std::unordered_map<Mac48Address, ReactiveRoute, Mac48AddressHash> m_routes;
+    /// Destinations of the reactive routes, by retransmitter, in address order
+    std::unordered_map<Mac48Address, std::set<Mac48Address>, Mac48AddressHash>
+        m_routesByRetransmitter;
     /// Path to proactive tree root MP
     ProactiveRoute m_root;
 };
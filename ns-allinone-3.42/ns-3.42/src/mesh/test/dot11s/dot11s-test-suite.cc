@@ -112,6 +112,9 @@ class HwmpRtableTest : public TestCase
     /// Test add path and try to lookup after entry has expired
     void TestExpire();
 
+    /// Test the destinations made unreachable by the loss of a retransmitter
+    void TestUnreachable();
+
     /// Test add precursors and find precursor list in rtable
     void TestPrecursorAdd();
     /// Test add precursors and find precursor list in rtable
@@ -160,6 +163,35 @@ HwmpRtableTest::TestLookup()
     NS_TEST_EXPECT_MSG_EQ(table->LookupProactive().IsValid(), false, "Proactive lookup works");
 }
 
+void
+HwmpRtableTest::TestUnreachable()
+{
+    Mac48Address dst2("01:00:00:01:00:02");
+    Mac48Address hop2("01:00:00:01:00:04");
+    table->AddReactivePath(dst, hop, iface, metric, expire, seqnum);
+    table->AddReactivePath(dst2, hop, iface, metric, expire, seqnum);
+    // Reroute dst through hop2
+    table->AddReactivePath(dst, hop2, iface, metric, expire, seqnum);
+
+    std::vector<HwmpProtocol::FailedDestination> unreachable =
+        table->GetUnreachableDestinations(hop);
+    NS_TEST_EXPECT_MSG_EQ(unreachable.size(), 1, "Rerouted destination is not through hop");
+    NS_TEST_EXPECT_MSG_EQ(unreachable[0].destination, dst2, "Unreachable destination works");
+    NS_TEST_EXPECT_MSG_EQ(unreachable[0].seqnum, seqnum + 1, "Unreachable seqnum works");
+    unreachable = table->GetUnreachableDestinations(hop2);
+    NS_TEST_EXPECT_MSG_EQ(unreachable.size(), 1, "Rerouted destination is through hop2");
+    NS_TEST_EXPECT_MSG_EQ(unreachable[0].destination, dst, "Unreachable destination works");
+
+    table->DeleteReactivePath(dst);
+    table->DeleteReactivePath(dst2);
+    NS_TEST_EXPECT_MSG_EQ(table->GetUnreachableDestinations(hop).size(),
+                          0,
+                          "Deleted routes are not unreachable");
+    NS_TEST_EXPECT_MSG_EQ(table->GetUnreachableDestinations(hop2).size(),
+                          0,
+                          "Deleted routes are not unreachable");
+}
+
 void
 HwmpRtableTest::TestAddPath()
 {
@@ -212,6 +244,7 @@ HwmpRtableTest::DoRun()
     table = CreateObject<HwmpRtable>();
 
     Simulator::Schedule(Seconds(0), &HwmpRtableTest::TestLookup, this);
+    Simulator::Schedule(Seconds(0.5), &HwmpRtableTest::TestUnreachable, this);
     Simulator::Schedule(Seconds(1), &HwmpRtableTest::TestAddPath, this);
     Simulator::Schedule(Seconds(2), &HwmpRtableTest::TestPrecursorAdd, this);
     Simulator::Schedule(expire + Seconds(2), &HwmpRtableTest::TestExpire, this);
@@ -77,8 +77,11 @@ main(int argc, char* argv[])
     std::string traceFile;
     std::string logFile;
 
+    std::string binaryFile;
+
     int nodeNum;
     double duration;
+    double streamWindow = 0;
 
     // Enable logging from the ns2 helper
     LogComponentEnable("Ns2MobilityHelper", LOG_LEVEL_DEBUG);
@@ -89,8 +92,22 @@ main(int argc, char* argv[])
     cmd.AddValue("nodeNum", "Number of nodes", nodeNum);
     cmd.AddValue("duration", "Duration of Simulation", duration);
     cmd.AddValue("logFile", "Log file", logFile);
+    cmd.AddValue("streamWindow",
+                 "Stream the trace with this time window in seconds, 0 to read it at install",
+                 streamWindow);
+    cmd.AddValue("convertTo", "Convert the trace to this binary trace file and exit", binaryFile);
     cmd.Parse(argc, argv);
 
+    if (!traceFile.empty() && !binaryFile.empty())
+    {
+        if (!Ns2MobilityHelper::ConvertToBinary(traceFile, binaryFile))
+        {
+            std::cerr << "Could not convert " << traceFile << " to " << binaryFile << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
     // Check command line arguments
     if (traceFile.empty() || nodeNum <= 0 || duration <= 0 || logFile.empty())
     {
@@ -114,6 +131,7 @@ main(int argc, char* argv[])
 
     // Create Ns2MobilityHelper with the specified trace log file as parameter
     Ns2MobilityHelper ns2 = Ns2MobilityHelper(traceFile);
+    ns2.SetStreamWindow(Seconds(streamWindow));
 
     // open log file for output
     std::ofstream os;
@@ -133,4 +133,21 @@ GroupMobilityHelper::AssignStreams(NodeContainer c, int64_t stream)
     return (currentStream - stream);
 }
 
+std::vector<Vector>
+GroupMobilityHelper::GetPositions(NodeContainer c)
+{
+    std::vector<Ptr<HierarchicalMobilityModel>> models;
+    models.reserve(c.GetN());
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        Ptr<HierarchicalMobilityModel> mobility = (*i)->GetObject<HierarchicalMobilityModel>();
+        if (!mobility)
+        {
+            NS_FATAL_ERROR("Did not find a HierarchicalMobilityModel");
+        }
+        models.push_back(mobility);
+    }
+    return HierarchicalMobilityModel::GetPositions(models);
+}
+
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include "ns3/attribute.h"
 #include "ns3/node-container.h"
 #include "ns3/object-factory.h"
+#include "ns3/vector.h"
 
 #include <vector>
 
@@ -180,6 +181,17 @@ class GroupMobilityHelper
      */
     int64_t AssignStreams(NodeContainer c, int64_t stream);
 
+    /**
+     * Get the positions of the nodes of a group at the current simulation
+     * time, with HierarchicalMobilityModel::GetPositions.  The reference
+     * model of the group is evaluated once for all the nodes.
+     *
+     * \param c NodeContainer of the set of nodes, whose mobility models
+     * were installed by this helper
+     * \return the positions of the nodes, in the same order
+     */
+    static std::vector<Vector> GetPositions(NodeContainer c);
+
   private:
     // Enable logging from template instantiations
     NS_LOG_TEMPLATE_DECLARE; //!< the log component
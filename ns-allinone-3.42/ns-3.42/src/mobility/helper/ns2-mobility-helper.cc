@@ -38,16 +38,31 @@
 
 #include "ns2-mobility-helper.h"
 
+#include "ns3/abort.h"
 #include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
 #include "ns3/simulator.h"
+#include "ns3/waypoint-mobility-model.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
 
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace ns3
 {
 
@@ -230,8 +245,283 @@ static Vector SetSchedPosition(Ptr<ConstantVelocityMobilityModel> model,
                                std::string coord,
                                double coordVal);
 
+/**
+ * Kinds of the scheduled statements of a streamed trace, as stored in the
+ * records of a binary trace
+ */
+enum Ns2StatementKind : uint32_t
+{
+    NS2_STATEMENT_SETDEST = 0, //!< $ns_ at $time $node setdest x2 y2 speed
+    NS2_STATEMENT_SET_X = 1,   //!< $ns_ at $time $node set X_ x1
+    NS2_STATEMENT_SET_Y = 2,   //!< $ns_ at $time $node set Y_ y1
+    NS2_STATEMENT_SET_Z = 3,   //!< $ns_ at $time $node set Z_ z1
+};
+
+/**
+ * A scheduled statement of a streamed trace
+ */
+struct Ns2Statement
+{
+    double time;      //!< time of the statement, in seconds from the install
+    uint32_t nodeId;  //!< node the statement applies to
+    uint32_t kind;    //!< an Ns2StatementKind
+    double values[3]; //!< x, y and speed of a setdest, or the coordinate of a set
+};
+
+/**
+ * Kinds of lines told apart by ScanNs2Line
+ */
+enum Ns2LineKind
+{
+    NS2_LINE_OTHER,       //!< empty line, comment or unknown statement
+    NS2_LINE_INITIAL_POS, //!< line like $node_(0) set X_ 123
+    NS2_LINE_SCHEDULED,   //!< line like $ns_ at 1 "$node_(0) ..."
+    NS2_LINE_BAD_TIME,    //!< scheduled line whose time is not a positive number
+};
+
+/// Magic string at the start of a binary trace
+static const char NS2_BINARY_MAGIC[8] = {'N', 'S', '2', 'M', 'O', 'B', 'B', '1'};
+/// Size of the header of a binary trace: magic, node count, padding and statement count
+static const size_t NS2_BINARY_HEADER_SIZE =
+    sizeof(NS2_BINARY_MAGIC) + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+/// Size of a node record of a binary trace: node id, padding and initial position
+static const size_t NS2_BINARY_NODE_SIZE = 2 * sizeof(uint32_t) + 3 * sizeof(double);
+/// Size of a statement record of a binary trace: time, node id, kind and values
+static const size_t NS2_BINARY_STATEMENT_SIZE = sizeof(double) + 2 * sizeof(uint32_t) +
+                                                3 * sizeof(double);
+
+/**
+ * A trace file mapped in memory, or read in a buffer where mmap is not available
+ */
+class Ns2MappedTrace
+{
+  public:
+    Ns2MappedTrace();
+    ~Ns2MappedTrace();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    Ns2MappedTrace(const Ns2MappedTrace&) = delete;
+    Ns2MappedTrace& operator=(const Ns2MappedTrace&) = delete;
+
+    /**
+     * \param filename the file to map
+     * \return true if the file could be mapped
+     */
+    bool Map(const std::string& filename);
+    /// \return the first byte of the file
+    const char* GetData() const;
+    /// \return the size of the file in bytes
+    size_t GetSize() const;
+
+  private:
+    void* m_mapping;            //!< Mapped file, if any
+    size_t m_mappingSize;       //!< Size of the mapping
+    std::vector<char> m_buffer; //!< File contents where it is not mapped
+    const char* m_data;         //!< First byte of the file
+    size_t m_size;              //!< Size of the file
+};
+
+/**
+ * Reads the scheduled statements of a trace in time order
+ */
+class Ns2TraceReader
+{
+  public:
+    /**
+     * \param trace the mapped trace
+     */
+    Ns2TraceReader(std::unique_ptr<Ns2MappedTrace> trace);
+    virtual ~Ns2TraceReader();
+
+    /// \return the initial position of every node of the trace, by node id
+    const std::map<uint32_t, Vector>& GetNodes() const;
+    /**
+     * \param horizon the time of the last statement to read, in seconds
+     * \param statement set to the next statement, if one is read
+     * \return true if a statement at or before the horizon was read
+     */
+    virtual bool Next(double horizon, Ns2Statement& statement) = 0;
+    /// \return true if all the statements were read
+    virtual bool IsDone() const = 0;
+
+  protected:
+    std::unique_ptr<Ns2MappedTrace> m_trace; //!< The mapped trace
+    std::map<uint32_t, Vector> m_nodes;      //!< Initial position of every node, by node id
+};
+
+/**
+ * Reads the statements of an ns2 movement trace.  The lines are parsed only
+ * as they are read.  If the scheduled lines of the trace are not in time
+ * order, the time and offset of each of them are indexed, and sorted by time.
+ */
+class Ns2TextTraceReader : public Ns2TraceReader
+{
+  public:
+    /**
+     * \param trace the mapped trace
+     */
+    Ns2TextTraceReader(std::unique_ptr<Ns2MappedTrace> trace);
+
+    bool Next(double horizon, Ns2Statement& statement) override;
+    bool IsDone() const override;
+
+  private:
+    /**
+     * Scan every line of the trace.  The first scan reads the initial
+     * positions and tells if the trace is in time order, the second one
+     * indexes the scheduled lines.
+     * \param index whether to index the scheduled lines
+     */
+    void Scan(bool index);
+    /**
+     * \param line the first byte of a line
+     * \return the end of the line
+     */
+    const char* GetLineEnd(const char* line) const;
+
+    bool m_ordered;                                 //!< Whether the lines are in time order
+    size_t m_cursor;                                //!< Offset of the next line, if ordered
+    std::vector<std::pair<double, size_t>> m_index; //!< Time and offset of the lines, otherwise
+    size_t m_nextEntry;                             //!< Next entry of the index
+};
+
+/**
+ * Reads the statements of a binary trace, which are stored in time order.
+ */
+class Ns2BinaryTraceReader : public Ns2TraceReader
+{
+  public:
+    /**
+     * \param trace the mapped trace
+     */
+    Ns2BinaryTraceReader(std::unique_ptr<Ns2MappedTrace> trace);
+
+    /// \return true if the header and the size of the trace match
+    bool IsValid() const;
+    bool Next(double horizon, Ns2Statement& statement) override;
+    bool IsDone() const override;
+
+  private:
+    bool m_valid;          //!< Whether the trace is valid
+    const char* m_records; //!< First statement record
+    uint64_t m_count;      //!< Number of statement records
+    uint64_t m_next;       //!< Next statement record
+    double m_lastTime;     //!< Time of the last statement read
+};
+
+/**
+ * Feeds the statements of a trace to waypoint mobility models, one time
+ * window at a time.  Each node follows legs: it moves at constant velocity
+ * from the position where a setdest started towards its destination.  The
+ * waypoints of a leg are added when the leg ends, or at the end of the
+ * loaded windows for a leg which goes on.
+ */
+class Ns2MobilityStream : public SimpleRefCount<Ns2MobilityStream>
+{
+  public:
+    /**
+     * \param reader the reader of the trace
+     * \param window the length of the time windows
+     */
+    Ns2MobilityStream(std::unique_ptr<Ns2TraceReader> reader, Time window);
+
+    /**
+     * \param nodeId the id of the node in the trace
+     * \param model the mobility model of the node
+     * \param position the initial position of the node
+     */
+    void AddNode(uint32_t nodeId, Ptr<WaypointMobilityModel> model, const Vector& position);
+    /// Load the first windows, and schedule the loading of the next ones
+    void Start();
+
+  private:
+    /**
+     * State of a node of the trace
+     */
+    struct Node
+    {
+        Ptr<WaypointMobilityModel> model; //!< Mobility model, null if not in the store
+        Vector position;                  //!< Position at the start of the leg
+        Vector velocity;                  //!< Velocity of the leg
+        Vector destination;               //!< Destination of the leg
+        Time start;                       //!< Start time of the leg
+        Time arrival;                     //!< Arrival time of the leg
+        bool moving{false};               //!< Whether the node is on a leg
+        Time lastTime;                    //!< Time of the last waypoint added
+        Vector lastPosition;              //!< Position of the last waypoint added
+    };
+
+    /// Load the statements until two windows ahead of now
+    void Refill();
+    /**
+     * \param statement the statement to apply
+     */
+    void Apply(const Ns2Statement& statement);
+    /**
+     * Add a waypoint for the end of the legs which go on after the horizon
+     * \param horizon the time of the last statement loaded
+     * \return true if some nodes are still moving
+     */
+    bool Flush(Time horizon);
+    /**
+     * End the leg of a node at its destination
+     * \param node the node
+     */
+    void Arrive(Node& node);
+    /**
+     * \param node the node
+     * \param time the time
+     * \return the position of the node at the given time
+     */
+    Vector GetPosition(const Node& node, Time time) const;
+    /**
+     * Add a waypoint to the model of a node.  A waypoint at the same time
+     * and position as the last one is dropped, and a waypoint which is not
+     * after the last one is moved one time step after it.
+     * \param node the node
+     * \param time the time of the waypoint
+     * \param position the position of the waypoint
+     */
+    void AddWaypoint(Node& node, Time time, const Vector& position);
+
+    std::unique_ptr<Ns2TraceReader> m_reader; //!< Reader of the trace
+    Time m_window;                            //!< Length of the time windows
+    Time m_offset;                            //!< Simulation time of the time zero of the trace
+    std::vector<Node> m_nodes;                //!< State of the nodes, by node id
+};
+
+/**
+ * Tell the kind of a line without parsing it all, and get the time and the
+ * node id of a scheduled line
+ * \param begin the first byte of the line
+ * \param end the end of the line
+ * \param time set to the time of a scheduled line
+ * \param nodeId set to the node id of a scheduled line
+ * \returns the kind of the line
+ */
+static Ns2LineKind ScanNs2Line(const char* begin,
+                               const char* end,
+                               double& time,
+                               uint32_t& nodeId);
+
+/**
+ * Parse a scheduled line of ns2 mobility
+ * \param line the line to parse
+ * \param statement set to the statement of the line
+ * \returns true if the line is a valid scheduled statement
+ */
+static bool ParseNs2Statement(const std::string& line, Ns2Statement& statement);
+
+/**
+ * Map a trace, and open a reader of the statements of its format
+ * \param filename the file of the trace
+ * \returns the reader, or nullptr if the trace could not be opened
+ */
+static std::unique_ptr<Ns2TraceReader> OpenNs2Trace(const std::string& filename);
+
 Ns2MobilityHelper::Ns2MobilityHelper(std::string filename)
-    : m_filename(filename)
+    : m_filename(filename),
+      m_streamWindow(Seconds(0))
 {
     std::ifstream file(m_filename, std::ios::in);
     if (!(file.is_open()))
@@ -262,11 +552,37 @@ Ns2MobilityHelper::GetMobilityModel(std::string idString, const ObjectStore& sto
     return model;
 }
 
+void
+Ns2MobilityHelper::SetStreamWindow(Time window)
+{
+    NS_ABORT_MSG_IF(window.IsStrictlyNegative(), "The stream window can not be negative");
+    m_streamWindow = window;
+}
+
 void
 Ns2MobilityHelper::ConfigNodesMovements(const ObjectStore& store) const
 {
+    if (m_streamWindow.IsStrictlyPositive())
+    {
+        StreamNodesMovements(store);
+        return;
+    }
+
     std::map<int, DestinationPoint> last_pos; // Stores previous movement scheduled for each node
 
+    std::ifstream file(m_filename, std::ios::in);
+
+    // Binary traces can not be parsed
+    char magic[sizeof(NS2_BINARY_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() == sizeof(magic) && std::memcmp(magic, NS2_BINARY_MAGIC, sizeof(magic)) == 0)
+    {
+        NS_FATAL_ERROR("Trace file " << m_filename
+                                     << " is a binary trace, which can only be streamed");
+    }
+    file.clear();
+    file.seekg(0);
+
     //*****************************************************************
     // Parse the file the first time to get the initial node positions.
     //*****************************************************************
@@ -274,7 +590,6 @@ Ns2MobilityHelper::ConfigNodesMovements(const ObjectStore& store) const
     // Look through the whole the file for the the initial node
     // positions to make this helper robust to handle trace files with
     // the initial node positions at the end.
-    std::ifstream file(m_filename, std::ios::in);
     if (file.is_open())
     {
         while (!file.eof())
@@ -858,6 +1173,730 @@ SetSchedPosition(Ptr<ConstantVelocityMobilityModel> model,
     return position;
 }
 
+Ns2LineKind
+ScanNs2Line(const char* begin, const char* end, double& time, uint32_t& nodeId)
+{
+    // ignore comments (#)
+    const char* sharp = static_cast<const char*>(std::memchr(begin, '#', end - begin));
+    if (sharp)
+    {
+        end = sharp;
+    }
+
+    // Split the first four tokens of the line
+    const char* tokens[4];
+    const char* tokenEnds[4];
+    size_t nTokens = 0;
+    const char* p = begin;
+    while (nTokens < 4)
+    {
+        while (p < end && isspace(*p))
+        {
+            p++;
+        }
+        if (p == end)
+        {
+            break;
+        }
+        tokens[nTokens] = p;
+        while (p < end && !isspace(*p))
+        {
+            p++;
+        }
+        tokenEnds[nTokens++] = p;
+    }
+
+    auto isToken = [&tokens, &tokenEnds](size_t i, const char* str) {
+        size_t length = std::strlen(str);
+        return size_t(tokenEnds[i] - tokens[i]) == length &&
+               std::strncmp(tokens[i], str, length) == 0;
+    };
+
+    size_t nodeIdLength = std::strlen(NS2_NODEID);
+    if (nTokens > 0 && size_t(tokenEnds[0] - tokens[0]) > nodeIdLength &&
+        std::strncmp(tokens[0], NS2_NODEID, nodeIdLength) == 0)
+    {
+        return NS2_LINE_INITIAL_POS;
+    }
+    if (nTokens < 4 || !isToken(0, NS2_NS_SCH) || !isToken(1, NS2_AT))
+    {
+        return NS2_LINE_OTHER;
+    }
+
+    // Time, which is a number as for IsNumber
+    std::string timeToken(tokens[2], tokenEnds[2]);
+    char* timeEnd;
+    time = strtod(timeToken.c_str(), &timeEnd);
+    if (timeEnd != timeToken.c_str() + timeToken.size() || time < 0)
+    {
+        return NS2_LINE_BAD_TIME;
+    }
+
+    // Node id, between the brackets of "$node_(0)
+    const char* open = static_cast<const char*>(
+        std::memchr(tokens[3], '(', tokenEnds[3] - tokens[3]));
+    if (!open)
+    {
+        return NS2_LINE_OTHER;
+    }
+    uint64_t id = 0;
+    const char* digit = open + 1;
+    for (; digit < tokenEnds[3] && isdigit(*digit); digit++)
+    {
+        id = id * 10 + (*digit - '0');
+        if (id > std::numeric_limits<uint32_t>::max())
+        {
+            return NS2_LINE_OTHER;
+        }
+    }
+    if (digit == open + 1 || digit == tokenEnds[3] || *digit != ')')
+    {
+        return NS2_LINE_OTHER;
+    }
+    nodeId = id;
+    return NS2_LINE_SCHEDULED;
+}
+
+bool
+ParseNs2Statement(const std::string& line, Ns2Statement& statement)
+{
+    ParseResult pr = ParseNs2Line(line);
+
+    if (IsSchedMobilityPos(pr))
+    {
+        statement.kind = NS2_STATEMENT_SETDEST;
+        statement.values[0] = pr.dvals[5];
+        statement.values[1] = pr.dvals[6];
+        statement.values[2] = pr.dvals[7];
+    }
+    else if (IsSchedSetPos(pr))
+    {
+        if (pr.tokens[5] == NS2_X_COORD)
+        {
+            statement.kind = NS2_STATEMENT_SET_X;
+        }
+        else if (pr.tokens[5] == NS2_Y_COORD)
+        {
+            statement.kind = NS2_STATEMENT_SET_Y;
+        }
+        else
+        {
+            statement.kind = NS2_STATEMENT_SET_Z;
+        }
+        statement.values[0] = pr.dvals[6];
+        statement.values[1] = 0;
+        statement.values[2] = 0;
+    }
+    else
+    {
+        NS_LOG_WARN("Format Line is not correct: " << line << "\n");
+        return false;
+    }
+    statement.time = pr.dvals[2];
+    statement.nodeId = GetNodeIdInt(pr);
+    return true;
+}
+
+/**
+ * \param data the first byte of the value
+ * \return the value
+ */
+template <typename T>
+static T
+ReadNs2Binary(const char* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/**
+ * \param os the stream to write to
+ * \param value the value to write
+ */
+template <typename T>
+static void
+WriteNs2Binary(std::ostream& os, T value)
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::unique_ptr<Ns2TraceReader>
+OpenNs2Trace(const std::string& filename)
+{
+    auto trace = std::make_unique<Ns2MappedTrace>();
+    if (!trace->Map(filename))
+    {
+        return nullptr;
+    }
+    if (trace->GetSize() >= sizeof(NS2_BINARY_MAGIC) &&
+        std::memcmp(trace->GetData(), NS2_BINARY_MAGIC, sizeof(NS2_BINARY_MAGIC)) == 0)
+    {
+        auto reader = std::make_unique<Ns2BinaryTraceReader>(std::move(trace));
+        if (!reader->IsValid())
+        {
+            NS_LOG_WARN(filename << " is not a valid binary trace");
+            return nullptr;
+        }
+        return reader;
+    }
+    return std::make_unique<Ns2TextTraceReader>(std::move(trace));
+}
+
+Ns2MappedTrace::Ns2MappedTrace()
+    : m_mapping(nullptr),
+      m_mappingSize(0),
+      m_data(nullptr),
+      m_size(0)
+{
+}
+
+Ns2MappedTrace::~Ns2MappedTrace()
+{
+#ifndef __WIN32__
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+bool
+Ns2MappedTrace::Map(const std::string& filename)
+{
+#ifndef __WIN32__
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return true;
+    }
+    size_t size = st.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NS_LOG_WARN("Can not map " << filename);
+        return false;
+    }
+    // The trace is read once from the start
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    m_mapping = mapping;
+    m_mappingSize = size;
+    m_data = static_cast<const char*>(mapping);
+    m_size = size;
+#else
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+    {
+        return false;
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#endif
+    return true;
+}
+
+const char*
+Ns2MappedTrace::GetData() const
+{
+    return m_data;
+}
+
+size_t
+Ns2MappedTrace::GetSize() const
+{
+    return m_size;
+}
+
+Ns2TraceReader::Ns2TraceReader(std::unique_ptr<Ns2MappedTrace> trace)
+    : m_trace(std::move(trace))
+{
+}
+
+Ns2TraceReader::~Ns2TraceReader()
+{
+}
+
+const std::map<uint32_t, Vector>&
+Ns2TraceReader::GetNodes() const
+{
+    return m_nodes;
+}
+
+Ns2TextTraceReader::Ns2TextTraceReader(std::unique_ptr<Ns2MappedTrace> trace)
+    : Ns2TraceReader(std::move(trace)),
+      m_ordered(true),
+      m_cursor(m_trace->GetSize()),
+      m_nextEntry(0)
+{
+    Scan(false);
+    if (!m_ordered)
+    {
+        Scan(true);
+        std::stable_sort(m_index.begin(), m_index.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        NS_LOG_INFO("Trace is not in time order, indexed " << m_index.size() << " lines");
+    }
+}
+
+const char*
+Ns2TextTraceReader::GetLineEnd(const char* line) const
+{
+    const char* end = m_trace->GetData() + m_trace->GetSize();
+    const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+    return newline ? newline : end;
+}
+
+void
+Ns2TextTraceReader::Scan(bool index)
+{
+    const char* data = m_trace->GetData();
+    double lastTime = 0;
+    for (size_t offset = 0; offset < m_trace->GetSize();)
+    {
+        const char* line = data + offset;
+        const char* end = GetLineEnd(line);
+        size_t next = end - data + 1;
+
+        double time;
+        uint32_t nodeId;
+        Ns2LineKind kind = ScanNs2Line(line, end, time, nodeId);
+        if (index)
+        {
+            if (kind == NS2_LINE_SCHEDULED)
+            {
+                m_index.emplace_back(time, offset);
+            }
+        }
+        else if (kind == NS2_LINE_SCHEDULED)
+        {
+            m_nodes.emplace(nodeId, Vector(0, 0, 0));
+            if (m_cursor == m_trace->GetSize())
+            {
+                m_cursor = offset;
+            }
+            else if (time < lastTime)
+            {
+                m_ordered = false;
+            }
+            lastTime = time;
+        }
+        else if (kind == NS2_LINE_INITIAL_POS)
+        {
+            ParseResult pr = ParseNs2Line(std::string(line, end));
+            int iNodeId = GetNodeIdInt(pr);
+            if (IsSetInitialPos(pr) && iNodeId != -1)
+            {
+                Vector& position = m_nodes[iNodeId];
+                position = SetOneInitialCoord(position, pr.tokens[2], pr.dvals[3]);
+            }
+            else
+            {
+                NS_LOG_WARN("Format Line is not correct: " << std::string(line, end) << "\n");
+            }
+        }
+        else if (kind == NS2_LINE_BAD_TIME)
+        {
+            NS_LOG_WARN("Time is not a positive number: " << std::string(line, end));
+        }
+        offset = next;
+    }
+}
+
+bool
+Ns2TextTraceReader::Next(double horizon, Ns2Statement& statement)
+{
+    const char* data = m_trace->GetData();
+    if (m_ordered)
+    {
+        while (m_cursor < m_trace->GetSize())
+        {
+            const char* line = data + m_cursor;
+            const char* end = GetLineEnd(line);
+            double time;
+            uint32_t nodeId;
+            Ns2LineKind kind = ScanNs2Line(line, end, time, nodeId);
+            if (kind == NS2_LINE_SCHEDULED && time > horizon)
+            {
+                return false;
+            }
+            m_cursor = end - data + 1;
+            if (kind == NS2_LINE_SCHEDULED && ParseNs2Statement(std::string(line, end), statement))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    while (m_nextEntry < m_index.size() && m_index[m_nextEntry].first <= horizon)
+    {
+        const char* line = data + m_index[m_nextEntry++].second;
+        if (ParseNs2Statement(std::string(line, GetLineEnd(line)), statement))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+Ns2TextTraceReader::IsDone() const
+{
+    if (m_ordered)
+    {
+        return m_cursor >= m_trace->GetSize();
+    }
+    return m_nextEntry == m_index.size();
+}
+
+Ns2BinaryTraceReader::Ns2BinaryTraceReader(std::unique_ptr<Ns2MappedTrace> trace)
+    : Ns2TraceReader(std::move(trace)),
+      m_valid(false),
+      m_records(nullptr),
+      m_count(0),
+      m_next(0),
+      m_lastTime(0)
+{
+    const char* data = m_trace->GetData();
+    size_t size = m_trace->GetSize();
+    if (size < NS2_BINARY_HEADER_SIZE)
+    {
+        return;
+    }
+    const char* p = data + sizeof(NS2_BINARY_MAGIC);
+    uint32_t nNodes = ReadNs2Binary<uint32_t>(p);
+    uint64_t nStatements = ReadNs2Binary<uint64_t>(p + 2 * sizeof(uint32_t));
+    p = data + NS2_BINARY_HEADER_SIZE;
+    size_t available = size - NS2_BINARY_HEADER_SIZE;
+    if (available / NS2_BINARY_NODE_SIZE < nNodes)
+    {
+        return;
+    }
+    available -= nNodes * NS2_BINARY_NODE_SIZE;
+    if (available != nStatements * NS2_BINARY_STATEMENT_SIZE ||
+        available / NS2_BINARY_STATEMENT_SIZE != nStatements)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < nNodes; i++, p += NS2_BINARY_NODE_SIZE)
+    {
+        const char* position = p + 2 * sizeof(uint32_t);
+        m_nodes[ReadNs2Binary<uint32_t>(p)] =
+            Vector(ReadNs2Binary<double>(position),
+                   ReadNs2Binary<double>(position + sizeof(double)),
+                   ReadNs2Binary<double>(position + 2 * sizeof(double)));
+    }
+    m_records = p;
+    m_count = nStatements;
+    m_valid = true;
+}
+
+bool
+Ns2BinaryTraceReader::IsValid() const
+{
+    return m_valid;
+}
+
+bool
+Ns2BinaryTraceReader::Next(double horizon, Ns2Statement& statement)
+{
+    while (m_next < m_count)
+    {
+        const char* p = m_records + m_next * NS2_BINARY_STATEMENT_SIZE;
+        double time = ReadNs2Binary<double>(p);
+        if (time > horizon)
+        {
+            return false;
+        }
+        NS_ABORT_MSG_IF(time < m_lastTime, "Binary trace statements are not in time order");
+        m_lastTime = time;
+        m_next++;
+        p += sizeof(double);
+        statement.time = time;
+        statement.nodeId = ReadNs2Binary<uint32_t>(p);
+        statement.kind = ReadNs2Binary<uint32_t>(p + sizeof(uint32_t));
+        p += 2 * sizeof(uint32_t);
+        for (double& value : statement.values)
+        {
+            value = ReadNs2Binary<double>(p);
+            p += sizeof(double);
+        }
+        if (statement.kind > NS2_STATEMENT_SET_Z)
+        {
+            NS_LOG_WARN("Unknown statement kind " << statement.kind << " at " << time);
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool
+Ns2BinaryTraceReader::IsDone() const
+{
+    return m_next == m_count;
+}
+
+Ns2MobilityStream::Ns2MobilityStream(std::unique_ptr<Ns2TraceReader> reader, Time window)
+    : m_reader(std::move(reader)),
+      m_window(window),
+      m_offset(Simulator::Now())
+{
+}
+
+void
+Ns2MobilityStream::AddNode(uint32_t nodeId,
+                           Ptr<WaypointMobilityModel> model,
+                           const Vector& position)
+{
+    if (nodeId >= m_nodes.size())
+    {
+        m_nodes.resize(nodeId + 1);
+    }
+    Node& node = m_nodes[nodeId];
+    node.model = model;
+    node.position = position;
+    node.moving = false;
+    node.start = m_offset;
+    model->AddWaypoint(Waypoint(m_offset, position));
+    node.lastTime = m_offset;
+    node.lastPosition = position;
+}
+
+void
+Ns2MobilityStream::Start()
+{
+    Refill();
+}
+
+void
+Ns2MobilityStream::Refill()
+{
+    Time horizon = Simulator::Now() + m_window + m_window;
+    Ns2Statement statement;
+    while (m_reader->Next((horizon - m_offset).GetSeconds(), statement))
+    {
+        Apply(statement);
+    }
+    bool moving = Flush(horizon);
+    NS_LOG_DEBUG("Loaded statements until " << horizon.As(Time::S));
+    if (moving || !m_reader->IsDone())
+    {
+        Simulator::Schedule(m_window, &Ns2MobilityStream::Refill, Ptr<Ns2MobilityStream>(this));
+    }
+}
+
+void
+Ns2MobilityStream::Apply(const Ns2Statement& statement)
+{
+    if (statement.nodeId >= m_nodes.size() || !m_nodes[statement.nodeId].model)
+    {
+        NS_LOG_ERROR("Unknown node ID (corrupted file?): " << statement.nodeId << "\n");
+        return;
+    }
+    Node& node = m_nodes[statement.nodeId];
+    Time at = m_offset + Seconds(statement.time);
+    if (node.moving && node.arrival <= at)
+    {
+        Arrive(node);
+    }
+
+    // Any statement ends the current leg
+    Vector current = GetPosition(node, at);
+    node.moving = false;
+    node.position = current;
+    node.start = at;
+    AddWaypoint(node, at, current);
+
+    switch (statement.kind)
+    {
+    case NS2_STATEMENT_SETDEST: {
+        double speed = statement.values[2];
+        if (speed <= 0)
+        {
+            break;
+        }
+        // first calculate the time; time = distance / speed
+        double time = std::sqrt(std::pow(statement.values[0] - current.x, 2) +
+                                std::pow(statement.values[1] - current.y, 2)) /
+                      speed;
+        if (time == 0)
+        {
+            break;
+        }
+        node.velocity = Vector((statement.values[0] - current.x) / time,
+                               (statement.values[1] - current.y) / time,
+                               0);
+        node.destination = current + node.velocity * time;
+        node.arrival = m_offset + Seconds(statement.time + time);
+        node.moving = true;
+        NS_LOG_DEBUG("Node " << statement.nodeId << " moves at " << node.velocity << " until "
+                             << node.arrival.As(Time::S));
+        break;
+    }
+    case NS2_STATEMENT_SET_X:
+        node.position.x = statement.values[0];
+        break;
+    case NS2_STATEMENT_SET_Y:
+        node.position.y = statement.values[0];
+        break;
+    case NS2_STATEMENT_SET_Z:
+        node.position.z = statement.values[0];
+        break;
+    }
+    if (!node.moving)
+    {
+        AddWaypoint(node, at, node.position);
+    }
+}
+
+bool
+Ns2MobilityStream::Flush(Time horizon)
+{
+    bool moving = false;
+    for (Node& node : m_nodes)
+    {
+        if (!node.moving)
+        {
+            continue;
+        }
+        if (node.arrival <= horizon)
+        {
+            Arrive(node);
+            continue;
+        }
+        AddWaypoint(node, horizon, GetPosition(node, horizon));
+        moving = true;
+    }
+    return moving;
+}
+
+void
+Ns2MobilityStream::Arrive(Node& node)
+{
+    AddWaypoint(node, node.arrival, node.destination);
+    node.moving = false;
+    node.position = node.destination;
+    node.start = node.arrival;
+}
+
+Vector
+Ns2MobilityStream::GetPosition(const Node& node, Time time) const
+{
+    if (!node.moving)
+    {
+        return node.position;
+    }
+    return node.position + node.velocity * (time - node.start).GetSeconds();
+}
+
+void
+Ns2MobilityStream::AddWaypoint(Node& node, Time time, const Vector& position)
+{
+    if (time <= node.lastTime)
+    {
+        if (position == node.lastPosition)
+        {
+            return;
+        }
+        time = node.lastTime + TimeStep(1);
+    }
+    node.model->AddWaypoint(Waypoint(time, position));
+    node.lastTime = time;
+    node.lastPosition = position;
+}
+
+void
+Ns2MobilityHelper::StreamNodesMovements(const ObjectStore& store) const
+{
+    std::unique_ptr<Ns2TraceReader> reader = OpenNs2Trace(m_filename);
+    if (!reader)
+    {
+        NS_FATAL_ERROR("Could not map trace file " << m_filename << " for reading");
+    }
+    std::map<uint32_t, Vector> nodes = reader->GetNodes();
+    Ptr<Ns2MobilityStream> stream = Create<Ns2MobilityStream>(std::move(reader), m_streamWindow);
+    for (const auto& [nodeId, position] : nodes)
+    {
+        Ptr<Object> object = store.Get(nodeId);
+        if (!object)
+        {
+            NS_LOG_ERROR("Unknown node ID (corrupted file?): " << nodeId << "\n");
+            continue;
+        }
+        Ptr<WaypointMobilityModel> model = object->GetObject<WaypointMobilityModel>();
+        if (!model)
+        {
+            model = CreateObject<WaypointMobilityModel>();
+            object->AggregateObject(model);
+        }
+        stream->AddNode(nodeId, model, position);
+    }
+    stream->Start();
+}
+
+bool
+Ns2MobilityHelper::ConvertToBinary(const std::string& input, const std::string& output)
+{
+    std::unique_ptr<Ns2TraceReader> reader = OpenNs2Trace(input);
+    if (!reader)
+    {
+        NS_LOG_WARN("Could not map trace file " << input);
+        return false;
+    }
+    std::ofstream os(output, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+    {
+        NS_LOG_WARN("Could not open " << output << " for writing");
+        return false;
+    }
+
+    // The statement count is written once known
+    os.write(NS2_BINARY_MAGIC, sizeof(NS2_BINARY_MAGIC));
+    WriteNs2Binary<uint32_t>(os, reader->GetNodes().size());
+    WriteNs2Binary<uint32_t>(os, 0);
+    WriteNs2Binary<uint64_t>(os, 0);
+    for (const auto& [nodeId, position] : reader->GetNodes())
+    {
+        WriteNs2Binary<uint32_t>(os, nodeId);
+        WriteNs2Binary<uint32_t>(os, 0);
+        WriteNs2Binary<double>(os, position.x);
+        WriteNs2Binary<double>(os, position.y);
+        WriteNs2Binary<double>(os, position.z);
+    }
+    uint64_t nStatements = 0;
+    Ns2Statement statement;
+    while (reader->Next(std::numeric_limits<double>::infinity(), statement))
+    {
+        WriteNs2Binary<double>(os, statement.time);
+        WriteNs2Binary<uint32_t>(os, statement.nodeId);
+        WriteNs2Binary<uint32_t>(os, statement.kind);
+        for (double value : statement.values)
+        {
+            WriteNs2Binary<double>(os, value);
+        }
+        nStatements++;
+    }
+    os.seekp(NS2_BINARY_HEADER_SIZE - sizeof(uint64_t));
+    WriteNs2Binary<uint64_t>(os, nStatements);
+    NS_LOG_INFO("Wrote " << reader->GetNodes().size() << " nodes and " << nStatements
+                         << " statements to " << output);
+    return os.good();
+}
+
 void
 Ns2MobilityHelper::Install() const
 {
@@ -22,6 +22,7 @@
 #ifndef NS2_MOBILITY_HELPER_H
 #define NS2_MOBILITY_HELPER_H
 
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
@@ -70,6 +71,14 @@ class ConstantVelocityMobilityModel;
  *
  *  See usage example in examples/mobility/ns2-mobility-trace.cc
  *
+ * By default, Install() parses the whole file and schedules every
+ * movement in the simulator with a ConstantVelocityMobilityModel.  For
+ * large traces, SetStreamWindow() makes Install() memory-map the file
+ * instead, and feed the movements to a WaypointMobilityModel one time
+ * window at a time while the simulation runs.  Streamed traces may also
+ * be in the binary format written by ConvertToBinary(), which is read
+ * without any parsing.
+ *
  * \bug Rounding errors may cause movement to diverge from the mobility
  * pattern in ns-2 (using the same trace).
  * See https://www.nsnam.org/bugzilla/show_bug.cgi?id=1316
@@ -105,6 +114,35 @@ class Ns2MobilityHelper
     template <typename T>
     void Install(T begin, T end) const;
 
+    /**
+     * \param window the length of the time window of the trace loaded ahead
+     *        of the simulation time, or zero to read the whole trace at install.
+     *
+     * With a strictly positive window, Install() memory-maps the trace and
+     * gives each node a WaypointMobilityModel.  The waypoints of the next two
+     * windows are added at install, and then every window, so that only those
+     * are held in memory and in the event list.  A movement which spans the
+     * end of the loaded windows is split by a waypoint on its path, so each
+     * window may notify an extra course change for moving nodes.
+     *
+     * A scheduled set of X_, Y_ or Z_ ends the current movement, and moves
+     * the node one time step after the statement time.
+     */
+    void SetStreamWindow(Time window);
+
+    /**
+     * \param input the filename of the ns2 movement trace to convert.
+     * \param output the filename of the binary trace to write.
+     * \return true if the binary trace was written.
+     *
+     * Write the statements of an ns2 movement trace in the binary format
+     * read by a streamed Install(), sorted by time.  The format stores the
+     * initial position of every node of the trace, then a fixed size record
+     * for every scheduled statement, in host byte order.  Statements which
+     * can not be parsed are dropped, as Install() would ignore them.
+     */
+    static bool ConvertToBinary(const std::string& input, const std::string& output);
+
   private:
     /**
      * \brief a class to hold input objects internally
@@ -137,7 +175,14 @@ class Ns2MobilityHelper
      */
     Ptr<ConstantVelocityMobilityModel> GetMobilityModel(std::string idString,
                                                         const ObjectStore& store) const;
+    /**
+     * Memory-map the trace and stream its movements to the waypoint
+     * mobility models of the objects in the store.
+     * \param store Object store containing ns-3 mobility models
+     */
+    void StreamNodesMovements(const ObjectStore& store) const;
     std::string m_filename; //!< filename of file containing ns-2 mobility trace
+    Time m_streamWindow;    //!< time window of the streamed trace, zero to read it at install
 };
 
 } // namespace ns3
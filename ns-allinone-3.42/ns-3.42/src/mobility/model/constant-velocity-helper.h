@@ -70,6 +70,12 @@ class ConstantVelocityHelper
      * \param vel Velocity vector
      */
     void SetVelocity(const Vector& vel);
+    /**
+     * Set new velocity vector
+     * \param vel Velocity vector
+     * \param now the time the velocity is set at, which must not be in the future
+     */
+    void SetVelocity(const Vector& vel, const Time& now);
     /**
      * Pause mobility at current position
      */
@@ -85,6 +91,13 @@ class ConstantVelocityHelper
      * the rectangle
      */
     void UpdateWithBounds(const Rectangle& rectangle) const;
+    /**
+     * Update position, if not paused, from last position and time of last update
+     * \param rectangle 2D bounding rectangle for resulting position; object will not move outside
+     * the rectangle
+     * \param now the time to update the position to, which must not be in the future
+     */
+    void UpdateWithBounds(const Rectangle& rectangle, const Time& now) const;
     /**
      * Update position, if not paused, from last position and time of last update
      * \param bounds 3D bounding box for resulting position; object will not move outside the box
@@ -94,6 +107,11 @@ class ConstantVelocityHelper
      * Update position, if not paused, from last position and time of last update
      */
     void Update() const;
+    /**
+     * Update position, if not paused, from last position and time of last update
+     * \param now the time to update the position to, which must not be in the future
+     */
+    void Update(const Time& now) const;
 
   private:
     mutable Time m_lastUpdate; //!< time of last update
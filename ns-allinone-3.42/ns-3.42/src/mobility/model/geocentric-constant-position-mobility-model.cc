@@ -47,18 +47,28 @@ GeocentricConstantPositionMobilityModel::GetTypeId()
                 "latitude, longitude and "
                 "altitude",
                 Vector3DValue({0, 0, 0}),
-                MakeVector3DAccessor(&GeocentricConstantPositionMobilityModel::m_position),
+                MakeVector3DAccessor(
+                    &GeocentricConstantPositionMobilityModel::SetGeographicPosition,
+                    &GeocentricConstantPositionMobilityModel::GetGeographicPosition),
                 MakeVector3DChecker())
             .AddAttribute("GeographicReferencePoint",
                           "The point, in meters, taken as reference when converting from "
                           "geographic to topographic.",
                           Vector3DValue({0, 0, 0}),
                           MakeVector3DAccessor(
-                              &GeocentricConstantPositionMobilityModel::m_geographicReferencePoint),
+                              &GeocentricConstantPositionMobilityModel::
+                                  SetCoordinateTranslationReferencePoint,
+                              &GeocentricConstantPositionMobilityModel::
+                                  GetCoordinateTranslationReferencePoint),
                           MakeVector3DChecker());
     return tid;
 }
 
+GeocentricConstantPositionMobilityModel::GeocentricConstantPositionMobilityModel()
+    : m_frame(m_geographicReferencePoint, GeographicPositions::SPHERE)
+{
+}
+
 Vector
 GeocentricConstantPositionMobilityModel::GetGeographicPosition() const
 {
@@ -125,21 +135,19 @@ GeocentricConstantPositionMobilityModel::GetDistanceFrom(
 Vector
 GeocentricConstantPositionMobilityModel::DoGetPosition() const
 {
-    Vector topographicCoordinates =
-        GeographicPositions::GeographicToTopocentricCoordinates(m_position,
-                                                                m_geographicReferencePoint,
-                                                                GeographicPositions::SPHERE);
-    return topographicCoordinates;
+    if (!m_topocentricPosition)
+    {
+        m_topocentricPosition = m_frame.GeographicToTopocentric(m_position);
+    }
+    return *m_topocentricPosition;
 }
 
 void
 GeocentricConstantPositionMobilityModel::DoSetPosition(const Vector& position)
 {
-    Vector geographicCoordinates =
-        GeographicPositions::TopocentricToGeographicCoordinates(position,
-                                                                m_geographicReferencePoint,
-                                                                GeographicPositions::SPHERE);
-    m_position = geographicCoordinates;
+    m_position = m_frame.TopocentricToGeographic(position);
+    m_geocentricPosition.reset();
+    m_topocentricPosition.reset();
     NotifyCourseChange();
 }
 
@@ -147,11 +155,7 @@ double
 GeocentricConstantPositionMobilityModel::DoGetDistanceFrom(
     Ptr<const GeocentricConstantPositionMobilityModel> other) const
 {
-    Vector cartesianCoordA =
-        GeographicPositions::GeographicToCartesianCoordinates(m_position.x,
-                                                              m_position.y,
-                                                              m_position.z,
-                                                              GeographicPositions::SPHERE);
+    Vector cartesianCoordA = DoGetGeocentricPosition();
     Vector cartesianCoordB = other->DoGetGeocentricPosition();
 
     double distance = (cartesianCoordA - cartesianCoordB).GetLength();
@@ -175,18 +179,23 @@ GeocentricConstantPositionMobilityModel::DoSetGeographicPosition(const Vector& l
     m_position = latLonAlt;
     // Normalize longitude to [-180, 180]
     m_position.y = WrapTo180(m_position.y);
+    m_geocentricPosition.reset();
+    m_topocentricPosition.reset();
     NotifyCourseChange();
 }
 
 Vector
 GeocentricConstantPositionMobilityModel::DoGetGeocentricPosition() const
 {
-    Vector geocentricCoordinates =
-        GeographicPositions::GeographicToCartesianCoordinates(m_position.x,
-                                                              m_position.y,
-                                                              m_position.z,
-                                                              GeographicPositions::SPHERE);
-    return geocentricCoordinates;
+    if (!m_geocentricPosition)
+    {
+        m_geocentricPosition =
+            GeographicPositions::GeographicToCartesianCoordinates(m_position.x,
+                                                                  m_position.y,
+                                                                  m_position.z,
+                                                                  GeographicPositions::SPHERE);
+    }
+    return *m_geocentricPosition;
 }
 
 void
@@ -196,6 +205,8 @@ GeocentricConstantPositionMobilityModel::DoSetGeocentricPosition(const Vector& p
         GeographicPositions::CartesianToGeographicCoordinates(position,
                                                               GeographicPositions::SPHERE);
     m_position = geographicCoordinates;
+    m_geocentricPosition.reset();
+    m_topocentricPosition.reset();
     NotifyCourseChange();
 }
 
@@ -230,6 +241,9 @@ GeocentricConstantPositionMobilityModel::DoSetCoordinateTranslationReferencePoin
     const Vector& refPoint)
 {
     m_geographicReferencePoint = refPoint;
+    m_frame = GeographicPositions::TopocentricFrame(refPoint, GeographicPositions::SPHERE);
+    m_topocentricPosition.reset();
+    InvalidatePositionCache();
 }
 
 Vector
@@ -22,6 +22,8 @@
 #include "geographic-positions.h"
 #include "mobility-model.h"
 
+#include <optional>
+
 /**
  * \file
  * \ingroup mobility
@@ -33,6 +35,11 @@ namespace ns3
 
 /**
  * \brief Mobility model using geocentric euclidean coordinates, as defined in 38.811 chapter 6.3
+ *
+ * As the node does not move, its geocentric and topocentric positions are
+ * converted once from its geographic position and cached until the position
+ * or the reference point is changed. The local tangent plane frame of the
+ * reference point is also built only when the reference point is set.
  */
 class GeocentricConstantPositionMobilityModel : public MobilityModel
 {
@@ -45,7 +52,7 @@ class GeocentricConstantPositionMobilityModel : public MobilityModel
     /**
      * Create a position located at coordinates (0,0,0)
      */
-    GeocentricConstantPositionMobilityModel() = default;
+    GeocentricConstantPositionMobilityModel();
     ~GeocentricConstantPositionMobilityModel() override = default;
 
     /**
@@ -155,6 +162,12 @@ class GeocentricConstantPositionMobilityModel : public MobilityModel
      * from geographic to topographic (also referred to as planar Cartesian)
      */
     Vector m_geographicReferencePoint{0, 0, 0};
+
+    /// Local tangent plane frame of m_geographicReferencePoint
+    GeographicPositions::TopocentricFrame m_frame;
+
+    mutable std::optional<Vector> m_geocentricPosition;  //!< cached geocentric position
+    mutable std::optional<Vector> m_topocentricPosition; //!< cached topocentric position
 };
 
 } // namespace ns3
@@ -43,47 +43,45 @@ namespace
  * \brief  Lambda function for computing the curvature
  */
 auto curvature = [](double e, double ph) { return sqrt(1 - e * e * sin(ph) * sin(ph)); };
-} // namespace
 
-namespace ns3
-{
-
-Vector
-GeographicPositions::GeographicToCartesianCoordinates(double latitude,
-                                                      double longitude,
-                                                      double altitude,
-                                                      EarthSpheroidType sphType)
+/**
+ * Converts geographic coordinates to Cartesian coordinates
+ * \param lla the geographic coordinates (latitude (deg), longitude (deg), altitude (m))
+ * \param a the radius, in meters
+ * \param e the first eccentricity
+ * \return the Cartesian (ECEF) coordinates, in meters
+ */
+ns3::Vector
+GeographicToCartesian(const ns3::Vector& lla, double a, double e)
 {
-    NS_LOG_FUNCTION_NOARGS();
-    double latitudeRadians = DegreesToRadians(latitude);
-    double longitudeRadians = DegreesToRadians(longitude);
-
-    // Retrieve radius, first eccentricity and flattening according to the specified Earth's model
-    auto [a, e, f] = GetRadiusEccentFlat(sphType);
+    double latitudeRadians = ns3::DegreesToRadians(lla.x);
+    double longitudeRadians = ns3::DegreesToRadians(lla.y);
+    double altitude = lla.z;
 
     double Rn = a / curvature(e, latitudeRadians); // radius of curvature
     double x = (Rn + altitude) * cos(latitudeRadians) * cos(longitudeRadians);
     double y = (Rn + altitude) * cos(latitudeRadians) * sin(longitudeRadians);
     double z = ((1 - e * e) * Rn + altitude) * sin(latitudeRadians);
-    Vector cartesianCoordinates = Vector(x, y, z);
-    return cartesianCoordinates;
+    return ns3::Vector(x, y, z);
 }
 
-Vector
-GeographicPositions::CartesianToGeographicCoordinates(Vector pos, EarthSpheroidType sphType)
+/**
+ * Converts Cartesian coordinates to geographic coordinates
+ * \param pos the Cartesian (ECEF) coordinates, in meters
+ * \param a the radius, in meters
+ * \param e the first eccentricity
+ * \return the geographic coordinates (latitude (deg), longitude (deg), altitude (m))
+ */
+ns3::Vector
+CartesianToGeographic(const ns3::Vector& pos, double a, double e)
 {
-    NS_LOG_FUNCTION(pos << sphType);
-
-    // Retrieve radius, first eccentricity and flattening according to the specified Earth's model
-    auto [a, e, f] = GetRadiusEccentFlat(sphType);
-
-    Vector lla;
-    Vector tmp;
+    ns3::Vector lla;
+    ns3::Vector tmp;
     lla.y = atan2(pos.y, pos.x); // longitude (rad), in +/- pi
 
     double e2 = e * e;
     // sqrt (pos.x^2 + pos.y^2)
-    double p = CalculateDistance(pos, {0, 0, pos.z});
+    double p = ns3::CalculateDistance(pos, {0, 0, pos.z});
     lla.x = atan2(pos.z, p * (1 - e2)); // init latitude (rad), in +/- pi
 
     do
@@ -95,10 +93,10 @@ GeographicPositions::CartesianToGeographicCoordinates(Vector pos, EarthSpheroidT
         lla.x = atan2(pos.z, p * (1 - e2 * N / v));
     }
     // 1 m difference is approx 1 / 30 arc seconds = 9.26e-6 deg
-    while (fabs(lla.x - tmp.x) > DegreesToRadians(0.00000926));
+    while (fabs(lla.x - tmp.x) > ns3::DegreesToRadians(0.00000926));
 
-    lla.x = RadiansToDegrees(lla.x);
-    lla.y = RadiansToDegrees(lla.y);
+    lla.x = ns3::RadiansToDegrees(lla.x);
+    lla.y = ns3::RadiansToDegrees(lla.y);
 
     // canonicalize (latitude) x in [-90, 90] and (longitude) y in [-180, 180)
     if (lla.x > 90.0)
@@ -125,83 +123,83 @@ GeographicPositions::CartesianToGeographicCoordinates(Vector pos, EarthSpheroidT
 
     return lla;
 }
+} // namespace
 
-Vector
-GeographicPositions::GeographicToTopocentricCoordinates(Vector pos,
-                                                        Vector refPoint,
-                                                        EarthSpheroidType sphType)
+namespace ns3
 {
-    NS_LOG_FUNCTION(pos << sphType);
 
-    double phi = DegreesToRadians(pos.x);
-    double lambda = DegreesToRadians(pos.y);
-    double h = pos.z;
-    double phi0 = DegreesToRadians(refPoint.x);
-    double lambda0 = DegreesToRadians(refPoint.y);
-    double h0 = refPoint.z;
+Vector
+GeographicPositions::GeographicToCartesianCoordinates(double latitude,
+                                                      double longitude,
+                                                      double altitude,
+                                                      EarthSpheroidType sphType)
+{
+    NS_LOG_FUNCTION_NOARGS();
     // Retrieve radius, first eccentricity and flattening according to the specified Earth's model
     auto [a, e, f] = GetRadiusEccentFlat(sphType);
 
-    // the radius of curvature in the prime vertical at latitude
-    double v = a / curvature(e, phi);
-    // the radius of curvature in the prime vertical at latitude
-    // of the reference point
-    double v0 = a / curvature(e, phi0);
-
-    double U = (v + h) * cos(phi) * sin(lambda - lambda0);
-    double V = (v + h) * (sin(phi) * cos(phi0) - cos(phi) * sin(phi0) * cos(lambda - lambda0)) +
-               e * e * (v0 * sin(phi0) - v * sin(phi)) * cos(phi0);
-    double W = (v + h) * (sin(phi) * sin(phi0) + cos(phi) * cos(phi0) * cos(lambda - lambda0)) +
-               e * e * (v0 * sin(phi0) - v * sin(phi)) * sin(phi0) - (v0 + h0);
-
-    Vector topocentricCoordinates = Vector(U, V, W);
-    return topocentricCoordinates;
+    return GeographicToCartesian(Vector(latitude, longitude, altitude), a, e);
 }
 
 Vector
-GeographicPositions::TopocentricToGeographicCoordinates(Vector pos,
-                                                        Vector refPoint,
-                                                        EarthSpheroidType sphType)
+GeographicPositions::CartesianToGeographicCoordinates(Vector pos, EarthSpheroidType sphType)
 {
     NS_LOG_FUNCTION(pos << sphType);
 
-    double U = pos.x;
-    double V = pos.y;
-    double W = pos.z;
-    double phi0 = DegreesToRadians(refPoint.x);
-    double lambda0 = DegreesToRadians(refPoint.y);
-    double h0 = refPoint.z;
     // Retrieve radius, first eccentricity and flattening according to the specified Earth's model
     auto [a, e, f] = GetRadiusEccentFlat(sphType);
 
-    // the radius of curvature in the prime vertical at latitude
-    // of the reference point
-    double v0 = a / curvature(e, phi0);
+    return CartesianToGeographic(pos, a, e);
+}
 
-    double X0 = (v0 + h0) * cos(phi0) * cos(lambda0);
-    double Y0 = (v0 + h0) * cos(phi0) * sin(lambda0);
-    double Z0 = ((1 - e * e) * v0 + h0) * sin(phi0);
+void
+GeographicPositions::GeographicToCartesianCoordinates(std::span<const Vector> latLonAlt,
+                                                      std::span<Vector> positions,
+                                                      EarthSpheroidType sphType)
+{
+    NS_LOG_FUNCTION(latLonAlt.size() << sphType);
+    NS_ASSERT_MSG(positions.size() >= latLonAlt.size(), "Output span too small");
 
-    double X = X0 - U * sin(lambda0) - V * sin(phi0) * cos(lambda0) + W * cos(phi0) * cos(lambda0);
-    double Y = Y0 + U * cos(lambda0) - V * sin(phi0) * sin(lambda0) + W * cos(phi0) * sin(lambda0);
-    double Z = Z0 + V * cos(phi0) + W * sin(phi0);
+    auto [a, e, f] = GetRadiusEccentFlat(sphType);
+    for (size_t i = 0; i < latLonAlt.size(); i++)
+    {
+        positions[i] = GeographicToCartesian(latLonAlt[i], a, e);
+    }
+}
 
-    double epsilon = e * e / (1 - e * e);
-    double b = a * (1 - f);
-    double p = sqrt(X * X + Y * Y);
-    double q = atan2((Z * a), (p * b));
+void
+GeographicPositions::CartesianToGeographicCoordinates(std::span<const Vector> positions,
+                                                      std::span<Vector> latLonAlt,
+                                                      EarthSpheroidType sphType)
+{
+    NS_LOG_FUNCTION(positions.size() << sphType);
+    NS_ASSERT_MSG(latLonAlt.size() >= positions.size(), "Output span too small");
 
-    double phi = atan2((Z + epsilon * b * pow(sin(q), 3)), (p - e * e * a * pow(cos(q), 3)));
-    double lambda = atan2(Y, X);
+    auto [a, e, f] = GetRadiusEccentFlat(sphType);
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        latLonAlt[i] = CartesianToGeographic(positions[i], a, e);
+    }
+}
 
-    double v = a / curvature(e, phi);
-    double h = (p / cos(phi)) - v;
+Vector
+GeographicPositions::GeographicToTopocentricCoordinates(Vector pos,
+                                                        Vector refPoint,
+                                                        EarthSpheroidType sphType)
+{
+    NS_LOG_FUNCTION(pos << sphType);
 
-    phi = RadiansToDegrees(phi);
-    lambda = RadiansToDegrees(lambda);
+    return TopocentricFrame(refPoint, sphType).GeographicToTopocentric(pos);
+}
 
-    Vector geographicCoordinates = Vector(phi, lambda, h);
-    return geographicCoordinates;
+Vector
+GeographicPositions::TopocentricToGeographicCoordinates(Vector pos,
+                                                        Vector refPoint,
+                                                        EarthSpheroidType sphType)
+{
+    NS_LOG_FUNCTION(pos << sphType);
+
+    return TopocentricFrame(refPoint, sphType).TopocentricToGeographic(pos);
 }
 
 std::list<Vector>
@@ -326,4 +324,133 @@ GeographicPositions::GetRadiusEccentFlat(EarthSpheroidType type)
     return std::make_tuple(a, e, f);
 }
 
+GeographicPositions::TopocentricFrame::TopocentricFrame(const Vector& refPoint,
+                                                        EarthSpheroidType sphType)
+    : m_refPoint(refPoint)
+{
+    NS_LOG_FUNCTION(refPoint << sphType);
+
+    // Retrieve radius, first eccentricity and flattening according to the specified Earth's model
+    std::tie(m_a, m_e, m_f) = GetRadiusEccentFlat(sphType);
+
+    m_phi0 = DegreesToRadians(refPoint.x);
+    m_lambda0 = DegreesToRadians(refPoint.y);
+    m_sinPhi0 = sin(m_phi0);
+    m_cosPhi0 = cos(m_phi0);
+    m_sinLambda0 = sin(m_lambda0);
+    m_cosLambda0 = cos(m_lambda0);
+
+    // the radius of curvature in the prime vertical at latitude
+    // of the reference point
+    m_v0 = m_a / curvature(m_e, m_phi0);
+
+    double h0 = refPoint.z;
+    m_origin = Vector((m_v0 + h0) * m_cosPhi0 * m_cosLambda0,
+                      (m_v0 + h0) * m_cosPhi0 * m_sinLambda0,
+                      ((1 - m_e * m_e) * m_v0 + h0) * m_sinPhi0);
+}
+
+Vector
+GeographicPositions::TopocentricFrame::GetReferencePoint() const
+{
+    return m_refPoint;
+}
+
+Vector
+GeographicPositions::TopocentricFrame::GeographicToTopocentric(const Vector& pos) const
+{
+    double phi = DegreesToRadians(pos.x);
+    double lambda = DegreesToRadians(pos.y);
+    double h = pos.z;
+    double h0 = m_refPoint.z;
+    double sinPhi = sin(phi);
+    double cosPhi = cos(phi);
+    double cosDeltaLambda = cos(lambda - m_lambda0);
+
+    // the radius of curvature in the prime vertical at latitude
+    double v = m_a / curvature(m_e, phi);
+
+    double U = (v + h) * cosPhi * sin(lambda - m_lambda0);
+    double V = (v + h) * (sinPhi * m_cosPhi0 - cosPhi * m_sinPhi0 * cosDeltaLambda) +
+               m_e * m_e * (m_v0 * m_sinPhi0 - v * sinPhi) * m_cosPhi0;
+    double W = (v + h) * (sinPhi * m_sinPhi0 + cosPhi * m_cosPhi0 * cosDeltaLambda) +
+               m_e * m_e * (m_v0 * m_sinPhi0 - v * sinPhi) * m_sinPhi0 - (m_v0 + h0);
+
+    return Vector(U, V, W);
+}
+
+Vector
+GeographicPositions::TopocentricFrame::TopocentricToGeographic(const Vector& pos) const
+{
+    Vector cartesian = TopocentricToCartesian(pos);
+    double X = cartesian.x;
+    double Y = cartesian.y;
+    double Z = cartesian.z;
+
+    double e2 = m_e * m_e;
+    double epsilon = e2 / (1 - e2);
+    double b = m_a * (1 - m_f);
+    double p = sqrt(X * X + Y * Y);
+    double q = atan2((Z * m_a), (p * b));
+
+    double phi = atan2((Z + epsilon * b * pow(sin(q), 3)), (p - e2 * m_a * pow(cos(q), 3)));
+    double lambda = atan2(Y, X);
+
+    double v = m_a / curvature(m_e, phi);
+    double h = (p / cos(phi)) - v;
+
+    return Vector(RadiansToDegrees(phi), RadiansToDegrees(lambda), h);
+}
+
+Vector
+GeographicPositions::TopocentricFrame::CartesianToTopocentric(const Vector& pos) const
+{
+    double dX = pos.x - m_origin.x;
+    double dY = pos.y - m_origin.y;
+    double dZ = pos.z - m_origin.z;
+
+    // inverse (transpose) of the rotation in TopocentricToCartesian
+    double U = -m_sinLambda0 * dX + m_cosLambda0 * dY;
+    double V = -m_sinPhi0 * m_cosLambda0 * dX - m_sinPhi0 * m_sinLambda0 * dY + m_cosPhi0 * dZ;
+    double W = m_cosPhi0 * m_cosLambda0 * dX + m_cosPhi0 * m_sinLambda0 * dY + m_sinPhi0 * dZ;
+    return Vector(U, V, W);
+}
+
+Vector
+GeographicPositions::TopocentricFrame::TopocentricToCartesian(const Vector& pos) const
+{
+    double U = pos.x;
+    double V = pos.y;
+    double W = pos.z;
+
+    double X = m_origin.x - U * m_sinLambda0 - V * m_sinPhi0 * m_cosLambda0 +
+               W * m_cosPhi0 * m_cosLambda0;
+    double Y = m_origin.y + U * m_cosLambda0 - V * m_sinPhi0 * m_sinLambda0 +
+               W * m_cosPhi0 * m_sinLambda0;
+    double Z = m_origin.z + V * m_cosPhi0 + W * m_sinPhi0;
+    return Vector(X, Y, Z);
+}
+
+void
+GeographicPositions::TopocentricFrame::GeographicToTopocentric(std::span<const Vector> latLonAlt,
+                                                               std::span<Vector> positions) const
+{
+    NS_ASSERT_MSG(positions.size() >= latLonAlt.size(), "Output span too small");
+    for (size_t i = 0; i < latLonAlt.size(); i++)
+    {
+        positions[i] = GeographicToTopocentric(latLonAlt[i]);
+    }
+}
+
+void
+GeographicPositions::TopocentricFrame::CartesianToTopocentric(std::span<const Vector> cartesian,
+                                                              std::span<Vector> positions) const
+{
+    NS_ASSERT_MSG(positions.size() >= cartesian.size(), "Output span too small");
+    for (size_t i = 0; i < cartesian.size(); i++)
+    {
+        positions[i] = CartesianToTopocentric(cartesian[i]);
+    }
+}
+
 } // namespace ns3
@@ -20,6 +20,8 @@
 #include <ns3/random-variable-stream.h>
 #include <ns3/vector.h>
 
+#include <span>
+
 #ifndef GEOGRAPHIC_POSITIONS_H
 #define GEOGRAPHIC_POSITIONS_H
 
@@ -122,6 +124,31 @@ class GeographicPositions
      */
     static Vector CartesianToGeographicCoordinates(Vector pos, EarthSpheroidType sphType);
 
+    /**
+     * Converts several points with GeographicToCartesianCoordinates, looking
+     * up the spheroid parameters only once.
+     * @param latLonAlt the geographic coordinates (latitude (deg), longitude (deg),
+     * altitude (m)) of the points
+     * @param [out] positions the Cartesian (ECEF) coordinates of the points, in
+     * meters; must be as large as latLonAlt
+     * @param sphType earth spheroid model to use for conversion
+     */
+    static void GeographicToCartesianCoordinates(std::span<const Vector> latLonAlt,
+                                                 std::span<Vector> positions,
+                                                 EarthSpheroidType sphType);
+
+    /**
+     * Converts several points with CartesianToGeographicCoordinates, looking
+     * up the spheroid parameters only once.
+     * @param positions the Cartesian (ECEF) coordinates of the points, in meters
+     * @param [out] latLonAlt the geographic coordinates (latitude (deg), longitude
+     * (deg), altitude (m)) of the points; must be as large as positions
+     * @param sphType earth spheroid model to use for conversion
+     */
+    static void CartesianToGeographicCoordinates(std::span<const Vector> positions,
+                                                 std::span<Vector> latLonAlt,
+                                                 EarthSpheroidType sphType);
+
     /**
      * Conversion from geographic to topocentric coordinates.
      *
@@ -205,6 +232,91 @@ class GeographicPositions
      * @return the corresponding radius (in meters), first eccentricity and first flattening values
      */
     static std::tuple<double, double, double> GetRadiusEccentFlat(EarthSpheroidType type);
+
+    /**
+     * Local tangent plane frame (East, North, Up) at a reference point.
+     *
+     * The trigonometric terms, the radius of curvature and the Cartesian (ECEF)
+     * coordinates of the reference point are computed once, when the frame is
+     * built, instead of at each conversion. GeographicToTopocentric and
+     * TopocentricToGeographic give the same results as
+     * GeographicToTopocentricCoordinates and TopocentricToGeographicCoordinates
+     * for the same reference point; the conversions from and to Cartesian
+     * coordinates are a translation and a rotation, without trigonometry.
+     */
+    class TopocentricFrame
+    {
+      public:
+        /**
+         * @param refPoint the reference point (latitude (deg), longitude (deg),
+         * altitude (m))
+         * @param sphType earth spheroid model to use for conversion
+         */
+        TopocentricFrame(const Vector& refPoint, EarthSpheroidType sphType);
+
+        /**
+         * @return the reference point (latitude (deg), longitude (deg), altitude (m))
+         */
+        Vector GetReferencePoint() const;
+
+        /**
+         * @param pos the geographic coordinates (latitude (deg), longitude (deg),
+         * altitude (m)) of a point
+         * @return the topocentric coordinates (U, V, W) of the point, in meters
+         */
+        Vector GeographicToTopocentric(const Vector& pos) const;
+
+        /**
+         * @param pos the topocentric coordinates (U, V, W) of a point, in meters
+         * @return the geographic coordinates (latitude (deg), longitude (deg),
+         * altitude (m)) of the point
+         */
+        Vector TopocentricToGeographic(const Vector& pos) const;
+
+        /**
+         * @param pos the Cartesian (ECEF) coordinates of a point, in meters
+         * @return the topocentric coordinates (U, V, W) of the point, in meters
+         */
+        Vector CartesianToTopocentric(const Vector& pos) const;
+
+        /**
+         * @param pos the topocentric coordinates (U, V, W) of a point, in meters
+         * @return the Cartesian (ECEF) coordinates of the point, in meters
+         */
+        Vector TopocentricToCartesian(const Vector& pos) const;
+
+        /**
+         * Converts several points with GeographicToTopocentric.
+         * @param latLonAlt the geographic coordinates of the points
+         * @param [out] positions the topocentric coordinates of the points; must be
+         * as large as latLonAlt
+         */
+        void GeographicToTopocentric(std::span<const Vector> latLonAlt,
+                                     std::span<Vector> positions) const;
+
+        /**
+         * Converts several points with CartesianToTopocentric.
+         * @param cartesian the Cartesian (ECEF) coordinates of the points
+         * @param [out] positions the topocentric coordinates of the points; must be
+         * as large as cartesian
+         */
+        void CartesianToTopocentric(std::span<const Vector> cartesian,
+                                    std::span<Vector> positions) const;
+
+      private:
+        Vector m_refPoint;   //!< reference point (latitude (deg), longitude (deg), altitude (m))
+        double m_a;          //!< semi-major axis, in meters
+        double m_e;          //!< first eccentricity
+        double m_f;          //!< first flattening
+        double m_phi0;       //!< latitude of the reference point, in radians
+        double m_lambda0;    //!< longitude of the reference point, in radians
+        double m_sinPhi0;    //!< sine of the latitude of the reference point
+        double m_cosPhi0;    //!< cosine of the latitude of the reference point
+        double m_sinLambda0; //!< sine of the longitude of the reference point
+        double m_cosLambda0; //!< cosine of the longitude of the reference point
+        double m_v0;         //!< radius of curvature in the prime vertical at the reference point
+        Vector m_origin;     //!< Cartesian (ECEF) coordinates of the reference point
+    };
 };
 
 } // namespace ns3
@@ -74,6 +74,7 @@ HierarchicalMobilityModel::SetChild(Ptr<MobilityModel> model)
             MakeCallback(&HierarchicalMobilityModel::ChildChanged, this));
     }
     m_child = model;
+    InvalidatePositionCache();
     m_child->TraceConnectWithoutContext(
         "CourseChange",
         MakeCallback(&HierarchicalMobilityModel::ChildChanged, this));
@@ -104,6 +105,7 @@ HierarchicalMobilityModel::SetParent(Ptr<MobilityModel> model)
             MakeCallback(&HierarchicalMobilityModel::ParentChanged, this));
     }
     m_parent = model;
+    InvalidatePositionCache();
     if (m_parent)
     {
         m_parent->TraceConnectWithoutContext(
@@ -137,13 +139,43 @@ HierarchicalMobilityModel::DoGetPosition() const
     {
         return m_child->GetPosition();
     }
-    Vector parentPosition = m_parent->GetPosition();
+    return ComposePosition(m_parent->GetPosition());
+}
+
+Vector
+HierarchicalMobilityModel::ComposePosition(const Vector& parentPosition) const
+{
     Vector childPosition = m_child->GetPositionWithReference(parentPosition);
     return Vector(parentPosition.x + childPosition.x,
                   parentPosition.y + childPosition.y,
                   parentPosition.z + childPosition.z);
 }
 
+std::vector<Vector>
+HierarchicalMobilityModel::GetPositions(const std::vector<Ptr<HierarchicalMobilityModel>>& models)
+{
+    std::vector<Vector> positions;
+    positions.reserve(models.size());
+    Ptr<MobilityModel> parent;
+    Vector parentPosition;
+    for (const auto& model : models)
+    {
+        if (model->IsPositionCached() || !model->m_parent)
+        {
+            positions.push_back(model->GetPosition());
+            continue;
+        }
+        if (model->m_parent != parent)
+        {
+            parent = model->m_parent;
+            parentPosition = parent->GetPosition();
+        }
+        positions.push_back(model->ComposePosition(parentPosition));
+        model->CachePosition(positions.back());
+    }
+    return positions;
+}
+
 void
 HierarchicalMobilityModel::DoSetPosition(const Vector& position)
 {
@@ -21,6 +21,8 @@
 
 #include "mobility-model.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -50,6 +52,11 @@ namespace ns3
  * the parent model to NULL makes the child model and the hierarchical
  * model start using world absolute coordinates.
  *
+ * Since the parent position is cached per simulation time, querying the
+ * positions of many models which share a parent, such as the members of
+ * a GroupMobilityHelper group, evaluates the parent once per time.
+ * GetPositions() gets the positions of such models all at once.
+ *
  * \warning: changing the parent/child mobility models in the middle
  * of a simulation will probably not play very well with the
  * ConfigStore APIs, so do this only if you know what you are doing.
@@ -99,6 +106,18 @@ class HierarchicalMobilityModel : public MobilityModel
      */
     void SetParent(Ptr<MobilityModel> model);
 
+    /**
+     * Get the positions of several hierarchical models at the current
+     * simulation time.  The position of a parent shared by consecutive
+     * models is queried once for all of them, and the position of each
+     * model is then the sum of that position and of its child position.
+     * The positions are also cached by the models, as GetPosition() would.
+     * \param models the hierarchical models
+     * \return the positions of the models, in the same order
+     */
+    static std::vector<Vector> GetPositions(
+        const std::vector<Ptr<HierarchicalMobilityModel>>& models);
+
   private:
     Vector DoGetPosition() const override;
     void DoSetPosition(const Vector& position) override;
@@ -116,6 +135,11 @@ class HierarchicalMobilityModel : public MobilityModel
      * \param model mobility mode (unused)
      */
     void ChildChanged(Ptr<const MobilityModel> model);
+    /**
+     * \param parentPosition the current position of the parent
+     * \return the current position of this model
+     */
+    Vector ComposePosition(const Vector& parentPosition) const;
 
     Ptr<MobilityModel> m_child;  //!< pointer to child mobility model
     Ptr<MobilityModel> m_parent; //!< pointer to parent mobility model
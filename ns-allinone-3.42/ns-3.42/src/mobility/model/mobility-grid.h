@@ -0,0 +1,470 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOBILITY_GRID_H
+#define MOBILITY_GRID_H
+
+#include "mobility-model.h"
+
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+#include "ns3/log.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Uniform grid over the positions of a set of objects, such as the
+ * PHYs attached to a channel
+ *
+ * The grid lets a channel visit only the receivers that are within a given
+ * range of the transmitter, instead of computing the propagation loss
+ * towards every attached PHY. The cell size equals the range being
+ * queried, so a query only looks at the 3x3 cells around the transmitter.
+ *
+ * The grid is built on the first query and then kept up to date lazily:
+ * the CourseChange trace of each mobility model only marks its objects as
+ * dirty, and they are moved to their new cell on the next query. Objects
+ * that are moving (non-zero velocity) are not stored in a cell, since
+ * their position changes without a course change; they are checked on
+ * every query, as are objects that do not have a mobility model yet.
+ *
+ * Queries return the objects in the order in which they were added, so
+ * that a channel using the grid schedules the receptions in the same order
+ * as one iterating over all of its PHYs.
+ *
+ * \tparam T the type of the objects, which must provide a
+ *           Ptr<MobilityModel> GetMobility() const method
+ */
+template <typename T>
+class MobilityGrid : public SimpleRefCount<MobilityGrid<T>>
+{
+  public:
+    MobilityGrid();
+    ~MobilityGrid();
+
+    // Delete copy constructor and assignment operator: the CourseChange
+    // callbacks are bound to this instance
+    MobilityGrid(const MobilityGrid&) = delete;
+    MobilityGrid& operator=(const MobilityGrid&) = delete;
+
+    /**
+     * Add an object to the grid; adding an object already in the grid has
+     * no effect.
+     *
+     * \param object the object to add
+     */
+    void Add(Ptr<T> object);
+
+    /**
+     * Remove an object from the grid; removing an object not in the grid
+     * has no effect.
+     *
+     * \param object the object to remove
+     */
+    void Remove(Ptr<T> object);
+
+    /**
+     * Remove all the objects and disconnect from their mobility models.
+     */
+    void Clear();
+
+    /**
+     * Get the objects within the given range of a position. Objects without
+     * a mobility model are always returned.
+     *
+     * \param position the position of the transmitter
+     * \param range the range, in meters; must be strictly positive
+     * \return the objects in range, in the order in which they were added
+     */
+    std::vector<Ptr<T>> GetInRange(const Vector& position, double range);
+
+  private:
+    /// Cell coordinates along the x and y axes
+    using CellKey = std::pair<int64_t, int64_t>;
+
+    /// Hash functor for CellKey
+    struct CellKeyHash
+    {
+        /**
+         * \param key the cell coordinates
+         * \return the hash of the coordinates
+         */
+        std::size_t operator()(const CellKey& key) const
+        {
+            std::size_t h = std::hash<int64_t>()(key.first);
+            return h ^ (std::hash<int64_t>()(key.second) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+                        (h >> 2));
+        }
+    };
+
+    /// Location of an object in the grid
+    struct Entry
+    {
+        uint64_t seq;                //!< order in which the object was added
+        Ptr<MobilityModel> mobility; //!< mobility model, if already known
+        bool placed{false};          //!< whether the object is in m_cells or m_uncelled
+        bool inCell{false};          //!< whether the object is in m_cells
+        CellKey cell{0, 0};          //!< the cell, if inCell is true
+        bool dirty{true};            //!< whether the object is in m_dirty
+    };
+
+    /**
+     * Drop all cells and place every object again, with a new cell size.
+     *
+     * \param cellSize the new cell size, in meters
+     */
+    void Rebuild(double cellSize);
+
+    /**
+     * Place the dirty objects in their cell or in m_uncelled.
+     */
+    void Refresh();
+
+    /**
+     * Remove an object from its cell or from m_uncelled.
+     *
+     * \param object the object
+     * \param entry the entry of the object
+     */
+    void Unplace(Ptr<T> object, Entry& entry);
+
+    /**
+     * \param position a position
+     * \return the cell holding that position
+     */
+    CellKey GetCell(const Vector& position) const;
+
+    /**
+     * Mark the objects using a mobility model as dirty.
+     *
+     * \param mobility the mobility model whose course changed
+     */
+    void NotifyCourseChange(Ptr<const MobilityModel> mobility);
+
+    /**
+     * Disconnect from the CourseChange trace of a mobility model if no
+     * object in the grid uses it anymore.
+     *
+     * \param mobility the mobility model
+     */
+    void ReleaseMobility(Ptr<MobilityModel> mobility);
+
+    /**
+     * Mark an object as dirty, so that it is placed again on the next query.
+     *
+     * \param object the object
+     * \param entry the entry of the object
+     */
+    void MarkDirty(Ptr<T> object, Entry& entry);
+
+    std::unordered_map<Ptr<T>, Entry> m_entries; //!< all the objects in the grid
+    /// Objects stored in each cell
+    std::unordered_map<CellKey, std::vector<Ptr<T>>, CellKeyHash> m_cells;
+    /// Objects that are moving or have no mobility model, checked on every query
+    std::vector<Ptr<T>> m_uncelled;
+    /// Objects of each mobility model the grid is connected to
+    std::unordered_map<Ptr<MobilityModel>, std::vector<Ptr<T>>> m_mobilityObjects;
+    std::vector<Ptr<T>> m_dirty; //!< objects to place on the next query
+    uint64_t m_nextSeq{0};       //!< sequence number of the next object added
+    double m_cellSize{0};        //!< cell size, in meters; 0 if not built yet
+    NS_LOG_TEMPLATE_DECLARE;     //!< the log component
+};
+
+/**
+ * Implementation of the templates declared above.
+ */
+
+template <typename T>
+MobilityGrid<T>::MobilityGrid()
+    : NS_LOG_TEMPLATE_DEFINE("MobilityGrid")
+{
+    NS_LOG_FUNCTION(this);
+}
+
+template <typename T>
+MobilityGrid<T>::~MobilityGrid()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+template <typename T>
+void
+MobilityGrid<T>::Add(Ptr<T> object)
+{
+    NS_LOG_FUNCTION(this << object);
+    auto [it, inserted] = m_entries.emplace(object, Entry{m_nextSeq});
+    if (inserted)
+    {
+        ++m_nextSeq;
+        m_dirty.push_back(object);
+    }
+}
+
+template <typename T>
+void
+MobilityGrid<T>::Remove(Ptr<T> object)
+{
+    NS_LOG_FUNCTION(this << object);
+    auto it = m_entries.find(object);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+    Entry& entry = it->second;
+    Unplace(object, entry);
+    if (entry.dirty)
+    {
+        m_dirty.erase(std::find(m_dirty.begin(), m_dirty.end(), object));
+    }
+    if (entry.mobility)
+    {
+        auto& objects = m_mobilityObjects[entry.mobility];
+        objects.erase(std::find(objects.begin(), objects.end(), object));
+        ReleaseMobility(entry.mobility);
+    }
+    m_entries.erase(it);
+}
+
+template <typename T>
+void
+MobilityGrid<T>::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [mobility, objects] : m_mobilityObjects)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGrid<T>::NotifyCourseChange, this));
+    }
+    m_mobilityObjects.clear();
+    m_entries.clear();
+    m_cells.clear();
+    m_uncelled.clear();
+    m_dirty.clear();
+    m_cellSize = 0;
+}
+
+template <typename T>
+std::vector<Ptr<T>>
+MobilityGrid<T>::GetInRange(const Vector& position, double range)
+{
+    NS_LOG_FUNCTION(this << position << range);
+    NS_ASSERT_MSG(range > 0, "The range must be strictly positive");
+    if (range != m_cellSize)
+    {
+        Rebuild(range);
+    }
+    else
+    {
+        Refresh();
+    }
+
+    std::vector<std::pair<uint64_t, Ptr<T>>> inRange;
+    auto addIfInRange = [&](const Ptr<T>& object) {
+        const Entry& entry = m_entries.at(object);
+        if (!entry.mobility || CalculateDistance(position, entry.mobility->GetPosition()) <= range)
+        {
+            inRange.emplace_back(entry.seq, object);
+        }
+    };
+
+    // with cells as large as the range, any object in range is in one of
+    // the 3x3 cells around the transmitter
+    CellKey center = GetCell(position);
+    for (int64_t dx = -1; dx <= 1; ++dx)
+    {
+        for (int64_t dy = -1; dy <= 1; ++dy)
+        {
+            auto cellIt = m_cells.find({center.first + dx, center.second + dy});
+            if (cellIt != m_cells.end())
+            {
+                std::for_each(cellIt->second.begin(), cellIt->second.end(), addIfInRange);
+            }
+        }
+    }
+    std::for_each(m_uncelled.begin(), m_uncelled.end(), addIfInRange);
+
+    std::sort(inRange.begin(), inRange.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    std::vector<Ptr<T>> objects;
+    objects.reserve(inRange.size());
+    for (auto& [seq, object] : inRange)
+    {
+        objects.push_back(object);
+    }
+    NS_LOG_LOGIC(objects.size() << " of " << m_entries.size() << " objects in range");
+    return objects;
+}
+
+template <typename T>
+void
+MobilityGrid<T>::Rebuild(double cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    m_cellSize = cellSize;
+    m_cells.clear();
+    m_uncelled.clear();
+    m_dirty.clear();
+    for (auto& [object, entry] : m_entries)
+    {
+        entry.placed = false;
+        entry.inCell = false;
+        entry.dirty = true;
+        m_dirty.push_back(object);
+    }
+    Refresh();
+}
+
+template <typename T>
+void
+MobilityGrid<T>::Refresh()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Ptr<T>> dirty;
+    dirty.swap(m_dirty);
+    for (auto& object : dirty)
+    {
+        Entry& entry = m_entries.at(object);
+        Unplace(object, entry);
+        entry.dirty = false;
+        entry.placed = true;
+
+        if (!entry.mobility)
+        {
+            entry.mobility = object->GetMobility();
+            if (!entry.mobility)
+            {
+                // the mobility model may be aggregated later on: try again
+                // on the next query
+                m_uncelled.push_back(object);
+                MarkDirty(object, entry);
+                continue;
+            }
+            auto& objects = m_mobilityObjects[entry.mobility];
+            if (objects.empty())
+            {
+                entry.mobility->TraceConnectWithoutContext(
+                    "CourseChange",
+                    MakeCallback(&MobilityGrid<T>::NotifyCourseChange, this));
+            }
+            objects.push_back(object);
+        }
+
+        if (entry.mobility->GetVelocity().GetLength() > 0)
+        {
+            m_uncelled.push_back(object);
+        }
+        else
+        {
+            entry.inCell = true;
+            entry.cell = GetCell(entry.mobility->GetPosition());
+            m_cells[entry.cell].push_back(object);
+        }
+    }
+}
+
+template <typename T>
+void
+MobilityGrid<T>::Unplace(Ptr<T> object, Entry& entry)
+{
+    if (!entry.placed)
+    {
+        return;
+    }
+    if (entry.inCell)
+    {
+        auto cellIt = m_cells.find(entry.cell);
+        NS_ASSERT(cellIt != m_cells.end());
+        cellIt->second.erase(std::find(cellIt->second.begin(), cellIt->second.end(), object));
+        if (cellIt->second.empty())
+        {
+            m_cells.erase(cellIt);
+        }
+    }
+    else
+    {
+        m_uncelled.erase(std::find(m_uncelled.begin(), m_uncelled.end(), object));
+    }
+    entry.placed = false;
+    entry.inCell = false;
+}
+
+template <typename T>
+typename MobilityGrid<T>::CellKey
+MobilityGrid<T>::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_cellSize)),
+            static_cast<int64_t>(std::floor(position.y / m_cellSize))};
+}
+
+template <typename T>
+void
+MobilityGrid<T>::NotifyCourseChange(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_mobilityObjects.find(ConstCast<MobilityModel>(mobility));
+    if (it == m_mobilityObjects.end())
+    {
+        return;
+    }
+    for (auto& object : it->second)
+    {
+        MarkDirty(object, m_entries.at(object));
+    }
+}
+
+template <typename T>
+void
+MobilityGrid<T>::ReleaseMobility(Ptr<MobilityModel> mobility)
+{
+    auto it = m_mobilityObjects.find(mobility);
+    if (it != m_mobilityObjects.end() && it->second.empty())
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MobilityGrid<T>::NotifyCourseChange, this));
+        m_mobilityObjects.erase(it);
+    }
+}
+
+template <typename T>
+void
+MobilityGrid<T>::MarkDirty(Ptr<T> object, Entry& entry)
+{
+    if (!entry.dirty)
+    {
+        entry.dirty = true;
+        m_dirty.push_back(object);
+    }
+}
+
+} // namespace ns3
+
+#endif /* MOBILITY_GRID_H */
@@ -19,6 +19,7 @@
 
 #include "mobility-model.h"
 
+#include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
 #include <cmath>
@@ -66,7 +67,14 @@ MobilityModel::~MobilityModel()
 Vector
 MobilityModel::GetPosition() const
 {
-    return DoGetPosition();
+    Time now = Simulator::Now();
+    if (!m_cachedPositionValid || m_cachedPositionTime != now)
+    {
+        m_cachedPosition = DoGetPosition();
+        m_cachedPositionTime = now;
+        m_cachedPositionValid = true;
+    }
+    return m_cachedPosition;
 }
 
 Vector
@@ -92,13 +100,14 @@ void
 MobilityModel::SetPosition(const Vector& position)
 {
     DoSetPosition(position);
+    m_cachedPositionValid = false;
 }
 
 double
 MobilityModel::GetDistanceFrom(Ptr<const MobilityModel> other) const
 {
-    Vector oPosition = other->DoGetPosition();
-    Vector position = DoGetPosition();
+    Vector oPosition = other->GetPosition();
+    Vector position = GetPosition();
     return CalculateDistance(position, oPosition);
 }
 
@@ -111,9 +120,30 @@ MobilityModel::GetRelativeSpeed(Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange() const
 {
+    m_cachedPositionValid = false;
     m_courseChangeTrace(this);
 }
 
+void
+MobilityModel::InvalidatePositionCache() const
+{
+    m_cachedPositionValid = false;
+}
+
+bool
+MobilityModel::IsPositionCached() const
+{
+    return m_cachedPositionValid && m_cachedPositionTime == Simulator::Now();
+}
+
+void
+MobilityModel::CachePosition(const Vector& position) const
+{
+    m_cachedPosition = position;
+    m_cachedPositionTime = Simulator::Now();
+    m_cachedPositionValid = true;
+}
+
 int64_t
 MobilityModel::AssignStreams(int64_t start)
 {
@@ -19,6 +19,7 @@
 #ifndef MOBILITY_MODEL_H
 #define MOBILITY_MODEL_H
 
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/traced-callback.h"
 #include "ns3/vector.h"
@@ -35,6 +36,13 @@ namespace ns3
  * metric international units.
  *
  * This is a base class for all specific mobility models.
+ *
+ * GetPosition caches the position computed by the subclass together with
+ * the simulation time it was computed at, so that the model is evaluated at
+ * most once per time instant however many times its position is queried.
+ * The cache is cleared by SetPosition and NotifyCourseChange; subclasses
+ * whose position may change at the current time without either of them
+ * being called must call InvalidatePositionCache.
  */
 class MobilityModel : public Object
 {
@@ -49,6 +57,8 @@ class MobilityModel : public Object
 
     /**
      * \return the current position
+     *
+     * The position is only computed by the subclass once per simulation time.
      */
     Vector GetPosition() const;
     /**
@@ -104,6 +114,21 @@ class MobilityModel : public Object
      * position changes to notify course change listeners.
      */
     void NotifyCourseChange() const;
+    /**
+     * Must be invoked by subclasses when the position at the current
+     * simulation time changes without a course change being notified.
+     */
+    void InvalidatePositionCache() const;
+    /**
+     * \return true if the position at the current simulation time is cached
+     */
+    bool IsPositionCached() const;
+    /**
+     * May be invoked by subclasses which compute their position at the
+     * current simulation time by other means than DoGetPosition.
+     * \param position the position at the current simulation time
+     */
+    void CachePosition(const Vector& position) const;
 
   private:
     /**
@@ -149,6 +174,10 @@ class MobilityModel : public Object
      * or position has occurred.
      */
     ns3::TracedCallback<Ptr<const MobilityModel>> m_courseChangeTrace;
+
+    mutable Vector m_cachedPosition;           //!< The position last computed by DoGetPosition
+    mutable Time m_cachedPositionTime;         //!< The simulation time m_cachedPosition refers to
+    mutable bool m_cachedPositionValid{false}; //!< Whether m_cachedPosition can be returned
 };
 
 } // namespace ns3
@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "mobility-step-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MobilityStepHelper");
+
+void
+MobilityStepHelper::SetLazy(bool lazy)
+{
+    NS_LOG_FUNCTION(this << lazy);
+    m_lazy = lazy;
+}
+
+bool
+MobilityStepHelper::IsLazy() const
+{
+    return m_lazy;
+}
+
+Time
+MobilityStepHelper::GetNow() const
+{
+    return m_running ? m_runningTime : Simulator::Now();
+}
+
+void
+MobilityStepHelper::Schedule(const Time& delay, Step step)
+{
+    NS_LOG_FUNCTION(this << delay);
+    m_event.Cancel();
+    if (m_lazy)
+    {
+        m_step = std::move(step);
+        m_stepTime = GetNow() + delay;
+    }
+    else
+    {
+        m_step = nullptr;
+        m_event = Simulator::Schedule(delay, std::move(step));
+    }
+}
+
+void
+MobilityStepHelper::Cancel()
+{
+    NS_LOG_FUNCTION(this);
+    m_event.Cancel();
+    m_step = nullptr;
+}
+
+bool
+MobilityStepHelper::CatchUp()
+{
+    if (!m_lazy || m_running)
+    {
+        return false;
+    }
+    bool ran = false;
+    Time now = Simulator::Now();
+    while (m_step && m_stepTime <= now)
+    {
+        NS_LOG_LOGIC("running the step due at " << m_stepTime.As(Time::S));
+        Step step = std::move(m_step);
+        m_step = nullptr;
+        m_running = true;
+        m_runningTime = m_stepTime;
+        step();
+        m_running = false;
+        ran = true;
+    }
+    return ran;
+}
+
+} // namespace ns3
@@ -0,0 +1,85 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MOBILITY_STEP_HELPER_H
+#define MOBILITY_STEP_HELPER_H
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+
+#include <functional>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ * \brief Utility class used to schedule the next course change of a mobility model.
+ *
+ * By default a step is scheduled as a Simulator event, as the mobility models
+ * always did.  In lazy mode no event is scheduled: the step is stored along
+ * with the time it is due at, and CatchUp runs every step due by the current
+ * simulation time.  A mobility model in lazy mode calls CatchUp whenever its
+ * position or velocity is queried, and uses GetNow instead of Simulator::Now
+ * within its steps, so that the trajectory is the same in both modes.
+ */
+class MobilityStepHelper
+{
+  public:
+    /// A step of the mobility model
+    typedef std::function<void()> Step;
+
+    /**
+     * \param lazy whether the steps are run lazily instead of being scheduled
+     */
+    void SetLazy(bool lazy);
+    /**
+     * \return whether the steps are run lazily
+     */
+    bool IsLazy() const;
+    /**
+     * \return the time the running step is due at if called from a step,
+     *         the current simulation time otherwise
+     */
+    Time GetNow() const;
+    /**
+     * Replace the pending step, if any, with a step due after the given delay.
+     * \param delay the delay, from GetNow, after which the step is due
+     * \param step the step
+     */
+    void Schedule(const Time& delay, Step step);
+    /**
+     * Cancel the pending step, if any
+     */
+    void Cancel();
+    /**
+     * In lazy mode, run the steps due by the current simulation time.
+     * Nothing is done in the other mode, or if called from a step.
+     * \return true if at least one step was run
+     */
+    bool CatchUp();
+
+  private:
+    bool m_lazy{false};    //!< whether the steps are run lazily
+    EventId m_event;       //!< the event of the pending step, if not lazy
+    Step m_step;           //!< the pending step, if lazy
+    Time m_stepTime;       //!< the time the pending step is due at, if lazy
+    bool m_running{false}; //!< whether a step is being run by CatchUp
+    Time m_runningTime;    //!< the time the step being run by CatchUp is due at
+};
+
+} // namespace ns3
+
+#endif /* MOBILITY_STEP_HELPER_H */
@@ -18,9 +18,9 @@
  */
 #include "random-direction-2d-mobility-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
-#include "ns3/simulator.h"
 #include "ns3/string.h"
 
 #include <algorithm>
@@ -55,7 +55,14 @@ RandomDirection2dMobilityModel::GetTypeId()
                           "A random variable to control the pause (s).",
                           StringValue("ns3::ConstantRandomVariable[Constant=2.0]"),
                           MakePointerAccessor(&RandomDirection2dMobilityModel::m_pause),
-                          MakePointerChecker<RandomVariableStream>());
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("LazyEvaluation",
+                          "If true, schedule no event and compute the movement when the "
+                          "position or the velocity is queried.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RandomDirection2dMobilityModel::SetLazyEvaluation,
+                                              &RandomDirection2dMobilityModel::GetLazyEvaluation),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -67,6 +74,7 @@ RandomDirection2dMobilityModel::RandomDirection2dMobilityModel()
 void
 RandomDirection2dMobilityModel::DoDispose()
 {
+    m_steps.Cancel();
     // chain up.
     MobilityModel::DoDispose();
 }
@@ -88,12 +96,10 @@ RandomDirection2dMobilityModel::DoInitializePrivate()
 void
 RandomDirection2dMobilityModel::BeginPause()
 {
-    m_helper.Update();
+    m_helper.Update(m_steps.GetNow());
     m_helper.Pause();
     Time pause = Seconds(m_pause->GetValue());
-    m_event.Cancel();
-    m_event =
-        Simulator::Schedule(pause, &RandomDirection2dMobilityModel::ResetDirectionAndSpeed, this);
+    m_steps.Schedule(pause, [this]() { ResetDirectionAndSpeed(); });
     NotifyCourseChange();
 }
 
@@ -101,16 +107,15 @@ void
 RandomDirection2dMobilityModel::SetDirectionAndSpeed(double direction)
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_helper.UpdateWithBounds(m_bounds);
+    m_helper.UpdateWithBounds(m_bounds, m_steps.GetNow());
     Vector position = m_helper.GetCurrentPosition();
     double speed = m_speed->GetValue();
     const Vector vector(std::cos(direction) * speed, std::sin(direction) * speed, 0.0);
-    m_helper.SetVelocity(vector);
+    m_helper.SetVelocity(vector, m_steps.GetNow());
     m_helper.Unpause();
     Vector next = m_bounds.CalculateIntersection(position, vector);
     Time delay = Seconds(CalculateDistance(position, next) / speed);
-    m_event.Cancel();
-    m_event = Simulator::Schedule(delay, &RandomDirection2dMobilityModel::BeginPause, this);
+    m_steps.Schedule(delay, [this]() { BeginPause(); });
     NotifyCourseChange();
 }
 
@@ -119,7 +124,7 @@ RandomDirection2dMobilityModel::ResetDirectionAndSpeed()
 {
     double direction = 0;
 
-    m_helper.UpdateWithBounds(m_bounds);
+    m_helper.UpdateWithBounds(m_bounds, m_steps.GetNow());
     Vector position = m_helper.GetCurrentPosition();
     switch (m_bounds.GetClosestSideOrCorner(position))
     {
@@ -152,24 +157,48 @@ RandomDirection2dMobilityModel::ResetDirectionAndSpeed()
     SetDirectionAndSpeed(direction);
 }
 
+void
+RandomDirection2dMobilityModel::CatchUp() const
+{
+    if (m_steps.CatchUp())
+    {
+        // the course change traces may have cached the position of a past step
+        InvalidatePositionCache();
+    }
+}
+
+void
+RandomDirection2dMobilityModel::SetLazyEvaluation(bool lazy)
+{
+    m_steps.SetLazy(lazy);
+}
+
+bool
+RandomDirection2dMobilityModel::GetLazyEvaluation() const
+{
+    return m_steps.IsLazy();
+}
+
 Vector
 RandomDirection2dMobilityModel::DoGetPosition() const
 {
-    m_helper.UpdateWithBounds(m_bounds);
+    CatchUp();
+    m_helper.UpdateWithBounds(m_bounds, m_steps.GetNow());
     return m_helper.GetCurrentPosition();
 }
 
 void
 RandomDirection2dMobilityModel::DoSetPosition(const Vector& position)
 {
+    CatchUp();
     m_helper.SetPosition(position);
-    m_event.Cancel();
-    m_event = Simulator::ScheduleNow(&RandomDirection2dMobilityModel::DoInitializePrivate, this);
+    m_steps.Schedule(Seconds(0), [this]() { DoInitializePrivate(); });
 }
 
 Vector
 RandomDirection2dMobilityModel::DoGetVelocity() const
 {
+    CatchUp();
     return m_helper.GetVelocity();
 }
 
@@ -21,9 +21,9 @@
 
 #include "constant-velocity-helper.h"
 #include "mobility-model.h"
+#include "mobility-step-helper.h"
 #include "rectangle.h"
 
-#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
@@ -41,6 +41,11 @@ namespace ns3
  * then travels in the specific direction until it reaches one of
  * the boundaries of the model. When it reaches the boundary, it pauses,
  * and selects a new direction and speed.
+ *
+ * If the LazyEvaluation attribute is true, no event is scheduled: the
+ * pauses and the changes of direction due by the current time are
+ * computed, and their course changes notified, when the position or the
+ * velocity of the model is queried.
  */
 class RandomDirection2dMobilityModel : public MobilityModel
 {
@@ -70,6 +75,18 @@ class RandomDirection2dMobilityModel : public MobilityModel
      * Sets a new random direction and calls SetDirectionAndSpeed
      */
     void DoInitializePrivate();
+    /**
+     * In lazy mode, run the pauses and changes of direction due by the current time
+     */
+    void CatchUp() const;
+    /**
+     * \param lazy whether the movement is evaluated lazily instead of by events
+     */
+    void SetLazyEvaluation(bool lazy);
+    /**
+     * \return whether the movement is evaluated lazily instead of by events
+     */
+    bool GetLazyEvaluation() const;
     void DoDispose() override;
     void DoInitialize() override;
     Vector DoGetPosition() const override;
@@ -81,7 +98,7 @@ class RandomDirection2dMobilityModel : public MobilityModel
     Rectangle m_bounds;                     //!< the 2D bounding area
     Ptr<RandomVariableStream> m_speed;      //!< a random variable to control speed
     Ptr<RandomVariableStream> m_pause;      //!< a random variable to control pause
-    EventId m_event;                        //!< event ID of next scheduled event
+    mutable MobilityStepHelper m_steps;     //!< helper scheduling the next pause or direction
     ConstantVelocityHelper m_helper;        //!< helper for velocity computations
 };
 
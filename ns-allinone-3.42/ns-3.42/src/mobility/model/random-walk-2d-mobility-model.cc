@@ -18,11 +18,11 @@
  */
 #include "random-walk-2d-mobility-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
-#include "ns3/simulator.h"
 #include "ns3/string.h"
 
 #include <cmath>
@@ -76,7 +76,14 @@ RandomWalk2dMobilityModel::GetTypeId()
                           "A random variable used to pick the speed (m/s).",
                           StringValue("ns3::UniformRandomVariable[Min=2.0|Max=4.0]"),
                           MakePointerAccessor(&RandomWalk2dMobilityModel::m_speed),
-                          MakePointerChecker<RandomVariableStream>());
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("LazyEvaluation",
+                          "If true, schedule no event and compute the walk when the position "
+                          "or the velocity is queried.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RandomWalk2dMobilityModel::SetLazyEvaluation,
+                                              &RandomWalk2dMobilityModel::GetLazyEvaluation),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -90,7 +97,7 @@ RandomWalk2dMobilityModel::DoInitialize()
 void
 RandomWalk2dMobilityModel::DoInitializePrivate()
 {
-    m_helper.Update();
+    m_helper.Update(m_steps.GetNow());
     Vector position = m_helper.GetCurrentPosition();
 
     double speed = m_speed->GetValue();
@@ -130,7 +137,7 @@ RandomWalk2dMobilityModel::DoInitializePrivate()
             break;
         }
     }
-    m_helper.SetVelocity(velocity);
+    m_helper.SetVelocity(velocity, m_steps.GetNow());
     m_helper.Unpause();
 
     Time delayLeft;
@@ -153,11 +160,9 @@ RandomWalk2dMobilityModel::DoWalk(Time delayLeft)
     Vector nextPosition = position;
     nextPosition.x += velocity.x * delayLeft.GetSeconds();
     nextPosition.y += velocity.y * delayLeft.GetSeconds();
-    m_event.Cancel();
     if (m_bounds.IsInside(nextPosition))
     {
-        m_event =
-            Simulator::Schedule(delayLeft, &RandomWalk2dMobilityModel::DoInitializePrivate, this);
+        m_steps.Schedule(delayLeft, [this]() { DoInitializePrivate(); });
     }
     else
     {
@@ -179,10 +184,7 @@ RandomWalk2dMobilityModel::DoWalk(Time delayLeft)
                          "(the node is stationary).");
         }
         Time delay = Seconds(delaySeconds);
-        m_event = Simulator::Schedule(delay,
-                                      &RandomWalk2dMobilityModel::Rebound,
-                                      this,
-                                      delayLeft - delay);
+        m_steps.Schedule(delay, [this, timeLeft = delayLeft - delay]() { Rebound(timeLeft); });
     }
     NotifyCourseChange();
 }
@@ -190,7 +192,7 @@ RandomWalk2dMobilityModel::DoWalk(Time delayLeft)
 void
 RandomWalk2dMobilityModel::Rebound(Time delayLeft)
 {
-    m_helper.UpdateWithBounds(m_bounds);
+    m_helper.UpdateWithBounds(m_bounds, m_steps.GetNow());
     Vector position = m_helper.GetCurrentPosition();
     Vector velocity = m_helper.GetVelocity();
     switch (m_bounds.GetClosestSideOrCorner(position))
@@ -211,14 +213,37 @@ RandomWalk2dMobilityModel::Rebound(Time delayLeft)
         velocity.y = -velocity.y;
         break;
     }
-    m_helper.SetVelocity(velocity);
+    m_helper.SetVelocity(velocity, m_steps.GetNow());
     m_helper.Unpause();
     DoWalk(delayLeft);
 }
 
+void
+RandomWalk2dMobilityModel::CatchUp() const
+{
+    if (m_steps.CatchUp())
+    {
+        // the course change traces may have cached the position of a past step
+        InvalidatePositionCache();
+    }
+}
+
+void
+RandomWalk2dMobilityModel::SetLazyEvaluation(bool lazy)
+{
+    m_steps.SetLazy(lazy);
+}
+
+bool
+RandomWalk2dMobilityModel::GetLazyEvaluation() const
+{
+    return m_steps.IsLazy();
+}
+
 void
 RandomWalk2dMobilityModel::DoDispose()
 {
+    m_steps.Cancel();
     // chain up
     MobilityModel::DoDispose();
 }
@@ -226,7 +251,8 @@ RandomWalk2dMobilityModel::DoDispose()
 Vector
 RandomWalk2dMobilityModel::DoGetPosition() const
 {
-    m_helper.UpdateWithBounds(m_bounds);
+    CatchUp();
+    m_helper.UpdateWithBounds(m_bounds, m_steps.GetNow());
     return m_helper.GetCurrentPosition();
 }
 
@@ -234,14 +260,15 @@ void
 RandomWalk2dMobilityModel::DoSetPosition(const Vector& position)
 {
     NS_ASSERT(m_bounds.IsInside(position));
+    CatchUp();
     m_helper.SetPosition(position);
-    m_event.Cancel();
-    m_event = Simulator::ScheduleNow(&RandomWalk2dMobilityModel::DoInitializePrivate, this);
+    m_steps.Schedule(Seconds(0), [this]() { DoInitializePrivate(); });
 }
 
 Vector
 RandomWalk2dMobilityModel::DoGetVelocity() const
 {
+    CatchUp();
     return m_helper.GetVelocity();
 }
 
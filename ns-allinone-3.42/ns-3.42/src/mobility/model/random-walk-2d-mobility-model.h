@@ -21,9 +21,9 @@
 
 #include "constant-velocity-helper.h"
 #include "mobility-model.h"
+#include "mobility-step-helper.h"
 #include "rectangle.h"
 
-#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
@@ -47,6 +47,11 @@ namespace ns3
  * inside the boundaries. The points on the boundary have their
  * direction chosen randomly, without considering the Direction
  * Attribute.
+ *
+ * If the LazyEvaluation attribute is true, no event is scheduled: the
+ * changes of direction and the rebounds due by the current time are
+ * computed, and their course changes notified, when the position or the
+ * velocity of the model is queried.
  */
 class RandomWalk2dMobilityModel : public MobilityModel
 {
@@ -80,6 +85,18 @@ class RandomWalk2dMobilityModel : public MobilityModel
      * Perform initialization of the object before MobilityModel::DoInitialize ()
      */
     void DoInitializePrivate();
+    /**
+     * In lazy mode, run the steps of the walk due by the current time
+     */
+    void CatchUp() const;
+    /**
+     * \param lazy whether the walk is evaluated lazily instead of by events
+     */
+    void SetLazyEvaluation(bool lazy);
+    /**
+     * \return whether the walk is evaluated lazily instead of by events
+     */
+    bool GetLazyEvaluation() const;
     void DoDispose() override;
     void DoInitialize() override;
     Vector DoGetPosition() const override;
@@ -88,7 +105,7 @@ class RandomWalk2dMobilityModel : public MobilityModel
     int64_t DoAssignStreams(int64_t) override;
 
     ConstantVelocityHelper m_helper;       //!< helper for this object
-    EventId m_event;                       //!< stored event ID
+    mutable MobilityStepHelper m_steps;    //!< helper scheduling the next step of the walk
     Mode m_mode;                           //!< whether in time or distance mode
     double m_modeDistance;                 //!< Change direction and speed after this distance
     Time m_modeTime;                       //!< Change current direction and speed after this delay
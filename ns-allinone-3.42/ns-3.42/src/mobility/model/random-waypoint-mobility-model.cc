@@ -22,7 +22,7 @@
 
 #include "ns3/pointer.h"
 #include "ns3/random-variable-stream.h"
-#include "ns3/simulator.h"
+#include "ns3/boolean.h"
 #include "ns3/string.h"
 
 #include <cmath>
@@ -54,7 +54,14 @@ RandomWaypointMobilityModel::GetTypeId()
                           "The position model used to pick a destination point.",
                           PointerValue(),
                           MakePointerAccessor(&RandomWaypointMobilityModel::m_position),
-                          MakePointerChecker<PositionAllocator>());
+                          MakePointerChecker<PositionAllocator>())
+            .AddAttribute("LazyEvaluation",
+                          "If true, schedule no event and compute the movement when the "
+                          "position or the velocity is queried.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RandomWaypointMobilityModel::SetLazyEvaluation,
+                                              &RandomWaypointMobilityModel::GetLazyEvaluation),
+                          MakeBooleanChecker());
 
     return tid;
 }
@@ -62,7 +69,7 @@ RandomWaypointMobilityModel::GetTypeId()
 void
 RandomWaypointMobilityModel::BeginWalk()
 {
-    m_helper.Update();
+    m_helper.Update(m_steps.GetNow());
     Vector m_current = m_helper.GetCurrentPosition();
     NS_ASSERT_MSG(m_position, "No position allocator added before using this model");
     Vector destination = m_position->GetNext();
@@ -77,11 +84,9 @@ RandomWaypointMobilityModel::BeginWalk()
     double k = distance ? speed / distance : 0;
     Time travelDelay = distance ? Seconds(distance / speed) : Time(0);
 
-    m_helper.SetVelocity(k * delta);
+    m_helper.SetVelocity(k * delta, m_steps.GetNow());
     m_helper.Unpause();
-    m_event.Cancel();
-    m_event =
-        Simulator::Schedule(travelDelay, &RandomWaypointMobilityModel::DoInitializePrivate, this);
+    m_steps.Schedule(travelDelay, [this]() { DoInitializePrivate(); });
     NotifyCourseChange();
 }
 
@@ -95,31 +100,62 @@ RandomWaypointMobilityModel::DoInitialize()
 void
 RandomWaypointMobilityModel::DoInitializePrivate()
 {
-    m_helper.Update();
+    m_helper.Update(m_steps.GetNow());
     m_helper.Pause();
     Time pause = Seconds(m_pause->GetValue());
-    m_event = Simulator::Schedule(pause, &RandomWaypointMobilityModel::BeginWalk, this);
+    m_steps.Schedule(pause, [this]() { BeginWalk(); });
     NotifyCourseChange();
 }
 
+void
+RandomWaypointMobilityModel::CatchUp() const
+{
+    if (m_steps.CatchUp())
+    {
+        // the course change traces may have cached the position of a past step
+        InvalidatePositionCache();
+    }
+}
+
+void
+RandomWaypointMobilityModel::SetLazyEvaluation(bool lazy)
+{
+    m_steps.SetLazy(lazy);
+}
+
+bool
+RandomWaypointMobilityModel::GetLazyEvaluation() const
+{
+    return m_steps.IsLazy();
+}
+
+void
+RandomWaypointMobilityModel::DoDispose()
+{
+    m_steps.Cancel();
+    MobilityModel::DoDispose();
+}
+
 Vector
 RandomWaypointMobilityModel::DoGetPosition() const
 {
-    m_helper.Update();
+    CatchUp();
+    m_helper.Update(m_steps.GetNow());
     return m_helper.GetCurrentPosition();
 }
 
 void
 RandomWaypointMobilityModel::DoSetPosition(const Vector& position)
 {
+    CatchUp();
     m_helper.SetPosition(position);
-    m_event.Cancel();
-    m_event = Simulator::ScheduleNow(&RandomWaypointMobilityModel::DoInitializePrivate, this);
+    m_steps.Schedule(Seconds(0), [this]() { DoInitializePrivate(); });
 }
 
 Vector
 RandomWaypointMobilityModel::DoGetVelocity() const
 {
+    CatchUp();
     return m_helper.GetVelocity();
 }
 
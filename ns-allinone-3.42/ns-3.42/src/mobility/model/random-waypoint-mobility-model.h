@@ -21,6 +21,7 @@
 
 #include "constant-velocity-helper.h"
 #include "mobility-model.h"
+#include "mobility-step-helper.h"
 #include "position-allocator.h"
 
 #include "ns3/ptr.h"
@@ -49,6 +50,12 @@ namespace ns3
  * a 3d random waypoint position model to this mobility model, the model
  * will still work. There is no 3d position allocator for now but it should
  * be trivial to add one.
+ *
+ * If the LazyEvaluation attribute is true, no event is scheduled: the
+ * pauses and walks due by the current time are computed, and their course
+ * changes notified, when the position or the velocity of the model is
+ * queried.  If the PositionAllocator is shared with other models, the
+ * waypoints are then drawn in a different order than with events.
  */
 class RandomWaypointMobilityModel : public MobilityModel
 {
@@ -71,16 +78,29 @@ class RandomWaypointMobilityModel : public MobilityModel
      * Begin current pause event, schedule future walk event
      */
     void DoInitializePrivate();
+    /**
+     * In lazy mode, run the pauses and walks due by the current time
+     */
+    void CatchUp() const;
+    /**
+     * \param lazy whether the movement is evaluated lazily instead of by events
+     */
+    void SetLazyEvaluation(bool lazy);
+    /**
+     * \return whether the movement is evaluated lazily instead of by events
+     */
+    bool GetLazyEvaluation() const;
+    void DoDispose() override;
     Vector DoGetPosition() const override;
     void DoSetPosition(const Vector& position) override;
     Vector DoGetVelocity() const override;
     int64_t DoAssignStreams(int64_t) override;
 
-    ConstantVelocityHelper m_helper;   //!< helper for velocity computations
-    Ptr<PositionAllocator> m_position; //!< pointer to position allocator
-    Ptr<RandomVariableStream> m_speed; //!< random variable to generate speeds
-    Ptr<RandomVariableStream> m_pause; //!< random variable to generate pauses
-    EventId m_event;                   //!< event ID of next scheduled event
+    ConstantVelocityHelper m_helper;    //!< helper for velocity computations
+    Ptr<PositionAllocator> m_position;  //!< pointer to position allocator
+    Ptr<RandomVariableStream> m_speed;  //!< random variable to generate speeds
+    Ptr<RandomVariableStream> m_pause;  //!< random variable to generate pauses
+    mutable MobilityStepHelper m_steps; //!< helper scheduling the next pause or walk
 };
 
 } // namespace ns3
@@ -99,6 +99,7 @@ WaypointMobilityModel::AddWaypoint(const Waypoint& waypoint)
                         "Waypoints must be added in ascending time order");
         m_waypoints.push_back(waypoint);
     }
+    InvalidatePositionCache();
 
     if (!m_lazyNotify)
     {
@@ -220,6 +221,7 @@ WaypointMobilityModel::EndMobility()
     m_current.time = Time(std::numeric_limits<uint64_t>::infinity());
     m_next.time = m_current.time;
     m_first = true;
+    InvalidatePositionCache();
 }
 
 Vector
@@ -18,6 +18,7 @@
  */
 
 #include <ns3/angles.h>
+#include <ns3/geocentric-constant-position-mobility-model.h>
 #include <ns3/geographic-positions.h>
 #include <ns3/log.h>
 #include <ns3/test.h>
@@ -528,6 +529,125 @@ GeoToAndFromTopocentricTestCase::CheckTestPass(double actual,
     return pass;
 }
 
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Topocentric frame and batch conversion Test Case
+ *
+ * This test verifies that a GeographicPositions::TopocentricFrame and the batch
+ * conversions of GeographicPositions give the same coordinates as the
+ * corresponding per-point conversions, that the conversion from Cartesian to
+ * topocentric coordinates by rotation matches the geographic to topocentric
+ * conversion, and that GeocentricConstantPositionMobilityModel updates its
+ * cached positions when its position or reference point changes.
+ */
+class TopocentricFrameTestCase : public TestCase
+{
+  public:
+    /**
+     * @brief Constructor
+     *
+     * @param sphereType spheroid type
+     */
+    TopocentricFrameTestCase(GeographicPositions::EarthSpheroidType sphereType);
+
+  private:
+    void DoRun() override;
+
+    GeographicPositions::EarthSpheroidType m_sphereType; ///< spheroid type
+};
+
+TopocentricFrameTestCase::TopocentricFrameTestCase(
+    GeographicPositions::EarthSpheroidType sphereType)
+    : TestCase("Topocentric frame and batch conversions"),
+      m_sphereType(sphereType)
+{
+}
+
+void
+TopocentricFrameTestCase::DoRun()
+{
+    GeographicPositions::TopocentricFrame frame(REFP_1_COORD, m_sphereType);
+    std::vector<Vector> topo(TEST_COORD.size());
+    std::vector<Vector> cartesian(TEST_COORD.size());
+    std::vector<Vector> rotated(TEST_COORD.size());
+    std::vector<Vector> geographic(TEST_COORD.size());
+    frame.GeographicToTopocentric(TEST_COORD, topo);
+    GeographicPositions::GeographicToCartesianCoordinates(TEST_COORD, cartesian, m_sphereType);
+    frame.CartesianToTopocentric(cartesian, rotated);
+    GeographicPositions::CartesianToGeographicCoordinates(cartesian, geographic, m_sphereType);
+
+    for (size_t i = 0; i < TEST_COORD.size(); i++)
+    {
+        const Vector& pos = TEST_COORD[i];
+        Vector expectedTopo = GeographicPositions::GeographicToTopocentricCoordinates(pos,
+                                                                                      REFP_1_COORD,
+                                                                                      m_sphereType);
+        NS_TEST_EXPECT_MSG_EQ(topo[i], expectedTopo, "Frame and per-point conversions differ");
+        Vector expectedGeo = GeographicPositions::TopocentricToGeographicCoordinates(topo[i],
+                                                                                     REFP_1_COORD,
+                                                                                     m_sphereType);
+        NS_TEST_EXPECT_MSG_EQ(frame.TopocentricToGeographic(topo[i]),
+                              expectedGeo,
+                              "Frame and per-point inverse conversions differ");
+
+        Vector expectedCartesian =
+            GeographicPositions::GeographicToCartesianCoordinates(pos.x,
+                                                                  pos.y,
+                                                                  pos.z,
+                                                                  m_sphereType);
+        NS_TEST_EXPECT_MSG_EQ(cartesian[i], expectedCartesian, "Batch conversion differs");
+        NS_TEST_EXPECT_MSG_EQ(
+            geographic[i],
+            GeographicPositions::CartesianToGeographicCoordinates(expectedCartesian, m_sphereType),
+            "Batch inverse conversion differs");
+
+        // the rotation only differs from the direct conversion by rounding errors
+        NS_TEST_EXPECT_MSG_LT(CalculateDistance(rotated[i], expectedTopo),
+                              1e-6,
+                              "Cartesian to topocentric rotation is wrong");
+        NS_TEST_EXPECT_MSG_LT(CalculateDistance(frame.TopocentricToCartesian(topo[i]),
+                                                expectedCartesian),
+                              1e-6,
+                              "Topocentric to Cartesian rotation is wrong");
+    }
+
+    if (m_sphereType != GeographicPositions::SPHERE)
+    {
+        return;
+    }
+    auto model = CreateObject<GeocentricConstantPositionMobilityModel>();
+    for (const auto& refPoint : {REFP_1_COORD, Vector(0, 0, 0)})
+    {
+        model->SetCoordinateTranslationReferencePoint(refPoint);
+        for (size_t i = 0; i < 2; i++)
+        {
+            // compare with the geographic position, as the model normalizes the longitude
+            model->SetGeographicPosition(TEST_COORD[i]);
+            Vector pos = model->GetGeographicPosition();
+            Vector expectedTopo =
+                GeographicPositions::GeographicToTopocentricCoordinates(pos,
+                                                                        refPoint,
+                                                                        m_sphereType);
+            Vector expectedCartesian =
+                GeographicPositions::GeographicToCartesianCoordinates(pos.x,
+                                                                      pos.y,
+                                                                      pos.z,
+                                                                      m_sphereType);
+            NS_TEST_EXPECT_MSG_EQ(model->GetPosition(),
+                                  expectedTopo,
+                                  "Cached topocentric position not updated");
+            NS_TEST_EXPECT_MSG_EQ(model->GetGeocentricPosition(),
+                                  expectedCartesian,
+                                  "Cached geocentric position not updated");
+        }
+    }
+    model->SetPosition(Vector(100, 200, 10));
+    NS_TEST_EXPECT_MSG_LT(CalculateDistance(model->GetPosition(), Vector(100, 200, 10)),
+                          1e-3,
+                          "Topocentric position not set");
+}
+
 /**
  * \ingroup mobility-test
  *
@@ -564,6 +684,14 @@ GeoToAndFromTopocentricTestSuite::GeoToAndFromTopocentricTestSuite()
                                                     WGS_84_REFP_1, // expected topo coord
                                                     GeographicPositions::WGS84),
                 TestCase::Duration::QUICK);
+
+    // Test the frame and batch conversions against the per-point ones
+    AddTestCase(new TopocentricFrameTestCase(GeographicPositions::SPHERE),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TopocentricFrameTestCase(GeographicPositions::GRS80),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TopocentricFrameTestCase(GeographicPositions::WGS84),
+                TestCase::Duration::QUICK);
 }
 
 /**
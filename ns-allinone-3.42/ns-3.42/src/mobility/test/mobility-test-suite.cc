@@ -23,10 +23,16 @@
  */
 
 #include "ns3/boolean.h"
+#include "ns3/hierarchical-mobility-model.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/mobility-model.h"
+#include "ns3/object-factory.h"
+#include "ns3/pointer.h"
+#include "ns3/position-allocator.h"
+#include "ns3/rectangle.h"
 #include "ns3/scheduler.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/vector.h"
 #include "ns3/waypoint-mobility-model.h"
@@ -472,6 +478,336 @@ WaypointMobilityModelViaHelper::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Mobility model moving at 1 m/s along the x axis, which counts how
+ * many times its position is computed
+ */
+class CountingMobilityModel : public MobilityModel
+{
+  public:
+    /// The number of calls to DoGetPosition
+    mutable uint32_t m_nComputed{0};
+    /// The position at time zero
+    Vector m_origin;
+
+  private:
+    Vector DoGetPosition() const override
+    {
+        m_nComputed++;
+        return Vector(m_origin.x + Simulator::Now().GetSeconds(), m_origin.y, m_origin.z);
+    }
+
+    void DoSetPosition(const Vector& position) override
+    {
+        // on purpose, no course change is notified
+        m_origin = position;
+    }
+
+    Vector DoGetVelocity() const override
+    {
+        return Vector(1, 0, 0);
+    }
+};
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Test that the position of a mobility model is computed once per
+ * simulation time, and computed again after it is set
+ */
+class PositionCacheTestCase : public TestCase
+{
+  public:
+    PositionCacheTestCase();
+
+  private:
+    /**
+     * Query the position a few times and check that it is computed once
+     * \param model the mobility model
+     * \param expectedXPos the expected X position
+     */
+    void CheckPosition(Ptr<CountingMobilityModel> model, double expectedXPos);
+    void DoRun() override;
+};
+
+PositionCacheTestCase::PositionCacheTestCase()
+    : TestCase("Test the caching of the position over a simulation time")
+{
+}
+
+void
+PositionCacheTestCase::CheckPosition(Ptr<CountingMobilityModel> model, double expectedXPos)
+{
+    uint32_t nComputed = model->m_nComputed;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(model->GetPosition().x, expectedXPos, 1e-9, "Wrong position");
+    }
+    NS_TEST_EXPECT_MSG_EQ(model->m_nComputed, nComputed + 1, "Position computed more than once");
+}
+
+void
+PositionCacheTestCase::DoRun()
+{
+    Ptr<CountingMobilityModel> model = CreateObject<CountingMobilityModel>();
+    Ptr<CountingMobilityModel> other = CreateObject<CountingMobilityModel>();
+    CheckPosition(model, 0);
+    Simulator::Schedule(Seconds(1), &PositionCacheTestCase::CheckPosition, this, model, 1);
+    Simulator::Schedule(Seconds(2), &PositionCacheTestCase::CheckPosition, this, model, 2);
+    Simulator::Schedule(Seconds(2), &MobilityModel::SetPosition, model, Vector(10, 0, 0));
+    Simulator::Schedule(Seconds(2), &PositionCacheTestCase::CheckPosition, this, model, 12);
+    Simulator::Schedule(Seconds(3), [this, model, other]() {
+        CheckPosition(model, 13);
+        CheckPosition(other, 3);
+        NS_TEST_EXPECT_MSG_EQ_TOL(model->GetDistanceFrom(other), 10, 1e-9, "Wrong distance");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Test that the positions of hierarchical models sharing a parent
+ * evaluate the parent once per simulation time, one by one or in a batch
+ */
+class HierarchicalPositionsTestCase : public TestCase
+{
+  public:
+    HierarchicalPositionsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HierarchicalPositionsTestCase::HierarchicalPositionsTestCase()
+    : TestCase("Test the positions of hierarchical models sharing a parent")
+{
+}
+
+void
+HierarchicalPositionsTestCase::DoRun()
+{
+    Ptr<CountingMobilityModel> parent = CreateObject<CountingMobilityModel>();
+    parent->SetPosition(Vector(100, 0, 0));
+    Ptr<CountingMobilityModel> otherParent = CreateObject<CountingMobilityModel>();
+    std::vector<Ptr<CountingMobilityModel>> children;
+    std::vector<Ptr<HierarchicalMobilityModel>> models;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        Ptr<CountingMobilityModel> child = CreateObject<CountingMobilityModel>();
+        child->SetPosition(Vector(0, i, 0));
+        Ptr<HierarchicalMobilityModel> model = CreateObject<HierarchicalMobilityModel>();
+        model->SetParent(i < 4 ? parent : otherParent);
+        model->SetChild(child);
+        children.push_back(child);
+        models.push_back(model);
+    }
+
+    // Each child moves at 1 m/s along x, as its parent does
+    auto expected = [](uint32_t i) {
+        double t = Simulator::Now().GetSeconds();
+        return Vector((i < 4 ? 100 : 0) + 2 * t, i, 0);
+    };
+
+    Simulator::Schedule(Seconds(1), [&]() {
+        uint32_t nComputed = parent->m_nComputed;
+        for (uint32_t i = 0; i < models.size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_LT(CalculateDistance(models[i]->GetPosition(), expected(i)),
+                                  1e-9,
+                                  "Wrong position of model " << i);
+        }
+        NS_TEST_EXPECT_MSG_EQ(parent->m_nComputed, nComputed + 1, "Parent computed again");
+    });
+    Simulator::Schedule(Seconds(2), [&]() {
+        // the position of the first model is already cached
+        NS_TEST_EXPECT_MSG_LT(CalculateDistance(models[0]->GetPosition(), expected(0)),
+                              1e-9,
+                              "Wrong position of model 0");
+        uint32_t nComputed = parent->m_nComputed;
+        uint32_t nOtherComputed = otherParent->m_nComputed;
+        std::vector<Vector> positions = HierarchicalMobilityModel::GetPositions(models);
+        NS_TEST_ASSERT_MSG_EQ(positions.size(), models.size(), "Wrong number of positions");
+        for (uint32_t i = 0; i < models.size(); i++)
+        {
+            NS_TEST_EXPECT_MSG_LT(CalculateDistance(positions[i], expected(i)),
+                                  1e-9,
+                                  "Wrong batch position of model " << i);
+        }
+        NS_TEST_EXPECT_MSG_EQ(parent->m_nComputed, nComputed, "Parent computed again");
+        NS_TEST_EXPECT_MSG_EQ(otherParent->m_nComputed,
+                              nOtherComputed + 1,
+                              "Other parent not computed once");
+
+        // the batch positions are cached by the models
+        for (uint32_t i = 0; i < models.size(); i++)
+        {
+            uint32_t nChildComputed = children[i]->m_nComputed;
+            NS_TEST_EXPECT_MSG_LT(CalculateDistance(models[i]->GetPosition(), expected(i)),
+                                  1e-9,
+                                  "Wrong position of model " << i);
+            NS_TEST_EXPECT_MSG_EQ(children[i]->m_nComputed,
+                                  nChildComputed,
+                                  "Child " << i << " computed again");
+        }
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Test that the random mobility models follow the same trajectory
+ * when evaluated lazily as with events, and that they schedule no event
+ * when evaluated lazily
+ */
+class LazyEvaluationTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param typeId the type of the mobility model
+     */
+    LazyEvaluationTestCase(std::string typeId);
+
+  private:
+    /**
+     * Create and initialize a mobility model
+     * \param lazy the value of the LazyEvaluation attribute
+     * \return the mobility model
+     */
+    Ptr<MobilityModel> CreateModel(bool lazy);
+    /**
+     * Store the current position of a model
+     * \param model the mobility model
+     * \param positions the positions to add the current one to
+     */
+    void RecordPosition(Ptr<MobilityModel> model, std::vector<Vector>* positions);
+    /**
+     * Course change callback
+     * \param model the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> model);
+    /**
+     * Record the positions of a model over a simulation
+     * \param lazy the value of the LazyEvaluation attribute
+     * \return the positions
+     */
+    std::vector<Vector> Run(bool lazy);
+    void DoRun() override;
+
+    std::string m_typeId;          //!< the type of the mobility model
+    uint32_t m_courseChanges{0};   //!< the number of course changes notified
+    const uint32_t m_nQueries{80}; //!< the number of times the position is recorded
+};
+
+LazyEvaluationTestCase::LazyEvaluationTestCase(std::string typeId)
+    : TestCase("Test the lazy evaluation of " + typeId),
+      m_typeId(typeId)
+{
+}
+
+Ptr<MobilityModel>
+LazyEvaluationTestCase::CreateModel(bool lazy)
+{
+    ObjectFactory factory(m_typeId);
+    factory.Set("LazyEvaluation", BooleanValue(lazy));
+    if (m_typeId == "ns3::RandomWaypointMobilityModel")
+    {
+        Ptr<RandomRectanglePositionAllocator> allocator =
+            CreateObject<RandomRectanglePositionAllocator>();
+        allocator->SetAttribute("X", StringValue("ns3::UniformRandomVariable[Min=0|Max=100]"));
+        allocator->SetAttribute("Y", StringValue("ns3::UniformRandomVariable[Min=0|Max=100]"));
+        factory.Set("PositionAllocator", PointerValue(allocator));
+        factory.Set("Pause", StringValue("ns3::UniformRandomVariable[Min=0|Max=3]"));
+        factory.Set("Speed", StringValue("ns3::UniformRandomVariable[Min=5|Max=10]"));
+    }
+    else if (m_typeId == "ns3::RandomDirection2dMobilityModel")
+    {
+        factory.Set("Bounds", RectangleValue(Rectangle(0, 100, 0, 100)));
+        factory.Set("Speed", StringValue("ns3::UniformRandomVariable[Min=5|Max=10]"));
+    }
+    else
+    {
+        factory.Set("Mode", StringValue("Time"));
+        factory.Set("Time", StringValue("3s"));
+        factory.Set("Speed", StringValue("ns3::UniformRandomVariable[Min=5|Max=10]"));
+    }
+    Ptr<MobilityModel> model = factory.Create<MobilityModel>();
+    model->AssignStreams(7);
+    model->SetPosition(Vector(50, 50, 0));
+    model->Initialize();
+    model->TraceConnectWithoutContext("CourseChange",
+                                      MakeCallback(&LazyEvaluationTestCase::CourseChanged, this));
+    return model;
+}
+
+void
+LazyEvaluationTestCase::RecordPosition(Ptr<MobilityModel> model, std::vector<Vector>* positions)
+{
+    positions->push_back(model->GetPosition());
+}
+
+void
+LazyEvaluationTestCase::CourseChanged(Ptr<const MobilityModel> model)
+{
+    m_courseChanges++;
+}
+
+std::vector<Vector>
+LazyEvaluationTestCase::Run(bool lazy)
+{
+    std::vector<Vector> positions;
+    Ptr<MobilityModel> model = CreateModel(lazy);
+    for (uint32_t i = 1; i <= m_nQueries; i++)
+    {
+        Simulator::Schedule(MilliSeconds(700 * i),
+                            &LazyEvaluationTestCase::RecordPosition,
+                            this,
+                            model,
+                            &positions);
+    }
+    if (!lazy)
+    {
+        Simulator::Stop(MilliSeconds(700 * m_nQueries));
+    }
+    Simulator::Run();
+    if (lazy)
+    {
+        // only the queries were run, the simulation stopped by itself
+        NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount(),
+                              m_nQueries,
+                              "Events were scheduled by the mobility model");
+    }
+    Simulator::Destroy();
+    return positions;
+}
+
+void
+LazyEvaluationTestCase::DoRun()
+{
+    std::vector<Vector> expected = Run(false);
+    uint32_t eagerCourseChanges = m_courseChanges;
+    m_courseChanges = 0;
+    std::vector<Vector> positions = Run(true);
+    NS_TEST_ASSERT_MSG_EQ(positions.size(), expected.size(), "Wrong number of positions");
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_LT(CalculateDistance(positions[i], expected[i]),
+                              1e-9,
+                              "Lazy position " << positions[i] << " differs from " << expected[i]);
+    }
+    // the course changes after the last query are not computed in lazy mode
+    NS_TEST_EXPECT_MSG_GT(m_courseChanges, 4, "Too few course changes notified");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(m_courseChanges,
+                                eagerCourseChanges,
+                                "Too many course changes notified");
+}
+
 /**
  * \ingroup mobility-test
  *
@@ -490,6 +826,14 @@ MobilityTestSuite::MobilityTestSuite()
     AddTestCase(new WaypointLazyNotifyTrue, TestCase::Duration::QUICK);
     AddTestCase(new WaypointInitialPositionIsWaypoint, TestCase::Duration::QUICK);
     AddTestCase(new WaypointMobilityModelViaHelper, TestCase::Duration::QUICK);
+    AddTestCase(new PositionCacheTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new HierarchicalPositionsTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new LazyEvaluationTestCase("ns3::RandomWalk2dMobilityModel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LazyEvaluationTestCase("ns3::RandomDirection2dMobilityModel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new LazyEvaluationTestCase("ns3::RandomWaypointMobilityModel"),
+                TestCase::Duration::QUICK);
 }
 
 /**
@@ -46,6 +46,7 @@
 #include "ns3/ns2-mobility-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/waypoint-mobility-model.h"
 
 #include <algorithm>
 
@@ -319,6 +320,161 @@ class Ns2MobilityHelperTest : public TestCase
     }
 };
 
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Read a trace with a streamed Ns2MobilityHelper, and check the
+ * positions of the nodes every quarter of a second against the positions
+ * given by a helper which reads the whole trace at install, or against
+ * reference positions.
+ */
+class Ns2MobilityHelperStreamTest : public TestCase
+{
+  public:
+    /**
+     * \param name Short description
+     * \param timeLimit Test time limit
+     * \param nodes Number of nodes used in the test trace
+     * \param window Stream window
+     * \param binary Whether to stream the trace converted to the binary format
+     */
+    Ns2MobilityHelperStreamTest(const std::string& name,
+                                Time timeLimit,
+                                uint32_t nodes,
+                                Time window,
+                                bool binary)
+        : TestCase(name),
+          m_timeLimit(timeLimit),
+          m_nodeCount(nodes),
+          m_window(window),
+          m_binary(binary)
+    {
+    }
+
+    /**
+     * \param trace the mobility trace
+     */
+    void SetTrace(const std::string& trace)
+    {
+        m_trace = trace;
+    }
+
+    /**
+     * Check the streamed position of a node at a given time, instead of
+     * comparing it with the helper which reads the whole trace
+     * \param node the node index
+     * \param sec the time, in seconds
+     * \param pos the reference position
+     */
+    void AddReferencePosition(uint32_t node, double sec, const Vector& pos)
+    {
+        m_reference.push_back({node, Seconds(sec), pos});
+    }
+
+  private:
+    /// Reference position of a node
+    struct ReferencePosition
+    {
+        uint32_t node; ///< node index
+        Time time;     ///< time
+        Vector pos;    ///< position
+    };
+
+    /// Compare the positions of the streamed nodes with the parsed ones
+    void ComparePositions()
+    {
+        for (uint32_t i = 0; i < m_nodeCount; ++i)
+        {
+            Vector parsed = m_parsed.Get(i)->GetObject<MobilityModel>()->GetPosition();
+            Vector streamed = m_streamed.Get(i)->GetObject<MobilityModel>()->GetPosition();
+            NS_TEST_EXPECT_MSG_EQ(AreVectorsEqual(streamed, parsed, 0.001),
+                                  true,
+                                  "Position mismatch at time " << Simulator::Now().GetSeconds()
+                                                               << " s for node " << i << ": "
+                                                               << streamed << " vs " << parsed);
+        }
+    }
+
+    /**
+     * Check the position of a streamed node
+     * \param ref the reference position
+     */
+    void CheckPosition(ReferencePosition ref)
+    {
+        Vector streamed = m_streamed.Get(ref.node)->GetObject<MobilityModel>()->GetPosition();
+        NS_TEST_EXPECT_MSG_EQ(AreVectorsEqual(streamed, ref.pos, 0.001),
+                              true,
+                              "Position mismatch at time " << ref.time.GetSeconds()
+                                                           << " s for node " << ref.node << ": "
+                                                           << streamed << " vs " << ref.pos);
+    }
+
+    void DoTeardown() override
+    {
+        m_parsed = NodeContainer();
+        m_streamed = NodeContainer();
+        Simulator::Destroy();
+    }
+
+    void DoRun() override
+    {
+        std::string traceFile = CreateTempDirFilename("Ns2MobilityHelperStreamTest.tcl");
+        std::ofstream of(traceFile);
+        NS_TEST_ASSERT_MSG_EQ(of.is_open(), true, "Need to write tmp. file");
+        of << m_trace;
+        of.close();
+
+        std::string streamedFile = traceFile;
+        if (m_binary)
+        {
+            streamedFile = CreateTempDirFilename("Ns2MobilityHelperStreamTest.bin");
+            NS_TEST_ASSERT_MSG_EQ(Ns2MobilityHelper::ConvertToBinary(traceFile, streamedFile),
+                                  true,
+                                  "Could not convert the trace");
+        }
+
+        m_parsed.Create(m_nodeCount);
+        m_streamed.Create(m_nodeCount);
+        if (m_reference.empty())
+        {
+            Ns2MobilityHelper parsed(traceFile);
+            parsed.Install(m_parsed.Begin(), m_parsed.End());
+        }
+        Ns2MobilityHelper streamed(streamedFile);
+        streamed.SetStreamWindow(m_window);
+        streamed.Install(m_streamed.Begin(), m_streamed.End());
+        for (uint32_t i = 0; i < m_nodeCount; ++i)
+        {
+            NS_TEST_ASSERT_MSG_NE(m_streamed.Get(i)->GetObject<WaypointMobilityModel>(),
+                                  nullptr,
+                                  "Streamed node " << i << " has no waypoint mobility model");
+        }
+
+        if (m_reference.empty())
+        {
+            for (Time t = Seconds(0); t < m_timeLimit; t += MilliSeconds(250))
+            {
+                Simulator::Schedule(t, &Ns2MobilityHelperStreamTest::ComparePositions, this);
+            }
+        }
+        for (const ReferencePosition& ref : m_reference)
+        {
+            Simulator::Schedule(ref.time, &Ns2MobilityHelperStreamTest::CheckPosition, this, ref);
+        }
+        Simulator::Stop(m_timeLimit);
+        Simulator::Run();
+    }
+
+    Time m_timeLimit;                           ///< Test time limit
+    uint32_t m_nodeCount;                       ///< Number of nodes used in the test
+    Time m_window;                              ///< Stream window
+    bool m_binary;                              ///< Whether to stream the binary trace
+    std::string m_trace;                        ///< Trace as string
+    std::vector<ReferencePosition> m_reference; ///< Reference positions, if any
+    NodeContainer m_parsed;                     ///< Nodes of the helper reading the whole trace
+    NodeContainer m_streamed;                   ///< Nodes of the streamed helper
+};
+
 /**
  * \ingroup mobility-test
  *
@@ -618,5 +774,52 @@ class Ns2MobilityHelperTestSuite : public TestSuite
                              Vector(300.000, 650.000, 0.000),
                              Vector(0.000, 0.000, 0.000));
         AddTestCase(t, TestCase::Duration::QUICK);
+
+        // Streamed traces, with initial positions at the end, interrupted
+        // movements, stops and movements which span several windows
+        const std::string ordered = "$node_(0) set X_ 10.0\n"
+                                    "$node_(0) set Y_ 20.0\n"
+                                    "$node_(0) set Z_ 1.5\n"
+                                    "$ns_ at 1.0 \"$node_(0) setdest 50 20 4\"\n"
+                                    "$ns_ at 2.0 \"$node_(1) setdest 30 40 5\"\n"
+                                    "$ns_ at 6.0 \"$node_(0) setdest 10 60 2\"\n"
+                                    "$ns_ at 15.0 \"$node_(1) setdest 30 40 0\"\n"
+                                    "$ns_ at 20.0 \"$node_(1) setdest 0 0 10\"\n"
+                                    "$ns_ at 21.5 \"$node_(1) setdest 5 5 0\"\n"
+                                    "$ns_ at 30.0 \"$node_(2) setdest 100 0 1\"\n"
+                                    "$node_(2) set X_ 50\n";
+        const std::string unordered = "$node_(0) set X_ 10.0\n"
+                                      "$node_(0) set Y_ 20.0\n"
+                                      "$node_(0) set Z_ 1.5\n"
+                                      "$ns_ at 1.0 \"$node_(0) setdest 50 20 4\"\n"
+                                      "$ns_ at 6.0 \"$node_(0) setdest 10 60 2\"\n"
+                                      "$ns_ at 2.0 \"$node_(1) setdest 30 40 5\"\n"
+                                      "$ns_ at 15.0 \"$node_(1) setdest 30 40 0\"\n"
+                                      "$ns_ at 20.0 \"$node_(1) setdest 0 0 10\"\n"
+                                      "$ns_ at 21.5 \"$node_(1) setdest 5 5 0\"\n"
+                                      "$node_(2) set X_ 50\n"
+                                      "$ns_ at 30.0 \"$node_(2) setdest 100 0 1\"\n";
+        Ns2MobilityHelperStreamTest* st(nullptr);
+        st = new Ns2MobilityHelperStreamTest("stream ordered", Seconds(40), 3, Seconds(3), false);
+        st->SetTrace(ordered);
+        AddTestCase(st, TestCase::Duration::QUICK);
+        st = new Ns2MobilityHelperStreamTest("stream unordered", Seconds(40), 3, Seconds(3), false);
+        st->SetTrace(unordered);
+        AddTestCase(st, TestCase::Duration::QUICK);
+        st = new Ns2MobilityHelperStreamTest("stream binary", Seconds(40), 3, Seconds(3), true);
+        st->SetTrace(unordered);
+        AddTestCase(st, TestCase::Duration::QUICK);
+
+        // A scheduled set ends the movement and moves the node
+        st = new Ns2MobilityHelperStreamTest("stream set", Seconds(10), 1, Seconds(1), false);
+        st->SetTrace("$ns_ at 1.0 \"$node_(0) setdest 10 0 1\"\n"
+                     "$ns_ at 3.0 \"$node_(0) set Y_ 5\"\n"
+                     "$ns_ at 5.0 \"$node_(0) setdest 2 9 1\"\n");
+        st->AddReferencePosition(0, 2, Vector(1, 0, 0));
+        st->AddReferencePosition(0, 3.5, Vector(2, 5, 0));
+        st->AddReferencePosition(0, 4.5, Vector(2, 5, 0));
+        st->AddReferencePosition(0, 7, Vector(2, 7, 0));
+        st->AddReferencePosition(0, 9.5, Vector(2, 9, 0));
+        AddTestCase(st, TestCase::Duration::QUICK);
     }
 } g_ns2TransmobilityHelperTestSuite; ///< the test suite
@@ -38,6 +38,7 @@
 #include "ns3/simulator.h"
 
 #include <cmath>
+#include <limits>
 #include <mpi.h>
 
 namespace ns3
@@ -164,6 +165,11 @@ DistributedSimulatorImpl::CalculateLookAhead()
 {
     NS_LOG_FUNCTION(this);
 
+    // Delay to each rank from this rank, bounded by the user supplied lookahead
+    const int64_t noLink = std::numeric_limits<int64_t>::max();
+    std::vector<int64_t> delays(m_systemCount, noLink);
+    const Time bound = m_lookAhead;
+
     /* If running sequential simulation can ignore lookahead */
     if (MpiInterface::GetSize() <= 1)
     {
@@ -220,6 +226,18 @@ DistributedSimulatorImpl::CalculateLookAhead()
                 {
                     m_lookAhead = delay.Get();
                 }
+                int64_t& remoteDelay = delays[remoteNode->GetSystemId()];
+                remoteDelay = std::min(remoteDelay, Min(delay.Get(), bound).GetInteger());
+            }
+        }
+
+        // channels without a fixed delay bound the lookahead through MpiInterface
+        for (const auto& [systemId, delay] : MpiInterface::GetRemoteLookAheads())
+        {
+            if (systemId != MpiInterface::GetSystemId())
+            {
+                m_lookAhead = Min(m_lookAhead, delay);
+                delays[systemId] = std::min(delays[systemId], Min(delay, bound).GetInteger());
             }
         }
     }
@@ -268,6 +286,95 @@ DistributedSimulatorImpl::CalculateLookAhead()
         m_lookAhead = Time(recvbuf);
         m_grantedTime = m_lookAhead;
     }
+
+    /*
+     * Gather the delays between all the ranks, and compute the smallest
+     * delay of a chain of messages from each rank to this rank (Dijkstra
+     * on the reversed graph of the ranks).  The chains from this rank
+     * back to itself are included: they bound the time at which this
+     * rank may receive a reply to its own messages.
+     */
+    m_pathLookAhead.assign(m_systemCount, GetMaximumSimulationTime());
+    if (m_systemCount <= 1)
+    {
+        return;
+    }
+    std::vector<int64_t> matrix(m_systemCount * m_systemCount);
+    MPI_Allgather(delays.data(),
+                  m_systemCount,
+                  MPI_INT64_T,
+                  matrix.data(),
+                  m_systemCount,
+                  MPI_INT64_T,
+                  MpiInterface::GetCommunicator());
+    std::vector<int64_t> distance(m_systemCount);
+    std::vector<bool> done(m_systemCount, false);
+    for (uint32_t j = 0; j < m_systemCount; ++j)
+    {
+        distance[j] = matrix[j * m_systemCount + m_myId];
+    }
+    for (uint32_t n = 0; n < m_systemCount; ++n)
+    {
+        uint32_t k = m_systemCount;
+        for (uint32_t j = 0; j < m_systemCount; ++j)
+        {
+            if (!done[j] && distance[j] != noLink &&
+                (k == m_systemCount || distance[j] < distance[k]))
+            {
+                k = j;
+            }
+        }
+        if (k == m_systemCount)
+        {
+            break;
+        }
+        done[k] = true;
+        m_pathLookAhead[k] = Time(distance[k]);
+        for (uint32_t j = 0; j < m_systemCount; ++j)
+        {
+            int64_t delay = matrix[j * m_systemCount + k];
+            if (delay != noLink)
+            {
+                distance[j] = std::min(distance[j], delay + distance[k]);
+            }
+        }
+    }
+}
+
+Time
+DistributedSimulatorImpl::CalculateGrantedTime(Time smallestTime)
+{
+    NS_LOG_FUNCTION(this << smallestTime);
+
+    // If lookahead is infinite then granted time should be as well.
+    // Covers the edge case if all the tasks have no inter tasks
+    // links, prevents overflow of granted time.
+    if (m_lookAhead == GetMaximumSimulationTime())
+    {
+        return GetMaximumSimulationTime();
+    }
+
+    // A message reaching this rank follows a chain of messages starting
+    // at the next event of some rank.
+    Time grantedTime = GetMaximumSimulationTime();
+    for (uint32_t i = 0; i < m_systemCount; ++i)
+    {
+        Time next = m_pLBTS[i].GetSmallestTime();
+        if (next == GetMaximumSimulationTime() ||
+            m_pathLookAhead[i] == GetMaximumSimulationTime())
+        {
+            continue;
+        }
+        grantedTime = Min(grantedTime, next + m_pathLookAhead[i]);
+    }
+
+    // Tasks without inter-task links advance with the window of the other tasks.
+    if (grantedTime == GetMaximumSimulationTime())
+    {
+        // Overflow is possible here if near end of representable time.
+        grantedTime = smallestTime + m_lookAhead;
+    }
+    return grantedTime;
 }
 
 void
@@ -377,7 +484,9 @@ DistributedSimulatorImpl::Run()
         if (nextTime > m_grantedTime || IsLocalFinished())
         {
             // Can't process next event, calculate a new LBTS
-            // First receive any pending messages
+            // First send the packets aggregated during the window
+            GrantedTimeWindowMpiInterface::FlushMessages();
+            // Then receive any pending messages
             GrantedTimeWindowMpiInterface::ReceiveMessages();
             // reset next time
             nextTime = Next();
@@ -390,13 +499,22 @@ DistributedSimulatorImpl::Run()
                              IsLocalFinished(),
                              nextTime);
             m_pLBTS[m_myId] = lMsg;
-            MPI_Allgather(&lMsg,
-                          sizeof(LbtsMessage),
-                          MPI_BYTE,
-                          m_pLBTS,
-                          sizeof(LbtsMessage),
-                          MPI_BYTE,
-                          MpiInterface::GetCommunicator());
+            // Complete the sends of this window while the LBTS messages are gathered
+            MPI_Request request;
+            MPI_Iallgather(&lMsg,
+                           sizeof(LbtsMessage),
+                           MPI_BYTE,
+                           m_pLBTS,
+                           sizeof(LbtsMessage),
+                           MPI_BYTE,
+                           MpiInterface::GetCommunicator(),
+                           &request);
+            int gathered = 0;
+            while (!gathered)
+            {
+                GrantedTimeWindowMpiInterface::TestSendComplete();
+                MPI_Test(&request, &gathered, MPI_STATUS_IGNORE);
+            }
             Time smallestTime = m_pLBTS[0].GetSmallestTime();
             // The totRx and totTx counts insure there are no transient
             // messages;  If totRx != totTx, there are transients,
@@ -422,18 +540,7 @@ DistributedSimulatorImpl::Run()
 
             if (totRx == totTx)
             {
-                // If lookahead is infinite then granted time should be as well.
-                // Covers the edge case if all the tasks have no inter tasks
-                // links, prevents overflow of granted time.
-                if (m_lookAhead == GetMaximumSimulationTime())
-                {
-                    m_grantedTime = GetMaximumSimulationTime();
-                }
-                else
-                {
-                    // Overflow is possible here if near end of representable time.
-                    m_grantedTime = smallestTime + m_lookAhead;
-                }
+                m_grantedTime = CalculateGrantedTime(smallestTime);
             }
         }
 
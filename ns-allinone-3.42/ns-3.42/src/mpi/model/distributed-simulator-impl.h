@@ -31,6 +31,7 @@
 #include "ns3/simulator-impl.h"
 
 #include <list>
+#include <vector>
 
 namespace ns3
 {
@@ -165,8 +166,21 @@ class DistributedSimulatorImpl : public SimulatorImpl
      * a constraint on the conservative PDES time window.  The
      * user may impose additional constraints on lookahead
      * using the ConstrainLookAhead() method.
+     *
+     * The delays between each pair of ranks are also gathered, to
+     * compute the smallest delay of a chain of messages from each
+     * rank to this rank.  Ranks far from this rank then constrain
+     * its time window less than its neighbors.
      */
     void CalculateLookAhead();
+    /**
+     * Compute the end of the time window of this rank from the
+     * LBTS messages of all the ranks.
+     *
+     * \param [in] smallestTime The smallest next event time of all the ranks.
+     * \return The granted time.
+     */
+    Time CalculateGrantedTime(Time smallestTime);
     /**
      * Check if this rank is finished.  It's finished when there are
      * no more events or stop has been requested.
@@ -229,6 +243,11 @@ class DistributedSimulatorImpl : public SimulatorImpl
     uint32_t m_systemCount;  /**< MPI communicator size. */
     Time m_grantedTime;      /**< End of current window. */
     static Time m_lookAhead; /**< Current window size. */
+    /**
+     * Smallest delay of a chain of messages from each rank to this
+     * rank, or the maximum time if there is none.
+     */
+    std::vector<Time> m_pathLookAhead;
 };
 
 } // namespace ns3
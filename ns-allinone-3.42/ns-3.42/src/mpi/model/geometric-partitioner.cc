@@ -0,0 +1,209 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mpi
+ * Implementation of class ns3::GeometricPartitioner.
+ */
+
+#include "geometric-partitioner.h"
+
+#include "mpi-interface.h"
+
+#include <ns3/assert.h>
+#include <ns3/log.h>
+#include <ns3/node.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("GeometricPartitioner");
+
+namespace
+{
+/// Speed of light in vacuum [m/s]
+const double SPEED_OF_LIGHT = 299792458.0;
+
+/**
+ * Get one coordinate of a position.
+ *
+ * \param v the position
+ * \param axis 0 for x, 1 for y, 2 for z
+ * \return the coordinate
+ */
+double
+GetCoordinate(const Vector& v, uint32_t axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+} // namespace
+
+std::vector<uint32_t>
+GeometricPartitioner::Partition(const std::vector<Vector>& positions, uint32_t nPartitions)
+{
+    NS_LOG_FUNCTION(positions.size() << nPartitions);
+    NS_ASSERT_MSG(nPartitions > 0, "At least one partition is needed");
+
+    std::vector<uint32_t> partitions(positions.size(), 0);
+    std::vector<uint32_t> indices(positions.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    Bisect(positions, indices.begin(), indices.end(), 0, nPartitions, partitions);
+    return partitions;
+}
+
+void
+GeometricPartitioner::Bisect(const std::vector<Vector>& positions,
+                             std::vector<uint32_t>::iterator begin,
+                             std::vector<uint32_t>::iterator end,
+                             uint32_t first,
+                             uint32_t count,
+                             std::vector<uint32_t>& partitions)
+{
+    if (count == 1 || begin == end)
+    {
+        for (auto it = begin; it != end; ++it)
+        {
+            partitions[*it] = first;
+        }
+        return;
+    }
+
+    // cut along the axis of the largest extent of the set
+    Vector min = positions[*begin];
+    Vector max = min;
+    for (auto it = begin; it != end; ++it)
+    {
+        const Vector& v = positions[*it];
+        min = Vector(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+        max = Vector(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+    }
+    uint32_t axis = 0;
+    double extent = max.x - min.x;
+    if (max.y - min.y > extent)
+    {
+        axis = 1;
+        extent = max.y - min.y;
+    }
+    if (max.z - min.z > extent)
+    {
+        axis = 2;
+    }
+
+    uint32_t lowCount = count / 2;
+    auto middle = begin + (end - begin) * lowCount / count;
+    std::nth_element(begin, middle, end, [&positions, axis](uint32_t i, uint32_t j) {
+        return GetCoordinate(positions[i], axis) < GetCoordinate(positions[j], axis);
+    });
+    Bisect(positions, begin, middle, first, lowCount, partitions);
+    Bisect(positions, middle, end, first + lowCount, count - lowCount, partitions);
+}
+
+NodeContainer
+GeometricPartitioner::CreateNodes(const std::vector<Vector>& positions)
+{
+    NS_LOG_FUNCTION(positions.size());
+
+    NodeContainer nodes;
+    for (uint32_t systemId : Partition(positions, MpiInterface::GetSize()))
+    {
+        nodes.Add(CreateObject<Node>(systemId));
+    }
+    return nodes;
+}
+
+double
+GeometricPartitioner::GetMinimumDistance(const std::vector<Vector>& positions,
+                                         const std::vector<uint32_t>& partitions,
+                                         uint32_t a,
+                                         uint32_t b)
+{
+    NS_LOG_FUNCTION(a << b);
+    NS_ASSERT(positions.size() == partitions.size());
+
+    std::vector<Vector> setA;
+    std::vector<Vector> setB;
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        if (partitions[i] == a)
+        {
+            setA.push_back(positions[i]);
+        }
+        else if (partitions[i] == b)
+        {
+            setB.push_back(positions[i]);
+        }
+    }
+    if (setA.size() > setB.size())
+    {
+        std::swap(setA, setB);
+    }
+
+    // sweep the positions of the larger set sorted by x, from the x of each
+    // position of the smaller set, until the x gap alone exceeds the best distance
+    auto byX = [](const Vector& u, const Vector& v) { return u.x < v.x; };
+    std::sort(setB.begin(), setB.end(), byX);
+    double best = std::numeric_limits<double>::infinity();
+    for (const Vector& u : setA)
+    {
+        auto start = std::lower_bound(setB.begin(), setB.end(), u, byX);
+        for (auto it = start; it != setB.end() && it->x - u.x < best; ++it)
+        {
+            best = std::min(best, CalculateDistance(u, *it));
+        }
+        for (auto it = start; it != setB.begin() && u.x - (it - 1)->x < best; --it)
+        {
+            best = std::min(best, CalculateDistance(u, *(it - 1)));
+        }
+    }
+    return best;
+}
+
+void
+GeometricPartitioner::SetLookAhead(const std::vector<Vector>& positions,
+                                   const std::vector<uint32_t>& partitions,
+                                   double maxRange)
+{
+    NS_LOG_FUNCTION(maxRange);
+
+    uint32_t myId = MpiInterface::GetSystemId();
+    for (uint32_t rank = 0; rank < MpiInterface::GetSize(); ++rank)
+    {
+        if (rank == myId)
+        {
+            continue;
+        }
+        double distance = GetMinimumDistance(positions, partitions, myId, rank);
+        if (distance > maxRange)
+        {
+            continue;
+        }
+        NS_ASSERT_MSG(distance > 0, "Ranks " << myId << " and " << rank << " share a position");
+        NS_LOG_INFO("Rank " << rank << " is " << distance << " m away");
+        MpiInterface::SetRemoteLookAhead(rank, GetPropagationDelay(distance));
+    }
+}
+
+Time
+GeometricPartitioner::GetPropagationDelay(double distance)
+{
+    return Seconds(distance / SPEED_OF_LIGHT);
+}
+
+} // namespace ns3
@@ -0,0 +1,137 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mpi
+ * Declaration of class ns3::GeometricPartitioner.
+ */
+
+#ifndef NS3_GEOMETRIC_PARTITIONER_H
+#define NS3_GEOMETRIC_PARTITIONER_H
+
+#include <ns3/node-container.h>
+#include <ns3/nstime.h>
+#include <ns3/vector.h>
+
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Assigns nodes to MPI ranks from their positions.
+ *
+ * The nodes are split by recursive coordinate bisection: the set of
+ * positions is cut in two along the axis of its largest extent, the sizes
+ * of the two halves being proportional to the number of ranks each of them
+ * receives, until each set gets a single rank. Nearby nodes thus end on the
+ * same rank, and each rank gets the same number of nodes, within one.
+ *
+ * Wireless links between ranks have no fixed delay, the lookahead between
+ * two ranks is instead the propagation delay over the minimum distance
+ * between their nodes. SetLookAhead computes it for all the neighbours of
+ * this rank and hands it to MpiInterface::SetRemoteLookAhead. This bound
+ * only holds if the nodes do not move closer to the nodes of other ranks
+ * during the simulation.
+ */
+class GeometricPartitioner
+{
+  public:
+    /**
+     * \brief Assign positions to partitions.
+     *
+     * \param positions the positions of the nodes
+     * \param nPartitions the number of partitions
+     * \return the partition of each position, in [0, nPartitions)
+     */
+    static std::vector<uint32_t> Partition(const std::vector<Vector>& positions,
+                                           uint32_t nPartitions);
+
+    /**
+     * \brief Create one node per position, with the system id of its partition.
+     *
+     * The positions are partitioned over MpiInterface::GetSize() ranks. The
+     * nodes are created in the order of the positions, which can then be
+     * given to the nodes with a ListPositionAllocator.
+     *
+     * \param positions the positions of the nodes
+     * \return the nodes created
+     */
+    static NodeContainer CreateNodes(const std::vector<Vector>& positions);
+
+    /**
+     * \brief Get the minimum distance between the nodes of two partitions.
+     *
+     * \param positions the positions of the nodes
+     * \param partitions the partition of each position
+     * \param a the first partition
+     * \param b the second partition
+     * \return the minimum distance in meters, or infinity if a partition is empty
+     */
+    static double GetMinimumDistance(const std::vector<Vector>& positions,
+                                     const std::vector<uint32_t>& partitions,
+                                     uint32_t a,
+                                     uint32_t b);
+
+    /**
+     * \brief Set the lookahead between this rank and the other ranks.
+     *
+     * The lookahead towards each other rank is the propagation delay at the
+     * speed of light over the minimum distance between the nodes of the two
+     * ranks. Ranks farther than maxRange can not receive the transmissions
+     * of this rank and are not neighbours.
+     *
+     * \param positions the positions of the nodes
+     * \param partitions the partition of each position
+     * \param maxRange the maximum range of the transmissions, in meters
+     */
+    static void SetLookAhead(const std::vector<Vector>& positions,
+                             const std::vector<uint32_t>& partitions,
+                             double maxRange = std::numeric_limits<double>::infinity());
+
+    /**
+     * \brief Get the propagation delay of a wireless link.
+     *
+     * \param distance the distance in meters
+     * \return the propagation delay at the speed of light
+     */
+    static Time GetPropagationDelay(double distance);
+
+  private:
+    /**
+     * Recursively bisect a set of positions.
+     *
+     * \param positions the positions of the nodes
+     * \param begin the first index of the positions of the set
+     * \param end past the last index of the positions of the set
+     * \param first the first partition assigned to the set
+     * \param count the number of partitions assigned to the set
+     * \param partitions the partition of each position
+     */
+    static void Bisect(const std::vector<Vector>& positions,
+                       std::vector<uint32_t>::iterator begin,
+                       std::vector<uint32_t>::iterator end,
+                       uint32_t first,
+                       uint32_t count,
+                       std::vector<uint32_t>& partitions);
+};
+
+} // namespace ns3
+
+#endif /* NS3_GEOMETRIC_PARTITIONER_H */
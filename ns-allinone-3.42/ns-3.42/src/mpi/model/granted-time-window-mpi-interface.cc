@@ -37,6 +37,7 @@
 #include "ns3/simulator-impl.h"
 #include "ns3/simulator.h"
 
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <list>
@@ -85,6 +86,13 @@ bool GrantedTimeWindowMpiInterface::g_mpiInitCalled = false;
 uint32_t GrantedTimeWindowMpiInterface::g_rxCount = 0;
 uint32_t GrantedTimeWindowMpiInterface::g_txCount = 0;
 std::list<SentBuffer> GrantedTimeWindowMpiInterface::g_pendingTx;
+std::vector<std::vector<uint8_t>> GrantedTimeWindowMpiInterface::g_aggregates;
+
+namespace
+{
+/// Size of the receive time, destination node, destination device and size of a packet
+const uint32_t PACKET_HEADER_SIZE = sizeof(uint64_t) + 3 * sizeof(uint32_t);
+} // namespace
 
 MPI_Request* GrantedTimeWindowMpiInterface::g_requests;
 char** GrantedTimeWindowMpiInterface::g_pRxBuffers;
@@ -112,6 +120,7 @@ GrantedTimeWindowMpiInterface::Destroy()
     delete[] g_requests;
 
     g_pendingTx.clear();
+    g_aggregates.clear();
 }
 
 uint32_t
@@ -192,6 +201,7 @@ GrantedTimeWindowMpiInterface::Enable(MPI_Comm communicator)
     g_size = mpiSize;
 
     g_enabled = true;
+    g_aggregates.assign(g_size, std::vector<uint8_t>());
     // Post a non-blocking receive for all peers
     g_pRxBuffers = new char*[g_size];
     g_requests = new MPI_Request[g_size];
@@ -216,35 +226,71 @@ GrantedTimeWindowMpiInterface::SendPacket(Ptr<Packet> p,
 {
     NS_LOG_FUNCTION(this << p << rxTime.GetTimeStep() << node << dev);
 
-    SentBuffer sendBuf;
-    g_pendingTx.push_back(sendBuf);
-    auto i = g_pendingTx.rbegin(); // Points to the last element
-
     uint32_t serializedSize = p->GetSerializedSize();
-    auto buffer = new uint8_t[serializedSize + 16];
-    i->SetBuffer(buffer);
-    // Add the time, dest node and dest device
-    uint64_t t = rxTime.GetInteger();
-    auto pTime = reinterpret_cast<uint64_t*>(buffer);
-    *pTime++ = t;
-    auto pData = reinterpret_cast<uint32_t*>(pTime);
-    *pData++ = node;
-    *pData++ = dev;
-    // Serialize the packet
-    p->Serialize(reinterpret_cast<uint8_t*>(pData), serializedSize);
+    uint32_t recordSize = PACKET_HEADER_SIZE + serializedSize;
+    NS_ASSERT_MSG(recordSize <= MAX_MPI_MSG_SIZE, "Packet too large for an MPI message");
 
     // Find the system id for the destination node
     Ptr<Node> destNode = NodeList::GetNode(node);
     uint32_t nodeSysId = destNode->GetSystemId();
 
+    std::vector<uint8_t>& aggregate = g_aggregates[nodeSysId];
+    if (aggregate.size() + recordSize > MAX_MPI_MSG_SIZE)
+    {
+        SendAggregate(nodeSysId);
+    }
+
+    // Add the time, dest node, dest device and packet size
+    size_t offset = aggregate.size();
+    aggregate.resize(offset + recordSize);
+    uint8_t* buffer = aggregate.data() + offset;
+    uint64_t t = rxTime.GetInteger();
+    uint32_t data[3] = {node, dev, serializedSize};
+    std::memcpy(buffer, &t, sizeof(t));
+    std::memcpy(buffer + sizeof(t), data, sizeof(data));
+    // Serialize the packet
+    p->Serialize(buffer + PACKET_HEADER_SIZE, serializedSize);
+}
+
+void
+GrantedTimeWindowMpiInterface::SendAggregate(uint32_t rank)
+{
+    NS_LOG_FUNCTION(rank);
+
+    std::vector<uint8_t>& aggregate = g_aggregates[rank];
+    if (aggregate.empty())
+    {
+        return;
+    }
+
+    SentBuffer sendBuf;
+    g_pendingTx.push_back(sendBuf);
+    auto i = g_pendingTx.rbegin(); // Points to the last element
+
+    auto buffer = new uint8_t[aggregate.size()];
+    std::memcpy(buffer, aggregate.data(), aggregate.size());
+    i->SetBuffer(buffer);
+
     MPI_Isend(reinterpret_cast<void*>(i->GetBuffer()),
-              serializedSize + 16,
+              aggregate.size(),
               MPI_CHAR,
-              nodeSysId,
+              rank,
               0,
               g_communicator,
               (i->GetRequest()));
     g_txCount++;
+    aggregate.clear();
+}
+
+void
+GrantedTimeWindowMpiInterface::FlushMessages()
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    for (uint32_t rank = 0; rank < g_aggregates.size(); ++rank)
+    {
+        SendAggregate(rank);
+    }
 }
 
 void
@@ -268,41 +314,48 @@ GrantedTimeWindowMpiInterface::ReceiveMessages()
         MPI_Get_count(&status, MPI_CHAR, &count);
         g_rxCount++; // Count this receive
 
-        // Get the meta data first
-        auto pTime = reinterpret_cast<uint64_t*>(g_pRxBuffers[index]);
-        uint64_t time = *pTime++;
-        auto pData = reinterpret_cast<uint32_t*>(pTime);
-        uint32_t node = *pData++;
-        uint32_t dev = *pData++;
-
-        Time rxTime(time);
-
-        count -= sizeof(time) + sizeof(node) + sizeof(dev);
-
-        Ptr<Packet> p = Create<Packet>(reinterpret_cast<uint8_t*>(pData), count, true);
-
-        // Find the correct node/device to schedule receive event
-        Ptr<Node> pNode = NodeList::GetNode(node);
-        Ptr<MpiReceiver> pMpiRec = nullptr;
-        uint32_t nDevices = pNode->GetNDevices();
-        for (uint32_t i = 0; i < nDevices; ++i)
+        // Each message holds one or more packets, with their meta data first
+        auto pRecord = reinterpret_cast<uint8_t*>(g_pRxBuffers[index]);
+        auto pEnd = pRecord + count;
+        while (pRecord + PACKET_HEADER_SIZE <= pEnd)
         {
-            Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
-            if (pThisDev->GetIfIndex() == dev)
+            uint64_t time;
+            uint32_t data[3];
+            std::memcpy(&time, pRecord, sizeof(time));
+            std::memcpy(data, pRecord + sizeof(time), sizeof(data));
+            uint32_t node = data[0];
+            uint32_t dev = data[1];
+            uint32_t size = data[2];
+            pRecord += PACKET_HEADER_SIZE;
+            NS_ASSERT(pRecord + size <= pEnd);
+
+            Time rxTime(time);
+            Ptr<Packet> p = Create<Packet>(pRecord, size, true);
+            pRecord += size;
+
+            // Find the correct node/device to schedule receive event
+            Ptr<Node> pNode = NodeList::GetNode(node);
+            Ptr<MpiReceiver> pMpiRec = nullptr;
+            uint32_t nDevices = pNode->GetNDevices();
+            for (uint32_t i = 0; i < nDevices; ++i)
             {
-                pMpiRec = pThisDev->GetObject<MpiReceiver>();
-                break;
+                Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
+                if (pThisDev->GetIfIndex() == dev)
+                {
+                    pMpiRec = pThisDev->GetObject<MpiReceiver>();
+                    break;
+                }
             }
-        }
 
-        NS_ASSERT(pNode && pMpiRec);
+            NS_ASSERT(pNode && pMpiRec);
 
-        // Schedule the rx event
-        Simulator::ScheduleWithContext(pNode->GetId(),
-                                       rxTime - Simulator::Now(),
-                                       &MpiReceiver::Receive,
-                                       pMpiRec,
-                                       p);
+            // Schedule the rx event
+            Simulator::ScheduleWithContext(pNode->GetId(),
+                                           rxTime - Simulator::Now(),
+                                           &MpiReceiver::Receive,
+                                           pMpiRec,
+                                           p);
+        }
 
         // Re-queue the next read
         MPI_Irecv(g_pRxBuffers[index],
@@ -35,15 +35,17 @@
 #include <list>
 #include <mpi.h>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
 
 /**
  * maximum MPI message size for easy
- * buffer creation
+ * buffer creation; a message holds the packets sent to
+ * a rank in a time window, up to this size.
  */
-const uint32_t MAX_MPI_MSG_SIZE = 2000;
+const uint32_t MAX_MPI_MSG_SIZE = 16384;
 
 /**
  * \ingroup mpi
@@ -88,6 +90,11 @@ class DistributedSimulatorImpl;
  * Implements the interface used by the singleton parallel controller
  * to interface between NS3 and the communications layer being
  * used for inter-task packet transfers.
+ *
+ * The packets sent to a rank are aggregated, and sent in a single MPI
+ * message at the end of the time window (or when the message is full).
+ * This does not delay them, since the remote rank only receives messages
+ * when it synchronizes with the other ranks.
  */
 class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Object
 {
@@ -122,16 +129,25 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
      * Check for received messages complete
      */
     static void ReceiveMessages();
+    /**
+     * Send the packets aggregated for all the ranks
+     */
+    static void FlushMessages();
+    /**
+     * Send the packets aggregated for a rank in one message
+     * \param rank the destination rank
+     */
+    static void SendAggregate(uint32_t rank);
     /**
      * Check for completed sends
      */
     static void TestSendComplete();
     /**
-     * \return received count in packets
+     * \return received count in messages
      */
     static uint32_t GetRxCount();
     /**
-     * \return transmitted count in packets
+     * \return transmitted count in messages
      */
     static uint32_t GetTxCount();
 
@@ -140,10 +156,10 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
     /** Size of the MPI COM_WORLD group. */
     static uint32_t g_size;
 
-    /** Total packets received. */
+    /** Total messages received. */
     static uint32_t g_rxCount;
 
-    /** Total packets sent. */
+    /** Total messages sent. */
     static uint32_t g_txCount;
 
     /** Has this interface been enabled. */
@@ -164,6 +180,9 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
     /** List of pending non-blocking sends. */
     static std::list<SentBuffer> g_pendingTx;
 
+    /** Packets not sent yet, per destination rank. */
+    static std::vector<std::vector<uint8_t>> g_aggregates;
+
     /** MPI communicator being used for ns-3 tasks. */
     static MPI_Comm g_communicator;
 
@@ -38,6 +38,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("MpiInterface");
 
 ParallelCommunicationInterface* MpiInterface::g_parallelCommunicationInterface = nullptr;
+std::map<uint32_t, Time> MpiInterface::g_remoteLookAheads;
 
 void
 MpiInterface::Destroy()
@@ -142,6 +143,28 @@ MpiInterface::SendPacket(Ptr<Packet> p, const Time& rxTime, uint32_t node, uint3
     g_parallelCommunicationInterface->SendPacket(p, rxTime, node, dev);
 }
 
+void
+MpiInterface::SetRemoteLookAhead(uint32_t systemId, Time lookAhead)
+{
+    NS_LOG_FUNCTION(systemId << lookAhead);
+    NS_ASSERT_MSG(lookAhead.IsStrictlyPositive(), "The lookahead must be positive");
+    auto it = g_remoteLookAheads.find(systemId);
+    if (it == g_remoteLookAheads.end())
+    {
+        g_remoteLookAheads[systemId] = lookAhead;
+    }
+    else
+    {
+        it->second = Min(it->second, lookAhead);
+    }
+}
+
+const std::map<uint32_t, Time>&
+MpiInterface::GetRemoteLookAheads()
+{
+    return g_remoteLookAheads;
+}
+
 MPI_Comm
 MpiInterface::GetCommunicator()
 {
@@ -156,6 +179,7 @@ MpiInterface::Disable()
     g_parallelCommunicationInterface->Disable();
     delete g_parallelCommunicationInterface;
     g_parallelCommunicationInterface = nullptr;
+    g_remoteLookAheads.clear();
 }
 
 } // namespace ns3
@@ -29,6 +29,7 @@
 #include <ns3/nstime.h>
 #include <ns3/packet.h>
 
+#include <map>
 #include <mpi.h>
 
 namespace ns3
@@ -144,6 +145,31 @@ class MpiInterface
      */
     static void SendPacket(Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev);
 
+    /**
+     * \brief Bound the lookahead towards a remote rank.
+     *
+     * The lookahead of the point-to-point links is their delay. The
+     * channels without a fixed delay, such as wireless channels whose
+     * transmissions are sent to the receivers of other ranks with
+     * SendPacket, must bound the lookahead towards these ranks here, for
+     * example with the propagation delay over the minimum distance
+     * between the nodes of the two ranks (see GeometricPartitioner).
+     * The remote rank must bound its lookahead towards this rank as well.
+     *
+     * This must be called before Simulator::Run.
+     *
+     * \param systemId the remote rank
+     * \param lookAhead the minimum delay of a message sent to the remote rank
+     */
+    static void SetRemoteLookAhead(uint32_t systemId, Time lookAhead);
+
+    /**
+     * \brief Get the lookahead bounds set with SetRemoteLookAhead.
+     *
+     * \return the lookahead towards each remote rank with a bound
+     */
+    static const std::map<uint32_t, Time>& GetRemoteLookAheads();
+
     /**
      * \brief Return the communicator used to run ns-3.
      *
@@ -165,6 +191,11 @@ class MpiInterface
      * Static instance of the instantiated parallel controller.
      */
     static ParallelCommunicationInterface* g_parallelCommunicationInterface;
+
+    /**
+     * Lookahead towards the remote ranks, set by SetRemoteLookAhead.
+     */
+    static std::map<uint32_t, Time> g_remoteLookAheads;
 };
 
 } // namespace ns3
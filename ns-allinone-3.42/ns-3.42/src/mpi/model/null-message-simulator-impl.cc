@@ -195,6 +195,22 @@ NullMessageSimulatorImpl::CalculateLookAhead()
                 remoteChannelBundle->AddChannel(channel, delay.Get());
             }
         }
+
+        // channels without a fixed delay bound the lookahead through MpiInterface
+        for (const auto& [systemId, delay] : MpiInterface::GetRemoteLookAheads())
+        {
+            if (systemId == MpiInterface::GetSystemId())
+            {
+                continue;
+            }
+            Ptr<RemoteChannelBundle> remoteChannelBundle =
+                RemoteChannelBundleManager::Find(systemId);
+            if (!remoteChannelBundle)
+            {
+                remoteChannelBundle = RemoteChannelBundleManager::Add(systemId);
+            }
+            remoteChannelBundle->BoundDelay(delay);
+        }
     }
 
     // Completed setup of remote channel bundles.  Setup send and receive buffers.
@@ -65,6 +65,12 @@ RemoteChannelBundle::AddChannel(Ptr<Channel> channel, Time delay)
     m_delay = ns3::Min(m_delay, delay);
 }
 
+void
+RemoteChannelBundle::BoundDelay(Time delay)
+{
+    m_delay = ns3::Min(m_delay, delay);
+}
+
 uint32_t
 RemoteChannelBundle::GetSystemId() const
 {
@@ -78,6 +78,13 @@ class RemoteChannelBundle : public Object
      */
     void AddChannel(Ptr<Channel> channel, Time delay);
 
+    /**
+     * Bound the delay of this bundle, for the channels to the remote task
+     * without a fixed delay.
+     * \param delay minimum delay of the messages sent to the remote task
+     */
+    void BoundDelay(Time delay);
+
     /**
      * Get the system Id for this side.
      * \return SystemID for remote side of this bundle
@@ -0,0 +1,223 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <limits>
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::LogicalProcess.
+ */
+
+namespace ns3
+{
+
+// Logging is largely avoided here, as these functions run for every event
+NS_LOG_COMPONENT_DEFINE("LogicalProcess");
+
+LogicalProcess::LogicalProcess()
+    : m_events(nullptr),
+      m_uid(EventId::UID::VALID),
+      m_currentUid(EventId::UID::INVALID),
+      m_currentTs(0),
+      m_currentContext(Simulator::NO_CONTEXT),
+      m_eventCount(0),
+      m_unscheduledEvents(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LogicalProcess::~LogicalProcess()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+void
+LogicalProcess::SetScheduler(Ptr<Scheduler> scheduler)
+{
+    NS_LOG_FUNCTION(this << scheduler);
+    if (m_events)
+    {
+        while (!m_events->IsEmpty())
+        {
+            scheduler->Insert(m_events->RemoveNext());
+        }
+    }
+    m_events = scheduler;
+}
+
+uint32_t
+LogicalProcess::AllocateUid()
+{
+    return m_uid.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+LogicalProcess::SetNextUid(uint32_t uid)
+{
+    m_uid.store(uid, std::memory_order_relaxed);
+}
+
+void
+LogicalProcess::Insert(const Scheduler::Event& ev)
+{
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+}
+
+void
+LogicalProcess::Enqueue(const Scheduler::Event& ev)
+{
+    m_mailbox.Push(ev);
+}
+
+void
+LogicalProcess::ReceiveMessages()
+{
+    m_mailbox.Drain([this](const Scheduler::Event& ev) { Insert(ev); });
+}
+
+Scheduler::Event
+LogicalProcess::RemoveNext()
+{
+    m_unscheduledEvents--;
+    return m_events->RemoveNext();
+}
+
+void
+LogicalProcess::Remove(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    m_events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+
+    m_unscheduledEvents--;
+}
+
+bool
+LogicalProcess::IsExpired(const EventId& id) const
+{
+    return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+void
+LogicalProcess::ProcessUntil(uint64_t end, const std::atomic<bool>& stop)
+{
+    while (!m_events->IsEmpty() && m_events->PeekNext().key.m_ts < end &&
+           !stop.load(std::memory_order_relaxed))
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+
+        NS_ASSERT(next.key.m_ts >= m_currentTs);
+        m_unscheduledEvents--;
+        m_eventCount++;
+
+        m_currentTs = next.key.m_ts;
+        m_currentContext = next.key.m_context;
+        m_currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+    }
+}
+
+bool
+LogicalProcess::IsEmpty() const
+{
+    return m_events->IsEmpty() && m_mailbox.IsEmpty();
+}
+
+uint64_t
+LogicalProcess::GetNextTs() const
+{
+    if (m_events->IsEmpty())
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return m_events->PeekNext().key.m_ts;
+}
+
+uint64_t
+LogicalProcess::GetCurrentTs() const
+{
+    return m_currentTs;
+}
+
+void
+LogicalProcess::SetCurrentTs(uint64_t ts)
+{
+    NS_ASSERT(ts >= m_currentTs);
+    if (ts > m_currentTs)
+    {
+        m_currentTs = ts;
+        m_currentUid = EventId::UID::INVALID;
+    }
+}
+
+uint32_t
+LogicalProcess::GetContext() const
+{
+    return m_currentContext;
+}
+
+uint64_t
+LogicalProcess::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+int
+LogicalProcess::GetUnscheduledEvents() const
+{
+    return m_unscheduledEvents;
+}
+
+void
+LogicalProcess::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_events)
+    {
+        return;
+    }
+    ReceiveMessages();
+    while (!m_events->IsEmpty())
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        next.impl->Unref();
+    }
+    m_unscheduledEvents = 0;
+    m_events = nullptr;
+}
+
+} // namespace ns3
@@ -0,0 +1,180 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::LogicalProcess.
+ */
+
+#ifndef NS3_LOGICAL_PROCESS_H
+#define NS3_LOGICAL_PROCESS_H
+
+#include "ns3/event-id.h"
+#include "ns3/mpsc-queue.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * \ingroup mtp
+ *
+ * \brief A partition of the simulation, with its own event queue and clock.
+ *
+ * A logical process owns the events of a set of nodes.  Its events are
+ * only executed, inserted and removed by the thread running it; other
+ * logical processes send it events through a lock-free mailbox, which is
+ * emptied into the event queue between two execution windows.
+ */
+class LogicalProcess
+{
+  public:
+    /** Constructor. */
+    LogicalProcess();
+    /** Destructor. */
+    ~LogicalProcess();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    LogicalProcess(const LogicalProcess&) = delete;
+    LogicalProcess& operator=(const LogicalProcess&) = delete;
+
+    /**
+     * Set the event queue, moving the events of the previous one into it.
+     *
+     * \param [in] scheduler The new event queue.
+     */
+    void SetScheduler(Ptr<Scheduler> scheduler);
+
+    /**
+     * Get a unique id for a new event of this logical process.
+     * Can be called from any thread.
+     *
+     * \returns The event uid.
+     */
+    uint32_t AllocateUid();
+
+    /**
+     * Set the uid of the next event.
+     *
+     * \param [in] uid The uid of the next event.
+     */
+    void SetNextUid(uint32_t uid);
+
+    /**
+     * Insert an event in the event queue.
+     * Must be called from the thread running this logical process.
+     *
+     * \param [in] ev The event, with its key filled in.
+     */
+    void Insert(const Scheduler::Event& ev);
+
+    /**
+     * Send an event to this logical process from another thread.
+     * The event is inserted at the next call to ReceiveMessages().
+     *
+     * \param [in] ev The event, with its key filled in.
+     */
+    void Enqueue(const Scheduler::Event& ev);
+
+    /** Move the events sent with Enqueue() into the event queue. */
+    void ReceiveMessages();
+
+    /**
+     * Remove the next event from the event queue, without running it.
+     *
+     * \returns The event.
+     */
+    Scheduler::Event RemoveNext();
+
+    /**
+     * Remove an event from the event queue, and cancel it.
+     *
+     * \param [in] id The event to remove.
+     */
+    void Remove(const EventId& id);
+
+    /**
+     * Check if an event of this logical process has already run or
+     * has been cancelled.
+     *
+     * \param [in] id The event.
+     * \returns \c true if the event has expired.
+     */
+    bool IsExpired(const EventId& id) const;
+
+    /**
+     * Run the events with a timestamp strictly before the end of the window.
+     *
+     * \param [in] end The end of the window, in time steps.
+     * \param [in] stop Flag checked before each event, to stop early.
+     */
+    void ProcessUntil(uint64_t end, const std::atomic<bool>& stop);
+
+    /** \returns \c true if the event queue is empty. */
+    bool IsEmpty() const;
+    /**
+     * \returns The timestamp of the next event, or the largest
+     * representable timestamp if there is none.
+     */
+    uint64_t GetNextTs() const;
+
+    /** \returns The timestamp of the current event. */
+    uint64_t GetCurrentTs() const;
+    /**
+     * Move the clock forward, without running any event.
+     *
+     * \param [in] ts The new timestamp, in time steps.
+     */
+    void SetCurrentTs(uint64_t ts);
+    /** \returns The execution context of the current event. */
+    uint32_t GetContext() const;
+    /** \returns The number of events run so far. */
+    uint64_t GetEventCount() const;
+    /**
+     * \returns The number of events inserted but not yet run, which is
+     * zero when the logical process stopped by lack of events.
+     */
+    int GetUnscheduledEvents() const;
+
+    /** Unref all the pending events, and release the event queue. */
+    void Clear();
+
+  private:
+    /** The event queue. */
+    Ptr<Scheduler> m_events;
+    /** Events sent by the other logical processes. */
+    MpscQueue<Scheduler::Event> m_mailbox;
+    /** Next event unique id. */
+    std::atomic<uint32_t> m_uid;
+    /** Unique id of the current event. */
+    uint32_t m_currentUid;
+    /** Timestamp of the current event. */
+    uint64_t m_currentTs;
+    /** Execution context of the current event. */
+    uint32_t m_currentContext;
+    /** The event count. */
+    uint64_t m_eventCount;
+    /** Number of events that have been inserted but not yet run. */
+    int m_unscheduledEvents;
+};
+
+} // namespace ns3
+
+#endif /* NS3_LOGICAL_PROCESS_H */
@@ -0,0 +1,65 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::MtpInterface.
+ */
+
+#ifndef NS3_MTP_INTERFACE_H
+#define NS3_MTP_INTERFACE_H
+
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * \defgroup mtp Multithreaded Parallel Simulation
+ */
+
+/**
+ * \ingroup mtp
+ * \ingroup tests
+ * \defgroup mtp-tests Multithreaded Parallel Simulation tests
+ */
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Selects the multithreaded simulator implementation.
+ *
+ * Enable() must be called before any node, channel or event is created.
+ */
+class MtpInterface
+{
+  public:
+    /**
+     * \brief Use ns3::MultithreadedSimulatorImpl, with one thread per
+     * hardware thread.
+     */
+    static void Enable();
+    /**
+     * \brief Use ns3::MultithreadedSimulatorImpl.
+     *
+     * \param [in] threads The maximum number of threads, 0 for one per hardware thread.
+     */
+    static void Enable(uint32_t threads);
+};
+
+} // namespace ns3
+
+#endif /* NS3_MTP_INTERFACE_H */
@@ -0,0 +1,634 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "logical-process.h"
+
+#include "ns3/assert.h"
+#include "ns3/channel-list.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+/**
+ * \file
+ * \ingroup mtp
+ * Implementation of class ns3::MultithreadedSimulatorImpl.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/**
+ * \ingroup mtp
+ * The logical process run by this thread, or \c nullptr outside of a
+ * parallel window.
+ */
+thread_local LogicalProcess* g_currentLp = nullptr;
+
+/** The timestamp of an empty event queue. */
+constexpr uint64_t NO_EVENT_TS = std::numeric_limits<uint64_t>::max();
+
+/** The lookahead when no channel links different logical processes. */
+constexpr uint64_t NO_LOOKAHEAD = std::numeric_limits<int64_t>::max();
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads running the simulation, "
+                          "0 to use one thread per hardware thread.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_lookahead(NO_LOOKAHEAD),
+      m_partitioned(false),
+      m_stop(false),
+      m_maxThreads(0),
+      m_round(0),
+      m_task(PROCESS),
+      m_windowEnd(0),
+      m_nextLp(0),
+      m_doneLps(0)
+{
+    NS_LOG_FUNCTION(this);
+    // The public logical process
+    m_lps.push_back(std::make_unique<LogicalProcess>());
+    m_mainThreadId = std::this_thread::get_id();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& lp : m_lps)
+    {
+        lp->Clear();
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    m_schedulerFactory = schedulerFactory;
+    for (auto& lp : m_lps)
+    {
+        lp->SetScheduler(schedulerFactory.Create<Scheduler>());
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetLogicalProcess(uint32_t context) const
+{
+    if (context < m_nodeLp.size())
+    {
+        return m_lps[m_nodeLp[context]].get();
+    }
+    return m_lps[0].get();
+}
+
+LogicalProcess*
+MultithreadedSimulatorImpl::GetCurrentLogicalProcess() const
+{
+    if (g_currentLp != nullptr)
+    {
+        return g_currentLp;
+    }
+    return m_lps[0].get();
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    m_partitioned = true;
+    uint32_t nNodes = NodeList::GetNNodes();
+
+    // Group the nodes which can not run in parallel, with a union-find
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t i) {
+        while (parent[i] != i)
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    // The nodes and the minimum delay of the channels which may be cut
+    std::vector<std::pair<std::vector<uint32_t>, uint64_t>> links;
+    for (auto i = ChannelList::Begin(); i != ChannelList::End(); ++i)
+    {
+        Ptr<Channel> channel = *i;
+        std::vector<uint32_t> nodes;
+        for (std::size_t j = 0; j < channel->GetNDevices(); ++j)
+        {
+            Ptr<NetDevice> device = channel->GetDevice(j);
+            if (device && device->GetNode())
+            {
+                nodes.push_back(device->GetNode()->GetId());
+            }
+        }
+        if (nodes.size() < 2)
+        {
+            continue;
+        }
+        Time delay = channel->GetMinimumDelay();
+        if (delay.IsStrictlyPositive())
+        {
+            links.emplace_back(nodes, delay.GetTimeStep());
+        }
+        else
+        {
+            for (auto node : nodes)
+            {
+                parent[find(node)] = find(nodes.front());
+            }
+        }
+    }
+
+    m_lookahead = NO_LOOKAHEAD;
+    for (const auto& [nodes, delay] : links)
+    {
+        for (auto node : nodes)
+        {
+            if (find(node) != find(nodes.front()))
+            {
+                m_lookahead = std::min(m_lookahead, delay);
+                break;
+            }
+        }
+    }
+
+    // One logical process per group, each one starting where the public
+    // one stands
+    LogicalProcess* pub = m_lps[0].get();
+    uint32_t uid = pub->AllocateUid();
+    std::vector<uint32_t> groupLp(nNodes, 0);
+    m_nodeLp.resize(nNodes);
+    for (uint32_t i = 0; i < nNodes; ++i)
+    {
+        uint32_t root = find(i);
+        if (groupLp[root] == 0)
+        {
+            auto lp = std::make_unique<LogicalProcess>();
+            lp->SetScheduler(m_schedulerFactory.Create<Scheduler>());
+            lp->SetNextUid(uid);
+            lp->SetCurrentTs(pub->GetCurrentTs());
+            groupLp[root] = m_lps.size();
+            m_lps.push_back(std::move(lp));
+        }
+        m_nodeLp[i] = groupLp[root];
+    }
+
+    // Move the events of the nodes to their logical process
+    pub->ReceiveMessages();
+    std::vector<Scheduler::Event> events;
+    while (!pub->IsEmpty())
+    {
+        events.push_back(pub->RemoveNext());
+    }
+    for (const auto& ev : events)
+    {
+        GetLogicalProcess(ev.key.m_context)->Insert(ev);
+    }
+
+    NS_LOG_INFO("Partitioned " << nNodes << " nodes into " << GetNPartitions()
+                               << " logical processes, lookahead " << GetLookahead());
+}
+
+void
+MultithreadedSimulatorImpl::StartThreads()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nThreads = m_maxThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = std::min<uint32_t>(nThreads, GetNPartitions());
+    // The main thread is one of them
+    for (uint32_t i = 1; i < nThreads; ++i)
+    {
+        m_threads.emplace_back(&MultithreadedSimulatorImpl::WorkerLoop, this, m_round.load());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StopThreads()
+{
+    NS_LOG_FUNCTION(this);
+    m_task.store(EXIT, std::memory_order_relaxed);
+    m_round.fetch_add(1, std::memory_order_release);
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+    m_threads.clear();
+}
+
+void
+MultithreadedSimulatorImpl::RunTask(Task task, uint64_t end)
+{
+    m_task.store(task, std::memory_order_relaxed);
+    m_windowEnd.store(end, std::memory_order_relaxed);
+    m_doneLps.store(0, std::memory_order_relaxed);
+    // Skip the public logical process; the workers pick up the task
+    // parameters along with a logical process index
+    m_nextLp.store(1, std::memory_order_release);
+    m_round.fetch_add(1, std::memory_order_release);
+
+    DoTask();
+    while (m_doneLps.load(std::memory_order_acquire) < GetNPartitions())
+    {
+        std::this_thread::yield();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DoTask()
+{
+    uint32_t i;
+    while ((i = m_nextLp.fetch_add(1, std::memory_order_acquire)) < m_lps.size())
+    {
+        LogicalProcess* lp = m_lps[i].get();
+        g_currentLp = lp;
+        if (m_task.load(std::memory_order_relaxed) == PROCESS)
+        {
+            lp->ProcessUntil(m_windowEnd.load(std::memory_order_relaxed), m_stop);
+        }
+        else
+        {
+            lp->ReceiveMessages();
+        }
+        m_doneLps.fetch_add(1, std::memory_order_release);
+    }
+    g_currentLp = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop(uint64_t round)
+{
+    while (true)
+    {
+        uint64_t current;
+        while ((current = m_round.load(std::memory_order_acquire)) == round)
+        {
+            std::this_thread::yield();
+        }
+        round = current;
+        if (m_task.load(std::memory_order_relaxed) == EXIT)
+        {
+            return;
+        }
+        DoTask();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    for (const auto& lp : m_lps)
+    {
+        if (!lp->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    // Set the current threadId as the main threadId
+    m_mainThreadId = std::this_thread::get_id();
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    m_stop = false;
+    StartThreads();
+
+    LogicalProcess* pub = m_lps[0].get();
+    while (true)
+    {
+        pub->ReceiveMessages();
+        uint64_t nextPublic = pub->GetNextTs();
+        uint64_t nextOthers = NO_EVENT_TS;
+        for (std::size_t i = 1; i < m_lps.size(); ++i)
+        {
+            nextOthers = std::min(nextOthers, m_lps[i]->GetNextTs());
+        }
+        if (m_stop || (nextPublic == NO_EVENT_TS && nextOthers == NO_EVENT_TS))
+        {
+            break;
+        }
+
+        if (nextPublic <= nextOthers)
+        {
+            // The public events run alone, and can reach any node
+            pub->ProcessUntil(nextPublic + 1, m_stop);
+        }
+        else
+        {
+            uint64_t end = NO_EVENT_TS;
+            if (m_lookahead < NO_EVENT_TS - nextOthers)
+            {
+                end = nextOthers + m_lookahead;
+            }
+            RunTask(PROCESS, std::min(end, nextPublic));
+            RunTask(RECEIVE, 0);
+        }
+    }
+    StopThreads();
+
+    // Between two runs, the simulation time is the one of the
+    // logical process which went the farthest
+    uint64_t now = pub->GetCurrentTs();
+    for (const auto& lp : m_lps)
+    {
+        now = std::max(now, lp->GetCurrentTs());
+    }
+    pub->SetCurrentTs(now);
+
+    // If the simulator stopped naturally by lack of events, make a
+    // consistency test to check that we didn't lose any events along the way.
+    for (const auto& lp : m_lps)
+    {
+        NS_ASSERT(m_stop || lp->GetUnscheduledEvents() == 0);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    LogicalProcess* lp = GetCurrentLogicalProcess();
+    Time tAbsolute = delay + TimeStep(lp->GetCurrentTs());
+
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = (uint64_t)tAbsolute.GetTimeStep();
+    ev.key.m_context = lp->GetContext();
+    ev.key.m_uid = lp->AllocateUid();
+    lp->Insert(ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(),
+                  "MultithreadedSimulatorImpl::ScheduleWithContext(): Negative delay");
+
+    LogicalProcess* current = GetCurrentLogicalProcess();
+    LogicalProcess* target = GetLogicalProcess(context);
+    Time tAbsolute = delay + TimeStep(current->GetCurrentTs());
+
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = (uint64_t)tAbsolute.GetTimeStep();
+    ev.key.m_context = context;
+    ev.key.m_uid = target->AllocateUid();
+    if (target == current || current == m_lps[0].get())
+    {
+        // Either a local event, or the other logical processes are idle
+        target->Insert(ev);
+    }
+    else
+    {
+        NS_ASSERT_MSG((uint64_t)delay.GetTimeStep() >= m_lookahead,
+                      "MultithreadedSimulatorImpl::ScheduleWithContext(): delay "
+                          << delay << " to node " << context << " is below the lookahead "
+                          << GetLookahead());
+        target->Enqueue(ev);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id() && g_currentLp == nullptr,
+                  "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+    EventId id(Ptr<EventImpl>(event, false),
+               m_lps[0]->GetCurrentTs(),
+               0xffffffff,
+               EventId::UID::DESTROY);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrentLogicalProcess()->GetCurrentTs());
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    else
+    {
+        return TimeStep(id.GetTs() - GetCurrentLogicalProcess()->GetCurrentTs());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    GetLogicalProcess(id.GetContext())->Remove(id);
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return GetLogicalProcess(id.GetContext())->IsExpired(id);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrentLogicalProcess()->GetContext();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->GetEventCount();
+    }
+    return count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions() const
+{
+    return m_lps.size() - 1;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return TimeStep(m_lookahead);
+}
+
+} // namespace ns3
@@ -0,0 +1,195 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mtp
+ * Declaration of class ns3::MultithreadedSimulatorImpl.
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/object-factory.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+class LogicalProcess;
+
+/**
+ * \ingroup mtp
+ *
+ * \brief Shared-memory parallel simulator implementation.
+ *
+ * At the first call to Run(), the nodes are partitioned into logical
+ * processes: two nodes attached to a channel whose
+ * Channel::GetMinimumDelay() is zero end up in the same logical process.
+ * The smallest minimum delay of the channels linking different logical
+ * processes is the lookahead.  The logical processes then run in parallel
+ * in windows of one lookahead, as in a conservative, synchronous parallel
+ * simulation: an event run inside a window can only schedule events on
+ * another logical process after the end of the window.
+ *
+ * The events with a context which is not a node id, such as the events
+ * scheduled with Simulator::Schedule before the simulation starts, belong
+ * to a public logical process, and run alone with all the other logical
+ * processes waiting.
+ *
+ * Since the logical processes share the address space, models must not
+ * share mutable state across partitions.  Events scheduled at the same
+ * time on a logical process by different logical processes run in an
+ * unspecified order.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * \returns The number of logical processes running in parallel, which is
+     * zero until the simulation has started.
+     */
+    uint32_t GetNPartitions() const;
+    /**
+     * \returns The lookahead between the logical processes, which is the
+     * largest time value until the simulation has started.
+     */
+    Time GetLookahead() const;
+
+  private:
+    void DoDispose() override;
+
+    /** Split the nodes into logical processes, and move their events. */
+    void Partition();
+    /**
+     * Get the logical process running the events of a context.
+     *
+     * \param [in] context The event context.
+     * \returns The logical process.
+     */
+    LogicalProcess* GetLogicalProcess(uint32_t context) const;
+    /** \returns The logical process of the calling thread. */
+    LogicalProcess* GetCurrentLogicalProcess() const;
+
+    /** The work done by the threads on each logical process. */
+    enum Task
+    {
+        PROCESS, //!< Run the events of the current window.
+        RECEIVE, //!< Move the events received into the event queues.
+        EXIT     //!< Terminate the worker threads.
+    };
+
+    /** Start the worker threads. */
+    void StartThreads();
+    /** Stop and join the worker threads. */
+    void StopThreads();
+    /**
+     * Run a task on all the logical processes but the public one, and wait
+     * for its completion.
+     *
+     * \param [in] task The task.
+     * \param [in] end The end of the window, for the PROCESS task.
+     */
+    void RunTask(Task task, uint64_t end);
+    /** Run the task on the logical processes left. */
+    void DoTask();
+    /**
+     * The worker threads main loop.
+     *
+     * \param [in] round The task round current when the thread started.
+     */
+    void WorkerLoop(uint64_t round);
+
+    /**
+     * The logical processes, the public one is the first one.
+     * Logical processes are only created or removed outside of Run().
+     */
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps;
+    /** The index in m_lps of the logical process of each node. */
+    std::vector<uint32_t> m_nodeLp;
+    /** The factory of the event queue of the logical processes. */
+    ObjectFactory m_schedulerFactory;
+    /** Lookahead between the logical processes, in time steps. */
+    uint64_t m_lookahead;
+    /** Flag \c true once the nodes have been partitioned. */
+    bool m_partitioned;
+
+    /** Container type for the events to run at Simulator::Destroy() */
+    typedef std::list<EventId> DestroyEvents;
+    /** The container of events to run at Destroy. */
+    DestroyEvents m_destroyEvents;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+
+    /** Maximum number of threads, including the main one. */
+    uint32_t m_maxThreads;
+    /** The worker threads. */
+    std::vector<std::thread> m_threads;
+    /** Incremented to start a new task. */
+    std::atomic<uint64_t> m_round;
+    /** The current task. */
+    std::atomic<Task> m_task;
+    /** The end of the current window, in time steps. */
+    std::atomic<uint64_t> m_windowEnd;
+    /** Index in m_lps of the next logical process to pick up. */
+    std::atomic<uint32_t> m_nextLp;
+    /** Number of logical processes done with the current task. */
+    std::atomic<uint32_t> m_doneLps;
+
+    /** Main execution thread. */
+    std::thread::id m_mainThreadId;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
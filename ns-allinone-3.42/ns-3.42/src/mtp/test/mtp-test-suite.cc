@@ -0,0 +1,239 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/config.h"
+#include "ns3/mtp-interface.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mtp-tests
+ * Multithreaded parallel simulation test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief Pass tokens around a ring of nodes, and check that the
+ * multithreaded simulator delivers them as the default one does.
+ *
+ * The ring channels have different delays; one of them has no delay, so
+ * that its two nodes must share a logical process.
+ */
+class MtpRingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param threads The maximum number of threads.
+     */
+    MtpRingTestCase(uint32_t threads);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** The outcome of a simulation. */
+    struct Outcome
+    {
+        std::vector<uint64_t> received; //!< Tokens received by each node.
+        std::vector<int64_t> times;     //!< Sum of the reception times, per node.
+        uint64_t events;                //!< Number of events run.
+        Time end;                       //!< Time of the last event.
+    };
+
+    /**
+     * Build the ring and run the simulation.
+     *
+     * \param [in] simulatorType The simulator implementation.
+     * \returns The outcome of the simulation.
+     */
+    Outcome RunRing(const std::string& simulatorType);
+
+    /**
+     * Receive a token, and pass it on after a processing delay.
+     *
+     * \param [in] device The receiving device.
+     * \param [in] packet The token; its size is the number of hops left.
+     * \param [in] protocol The protocol number.
+     * \param [in] from The sender address.
+     * \returns \c true.
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    /**
+     * Send a token to the next node of the ring.
+     *
+     * \param [in] node The sending node.
+     * \param [in] hops The number of hops left.
+     */
+    void Send(uint32_t node, uint32_t hops);
+
+    uint32_t m_threads;                   //!< The maximum number of threads.
+    std::vector<Ptr<NetDevice>> m_next;   //!< The device of each node towards the next one.
+    Outcome m_outcome;                    //!< The outcome of the current simulation.
+    uint32_t m_partitions;                //!< The number of logical processes.
+    Time m_lookahead;                     //!< The lookahead.
+    static constexpr uint32_t N_NODES = 8; //!< The number of nodes in the ring.
+};
+
+MtpRingTestCase::MtpRingTestCase(uint32_t threads)
+    : TestCase("Check token passing on a ring with " + std::to_string(threads) + " threads"),
+      m_threads(threads),
+      m_partitions(0)
+{
+}
+
+bool
+MtpRingTestCase::Receive(Ptr<NetDevice> device [[maybe_unused]],
+                         Ptr<const Packet> packet,
+                         uint16_t protocol [[maybe_unused]],
+                         const Address& from [[maybe_unused]])
+{
+    uint32_t node = Simulator::GetContext();
+    m_outcome.received[node]++;
+    m_outcome.times[node] += Simulator::Now().GetNanoSeconds();
+    if (packet->GetSize() > 1)
+    {
+        Simulator::Schedule(MicroSeconds(10),
+                            &MtpRingTestCase::Send,
+                            this,
+                            node,
+                            packet->GetSize() - 1);
+    }
+    return true;
+}
+
+void
+MtpRingTestCase::Send(uint32_t node, uint32_t hops)
+{
+    m_next[node]->Send(Create<Packet>(hops), m_next[node]->GetBroadcast(), 0);
+}
+
+MtpRingTestCase::Outcome
+MtpRingTestCase::RunRing(const std::string& simulatorType)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(simulatorType));
+
+    m_outcome.received.assign(N_NODES, 0);
+    m_outcome.times.assign(N_NODES, 0);
+    m_next.assign(N_NODES, nullptr);
+
+    NodeContainer nodes;
+    nodes.Create(N_NODES);
+    SimpleNetDeviceHelper simple;
+    simple.SetNetDevicePointToPointMode(true);
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Time delay = i == 3 ? Time(0) : MilliSeconds(1) + MicroSeconds(100 * i);
+        simple.SetChannelAttribute("Delay", TimeValue(delay));
+        NetDeviceContainer devices =
+            simple.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % N_NODES)));
+        for (uint32_t j = 0; j < devices.GetN(); ++j)
+        {
+            devices.Get(j)->SetReceiveCallback(MakeCallback(&MtpRingTestCase::Receive, this));
+        }
+        m_next[i] = devices.Get(0);
+    }
+
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        Simulator::ScheduleWithContext(i,
+                                       MicroSeconds(7 * i),
+                                       &MtpRingTestCase::Send,
+                                       this,
+                                       i,
+                                       100);
+    }
+    Simulator::Run();
+
+    m_outcome.events = Simulator::GetEventCount();
+    m_outcome.end = Simulator::Now();
+    Ptr<MultithreadedSimulatorImpl> impl =
+        DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    if (impl)
+    {
+        m_partitions = impl->GetNPartitions();
+        m_lookahead = impl->GetLookahead();
+    }
+    Simulator::Destroy();
+    m_next.clear();
+    return m_outcome;
+}
+
+void
+MtpRingTestCase::DoRun()
+{
+    Outcome reference = RunRing("ns3::DefaultSimulatorImpl");
+    MtpInterface::Enable(m_threads);
+    Outcome outcome = RunRing("ns3::MultithreadedSimulatorImpl");
+
+    // Nodes 3 and 4, linked by a channel with no delay, share a partition
+    NS_TEST_EXPECT_MSG_EQ(m_partitions, N_NODES - 1, "Wrong number of logical processes");
+    NS_TEST_EXPECT_MSG_EQ(m_lookahead, MilliSeconds(1), "Wrong lookahead");
+    for (uint32_t i = 0; i < N_NODES; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(outcome.received[i],
+                              reference.received[i],
+                              "Wrong number of tokens received by node " << i);
+        NS_TEST_EXPECT_MSG_EQ(outcome.times[i],
+                              reference.times[i],
+                              "Wrong reception times on node " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(outcome.events, reference.events, "Wrong number of events");
+    NS_TEST_EXPECT_MSG_EQ(outcome.end, reference.end, "Wrong end of simulation");
+}
+
+void
+MtpRingTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup mtp-tests
+ *
+ * \brief Multithreaded parallel simulation test suite.
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", Type::UNIT)
+{
+    AddTestCase(new MtpRingTestCase(1), TestCase::Duration::QUICK);
+    AddTestCase(new MtpRingTestCase(2), TestCase::Duration::QUICK);
+    AddTestCase(new MtpRingTestCase(4), TestCase::Duration::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,44 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/core-module.h"
+#include "ns3/netanim-module.h"
+
+// Convert a binary trace written by AnimationInterface::EnableBinaryOutput
+// to the XML trace read by NetAnim.
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("NetAnimBinaryToXml");
+
+int
+main(int argc, char* argv[])
+{
+    std::string input = "animation.bin";
+    std::string output = "animation.xml";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("input", "Binary trace written by AnimationInterface", input);
+    cmd.AddValue("output", "XML trace for NetAnim", output);
+    cmd.Parse(argc, argv);
+
+    if (!AnimationInterface::ConvertBinaryTrace(input, output))
+    {
+        NS_LOG_UNCOND("Unable to convert " << input << " to " << output);
+        return 1;
+    }
+    return 0;
+}
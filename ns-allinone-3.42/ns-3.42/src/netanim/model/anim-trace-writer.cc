@@ -0,0 +1,202 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "anim-trace-writer.h"
+
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AnimTraceWriter");
+
+AnimTraceWriter::AnimTraceWriter(FILE* f, uint32_t bufferSize)
+    : m_f(f),
+      m_bufferSize(bufferSize),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this << bufferSize);
+    m_buffer.reserve(m_bufferSize);
+    m_thread = std::thread(&AnimTraceWriter::WriterLoop, this);
+}
+
+AnimTraceWriter::~AnimTraceWriter()
+{
+    Close();
+}
+
+void
+AnimTraceWriter::Write(const char* data, uint32_t count)
+{
+    m_buffer.append(data, count);
+    if (m_buffer.size() < m_bufferSize)
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this] { return m_pending.size() < MAX_PENDING_BUFFERS; });
+    m_pending.push_back(std::move(m_buffer));
+    m_buffer = std::string();
+    m_buffer.reserve(m_bufferSize);
+    m_changed.notify_all();
+}
+
+void
+AnimTraceWriter::Close()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_buffer.empty())
+        {
+            m_pending.push_back(std::move(m_buffer));
+            m_buffer = std::string();
+        }
+        m_stop = true;
+        m_changed.notify_all();
+    }
+    m_thread.join();
+    std::fflush(m_f);
+}
+
+void
+AnimTraceWriter::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_changed.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty())
+        {
+            return;
+        }
+        std::string buffer = std::move(m_pending.front());
+        lock.unlock();
+        if (std::fwrite(buffer.data(), 1, buffer.size(), m_f) != buffer.size())
+        {
+            NS_LOG_WARN("Unable to write the animation trace file");
+        }
+        lock.lock();
+        m_pending.pop_front();
+        m_changed.notify_all();
+    }
+}
+
+const std::string AnimBinaryTrace::MAGIC = "NS3ANIM\x01";
+
+void
+AnimBinaryTrace::PutUnsigned(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void
+AnimBinaryTrace::PutSigned(std::string& out, int64_t value)
+{
+    PutUnsigned(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void
+AnimBinaryTrace::PutDouble(std::string& out, double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        out.push_back(static_cast<char>(bits >> (8 * i)));
+    }
+}
+
+void
+AnimBinaryTrace::PutString(std::string& out, const std::string& value)
+{
+    PutUnsigned(out, value.size());
+    out.append(value);
+}
+
+bool
+AnimBinaryTrace::GetUnsigned(std::istream& is, uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        int byte = is.get();
+        if (byte == std::istream::traits_type::eof())
+        {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+AnimBinaryTrace::GetSigned(std::istream& is, int64_t& value)
+{
+    uint64_t zigzag;
+    if (!GetUnsigned(is, zigzag))
+    {
+        return false;
+    }
+    value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+    return true;
+}
+
+bool
+AnimBinaryTrace::GetDouble(std::istream& is, double& value)
+{
+    unsigned char bytes[8];
+    if (!is.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+    {
+        return false;
+    }
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool
+AnimBinaryTrace::GetString(std::istream& is, std::string& value)
+{
+    uint64_t size;
+    if (!GetUnsigned(is, size))
+    {
+        return false;
+    }
+    value.resize(size);
+    return size == 0 || static_cast<bool>(is.read(&value[0], size));
+}
+
+} // namespace ns3
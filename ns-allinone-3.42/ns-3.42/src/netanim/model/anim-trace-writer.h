@@ -0,0 +1,166 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef ANIM_TRACE_WRITER_H
+#define ANIM_TRACE_WRITER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+
+namespace ns3
+{
+
+/**
+ * \ingroup netanim
+ *
+ * \brief Writes the animation trace file from a separate thread.
+ *
+ * The data is appended to a buffer, which is handed to the writer thread
+ * when it is full. At most a few buffers are waiting to be written: when
+ * the disk can not keep up, Write blocks until a buffer is written, so that
+ * the memory used stays bounded.
+ */
+class AnimTraceWriter
+{
+  public:
+    /**
+     * \brief Constructor, starting the writer thread
+     * \param f the file to write to, which must stay open until Close returns
+     * \param bufferSize the size of the buffers handed to the writer thread
+     */
+    AnimTraceWriter(FILE* f, uint32_t bufferSize);
+    /// Destructor, calling Close
+    ~AnimTraceWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AnimTraceWriter(const AnimTraceWriter&) = delete;
+    AnimTraceWriter& operator=(const AnimTraceWriter&) = delete;
+
+    /**
+     * \brief Append data to the trace file
+     * \param data the data
+     * \param count the number of bytes of the data
+     */
+    void Write(const char* data, uint32_t count);
+
+    /// Write the buffered data and stop the writer thread
+    void Close();
+
+  private:
+    /// Loop of the writer thread
+    void WriterLoop();
+
+    /// Maximum number of buffers waiting to be written
+    static constexpr std::size_t MAX_PENDING_BUFFERS = 4;
+
+    FILE* m_f;                         ///< file written
+    uint32_t m_bufferSize;             ///< size of the buffers
+    std::string m_buffer;              ///< buffer being filled
+    std::mutex m_mutex;                ///< mutex protecting the pending buffers
+    std::condition_variable m_changed; ///< signals a change of the pending buffers
+    std::deque<std::string> m_pending; ///< buffers waiting to be written
+    bool m_stop;                       ///< whether the thread must stop when idle
+    std::thread m_thread;              ///< writer thread
+};
+
+/**
+ * \ingroup netanim
+ *
+ * \brief Encoding of the records of the binary animation trace.
+ *
+ * A binary trace starts with MAGIC, followed by records made of a type
+ * byte and of fields encoded as LEB128 varints, zigzag-encoded when signed.
+ * Times are in nanoseconds, each record storing the difference with the
+ * time of the previous record, and packet times the difference with the
+ * time of their record. Positions are in micrometers, each record storing
+ * the difference with the previous position of the node. The elements
+ * without binary encoding are stored verbatim in XML records.
+ * AnimationInterface::ConvertBinaryTrace turns a binary trace into the XML
+ * trace read by NetAnim.
+ */
+class AnimBinaryTrace
+{
+  public:
+    /// Record types
+    enum RecordType : uint8_t
+    {
+        XML = 0,        ///< verbatim XML element
+        POSITION = 1,   ///< node position update
+        PACKET = 2,     ///< wired packet
+        PACKET_REF = 3, ///< wireless packet transmission
+        PACKET_RX = 4,  ///< wireless packet reception
+        COUNTER = 5,    ///< node counter update
+    };
+
+    /// Signature at the beginning of the binary traces
+    static const std::string MAGIC;
+
+    /**
+     * \param out the string to append to
+     * \param value the value to append
+     */
+    static void PutUnsigned(std::string& out, uint64_t value);
+    /**
+     * \param out the string to append to
+     * \param value the value to append
+     */
+    static void PutSigned(std::string& out, int64_t value);
+    /**
+     * \param out the string to append to
+     * \param value the value to append
+     */
+    static void PutDouble(std::string& out, double value);
+    /**
+     * \param out the string to append to
+     * \param value the string to append, preceded by its length
+     */
+    static void PutString(std::string& out, const std::string& value);
+
+    /**
+     * \param is the stream to read from
+     * \param value the value read
+     * \return false at the end of the stream
+     */
+    static bool GetUnsigned(std::istream& is, uint64_t& value);
+    /**
+     * \param is the stream to read from
+     * \param value the value read
+     * \return false at the end of the stream
+     */
+    static bool GetSigned(std::istream& is, int64_t& value);
+    /**
+     * \param is the stream to read from
+     * \param value the value read
+     * \return false at the end of the stream
+     */
+    static bool GetDouble(std::istream& is, double& value);
+    /**
+     * \param is the stream to read from
+     * \param value the string read
+     * \return false at the end of the stream
+     */
+    static bool GetString(std::istream& is, std::string& value);
+};
+
+} // namespace ns3
+
+#endif /* ANIM_TRACE_WRITER_H */
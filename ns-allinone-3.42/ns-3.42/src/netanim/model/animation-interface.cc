@@ -21,6 +21,7 @@
 
 // Interface between ns-3 and the network animator
 
+#include <cmath>
 #include <cstdio>
 #ifndef WIN32
 #include <unistd.h>
@@ -89,7 +90,11 @@ AnimationInterface::AnimationInterface(const std::string fn)
       m_routingStopTime(Seconds(0)),
       m_routingFileName(""),
       m_routingPollInterval(Seconds(5)),
-      m_trackPackets(true)
+      m_trackPackets(true),
+      m_packetSamplingInterval(1),
+      m_bufferSize(0),
+      m_binaryOutput(false),
+      m_binaryTime(0)
 {
     initialized = true;
     StartAnimation();
@@ -291,6 +296,49 @@ AnimationInterface::EnablePacketMetadata(bool enable)
     }
 }
 
+void
+AnimationInterface::EnableBufferedOutput(uint32_t bufferSize)
+{
+    NS_ASSERT_MSG(bufferSize > 0, "The buffers can not be empty");
+    m_bufferSize = bufferSize;
+    if (m_f && !m_traceWriter)
+    {
+        m_traceWriter = std::make_unique<AnimTraceWriter>(m_f, m_bufferSize);
+    }
+}
+
+void
+AnimationInterface::EnableBinaryOutput()
+{
+    if (m_binaryOutput)
+    {
+        return;
+    }
+    // restart the trace file from scratch, in the binary format
+    if (m_f)
+    {
+        m_traceWriter.reset();
+        std::fclose(m_f);
+        m_f = nullptr;
+    }
+    m_binaryOutput = true;
+    StartAnimation(true);
+}
+
+void
+AnimationInterface::SetPacketSamplingInterval(uint32_t interval)
+{
+    NS_ASSERT_MSG(interval > 0, "The sampling interval must be at least 1");
+    m_packetSamplingInterval = interval;
+}
+
+bool
+AnimationInterface::SamplePacket(uint32_t nodeId)
+{
+    return m_packetSamplingInterval == 1 ||
+           m_nodeTxPackets[nodeId]++ % m_packetSamplingInterval == 0;
+}
+
 bool
 AnimationInterface::IsInitialized()
 {
@@ -538,6 +586,12 @@ AnimationInterface::WriteN(const std::string& st, FILE* f)
     {
         m_writeCallback(st.c_str());
     }
+    if (f == m_f && m_binaryOutput)
+    {
+        std::string record(1, AnimBinaryTrace::XML);
+        AnimBinaryTrace::PutString(record, st);
+        return WriteN(record.data(), record.size(), f);
+    }
     return WriteN(st.c_str(), st.length(), f);
 }
 
@@ -548,6 +602,11 @@ AnimationInterface::WriteN(const char* data, uint32_t count, FILE* f)
     {
         return 0;
     }
+    if (f == m_f && m_traceWriter)
+    {
+        m_traceWriter->Write(data, count);
+        return count;
+    }
     // Write count bytes to h from data
     uint32_t nLeft = count;
     const char* p = data;
@@ -834,6 +893,10 @@ AnimationInterface::DevTxTrace(std::string context,
     double lbTx = (now + txTime).GetSeconds();
     double fbRx = (now + rxTime - txTime).GetSeconds();
     double lbRx = (now + rxTime).GetSeconds();
+    if (!SamplePacket(tx->GetNode()->GetId()))
+    {
+        return;
+    }
     CheckMaxPktsPerTraceFile();
     WriteXmlP("p",
               tx->GetNode()->GetId(),
@@ -1131,7 +1194,7 @@ AnimationInterface::LteSpectrumPhyTxStart(std::string context, Ptr<const PacketB
         AnimPacketInfo pktInfo(ndev, Simulator::Now());
         AddByteTag(gAnimUid, p);
         AddPendingPacket(AnimationInterface::LTE, gAnimUid, pktInfo);
-        OutputWirelessPacketTxInfo(p, pktInfo, gAnimUid);
+        OutputWirelessPacketTxInfo(p, m_pendingLtePackets[gAnimUid], gAnimUid);
     }
 }
 
@@ -1180,6 +1243,7 @@ AnimationInterface::CsmaPhyTxBeginTrace(std::string context, Ptr<const Packet> p
     AddByteTag(gAnimUid, p);
     UpdatePosition(ndev);
     AnimPacketInfo pktInfo(ndev, Simulator::Now());
+    pktInfo.m_traced = SamplePacket(ndev->GetNode()->GetId());
     AddPendingPacket(AnimationInterface::CSMA, gAnimUid, pktInfo);
 }
 
@@ -1252,7 +1316,6 @@ AnimationInterface::OutputWirelessPacketTxInfo(Ptr<const Packet> p,
                                                AnimPacketInfo& pktInfo,
                                                uint64_t animUid)
 {
-    CheckMaxPktsPerTraceFile();
     uint32_t nodeId = 0;
     if (pktInfo.m_txnd)
     {
@@ -1262,6 +1325,12 @@ AnimationInterface::OutputWirelessPacketTxInfo(Ptr<const Packet> p,
     {
         nodeId = pktInfo.m_txNodeId;
     }
+    pktInfo.m_traced = SamplePacket(nodeId);
+    if (!pktInfo.m_traced)
+    {
+        return;
+    }
+    CheckMaxPktsPerTraceFile();
     WriteXmlPRef(animUid,
                  nodeId,
                  pktInfo.m_fbTx,
@@ -1273,6 +1342,10 @@ AnimationInterface::OutputWirelessPacketRxInfo(Ptr<const Packet> p,
                                                AnimPacketInfo& pktInfo,
                                                uint64_t animUid)
 {
+    if (!pktInfo.m_traced)
+    {
+        return;
+    }
     CheckMaxPktsPerTraceFile();
     uint32_t rxId = pktInfo.m_rxnd->GetNode()->GetId();
     WriteXmlP(animUid, "wpr", rxId, pktInfo.m_fbRx, pktInfo.m_lbRx);
@@ -1281,6 +1354,10 @@ AnimationInterface::OutputWirelessPacketRxInfo(Ptr<const Packet> p,
 void
 AnimationInterface::OutputCsmaPacket(Ptr<const Packet> p, AnimPacketInfo& pktInfo)
 {
+    if (!pktInfo.m_traced)
+    {
+        return;
+    }
     CheckMaxPktsPerTraceFile();
     NS_ASSERT(pktInfo.m_txnd);
     uint32_t nodeId = pktInfo.m_txnd->GetNode()->GetId();
@@ -1453,6 +1530,7 @@ AnimationInterface::StopAnimation(bool onlyAnimation)
     {
         // Terminate the anim element
         WriteXmlClose("anim");
+        m_traceWriter.reset();
         std::fclose(m_f);
         m_f = nullptr;
     }
@@ -1474,6 +1552,16 @@ AnimationInterface::StartAnimation(bool restart)
     m_currentPktCount = 0;
     m_started = true;
     SetOutputFile(m_outputFileName);
+    if (m_bufferSize > 0)
+    {
+        m_traceWriter = std::make_unique<AnimTraceWriter>(m_f, m_bufferSize);
+    }
+    if (m_binaryOutput)
+    {
+        m_binaryTime = 0;
+        m_binaryPositions.clear();
+        WriteN(AnimBinaryTrace::MAGIC.data(), AnimBinaryTrace::MAGIC.size(), m_f);
+    }
     WriteXmlAnim();
     WriteNodes();
     WriteNodeColors();
@@ -2091,7 +2179,7 @@ AnimationInterface::SetOutputFile(const std::string& fn, bool routing)
 
     NS_LOG_INFO("Creating new trace file:" << fn);
     FILE* f = nullptr;
-    f = std::fopen(fn.c_str(), "w");
+    f = std::fopen(fn.c_str(), (m_binaryOutput && !routing) ? "wb" : "w");
     if (!f)
     {
         NS_FATAL_ERROR("Unable to open output file:" << fn);
@@ -2542,6 +2630,22 @@ AnimationInterface::WriteXmlRp(uint32_t nodeId,
 
 void
 AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
+{
+    if (m_binaryOutput)
+    {
+        std::string record = StartBinaryRecord(AnimBinaryTrace::PACKET_REF);
+        AnimBinaryTrace::PutUnsigned(record, animUid);
+        AnimBinaryTrace::PutUnsigned(record, fId);
+        AnimBinaryTrace::PutSigned(record, std::llround(fbTx * 1e9) - m_binaryTime);
+        AnimBinaryTrace::PutString(record, metaInfo);
+        WriteN(record.data(), record.size(), m_f);
+        return;
+    }
+    WriteN(GetXmlPRef(animUid, fId, fbTx, metaInfo), m_f);
+}
+
+std::string
+AnimationInterface::GetXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo)
 {
     AnimXmlElement element("pr");
     element.AddAttribute("uId", animUid);
@@ -2551,7 +2655,7 @@ AnimationInterface::WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, st
     {
         element.AddAttribute("meta-info", metaInfo.c_str(), true);
     }
-    WriteN(element.ToString(), m_f);
+    return element.ToString();
 }
 
 void
@@ -2560,13 +2664,33 @@ AnimationInterface::WriteXmlP(uint64_t animUid,
                               uint32_t tId,
                               double fbRx,
                               double lbRx)
+{
+    if (m_binaryOutput && pktType == "wpr")
+    {
+        std::string record = StartBinaryRecord(AnimBinaryTrace::PACKET_RX);
+        AnimBinaryTrace::PutUnsigned(record, animUid);
+        AnimBinaryTrace::PutUnsigned(record, tId);
+        AnimBinaryTrace::PutSigned(record, std::llround(fbRx * 1e9) - m_binaryTime);
+        AnimBinaryTrace::PutSigned(record, std::llround(lbRx * 1e9) - m_binaryTime);
+        WriteN(record.data(), record.size(), m_f);
+        return;
+    }
+    WriteN(GetXmlP(animUid, pktType, tId, fbRx, lbRx), m_f);
+}
+
+std::string
+AnimationInterface::GetXmlP(uint64_t animUid,
+                            std::string pktType,
+                            uint32_t tId,
+                            double fbRx,
+                            double lbRx)
 {
     AnimXmlElement element(pktType);
     element.AddAttribute("uId", animUid);
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    return element.ToString();
 }
 
 void
@@ -2578,6 +2702,32 @@ AnimationInterface::WriteXmlP(std::string pktType,
                               double fbRx,
                               double lbRx,
                               std::string metaInfo)
+{
+    if (m_binaryOutput && pktType == "p")
+    {
+        std::string record = StartBinaryRecord(AnimBinaryTrace::PACKET);
+        AnimBinaryTrace::PutUnsigned(record, fId);
+        AnimBinaryTrace::PutUnsigned(record, tId);
+        for (double t : {fbTx, lbTx, fbRx, lbRx})
+        {
+            AnimBinaryTrace::PutSigned(record, std::llround(t * 1e9) - m_binaryTime);
+        }
+        AnimBinaryTrace::PutString(record, metaInfo);
+        WriteN(record.data(), record.size(), m_f);
+        return;
+    }
+    WriteN(GetXmlP(pktType, fId, fbTx, lbTx, tId, fbRx, lbRx, metaInfo), m_f);
+}
+
+std::string
+AnimationInterface::GetXmlP(std::string pktType,
+                            uint32_t fId,
+                            double fbTx,
+                            double lbTx,
+                            uint32_t tId,
+                            double fbRx,
+                            double lbRx,
+                            std::string metaInfo)
 {
     AnimXmlElement element(pktType);
     element.AddAttribute("fId", fId);
@@ -2590,7 +2740,7 @@ AnimationInterface::WriteXmlP(std::string pktType,
     element.AddAttribute("tId", tId);
     element.AddAttribute("fbRx", fbRx);
     element.AddAttribute("lbRx", lbRx);
-    WriteN(element.ToString(), m_f);
+    return element.ToString();
 }
 
 void
@@ -2639,14 +2789,33 @@ AnimationInterface::WriteXmlUpdateNodeSize(uint32_t nodeId, double width, double
 
 void
 AnimationInterface::WriteXmlUpdateNodePosition(uint32_t nodeId, double x, double y)
+{
+    if (m_binaryOutput)
+    {
+        std::string record = StartBinaryRecord(AnimBinaryTrace::POSITION);
+        auto& last = m_binaryPositions[nodeId];
+        const int64_t microX = std::llround(x * 1e6);
+        const int64_t microY = std::llround(y * 1e6);
+        AnimBinaryTrace::PutUnsigned(record, nodeId);
+        AnimBinaryTrace::PutSigned(record, microX - last.first);
+        AnimBinaryTrace::PutSigned(record, microY - last.second);
+        last = {microX, microY};
+        WriteN(record.data(), record.size(), m_f);
+        return;
+    }
+    WriteN(GetXmlUpdateNodePosition(Simulator::Now().GetSeconds(), nodeId, x, y), m_f);
+}
+
+std::string
+AnimationInterface::GetXmlUpdateNodePosition(double t, uint32_t nodeId, double x, double y)
 {
     AnimXmlElement element("nu");
     element.AddAttribute("p", "p");
-    element.AddAttribute("t", Simulator::Now().GetSeconds());
+    element.AddAttribute("t", t);
     element.AddAttribute("id", nodeId);
     element.AddAttribute("x", x);
     element.AddAttribute("y", y);
-    WriteN(element.ToString(), m_f);
+    return element.ToString();
 }
 
 void
@@ -2680,13 +2849,35 @@ void
 AnimationInterface::WriteXmlUpdateNodeCounter(uint32_t nodeCounterId,
                                               uint32_t nodeId,
                                               double counterValue)
+{
+    if (m_binaryOutput)
+    {
+        std::string record = StartBinaryRecord(AnimBinaryTrace::COUNTER);
+        AnimBinaryTrace::PutUnsigned(record, nodeCounterId);
+        AnimBinaryTrace::PutUnsigned(record, nodeId);
+        AnimBinaryTrace::PutDouble(record, counterValue);
+        WriteN(record.data(), record.size(), m_f);
+        return;
+    }
+    WriteN(GetXmlUpdateNodeCounter(nodeCounterId,
+                                   nodeId,
+                                   Simulator::Now().GetSeconds(),
+                                   counterValue),
+           m_f);
+}
+
+std::string
+AnimationInterface::GetXmlUpdateNodeCounter(uint32_t nodeCounterId,
+                                            uint32_t nodeId,
+                                            double t,
+                                            double counterValue)
 {
     AnimXmlElement element("nc");
     element.AddAttribute("c", nodeCounterId);
     element.AddAttribute("i", nodeId);
-    element.AddAttribute("t", Simulator::Now().GetSeconds());
+    element.AddAttribute("t", t);
     element.AddAttribute("v", counterValue);
-    WriteN(element.ToString(), m_f);
+    return element.ToString();
 }
 
 void
@@ -2719,6 +2910,121 @@ AnimationInterface::WriteXmlNonP2pLinkProperties(uint32_t id,
     WriteN(element.ToString(), m_f);
 }
 
+/***** Binary trace *****/
+
+std::string
+AnimationInterface::StartBinaryRecord(AnimBinaryTrace::RecordType type)
+{
+    const int64_t now = Simulator::Now().GetNanoSeconds();
+    std::string record(1, type);
+    AnimBinaryTrace::PutSigned(record, now - m_binaryTime);
+    m_binaryTime = now;
+    return record;
+}
+
+bool
+AnimationInterface::ConvertBinaryTrace(const std::string& binaryFileName,
+                                       const std::string& xmlFileName)
+{
+    std::ifstream is(binaryFileName, std::ios::binary);
+    std::string magic(AnimBinaryTrace::MAGIC.size(), '\0');
+    if (!is.read(&magic[0], magic.size()) || magic != AnimBinaryTrace::MAGIC)
+    {
+        NS_LOG_WARN(binaryFileName << " is not a binary animation trace");
+        return false;
+    }
+    std::ofstream os(xmlFileName);
+    if (!os)
+    {
+        NS_LOG_WARN("Unable to open " << xmlFileName);
+        return false;
+    }
+
+    int64_t time = 0;
+    std::map<uint32_t, std::pair<int64_t, int64_t>> positions;
+    // packet times are stored relative to the time of their record
+    auto getTime = [&is, &time](double& seconds) {
+        int64_t offset;
+        if (!AnimBinaryTrace::GetSigned(is, offset))
+        {
+            return false;
+        }
+        seconds = (time + offset) / 1e9;
+        return true;
+    };
+    int type;
+    while ((type = is.get()) != std::ifstream::traits_type::eof())
+    {
+        std::string text;
+        if (type == AnimBinaryTrace::XML)
+        {
+            if (!AnimBinaryTrace::GetString(is, text))
+            {
+                return false;
+            }
+            os << text;
+            continue;
+        }
+        int64_t delta;
+        uint64_t first;
+        if (!AnimBinaryTrace::GetSigned(is, delta) || !AnimBinaryTrace::GetUnsigned(is, first))
+        {
+            return false;
+        }
+        time += delta;
+        uint64_t second = 0;
+        double t[4] = {0, 0, 0, 0};
+        bool ok = true;
+        switch (type)
+        {
+        case AnimBinaryTrace::POSITION: {
+            int64_t dx;
+            int64_t dy;
+            ok = AnimBinaryTrace::GetSigned(is, dx) && AnimBinaryTrace::GetSigned(is, dy);
+            auto& position = positions[first];
+            position.first += dx;
+            position.second += dy;
+            text = GetXmlUpdateNodePosition(time / 1e9,
+                                            first,
+                                            position.first / 1e6,
+                                            position.second / 1e6);
+            break;
+        }
+        case AnimBinaryTrace::PACKET: {
+            ok = AnimBinaryTrace::GetUnsigned(is, second) && getTime(t[0]) && getTime(t[1]) &&
+                 getTime(t[2]) && getTime(t[3]) && AnimBinaryTrace::GetString(is, text);
+            text = GetXmlP("p", first, t[0], t[1], second, t[2], t[3], text);
+            break;
+        }
+        case AnimBinaryTrace::PACKET_REF: {
+            ok = AnimBinaryTrace::GetUnsigned(is, second) && getTime(t[0]) &&
+                 AnimBinaryTrace::GetString(is, text);
+            text = GetXmlPRef(first, second, t[0], text);
+            break;
+        }
+        case AnimBinaryTrace::PACKET_RX: {
+            ok = AnimBinaryTrace::GetUnsigned(is, second) && getTime(t[0]) && getTime(t[1]);
+            text = GetXmlP(first, "wpr", second, t[0], t[1]);
+            break;
+        }
+        case AnimBinaryTrace::COUNTER: {
+            ok = AnimBinaryTrace::GetUnsigned(is, second) && AnimBinaryTrace::GetDouble(is, t[0]);
+            text = GetXmlUpdateNodeCounter(first, second, time / 1e9, t[0]);
+            break;
+        }
+        default:
+            NS_LOG_WARN("Unknown record type " << type);
+            return false;
+        }
+        if (!ok)
+        {
+            return false;
+        }
+        os << text;
+    }
+    return true;
+}
+
 /***** AnimXmlElement  *****/
 
 AnimationInterface::AnimXmlElement::AnimXmlElement(std::string tagName, bool emptyElement)
@@ -2883,7 +3189,8 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo()
       m_txNodeId(0),
       m_fbTx(0),
       m_lbTx(0),
-      m_lbRx(0)
+      m_lbRx(0),
+      m_traced(true)
 {
 }
 
@@ -2894,6 +3201,7 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo(const AnimPacketInfo& pInfo)
     m_fbTx = pInfo.m_fbTx;
     m_lbTx = pInfo.m_lbTx;
     m_lbRx = pInfo.m_lbRx;
+    m_traced = pInfo.m_traced;
 }
 
 AnimationInterface::AnimPacketInfo::AnimPacketInfo(Ptr<const NetDevice> txnd,
@@ -2903,7 +3211,8 @@ AnimationInterface::AnimPacketInfo::AnimPacketInfo(Ptr<const NetDevice> txnd,
       m_txNodeId(0),
       m_fbTx(fbTx.GetSeconds()),
       m_lbTx(0),
-      m_lbRx(0)
+      m_lbRx(0),
+      m_traced(true)
 {
     if (!m_txnd)
     {
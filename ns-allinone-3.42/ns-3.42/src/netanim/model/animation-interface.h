@@ -23,6 +23,8 @@
 #ifndef ANIMATION_INTERFACE__H
 #define ANIMATION_INTERFACE__H
 
+#include "anim-trace-writer.h"
+
 #include "ns3/config.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4.h"
@@ -43,6 +45,7 @@
 
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace ns3
@@ -399,6 +402,51 @@ class AnimationInterface
      */
     void EnablePacketMetadata(bool enable = true);
 
+    /**
+     * \brief Write the trace file from a separate thread
+     *
+     * The trace is appended to in-memory buffers, written to the file by
+     * another thread, so that the simulation does not wait for the disk.
+     * The write callback, if any, is still called by the simulation.
+     *
+     * \param bufferSize The size of the buffers handed to the writer thread
+     */
+    void EnableBufferedOutput(uint32_t bufferSize = 1 << 20);
+
+    /**
+     * \brief Write a compact binary trace instead of an XML trace
+     *
+     * Position updates, packets and node counters are written as binary
+     * records, positions as deltas rounded to the micrometer. NetAnim can not
+     * read binary traces: ConvertBinaryTrace turns them into XML traces.
+     * The write callback is not called for the binary records.
+     *
+     * The trace file is restarted in the binary format, hence this method
+     * must be called right after the constructor, before the node counters
+     * and the resources are added.
+     */
+    void EnableBinaryOutput();
+
+    /**
+     * \brief Convert a binary trace into an XML trace readable by NetAnim
+     *
+     * \param binaryFileName The binary trace written with EnableBinaryOutput
+     * \param xmlFileName The XML trace to write
+     * \returns false if the binary trace can not be read or is truncated
+     */
+    static bool ConvertBinaryTrace(const std::string& binaryFileName,
+                                   const std::string& xmlFileName);
+
+    /**
+     * \brief Trace one packet out of every interval packets transmitted by each node
+     *
+     * The other packets are neither written to the trace file nor counted
+     * for SetMaxPktsPerTraceFile.
+     *
+     * \param interval The sampling interval, 1 to trace all the packets
+     */
+    void SetPacketSamplingInterval(uint32_t interval);
+
     /**
      *
      * \brief Get trace file packet count (This used only for testing)
@@ -465,6 +513,7 @@ class AnimationInterface
         double m_fbRx;               ///< fb receive
         double m_lbRx;               ///< lb receive
         Ptr<const NetDevice> m_rxnd; ///< receive device
+        bool m_traced;               ///< whether the packet is written to the trace
         /**
          * Process receive begin
          * \param nd the device
@@ -643,6 +692,16 @@ class AnimationInterface
     static Rectangle* userBoundary;            ///< user boundary
     bool m_trackPackets;                       ///< track packets
 
+    // Output volume
+    uint32_t m_packetSamplingInterval;              ///< one traced packet per interval, per node
+    std::map<uint32_t, uint64_t> m_nodeTxPackets;   ///< packets transmitted per node
+    uint32_t m_bufferSize;                          ///< size of the buffers, 0 if not buffered
+    std::unique_ptr<AnimTraceWriter> m_traceWriter; ///< writer thread of m_f
+    bool m_binaryOutput;                            ///< write a binary trace
+    int64_t m_binaryTime;                           ///< time of the last binary record, in ns
+    std::map<uint32_t, std::pair<int64_t, int64_t>>
+        m_binaryPositions; ///< last position written per node, in micrometers
+
     // Counter ID
     uint32_t m_remainingEnergyCounterId; ///< remaining energy counter ID
 
@@ -882,6 +941,18 @@ class AnimationInterface
     bool IsInTimeWindow();
     /// Check maximum packets per trace file function
     void CheckMaxPktsPerTraceFile();
+    /**
+     * Decide whether to trace a packet transmitted by a node
+     * \param nodeId the transmitting node ID
+     * \returns true if the packet is traced
+     */
+    bool SamplePacket(uint32_t nodeId);
+    /**
+     * Start a binary record at the current time
+     * \param type the record type
+     * \returns the record
+     */
+    std::string StartBinaryRecord(AnimBinaryTrace::RecordType type);
 
     /// Track wifi phy counters function
     void TrackWifiPhyCounters();
@@ -1317,6 +1388,15 @@ class AnimationInterface
      * \param y the Y position
      */
     void WriteXmlUpdateNodePosition(uint32_t nodeId, double x, double y);
+    /**
+     * Get XML update node position function
+     * \param t the time in seconds
+     * \param nodeId the node ID
+     * \param x the X position
+     * \param y the Y position
+     * \returns the XML element
+     */
+    static std::string GetXmlUpdateNodePosition(double t, uint32_t nodeId, double x, double y);
     /**
      * Write XML update node color function
      * \param nodeId the node ID
@@ -1365,6 +1445,18 @@ class AnimationInterface
      * \param value the node counter value
      */
     void WriteXmlUpdateNodeCounter(uint32_t counterId, uint32_t nodeId, double value);
+    /**
+     * Get XML update node counter function
+     * \param counterId the counter ID
+     * \param nodeId the node ID
+     * \param t the time in seconds
+     * \param value the node counter value
+     * \returns the XML element
+     */
+    static std::string GetXmlUpdateNodeCounter(uint32_t counterId,
+                                               uint32_t nodeId,
+                                               double t,
+                                               double value);
     /**
      * Write XML node function
      * \param id the ID
@@ -1415,6 +1507,40 @@ class AnimationInterface
      * \param lbTx the LB transmit
      */
     void WriteXmlP(uint64_t animUid, std::string pktType, uint32_t fId, double fbTx, double lbTx);
+    /**
+     * Get XMLP function
+     * \param pktType the packet type
+     * \param fId the FID
+     * \param fbTx the FB transmit
+     * \param lbTx the LB transmit
+     * \param tId the TID
+     * \param fbRx the FB receive
+     * \param lbRx the LB receive
+     * \param metaInfo the meta info
+     * \returns the XML element
+     */
+    static std::string GetXmlP(std::string pktType,
+                               uint32_t fId,
+                               double fbTx,
+                               double lbTx,
+                               uint32_t tId,
+                               double fbRx,
+                               double lbRx,
+                               std::string metaInfo);
+    /**
+     * Get XMLP function
+     * \param animUid the UID
+     * \param pktType the packet type
+     * \param fId the FID
+     * \param fbTx the FB transmit
+     * \param lbTx the LB transmit
+     * \returns the XML element
+     */
+    static std::string GetXmlP(uint64_t animUid,
+                               std::string pktType,
+                               uint32_t fId,
+                               double fbTx,
+                               double lbTx);
     /**
      * Write XMLP Ref function
      * \param animUid the UID
@@ -1423,6 +1549,18 @@ class AnimationInterface
      * \param metaInfo the meta info
      */
     void WriteXmlPRef(uint64_t animUid, uint32_t fId, double fbTx, std::string metaInfo = "");
+    /**
+     * Get XMLP Ref function
+     * \param animUid the UID
+     * \param fId the FID
+     * \param fbTx the FB transmit
+     * \param metaInfo the meta info
+     * \returns the XML element
+     */
+    static std::string GetXmlPRef(uint64_t animUid,
+                                  uint32_t fId,
+                                  double fbTx,
+                                  std::string metaInfo);
     /**
      * Write XML close function
      * \param name the name
@@ -29,7 +29,9 @@
 #include "ns3/simple-device-energy-model.h"
 #include "ns3/udp-echo-helper.h"
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 using namespace ns3;
 using namespace ns3::energy;
@@ -68,6 +70,9 @@ class AbstractAnimationInterfaceTestCase : public TestCase
     /// Prepare network function
     virtual void PrepareNetwork() = 0;
 
+    /// Configure the animation interface, right after its construction
+    virtual void ConfigureAnimation();
+
     /// Check logic function
     virtual void CheckLogic() = 0;
 
@@ -95,6 +100,7 @@ AbstractAnimationInterfaceTestCase::DoRun()
     PrepareNetwork();
 
     m_anim = new AnimationInterface(m_traceFileName);
+    ConfigureAnimation();
 
     Simulator::Run();
     CheckLogic();
@@ -102,6 +108,11 @@ AbstractAnimationInterfaceTestCase::DoRun()
     Simulator::Destroy();
 }
 
+void
+AbstractAnimationInterfaceTestCase::ConfigureAnimation()
+{
+}
+
 void
 AbstractAnimationInterfaceTestCase::CheckFileExistence()
 {
@@ -124,6 +135,13 @@ class AnimationInterfaceTestCase : public AbstractAnimationInterfaceTestCase
      */
     AnimationInterfaceTestCase();
 
+  protected:
+    /**
+     * \brief Constructor.
+     * \param name testcase name
+     */
+    AnimationInterfaceTestCase(std::string name);
+
   private:
     void PrepareNetwork() override;
 
@@ -131,7 +149,12 @@ class AnimationInterfaceTestCase : public AbstractAnimationInterfaceTestCase
 };
 
 AnimationInterfaceTestCase::AnimationInterfaceTestCase()
-    : AbstractAnimationInterfaceTestCase("Verify AnimationInterface")
+    : AnimationInterfaceTestCase("Verify AnimationInterface")
+{
+}
+
+AnimationInterfaceTestCase::AnimationInterfaceTestCase(std::string name)
+    : AbstractAnimationInterfaceTestCase(name)
 {
 }
 
@@ -179,6 +202,65 @@ AnimationInterfaceTestCase::CheckLogic()
     NS_TEST_ASSERT_MSG_EQ(m_anim->GetTracePktCount(), 16, "Expected 16 packets traced");
 }
 
+/**
+ * \ingroup netanim-test
+ *
+ * \brief Binary, buffered and sampled trace Test Case
+ */
+class AnimationBinaryTraceTestCase : public AnimationInterfaceTestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    AnimationBinaryTraceTestCase();
+
+  private:
+    void ConfigureAnimation() override;
+
+    void CheckLogic() override;
+};
+
+AnimationBinaryTraceTestCase::AnimationBinaryTraceTestCase()
+    : AnimationInterfaceTestCase("Verify binary, buffered and sampled traces")
+{
+}
+
+void
+AnimationBinaryTraceTestCase::ConfigureAnimation()
+{
+    m_anim->EnableBinaryOutput();
+    m_anim->EnableBufferedOutput(256);
+    m_anim->SetPacketSamplingInterval(2);
+}
+
+void
+AnimationBinaryTraceTestCase::CheckLogic()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_anim->GetTracePktCount(), 8, "Expected one packet out of two traced");
+    // close the trace file
+    delete m_anim;
+    m_anim = nullptr;
+
+    std::string xmlFileName = CreateTempDirFilename("netanim-test-converted.xml");
+    NS_TEST_ASSERT_MSG_EQ(AnimationInterface::ConvertBinaryTrace("netanim-test.xml", xmlFileName),
+                          true,
+                          "Unable to convert the binary trace");
+    std::ifstream xmlFile(xmlFileName);
+    std::string xml((std::istreambuf_iterator<char>(xmlFile)), std::istreambuf_iterator<char>());
+    NS_TEST_ASSERT_MSG_EQ(xml.rfind("<anim ", 0), 0, "The XML trace must start with <anim>");
+    NS_TEST_ASSERT_MSG_EQ(xml.substr(xml.size() - 8), "</anim>\n", "The XML trace is truncated");
+    uint32_t nPackets = 0;
+    for (auto pos = xml.find("<p "); pos != std::string::npos; pos = xml.find("<p ", pos + 1))
+    {
+        nPackets++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(nPackets, 8, "Wrong number of packets in the XML trace");
+    NS_TEST_ASSERT_MSG_NE(xml.find("fId=\"0\" fbTx=\"2\""),
+                          std::string::npos,
+                          "The first packet must be sent at 2 s");
+}
+
 /**
  * \ingroup netanim-test
  *
@@ -253,5 +335,6 @@ static class AnimationInterfaceTestSuite : public TestSuite
     {
         AddTestCase(new AnimationInterfaceTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new AnimationRemainingEnergyTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new AnimationBinaryTraceTestCase(), TestCase::Duration::QUICK);
     }
 } g_animationInterfaceTestSuite; ///< the test suite
@@ -20,6 +20,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
@@ -54,7 +55,15 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
+/// The MemoryAccounting category of the buffer data
+static const uint32_t g_bufferDataCategory =
+    MemoryAccounting::RegisterCategory("ns3::Buffer::Data");
+
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -79,9 +88,15 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
+#ifdef NS3_MTP
+thread_local uint32_t Buffer::g_maxSize = 0;
+thread_local Buffer::FreeList* Buffer::g_freeList = nullptr;
+thread_local Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+#else
 uint32_t Buffer::g_maxSize = 0;
 Buffer::FreeList* Buffer::g_freeList = nullptr;
 Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+#endif
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -102,7 +117,17 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+#ifdef NS3_MTP
+    // The data may have been created by another thread, before this thread
+    // created any buffer
+    if (IS_UNINITIALIZED(g_freeList))
+    {
+        Buffer::Deallocate(data);
+        return;
+    }
+#else
     NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
+#endif
     g_maxSize = std::max(g_maxSize, data->m_size);
     /* feed into free list */
     if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
@@ -123,6 +148,11 @@ Buffer::Create(uint32_t dataSize)
     /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
+#ifdef NS3_MTP
+        // Touch the destructor of this thread, so that it is registered to
+        // release the free list when the thread exits
+        (void)&g_localStaticDestructor;
+#endif
         g_freeList = new Buffer::FreeList();
     }
     else if (IS_INITIALIZED(g_freeList))
@@ -174,6 +204,10 @@ Buffer::Allocate(uint32_t reqSize)
     reqSize += ALLOC_OVER_PROVISION;
     uint32_t size = reqSize - 1 + sizeof(Buffer::Data);
     auto b = new uint8_t[size];
+    if (MemoryAccounting::IsEnabled())
+    {
+        MemoryAccounting::Allocate(g_bufferDataCategory, size);
+    }
     auto data = reinterpret_cast<Buffer::Data*>(b);
     data->m_size = reqSize;
     data->m_count = 1;
@@ -185,6 +219,10 @@ Buffer::Deallocate(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    if (MemoryAccounting::IsEnabled())
+    {
+        MemoryAccounting::Deallocate(g_bufferDataCategory, data->m_size - 1 + sizeof(Buffer::Data));
+    }
     auto buf = reinterpret_cast<uint8_t*>(data);
     delete[] buf;
 }
@@ -266,8 +304,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -289,8 +326,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -315,7 +351,11 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -333,8 +373,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -361,7 +400,11 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+    bool isDirty = m_data->m_count > 1;
+#else
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -379,8 +422,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -407,21 +449,44 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    uint32_t zeroSize = m_zeroAreaEnd - m_zeroAreaStart;
+    uint32_t otherZeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
+    if ((m_end == m_zeroAreaEnd || zeroSize == 0) && o.m_start == o.m_zeroAreaStart &&
+        otherZeroSize > 0)
     {
         /**
          * This is an optimization which kicks in when
          * we attempt to aggregate two buffers which contain
          * adjacent zero areas.
          */
+        if (m_data->m_count != 1 || m_end != m_data->m_dirtyEnd)
+        {
+            /* Our data is shared (typically, by the other fragments of
+             * the same packet): make a private copy of the bytes before
+             * our zero area, but not of the zero area itself.
+             */
+            uint32_t internalSize = GetInternalSize();
+            Buffer::Data* newData = Buffer::Create(internalSize);
+            memcpy(newData->m_data, m_data->m_data + m_start, internalSize);
+            if (--m_data->m_count == 0)
+            {
+                Buffer::Recycle(m_data);
+            }
+            m_data = newData;
+
+            int32_t delta = -m_start;
+            m_zeroAreaStart += delta;
+            m_zeroAreaEnd += delta;
+            m_end += delta;
+            m_start += delta;
+            m_data->m_dirtyStart = m_start;
+            m_data->m_dirtyEnd = m_end;
+        }
         if (m_zeroAreaStart == m_zeroAreaEnd)
         {
             m_zeroAreaStart = m_end;
         }
-        uint32_t zeroSize = o.m_zeroAreaEnd - o.m_zeroAreaStart;
-        m_zeroAreaEnd = m_end + zeroSize;
+        m_zeroAreaEnd = m_end + otherZeroSize;
         m_end = m_zeroAreaEnd;
         m_data->m_dirtyEnd = m_zeroAreaEnd;
         uint32_t endData = o.m_end - o.m_zeroAreaEnd;
@@ -435,6 +500,32 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
+    if (m_data != o.m_data && zeroSize >= otherZeroSize)
+    {
+        /* Keep our zero area, and append the bytes of o (and the zero
+         * bytes of its smaller zero area) after it.
+         */
+        AddAtEnd(o.GetSize());
+        Buffer::Iterator destStart = End();
+        destStart.Prev(o.GetSize());
+        destStart.Write(o.Begin(), o.End());
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    if (m_data != o.m_data)
+    {
+        /* Keep the larger zero area of o, and prepend our bytes
+         * (and the zero bytes of our zero area) before it.
+         */
+        Buffer tmp = o;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
     *this = CreateFullCopy();
     AddAtEnd(o.GetSize());
     Buffer::Iterator destStart = End();
@@ -832,25 +923,36 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // the destination bytes are all either before or after our zero area
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
         m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
         m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
     m_current += toCopy;
 }
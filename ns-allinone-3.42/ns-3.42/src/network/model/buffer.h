@@ -25,6 +25,11 @@
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+// With multithreaded simulation, each thread has its own free list
 #define BUFFER_FREE_LIST 1
 
 namespace ns3
@@ -528,6 +533,11 @@ class Buffer
      * Add bytes at the end of the Buffer.
      * Any call to this method invalidates any Iterator
      * pointing to this Buffer.
+     *
+     * The larger zero area of the two buffers stays virtual, and
+     * adjacent zero areas are merged, so that reassembling the
+     * fragments of a packet whose payload was created with
+     * Packet::Packet(uint32_t) only copies the bytes of its headers.
      */
     void AddAtEnd(const Buffer& o);
     /**
@@ -658,6 +668,9 @@ class Buffer
      * New user data can be safely written only outside of the "dirty
      * area" if the reference count is higher than 1 (that is, if
      * more than one Buffer instance references the same BufferData).
+     * With multithreaded simulation enabled a shared BufferData is never
+     * written to, since the Buffer instances which reference it may be
+     * used by different threads.
      */
     struct Data
     {
@@ -665,7 +678,11 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /**
          * the size of the m_data field below.
          */
@@ -769,7 +786,11 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
+#ifdef NS3_MTP
+    static thread_local uint32_t g_recommendedStart;
+#else
     static uint32_t g_recommendedStart;
+#endif
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -802,10 +823,17 @@ class Buffer
         ~LocalStaticDestructor();
     };
 
+#ifdef NS3_MTP
+    static thread_local uint32_t g_maxSize;   //!< Max observed data size
+    static thread_local FreeList* g_freeList; //!< Buffer data container
+    /// Local static destructor, run at the exit of each thread
+    static thread_local LocalStaticDestructor g_localStaticDestructor;
+#else
     static uint32_t g_maxSize;                            //!< Max observed data size
     static FreeList* g_freeList;                          //!< Buffer data container
     static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
+#endif
 };
 
 } // namespace ns3
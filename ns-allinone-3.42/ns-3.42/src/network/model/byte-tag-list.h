@@ -47,7 +47,11 @@ struct ByteTagListData;
  *     as 4 32bit integers (TypeId, tag data size, start, end) followed
  *     by the tag data as generated by Tag::Serialize.
  *
- *   - The struct ByteTagListData structure which contains the tag byte buffer
+ *   - The first #INLINE_SIZE bytes of that buffer are stored inline, in the
+ *     ByteTagList itself, so that the few byte tags of a typical packet do
+ *     not need a heap allocation. Copying such a list copies the used bytes.
+ *
+ *   - Larger buffers are moved to a struct ByteTagListData structure, which
  *     is shared and, thus, reference-counted. This data structure is unshared
  *     as-needed to emulate COW semantics.
  *
@@ -153,11 +157,14 @@ class ByteTagList
         int32_t m_nextEnd;     //!< End of the next tag
     };
 
+    /// Number of bytes of tags stored without a heap allocation
+    static constexpr uint32_t INLINE_SIZE = 48;
+
     ByteTagList();
 
     /**
      *
-     * Copy constructor, copies the data and increases reference count
+     * Copy constructor, copies the inline data or increases the reference count
      *
      * \param o The ByteTagList to copy
      *
@@ -167,7 +174,8 @@ class ByteTagList
     /**
      *
      * Assignment operator, deallocates current data and assigns
-     * value of passed in ByteTagList.  Also increases reference count
+     * value of passed in ByteTagList.  Also copies the inline data or increases
+     * the reference count
      *
      * \param o reference to the ByteTagList to copy
      * \returns reference to the assignee
@@ -283,11 +291,12 @@ class ByteTagList
      */
     void Deallocate(ByteTagListData* data);
 
-    int32_t m_minStart;      //!< minimal start offset
-    int32_t m_maxEnd;        //!< maximal end offset
-    int32_t m_adjustment;    //!< adjustment to byte tag offsets
-    uint32_t m_used;         //!< the number of used bytes in the buffer
-    ByteTagListData* m_data; //!< the ByteTagListData structure
+    int32_t m_minStart;            //!< minimal start offset
+    int32_t m_maxEnd;              //!< maximal end offset
+    int32_t m_adjustment;          //!< adjustment to byte tag offsets
+    uint32_t m_used;               //!< the number of used bytes in the buffer
+    ByteTagListData* m_data;       //!< the ByteTagListData structure, null if the tags are inline
+    uint8_t m_inline[INLINE_SIZE]; //!< inline storage for the tags
 };
 
 void
@@ -64,4 +64,11 @@ Channel::GetId() const
     return m_id;
 }
 
+Time
+Channel::GetMinimumDelay() const
+{
+    NS_LOG_FUNCTION(this);
+    return Time(0);
+}
+
 } // namespace ns3
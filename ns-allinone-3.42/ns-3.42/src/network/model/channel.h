@@ -16,6 +16,7 @@
 #ifndef NS3_CHANNEL_H
 #define NS3_CHANNEL_H
 
+#include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
@@ -75,6 +76,18 @@ class Channel : public Object
      */
     virtual Ptr<NetDevice> GetDevice(std::size_t i) const = 0;
 
+    /**
+     * \returns the minimum delay between a transmission on this channel and
+     * any event it schedules on the other nodes attached to it.
+     *
+     * Parallel simulator implementations use this value as the lookahead
+     * between the nodes connected by the channel.  A channel must only
+     * return a positive value if, in addition, its devices share no mutable
+     * state through it; the default, zero, means that all the nodes attached
+     * to this channel must be simulated together.
+     */
+    virtual Time GetMinimumDelay() const;
+
   private:
     uint32_t m_id; //!< Channel id for this channel
 };
@@ -24,6 +24,7 @@
 #include "chunk.h"
 
 #include <stdint.h>
+#include <type_traits>
 
 namespace ns3
 {
@@ -113,6 +114,38 @@ class Header : public Chunk
  */
 std::ostream& operator<<(std::ostream& os, const Header& header);
 
+/**
+ * \ingroup packet
+ *
+ * \brief Tell whether a header type has a serialized size known at compile time.
+ *
+ * A header class opts in by being declared final and by defining a public
+ * `static constexpr uint32_t SERIALIZED_SIZE` member, equal to the value
+ * always returned by its GetSerializedSize method. Packet::AddHeader,
+ * Packet::RemoveHeader and Packet::PeekHeader then use the constant size
+ * and bind the calls to Serialize and Deserialize statically when they are
+ * passed an object of that class.
+ *
+ * \tparam T \explicit the header type
+ */
+template <typename T, typename = void>
+struct HasFixedSerializedSize : std::false_type
+{
+};
+
+/**
+ * \ingroup packet
+ *
+ * \brief Specialization for header types defining SERIALIZED_SIZE.
+ *
+ * \tparam T \explicit the header type
+ */
+template <typename T>
+struct HasFixedSerializedSize<T, std::void_t<decltype(T::SERIALIZED_SIZE)>>
+    : std::is_base_of<Header, T>
+{
+};
+
 } // namespace ns3
 
 #endif /* HEADER_H */
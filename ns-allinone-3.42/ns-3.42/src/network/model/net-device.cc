@@ -20,6 +20,7 @@
 #include "net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/packet-burst.h"
 
 namespace ns3
 {
@@ -40,4 +41,17 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+NetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    bool ret = true;
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        ret = Send(*it, dest, protocolNumber) && ret;
+    }
+    return ret;
+}
+
 } // namespace ns3
@@ -36,6 +36,7 @@ namespace ns3
 
 class Node;
 class Channel;
+class PacketBurst;
 
 /**
  * \ingroup network
@@ -264,6 +265,21 @@ class NetDevice : public Object
                           const Address& source,
                           const Address& dest,
                           uint16_t protocolNumber) = 0;
+    /**
+     * \param burst packets sent from above down to Network Device
+     * \param dest mac address of the destination (already resolved)
+     * \param protocolNumber identifies the type of payload contained in
+     *        the packets.
+     *
+     *  Called from higher layer to send a batch of packets for the same
+     *  destination into Network Device. Each packet is handled as if it
+     *  were passed to Send, in order; the default implementation just
+     *  calls Send for every packet, while subclasses may override it to
+     *  amortize the per-packet overhead over the whole burst.
+     *
+     * \return whether the Send operation succeeded for all the packets
+     */
+    virtual bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber);
     /**
      * \returns the node base class which contains this network
      *          interface.
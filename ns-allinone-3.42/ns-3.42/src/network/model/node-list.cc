@@ -20,6 +20,8 @@
 
 #include "node-list.h"
 
+#include "address.h"
+#include "net-device.h"
 #include "node.h"
 
 #include "ns3/assert.h"
@@ -28,6 +30,10 @@
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 namespace ns3
 {
 
@@ -80,6 +86,12 @@ class NodeListPriv : public Object
      */
     uint32_t GetNNodes();
 
+    /**
+     * \param address the address of the requested device.
+     * \returns the NetDevice with the given address, or 0 if none.
+     */
+    Ptr<NetDevice> FindDevice(const Address& address);
+
     /**
      * \brief Get the node list object
      * \returns the node list
@@ -103,7 +115,48 @@ class NodeListPriv : public Object
      */
     void DoDispose() override;
 
+    /**
+     * \brief Queue a device for the index of the devices by address
+     *
+     * This is the device addition listener of every node of the list. The
+     * device is indexed at the next lookup, as it may not have an address
+     * yet when it is added.
+     *
+     * \param device the device added to a node
+     */
+    void IndexDevice(Ptr<NetDevice> device);
+
+    /**
+     * \brief Rebuild the index of the devices by address
+     */
+    void IndexDevices();
+
+    /**
+     * Hash function for Address objects. The type is not hashed because
+     * addresses of type zero compare equal to addresses of any type.
+     */
+    struct AddressHash
+    {
+        /**
+         * \param address the address to hash
+         * \return the hash of the value of the address
+         */
+        std::size_t operator()(const Address& address) const
+        {
+            uint8_t buffer[Address::MAX_SIZE];
+            uint32_t len = address.CopyTo(buffer);
+            return std::hash<std::string_view>()(
+                std::string_view(reinterpret_cast<const char*>(buffer), len));
+        }
+    };
+
     std::vector<Ptr<Node>> m_nodes; //!< node objects container
+    /// devices indexed by the address they had when indexed
+    std::unordered_multimap<Address, Ptr<NetDevice>, AddressHash> m_devices;
+    /// devices added to the nodes and not indexed yet
+    std::vector<Ptr<NetDevice>> m_newDevices;
+    /// whether devices were added since the index was last rebuilt
+    bool m_devicesAdded{false};
 };
 
 NS_OBJECT_ENSURE_REGISTERED(NodeListPriv);
@@ -172,6 +225,8 @@ NodeListPriv::DoDispose()
         *i = nullptr;
     }
     m_nodes.erase(m_nodes.begin(), m_nodes.end());
+    m_devices.clear();
+    m_newDevices.clear();
     Object::DoDispose();
 }
 
@@ -181,6 +236,7 @@ NodeListPriv::Add(Ptr<Node> node)
     NS_LOG_FUNCTION(this << node);
     uint32_t index = m_nodes.size();
     m_nodes.push_back(node);
+    node->RegisterDeviceAdditionListener(MakeCallback(&NodeListPriv::IndexDevice, this));
     Simulator::ScheduleWithContext(index, TimeStep(0), &Node::Initialize, node);
     return index;
 }
@@ -216,6 +272,75 @@ NodeListPriv::GetNode(uint32_t n)
     return m_nodes[n];
 }
 
+Ptr<NetDevice>
+NodeListPriv::FindDevice(const Address& address)
+{
+    NS_LOG_FUNCTION(this << address);
+    for (const auto& device : m_newDevices)
+    {
+        m_devices.emplace(device->GetAddress(), device);
+    }
+    m_newDevices.clear();
+
+    Ptr<NetDevice> found;
+    // move the devices whose address changed since they were indexed
+    std::vector<Ptr<NetDevice>> moved;
+    auto [first, last] = m_devices.equal_range(address);
+    for (auto it = first; it != last;)
+    {
+        if (it->second->GetAddress() != address)
+        {
+            moved.push_back(it->second);
+            it = m_devices.erase(it);
+            continue;
+        }
+        if (!found)
+        {
+            found = it->second;
+        }
+        ++it;
+    }
+    for (const auto& device : moved)
+    {
+        m_devices.emplace(device->GetAddress(), device);
+    }
+
+    // the devices added since the last rebuild may have got their address
+    // after they were indexed, which a rebuild catches
+    if (!found && m_devicesAdded)
+    {
+        IndexDevices();
+        auto it = m_devices.find(address);
+        found = (it != m_devices.end() ? it->second : nullptr);
+    }
+    return found;
+}
+
+void
+NodeListPriv::IndexDevice(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    m_newDevices.push_back(device);
+    m_devicesAdded = true;
+}
+
+void
+NodeListPriv::IndexDevices()
+{
+    NS_LOG_FUNCTION(this);
+    m_devices.clear();
+    m_newDevices.clear();
+    for (const auto& node : m_nodes)
+    {
+        for (uint32_t i = 0; i < node->GetNDevices(); i++)
+        {
+            Ptr<NetDevice> device = node->GetDevice(i);
+            m_devices.emplace(device->GetAddress(), device);
+        }
+    }
+    m_devicesAdded = false;
+}
+
 } // namespace ns3
 
 /**
@@ -261,4 +386,11 @@ NodeList::GetNNodes()
     return NodeListPriv::Get()->GetNNodes();
 }
 
+Ptr<NetDevice>
+NodeList::FindDevice(const Address& address)
+{
+    NS_LOG_FUNCTION(address);
+    return NodeListPriv::Get()->FindDevice(address);
+}
+
 } // namespace ns3
@@ -28,6 +28,8 @@ namespace ns3
 {
 
 class Node;
+class NetDevice;
+class Address;
 class CallbackBase;
 
 /**
@@ -70,6 +72,20 @@ class NodeList
      * \returns the number of nodes currently in the list.
      */
     static uint32_t GetNNodes();
+    /**
+     * \param address the address of the requested device.
+     * \returns the NetDevice whose address is the given one, or 0 if
+     *          no device has such an address.
+     *
+     * Devices are looked up in an index, which the devices added to the
+     * nodes join at the next lookup, so that the cost of a lookup does not
+     * depend on the number of nodes. Since the address of a device may be
+     * set after it was added, a failed lookup rebuilds the index once if
+     * devices were added since the last rebuild, and a device found with
+     * another address than the one it was indexed with is indexed again. If several devices share
+     * the same address, any of them is returned.
+     */
+    static Ptr<NetDevice> FindDevice(const Address& address);
 };
 
 } // namespace ns3
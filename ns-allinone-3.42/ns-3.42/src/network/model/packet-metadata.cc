@@ -25,7 +25,9 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/memory-accounting.h"
 
+#include <algorithm>
 #include <list>
 #include <utility>
 
@@ -34,11 +36,22 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
+/// The MemoryAccounting category of the metadata
+static const uint32_t g_metadataCategory =
+    MemoryAccounting::RegisterCategory("ns3::PacketMetadata::Data");
+
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+bool PacketMetadata::m_enableLazy = false;
+#ifdef NS3_MTP
+thread_local bool PacketMetadata::m_metadataSkipped = false;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+std::atomic<uint16_t> PacketMetadata::m_chunkUid = 0;
+#else
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
+#endif
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
 
 PacketMetadata::DataFreeList::~DataFreeList()
@@ -55,6 +68,11 @@ void
 PacketMetadata::Enable()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (m_enableLazy)
+    {
+        // the lazy metadata can already be printed
+        return;
+    }
     NS_ASSERT_MSG(!m_metadataSkipped,
                   "Error: attempting to enable the packet metadata "
                   "subsystem too late in the simulation, which is not allowed.\n"
@@ -69,10 +87,28 @@ void
 PacketMetadata::EnableChecking()
 {
     NS_LOG_FUNCTION_NOARGS();
+    m_enableLazy = false;
     Enable();
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableLazy()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    NS_ASSERT_MSG(!m_metadataSkipped,
+                  "Error: attempting to enable the lazy packet metadata "
+                  "subsystem too late in the simulation, which is not allowed.\n"
+                  "Call ns3::PacketMetadata::EnableLazy () near the beginning of"
+                  " the program, before any packets are sent.");
+    if (m_enable)
+    {
+        // the full metadata is already recorded
+        return;
+    }
+    m_enableLazy = true;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -80,8 +116,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -104,8 +139,13 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
+#ifdef NS3_MTP
+    // Shared data may be read by other threads: never write to it
+    if (m_data->m_size >= m_used + size && m_data->m_count == 1)
+#else
     if (m_data->m_size >= m_used + size &&
         (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+#endif
     {
         /* enough room, not dirty. */
     }
@@ -384,8 +424,12 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
+#ifdef NS3_MTP
+    if (m_used + n > m_data->m_size || m_data->m_count != 1)
+#else
     if (m_used + n > m_data->m_size ||
         (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#endif
     {
         ReserveCopy(n);
     }
@@ -421,8 +465,12 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t fragEndSize = GetUleb128Size(extraItem->fragmentEnd);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
+#ifdef NS3_MTP
+    if (m_used + n > m_data->m_size || m_data->m_count != 1)
+#else
     if (m_used + n > m_data->m_size ||
         (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+#endif
     {
         ReserveCopy(n);
     }
@@ -572,6 +620,7 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
+#ifndef NS3_MTP
     while (!m_freeList.empty())
     {
         PacketMetadata::Data* data = m_freeList.back();
@@ -585,6 +634,7 @@ PacketMetadata::Create(uint32_t size)
         NS_LOG_LOGIC("create dealloc size=" << data->m_size);
         PacketMetadata::Deallocate(data);
     }
+#endif
     NS_LOG_LOGIC("create alloc size=" << m_maxSize);
     return PacketMetadata::Allocate(m_maxSize);
 }
@@ -593,6 +643,10 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+#ifdef NS3_MTP
+    // The free list would be shared by all the threads
+    PacketMetadata::Deallocate(data);
+#else
     if (!m_enable)
     {
         PacketMetadata::Deallocate(data);
@@ -608,6 +662,7 @@ PacketMetadata::Recycle(PacketMetadata::Data* data)
     {
         m_freeList.push_back(data);
     }
+#endif
 }
 
 PacketMetadata::Data*
@@ -621,6 +676,10 @@ PacketMetadata::Allocate(uint32_t n)
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
     auto buf = new uint8_t[size];
+    if (MemoryAccounting::IsEnabled())
+    {
+        MemoryAccounting::Allocate(g_metadataCategory, size);
+    }
     auto data = (PacketMetadata::Data*)buf;
     data->m_size = n;
     data->m_count = 1;
@@ -632,6 +691,11 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
+    if (MemoryAccounting::IsEnabled())
+    {
+        MemoryAccounting::Deallocate(g_metadataCategory,
+                                     sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
+    }
     auto buf = (uint8_t*)data;
     delete[] buf;
 }
@@ -651,6 +715,11 @@ PacketMetadata::AddHeader(const Header& header, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &header << size);
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
+    if (m_enableLazy)
+    {
+        m_lazyHeaders = ns3::Create<LazyItem>(uid, size, 0, size, m_lazyHeaders);
+        return;
+    }
     DoAddHeader(uid, size);
     NS_ASSERT(IsStateOk());
 }
@@ -670,8 +739,7 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid++;
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -681,6 +749,18 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
 {
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &header << size);
+    if (m_enableLazy)
+    {
+        const LazyItem* item = PeekPointer(m_lazyHeaders);
+        // as with the full metadata, an unexpected header is not removed
+        if (item != nullptr && item->typeUid == uid && item->size == size &&
+            item->fragmentStart == 0 && item->fragmentEnd == size)
+        {
+            Ptr<const LazyItem> next = item->next;
+            m_lazyHeaders = next;
+        }
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -726,6 +806,11 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
 {
     uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &trailer << size);
+    if (m_enableLazy)
+    {
+        m_lazyTrailers = ns3::Create<LazyItem>(uid, size, 0, size, m_lazyTrailers);
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -736,8 +821,7 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = m_chunkUid++;
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -748,6 +832,17 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
 {
     uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
     NS_LOG_FUNCTION(this << &trailer << size);
+    if (m_enableLazy)
+    {
+        const LazyItem* item = PeekPointer(m_lazyTrailers);
+        if (item != nullptr && item->typeUid == uid && item->size == size &&
+            item->fragmentStart == 0 && item->fragmentEnd == size)
+        {
+            Ptr<const LazyItem> next = item->next;
+            m_lazyTrailers = next;
+        }
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -792,6 +887,11 @@ void
 PacketMetadata::AddAtEnd(const PacketMetadata& o)
 {
     NS_LOG_FUNCTION(this << &o);
+    if (m_enableLazy)
+    {
+        AddLazyAtEnd(o);
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -879,6 +979,11 @@ void
 PacketMetadata::RemoveAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
+    if (m_enableLazy)
+    {
+        RemoveLazyAtStart(start);
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -940,6 +1045,11 @@ void
 PacketMetadata::RemoveAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
+    if (m_enableLazy)
+    {
+        RemoveLazyAtEnd(end);
+        return;
+    }
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -1033,9 +1143,330 @@ PacketMetadata::ItemIterator
 PacketMetadata::BeginItem(Buffer buffer) const
 {
     NS_LOG_FUNCTION(this << &buffer);
+    if (m_enableLazy)
+    {
+        auto materialized = std::make_shared<const PacketMetadata>(Materialize(buffer.GetSize()));
+        ItemIterator i(materialized.get(), buffer);
+        i.m_materialized = materialized;
+        return i;
+    }
     return ItemIterator(this, buffer);
 }
 
+namespace
+{
+
+/** Maximum number of free lazy items kept per thread. */
+constexpr uint32_t LAZY_ITEM_POOL_MAX_FREE = 1 << 16;
+
+/** A free lazy item block, linked in the free list of its thread. */
+struct FreeLazyItem
+{
+    FreeLazyItem* next; //!< Next free block.
+};
+
+/**
+ * The free list of lazy items of one thread.
+ *
+ * Blocks are allocated one by one with the global allocator, so that an
+ * item can be released by another thread than the one which created it.
+ */
+struct LazyItemPool
+{
+    FreeLazyItem* head = nullptr; //!< Free list.
+    uint32_t count = 0;           //!< Free list length.
+
+    /** Release the cached blocks when the thread exits. */
+    ~LazyItemPool();
+};
+
+/** Whether the free list of this thread has been released. */
+thread_local bool g_lazyItemPoolReleased = false;
+
+/** The free list of lazy items of this thread. */
+thread_local LazyItemPool g_lazyItemPool;
+
+LazyItemPool::~LazyItemPool()
+{
+    g_lazyItemPoolReleased = true;
+    while (head != nullptr)
+    {
+        FreeLazyItem* block = head;
+        head = block->next;
+        ::operator delete(block);
+    }
+    count = 0;
+}
+
+} // namespace
+
+void*
+PacketMetadata::LazyItem::operator new(std::size_t size)
+{
+    if (!g_lazyItemPoolReleased && g_lazyItemPool.head != nullptr)
+    {
+        FreeLazyItem* block = g_lazyItemPool.head;
+        g_lazyItemPool.head = block->next;
+        g_lazyItemPool.count--;
+        return block;
+    }
+    return ::operator new(size);
+}
+
+void
+PacketMetadata::LazyItem::operator delete(void* ptr, std::size_t /* size */)
+{
+    if (!g_lazyItemPoolReleased && g_lazyItemPool.count < LAZY_ITEM_POOL_MAX_FREE)
+    {
+        auto block = static_cast<FreeLazyItem*>(ptr);
+        block->next = g_lazyItemPool.head;
+        g_lazyItemPool.head = block;
+        g_lazyItemPool.count++;
+        return;
+    }
+    ::operator delete(ptr);
+}
+
+PacketMetadata::LazyItem::LazyItem(uint32_t typeUid,
+                                   uint32_t size,
+                                   uint32_t fragmentStart,
+                                   uint32_t fragmentEnd,
+                                   Ptr<const LazyItem> next)
+    : typeUid(typeUid),
+      size(size),
+      fragmentStart(fragmentStart),
+      fragmentEnd(fragmentEnd),
+      next(next)
+{
+}
+
+uint32_t
+PacketMetadata::GetLazySize(const LazyItem* item)
+{
+    uint32_t size = 0;
+    for (; item != nullptr; item = PeekPointer(item->next))
+    {
+        size += item->fragmentEnd - item->fragmentStart;
+    }
+    return size;
+}
+
+Ptr<const PacketMetadata::LazyItem>
+PacketMetadata::ConcatLazy(const Ptr<const LazyItem>& first, Ptr<const LazyItem> second)
+{
+    std::vector<const LazyItem*> items;
+    for (const LazyItem* i = PeekPointer(first); i != nullptr; i = PeekPointer(i->next))
+    {
+        items.push_back(i);
+    }
+    for (auto i = items.rbegin(); i != items.rend(); i++)
+    {
+        const LazyItem* item = *i;
+        if (i == items.rbegin() && second && item->typeUid == second->typeUid &&
+            item->size == second->size &&
+            (item->fragmentEnd == second->fragmentStart ||
+             second->fragmentEnd == item->fragmentStart))
+        {
+            // two consecutive fragments of the same header or trailer
+            second = ns3::Create<LazyItem>(item->typeUid,
+                                      item->size,
+                                      std::min(item->fragmentStart, second->fragmentStart),
+                                      std::max(item->fragmentEnd, second->fragmentEnd),
+                                      second->next);
+            continue;
+        }
+        second = ns3::Create<LazyItem>(item->typeUid,
+                                  item->size,
+                                  item->fragmentStart,
+                                  item->fragmentEnd,
+                                  second);
+    }
+    return second;
+}
+
+uint32_t
+PacketMetadata::TrimLazy(Ptr<const LazyItem>& list, uint32_t size, bool fromStart)
+{
+    if (size == 0 || !list)
+    {
+        return size;
+    }
+    std::vector<const LazyItem*> items;
+    for (const LazyItem* i = PeekPointer(list); i != nullptr; i = PeekPointer(i->next))
+    {
+        items.push_back(i);
+    }
+    Ptr<const LazyItem> trimmed;
+    while (!items.empty() && size > 0)
+    {
+        const LazyItem* item = items.back();
+        items.pop_back();
+        uint32_t itemSize = item->fragmentEnd - item->fragmentStart;
+        if (itemSize <= size)
+        {
+            size -= itemSize;
+            continue;
+        }
+        uint32_t start = fromStart ? item->fragmentStart + size : item->fragmentStart;
+        uint32_t end = fromStart ? item->fragmentEnd : item->fragmentEnd - size;
+        trimmed = ns3::Create<LazyItem>(item->typeUid, item->size, start, end, nullptr);
+        size = 0;
+    }
+    // the items before the trimmed ones point to them, so they are copied
+    for (auto i = items.rbegin(); i != items.rend(); i++)
+    {
+        const LazyItem* item = *i;
+        trimmed = ns3::Create<LazyItem>(item->typeUid,
+                                   item->size,
+                                   item->fragmentStart,
+                                   item->fragmentEnd,
+                                   trimmed);
+    }
+    list = trimmed;
+    return size;
+}
+
+void
+PacketMetadata::RemoveLazyAtStart(uint32_t start)
+{
+    NS_LOG_FUNCTION(this << start);
+    uint32_t leftToRemove = start;
+    while (leftToRemove > 0 && m_lazyHeaders)
+    {
+        const LazyItem* item = PeekPointer(m_lazyHeaders);
+        uint32_t itemSize = item->fragmentEnd - item->fragmentStart;
+        if (itemSize <= leftToRemove)
+        {
+            leftToRemove -= itemSize;
+            Ptr<const LazyItem> next = item->next;
+            m_lazyHeaders = next;
+        }
+        else
+        {
+            m_lazyHeaders = ns3::Create<LazyItem>(item->typeUid,
+                                             item->size,
+                                             item->fragmentStart + leftToRemove,
+                                             item->fragmentEnd,
+                                             item->next);
+            leftToRemove = 0;
+        }
+    }
+    uint32_t payload = std::min(leftToRemove, m_lazyPayload);
+    m_lazyPayload -= payload;
+    leftToRemove -= payload;
+    TrimLazy(m_lazyTrailers, leftToRemove, true);
+}
+
+void
+PacketMetadata::RemoveLazyAtEnd(uint32_t end)
+{
+    NS_LOG_FUNCTION(this << end);
+    uint32_t leftToRemove = end;
+    while (leftToRemove > 0 && m_lazyTrailers)
+    {
+        const LazyItem* item = PeekPointer(m_lazyTrailers);
+        uint32_t itemSize = item->fragmentEnd - item->fragmentStart;
+        if (itemSize <= leftToRemove)
+        {
+            leftToRemove -= itemSize;
+            Ptr<const LazyItem> next = item->next;
+            m_lazyTrailers = next;
+        }
+        else
+        {
+            m_lazyTrailers = ns3::Create<LazyItem>(item->typeUid,
+                                              item->size,
+                                              item->fragmentStart,
+                                              item->fragmentEnd - leftToRemove,
+                                              item->next);
+            leftToRemove = 0;
+        }
+    }
+    uint32_t payload = std::min(leftToRemove, m_lazyPayload);
+    m_lazyPayload -= payload;
+    leftToRemove -= payload;
+    TrimLazy(m_lazyHeaders, leftToRemove, false);
+}
+
+void
+PacketMetadata::AddLazyAtEnd(const PacketMetadata& o)
+{
+    NS_LOG_FUNCTION(this << &o);
+    if (!m_lazyTrailers && m_lazyPayload == 0)
+    {
+        // the headers of o follow the headers of this packet
+        m_lazyHeaders = ConcatLazy(m_lazyHeaders, o.m_lazyHeaders);
+        m_lazyPayload = o.m_lazyPayload;
+        m_lazyTrailers = o.m_lazyTrailers;
+    }
+    else if (!o.m_lazyHeaders && o.m_lazyPayload == 0)
+    {
+        // the trailers of o follow the trailers of this packet
+        m_lazyTrailers = ConcatLazy(o.m_lazyTrailers, m_lazyTrailers);
+    }
+    else
+    {
+        // the lists cannot describe headers after payload or trailers:
+        // all the bytes between the two lists are shown as payload
+        m_lazyPayload += GetLazySize(PeekPointer(m_lazyTrailers)) +
+                         GetLazySize(PeekPointer(o.m_lazyHeaders)) + o.m_lazyPayload;
+        m_lazyTrailers = o.m_lazyTrailers;
+    }
+}
+
+void
+PacketMetadata::AppendItem(uint32_t typeUid,
+                           uint32_t size,
+                           uint32_t fragmentStart,
+                           uint32_t fragmentEnd)
+{
+    NS_LOG_FUNCTION(this << typeUid << size << fragmentStart << fragmentEnd);
+    PacketMetadata::SmallItem item;
+    item.next = 0xffff;
+    item.prev = m_tail;
+    item.typeUid = typeUid;
+    item.size = size;
+    item.chunkUid = 0;
+    PacketMetadata::ExtraItem extraItem;
+    extraItem.fragmentStart = fragmentStart;
+    extraItem.fragmentEnd = fragmentEnd;
+    extraItem.packetUid = m_packetUid;
+    uint16_t written = AddBig(0xffff, m_tail, &item, &extraItem);
+    UpdateTail(written);
+}
+
+PacketMetadata
+PacketMetadata::Materialize(uint32_t size) const
+{
+    NS_LOG_FUNCTION(this << size);
+    PacketMetadata metadata(m_packetUid, 0);
+    uint32_t headersSize = 0;
+    for (const LazyItem* i = PeekPointer(m_lazyHeaders); i != nullptr; i = PeekPointer(i->next))
+    {
+        metadata.AppendItem(i->typeUid, i->size, i->fragmentStart, i->fragmentEnd);
+        headersSize += i->fragmentEnd - i->fragmentStart;
+    }
+    std::vector<const LazyItem*> trailers;
+    uint32_t trailersSize = 0;
+    for (const LazyItem* i = PeekPointer(m_lazyTrailers); i != nullptr; i = PeekPointer(i->next))
+    {
+        trailers.push_back(i);
+        trailersSize += i->fragmentEnd - i->fragmentStart;
+    }
+    // the payload size is taken from the buffer, which is also right for
+    // the packets deserialized without their lazy lists
+    if (size > headersSize + trailersSize)
+    {
+        uint32_t payload = size - headersSize - trailersSize;
+        metadata.AppendItem(0, payload, 0, payload);
+    }
+    for (auto i = trailers.rbegin(); i != trailers.rend(); i++)
+    {
+        metadata.AppendItem((*i)->typeUid, (*i)->size, (*i)->fragmentStart, (*i)->fragmentEnd);
+    }
+    return metadata;
+}
+
 PacketMetadata::ItemIterator::ItemIterator(const PacketMetadata* metadata, Buffer buffer)
     : m_metadata(metadata),
       m_buffer(buffer),
@@ -23,12 +23,20 @@
 
 #include "ns3/assert.h"
 #include "ns3/callback.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/type-id.h"
 
+#include <cstddef>
 #include <limits>
+#include <memory>
 #include <stdint.h>
 #include <vector>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -76,6 +84,13 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * In lazy mode (see EnableLazy), this list is not maintained. Each
+ * packet only keeps two immutable singly linked lists, of its headers
+ * and of its trailers, which are shared with its copies and updated in
+ * constant time when a header or a trailer is added or removed. The item
+ * list is built from them when the items are iterated, e.g. by
+ * Packet::Print.
  */
 class PacketMetadata
 {
@@ -154,6 +169,10 @@ class PacketMetadata
         Item Next();
 
       private:
+        friend class PacketMetadata;
+
+        /// metadata built from the lazy header and trailer lists, if any
+        std::shared_ptr<const PacketMetadata> m_materialized;
         const PacketMetadata* m_metadata; //!< pointer to the metadata
         Buffer m_buffer;                  //!< buffer the metadata refers to
         uint16_t m_current;               //!< current position
@@ -167,8 +186,27 @@ class PacketMetadata
     static void Enable();
     /**
      * \brief Enable the packet metadata checking
+     *
+     * Checking requires the full metadata, so it disables the lazy mode.
      */
     static void EnableChecking();
+    /**
+     * \brief Enable the lazy packet metadata
+     *
+     * Only the types and sizes of the headers and trailers of each packet
+     * are recorded, in lists shared with the packet copies, and the full
+     * metadata is built when it is iterated, e.g. by Packet::Print. This is
+     * much cheaper than Enable when few packets are printed. Once the lazy
+     * mode is enabled, Enable does nothing, so that helpers enabling the
+     * printing for their ascii traces keep the lazy mode.
+     *
+     * The lazy mode loses some details of the full metadata: when a packet
+     * with payload or trailers is concatenated with a packet with headers,
+     * the bytes between the headers of the first packet and the trailers of
+     * the second one are all shown as payload, and the lists are not
+     * serialized with the packet.
+     */
+    static void EnableLazy();
 
     /**
      * \brief Constructor
@@ -426,7 +464,11 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
+#ifdef NS3_MTP
+        std::atomic<uint32_t> m_count;
+#else
         uint32_t m_count;
+#endif
         /** size (in bytes) of m_data buffer below */
         uint32_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -675,19 +717,128 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
+    /**
+     * \brief A header or trailer of a packet in lazy mode
+     *
+     * The items are immutable, so that a list of items can be shared by
+     * the copies of a packet and by lists which only differ by their
+     * first items.
+     */
+    struct LazyItem : public SimpleRefCount<LazyItem>
+    {
+        /**
+         * \brief Constructor
+         * \param typeUid the uid of the header or trailer type, as in SmallItem
+         * \param size the size of the whole header or trailer
+         * \param fragmentStart the start of the fragment present in the packet
+         * \param fragmentEnd the end of the fragment present in the packet
+         * \param next the next item, towards the payload
+         */
+        LazyItem(uint32_t typeUid,
+                 uint32_t size,
+                 uint32_t fragmentStart,
+                 uint32_t fragmentEnd,
+                 Ptr<const LazyItem> next);
+
+        /**
+         * \brief Allocate an item, from the free list of this thread
+         * \param size the size of the item
+         * \returns the allocated memory
+         */
+        static void* operator new(std::size_t size);
+        /**
+         * \brief Release an item, to the free list of this thread
+         * \param ptr the item memory
+         * \param size the size of the item
+         */
+        static void operator delete(void* ptr, std::size_t size);
+
+        uint32_t typeUid;         //!< uid of the header or trailer type
+        uint32_t size;            //!< size of the whole header or trailer
+        uint32_t fragmentStart;   //!< start of the fragment present in the packet
+        uint32_t fragmentEnd;     //!< end of the fragment present in the packet
+        Ptr<const LazyItem> next; //!< next item, towards the payload
+    };
+
+    /**
+     * \brief Get the number of bytes of a lazy item list
+     * \param item the first item of the list
+     * \returns the sum of the fragment sizes of the items
+     */
+    static uint32_t GetLazySize(const LazyItem* item);
+    /**
+     * \brief Concatenate two lazy item lists
+     *
+     * The items of the first list are copied in front of the second one,
+     * and the last one is merged with the first item of the second list
+     * if they are two consecutive fragments of the same header or trailer.
+     *
+     * \param first the list to put in front
+     * \param second the list to put behind
+     * \returns the concatenated list
+     */
+    static Ptr<const LazyItem> ConcatLazy(const Ptr<const LazyItem>& first,
+                                          Ptr<const LazyItem> second);
+    /**
+     * \brief Remove bytes from the items at the far end of a lazy item list
+     * \param list the list to trim
+     * \param size the number of bytes to remove
+     * \param fromStart whether the bytes are removed from the start of the
+     *        last items (for trailers) or from their end (for headers)
+     * \returns the number of bytes which could not be removed
+     */
+    static uint32_t TrimLazy(Ptr<const LazyItem>& list, uint32_t size, bool fromStart);
+    /**
+     * \brief Remove a chunk at the start of a packet in lazy mode
+     * \param start the number of bytes to remove
+     */
+    void RemoveLazyAtStart(uint32_t start);
+    /**
+     * \brief Remove a chunk at the end of a packet in lazy mode
+     * \param end the number of bytes to remove
+     */
+    void RemoveLazyAtEnd(uint32_t end);
+    /**
+     * \brief Append a packet in lazy mode
+     * \param o the metadata of the packet to append
+     */
+    void AddLazyAtEnd(const PacketMetadata& o);
+    /**
+     * \brief Build the full metadata of a packet in lazy mode
+     * \param size the size of the packet buffer
+     * \returns the full metadata
+     */
+    PacketMetadata Materialize(uint32_t size) const;
+    /**
+     * \brief Append an item at the tail of the list, whatever the mode
+     * \param typeUid the uid of the item type, as in SmallItem
+     * \param size the size of the whole item
+     * \param fragmentStart the start of the fragment of the item
+     * \param fragmentEnd the end of the fragment of the item
+     */
+    void AppendItem(uint32_t typeUid, uint32_t size, uint32_t fragmentStart, uint32_t fragmentEnd);
+
+    static DataFreeList m_freeList; //!< the metadata data storage, unused with NS3_MTP
     static bool m_enable;           //!< Enable the packet metadata
     static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static bool m_enableLazy;       //!< Enable the lazy packet metadata
 
     /**
      * Set to true when adding metadata to a packet is skipped because
      * m_enable is false; used to detect enabling of metadata in the
-     * middle of a simulation, which isn't allowed.
-     */
+     * middle of a simulation, which isn't allowed.  With multithreaded
+     * simulation it only records the packets of the calling thread.
+     */
+#ifdef NS3_MTP
+    static thread_local bool m_metadataSkipped;
+    static thread_local uint32_t m_maxSize; //!< maximum metadata size, per thread
+    static std::atomic<uint16_t> m_chunkUid; //!< Chunk Uid
+#else
     static bool m_metadataSkipped;
 
     static uint32_t m_maxSize;  //!< maximum metadata size
     static uint16_t m_chunkUid; //!< Chunk Uid
+#endif
 
     Data* m_data; //!< Metadata storage
     /*
@@ -699,6 +850,10 @@ class PacketMetadata
     uint16_t m_tail;      //!< list tail
     uint32_t m_used;      //!< used portion
     uint64_t m_packetUid; //!< packet Uid
+
+    Ptr<const LazyItem> m_lazyHeaders;  //!< lazy mode headers, from the first one
+    Ptr<const LazyItem> m_lazyTrailers; //!< lazy mode trailers, from the last one
+    uint32_t m_lazyPayload;             //!< lazy mode payload size
 };
 
 } // namespace ns3
@@ -711,7 +866,8 @@ PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
       m_head(0xffff),
       m_tail(0xffff),
       m_used(0),
-      m_packetUid(uid)
+      m_packetUid(uid),
+      m_lazyPayload(size)
 {
     memset(m_data->m_data, 0xff, 4);
     if (size > 0)
@@ -725,7 +881,10 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_head(o.m_head),
       m_tail(o.m_tail),
       m_used(o.m_used),
-      m_packetUid(o.m_packetUid)
+      m_packetUid(o.m_packetUid),
+      m_lazyHeaders(o.m_lazyHeaders),
+      m_lazyTrailers(o.m_lazyTrailers),
+      m_lazyPayload(o.m_lazyPayload)
 {
     NS_ASSERT(m_data != nullptr);
     NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
@@ -739,8 +898,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -752,14 +910,16 @@ PacketMetadata::operator=(const PacketMetadata& o)
     m_tail = o.m_tail;
     m_used = o.m_used;
     m_packetUid = o.m_packetUid;
+    m_lazyHeaders = o.m_lazyHeaders;
+    m_lazyTrailers = o.m_lazyTrailers;
+    m_lazyPayload = o.m_lazyPayload;
     return *this;
 }
 
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
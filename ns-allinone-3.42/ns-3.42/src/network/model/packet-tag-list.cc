@@ -19,7 +19,7 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a flat list of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
@@ -30,277 +30,194 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <limits>
+#include <new>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
-PacketTagList::TagData*
-PacketTagList::CreateTagData(size_t dataSize)
+uint32_t
+PacketTagList::GetEntrySize(uint32_t dataSize)
 {
-    NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
+    NS_ASSERT_MSG(dataSize < std::numeric_limits<uint32_t>::max() - sizeof(TagData),
                   "Requested TagData size " << dataSize << " exceeds maximum "
-                                            << std::numeric_limits<decltype(TagData::size)>::max());
-
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
-
-    auto tag = new (p) TagData;
-    tag->size = dataSize;
-    return tag;
+                                            << std::numeric_limits<uint32_t>::max());
+    uint32_t size = offsetof(TagData, data) + dataSize;
+    return (size + alignof(TagData) - 1) & ~(alignof(TagData) - 1);
 }
 
-bool
-PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
+const uint8_t*
+PacketTagList::GetEntries() const
 {
-    TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
+    return m_data != nullptr ? m_data->data : m_inline;
+}
 
-    // trivial case when list is empty
-    if (m_next == nullptr)
+const PacketTagList::TagData*
+PacketTagList::Find(TypeId tid, uint32_t& offset) const
+{
+    const uint8_t* entries = GetEntries();
+    for (offset = 0; offset < m_used;)
     {
-        return false;
+        auto cur = reinterpret_cast<const TagData*>(entries + offset);
+        if (cur->tid == tid)
+        {
+            return cur;
+        }
+        offset += GetEntrySize(cur->size);
     }
+    return nullptr;
+}
 
-    bool found = false;
-
-    TagData** prevNext = &m_next; // previous node's next pointer
-    TagData* cur = m_next;        // cursor to current node
-    TagData* it = nullptr;        // utility
-
-    // Search from the head of the list until we find tid or a merge
-    while (cur != nullptr)
+uint8_t*
+PacketTagList::Resize(uint32_t offset, uint32_t oldSize, uint32_t newSize)
+{
+    NS_LOG_FUNCTION(this << offset << oldSize << newSize);
+    NS_ASSERT(offset + oldSize <= m_used);
+    uint32_t tail = m_used - offset - oldSize;
+    uint32_t used = m_used - oldSize + newSize;
+    uint8_t* entries;
+    if (m_data == nullptr && used <= INLINE_SIZE)
     {
-        if (cur->count > 1)
-        {
-            // found merge
-            NS_LOG_INFO("found initial merge before tid");
-            break;
-        }
-        else if (cur->tid == tid)
+        // inline before and after
+        entries = m_inline;
+        std::memmove(entries + offset + newSize, entries + offset + oldSize, tail);
+    }
+    else if (m_data != nullptr && m_data->count == 1 && m_data->size >= used &&
+             used > INLINE_SIZE)
+    {
+        // the heap buffer is not shared and large enough: work in place
+        entries = m_data->data;
+        std::memmove(entries + offset + newSize, entries + offset + oldSize, tail);
+    }
+    else
+    {
+        // copy to another storage, leaving the hole for the entry
+        const uint8_t* old = GetEntries();
+        Data* data = nullptr;
+        if (used <= INLINE_SIZE)
         {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
-            found = (this->*Writer)(tag, true, cur, prevNext);
-            break;
+            // old is a heap buffer here, which does not overlap m_inline
+            entries = m_inline;
         }
         else
         {
-            // no merge or tid found yet, move on
-            prevNext = &cur->next;
-            cur = cur->next;
+            uint32_t size = std::max(used, 2 * m_used);
+            void* p = std::malloc(sizeof(Data) - sizeof(Data::data) + size);
+            // The matching frees are in RemoveAll and just below
+            data = new (p) Data;
+            data->count = 1;
+            data->size = size;
+            entries = data->data;
         }
-    } // while !found && !cow
-
-    // did we find it or run out of tags?
-    if (cur == nullptr || found)
-    {
-        NS_LOG_INFO("returning after header with found: " << found);
-        return found;
-    }
-
-    // From here on out, we have to copy the list
-    // until we find tid, then link past it
-
-    // Before we do all that work, let's make sure tid really exists
-    for (it = cur; it != nullptr; it = it->next)
-    {
-        if (it->tid == tid)
+        std::memmove(entries, old, offset);
+        std::memmove(entries + offset + newSize, old + offset + oldSize, tail);
+        if (m_data != nullptr && --m_data->count == 0)
         {
-            break;
+            std::free(m_data);
         }
+        m_data = data;
     }
-    if (it == nullptr)
-    {
-        // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
-        return found;
-    }
-
-    // At this point cur is a merge, but untested for tid
-    NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
-
-    /*
-       Walk the remainder of the list, copying, until we find tid
-       As we put a copy of the cur node onto our list,
-       we move the merge point down the list.
-
-       Starting position                  End position
-         T1 is a merge                     T1.count decremented
-                                           T2 is a merge
-                                           T1' is a copy of T1
-
-            other                             other
-                 \                                 \
-        Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-             /   /                                         /|
-        pNext cur                         Prev  ->  T1' --/ |
-                                                       /    |
-                                                  pNext   cur
-
-       When we reach tid, we link past it, decrement count, and we're done.
-    */
-
-    // Should normally check for null cur pointer,
-    // but since we know tid exists, we'll skip this test
-    while (/* cur && */ cur->tid != tid)
-    {
-        NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(cur->size);
-        copy->tid = cur->tid;
-        copy->count = 1;
-        copy->size = cur->size;
-        memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
-        cur = copy->next;
-    }
-    // Sanity check:
-    NS_ASSERT(cur != nullptr);  // cur should be non-zero
-    NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
-
-    // link around tid, removing it from our list
-    found = (this->*Writer)(tag, false, cur, prevNext);
-    return found;
+    m_used = used;
+    return entries + offset;
 }
 
 bool
 PacketTagList::Remove(Tag& tag)
 {
-    return COWTraverse(tag, &PacketTagList::RemoveWriter);
-}
-
-// COWWriter implementing Remove
-bool
-PacketTagList::RemoveWriter(Tag& tag,
-                            bool preMerge,
-                            PacketTagList::TagData* cur,
-                            PacketTagList::TagData** prevNext)
-{
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-    *prevNext = cur->next; // link around cur
-
-    if (preMerge)
-    {
-        // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
-    }
-    else
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t offset;
+    const TagData* cur = Find(tid, offset);
+    if (cur == nullptr)
     {
-        // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
-        if (cur->next != nullptr)
-        {
-            // there's a next, so make it a merge
-            cur->next->count++;
-        }
+        return false;
     }
-    return found;
+    tag.Deserialize(TagBuffer(const_cast<uint8_t*>(cur->data),
+                              const_cast<uint8_t*>(cur->data) + cur->size));
+    Resize(offset, GetEntrySize(cur->size), 0);
+    return true;
 }
 
 bool
 PacketTagList::Replace(Tag& tag)
 {
-    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
-    if (!found)
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t offset;
+    const TagData* cur = Find(tid, offset);
+    if (cur == nullptr)
     {
         Add(tag);
+        return false;
     }
-    return found;
-}
-
-// COWWriter implementing Replace
-bool
-PacketTagList::ReplaceWriter(Tag& tag,
-                             bool preMerge,
-                             PacketTagList::TagData* cur,
-                             PacketTagList::TagData** prevNext)
-{
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    if (preMerge)
-    {
-        // found tid before first merge, so just rewrite
-        tag.Serialize(TagBuffer(cur->data, cur->data + cur->size));
-    }
-    else
-    {
-        // cur is always a merge at this point
-        // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(tag.GetSerializedSize());
-        copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
-        tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
-        copy->next = cur->next; // merge into tail
-        if (copy->next != nullptr)
-        {
-            copy->next->count++; // mark new merge
-        }
-        *prevNext = copy; // point prior list at copy
-    }
-    return found;
+    uint32_t size = tag.GetSerializedSize();
+    auto entry =
+        reinterpret_cast<TagData*>(Resize(offset, GetEntrySize(cur->size), GetEntrySize(size)));
+    entry->tid = tid;
+    entry->size = size;
+    tag.Serialize(TagBuffer(entry->data, entry->data + size));
+    return true;
 }
 
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
     // ensure this id was not yet added
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
-                      "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
-    }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
-    head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
-    head->next = m_next;
-    tag.Serialize(TagBuffer(head->data, head->data + head->size));
-
-    const_cast<PacketTagList*>(this)->m_next = head;
+    [[maybe_unused]] uint32_t offset;
+    NS_ASSERT_MSG(Find(tid, offset) == nullptr,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tid.GetName());
+    uint32_t size = tag.GetSerializedSize();
+    auto entry = reinterpret_cast<TagData*>(
+        const_cast<PacketTagList*>(this)->Resize(0, 0, GetEntrySize(size)));
+    entry->tid = tid;
+    entry->size = size;
+    tag.Serialize(TagBuffer(entry->data, entry->data + size));
 }
 
 bool
 PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
-    TypeId tid = tag.GetInstanceTypeId();
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    uint32_t offset;
+    const TagData* cur = Find(tag.GetInstanceTypeId(), offset);
+    if (cur == nullptr)
     {
-        if (cur->tid == tid)
-        {
-            /* found tag */
-            tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-            return true;
-        }
+        /* no tag found */
+        return false;
     }
-    /* no tag found */
-    return false;
+    /* found tag */
+    tag.Deserialize(TagBuffer(const_cast<uint8_t*>(cur->data),
+                              const_cast<uint8_t*>(cur->data) + cur->size));
+    return true;
 }
 
 const PacketTagList::TagData*
 PacketTagList::Head() const
 {
-    return m_next;
+    if (m_used == 0)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const TagData*>(GetEntries());
+}
+
+const PacketTagList::TagData*
+PacketTagList::Next(const PacketTagList::TagData* cur) const
+{
+    auto next = reinterpret_cast<const uint8_t*>(cur) + GetEntrySize(cur->size);
+    if (next >= GetEntries() + m_used)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const TagData*>(next);
 }
 
 uint32_t
@@ -312,7 +229,7 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != nullptr; cur = Next(cur))
     {
         size += 4; // TagData -> size
 
@@ -346,7 +263,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != nullptr; cur = Next(cur))
     {
         size += 4;
 
@@ -404,7 +321,7 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
     NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-    TagData* prevTag = nullptr;
+    RemoveAll();
     for (uint32_t i = 0; i < numberOfTags; ++i)
     {
         NS_ASSERT(sizeCheck >= 4);
@@ -422,10 +339,10 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
+        // Append, to keep the order of the serialized list
+        auto newTag = reinterpret_cast<TagData*>(Resize(m_used, 0, GetEntrySize(tagSize)));
         newTag->tid = tid;
+        newTag->size = tagSize;
 
         NS_ASSERT(sizeCheck >= tagSize);
         memcpy(newTag->data, p, tagSize);
@@ -434,18 +351,6 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
     }
 
     NS_ASSERT(sizeCheck == 0);
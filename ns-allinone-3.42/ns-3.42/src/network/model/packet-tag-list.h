@@ -21,14 +21,20 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a flat list of Packet tags, including copy-on-write semantics.
 */
 
 #include "ns3/type-id.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <ostream>
 #include <stdint.h>
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 namespace ns3
 {
 
@@ -44,88 +50,31 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
- *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * \enddot
- *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
- *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
- *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ * The tags are stored in serialized form, one after the other, in a
+ * single contiguous byte buffer:
  *
- * \par <b> Copy-on-write </b> is implemented as follows:
+ *   - Each entry is a TagData header (the TypeId of the tag and the
+ *     size of its serialized data) followed by the tag data, padded to
+ *     the alignment of TagData.  The most recently added tag comes first.
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
+ *   - The first #INLINE_SIZE bytes of entries are stored inline, in the
+ *     PacketTagList itself, so that the handful of tags carried by a
+ *     typical packet never touch the heap.  Copying such a list copies
+ *     the used bytes.
  *
- *   - Copy constructor (PacketTagList(const PacketTagList & o))
- *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
+ *   - Longer lists are moved to a reference-counted heap buffer which is
+ *     shared by the copies of the list.  Add, #Remove and #Replace
+ *     unshare it first (copy-on-write), and move the list back inline
+ *     when the result fits.
  *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - Lookups scan the entries comparing the TypeId of each tag, which
+ *     for a few tags on contiguous memory is cheaper than any index.
  */
 class PacketTagList
 {
   public:
     /**
-     * Tree node for sharing serialized tags.
+     * Header of each serialized tag in the list.
      *
      * See PacketTagList for a discussion of the data structure.
      *
@@ -134,20 +83,17 @@ class PacketTagList
      * PacketTagIterator::Item::GetTag() needs the data and size values.
      * The Item nested class can't be forward declared, so friending isn't
      * possible.
-     *
-     * We use placement new so we can allocate enough room for the Tag
-     * type which will be serialized into data.  See Object::Aggregates
-     * for a similar construction.
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
         TypeId tid;      //!< Type of the tag serialized into #data
         uint32_t size;   //!< Size of the \c data buffer
         uint8_t data[1]; //!< Serialization buffer
     };
 
+    /// Number of bytes of tag entries stored without a heap allocation
+    static constexpr uint32_t INLINE_SIZE = 48;
+
     /**
      * Create a new PacketTagList.
      */
@@ -157,8 +103,8 @@ class PacketTagList
      *
      * \param [in] o The PacketTagList to copy.
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This copies the inline tags of \pname{o}, or shares
+     * its heap buffer.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -168,18 +114,18 @@ class PacketTagList
      * \returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * copying the inline tags of \pname{o}, or sharing its heap buffer.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
      * Destructor
      *
-     * #RemoveAll's the tags up to the first merge.
+     * #RemoveAll's the tags.
      */
     inline ~PacketTagList();
 
     /**
-     * Add a tag to the head of this branch.
+     * Add a tag to the head of this list.
      *
      * \param [in] tag The tag to add
      */
@@ -211,13 +157,19 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list.
      */
     inline void RemoveAll();
     /**
-     * \returns pointer to head of tag list
+     * \returns pointer to head of tag list, or null if the list is empty
      */
     const PacketTagList::TagData* Head() const;
+    /**
+     * \param [in] cur A tag of this list.
+     * \returns pointer to the tag following \pname{cur}, or null if
+     *          \pname{cur} is the last one
+     */
+    const PacketTagList::TagData* Next(const PacketTagList::TagData* cur) const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -245,66 +197,60 @@ class PacketTagList
 
   private:
     /**
-     * Allocate and construct a TagData struct, sizing the data area
-     * large enough to serialize dataSize bytes from a Tag.
+     * Heap buffer holding the entries of lists longer than #INLINE_SIZE.
      *
-     * \param [in] dataSize The serialized size of the Tag.
-     * \returns The newly constructed TagData object.
+     * We use malloc so we can allocate enough room after the structure
+     * for the entries.
      */
-    static TagData* CreateTagData(size_t dataSize);
+    struct Data
+    {
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< Number of lists sharing this buffer
+#else
+        uint32_t count;  //!< Number of lists sharing this buffer
+#endif
+        uint32_t size;   //!< Size of the \c data buffer
+        uint8_t data[4]; //!< Tag entries
+    };
 
     /**
-     * Typedef of method function pointer for copy-on-write operations
-     *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True if operation successful, false otherwise
+     * \param [in] dataSize The serialized size of a Tag.
+     * \returns The number of bytes taken by the entry of the tag.
      */
-    typedef bool (PacketTagList::*COWWriter)(Tag& tag,
-                                             bool preMerge,
-                                             TagData* cur,
-                                             TagData** prevNext);
+    static uint32_t GetEntrySize(uint32_t dataSize);
+
     /**
-     * Traverse the list implementing copy-on-write, using \pname{Writer}.
-     *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] Writer The copy-on-write function to use.
-     * \returns True if \pname{tag} found, false otherwise.
+     * \returns The first byte of the entries.
      */
-    bool COWTraverse(Tag& tag, PacketTagList::COWWriter Writer);
+    const uint8_t* GetEntries() const;
+
     /**
-     * Copy-on-write implementing Remove.
+     * Find the entry of a tag type.
      *
-     * \param [in] tag The target tag type to remove.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag will definitely be removed.
+     * \param [in] tid The tag type to look for.
+     * \param [out] offset The offset of the entry in the list, if found.
+     * \returns The entry of the tag, or null if the list has none.
      */
-    bool RemoveWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    const TagData* Find(TypeId tid, uint32_t& offset) const;
+
     /**
-     * Copy-on-write implementing Replace
+     * Resize the entry at \pname{offset}, unsharing the buffer first
+     * if it is shared and moving the entries to or from the
+     * inline storage as needed.
      *
-     * \param [in] tag The target tag type to replace
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *          false otherwise.
-     * \param [in] cur Pointer to the tag
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag value will definitely be replaced.
+     * \param [in] offset The offset of the entry.
+     * \param [in] oldSize The current size of the entry, zero to insert one.
+     * \param [in] newSize The new size of the entry, zero to remove it.
+     * \returns The first byte of the entry, whose content must be rewritten.
      */
-    bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    uint8_t* Resize(uint32_t offset, uint32_t oldSize, uint32_t newSize);
 
-    /**
-     * Pointer to first \ref TagData on the list
-     */
-    TagData* m_next;
+    /// Number of bytes of entries
+    uint32_t m_used;
+    /// Heap buffer holding the entries, or null if they are inline
+    Data* m_data;
+    /// Inline storage for the entries
+    alignas(TagData) uint8_t m_inline[INLINE_SIZE];
 };
 
 } // namespace ns3
@@ -317,16 +263,22 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_used(0),
+      m_data(nullptr)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_used(o.m_used),
+      m_data(o.m_data)
 {
-    if (m_next != nullptr)
+    if (m_data != nullptr)
+    {
+        m_data->count++;
+    }
+    else
     {
-        m_next->count++;
+        std::memcpy(m_inline, o.m_inline, m_used);
     }
 }
 
@@ -334,15 +286,20 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
     RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    m_used = o.m_used;
+    m_data = o.m_data;
+    if (m_data != nullptr)
     {
-        m_next->count++;
+        m_data->count++;
+    }
+    else
+    {
+        std::memcpy(m_inline, o.m_inline, m_used);
     }
     return *this;
 }
@@ -355,27 +312,12 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
-    TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        cur->count--;
-        if (cur->count > 0)
-        {
-            break;
-        }
-        if (prev != nullptr)
-        {
-            prev->~TagData();
-            std::free(prev);
-        }
-        prev = cur;
-    }
-    if (prev != nullptr)
+    if (m_data != nullptr && --m_data->count == 0)
     {
-        prev->~TagData();
-        std::free(prev);
+        std::free(m_data);
     }
-    m_next = nullptr;
+    m_data = nullptr;
+    m_used = 0;
 }
 
 } // namespace ns3
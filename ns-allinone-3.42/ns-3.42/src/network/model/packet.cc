@@ -25,12 +25,131 @@
 #include <cstdarg>
 #include <string>
 
+#if defined(__SANITIZE_ADDRESS__)
+#define NS3_PACKET_POOL 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define NS3_PACKET_POOL 0
+#endif
+#endif
+#ifndef NS3_PACKET_POOL
+#define NS3_PACKET_POOL 1
+#endif
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+std::atomic<uint32_t> Packet::m_globalUid = 0;
+#else
 uint32_t Packet::m_globalUid = 0;
+#endif
+
+#if NS3_PACKET_POOL
+namespace
+{
+
+/** Maximum number of free packets kept per thread. */
+constexpr uint32_t PACKET_POOL_MAX_FREE = 1 << 14;
+
+/** A free packet block, linked in the free list of its thread. */
+struct FreePacket
+{
+    FreePacket* next; //!< Next free packet block.
+};
+
+/**
+ * The free list of one thread.
+ *
+ * Blocks are allocated one by one with the global allocator, so that a
+ * packet can be destroyed by another thread than the one which created it,
+ * as happens with the multithreaded simulator.
+ */
+struct PacketPool
+{
+    FreePacket* head = nullptr; //!< Free list.
+    uint32_t count = 0;         //!< Free list length.
+
+    /** Release the cached blocks when the thread exits. */
+    ~PacketPool();
+};
+
+/**
+ * Whether the free list of this thread has been released, at thread or
+ * program exit.  Packets destroyed afterwards, e.g. by static objects, go
+ * straight to the global allocator.
+ */
+thread_local bool g_packetPoolReleased = false;
+
+/** The free list of this thread. */
+thread_local PacketPool g_packetPool;
+
+PacketPool::~PacketPool()
+{
+    g_packetPoolReleased = true;
+    while (head != nullptr)
+    {
+        FreePacket* block = head;
+        head = block->next;
+        ::operator delete(block);
+    }
+    count = 0;
+}
+
+/**
+ * Get the free list of this thread, if it can still be used.
+ *
+ * \returns The free list, or nullptr after it has been released.
+ */
+inline PacketPool*
+GetPacketPool()
+{
+    return g_packetPoolReleased ? nullptr : &g_packetPool;
+}
+
+} // namespace
+#endif /* NS3_PACKET_POOL */
+
+void*
+Packet::operator new(std::size_t size)
+{
+#if NS3_PACKET_POOL
+    if (size == sizeof(Packet))
+    {
+        PacketPool* pool = GetPacketPool();
+        if (pool != nullptr && pool->head != nullptr)
+        {
+            FreePacket* block = pool->head;
+            pool->head = block->next;
+            pool->count--;
+            return block;
+        }
+    }
+#endif
+    return ::operator new(size);
+}
+
+void
+Packet::operator delete(void* ptr, [[maybe_unused]] std::size_t size)
+{
+#if NS3_PACKET_POOL
+    if (size == sizeof(Packet))
+    {
+        PacketPool* pool = GetPacketPool();
+        if (pool != nullptr && pool->count < PACKET_POOL_MAX_FREE)
+        {
+            auto block = static_cast<FreePacket*>(ptr);
+            block->next = pool->head;
+            pool->head = block;
+            pool->count++;
+            return;
+        }
+    }
+#endif
+    ::operator delete(ptr);
+}
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -89,8 +208,9 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList& list)
+    : m_list(&list),
+      m_current(list.Head())
 {
 }
 
@@ -105,7 +225,7 @@ PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
     const PacketTagList::TagData* prev = m_current;
-    m_current = m_current->next;
+    m_current = m_list->Next(m_current);
     return PacketTagIterator::Item(prev);
 }
 
@@ -146,17 +266,17 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
     : m_buffer(o.m_buffer),
       m_byteTagList(o.m_byteTagList),
       m_packetTagList(o.m_packetTagList),
-      m_metadata(o.m_metadata)
+      m_metadata(o.m_metadata),
+      m_fixedFields(o.m_fixedFields)
 {
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
 }
@@ -173,6 +293,7 @@ Packet::operator=(const Packet& o)
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
+    m_fixedFields = o.m_fixedFields;
     return *this;
 }
 
@@ -186,10 +307,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -213,10 +333,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++, size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -249,6 +368,7 @@ Packet::CreateFragment(uint32_t start, uint32_t length) const
     Ptr<Packet> ret =
         Ptr<Packet>(new Packet(buffer, byteTagList, m_packetTagList, metadata), false);
     ret->SetNixVector(GetNixVector());
+    ret->m_fixedFields = m_fixedFields;
     return ret;
 }
 
@@ -264,6 +384,73 @@ Packet::GetNixVector() const
     return m_nixVector;
 }
 
+Packet::FixedFields&
+Packet::GetWritableFixedFields() const
+{
+    // copy on write, as the fields may be shared with other packets
+    Ptr<FixedFields> fields =
+        m_fixedFields ? Create<FixedFields>(*m_fixedFields) : Create<FixedFields>();
+    m_fixedFields = fields;
+    return *fields;
+}
+
+void
+Packet::SetTimestamp(Time timestamp) const
+{
+    FixedFields& fields = GetWritableFixedFields();
+    fields.timestamp = timestamp.GetTimeStep();
+    fields.set |= FixedFields::FIELD_TIMESTAMP;
+}
+
+bool
+Packet::GetTimestamp(Time& timestamp) const
+{
+    if (!m_fixedFields || !(m_fixedFields->set & FixedFields::FIELD_TIMESTAMP))
+    {
+        return false;
+    }
+    timestamp = TimeStep(m_fixedFields->timestamp);
+    return true;
+}
+
+void
+Packet::SetFlowId(uint32_t flowId) const
+{
+    FixedFields& fields = GetWritableFixedFields();
+    fields.flowId = flowId;
+    fields.set |= FixedFields::FIELD_FLOW_ID;
+}
+
+bool
+Packet::GetFlowId(uint32_t& flowId) const
+{
+    if (!m_fixedFields || !(m_fixedFields->set & FixedFields::FIELD_FLOW_ID))
+    {
+        return false;
+    }
+    flowId = m_fixedFields->flowId;
+    return true;
+}
+
+void
+Packet::SetUserData(uint64_t userData) const
+{
+    FixedFields& fields = GetWritableFixedFields();
+    fields.userData = userData;
+    fields.set |= FixedFields::FIELD_USER_DATA;
+}
+
+bool
+Packet::GetUserData(uint64_t& userData) const
+{
+    if (!m_fixedFields || !(m_fixedFields->set & FixedFields::FIELD_USER_DATA))
+    {
+        return false;
+    }
+    userData = m_fixedFields->userData;
+    return true;
+}
+
 void
 Packet::AddHeader(const Header& header)
 {
@@ -599,6 +786,13 @@ Packet::EnablePrinting()
     PacketMetadata::Enable();
 }
 
+void
+Packet::EnableLazyPrinting()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketMetadata::EnableLazy();
+}
+
 void
 Packet::EnableChecking()
 {
@@ -1019,7 +1213,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList);
 }
 
 std::ostream&
@@ -31,9 +31,16 @@
 #include "ns3/assert.h"
 #include "ns3/callback.h"
 #include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 
+#include <cstddef>
 #include <stdint.h>
+#include <type_traits>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 namespace ns3
 {
@@ -180,9 +187,10 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * \param head head of the items
+     * \param list the list of the items
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
+    PacketTagIterator(const PacketTagList& list);
+    const PacketTagList* m_list;             //!< the list of tags in a packet
     const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
 };
 
@@ -203,7 +211,9 @@ class PacketTagIterator
  * were serialized in the byte buffer. The maintenance of metadata is
  * optional and disabled by default. To enable it, you must call
  * Packet::EnablePrinting and this will allow you to get non-empty
- * output from Packet::Print. If you wish to only enable
+ * output from Packet::Print. Packet::EnableLazyPrinting gives the same
+ * output for most packets at a much lower cost, by building the metadata
+ * only when a packet is printed. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than
  * Packet::EnablePrinting.
@@ -224,6 +234,12 @@ class PacketTagIterator
  * qos class id set by an application and processed by a lower-level MAC
  * layer.
  *
+ * A packet also has a few fixed fields, a time stamp, a flow id and some
+ * user data, for the measurements which only need a value per packet,
+ * such as the delay since the packet was created: they are set and read
+ * in constant time, without the tag list manipulation of a TimestampTag
+ * or a FlowIdTag.
+ *
  * Implementing a new type of Header or Trailer for a new protocol is
  * pretty easy and is a matter of creating a subclass of the ns3::Header
  * or of the ns3::Trailer base class, and implementing the methods
@@ -234,6 +250,11 @@ class PacketTagIterator
  *
  * The performance aspects copy-on-write semantics of the
  * Packet API are discussed in \ref packetperf
+ *
+ * Packet objects are allocated from a per-thread free list, so that
+ * creating or copying a packet usually reuses the memory of a packet which
+ * has already been destroyed instead of calling the global allocator.
+ * Builds with AddressSanitizer enabled bypass the free list.
  */
 class Packet : public SimpleRefCount<Packet>
 {
@@ -254,6 +275,18 @@ class Packet : public SimpleRefCount<Packet>
      * \return the copied object
      */
     Packet& operator=(const Packet& o);
+    /**
+     * \brief Allocate memory for a packet, from the free list of this thread.
+     * \param size the size of the packet object
+     * \return the allocated memory
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * \brief Release the memory of a packet, to the free list of this thread.
+     * \param ptr the packet memory
+     * \param size the size of the packet object
+     */
+    static void operator delete(void* ptr, std::size_t size);
     /**
      * \brief Create a packet with a zero-filled payload.
      *
@@ -319,6 +352,17 @@ class Packet : public SimpleRefCount<Packet>
      * \param header a reference to the header to add to this packet.
      */
     void AddHeader(const Header& header);
+    /**
+     * \brief Add a header whose serialized size is known at compile time.
+     *
+     * Same as AddHeader(const Header&), except that the size of the header
+     * is a constant and its Serialize method is bound statically.
+     *
+     * \tparam T \deduced the header type (see HasFixedSerializedSize)
+     * \param header a reference to the header to add to this packet.
+     */
+    template <typename T, typename = std::enable_if_t<HasFixedSerializedSize<T>::value>>
+    void AddHeader(const T& header);
     /**
      * \brief Deserialize and remove the header from the internal buffer.
      *
@@ -329,6 +373,19 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the number of bytes removed from the packet.
      */
     uint32_t RemoveHeader(Header& header);
+    /**
+     * \brief Deserialize and remove a header whose serialized size is known at
+     * compile time.
+     *
+     * Same as RemoveHeader(Header&), except that the size of the header is a
+     * constant and its Deserialize method is bound statically.
+     *
+     * \tparam T \deduced the header type (see HasFixedSerializedSize)
+     * \param header a reference to the header to remove from the internal buffer.
+     * \returns the number of bytes removed from the packet.
+     */
+    template <typename T, typename = std::enable_if_t<HasFixedSerializedSize<T>::value>>
+    uint32_t RemoveHeader(T& header);
     /**
      * \brief Deserialize and remove the header from the internal buffer.
      *
@@ -350,6 +407,19 @@ class Packet : public SimpleRefCount<Packet>
      * \returns the number of bytes read from the packet.
      */
     uint32_t PeekHeader(Header& header) const;
+    /**
+     * \brief Deserialize, without removing it, a header whose serialized size
+     * is known at compile time.
+     *
+     * Same as PeekHeader(Header&), except that the Deserialize method of the
+     * header is bound statically.
+     *
+     * \tparam T \deduced the header type (see HasFixedSerializedSize)
+     * \param header a reference to the header to read from the internal buffer.
+     * \returns the number of bytes read from the packet.
+     */
+    template <typename T, typename = std::enable_if_t<HasFixedSerializedSize<T>::value>>
+    uint32_t PeekHeader(T& header) const;
     /**
      * \brief Deserialize but does _not_ remove the header from the internal buffer.
      * s
@@ -525,6 +595,20 @@ class Packet : public SimpleRefCount<Packet>
      * simulation setup and before any packet is created.
      */
     static void EnablePrinting();
+    /**
+     * \brief Enable printing packets from a lazily built metadata.
+     *
+     * Packets only record the types and sizes of their headers and
+     * trailers, in lists shared with their copies, and the metadata used
+     * by the Print methods is built when a packet is printed. This costs
+     * much less than EnablePrinting when only a few packets are printed,
+     * e.g. by a single ascii trace sink. Once this method has been called,
+     * EnablePrinting does nothing. As for EnablePrinting, this method must
+     * be invoked before any packet is created.
+     *
+     * \sa PacketMetadata::EnableLazy
+     */
+    static void EnableLazyPrinting();
     /**
      * \brief Enable packets metadata checking.
      *
@@ -716,6 +800,66 @@ class Packet : public SimpleRefCount<Packet>
      */
     Ptr<NixVector> GetNixVector() const;
 
+    /**
+     * \brief Set the time stamp of the packet, e.g. its creation time.
+     *
+     * The time stamp, the flow id and the user data are fixed fields of
+     * the packet, which are set and read in constant time.  Like the
+     * packet tags, they follow the packet: they are kept by Copy() and
+     * CreateFragment(), and a packet keeps its own when other packets are
+     * added to it with AddAtEnd().  They are not serialized, and they are
+     * lost by the protocols which build new packets from the received
+     * bytes, such as TCP: use a byte tag to follow such bytes instead.
+     *
+     * The fields are stored in a block allocated when a field is first set
+     * and shared by the copies of the packet, so that the packets which do
+     * not use them only carry a null pointer.
+     *
+     * \warning Like AddByteTag(), this function is const so that the
+     * fields of a packet can be set by the code which only holds a
+     * Ptr<const Packet>, e.g. from a trace source.
+     *
+     * \param timestamp the time stamp
+     */
+    void SetTimestamp(Time timestamp) const;
+    /**
+     * \brief Get the time stamp of the packet.
+     *
+     * \param [out] timestamp the time stamp, if it was set
+     * \returns true if the time stamp was set with SetTimestamp()
+     */
+    bool GetTimestamp(Time& timestamp) const;
+    /**
+     * \brief Set the flow id of the packet.
+     *
+     * \see SetTimestamp
+     *
+     * \param flowId the flow id, e.g. from FlowIdTag::AllocateFlowId()
+     */
+    void SetFlowId(uint32_t flowId) const;
+    /**
+     * \brief Get the flow id of the packet.
+     *
+     * \param [out] flowId the flow id, if it was set
+     * \returns true if the flow id was set with SetFlowId()
+     */
+    bool GetFlowId(uint32_t& flowId) const;
+    /**
+     * \brief Set the user data of the packet.
+     *
+     * \see SetTimestamp
+     *
+     * \param userData the user data
+     */
+    void SetUserData(uint64_t userData) const;
+    /**
+     * \brief Get the user data of the packet.
+     *
+     * \param [out] userData the user data, if it was set
+     * \returns true if the user data was set with SetUserData()
+     */
+    bool GetUserData(uint64_t& userData) const;
+
     /**
      * TracedCallback signature for Ptr<Packet>
      *
@@ -795,7 +939,36 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+    /**
+     * The fixed fields of the packet, see SetTimestamp(). They are shared by
+     * the copies of the packet until one of them sets a field.
+     */
+    struct FixedFields : public SimpleRefCount<FixedFields>
+    {
+        int64_t timestamp{0}; //!< the time stamp, in time steps
+        uint64_t userData{0}; //!< the user data
+        uint32_t flowId{0};   //!< the flow id
+        uint8_t set{0};       //!< the fields set, from the FIELD_ bits below
+
+        static constexpr uint8_t FIELD_TIMESTAMP{1 << 0}; //!< the time stamp is set
+        static constexpr uint8_t FIELD_FLOW_ID{1 << 1};   //!< the flow id is set
+        static constexpr uint8_t FIELD_USER_DATA{1 << 2}; //!< the user data is set
+    };
+
+    /**
+     * \brief Get the fixed fields of the packet, to set one of them
+     * \returns fixed fields owned by this packet only
+     */
+    FixedFields& GetWritableFixedFields() const;
+
+    /// the packet's fixed fields, allocated when a field is first set
+    mutable Ptr<const FixedFields> m_fixedFields;
+
+#ifdef NS3_MTP
+    static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
+#else
     static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
 };
 
 /**
@@ -863,6 +1036,48 @@ Packet::GetSize() const
     return m_buffer.GetSize();
 }
 
+template <typename T, typename>
+void
+Packet::AddHeader(const T& header)
+{
+    static_assert(std::is_final_v<T>, "A header with a fixed serialized size must be final");
+    constexpr uint32_t size = T::SERIALIZED_SIZE;
+    NS_ASSERT_MSG(header.T::GetSerializedSize() == size,
+                  "Serialized size of " << T::GetTypeId().GetName() << " is not constant");
+    m_buffer.AddAtStart(size);
+    m_byteTagList.Adjust(size);
+    m_byteTagList.AddAtStart(size);
+    header.T::Serialize(m_buffer.Begin());
+    m_metadata.AddHeader(header, size);
+}
+
+template <typename T, typename>
+uint32_t
+Packet::RemoveHeader(T& header)
+{
+    static_assert(std::is_final_v<T>, "A header with a fixed serialized size must be final");
+    constexpr uint32_t size = T::SERIALIZED_SIZE;
+    [[maybe_unused]] uint32_t deserialized = header.T::Deserialize(m_buffer.Begin());
+    NS_ASSERT_MSG(deserialized == size,
+                  "Serialized size of " << T::GetTypeId().GetName() << " is not constant");
+    m_buffer.RemoveAtStart(size);
+    m_byteTagList.Adjust(-static_cast<int32_t>(size));
+    m_metadata.RemoveHeader(header, size);
+    return size;
+}
+
+template <typename T, typename>
+uint32_t
+Packet::PeekHeader(T& header) const
+{
+    static_assert(std::is_final_v<T>, "A header with a fixed serialized size must be final");
+    constexpr uint32_t size = T::SERIALIZED_SIZE;
+    [[maybe_unused]] uint32_t deserialized = header.T::Deserialize(m_buffer.Begin());
+    NS_ASSERT_MSG(deserialized == size,
+                  "Serialized size of " << T::GetTypeId().GetName() << " is not constant");
+    return size;
+}
+
 } // namespace ns3
 
 #endif /* PACKET_H */
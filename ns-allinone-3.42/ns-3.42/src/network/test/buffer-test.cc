@@ -353,6 +353,42 @@ BufferTest::DoRun()
     i.Write(buffer.Begin(), buffer.End());
     ENSURE_WRITTEN_BYTES(other, 9, 0x1, 0x2, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3, 0x4);
 
+    // Reassembling fragments of a zero-filled payload keeps it virtual
+    buffer = Buffer(3000);
+    buffer.AddAtStart(2);
+    i = buffer.Begin();
+    i.WriteU8(0x1);
+    i.WriteU8(0x2);
+    frag0 = buffer.CreateFragment(0, 1002);
+    frag1 = buffer.CreateFragment(1002, 1000);
+    Buffer frag2 = buffer.CreateFragment(2002, 1000);
+    frag0.AddAtEnd(frag1);
+    frag0.AddAtEnd(frag2);
+    NS_TEST_EXPECT_MSG_EQ(frag0.GetSize(), 3002, "Bad reassembled size");
+    NS_TEST_EXPECT_MSG_LT(frag0.GetSerializedSize(), 100, "Zero area copied");
+    ENSURE_WRITTEN_BYTES(frag0, 4, 0x1, 0x2, 0x00, 0x00);
+    ENSURE_WRITTEN_BYTES(buffer, 4, 0x1, 0x2, 0x00, 0x00);
+
+    // A small zero area is written out in front of a larger one
+    Buffer small = Buffer(10);
+    small.AddAtEnd(1);
+    i = small.End();
+    i.Prev(1);
+    i.WriteU8(0x3);
+    Buffer large = Buffer(1000);
+    large.AddAtEnd(1);
+    i = large.End();
+    i.Prev(1);
+    i.WriteU8(0x4);
+    small.AddAtEnd(large);
+    NS_TEST_EXPECT_MSG_EQ(small.GetSize(), 1012, "Bad concatenated size");
+    NS_TEST_EXPECT_MSG_LT(small.GetSerializedSize(), 100, "Large zero area copied");
+    i = small.Begin();
+    i.Next(10);
+    NS_TEST_EXPECT_MSG_EQ(i.ReadU8(), 0x3, "Bad first buffer data");
+    i.Next(1000);
+    NS_TEST_EXPECT_MSG_EQ(i.ReadU8(), 0x4, "Bad second buffer data");
+
     // See \bugid{1001}
     std::string ct("This is the next content of the buffer.");
     buffer = Buffer();
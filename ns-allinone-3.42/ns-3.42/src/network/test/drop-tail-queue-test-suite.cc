@@ -16,8 +16,14 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/packet-memory-budget.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -87,6 +93,192 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * RingBuffer unit tests.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Check the ring buffer used to store the items of a queue")
+{
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    // wrap around the end of the storage many times through a drop tail queue
+    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    queue->SetMaxSize(QueueSize("20p"));
+
+    std::vector<Ptr<Packet>> packets;
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        packets.push_back(Create<Packet>(i));
+        queue->Enqueue(packets.back());
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->Enqueue(Create<Packet>()), false, "The queue should be full");
+
+    for (uint32_t i = 20; i < 1000; i++)
+    {
+        Ptr<Packet> packet = queue->Dequeue();
+        NS_TEST_EXPECT_MSG_EQ(packet, packets[i - 20], "Packets must be dequeued in FIFO order");
+        packets.push_back(Create<Packet>(i % 100));
+        queue->Enqueue(packets.back());
+        NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 20, "There should be 20 packets in there");
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue->Peek(), packets[980], "Unexpected packet at the head");
+    NS_TEST_EXPECT_MSG_EQ(queue->Remove(), packets[980], "Unexpected packet removed");
+    queue->Flush();
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 0, "There should be no packets in there");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNBytes(), 0, "There should be no bytes in there");
+
+    // iterators refer to logical positions, which survive reallocations and
+    // insertions at either end
+    RingBuffer<int> ring;
+    RingBuffer<int>::iterator first = ring.insert(ring.end(), 1);
+    RingBuffer<int>::iterator last = ring.insert(ring.end(), 2);
+    for (int i = 3; i <= 40; i++)
+    {
+        ring.insert(ring.begin(), -i);
+        last = ring.insert(ring.end(), i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(ring.size(), 78, "Unexpected number of elements");
+    NS_TEST_EXPECT_MSG_EQ(ring.capacity(), 128, "The capacity should be a power of two");
+    NS_TEST_EXPECT_MSG_EQ(*first, 1, "Iterator invalidated by a reallocation");
+    NS_TEST_EXPECT_MSG_EQ(*last, 40, "Iterator invalidated by a reallocation");
+    NS_TEST_EXPECT_MSG_EQ(*ring.begin(), -40, "Unexpected first element");
+
+    // insert and erase in the middle
+    RingBuffer<int>::iterator it = ring.insert(first, 0);
+    NS_TEST_EXPECT_MSG_EQ(*it, 0, "Unexpected inserted element");
+    NS_TEST_EXPECT_MSG_EQ(*++it, 1, "Elements after the insertion point should be shifted");
+    it = ring.erase(ring.erase(--it));
+    NS_TEST_EXPECT_MSG_EQ(*it, 2, "Unexpected element after the erased ones");
+
+    int expected = -40;
+    for (RingBuffer<int>::const_iterator cit = ring.begin(); cit != ring.end(); ++cit)
+    {
+        NS_TEST_EXPECT_MSG_EQ(*cit, expected, "Unexpected element");
+        expected = (expected == -3 ? 2 : expected + 1);
+    }
+    NS_TEST_EXPECT_MSG_EQ(expected, 41, "Not all the elements were visited");
+
+    ring.clear();
+    NS_TEST_EXPECT_MSG_EQ(ring.empty(), true, "The ring buffer should be empty");
+    NS_TEST_EXPECT_MSG_EQ(ring.capacity(), 128, "Clearing should keep the storage");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * PacketMemoryBudget unit tests.
+ */
+class PacketMemoryBudgetTestCase : public TestCase
+{
+  public:
+    PacketMemoryBudgetTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Enqueue a packet in a queue
+     * \param queue the queue
+     * \param expected whether the packet is expected to be enqueued
+     */
+    void Enqueue(Ptr<DropTailQueue<Packet>> queue, bool expected);
+    /**
+     * Drop trace sink of the budget
+     * \param nodeId the id of the node
+     * \param bytes the size of the dropped item
+     */
+    void Drop(uint32_t nodeId, uint32_t bytes);
+
+    uint32_t m_nDrops{0}; //!< the number of drops reported by the budget
+};
+
+PacketMemoryBudgetTestCase::PacketMemoryBudgetTestCase()
+    : TestCase("Check the packet memory budget of the queues")
+{
+}
+
+void
+PacketMemoryBudgetTestCase::Enqueue(Ptr<DropTailQueue<Packet>> queue, bool expected)
+{
+    NS_TEST_EXPECT_MSG_EQ(queue->Enqueue(Create<Packet>(1000)),
+                          expected,
+                          "Unexpected result of the enqueue at node " << Simulator::GetContext());
+}
+
+void
+PacketMemoryBudgetTestCase::Drop(uint32_t nodeId, uint32_t bytes)
+{
+    m_nDrops++;
+}
+
+void
+PacketMemoryBudgetTestCase::DoRun()
+{
+    auto budget = CreateObject<PacketMemoryBudget>();
+    budget->SetAttribute("MaxBytes", UintegerValue(3000));
+    budget->SetAttribute("MaxNodeBytes", UintegerValue(2000));
+    budget->TraceConnectWithoutContext("Drop",
+                                       MakeCallback(&PacketMemoryBudgetTestCase::Drop, this));
+    PacketMemoryBudget::Install(budget);
+
+    std::vector<Ptr<DropTailQueue<Packet>>> queues;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        queues.push_back(CreateObject<DropTailQueue<Packet>>());
+        queues.back()->SetMaxSize(QueueSize("100p"));
+    }
+
+    auto enqueue = &PacketMemoryBudgetTestCase::Enqueue;
+    // the third packet of node 0 exceeds its budget
+    Simulator::ScheduleWithContext(0, Seconds(1), enqueue, this, queues[0], true);
+    Simulator::ScheduleWithContext(0, Seconds(1), enqueue, this, queues[0], true);
+    Simulator::ScheduleWithContext(0, Seconds(1), enqueue, this, queues[0], false);
+    // the second packet of node 1 exceeds the global budget
+    Simulator::ScheduleWithContext(1, Seconds(2), enqueue, this, queues[1], true);
+    Simulator::ScheduleWithContext(1, Seconds(2), enqueue, this, queues[1], false);
+    Simulator::Schedule(Seconds(3), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(budget->GetBytes(), 3000, "Unexpected reserved bytes");
+        NS_TEST_EXPECT_MSG_EQ(budget->GetNodeBytes(0), 2000, "Unexpected bytes of node 0");
+        NS_TEST_EXPECT_MSG_EQ(budget->GetNodeBytes(1), 1000, "Unexpected bytes of node 1");
+        NS_TEST_EXPECT_MSG_EQ(budget->GetAvailableBytes(1), 0, "No bytes should be available");
+        // dequeuing from node 0 releases memory for node 1
+        queues[0]->Dequeue();
+    });
+    Simulator::ScheduleWithContext(1, Seconds(4), enqueue, this, queues[1], true);
+    Simulator::Schedule(Seconds(5), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(budget->GetNodeBytes(1), 2000, "Unexpected bytes of node 1");
+        queues[1]->Dispose();
+        NS_TEST_EXPECT_MSG_EQ(budget->GetNodeBytes(1), 0, "Disposing should release memory");
+    });
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(budget->GetBytes(), 1000, "Unexpected reserved bytes");
+    NS_TEST_EXPECT_MSG_EQ(budget->GetPeakBytes(), 3000, "Unexpected peak of the reserved bytes");
+    NS_TEST_EXPECT_MSG_EQ(budget->GetNDrops(), 2, "Unexpected number of drops");
+    NS_TEST_EXPECT_MSG_EQ(m_nDrops, 2, "Unexpected number of drops reported by the trace");
+    NS_TEST_EXPECT_MSG_EQ(queues[0]->GetTotalDroppedPackets(),
+                          1,
+                          "The queue should account for the drop");
+
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryBudget::Get(),
+                          nullptr,
+                          "The budget should be removed at the end of the simulation");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -100,6 +292,8 @@ class DropTailQueueTestSuite : public TestSuite
         : TestSuite("drop-tail-queue", Type::UNIT)
     {
         AddTestCase(new DropTailQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new RingBufferTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new PacketMemoryBudgetTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -40,6 +40,8 @@
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+
 using namespace ns3;
 
 static void
@@ -288,6 +290,102 @@ BurstErrorModelSimple::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_drops, 260, "Wrong number of drops.");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * ErrorModel::IsCorruptBatch unit tests: a batch must give the same outcome
+ * as evaluating the packets one by one.
+ */
+class ErrorModelBatchTest : public TestCase
+{
+  public:
+    ErrorModelBatchTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Compare IsCorruptBatch() on one model with IsCorrupt() on a twin model.
+     * \param batch The model evaluated in batches.
+     * \param serial The model evaluated one packet at a time.
+     * \param pkts The packets of one batch; the batch is evaluated 100 times.
+     */
+    void CheckSameOutcome(Ptr<ErrorModel> batch,
+                          Ptr<ErrorModel> serial,
+                          const std::vector<Ptr<Packet>>& pkts);
+};
+
+ErrorModelBatchTest::ErrorModelBatchTest()
+    : TestCase("ErrorModel batch evaluation matches per-packet evaluation")
+{
+}
+
+void
+ErrorModelBatchTest::CheckSameOutcome(Ptr<ErrorModel> batch,
+                                      Ptr<ErrorModel> serial,
+                                      const std::vector<Ptr<Packet>>& pkts)
+{
+    uint32_t drops = 0;
+    for (uint32_t round = 0; round < 100; ++round)
+    {
+        std::vector<bool> corrupted = batch->IsCorruptBatch(pkts);
+        NS_TEST_ASSERT_MSG_EQ(corrupted.size(), pkts.size(), "One flag per packet expected");
+        for (std::size_t i = 0; i < pkts.size(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(corrupted[i],
+                                  serial->IsCorrupt(pkts[i]),
+                                  "Batch and per-packet outcomes differ");
+            drops += corrupted[i] ? 1 : 0;
+        }
+    }
+    NS_TEST_ASSERT_MSG_GT(drops, 0, "The error model never dropped a packet");
+}
+
+void
+ErrorModelBatchTest::DoRun()
+{
+    // The copies of a broadcast, plus a couple of packets of a different size
+    std::vector<Ptr<Packet>> pkts;
+    for (uint32_t i = 0; i < 30; ++i)
+    {
+        pkts.push_back(Create<Packet>(i < 25 ? 1000 : 200));
+    }
+
+    for (auto unit : {RateErrorModel::ERROR_UNIT_PACKET,
+                      RateErrorModel::ERROR_UNIT_BYTE,
+                      RateErrorModel::ERROR_UNIT_BIT})
+    {
+        Ptr<RateErrorModel> batch = CreateObject<RateErrorModel>();
+        Ptr<RateErrorModel> serial = CreateObject<RateErrorModel>();
+        for (auto em : {batch, serial})
+        {
+            em->SetUnit(unit);
+            em->SetRate(unit == RateErrorModel::ERROR_UNIT_PACKET ? 0.1 : 1e-5);
+            em->AssignStreams(60);
+        }
+        CheckSameOutcome(batch, serial, pkts);
+    }
+
+    Ptr<BurstErrorModel> batchBurst = CreateObject<BurstErrorModel>();
+    Ptr<BurstErrorModel> serialBurst = CreateObject<BurstErrorModel>();
+    for (auto em : {batchBurst, serialBurst})
+    {
+        em->SetBurstRate(0.05);
+        em->AssignStreams(70);
+    }
+    CheckSameOutcome(batchBurst, serialBurst, pkts);
+
+    // A disabled model corrupts nothing
+    Ptr<RateErrorModel> disabled = CreateObject<RateErrorModel>();
+    disabled->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    disabled->SetRate(1.0);
+    disabled->Disable();
+    std::vector<bool> corrupted = disabled->IsCorruptBatch(pkts);
+    NS_TEST_ASSERT_MSG_EQ(std::count(corrupted.begin(), corrupted.end(), true),
+                          0,
+                          "A disabled model corrupted a packet");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -309,6 +407,7 @@ ErrorModelTestSuite::ErrorModelTestSuite()
 {
     AddTestCase(new ErrorModelSimple, TestCase::Duration::QUICK);
     AddTestCase(new BurstErrorModelSimple, TestCase::Duration::QUICK);
+    AddTestCase(new ErrorModelBatchTest, TestCase::Duration::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,112 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/mac48-address.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * NodeList device lookup test.
+ */
+class NodeListFindDeviceTestCase : public TestCase
+{
+  public:
+    NodeListFindDeviceTestCase();
+    void DoRun() override;
+};
+
+NodeListFindDeviceTestCase::NodeListFindDeviceTestCase()
+    : TestCase("Check the lookup of devices by address")
+{
+}
+
+void
+NodeListFindDeviceTestCase::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<SimpleNetDevice> devA = CreateObject<SimpleNetDevice>();
+    Ptr<SimpleNetDevice> devB = CreateObject<SimpleNetDevice>();
+    devA->SetAddress(Mac48Address("00:00:00:00:00:01"));
+    devB->SetAddress(Mac48Address("00:00:00:00:00:02"));
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:01")),
+                          devA,
+                          "Device not found");
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:02")),
+                          devB,
+                          "Device not found");
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:03")),
+                          nullptr,
+                          "Found a device with a non-existent address");
+
+    // devices added and addresses changed after the index was built
+    Ptr<SimpleNetDevice> devC = CreateObject<SimpleNetDevice>();
+    devC->SetAddress(Mac48Address("00:00:00:00:00:03"));
+    b->AddDevice(devC);
+    devA->SetAddress(Mac48Address("00:00:00:00:00:04"));
+
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:03")),
+                          devC,
+                          "Device added after the first lookup not found");
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:01")),
+                          nullptr,
+                          "Found a device with a stale address");
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:04")),
+                          devA,
+                          "Device with a changed address not found");
+
+    // a device whose address is set after it was added, looked up by the
+    // new address first
+    Ptr<SimpleNetDevice> devD = CreateObject<SimpleNetDevice>();
+    a->AddDevice(devD);
+    devD->SetAddress(Mac48Address("00:00:00:00:00:05"));
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:05")),
+                          devD,
+                          "Device addressed after it was added not found");
+    NS_TEST_EXPECT_MSG_EQ(NodeList::FindDevice(Mac48Address("00:00:00:00:00:06")),
+                          nullptr,
+                          "Found a device with a non-existent address");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief NodeList TestSuite
+ */
+class NodeListTestSuite : public TestSuite
+{
+  public:
+    NodeListTestSuite()
+        : TestSuite("node-list", Type::UNIT)
+    {
+        AddTestCase(new NodeListFindDeviceTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static NodeListTestSuite g_nodeListTestSuite; //!< Static variable for test initialization
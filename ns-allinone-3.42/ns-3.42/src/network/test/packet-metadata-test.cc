@@ -327,6 +327,11 @@ class PacketMetadataTest : public TestCase
 {
   public:
     PacketMetadataTest();
+    /**
+     * Constructor
+     * \param name The test case name
+     */
+    PacketMetadataTest(const std::string& name);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -351,6 +356,11 @@ PacketMetadataTest::PacketMetadataTest()
 {
 }
 
+PacketMetadataTest::PacketMetadataTest(const std::string& name)
+    : TestCase(name)
+{
+}
+
 PacketMetadataTest::~PacketMetadataTest()
 {
 }
@@ -881,6 +891,140 @@ PacketMetadataTest::DoRun()
                           "Could not find original data in received packet");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Lazy packet metadata unit tests.
+ *
+ * The lazy lists are not serialized, so the histories are checked on the
+ * packets themselves only.
+ */
+class LazyPacketMetadataTest : public PacketMetadataTest
+{
+  public:
+    LazyPacketMetadataTest();
+
+  private:
+    void DoRun() override;
+};
+
+LazyPacketMetadataTest::LazyPacketMetadataTest()
+    : PacketMetadataTest("Lazy packet metadata")
+{
+}
+
+void
+LazyPacketMetadataTest::DoRun()
+{
+    Packet::EnableLazyPrinting();
+    // The helpers enabling the ascii traces must not switch to the full metadata
+    Packet::EnablePrinting();
+
+    Ptr<Packet> p = Create<Packet>(10);
+    ADD_HEADER(p, 1);
+    ADD_HEADER(p, 2);
+    ADD_HEADER(p, 3);
+    Ptr<Packet> p1 = p->Copy();
+    REM_HEADER(p1, 3);
+    REM_HEADER(p1, 2);
+    REM_HEADER(p1, 1);
+    CheckHistory(p1, 1, 10);
+    CheckHistory(p, 4, 3, 2, 1, 10);
+    ADD_HEADER(p1, 1);
+    ADD_HEADER(p1, 2);
+    CheckHistory(p1, 3, 2, 1, 10);
+    CheckHistory(p, 4, 3, 2, 1, 10);
+    ADD_TRAILER(p, 4);
+    ADD_TRAILER(p, 5);
+    CheckHistory(p, 6, 3, 2, 1, 10, 4, 5);
+    REM_TRAILER(p, 5);
+    p1 = p->Copy();
+    REM_TRAILER(p, 4);
+    CheckHistory(p, 4, 3, 2, 1, 10);
+    CheckHistory(p1, 5, 3, 2, 1, 10, 4);
+    p1->RemoveAtStart(3);
+    CheckHistory(p1, 4, 2, 1, 10, 4);
+    p1->RemoveAtStart(1);
+    CheckHistory(p1, 4, 1, 1, 10, 4);
+    p1->RemoveAtEnd(4);
+    CheckHistory(p1, 3, 1, 1, 10);
+
+    p = Create<Packet>(10);
+    ADD_HEADER(p, 10);
+    ADD_HEADER(p, 8);
+    ADD_TRAILER(p, 6);
+    ADD_TRAILER(p, 7);
+    ADD_TRAILER(p, 9);
+    p->RemoveAtStart(5);
+    p->RemoveAtEnd(12);
+    CheckHistory(p, 5, 3, 10, 10, 6, 4);
+
+    p = Create<Packet>(10);
+    ADD_HEADER(p, 10);
+    ADD_TRAILER(p, 6);
+    p->RemoveAtEnd(18);
+    ADD_TRAILER(p, 5);
+    ADD_HEADER(p, 3);
+    CheckHistory(p, 3, 3, 8, 5);
+    p->RemoveAtStart(12);
+    CheckHistory(p, 1, 4);
+    p->RemoveAtEnd(2);
+    CheckHistory(p, 1, 2);
+    ADD_HEADER(p, 10);
+    CheckHistory(p, 2, 10, 2);
+    p->RemoveAtEnd(5);
+    CheckHistory(p, 1, 7);
+
+    // Fragments of the same header are merged back on reassembly
+    p = Create<Packet>(40);
+    ADD_HEADER(p, 5);
+    ADD_HEADER(p, 8);
+    p1 = p->CreateFragment(0, 5);
+    Ptr<Packet> p2 = p->CreateFragment(5, 5);
+    Ptr<Packet> p3 = p->CreateFragment(10, 43);
+    CheckHistory(p1, 1, 5);
+    CheckHistory(p2, 2, 3, 2);
+    CheckHistory(p3, 2, 3, 40);
+    p1->AddAtEnd(p2);
+    CheckHistory(p1, 2, 8, 2);
+    p1->AddAtEnd(p3);
+    CheckHistory(p1, 3, 8, 5, 40);
+    CheckHistory(p, 3, 8, 5, 40);
+
+    p = Create<Packet>();
+    ADD_TRAILER(p, 10);
+    ADD_HEADER(p, 5);
+    p1 = p->CreateFragment(0, 8);
+    p2 = p->CreateFragment(8, 7);
+    CheckHistory(p1, 2, 5, 3);
+    CheckHistory(p2, 1, 7);
+    p1->AddAtEnd(p2);
+    CheckHistory(p1, 2, 5, 10);
+
+    p = Create<Packet>(reinterpret_cast<const uint8_t*>("hello world"), 11);
+    ADD_HEADER(p, 2);
+    p1 = p->CreateFragment(0, 5);
+    CheckHistory(p1, 2, 2, 3);
+    p2 = p->CreateFragment(5, 8);
+    CheckHistory(p2, 1, 8);
+    p1->AddAtEnd(p2);
+    CheckHistory(p1, 2, 2, 11);
+
+    // Headers following payload are shown as payload
+    p = Create<Packet>(20);
+    ADD_HEADER(p, 10);
+    p1 = Create<Packet>(30);
+    ADD_HEADER(p1, 5);
+    ADD_TRAILER(p1, 3);
+    p->AddAtEnd(p1);
+    CheckHistory(p, 3, 10, 55, 3);
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 68, "Wrong packet size");
+
+    p = Create<Packet>(0);
+    CheckHistory(p, 0);
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -900,3 +1044,27 @@ PacketMetadataTestSuite::PacketMetadataTestSuite()
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Lazy Packet Metadata TestSuite
+ *
+ * It is a separate suite, since the metadata mode is global and cannot be
+ * changed once packets have been created.
+ */
+class LazyPacketMetadataTestSuite : public TestSuite
+{
+  public:
+    LazyPacketMetadataTestSuite();
+};
+
+LazyPacketMetadataTestSuite::LazyPacketMetadataTestSuite()
+    : TestSuite("packet-metadata-lazy", Type::UNIT)
+{
+    AddTestCase(new LazyPacketMetadataTest, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static LazyPacketMetadataTestSuite g_lazyPacketMetadataTest;
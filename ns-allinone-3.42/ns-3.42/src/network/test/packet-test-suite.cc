@@ -20,12 +20,16 @@
 #include "ns3/packet.h"
 #include "ns3/test.h"
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -346,6 +350,22 @@ class ATestHeader : public ATestHeaderBase
     }
 };
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test header with a serialized size known at compile time
+ *
+ * \note Class internal to packet-test-suite.cc
+ */
+template <int N>
+class AFixedSizeTestHeader final : public ATestHeader<N>
+{
+  public:
+    /// The serialized size of the header
+    static constexpr uint32_t SERIALIZED_SIZE = N;
+};
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -956,6 +976,44 @@ PacketTest::DoRun()
         ALargeTestTag a;
         tmp->AddPacketTag(a);
     }
+
+    /* Test headers with a serialized size known at compile time */
+    {
+        static_assert(HasFixedSerializedSize<AFixedSizeTestHeader<10>>::value);
+        static_assert(!HasFixedSerializedSize<ATestHeader<10>>::value);
+
+        Ptr<Packet> fixed = Create<Packet>(100);
+        Ptr<Packet> variable = Create<Packet>(100);
+        fixed->AddByteTag(ATestTag<25>());
+        variable->AddByteTag(ATestTag<25>());
+        fixed->AddHeader(AFixedSizeTestHeader<10>());
+        variable->AddHeader(ATestHeader<10>());
+        NS_TEST_EXPECT_MSG_EQ(fixed->GetSize(), 110, "Wrong size after adding the header");
+        NS_TEST_EXPECT_MSG_EQ(fixed->ToString(), variable->ToString(), "Different metadata");
+        CHECK(fixed, 1, E(25, 10, 110));
+
+        uint8_t fixedData[110];
+        uint8_t variableData[110];
+        fixed->CopyData(fixedData, sizeof(fixedData));
+        variable->CopyData(variableData, sizeof(variableData));
+        NS_TEST_EXPECT_MSG_EQ(memcmp(fixedData, variableData, sizeof(fixedData)),
+                              0,
+                              "Different serialized data");
+
+        AFixedSizeTestHeader<10> h;
+        NS_TEST_EXPECT_MSG_EQ(fixed->PeekHeader(h), 10, "Wrong number of bytes read");
+        NS_TEST_EXPECT_MSG_EQ(fixed->GetSize(), 110, "PeekHeader changed the size");
+        NS_TEST_EXPECT_MSG_EQ(fixed->RemoveHeader(h), 10, "Wrong number of bytes removed");
+        NS_TEST_EXPECT_MSG_EQ(h.m_error, false, "Wrong deserialized header");
+        NS_TEST_EXPECT_MSG_EQ(fixed->GetSize(), 100, "Wrong size after removing the header");
+        CHECK(fixed, 1, E(25, 0, 100));
+
+        // the fixed size header can still be removed through the Header interface
+        fixed->AddHeader(AFixedSizeTestHeader<10>());
+        Header& base = h;
+        NS_TEST_EXPECT_MSG_EQ(fixed->RemoveHeader(base), 10, "Wrong number of bytes removed");
+        NS_TEST_EXPECT_MSG_EQ(fixed->ToString(), Create<Packet>(100)->ToString(), "Wrong metadata");
+    }
 }
 
 /**
@@ -1205,6 +1263,42 @@ PacketTagListTest::DoRun()
         ReplaceCheck(7);
     }
 
+    // Inline storage
+    {
+        std::cout << GetName() << "check moves to and from the inline storage" << std::endl;
+        PacketTagList small;
+        small.Add(t1);
+        small.Add(t2);
+        PacketTagList large = small; // inline copy
+        large.Add(t3);
+        large.Add(t4); // moved to the heap
+        large.Add(t5);
+        PacketTagList shared = large; // shares the heap buffer
+        NS_TEST_EXPECT_MSG_EQ(shared.Remove(t5), true, "remove from shared buffer");
+        const char* msg = "inline storage";
+        CheckRef(small, t1, msg, false);
+        CheckRef(small, t3, msg, true);
+        CheckRef(large, t5, msg, false);
+        CheckRef(shared, t5, msg, true);
+        CheckRef(shared, t4, msg, false);
+        NS_TEST_EXPECT_MSG_EQ(large.Remove(t4), true, "remove from unshared buffer");
+        NS_TEST_EXPECT_MSG_EQ(large.Remove(t5), true, "remove back into inline storage");
+        CheckRef(large, t3, msg, false);
+        CheckRef(large, t1, msg, false);
+        CheckRef(shared, t4, msg, false);
+
+        // Iteration visits the most recent tag first
+        Ptr<Packet> p = Create<Packet>(0);
+        p->AddPacketTag(t1);
+        p->AddPacketTag(t2);
+        p->AddPacketTag(t6);
+        PacketTagIterator i = p->GetPacketTagIterator();
+        NS_TEST_EXPECT_MSG_EQ(i.Next().GetTypeId(), t6.GetTypeId(), "iteration order");
+        NS_TEST_EXPECT_MSG_EQ(i.Next().GetTypeId(), t2.GetTypeId(), "iteration order");
+        NS_TEST_EXPECT_MSG_EQ(i.Next().GetTypeId(), t1.GetTypeId(), "iteration order");
+        NS_TEST_EXPECT_MSG_EQ(i.HasNext(), false, "iteration end");
+    }
+
     // Timing
     {
         std::cout << GetName() << "add+remove timing" << std::endl;
@@ -1268,6 +1362,141 @@ PacketTagListTest::DoRun()
     } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Packet free list test.
+ *
+ * Small packets are created, copied and destroyed for a few rounds, so that
+ * later rounds reuse the memory of the packets of the previous ones, and
+ * the content of each packet is checked.  Some packets are destroyed by
+ * another thread than the one which created them.
+ */
+class PacketPoolTest : public TestCase
+{
+  public:
+    PacketPoolTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketPoolTest::PacketPoolTest()
+    : TestCase("Packet free list")
+{
+}
+
+void
+PacketPoolTest::DoRun()
+{
+    // A destroyed packet should be reused by the next packet
+    Ptr<Packet> first = Create<Packet>(10);
+    const Packet* memory = PeekPointer(first);
+    first = nullptr;
+    Ptr<Packet> second = Create<Packet>(20);
+#ifndef __SANITIZE_ADDRESS__
+    NS_TEST_EXPECT_MSG_EQ((memory == PeekPointer(second)), true, "Packet memory not reused");
+#endif
+    NS_TEST_EXPECT_MSG_EQ(second->GetSize(), 20, "Reused packet has a wrong size");
+    second = nullptr;
+
+    for (uint32_t round = 0; round < 3; round++)
+    {
+        std::vector<Ptr<Packet>> packets;
+        for (uint8_t i = 0; i < 100; i++)
+        {
+            uint8_t payload[12];
+            std::fill(payload, payload + sizeof(payload), i);
+            Ptr<Packet> p = Create<Packet>(payload, sizeof(payload));
+            packets.push_back(p);
+            packets.push_back(p->Copy());
+            packets.push_back(p->CreateFragment(4, 4));
+        }
+        for (uint32_t i = 0; i < packets.size(); i++)
+        {
+            uint8_t expected = i / 3;
+            uint32_t expectedSize = (i % 3 == 2) ? 4 : 12;
+            uint8_t buffer[12] = {};
+            NS_TEST_ASSERT_MSG_EQ(packets[i]->CopyData(buffer, sizeof(buffer)),
+                                  expectedSize,
+                                  "Wrong packet size");
+            for (uint32_t j = 0; j < expectedSize; j++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(static_cast<uint32_t>(buffer[j]),
+                                      static_cast<uint32_t>(expected),
+                                      "Corrupted packet " << i << " in round " << round);
+            }
+        }
+        if (round == 1)
+        {
+            // The packets and their buffers are released to the free lists
+            // of a thread which never created any
+            std::thread other([&packets]() { packets.clear(); });
+            other.join();
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Packet fixed fields Test
+ */
+class PacketFixedFieldsTest : public TestCase
+{
+  public:
+    PacketFixedFieldsTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketFixedFieldsTest::PacketFixedFieldsTest()
+    : TestCase("Packet fixed fields")
+{
+}
+
+void
+PacketFixedFieldsTest::DoRun()
+{
+    Time timestamp;
+    uint32_t flowId = 0;
+    uint64_t userData = 0;
+
+    Ptr<const Packet> p = Create<Packet>(100);
+    NS_TEST_EXPECT_MSG_EQ(p->GetTimestamp(timestamp), false, "Time stamp not set yet");
+    NS_TEST_EXPECT_MSG_EQ(p->GetFlowId(flowId), false, "Flow id not set yet");
+    NS_TEST_EXPECT_MSG_EQ(p->GetUserData(userData), false, "User data not set yet");
+
+    p->SetTimestamp(MilliSeconds(42));
+    p->SetFlowId(7);
+    NS_TEST_EXPECT_MSG_EQ(p->GetTimestamp(timestamp), true, "Time stamp not set");
+    NS_TEST_EXPECT_MSG_EQ(timestamp, MilliSeconds(42), "Wrong time stamp");
+    NS_TEST_EXPECT_MSG_EQ(p->GetUserData(userData), false, "User data not set yet");
+
+    // The fields follow copies and fragments
+    Ptr<Packet> copy = p->Copy();
+    copy->SetUserData(0x123456789ULL);
+    Ptr<Packet> fragment = copy->CreateFragment(10, 20);
+    NS_TEST_EXPECT_MSG_EQ(fragment->GetFlowId(flowId), true, "Flow id not copied");
+    NS_TEST_EXPECT_MSG_EQ(flowId, 7, "Wrong flow id");
+    NS_TEST_EXPECT_MSG_EQ(fragment->GetUserData(userData), true, "User data not copied");
+    NS_TEST_EXPECT_MSG_EQ(userData, 0x123456789ULL, "Wrong user data");
+    NS_TEST_EXPECT_MSG_EQ(p->GetUserData(userData), false, "Copy changed the original");
+
+    // A packet keeps its own fields when others are added to it
+    Ptr<Packet> other = Create<Packet>(10);
+    other->SetFlowId(8);
+    fragment->AddAtEnd(other);
+    NS_TEST_EXPECT_MSG_EQ(fragment->GetFlowId(flowId), true, "Flow id lost");
+    NS_TEST_EXPECT_MSG_EQ(flowId, 7, "Wrong flow id after AddAtEnd");
+    *other = *fragment;
+    NS_TEST_EXPECT_MSG_EQ(other->GetTimestamp(timestamp), true, "Time stamp not assigned");
+    NS_TEST_EXPECT_MSG_EQ(timestamp, MilliSeconds(42), "Wrong assigned time stamp");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1285,6 +1514,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketPoolTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketFixedFieldsTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
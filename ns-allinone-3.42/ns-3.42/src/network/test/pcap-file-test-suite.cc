@@ -19,6 +19,7 @@
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -1375,6 +1376,83 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Test case to make sure that records accumulated in a small write
+ * buffer, and truncated to the snaplen, are read back intact.
+ */
+class BufferedWriteTestCase : public TestCase
+{
+  public:
+    BufferedWriteTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase()
+    : TestCase("Check that PcapFile buffered writes are read back")
+{
+}
+
+void
+BufferedWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("buffered.pcap");
+    const uint32_t nRecords = 100;
+    const uint32_t snapLen = 50;
+    uint8_t bufferOut[128];
+    for (uint32_t i = 0; i < 128; ++i)
+    {
+        bufferOut[i] = i;
+    }
+
+    PcapFile f;
+    // smaller than a few records, so that they straddle the buffer boundaries
+    f.SetBufferSize(100);
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(),
+                          false,
+                          "Open (" << filename << ", \"std::ios::out\") returns error");
+    f.Init(1, snapLen);
+    for (uint32_t i = 0; i < nRecords; ++i)
+    {
+        f.Write(i, 0, bufferOut + i % 8, 20 + i % 100);
+        NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write must not fail");
+    }
+    f.Close();
+
+    f.Open(filename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(),
+                          false,
+                          "Open (" << filename << ", \"std::ios::in\") returns error");
+    uint8_t bufferIn[128];
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+    uint32_t readLen;
+    for (uint32_t i = 0; i < nRecords; ++i)
+    {
+        f.Read(bufferIn, sizeof(bufferIn), tsSec, tsUsec, inclLen, origLen, readLen);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Read (" << i << ") returns error");
+        NS_TEST_EXPECT_MSG_EQ(tsSec, i, "Bad timestamp of record " << i);
+        NS_TEST_EXPECT_MSG_EQ(origLen, 20 + i % 100, "Bad original length of record " << i);
+        NS_TEST_EXPECT_MSG_EQ(inclLen,
+                              std::min(origLen, snapLen),
+                              "Bad included length of record " << i);
+        NS_TEST_EXPECT_MSG_EQ(std::memcmp(bufferIn, bufferOut + i % 8, inclLen),
+                              0,
+                              "Bad data in record " << i);
+    }
+    f.Read(bufferIn, sizeof(bufferIn), tsSec, tsUsec, inclLen, origLen, readLen);
+    NS_TEST_EXPECT_MSG_EQ(f.Eof(), true, "Extra records in the file");
+    f.Close();
+    std::remove(filename.c_str());
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1398,6 +1476,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BufferedWriteTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -115,6 +115,25 @@ ErrorModel::IsCorrupt(Ptr<Packet> p)
     return result;
 }
 
+std::vector<bool>
+ErrorModel::IsCorruptBatch(const std::vector<Ptr<Packet>>& pkts)
+{
+    NS_LOG_FUNCTION(this << pkts.size());
+    std::vector<bool> corrupted(pkts.size(), false);
+    DoCorruptBatch(pkts, corrupted);
+    return corrupted;
+}
+
+void
+ErrorModel::DoCorruptBatch(const std::vector<Ptr<Packet>>& pkts, std::vector<bool>& corrupted)
+{
+    NS_LOG_FUNCTION(this << pkts.size());
+    for (std::size_t i = 0; i < pkts.size(); ++i)
+    {
+        corrupted[i] = DoCorrupt(pkts[i]);
+    }
+}
+
 void
 ErrorModel::Reset()
 {
@@ -256,6 +275,48 @@ RateErrorModel::DoCorrupt(Ptr<Packet> p)
     return false;
 }
 
+void
+RateErrorModel::DoCorruptBatch(const std::vector<Ptr<Packet>>& pkts, std::vector<bool>& corrupted)
+{
+    NS_LOG_FUNCTION(this << pkts.size());
+    if (!IsEnabled())
+    {
+        return;
+    }
+    // The copies of a broadcast all have the same size, so the pow() below
+    // is usually evaluated once for the whole batch
+    uint32_t lastSize = 0;
+    double per = GetPacketErrorRate(lastSize);
+    for (std::size_t i = 0; i < pkts.size(); ++i)
+    {
+        uint32_t size = pkts[i]->GetSize();
+        if (size != lastSize)
+        {
+            lastSize = size;
+            per = GetPacketErrorRate(size);
+        }
+        corrupted[i] = (m_ranvar->GetValue() < per);
+    }
+}
+
+double
+RateErrorModel::GetPacketErrorRate(uint32_t size) const
+{
+    switch (m_unit)
+    {
+    case ERROR_UNIT_PACKET:
+        return m_rate;
+    case ERROR_UNIT_BYTE:
+        return 1 - std::pow(1.0 - m_rate, static_cast<double>(size));
+    case ERROR_UNIT_BIT:
+        return 1 - std::pow(1.0 - m_rate, static_cast<double>(8 * size));
+    default:
+        NS_ASSERT_MSG(false, "m_unit not supported yet");
+        break;
+    }
+    return 0;
+}
+
 bool
 RateErrorModel::DoCorruptPkt(Ptr<Packet> p)
 {
@@ -66,6 +66,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <list>
+#include <vector>
 
 namespace ns3
 {
@@ -133,6 +134,19 @@ class ErrorModel : public Object
      * \param pkt Packet to apply error model to
      */
     bool IsCorrupt(Ptr<Packet> pkt);
+    /**
+     * Decide corruption for several packets at once, e.g. the copies of one
+     * transmission handed to every receiver of a broadcast channel.
+     *
+     * The outcome, and the random variates consumed, are the same as calling
+     * IsCorrupt() on each packet in order; models may however share the work
+     * that does not depend on the individual packet.
+     *
+     * \returns one flag per packet, true if that packet is to be considered
+     * as errored/corrupted
+     * \param pkts Packets to apply error model to
+     */
+    std::vector<bool> IsCorruptBatch(const std::vector<Ptr<Packet>>& pkts);
     /**
      * Reset any state associated with the error model
      */
@@ -157,6 +171,15 @@ class ErrorModel : public Object
      * \returns true if the packet is corrupted
      */
     virtual bool DoCorrupt(Ptr<Packet> p) = 0;
+    /**
+     * Corrupt several packets according to the specified model.
+     *
+     * The default implementation calls DoCorrupt() on each packet in order.
+     * \param pkts the packets to corrupt
+     * \param corrupted one flag per packet, set to true if the packet is corrupted
+     */
+    virtual void DoCorruptBatch(const std::vector<Ptr<Packet>>& pkts,
+                                std::vector<bool>& corrupted);
     /**
      * Re-initialize any state
      */
@@ -179,6 +202,12 @@ class ErrorModel : public Object
  * Reset() on this model will do nothing
  *
  * IsCorrupt() will not modify the packet data buffer
+ *
+ * IsCorruptBatch() computes the packet error rate once for each run of
+ * packets of the same size and then draws one variate per packet, without
+ * going through the per-unit DoCorruptPkt(), DoCorruptByte() and
+ * DoCorruptBit() methods; subclasses overriding those should override
+ * DoCorruptBatch() as well.
  */
 class RateErrorModel : public ErrorModel
 {
@@ -237,6 +266,14 @@ class RateErrorModel : public ErrorModel
 
   private:
     bool DoCorrupt(Ptr<Packet> p) override;
+    void DoCorruptBatch(const std::vector<Ptr<Packet>>& pkts,
+                        std::vector<bool>& corrupted) override;
+    /**
+     * Packet error rate of a packet of the given size.
+     * \param size the packet size, in bytes
+     * \returns the probability that a packet of that size is corrupted
+     */
+    double GetPacketErrorRate(uint32_t size) const;
     /**
      * Corrupt a packet (packet unit).
      * \param p the packet to corrupt
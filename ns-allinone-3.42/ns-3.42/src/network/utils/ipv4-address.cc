@@ -20,6 +20,7 @@
 #include "ipv4-address.h"
 
 #include "ns3/assert.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
 
 #include <cstdlib>
@@ -401,7 +402,7 @@ Ipv4Address::GetLoopback()
 size_t
 Ipv4AddressHash::operator()(const Ipv4Address& x) const
 {
-    return std::hash<uint32_t>()(x.Get());
+    return HashMix(x.Get());
 }
 
 std::ostream&
@@ -405,7 +405,7 @@ class Ipv4AddressHash
      * \param x the address
      * \return the hash
      *
-     * This method uses std::hash rather than class Hash
+     * This method uses HashMix() rather than class Hash
      * as speed is more important than cryptographic robustness.
      */
     size_t operator()(const Ipv4Address& x) const;
@@ -425,4 +425,22 @@ operator!=(const Ipv4Mask& a, const Ipv4Mask& b)
 
 } // namespace ns3
 
+/**
+ * \ingroup address
+ * Hash an Ipv4Address, for use as the key of the standard unordered containers.
+ */
+template <>
+struct std::hash<ns3::Ipv4Address>
+{
+    /**
+     * The functor.
+     * \param address The address to hash.
+     * \return the hash
+     */
+    std::size_t operator()(const ns3::Ipv4Address& address) const
+    {
+        return ns3::Ipv4AddressHash()(address);
+    }
+};
+
 #endif /* IPV4_ADDRESS_H */
@@ -698,4 +698,22 @@ class Ipv6AddressHash
 
 } /* namespace ns3 */
 
+/**
+ * \ingroup address
+ * Hash an Ipv6Address, for use as the key of the standard unordered containers.
+ */
+template <>
+struct std::hash<ns3::Ipv6Address>
+{
+    /**
+     * The functor.
+     * \param address The address to hash.
+     * \return the hash
+     */
+    std::size_t operator()(const ns3::Ipv6Address& address) const
+    {
+        return ns3::Ipv6AddressHash()(address);
+    }
+};
+
 #endif /* IPV6_ADDRESS_H */
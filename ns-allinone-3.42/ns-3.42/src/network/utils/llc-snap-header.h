@@ -41,7 +41,7 @@ static const uint16_t LLC_SNAP_HEADER_LENGTH = 8;
  * For a list of EtherTypes, see
  * http://www.iana.org/assignments/ieee-802-numbers/ieee-802-numbers.xhtml
  */
-class LlcSnapHeader : public Header
+class LlcSnapHeader final : public Header
 {
   public:
     LlcSnapHeader();
@@ -62,6 +62,10 @@ class LlcSnapHeader : public Header
      * \return the object TypeId
      */
     static TypeId GetTypeId();
+
+    /// The serialized size of the header, in bytes (see HasFixedSerializedSize)
+    static constexpr uint32_t SERIALIZED_SIZE = LLC_SNAP_HEADER_LENGTH;
+
     TypeId GetInstanceTypeId() const override;
     void Print(std::ostream& os) const override;
     uint32_t GetSerializedSize() const override;
@@ -20,6 +20,7 @@
 
 #include "ns3/address.h"
 #include "ns3/assert.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
@@ -236,6 +237,19 @@ Mac48Address::GetMulticast(Ipv6Address addr)
     return etherAddr;
 }
 
+size_t
+Mac48AddressHash::operator()(const Mac48Address& x) const
+{
+    uint8_t buffer[6];
+    x.CopyTo(buffer);
+    uint64_t value = 0;
+    for (uint8_t byte : buffer)
+    {
+        value = (value << 8) | byte;
+    }
+    return HashMix(value);
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Mac48Address& address)
 {
@@ -236,9 +236,46 @@ operator<(const Mac48Address& a, const Mac48Address& b)
     return memcmp(a.m_address, b.m_address, 6) < 0;
 }
 
+/**
+ * \ingroup address
+ *
+ * \brief Class providing an hash for MAC48 addresses
+ */
+class Mac48AddressHash
+{
+  public:
+    /**
+     * \brief Returns the hash of a MAC48 address.
+     * \param x the address
+     * \return the hash
+     *
+     * This method uses HashMix() rather than class Hash
+     * as speed is more important than cryptographic robustness.
+     */
+    size_t operator()(const Mac48Address& x) const;
+};
+
 std::ostream& operator<<(std::ostream& os, const Mac48Address& address);
 std::istream& operator>>(std::istream& is, Mac48Address& address);
 
 } // namespace ns3
 
+/**
+ * \ingroup address
+ * Hash a Mac48Address, for use as the key of the standard unordered containers.
+ */
+template <>
+struct std::hash<ns3::Mac48Address>
+{
+    /**
+     * The functor.
+     * \param address The address to hash.
+     * \return the hash
+     */
+    std::size_t operator()(const ns3::Mac48Address& address) const
+    {
+        return ns3::Mac48AddressHash()(address);
+    }
+};
+
 #endif /* MAC48_ADDRESS_H */
@@ -55,6 +55,7 @@ NetDeviceQueue::~NetDeviceQueue()
     m_queueLimits = nullptr;
     m_wakeCallback.Nullify();
     m_device = nullptr;
+    m_deviceQueueRoom = nullptr;
 }
 
 bool
@@ -64,6 +65,21 @@ NetDeviceQueue::IsStopped() const
     return m_stoppedByDevice || m_stoppedByQueueLimits;
 }
 
+uint32_t
+NetDeviceQueue::GetBulkLimit() const
+{
+    NS_LOG_FUNCTION(this);
+    if (IsStopped())
+    {
+        return 0;
+    }
+    if (m_queueLimits || !m_deviceQueueRoom)
+    {
+        return 1;
+    }
+    return m_deviceQueueRoom();
+}
+
 void
 NetDeviceQueue::Start()
 {
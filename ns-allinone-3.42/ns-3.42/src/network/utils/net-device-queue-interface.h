@@ -25,6 +25,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/queue-size.h"
 #include "ns3/simulator.h"
 
 #include <functional>
@@ -94,6 +95,25 @@ class NetDeviceQueue : public Object
      */
     virtual bool IsStopped() const;
 
+    /**
+     * \brief Get the number of packets that can be sent to the device before
+     *        this transmission queue can possibly be stopped.
+     * \return the number of packets that can be sent to the device at once
+     *
+     * Called by queue discs to determine how many packets they can dequeue and
+     * send to the device together. The returned value is exact under the assumption
+     * that the device does not transmit any packet meanwhile, and conservative
+     * otherwise: the packets sent to the device never exceed what the device queue
+     * would accept if they were sent one at a time, checking the status of this
+     * transmission queue after each of them. If this transmission queue is stopped,
+     * zero is returned. If the room in the device queue cannot be predicted (the
+     * queue traces were not connected, the device queue is in byte mode or queue
+     * limits are in use, as the device may add headers to the packets), one is
+     * returned.
+     * This is the analogous to the qdisc_avail_bulklimit function of the Linux kernel.
+     */
+    uint32_t GetBulkLimit() const;
+
     /**
      * \brief Notify this NetDeviceQueue that the NetDeviceQueueInterface was
      *        aggregated to an object.
@@ -210,6 +230,8 @@ class NetDeviceQueue : public Object
     Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
     WakeCallback m_wakeCallback;    //!< Wake callback
     Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
+    /// Return the number of packets the device queue can store before it gets full
+    std::function<uint32_t()> m_deviceQueueRoom;
 
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -334,6 +356,17 @@ NetDeviceQueue::ConnectQueueTraces(Ptr<QueueType> queue)
     queue->TraceConnectWithoutContext(
         "DropBeforeEnqueue",
         MakeCallback(&NetDeviceQueue::PacketDiscarded<QueueType>, this).Bind(PeekPointer(queue)));
+
+    // The device queue is stopped after each enqueue that leaves no room for another packet,
+    // hence as many packets as the free slots can be sent to the device in packet mode
+    m_deviceQueueRoom = [q = PeekPointer(queue)]() -> uint32_t {
+        const auto maxSize = q->GetMaxSize();
+        if (maxSize.GetUnit() != QueueSizeUnit::PACKETS || q->GetNPackets() >= maxSize.GetValue())
+        {
+            return 1;
+        }
+        return maxSize.GetValue() - q->GetNPackets();
+    };
 }
 
 template <typename QueueType>
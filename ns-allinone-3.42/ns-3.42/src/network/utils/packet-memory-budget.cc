@@ -0,0 +1,195 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-memory-budget.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketMemoryBudget");
+
+NS_OBJECT_ENSURE_REGISTERED(PacketMemoryBudget);
+
+Ptr<PacketMemoryBudget> PacketMemoryBudget::m_installed = nullptr;
+
+TypeId
+PacketMemoryBudget::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::PacketMemoryBudget")
+            .SetParent<Object>()
+            .SetGroupName("Network")
+            .AddConstructor<PacketMemoryBudget>()
+            .AddAttribute("MaxBytes",
+                          "The bytes that all the queues can store overall (0 means no limit)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PacketMemoryBudget::m_maxBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("MaxNodeBytes",
+                          "The bytes that the queues of each node can store (0 means no limit)",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PacketMemoryBudget::m_maxNodeBytes),
+                          MakeUintegerChecker<uint64_t>())
+            .AddTraceSource("Bytes",
+                            "The bytes stored by all the queues",
+                            MakeTraceSourceAccessor(&PacketMemoryBudget::m_bytes),
+                            "ns3::TracedValueCallback::Uint64")
+            .AddTraceSource("NodeBytes",
+                            "The bytes stored by the queues of a node changed",
+                            MakeTraceSourceAccessor(&PacketMemoryBudget::m_nodeBytesTrace),
+                            "ns3::PacketMemoryBudget::NodeBytesTracedCallback")
+            .AddTraceSource("Drop",
+                            "An item was dropped because it did not fit in the budget",
+                            MakeTraceSourceAccessor(&PacketMemoryBudget::m_dropTrace),
+                            "ns3::PacketMemoryBudget::DropTracedCallback");
+    return tid;
+}
+
+PacketMemoryBudget::PacketMemoryBudget()
+    : m_bytes(0),
+      m_noContextBytes(0),
+      m_peakBytes(0),
+      m_nDrops(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PacketMemoryBudget::~PacketMemoryBudget()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+PacketMemoryBudget::Install(Ptr<PacketMemoryBudget> budget)
+{
+    NS_LOG_FUNCTION(budget);
+    if (budget && !m_installed)
+    {
+        Simulator::ScheduleDestroy(&PacketMemoryBudget::Uninstall);
+    }
+    m_installed = budget;
+}
+
+void
+PacketMemoryBudget::Uninstall()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_installed = nullptr;
+}
+
+Ptr<PacketMemoryBudget>
+PacketMemoryBudget::Get()
+{
+    return m_installed;
+}
+
+uint64_t&
+PacketMemoryBudget::GetNodeSlot(uint32_t nodeId)
+{
+    if (nodeId == Simulator::NO_CONTEXT)
+    {
+        return m_noContextBytes;
+    }
+    if (nodeId >= m_nodeBytes.size())
+    {
+        m_nodeBytes.resize(nodeId + 1, 0);
+    }
+    return m_nodeBytes[nodeId];
+}
+
+bool
+PacketMemoryBudget::Reserve(uint32_t nodeId, uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << nodeId << bytes);
+    auto& nodeBytes = GetNodeSlot(nodeId);
+    if ((m_maxBytes > 0 && m_bytes + bytes > m_maxBytes) ||
+        (m_maxNodeBytes > 0 && nodeBytes + bytes > m_maxNodeBytes))
+    {
+        NS_LOG_LOGIC("Budget exceeded, node bytes " << nodeBytes << ", total bytes " << m_bytes);
+        m_nDrops++;
+        m_dropTrace(nodeId, bytes);
+        return false;
+    }
+    nodeBytes += bytes;
+    m_bytes += bytes;
+    m_peakBytes = std::max(m_peakBytes, m_bytes.Get());
+    m_nodeBytesTrace(nodeId, nodeBytes);
+    return true;
+}
+
+void
+PacketMemoryBudget::Release(uint32_t nodeId, uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << nodeId << bytes);
+    auto& nodeBytes = GetNodeSlot(nodeId);
+    NS_ASSERT_MSG(nodeBytes >= bytes, "Releasing more bytes than reserved by node " << nodeId);
+    nodeBytes -= bytes;
+    m_bytes -= bytes;
+    m_nodeBytesTrace(nodeId, nodeBytes);
+}
+
+uint64_t
+PacketMemoryBudget::GetBytes() const
+{
+    return m_bytes;
+}
+
+uint64_t
+PacketMemoryBudget::GetNodeBytes(uint32_t nodeId) const
+{
+    if (nodeId == Simulator::NO_CONTEXT)
+    {
+        return m_noContextBytes;
+    }
+    return nodeId < m_nodeBytes.size() ? m_nodeBytes[nodeId] : 0;
+}
+
+uint64_t
+PacketMemoryBudget::GetAvailableBytes(uint32_t nodeId) const
+{
+    auto available = std::numeric_limits<uint64_t>::max();
+    if (m_maxBytes > 0)
+    {
+        available = m_maxBytes - std::min<uint64_t>(m_bytes, m_maxBytes);
+    }
+    if (m_maxNodeBytes > 0)
+    {
+        const auto nodeBytes = GetNodeBytes(nodeId);
+        available = std::min(available, m_maxNodeBytes - std::min(nodeBytes, m_maxNodeBytes));
+    }
+    return available;
+}
+
+uint64_t
+PacketMemoryBudget::GetPeakBytes() const
+{
+    return m_peakBytes;
+}
+
+uint64_t
+PacketMemoryBudget::GetNDrops() const
+{
+    return m_nDrops;
+}
+
+} // namespace ns3
@@ -0,0 +1,153 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PACKET_MEMORY_BUDGET_H
+#define PACKET_MEMORY_BUDGET_H
+
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Budget of the memory held by the packets stored in queues.
+ *
+ * When a budget is installed with Install(), every Queue, including the internal
+ * queues of the queue discs and the wifi MAC queues, reserves the bytes of each
+ * item it stores from the budget and releases them when the item leaves the queue.
+ * An item that does not fit in the global budget or in the budget of the node
+ * owning the queue is dropped before enqueue, as if the queue were full. This
+ * bounds the memory used by the packets of simulations with very large buffers.
+ *
+ * The node owning a queue is the one whose id is the context of the event in which
+ * the queue stores its first item, and a queue keeps using the budget installed at
+ * that time. Hence, the budget has to be installed before the simulation starts.
+ *
+ * Senders can apply back-pressure by checking GetAvailableBytes() before generating
+ * traffic, and the Drop trace source reports the items refused by the budget.
+ */
+class PacketMemoryBudget : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    PacketMemoryBudget();
+    ~PacketMemoryBudget() override;
+
+    /**
+     * \brief Install the budget used by the queues, until the end of the simulation.
+     * \param budget the budget, or a null pointer to remove the installed one
+     */
+    static void Install(Ptr<PacketMemoryBudget> budget);
+
+    /**
+     * \return the installed budget, or a null pointer if none is installed
+     */
+    static Ptr<PacketMemoryBudget> Get();
+
+    /**
+     * \brief Reserve memory for an item.
+     * \param nodeId the id of the node storing the item
+     * \param bytes the size of the item
+     * \return false if the item does not fit in the budget
+     */
+    bool Reserve(uint32_t nodeId, uint32_t bytes);
+
+    /**
+     * \brief Release the memory reserved for an item.
+     * \param nodeId the id of the node that stored the item
+     * \param bytes the size of the item
+     */
+    void Release(uint32_t nodeId, uint32_t bytes);
+
+    /**
+     * \return the bytes currently reserved
+     */
+    uint64_t GetBytes() const;
+
+    /**
+     * \param nodeId the id of a node
+     * \return the bytes currently reserved by the given node
+     */
+    uint64_t GetNodeBytes(uint32_t nodeId) const;
+
+    /**
+     * \param nodeId the id of a node
+     * \return the bytes the given node can still reserve
+     */
+    uint64_t GetAvailableBytes(uint32_t nodeId) const;
+
+    /**
+     * \return the maximum number of bytes reserved at the same time
+     */
+    uint64_t GetPeakBytes() const;
+
+    /**
+     * \return the number of reservations refused
+     */
+    uint64_t GetNDrops() const;
+
+    /**
+     * TracedCallback signature for the changes of the bytes reserved by a node.
+     *
+     * \param [in] nodeId The id of the node.
+     * \param [in] bytes The bytes reserved by the node.
+     */
+    typedef void (*NodeBytesTracedCallback)(uint32_t nodeId, uint64_t bytes);
+
+    /**
+     * TracedCallback signature for refused reservations.
+     *
+     * \param [in] nodeId The id of the node.
+     * \param [in] bytes The size of the item.
+     */
+    typedef void (*DropTracedCallback)(uint32_t nodeId, uint32_t bytes);
+
+  private:
+    /**
+     * \param nodeId the id of a node
+     * \return the bytes reserved by the given node
+     */
+    uint64_t& GetNodeSlot(uint32_t nodeId);
+
+    /// Remove the installed budget, at the end of the simulation
+    static void Uninstall();
+
+    static Ptr<PacketMemoryBudget> m_installed; //!< the installed budget
+
+    uint64_t m_maxBytes;                                 //!< the global budget
+    uint64_t m_maxNodeBytes;                             //!< the budget of each node
+    TracedValue<uint64_t> m_bytes;                       //!< the bytes reserved
+    std::vector<uint64_t> m_nodeBytes;                   //!< the bytes reserved by each node
+    uint64_t m_noContextBytes;                           //!< the bytes reserved out of any node
+    uint64_t m_peakBytes;                                //!< the peak of the bytes reserved
+    uint64_t m_nDrops;                                   //!< the number of refused reservations
+    TracedCallback<uint32_t, uint64_t> m_nodeBytesTrace; //!< the node bytes trace source
+    TracedCallback<uint32_t, uint32_t> m_dropTrace;      //!< the drop trace source
+};
+
+} // namespace ns3
+
+#endif /* PACKET_MEMORY_BUDGET_H */
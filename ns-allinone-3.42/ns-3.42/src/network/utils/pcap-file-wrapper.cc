@@ -48,7 +48,13 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("BufferSize",
+                          "Size in bytes of the buffer in which packets are accumulated before "
+                          "being written to the file (0 for the default of the C++ library).",
+                          UintegerValue(64 * 1024),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -95,6 +101,7 @@ void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
+    m_file.SetBufferSize(m_bufferSize);
     m_file.Open(filename, mode);
 }
 
@@ -223,8 +223,9 @@ class PcapFileWrapper : public Object
 
   private:
     PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    uint32_t m_snapLen;    //!< max length of saved packets
+    bool m_nanosecMode;    //!< Timestamps in nanosecond mode
+    uint32_t m_bufferSize; //!< size of the write buffer of the file
 };
 
 } // namespace ns3
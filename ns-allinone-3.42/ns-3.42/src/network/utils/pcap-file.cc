@@ -21,7 +21,6 @@
 
 #include "ns3/assert.h"
 #include "ns3/buffer.h"
-#include "ns3/build-profile.h"
 #include "ns3/fatal-error.h"
 #include "ns3/fatal-impl.h"
 #include "ns3/header.h"
@@ -95,6 +94,13 @@ PcapFile::Close()
     m_file.close();
 }
 
+void
+PcapFile::SetBufferSize(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << size);
+    m_buffer.resize(size);
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -339,6 +345,11 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
     mode |= std::ios::binary;
 
     m_filename = filename;
+    if (!m_buffer.empty())
+    {
+        // the buffer of a file stream must be set before opening it
+        m_file.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+    }
     m_file.open(filename, mode);
     if (mode & std::ios::in)
     {
@@ -429,14 +440,20 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     }
 
     //
-    // Watch out for memory alignment differences between machines, so write
-    // them all individually.
-    //
-    m_file.write((const char*)&header.m_tsSec, sizeof(header.m_tsSec));
-    m_file.write((const char*)&header.m_tsUsec, sizeof(header.m_tsUsec));
-    m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
-    m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
-    NS_BUILD_DEBUG(m_file.flush());
+    // Watch out for memory alignment differences between machines, so copy
+    // them all individually, then write the record header at once.
+    //
+    char record[sizeof(header.m_tsSec) + sizeof(header.m_tsUsec) + sizeof(header.m_inclLen) +
+                sizeof(header.m_origLen)];
+    char* p = record;
+    std::memcpy(p, &header.m_tsSec, sizeof(header.m_tsSec));
+    p += sizeof(header.m_tsSec);
+    std::memcpy(p, &header.m_tsUsec, sizeof(header.m_tsUsec));
+    p += sizeof(header.m_tsUsec);
+    std::memcpy(p, &header.m_inclLen, sizeof(header.m_inclLen));
+    p += sizeof(header.m_inclLen);
+    std::memcpy(p, &header.m_origLen, sizeof(header.m_origLen));
+    m_file.write(record, sizeof(record));
     return inclLen;
 }
 
@@ -446,7 +463,6 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
     m_file.write((const char*)data, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
 }
 
 void
@@ -455,7 +471,6 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
     p->CopyData(&m_file, inclLen);
-    NS_BUILD_DEBUG(m_file.flush());
 }
 
 void
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -86,6 +87,17 @@ class PcapFile
      */
     void Close();
 
+    /**
+     * Set the size of the buffer in which the records are accumulated
+     * before being written to the file, so that writing many small
+     * packets to many files does not cost a system call per packet.
+     * This takes effect at the next #Open.
+     *
+     * \param size The buffer size, in bytes.  Zero keeps the default
+     * buffer of the standard library.
+     */
+    void SetBufferSize(uint32_t size);
+
     /**
      * Initialize the pcap file associated with this object.  This file must have
      * been previously opened with write permissions.
@@ -374,6 +386,7 @@ class PcapFile
     void ReadAndVerifyFileHeader();
 
     std::string m_filename;      //!< file name
+    std::vector<char> m_buffer;  //!< write buffer of the file stream
     std::fstream m_file;         //!< file stream
     PcapFileHeader m_fileHeader; //!< file header
     bool m_swapMode;             //!< swap mode
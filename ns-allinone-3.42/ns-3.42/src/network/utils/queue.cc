@@ -19,6 +19,7 @@
 
 #include "ns3/abort.h"
 #include "ns3/enum.h"
+#include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
@@ -58,7 +59,8 @@ QueueBase::QueueBase()
       m_nTotalDroppedBytesAfterDequeue(0),
       m_nTotalDroppedPackets(0),
       m_nTotalDroppedPacketsBeforeEnqueue(0),
-      m_nTotalDroppedPacketsAfterDequeue(0)
+      m_nTotalDroppedPacketsAfterDequeue(0),
+      m_budgetNode(0)
 {
     NS_LOG_FUNCTION(this);
     m_maxSize = QueueSize(QueueSizeUnit::PACKETS, std::numeric_limits<uint32_t>::max());
@@ -69,6 +71,30 @@ QueueBase::~QueueBase()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+QueueBase::ReserveMemory(uint32_t bytes)
+{
+    if (!m_budget)
+    {
+        m_budget = PacketMemoryBudget::Get();
+        if (!m_budget)
+        {
+            return true;
+        }
+        m_budgetNode = Simulator::GetContext();
+    }
+    return m_budget->Reserve(m_budgetNode, bytes);
+}
+
+void
+QueueBase::ReleaseMemory(uint32_t bytes)
+{
+    if (m_budget && bytes > 0)
+    {
+        m_budget->Release(m_budgetNode, bytes);
+    }
+}
+
 void
 QueueBase::AppendItemTypeIfNotPresent(std::string& typeId, const std::string& itemType)
 {
@@ -22,6 +22,7 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include "packet-memory-budget.h"
 #include "queue-fwd.h"
 #include "queue-item.h"
 #include "queue-size.h"
@@ -215,6 +216,19 @@ class QueueBase : public Object
 #endif
 
   protected:
+    /**
+     * \brief Reserve memory for an item from the installed PacketMemoryBudget, if any.
+     * \param bytes the size of the item
+     * \return false if the item does not fit in the budget
+     */
+    bool ReserveMemory(uint32_t bytes);
+
+    /**
+     * \brief Release the memory reserved for an item.
+     * \param bytes the size of the item
+     */
+    void ReleaseMemory(uint32_t bytes);
+
     TracedValue<uint32_t> m_nBytes;               //!< Number of bytes in the queue
     uint32_t m_nTotalReceivedBytes;               //!< Total received bytes
     TracedValue<uint32_t> m_nPackets;             //!< Number of packets in the queue
@@ -227,6 +241,10 @@ class QueueBase : public Object
     uint32_t m_nTotalDroppedPacketsAfterDequeue;  //!< Total dropped packets after dequeue
 
     QueueSize m_maxSize; //!< max queue size
+
+  private:
+    Ptr<PacketMemoryBudget> m_budget; //!< the memory budget of the stored items, if any
+    uint32_t m_budgetNode;            //!< the id of the node owning the queue
 };
 
 /**
@@ -246,7 +264,9 @@ class QueueBase : public Object
  * container used internally to store queue items. The container type must provide
  * the methods insert(), erase() and clear() and define the iterator and const_iterator
  * types, following the usual syntax of C++ containers. The default container type
- * is std::list (as defined in queue-fwd.h). In case the container is such that
+ * is RingBuffer (as defined in queue-fwd.h), which does not allocate memory per
+ * enqueued item and keeps iterators valid when items are added or removed at
+ * either end. In case the container is such that
  * an object stored within the queue is obtained from a container element through
  * an operation other than dereferencing an iterator pointing to the container
  * element, the container has to provide a public method named GetItem that
@@ -527,9 +547,16 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
         return false;
     }
 
+    uint32_t size = item->GetSize();
+    if (!ReserveMemory(size))
+    {
+        NS_LOG_LOGIC("Packet memory budget exceeded -- dropping pkt");
+        DropBeforeEnqueue(item);
+        return false;
+    }
+
     ret = m_packets.insert(pos, item);
 
-    uint32_t size = item->GetSize();
     m_nBytes += size;
     m_nTotalReceivedBytes += size;
 
@@ -564,6 +591,7 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
 
         m_nBytes -= item->GetSize();
         m_nPackets--;
+        ReleaseMemory(item->GetSize());
 
         NS_LOG_LOGIC("m_traceDequeue (p)");
         m_traceDequeue(item);
@@ -593,6 +621,7 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
 
         m_nBytes -= item->GetSize();
         m_nPackets--;
+        ReleaseMemory(item->GetSize());
 
         // packets are first dequeued and then dropped
         NS_LOG_LOGIC("m_traceDequeue (p)");
@@ -620,6 +649,7 @@ Queue<Item, Container>::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_packets.clear();
+    ReleaseMemory(m_nBytes);
     Object::DoDispose();
 }
 
@@ -0,0 +1,385 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup queue
+ * ns3::RingBuffer declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup queue
+ * \brief Circular buffer usable as the container of a Queue
+ *
+ * Elements are stored in a contiguous array whose capacity is a power of two.
+ * Inserting or erasing at either end takes constant time and never moves any
+ * other element, so a FIFO queue does not allocate once the buffer has grown
+ * to the largest backlog seen. Insertions and removals in the middle shift the
+ * elements between the given position and the tail.
+ *
+ * Iterators refer to a logical position rather than to a memory location: they
+ * stay valid across a reallocation and when elements are added or removed at
+ * either end (except the one pointing to an erased element). An insertion or
+ * an erasure in the middle changes the element pointed to by the iterators
+ * after the given position, as it happens for std::vector.
+ *
+ * The capacity grows on demand, hence when RingBuffer is the container of a
+ * Queue it is bounded by the maximum size of the queue rounded up to a power
+ * of two.
+ *
+ * \tparam T \explicit Type of the stored elements
+ */
+template <typename T>
+class RingBuffer
+{
+  private:
+    /**
+     * Bidirectional iterator over the elements of a RingBuffer.
+     *
+     * \tparam IsConst whether this is a const iterator
+     */
+    template <bool IsConst>
+    class IteratorImpl
+    {
+      public:
+        /// Iterator category
+        using iterator_category = std::bidirectional_iterator_tag;
+        /// Type of the elements
+        using value_type = T;
+        /// Type of the difference between two iterators
+        using difference_type = std::ptrdiff_t;
+        /// Pointer to an element
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        /// Reference to an element
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        /// Pointer to the ring buffer
+        using RingPtr = std::conditional_t<IsConst, const RingBuffer*, RingBuffer*>;
+
+        IteratorImpl() = default;
+
+        /**
+         * Constructor
+         *
+         * \param ring the ring buffer
+         * \param index the logical index of the element pointed to
+         */
+        IteratorImpl(RingPtr ring, std::size_t index)
+            : m_ring(ring),
+              m_index(index)
+        {
+        }
+
+        /**
+         * Convert an iterator into a const iterator
+         *
+         * \param it the iterator
+         */
+        template <bool C = IsConst, typename = std::enable_if_t<C>>
+        IteratorImpl(const IteratorImpl<false>& it)
+            : m_ring(it.m_ring),
+              m_index(it.m_index)
+        {
+        }
+
+        /// \return a reference to the element pointed to
+        reference operator*() const
+        {
+            return m_ring->Slot(m_index);
+        }
+
+        /// \return a pointer to the element pointed to
+        pointer operator->() const
+        {
+            return &m_ring->Slot(m_index);
+        }
+
+        /// \return this iterator, moved to the next element
+        IteratorImpl& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        /// \return this iterator before it is moved to the next element
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl tmp = *this;
+            ++m_index;
+            return tmp;
+        }
+
+        /// \return this iterator, moved to the previous element
+        IteratorImpl& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        /// \return this iterator before it is moved to the previous element
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl tmp = *this;
+            --m_index;
+            return tmp;
+        }
+
+        /**
+         * \param a the first iterator
+         * \param b the second iterator
+         * \return true if the two iterators point to the same position
+         */
+        friend bool operator==(const IteratorImpl& a, const IteratorImpl& b)
+        {
+            return a.m_index == b.m_index;
+        }
+
+      private:
+        friend class RingBuffer;
+        template <bool>
+        friend class IteratorImpl;
+
+        RingPtr m_ring{nullptr}; //!< the ring buffer
+        std::size_t m_index{0};  //!< the logical index of the element pointed to
+    };
+
+  public:
+    /// Type of the elements
+    using value_type = T;
+    /// Type of the number of elements
+    using size_type = std::size_t;
+    /// Iterator
+    using iterator = IteratorImpl<false>;
+    /// Const iterator
+    using const_iterator = IteratorImpl<true>;
+
+    /// \return an iterator to the first element
+    iterator begin()
+    {
+        return iterator(this, m_head);
+    }
+
+    /// \return a const iterator to the first element
+    const_iterator begin() const
+    {
+        return const_iterator(this, m_head);
+    }
+
+    /// \return an iterator past the last element
+    iterator end()
+    {
+        return iterator(this, m_head + m_size);
+    }
+
+    /// \return a const iterator past the last element
+    const_iterator end() const
+    {
+        return const_iterator(this, m_head + m_size);
+    }
+
+    /// \return the number of stored elements
+    size_type size() const
+    {
+        return m_size;
+    }
+
+    /// \return true if no element is stored
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// \return the number of elements that can be stored without reallocating
+    size_type capacity() const
+    {
+        return m_slots.size();
+    }
+
+    /**
+     * Make room for at least the given number of elements.
+     *
+     * \param n the number of elements
+     */
+    void reserve(size_type n);
+
+    /**
+     * Insert an element before the given position.
+     *
+     * \param pos the position
+     * \param value the element to insert
+     * \return an iterator pointing to the inserted element
+     */
+    iterator insert(const_iterator pos, const T& value);
+
+    /**
+     * Erase the element at the given position.
+     *
+     * \param pos the position of the element to erase
+     * \return an iterator pointing to the element that followed the erased one
+     */
+    iterator erase(const_iterator pos);
+
+    /// Erase all the elements, keeping the allocated storage
+    void clear();
+
+  private:
+    /**
+     * \param index a logical index
+     * \return the slot storing the element with the given logical index
+     */
+    T& Slot(std::size_t index)
+    {
+        return m_slots[index & (m_slots.size() - 1)];
+    }
+
+    /**
+     * \param index a logical index
+     * \return the slot storing the element with the given logical index
+     */
+    const T& Slot(std::size_t index) const
+    {
+        return m_slots[index & (m_slots.size() - 1)];
+    }
+
+    /**
+     * Move the elements to a storage of the given capacity.
+     *
+     * \param capacity the new capacity, a power of two
+     */
+    void Reallocate(size_type capacity);
+
+    /// Minimum capacity allocated when the first element is inserted
+    static constexpr size_type MIN_CAPACITY = 16;
+
+    std::vector<T> m_slots; //!< storage, whose size is zero or a power of two
+    std::size_t m_head{0};  //!< logical index of the first element
+    size_type m_size{0};    //!< number of stored elements
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T>
+void
+RingBuffer<T>::reserve(size_type n)
+{
+    if (n <= capacity())
+    {
+        return;
+    }
+    size_type newCapacity = MIN_CAPACITY;
+    while (newCapacity < n)
+    {
+        newCapacity *= 2;
+    }
+    Reallocate(newCapacity);
+}
+
+template <typename T>
+void
+RingBuffer<T>::Reallocate(size_type newCapacity)
+{
+    std::vector<T> slots(newCapacity);
+    // logical indices are preserved, so that iterators stay valid
+    for (std::size_t index = m_head; index != m_head + m_size; ++index)
+    {
+        slots[index & (newCapacity - 1)] = std::move(Slot(index));
+    }
+    m_slots.swap(slots);
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::insert(const_iterator pos, const T& value)
+{
+    NS_ASSERT(pos.m_index - m_head <= m_size);
+
+    if (m_size == capacity())
+    {
+        Reallocate(m_slots.empty() ? MIN_CAPACITY : 2 * capacity());
+    }
+
+    std::size_t index = pos.m_index;
+
+    if (index == m_head && m_size > 0)
+    {
+        Slot(--m_head) = value;
+        ++m_size;
+        return iterator(this, m_head);
+    }
+
+    for (std::size_t i = m_head + m_size; i != index; --i)
+    {
+        Slot(i) = std::move(Slot(i - 1));
+    }
+    Slot(index) = value;
+    ++m_size;
+    return iterator(this, index);
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::erase(const_iterator pos)
+{
+    NS_ASSERT(pos.m_index - m_head < m_size);
+
+    std::size_t index = pos.m_index;
+
+    if (index == m_head)
+    {
+        Slot(m_head++) = T();
+        --m_size;
+        return iterator(this, m_head);
+    }
+
+    std::size_t last = m_head + m_size - 1;
+    for (std::size_t i = index; i != last; ++i)
+    {
+        Slot(i) = std::move(Slot(i + 1));
+    }
+    Slot(last) = T();
+    --m_size;
+    return iterator(this, index);
+}
+
+template <typename T>
+void
+RingBuffer<T>::clear()
+{
+    for (std::size_t index = m_head; index != m_head + m_size; ++index)
+    {
+        Slot(index) = T();
+    }
+    m_head = 0;
+    m_size = 0;
+}
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
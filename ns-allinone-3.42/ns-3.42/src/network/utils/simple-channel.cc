@@ -109,6 +109,13 @@ SimpleChannel::GetDevice(std::size_t i) const
     return m_devices[i];
 }
 
+Time
+SimpleChannel::GetMinimumDelay() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_delay;
+}
+
 void
 SimpleChannel::BlackList(Ptr<SimpleNetDevice> from, Ptr<SimpleNetDevice> to)
 {
@@ -101,6 +101,7 @@ class SimpleChannel : public Channel
     // inherited from ns3::Channel
     std::size_t GetNDevices() const override;
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
+    Time GetMinimumDelay() const override;
 
   private:
     Time m_delay; //!< The assigned speed-of-light delay of the channel
@@ -19,6 +19,7 @@
 #include "simple-net-device.h"
 
 #include "error-model.h"
+#include "packet-burst.h"
 #include "queue.h"
 #include "simple-channel.h"
 
@@ -426,6 +427,19 @@ SimpleNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocol
     return SendFrom(packet, m_address, dest, protocolNumber);
 }
 
+bool
+SimpleNetDevice::SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    bool ret = true;
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        ret = SimpleNetDevice::SendFrom(*it, m_address, dest, protocolNumber) && ret;
+    }
+    return ret;
+}
+
 bool
 SimpleNetDevice::SendFrom(Ptr<Packet> p,
                           const Address& source,
@@ -124,6 +124,7 @@ class SimpleNetDevice : public NetDevice
     bool IsPointToPoint() const override;
     bool IsBridge() const override;
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber) override;
     bool SendFrom(Ptr<Packet> packet,
                   const Address& source,
                   const Address& dest,
@@ -25,10 +25,12 @@
 #include "nix-vector-routing.h"
 
 #include "ns3/abort.h"
+#include "ns3/global-value.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 
 #include <iomanip>
 #include <queue>
@@ -41,6 +43,13 @@ NS_LOG_COMPONENT_DEFINE("NixVectorRouting");
 NS_OBJECT_TEMPLATE_CLASS_DEFINE(NixVectorRouting, Ipv4RoutingProtocol);
 NS_OBJECT_TEMPLATE_CLASS_DEFINE(NixVectorRouting, Ipv6RoutingProtocol);
 
+/// Bound of the shared nix-vector and route cache
+static GlobalValue g_nixCacheSize("NixVectorRoutingCacheSize",
+                                  "Maximum number of (node, destination) entries in the "
+                                  "Nix-vector routing cache; 0 means unbounded",
+                                  UintegerValue(100000),
+                                  MakeUintegerChecker<uint32_t>());
+
 template <typename T>
 bool NixVectorRouting<T>::g_isCacheDirty = false;
 
@@ -55,6 +64,22 @@ template <typename T>
 typename NixVectorRouting<T>::NetDeviceToIpInterfaceMap
     NixVectorRouting<T>::g_netdeviceToIpInterfaceMap;
 
+template <typename T>
+std::set<uint32_t> NixVectorRouting<T>::g_downNodes;
+
+template <typename T>
+typename NixVectorRouting<T>::CacheList_t NixVectorRouting<T>::g_cacheList;
+
+template <typename T>
+std::unordered_map<uint32_t, typename NixVectorRouting<T>::CacheIndex_t>
+    NixVectorRouting<T>::g_cacheIndex;
+
+template <typename T>
+std::vector<uint32_t> NixVectorRouting<T>::g_adjacencyOffsets;
+
+template <typename T>
+std::vector<uint32_t> NixVectorRouting<T>::g_adjacency;
+
 template <typename T>
 TypeId
 NixVectorRouting<T>::GetTypeId()
@@ -130,6 +155,15 @@ NixVectorRouting<T>::DoDispose()
 {
     NS_LOG_FUNCTION_NOARGS();
 
+    if (m_node)
+    {
+        FlushNixCache();
+        FlushIpRouteCache();
+    }
+    // The topology is going away, drop the adjacency built over it
+    g_adjacencyOffsets.clear();
+    g_adjacency.clear();
+
     m_node = nullptr;
     m_ip = nullptr;
 
@@ -159,15 +193,19 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache() const
         {
             continue;
         }
-        NS_LOG_LOGIC("Flushing Nix caches.");
-        rp->FlushNixCache();
-        rp->FlushIpRouteCache();
         rp->m_totalNeighbors = 0;
     }
 
-    // IP address to node mapping is potentially invalid so clear it.
+    NS_LOG_LOGIC("Flushing Nix caches.");
+    g_cacheList.clear();
+    g_cacheIndex.clear();
+    g_downNodes.clear();
+
+    // IP address to node mapping and adjacency are potentially invalid so clear them.
     // Will be repopulated in lazy evaluation when mapping is needed.
     g_ipAddressToNodeMap.clear();
+    g_adjacencyOffsets.clear();
+    g_adjacency.clear();
 }
 
 template <typename T>
@@ -175,7 +213,27 @@ void
 NixVectorRouting<T>::FlushNixCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_nixCache.clear();
+
+    auto node = g_cacheIndex.find(m_node->GetId());
+    if (node == g_cacheIndex.end())
+    {
+        return;
+    }
+    // Erasing the last entry of the node erases its index too, so iterate on a copy
+    std::vector<typename CacheList_t::iterator> entries;
+    for (const auto& [address, entry] : node->second)
+    {
+        entries.push_back(entry);
+    }
+    for (auto entry : entries)
+    {
+        entry->nixVector = nullptr;
+        entry->path.clear();
+        if (!entry->route)
+        {
+            EraseCacheEntry(entry);
+        }
+    }
 }
 
 template <typename T>
@@ -183,12 +241,82 @@ void
 NixVectorRouting<T>::FlushIpRouteCache() const
 {
     NS_LOG_FUNCTION_NOARGS();
-    m_ipRouteCache.clear();
+
+    auto node = g_cacheIndex.find(m_node->GetId());
+    if (node == g_cacheIndex.end())
+    {
+        return;
+    }
+    std::vector<typename CacheList_t::iterator> entries;
+    for (const auto& [address, entry] : node->second)
+    {
+        entries.push_back(entry);
+    }
+    for (auto entry : entries)
+    {
+        entry->route = nullptr;
+        if (!entry->nixVector)
+        {
+            EraseCacheEntry(entry);
+        }
+    }
+}
+
+template <typename T>
+typename NixVectorRouting<T>::CacheEntry*
+NixVectorRouting<T>::LookupCacheEntry(uint32_t node, const IpAddress& address, bool create)
+{
+    auto nodeIt = g_cacheIndex.find(node);
+    if (nodeIt != g_cacheIndex.end())
+    {
+        auto it = nodeIt->second.find(address);
+        if (it != nodeIt->second.end())
+        {
+            g_cacheList.splice(g_cacheList.begin(), g_cacheList, it->second);
+            return &(*it->second);
+        }
+    }
+    if (!create)
+    {
+        return nullptr;
+    }
+
+    g_cacheList.push_front(CacheEntry{node, address, nullptr, {}, nullptr});
+    g_cacheIndex[node][address] = g_cacheList.begin();
+
+    UintegerValue size;
+    g_nixCacheSize.GetValue(size);
+    if (size.Get() > 0)
+    {
+        while (g_cacheList.size() > size.Get())
+        {
+            NS_LOG_LOGIC("Evicting least recently used Nix cache entry.");
+            EraseCacheEntry(std::prev(g_cacheList.end()));
+        }
+    }
+    return &g_cacheList.front();
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::EraseCacheEntry(typename CacheList_t::iterator it)
+{
+    auto nodeIt = g_cacheIndex.find(it->node);
+    NS_ASSERT(nodeIt != g_cacheIndex.end());
+    nodeIt->second.erase(it->dest);
+    if (nodeIt->second.empty())
+    {
+        g_cacheIndex.erase(nodeIt);
+    }
+    g_cacheList.erase(it);
 }
 
 template <typename T>
 Ptr<NixVector>
-NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevice> oif) const
+NixVectorRouting<T>::GetNixVector(Ptr<Node> source,
+                                  IpAddress dest,
+                                  Ptr<NetDevice> oif,
+                                  std::vector<uint32_t>* path) const
 {
     NS_LOG_FUNCTION(this << source << dest << oif);
 
@@ -223,6 +351,16 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
         {
             if (BuildNixVector(parentVector, source->GetId(), destNode->GetId(), nixVector))
             {
+                if (path)
+                {
+                    path->clear();
+                    for (Ptr<Node> node = destNode; node != source;
+                         node = parentVector.at(node->GetId()))
+                    {
+                        path->push_back(node->GetId());
+                    }
+                    path->push_back(source->GetId());
+                }
                 return nixVector;
             }
             else
@@ -247,12 +385,12 @@ NixVectorRouting<T>::GetNixVectorInCache(const IpAddress& address, bool& foundIn
 
     CheckCacheStateAndFlush();
 
-    auto iter = m_nixCache.find(address);
-    if (iter != m_nixCache.end())
+    CacheEntry* entry = LookupCacheEntry(m_node->GetId(), address, false);
+    if (entry && entry->nixVector)
     {
         NS_LOG_LOGIC("Found Nix-vector in cache.");
         foundInCache = true;
-        return iter->second;
+        return entry->nixVector;
     }
 
     // not in cache
@@ -268,17 +406,48 @@ NixVectorRouting<T>::GetIpRouteInCache(IpAddress address)
 
     CheckCacheStateAndFlush();
 
-    auto iter = m_ipRouteCache.find(address);
-    if (iter != m_ipRouteCache.end())
+    CacheEntry* entry = LookupCacheEntry(m_node->GetId(), address, false);
+    if (entry && entry->route)
     {
         NS_LOG_LOGIC("Found IpRoute in cache.");
-        return iter->second;
+        return entry->route;
     }
 
     // not in cache
     return nullptr;
 }
 
+template <typename T>
+void
+NixVectorRouting<T>::AddNixVectorInCache(const IpAddress& address,
+                                         Ptr<NixVector> nixVector,
+                                         std::vector<uint32_t>&& path) const
+{
+    NS_LOG_FUNCTION(this << address << nixVector);
+
+    CacheEntry* entry = LookupCacheEntry(m_node->GetId(), address, true);
+    entry->nixVector = nixVector;
+    entry->path = std::move(path);
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::AddIpRouteInCache(const IpAddress& address, Ptr<IpRoute> route)
+{
+    NS_LOG_FUNCTION(this << address << route);
+
+    CacheEntry* entry = LookupCacheEntry(m_node->GetId(), address, route != nullptr);
+    if (!entry)
+    {
+        return;
+    }
+    entry->route = route;
+    if (!route && !entry->nixVector)
+    {
+        EraseCacheEntry(g_cacheIndex[entry->node][address]);
+    }
+}
+
 template <typename T>
 bool
 NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
@@ -757,11 +926,12 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
         NS_LOG_LOGIC("Nix-vector not in cache, build: ");
         // Build the nix-vector, given this node and the
         // dest IP address
-        nixVectorInCache = GetNixVector(m_node, destAddress, oif);
+        std::vector<uint32_t> path;
+        nixVectorInCache = GetNixVector(m_node, destAddress, oif, &path);
         if (nixVectorInCache)
         {
             // cache it
-            m_nixCache.insert(typename NixMap_t::value_type(destAddress, nixVectorInCache));
+            AddNixVectorInCache(destAddress, nixVectorInCache, std::move(path));
         }
     }
 
@@ -799,7 +969,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
             // rtentry from the map
             if (rtentry)
             {
-                m_ipRouteCache.erase(destAddress);
+                AddIpRouteInCache(destAddress, nullptr);
             }
 
             NS_LOG_LOGIC("IpRoute not in cache, build: ");
@@ -839,7 +1009,7 @@ NixVectorRouting<T>::RouteOutput(Ptr<Packet> p,
             sockerr = Socket::ERROR_NOTERROR;
 
             // add rtentry to cache
-            m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+            AddIpRouteInCache(destAddress, rtentry);
         }
 
         NS_LOG_LOGIC("Nix-vector contents: " << *nixVectorInCache << " : Remaining bits: "
@@ -972,7 +1142,7 @@ NixVectorRouting<T>::RouteInput(Ptr<const Packet> p,
         rtentry->SetOutputDevice(m_ip->GetNetDevice(interfaceIndex));
 
         // add rtentry to cache
-        m_ipRouteCache.insert(typename IpRouteMap_t::value_type(destAddress, rtentry));
+        AddIpRouteInCache(destAddress, rtentry);
     }
 
     NS_LOG_LOGIC("At Node " << m_node->GetId() << ", Extracting " << numberOfBits
@@ -1013,53 +1183,65 @@ NixVectorRouting<T>::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Un
         << ", Local time: " << m_ip->template GetObject<Node>()->GetLocalTime().As(unit)
         << ", Nix Routing" << std::endl;
 
+    // Entries of this node in the shared cache, sorted by destination
+    std::vector<const CacheEntry*> nixEntries;
+    std::vector<const CacheEntry*> routeEntries;
+    auto node = g_cacheIndex.find(m_node->GetId());
+    if (node != g_cacheIndex.end())
+    {
+        for (const auto& [address, entry] : node->second)
+        {
+            if (entry->nixVector)
+            {
+                nixEntries.push_back(&(*entry));
+            }
+            if (entry->route)
+            {
+                routeEntries.push_back(&(*entry));
+            }
+        }
+    }
+
     *os << "NixCache:" << std::endl;
-    if (m_nixCache.size() > 0)
+    if (!nixEntries.empty())
     {
         *os << std::setw(30) << "Destination";
         *os << "NixVector" << std::endl;
-        for (auto it = m_nixCache.begin(); it != m_nixCache.end(); it++)
+        for (const auto entry : nixEntries)
         {
             std::ostringstream dest;
-            dest << it->first;
+            dest << entry->dest;
             *os << std::setw(30) << dest.str();
-            if (it->second)
-            {
-                *os << *(it->second) << std::endl;
-            }
-            else
-            {
-                *os << "-" << std::endl;
-            }
+            *os << *(entry->nixVector) << std::endl;
         }
     }
 
     *os << "IpRouteCache:" << std::endl;
-    if (m_ipRouteCache.size() > 0)
+    if (!routeEntries.empty())
     {
         *os << std::setw(30) << "Destination";
         *os << std::setw(30) << "Gateway";
         *os << std::setw(30) << "Source";
         *os << "OutputDevice" << std::endl;
-        for (auto it = m_ipRouteCache.begin(); it != m_ipRouteCache.end(); it++)
+        for (const auto entry : routeEntries)
         {
             std::ostringstream dest;
             std::ostringstream gw;
             std::ostringstream src;
-            dest << it->second->GetDestination();
+            dest << entry->route->GetDestination();
             *os << std::setw(30) << dest.str();
-            gw << it->second->GetGateway();
+            gw << entry->route->GetGateway();
             *os << std::setw(30) << gw.str();
-            src << it->second->GetSource();
+            src << entry->route->GetSource();
             *os << std::setw(30) << src.str();
             *os << "  ";
-            if (Names::FindName(it->second->GetOutputDevice()) != "")
+            if (Names::FindName(entry->route->GetOutputDevice()) != "")
             {
-                *os << Names::FindName(it->second->GetOutputDevice());
+                *os << Names::FindName(entry->route->GetOutputDevice());
             }
             else
             {
-                *os << it->second->GetOutputDevice()->GetIfIndex();
+                *os << entry->route->GetOutputDevice()->GetIfIndex();
             }
             *os << std::endl;
         }
@@ -1081,6 +1263,17 @@ template <typename T>
 void
 NixVectorRouting<T>::NotifyInterfaceDown(uint32_t i)
 {
+    if constexpr (IsIpv4)
+    {
+        if (m_node)
+        {
+            // Only the routes through this node and its neighbors are affected
+            g_downNodes.insert(m_node->GetId());
+            return;
+        }
+    }
+    // IPv6 interfaces lose their addresses when going down, which
+    // invalidates the address to node map as well
     g_isCacheDirty = true;
 }
 
@@ -1120,6 +1313,131 @@ NixVectorRouting<T>::NotifyRemoveRoute(IpAddress dst,
     g_isCacheDirty = true;
 }
 
+template <typename T>
+void
+NixVectorRouting<T>::BuildAdjacency() const
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    g_adjacencyOffsets.assign(1, 0);
+    g_adjacency.clear();
+
+    for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        Ptr<Node> node = *it;
+        Ptr<IpL3Protocol> ip = node->GetObject<IpL3Protocol>();
+
+        for (uint32_t i = 0; i < node->GetNDevices(); i++)
+        {
+            // Get a net device from the node
+            // as well as the channel, and figure
+            // out the adjacent net device
+            Ptr<NetDevice> localNetDevice = node->GetDevice(i);
+
+            // make sure that we can go this way
+            if (ip)
+            {
+                uint32_t interfaceIndex = (ip)->GetInterfaceForDevice(localNetDevice);
+                if (!(ip->IsUp(interfaceIndex)))
+                {
+                    NS_LOG_LOGIC("IpInterface is down");
+                    continue;
+                }
+            }
+            if (!(localNetDevice->IsLinkUp()))
+            {
+                NS_LOG_LOGIC("Link is down.");
+                continue;
+            }
+            Ptr<Channel> channel = localNetDevice->GetChannel();
+            if (!channel)
+            {
+                continue;
+            }
+
+            // this function takes in the local net dev, and channel, and
+            // writes to the netDeviceContainer the adjacent net devs
+            NetDeviceContainer netDeviceContainer;
+            GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
+
+            for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End(); iter++)
+            {
+                Ptr<IpInterface> remoteIpInterface = GetInterfaceByNetDevice(*iter);
+                if (!remoteIpInterface || !(remoteIpInterface->IsUp()))
+                {
+                    NS_LOG_LOGIC("IpInterface either doesn't exist or is down");
+                    continue;
+                }
+                g_adjacency.push_back((*iter)->GetNode()->GetId());
+            }
+        }
+        g_adjacencyOffsets.push_back(g_adjacency.size());
+    }
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::InvalidateAffectedRoutes() const
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    // Nodes whose neighbor count, and hence nix-vector encoding, may have changed
+    std::vector<bool> affected(NodeList::GetNNodes(), false);
+    bool adjacencyValid = (g_adjacencyOffsets.size() == NodeList::GetNNodes() + 1);
+    for (uint32_t node : g_downNodes)
+    {
+        affected.at(node) = true;
+        if (adjacencyValid)
+        {
+            for (uint32_t k = g_adjacencyOffsets[node]; k < g_adjacencyOffsets[node + 1]; ++k)
+            {
+                affected.at(g_adjacency[k]) = true;
+            }
+        }
+    }
+    g_downNodes.clear();
+
+    if (!adjacencyValid)
+    {
+        // No way to tell the neighbors apart, fall back to a full flush
+        FlushGlobalNixRoutingCache();
+        return;
+    }
+
+    for (uint32_t node = 0; node < affected.size(); ++node)
+    {
+        if (affected[node])
+        {
+            Ptr<NixVectorRouting<T>> rp = NodeList::GetNode(node)->GetObject<NixVectorRouting>();
+            if (rp)
+            {
+                rp->m_totalNeighbors = 0;
+            }
+        }
+    }
+
+    // Removing links only makes other paths longer, so a nix-vector that
+    // crosses none of the affected nodes is still valid and shortest.
+    // Routes learnt from forwarded packets carry no path and are dropped.
+    for (auto it = g_cacheList.begin(); it != g_cacheList.end();)
+    {
+        auto entry = it++;
+        bool stale = affected[entry->node] || !entry->nixVector;
+        for (auto node = entry->path.begin(); !stale && node != entry->path.end(); ++node)
+        {
+            stale = affected[*node];
+        }
+        if (stale)
+        {
+            EraseCacheEntry(entry);
+        }
+    }
+
+    NS_LOG_LOGIC("Kept " << g_cacheList.size() << " Nix cache entries.");
+    g_adjacencyOffsets.clear();
+    g_adjacency.clear();
+}
+
 template <typename T>
 bool
 NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
@@ -1136,6 +1454,12 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
     // reset the parent vector
     parentVector.assign(numberOfNodes, nullptr); // initialize to 0
 
+    // (re)build the adjacency if the topology changed
+    if (g_adjacencyOffsets.size() != numberOfNodes + 1)
+    {
+        BuildAdjacency();
+    }
+
     // Add the source node to the queue, set its parent to itself
     greyNodeList.push(source);
     parentVector.at(source->GetId()) = source;
@@ -1144,7 +1468,6 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
     while (!greyNodeList.empty())
     {
         Ptr<Node> currNode = greyNodeList.front();
-        Ptr<IpL3Protocol> ip = currNode->GetObject<IpL3Protocol>();
 
         if (currNode == dest)
         {
@@ -1158,6 +1481,7 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
         if (currNode == source && oif)
         {
             // make sure that we can go this way
+            Ptr<IpL3Protocol> ip = currNode->GetObject<IpL3Protocol>();
             if (ip)
             {
                 uint32_t interfaceIndex = (ip)->GetInterfaceForDevice(oif);
@@ -1211,64 +1535,21 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
         else
         {
             // Iterate over the current node's adjacent vertices
-            // and push them into the queue
-            for (uint32_t i = 0; i < (currNode->GetNDevices()); i++)
+            // and push them into the queue.  The adjacency only
+            // holds neighbors reachable through up interfaces and links.
+            uint32_t currId = currNode->GetId();
+            for (uint32_t k = g_adjacencyOffsets[currId]; k < g_adjacencyOffsets[currId + 1]; ++k)
             {
-                // Get a net device from the node
-                // as well as the channel, and figure
-                // out the adjacent net device
-                Ptr<NetDevice> localNetDevice = currNode->GetDevice(i);
-
-                // make sure that we can go this way
-                if (ip)
-                {
-                    uint32_t interfaceIndex = (ip)->GetInterfaceForDevice(currNode->GetDevice(i));
-                    if (!(ip->IsUp(interfaceIndex)))
-                    {
-                        NS_LOG_LOGIC("IpInterface is down");
-                        continue;
-                    }
-                }
-                if (!(localNetDevice->IsLinkUp()))
-                {
-                    NS_LOG_LOGIC("Link is down.");
-                    continue;
-                }
-                Ptr<Channel> channel = localNetDevice->GetChannel();
-                if (!channel)
-                {
-                    continue;
-                }
-
-                // this function takes in the local net dev, and channel, and
-                // writes to the netDeviceContainer the adjacent net devs
-                NetDeviceContainer netDeviceContainer;
-                GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
-
-                // Finally we can get the adjacent nodes
-                // and scan through them.  We push them
-                // to the greyNode queue, if they aren't
-                // already there.
-                for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End();
-                     iter++)
+                // check to see if this node has been pushed before
+                // by checking to see if it has a parent
+                // if it doesn't (null or 0), then set its parent and
+                // push to the queue
+                uint32_t remoteId = g_adjacency[k];
+                if (!parentVector.at(remoteId))
                 {
-                    Ptr<Node> remoteNode = (*iter)->GetNode();
-                    Ptr<IpInterface> remoteIpInterface = GetInterfaceByNetDevice(*iter);
-                    if (!remoteIpInterface || !(remoteIpInterface->IsUp()))
-                    {
-                        NS_LOG_LOGIC("IpInterface either doesn't exist or is down");
-                        continue;
-                    }
-
-                    // check to see if this node has been pushed before
-                    // by checking to see if it has a parent
-                    // if it doesn't (null or 0), then set its parent and
-                    // push to the queue
-                    if (!parentVector.at(remoteNode->GetId()))
-                    {
-                        parentVector.at(remoteNode->GetId()) = currNode;
-                        greyNodeList.push(remoteNode);
-                    }
+                    Ptr<Node> remoteNode = NodeList::GetNode(remoteId);
+                    parentVector.at(remoteId) = currNode;
+                    greyNodeList.push(remoteNode);
                 }
             }
         }
@@ -1427,6 +1708,11 @@ NixVectorRouting<T>::CheckCacheStateAndFlush() const
         g_epoch++;
         g_isCacheDirty = false;
     }
+    else if (!g_downNodes.empty())
+    {
+        InvalidateAffectedRoutes();
+        g_epoch++;
+    }
 }
 
 /* Public template function declarations */
@@ -41,7 +41,9 @@
 #include "ns3/node-list.h"
 #include "ns3/nstime.h"
 
+#include <list>
 #include <map>
+#include <set>
 #include <unordered_map>
 
 // NOLINTBEGIN(modernize-use-override)
@@ -60,6 +62,15 @@ namespace ns3
  * \ingroup nix-vector-routing
  * Nix-vector routing protocol
  *
+ * Nix-vectors and routes are kept in a single cache shared by all the
+ * nodes, keyed by (node, destination) and bounded by the
+ * NixVectorRoutingCacheSize global value; when the bound is reached the
+ * least recently used entry is evicted.  Paths are computed by a BFS over
+ * a compressed (CSR) adjacency of the whole topology, built on first use
+ * and rebuilt after a topology change.  When an IPv4 interface goes down,
+ * only the nix-vectors whose path crosses the node or one of its
+ * neighbors are dropped; any other change flushes all the caches.
+ *
  * \internal
  * Since this class is meant to be specialized only by Ipv4RoutingProtocol or
  * Ipv6RoutingProtocol the implementation of this class doesn't need to be
@@ -123,7 +134,7 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      * \internal
      * \c const is used here due to need to potentially flush the cache
      * in const methods such as PrintRoutingTable.  Caches are stored in
-     * mutable variables and flushed in const methods.
+     * static variables and flushed in const methods.
      */
     void FlushGlobalNixRoutingCache() const;
 
@@ -167,12 +178,16 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      * BFS, accounting for any output interface specified, and finally
      * BuildNixVector to return the built nix-vector
      *
-     * \param source Source node
-     * \param dest Destination node address
-     * \param oif Preferred output interface
+     * \param [in] source Source node
+     * \param [in] dest Destination node address
+     * \param [in] oif Preferred output interface
+     * \param [out] path if not null, the ids of the nodes traversed by the path
      * \returns The NixVector to be used in routing.
      */
-    Ptr<NixVector> GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevice> oif) const;
+    Ptr<NixVector> GetNixVector(Ptr<Node> source,
+                                IpAddress dest,
+                                Ptr<NetDevice> oif,
+                                std::vector<uint32_t>* path = nullptr) const;
 
     /**
      * Checks the cache based on dest IP for the nix-vector
@@ -189,6 +204,25 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     Ptr<IpRoute> GetIpRouteInCache(IpAddress address);
 
+    /**
+     * Stores a nix-vector in the shared cache, evicting the least
+     * recently used entries if the cache grows past its bound
+     * \param address Destination address
+     * \param nixVector The nix-vector towards address
+     * \param path The ids of the nodes traversed by nixVector
+     */
+    void AddNixVectorInCache(const IpAddress& address,
+                             Ptr<NixVector> nixVector,
+                             std::vector<uint32_t>&& path) const;
+
+    /**
+     * Stores (or, if route is null, removes) an IpRoute in the shared cache,
+     * evicting the least recently used entries if the cache grows past its bound
+     * \param address Destination address
+     * \param route The route towards address
+     */
+    void AddIpRouteInCache(const IpAddress& address, Ptr<IpRoute> route);
+
     /**
      * Given a net-device returns all the adjacent net-devices,
      * essentially getting the neighbors on that channel
@@ -256,6 +290,19 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                                       uint32_t nodeIndex,
                                       IpAddress& gatewayIp) const;
 
+    /**
+     * Builds the CSR adjacency of the topology: for each node, the ids of
+     * the nodes reachable through its up interfaces and links.
+     */
+    void BuildAdjacency() const;
+
+    /**
+     * Drops the cache entries affected by the interfaces that went down
+     * since the last call, i.e. the entries of the nodes owning those
+     * interfaces and of their neighbors, and the nix-vectors crossing them.
+     */
+    void InvalidateAffectedRoutes() const;
+
     /**
      * \brief Breadth first search algorithm.
      * \param [in] numberOfNodes total number of nodes
@@ -283,11 +330,6 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     void DoDispose();
 
-    /// Map of IpAddress to NixVector
-    typedef std::map<IpAddress, Ptr<NixVector>> NixMap_t;
-    /// Map of IpAddress to IpRoute
-    typedef std::map<IpAddress, Ptr<IpRoute>> IpRouteMap_t;
-
     /// Callback for IPv4 unicast packets to be forwarded
     typedef Callback<void, Ptr<IpRoute>, Ptr<const Packet>, const IpHeader&>
         UnicastForwardCallbackv4;
@@ -491,11 +533,52 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
      */
     static uint32_t g_epoch;
 
-    /** Cache stores nix-vectors based on destination ip */
-    mutable NixMap_t m_nixCache;
+    /**
+     * Nodes with an interface that went down since the last cache check.
+     * Used to invalidate only the affected cache entries.
+     */
+    static std::set<uint32_t> g_downNodes;
+
+    /// Entry of the shared nix-vector and IpRoute cache
+    struct CacheEntry
+    {
+        uint32_t node;              //!< Id of the node owning the entry
+        IpAddress dest;             //!< Destination address
+        Ptr<NixVector> nixVector;   //!< Nix-vector from node to dest (may be null)
+        std::vector<uint32_t> path; //!< Ids of the nodes traversed by nixVector
+        Ptr<IpRoute> route;         //!< Route from node to dest (may be null)
+    };
+
+    /// List of cache entries, most recently used first
+    typedef std::list<CacheEntry> CacheList_t;
+    /// Map of IpAddress to the entry of a node
+    typedef std::map<IpAddress, typename CacheList_t::iterator> CacheIndex_t;
+
+    /**
+     * Looks up the cache entry of a node towards a destination
+     * and moves it to the front of the LRU list
+     * \param node the node id
+     * \param address the destination address
+     * \param create whether to create the entry if it does not exist
+     * \returns the entry, or null if not found and not created
+     */
+    static CacheEntry* LookupCacheEntry(uint32_t node, const IpAddress& address, bool create);
+
+    /**
+     * Removes an entry from the shared cache
+     * \param it the entry to remove
+     */
+    static void EraseCacheEntry(typename CacheList_t::iterator it);
+
+    /// Shared cache entries, most recently used first
+    static CacheList_t g_cacheList;
+    /// Index of the shared cache, by node id and then destination address
+    static std::unordered_map<uint32_t, CacheIndex_t> g_cacheIndex;
 
-    /** Cache stores IpRoutes based on destination ip */
-    mutable IpRouteMap_t m_ipRouteCache;
+    /// CSR adjacency: offsets in g_adjacency of the neighbors of each node
+    static std::vector<uint32_t> g_adjacencyOffsets;
+    /// CSR adjacency: neighbor node ids
+    static std::vector<uint32_t> g_adjacency;
 
     Ptr<Ip> m_ip;     //!< IP object
     Ptr<Node> m_node; //!< Node object
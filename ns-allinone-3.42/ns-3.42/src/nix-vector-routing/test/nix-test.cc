@@ -17,6 +17,8 @@
  * Author: Ameya Deshpande <ameyanrd@outlook.com>
  */
 
+#include "ns3/config.h"
+#include "ns3/global-value.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -32,6 +34,7 @@
 #include "ns3/test.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -393,6 +396,192 @@ NixVectorRoutingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * The topology is of the form:
+ * \verbatim
+    n0 -- n1 -- n2 -- n3
+                 |
+                 n4
+   \endverbatim
+ *
+ * Following are the tests in this test case:
+ * - Route from n0 to n1 and from n0 to n3.
+ * (Set down the interface of n4 on the n2-n4 channel.)
+ * - Test that the n0 -> n1 route is still cached, while the n0 -> n3 one,
+ *   whose path crosses a neighbor of n4, has been dropped.
+ * - Test the routing from n0 to n3 again.
+ * (Limit the cache to one entry.)
+ * - Route from n0 to n1 and from n0 to n2: test that the packets are
+ *   delivered and that only the most recent entry is kept.
+ *
+ * \brief IPv4 Nix-Vector Routing shared cache Test
+ */
+class NixVectorRoutingCacheTest : public TestCase
+{
+    /**
+     * \brief Send data immediately after being called.
+     * \param socket The sending socket.
+     * \param to IPv4 Destination address.
+     */
+    void DoSendData(Ptr<Socket> socket, Ipv4Address to);
+
+    /**
+     * \brief Schedules the DoSendData () function to send the data.
+     * \param delay The scheduled time to send data.
+     * \param socket The sending socket.
+     * \param to IPv4 Destination address.
+     */
+    void SendData(Time delay, Ptr<Socket> socket, Ipv4Address to);
+
+    /**
+     * \brief Receive data.
+     * \param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+
+    uint32_t m_receivedPackets{0}; //!< Number of received packets
+
+  public:
+    void DoRun() override;
+    NixVectorRoutingCacheTest();
+};
+
+NixVectorRoutingCacheTest::NixVectorRoutingCacheTest()
+    : TestCase("shared cache invalidation and bound test")
+{
+}
+
+void
+NixVectorRoutingCacheTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_receivedPackets++;
+    }
+}
+
+void
+NixVectorRoutingCacheTest::DoSendData(Ptr<Socket> socket, Ipv4Address to)
+{
+    Address realTo = InetSocketAddress(to, 1234);
+    socket->SendTo(Create<Packet>(123), 0, realTo);
+}
+
+void
+NixVectorRoutingCacheTest::SendData(Time delay, Ptr<Socket> socket, Ipv4Address to)
+{
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(),
+                                   delay,
+                                   &NixVectorRoutingCacheTest::DoSendData,
+                                   this,
+                                   socket,
+                                   to);
+}
+
+void
+NixVectorRoutingCacheTest::DoRun()
+{
+    UintegerValue cacheSize;
+    GlobalValue::GetValueByName("NixVectorRoutingCacheSize", cacheSize);
+
+    NodeContainer nodes;
+    nodes.Create(5);
+
+    Ipv4NixVectorHelper ipv4NixRouting;
+    InternetStackHelper stack;
+    stack.SetIpv6StackInstall(false);
+    stack.SetRoutingHelper(ipv4NixRouting);
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    NetDeviceContainer d0d1 = devHelper.Install(NodeContainer(nodes.Get(0), nodes.Get(1)));
+    NetDeviceContainer d1d2 = devHelper.Install(NodeContainer(nodes.Get(1), nodes.Get(2)));
+    NetDeviceContainer d2d3 = devHelper.Install(NodeContainer(nodes.Get(2), nodes.Get(3)));
+    NetDeviceContainer d2d4 = devHelper.Install(NodeContainer(nodes.Get(2), nodes.Get(4)));
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.255.0");
+    address.Assign(d0d1);
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(d1d2);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    address.Assign(d2d3);
+    address.SetBase("10.1.3.0", "255.255.255.0");
+    address.Assign(d2d4);
+
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        Ptr<Socket> rxSocket = nodes.Get(i)->GetObject<UdpSocketFactory>()->CreateSocket();
+        NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 1234)),
+                              0,
+                              "trivial");
+        rxSocket->SetRecvCallback(MakeCallback(&NixVectorRoutingCacheTest::ReceivePkt, this));
+    }
+    Ptr<Socket> txSocket = nodes.Get(0)->GetObject<UdpSocketFactory>()->CreateSocket();
+
+    std::ostringstream stringStream1;
+    Ptr<OutputStreamWrapper> cacheStream1 = Create<OutputStreamWrapper>(&stringStream1);
+    std::ostringstream stringStream2;
+    Ptr<OutputStreamWrapper> cacheStream2 = Create<OutputStreamWrapper>(&stringStream2);
+    std::ostringstream stringStream3;
+    Ptr<OutputStreamWrapper> cacheStream3 = Create<OutputStreamWrapper>(&stringStream3);
+
+    SendData(Seconds(1), txSocket, Ipv4Address("10.1.0.2"));
+    SendData(Seconds(1), txSocket, Ipv4Address("10.1.2.2"));
+
+    // Set the n4 interface on the n2 - n4 channel down.
+    Ptr<Ipv4> ipv4 = nodes.Get(4)->GetObject<Ipv4>();
+    int32_t ifIndex = ipv4->GetInterfaceForDevice(d2d4.Get(1));
+    Simulator::Schedule(Seconds(2), &Ipv4::SetDown, ipv4, ifIndex);
+
+    Ipv4RoutingHelper::PrintRoutingTableAt(Seconds(3), nodes.Get(0), cacheStream1);
+
+    SendData(Seconds(4), txSocket, Ipv4Address("10.1.2.2"));
+
+    // From now on keep a single entry in the cache
+    Simulator::Schedule(Seconds(5),
+                        &Config::SetGlobal,
+                        "NixVectorRoutingCacheSize",
+                        UintegerValue(1));
+    SendData(Seconds(6), txSocket, Ipv4Address("10.1.0.2"));
+    SendData(Seconds(7), txSocket, Ipv4Address("10.1.1.2"));
+
+    Ipv4RoutingHelper::PrintRoutingTableAt(Seconds(8), nodes.Get(0), cacheStream2);
+    Ipv4RoutingHelper::PrintRoutingTableAt(Seconds(8), nodes.Get(1), cacheStream3);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_receivedPackets, 5, "All the packets should have been delivered.");
+
+    // Only the n0 -> n1 entries survive the interface going down
+    NS_TEST_EXPECT_MSG_NE(stringStream1.str().find("10.1.0.2"),
+                          std::string::npos,
+                          "The route to n1 should have been kept.");
+    NS_TEST_EXPECT_MSG_EQ(stringStream1.str().find("10.1.2.2"),
+                          std::string::npos,
+                          "The route to n3 should have been dropped.");
+
+    // The last packet evicted the n0 entries and left a route on n1
+    const std::string emptyCache = "Node: 0, Time: +8s, Local time: +8s, Nix Routing\n"
+                                   "NixCache:\n"
+                                   "IpRouteCache:\n\n";
+    NS_TEST_EXPECT_MSG_EQ(stringStream2.str(), emptyCache, "The cache of n0 should be empty.");
+    NS_TEST_EXPECT_MSG_EQ(stringStream3.str().find("NixCache:\nIpRouteCache:\n"),
+                          stringStream3.str().find("NixCache:"),
+                          "The Nix cache of n1 should be empty.");
+    NS_TEST_EXPECT_MSG_NE(stringStream3.str().find("10.1.1.2"),
+                          std::string::npos,
+                          "The route of n1 to n2 should have been kept.");
+
+    Simulator::Destroy();
+    Config::SetGlobal("NixVectorRoutingCacheSize", cacheSize);
+}
+
 /**
  * \ingroup nix-vector-routing-test
  * \ingroup tests
@@ -406,6 +595,7 @@ class NixVectorRoutingTestSuite : public TestSuite
         : TestSuite("nix-vector-routing", Type::UNIT)
     {
         AddTestCase(new NixVectorRoutingTest(), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorRoutingCacheTest(), TestCase::Duration::QUICK);
     }
 };
 
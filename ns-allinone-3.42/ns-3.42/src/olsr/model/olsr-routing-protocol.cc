@@ -52,8 +52,10 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
+#include <unordered_map>
 
 /********** Useful macros **********/
 
@@ -237,6 +239,13 @@ RoutingProtocol::GetTypeId()
                                           "high",
                                           Willingness::ALWAYS,
                                           "always"))
+            .AddAttribute("RoutingTableHoldDown",
+                          "Minimum time between two routing table computations.  The changes "
+                          "of the state within this time are applied by a single computation "
+                          "at its end.  With 0, the table is computed after every change.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&RoutingProtocol::m_routingTableHoldDown),
+                          MakeTimeChecker(Seconds(0)))
             .AddTraceSource("Rx",
                             "Receive OLSR packet.",
                             MakeTraceSourceAccessor(&RoutingProtocol::m_rxPacketTrace),
@@ -255,6 +264,7 @@ RoutingProtocol::GetTypeId()
 RoutingProtocol::RoutingProtocol()
     : m_routingTableAssociation(nullptr),
       m_ipv4(nullptr),
+      m_lastRoutingTableComputation(Time::Min()),
       m_helloTimer(Timer::CANCEL_ON_DESTROY),
       m_tcTimer(Timer::CANCEL_ON_DESTROY),
       m_midTimer(Timer::CANCEL_ON_DESTROY),
@@ -312,6 +322,7 @@ RoutingProtocol::DoDispose()
     }
     m_sendSockets.clear();
     m_table.clear();
+    m_routingTableComputationEvent.Cancel();
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -645,7 +656,7 @@ RoutingProtocol::RecvOlsr(Ptr<Socket> socket)
     }
 
     // After processing all OLSR messages, we must recompute the routing table
-    RoutingTableComputation();
+    ScheduleRoutingTableComputation();
 }
 
 ///
@@ -1020,6 +1031,14 @@ RoutingProtocol::RoutingTableComputation()
     // 2. The new routing entries are added starting with the
     // symmetric neighbors (h=1) as the destination nodes.
     const NeighborSet& neighborSet = m_state.GetNeighbors();
+    const LinkSet& linkSet = m_state.GetLinks();
+    // The main addresses of the neighbors of the links, looked up once
+    std::vector<Ipv4Address> linkMainAddrs;
+    linkMainAddrs.reserve(linkSet.size());
+    for (const auto& link_tuple : linkSet)
+    {
+        linkMainAddrs.push_back(GetMainAddress(link_tuple.neighborIfaceAddr));
+    }
     for (auto it = neighborSet.begin(); it != neighborSet.end(); it++)
     {
         const NeighborTuple& nb_tuple = *it;
@@ -1028,14 +1047,13 @@ RoutingProtocol::RoutingTableComputation()
         {
             bool nb_main_addr = false;
             const LinkTuple* lt = nullptr;
-            const LinkSet& linkSet = m_state.GetLinks();
-            for (auto it2 = linkSet.begin(); it2 != linkSet.end(); it2++)
+            for (std::size_t i = 0; i < linkSet.size(); i++)
             {
-                const LinkTuple& link_tuple = *it2;
+                const LinkTuple& link_tuple = linkSet[i];
                 NS_LOG_DEBUG("Looking at link tuple: "
                              << link_tuple
                              << (link_tuple.time >= Simulator::Now() ? "" : " (expired)"));
-                if ((GetMainAddress(link_tuple.neighborIfaceAddr) == nb_tuple.neighborMainAddr) &&
+                if (linkMainAddrs[i] == nb_tuple.neighborMainAddr &&
                     link_tuple.time >= Simulator::Now())
                 {
                     NS_LOG_LOGIC("Link tuple matches neighbor "
@@ -1054,7 +1072,7 @@ RoutingProtocol::RoutingTableComputation()
                 else
                 {
                     NS_LOG_LOGIC("Link tuple: linkMainAddress= "
-                                 << GetMainAddress(link_tuple.neighborIfaceAddr)
+                                 << linkMainAddrs[i]
                                  << "; neighborMainAddr =  " << nb_tuple.neighborMainAddr
                                  << "; expired=" << int(link_tuple.time < Simulator::Now())
                                  << " => IGNORE");
@@ -1151,58 +1169,75 @@ RoutingProtocol::RoutingTableComputation()
         }
     }
 
-    for (uint32_t h = 2;; h++)
+    // 3.1. For each topology entry in the topology table, if its
+    // T_dest_addr does not correspond to R_dest_addr of any
+    // route entry in the routing table AND its T_last_addr
+    // corresponds to R_dest_addr of a route entry whose R_dist
+    // is equal to h, then a new route entry MUST be recorded in
+    // the routing table (if it does not already exist)
+    //
+    // The topology tuples are indexed by T_last_addr, so that the round h
+    // only looks at the tuples of the destinations added at distance h, in
+    // their order in the topology set.
+    const TopologySet& topology = m_state.GetTopologySet();
+    std::unordered_map<Ipv4Address, std::vector<std::size_t>, Ipv4AddressHash> topologyByLastAddr;
+    for (std::size_t i = 0; i < topology.size(); i++)
+    {
+        topologyByLastAddr[topology[i].lastAddr].push_back(i);
+    }
+    std::vector<Ipv4Address> lastAddrs;
+    for (const auto& [destAddr, entry] : m_table)
+    {
+        if (entry.distance == 2)
+        {
+            lastAddrs.push_back(destAddr);
+        }
+    }
+    for (uint32_t h = 2; !lastAddrs.empty(); h++)
     {
-        bool added = false;
+        std::vector<std::size_t> candidates;
+        for (const auto& lastAddr : lastAddrs)
+        {
+            auto it = topologyByLastAddr.find(lastAddr);
+            if (it != topologyByLastAddr.end())
+            {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        lastAddrs.clear();
 
-        // 3.1. For each topology entry in the topology table, if its
-        // T_dest_addr does not correspond to R_dest_addr of any
-        // route entry in the routing table AND its T_last_addr
-        // corresponds to R_dest_addr of a route entry whose R_dist
-        // is equal to h, then a new route entry MUST be recorded in
-        // the routing table (if it does not already exist)
-        const TopologySet& topology = m_state.GetTopologySet();
-        for (auto it = topology.begin(); it != topology.end(); it++)
+        for (std::size_t i : candidates)
         {
-            const TopologyTuple& topology_tuple = *it;
+            const TopologyTuple& topology_tuple = topology[i];
             NS_LOG_LOGIC("Looking at topology tuple: " << topology_tuple);
 
             RoutingTableEntry destAddrEntry;
             RoutingTableEntry lastAddrEntry;
-            bool have_destAddrEntry = Lookup(topology_tuple.destAddr, destAddrEntry);
-            bool have_lastAddrEntry = Lookup(topology_tuple.lastAddr, lastAddrEntry);
-            if (!have_destAddrEntry && have_lastAddrEntry && lastAddrEntry.distance == h)
-            {
-                NS_LOG_LOGIC("Adding routing table entry based on the topology tuple.");
-                // then a new route entry MUST be recorded in
-                //                the routing table (if it does not already exist) where:
-                //                     R_dest_addr  = T_dest_addr;
-                //                     R_next_addr  = R_next_addr of the recorded
-                //                                    route entry where:
-                //                                    R_dest_addr == T_last_addr
-                //                     R_dist       = h+1; and
-                //                     R_iface_addr = R_iface_addr of the recorded
-                //                                    route entry where:
-                //                                       R_dest_addr == T_last_addr.
-                AddEntry(topology_tuple.destAddr,
-                         lastAddrEntry.nextAddr,
-                         lastAddrEntry.interface,
-                         h + 1);
-                added = true;
-            }
-            else
+            if (Lookup(topology_tuple.destAddr, destAddrEntry))
             {
                 NS_LOG_LOGIC("NOT adding routing table entry based on the topology tuple: "
-                             "have_destAddrEntry="
-                             << have_destAddrEntry << " have_lastAddrEntry=" << have_lastAddrEntry
-                             << " lastAddrEntry.distance=" << (int)lastAddrEntry.distance
-                             << " (h=" << h << ")");
+                             "destination already in the routing table at distance "
+                             << (int)destAddrEntry.distance << " (h=" << h << ")");
+                continue;
             }
-        }
-
-        if (!added)
-        {
-            break;
+            Lookup(topology_tuple.lastAddr, lastAddrEntry);
+            NS_LOG_LOGIC("Adding routing table entry based on the topology tuple.");
+            // then a new route entry MUST be recorded in
+            //                the routing table (if it does not already exist) where:
+            //                     R_dest_addr  = T_dest_addr;
+            //                     R_next_addr  = R_next_addr of the recorded
+            //                                    route entry where:
+            //                                    R_dest_addr == T_last_addr
+            //                     R_dist       = h+1; and
+            //                     R_iface_addr = R_iface_addr of the recorded
+            //                                    route entry where:
+            //                                       R_dest_addr == T_last_addr.
+            AddEntry(topology_tuple.destAddr,
+                     lastAddrEntry.nextAddr,
+                     lastAddrEntry.interface,
+                     h + 1);
+            lastAddrs.push_back(topology_tuple.destAddr);
         }
     }
 
@@ -1315,6 +1350,29 @@ RoutingProtocol::RoutingTableComputation()
     m_routingTableChanged(GetSize());
 }
 
+void
+RoutingProtocol::ScheduleRoutingTableComputation()
+{
+    if (m_routingTableComputationEvent.IsPending())
+    {
+        NS_LOG_LOGIC("Routing table computation already scheduled");
+        return;
+    }
+    Time next = m_lastRoutingTableComputation + m_routingTableHoldDown;
+    if (next <= Simulator::Now())
+    {
+        RoutingTableComputation();
+        m_lastRoutingTableComputation = Simulator::Now();
+    }
+    else
+    {
+        m_routingTableComputationEvent =
+            Simulator::Schedule(next - Simulator::Now(),
+                                &RoutingProtocol::ScheduleRoutingTableComputation,
+                                this);
+    }
+}
+
 void
 RoutingProtocol::ProcessHello(const olsr::MessageHeader& msg,
                               const Ipv4Address& receiverIface,
@@ -2342,7 +2400,7 @@ RoutingProtocol::NeighborLoss(const LinkTuple& tuple)
     m_state.EraseMprSelectorTuples(GetMainAddress(tuple.neighborIfaceAddr));
 
     MprComputation();
-    RoutingTableComputation();
+    ScheduleRoutingTableComputation();
 }
 
 void
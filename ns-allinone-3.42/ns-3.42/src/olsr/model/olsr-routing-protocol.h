@@ -400,6 +400,16 @@ class RoutingProtocol : public Ipv4RoutingProtocol
      */
     void RoutingTableComputation();
 
+    /**
+     * \brief Computes the routing table now, or at the end of the hold-down
+     * time if the last computation is more recent than that.
+     */
+    void ScheduleRoutingTableComputation();
+
+    Time m_routingTableHoldDown;            //!< Minimum time between two table computations.
+    Time m_lastRoutingTableComputation;     //!< Time of the last routing table computation.
+    EventId m_routingTableComputationEvent; //!< Pending routing table computation.
+
   public:
     /**
      * \brief Gets the main address associated with a given interface address.
@@ -27,11 +27,42 @@
 
 #include "olsr-state.h"
 
+#include "ns3/assert.h"
+
+#include <algorithm>
+
 namespace ns3
 {
 namespace olsr
 {
 
+namespace
+{
+/**
+ * Key of a duplicate tuple in the Duplicate Set index.
+ * \param address The duplicate tuple address.
+ * \param sequenceNumber The duplicate tuple sequence number.
+ * \returns The key.
+ */
+uint64_t
+DuplicateKey(const Ipv4Address& address, uint16_t sequenceNumber)
+{
+    return (static_cast<uint64_t>(address.Get()) << 16) | sequenceNumber;
+}
+
+/**
+ * Key of a topology tuple in the Topology Set index.
+ * \param destAddr The destination address of the tuple.
+ * \param lastAddr The last address of the tuple.
+ * \returns The key.
+ */
+uint64_t
+TopologyKey(const Ipv4Address& destAddr, const Ipv4Address& lastAddr)
+{
+    return (static_cast<uint64_t>(destAddr.Get()) << 32) | lastAddr.Get();
+}
+} // namespace
+
 /********** MPR Selector Set Manipulation **********/
 
 MprSelectorTuple*
@@ -279,32 +310,44 @@ OlsrState::GetMprSet() const
 DuplicateTuple*
 OlsrState::FindDuplicateTuple(const Ipv4Address& addr, uint16_t sequenceNumber)
 {
-    for (auto it = m_duplicateSet.begin(); it != m_duplicateSet.end(); it++)
+    auto it = m_duplicateIndex.find(DuplicateKey(addr, sequenceNumber));
+    if (it == m_duplicateIndex.end())
     {
-        if (it->address == addr && it->sequenceNumber == sequenceNumber)
-        {
-            return &(*it);
-        }
+        return nullptr;
     }
-    return nullptr;
+    return &m_duplicateSet[it->second];
 }
 
 void
 OlsrState::EraseDuplicateTuple(const DuplicateTuple& tuple)
 {
-    for (auto it = m_duplicateSet.begin(); it != m_duplicateSet.end(); it++)
+    auto it = m_duplicateIndex.find(DuplicateKey(tuple.address, tuple.sequenceNumber));
+    if (it == m_duplicateIndex.end() || !(m_duplicateSet[it->second] == tuple))
     {
-        if (*it == tuple)
-        {
-            m_duplicateSet.erase(it);
-            break;
-        }
+        return;
     }
+    // The order of the Duplicate Set is not significant: move the last tuple
+    // in place of the erased one
+    std::size_t position = it->second;
+    m_duplicateIndex.erase(it);
+    if (position != m_duplicateSet.size() - 1)
+    {
+        m_duplicateSet[position] = m_duplicateSet.back();
+        const DuplicateTuple& moved = m_duplicateSet[position];
+        m_duplicateIndex[DuplicateKey(moved.address, moved.sequenceNumber)] = position;
+    }
+    m_duplicateSet.pop_back();
 }
 
 void
 OlsrState::InsertDuplicateTuple(const DuplicateTuple& tuple)
 {
+    bool inserted =
+        m_duplicateIndex.emplace(DuplicateKey(tuple.address, tuple.sequenceNumber),
+                                 m_duplicateSet.size())
+            .second;
+    NS_ASSERT_MSG(inserted, "Duplicate tuple " << tuple.address << " " << tuple.sequenceNumber
+                                               << " already in the set");
     m_duplicateSet.push_back(tuple);
 }
 
@@ -365,17 +408,25 @@ OlsrState::InsertLinkTuple(const LinkTuple& tuple)
 
 /********** Topology Set Manipulation **********/
 
+void
+OlsrState::ReindexTopologySet(std::size_t first)
+{
+    for (std::size_t i = first; i < m_topologySet.size(); i++)
+    {
+        const TopologyTuple& tuple = m_topologySet[i];
+        m_topologyIndex[TopologyKey(tuple.destAddr, tuple.lastAddr)] = i;
+    }
+}
+
 TopologyTuple*
 OlsrState::FindTopologyTuple(const Ipv4Address& destAddr, const Ipv4Address& lastAddr)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
+    auto it = m_topologyIndex.find(TopologyKey(destAddr, lastAddr));
+    if (it == m_topologyIndex.end())
     {
-        if (it->destAddr == destAddr && it->lastAddr == lastAddr)
-        {
-            return &(*it);
-        }
+        return nullptr;
     }
-    return nullptr;
+    return &m_topologySet[it->second];
 }
 
 TopologyTuple*
@@ -394,35 +445,49 @@ OlsrState::FindNewerTopologyTuple(const Ipv4Address& lastAddr, uint16_t ansn)
 void
 OlsrState::EraseTopologyTuple(const TopologyTuple& tuple)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end(); it++)
+    auto it = m_topologyIndex.find(TopologyKey(tuple.destAddr, tuple.lastAddr));
+    if (it == m_topologyIndex.end() || !(m_topologySet[it->second] == tuple))
     {
-        if (*it == tuple)
-        {
-            m_topologySet.erase(it);
-            break;
-        }
+        return;
     }
+    // The order of the Topology Set decides between routes of equal length,
+    // so it is kept: the tuples after the erased one move down by one
+    std::size_t position = it->second;
+    m_topologyIndex.erase(it);
+    m_topologySet.erase(m_topologySet.begin() + position);
+    ReindexTopologySet(position);
 }
 
 void
 OlsrState::EraseOlderTopologyTuples(const Ipv4Address& lastAddr, uint16_t ansn)
 {
-    for (auto it = m_topologySet.begin(); it != m_topologySet.end();)
+    auto older = [&lastAddr, ansn](const TopologyTuple& tuple) {
+        return tuple.lastAddr == lastAddr && tuple.sequenceNumber < ansn;
+    };
+    auto first = std::find_if(m_topologySet.begin(), m_topologySet.end(), older);
+    if (first == m_topologySet.end())
     {
-        if (it->lastAddr == lastAddr && it->sequenceNumber < ansn)
-        {
-            it = m_topologySet.erase(it);
-        }
-        else
+        return;
+    }
+    std::size_t position = first - m_topologySet.begin();
+    for (auto it = first; it != m_topologySet.end(); it++)
+    {
+        if (older(*it))
         {
-            it++;
+            m_topologyIndex.erase(TopologyKey(it->destAddr, it->lastAddr));
         }
     }
+    m_topologySet.erase(std::remove_if(first, m_topologySet.end(), older), m_topologySet.end());
+    ReindexTopologySet(position);
 }
 
 void
 OlsrState::InsertTopologyTuple(const TopologyTuple& tuple)
 {
+    bool inserted =
+        m_topologyIndex.emplace(TopologyKey(tuple.destAddr, tuple.lastAddr), m_topologySet.size())
+            .second;
+    NS_ASSERT_MSG(inserted, "Topology tuple " << tuple << " already in the set");
     m_topologySet.push_back(tuple);
 }
 
@@ -24,6 +24,8 @@
 
 #include "olsr-repositories.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 namespace olsr
@@ -50,6 +52,18 @@ class OlsrState
     Associations m_associations;     //!< The node's local Host Network Associations that will be
                                      //!< advertised using HNA messages.
 
+    /// Positions in the Duplicate Set, by address and sequence number.
+    std::unordered_map<uint64_t, std::size_t> m_duplicateIndex;
+    /// Positions in the Topology Set, by destination and last address.
+    std::unordered_map<uint64_t, std::size_t> m_topologyIndex;
+
+    /**
+     * Updates the positions of the topology tuples from a given position
+     * to the end of the Topology Set.
+     * \param first The position of the first tuple to update.
+     */
+    void ReindexTopologySet(std::size_t first);
+
   public:
     OlsrState()
     {
@@ -322,7 +336,8 @@ class OlsrState
      */
     void EraseOlderTopologyTuples(const Ipv4Address& lastAddr, uint16_t ansn);
     /**
-     * Inserts a topology tuple.
+     * Inserts a topology tuple.  There must be no other tuple with the same
+     * destination and last addresses in the set.
      * \param tuple The tuple to insert.
      */
     void InsertTopologyTuple(const TopologyTuple& tuple);
@@ -174,6 +174,104 @@ OlsrMprTestCase::DoRun()
                           "Node 1 must NOT select node 8 as MPR");
 }
 
+/**
+ * \ingroup olsr-test
+ * \ingroup tests
+ *
+ * Testcase for the indexed duplicate and topology sets of OlsrState
+ */
+class OlsrStateIndexTestCase : public TestCase
+{
+  public:
+    OlsrStateIndexTestCase();
+    void DoRun() override;
+};
+
+OlsrStateIndexTestCase::OlsrStateIndexTestCase()
+    : TestCase("Check the OLSR duplicate and topology set lookups")
+{
+}
+
+void
+OlsrStateIndexTestCase::DoRun()
+{
+    OlsrState state;
+
+    DuplicateTuple dup;
+    dup.address = Ipv4Address("10.0.0.1");
+    dup.retransmitted = false;
+    for (uint16_t seq = 0; seq < 10; seq++)
+    {
+        dup.sequenceNumber = seq;
+        state.InsertDuplicateTuple(dup);
+    }
+    dup.sequenceNumber = 3;
+    state.EraseDuplicateTuple(dup);
+    NS_TEST_EXPECT_MSG_EQ(state.FindDuplicateTuple(Ipv4Address("10.0.0.1"), 3),
+                          nullptr,
+                          "Erased duplicate tuple found");
+    for (uint16_t seq = 0; seq < 10; seq++)
+    {
+        if (seq == 3)
+        {
+            continue;
+        }
+        DuplicateTuple* found = state.FindDuplicateTuple(Ipv4Address("10.0.0.1"), seq);
+        NS_TEST_ASSERT_MSG_NE(found, nullptr, "Duplicate tuple " << seq << " not found");
+        NS_TEST_EXPECT_MSG_EQ(found->sequenceNumber, seq, "Wrong duplicate tuple");
+    }
+    NS_TEST_EXPECT_MSG_EQ(state.FindDuplicateTuple(Ipv4Address("10.0.0.2"), 1),
+                          nullptr,
+                          "Unknown duplicate tuple found");
+
+    /*
+     * Topology tuples advertised by 10.0.1.x (ANSN x) for 10.0.2.y, inserted
+     * in an interleaved order
+     */
+    TopologyTuple topology;
+    for (uint32_t y = 1; y <= 3; y++)
+    {
+        for (uint32_t x = 1; x <= 3; x++)
+        {
+            topology.lastAddr = Ipv4Address(0x0a000100 + x);
+            topology.destAddr = Ipv4Address(0x0a000200 + y);
+            topology.sequenceNumber = x;
+            state.InsertTopologyTuple(topology);
+        }
+    }
+    state.EraseOlderTopologyTuples(Ipv4Address("10.0.1.2"), 3);
+    topology.lastAddr = Ipv4Address("10.0.1.1");
+    topology.destAddr = Ipv4Address("10.0.2.2");
+    topology.sequenceNumber = 1;
+    state.EraseTopologyTuple(topology);
+
+    const TopologySet& topologySet = state.GetTopologySet();
+    NS_TEST_ASSERT_MSG_EQ(topologySet.size(), 5, "Wrong number of topology tuples");
+    const char* expected[5][2] = {{"10.0.2.1", "10.0.1.1"},
+                                  {"10.0.2.1", "10.0.1.3"},
+                                  {"10.0.2.2", "10.0.1.3"},
+                                  {"10.0.2.3", "10.0.1.1"},
+                                  {"10.0.2.3", "10.0.1.3"}};
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(topologySet[i].destAddr,
+                              Ipv4Address(expected[i][0]),
+                              "Topology set order changed");
+        NS_TEST_EXPECT_MSG_EQ(topologySet[i].lastAddr,
+                              Ipv4Address(expected[i][1]),
+                              "Topology set order changed");
+        TopologyTuple* found = state.FindTopologyTuple(Ipv4Address(expected[i][0]),
+                                                       Ipv4Address(expected[i][1]));
+        NS_TEST_EXPECT_MSG_EQ(found, &topologySet[i], "Wrong topology tuple found");
+    }
+    NS_TEST_EXPECT_MSG_EQ(state.FindTopologyTuple(Ipv4Address("10.0.2.2"), Ipv4Address("10.0.1.2")),
+                          nullptr,
+                          "Erased topology tuple found");
+    NS_TEST_EXPECT_MSG_NE(state.FindNewerTopologyTuple(Ipv4Address("10.0.1.3"), 2),
+                          nullptr,
+                          "Newer topology tuple not found");
+}
+
 /**
  * \ingroup olsr-test
  * \ingroup tests
@@ -190,6 +288,7 @@ OlsrProtocolTestSuite::OlsrProtocolTestSuite()
     : TestSuite("routing-olsr", Type::UNIT)
 {
     AddTestCase(new OlsrMprTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new OlsrStateIndexTestCase(), TestCase::Duration::QUICK);
 }
 
 static OlsrProtocolTestSuite g_olsrProtocolTestSuite; //!< Static variable for test initialization
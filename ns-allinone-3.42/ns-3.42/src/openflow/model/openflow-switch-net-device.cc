@@ -782,7 +782,7 @@ OpenFlowSwitchNetDevice::OutputPacket(uint32_t packet_uid, int out_port)
         ofi::Port& p = m_ports[out_port];
         if (p.netdev && !(p.config & OFPPC_PORT_DOWN))
         {
-            ofi::SwitchPacketMetadata data = m_packetData.find(packet_uid)->second;
+            const ofi::SwitchPacketMetadata& data = m_packetData.find(packet_uid)->second;
             size_t bufsize = data.buffer->size;
             NS_LOG_INFO("Sending packet " << data.packet->GetUid() << " over port " << out_port);
             if (p.netdev->SendFrom(data.packet->Copy(), data.src, data.dst, data.protocolNumber))
@@ -1056,8 +1056,7 @@ OpenFlowSwitchNetDevice::FlowTableLookup(sw_flow_key key,
 void
 OpenFlowSwitchNetDevice::RunThroughFlowTable(uint32_t packet_uid, int port, bool send_to_controller)
 {
-    ofi::SwitchPacketMetadata data = m_packetData.find(packet_uid)->second;
-    ofpbuf* buffer = data.buffer;
+    ofpbuf* buffer = m_packetData.find(packet_uid)->second.buffer;
 
     sw_flow_key key;
     key.wildcards = 0; // Lookup cannot take wildcards.
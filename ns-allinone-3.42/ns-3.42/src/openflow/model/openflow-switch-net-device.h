@@ -42,8 +42,8 @@
 #include "ns3/udp-header.h"
 #include "ns3/uinteger.h"
 
-#include <map>
 #include <set>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -528,7 +528,7 @@ class OpenFlowSwitchNetDevice : public NetDevice
     uint16_t m_mtu;               ///< Maximum Transmission Unit
 
     /// PacketData type
-    typedef std::map<uint32_t, ofi::SwitchPacketMetadata> PacketData_t;
+    typedef std::unordered_map<uint32_t, ofi::SwitchPacketMetadata> PacketData_t;
     PacketData_t m_packetData; ///< Packet data
 
     /// Switch's port type
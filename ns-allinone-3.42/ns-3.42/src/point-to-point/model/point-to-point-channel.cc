@@ -135,6 +135,12 @@ PointToPointChannel::GetDelay() const
     return m_delay;
 }
 
+Time
+PointToPointChannel::GetMinimumDelay() const
+{
+    return m_delay;
+}
+
 Ptr<PointToPointNetDevice>
 PointToPointChannel::GetSource(uint32_t i) const
 {
@@ -101,6 +101,17 @@ class PointToPointChannel : public Channel
      */
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
+    /**
+     * \brief Get the minimum delay between the two ends of the channel
+     *
+     * The devices on each side of a point-to-point link only interact
+     * through events scheduled after the propagation delay, so this is the
+     * channel delay.
+     *
+     * \returns Time delay
+     */
+    Time GetMinimumDelay() const override;
+
   protected:
     /**
      * \brief Get the delay associated with this channel
@@ -24,12 +24,15 @@
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
+#include "ns3/packet-burst.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -61,6 +64,13 @@ PointToPointNetDevice::GetTypeId()
                           DataRateValue(DataRate("32768b/s")),
                           MakeDataRateAccessor(&PointToPointNetDevice::m_bps),
                           MakeDataRateChecker())
+            .AddAttribute("BackgroundDataRate",
+                          "The part of the data rate taken by traffic that is not simulated "
+                          "packet by packet (e.g., fluid flows). Packets are transmitted at "
+                          "the remaining rate, of at least 1% of DataRate.",
+                          DataRateValue(DataRate(0)),
+                          MakeDataRateAccessor(&PointToPointNetDevice::m_backgroundBps),
+                          MakeDataRateChecker())
             .AddAttribute("ReceiveErrorModel",
                           "The receiver error model used to simulate packet loss",
                           PointerValue(),
@@ -250,6 +260,13 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_phyTxBeginTrace(m_currentPkt);
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    if (m_backgroundBps.GetBitRate() > 0)
+    {
+        // The background traffic takes its share of the link
+        uint64_t background = std::min(m_backgroundBps.GetBitRate(), m_bps.GetBitRate());
+        uint64_t rate = std::max(m_bps.GetBitRate() - background, m_bps.GetBitRate() / 100);
+        txTime = DataRate(rate).CalculateBytesTxTime(p->GetSize());
+    }
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -356,9 +373,13 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
 
         //
         // Trace sinks will expect complete packets, not packets without some of the
-        // headers.
+        // headers.  The copy is only made when there is a sink to see it.
         //
-        Ptr<Packet> originalPacket = packet->Copy();
+        Ptr<Packet> originalPacket;
+        if (!m_macRxTrace.IsEmpty() || !m_macPromiscRxTrace.IsEmpty())
+        {
+            originalPacket = packet->Copy();
+        }
 
         //
         // Strip off the point-to-point protocol header and forward this packet
@@ -559,6 +580,22 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     return false;
 }
 
+bool
+PointToPointNetDevice::SendBurst(Ptr<PacketBurst> burst,
+                                 const Address& dest,
+                                 uint16_t protocolNumber)
+{
+    NS_LOG_FUNCTION(this << burst << dest << protocolNumber);
+
+    bool ret = true;
+    for (auto it = burst->Begin(); it != burst->End(); ++it)
+    {
+        // statically bound, so that the burst costs a single virtual call
+        ret = PointToPointNetDevice::Send(*it, dest, protocolNumber) && ret;
+    }
+    return ret;
+}
+
 bool
 PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& source,
@@ -181,6 +181,7 @@ class PointToPointNetDevice : public NetDevice
     bool IsBridge() const override;
 
     bool Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber) override;
+    bool SendBurst(Ptr<PacketBurst> burst, const Address& dest, uint16_t protocolNumber) override;
     bool SendFrom(Ptr<Packet> packet,
                   const Address& source,
                   const Address& dest,
@@ -288,6 +289,12 @@ class PointToPointNetDevice : public NetDevice
      */
     DataRate m_bps;
 
+    /**
+     * The part of m_bps taken by traffic that is not simulated packet by
+     * packet, which slows down the transmission of the packets.
+     */
+    DataRate m_backgroundBps;
+
     /**
      * The interframe gap that the Net Device uses to throttle packet
      * transmission
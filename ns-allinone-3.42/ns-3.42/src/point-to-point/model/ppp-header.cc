@@ -77,7 +77,7 @@ PppHeader::Print(std::ostream& os) const
 uint32_t
 PppHeader::GetSerializedSize() const
 {
-    return 2;
+    return SERIALIZED_SIZE;
 }
 
 void
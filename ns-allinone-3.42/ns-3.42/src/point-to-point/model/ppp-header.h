@@ -45,7 +45,7 @@ namespace ns3
  * to the packet.  The ns-3 way to do this is via a class that inherits from
  * class Header.
  */
-class PppHeader : public Header
+class PppHeader final : public Header
 {
   public:
     /**
@@ -65,6 +65,9 @@ class PppHeader : public Header
      */
     static TypeId GetTypeId();
 
+    /// The serialized size of the header, in bytes (see HasFixedSerializedSize)
+    static constexpr uint32_t SERIALIZED_SIZE = 2;
+
     /**
      * \brief Get the TypeId of the instance
      *
@@ -19,12 +19,14 @@
 
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/packet-burst.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -139,6 +141,103 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \brief Test class for the PointToPoint burst send path
+ *
+ * It sends a burst of packets from one NetDevice to another and checks that
+ * they are received in order, one transmission time apart.
+ */
+class PointToPointBurstTest : public TestCase
+{
+  public:
+    /**
+     * \brief Create the test
+     */
+    PointToPointBurstTest();
+
+    /**
+     * \brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * \brief Callback function which records the received packet
+     *
+     * \param dev The receiving device.
+     * \param pkt The received packet.
+     * \param mode The protocol mode used.
+     * \param sender The sender address.
+     *
+     * \return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    std::vector<uint32_t> m_rxSizes; //!< sizes of the received packets
+    std::vector<Time> m_rxTimes;     //!< reception times of the received packets
+};
+
+PointToPointBurstTest::PointToPointBurstTest()
+    : TestCase("PointToPoint burst")
+{
+}
+
+bool
+PointToPointBurstTest::RxPacket(Ptr<NetDevice> dev,
+                                Ptr<const Packet> pkt,
+                                uint16_t mode,
+                                const Address& sender)
+{
+    m_rxSizes.push_back(pkt->GetSize());
+    m_rxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+PointToPointBurstTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetDataRate(DataRate("8Mb/s"));
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointBurstTest::RxPacket, this));
+
+    Ptr<PacketBurst> burst = CreateObject<PacketBurst>();
+    for (uint32_t size = 998; size <= 1000; size++)
+    {
+        burst->AddPacket(Create<Packet>(size));
+    }
+    Simulator::Schedule(Seconds(1.0),
+                        [=]() { devA->SendBurst(burst, devA->GetBroadcast(), 0x800); });
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_rxSizes.size(), 3, "All the packets of the burst should be received");
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_rxSizes[i], 998 + i, "Packets should be received in order");
+    }
+    // each packet carries a 2 byte PPP header and takes 1 us per byte at 8 Mb/s
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[0], Seconds(1) + MicroSeconds(1000), "Unexpected rx time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[1], m_rxTimes[0] + MicroSeconds(1001), "Unexpected rx time");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes[2], m_rxTimes[1] + MicroSeconds(1002), "Unexpected rx time");
+
+    Simulator::Destroy();
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -155,6 +254,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointBurstTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -376,7 +376,16 @@ ThreeGppChannelConditionModel::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(
                               &ThreeGppChannelConditionModel::m_linkO2iConditionToAntennaHeight),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("GridCellSize",
+                          "Side (in m) of the square cells of a grid in the horizontal plane. "
+                          "If positive, the channels between nodes located in the same pair of "
+                          "cells share the random value compared with the LOS probability, "
+                          "which makes the LOS condition spatially consistent. If set to 0, "
+                          "a value is drawn for each channel.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&ThreeGppChannelConditionModel::m_gridCellSize),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -399,6 +408,7 @@ void
 ThreeGppChannelConditionModel::DoDispose()
 {
     m_channelConditionMap.clear();
+    m_cellPairDraws.clear();
     m_updatePeriod = Seconds(0.0);
 }
 
@@ -494,8 +504,8 @@ ThreeGppChannelConditionModel::ComputeChannelCondition(Ptr<const MobilityModel>
     double pLos = ComputePlos(a, b);
     double pNlos = ComputePnlos(a, b);
 
-    // draw a random value
-    double pRef = m_uniformVar->GetValue();
+    // draw a random value, or use the one of the grid cells of the nodes
+    double pRef = GetLosDraw(a, b);
 
     NS_LOG_DEBUG("pRef " << pRef << " pLos " << pLos << " pNlos " << pNlos);
 
@@ -574,8 +584,10 @@ ThreeGppChannelConditionModel::GetKey(Ptr<const MobilityModel> a, Ptr<const Mobi
 {
     // use the nodes ids to obtain a unique key for the channel between a and b
     // sort the nodes ids so that the key is reciprocal
-    uint32_t x1 = std::min(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
-    uint32_t x2 = std::max(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
+    uint32_t aId = a->GetObject<Node>()->GetId();
+    uint32_t bId = b->GetObject<Node>()->GetId();
+    uint32_t x1 = std::min(aId, bId);
+    uint32_t x2 = std::max(aId, bId);
 
     // use the cantor function to obtain the key
     uint32_t key = (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
@@ -583,6 +595,43 @@ ThreeGppChannelConditionModel::GetKey(Ptr<const MobilityModel> a, Ptr<const Mobi
     return key;
 }
 
+uint64_t
+ThreeGppChannelConditionModel::GetCellKey(const Vector& position) const
+{
+    auto x = static_cast<int32_t>(std::floor(position.x / m_gridCellSize));
+    auto y = static_cast<int32_t>(std::floor(position.y / m_gridCellSize));
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+double
+ThreeGppChannelConditionModel::GetLosDraw(Ptr<const MobilityModel> a,
+                                          Ptr<const MobilityModel> b) const
+{
+    if (m_gridCellSize <= 0)
+    {
+        return m_uniformVar->GetValue();
+    }
+
+    // the key is reciprocal, like the one of the channel conditions
+    uint64_t aCell = GetCellKey(a->GetPosition());
+    uint64_t bCell = GetCellKey(b->GetPosition());
+    auto key = std::make_pair(std::min(aCell, bCell), std::max(aCell, bCell));
+
+    // the map is used as a cache, hence the const_cast
+    auto& draws = const_cast<ThreeGppChannelConditionModel*>(this)->m_cellPairDraws;
+    auto it = draws.find(key);
+    if (it == draws.end() || (!m_updatePeriod.IsZero() &&
+                              Simulator::Now() - it->second.m_generatedTime > m_updatePeriod))
+    {
+        NS_LOG_DEBUG("draw a new value for the pair of cells");
+        CellPairDraw draw;
+        draw.m_value = m_uniformVar->GetValue();
+        draw.m_generatedTime = Simulator::Now();
+        it = draws.insert_or_assign(key, draw).first;
+    }
+    return it->second.m_value;
+}
+
 std::tuple<double, double>
 ThreeGppChannelConditionModel::GetQuantizedElevationAngle(Ptr<const MobilityModel> a,
                                                           Ptr<const MobilityModel> b)
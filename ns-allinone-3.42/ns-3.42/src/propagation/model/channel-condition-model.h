@@ -569,6 +569,29 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
      */
     static uint32_t GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
 
+    /**
+     * \brief Returns the random value compared with the LOS probability to
+     * determine the condition of the channel between a and b.
+     *
+     * If GridCellSize is zero, a new value is drawn for each channel. Otherwise,
+     * the value is drawn once for each pair of grid cells and shared by all the
+     * channels between nodes located in these cells, so that close nodes see
+     * correlated conditions. The value of a pair of cells is drawn again after
+     * UpdatePeriod, if not zero.
+     *
+     * \param a tx mobility model
+     * \param b rx mobility model
+     * \return a value uniformly distributed in [0, 1]
+     */
+    double GetLosDraw(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
+    /**
+     * \brief Returns the key of the grid cell containing a position
+     * \param position the position
+     * \return cell key
+     */
+    uint64_t GetCellKey(const Vector& position) const;
+
     /**
      * Struct to store the channel condition in the m_channelConditionMap
      */
@@ -582,6 +605,19 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
         m_channelConditionMap; //!< map to store the channel conditions
     Time m_updatePeriod;       //!< the update period for the channel condition
 
+    /**
+     * Struct to store the random value shared by a pair of grid cells
+     */
+    struct CellPairDraw
+    {
+        double m_value;       //!< the value compared with the LOS probability
+        Time m_generatedTime; //!< the time when the value was drawn
+    };
+
+    double m_gridCellSize{0}; //!< side of the grid cells, 0 to draw a value per channel
+    std::map<std::pair<uint64_t, uint64_t>, CellPairDraw>
+        m_cellPairDraws; //!< values shared by the channels between pairs of grid cells
+
     double m_o2iThreshold{
         0}; //!< the threshold for determining what is the ratio of channels with O2I
     double m_o2iLowLossThreshold{0}; //!< the threshold for determining what is the ratio of low -
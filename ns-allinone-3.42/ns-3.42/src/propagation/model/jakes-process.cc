@@ -32,22 +32,6 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("JakesProcess");
 
-/// Represents a single oscillator
-JakesProcess::Oscillator::Oscillator(std::complex<double> amplitude,
-                                     double initialPhase,
-                                     double omega)
-    : m_amplitude(amplitude),
-      m_phase(initialPhase),
-      m_omega(omega)
-{
-}
-
-std::complex<double>
-JakesProcess::Oscillator::GetValueAt(Time at) const
-{
-    return (m_amplitude * std::cos(at.GetSeconds() * m_omega + m_phase));
-}
-
 NS_OBJECT_ENSURE_REGISTERED(JakesProcess);
 
 TypeId
@@ -102,8 +86,12 @@ JakesProcess::ConstructOscillators()
     NS_ASSERT(m_jakes);
     // Initial phase is common for all oscillators:
     double phi = m_jakes->GetUniformRandomVariable()->GetValue();
+    m_phase = phi;
     // Theta is common for all oscillators:
     double theta = m_jakes->GetUniformRandomVariable()->GetValue();
+    m_amplitudeReal.clear();
+    m_amplitudeImag.clear();
+    m_omegas.clear();
     for (unsigned int i = 0; i < m_nOscillators; i++)
     {
         unsigned int n = i + 1;
@@ -118,19 +106,30 @@ JakesProcess::ConstructOscillators()
         std::complex<double> amplitude =
             std::complex<double>(std::cos(psi), std::sin(psi)) * 2.0 / std::sqrt(m_nOscillators);
         /// 3. Construct oscillator:
-        m_oscillators.emplace_back(amplitude, phi, omega);
+        m_amplitudeReal.push_back(amplitude.real());
+        m_amplitudeImag.push_back(amplitude.imag());
+        m_omegas.push_back(omega);
     }
+    m_cos.resize(m_nOscillators);
+    m_sin.resize(m_nOscillators);
+    m_stepCos.resize(m_nOscillators);
+    m_stepSin.resize(m_nOscillators);
+    m_step = Time(0);
+    m_evaluated = false;
 }
 
 JakesProcess::JakesProcess()
-    : m_omegaDopplerMax(0),
+    : m_phase(0),
+      m_step(0),
+      m_nRotations(0),
+      m_evaluated(false),
+      m_omegaDopplerMax(0),
       m_nOscillators(0)
 {
 }
 
 JakesProcess::~JakesProcess()
 {
-    m_oscillators.clear();
 }
 
 void
@@ -140,21 +139,81 @@ JakesProcess::DoDispose()
     m_jakes = nullptr;
 }
 
+void
+JakesProcess::UpdatePhasors(Time t) const
+{
+    const std::size_t n = m_omegas.size();
+    Time delta = t - m_lastTime;
+    if (!m_evaluated || delta.IsStrictlyNegative() || m_nRotations >= MAX_ROTATIONS)
+    {
+        const double seconds = t.GetSeconds();
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double phase = seconds * m_omegas[i] + m_phase;
+            m_cos[i] = std::cos(phase);
+            m_sin[i] = std::sin(phase);
+        }
+        m_nRotations = 0;
+        m_evaluated = true;
+        return;
+    }
+    if (delta != m_step)
+    {
+        const double seconds = delta.GetSeconds();
+        for (std::size_t i = 0; i < n; i++)
+        {
+            m_stepCos[i] = std::cos(seconds * m_omegas[i]);
+            m_stepSin[i] = std::sin(seconds * m_omegas[i]);
+        }
+        m_step = delta;
+    }
+    // e^{j(w (t + dt) + phi)} = e^{j(w t + phi)} e^{j w dt}
+    for (std::size_t i = 0; i < n; i++)
+    {
+        double c = m_cos[i] * m_stepCos[i] - m_sin[i] * m_stepSin[i];
+        double s = m_sin[i] * m_stepCos[i] + m_cos[i] * m_stepSin[i];
+        m_cos[i] = c;
+        m_sin[i] = s;
+    }
+    m_nRotations++;
+}
+
 std::complex<double>
 JakesProcess::GetComplexGain() const
 {
-    std::complex<double> sumAmplitude = std::complex<double>(0, 0);
-    for (unsigned int i = 0; i < m_oscillators.size(); i++)
+    return GetComplexGain(Now());
+}
+
+std::complex<double>
+JakesProcess::GetComplexGain(Time t) const
+{
+    if (m_evaluated && t == m_lastTime)
     {
-        sumAmplitude += m_oscillators[i].GetValueAt(Now());
+        return m_lastGain;
     }
-    return sumAmplitude;
+    UpdatePhasors(t);
+    double real = 0;
+    double imag = 0;
+    for (std::size_t i = 0; i < m_omegas.size(); i++)
+    {
+        real += m_amplitudeReal[i] * m_cos[i];
+        imag += m_amplitudeImag[i] * m_cos[i];
+    }
+    m_lastTime = t;
+    m_lastGain = std::complex<double>(real, imag);
+    return m_lastGain;
 }
 
 double
 JakesProcess::GetChannelGainDb() const
 {
-    std::complex<double> complexGain = GetComplexGain();
+    return GetChannelGainDb(Now());
+}
+
+double
+JakesProcess::GetChannelGainDb(Time t) const
+{
+    std::complex<double> complexGain = GetComplexGain(t);
     return (10 *
             std::log10((std::pow(complexGain.real(), 2) + std::pow(complexGain.imag(), 2)) / 2));
 }
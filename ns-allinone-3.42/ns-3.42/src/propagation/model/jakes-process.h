@@ -24,6 +24,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <complex>
+#include <vector>
 
 namespace ns3
 {
@@ -49,6 +50,15 @@ class JakesPropagationLossModel;
  * statically independent and uniformly distributed over \f$[-\pi, \pi)\f$ for all \f$n\f$.
  *
  *
+ * The oscillators are stored as contiguous arrays. Rather than evaluating
+ * \f$\cos(\omega_n t + \phi)\f$ at each call, the process keeps the phasor
+ * \f$e^{j(\omega_n t + \phi)}\f$ of each oscillator at the last evaluation and
+ * rotates it by \f$e^{j\omega_n \Delta t}\f$, a complex multiplication; the
+ * rotation phasors are computed once per time step, so that a process sampled
+ * at a regular interval evaluates no trigonometric function. The phasors are
+ * recomputed exactly every MAX_ROTATIONS rotations, to bound the rounding
+ * errors.
+ *
  * [1] Y. R. Zheng and C. Xiao, "Simulation Models With Correct
  * Statistical Properties for Rayleigh Fading Channel", IEEE
  * Trans. on Communications, Vol. 51, pp 920-928, June 2003
@@ -75,6 +85,21 @@ class JakesProcess : public Object
      */
     double GetChannelGainDb() const;
 
+    /**
+     * Get the channel complex gain at a given time, not earlier than the
+     * previous evaluations for an incremental evaluation
+     * \param t the time
+     * \return the channel complex gain
+     */
+    std::complex<double> GetComplexGain(Time t) const;
+    /**
+     * Get the channel gain in dB at a given time, e.g., the same time for a
+     * batch of processes
+     * \param t the time
+     * \return the channel gain [dB]
+     */
+    double GetChannelGainDb(Time t) const;
+
     /**
      * Set the propagation model using this class
      * \param model the propagation model using this class
@@ -85,32 +110,9 @@ class JakesProcess : public Object
     void DoDispose() override;
 
   private:
-    /**
-     * This class Represents a single oscillator
-     */
-    struct Oscillator
-    {
-        /**
-         * Initiate oscillator with complex amplitude, initial phase and rotation speed
-         * \param amplitude initial complex amplitude
-         * \param initialPhase initial phase
-         * \param omega rotation speed
-         */
-        Oscillator(std::complex<double> amplitude, double initialPhase, double omega);
-        /**
-         * Get the complex amplitude at a given moment
-         * \param t time instant
-         * \returns the complex amplitude
-         */
-        std::complex<double> GetValueAt(Time t) const;
-
-        std::complex<double>
-            m_amplitude; //!< Complex number \f$Re=\cos(\psi_n), Im = i\sin(\psi_n)]\f$
-        double m_phase;  //!< Phase \f$\phi_n\f$ of the oscillator
-        double m_omega;  //!< Rotation speed of the oscillator \f$\omega_d \cos(\alpha_n)\f$
-    };
+    /// Number of incremental rotations after which the phasors are recomputed exactly
+    static constexpr unsigned int MAX_ROTATIONS = 64;
 
-  private:
     /**
      * Set the number of Oscillators to use
      * @param nOscillators the number of oscillators
@@ -128,8 +130,30 @@ class JakesProcess : public Object
      */
     void ConstructOscillators();
 
+    /**
+     * Set the phasors of the oscillators at the given time
+     * \param t the time
+     */
+    void UpdatePhasors(Time t) const;
+
   private:
-    std::vector<Oscillator> m_oscillators;        //!< Vector of oscillators
+    // Oscillator n has the complex amplitude \f$\frac{2}{\sqrt{M}} e^{j\psi_n}\f$, the common
+    // initial phase \f$\phi\f$ and the rotation speed \f$\omega_d \cos(\alpha_n)\f$
+    std::vector<double> m_amplitudeReal; //!< Real parts of the amplitudes of the oscillators
+    std::vector<double> m_amplitudeImag; //!< Imaginary parts of the amplitudes of the oscillators
+    std::vector<double> m_omegas;        //!< Rotation speeds of the oscillators
+    double m_phase;                      //!< Initial phase of the oscillators
+
+    mutable std::vector<double> m_cos;     //!< \f$\cos(\omega_n t + \phi)\f$ at m_lastTime
+    mutable std::vector<double> m_sin;     //!< \f$\sin(\omega_n t + \phi)\f$ at m_lastTime
+    mutable std::vector<double> m_stepCos; //!< \f$\cos(\omega_n \Delta t)\f$ for m_step
+    mutable std::vector<double> m_stepSin; //!< \f$\sin(\omega_n \Delta t)\f$ for m_step
+    mutable Time m_step;                   //!< Time step of the rotation phasors, 0 if none
+    mutable Time m_lastTime;               //!< Time of the last evaluation
+    mutable std::complex<double> m_lastGain; //!< Complex gain at m_lastTime
+    mutable unsigned int m_nRotations;       //!< Rotations since the phasors were computed exactly
+    mutable bool m_evaluated;                //!< Whether the process has been evaluated
+
     double m_omegaDopplerMax;                     //!< max rotation speed Doppler frequency
     unsigned int m_nOscillators;                  //!< number of oscillators
     Ptr<UniformRandomVariable> m_uniformVariable; //!< random stream
@@ -21,6 +21,7 @@
 
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
 
 namespace ns3
 {
@@ -61,6 +62,25 @@ double
 JakesPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                          Ptr<MobilityModel> a,
                                          Ptr<MobilityModel> b) const
+{
+    return txPowerDbm + GetProcess(a, b)->GetChannelGainDb();
+}
+
+void
+JakesPropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel>>& b,
+                                              std::vector<double>& rxPowerDbm) const
+{
+    // all the processes are evaluated at the same time
+    const Time now = Simulator::Now();
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        rxPowerDbm[i] += GetProcess(a, b[i])->GetChannelGainDb(now);
+    }
+}
+
+Ptr<JakesProcess>
+JakesPropagationLossModel::GetProcess(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
     Ptr<JakesProcess> pathData = m_propagationCache.GetPathData(
         a,
@@ -76,7 +96,7 @@ JakesPropagationLossModel::DoCalcRxPower(double txPowerDbm,
             b,
             0 /**Spectrum model uid is not used in PropagationLossModel*/);
     }
-    return txPowerDbm + pathData->GetChannelGainDb();
+    return pathData;
 }
 
 Ptr<UniformRandomVariable>
@@ -57,6 +57,18 @@ class JakesPropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
+
+    /**
+     * Get the process of a link, created on first use
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \return the Jakes process of the link
+     */
+    Ptr<JakesProcess> GetProcess(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -29,7 +29,9 @@
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -82,6 +84,43 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+void
+PropagationLossModel::CalcRxPowerBatch(double txPowerDbm,
+                                       Ptr<MobilityModel> a,
+                                       const std::vector<Ptr<MobilityModel>>& b,
+                                       std::vector<double>& rxPowerDbm) const
+{
+    rxPowerDbm.assign(b.size(), txPowerDbm);
+    for (const PropagationLossModel* model = this; model; model = PeekPointer(model->m_next))
+    {
+        model->DoCalcRxPowerBatch(a, b, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                         const std::vector<Ptr<MobilityModel>>& b,
+                                         std::vector<double>& rxPowerDbm) const
+{
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        rxPowerDbm[i] = DoCalcRxPower(rxPowerDbm[i], a, b[i]);
+    }
+}
+
+void
+PropagationLossModel::GetDistances(Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel>>& b,
+                                   std::vector<double>& distances)
+{
+    const Vector position = a->GetPosition();
+    distances.resize(b.size());
+    for (std::size_t i = 0; i < b.size(); i++)
+    {
+        distances[i] = CalculateDistance(position, b[i]->GetPosition());
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -283,6 +322,35 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel>>& b,
+                                              std::vector<double>& rxPowerDbm) const
+{
+    std::vector<double> distances;
+    GetDistances(a, b, distances);
+    // same operations and order as DoCalcRxPower, with the constant factors hoisted
+    const double numerator = m_lambda * m_lambda;
+    const double factor = 16 * M_PI * M_PI;
+    for (std::size_t i = 0; i < distances.size(); i++)
+    {
+        double distance = distances[i];
+        if (distance < 3 * m_lambda)
+        {
+            NS_LOG_WARN(
+                "distance not within the far field region => inaccurate propagation loss value");
+        }
+        if (distance <= 0)
+        {
+            rxPowerDbm[i] -= m_minLoss;
+            continue;
+        }
+        double denominator = factor * distance * distance * m_systemLoss;
+        double lossDb = -10 * log10(numerator / denominator);
+        rxPowerDbm[i] -= std::max(lossDb, m_minLoss);
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -560,6 +628,28 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                                    const std::vector<Ptr<MobilityModel>>& b,
+                                                    std::vector<double>& rxPowerDbm) const
+{
+    std::vector<double> distances;
+    GetDistances(a, b, distances);
+    const double factor = 10 * m_exponent;
+    for (std::size_t i = 0; i < distances.size(); i++)
+    {
+        if (distances[i] <= m_referenceDistance)
+        {
+            rxPowerDbm[i] -= m_referenceLoss;
+        }
+        else
+        {
+            double pathLossDb = factor * std::log10(distances[i] / m_referenceDistance);
+            rxPowerDbm[i] += -m_referenceLoss - pathLossDb;
+        }
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -659,6 +749,42 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - pathLossDb;
 }
 
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                                         const std::vector<Ptr<MobilityModel>>& b,
+                                                         std::vector<double>& rxPowerDbm) const
+{
+    std::vector<double> distances;
+    GetDistances(a, b, distances);
+    // losses at the start of the second and third fields, summed as in DoCalcRxPower
+    const double loss1 =
+        m_referenceLoss + 10 * m_exponent0 * std::log10(m_distance1 / m_distance0);
+    const double loss2 = loss1 + 10 * m_exponent1 * std::log10(m_distance2 / m_distance1);
+    for (std::size_t i = 0; i < distances.size(); i++)
+    {
+        double distance = distances[i];
+        NS_ASSERT(distance >= 0);
+        double pathLossDb;
+        if (distance < m_distance0)
+        {
+            pathLossDb = 0;
+        }
+        else if (distance < m_distance1)
+        {
+            pathLossDb = m_referenceLoss + 10 * m_exponent0 * std::log10(distance / m_distance0);
+        }
+        else if (distance < m_distance2)
+        {
+            pathLossDb = loss1 + 10 * m_exponent1 * std::log10(distance / m_distance1);
+        }
+        else
+        {
+            pathLossDb = loss2 + 10 * m_exponent2 * std::log10(distance / m_distance2);
+        }
+        rxPowerDbm[i] -= pathLossDb;
+    }
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -954,6 +1080,22 @@ RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+void
+RangePropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel>>& b,
+                                              std::vector<double>& rxPowerDbm) const
+{
+    std::vector<double> distances;
+    GetDistances(a, b, distances);
+    for (std::size_t i = 0; i < distances.size(); i++)
+    {
+        if (distances[i] > m_range)
+        {
+            rxPowerDbm[i] = -1000;
+        }
+    }
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -962,4 +1104,141 @@ RangePropagationLossModel::DoAssignStreams(int64_t stream)
 
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The deterministic model whose loss between static nodes is cached.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetModel,
+                                              &CachedPropagationLossModel::GetModel),
+                          MakePointerChecker<PropagationLossModel>());
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+    : m_capacity(0)
+{
+    m_courseChange = MakeCallback(&CachedPropagationLossModel::NotifyCourseChange, this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    Clear();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetModel(Ptr<PropagationLossModel> model)
+{
+    Clear();
+    m_model = model;
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel() const
+{
+    return m_model;
+}
+
+void
+CachedPropagationLossModel::Clear()
+{
+    for (const auto& mobility : m_mobility)
+    {
+        mobility->TraceDisconnectWithoutContext("CourseChange", m_courseChange);
+    }
+    m_index.clear();
+    m_mobility.clear();
+    m_loss.clear();
+    m_capacity = 0;
+}
+
+uint32_t
+CachedPropagationLossModel::GetIndex(Ptr<MobilityModel> mobility) const
+{
+    auto it = m_index.find(PeekPointer(mobility));
+    if (it != m_index.end())
+    {
+        return it->second;
+    }
+
+    uint32_t index = m_mobility.size();
+    if (index == m_capacity)
+    {
+        // double the row length, so that the table is copied O(log n) times
+        uint32_t capacity = std::max<uint32_t>(2 * m_capacity, 16);
+        std::vector<double> loss(std::size_t(capacity) * capacity,
+                                 std::numeric_limits<double>::quiet_NaN());
+        for (uint32_t i = 0; i < index; i++)
+        {
+            std::copy_n(m_loss.begin() + std::size_t(i) * m_capacity,
+                        index,
+                        loss.begin() + std::size_t(i) * capacity);
+        }
+        m_loss = std::move(loss);
+        m_capacity = capacity;
+    }
+    m_index[PeekPointer(mobility)] = index;
+    m_mobility.push_back(mobility);
+    mobility->TraceConnectWithoutContext("CourseChange", m_courseChange);
+    return index;
+}
+
+void
+CachedPropagationLossModel::NotifyCourseChange(Ptr<const MobilityModel> mobility) const
+{
+    auto it = m_index.find(PeekPointer(mobility));
+    NS_ASSERT(it != m_index.end());
+    uint32_t k = it->second;
+    for (uint32_t i = 0; i < m_mobility.size(); i++)
+    {
+        m_loss[std::size_t(k) * m_capacity + i] = std::numeric_limits<double>::quiet_NaN();
+        m_loss[std::size_t(i) * m_capacity + k] = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_model, "The model whose loss is cached was not set");
+    const Vector still(0, 0, 0);
+    if (!(a->GetVelocity() == still) || !(b->GetVelocity() == still))
+    {
+        return m_model->CalcRxPower(txPowerDbm, a, b);
+    }
+
+    uint32_t i = GetIndex(a);
+    uint32_t j = GetIndex(b);
+    double& loss = m_loss[std::size_t(i) * m_capacity + j];
+    if (std::isnan(loss))
+    {
+        loss = txPowerDbm - m_model->CalcRxPower(txPowerDbm, a, b);
+    }
+    return txPowerDbm - loss;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+// ------------------------------------------------------------------------- //
+
 } // namespace ns3
@@ -24,10 +24,12 @@
 #ifndef PROPAGATION_LOSS_MODEL_H
 #define PROPAGATION_LOSS_MODEL_H
 
+#include "ns3/callback.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -101,6 +103,25 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns the Rx Power at several receivers of the same transmission, taking
+     * into account all the PropagationLossModel(s) chained to the current one.
+     *
+     * The result is the one of calling CalcRxPower for each receiver in turn,
+     * but each model of the chain handles all the receivers in a single call,
+     * and the common models compute the position of the transmitter and their
+     * constant terms only once.
+     *
+     * \param txPowerDbm current transmission power (in dBm)
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     * \param [out] rxPowerDbm the reception power at each destination (in dBm)
+     */
+    void CalcRxPowerBatch(double txPowerDbm,
+                          Ptr<MobilityModel> a,
+                          const std::vector<Ptr<MobilityModel>>& b,
+                          std::vector<double>& rxPowerDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -126,6 +147,18 @@ class PropagationLossModel : public Object
      */
     virtual int64_t DoAssignStreams(int64_t stream) = 0;
 
+    /**
+     * Compute the distances between a transmitter and several receivers,
+     * as MobilityModel::GetDistanceFrom does.
+     *
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     * \param [out] distances the distance to each destination (in m)
+     */
+    static void GetDistances(Ptr<MobilityModel> a,
+                             const std::vector<Ptr<MobilityModel>>& b,
+                             std::vector<double>& distances);
+
   private:
     /**
      * PropagationLossModel.
@@ -139,6 +172,19 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Apply the loss of this model, without the chained ones, to several
+     * receivers. The default implementation calls DoCalcRxPower for each of them.
+     *
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     * \param [in,out] rxPowerDbm on input, the power entering this model for each
+     * destination; on output, the power after the loss of this model (in dBm)
+     */
+    virtual void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                    const std::vector<Ptr<MobilityModel>>& b,
+                                    std::vector<double>& rxPowerDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -305,6 +351,9 @@ class FriisPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -495,6 +544,9 @@ class LogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -571,6 +623,9 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -800,12 +855,102 @@ class RangePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_range; //!< Maximum Transmission Range (meters)
 };
 
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the propagation loss of another model between static nodes.
+ *
+ * The loss computed by the wrapped model (set with the Model attribute,
+ * including any model chained to it) is stored in a dense table indexed by
+ * the transmitter and the receiver, so that the following packets exchanged
+ * by the same static pair cost a single table read. Rows and columns are
+ * assigned to the mobility models the first time they are seen.
+ *
+ * A node is considered static while its velocity is zero. The entries of a
+ * node are invalidated when its mobility model fires the CourseChange trace,
+ * for example because its position was set, and the pairs including a node
+ * that is moving are always handed to the wrapped model.
+ *
+ * The cached value is the loss in dB, so the wrapped model must be
+ * deterministic and its loss must not depend on the transmission power.
+ * Random models (e.g., NakagamiPropagationLossModel) and power-dependent
+ * ones (e.g., RangePropagationLossModel, FixedRssLossModel) should rather be
+ * chained after this model with SetNext. The table grows with the square of
+ * the number of nodes.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * \brief Set the model whose loss is cached, and clear the cache.
+     * \param model the wrapped model
+     */
+    void SetModel(Ptr<PropagationLossModel> model);
+
+    /**
+     * \return the model whose loss is cached
+     */
+    Ptr<PropagationLossModel> GetModel() const;
+
+    /**
+     * \brief Forget all the cached losses and the mobility models seen so far.
+     */
+    void Clear();
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    void DoDispose() override;
+
+    /**
+     * \brief Get the row and column of a mobility model, assigning them
+     * if this is the first time the model is seen.
+     * \param mobility the mobility model
+     * \return the index of the mobility model in the table
+     */
+    uint32_t GetIndex(Ptr<MobilityModel> mobility) const;
+
+    /**
+     * \brief Invalidate the cached losses of a node which changed course.
+     * \param mobility the mobility model of the node
+     */
+    void NotifyCourseChange(Ptr<const MobilityModel> mobility) const;
+
+    Ptr<PropagationLossModel> m_model; //!< the wrapped model
+    Callback<void, Ptr<const MobilityModel>> m_courseChange; //!< connected to CourseChange
+    mutable std::unordered_map<const MobilityModel*, uint32_t>
+        m_index;                                        //!< table index of each mobility model
+    mutable std::vector<Ptr<MobilityModel>> m_mobility; //!< mobility models, by index
+    mutable std::vector<double> m_loss;                 //!< losses in dB, NaN if not computed
+    mutable uint32_t m_capacity;                        //!< row length of m_loss
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
@@ -0,0 +1,449 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "topology-snapshot.h"
+
+#include "ns3/assert.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TopologySnapshot");
+
+NS_OBJECT_ENSURE_REGISTERED(TopologySnapshot);
+NS_OBJECT_ENSURE_REGISTERED(SnapshotPropagationLossModel);
+
+namespace
+{
+/// Magic string at the start of a snapshot file
+const char SNAPSHOT_MAGIC[8] = {'N', 'S', '3', 'T', 'O', 'P', 'O', '1'};
+/// Size of the magic string and of the two counts
+const size_t SNAPSHOT_HEADER_SIZE = sizeof(SNAPSHOT_MAGIC) + 2 * sizeof(uint32_t);
+
+/**
+ * \param nEndDevices the number of end devices
+ * \param nGateways the number of gateways
+ * \return the size in bytes of a snapshot image
+ */
+size_t
+SnapshotSize(uint32_t nEndDevices, uint32_t nGateways)
+{
+    size_t nDoubles = 3 * size_t(nEndDevices) + 3 * size_t(nGateways) +
+                      size_t(nEndDevices) * size_t(nGateways);
+    return SNAPSHOT_HEADER_SIZE + nDoubles * sizeof(double) + nEndDevices;
+}
+} // namespace
+
+TypeId
+TopologySnapshot::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TopologySnapshot")
+                            .SetParent<Object>()
+                            .SetGroupName("Propagation")
+                            .AddConstructor<TopologySnapshot>();
+    return tid;
+}
+
+TopologySnapshot::TopologySnapshot()
+    : m_mapping(nullptr),
+      m_mappingSize(0),
+      m_nEndDevices(0),
+      m_nGateways(0),
+      m_endDevicePositions(nullptr),
+      m_gatewayPositions(nullptr),
+      m_loss(nullptr),
+      m_mobile(nullptr)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TopologySnapshot::~TopologySnapshot()
+{
+    Release();
+}
+
+void
+TopologySnapshot::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Release();
+    Object::DoDispose();
+}
+
+std::string
+TopologySnapshot::GetFileName(const std::string& directory, const std::string& key)
+{
+    if (directory.empty())
+    {
+        return key + ".topo";
+    }
+    return directory + "/" + key + ".topo";
+}
+
+void
+TopologySnapshot::Release()
+{
+#ifndef __WIN32__
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+    m_nEndDevices = 0;
+    m_nGateways = 0;
+    m_endDevicePositions = nullptr;
+    m_gatewayPositions = nullptr;
+    m_loss = nullptr;
+    m_mobile = nullptr;
+}
+
+bool
+TopologySnapshot::Attach(const uint8_t* data, size_t size)
+{
+    if (size < SNAPSHOT_HEADER_SIZE ||
+        std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+    {
+        return false;
+    }
+    uint32_t nEndDevices;
+    uint32_t nGateways;
+    std::memcpy(&nEndDevices, data + sizeof(SNAPSHOT_MAGIC), sizeof(uint32_t));
+    std::memcpy(&nGateways, data + sizeof(SNAPSHOT_MAGIC) + sizeof(uint32_t), sizeof(uint32_t));
+    if (size != SnapshotSize(nEndDevices, nGateways))
+    {
+        return false;
+    }
+
+    // The header is 16 bytes long, so the float64 arrays are aligned
+    m_nEndDevices = nEndDevices;
+    m_nGateways = nGateways;
+    m_endDevicePositions = reinterpret_cast<const double*>(data + SNAPSHOT_HEADER_SIZE);
+    m_gatewayPositions = m_endDevicePositions + 3 * size_t(nEndDevices);
+    m_loss = m_gatewayPositions + 3 * size_t(nGateways);
+    m_mobile = reinterpret_cast<const uint8_t*>(m_loss + size_t(nEndDevices) * nGateways);
+    return true;
+}
+
+void
+TopologySnapshot::Capture(const NodeContainer& endDevices,
+                          const NodeContainer& gateways,
+                          Ptr<PropagationLossModel> loss)
+{
+    NS_LOG_FUNCTION(this << endDevices.GetN() << gateways.GetN() << loss);
+    NS_ASSERT(loss);
+    Release();
+
+    uint32_t nEndDevices = endDevices.GetN();
+    uint32_t nGateways = gateways.GetN();
+    std::vector<uint8_t> image(SnapshotSize(nEndDevices, nGateways));
+    std::memcpy(image.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    std::memcpy(image.data() + sizeof(SNAPSHOT_MAGIC), &nEndDevices, sizeof(uint32_t));
+    std::memcpy(image.data() + sizeof(SNAPSHOT_MAGIC) + sizeof(uint32_t),
+                &nGateways,
+                sizeof(uint32_t));
+
+    auto edPositions = reinterpret_cast<double*>(image.data() + SNAPSHOT_HEADER_SIZE);
+    double* gwPositions = edPositions + 3 * size_t(nEndDevices);
+    double* losses = gwPositions + 3 * size_t(nGateways);
+    auto mobile = reinterpret_cast<uint8_t*>(losses + size_t(nEndDevices) * nGateways);
+
+    std::vector<Ptr<MobilityModel>> gwMobility(nGateways);
+    for (uint32_t j = 0; j < nGateways; j++)
+    {
+        gwMobility[j] = gateways.Get(j)->GetObject<MobilityModel>();
+        NS_ASSERT_MSG(gwMobility[j], "Gateway " << j << " has no mobility model");
+        Vector position = gwMobility[j]->GetPosition();
+        gwPositions[3 * j] = position.x;
+        gwPositions[3 * j + 1] = position.y;
+        gwPositions[3 * j + 2] = position.z;
+    }
+
+    for (uint32_t i = 0; i < nEndDevices; i++)
+    {
+        Ptr<MobilityModel> mobility = endDevices.Get(i)->GetObject<MobilityModel>();
+        NS_ASSERT_MSG(mobility, "End device " << i << " has no mobility model");
+        Vector position = mobility->GetPosition();
+        edPositions[3 * i] = position.x;
+        edPositions[3 * i + 1] = position.y;
+        edPositions[3 * i + 2] = position.z;
+        mobile[i] = DynamicCast<ConstantPositionMobilityModel>(mobility) ? 0 : 1;
+        for (uint32_t j = 0; j < nGateways; j++)
+        {
+            losses[size_t(i) * nGateways + j] = -loss->CalcRxPower(0.0, mobility, gwMobility[j]);
+        }
+    }
+
+    m_buffer = std::move(image);
+    Attach(m_buffer.data(), m_buffer.size());
+}
+
+bool
+TopologySnapshot::Save(const std::string& filename) const
+{
+    NS_LOG_FUNCTION(this << filename);
+    NS_ASSERT_MSG(m_endDevicePositions || m_nEndDevices == 0, "Nothing to save");
+
+    std::ostringstream tmpName;
+    tmpName << filename << ".tmp";
+#ifndef __WIN32__
+    tmpName << getpid();
+#endif
+    {
+        std::ofstream out(tmpName.str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            NS_LOG_WARN("Can not open " << tmpName.str());
+            return false;
+        }
+        size_t size = SnapshotSize(m_nEndDevices, m_nGateways);
+        const char* image = m_mapping ? static_cast<const char*>(m_mapping)
+                                      : reinterpret_cast<const char*>(m_buffer.data());
+        out.write(image, size);
+        if (!out.good())
+        {
+            NS_LOG_WARN("Error while writing " << tmpName.str());
+            std::remove(tmpName.str().c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpName.str().c_str(), filename.c_str()) != 0)
+    {
+        NS_LOG_WARN("Can not rename " << tmpName.str() << " to " << filename);
+        std::remove(tmpName.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool
+TopologySnapshot::Load(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    Release();
+
+#ifndef __WIN32__
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        NS_LOG_WARN("Can not map " << filename);
+        return false;
+    }
+    m_mapping = mapping;
+    m_mappingSize = size;
+    if (!Attach(static_cast<const uint8_t*>(mapping), size))
+    {
+        NS_LOG_WARN(filename << " is not a valid topology snapshot");
+        Release();
+        return false;
+    }
+#else
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open())
+    {
+        return false;
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (!Attach(m_buffer.data(), m_buffer.size()))
+    {
+        NS_LOG_WARN(filename << " is not a valid topology snapshot");
+        Release();
+        return false;
+    }
+#endif
+    NS_LOG_INFO("Loaded " << m_nEndDevices << " end devices and " << m_nGateways
+                          << " gateways from " << filename);
+    return true;
+}
+
+void
+TopologySnapshot::Apply(const NodeContainer& endDevices, const NodeContainer& gateways) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(endDevices.GetN() == m_nEndDevices && gateways.GetN() == m_nGateways,
+                  "The topology does not match the snapshot");
+    for (uint32_t i = 0; i < m_nEndDevices; i++)
+    {
+        endDevices.Get(i)->GetObject<MobilityModel>()->SetPosition(GetEndDevicePosition(i));
+    }
+    for (uint32_t j = 0; j < m_nGateways; j++)
+    {
+        gateways.Get(j)->GetObject<MobilityModel>()->SetPosition(GetGatewayPosition(j));
+    }
+}
+
+uint32_t
+TopologySnapshot::GetNEndDevices() const
+{
+    return m_nEndDevices;
+}
+
+uint32_t
+TopologySnapshot::GetNGateways() const
+{
+    return m_nGateways;
+}
+
+Vector
+TopologySnapshot::GetEndDevicePosition(uint32_t i) const
+{
+    NS_ASSERT(i < m_nEndDevices);
+    const double* p = m_endDevicePositions + 3 * size_t(i);
+    return Vector(p[0], p[1], p[2]);
+}
+
+Vector
+TopologySnapshot::GetGatewayPosition(uint32_t j) const
+{
+    NS_ASSERT(j < m_nGateways);
+    const double* p = m_gatewayPositions + 3 * size_t(j);
+    return Vector(p[0], p[1], p[2]);
+}
+
+bool
+TopologySnapshot::IsMobile(uint32_t i) const
+{
+    NS_ASSERT(i < m_nEndDevices);
+    return m_mobile[i] != 0;
+}
+
+double
+TopologySnapshot::GetLoss(uint32_t i, uint32_t j) const
+{
+    NS_ASSERT(i < m_nEndDevices && j < m_nGateways);
+    return m_loss[size_t(i) * m_nGateways + j];
+}
+
+// ------------------------------------------------------------------------- //
+
+TypeId
+SnapshotPropagationLossModel::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SnapshotPropagationLossModel")
+                            .SetParent<PropagationLossModel>()
+                            .SetGroupName("Propagation")
+                            .AddConstructor<SnapshotPropagationLossModel>();
+    return tid;
+}
+
+SnapshotPropagationLossModel::SnapshotPropagationLossModel()
+{
+}
+
+SnapshotPropagationLossModel::~SnapshotPropagationLossModel()
+{
+}
+
+void
+SnapshotPropagationLossModel::DoDispose()
+{
+    m_snapshot = nullptr;
+    m_fallback = nullptr;
+    m_endDevices.clear();
+    m_gateways.clear();
+    PropagationLossModel::DoDispose();
+}
+
+void
+SnapshotPropagationLossModel::SetSnapshot(Ptr<TopologySnapshot> snapshot,
+                                          const NodeContainer& endDevices,
+                                          const NodeContainer& gateways)
+{
+    NS_LOG_FUNCTION(this << snapshot);
+    NS_ASSERT_MSG(endDevices.GetN() == snapshot->GetNEndDevices() &&
+                      gateways.GetN() == snapshot->GetNGateways(),
+                  "The topology does not match the snapshot");
+    m_snapshot = snapshot;
+    m_endDevices.clear();
+    m_gateways.clear();
+    for (uint32_t i = 0; i < endDevices.GetN(); i++)
+    {
+        if (!snapshot->IsMobile(i))
+        {
+            m_endDevices[PeekPointer(endDevices.Get(i)->GetObject<MobilityModel>())] = i;
+        }
+    }
+    for (uint32_t j = 0; j < gateways.GetN(); j++)
+    {
+        m_gateways[PeekPointer(gateways.Get(j)->GetObject<MobilityModel>())] = j;
+    }
+}
+
+void
+SnapshotPropagationLossModel::SetFallback(Ptr<PropagationLossModel> fallback)
+{
+    m_fallback = fallback;
+}
+
+double
+SnapshotPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                            Ptr<MobilityModel> a,
+                                            Ptr<MobilityModel> b) const
+{
+    auto ed = m_endDevices.find(PeekPointer(a));
+    auto gw = m_gateways.find(PeekPointer(b));
+    if (ed == m_endDevices.end() || gw == m_gateways.end())
+    {
+        ed = m_endDevices.find(PeekPointer(b));
+        gw = m_gateways.find(PeekPointer(a));
+    }
+    if (ed != m_endDevices.end() && gw != m_gateways.end())
+    {
+        return txPowerDbm - m_snapshot->GetLoss(ed->second, gw->second);
+    }
+    NS_ASSERT_MSG(m_fallback, "No fallback loss model for a pair outside of the snapshot");
+    return m_fallback->CalcRxPower(txPowerDbm, a, b);
+}
+
+int64_t
+SnapshotPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_fallback ? m_fallback->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
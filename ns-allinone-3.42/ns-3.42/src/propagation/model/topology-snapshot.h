@@ -0,0 +1,244 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TOPOLOGY_SNAPSHOT_H
+#define TOPOLOGY_SNAPSHOT_H
+
+#include "propagation-loss-model.h"
+
+#include "ns3/node-container.h"
+#include "ns3/object.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Snapshot of a two-tier topology and of its static link budget.
+ *
+ * A snapshot stores the positions of a set of end devices and gateways,
+ * whether each end device is mobile, and the propagation loss between every
+ * end device and every gateway, computed once with a deterministic
+ * propagation loss model.  It can be saved to a file and memory-mapped back
+ * by later runs, so that runs sharing the same scenario parameters and seed
+ * reuse the same positions and channel realization.
+ *
+ * File layout (values stored in the byte order of the host):
+ *
+ * - the magic string "NS3TOPO1";
+ * - the number of end devices N and of gateways G (uint32 each);
+ * - the end device positions, then the gateway positions (3 float64 each);
+ * - the N x G loss matrix in dB (float64, row-major by end device);
+ * - one uint8 mobility flag per end device.
+ *
+ * The losses of mobile end devices are stored but only meaningful at the
+ * captured position; SnapshotPropagationLossModel ignores them.
+ */
+class TopologySnapshot : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TopologySnapshot();
+    ~TopologySnapshot() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    TopologySnapshot(const TopologySnapshot&) = delete;
+    TopologySnapshot& operator=(const TopologySnapshot&) = delete;
+
+    /**
+     * \param directory the cache directory
+     * \param key a string identifying the scenario parameters and the seed
+     * \return the name of the snapshot file for this key
+     */
+    static std::string GetFileName(const std::string& directory, const std::string& key);
+
+    /**
+     * \brief Capture the current topology.
+     *
+     * All nodes must have a MobilityModel aggregated.  End devices whose
+     * mobility model is not a ConstantPositionMobilityModel are flagged as
+     * mobile.
+     *
+     * \param endDevices the end devices
+     * \param gateways the gateways
+     * \param loss the (deterministic) loss model used for the link budget
+     */
+    void Capture(const NodeContainer& endDevices,
+                 const NodeContainer& gateways,
+                 Ptr<PropagationLossModel> loss);
+
+    /**
+     * \brief Write the snapshot to a file.
+     *
+     * The file is written under a temporary name and then renamed, so that
+     * concurrent runs never read a partial snapshot.
+     *
+     * \param filename the output file
+     * \return true on success
+     */
+    bool Save(const std::string& filename) const;
+
+    /**
+     * \brief Map a snapshot file previously written by Save.
+     * \param filename the input file
+     * \return false if the file does not exist or is not a valid snapshot
+     */
+    bool Load(const std::string& filename);
+
+    /**
+     * \brief Move the nodes to the positions of the snapshot.
+     *
+     * The containers must have the number of end devices and gateways of the
+     * snapshot.
+     *
+     * \param endDevices the end devices
+     * \param gateways the gateways
+     */
+    void Apply(const NodeContainer& endDevices, const NodeContainer& gateways) const;
+
+    /**
+     * \return the number of end devices
+     */
+    uint32_t GetNEndDevices() const;
+
+    /**
+     * \return the number of gateways
+     */
+    uint32_t GetNGateways() const;
+
+    /**
+     * \param i the end device index
+     * \return the position of the end device
+     */
+    Vector GetEndDevicePosition(uint32_t i) const;
+
+    /**
+     * \param j the gateway index
+     * \return the position of the gateway
+     */
+    Vector GetGatewayPosition(uint32_t j) const;
+
+    /**
+     * \param i the end device index
+     * \return true if the end device is mobile
+     */
+    bool IsMobile(uint32_t i) const;
+
+    /**
+     * \param i the end device index
+     * \param j the gateway index
+     * \return the propagation loss in dB between the end device and the gateway
+     */
+    double GetLoss(uint32_t i, uint32_t j) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Point the accessors at a snapshot image.
+     * \param data the image
+     * \param size the size of the image in bytes
+     * \return false if the image is not a valid snapshot
+     */
+    bool Attach(const uint8_t* data, size_t size);
+
+    /// Release the current image
+    void Release();
+
+    std::vector<uint8_t> m_buffer; //!< Image built by Capture or read without mmap
+    void* m_mapping;               //!< Memory-mapped image, if any
+    size_t m_mappingSize;          //!< Size of the mapped image
+    uint32_t m_nEndDevices;        //!< Number of end devices
+    uint32_t m_nGateways;          //!< Number of gateways
+    const double* m_endDevicePositions; //!< 3 coordinates per end device
+    const double* m_gatewayPositions;   //!< 3 coordinates per gateway
+    const double* m_loss;               //!< Loss matrix, row-major by end device
+    const uint8_t* m_mobile;            //!< Mobility flags
+};
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Propagation loss read from a TopologySnapshot.
+ *
+ * Between a static end device and a gateway of the snapshot, in either
+ * direction, the loss is the one stored in the snapshot.  Any other pair
+ * (mobile end devices, pairs of end devices or of gateways, nodes unknown to
+ * the snapshot) is handed to the fallback model.
+ */
+class SnapshotPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SnapshotPropagationLossModel();
+    ~SnapshotPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SnapshotPropagationLossModel(const SnapshotPropagationLossModel&) = delete;
+    SnapshotPropagationLossModel& operator=(const SnapshotPropagationLossModel&) = delete;
+
+    /**
+     * \brief Associate the nodes with the rows and columns of a snapshot.
+     * \param snapshot the snapshot
+     * \param endDevices the end devices, in snapshot order
+     * \param gateways the gateways, in snapshot order
+     */
+    void SetSnapshot(Ptr<TopologySnapshot> snapshot,
+                     const NodeContainer& endDevices,
+                     const NodeContainer& gateways);
+
+    /**
+     * \param fallback the model used for the pairs not covered by the snapshot
+     */
+    void SetFallback(Ptr<PropagationLossModel> fallback);
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    void DoDispose() override;
+
+    Ptr<TopologySnapshot> m_snapshot;        //!< Link budget source
+    Ptr<PropagationLossModel> m_fallback;    //!< Model for the other pairs
+    std::unordered_map<const MobilityModel*, uint32_t> m_endDevices; //!< Static end device rows
+    std::unordered_map<const MobilityModel*, uint32_t> m_gateways;   //!< Gateway columns
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_SNAPSHOT_H
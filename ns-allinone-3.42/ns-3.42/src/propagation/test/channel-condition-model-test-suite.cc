@@ -23,6 +23,7 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/node-container.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
@@ -277,6 +278,101 @@ ThreeGppChannelConditionModelTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * Test case for the GridCellSize attribute of the 3GPP channel condition
+ * models. A set of nodes is placed at the same distance from a base station
+ * and within the same grid cell, so that all the channels have the same LOS
+ * probability. With the grid, all the channels must share the same condition.
+ * Without it, the conditions are drawn independently.
+ */
+class ThreeGppChannelConditionGridTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelConditionGridTestCase();
+
+  private:
+    /**
+     * Builds the simulation scenario and perform the tests
+     */
+    void DoRun() override;
+
+    /**
+     * Counts the LOS channels between a base station and a set of nodes
+     * \param gridCellSize the value of the GridCellSize attribute
+     * \param numNodes the number of nodes
+     * \return the number of LOS channels
+     */
+    uint32_t CountLos(double gridCellSize, uint32_t numNodes);
+};
+
+ThreeGppChannelConditionGridTestCase::ThreeGppChannelConditionGridTestCase()
+    : TestCase("Test case for the spatially consistent 3GPP channel condition")
+{
+}
+
+uint32_t
+ThreeGppChannelConditionGridTestCase::CountLos(double gridCellSize, uint32_t numNodes)
+{
+    NodeContainer nodes;
+    nodes.Create(numNodes + 1);
+
+    Ptr<MobilityModel> bs = CreateObject<ConstantPositionMobilityModel>();
+    bs->SetPosition(Vector(0, 0, 25.0));
+    nodes.Get(0)->AggregateObject(bs);
+
+    Ptr<ThreeGppChannelConditionModel> condModel =
+        CreateObject<ThreeGppUmaChannelConditionModel>();
+    condModel->SetAttribute("GridCellSize", DoubleValue(gridCellSize));
+
+    // place the nodes on an arc of radius 100 m which lies within the grid
+    // cell [50, 100) x [0, 50)
+    uint32_t numLos = 0;
+    for (uint32_t i = 0; i < numNodes; ++i)
+    {
+        double angle = 0.1 + 0.3 * i / numNodes;
+        Ptr<MobilityModel> ue = CreateObject<ConstantPositionMobilityModel>();
+        ue->SetPosition(Vector(100.0 * std::cos(angle), 100.0 * std::sin(angle), 1.5));
+        nodes.Get(i + 1)->AggregateObject(ue);
+
+        Ptr<ChannelCondition> cond = condModel->GetChannelCondition(bs, ue);
+        if (cond->GetLosCondition() == ChannelCondition::LosConditionValue::LOS)
+        {
+            ++numLos;
+        }
+    }
+
+    Simulator::Destroy();
+    return numLos;
+}
+
+void
+ThreeGppChannelConditionGridTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    uint32_t numNodes = 20;
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        uint32_t numLos = CountLos(50.0, numNodes);
+        NS_TEST_EXPECT_MSG_EQ((numLos == 0 || numLos == numNodes),
+                              true,
+                              "Channels within the same pair of cells have different conditions");
+    }
+
+    // the LOS probability is about 0.35, hence all the channels are very
+    // unlikely to have the same condition if drawn independently
+    uint32_t numLos = CountLos(0.0, numNodes);
+    NS_TEST_EXPECT_MSG_EQ((numLos > 0 && numLos < numNodes),
+                          true,
+                          "Channels are expected to have independent conditions");
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -292,6 +388,7 @@ ChannelConditionModelsTestSuite::ChannelConditionModelsTestSuite()
     : TestSuite("propagation-channel-condition-model", Type::UNIT)
 {
     AddTestCase(new ThreeGppChannelConditionModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelConditionGridTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -18,7 +18,9 @@
 #include "ns3/abort.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/jakes-propagation-loss-model.h"
 #include "ns3/log.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
@@ -489,6 +491,238 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CachedPropagationLossModel Test
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(100, 0, 0));
+    Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel>();
+    c->SetPosition(Vector(0, 100, 0));
+    c->SetVelocity(Vector(1, 0, 0));
+
+    Ptr<LogDistancePropagationLossModel> logDistance =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+    cached->SetModel(logDistance);
+
+    double tolerance = 1e-9;
+    double expected = logDistance->CalcRxPower(10, a, b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(10, a, b),
+                              expected,
+                              tolerance,
+                              "Got unexpected rcv power");
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(0, a, b),
+                              expected - 10,
+                              tolerance,
+                              "The cached loss does not depend on the transmission power");
+
+    // the loss of a static pair is not computed again...
+    logDistance->SetAttribute("Exponent", DoubleValue(2.0));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(10, a, b),
+                              expected,
+                              tolerance,
+                              "The loss of a static pair should be cached");
+
+    // ...until one of the nodes changes course
+    b->SetPosition(Vector(200, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(10, b, a),
+                              logDistance->CalcRxPower(10, b, a),
+                              tolerance,
+                              "The loss should be computed again after a course change");
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(10, a, b),
+                              logDistance->CalcRxPower(10, a, b),
+                              tolerance,
+                              "The loss should be computed again after a course change");
+
+    // the pairs including a moving node are never cached
+    cached->CalcRxPower(10, a, c);
+    logDistance->SetAttribute("Exponent", DoubleValue(3.0));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(10, a, c),
+                              logDistance->CalcRxPower(10, a, c),
+                              tolerance,
+                              "The loss to a moving node should not be cached");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief PropagationLossModel::CalcRxPowerBatch Test
+ */
+class PropagationLossModelBatchTestCase : public TestCase
+{
+  public:
+    PropagationLossModelBatchTestCase();
+    ~PropagationLossModelBatchTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+PropagationLossModelBatchTestCase::PropagationLossModelBatchTestCase()
+    : TestCase("Test PropagationLossModel::CalcRxPowerBatch")
+{
+}
+
+PropagationLossModelBatchTestCase::~PropagationLossModelBatchTestCase()
+{
+}
+
+void
+PropagationLossModelBatchTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 1.5));
+    std::vector<Ptr<MobilityModel>> b;
+    for (double x : {0.0, 0.5, 1.0, 150.0, 230.0, 600.0})
+    {
+        b.push_back(CreateObject<ConstantPositionMobilityModel>());
+        b.back()->SetPosition(Vector(x, 0, 1.5));
+    }
+
+    Ptr<PropagationLossModel> chain = CreateObject<FriisPropagationLossModel>();
+    chain->SetNext(CreateObject<RangePropagationLossModel>());
+    Ptr<PropagationLossModel> fading = CreateObject<LogDistancePropagationLossModel>();
+    fading->SetNext(CreateObject<MatrixPropagationLossModel>());
+    DynamicCast<MatrixPropagationLossModel>(fading->GetNext())->SetDefaultLoss(3);
+
+    std::vector<Ptr<PropagationLossModel>> models{
+        CreateObject<FriisPropagationLossModel>(),
+        CreateObject<LogDistancePropagationLossModel>(),
+        CreateObject<ThreeLogDistancePropagationLossModel>(),
+        CreateObject<RangePropagationLossModel>(),
+        chain,
+        fading,
+        CreateObject<JakesPropagationLossModel>(),
+    };
+    for (const auto& model : models)
+    {
+        std::vector<double> rxPowerDbm;
+        model->CalcRxPowerBatch(16, a, b, rxPowerDbm);
+        NS_TEST_ASSERT_MSG_EQ(rxPowerDbm.size(), b.size(), "Wrong number of results");
+        for (std::size_t i = 0; i < b.size(); i++)
+        {
+            // the batch performs the same floating point operations
+            NS_TEST_EXPECT_MSG_EQ(rxPowerDbm[i],
+                                  model->CalcRxPower(16, a, b[i]),
+                                  model->GetInstanceTypeId().GetName() << " receiver " << i);
+        }
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief JakesPropagationLossModel Test: the incremental evaluation of the
+ * processes matches their direct evaluation by a new model with the same stream
+ */
+class JakesPropagationLossModelTestCase : public TestCase
+{
+  public:
+    JakesPropagationLossModelTestCase();
+    ~JakesPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \return a new model with the same random streams as the others
+     */
+    Ptr<PropagationLossModel> CreateModel() const;
+
+    /**
+     * Check the incremental evaluation at the current time
+     */
+    void Check();
+
+    Ptr<PropagationLossModel> m_model; //!< the model evaluated incrementally
+    Ptr<MobilityModel> m_a;            //!< the source
+    Ptr<MobilityModel> m_b;            //!< the destination
+};
+
+JakesPropagationLossModelTestCase::JakesPropagationLossModelTestCase()
+    : TestCase("Test JakesPropagationLossModel incremental evaluation")
+{
+}
+
+JakesPropagationLossModelTestCase::~JakesPropagationLossModelTestCase()
+{
+}
+
+Ptr<PropagationLossModel>
+JakesPropagationLossModelTestCase::CreateModel() const
+{
+    Ptr<PropagationLossModel> model = CreateObject<JakesPropagationLossModel>();
+    model->AssignStreams(7);
+    return model;
+}
+
+void
+JakesPropagationLossModelTestCase::Check()
+{
+    double rxPowerDbm = m_model->CalcRxPower(0, m_a, m_b);
+    // the first evaluation of a process is direct
+    double expectedDbm = CreateModel()->CalcRxPower(0, m_a, m_b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(rxPowerDbm,
+                              expectedDbm,
+                              1e-6,
+                              "incremental evaluation differs at " << Simulator::Now().As(Time::MS));
+}
+
+void
+JakesPropagationLossModelTestCase::DoRun()
+{
+    m_a = CreateObject<ConstantPositionMobilityModel>();
+    m_b = CreateObject<ConstantPositionMobilityModel>();
+    m_b->SetPosition(Vector(10, 0, 0));
+    m_model = CreateModel();
+
+    // a regular sampling, which rotates the phasors by the same step, then irregular steps
+    Time t = MilliSeconds(1);
+    for (int i = 0; i < 300; i++)
+    {
+        Simulator::Schedule(t, &JakesPropagationLossModelTestCase::Check, this);
+        t += MicroSeconds(200);
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        Simulator::Schedule(t, &JakesPropagationLossModelTestCase::Check, this);
+        t += MicroSeconds(100 + 37 * (i % 5));
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    m_model = nullptr;
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -500,6 +734,8 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
+ *   - JakesPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -515,6 +751,9 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PropagationLossModelBatchTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new JakesPropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
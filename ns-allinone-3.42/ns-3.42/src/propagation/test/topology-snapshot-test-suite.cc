@@ -0,0 +1,172 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/test.h"
+#include "ns3/topology-snapshot.h"
+
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TopologySnapshotTest");
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Round trip of a TopologySnapshot through a file, and the loss
+ * returned by SnapshotPropagationLossModel.
+ */
+class TopologySnapshotTestCase : public TestCase
+{
+  public:
+    TopologySnapshotTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TopologySnapshotTestCase::TopologySnapshotTestCase()
+    : TestCase("Save, map back and use a topology snapshot")
+{
+}
+
+void
+TopologySnapshotTestCase::DoRun()
+{
+    NodeContainer endDevices;
+    endDevices.Create(3);
+    NodeContainer gateways;
+    gateways.Create(2);
+
+    const Vector edPositions[] = {Vector(100, 0, 0), Vector(0, 250, 1), Vector(-400, -300, 0)};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(edPositions[i]);
+        endDevices.Get(i)->AggregateObject(mobility);
+    }
+    Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel>();
+    moving->SetPosition(edPositions[2]);
+    moving->SetVelocity(Vector(5, 0, 0));
+    endDevices.Get(2)->AggregateObject(moving);
+
+    const Vector gwPositions[] = {Vector(0, 0, 15), Vector(1000, 0, 15)};
+    for (uint32_t j = 0; j < 2; j++)
+    {
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(gwPositions[j]);
+        gateways.Get(j)->AggregateObject(mobility);
+    }
+
+    Ptr<LogDistancePropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel>();
+    loss->SetPathLossExponent(3.76);
+    loss->SetReference(1, 7.7);
+
+    Ptr<TopologySnapshot> captured = CreateObject<TopologySnapshot>();
+    captured->Capture(endDevices, gateways, loss);
+    NS_TEST_ASSERT_MSG_EQ(captured->GetNEndDevices(), 3, "Wrong number of end devices");
+    NS_TEST_ASSERT_MSG_EQ(captured->GetNGateways(), 2, "Wrong number of gateways");
+
+    std::string filename = CreateTempDirFilename("snapshot.topo");
+    NS_TEST_ASSERT_MSG_EQ(captured->Save(filename), true, "Could not save the snapshot");
+
+    Ptr<TopologySnapshot> snapshot = CreateObject<TopologySnapshot>();
+    NS_TEST_ASSERT_MSG_EQ(snapshot->Load(filename), true, "Could not load the snapshot");
+    NS_TEST_ASSERT_MSG_EQ(snapshot->GetNEndDevices(), 3, "Wrong number of end devices");
+    NS_TEST_ASSERT_MSG_EQ(snapshot->GetNGateways(), 2, "Wrong number of gateways");
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(snapshot->GetEndDevicePosition(i),
+                              edPositions[i],
+                              "Wrong position for end device " << i);
+        NS_TEST_ASSERT_MSG_EQ(snapshot->IsMobile(i), (i == 2), "Wrong mobility flag " << i);
+        for (uint32_t j = 0; j < 2; j++)
+        {
+            Ptr<MobilityModel> ed = endDevices.Get(i)->GetObject<MobilityModel>();
+            Ptr<MobilityModel> gw = gateways.Get(j)->GetObject<MobilityModel>();
+            NS_TEST_ASSERT_MSG_EQ_TOL(snapshot->GetLoss(i, j),
+                                      -loss->CalcRxPower(0.0, ed, gw),
+                                      1e-9,
+                                      "Wrong loss for the pair " << i << "," << j);
+        }
+    }
+    for (uint32_t j = 0; j < 2; j++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(snapshot->GetGatewayPosition(j),
+                              gwPositions[j],
+                              "Wrong position for gateway " << j);
+    }
+
+    // Static pairs come from the snapshot, the others from the fallback
+    Ptr<MatrixPropagationLossModel> fallback = CreateObject<MatrixPropagationLossModel>();
+    fallback->SetDefaultLoss(200.0);
+    Ptr<SnapshotPropagationLossModel> model = CreateObject<SnapshotPropagationLossModel>();
+    model->SetSnapshot(snapshot, endDevices, gateways);
+    model->SetFallback(fallback);
+
+    Ptr<MobilityModel> ed0 = endDevices.Get(0)->GetObject<MobilityModel>();
+    Ptr<MobilityModel> ed1 = endDevices.Get(1)->GetObject<MobilityModel>();
+    Ptr<MobilityModel> gw1 = gateways.Get(1)->GetObject<MobilityModel>();
+    NS_TEST_ASSERT_MSG_EQ_TOL(model->CalcRxPower(14.0, ed0, gw1),
+                              14.0 - snapshot->GetLoss(0, 1),
+                              1e-9,
+                              "Uplink loss not read from the snapshot");
+    NS_TEST_ASSERT_MSG_EQ_TOL(model->CalcRxPower(14.0, gw1, ed0),
+                              14.0 - snapshot->GetLoss(0, 1),
+                              1e-9,
+                              "Downlink loss not read from the snapshot");
+    NS_TEST_ASSERT_MSG_EQ_TOL(model->CalcRxPower(14.0, moving, gw1),
+                              14.0 - 200.0,
+                              1e-9,
+                              "Mobile end device not handed to the fallback");
+    NS_TEST_ASSERT_MSG_EQ_TOL(model->CalcRxPower(14.0, ed0, ed1),
+                              14.0 - 200.0,
+                              1e-9,
+                              "End device pair not handed to the fallback");
+
+    // A truncated file is rejected
+    {
+        std::ofstream truncated(filename, std::ios::binary | std::ios::trunc);
+        truncated << "NS3TOPO1";
+    }
+    NS_TEST_ASSERT_MSG_EQ(snapshot->Load(filename), false, "Truncated snapshot accepted");
+    NS_TEST_ASSERT_MSG_EQ(snapshot->GetNEndDevices(), 0, "Rejected snapshot not released");
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief TopologySnapshot TestSuite
+ */
+class TopologySnapshotTestSuite : public TestSuite
+{
+  public:
+    TopologySnapshotTestSuite();
+};
+
+TopologySnapshotTestSuite::TopologySnapshotTestSuite()
+    : TestSuite("topology-snapshot", Type::UNIT)
+{
+    AddTestCase(new TopologySnapshotTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static TopologySnapshotTestSuite g_topologySnapshotTestSuite;
@@ -2324,8 +2324,8 @@ SixLowPanNetDevice::DoFragmentation(Ptr<Packet> packet,
 {
     NS_LOG_FUNCTION(this << *packet);
 
-    Ptr<Packet> p = packet->Copy();
-
+    // CreateFragment does not alter the original packet, so the fragments are
+    // sliced directly out of its buffer.
     uint16_t offsetData = 0;
     uint16_t offset = 0;
     uint16_t l2Mtu = m_netDevice->GetMtu();
@@ -2350,7 +2350,7 @@ SixLowPanNetDevice::DoFragmentation(Ptr<Packet> packet,
 
     frag1Hdr.SetDatagramSize(origPacketSize);
 
-    Ptr<Packet> fragment1 = p->CreateFragment(offsetData, size);
+    Ptr<Packet> fragment1 = packet->CreateFragment(offsetData, size);
     offset += size + origHdrSize - compressedHeaderSize;
     offsetData += size;
 
@@ -2377,7 +2377,7 @@ SixLowPanNetDevice::DoFragmentation(Ptr<Packet> packet,
         if (size > 0)
         {
             NS_LOG_LOGIC("Fragment creation - " << offset << ", " << offset);
-            Ptr<Packet> fragment = p->CreateFragment(offsetData, size);
+            Ptr<Packet> fragment = packet->CreateFragment(offsetData, size);
             NS_LOG_LOGIC("Fragment created - " << offset << ", " << fragment->GetSize());
 
             offset += size;
@@ -2527,6 +2527,7 @@ SixLowPanNetDevice::Fragments::Fragments()
 {
     NS_LOG_FUNCTION(this);
     m_packetSize = 0;
+    m_receivedSize = 0;
 }
 
 SixLowPanNetDevice::Fragments::~Fragments()
@@ -2559,6 +2560,7 @@ SixLowPanNetDevice::Fragments::AddFragment(Ptr<Packet> fragment, uint16_t fragme
     if (!duplicate)
     {
         m_fragments.insert(it, std::make_pair(fragment, fragmentOffset));
+        m_receivedSize += fragment->GetSize();
     }
 }
 
@@ -2575,6 +2577,12 @@ SixLowPanNetDevice::Fragments::IsEntire() const
 {
     NS_LOG_FUNCTION(this);
 
+    // The fragments can not cover the packet until at least its size has been received
+    if (m_receivedSize < m_packetSize)
+    {
+        return false;
+    }
+
     bool ret = !m_fragments.empty();
     uint16_t lastEndOffset = 0;
 
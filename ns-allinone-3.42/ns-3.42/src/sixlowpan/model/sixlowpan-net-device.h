@@ -535,6 +535,11 @@ class SixLowPanNetDevice : public NetDevice
          */
         uint32_t m_packetSize;
 
+        /**
+         * \brief The total size of the stored fragments (bytes).
+         */
+        uint32_t m_receivedSize;
+
         /**
          * \brief The current fragments.
          */
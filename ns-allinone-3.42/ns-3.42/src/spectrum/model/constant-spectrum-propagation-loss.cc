@@ -84,19 +84,31 @@ ConstantSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     NS_LOG_FUNCTION(this);
 
     Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
-    auto vit = rxPsd->ValuesBegin();
-    auto fit = rxPsd->ConstBandsBegin();
+    DoApplyRxPowerSpectralDensity(rxPsd, params, a, b);
+    return rxPsd;
+}
 
-    while (vit != rxPsd->ValuesEnd())
+void
+ConstantSpectrumPropagationLossModel::DoApplyRxPowerSpectralDensity(
+    Ptr<SpectrumValue> psd,
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this);
+
+    auto vit = psd->ValuesBegin();
+    auto fit = psd->ConstBandsBegin();
+
+    while (vit != psd->ValuesEnd())
     {
-        NS_ASSERT(fit != rxPsd->ConstBandsEnd());
+        NS_ASSERT(fit != psd->ConstBandsEnd());
         NS_LOG_LOGIC("Ptx = " << *vit);
         *vit /= m_lossLinear; // Prx = Ptx / loss
         NS_LOG_LOGIC("Prx = " << *vit);
         ++vit;
         ++fit;
     }
-    return rxPsd;
 }
 
 int64_t
@@ -45,6 +45,19 @@ class ConstantSpectrumPropagationLossModel : public SpectrumPropagationLossModel
     Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParameters> params,
                                                     Ptr<const MobilityModel> a,
                                                     Ptr<const MobilityModel> b) const override;
+
+    /**
+     * Apply the loss to a set of values in place
+     *
+     * @param psd the values to update
+     * @param params the spectrum signal parameters.
+     * @param a sender mobility
+     * @param b receiver mobility
+     */
+    void DoApplyRxPowerSpectralDensity(Ptr<SpectrumValue> psd,
+                                       Ptr<const SpectrumSignalParameters> params,
+                                       Ptr<const MobilityModel> a,
+                                       Ptr<const MobilityModel> b) const override;
     /**
      * Set the propagation loss
      * \param lossDb the propagation loss [dB]
@@ -55,22 +55,32 @@ FriisSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     Ptr<const MobilityModel> b) const
 {
     Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
-    auto vit = rxPsd->ValuesBegin();
-    auto fit = rxPsd->ConstBandsBegin();
+    DoApplyRxPowerSpectralDensity(rxPsd, params, a, b);
+    return rxPsd;
+}
+
+void
+FriisSpectrumPropagationLossModel::DoApplyRxPowerSpectralDensity(
+    Ptr<SpectrumValue> psd,
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b) const
+{
+    auto vit = psd->ValuesBegin();
+    auto fit = psd->ConstBandsBegin();
 
     NS_ASSERT(a);
     NS_ASSERT(b);
 
     double d = a->GetDistanceFrom(b);
 
-    while (vit != rxPsd->ValuesEnd())
+    while (vit != psd->ValuesEnd())
     {
-        NS_ASSERT(fit != rxPsd->ConstBandsEnd());
+        NS_ASSERT(fit != psd->ConstBandsEnd());
         *vit /= CalculateLoss(fit->fc, d); // Prx = Ptx / loss
         ++vit;
         ++fit;
     }
-    return rxPsd;
 }
 
 double
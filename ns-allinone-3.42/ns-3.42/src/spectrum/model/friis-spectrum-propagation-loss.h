@@ -55,6 +55,19 @@ class FriisSpectrumPropagationLossModel : public SpectrumPropagationLossModel
                                                     Ptr<const MobilityModel> a,
                                                     Ptr<const MobilityModel> b) const override;
 
+    /**
+     * Apply the loss to a set of values in place
+     *
+     * @param psd the values to update
+     * @param params the spectrum signal parameters.
+     * @param a sender mobility
+     * @param b receiver mobility
+     */
+    void DoApplyRxPowerSpectralDensity(Ptr<SpectrumValue> psd,
+                                       Ptr<const SpectrumSignalParameters> params,
+                                       Ptr<const MobilityModel> a,
+                                       Ptr<const MobilityModel> b) const override;
+
     /**
      * Return the propagation loss L according to a simplified version of Friis'
      * formula in which antenna gains are unitary
@@ -0,0 +1,205 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include "ns3/assert.h"
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Counters of a LruCache
+ */
+struct LruCacheStats
+{
+    uint64_t hits = 0;      //!< lookups which found an entry
+    uint64_t misses = 0;    //!< lookups which did not find an entry
+    uint64_t evictions = 0; //!< entries removed to stay within the budget
+};
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Map with a byte budget and least-recently-used eviction
+ *
+ * Each entry is inserted together with an estimate of the memory it uses.
+ * When the sum of the estimates exceeds the budget, the entries which were
+ * least recently looked up or inserted are removed, except for the one
+ * just inserted. A budget of zero means that nothing is ever evicted, so
+ * that the cache behaves like a plain map.
+ *
+ * \tparam Key the type of the keys
+ * \tparam Value the type of the values, usually a Ptr
+ */
+template <typename Key, typename Value>
+class LruCache
+{
+  public:
+    /**
+     * Set the budget, evicting entries if needed
+     *
+     * \param bytes the maximum sum of the entry sizes, or 0 for no limit
+     */
+    void SetBudget(uint64_t bytes)
+    {
+        m_budget = bytes;
+        Shrink();
+    }
+
+    /**
+     * \return the budget, in bytes
+     */
+    uint64_t GetBudget() const
+    {
+        return m_budget;
+    }
+
+    /**
+     * Look an entry up, and mark it as the most recently used
+     *
+     * \param key the key
+     * \return a pointer to the value, or nullptr if there is no such entry
+     */
+    Value* Find(const Key& key)
+    {
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+        {
+            m_stats.misses++;
+            return nullptr;
+        }
+        m_stats.hits++;
+        m_order.splice(m_order.end(), m_order, it->second.order);
+        return &it->second.value;
+    }
+
+    /**
+     * Look an entry up without updating the recency or the counters
+     *
+     * \param key the key
+     * \return a pointer to the value, or nullptr if there is no such entry
+     */
+    const Value* Peek(const Key& key) const
+    {
+        auto it = m_entries.find(key);
+        return it == m_entries.end() ? nullptr : &it->second.value;
+    }
+
+    /**
+     * Insert or replace an entry, which becomes the most recently used,
+     * and evict other entries if the budget is exceeded
+     *
+     * \param key the key
+     * \param value the value
+     * \param bytes the estimated size of the entry
+     */
+    void Insert(const Key& key, Value value, uint64_t bytes)
+    {
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            m_bytes -= it->second.bytes;
+            it->second.value = std::move(value);
+            it->second.bytes = bytes;
+            m_order.splice(m_order.end(), m_order, it->second.order);
+        }
+        else
+        {
+            m_order.push_back(key);
+            m_entries.emplace(key, Entry{std::move(value), bytes, std::prev(m_order.end())});
+        }
+        m_bytes += bytes;
+        Shrink();
+    }
+
+    /**
+     * Remove all the entries. The counters are kept.
+     */
+    void Clear()
+    {
+        m_entries.clear();
+        m_order.clear();
+        m_bytes = 0;
+    }
+
+    /**
+     * \return the number of entries
+     */
+    std::size_t GetSize() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * \return the sum of the sizes of the entries, in bytes
+     */
+    uint64_t GetBytes() const
+    {
+        return m_bytes;
+    }
+
+    /**
+     * \return the hit, miss and eviction counters
+     */
+    const LruCacheStats& GetStats() const
+    {
+        return m_stats;
+    }
+
+  private:
+    /// An entry of the cache
+    struct Entry
+    {
+        Value value;                             //!< the value
+        uint64_t bytes;                          //!< the estimated size
+        typename std::list<Key>::iterator order; //!< position in m_order
+    };
+
+    /**
+     * Evict the least recently used entries until the budget is met,
+     * always keeping the most recently used one
+     */
+    void Shrink()
+    {
+        while (m_budget > 0 && m_bytes > m_budget && m_order.size() > 1)
+        {
+            auto it = m_entries.find(m_order.front());
+            NS_ASSERT(it != m_entries.end());
+            m_bytes -= it->second.bytes;
+            m_entries.erase(it);
+            m_order.pop_front();
+            m_stats.evictions++;
+        }
+    }
+
+    std::unordered_map<Key, Entry> m_entries; //!< the entries
+    std::list<Key> m_order;                   //!< keys, from least to most recently used
+    uint64_t m_budget{0};                     //!< the budget in bytes, 0 for no limit
+    uint64_t m_bytes{0};                      //!< the sum of the entry sizes
+    LruCacheStats m_stats;                    //!< the counters
+};
+
+} // namespace ns3
+
+#endif /* LRU_CACHE_H */
@@ -76,7 +76,8 @@ TxSpectrumModelInfo::TxSpectrumModelInfo(Ptr<const SpectrumModel> txSpectrumMode
 }
 
 RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumModel)
-    : m_rxSpectrumModel(rxSpectrumModel)
+    : m_rxSpectrumModel(rxSpectrumModel),
+      m_rxPhyGrid(Create<MobilityGrid<SpectrumPhy>>())
 {
 }
 
@@ -91,6 +92,10 @@ MultiModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
+    for (auto& [uid, rxInfo] : m_rxSpectrumModelInfoMap)
+    {
+        rxInfo.m_rxPhyGrid->Clear();
+    }
     m_rxSpectrumModelInfoMap.clear();
     SpectrumChannel::DoDispose();
 }
@@ -126,6 +131,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         if (phyIt != rxInfoIterator->second.m_rxPhys.end())
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
+            rxInfoIterator->second.m_rxPhyGrid->Remove(phy);
             --m_numDevices;
             break; // there should be at most one entry
         }
@@ -155,6 +161,7 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     // rxInfoIterator points either to the newly inserted element or to the element that
     // prevented insertion. In both cases, add the phy to the element pointed to by rxInfoIterator
     rxInfoIterator->second.m_rxPhys.push_back(phy);
+    rxInfoIterator->second.m_rxPhyGrid->Add(phy);
 
     if (inserted)
     {
@@ -239,6 +246,10 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     auto txMobility = txParams->txPhy->GetMobility();
     auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
     NS_LOG_LOGIC("txSpectrumModelUid " << txSpectrumModelUid);
+    auto txInfoIterator = FindAndEventuallyAddTxSpectrumModel(txParams->psd->GetSpectrumModel());
+    NS_ASSERT(txInfoIterator != m_txSpectrumModelInfoMap.end());
+
+    bool cull = m_maxRange > 0 && txMobility;
 
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
@@ -247,9 +258,41 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        std::vector<Ptr<SpectrumPhy>> inRange;
+        if (cull)
+        {
+            inRange = rxInfoIterator->second.m_rxPhyGrid->GetInRange(txMobility->GetPosition(),
+                                                                     m_maxRange);
+        }
+        const auto& rxPhys = cull ? inRange : rxInfoIterator->second.m_rxPhys;
+        if (rxPhys.empty())
+        {
+            continue;
+        }
+
+        // The PSD is converted to the RX SpectrumModel once per transmission, and
+        // each receiver gets a copy of the converted PSD to apply its losses to
+        Ptr<SpectrumSignalParameters> modelParams = txParams;
+        bool orthogonal = false;
+        if (rxSpectrumModelUid != txSpectrumModelUid)
+        {
+            auto rxConverterIterator =
+                txInfoIterator->second.m_spectrumConverterMap.find(rxSpectrumModelUid);
+            if (rxConverterIterator == txInfoIterator->second.m_spectrumConverterMap.end())
+            {
+                // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+                orthogonal = true;
+            }
+            else
+            {
+                NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
+                             << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
+                modelParams = txParams->Copy();
+                modelParams->psd = rxConverterIterator->second.Convert(txParams->psd);
+            }
+        }
+
+        for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
         {
             NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
@@ -277,9 +320,8 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     continue;
                 }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(txParams->psd);
+                NS_LOG_LOGIC("copying signal parameters " << modelParams);
+                auto rxParams = modelParams->Copy();
                 Time delay{0};
 
                 auto receiverMobility = (*rxPhyIterator)->GetMobility();
@@ -336,6 +378,13 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
+                if (orthogonal)
+                {
+                    // the losses are still computed above, so that the traces and the
+                    // random variables of the models are the same
+                    continue;
+                }
+
                 if (rxNetDevice)
                 {
                     // the receiver has a NetDevice, so we expect that it is attached to a Node
@@ -369,16 +418,8 @@ MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<Spe
     const auto txSpectrumModelUid = params->psd->GetSpectrumModelUid();
     const auto rxSpectrumModelUid = receiver->GetRxSpectrumModel()->GetUid();
 
-    auto txInfoIteratorerator =
-        FindAndEventuallyAddTxSpectrumModel(params->psd->GetSpectrumModel());
-    NS_ASSERT(txInfoIteratorerator != m_txSpectrumModelInfoMap.end());
-
-    NS_LOG_LOGIC("converter map for TX SpectrumModel with Uid " << txInfoIteratorerator->first);
-    NS_LOG_LOGIC(
-        "converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size());
-    NS_LOG_LOGIC("converter map first element: "
-                 << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
-
+    // The PSD has been converted to the RX SpectrumModel in StartTx, unless the
+    // receiver changed its SpectrumModel in the meantime
     Ptr<SpectrumValue> convertedPsd;
     if (txSpectrumModelUid == rxSpectrumModelUid)
     {
@@ -387,6 +428,9 @@ MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<Spe
     }
     else
     {
+        auto txInfoIteratorerator =
+            FindAndEventuallyAddTxSpectrumModel(params->psd->GetSpectrumModel());
+        NS_ASSERT(txInfoIteratorerator != m_txSpectrumModelInfoMap.end());
         NS_LOG_LOGIC("converting txPowerSpectrum SpectrumModelUids "
                      << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
         auto rxConverterIterator =
@@ -402,10 +446,11 @@ MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<Spe
     params->psd = convertedPsd;
     if (m_spectrumPropagationLoss)
     {
-        params->psd =
-            m_spectrumPropagationLoss->CalcRxPowerSpectralDensity(params,
-                                                                  params->txPhy->GetMobility(),
-                                                                  receiver->GetMobility());
+        // params is the copy made for this receiver in StartTx, so the loss
+        // can be applied to its psd directly
+        m_spectrumPropagationLoss->ApplyRxPowerSpectralDensity(params,
+                                                               params->txPhy->GetMobility(),
+                                                               receiver->GetMobility());
     }
     else if (m_phasedArraySpectrumPropagationLoss)
     {
@@ -25,6 +25,7 @@
 #include "spectrum-propagation-loss-model.h"
 #include "spectrum-value.h"
 
+#include <ns3/mobility-grid.h>
 #include <ns3/propagation-delay-model.h>
 
 #include <map>
@@ -79,6 +80,7 @@ class RxSpectrumModelInfo
 
     Ptr<const SpectrumModel> m_rxSpectrumModel; //!< Rx Spectrum model.
     std::vector<Ptr<SpectrumPhy>> m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
+    Ptr<MobilityGrid<SpectrumPhy>> m_rxPhyGrid; //!< Grid over the positions of m_rxPhys.
 };
 
 /**
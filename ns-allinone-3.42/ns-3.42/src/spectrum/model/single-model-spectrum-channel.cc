@@ -47,6 +47,7 @@ NS_LOG_COMPONENT_DEFINE("SingleModelSpectrumChannel");
 NS_OBJECT_ENSURE_REGISTERED(SingleModelSpectrumChannel);
 
 SingleModelSpectrumChannel::SingleModelSpectrumChannel()
+    : m_phyGrid(Create<MobilityGrid<SpectrumPhy>>())
 {
     NS_LOG_FUNCTION(this);
 }
@@ -56,6 +57,7 @@ SingleModelSpectrumChannel::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_phyGrid->Clear();
     m_spectrumModel = nullptr;
     SpectrumChannel::DoDispose();
 }
@@ -79,6 +81,7 @@ SingleModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
     if (it != std::end(m_phyList))
     {
         m_phyList.erase(it);
+        m_phyGrid->Remove(phy);
     }
 }
 
@@ -89,6 +92,7 @@ SingleModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     if (std::find(m_phyList.cbegin(), m_phyList.cend(), phy) == m_phyList.cend())
     {
         m_phyList.push_back(phy);
+        m_phyGrid->Add(phy);
     }
     else
     {
@@ -124,7 +128,15 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    PhyList inRange;
+    bool cull = m_maxRange > 0 && senderMobility;
+    if (cull)
+    {
+        inRange = m_phyGrid->GetInRange(senderMobility->GetPosition(), m_maxRange);
+    }
+    const PhyList& rxPhys = cull ? inRange : m_phyList;
+
+    for (auto rxPhyIterator = rxPhys.begin(); rxPhyIterator != rxPhys.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
         Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
@@ -237,10 +249,11 @@ SingleModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<Sp
     NS_LOG_FUNCTION(this << params);
     if (m_spectrumPropagationLoss)
     {
-        params->psd =
-            m_spectrumPropagationLoss->CalcRxPowerSpectralDensity(params,
-                                                                  params->txPhy->GetMobility(),
-                                                                  receiver->GetMobility());
+        // params is the copy made for this receiver in StartTx, so the loss
+        // can be applied to its psd directly
+        m_spectrumPropagationLoss->ApplyRxPowerSpectralDensity(params,
+                                                               params->txPhy->GetMobility(),
+                                                               receiver->GetMobility());
     }
     receiver->StartRx(params);
 }
@@ -23,6 +23,7 @@
 #include "spectrum-channel.h"
 #include "spectrum-model.h"
 
+#include <ns3/mobility-grid.h>
 #include <ns3/traced-callback.h>
 
 namespace ns3
@@ -74,6 +75,11 @@ class SingleModelSpectrumChannel : public SpectrumChannel
      */
     PhyList m_phyList;
 
+    /**
+     * Grid over the positions of m_phyList, used when MaxRange is set.
+     */
+    Ptr<MobilityGrid<SpectrumPhy>> m_phyGrid;
+
     /**
      * SpectrumModel that this channel instance is supporting.
      */
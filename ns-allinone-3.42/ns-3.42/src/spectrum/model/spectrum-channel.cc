@@ -70,6 +70,19 @@ SpectrumChannel::GetTypeId()
                           DoubleValue(1.0e9),
                           MakeDoubleAccessor(&SpectrumChannel::m_maxLossDb),
                           MakeDoubleChecker<double>())
+            .AddAttribute("MaxRange",
+                          "If strictly positive, the maximum distance in meters between "
+                          "the transmitter and a receiver for transmissions to be passed "
+                          "to the receiving PHY. Receivers farther away are skipped "
+                          "before any loss is computed, and the PathLoss and Gain traces "
+                          "are not fired for them. Receivers are found through a grid "
+                          "over their positions, so that the cost of a transmission "
+                          "depends on the number of receivers in range rather than on "
+                          "the number of receivers attached to the channel. The default "
+                          "value of zero disables this cutoff.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&SpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
 
             .AddAttribute("PropagationLossModel",
                           "A pointer to the propagation loss model attached to this channel.",
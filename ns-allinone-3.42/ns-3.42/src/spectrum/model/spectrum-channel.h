@@ -269,6 +269,14 @@ class SpectrumChannel : public Channel
      */
     double m_maxLossDb;
 
+    /**
+     * Maximum range [m].
+     *
+     * If strictly positive, any device farther than this from the transmitter
+     * is considered out of range and is not visited at all.
+     */
+    double m_maxRange;
+
     /**
      * Single-frequency propagation loss model to be used with this channel.
      */
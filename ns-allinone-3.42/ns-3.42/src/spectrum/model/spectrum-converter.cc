@@ -80,16 +80,20 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
 
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
+    // the CSR structure is validated at construction, hence no bounds checks here
+    const double* from = &*fvvf->ConstValuesBegin();
+    const double* coefficients = m_conversionMatrix.data();
+    const size_t* columns = m_conversionColInd.data();
     auto tvit = tvvf->ValuesBegin();
     size_t i = 0; // Index of conversion coefficient
 
     for (auto convIt = m_conversionRowPtr.begin(); convIt != m_conversionRowPtr.end(); ++convIt)
     {
         double sum = 0;
-        while (i < *convIt)
+        const size_t rowEnd = *convIt;
+        for (; i < rowEnd; i++)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += from[columns[i]] * coefficients[i];
         }
         *tvit = sum;
         ++tvit;
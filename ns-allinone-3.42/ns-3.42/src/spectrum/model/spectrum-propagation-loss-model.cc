@@ -78,6 +78,32 @@ SpectrumPropagationLossModel::CalcRxPowerSpectralDensity(Ptr<const SpectrumSigna
     return rxPsd;
 }
 
+void
+SpectrumPropagationLossModel::ApplyRxPowerSpectralDensity(Ptr<SpectrumSignalParameters> params,
+                                                          Ptr<const MobilityModel> a,
+                                                          Ptr<const MobilityModel> b) const
+{
+    if (m_next)
+    {
+        // a chain goes through CalcRxPowerSpectralDensity, so that both
+        // methods always give the same result
+        params->psd = CalcRxPowerSpectralDensity(params, a, b);
+        return;
+    }
+    DoApplyRxPowerSpectralDensity(params->psd, params, a, b);
+}
+
+void
+SpectrumPropagationLossModel::DoApplyRxPowerSpectralDensity(
+    Ptr<SpectrumValue> psd,
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b) const
+{
+    Ptr<SpectrumValue> rxPsd = DoCalcRxPowerSpectralDensity(params, a, b);
+    psd->SetValues(std::move(rxPsd->GetValues()));
+}
+
 int64_t
 SpectrumPropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -80,6 +80,21 @@ class SpectrumPropagationLossModel : public Object
                                                   Ptr<const MobilityModel> a,
                                                   Ptr<const MobilityModel> b) const;
 
+    /**
+     * Same as CalcRxPowerSpectralDensity, except that the loss is applied to
+     * params->psd itself instead of to a copy. The caller must be the only
+     * user of params->psd, as the spectrum channels are with the per-receiver
+     * copy of the signal parameters.
+     *
+     * @param params the spectrum signal parameters; params->psd is updated to
+     * the received power.
+     * @param a sender mobility
+     * @param b receiver mobility
+     */
+    void ApplyRxPowerSpectralDensity(Ptr<SpectrumSignalParameters> params,
+                                     Ptr<const MobilityModel> a,
+                                     Ptr<const MobilityModel> b) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -120,6 +135,22 @@ class SpectrumPropagationLossModel : public Object
         Ptr<const MobilityModel> a,
         Ptr<const MobilityModel> b) const = 0;
 
+    /**
+     * Apply the loss to a set of values in place.
+     *
+     * The default implementation calls DoCalcRxPowerSpectralDensity and moves
+     * its result into psd; models that can work in place should override it.
+     *
+     * @param psd the values to update, which belong to params
+     * @param params the spectrum signal parameters.
+     * @param a sender mobility
+     * @param b receiver mobility
+     */
+    virtual void DoApplyRxPowerSpectralDensity(Ptr<SpectrumValue> psd,
+                                               Ptr<const SpectrumSignalParameters> params,
+                                               Ptr<const MobilityModel> a,
+                                               Ptr<const MobilityModel> b) const;
+
     Ptr<SpectrumPropagationLossModel> m_next; //!< SpectrumPropagationLossModel chained to this one.
 };
 
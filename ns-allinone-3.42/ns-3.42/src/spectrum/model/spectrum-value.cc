@@ -23,6 +23,8 @@
 #include <ns3/log.h>
 #include <ns3/math.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -101,46 +103,41 @@ SpectrumValue::ConstBandsEnd() const
 void
 SpectrumValue::Add(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
+        v[i] += w[i];
     }
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += s;
-        ++it1;
+        v[i] += s;
     }
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
+        v[i] -= w[i];
     }
 }
 
@@ -153,46 +150,41 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
+        v[i] *= w[i];
     }
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= s;
-        ++it1;
+        v[i] *= s;
     }
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    auto it1 = m_values.begin();
-    auto it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
 
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const double* w = x.m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
+        v[i] /= w[i];
     }
 }
 
@@ -200,24 +192,22 @@ void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= s;
-        ++it1;
+        v[i] /= s;
     }
 }
 
 void
 SpectrumValue::ChangeSign()
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = -(*it1);
-        ++it1;
+        v[i] = -v[i];
     }
 }
 
@@ -257,12 +247,11 @@ void
 SpectrumValue::Pow(double exp)
 {
     NS_LOG_FUNCTION(this << exp);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = std::pow(*it1, exp);
-        ++it1;
+        v[i] = std::pow(v[i], exp);
     }
 }
 
@@ -270,12 +259,11 @@ void
 SpectrumValue::Exp(double base)
 {
     NS_LOG_FUNCTION(this << base);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = std::pow(base, *it1);
-        ++it1;
+        v[i] = std::pow(base, v[i]);
     }
 }
 
@@ -283,12 +271,11 @@ void
 SpectrumValue::Log10()
 {
     NS_LOG_FUNCTION(this);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = std::log10(*it1);
-        ++it1;
+        v[i] = std::log10(v[i]);
     }
 }
 
@@ -296,12 +283,11 @@ void
 SpectrumValue::Log2()
 {
     NS_LOG_FUNCTION(this);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = log2(*it1);
-        ++it1;
+        v[i] = log2(v[i]);
     }
 }
 
@@ -309,12 +295,11 @@ void
 SpectrumValue::Log()
 {
     NS_LOG_FUNCTION(this);
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = std::log(*it1);
-        ++it1;
+        v[i] = std::log(v[i]);
     }
 }
 
@@ -520,6 +505,69 @@ operator/(double lhs, const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator+(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator+(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Add(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator-(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Subtract(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Multiply(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator*(double lhs, SpectrumValue&& rhs)
+{
+    rhs.Multiply(lhs);
+    return std::move(rhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, const SpectrumValue& rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
+SpectrumValue
+operator/(SpectrumValue&& lhs, double rhs)
+{
+    lhs.Divide(rhs);
+    return std::move(lhs);
+}
+
 SpectrumValue
 operator+(const SpectrumValue& rhs)
 {
@@ -534,6 +582,13 @@ operator-(const SpectrumValue& rhs)
     return res;
 }
 
+SpectrumValue
+operator-(SpectrumValue&& rhs)
+{
+    rhs.ChangeSign();
+    return std::move(rhs);
+}
+
 SpectrumValue
 Pow(double lhs, const SpectrumValue& rhs)
 {
@@ -633,13 +688,7 @@ SpectrumValue::operator/=(double rhs)
 SpectrumValue&
 SpectrumValue::operator=(double rhs)
 {
-    auto it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 = rhs;
-        ++it1;
-    }
+    std::fill(m_values.begin(), m_values.end(), rhs);
     return *this;
 }
 
@@ -30,6 +30,7 @@
 #include "ns3/phased-array-model.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 #include <ns3/simulator.h>
 
 #include <algorithm>
@@ -1100,8 +1101,8 @@ ThreeGppChannelModel::DoDispose()
     {
         m_channelConditionModel->Dispose();
     }
-    m_channelMatrixMap.clear();
-    m_channelParamsMap.clear();
+    m_channelMatrixMap.Clear();
+    m_channelParamsMap.Clear();
     m_channelConditionModel = nullptr;
 }
 
@@ -1138,6 +1139,22 @@ ThreeGppChannelModel::GetTypeId()
                           TimeValue(MilliSeconds(0)),
                           MakeTimeAccessor(&ThreeGppChannelModel::m_updatePeriod),
                           MakeTimeChecker())
+            .AddAttribute("ChannelCacheBudget",
+                          "Memory budget, in bytes, of the cache of channel matrices. The least "
+                          "recently used matrices are dropped and generated again when needed. "
+                          "0 means no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::SetChannelCacheBudget,
+                                               &ThreeGppChannelModel::GetChannelCacheBudget),
+                          MakeUintegerChecker<uint64_t>())
+            .AddAttribute("ParamsCacheBudget",
+                          "Memory budget, in bytes, of the cache of channel parameters. The least "
+                          "recently used parameters are dropped and generated again when needed. "
+                          "0 means no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::SetParamsCacheBudget,
+                                               &ThreeGppChannelModel::GetParamsCacheBudget),
+                          MakeUintegerChecker<uint64_t>())
             // attributes for the blockage model
             .AddAttribute("Blockage",
                           "Enable blockage model A (sec 7.6.4.1)",
@@ -1224,6 +1241,92 @@ ThreeGppChannelModel::GetScenario() const
     return m_scenario;
 }
 
+void
+ThreeGppChannelModel::SetChannelCacheBudget(uint64_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    m_channelMatrixMap.SetBudget(bytes);
+}
+
+uint64_t
+ThreeGppChannelModel::GetChannelCacheBudget() const
+{
+    return m_channelMatrixMap.GetBudget();
+}
+
+void
+ThreeGppChannelModel::SetParamsCacheBudget(uint64_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    m_channelParamsMap.SetBudget(bytes);
+}
+
+uint64_t
+ThreeGppChannelModel::GetParamsCacheBudget() const
+{
+    return m_channelParamsMap.GetBudget();
+}
+
+const LruCacheStats&
+ThreeGppChannelModel::GetChannelCacheStats() const
+{
+    return m_channelMatrixMap.GetStats();
+}
+
+const LruCacheStats&
+ThreeGppChannelModel::GetParamsCacheStats() const
+{
+    return m_channelParamsMap.GetStats();
+}
+
+/**
+ * Estimate the memory used by a channel matrix
+ * \param channelMatrix the channel matrix
+ * \return the estimated size in bytes
+ */
+static uint64_t
+EstimateChannelMatrixSize(Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix)
+{
+    return sizeof(MatrixBasedChannelModel::ChannelMatrix) +
+           channelMatrix->m_channel.GetSize() * sizeof(std::complex<double>);
+}
+
+uint64_t
+ThreeGppChannelModel::EstimateParamsSize(Ptr<const ThreeGppChannelParams> params)
+{
+    uint64_t doubles = params->m_delay.size() + params->m_alpha.size() + params->m_D.size() +
+                       params->m_clusterPower.size() + params->m_attenuation_dB.size();
+    for (const auto& v : params->m_angle)
+    {
+        doubles += v.size();
+    }
+    for (const auto& v : params->m_cachedAngleSincos)
+    {
+        doubles += 2 * v.size();
+    }
+    for (const auto* rays : {&params->m_rayAodRadian,
+                             &params->m_rayAoaRadian,
+                             &params->m_rayZodRadian,
+                             &params->m_rayZoaRadian,
+                             &params->m_crossPolarizationPowerRatios,
+                             &params->m_nonSelfBlocking,
+                             &params->m_norRvAngles})
+    {
+        for (const auto& v : *rays)
+        {
+            doubles += v.size();
+        }
+    }
+    for (const auto& cluster : params->m_clusterPhase)
+    {
+        for (const auto& v : cluster)
+        {
+            doubles += v.size();
+        }
+    }
+    return sizeof(ThreeGppChannelParams) + doubles * sizeof(double);
+}
+
 Ptr<const ThreeGppChannelModel::ParamsTable>
 ThreeGppChannelModel::GetThreeGppTable(const Ptr<const MobilityModel> aMob,
                                        const Ptr<const MobilityModel> bMob,
@@ -2502,9 +2605,9 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     Ptr<ChannelMatrix> channelMatrix;
     Ptr<ThreeGppChannelParams> channelParams;
 
-    if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
+    if (auto cachedParams = m_channelParamsMap.Find(channelParamsKey))
     {
-        channelParams = m_channelParamsMap[channelParamsKey];
+        channelParams = *cachedParams;
         // check if it has to be updated
         updateParams = ChannelParamsNeedsUpdate(channelParams, condition);
     }
@@ -2529,14 +2632,16 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
         // Step 10: Draw initial phases
         channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
         // store or replace the channel parameters
-        m_channelParamsMap[channelParamsKey] = channelParams;
+        m_channelParamsMap.Insert(channelParamsKey,
+                                  channelParams,
+                                  EstimateParamsSize(channelParams));
     }
 
-    if (m_channelMatrixMap.find(channelMatrixKey) != m_channelMatrixMap.end())
+    if (auto cachedMatrix = m_channelMatrixMap.Find(channelMatrixKey))
     {
         // channel matrix present in the map
         NS_LOG_DEBUG("channel matrix present in the map");
-        channelMatrix = m_channelMatrixMap[channelMatrixKey];
+        channelMatrix = *cachedMatrix;
         updateMatrix = ChannelMatrixNeedsUpdate(channelParams, channelMatrix);
         updateMatrix |= AntennaSetupChanged(aAntenna, bAntenna, channelMatrix);
     }
@@ -2558,7 +2663,9 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
                                                // antennas at the moment of the channel generation
 
         // store or replace the channel matrix in the channel map
-        m_channelMatrixMap[channelMatrixKey] = channelMatrix;
+        m_channelMatrixMap.Insert(channelMatrixKey,
+                                  channelMatrix,
+                                  EstimateChannelMatrixSize(channelMatrix));
     }
 
     return channelMatrix;
@@ -2573,9 +2680,9 @@ ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const Mobilit
     uint64_t channelParamsKey =
         GetKey(aMob->GetObject<Node>()->GetId(), bMob->GetObject<Node>()->GetId());
 
-    if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
+    if (auto params = m_channelParamsMap.Peek(channelParamsKey))
     {
-        return m_channelParamsMap.find(channelParamsKey)->second;
+        return *params;
     }
     else
     {
@@ -3413,6 +3520,12 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     }
 
+    // The rx (tx) phase term of a ray only depends on the u (s) element, so
+    // for each cluster it is computed once per element rather than once per
+    // element pair
+    Complex2DVector rxPhases(uSize, table3gpp->m_raysPerCluster);
+    Complex2DVector txPhases(sSize, table3gpp->m_raysPerCluster);
+
     // The following for loops computes the channel coefficients
     // Keeps track of how many sub-clusters have been added up to now
     uint8_t numSubClustersAdded = 0;
@@ -3421,10 +3534,38 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         for (size_t uIndex = 0; uIndex < uSize; uIndex++)
         {
             Vector uLoc = uAntenna->GetElementLocation(uIndex);
+            for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+            {
+                // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+                double rxPhaseDiff =
+                    2 * M_PI *
+                    (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
+                     cosZoA[nIndex][mIndex] * uLoc.z);
+                rxPhases(uIndex, mIndex) =
+                    std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
+            }
+        }
+        for (size_t sIndex = 0; sIndex < sSize; sIndex++)
+        {
+            Vector sLoc = sAntenna->GetElementLocation(sIndex);
+            for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+            {
+                double txPhaseDiff =
+                    2 * M_PI *
+                    (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
+                     cosZoD[nIndex][mIndex] * sLoc.z);
+                txPhases(sIndex, mIndex) =
+                    std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+            }
+        }
 
+        for (size_t uIndex = 0; uIndex < uSize; uIndex++)
+        {
             for (size_t sIndex = 0; sIndex < sSize; sIndex++)
             {
-                Vector sLoc = sAntenna->GetElementLocation(sIndex);
+                const Complex2DVector& rayPreComp = raysPreComp[std::make_pair(
+                    sAntenna->GetElemPol(sIndex),
+                    uAntenna->GetElemPol(uIndex))];
                 // Compute the N-2 weakest cluster, assuming 0 slant angle and a
                 // polarization slant angle configured in the array (7.5-22)
                 if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
@@ -3432,23 +3573,10 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     std::complex<double> rays(0, 0);
                     for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
                     {
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
                         // NOTE Doppler is computed in the CalcBeamformingGain function and is
                         // simplified to only account for the center angle of each cluster.
-                        rays += raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                           uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                          mIndex) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        rays += rayPreComp(nIndex, mIndex) * rxPhases(uIndex, mIndex) *
+                                txPhases(sIndex, mIndex);
                     }
                     rays *=
                         sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
@@ -3464,22 +3592,9 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                     {
                         // ZML:Just remind me that the angle offsets for the 3 subclusters were not
                         // generated correctly.
-                        double rxPhaseDiff =
-                            2 * M_PI *
-                            (sinCosA[nIndex][mIndex] * uLoc.x + sinSinA[nIndex][mIndex] * uLoc.y +
-                             cosZoA[nIndex][mIndex] * uLoc.z);
-
-                        double txPhaseDiff =
-                            2 * M_PI *
-                            (sinCosD[nIndex][mIndex] * sLoc.x + sinSinD[nIndex][mIndex] * sLoc.y +
-                             cosZoD[nIndex][mIndex] * sLoc.z);
-
-                        std::complex<double> raySub =
-                            raysPreComp[std::make_pair(sAntenna->GetElemPol(sIndex),
-                                                       uAntenna->GetElemPol(uIndex))](nIndex,
-                                                                                      mIndex) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        std::complex<double> raySub = rayPreComp(nIndex, mIndex) *
+                                                      rxPhases(uIndex, mIndex) *
+                                                      txPhases(sIndex, mIndex);
 
                         switch (mIndex)
                         {
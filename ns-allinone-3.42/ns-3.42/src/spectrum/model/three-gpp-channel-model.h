@@ -21,6 +21,7 @@
 #ifndef THREE_GPP_CHANNEL_H
 #define THREE_GPP_CHANNEL_H
 
+#include "lru-cache.h"
 #include "matrix-based-channel-model.h"
 
 #include "ns3/angles.h"
@@ -102,6 +103,43 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
      */
     std::string GetScenario() const;
 
+    /**
+     * Set the memory budget of the cache of channel matrices. When it is
+     * exceeded, the least recently used matrices are dropped, and a new
+     * realization is generated the next time they are needed.
+     * \param bytes the budget in bytes, 0 for no limit
+     */
+    void SetChannelCacheBudget(uint64_t bytes);
+
+    /**
+     * \return the memory budget of the cache of channel matrices, in bytes
+     */
+    uint64_t GetChannelCacheBudget() const;
+
+    /**
+     * Set the memory budget of the cache of channel parameters. When it is
+     * exceeded, the least recently used parameters are dropped, and new
+     * parameters (and channel matrices) are generated the next time they are
+     * needed.
+     * \param bytes the budget in bytes, 0 for no limit
+     */
+    void SetParamsCacheBudget(uint64_t bytes);
+
+    /**
+     * \return the memory budget of the cache of channel parameters, in bytes
+     */
+    uint64_t GetParamsCacheBudget() const;
+
+    /**
+     * \return the hit, miss and eviction counters of the cache of channel matrices
+     */
+    const LruCacheStats& GetChannelCacheStats() const;
+
+    /**
+     * \return the hit, miss and eviction counters of the cache of channel parameters
+     */
+    const LruCacheStats& GetParamsCacheStats() const;
+
     /**
      * Looks for the channel matrix associated to the aMob and bMob pair in m_channelMatrixMap.
      * If found, it checks if it has to be updated. If not found or if it has to
@@ -205,6 +243,14 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
         uint8_t m_cluster2nd;               //!< index of the second strongest cluster
     };
 
+    /**
+     * Estimate the memory used by a set of channel parameters, counting the
+     * per-cluster and per-ray vectors, to account for it in the cache budget
+     * \param params the channel parameters
+     * \return the estimated size in bytes
+     */
+    static uint64_t EstimateParamsSize(Ptr<const ThreeGppChannelParams> params);
+
     /**
      * Data structure that stores the parameters of 3GPP TR 38.901, Table 7.5-6,
      * for a certain scenario
@@ -364,11 +410,11 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                              Ptr<const PhasedArrayModel> bAntenna,
                              Ptr<const ChannelMatrix> channelMatrix);
 
-    std::unordered_map<uint64_t, Ptr<ChannelMatrix>>
+    LruCache<uint64_t, Ptr<ChannelMatrix>>
         m_channelMatrixMap; //!< map containing the channel realizations per pair of
                             //!< PhasedAntennaArray instances, the key of this map is reciprocal
                             //!< uniquely identifies a pair of PhasedAntennaArrays
-    std::unordered_map<uint64_t, Ptr<ThreeGppChannelParams>>
+    LruCache<uint64_t, Ptr<ThreeGppChannelParams>>
         m_channelParamsMap; //!< map containing the common channel parameters per pair of nodes, the
                             //!< key of this map is reciprocal and uniquely identifies a pair of
                             //!< nodes
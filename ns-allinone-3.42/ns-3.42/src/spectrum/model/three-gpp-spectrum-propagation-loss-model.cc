@@ -31,8 +31,11 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <map>
+#include <valarray>
+#include <vector>
 
 namespace ns3
 {
@@ -41,6 +44,39 @@ NS_LOG_COMPONENT_DEFINE("ThreeGppSpectrumPropagationLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED(ThreeGppSpectrumPropagationLossModel);
 
+/**
+ * Build the matrix that selects and weights the elements of each port of an
+ * antenna array, so that column p, multiplied by a channel matrix, gives the
+ * beamformed contribution of port p. The elements of a port are walked as in
+ * ThreeGppSpectrumPropagationLossModel::CalculateLongTermComponent.
+ *
+ * \param ant the antenna array
+ * \return a matrix with dimensions #elements x #ports
+ */
+static ComplexMatrixArray
+GetPortWeights(Ptr<const PhasedArrayModel> ant)
+{
+    const PhasedArrayModel::ComplexVector& w = ant->GetBeamformingVectorRef();
+    const auto portElems = ant->GetNumElemsPerPort();
+    const auto hElemsPerPort = ant->GetHElemsPerPort();
+    const size_t incVal = ant->GetNumColumns() - hElemsPerPort;
+    ComplexMatrixArray weights(w.GetSize(), ant->GetNumPorts());
+    for (auto portIdx = 0; portIdx < ant->GetNumPorts(); portIdx++)
+    {
+        auto start = ant->ArrayIndexFromPortIndex(portIdx, 0);
+        auto index = start;
+        for (size_t elemIdx = 0; elemIdx < portElems; elemIdx++, index++)
+        {
+            weights(index, portIdx) = w[index - start];
+            if (elemIdx % hElemsPerPort == hElemsPerPort - 1)
+            {
+                index += incVal; // Increment by a factor to reach next column in a port
+            }
+        }
+    }
+    return weights;
+}
+
 ThreeGppSpectrumPropagationLossModel::ThreeGppSpectrumPropagationLossModel()
 {
     NS_LOG_FUNCTION(this);
@@ -54,7 +90,7 @@ ThreeGppSpectrumPropagationLossModel::~ThreeGppSpectrumPropagationLossModel()
 void
 ThreeGppSpectrumPropagationLossModel::DoDispose()
 {
-    m_longTermMap.clear();
+    m_longTermMap.Clear();
     m_channelModel->Dispose();
     m_channelModel = nullptr;
 }
@@ -73,7 +109,16 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId()
                 StringValue("ns3::ThreeGppChannelModel"),
                 MakePointerAccessor(&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                     &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
-                MakePointerChecker<MatrixBasedChannelModel>());
+                MakePointerChecker<MatrixBasedChannelModel>())
+            .AddAttribute(
+                "LongTermCacheBudget",
+                "Memory budget, in bytes, of the cache of long term components. The least "
+                "recently used components are dropped and computed again when needed. "
+                "0 means no limit.",
+                UintegerValue(0),
+                MakeUintegerAccessor(&ThreeGppSpectrumPropagationLossModel::SetLongTermCacheBudget,
+                                     &ThreeGppSpectrumPropagationLossModel::GetLongTermCacheBudget),
+                MakeUintegerChecker<uint64_t>());
     return tid;
 }
 
@@ -89,6 +134,25 @@ ThreeGppSpectrumPropagationLossModel::GetChannelModel() const
     return m_channelModel;
 }
 
+void
+ThreeGppSpectrumPropagationLossModel::SetLongTermCacheBudget(uint64_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    m_longTermMap.SetBudget(bytes);
+}
+
+uint64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheBudget() const
+{
+    return m_longTermMap.GetBudget();
+}
+
+const LruCacheStats&
+ThreeGppSpectrumPropagationLossModel::GetLongTermCacheStats() const
+{
+    return m_longTermMap.GetStats();
+}
+
 double
 ThreeGppSpectrumPropagationLossModel::GetFrequency() const
 {
@@ -137,18 +201,18 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
                                                          sAnt->GetNumPorts(),
                                                          numClusters);
     // Calculate long term uW * Husn * sW, the result is a matrix
-    // with the dimensions #uPorts, #sPorts, #cluster
-    for (auto sPortIdx = 0; sPortIdx < sAnt->GetNumPorts(); sPortIdx++)
-    {
-        for (auto uPortIdx = 0; uPortIdx < uAnt->GetNumPorts(); uPortIdx++)
-        {
-            for (size_t cIndex = 0; cIndex < numClusters; cIndex++)
-            {
-                longTerm->Elem(uPortIdx, sPortIdx, cIndex) =
-                    CalculateLongTermComponent(params, sAnt, uAnt, sPortIdx, uPortIdx, cIndex);
-            }
-        }
-    }
+    // with the dimensions #uPorts, #sPorts, #cluster.
+    // The pages of Husn are contiguous, so that Husn is also a
+    // #uElems x (#sElems * #cluster) matrix and the u side is a single product
+    ComplexMatrixArray uWeights = GetPortWeights(uAnt).Transpose();
+    ComplexMatrixArray channel(uAntNumElems,
+                               sAntNumElems * numClusters,
+                               params->m_channel.GetValues());
+    ComplexMatrixArray uH(uAnt->GetNumPorts(),
+                          sAntNumElems,
+                          numClusters,
+                          (uWeights * channel).GetValues());
+    *longTerm = uH * GetPortWeights(sAnt).MakeNCopies(numClusters);
     return longTerm;
 }
 
@@ -382,46 +446,60 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
         }
     }
 
-    // Compute the product between the doppler and the delay sincos
-    auto delaySincosCopy = channelParams->m_cachedDelaySincos;
-    for (size_t iRb = 0; iRb < inPsd->GetValuesN(); iRb++)
+    // Only the RBs with some power get a channel, the others are left to zero
+    std::vector<size_t> activeRbs;
+    for (size_t iRb = 0; iRb < numRb; iRb++)
+    {
+        if ((*inPsd)[iRb] != 0.00)
+        {
+            activeRbs.push_back(iRb);
+        }
+    }
+    if (activeRbs.empty())
+    {
+        return chanSpct;
+    }
+
+    // Compute the product between the doppler and the delay sincos, as a
+    // #cluster x #activeRbs matrix
+    ComplexMatrixArray delayDoppler(numCluster, activeRbs.size());
+    for (size_t i = 0; i < activeRbs.size(); i++)
     {
         for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
         {
-            delaySincosCopy(iRb, cIndex) *= doppler[cIndex];
+            delayDoppler(cIndex, i) =
+                channelParams->m_cachedDelaySincos(activeRbs[i], cIndex) * doppler[cIndex];
         }
     }
 
     // If "params" (ChannelMatrix) and longTerm were computed for the reverse direction (e.g. this
     // is a DL transmission but params and longTerm were last updated during UL), then the elements
     // in longTerm start from different offsets.
+    NS_ASSERT(directionalLongTerm.GetNumRows() == numRxPorts);
+    NS_ASSERT(directionalLongTerm.GetNumCols() == numTxPorts);
+    const size_t numPortPairs = numRxPorts * numTxPorts;
+
+    // The long term seen as a (#rxPorts * #txPorts) x #cluster matrix, which
+    // has the same memory layout as the 3D array. The product with the
+    // delay/doppler terms gives the sub-band gains of all the port pairs and RBs
+    ComplexMatrixArray longTermPerPair(
+        numPortPairs,
+        numCluster,
+        std::valarray<std::complex<double>>(
+            directionalLongTerm.GetValues()[std::slice(0, numPortPairs * numCluster, 1)]));
+    ComplexMatrixArray subbandGains = longTermPerPair * delayDoppler;
 
-    auto vit = inPsd->ValuesBegin(); // psd iterator
-    size_t iRb = 0;
     // Compute the frequency-domain channel matrix
-    while (vit != inPsd->ValuesEnd())
+    for (size_t i = 0; i < activeRbs.size(); i++)
     {
-        if ((*vit) != 0.00)
+        auto sqrtVit = sqrt((*inPsd)[activeRbs[i]]);
+        for (size_t pair = 0; pair < numPortPairs; pair++)
         {
-            auto sqrtVit = sqrt(*vit);
-            for (auto rxPortIdx = 0; rxPortIdx < numRxPorts; rxPortIdx++)
-            {
-                for (auto txPortIdx = 0; txPortIdx < numTxPorts; txPortIdx++)
-                {
-                    std::complex<double> subsbandGain(0.0, 0.0);
-                    for (size_t cIndex = 0; cIndex < numCluster; cIndex++)
-                    {
-                        subsbandGain += directionalLongTerm(rxPortIdx, txPortIdx, cIndex) *
-                                        delaySincosCopy(iRb, cIndex);
-                    }
-                    // Multiply with the square root of the input PSD so that the norm (absolute
-                    // value squared) of chanSpct will be the output PSD
-                    chanSpct->Elem(rxPortIdx, txPortIdx, iRb) = sqrtVit * subsbandGain;
-                }
-            }
+            // Multiply with the square root of the input PSD so that the norm (absolute
+            // value squared) of chanSpct will be the output PSD
+            chanSpct->Elem(pair % numRxPorts, pair / numRxPorts, activeRbs[i]) =
+                sqrtVit * subbandGains(pair, i);
         }
-        vit++;
-        iRb++;
     }
     return chanSpct;
 }
@@ -463,17 +541,16 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm(
         MatrixBasedChannelModel::GetKey(aPhasedArrayModel->GetId(), bPhasedArrayModel->GetId());
 
     // look for the long term in the map and check if it is valid
-    if (m_longTermMap.find(longTermId) != m_longTermMap.end())
+    if (auto cached = m_longTermMap.Find(longTermId))
     {
         NS_LOG_DEBUG("found the long term component in the map");
-        longTerm = m_longTermMap[longTermId]->m_longTerm;
+        longTerm = (*cached)->m_longTerm;
 
         // check if the channel matrix has been updated
         // or the s beam has been changed
         // or the u beam has been changed
-        update = (m_longTermMap[longTermId]->m_channel->m_generatedTime !=
-                      channelMatrix->m_generatedTime ||
-                  m_longTermMap[longTermId]->m_sW != sW || m_longTermMap[longTermId]->m_uW != uW);
+        update = ((*cached)->m_channel->m_generatedTime != channelMatrix->m_generatedTime ||
+                  (*cached)->m_sW != sW || (*cached)->m_uW != uW);
     }
     else
     {
@@ -491,10 +568,15 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm(
         longTermItem->m_channel = channelMatrix;
         longTermItem->m_sW = std::move(sW);
         longTermItem->m_uW = std::move(uW);
+        // the channel matrix is accounted for by the channel model cache
+        uint64_t bytes = sizeof(LongTerm) +
+                         (longTerm->GetSize() + longTermItem->m_sW.GetSize() +
+                          longTermItem->m_uW.GetSize()) *
+                             sizeof(std::complex<double>);
         // store the long term to reduce computation load
         // only the small scale fading needs to be updated if the large scale parameters and antenna
         // weights remain unchanged.
-        m_longTermMap[longTermId] = longTermItem;
+        m_longTermMap.Insert(longTermId, longTermItem, bytes);
     }
 
     return longTerm;
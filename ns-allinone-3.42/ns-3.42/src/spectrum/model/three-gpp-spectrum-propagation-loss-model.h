@@ -21,6 +21,7 @@
 #ifndef THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
 #define THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
 
+#include "lru-cache.h"
 #include "matrix-based-channel-model.h"
 #include "phased-array-spectrum-propagation-loss-model.h"
 
@@ -104,6 +105,24 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
      */
     void GetChannelModelAttribute(const std::string& name, AttributeValue& value) const;
 
+    /**
+     * Set the memory budget of the cache of long term components. When it is
+     * exceeded, the least recently used components are dropped, and computed
+     * again the next time they are needed.
+     * \param bytes the budget in bytes, 0 for no limit
+     */
+    void SetLongTermCacheBudget(uint64_t bytes);
+
+    /**
+     * \return the memory budget of the cache of long term components, in bytes
+     */
+    uint64_t GetLongTermCacheBudget() const;
+
+    /**
+     * \return the hit, miss and eviction counters of the cache of long term components
+     */
+    const LruCacheStats& GetLongTermCacheStats() const;
+
     /**
      * \brief Computes the received PSD.
      *
@@ -246,7 +265,7 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
 
     int64_t DoAssignStreams(int64_t stream) override;
 
-    mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
+    mutable LruCache<uint64_t, Ptr<const LongTerm>>
         m_longTermMap;                           //!< map containing the long term components
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
 };
@@ -24,13 +24,26 @@
 #include "spectrum-value.h"
 
 #include "ns3/uinteger.h"
+#include <ns3/abort.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
+#include <ns3/simple-ref-count.h>
 #include <ns3/simulator.h>
 #include <ns3/string.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <tuple>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace ns3
 {
@@ -39,8 +52,189 @@ NS_LOG_COMPONENT_DEFINE("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED(TraceFadingLossModel);
 
+namespace
+{
+
+/// Magic number at the beginning of a binary fading trace
+constexpr char BINARY_TRACE_MAGIC[8] = {'N', 'S', '3', 'F', 'A', 'D', 'E', '1'};
+
+/// Size of the header of a binary fading trace: magic number, RB and sample numbers
+constexpr size_t BINARY_TRACE_HEADER_SIZE = sizeof(BINARY_TRACE_MAGIC) + 2 * sizeof(uint32_t);
+
+} // namespace
+
+/**
+ * The samples of a fading trace file, loaded once and shared by all the models
+ * using that file with the same dimensions. A binary trace is memory-mapped,
+ * a text trace is parsed into a buffer.
+ */
+class TraceFadingLossModel::SharedTrace : public SimpleRefCount<SharedTrace>
+{
+  public:
+    /// Trace file name, number of RBs and number of samples per RB
+    typedef std::tuple<std::string, uint32_t, uint32_t> Key;
+
+    /**
+     * \param key the trace file and its dimensions
+     * \return the trace, loaded if no model currently uses it
+     */
+    static Ptr<const SharedTrace> Get(const Key& key);
+
+    /**
+     * Load the trace, use Get instead to share it.
+     * \param key the trace file and its dimensions
+     */
+    SharedTrace(const Key& key);
+
+    ~SharedTrace();
+
+    /**
+     * \return the samples in dB, SamplesNum per RB
+     */
+    const double* GetSamples() const;
+
+  private:
+    /**
+     * Use the binary trace or parse the text trace of the given file content.
+     * \param data the content of the trace file
+     * \param size the size of the content
+     * \return true if the trace is binary, hence data must be kept
+     */
+    bool Attach(const char* data, size_t size);
+
+    /// \return the traces in use, by file and dimensions
+    static std::map<Key, SharedTrace*>& GetRegistry();
+
+    Key m_key;                   ///< the trace file and its dimensions
+    const double* m_samples;     ///< the samples
+    std::vector<double> m_text;  ///< the samples parsed from a text trace
+    std::vector<char> m_binary;  ///< the binary trace, when it is not mapped
+    void* m_mapping;             ///< the mapped binary trace, if any
+    size_t m_mappingSize;        ///< the size of the mapping
+};
+
+std::map<TraceFadingLossModel::SharedTrace::Key, TraceFadingLossModel::SharedTrace*>&
+TraceFadingLossModel::SharedTrace::GetRegistry()
+{
+    static std::map<Key, SharedTrace*> registry;
+    return registry;
+}
+
+Ptr<const TraceFadingLossModel::SharedTrace>
+TraceFadingLossModel::SharedTrace::Get(const Key& key)
+{
+    auto it = GetRegistry().find(key);
+    if (it != GetRegistry().end())
+    {
+        NS_LOG_LOGIC("Sharing the loaded fading trace " << std::get<0>(key));
+        return Ptr<const SharedTrace>(it->second);
+    }
+    Ptr<SharedTrace> trace = Create<SharedTrace>(key);
+    GetRegistry()[key] = PeekPointer(trace);
+    return trace;
+}
+
+TraceFadingLossModel::SharedTrace::SharedTrace(const Key& key)
+    : m_key(key),
+      m_samples(nullptr),
+      m_mapping(nullptr),
+      m_mappingSize(0)
+{
+    const std::string& fileName = std::get<0>(key);
+    NS_LOG_FUNCTION(this << fileName);
+#ifndef __WIN32__
+    int fd = open(fileName.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Fading trace file " << fileName << " not found");
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        m_mappingSize = st.st_size;
+        m_mapping = mmap(nullptr, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    NS_ABORT_MSG_IF(m_mapping == nullptr || m_mapping == MAP_FAILED,
+                    "Can not map fading trace file " << fileName);
+    if (!Attach(static_cast<const char*>(m_mapping), m_mappingSize))
+    {
+        munmap(m_mapping, m_mappingSize);
+        m_mapping = nullptr;
+    }
+#else
+    std::ifstream in(fileName, std::ios::binary);
+    NS_ABORT_MSG_IF(!in.is_open(), "Fading trace file " << fileName << " not found");
+    m_binary.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (!Attach(m_binary.data(), m_binary.size()))
+    {
+        m_binary.clear();
+        m_binary.shrink_to_fit();
+    }
+#endif
+}
+
+TraceFadingLossModel::SharedTrace::~SharedTrace()
+{
+    NS_LOG_FUNCTION(this);
+    GetRegistry().erase(m_key);
+#ifndef __WIN32__
+    if (m_mapping != nullptr)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+bool
+TraceFadingLossModel::SharedTrace::Attach(const char* data, size_t size)
+{
+    const auto& [fileName, rbNum, samplesNum] = m_key;
+    size_t nSamples = static_cast<size_t>(rbNum) * samplesNum;
+    if (size >= sizeof(BINARY_TRACE_MAGIC) &&
+        std::memcmp(data, BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC)) == 0)
+    {
+        NS_ABORT_MSG_IF(size < BINARY_TRACE_HEADER_SIZE,
+                        "Truncated binary fading trace " << fileName);
+        uint32_t header[2];
+        std::memcpy(header, data + sizeof(BINARY_TRACE_MAGIC), sizeof(header));
+        NS_ABORT_MSG_IF(header[0] != rbNum || header[1] != samplesNum,
+                        "Binary fading trace " << fileName << " has " << header[0] << " RBs and "
+                                               << header[1] << " samples, the RbNum and "
+                                               << "SamplesNum attributes are " << rbNum << " and "
+                                               << samplesNum);
+        NS_ABORT_MSG_IF(size < BINARY_TRACE_HEADER_SIZE + nSamples * sizeof(double),
+                        "Truncated binary fading trace " << fileName);
+        // The header size keeps the samples aligned in the page-aligned mapping
+        m_samples = reinterpret_cast<const double*>(data + BINARY_TRACE_HEADER_SIZE);
+        NS_LOG_INFO("Mapped the binary fading trace " << fileName);
+        return true;
+    }
+
+    // strtod needs a null-terminated string
+    std::string text(data, size);
+    const char* cursor = text.c_str();
+    m_text.resize(nSamples);
+    for (size_t i = 0; i < nSamples; i++)
+    {
+        char* end;
+        m_text[i] = std::strtod(cursor, &end);
+        NS_ABORT_MSG_IF(end == cursor,
+                        "Fading trace " << fileName << " has less than " << nSamples
+                                        << " samples (RbNum times SamplesNum)");
+        cursor = end;
+    }
+    m_samples = m_text.data();
+    NS_LOG_INFO("Parsed the text fading trace " << fileName);
+    return false;
+}
+
+const double*
+TraceFadingLossModel::SharedTrace::GetSamples() const
+{
+    return m_samples;
+}
+
 TraceFadingLossModel::TraceFadingLossModel()
-    : m_streamsAssigned(false)
+    : m_samples(nullptr),
+      m_streamsAssigned(false)
 {
     NS_LOG_FUNCTION(this);
     SetNext(nullptr);
@@ -48,7 +242,7 @@ TraceFadingLossModel::TraceFadingLossModel()
 
 TraceFadingLossModel::~TraceFadingLossModel()
 {
-    m_fadingTrace.clear();
+    m_fadingTrace = nullptr;
     m_windowOffsetsMap.clear();
     m_startVariableMap.clear();
 }
@@ -120,28 +314,11 @@ void
 TraceFadingLossModel::LoadTrace()
 {
     NS_LOG_FUNCTION(this << "Loading Fading Trace " << m_traceFile);
-    std::ifstream ifTraceFile;
-    ifTraceFile.open(m_traceFile, std::ifstream::in);
-    m_fadingTrace.clear();
-    if (!ifTraceFile.good())
-    {
-        NS_LOG_INFO(this << " File: " << m_traceFile);
-        NS_ASSERT_MSG(ifTraceFile.good(), " Fading trace file not found");
-    }
+    m_fadingTrace = SharedTrace::Get({m_traceFile, m_rbNum, m_samplesNum});
+    m_samples = m_fadingTrace->GetSamples();
 
     //   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
     //   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-    for (uint32_t i = 0; i < m_rbNum; i++)
-    {
-        FadingTraceSample rbTimeFadingTrace;
-        for (uint32_t j = 0; j < m_samplesNum; j++)
-        {
-            double sample;
-            ifTraceFile >> sample;
-            rbTimeFadingTrace.push_back(sample);
-        }
-        m_fadingTrace.push_back(rbTimeFadingTrace);
-    }
     m_timeGranularity = m_traceLength.GetMilliSeconds() / m_samplesNum;
     m_lastWindowUpdate = Simulator::Now();
 }
@@ -151,7 +328,18 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
                                                    Ptr<const MobilityModel> a,
                                                    Ptr<const MobilityModel> b) const
 {
-    NS_LOG_FUNCTION(this << *params->psd << a << b);
+    Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
+    DoApplyRxPowerSpectralDensity(rxPsd, params, a, b);
+    return rxPsd;
+}
+
+void
+TraceFadingLossModel::DoApplyRxPowerSpectralDensity(Ptr<SpectrumValue> psd,
+                                                    Ptr<const SpectrumSignalParameters> params,
+                                                    Ptr<const MobilityModel> a,
+                                                    Ptr<const MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << *psd << a << b);
 
     ChannelRealizationId_t mobilityPair = std::make_pair(a, b);
     auto itOff = m_windowOffsetsMap.find(mobilityPair);
@@ -196,8 +384,7 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
                 .first;
     }
 
-    Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
-    auto vit = rxPsd->ValuesBegin();
+    auto vit = psd->ValuesBegin();
 
     // Vector aSpeedVector = a->GetVelocity ();
     // Vector bSpeedVector = b->GetVelocity ();
@@ -205,18 +392,19 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
     // double speed = std::sqrt (std::pow (aSpeedVector.x-bSpeedVector.x,2) + std::pow
     // (aSpeedVector.y-bSpeedVector.y,2));
 
-    NS_LOG_LOGIC(this << *rxPsd);
-    NS_ASSERT(!m_fadingTrace.empty());
+    NS_LOG_LOGIC(this << *psd);
+    NS_ASSERT(m_samples != nullptr);
     int now_ms = static_cast<int>(Simulator::Now().GetMilliSeconds() * m_timeGranularity);
     int lastUpdate_ms = static_cast<int>(m_lastWindowUpdate.GetMilliSeconds() * m_timeGranularity);
     int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
     int subChannel = 0;
-    while (vit != rxPsd->ValuesEnd())
+    while (vit != psd->ValuesEnd())
     {
         NS_ASSERT(subChannel < 100);
+        NS_ASSERT(static_cast<uint32_t>(subChannel) < m_rbNum);
         if (*vit != 0.)
         {
-            double fading = m_fadingTrace.at(subChannel).at(index);
+            double fading = m_samples[subChannel * m_samplesNum + index];
             NS_LOG_INFO(this << " FADING now " << now_ms << " offset " << (*itOff).second << " id "
                              << index << " fading " << fading);
             double power = *vit;                     // in Watt/Hz
@@ -233,8 +421,40 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParam
         ++subChannel;
     }
 
-    NS_LOG_LOGIC(this << *rxPsd);
-    return rxPsd;
+    NS_LOG_LOGIC(this << *psd);
+}
+
+bool
+TraceFadingLossModel::ConvertTrace(const std::string& textFile,
+                                   const std::string& binaryFile,
+                                   uint32_t rbNum,
+                                   uint32_t samplesNum)
+{
+    NS_LOG_FUNCTION(textFile << binaryFile << rbNum << samplesNum);
+    std::ifstream in(textFile);
+    if (!in.is_open())
+    {
+        return false;
+    }
+    std::vector<double> samples(static_cast<size_t>(rbNum) * samplesNum);
+    for (auto& sample : samples)
+    {
+        if (!(in >> sample))
+        {
+            NS_LOG_WARN(textFile << " has less than " << samples.size() << " samples");
+            return false;
+        }
+    }
+    std::ofstream out(binaryFile, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        return false;
+    }
+    out.write(BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&rbNum), sizeof(rbNum));
+    out.write(reinterpret_cast<const char*>(&samplesNum), sizeof(samplesNum));
+    out.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(double));
+    return out.good();
 }
 
 int64_t
@@ -38,6 +38,14 @@ class MobilityModel;
  * \ingroup spectrum
  *
  * \brief fading loss model based on precalculated fading traces
+ *
+ * The trace file is either the text format of the traces generated by
+ * fading_trace_generator.m (RbNum rows of SamplesNum values in dB), or the
+ * binary format written by ConvertTrace (a header followed by the same
+ * values as native doubles). A binary trace is memory-mapped. The samples of a
+ * trace file are loaded once per process and shared, read-only, by all the
+ * models using that file, so the memory and the loading time do not grow with
+ * the number of models (e.g., one per cell).
  */
 class TraceFadingLossModel : public SpectrumPropagationLossModel
 {
@@ -53,6 +61,21 @@ class TraceFadingLossModel : public SpectrumPropagationLossModel
 
     void DoInitialize() override;
 
+    /**
+     * \brief Convert a text fading trace to the binary format, which is faster
+     * to load and is memory-mapped.
+     * \param textFile the text trace file
+     * \param binaryFile the binary trace file to write
+     * \param rbNum the number of RBs of the trace
+     * \param samplesNum the number of samples per RB of the trace
+     * \return false if the text trace could not be read or the binary trace
+     * could not be written
+     */
+    static bool ConvertTrace(const std::string& textFile,
+                             const std::string& binaryFile,
+                             uint32_t rbNum,
+                             uint32_t samplesNum);
+
     /**
      * \brief The couple of mobility node that form a fading channel realization
      */
@@ -73,6 +96,19 @@ class TraceFadingLossModel : public SpectrumPropagationLossModel
                                                     Ptr<const MobilityModel> a,
                                                     Ptr<const MobilityModel> b) const override;
 
+    /**
+     * Apply the loss to a set of values in place
+     *
+     * @param psd the values to update
+     * @param params the spectrum signal parameters.
+     * @param a sender mobility
+     * @param b receiver mobility
+     */
+    void DoApplyRxPowerSpectralDensity(Ptr<SpectrumValue> psd,
+                                       Ptr<const SpectrumSignalParameters> params,
+                                       Ptr<const MobilityModel> a,
+                                       Ptr<const MobilityModel> b) const override;
+
     /**
      * \brief Get the value for a particular sub channel and a given speed
      * \param subChannel the sub channel for which a value is requested
@@ -100,18 +136,12 @@ class TraceFadingLossModel : public SpectrumPropagationLossModel
     mutable std::map<ChannelRealizationId_t, Ptr<UniformRandomVariable>>
         m_startVariableMap; ///< start variable map
 
-    /**
-     * Vector with fading samples in time domain (for a fixed RB)
-     */
-    typedef std::vector<double> FadingTraceSample;
-    /**
-     * Vector collecting the time fading traces in the frequency domain (per RB)
-     */
-    typedef std::vector<FadingTraceSample> FadingTrace;
+    class SharedTrace; ///< The samples of a trace file, shared by the models using it
 
     std::string m_traceFile; ///< the trace file name
 
-    FadingTrace m_fadingTrace; ///< fading trace
+    Ptr<const SharedTrace> m_fadingTrace; ///< fading trace, shared with the other models
+    const double* m_samples;              ///< fading samples in dB, SamplesNum per RB
 
     Time m_traceLength;               ///< the trace time
     uint32_t m_samplesNum;            ///< number of samples
@@ -0,0 +1,211 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Minimal SpectrumPhy which keeps the received PSDs
+ */
+class ConversionTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param model the RX spectrum model
+     */
+    ConversionTestPhy(Ptr<const SpectrumModel> model)
+        : m_model(model)
+    {
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_rxPsds.push_back(params->psd);
+    }
+
+    std::vector<Ptr<SpectrumValue>> m_rxPsds; //!< the received PSDs
+
+  private:
+    Ptr<const SpectrumModel> m_model; //!< RX spectrum model
+    Ptr<MobilityModel> m_mobility;    //!< mobility model
+};
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the MultiModelSpectrumChannel delivers to each receiver
+ * the transmitted PSD, converted to its SpectrumModel, times its path gain,
+ * and nothing to the receivers of an orthogonal SpectrumModel
+ */
+class MultiModelSpectrumChannelConversionTestCase : public TestCase
+{
+  public:
+    MultiModelSpectrumChannelConversionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MultiModelSpectrumChannelConversionTestCase::MultiModelSpectrumChannelConversionTestCase()
+    : TestCase("PSD conversion to the SpectrumModel of the receivers")
+{
+}
+
+void
+MultiModelSpectrumChannelConversionTestCase::DoRun()
+{
+    // 4 bands of 1 MHz, 2 bands of 2 MHz over the same range, and 5 GHz bands
+    auto txModel =
+        Create<SpectrumModel>(std::vector<double>{2.4005e9, 2.4015e9, 2.4025e9, 2.4035e9});
+    auto wideModel = Create<SpectrumModel>(std::vector<double>{2.401e9, 2.403e9});
+    auto orthogonalModel = Create<SpectrumModel>(std::vector<double>{5.18e9, 5.2e9});
+
+    auto channel = CreateObject<MultiModelSpectrumChannel>();
+    auto propagationLoss = CreateObject<FriisPropagationLossModel>();
+    channel->AddPropagationLossModel(propagationLoss);
+
+    auto tx = CreateObject<ConversionTestPhy>(txModel);
+    auto txMobility = CreateObject<ConstantPositionMobilityModel>();
+    tx->SetMobility(txMobility);
+    std::vector<Ptr<ConversionTestPhy>> rxs;
+    for (auto model : {txModel, wideModel, wideModel, orthogonalModel, wideModel})
+    {
+        auto rx = CreateObject<ConversionTestPhy>(model);
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(10.0 * (rxs.size() + 1), 5, 0));
+        rx->SetMobility(mobility);
+        channel->AddRx(rx);
+        rxs.push_back(rx);
+    }
+
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(txModel);
+    for (std::size_t i = 0; i < 4; i++)
+    {
+        (*params->psd)[i] = 1e-9 * (i + 1);
+    }
+    params->txPhy = tx;
+    params->duration = MicroSeconds(100);
+    SpectrumValue txPsd = *params->psd;
+    channel->StartTx(params);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ((*params->psd == txPsd), true, "the TX PSD has been modified");
+    SpectrumConverter converter(txModel, wideModel);
+    Ptr<SpectrumValue> converted = converter.Convert(params->psd);
+    for (std::size_t r = 0; r < rxs.size(); r++)
+    {
+        Ptr<const SpectrumModel> model = rxs[r]->GetRxSpectrumModel();
+        if (model == orthogonalModel)
+        {
+            NS_TEST_EXPECT_MSG_EQ(rxs[r]->m_rxPsds.size(), 0, "receiver " << r << " is orthogonal");
+            continue;
+        }
+        NS_TEST_ASSERT_MSG_EQ(rxs[r]->m_rxPsds.size(), 1, "receiver " << r << " missed the PSD");
+        Ptr<SpectrumValue> rxPsd = rxs[r]->m_rxPsds[0];
+        NS_TEST_ASSERT_MSG_EQ(rxPsd->GetSpectrumModelUid(),
+                              model->GetUid(),
+                              "receiver " << r << " got a PSD of another SpectrumModel");
+        double gainDb = propagationLoss->CalcRxPower(0, txMobility, rxs[r]->GetMobility());
+        double gain = std::pow(10.0, gainDb / 10.0);
+        const SpectrumValue& expected = (model == txModel) ? txPsd : *converted;
+        for (std::size_t i = 0; i < expected.GetValuesN(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ_TOL((*rxPsd)[i],
+                                      expected[i] * gain,
+                                      expected[i] * gain * 1e-12,
+                                      "receiver " << r << " band " << i);
+        }
+        for (std::size_t other = 0; other < r; other++)
+        {
+            // each receiver owns its PSD, since the spectrum losses are applied in place
+            bool shared = !rxs[other]->m_rxPsds.empty() && rxs[other]->m_rxPsds[0] == rxPsd;
+            NS_TEST_EXPECT_MSG_EQ(shared, false, "receivers " << other << " and " << r);
+        }
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test suite for the MultiModelSpectrumChannel
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+  public:
+    MultiModelSpectrumChannelTestSuite();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite()
+    : TestSuite("multi-model-spectrum-channel", Type::UNIT)
+{
+    AddTestCase(new MultiModelSpectrumChannelConversionTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite;
@@ -0,0 +1,292 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/net-device.h>
+#include <ns3/object-factory.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Minimal SpectrumPhy which logs the receptions
+ */
+class GridTestPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param id the identifier logged on reception
+     * \param model the RX spectrum model
+     * \param rxLog the reception log
+     */
+    GridTestPhy(uint32_t id, Ptr<const SpectrumModel> model, std::vector<uint32_t>* rxLog)
+        : m_id(id),
+          m_model(model),
+          m_rxLog(rxLog)
+    {
+    }
+
+    void SetDevice(Ptr<NetDevice> d) override
+    {
+    }
+
+    Ptr<NetDevice> GetDevice() const override
+    {
+        return nullptr;
+    }
+
+    void SetMobility(Ptr<MobilityModel> m) override
+    {
+        m_mobility = m;
+    }
+
+    Ptr<MobilityModel> GetMobility() const override
+    {
+        return m_mobility;
+    }
+
+    void SetChannel(Ptr<SpectrumChannel> c) override
+    {
+    }
+
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override
+    {
+        return m_model;
+    }
+
+    Ptr<Object> GetAntenna() const override
+    {
+        return nullptr;
+    }
+
+    void StartRx(Ptr<SpectrumSignalParameters> params) override
+    {
+        m_rxLog->push_back(m_id);
+    }
+
+  private:
+    uint32_t m_id;                    //!< identifier logged on reception
+    Ptr<const SpectrumModel> m_model; //!< RX spectrum model
+    Ptr<MobilityModel> m_mobility;    //!< mobility model
+    std::vector<uint32_t>* m_rxLog;   //!< reception log
+};
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the MaxRange attribute of the spectrum channels delivers
+ * a transmission to exactly the receivers in range, in attachment order,
+ * while receivers are moved, are moving or have no mobility model.
+ */
+class SpectrumChannelMaxRangeTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param channelType the SpectrumChannel TypeId name
+     */
+    SpectrumChannelMaxRangeTestCase(std::string channelType);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Transmit from the first phy and record the expected receivers.
+     */
+    void Transmit();
+
+    std::string m_channelType;             //!< the SpectrumChannel TypeId name
+    double m_maxRange;                     //!< the MaxRange of the channel
+    Ptr<SpectrumChannel> m_channel;        //!< the channel
+    Ptr<SpectrumValue> m_psd;              //!< the transmitted PSD
+    std::vector<Ptr<GridTestPhy>> m_phys;  //!< the phys, the first one transmits
+    std::vector<uint32_t> m_rxLog;         //!< the receptions of all the phys
+    std::vector<std::vector<uint32_t>> m_expected; //!< the expected receptions
+    std::vector<std::vector<uint32_t>> m_actual;   //!< the actual receptions
+};
+
+SpectrumChannelMaxRangeTestCase::SpectrumChannelMaxRangeTestCase(std::string channelType)
+    : TestCase("MaxRange culling with " + channelType),
+      m_channelType(channelType),
+      m_maxRange(100)
+{
+}
+
+void
+SpectrumChannelMaxRangeTestCase::Transmit()
+{
+    // the receptions of the previous transmission are complete by now
+    if (!m_expected.empty())
+    {
+        m_actual.push_back(m_rxLog);
+    }
+    m_rxLog.clear();
+
+    Vector txPosition = m_phys[0]->GetMobility()->GetPosition();
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 1; i < m_phys.size(); ++i)
+    {
+        Ptr<MobilityModel> mobility = m_phys[i]->GetMobility();
+        if (!mobility || CalculateDistance(txPosition, mobility->GetPosition()) <= m_maxRange)
+        {
+            expected.push_back(i);
+        }
+    }
+    m_expected.push_back(expected);
+
+    Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters>();
+    params->psd = m_psd;
+    params->txPhy = m_phys[0];
+    params->duration = MicroSeconds(100);
+    m_channel->StartTx(params);
+}
+
+void
+SpectrumChannelMaxRangeTestCase::DoRun()
+{
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(std::vector<double>{2.40e9, 2.41e9});
+    m_psd = Create<SpectrumValue>(model);
+
+    ObjectFactory factory(m_channelType);
+    factory.Set("MaxRange", DoubleValue(m_maxRange));
+    m_channel = factory.Create<SpectrumChannel>();
+
+    // the transmitter, in the middle of static receivers spread over a
+    // 400 m x 400 m square
+    for (uint32_t i = 0; i < 40; ++i)
+    {
+        Ptr<GridTestPhy> phy = CreateObject<GridTestPhy>(i, model, &m_rxLog);
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(i == 0 ? Vector(200, 200, 0)
+                                     : Vector((i * 37) % 400, (i * 53) % 400, (i * 11) % 30));
+        phy->SetMobility(mobility);
+        m_phys.push_back(phy);
+    }
+    // a receiver driving through the range of the transmitter, which does
+    // not trigger any course change
+    Ptr<GridTestPhy> mover = CreateObject<GridTestPhy>(m_phys.size(), model, &m_rxLog);
+    Ptr<ConstantVelocityMobilityModel> velocity = CreateObject<ConstantVelocityMobilityModel>();
+    velocity->SetPosition(Vector(470, 200, 0));
+    velocity->SetVelocity(Vector(-60, 0, 0));
+    mover->SetMobility(velocity);
+    m_phys.push_back(mover);
+    // a receiver without mobility model, which is never culled
+    m_phys.push_back(CreateObject<GridTestPhy>(m_phys.size(), model, &m_rxLog));
+
+    for (auto& phy : m_phys)
+    {
+        m_channel->AddRx(phy);
+    }
+
+    Simulator::Schedule(Seconds(1), &SpectrumChannelMaxRangeTestCase::Transmit, this);
+    // move a far away receiver next to the transmitter, and move the
+    // transmitter itself
+    Simulator::Schedule(Seconds(2), [this]() {
+        m_phys[1]->GetMobility()->SetPosition(Vector(210, 190, 0));
+    });
+    Simulator::Schedule(Seconds(3), &SpectrumChannelMaxRangeTestCase::Transmit, this);
+    Simulator::Schedule(Seconds(4), [this]() {
+        m_phys[0]->GetMobility()->SetPosition(Vector(50, 50, 0));
+    });
+    Simulator::Schedule(Seconds(5), &SpectrumChannelMaxRangeTestCase::Transmit, this);
+    // detach a receiver in range and stop the mover
+    Simulator::Schedule(Seconds(6), [this]() {
+        m_channel->RemoveRx(m_phys[3]);
+        DynamicCast<ConstantVelocityMobilityModel>(m_phys[40]->GetMobility())
+            ->SetVelocity(Vector(0, 0, 0));
+        m_phys[0]->GetMobility()->SetPosition(Vector(200, 200, 0));
+    });
+    Simulator::Schedule(Seconds(7), &SpectrumChannelMaxRangeTestCase::Transmit, this);
+    Simulator::Run();
+    m_actual.push_back(m_rxLog);
+
+    // the detached receiver does not receive anymore
+    NS_TEST_ASSERT_MSG_EQ(std::count(m_expected[3].begin(), m_expected[3].end(), 3),
+                          1,
+                          "The detached receiver is not in range");
+    m_expected[3].erase(std::remove(m_expected[3].begin(), m_expected[3].end(), 3),
+                        m_expected[3].end());
+
+    NS_TEST_ASSERT_MSG_EQ(m_actual.size(), m_expected.size(), "Wrong number of transmissions");
+    for (std::size_t tx = 0; tx < m_expected.size(); ++tx)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_expected[tx].size(), 1, "Too few receivers in range");
+        NS_TEST_ASSERT_MSG_LT(m_expected[tx].size(), 20, "Too many receivers in range");
+        NS_TEST_ASSERT_MSG_EQ(m_actual[tx].size(),
+                              m_expected[tx].size(),
+                              "Wrong number of receptions for transmission " << tx);
+        for (std::size_t i = 0; i < m_expected[tx].size(); ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(m_actual[tx][i],
+                                  m_expected[tx][i],
+                                  "Wrong reception " << i << " for transmission " << tx);
+        }
+    }
+    // the moved receiver got the second transmission, the mover got the
+    // second and the last ones but not the first one
+    NS_TEST_ASSERT_MSG_EQ(m_expected[1].front(), 1, "The moved receiver is out of range");
+    NS_TEST_ASSERT_MSG_EQ(std::count(m_expected[3].begin(), m_expected[3].end(), 40),
+                          1,
+                          "The stopped mover is not in range");
+    NS_TEST_ASSERT_MSG_EQ(std::count(m_expected[0].begin(), m_expected[0].end(), 40),
+                          0,
+                          "The mover is already in range");
+    NS_TEST_ASSERT_MSG_EQ(std::count(m_expected[1].begin(), m_expected[1].end(), 40),
+                          1,
+                          "The mover is not in range");
+
+    m_channel->Dispose();
+    m_phys.clear();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumChannel MaxRange TestSuite
+ */
+class SpectrumChannelMaxRangeTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelMaxRangeTestSuite();
+};
+
+SpectrumChannelMaxRangeTestSuite::SpectrumChannelMaxRangeTestSuite()
+    : TestSuite("spectrum-channel-max-range", Type::UNIT)
+{
+    AddTestCase(new SpectrumChannelMaxRangeTestCase("ns3::SingleModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumChannelMaxRangeTestCase("ns3::MultiModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SpectrumChannelMaxRangeTestSuite g_spectrumChannelMaxRangeTestSuite;
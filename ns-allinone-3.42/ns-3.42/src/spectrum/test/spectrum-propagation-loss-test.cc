@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-spectrum-propagation-loss.h>
+#include <ns3/friis-spectrum-propagation-loss.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that ApplyRxPowerSpectralDensity gives the same values as
+ * CalcRxPowerSpectralDensity, and that the latter leaves the TX PSD untouched
+ */
+class SpectrumPropagationLossInPlaceTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param loss the loss model (or chain of models) to check
+     * \param name test name
+     */
+    SpectrumPropagationLossInPlaceTestCase(Ptr<SpectrumPropagationLossModel> loss,
+                                           std::string name);
+
+  private:
+    void DoRun() override;
+
+    Ptr<SpectrumPropagationLossModel> m_loss; //!< the loss model
+};
+
+SpectrumPropagationLossInPlaceTestCase::SpectrumPropagationLossInPlaceTestCase(
+    Ptr<SpectrumPropagationLossModel> loss,
+    std::string name)
+    : TestCase(name),
+      m_loss(loss)
+{
+}
+
+void
+SpectrumPropagationLossInPlaceTestCase::DoRun()
+{
+    std::vector<double> freqs;
+    for (int i = 0; i < 8; i++)
+    {
+        freqs.push_back(2.4e9 + i * 1e6);
+    }
+    Ptr<SpectrumModel> model = Create<SpectrumModel>(freqs);
+
+    auto a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    auto b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(30, 40, 0));
+
+    auto txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = Create<SpectrumValue>(model);
+    for (std::size_t i = 0; i < freqs.size(); i++)
+    {
+        (*txParams->psd)[i] = 1e-9 * (i + 1);
+    }
+    SpectrumValue txPsd = *txParams->psd;
+
+    Ptr<SpectrumValue> calculated = m_loss->CalcRxPowerSpectralDensity(txParams, a, b);
+    NS_TEST_ASSERT_MSG_EQ((*txParams->psd == txPsd), true, "the TX PSD has been modified");
+
+    Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    m_loss->ApplyRxPowerSpectralDensity(rxParams, a, b);
+    NS_TEST_ASSERT_MSG_EQ((*txParams->psd == txPsd), true, "the TX PSD has been modified");
+    NS_TEST_ASSERT_MSG_EQ(rxParams->psd->GetSpectrumModelUid(),
+                          model->GetUid(),
+                          "the RX PSD refers to another SpectrumModel");
+    for (std::size_t i = 0; i < freqs.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ((*rxParams->psd)[i],
+                              (*calculated)[i],
+                              "in-place loss differs at band " << i);
+        NS_TEST_ASSERT_MSG_LT((*rxParams->psd)[i], txPsd[i], "no loss applied at band " << i);
+    }
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test suite for the in-place application of the spectrum propagation loss
+ */
+class SpectrumPropagationLossInPlaceTestSuite : public TestSuite
+{
+  public:
+    SpectrumPropagationLossInPlaceTestSuite();
+};
+
+SpectrumPropagationLossInPlaceTestSuite::SpectrumPropagationLossInPlaceTestSuite()
+    : TestSuite("spectrum-propagation-loss-in-place", Type::UNIT)
+{
+    AddTestCase(new SpectrumPropagationLossInPlaceTestCase(
+                    CreateObject<FriisSpectrumPropagationLossModel>(),
+                    "Friis"),
+                TestCase::Duration::QUICK);
+
+    auto constant = CreateObject<ConstantSpectrumPropagationLossModel>();
+    constant->SetLossDb(10);
+    AddTestCase(new SpectrumPropagationLossInPlaceTestCase(constant, "Constant"),
+                TestCase::Duration::QUICK);
+
+    auto chained = CreateObject<ConstantSpectrumPropagationLossModel>();
+    chained->SetLossDb(3);
+    chained->SetNext(CreateObject<FriisSpectrumPropagationLossModel>());
+    AddTestCase(new SpectrumPropagationLossInPlaceTestCase(chained, "Constant then Friis"),
+                TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SpectrumPropagationLossInPlaceTestSuite g_spectrumPropagationLossInPlaceTestSuite;
@@ -276,6 +276,34 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"),
                 TestCase::Duration::QUICK);
+
+    // expressions whose left operand is a temporary are computed in place
+    SpectrumValue v11 = v1;
+    v11 *= v2;
+    v11 += v1;
+    v11 /= doubleValue;
+    v11 -= v2;
+    SpectrumValue tv11 = (v1 * v2 + v1) / doubleValue - v2;
+    AddTestCase(new SpectrumValueTestCase(tv11,
+                                          v11,
+                                          "tv11 = (v1 * v2 + v1) div doubleValue - v2"),
+                TestCase::Duration::QUICK);
+
+    SpectrumValue v12 = v1;
+    v12 += doubleValue;
+    v12 *= doubleValue;
+    v12 -= v2;
+    v12 = -v12;
+    SpectrumValue tv12 = -(doubleValue * (v1 + doubleValue) - v2);
+    AddTestCase(new SpectrumValueTestCase(tv12,
+                                          v12,
+                                          "tv12 = -(doubleValue * (v1 + doubleValue) - v2)"),
+                TestCase::Duration::QUICK);
+
+    SpectrumValue v13 = v1 + v1;
+    SpectrumValue tv13 = v1;
+    tv13 += tv13;
+    AddTestCase(new SpectrumValueTestCase(tv13, v13, "tv13 += tv13"), TestCase::Duration::QUICK);
 }
 
 /**
@@ -742,6 +742,101 @@ struct CheckLongTermUpdateParams
     Ptr<PhasedArrayModel> rxAntenna;        //!< the antenna array of the rx device
 };
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the cache budgets of the ThreeGppChannelModel class.
+ * It checks that, when the budget only fits one channel matrix, the matrix of
+ * the least recently used pair is evicted and generated again, and that the
+ * hit, miss and eviction counters follow the lookups.
+ */
+class ThreeGppChannelCacheBudgetTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelCacheBudgetTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+};
+
+ThreeGppChannelCacheBudgetTest::ThreeGppChannelCacheBudgetTest()
+    : TestCase("Check the eviction of channel matrices when the cache budget is exceeded")
+{
+}
+
+void
+ThreeGppChannelCacheBudgetTest::DoRun()
+{
+    // a budget of one byte keeps only the most recently used matrix
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(60.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMa"));
+    channelModel->SetAttribute("ChannelConditionModel",
+                               PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    channelModel->SetAttribute("ChannelCacheBudget", UintegerValue(1));
+
+    // create a transmitter and two receivers
+    NodeContainer nodes;
+    nodes.Create(3);
+    std::vector<Ptr<MobilityModel>> mob;
+    std::vector<Ptr<PhasedArrayModel>> antenna;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+        nodes.Get(i)->AddDevice(dev);
+        dev->SetNode(nodes.Get(i));
+
+        mob.push_back(CreateObject<ConstantPositionMobilityModel>());
+        mob[i]->SetPosition(Vector(100.0 * i, 0.0, i == 0 ? 10.0 : 1.6));
+        nodes.Get(i)->AggregateObject(mob[i]);
+
+        antenna.push_back(CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(2),
+            "NumRows",
+            UintegerValue(2),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>())));
+    }
+
+    auto first = channelModel->GetChannel(mob[0], mob[1], antenna[0], antenna[1]);
+    auto again = channelModel->GetChannel(mob[0], mob[1], antenna[0], antenna[1]);
+    NS_TEST_ASSERT_MSG_EQ(first, again, "The cached channel matrix should be returned");
+
+    // the matrix of the second pair evicts the one of the first pair
+    channelModel->GetChannel(mob[0], mob[2], antenna[0], antenna[2]);
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetChannelCacheStats().evictions,
+                          1,
+                          "The first channel matrix should have been evicted");
+
+    auto regenerated = channelModel->GetChannel(mob[0], mob[1], antenna[0], antenna[1]);
+    NS_TEST_ASSERT_MSG_NE(first, regenerated, "The evicted channel matrix should be regenerated");
+    NS_TEST_ASSERT_MSG_EQ(regenerated->m_channel.GetSize(),
+                          first->m_channel.GetSize(),
+                          "The regenerated channel matrix has wrong dimensions");
+
+    const auto& stats = channelModel->GetChannelCacheStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.hits, 1, "Wrong number of cache hits");
+    NS_TEST_ASSERT_MSG_EQ(stats.misses, 3, "Wrong number of cache misses");
+    NS_TEST_ASSERT_MSG_EQ(stats.evictions, 2, "Wrong number of cache evictions");
+
+    // the channel parameters have no budget and are never evicted
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetParamsCacheStats().evictions,
+                          0,
+                          "The channel parameters should not be evicted");
+    NS_TEST_ASSERT_MSG_EQ(channelModel->GetParamsCacheStats().hits,
+                          2,
+                          "The channel parameters of the first pair should have been reused");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -1119,6 +1214,30 @@ ThreeGppCalcLongTermMultiPortTest::DoRun()
     Ptr<const MatrixBasedChannelModel::Complex3DVector> matrixA =
         threeGppSplm->CalcLongTerm(channelMatrixM0, txAntenna1, rxAntenna1);
 
+    // the port weight products give the same long term as the computation
+    // per port pair and cluster
+    for (size_t cIndex = 0; cIndex < matrixA->GetNumPages(); cIndex++)
+    {
+        for (uint16_t sPortIdx = 0; sPortIdx < txAntenna1->GetNumPorts(); sPortIdx++)
+        {
+            for (uint16_t uPortIdx = 0; uPortIdx < rxAntenna1->GetNumPorts(); uPortIdx++)
+            {
+                std::complex<double> expected =
+                    threeGppSplm->CalculateLongTermComponent(channelMatrixM0,
+                                                             txAntenna1,
+                                                             rxAntenna1,
+                                                             sPortIdx,
+                                                             uPortIdx,
+                                                             cIndex);
+                NS_TEST_ASSERT_MSG_EQ_TOL(std::abs(matrixA->Elem(uPortIdx, sPortIdx, cIndex) -
+                                                   expected),
+                                          0,
+                                          1e-9,
+                                          "Wrong long term component");
+            }
+        }
+    }
+
     // create the tx and rx antennas and set the their dimensions
     Ptr<PhasedArrayModel> txAntenna2 = CreateObjectWithAttributes<UniformPlanarArray>(
         "NumColumns",
@@ -1468,6 +1587,7 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 4, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppChannelMatrixUpdateTest(2, 2, 2, 2), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppAntennaSetupChangedTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelCacheBudgetTest(), TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 1, 1),
                 TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 4, 2, 2),
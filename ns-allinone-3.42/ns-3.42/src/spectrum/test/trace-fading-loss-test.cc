@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/nstime.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+#include <ns3/trace-fading-loss-model.h>
+#include <ns3/uinteger.h>
+
+#include <cmath>
+#include <fstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the text and binary fading traces give the same fading,
+ * taken from the samples of the trace file
+ */
+class TraceFadingLossFormatTestCase : public TestCase
+{
+  public:
+    TraceFadingLossFormatTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \param fileName the trace file
+     * \return an initialized fading model using the trace file
+     */
+    Ptr<TraceFadingLossModel> CreateModel(const std::string& fileName);
+
+    static constexpr uint32_t RB_NUM = 8;       //!< number of RBs of the trace
+    static constexpr uint32_t SAMPLES_NUM = 50; //!< number of samples per RB of the trace
+};
+
+TraceFadingLossFormatTestCase::TraceFadingLossFormatTestCase()
+    : TestCase("Text and binary fading traces")
+{
+}
+
+Ptr<TraceFadingLossModel>
+TraceFadingLossFormatTestCase::CreateModel(const std::string& fileName)
+{
+    auto model = CreateObject<TraceFadingLossModel>();
+    model->SetAttribute("TraceFilename", StringValue(fileName));
+    model->SetAttribute("TraceLength", TimeValue(Seconds(0.5)));
+    model->SetAttribute("SamplesNum", UintegerValue(SAMPLES_NUM));
+    model->SetAttribute("WindowSize", TimeValue(Seconds(0.1)));
+    model->SetAttribute("RbNum", UintegerValue(RB_NUM));
+    model->Initialize();
+    model->AssignStreams(1);
+    return model;
+}
+
+void
+TraceFadingLossFormatTestCase::DoRun()
+{
+    std::vector<double> samples(RB_NUM * SAMPLES_NUM);
+    std::string textFile = CreateTempDirFilename("fading-trace.fad");
+    std::ofstream out(textFile);
+    for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+        for (uint32_t sample = 0; sample < SAMPLES_NUM; sample++)
+        {
+            double& value = samples[rb * SAMPLES_NUM + sample];
+            value = -0.5 * rb - 0.25 * sample + 3;
+            out << value << " ";
+        }
+        out << std::endl;
+    }
+    out.close();
+    std::string binaryFile = CreateTempDirFilename("fading-trace.bin");
+    NS_TEST_ASSERT_MSG_EQ(
+        TraceFadingLossModel::ConvertTrace(textFile, binaryFile, RB_NUM, SAMPLES_NUM),
+        true,
+        "the text trace could not be converted");
+
+    std::vector<double> freqs;
+    for (uint32_t i = 0; i < RB_NUM; i++)
+    {
+        freqs.push_back(2.1e9 + i * 180e3);
+    }
+    auto txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = Create<SpectrumValue>(Create<SpectrumModel>(freqs));
+    *txParams->psd = 1e-12;
+    auto a = CreateObject<ConstantPositionMobilityModel>();
+    auto b = CreateObject<ConstantPositionMobilityModel>();
+
+    // Two models share the text trace, the third one maps the binary trace
+    Ptr<SpectrumValue> text = CreateModel(textFile)->CalcRxPowerSpectralDensity(txParams, a, b);
+    Ptr<SpectrumValue> shared = CreateModel(textFile)->CalcRxPowerSpectralDensity(txParams, a, b);
+    Ptr<SpectrumValue> binary =
+        CreateModel(binaryFile)->CalcRxPowerSpectralDensity(txParams, a, b);
+
+    // The models start at the same random sample, identify it from the first RB
+    double fading0 = 10 * std::log10((*text)[0] / (*txParams->psd)[0]);
+    uint32_t index = std::lround((3 - fading0) / 0.25);
+    NS_TEST_ASSERT_MSG_LT(index, SAMPLES_NUM, "unexpected fading " << fading0);
+    for (uint32_t rb = 0; rb < RB_NUM; rb++)
+    {
+        double fading = 10 * std::log10((*text)[rb] / (*txParams->psd)[rb]);
+        NS_TEST_ASSERT_MSG_EQ_TOL(fading,
+                                  samples[rb * SAMPLES_NUM + index],
+                                  1e-9,
+                                  "the fading of RB " << rb << " is not the trace sample");
+        NS_TEST_ASSERT_MSG_EQ((*shared)[rb], (*text)[rb], "the shared trace differs at RB " << rb);
+        NS_TEST_ASSERT_MSG_EQ((*binary)[rb], (*text)[rb], "the binary trace differs at RB " << rb);
+    }
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test suite for the trace fading loss model
+ */
+class TraceFadingLossTestSuite : public TestSuite
+{
+  public:
+    TraceFadingLossTestSuite();
+};
+
+TraceFadingLossTestSuite::TraceFadingLossTestSuite()
+    : TestSuite("trace-fading-loss", Type::UNIT)
+{
+    AddTestCase(new TraceFadingLossFormatTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceFadingLossTestSuite g_traceFadingLossTestSuite;
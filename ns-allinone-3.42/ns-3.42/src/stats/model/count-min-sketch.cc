@@ -0,0 +1,154 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "count-min-sketch.h"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+/**
+ * \param state the state of the generator, updated by the call
+ * \return the next value of the SplitMix64 sequence
+ */
+static uint64_t
+SplitMix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+CountMinSketch::CountMinSketch(double epsilon, double delta)
+    : m_epsilon(epsilon),
+      m_delta(delta),
+      m_widthBits(1),
+      m_total(0)
+{
+    NS_ASSERT_MSG(epsilon > 0 && epsilon < 1, "Epsilon must be in (0, 1)");
+    NS_ASSERT_MSG(delta > 0 && delta < 1, "Delta must be in (0, 1)");
+    const auto width = std::exp(1.0) / epsilon;
+    while ((1U << m_widthBits) < width && m_widthBits < 31)
+    {
+        m_widthBits++;
+    }
+    m_depth = static_cast<uint32_t>(std::ceil(std::log(1 / delta)));
+    m_counters.assign(static_cast<std::size_t>(m_depth) << m_widthBits, 0);
+
+    // multiply-add-shift hashing of 32-bit keys, the multipliers must be odd
+    uint64_t state = 0;
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        m_hashes.push_back(SplitMix64(state) | 1);
+        m_hashes.push_back(SplitMix64(state));
+    }
+}
+
+CountMinSketch::CountMinSketch()
+    : CountMinSketch(0.001, 0.01)
+{
+}
+
+uint32_t
+CountMinSketch::GetIndex(uint32_t row, uint32_t key) const
+{
+    return (m_hashes[2 * row] * key + m_hashes[2 * row + 1]) >> (64 - m_widthBits);
+}
+
+void
+CountMinSketch::Add(uint32_t key, uint64_t count)
+{
+    m_total += count;
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        m_counters[(static_cast<std::size_t>(row) << m_widthBits) + GetIndex(row, key)] += count;
+    }
+}
+
+void
+CountMinSketch::Merge(const CountMinSketch& other)
+{
+    NS_ASSERT_MSG(m_widthBits == other.m_widthBits && m_depth == other.m_depth,
+                  "Only sketches with the same epsilon and delta can be merged");
+    m_total += other.m_total;
+    for (std::size_t i = 0; i < m_counters.size(); i++)
+    {
+        m_counters[i] += other.m_counters[i];
+    }
+}
+
+uint64_t
+CountMinSketch::GetEstimate(uint32_t key) const
+{
+    auto estimate = std::numeric_limits<uint64_t>::max();
+    for (uint32_t row = 0; row < m_depth; row++)
+    {
+        estimate = std::min(
+            estimate,
+            m_counters[(static_cast<std::size_t>(row) << m_widthBits) + GetIndex(row, key)]);
+    }
+    return estimate;
+}
+
+uint64_t
+CountMinSketch::GetTotal() const
+{
+    return m_total;
+}
+
+uint64_t
+CountMinSketch::GetErrorBound() const
+{
+    return static_cast<uint64_t>(std::ceil(m_epsilon * m_total));
+}
+
+double
+CountMinSketch::GetEpsilon() const
+{
+    return m_epsilon;
+}
+
+double
+CountMinSketch::GetDelta() const
+{
+    return m_delta;
+}
+
+uint32_t
+CountMinSketch::GetWidth() const
+{
+    return 1U << m_widthBits;
+}
+
+uint32_t
+CountMinSketch::GetDepth() const
+{
+    return m_depth;
+}
+
+void
+CountMinSketch::Clear()
+{
+    std::fill(m_counters.begin(), m_counters.end(), 0);
+    m_total = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,131 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_COUNT_MIN_SKETCH_H
+#define NS3_COUNT_MIN_SKETCH_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Count-Min sketch, estimating the total count associated with each of a large number
+ * of keys in a fixed amount of memory.
+ *
+ * The sketch is made of \a depth rows of \a width counters, each row with its own hash
+ * function. Adding a count to a key increments one counter per row, and the estimate for a
+ * key is the minimum of its counters. Estimates never underestimate the exact count and,
+ * with probability at least 1 - delta, overestimate it by at most epsilon times the total
+ * count added to the sketch, where width = e / epsilon, rounded up to a power of two, and
+ * depth = ln(1 / delta).
+ *
+ * The hash functions are drawn from a fixed sequence, hence the sketch is deterministic, and
+ * sketches with the same epsilon and delta, e.g., those of several replications or MPI ranks,
+ * can be merged by adding their counters.
+ *
+ * See G. Cormode and S. Muthukrishnan, "An improved data stream summary: the count-min
+ * sketch and its applications", Journal of Algorithms, 55(1), 2005.
+ */
+class CountMinSketch
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param epsilon the error bound, as a fraction of the total count, in (0, 1)
+     * \param delta the probability that the error bound is exceeded, in (0, 1)
+     */
+    CountMinSketch(double epsilon, double delta);
+    /// Constructor with epsilon = 0.001 and delta = 0.01
+    CountMinSketch();
+
+    /**
+     * \brief Add a count to a key
+     * \param key the key
+     * \param count the count to add
+     */
+    void Add(uint32_t key, uint64_t count);
+
+    /**
+     * \brief Add the counts of another sketch to this sketch
+     * \param other a sketch with the same epsilon and delta
+     */
+    void Merge(const CountMinSketch& other);
+
+    /**
+     * \param key the key
+     * \return an estimate of the total count added to the key
+     */
+    uint64_t GetEstimate(uint32_t key) const;
+
+    /**
+     * \return the total count added to the sketch
+     */
+    uint64_t GetTotal() const;
+
+    /**
+     * \return the maximum overestimation (with probability 1 - delta), i.e., epsilon times the
+     * total count
+     */
+    uint64_t GetErrorBound() const;
+
+    /**
+     * \return the error bound, as a fraction of the total count
+     */
+    double GetEpsilon() const;
+
+    /**
+     * \return the probability that the error bound is exceeded
+     */
+    double GetDelta() const;
+
+    /**
+     * \return the number of counters per row
+     */
+    uint32_t GetWidth() const;
+
+    /**
+     * \return the number of rows
+     */
+    uint32_t GetDepth() const;
+
+    /**
+     * Clear the sketch content.
+     */
+    void Clear();
+
+  private:
+    /**
+     * \param row the row
+     * \param key the key
+     * \return the index of the counter of the key in the given row
+     */
+    uint32_t GetIndex(uint32_t row, uint32_t key) const;
+
+    double m_epsilon;                 //!< error bound, as a fraction of the total count
+    double m_delta;                   //!< probability that the error bound is exceeded
+    uint32_t m_widthBits;             //!< log2 of the number of counters per row
+    uint32_t m_depth;                 //!< number of rows
+    std::vector<uint64_t> m_hashes;   //!< multiplier and increment of the hash of each row
+    std::vector<uint64_t> m_counters; //!< counters, row after row
+    uint64_t m_total;                 //!< total count
+};
+
+} // namespace ns3
+
+#endif /* NS3_COUNT_MIN_SKETCH_H */
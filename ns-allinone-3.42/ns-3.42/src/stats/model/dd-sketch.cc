@@ -0,0 +1,268 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dd-sketch.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/// Values below this threshold are counted as zeros
+#define MIN_INDEXABLE_VALUE 1e-9
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DdSketch");
+
+DdSketch::DdSketch(double relativeAccuracy, uint32_t maxBins)
+    : m_relativeAccuracy(relativeAccuracy),
+      m_maxBins(maxBins),
+      m_offset(0),
+      m_zeroCount(0),
+      m_count(0),
+      m_collapsedCount(0)
+{
+    NS_ASSERT_MSG(relativeAccuracy > 0 && relativeAccuracy < 1,
+                  "The relative accuracy must be in (0, 1)");
+    NS_ASSERT_MSG(maxBins > 0, "At least one bin is needed");
+    m_logGamma = std::log((1 + relativeAccuracy) / (1 - relativeAccuracy));
+}
+
+DdSketch::DdSketch()
+    : DdSketch(0.01, 2048)
+{
+}
+
+int32_t
+DdSketch::GetIndex(double value) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) / m_logGamma));
+}
+
+double
+DdSketch::GetBinValue(int32_t index) const
+{
+    // the value that is at the same relative distance from both bounds of the bin
+    return 2 * std::exp(index * m_logGamma) / (1 + std::exp(m_logGamma));
+}
+
+void
+DdSketch::AddValue(double value)
+{
+    NS_ASSERT_MSG(value >= 0, "Negative values are not supported");
+    m_count++;
+    if (value < MIN_INDEXABLE_VALUE)
+    {
+        m_zeroCount++;
+        return;
+    }
+
+    AddToBin(GetIndex(value), 1);
+}
+
+void
+DdSketch::AddToBin(int32_t index, uint64_t count)
+{
+    NS_LOG_DEBUG("AddToBin: index=" << index << ", m_offset=" << m_offset
+                                    << ", m_bins.size()=" << m_bins.size());
+
+    if (m_bins.empty())
+    {
+        m_offset = index;
+        m_bins.assign(1, 0);
+    }
+    else if (index < m_offset)
+    {
+        // extend the range downwards as far as allowed, lower values go to the lowest bin
+        const auto grow = std::min<int64_t>(m_offset - index, m_maxBins - m_bins.size());
+        m_bins.insert(m_bins.begin(), grow, 0);
+        m_offset -= grow;
+        if (index < m_offset)
+        {
+            index = m_offset;
+            m_collapsedCount += count;
+        }
+    }
+    else if (index - m_offset >= static_cast<int64_t>(m_bins.size()))
+    {
+        const int64_t size = index - m_offset + 1;
+        if (size > m_maxBins)
+        {
+            // collapse the lowest bins, so that the highest ones fit
+            const auto shift = size - m_maxBins;
+            const auto nCollapsed = std::min<int64_t>(shift, m_bins.size());
+            const auto collapsed =
+                std::accumulate(m_bins.begin(), m_bins.begin() + nCollapsed, uint64_t(0));
+            m_bins.erase(m_bins.begin(), m_bins.begin() + nCollapsed);
+            m_offset += shift;
+            if (m_bins.empty())
+            {
+                m_bins.assign(1, 0);
+            }
+            m_bins[0] += collapsed;
+            m_collapsedCount += collapsed;
+        }
+        m_bins.resize(index - m_offset + 1, 0);
+    }
+    m_bins[index - m_offset] += count;
+}
+
+void
+DdSketch::Merge(const DdSketch& other)
+{
+    NS_ASSERT_MSG(m_relativeAccuracy == other.m_relativeAccuracy,
+                  "Only sketches with the same relative accuracy can be merged");
+    m_count += other.m_count;
+    m_zeroCount += other.m_zeroCount;
+    m_collapsedCount += other.m_collapsedCount;
+    // add the highest bins first, so that the lowest ones are collapsed if needed
+    for (std::size_t i = other.m_bins.size(); i > 0; i--)
+    {
+        if (other.m_bins[i - 1] > 0)
+        {
+            AddToBin(other.m_offset + i - 1, other.m_bins[i - 1]);
+        }
+    }
+}
+
+double
+DdSketch::GetQuantile(double quantile) const
+{
+    NS_ASSERT_MSG(quantile >= 0 && quantile <= 1, "The quantile must be in [0, 1]");
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    const auto rank = quantile * (m_count - 1);
+    uint64_t cumulative = m_zeroCount;
+    if (rank < cumulative)
+    {
+        return 0;
+    }
+    for (std::size_t i = 0; i < m_bins.size(); i++)
+    {
+        cumulative += m_bins[i];
+        if (rank < cumulative)
+        {
+            return GetBinValue(m_offset + i);
+        }
+    }
+    return GetBinValue(m_offset + m_bins.size() - 1);
+}
+
+uint64_t
+DdSketch::GetCount() const
+{
+    return m_count;
+}
+
+uint64_t
+DdSketch::GetCollapsedCount() const
+{
+    return m_collapsedCount;
+}
+
+uint32_t
+DdSketch::GetNBins() const
+{
+    return m_bins.size();
+}
+
+double
+DdSketch::GetRelativeAccuracy() const
+{
+    return m_relativeAccuracy;
+}
+
+void
+DdSketch::Clear()
+{
+    m_bins.clear();
+    m_offset = 0;
+    m_zeroCount = 0;
+    m_count = 0;
+    m_collapsedCount = 0;
+}
+
+void
+DdSketch::Serialize(std::ostream& os) const
+{
+    const auto precision = os.precision(17);
+    os << m_relativeAccuracy << " " << m_maxBins << " " << m_offset << " "
+       << m_zeroCount << " " << m_count << " " << m_collapsedCount << " " << m_bins.size();
+    for (const auto bin : m_bins)
+    {
+        os << " " << bin;
+    }
+    os << "\n";
+    os.precision(precision);
+}
+
+bool
+DdSketch::Deserialize(std::istream& is)
+{
+    double relativeAccuracy;
+    uint32_t maxBins;
+    std::size_t nBins;
+    if (!(is >> relativeAccuracy >> maxBins) || relativeAccuracy <= 0 || relativeAccuracy >= 1 ||
+        maxBins == 0)
+    {
+        return false;
+    }
+    *this = DdSketch(relativeAccuracy, maxBins);
+    if (!(is >> m_offset >> m_zeroCount >> m_count >> m_collapsedCount >> nBins) ||
+        nBins > maxBins)
+    {
+        Clear();
+        return false;
+    }
+    m_bins.resize(nBins);
+    for (auto& bin : m_bins)
+    {
+        if (!(is >> bin))
+        {
+            Clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+DdSketch::SerializeToXmlStream(std::ostream& os, uint16_t indent, std::string elementName) const
+{
+    os << std::string(indent, ' ') << "<" << elementName << " relativeAccuracy=\""
+       << m_relativeAccuracy << "\""
+       << " count=\"" << m_count << "\""
+       << " collapsedCount=\"" << m_collapsedCount << "\""
+       << " nBins=\"" << m_bins.size() << "\""
+       << " >\n";
+    indent += 2;
+    for (const auto quantile : {0.5, 0.9, 0.95, 0.99, 0.999})
+    {
+        os << std::string(indent, ' ') << "<quantile"
+           << " q=\"" << quantile << "\""
+           << " value=\"" << GetQuantile(quantile) << "\""
+           << " />\n";
+    }
+    indent -= 2;
+    os << std::string(indent, ' ') << "</" << elementName << ">\n";
+}
+
+} // namespace ns3
@@ -0,0 +1,165 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_DD_SKETCH_H
+#define NS3_DD_SKETCH_H
+
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Quantile sketch with relative error guarantees (DDSketch).
+ *
+ * Values are grouped in bins of exponentially increasing width: bin \a i
+ * groups the data from (gamma^(i-1), gamma^i], where
+ * gamma = (1 + alpha) / (1 - alpha) and alpha is the relative accuracy.
+ * The value returned for a quantile is hence within a relative distance
+ * alpha from the exact quantile of the data added to the sketch, regardless
+ * of the number of values and of their range.
+ *
+ * The memory used by the sketch is bounded by the maximum number of bins.
+ * When the values span more bins than that, the lowest bins are collapsed
+ * together: the accuracy guarantee is kept for the highest quantiles (which
+ * are usually the interesting ones for delays) and lost only for the lowest
+ * ones. The number of values affected is reported by GetCollapsedCount().
+ *
+ * Like Histogram, this class does \a not handle negative data. Values
+ * smaller than 1e-9 are counted as zeros.
+ *
+ * Sketches with the same relative accuracy can be merged, e.g., to combine
+ * the sketches of several replications or MPI ranks: the result is the
+ * sketch of the union of their values. Serialize and Deserialize transport
+ * the content of a sketch as text.
+ *
+ * See C. Masson, J. E. Rim and H. K. Lee, "DDSketch: A Fast and
+ * Fully-Mergeable Quantile Sketch with Relative-Error Guarantees",
+ * Proceedings of the VLDB Endowment, 12(12), 2019.
+ */
+class DdSketch
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param relativeAccuracy the relative accuracy of the quantiles, in (0, 1)
+     * \param maxBins the maximum number of bins
+     */
+    DdSketch(double relativeAccuracy, uint32_t maxBins);
+    /// Constructor with a relative accuracy of 1% and 2048 bins
+    DdSketch();
+
+    /**
+     * \brief Add a value to the sketch
+     * \param value the value to add
+     */
+    void AddValue(double value);
+
+    /**
+     * \brief Add the values of another sketch to this sketch.
+     * \param other a sketch with the same relative accuracy
+     */
+    void Merge(const DdSketch& other);
+
+    /**
+     * \brief Get an estimate of a quantile of the values added to the sketch.
+     * \param quantile the quantile, in [0, 1]
+     * \return the estimate of the quantile, or 0 if the sketch is empty
+     */
+    double GetQuantile(double quantile) const;
+
+    /**
+     * \return the number of values added to the sketch
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * \return the number of values whose bin was collapsed into a higher one
+     */
+    uint64_t GetCollapsedCount() const;
+
+    /**
+     * \return the number of bins currently used by the sketch
+     */
+    uint32_t GetNBins() const;
+
+    /**
+     * \return the relative accuracy of the quantiles
+     */
+    double GetRelativeAccuracy() const;
+
+    /**
+     * Clear the sketch content.
+     */
+    void Clear();
+
+    /**
+     * \brief Serializes a few quantiles and the error bound to an std::ostream in XML format.
+     * \param os the output stream
+     * \param indent number of spaces to use as base indentation level
+     * \param elementName name of the element to serialize.
+     */
+    void SerializeToXmlStream(std::ostream& os, uint16_t indent, std::string elementName) const;
+
+    /**
+     * \brief Write the content of the sketch, to be read back by Deserialize.
+     * \param os the output stream
+     */
+    void Serialize(std::ostream& os) const;
+
+    /**
+     * \brief Replace the content of the sketch by the one written by Serialize.
+     * \param is the input stream
+     * \return false if the stream does not hold a sketch
+     */
+    bool Deserialize(std::istream& is);
+
+  private:
+    /**
+     * \brief Add a count to a bin, collapsing the lowest bins if needed.
+     * \param index the index of the bin
+     * \param count the count to add
+     */
+    void AddToBin(int32_t index, uint64_t count);
+    /**
+     * \param value a (non-zero) value
+     * \return the index of the bin the value belongs to
+     */
+    int32_t GetIndex(double value) const;
+    /**
+     * \param index the index of a bin
+     * \return the value representing the bin
+     */
+    double GetBinValue(int32_t index) const;
+
+    double m_relativeAccuracy;    //!< relative accuracy of the quantiles
+    double m_logGamma;            //!< logarithm of the ratio between the bounds of a bin
+    uint32_t m_maxBins;           //!< maximum number of bins
+    std::vector<uint64_t> m_bins; //!< number of values per bin
+    int32_t m_offset;             //!< index of the first bin
+    uint64_t m_zeroCount;         //!< number of values counted as zeros
+    uint64_t m_count;             //!< number of values
+    uint64_t m_collapsedCount;    //!< number of values whose bin was collapsed
+};
+
+} // namespace ns3
+
+#endif /* NS3_DD_SKETCH_H */
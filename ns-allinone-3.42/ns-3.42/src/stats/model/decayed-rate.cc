@@ -0,0 +1,111 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "decayed-rate.h"
+
+#include "ns3/assert.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+DecayedRate::DecayedRate(Time timeConstant)
+    : m_timeConstant(timeConstant),
+      m_last(0),
+      m_total(0)
+{
+    NS_ASSERT_MSG(timeConstant.IsStrictlyPositive(), "The time constant must be positive");
+}
+
+DecayedRate::DecayedRate()
+    : DecayedRate(Seconds(1))
+{
+}
+
+double
+DecayedRate::GetDecay(Time elapsed) const
+{
+    return std::exp(-elapsed.GetSeconds() / m_timeConstant.GetSeconds());
+}
+
+void
+DecayedRate::Add(Time now, double amount)
+{
+    if (now >= m_last)
+    {
+        m_total = m_total * GetDecay(now - m_last) + amount;
+        m_last = now;
+    }
+    else
+    {
+        m_total += amount * GetDecay(m_last - now);
+    }
+}
+
+void
+DecayedRate::Merge(const DecayedRate& other)
+{
+    NS_ASSERT_MSG(m_timeConstant == other.m_timeConstant,
+                  "Only rates with the same time constant can be merged");
+    Add(other.m_last, other.m_total);
+}
+
+double
+DecayedRate::GetRate(Time now) const
+{
+    NS_ASSERT_MSG(now >= m_last, "The rate is only known after the last amount");
+    return m_total * GetDecay(now - m_last) / m_timeConstant.GetSeconds();
+}
+
+Time
+DecayedRate::GetTimeConstant() const
+{
+    return m_timeConstant;
+}
+
+void
+DecayedRate::Clear()
+{
+    m_last = Time(0);
+    m_total = 0;
+}
+
+void
+DecayedRate::Serialize(std::ostream& os) const
+{
+    const auto precision = os.precision(17);
+    os << m_timeConstant.GetTimeStep() << " " << m_last.GetTimeStep() << " " << m_total << "\n";
+    os.precision(precision);
+}
+
+bool
+DecayedRate::Deserialize(std::istream& is)
+{
+    int64_t timeConstant;
+    int64_t last;
+    double total;
+    if (!(is >> timeConstant >> last >> total) || timeConstant <= 0)
+    {
+        return false;
+    }
+    m_timeConstant = TimeStep(timeConstant);
+    m_last = TimeStep(last);
+    m_total = total;
+    return true;
+}
+
+} // namespace ns3
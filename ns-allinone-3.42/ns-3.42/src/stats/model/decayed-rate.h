@@ -0,0 +1,109 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef NS3_DECAYED_RATE_H
+#define NS3_DECAYED_RATE_H
+
+#include "ns3/nstime.h"
+
+#include <istream>
+#include <ostream>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Exponentially decayed rate of a stream of amounts, e.g., bytes or packets.
+ *
+ * Each amount added at time t contributes amount * exp(-(now - t) / tau) / tau to the rate
+ * at time now, where tau is the time constant. A steady stream of r units per second hence
+ * has a rate converging to r, and the amounts older than a few tau are forgotten, with a
+ * state of two numbers regardless of the number of amounts.
+ *
+ * Rates with the same time constant, e.g., those of several replications or MPI ranks, can
+ * be merged: the result is the rate of the union of their amounts.
+ */
+class DecayedRate
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param timeConstant the time constant of the decay
+     */
+    DecayedRate(Time timeConstant);
+    /// Constructor with a time constant of one second
+    DecayedRate();
+
+    /**
+     * \brief Add an amount. The amounts are usually added in time order, although
+     * earlier amounts are accepted.
+     * \param now the time of the amount
+     * \param amount the amount
+     */
+    void Add(Time now, double amount);
+
+    /**
+     * \brief Add the amounts of another rate to this rate
+     * \param other a rate with the same time constant
+     */
+    void Merge(const DecayedRate& other);
+
+    /**
+     * \param now the current time, not earlier than the last amount added
+     * \return the rate at the given time, in units per second
+     */
+    double GetRate(Time now) const;
+
+    /**
+     * \return the time constant of the decay
+     */
+    Time GetTimeConstant() const;
+
+    /**
+     * Clear the rate content.
+     */
+    void Clear();
+
+    /**
+     * \brief Write the content of the rate, to be read back by Deserialize.
+     * \param os the output stream
+     */
+    void Serialize(std::ostream& os) const;
+
+    /**
+     * \brief Replace the content of the rate by the one written by Serialize.
+     * \param is the input stream
+     * \return false if the stream does not hold a rate
+     */
+    bool Deserialize(std::istream& is);
+
+  private:
+    /**
+     * \param elapsed a delay
+     * \return the decay factor over the delay
+     */
+    double GetDecay(Time elapsed) const;
+
+    Time m_timeConstant; //!< time constant of the decay
+    Time m_last;         //!< time of the latest amount
+    double m_total;      //!< sum of the amounts, decayed to m_last
+};
+
+} // namespace ns3
+
+#endif /* NS3_DECAYED_RATE_H */
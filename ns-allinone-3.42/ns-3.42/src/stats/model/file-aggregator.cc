@@ -24,6 +24,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 namespace ns3
@@ -589,4 +590,40 @@ FileAggregator::Write10d(std::string context,
     }
 }
 
+void
+FileAggregator::Write2dBatch(const std::vector<double>& v1, const std::vector<double>& v2)
+{
+    NS_LOG_FUNCTION(this << v1.size());
+    NS_ASSERT_MSG(v1.size() == v2.size(), "The batch needs as many first as second values");
+
+    if (m_enabled)
+    {
+        std::ostringstream batch;
+        if (m_fileType == FORMATTED)
+        {
+            char buffer[500];
+            int maxBufferSize = 500;
+            for (size_t i = 0; i < v1.size(); i++)
+            {
+                buffer[0] = 0;
+                int charWritten = snprintf(buffer, maxBufferSize, m_2dFormat.c_str(), v1[i], v2[i]);
+                if (charWritten < 0)
+                {
+                    NS_LOG_DEBUG("Error writing values to output file");
+                }
+                batch << buffer << '\n';
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < v1.size(); i++)
+            {
+                batch << v1[i] << m_separator << v2[i] << '\n';
+            }
+        }
+        m_file << batch.str();
+        m_file.flush();
+    }
+}
+
 } // namespace ns3
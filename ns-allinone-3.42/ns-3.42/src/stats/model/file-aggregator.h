@@ -28,6 +28,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -336,6 +337,15 @@ class FileAggregator : public DataCollectionObject
                   double v9,
                   double v10);
 
+    /**
+     * \param v1 first values of the new data points.
+     * \param v2 second values of the new data points.
+     *
+     * \brief Writes a batch of 2D data points to the file, formatted as
+     * Write2d does, with a single write to the file.
+     */
+    void Write2dBatch(const std::vector<double>& v1, const std::vector<double>& v2);
+
   private:
     /// The file name.
     std::string m_outputFileName;
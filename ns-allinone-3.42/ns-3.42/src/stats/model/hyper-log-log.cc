@@ -0,0 +1,168 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "hyper-log-log.h"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \param key a key
+ * \return the hash of the key, mixed with the finalizer of SplitMix64
+ */
+static uint64_t
+HashKey(uint64_t key)
+{
+    uint64_t z = key + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+HyperLogLog::HyperLogLog(uint32_t precision)
+    : m_precision(precision),
+      m_registers(1U << precision, 0)
+{
+    NS_ASSERT_MSG(precision >= 4 && precision <= 18, "The precision must be in [4, 18]");
+}
+
+HyperLogLog::HyperLogLog()
+    : HyperLogLog(14)
+{
+}
+
+void
+HyperLogLog::Add(uint64_t key)
+{
+    const auto hash = HashKey(key);
+    const auto index = hash >> (64 - m_precision);
+    // position of the first set bit after the index bits, a sentinel bit bounds it
+    const auto rest = (hash << m_precision) | (1ULL << (m_precision - 1));
+    uint8_t rank = 1;
+    while (!(rest & (1ULL << (64 - rank))))
+    {
+        rank++;
+    }
+    m_registers[index] = std::max(m_registers[index], rank);
+}
+
+void
+HyperLogLog::Merge(const HyperLogLog& other)
+{
+    NS_ASSERT_MSG(m_precision == other.m_precision,
+                  "Only sketches with the same precision can be merged");
+    for (std::size_t i = 0; i < m_registers.size(); i++)
+    {
+        m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+}
+
+double
+HyperLogLog::GetEstimate() const
+{
+    const double m = m_registers.size();
+    double sum = 0;
+    uint32_t nEmpty = 0;
+    for (const auto reg : m_registers)
+    {
+        sum += std::ldexp(1.0, -reg);
+        nEmpty += (reg == 0);
+    }
+    double alpha;
+    switch (m_precision)
+    {
+    case 4:
+        alpha = 0.673;
+        break;
+    case 5:
+        alpha = 0.697;
+        break;
+    case 6:
+        alpha = 0.709;
+        break;
+    default:
+        alpha = 0.7213 / (1 + 1.079 / m);
+    }
+    const auto estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && nEmpty > 0)
+    {
+        // linear counting, more accurate for small cardinalities
+        return m * std::log(m / nEmpty);
+    }
+    // the 64-bit hashes make the large range correction unnecessary
+    return estimate;
+}
+
+double
+HyperLogLog::GetRelativeError() const
+{
+    return 1.04 / std::sqrt(m_registers.size());
+}
+
+uint32_t
+HyperLogLog::GetPrecision() const
+{
+    return m_precision;
+}
+
+void
+HyperLogLog::Clear()
+{
+    std::fill(m_registers.begin(), m_registers.end(), 0);
+}
+
+void
+HyperLogLog::Serialize(std::ostream& os) const
+{
+    // one character per register, the ranks are at most 64 - precision + 1
+    std::string registers(m_registers.size(), '0');
+    for (std::size_t i = 0; i < m_registers.size(); i++)
+    {
+        registers[i] += m_registers[i];
+    }
+    os << m_precision << " " << registers << "\n";
+}
+
+bool
+HyperLogLog::Deserialize(std::istream& is)
+{
+    uint32_t precision;
+    std::string registers;
+    if (!(is >> precision >> registers) || precision < 4 || precision > 18 ||
+        registers.size() != (1U << precision))
+    {
+        return false;
+    }
+    *this = HyperLogLog(precision);
+    for (std::size_t i = 0; i < m_registers.size(); i++)
+    {
+        if (registers[i] < '0' || registers[i] > '0' + 64 - static_cast<int>(precision) + 1)
+        {
+            Clear();
+            return false;
+        }
+        m_registers[i] = registers[i] - '0';
+    }
+    return true;
+}
+
+} // namespace ns3
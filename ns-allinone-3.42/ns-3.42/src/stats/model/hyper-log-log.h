@@ -0,0 +1,110 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef NS3_HYPER_LOG_LOG_H
+#define NS3_HYPER_LOG_LOG_H
+
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief HyperLogLog sketch, estimating the number of distinct keys added to it in a fixed
+ * amount of memory.
+ *
+ * The sketch is made of 2^precision registers of one byte. Each key is hashed, the first bits
+ * of the hash select a register, which keeps the largest position of the first set bit among
+ * the remaining bits of the hashes. The standard error of the estimate is 1.04 / sqrt(2^precision),
+ * e.g., 0.8% with the default precision of 14 (16 KiB of registers). Small cardinalities are
+ * estimated by linear counting of the empty registers.
+ *
+ * Sketches with the same precision, e.g., those of several replications or MPI ranks, can be
+ * merged by taking the maximum of their registers: the result is the sketch of the union of
+ * their keys. Serialize and Deserialize transport the registers as text.
+ *
+ * See P. Flajolet, E. Fusy, O. Gandouet and F. Meunier, "HyperLogLog: the analysis of a
+ * near-optimal cardinality estimation algorithm", AofA 2007.
+ */
+class HyperLogLog
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param precision the number of bits of the hash selecting the register, in [4, 18]
+     */
+    HyperLogLog(uint32_t precision);
+    /// Constructor with a precision of 14
+    HyperLogLog();
+
+    /**
+     * \brief Add a key
+     * \param key the key
+     */
+    void Add(uint64_t key);
+
+    /**
+     * \brief Add the keys of another sketch to this sketch
+     * \param other a sketch with the same precision
+     */
+    void Merge(const HyperLogLog& other);
+
+    /**
+     * \return an estimate of the number of distinct keys added to the sketch
+     */
+    double GetEstimate() const;
+
+    /**
+     * \return the standard error of the estimate, as a fraction of the estimate
+     */
+    double GetRelativeError() const;
+
+    /**
+     * \return the number of bits of the hash selecting the register
+     */
+    uint32_t GetPrecision() const;
+
+    /**
+     * Clear the sketch content.
+     */
+    void Clear();
+
+    /**
+     * \brief Write the content of the sketch, to be read back by Deserialize.
+     * \param os the output stream
+     */
+    void Serialize(std::ostream& os) const;
+
+    /**
+     * \brief Replace the content of the sketch by the one written by Serialize.
+     * \param is the input stream
+     * \return false if the stream does not hold a sketch
+     */
+    bool Deserialize(std::istream& is);
+
+  private:
+    uint32_t m_precision;             //!< number of bits of the hash selecting the register
+    std::vector<uint8_t> m_registers; //!< largest position of the first set bit, per register
+};
+
+} // namespace ns3
+
+#endif /* NS3_HYPER_LOG_LOG_H */
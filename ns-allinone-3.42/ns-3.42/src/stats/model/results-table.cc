@@ -0,0 +1,432 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "results-table.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ResultsTable");
+
+NS_OBJECT_ENSURE_REGISTERED(ResultsTable);
+
+TypeId
+ResultsTable::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ResultsTable")
+            .SetParent<Object>()
+            .SetGroupName("Stats")
+            .AddConstructor<ResultsTable>()
+            .AddAttribute("Format",
+                          "Output format of the table.",
+                          EnumValue(ResultsTable::CSV),
+                          MakeEnumAccessor<Format>(&ResultsTable::m_format),
+                          MakeEnumChecker(ResultsTable::CSV,
+                                          "CSV",
+                                          ResultsTable::COLUMNAR,
+                                          "COLUMNAR"))
+            .AddAttribute("BatchSize",
+                          "Number of rows handed over to the writer thread at once.",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&ResultsTable::m_batchSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxPendingBatches",
+                          "Number of batches waiting for the writer thread before "
+                          "the simulation blocks, bounding the memory used by the table.",
+                          UintegerValue(4),
+                          MakeUintegerAccessor(&ResultsTable::m_maxPendingBatches),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+ResultsTable::ResultsTable()
+    : m_format(CSV),
+      m_batchSize(4096),
+      m_maxPendingBatches(4),
+      m_open(false),
+      m_nextColumn(0),
+      m_nRows(0),
+      m_writing(false),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ResultsTable::~ResultsTable()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+ResultsTable::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+    Object::DoDispose();
+}
+
+std::string
+ResultsTable::GetExtension(Format format)
+{
+    return format == COLUMNAR ? ".rtab" : ".csv";
+}
+
+void
+ResultsTable::SetFormat(Format format)
+{
+    NS_LOG_FUNCTION(this << format);
+    NS_ASSERT_MSG(!m_open, "The format cannot be changed once the table is open");
+    m_format = format;
+}
+
+ResultsTable::Format
+ResultsTable::GetFormat() const
+{
+    return m_format;
+}
+
+void
+ResultsTable::AddColumn(const std::string& name, ColumnType type, int precision)
+{
+    NS_LOG_FUNCTION(this << name << type << precision);
+    NS_ASSERT_MSG(!m_open, "The schema cannot be changed once the table is open");
+    m_columns.push_back({name, type, precision});
+}
+
+uint32_t
+ResultsTable::GetNColumns() const
+{
+    return m_columns.size();
+}
+
+bool
+ResultsTable::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    NS_ASSERT_MSG(!m_open, "The table is already open");
+    NS_ABORT_MSG_IF(m_columns.empty(), "The table has no column");
+
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+    if (m_format == COLUMNAR)
+    {
+        mode |= std::ios_base::binary;
+    }
+    m_file.open(fileName, mode);
+    if (!m_file.is_open())
+    {
+        NS_LOG_ERROR("Unable to open " << fileName);
+        return false;
+    }
+    WriteHeader();
+
+    m_current = Batch();
+    m_current.columns.resize(m_columns.size());
+    m_nextColumn = 0;
+    m_nRows = 0;
+    m_stop = false;
+    m_writing = false;
+    m_open = true;
+    m_writer = std::thread(&ResultsTable::WriterLoop, this);
+    return true;
+}
+
+bool
+ResultsTable::IsOpen() const
+{
+    return m_open;
+}
+
+uint32_t
+ResultsTable::NextColumn(ColumnType type)
+{
+    NS_ASSERT_MSG(m_open, "The table is not open");
+    NS_ABORT_MSG_IF(m_nextColumn >= m_columns.size(), "Too many values in the row");
+    const Column& column = m_columns[m_nextColumn];
+    // Integers are accepted in REAL columns, everything else must match
+    NS_ABORT_MSG_IF(column.type != type && !(type == INTEGER && column.type == REAL),
+                    "Wrong type of value for column " << column.name);
+    return m_nextColumn++;
+}
+
+void
+ResultsTable::AddInteger(int64_t value)
+{
+    uint32_t column = NextColumn(INTEGER);
+    if (m_columns[column].type == REAL)
+    {
+        m_current.columns[column].reals.push_back(value);
+    }
+    else
+    {
+        m_current.columns[column].integers.push_back(value);
+    }
+}
+
+void
+ResultsTable::AddReal(double value)
+{
+    m_current.columns[NextColumn(REAL)].reals.push_back(value);
+}
+
+void
+ResultsTable::AddText(const std::string& value)
+{
+    m_current.columns[NextColumn(TEXT)].texts.push_back(value);
+}
+
+void
+ResultsTable::EndRow()
+{
+    NS_ABORT_MSG_IF(m_nextColumn != m_columns.size(),
+                    "Incomplete row: " << m_nextColumn << " of " << m_columns.size()
+                                       << " values");
+    m_nextColumn = 0;
+    m_current.nRows++;
+    m_nRows++;
+    if (m_current.nRows >= m_batchSize)
+    {
+        SubmitBatch();
+    }
+}
+
+uint64_t
+ResultsTable::GetNRows() const
+{
+    return m_nRows;
+}
+
+void
+ResultsTable::SubmitBatch()
+{
+    if (m_current.nRows == 0)
+    {
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return m_pending.size() < m_maxPendingBatches; });
+        m_pending.push_back(std::move(m_current));
+    }
+    m_changed.notify_all();
+
+    m_current = Batch();
+    m_current.columns.resize(m_columns.size());
+}
+
+void
+ResultsTable::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_open)
+    {
+        return;
+    }
+    NS_ABORT_MSG_IF(m_nextColumn != 0, "Flush in the middle of a row");
+    SubmitBatch();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+void
+ResultsTable::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_open)
+    {
+        return;
+    }
+    if (m_nextColumn != 0)
+    {
+        NS_LOG_WARN("Discarding an incomplete row");
+        for (ColumnData& data : m_current.columns)
+        {
+            data.integers.resize(std::min<std::size_t>(data.integers.size(), m_current.nRows));
+            data.reals.resize(std::min<std::size_t>(data.reals.size(), m_current.nRows));
+            data.texts.resize(std::min<std::size_t>(data.texts.size(), m_current.nRows));
+        }
+        m_nextColumn = 0;
+    }
+    SubmitBatch();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_all();
+    m_writer.join();
+    m_file.close();
+    m_open = false;
+}
+
+void
+ResultsTable::WriterLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_changed.wait(lock, [this] { return !m_pending.empty() || m_stop; });
+        if (m_pending.empty())
+        {
+            break;
+        }
+        Batch batch = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_writing = true;
+        lock.unlock();
+        m_changed.notify_all();
+
+        if (m_format == COLUMNAR)
+        {
+            WriteColumnar(batch);
+        }
+        else
+        {
+            WriteCsv(batch);
+        }
+        m_file.flush();
+
+        lock.lock();
+        m_writing = false;
+        m_changed.notify_all();
+    }
+}
+
+void
+ResultsTable::WriteHeader()
+{
+    if (m_format == CSV)
+    {
+        for (std::size_t i = 0; i < m_columns.size(); i++)
+        {
+            m_file << (i > 0 ? "," : "") << m_columns[i].name;
+        }
+        m_file << "\n";
+        return;
+    }
+
+    m_file.write("NS3RTAB1", 8);
+    uint32_t nColumns = m_columns.size();
+    m_file.write(reinterpret_cast<const char*>(&nColumns), sizeof(nColumns));
+    for (const Column& column : m_columns)
+    {
+        uint8_t type = column.type;
+        uint32_t length = column.name.size();
+        m_file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+        m_file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        m_file.write(column.name.data(), length);
+    }
+}
+
+void
+ResultsTable::WriteCsv(const Batch& batch)
+{
+    const std::streamsize defaultPrecision = m_file.precision();
+    for (uint32_t row = 0; row < batch.nRows; row++)
+    {
+        for (std::size_t i = 0; i < m_columns.size(); i++)
+        {
+            if (i > 0)
+            {
+                m_file << ',';
+            }
+            const ColumnData& data = batch.columns[i];
+            switch (m_columns[i].type)
+            {
+            case INTEGER:
+                m_file << data.integers[row];
+                break;
+            case REAL:
+                if (m_columns[i].precision >= 0)
+                {
+                    m_file << std::fixed << std::setprecision(m_columns[i].precision)
+                           << data.reals[row];
+                    m_file.unsetf(std::ios_base::floatfield);
+                    m_file.precision(defaultPrecision);
+                }
+                else
+                {
+                    m_file << data.reals[row];
+                }
+                break;
+            case TEXT: {
+                const std::string& text = data.texts[row];
+                if (text.find_first_of(",\"\n") == std::string::npos)
+                {
+                    m_file << text;
+                }
+                else
+                {
+                    m_file << '"';
+                    for (char c : text)
+                    {
+                        m_file << (c == '"' ? "\"\"" : std::string(1, c));
+                    }
+                    m_file << '"';
+                }
+                break;
+            }
+            }
+        }
+        m_file << '\n';
+    }
+}
+
+void
+ResultsTable::WriteColumnar(const Batch& batch)
+{
+    m_file.write(reinterpret_cast<const char*>(&batch.nRows), sizeof(batch.nRows));
+    for (std::size_t i = 0; i < m_columns.size(); i++)
+    {
+        const ColumnData& data = batch.columns[i];
+        switch (m_columns[i].type)
+        {
+        case INTEGER:
+            m_file.write(reinterpret_cast<const char*>(data.integers.data()),
+                         data.integers.size() * sizeof(int64_t));
+            break;
+        case REAL:
+            m_file.write(reinterpret_cast<const char*>(data.reals.data()),
+                         data.reals.size() * sizeof(double));
+            break;
+        case TEXT: {
+            std::vector<uint32_t> lengths;
+            lengths.reserve(data.texts.size());
+            for (const std::string& text : data.texts)
+            {
+                lengths.push_back(text.size());
+            }
+            m_file.write(reinterpret_cast<const char*>(lengths.data()),
+                         lengths.size() * sizeof(uint32_t));
+            for (const std::string& text : data.texts)
+            {
+                m_file.write(text.data(), text.size());
+            }
+            break;
+        }
+        }
+    }
+}
+
+} // namespace ns3
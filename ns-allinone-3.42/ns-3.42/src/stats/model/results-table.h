@@ -0,0 +1,261 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RESULTS_TABLE_H
+#define RESULTS_TABLE_H
+
+#include "ns3/object.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup dataoutput
+ *
+ * \brief Buffered, append-only results table with a fixed schema.
+ *
+ * Rows are accumulated column by column in memory and handed over in
+ * batches of BatchSize rows to a writer thread, which formats them and
+ * appends them to the output file.  The simulation thread only copies the
+ * values, it never formats nor writes to the file.
+ *
+ * Two formats are available:
+ *
+ * - CSV: a header line with the column names followed by one line per row.
+ * - COLUMNAR: a binary, append-only format.  The file starts with the magic
+ *   string "NS3RTAB1", the number of columns (uint32) and, for each column,
+ *   its type (uint8, see ColumnType), the length of its name (uint32) and its
+ *   name.  It is followed by the batches: the number of rows of the batch
+ *   (uint32), then each column stored contiguously: int64 values for INTEGER
+ *   columns, float64 values for REAL columns and, for TEXT columns, the
+ *   lengths of the strings (uint32) followed by their concatenated bytes.
+ *   Values are stored in the byte order of the host.
+ *
+ * The schema is defined with AddColumn before Open; the values of a row are
+ * then given in column order with Add and the row is terminated by EndRow.
+ */
+class ResultsTable : public Object
+{
+  public:
+    /// Output format of the table
+    enum Format
+    {
+        CSV,     //!< Comma-separated text
+        COLUMNAR //!< Binary column batches
+    };
+
+    /// Type of the values of a column
+    enum ColumnType : uint8_t
+    {
+        INTEGER = 0, //!< Signed 64-bit integers
+        REAL = 1,    //!< Double precision values
+        TEXT = 2     //!< Strings
+    };
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    ResultsTable();
+    ~ResultsTable() override;
+
+    /**
+     * \brief Get the usual file extension of a format.
+     * \param format the output format
+     * \return ".csv" or ".rtab"
+     */
+    static std::string GetExtension(Format format);
+
+    /**
+     * \brief Set the output format; must be called before Open.
+     * \param format the output format
+     */
+    void SetFormat(Format format);
+
+    /**
+     * \brief Get the output format.
+     * \return the output format
+     */
+    Format GetFormat() const;
+
+    /**
+     * \brief Append a column to the schema; must be called before Open.
+     * \param name the column name
+     * \param type the type of the values
+     * \param precision for REAL columns, number of decimals written in CSV
+     *        in fixed notation (negative for the default stream formatting)
+     */
+    void AddColumn(const std::string& name, ColumnType type, int precision = -1);
+
+    /**
+     * \brief Get the number of columns of the schema.
+     * \return the number of columns
+     */
+    uint32_t GetNColumns() const;
+
+    /**
+     * \brief Create the output file, write the header and start the writer thread.
+     * \param fileName the output file name
+     * \return true if the file could be created
+     */
+    bool Open(const std::string& fileName);
+
+    /**
+     * \return true if the table is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * \brief Set the value of the next column of the current row.
+     * \param value an integer value (INTEGER column)
+     */
+    void AddInteger(int64_t value);
+
+    /**
+     * \brief Set the value of the next column of the current row.
+     * \param value a real value (REAL column)
+     */
+    void AddReal(double value);
+
+    /**
+     * \brief Set the value of the next column of the current row.
+     * \param value a string (TEXT column)
+     */
+    void AddText(const std::string& value);
+
+    /**
+     * \brief Set the value of the next column of the current row, dispatching
+     * on the type of the value.
+     * \tparam T an arithmetic type or a type convertible to std::string
+     * \param value the value
+     * \return this table, to chain the values of a row
+     */
+    template <typename T>
+    ResultsTable& Add(const T& value);
+
+    /**
+     * \brief Terminate the current row; all the columns must have been set.
+     */
+    void EndRow();
+
+    /**
+     * \brief Hand the pending rows over to the writer thread and wait until
+     * everything has been written to the file.
+     */
+    void Flush();
+
+    /**
+     * \brief Flush the table, stop the writer thread and close the file.
+     */
+    void Close();
+
+    /**
+     * \return the number of rows added since Open
+     */
+    uint64_t GetNRows() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Description of a column
+    struct Column
+    {
+        std::string name; //!< Column name
+        ColumnType type;  //!< Type of the values
+        int precision;    //!< CSV precision of REAL values
+    };
+
+    /// Values of one column for the rows of a batch
+    struct ColumnData
+    {
+        std::vector<int64_t> integers; //!< INTEGER values
+        std::vector<double> reals;     //!< REAL values
+        std::vector<std::string> texts; //!< TEXT values
+    };
+
+    /// Rows handed over to the writer thread
+    struct Batch
+    {
+        uint32_t nRows{0};               //!< Number of rows
+        std::vector<ColumnData> columns; //!< Values, one entry per column
+    };
+
+    /// \return the column of the next value, checking its type
+    /// \param type the type of the value
+    uint32_t NextColumn(ColumnType type);
+    /// Queue the current batch for the writer thread
+    void SubmitBatch();
+    /// Body of the writer thread
+    void WriterLoop();
+    /// \param batch the rows to write in CSV
+    void WriteCsv(const Batch& batch);
+    /// \param batch the rows to write in the columnar format
+    void WriteColumnar(const Batch& batch);
+    /// Write the header of the file
+    void WriteHeader();
+
+    Format m_format;               //!< Output format
+    uint32_t m_batchSize;          //!< Number of rows per batch
+    uint32_t m_maxPendingBatches;  //!< Batches queued before Add blocks
+    std::vector<Column> m_columns; //!< Schema
+    std::ofstream m_file;          //!< Output file, only used by the writer thread once open
+    bool m_open;                   //!< Whether the table is open
+    Batch m_current;               //!< Batch being filled by the simulation
+    uint32_t m_nextColumn;         //!< Column of the next value of the current row
+    uint64_t m_nRows;              //!< Rows added since Open
+
+    std::thread m_writer;              //!< Writer thread
+    std::mutex m_mutex;                //!< Protects the fields below
+    std::condition_variable m_changed; //!< Signals a change of the fields below
+    std::deque<Batch> m_pending;       //!< Batches waiting for the writer thread
+    bool m_writing;                    //!< Whether the writer thread holds a batch
+    bool m_stop;                       //!< Whether the writer thread must exit
+};
+
+template <typename T>
+ResultsTable&
+ResultsTable::Add(const T& value)
+{
+    if constexpr (std::is_same_v<T, bool> || std::is_integral_v<T> || std::is_enum_v<T>)
+    {
+        AddInteger(static_cast<int64_t>(value));
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        AddReal(value);
+    }
+    else
+    {
+        AddText(std::string(value));
+    }
+    return *this;
+}
+
+} // namespace ns3
+
+#endif /* RESULTS_TABLE_H */
@@ -68,73 +68,42 @@ SqliteDataOutput::Output(DataCollector& dc)
     bool res;
 
     m_sqliteOut = new SQLiteOutput(m_dbFile);
+    m_sqliteOut->SetJournalWal();
 
     res = m_sqliteOut->SpinExec("CREATE TABLE IF NOT EXISTS Experiments (run, experiment, "
                                 "strategy, input, description text)");
     NS_ASSERT(res);
 
-    sqlite3_stmt* stmt;
-    res = m_sqliteOut->WaitPrepare(&stmt,
-                                   "INSERT INTO Experiments "
-                                   "(run, experiment, strategy, input, description)"
-                                   "values (?, ?, ?, ?, ?)");
-    NS_ASSERT(res);
-
-    // Create temporary strings to hold their value
-    // throughout the lifetime of the Bind and Step
-    // procedures
-    //
-    // DataCollector could return const std::string&,
-    // but that could break the python bindings
-    res = m_sqliteOut->Bind(stmt, 1, run);
-    NS_ASSERT(res);
-    std::string experimentLabel = dc.GetExperimentLabel();
-    res = m_sqliteOut->Bind(stmt, 2, experimentLabel);
-    NS_ASSERT(res);
-    std::string strategyLabel = dc.GetStrategyLabel();
-    res = m_sqliteOut->Bind(stmt, 3, strategyLabel);
-    NS_ASSERT(res);
-    std::string inputLabel = dc.GetInputLabel();
-    res = m_sqliteOut->Bind(stmt, 4, inputLabel);
-    NS_ASSERT(res);
-    std::string description = dc.GetDescription();
-    res = m_sqliteOut->Bind(stmt, 5, description);
-    NS_ASSERT(res);
-
-    res = m_sqliteOut->SpinStep(stmt);
-    NS_ASSERT(res);
-    res = m_sqliteOut->SpinFinalize(stmt);
-    NS_ASSERT(res == 0);
+    // The rows are written by the writer thread of the database, in
+    // batches inside transactions
+    uint32_t insert = m_sqliteOut->PrepareInsert("INSERT INTO Experiments "
+                                                 "(run, experiment, strategy, input, description)"
+                                                 "values (?, ?, ?, ?, ?)");
+    m_sqliteOut->Insert(insert,
+                        {run,
+                         dc.GetExperimentLabel(),
+                         dc.GetStrategyLabel(),
+                         dc.GetInputLabel(),
+                         dc.GetDescription()});
 
     res = m_sqliteOut->WaitExec("CREATE TABLE IF NOT EXISTS "
                                 "Metadata ( run text, key text, value)");
     NS_ASSERT(res);
 
-    res = m_sqliteOut->WaitPrepare(&stmt,
-                                   "INSERT INTO Metadata "
-                                   "(run, key, value)"
-                                   "values (?, ?, ?)");
-    NS_ASSERT(res);
-
+    insert = m_sqliteOut->PrepareInsert("INSERT INTO Metadata "
+                                        "(run, key, value)"
+                                        "values (?, ?, ?)");
     for (auto i = dc.MetadataBegin(); i != dc.MetadataEnd(); i++)
     {
-        std::pair<std::string, std::string> blob = (*i);
-        m_sqliteOut->SpinReset(stmt);
-        m_sqliteOut->Bind(stmt, 1, run);
-        m_sqliteOut->Bind(stmt, 2, blob.first);
-        m_sqliteOut->Bind(stmt, 3, blob.second);
-        m_sqliteOut->SpinStep(stmt);
+        m_sqliteOut->Insert(insert, {run, i->first, i->second});
     }
 
-    m_sqliteOut->SpinFinalize(stmt);
-
-    m_sqliteOut->SpinExec("BEGIN");
     SqliteOutputCallback callback(m_sqliteOut, run);
     for (auto i = dc.DataCalculatorBegin(); i != dc.DataCalculatorEnd(); i++)
     {
         (*i)->Output(callback);
     }
-    m_sqliteOut->SpinExec("COMMIT");
+    m_sqliteOut->Flush();
     // end SqliteDataOutput::Output
     m_sqliteOut->Unref();
 }
@@ -149,16 +118,13 @@ SqliteDataOutput::SqliteOutputCallback::SqliteOutputCallback(const Ptr<SQLiteOut
     m_db->WaitExec("CREATE TABLE IF NOT EXISTS Singletons "
                    "( run text, name text, variable text, value )");
 
-    m_db->WaitPrepare(&m_insertSingletonStatement,
-                      "INSERT INTO Singletons "
-                      "(run, name, variable, value)"
-                      "values (?, ?, ?, ?)");
-    m_db->Bind(m_insertSingletonStatement, 1, m_runLabel);
+    m_insertSingleton = m_db->PrepareInsert("INSERT INTO Singletons "
+                                            "(run, name, variable, value)"
+                                            "values (?, ?, ?, ?)");
 }
 
 SqliteDataOutput::SqliteOutputCallback::~SqliteOutputCallback()
 {
-    m_db->SpinFinalize(m_insertSingletonStatement);
 }
 
 void
@@ -198,11 +164,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_db->Insert(m_insertSingleton, {m_runLabel, key, variable, static_cast<int64_t>(val)});
 }
 
 void
@@ -212,11 +174,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_db->Insert(m_insertSingleton, {m_runLabel, key, variable, static_cast<int64_t>(val)});
 }
 
 void
@@ -226,11 +184,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_db->Insert(m_insertSingleton, {m_runLabel, key, variable, val});
 }
 
 void
@@ -240,11 +194,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val);
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_db->Insert(m_insertSingleton, {m_runLabel, key, variable, val});
 }
 
 void
@@ -254,11 +204,7 @@ SqliteDataOutput::SqliteOutputCallback::OutputSingleton(std::string key,
 {
     NS_LOG_FUNCTION(this << key << variable << val);
 
-    m_db->SpinReset(m_insertSingletonStatement);
-    m_db->Bind(m_insertSingletonStatement, 2, key);
-    m_db->Bind(m_insertSingletonStatement, 3, variable);
-    m_db->Bind(m_insertSingletonStatement, 4, val.GetTimeStep());
-    m_db->SpinStep(m_insertSingletonStatement);
+    m_db->Insert(m_insertSingleton, {m_runLabel, key, variable, val.GetTimeStep()});
 }
 
 } // namespace ns3
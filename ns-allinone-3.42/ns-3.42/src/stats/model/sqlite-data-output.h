@@ -24,8 +24,6 @@
 
 #include "ns3/nstime.h"
 
-struct sqlite3_stmt;
-
 namespace ns3
 {
 
@@ -127,8 +125,8 @@ class SqliteDataOutput : public DataOutputInterface
         Ptr<SQLiteOutput> m_db; //!< Db
         std::string m_runLabel; //!< Run label
 
-        /// Pointer to a Sqlite3 singleton statement
-        sqlite3_stmt* m_insertSingletonStatement;
+        /// Identifier of the asynchronous insert of the singletons
+        uint32_t m_insertSingleton;
     };
 
     Ptr<SQLiteOutput> m_sqliteOut; //!< Database
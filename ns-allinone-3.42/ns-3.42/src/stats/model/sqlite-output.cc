@@ -18,6 +18,7 @@
 #include "sqlite-output.h"
 
 #include "ns3/abort.h"
+#include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/nstime.h"
 
@@ -39,6 +40,21 @@ SQLiteOutput::~SQLiteOutput()
 {
     int rc = SQLITE_FAIL;
 
+    Flush();
+    if (m_writer.joinable())
+    {
+        {
+            std::unique_lock lock{m_queueMutex};
+            m_stop = true;
+        }
+        m_changed.notify_all();
+        m_writer.join();
+    }
+    for (auto stmt : m_statements)
+    {
+        SpinFinalize(stmt);
+    }
+
     rc = sqlite3_close_v2(m_db);
     NS_ABORT_MSG_UNLESS(rc == SQLITE_OK, "Failed to close DB");
 }
@@ -50,6 +66,142 @@ SQLiteOutput::SetJournalInMemory()
     SpinExec("PRAGMA journal_mode = MEMORY");
 }
 
+void
+SQLiteOutput::SetJournalWal()
+{
+    NS_LOG_FUNCTION(this);
+    // journal_mode returns the new mode as a row, let sqlite3_exec consume it
+    std::unique_lock lock{m_mutex};
+    int rc = sqlite3_exec(m_db, "PRAGMA journal_mode = WAL", nullptr, nullptr, nullptr);
+    CheckError(m_db, rc, "PRAGMA journal_mode = WAL", false);
+    rc = sqlite3_exec(m_db, "PRAGMA synchronous = NORMAL", nullptr, nullptr, nullptr);
+    CheckError(m_db, rc, "PRAGMA synchronous = NORMAL", false);
+}
+
+uint32_t
+SQLiteOutput::PrepareInsert(const std::string& cmd)
+{
+    NS_LOG_FUNCTION(this << cmd);
+    std::unique_lock lock{m_queueMutex};
+    m_inserts.push_back(cmd);
+    return m_inserts.size() - 1;
+}
+
+void
+SQLiteOutput::Insert(uint32_t insert, std::vector<Value> row)
+{
+    NS_ASSERT_MSG(insert < m_inserts.size(), "Unknown insert " << insert);
+    m_current.push_back({insert, std::move(row)});
+    if (m_current.size() >= m_batchSize)
+    {
+        SubmitBatch();
+    }
+}
+
+void
+SQLiteOutput::SetBatchSize(uint32_t rows)
+{
+    NS_LOG_FUNCTION(this << rows);
+    NS_ASSERT(rows > 0);
+    m_batchSize = rows;
+}
+
+void
+SQLiteOutput::SubmitBatch()
+{
+    if (m_current.empty())
+    {
+        return;
+    }
+    {
+        std::unique_lock lock{m_queueMutex};
+        m_pending.push_back(std::move(m_current));
+    }
+    m_current.clear();
+    m_changed.notify_all();
+    if (!m_writer.joinable())
+    {
+        m_writer = std::thread(&SQLiteOutput::WriterLoop, this);
+    }
+}
+
+void
+SQLiteOutput::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    SubmitBatch();
+    std::unique_lock lock{m_queueMutex};
+    m_changed.wait(lock, [this] { return m_pending.empty() && !m_writing; });
+}
+
+void
+SQLiteOutput::WriterLoop()
+{
+    std::unique_lock lock{m_queueMutex};
+    while (true)
+    {
+        m_changed.wait(lock, [this] { return !m_pending.empty() || m_stop; });
+        if (m_pending.empty())
+        {
+            return; // stopped
+        }
+        std::vector<Row> batch = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_writing = true;
+        // prepare the inserts registered since the last batch
+        while (m_statements.size() < m_inserts.size())
+        {
+            sqlite3_stmt* stmt = nullptr;
+            WaitPrepare(&stmt, m_inserts[m_statements.size()]);
+            m_statements.push_back(stmt);
+        }
+        lock.unlock();
+
+        WriteBatch(batch);
+
+        lock.lock();
+        m_writing = false;
+        m_changed.notify_all();
+    }
+}
+
+void
+SQLiteOutput::WriteBatch(const std::vector<Row>& batch)
+{
+    std::unique_lock lock{m_mutex};
+
+    SpinExec(m_db, "BEGIN");
+    for (const auto& row : batch)
+    {
+        sqlite3_stmt* stmt = m_statements[row.insert];
+        if (!stmt)
+        {
+            continue; // the command could not be prepared
+        }
+        SpinReset(stmt);
+        for (size_t i = 0; i < row.values.size(); i++)
+        {
+            int pos = static_cast<int>(i) + 1;
+            const Value& value = row.values[i];
+            if (const auto integer = std::get_if<int64_t>(&value))
+            {
+                sqlite3_bind_int64(stmt, pos, *integer);
+            }
+            else if (const auto real = std::get_if<double>(&value))
+            {
+                sqlite3_bind_double(stmt, pos, *real);
+            }
+            else
+            {
+                const std::string& text = std::get<std::string>(value);
+                sqlite3_bind_text(stmt, pos, text.c_str(), text.size(), SQLITE_STATIC);
+            }
+        }
+        CheckError(m_db, SpinStep(stmt), sqlite3_sql(stmt), false);
+    }
+    SpinExec(m_db, "COMMIT");
+}
+
 bool
 SQLiteOutput::SpinExec(const std::string& cmd) const
 {
@@ -20,9 +20,15 @@
 
 #include "ns3/simple-ref-count.h"
 
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <mutex>
 #include <sqlite3.h>
 #include <string>
+#include <thread>
+#include <variant>
+#include <vector>
 
 namespace ns3
 {
@@ -42,6 +48,15 @@ namespace ns3
  * the database is unique, using "Spin" methods will speed up database access.
  *
  * The database is opened in the constructor, and closed in the deconstructor.
+ *
+ * Rows can also be inserted asynchronously: an insert command is prepared
+ * once with PrepareInsert, and its rows are given to Insert. The rows are
+ * handed over in batches of SetBatchSize rows to a writer thread, which
+ * inserts each batch inside a single transaction, reusing the prepared
+ * statements. The caller never waits for the database, except in Flush,
+ * which waits until all the rows are written. The other methods must not
+ * be used on the tables written asynchronously until Flush returns, and
+ * must not start transactions while rows are pending.
  */
 class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
 {
@@ -63,6 +78,42 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
      */
     void SetJournalInMemory();
 
+    /**
+     * \brief Instruct SQLite to use a write-ahead log, so that readers do not block
+     * the writer, and to synchronize the log less often.
+     */
+    void SetJournalWal();
+
+    /// A value of a row inserted asynchronously
+    using Value = std::variant<int64_t, double, std::string>;
+
+    /**
+     * \brief Register an insert command for the asynchronous inserts
+     * \param cmd Command with one parameter per column, e.g.
+     *        "INSERT INTO t (a, b) VALUES (?, ?)"
+     * \return the identifier of the command, to give to Insert
+     */
+    uint32_t PrepareInsert(const std::string& cmd);
+
+    /**
+     * \brief Queue a row for the writer thread
+     * \param insert the identifier returned by PrepareInsert
+     * \param row the values bound to the parameters of the command, in order
+     */
+    void Insert(uint32_t insert, std::vector<Value> row);
+
+    /**
+     * \brief Set the number of rows handed over to the writer thread at once
+     * \param rows Number of rows per batch (and per transaction)
+     */
+    void SetBatchSize(uint32_t rows);
+
+    /**
+     * \brief Hand the pending rows over to the writer thread and wait until
+     * they are written to the database
+     */
+    void Flush();
+
     /**
      * \brief Execute a command until the return value is OK or an ERROR
      *
@@ -227,9 +278,39 @@ class SQLiteOutput : public SimpleRefCount<SQLiteOutput>
     static bool CheckError(sqlite3* db, int rc, const std::string& cmd, bool hardExit);
 
   private:
+    /// Row inserted asynchronously
+    struct Row
+    {
+        uint32_t insert;           //!< Identifier of the insert command
+        std::vector<Value> values; //!< Values of the row
+    };
+
+    /// Queue the current batch for the writer thread
+    void SubmitBatch();
+    /// Body of the writer thread
+    void WriterLoop();
+    /**
+     * \brief Insert rows inside a transaction
+     * \param batch the rows
+     */
+    void WriteBatch(const std::vector<Row>& batch);
+
     std::string m_dBname;       //!< Database name
     mutable std::mutex m_mutex; //!< Mutex
     sqlite3* m_db{nullptr};     //!< Database pointer
+
+    uint32_t m_batchSize{1000}; //!< Number of rows per batch
+    std::vector<Row> m_current; //!< Batch being filled by the caller
+
+    std::thread m_writer;                   //!< Writer thread, started by the first batch
+    std::mutex m_queueMutex;                //!< Protects the fields below
+    std::condition_variable m_changed;      //!< Signals a change of the fields below
+    std::deque<std::vector<Row>> m_pending; //!< Batches waiting for the writer thread
+    std::vector<std::string> m_inserts;     //!< Commands of the asynchronous inserts
+    bool m_writing{false};                  //!< Whether the writer thread holds a batch
+    bool m_stop{false};                     //!< Whether the writer thread must exit
+
+    std::vector<sqlite3_stmt*> m_statements; //!< Prepared inserts, only used by the writer
 };
 
 } // namespace ns3
@@ -0,0 +1,53 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "typed-probe.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TypedProbe");
+
+FileAggregatorBatch::FileAggregatorBatch(Ptr<FileAggregator> aggregator, uint32_t batchSize)
+    : m_aggregator(aggregator),
+      m_batchSize(batchSize)
+{
+    NS_LOG_FUNCTION(this << aggregator << batchSize);
+    NS_ASSERT(aggregator && batchSize > 0);
+    m_times.reserve(batchSize);
+    m_values.reserve(batchSize);
+}
+
+FileAggregatorBatch::~FileAggregatorBatch()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+}
+
+void
+FileAggregatorBatch::Flush()
+{
+    NS_LOG_FUNCTION(this << m_times.size());
+    if (!m_times.empty())
+    {
+        m_aggregator->Write2dBatch(m_times, m_values);
+        m_times.clear();
+        m_values.clear();
+    }
+}
+
+} // namespace ns3
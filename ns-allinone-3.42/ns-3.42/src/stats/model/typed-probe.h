@@ -0,0 +1,264 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TYPED_PROBE_H
+#define TYPED_PROBE_H
+
+#include "file-aggregator.h"
+
+#include "ns3/config.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup probes
+ *
+ * \brief A probe wired at compile time to its sink.
+ *
+ * A TypedProbe connects to trace sources exporting values of type T, and
+ * passes each value, with the current simulation time, to its sink, which
+ * is any type callable as sink(Time, T): a lambda, or an aggregator
+ * adapter such as FileAggregatorBatch. Unlike the Probe subclasses, the
+ * value does not go through an Output trace source nor a Config path to
+ * reach the aggregator: the sink is a member of the probe, called
+ * directly, and can be inlined.
+ *
+ * The trace sources are resolved once, when the probe is connected,
+ * either from an object or from a Config path.
+ *
+ * \code
+ *   auto probe = MakeTypedProbe<double>([](Time now, double value) { ... });
+ *   probe->ConnectByPath("/NodeList/0/$ns3::Ipv4L3Protocol/...");
+ *   auto fileProbe = Create<TypedProbe<double, FileAggregatorBatch>>(aggregator, 1024);
+ * \endcode
+ *
+ * \tparam T the type of the values
+ * \tparam Sink the type of the sink
+ */
+template <typename T, typename Sink>
+class TypedProbe : public SimpleRefCount<TypedProbe<T, Sink>>
+{
+  public:
+    /**
+     * \brief Construct the probe and its sink.
+     * \param args the arguments of the constructor of the sink
+     */
+    template <typename... SinkArgs>
+    explicit TypedProbe(SinkArgs&&... args)
+        : m_sink(std::forward<SinkArgs>(args)...),
+          m_value(),
+          m_enabled(true)
+    {
+    }
+
+    /**
+     * \brief Connect to a TracedValue trace source of an object.
+     * \param traceSource the name of the trace source
+     * \param obj the object
+     * \return true if the trace source was connected
+     */
+    bool ConnectByObject(std::string traceSource, Ptr<Object> obj)
+    {
+        return obj->TraceConnectWithoutContext(traceSource,
+                                               MakeCallback(&TypedProbe::ValueSink, this));
+    }
+
+    /**
+     * \brief Connect to a trace source of an object whose signature is
+     * void (T), such as the packet trace sources.
+     * \param traceSource the name of the trace source
+     * \param obj the object
+     * \return true if the trace source was connected
+     */
+    bool ConnectSamplesByObject(std::string traceSource, Ptr<Object> obj)
+    {
+        return obj->TraceConnectWithoutContext(traceSource,
+                                               MakeCallback(&TypedProbe::SampleSink, this));
+    }
+
+    /**
+     * \brief Connect to the TracedValue trace sources matching a Config path.
+     *
+     * The path is resolved once, the trace sources of the objects found are
+     * then connected directly.
+     *
+     * \param path the Config path, ending with the name of the trace source
+     * \return the number of trace sources connected
+     */
+    uint32_t ConnectByPath(std::string path)
+    {
+        std::string::size_type pos = path.rfind('/');
+        NS_ASSERT_MSG(pos != std::string::npos, "Invalid path " << path);
+        std::string traceSource = path.substr(pos + 1);
+        Config::MatchContainer matches = Config::LookupMatches(path.substr(0, pos));
+        uint32_t connected = 0;
+        for (auto it = matches.Begin(); it != matches.End(); ++it)
+        {
+            connected += ConnectByObject(traceSource, *it) ? 1 : 0;
+        }
+        return connected;
+    }
+
+    /**
+     * \brief Pass a value to the sink, as if a trace source emitted it.
+     * \param value the value
+     */
+    void SetValue(T value)
+    {
+        SampleSink(value);
+    }
+
+    /**
+     * \return the most recent value
+     */
+    T GetValue() const
+    {
+        return m_value;
+    }
+
+    /// Pass the values to the sink
+    void Enable()
+    {
+        m_enabled = true;
+    }
+
+    /// Drop the values instead of passing them to the sink
+    void Disable()
+    {
+        m_enabled = false;
+    }
+
+    /**
+     * \return true if the values are passed to the sink
+     */
+    bool IsEnabled() const
+    {
+        return m_enabled;
+    }
+
+    /**
+     * \return the sink
+     */
+    Sink& GetSink()
+    {
+        return m_sink;
+    }
+
+  private:
+    /**
+     * \brief Sink of the TracedValue trace sources.
+     * \param oldValue the previous value
+     * \param newValue the new value
+     */
+    void ValueSink(T oldValue, T newValue)
+    {
+        SampleSink(newValue);
+    }
+
+    /**
+     * \brief Sink of the trace sources exporting samples.
+     * \param value the value
+     */
+    void SampleSink(T value)
+    {
+        if (m_enabled)
+        {
+            m_value = value;
+            m_sink(Simulator::Now(), value);
+        }
+    }
+
+    Sink m_sink;    //!< Sink of the values
+    T m_value;      //!< Most recent value
+    bool m_enabled; //!< Whether the values are passed to the sink
+};
+
+/**
+ * \ingroup probes
+ *
+ * \brief Create a TypedProbe with a given sink.
+ *
+ * \tparam T the type of the values
+ * \tparam Sink the type of the sink
+ * \param sink the sink
+ * \return the probe
+ */
+template <typename T, typename Sink>
+Ptr<TypedProbe<T, Sink>>
+MakeTypedProbe(Sink sink)
+{
+    return Create<TypedProbe<T, Sink>>(std::move(sink));
+}
+
+/**
+ * \ingroup aggregator
+ *
+ * \brief Sink of a TypedProbe writing (time, value) points to a
+ * FileAggregator in batches.
+ *
+ * The points are buffered and written with FileAggregator::Write2dBatch
+ * every batchSize points, when Flush is called, and on destruction.
+ */
+class FileAggregatorBatch
+{
+  public:
+    /**
+     * \param aggregator the aggregator
+     * \param batchSize the number of points written at once
+     */
+    FileAggregatorBatch(Ptr<FileAggregator> aggregator, uint32_t batchSize = 256);
+    ~FileAggregatorBatch();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    FileAggregatorBatch(const FileAggregatorBatch&) = delete;
+    FileAggregatorBatch& operator=(const FileAggregatorBatch&) = delete;
+
+    /**
+     * \brief Add a point.
+     * \param now the time of the point, written in seconds
+     * \param value the value of the point
+     */
+    void operator()(Time now, double value)
+    {
+        m_times.push_back(now.GetSeconds());
+        m_values.push_back(value);
+        if (m_times.size() >= m_batchSize)
+        {
+            Flush();
+        }
+    }
+
+    /// Write the buffered points
+    void Flush();
+
+  private:
+    Ptr<FileAggregator> m_aggregator; //!< Aggregator
+    uint32_t m_batchSize;             //!< Number of points written at once
+    std::vector<double> m_times;      //!< Times of the buffered points
+    std::vector<double> m_values;     //!< Values of the buffered points
+};
+
+} // namespace ns3
+
+#endif // TYPED_PROBE_H
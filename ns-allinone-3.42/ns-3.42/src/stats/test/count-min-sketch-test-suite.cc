@@ -0,0 +1,106 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/count-min-sketch.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief CountMinSketch Test
+ */
+class CountMinSketchTestCase : public ns3::TestCase
+{
+  public:
+    CountMinSketchTestCase();
+    void DoRun() override;
+};
+
+CountMinSketchTestCase::CountMinSketchTestCase()
+    : ns3::TestCase("CountMinSketch")
+{
+}
+
+void
+CountMinSketchTestCase::DoRun()
+{
+    CountMinSketch sketch(0.01, 0.01);
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetWidth(), 512, "Width must be e/epsilon, rounded up");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetDepth(), 5, "Depth must be ln(1/delta), rounded up");
+
+    // many mice and a few elephants
+    const uint32_t nKeys = 5000;
+    for (uint32_t key = 1; key <= nKeys; key++)
+    {
+        sketch.Add(key, 10);
+    }
+    for (uint32_t key = 1; key <= 5; key++)
+    {
+        sketch.Add(key * 1000, 100000);
+    }
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetTotal(), 10 * nKeys + 500000, "");
+
+    uint32_t nExceeded = 0;
+    for (uint32_t key = 1; key <= nKeys; key++)
+    {
+        const uint64_t exact = 10 + (key % 1000 == 0 ? 100000 : 0);
+        const auto estimate = sketch.GetEstimate(key);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(estimate, exact, "Count-Min never underestimates");
+        if (estimate - exact > sketch.GetErrorBound())
+        {
+            nExceeded++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(nExceeded, nKeys / 100, "Error bound exceeded too often");
+    for (uint32_t key = 1; key <= 5; key++)
+    {
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(sketch.GetEstimate(key * 1000),
+                                    100010 + sketch.GetErrorBound(),
+                                    "Wrong estimate for an elephant flow");
+    }
+
+    // the merge of two sketches is the sketch of the union of their counts
+    CountMinSketch other(0.01, 0.01);
+    other.Add(1, 1000);
+    const auto estimate = sketch.GetEstimate(1) + other.GetEstimate(1);
+    sketch.Merge(other);
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetEstimate(1), estimate, "Wrong merged estimate");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetTotal(), 10 * nKeys + 501000, "Wrong merged total");
+
+    sketch.Clear();
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetTotal(), 0, "");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetEstimate(1000), 0, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief CountMinSketch TestSuite
+ */
+class CountMinSketchTestSuite : public TestSuite
+{
+  public:
+    CountMinSketchTestSuite();
+};
+
+CountMinSketchTestSuite::CountMinSketchTestSuite()
+    : TestSuite("count-min-sketch", Type::UNIT)
+{
+    AddTestCase(new CountMinSketchTestCase, TestCase::Duration::QUICK);
+}
+
+static CountMinSketchTestSuite g_cmSketchTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,147 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/dd-sketch.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief DdSketch Test
+ */
+class DdSketchTestCase : public ns3::TestCase
+{
+  public:
+    DdSketchTestCase();
+    void DoRun() override;
+};
+
+DdSketchTestCase::DdSketchTestCase()
+    : ns3::TestCase("DdSketch")
+{
+}
+
+void
+DdSketchTestCase::DoRun()
+{
+    const double alpha = 0.01;
+
+    {
+        // Testing the relative accuracy of the quantiles
+        DdSketch sketch(alpha, 2048);
+        const uint32_t n = 10000;
+        for (uint32_t i = 1; i <= n; i++)
+        {
+            sketch.AddValue(i * 1e-4);
+        }
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), n, "");
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetCollapsedCount(), 0, "");
+        for (const auto q : {0.0, 0.25, 0.5, 0.9, 0.99, 1.0})
+        {
+            const auto exact = (1 + std::floor(q * (n - 1))) * 1e-4;
+            NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(q),
+                                      exact,
+                                      alpha * exact,
+                                      "Wrong estimate of quantile " << q);
+        }
+        // the number of bins grows with the logarithm of the range only
+        NS_TEST_EXPECT_MSG_LT(sketch.GetNBins(), 500, "Too many bins");
+
+        sketch.Clear();
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), 0, "");
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetNBins(), 0, "");
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetQuantile(0.5), 0, "");
+    }
+
+    {
+        // Testing zeros
+        DdSketch sketch(alpha, 2048);
+        for (uint32_t i = 0; i < 60; i++)
+        {
+            sketch.AddValue(0);
+        }
+        for (uint32_t i = 0; i < 40; i++)
+        {
+            sketch.AddValue(2.0);
+        }
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetQuantile(0.5), 0, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(0.9), 2.0, alpha * 2.0, "");
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetNBins(), 1, "");
+    }
+
+    {
+        // Testing the collapse of the lowest bins, in both growth directions
+        DdSketch sketch(alpha, 100);
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            sketch.AddValue(1e-6);
+            sketch.AddValue(1.0);
+            sketch.AddValue(1e-8);
+        }
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetNBins(), 100, "The number of bins is not bounded");
+        NS_TEST_EXPECT_MSG_EQ(sketch.GetCollapsedCount(), 2000, "");
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(1.0), 1.0, alpha, "");
+        NS_TEST_EXPECT_MSG_LT(sketch.GetQuantile(0.5), 1.0, "Collapsed values must stay low");
+    }
+
+    {
+        // Testing the merge of the sketches of two halves of the data, and its transport
+        DdSketch low(alpha, 2048);
+        DdSketch high(alpha, 2048);
+        DdSketch all(alpha, 2048);
+        for (uint32_t i = 1; i <= 1000; i++)
+        {
+            (i <= 500 ? low : high).AddValue(i * 1e-3);
+            all.AddValue(i * 1e-3);
+        }
+        std::stringstream ss;
+        high.Serialize(ss);
+        DdSketch received;
+        NS_TEST_EXPECT_MSG_EQ(received.Deserialize(ss), true, "Unable to read the sketch");
+        low.Merge(received);
+        NS_TEST_EXPECT_MSG_EQ(low.GetCount(), all.GetCount(), "");
+        NS_TEST_EXPECT_MSG_EQ(low.GetNBins(), all.GetNBins(), "");
+        for (const auto q : {0.0, 0.5, 0.95, 1.0})
+        {
+            NS_TEST_EXPECT_MSG_EQ(low.GetQuantile(q),
+                                  all.GetQuantile(q),
+                                  "The merged sketch differs for quantile " << q);
+        }
+    }
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief DdSketch TestSuite
+ */
+class DdSketchTestSuite : public TestSuite
+{
+  public:
+    DdSketchTestSuite();
+};
+
+DdSketchTestSuite::DdSketchTestSuite()
+    : TestSuite("dd-sketch", Type::UNIT)
+{
+    AddTestCase(new DdSketchTestCase, TestCase::Duration::QUICK);
+}
+
+static DdSketchTestSuite g_ddSketchTestSuite; //!< Static variable for test initialization
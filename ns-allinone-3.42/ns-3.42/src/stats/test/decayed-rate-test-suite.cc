@@ -0,0 +1,100 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/decayed-rate.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief DecayedRate Test
+ */
+class DecayedRateTestCase : public ns3::TestCase
+{
+  public:
+    DecayedRateTestCase();
+    void DoRun() override;
+};
+
+DecayedRateTestCase::DecayedRateTestCase()
+    : ns3::TestCase("DecayedRate")
+{
+}
+
+void
+DecayedRateTestCase::DoRun()
+{
+    // 1000 bytes per millisecond, i.e., 1e6 bytes per second
+    DecayedRate rate(MilliSeconds(100));
+    for (uint32_t i = 1; i <= 2000; i++)
+    {
+        rate.Add(MilliSeconds(i), 1000);
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(rate.GetRate(Seconds(2)), 1e6, 1e4, "Wrong steady rate");
+
+    // the rate decays by e after one time constant without traffic
+    NS_TEST_EXPECT_MSG_EQ_TOL(rate.GetRate(MilliSeconds(2100)),
+                              rate.GetRate(Seconds(2)) / std::exp(1.0),
+                              1,
+                              "Wrong decay");
+
+    // the streams of two ranks, merged, give the rate of the whole stream
+    DecayedRate even(MilliSeconds(100));
+    DecayedRate odd(MilliSeconds(100));
+    for (uint32_t i = 1; i <= 2000; i++)
+    {
+        (i % 2 ? odd : even).Add(MilliSeconds(i), 1000);
+    }
+    odd.Merge(even);
+    NS_TEST_EXPECT_MSG_EQ_TOL(odd.GetRate(Seconds(2)),
+                              rate.GetRate(Seconds(2)),
+                              1e-6 * rate.GetRate(Seconds(2)),
+                              "Wrong merged rate");
+
+    std::stringstream ss;
+    odd.Serialize(ss);
+    DecayedRate copy;
+    NS_TEST_EXPECT_MSG_EQ(copy.Deserialize(ss), true, "Unable to read the rate");
+    NS_TEST_EXPECT_MSG_EQ(copy.GetTimeConstant(), MilliSeconds(100), "Wrong time constant");
+    NS_TEST_EXPECT_MSG_EQ(copy.GetRate(Seconds(3)), odd.GetRate(Seconds(3)), "Wrong content");
+
+    rate.Clear();
+    NS_TEST_EXPECT_MSG_EQ(rate.GetRate(Seconds(3)), 0, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief DecayedRate TestSuite
+ */
+class DecayedRateTestSuite : public TestSuite
+{
+  public:
+    DecayedRateTestSuite();
+};
+
+DecayedRateTestSuite::DecayedRateTestSuite()
+    : TestSuite("decayed-rate", Type::UNIT)
+{
+    AddTestCase(new DecayedRateTestCase, TestCase::Duration::QUICK);
+}
+
+static DecayedRateTestSuite g_decayedRateTestSuite; //!< Static variable for test initialization
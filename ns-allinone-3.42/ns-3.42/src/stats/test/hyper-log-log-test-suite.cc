@@ -0,0 +1,108 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/hyper-log-log.h"
+#include "ns3/test.h"
+
+#include <cmath>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief HyperLogLog Test
+ */
+class HyperLogLogTestCase : public ns3::TestCase
+{
+  public:
+    HyperLogLogTestCase();
+    void DoRun() override;
+};
+
+HyperLogLogTestCase::HyperLogLogTestCase()
+    : ns3::TestCase("HyperLogLog")
+{
+}
+
+void
+HyperLogLogTestCase::DoRun()
+{
+    HyperLogLog sketch(12);
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetEstimate(), 0, "An empty sketch has no key");
+
+    // small cardinalities, with duplicates
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        for (uint64_t key = 0; key < 100; key++)
+        {
+            sketch.Add(key);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetEstimate(), 100, 3, "Wrong small cardinality");
+
+    // large cardinalities, 4 standard errors
+    HyperLogLog a(12);
+    HyperLogLog b(12);
+    const uint64_t n = 200000;
+    for (uint64_t key = 0; key < n; key++)
+    {
+        a.Add(key);
+        if (key >= n / 2)
+        {
+            b.Add(key + n / 2);
+        }
+    }
+    const auto tolerance = 4 * a.GetRelativeError();
+    NS_TEST_EXPECT_MSG_EQ_TOL(a.GetEstimate(), n, tolerance * n, "Wrong large cardinality");
+
+    // the union of [0, n) and [n, 1.5 n)
+    a.Merge(b);
+    NS_TEST_EXPECT_MSG_EQ_TOL(a.GetEstimate(), 1.5 * n, tolerance * 1.5 * n, "Wrong union");
+
+    std::stringstream ss;
+    a.Serialize(ss);
+    HyperLogLog c;
+    NS_TEST_EXPECT_MSG_EQ(c.Deserialize(ss), true, "Unable to read the sketch");
+    NS_TEST_EXPECT_MSG_EQ(c.GetPrecision(), 12, "Wrong precision");
+    NS_TEST_EXPECT_MSG_EQ(c.GetEstimate(), a.GetEstimate(), "Wrong content");
+
+    std::stringstream bad("12 0123");
+    NS_TEST_EXPECT_MSG_EQ(c.Deserialize(bad), false, "Truncated registers are not a sketch");
+
+    a.Clear();
+    NS_TEST_EXPECT_MSG_EQ(a.GetEstimate(), 0, "");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief HyperLogLog TestSuite
+ */
+class HyperLogLogTestSuite : public TestSuite
+{
+  public:
+    HyperLogLogTestSuite();
+};
+
+HyperLogLogTestSuite::HyperLogLogTestSuite()
+    : TestSuite("hyper-log-log", Type::UNIT)
+{
+    AddTestCase(new HyperLogLogTestCase, TestCase::Duration::QUICK);
+}
+
+static HyperLogLogTestSuite g_hllTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,211 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/results-table.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Fill a table with the same rows for both formats.
+ *
+ * \param table the table, opened by the caller
+ * \param nRows the number of rows
+ */
+static void
+FillTable(Ptr<ResultsTable> table, uint32_t nRows)
+{
+    for (uint32_t i = 0; i < nRows; i++)
+    {
+        table->Add(i).Add(i * 0.5).Add(i % 2 ? std::string("odd, \"quoted\"") : "even");
+        table->EndRow();
+    }
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief CSV output of ResultsTable
+ */
+class ResultsTableCsvTestCase : public TestCase
+{
+  public:
+    ResultsTableCsvTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ResultsTableCsvTestCase::ResultsTableCsvTestCase()
+    : TestCase("ResultsTable CSV output")
+{
+}
+
+void
+ResultsTableCsvTestCase::DoRun()
+{
+    const uint32_t nRows = 10;
+    std::string fileName = CreateTempDirFilename("results-table.csv");
+    Ptr<ResultsTable> table = CreateObject<ResultsTable>();
+    table->SetAttribute("BatchSize", UintegerValue(3));
+    table->AddColumn("Index", ResultsTable::INTEGER);
+    table->AddColumn("Value", ResultsTable::REAL, 2);
+    table->AddColumn("Label", ResultsTable::TEXT);
+    NS_TEST_ASSERT_MSG_EQ(table->Open(fileName), true, "Unable to open " << fileName);
+    FillTable(table, nRows);
+    table->Close();
+    NS_TEST_ASSERT_MSG_EQ(table->GetNRows(), nRows, "Wrong number of rows");
+
+    std::ifstream file(fileName);
+    std::string line;
+    std::getline(file, line);
+    NS_TEST_ASSERT_MSG_EQ(line, "Index,Value,Label", "Wrong header");
+    for (uint32_t i = 0; i < nRows; i++)
+    {
+        std::ostringstream expected;
+        expected << i << "," << std::fixed << std::setprecision(2) << i * 0.5 << ","
+                 << (i % 2 ? "\"odd, \"\"quoted\"\"\"" : "even");
+        NS_TEST_ASSERT_MSG_EQ(std::getline(file, line).good(), true, "Missing row " << i);
+        NS_TEST_ASSERT_MSG_EQ(line, expected.str(), "Wrong row " << i);
+    }
+    NS_TEST_ASSERT_MSG_EQ(std::getline(file, line).good(), false, "Unexpected extra row");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Columnar output of ResultsTable
+ */
+class ResultsTableColumnarTestCase : public TestCase
+{
+  public:
+    ResultsTableColumnarTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ResultsTableColumnarTestCase::ResultsTableColumnarTestCase()
+    : TestCase("ResultsTable columnar output")
+{
+}
+
+/**
+ * Read a value of the host byte order from a stream.
+ * \tparam T the type of the value
+ * \param file the stream
+ * \return the value
+ */
+template <typename T>
+static T
+ReadValue(std::istream& file)
+{
+    T value{};
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+void
+ResultsTableColumnarTestCase::DoRun()
+{
+    const uint32_t nRows = 10;
+    const uint32_t batchSize = 4;
+    std::string fileName = CreateTempDirFilename("results-table.rtab");
+    Ptr<ResultsTable> table = CreateObject<ResultsTable>();
+    table->SetFormat(ResultsTable::COLUMNAR);
+    table->SetAttribute("BatchSize", UintegerValue(batchSize));
+    table->AddColumn("Index", ResultsTable::INTEGER);
+    table->AddColumn("Value", ResultsTable::REAL);
+    table->AddColumn("Label", ResultsTable::TEXT);
+    NS_TEST_ASSERT_MSG_EQ(table->Open(fileName), true, "Unable to open " << fileName);
+    FillTable(table, 6);
+    table->Flush();
+    FillTable(table, nRows - 6);
+    table->Dispose();
+
+    std::ifstream file(fileName, std::ios_base::binary);
+    char magic[8];
+    file.read(magic, sizeof(magic));
+    NS_TEST_ASSERT_MSG_EQ(std::memcmp(magic, "NS3RTAB1", 8), 0, "Wrong magic string");
+    NS_TEST_ASSERT_MSG_EQ(ReadValue<uint32_t>(file), 3, "Wrong number of columns");
+    const char* names[] = {"Index", "Value", "Label"};
+    for (uint8_t column = 0; column < 3; column++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(ReadValue<uint8_t>(file), column, "Wrong column type");
+        std::string name(ReadValue<uint32_t>(file), '\0');
+        file.read(name.data(), name.size());
+        NS_TEST_ASSERT_MSG_EQ(name, names[column], "Wrong column name");
+    }
+
+    // Batches of 4 and 2 rows before the flush, then 4 rows at the closing
+    uint32_t row = 0;
+    for (uint32_t expectedRows : {4, 2, 4})
+    {
+        uint32_t batchRows = ReadValue<uint32_t>(file);
+        NS_TEST_ASSERT_MSG_EQ(batchRows, expectedRows, "Wrong batch size");
+        for (uint32_t i = 0; i < batchRows; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(ReadValue<int64_t>(file), (row + i) % 6, "Wrong integer");
+        }
+        for (uint32_t i = 0; i < batchRows; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(ReadValue<double>(file), ((row + i) % 6) * 0.5, "Wrong real");
+        }
+        std::vector<uint32_t> lengths;
+        for (uint32_t i = 0; i < batchRows; i++)
+        {
+            lengths.push_back(ReadValue<uint32_t>(file));
+        }
+        for (uint32_t i = 0; i < batchRows; i++)
+        {
+            std::string text(lengths[i], '\0');
+            file.read(text.data(), text.size());
+            std::string expected = ((row + i) % 6) % 2 ? "odd, \"quoted\"" : "even";
+            NS_TEST_ASSERT_MSG_EQ(text, expected, "Wrong text");
+        }
+        row += batchRows;
+    }
+    file.peek();
+    NS_TEST_ASSERT_MSG_EQ(file.eof(), true, "Unexpected trailing data");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief ResultsTable TestSuite
+ */
+class ResultsTableTestSuite : public TestSuite
+{
+  public:
+    ResultsTableTestSuite();
+};
+
+ResultsTableTestSuite::ResultsTableTestSuite()
+    : TestSuite("results-table", Type::UNIT)
+{
+    AddTestCase(new ResultsTableCsvTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ResultsTableColumnarTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static ResultsTableTestSuite g_resultsTableTestSuite;
@@ -0,0 +1,112 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ptr.h"
+#include "ns3/sqlite-output.h"
+#include "ns3/test.h"
+
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Asynchronous inserts of SQLiteOutput
+ */
+class SQLiteOutputInsertTestCase : public TestCase
+{
+  public:
+    SQLiteOutputInsertTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SQLiteOutputInsertTestCase::SQLiteOutputInsertTestCase()
+    : TestCase("SQLiteOutput asynchronous inserts")
+{
+}
+
+void
+SQLiteOutputInsertTestCase::DoRun()
+{
+    const int64_t nRows = 100;
+    std::string fileName = CreateTempDirFilename("sqlite-output.db");
+    Ptr<SQLiteOutput> db = Create<SQLiteOutput>(fileName);
+    db->SetJournalWal();
+    db->SetBatchSize(7);
+    NS_TEST_ASSERT_MSG_EQ(db->SpinExec("CREATE TABLE Rows (id, value, label)"),
+                          true,
+                          "Unable to create the table");
+    NS_TEST_ASSERT_MSG_EQ(db->SpinExec("CREATE TABLE Others (id)"),
+                          true,
+                          "Unable to create the table");
+
+    uint32_t rows = db->PrepareInsert("INSERT INTO Rows (id, value, label) VALUES (?, ?, ?)");
+    uint32_t others = db->PrepareInsert("INSERT INTO Others (id) VALUES (?)");
+    for (int64_t i = 0; i < nRows; i++)
+    {
+        db->Insert(rows, {i, i * 0.5, i % 2 ? std::string("odd") : std::string("even")});
+        if (i % 10 == 0)
+        {
+            db->Insert(others, {i});
+        }
+    }
+    db->Flush();
+
+    sqlite3_stmt* stmt;
+    NS_TEST_ASSERT_MSG_EQ(db->WaitPrepare(&stmt,
+                                          "SELECT COUNT(*), SUM(id), SUM(value), "
+                                          "SUM(label = 'odd') FROM Rows"),
+                          true,
+                          "Unable to prepare the query");
+    NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "No result");
+    NS_TEST_ASSERT_MSG_EQ(sqlite3_column_int64(stmt, 0), nRows, "Wrong number of rows");
+    NS_TEST_ASSERT_MSG_EQ(sqlite3_column_int64(stmt, 1), nRows * (nRows - 1) / 2, "Wrong ids");
+    NS_TEST_ASSERT_MSG_EQ_TOL(sqlite3_column_double(stmt, 2),
+                              nRows * (nRows - 1) / 4.0,
+                              1e-9,
+                              "Wrong values");
+    NS_TEST_ASSERT_MSG_EQ(sqlite3_column_int64(stmt, 3), nRows / 2, "Wrong labels");
+    SQLiteOutput::SpinFinalize(stmt);
+
+    NS_TEST_ASSERT_MSG_EQ(db->WaitPrepare(&stmt, "SELECT COUNT(*) FROM Others"),
+                          true,
+                          "Unable to prepare the query");
+    NS_TEST_ASSERT_MSG_EQ(SQLiteOutput::SpinStep(stmt), SQLITE_ROW, "No result");
+    NS_TEST_ASSERT_MSG_EQ(sqlite3_column_int64(stmt, 0), nRows / 10, "Wrong number of rows");
+    SQLiteOutput::SpinFinalize(stmt);
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief SQLiteOutput TestSuite
+ */
+class SQLiteOutputTestSuite : public TestSuite
+{
+  public:
+    SQLiteOutputTestSuite();
+};
+
+SQLiteOutputTestSuite::SQLiteOutputTestSuite()
+    : TestSuite("sqlite-output", Type::UNIT)
+{
+    AddTestCase(new SQLiteOutputInsertTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static SQLiteOutputTestSuite g_sqliteOutputTestSuite;
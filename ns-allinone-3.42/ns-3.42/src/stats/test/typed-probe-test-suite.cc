@@ -0,0 +1,217 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/names.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+#include "ns3/typed-probe.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Object exporting a traced value and a sample trace source.
+ */
+class TypedProbeEmitter : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * TracedCallback signature of the samples.
+     * \param [in] sample The sample.
+     */
+    typedef void (*SampleTracedCallback)(uint32_t sample);
+
+    TracedValue<double> m_value;            //!< Traced value
+    TracedCallback<uint32_t> m_sampleTrace; //!< Sample trace source
+};
+
+TypeId
+TypedProbeEmitter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TypedProbeEmitter")
+            .SetParent<Object>()
+            .SetGroupName("Stats")
+            .AddTraceSource("Value",
+                            "A traced value",
+                            MakeTraceSourceAccessor(&TypedProbeEmitter::m_value),
+                            "ns3::TracedValueCallback::Double")
+            .AddTraceSource("Sample",
+                            "A sample",
+                            MakeTraceSourceAccessor(&TypedProbeEmitter::m_sampleTrace),
+                            "ns3::TypedProbeEmitter::SampleTracedCallback");
+    return tid;
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief TypedProbe connected to trace sources, with a lambda sink
+ */
+class TypedProbeConnectTestCase : public TestCase
+{
+  public:
+    TypedProbeConnectTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TypedProbeConnectTestCase::TypedProbeConnectTestCase()
+    : TestCase("TypedProbe connected by object and by path")
+{
+}
+
+void
+TypedProbeConnectTestCase::DoRun()
+{
+    Ptr<TypedProbeEmitter> emitter = CreateObject<TypedProbeEmitter>();
+    Names::Add("typed-probe-emitter", emitter);
+
+    std::vector<std::pair<Time, double>> values;
+    auto valueProbe = MakeTypedProbe<double>(
+        [&values](Time now, double value) { values.emplace_back(now, value); });
+    NS_TEST_ASSERT_MSG_EQ(valueProbe->ConnectByPath("/Names/typed-probe-emitter/Value"),
+                          1,
+                          "The traced value is not connected");
+
+    uint64_t total = 0;
+    auto sampleProbe =
+        MakeTypedProbe<uint32_t>([&total](Time, uint32_t sample) { total += sample; });
+    NS_TEST_ASSERT_MSG_EQ(sampleProbe->ConnectSamplesByObject("Sample", emitter),
+                          true,
+                          "The sample trace source is not connected");
+
+    Simulator::Schedule(Seconds(1), [emitter]() { emitter->m_value = 1.5; });
+    Simulator::Schedule(Seconds(2), [emitter]() { emitter->m_value = 2.5; });
+    Simulator::Schedule(Seconds(3), [valueProbe]() { valueProbe->Disable(); });
+    Simulator::Schedule(Seconds(4), [emitter]() { emitter->m_value = 3.5; });
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        Simulator::Schedule(Seconds(i), [emitter, i]() { emitter->m_sampleTrace(i); });
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+    Names::Clear();
+
+    NS_TEST_ASSERT_MSG_EQ(values.size(), 2, "Wrong number of values");
+    NS_TEST_ASSERT_MSG_EQ(values[0].first, Seconds(1), "Wrong time");
+    NS_TEST_ASSERT_MSG_EQ(values[0].second, 1.5, "Wrong value");
+    NS_TEST_ASSERT_MSG_EQ(values[1].first, Seconds(2), "Wrong time");
+    NS_TEST_ASSERT_MSG_EQ(values[1].second, 2.5, "Wrong value");
+    NS_TEST_ASSERT_MSG_EQ(valueProbe->GetValue(), 2.5, "Wrong last value");
+    NS_TEST_ASSERT_MSG_EQ(total, 55, "Wrong sum of the samples");
+    NS_TEST_ASSERT_MSG_EQ(sampleProbe->GetValue(), 10, "Wrong last sample");
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief Batches of FileAggregatorBatch are written as the single points of Write2d
+ */
+class FileAggregatorBatchTestCase : public TestCase
+{
+  public:
+    FileAggregatorBatchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FileAggregatorBatchTestCase::FileAggregatorBatchTestCase()
+    : TestCase("FileAggregatorBatch output")
+{
+}
+
+void
+FileAggregatorBatchTestCase::DoRun()
+{
+    const uint32_t nPoints = 25;
+    for (auto fileType : {FileAggregator::SPACE_SEPARATED, FileAggregator::FORMATTED})
+    {
+        std::string singleName = CreateTempDirFilename("file-aggregator-single.txt");
+        std::string batchName = CreateTempDirFilename("file-aggregator-batch.txt");
+        {
+            Ptr<FileAggregator> single = CreateObject<FileAggregator>(singleName, fileType);
+            Ptr<FileAggregator> batched = CreateObject<FileAggregator>(batchName, fileType);
+            if (fileType == FileAggregator::FORMATTED)
+            {
+                single->Set2dFormat("%.3f -> %e");
+                batched->Set2dFormat("%.3f -> %e");
+            }
+            auto probe = Create<TypedProbe<double, FileAggregatorBatch>>(batched, 4);
+            for (uint32_t i = 0; i < nPoints; i++)
+            {
+                Simulator::Schedule(MilliSeconds(10 * i), [single, probe, i]() {
+                    single->Write2d("single", Simulator::Now().GetSeconds(), i / 3.0);
+                    probe->SetValue(i / 3.0);
+                });
+            }
+            Simulator::Run();
+            Simulator::Destroy();
+            probe->GetSink().Flush();
+        }
+
+        std::ifstream singleFile(singleName);
+        std::ifstream batchFile(batchName);
+        std::ostringstream singleContents;
+        std::ostringstream batchContents;
+        singleContents << singleFile.rdbuf();
+        batchContents << batchFile.rdbuf();
+        NS_TEST_ASSERT_MSG_EQ(batchContents.str(),
+                              singleContents.str(),
+                              "The batches differ from the single points");
+        std::string contents = singleContents.str();
+        NS_TEST_ASSERT_MSG_EQ(std::count(contents.begin(), contents.end(), '\n'),
+                              nPoints,
+                              "Wrong number of points");
+    }
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief TypedProbe TestSuite
+ */
+class TypedProbeTestSuite : public TestSuite
+{
+  public:
+    TypedProbeTestSuite();
+};
+
+TypedProbeTestSuite::TypedProbeTestSuite()
+    : TestSuite("typed-probe", Type::UNIT)
+{
+    AddTestCase(new TypedProbeConnectTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FileAggregatorBatchTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static TypedProbeTestSuite g_typedProbeTestSuite;
@@ -0,0 +1,215 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/application-container.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/data-rate.h"
+#include "ns3/fluid-bulk-send-application.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * Check that a fluid bulk transfer fills a bottleneck link on its own, and
+ * shares it with a packet-level TCP transfer.
+ */
+class Ns3TcpFluidTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param congestionOps the type of the congestion control of the fluid flow
+     * \param foreground whether a packet-level bulk transfer shares the link
+     */
+    Ns3TcpFluidTestCase(const std::string& congestionOps, bool foreground);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Cwnd trace sink; counts the reductions of the window
+     * \param oldValue the old window
+     * \param newValue the new window
+     */
+    void CwndChange(uint32_t oldValue, uint32_t newValue);
+
+    std::string m_congestionOps; //!< Congestion control of the fluid flow
+    bool m_foreground;           //!< Whether a packet-level transfer shares the link
+    uint32_t m_reductions{0};    //!< Number of reductions of the window
+};
+
+Ns3TcpFluidTestCase::Ns3TcpFluidTestCase(const std::string& congestionOps, bool foreground)
+    : TestCase("Fluid " + congestionOps + (foreground ? " with a packet flow" : " alone")),
+      m_congestionOps(congestionOps),
+      m_foreground(foreground)
+{
+}
+
+void
+Ns3TcpFluidTestCase::CwndChange(uint32_t oldValue, uint32_t newValue)
+{
+    if (newValue < oldValue)
+    {
+        ++m_reductions;
+    }
+}
+
+void
+Ns3TcpFluidTestCase::DoRun()
+{
+    const DataRate capacity("10Mbps");
+    const Time duration = Seconds(20);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", DataRateValue(capacity));
+    p2p.SetChannelAttribute("Delay", StringValue("10ms"));
+    NetDeviceContainer devices = p2p.Install(nodes);
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    Ipv4AddressHelper address("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    Ptr<FluidBulkSendApplication> fluid = CreateObject<FluidBulkSendApplication>();
+    fluid->SetAttribute("Device", PointerValue(devices.Get(0)));
+    fluid->SetAttribute("CongestionOps", StringValue(m_congestionOps));
+    fluid->SetAttribute("SegmentSize", UintegerValue(1448));
+    fluid->SetAttribute("BaseRtt", TimeValue(MilliSeconds(20)));
+    fluid->TraceConnectWithoutContext("CongestionWindow",
+                                      MakeCallback(&Ns3TcpFluidTestCase::CwndChange, this));
+    nodes.Get(0)->AddApplication(fluid);
+    fluid->SetStartTime(Seconds(0));
+    fluid->SetStopTime(duration);
+
+    ApplicationContainer sinks;
+    if (m_foreground)
+    {
+        const uint16_t port = 9;
+        BulkSendHelper source("ns3::TcpSocketFactory",
+                              InetSocketAddress(interfaces.GetAddress(1), port));
+        source.Install(nodes.Get(0)).Start(Seconds(0));
+        PacketSinkHelper sink("ns3::TcpSocketFactory",
+                              InetSocketAddress(Ipv4Address::GetAny(), port));
+        sinks = sink.Install(nodes.Get(1));
+    }
+
+    Simulator::Stop(duration);
+    Simulator::Run();
+
+    const double link = capacity.GetBitRate() / 8.0 * duration.GetSeconds();
+    const double fluidShare = fluid->GetTotalDelivered() / link;
+    const double packetShare =
+        m_foreground ? DynamicCast<PacketSink>(sinks.Get(0))->GetTotalRx() / link : 0;
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_GT(m_reductions, 0, "The fluid flow never saw a loss");
+    NS_TEST_EXPECT_MSG_LT(fluidShare + packetShare, 1.02, "The link carried too much traffic");
+    if (m_foreground)
+    {
+        NS_TEST_EXPECT_MSG_GT(fluidShare, 0.2, "The fluid flow got too little of the link");
+        NS_TEST_EXPECT_MSG_GT(packetShare, 0.2, "The packet flow got too little of the link");
+        NS_TEST_EXPECT_MSG_GT(fluidShare + packetShare, 0.8, "The link was not filled");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_GT(fluidShare, 0.8, "The fluid flow did not fill the link");
+    }
+}
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * Check that a fluid transfer ends after MaxBytes, and cancels its
+ * reservation on the device.
+ */
+class Ns3TcpFluidMaxBytesTestCase : public TestCase
+{
+  public:
+    Ns3TcpFluidMaxBytesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ns3TcpFluidMaxBytesTestCase::Ns3TcpFluidMaxBytesTestCase()
+    : TestCase("Fluid transfer of a limited size")
+{
+}
+
+void
+Ns3TcpFluidMaxBytesTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    NetDeviceContainer devices = p2p.Install(nodes);
+
+    Ptr<FluidBulkSendApplication> fluid = CreateObject<FluidBulkSendApplication>();
+    fluid->SetDevice(devices.Get(0));
+    fluid->SetAttribute("MaxBytes", UintegerValue(1000000));
+    nodes.Get(0)->AddApplication(fluid);
+
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+
+    DataRateValue background;
+    devices.Get(0)->GetAttribute("BackgroundDataRate", background);
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetTotalDelivered(), 1000000, "Wrong number of bytes delivered");
+    NS_TEST_EXPECT_MSG_EQ(fluid->GetRate(), DataRate(0), "The flow did not end");
+    NS_TEST_EXPECT_MSG_EQ(background.Get(), DataRate(0), "The reservation was not cancelled");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * TestSuite for the fluid bulk transfers
+ */
+class Ns3TcpFluidTestSuite : public TestSuite
+{
+  public:
+    Ns3TcpFluidTestSuite();
+};
+
+Ns3TcpFluidTestSuite::Ns3TcpFluidTestSuite()
+    : TestSuite("ns3-tcp-fluid", Type::SYSTEM)
+{
+    AddTestCase(new Ns3TcpFluidTestCase("ns3::TcpNewReno", false), TestCase::Duration::QUICK);
+    AddTestCase(new Ns3TcpFluidTestCase("ns3::TcpCubic", false), TestCase::Duration::QUICK);
+    AddTestCase(new Ns3TcpFluidTestCase("ns3::TcpNewReno", true), TestCase::Duration::QUICK);
+    AddTestCase(new Ns3TcpFluidMaxBytesTestCase, TestCase::Duration::QUICK);
+}
+
+/**
+ * Static variable for test initialization
+ */
+static Ns3TcpFluidTestSuite ns3TcpFluidTestSuite;
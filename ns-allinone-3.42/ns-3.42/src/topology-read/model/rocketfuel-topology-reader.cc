@@ -167,19 +167,26 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
     {
         // Each line contains a list <.*>[ |\t]<.*>[ |\t]<.*>[ |\t]
         // First remove < and >
-        std::string temp;
-        std::regex replace_regex("[<|>]");
-        std::regex_replace(std::back_inserter(temp),
-                           argv[6].begin(),
-                           argv[6].end(),
-                           replace_regex,
-                           "");
-
-        // Then split list
-        std::regex split_regex("[ |\t]");
-        std::sregex_token_iterator first{temp.begin(), temp.end(), split_regex, -1};
-        std::sregex_token_iterator last;
-        neigh_list = std::vector<std::string>{first, last};
+        std::string temp = argv[6];
+        std::erase_if(temp, [](char c) { return c == '<' || c == '|' || c == '>'; });
+
+        // Then split list; consecutive separators yield an empty name, a
+        // trailing separator does not.
+        std::string::size_type start = 0;
+        while (true)
+        {
+            std::string::size_type end = temp.find_first_of(" \t", start);
+            if (end == std::string::npos)
+            {
+                if (start < temp.size() || temp.empty())
+                {
+                    neigh_list.emplace_back(temp, start);
+                }
+                break;
+            }
+            neigh_list.emplace_back(temp, start, end - start);
+            start = end + 1;
+        }
     }
     if (num_neigh != neigh_list.size())
     {
@@ -210,15 +217,7 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
     // Create node and link
     if (!uid.empty())
     {
-        if (!m_nodeMap[uid])
-        {
-            Ptr<Node> tmpNode = CreateObject<Node>();
-            std::string nodename = "RocketFuelTopology/NodeName/" + uid;
-            Names::Add(nodename, tmpNode);
-            m_nodeMap[uid] = tmpNode;
-            nodes.Add(tmpNode);
-            m_nodesNumber++;
-        }
+        GetOrCreateNode(uid, nodes);
 
         for (auto& nuid : neigh_list)
         {
@@ -227,20 +226,10 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
                 return nodes;
             }
 
-            if (!m_nodeMap[nuid])
-            {
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "RocketFuelTopology/NodeName/" + nuid;
-                Names::Add(nodename, tmpNode);
-                m_nodeMap[nuid] = tmpNode;
-                nodes.Add(tmpNode);
-                m_nodesNumber++;
-            }
+            GetOrCreateNode(nuid, nodes);
             NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << uid
                                       << " to: " << nuid);
-            Link link(m_nodeMap[uid], uid, m_nodeMap[nuid], nuid);
-            AddLink(link);
-            m_linksNumber++;
+            AddNamedLink(uid, nuid);
         }
     }
 
@@ -272,44 +261,15 @@ RocketfuelTopologyReader::GenerateFromWeightsFile(const std::vector<std::string>
     // Create node and link
     if (!sname.empty() && !tname.empty())
     {
-        if (!m_nodeMap[sname])
-        {
-            Ptr<Node> tmpNode = CreateObject<Node>();
-            std::string nodename = "RocketFuelTopology/NodeName/" + sname;
-            Names::Add(nodename, tmpNode);
-            m_nodeMap[sname] = tmpNode;
-            nodes.Add(tmpNode);
-            m_nodesNumber++;
-        }
-
-        if (!m_nodeMap[tname])
-        {
-            Ptr<Node> tmpNode = CreateObject<Node>();
-            std::string nodename = "RocketFuelTopology/NodeName/" + tname;
-            Names::Add(nodename, tmpNode);
-            m_nodeMap[tname] = tmpNode;
-            nodes.Add(tmpNode);
-            m_nodesNumber++;
-        }
+        GetOrCreateNode(sname, nodes);
+        GetOrCreateNode(tname, nodes);
         NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << sname
                                   << " to: " << tname);
-        TopologyReader::ConstLinksIterator iter;
-        bool found = false;
-        for (iter = LinksBegin(); iter != LinksEnd(); iter++)
-        {
-            if ((iter->GetFromNode() == m_nodeMap[tname]) &&
-                (iter->GetToNode() == m_nodeMap[sname]))
-            {
-                found = true;
-                break;
-            }
-        }
 
-        if (!found)
+        // Skip the link if it has already been added in the reverse direction
+        if (m_links.find(std::make_pair(tname, sname)) == m_links.end())
         {
-            Link link(m_nodeMap[sname], sname, m_nodeMap[tname], tname);
-            AddLink(link);
-            m_linksNumber++;
+            AddNamedLink(sname, tname);
         }
     }
 
@@ -319,6 +279,30 @@ RocketfuelTopologyReader::GenerateFromWeightsFile(const std::vector<std::string>
     return nodes;
 }
 
+Ptr<Node>
+RocketfuelTopologyReader::GetOrCreateNode(const std::string& uid, NodeContainer& nodes)
+{
+    Ptr<Node>& node = m_nodeMap[uid];
+    if (!node)
+    {
+        node = CreateObject<Node>();
+        std::string nodename = "RocketFuelTopology/NodeName/" + uid;
+        Names::Add(nodename, node);
+        nodes.Add(node);
+        m_nodesNumber++;
+    }
+    return node;
+}
+
+void
+RocketfuelTopologyReader::AddNamedLink(const std::string& from, const std::string& to)
+{
+    Link link(m_nodeMap[from], from, m_nodeMap[to], to);
+    AddLink(link);
+    m_links.emplace(from, to);
+    m_linksNumber++;
+}
+
 RocketfuelTopologyReader::RF_FileType
 RocketfuelTopologyReader::GetFileType(const std::string& line)
 {
@@ -22,6 +22,10 @@
 
 #include "topology-reader.h"
 
+#include <set>
+#include <unordered_map>
+#include <utility>
+
 /**
  * \file
  * \ingroup topology
@@ -113,9 +117,27 @@ class RocketfuelTopologyReader : public TopologyReader
      */
     RF_FileType GetFileType(const std::string& buf);
 
-    int m_linksNumber;                          //!< Number of links.
-    int m_nodesNumber;                          //!< Number of nodes.
-    std::map<std::string, Ptr<Node>> m_nodeMap; //!< Map of the nodes (name, node).
+    /**
+     * \brief Returns the node with the given name, creating it if needed.
+     *
+     * \param [in] uid The node name.
+     * \param [in,out] nodes The container the node is added to if it is created.
+     * \return The node.
+     */
+    Ptr<Node> GetOrCreateNode(const std::string& uid, NodeContainer& nodes);
+
+    /**
+     * \brief Adds a link between two nodes and records the pair of names.
+     *
+     * \param [in] from The name of the first node.
+     * \param [in] to The name of the second node.
+     */
+    void AddNamedLink(const std::string& from, const std::string& to);
+
+    int m_linksNumber; //!< Number of links.
+    int m_nodesNumber; //!< Number of nodes.
+    std::unordered_map<std::string, Ptr<Node>> m_nodeMap;  //!< Map of the nodes (name, node).
+    std::set<std::pair<std::string, std::string>> m_links; //!< Names of the linked nodes.
 
     // end class RocketfuelTopologyReader
 };
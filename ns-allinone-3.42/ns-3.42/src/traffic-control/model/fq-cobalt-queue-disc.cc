@@ -236,11 +236,11 @@ FqCobaltQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        const uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCobaltFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
+        // a queue that has been created has a tag
+        if (index == FqFlowLists::NO_FLOW || m_tags[i] == flowHash ||
+            StaticCast<FqCobaltFlow>(GetQueueDiscClass(index))->GetStatus() ==
                 FqCobaltFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
@@ -293,7 +293,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqCobaltFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == FqFlowLists::NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCobaltFlow>();
@@ -313,6 +313,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         AddQueueDiscClass(flow);
 
         m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowLists.AddFlow();
     }
     else
     {
@@ -323,7 +324,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     {
         flow->SetStatus(FqCobaltFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_flowLists.PushBack(FqFlowLists::NEW_FLOWS, m_flowsIndices[h]);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
@@ -351,17 +352,17 @@ FqCobaltQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_flowLists.IsEmpty(FqFlowLists::NEW_FLOWS))
         {
-            flow = m_newFlows.front();
+            flow = StaticCast<FqCobaltFlow>(
+                GetQueueDiscClass(m_flowLists.GetFront(FqFlowLists::NEW_FLOWS)));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowLists.MoveFrontToBack(FqFlowLists::NEW_FLOWS, FqFlowLists::OLD_FLOWS);
             }
             else
             {
@@ -370,16 +371,16 @@ FqCobaltQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_flowLists.IsEmpty(FqFlowLists::OLD_FLOWS))
         {
-            flow = m_oldFlows.front();
+            flow = StaticCast<FqCobaltFlow>(
+                GetQueueDiscClass(m_flowLists.GetFront(FqFlowLists::OLD_FLOWS)));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_flowLists.MoveFrontToBack(FqFlowLists::OLD_FLOWS, FqFlowLists::OLD_FLOWS);
             }
             else
             {
@@ -399,16 +400,15 @@ FqCobaltQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_flowLists.IsEmpty(FqFlowLists::NEW_FLOWS))
             {
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowLists.MoveFrontToBack(FqFlowLists::NEW_FLOWS, FqFlowLists::OLD_FLOWS);
             }
             else
             {
                 flow->SetStatus(FqCobaltFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_flowLists.PopFront(FqFlowLists::OLD_FLOWS);
             }
         }
         else
@@ -484,6 +484,12 @@ FqCobaltQueueDisc::InitializeParams()
 
     m_flowFactory.SetTypeId("ns3::FqCobaltFlow");
 
+    m_flowsIndices.assign(m_flows, FqFlowLists::NO_FLOW);
+    if (m_enableSetAssociativeHash)
+    {
+        m_tags.assign(m_flows, 0);
+    }
+
     m_queueDiscFactory.SetTypeId("ns3::CobaltQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     m_queueDiscFactory.Set("Interval", StringValue(m_interval));
@@ -0,0 +1,165 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FQ_FLOW_LISTS_H
+#define FQ_FLOW_LISTS_H
+
+#include "ns3/assert.h"
+
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief The lists of new and old flows of the flow queueing disciplines
+ * (FqCoDelQueueDisc, FqCobaltQueueDisc and FqPieQueueDisc).
+ *
+ * A flow is identified by the index of its class in the queue disc, and it
+ * belongs to at most one list at a time. The lists are linked through a flat
+ * array of indices, hence appending a flow or moving it from a list to the
+ * other never allocates memory.
+ */
+class FqFlowLists
+{
+  public:
+    /// The identifier of a list
+    enum ListId
+    {
+        NEW_FLOWS = 0, //!< the list of new flows
+        OLD_FLOWS = 1, //!< the list of old flows
+    };
+
+    /// Index of no flow, e.g., the index of the flow following the last one
+    static constexpr uint32_t NO_FLOW = std::numeric_limits<uint32_t>::max();
+
+    FqFlowLists();
+
+    /**
+     * \brief Make room for a new flow, whose index is the number of flows added so far
+     */
+    void AddFlow();
+
+    /**
+     * \param list the list
+     * \return true if the list is empty
+     */
+    bool IsEmpty(ListId list) const;
+
+    /**
+     * \param list the list
+     * \return the index of the first flow of the list, which must not be empty
+     */
+    uint32_t GetFront(ListId list) const;
+
+    /**
+     * \brief Append a flow, which must not belong to any list, to a list
+     * \param list the list
+     * \param flow the index of the flow
+     */
+    void PushBack(ListId list, uint32_t flow);
+
+    /**
+     * \brief Remove the first flow of a list, which must not be empty
+     * \param list the list
+     */
+    void PopFront(ListId list);
+
+    /**
+     * \brief Move the first flow of a list, which must not be empty, to the end
+     * of a list (possibly the same)
+     * \param from the list of the flow
+     * \param to the list to which the flow is appended
+     */
+    void MoveFrontToBack(ListId from, ListId to);
+
+  private:
+    std::vector<uint32_t> m_next; //!< Index of the flow following each flow in its list
+    uint32_t m_head[2];           //!< Index of the first flow of each list
+    uint32_t m_tail[2];           //!< Index of the last flow of each list
+};
+
+/*************************************************
+ *  Inline implementation
+ *************************************************/
+
+inline FqFlowLists::FqFlowLists()
+    : m_head{NO_FLOW, NO_FLOW},
+      m_tail{NO_FLOW, NO_FLOW}
+{
+}
+
+inline void
+FqFlowLists::AddFlow()
+{
+    m_next.push_back(NO_FLOW);
+}
+
+inline bool
+FqFlowLists::IsEmpty(ListId list) const
+{
+    return m_head[list] == NO_FLOW;
+}
+
+inline uint32_t
+FqFlowLists::GetFront(ListId list) const
+{
+    NS_ASSERT(!IsEmpty(list));
+    return m_head[list];
+}
+
+inline void
+FqFlowLists::PushBack(ListId list, uint32_t flow)
+{
+    NS_ASSERT(flow < m_next.size());
+    m_next[flow] = NO_FLOW;
+    if (IsEmpty(list))
+    {
+        m_head[list] = flow;
+    }
+    else
+    {
+        m_next[m_tail[list]] = flow;
+    }
+    m_tail[list] = flow;
+}
+
+inline void
+FqFlowLists::PopFront(ListId list)
+{
+    NS_ASSERT(!IsEmpty(list));
+    const uint32_t flow = m_head[list];
+    m_head[list] = m_next[flow];
+    if (m_head[list] == NO_FLOW)
+    {
+        m_tail[list] = NO_FLOW;
+    }
+}
+
+inline void
+FqFlowLists::MoveFrontToBack(ListId from, ListId to)
+{
+    const uint32_t flow = GetFront(from);
+    PopFront(from);
+    PushBack(to, flow);
+}
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_LISTS_H */
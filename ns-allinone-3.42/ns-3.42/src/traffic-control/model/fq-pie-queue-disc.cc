@@ -200,6 +200,12 @@ FqPieQueueDisc::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&FqPieQueueDisc::m_useDerandomization),
                           MakeBooleanChecker())
+            .AddAttribute("SharedUpdateTimer",
+                          "True to update the drop probability of all the flow queues in a "
+                          "single event (see PieQueueDisc::SharedUpdateTimer)",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FqPieQueueDisc::m_sharedUpdateTimer),
+                          MakeBooleanChecker())
             .AddAttribute("Flows",
                           "The number of queues into which the incoming packets are classified",
                           UintegerValue(1024),
@@ -265,12 +271,11 @@ FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        const uint32_t index = m_flowsIndices[i];
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
+        // a queue that has been created has a tag
+        if (index == FqFlowLists::NO_FLOW || m_tags[i] == flowHash ||
+            StaticCast<FqPieFlow>(GetQueueDiscClass(index))->GetStatus() == FqPieFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -322,7 +327,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (m_flowsIndices[h] == FqFlowLists::NO_FLOW)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqPieFlow>();
@@ -341,6 +346,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         AddQueueDiscClass(flow);
 
         m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowLists.AddFlow();
     }
     else
     {
@@ -351,7 +357,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     {
         flow->SetStatus(FqPieFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_flowLists.PushBack(FqFlowLists::NEW_FLOWS, m_flowsIndices[h]);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
@@ -379,17 +385,17 @@ FqPieQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_flowLists.IsEmpty(FqFlowLists::NEW_FLOWS))
         {
-            flow = m_newFlows.front();
+            flow = StaticCast<FqPieFlow>(
+                GetQueueDiscClass(m_flowLists.GetFront(FqFlowLists::NEW_FLOWS)));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowLists.MoveFrontToBack(FqFlowLists::NEW_FLOWS, FqFlowLists::OLD_FLOWS);
             }
             else
             {
@@ -398,16 +404,16 @@ FqPieQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_flowLists.IsEmpty(FqFlowLists::OLD_FLOWS))
         {
-            flow = m_oldFlows.front();
+            flow = StaticCast<FqPieFlow>(
+                GetQueueDiscClass(m_flowLists.GetFront(FqFlowLists::OLD_FLOWS)));
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_flowLists.MoveFrontToBack(FqFlowLists::OLD_FLOWS, FqFlowLists::OLD_FLOWS);
             }
             else
             {
@@ -427,16 +433,15 @@ FqPieQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_flowLists.IsEmpty(FqFlowLists::NEW_FLOWS))
             {
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowLists.MoveFrontToBack(FqFlowLists::NEW_FLOWS, FqFlowLists::OLD_FLOWS);
             }
             else
             {
                 flow->SetStatus(FqPieFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_flowLists.PopFront(FqFlowLists::OLD_FLOWS);
             }
         }
         else
@@ -512,6 +517,12 @@ FqPieQueueDisc::InitializeParams()
 
     m_flowFactory.SetTypeId("ns3::FqPieFlow");
 
+    m_flowsIndices.assign(m_flows, FqFlowLists::NO_FLOW);
+    if (m_enableSetAssociativeHash)
+    {
+        m_tags.assign(m_flows, 0);
+    }
+
     m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
     m_queueDiscFactory.Set("MaxSize", QueueSizeValue(GetMaxSize()));
     m_queueDiscFactory.Set("MeanPktSize", UintegerValue(m_meanPktSize));
@@ -525,6 +536,7 @@ FqPieQueueDisc::InitializeParams()
     m_queueDiscFactory.Set("UseDequeueRateEstimator", BooleanValue(m_useDqRateEstimator));
     m_queueDiscFactory.Set("UseCapDropAdjustment", BooleanValue(m_isCapDropAdjustment));
     m_queueDiscFactory.Set("UseDerandomization", BooleanValue(m_useDerandomization));
+    m_queueDiscFactory.Set("SharedUpdateTimer", BooleanValue(m_sharedUpdateTimer));
 }
 
 uint32_t
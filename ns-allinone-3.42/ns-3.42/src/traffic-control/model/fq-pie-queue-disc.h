@@ -26,12 +26,12 @@
 #ifndef FQ_PIE_QUEUE_DISC
 #define FQ_PIE_QUEUE_DISC
 
+#include "fq-flow-lists.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -191,6 +191,7 @@ class FqPieQueueDisc : public QueueDisc
     bool
         m_isCapDropAdjustment; //!< Enable/Disable Cap Drop Adjustment feature mentioned in RFC 8033
     bool m_useDerandomization; //!< Enable Derandomization feature mentioned in RFC 8033
+    bool m_sharedUpdateTimer;  //!< True to update the flow queues with a shared timer
 
     // Fq parameters
     uint32_t m_quantum;              //!< Deficit assigned to flows at each round
@@ -200,11 +201,10 @@ class FqPieQueueDisc : public QueueDisc
     uint32_t m_perturbation;         //!< hash perturbation value
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
 
-    std::list<Ptr<FqPieFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqPieFlow>> m_oldFlows; //!< The list of old flows
+    FqFlowLists m_flowLists; //!< The lists of new and old flows (indices of their class)
 
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<uint32_t> m_flowsIndices; //!< Index of the class of each flow queue, if created
+    std::vector<uint32_t> m_tags;         //!< Tags used by set associative hash
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
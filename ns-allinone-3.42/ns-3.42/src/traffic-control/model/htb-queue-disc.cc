@@ -0,0 +1,760 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "htb-queue-disc.h"
+
+#include "ns3/integer.h"
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/object-vector.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("HtbQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED(HtbQueueDiscClass);
+
+TypeId
+HtbQueueDiscClass::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::HtbQueueDiscClass")
+            .SetParent<QueueDiscClass>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<HtbQueueDiscClass>()
+            .AddAttribute("Rate",
+                          "The rate guaranteed to the class",
+                          DataRateValue(DataRate("1Mbps")),
+                          MakeDataRateAccessor(&HtbQueueDiscClass::m_rate),
+                          MakeDataRateChecker())
+            .AddAttribute("Ceil",
+                          "The maximum rate of the class, including the bandwidth borrowed "
+                          "from its ancestors. If null, it is equal to the rate",
+                          DataRateValue(DataRate("0bps")),
+                          MakeDataRateAccessor(&HtbQueueDiscClass::m_ceil),
+                          MakeDataRateChecker())
+            .AddAttribute("Burst",
+                          "The size of the bucket of the rate, in bytes",
+                          UintegerValue(1600),
+                          MakeUintegerAccessor(&HtbQueueDiscClass::m_burst),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Cburst",
+                          "The size of the bucket of the ceil rate, in bytes",
+                          UintegerValue(1600),
+                          MakeUintegerAccessor(&HtbQueueDiscClass::m_cburst),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Priority",
+                          "The priority of a leaf class (0 is the highest), used to "
+                          "assign it the bandwidth to lend before the other leaves",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbQueueDiscClass::m_priority),
+                          MakeUintegerChecker<uint8_t>(0, HtbQueueDisc::N_PRIOS - 1))
+            .AddAttribute("Quantum",
+                          "The bytes a leaf class can send in a round when borrowing. "
+                          "If null, it is the rate (in bytes per second) divided by 10, "
+                          "bounded between 1000 and 200000 bytes",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&HtbQueueDiscClass::m_quantum),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Parent",
+                          "The index of the parent inner class, or -1 if the class has "
+                          "no parent",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&HtbQueueDiscClass::m_parent),
+                          MakeIntegerChecker<int32_t>(-1));
+    return tid;
+}
+
+HtbQueueDiscClass::HtbQueueDiscClass()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HtbQueueDiscClass::~HtbQueueDiscClass()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+DataRate
+HtbQueueDiscClass::GetRate() const
+{
+    return m_rate;
+}
+
+DataRate
+HtbQueueDiscClass::GetCeil() const
+{
+    return m_ceil;
+}
+
+uint32_t
+HtbQueueDiscClass::GetBurst() const
+{
+    return m_burst;
+}
+
+uint32_t
+HtbQueueDiscClass::GetCburst() const
+{
+    return m_cburst;
+}
+
+uint8_t
+HtbQueueDiscClass::GetPriority() const
+{
+    return m_priority;
+}
+
+uint32_t
+HtbQueueDiscClass::GetQuantum() const
+{
+    return m_quantum;
+}
+
+int32_t
+HtbQueueDiscClass::GetParent() const
+{
+    return m_parent;
+}
+
+NS_OBJECT_ENSURE_REGISTERED(HtbQueueDisc);
+
+/// Maximum number of tokens of a bucket, in ns, as htb_mbuffer in Linux
+static constexpr int64_t MAX_BUFFER = 60000000000LL;
+
+TypeId
+HtbQueueDisc::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::HtbQueueDisc")
+            .SetParent<QueueDisc>()
+            .SetGroupName("TrafficControl")
+            .AddConstructor<HtbQueueDisc>()
+            .AddAttribute("DefaultClass",
+                          "The index of the leaf class of the packets that are not "
+                          "classified by any packet filter. If greater than the index of "
+                          "the last class, such packets are dropped",
+                          UintegerValue(std::numeric_limits<uint32_t>::max()),
+                          MakeUintegerAccessor(&HtbQueueDisc::m_defaultClass),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("InnerClassList",
+                          "The list of inner classes.",
+                          ObjectVectorValue(),
+                          MakeObjectVectorAccessor(&HtbQueueDisc::m_innerClasses),
+                          MakeObjectVectorChecker<HtbQueueDiscClass>());
+    return tid;
+}
+
+HtbQueueDisc::HtbQueueDisc()
+    : QueueDisc(QueueDiscSizePolicy::NO_LIMITS),
+      m_now(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HtbQueueDisc::~HtbQueueDisc()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+HtbQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Simulator::Cancel(m_watchdog);
+    m_innerClasses.clear();
+    m_state.clear();
+    m_waitQueue.clear();
+    QueueDisc::DoDispose();
+}
+
+uint32_t
+HtbQueueDisc::AddInnerClass(Ptr<HtbQueueDiscClass> cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+    m_innerClasses.push_back(cl);
+    return m_innerClasses.size() - 1;
+}
+
+Ptr<HtbQueueDiscClass>
+HtbQueueDisc::GetInnerClass(std::size_t i) const
+{
+    NS_ASSERT(i < m_innerClasses.size());
+    return m_innerClasses[i];
+}
+
+std::size_t
+HtbQueueDisc::GetNInnerClasses() const
+{
+    return m_innerClasses.size();
+}
+
+void
+HtbQueueDisc::RingInsert(Ring& ring, uint32_t cl, uint8_t prio)
+{
+    auto& c = m_state[cl];
+    if (ring.first == NO_CLASS)
+    {
+        c.next[prio] = c.prev[prio] = cl;
+        ring.first = ring.ptr = cl;
+        ring.lastPtr = NO_CLASS;
+        return;
+    }
+    // insert before the first class with a higher index
+    auto next = ring.first;
+    while (next < cl && m_state[next].next[prio] != ring.first)
+    {
+        next = m_state[next].next[prio];
+    }
+    if (next < cl)
+    {
+        next = ring.first;
+    }
+    else if (next == ring.first)
+    {
+        ring.first = cl;
+    }
+    const auto prev = m_state[next].prev[prio];
+    c.next[prio] = next;
+    c.prev[prio] = prev;
+    m_state[prev].next[prio] = cl;
+    m_state[next].prev[prio] = cl;
+}
+
+void
+HtbQueueDisc::RingRemove(Ring& ring, uint32_t cl, uint8_t prio, bool remember)
+{
+    auto& c = m_state[cl];
+    if (remember && ring.ptr == cl)
+    {
+        ring.lastPtr = cl;
+    }
+    if (c.next[prio] == cl)
+    {
+        ring.first = ring.ptr = NO_CLASS;
+        return;
+    }
+    m_state[c.prev[prio]].next[prio] = c.next[prio];
+    m_state[c.next[prio]].prev[prio] = c.prev[prio];
+    if (ring.first == cl)
+    {
+        ring.first = c.next[prio];
+    }
+    if (ring.ptr == cl)
+    {
+        ring.ptr = (remember ? NO_CLASS : c.next[prio]);
+    }
+}
+
+uint32_t
+HtbQueueDisc::RingGetPtr(Ring& ring, uint8_t prio)
+{
+    if (ring.ptr == NO_CLASS)
+    {
+        // resume from the first class whose index is not lower than the remembered one
+        ring.ptr = ring.first;
+        while (ring.ptr < ring.lastPtr && m_state[ring.ptr].next[prio] != ring.first)
+        {
+            ring.ptr = m_state[ring.ptr].next[prio];
+        }
+        if (ring.ptr < ring.lastPtr)
+        {
+            ring.ptr = ring.first;
+        }
+        ring.lastPtr = NO_CLASS;
+    }
+    return ring.ptr;
+}
+
+void
+HtbQueueDisc::ActivatePrios(uint32_t cl)
+{
+    auto p = m_state[cl].parent;
+    uint8_t mask = m_state[cl].activity;
+
+    while (m_state[cl].mode == MAY_BORROW && p != NO_CLASS && mask)
+    {
+        for (uint8_t m = mask; m; m &= m - 1)
+        {
+            const uint8_t prio = std::countr_zero(m);
+            if (m_state[p].feed[prio].first != NO_CLASS)
+            {
+                // the parent is already active for this priority
+                mask &= ~(1 << prio);
+            }
+            RingInsert(m_state[p].feed[prio], cl, prio);
+        }
+        m_state[p].activity |= mask;
+        cl = p;
+        p = m_state[cl].parent;
+    }
+    if (m_state[cl].mode == CAN_SEND && mask)
+    {
+        auto& row = m_row[m_state[cl].level];
+        for (uint8_t m = mask; m; m &= m - 1)
+        {
+            const uint8_t prio = std::countr_zero(m);
+            RingInsert(row[prio], cl, prio);
+        }
+        m_rowMask[m_state[cl].level] |= mask;
+    }
+}
+
+void
+HtbQueueDisc::DeactivatePrios(uint32_t cl)
+{
+    auto p = m_state[cl].parent;
+    uint8_t mask = m_state[cl].activity;
+
+    while (m_state[cl].mode == MAY_BORROW && p != NO_CLASS && mask)
+    {
+        const uint8_t m = mask;
+        mask = 0;
+        for (uint8_t b = m; b; b &= b - 1)
+        {
+            const uint8_t prio = std::countr_zero(b);
+            RingRemove(m_state[p].feed[prio], cl, prio, true);
+            if (m_state[p].feed[prio].first == NO_CLASS)
+            {
+                // the parent is no longer active for this priority
+                mask |= 1 << prio;
+            }
+        }
+        m_state[p].activity &= ~mask;
+        cl = p;
+        p = m_state[cl].parent;
+    }
+    if (m_state[cl].mode == CAN_SEND && mask)
+    {
+        const auto level = m_state[cl].level;
+        for (uint8_t m = mask; m; m &= m - 1)
+        {
+            const uint8_t prio = std::countr_zero(m);
+            RingRemove(m_row[level][prio], cl, prio, false);
+            if (m_row[level][prio].first == NO_CLASS)
+            {
+                m_rowMask[level] &= ~(1 << prio);
+            }
+        }
+    }
+}
+
+void
+HtbQueueDisc::Activate(uint32_t cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+    m_state[cl].activity = 1 << m_state[cl].prio;
+    ActivatePrios(cl);
+}
+
+void
+HtbQueueDisc::Deactivate(uint32_t cl)
+{
+    NS_LOG_FUNCTION(this << cl);
+    DeactivatePrios(cl);
+    m_state[cl].activity = 0;
+}
+
+HtbQueueDisc::Mode
+HtbQueueDisc::GetMode(const Class& cl, int64_t& diff) const
+{
+    int64_t toks = cl.ctokens + diff;
+    if (toks < 0)
+    {
+        diff = -toks;
+        return CANT_SEND;
+    }
+    toks = cl.tokens + diff;
+    if (toks >= 0)
+    {
+        return CAN_SEND;
+    }
+    diff = -toks;
+    return MAY_BORROW;
+}
+
+void
+HtbQueueDisc::ChangeMode(uint32_t cl, int64_t& diff)
+{
+    auto& c = m_state[cl];
+    const auto newMode = GetMode(c, diff);
+    if (newMode == c.mode)
+    {
+        return;
+    }
+    NS_LOG_LOGIC("Class " << cl << " changes mode from " << +c.mode << " to " << +newMode);
+    if (c.activity)
+    {
+        if (c.mode != CANT_SEND)
+        {
+            DeactivatePrios(cl);
+        }
+        c.mode = newMode;
+        if (newMode != CANT_SEND)
+        {
+            ActivatePrios(cl);
+        }
+    }
+    else
+    {
+        c.mode = newMode;
+    }
+}
+
+void
+HtbQueueDisc::AddToWaitQueue(uint32_t cl, int64_t delay)
+{
+    m_state[cl].pqKey = m_now + delay;
+    m_waitQueue.emplace(m_state[cl].pqKey, cl);
+}
+
+int64_t
+HtbQueueDisc::AccountTokens(int64_t tokens, int64_t buffer, DataRate rate, uint32_t bytes) const
+{
+    tokens = std::min(tokens, buffer) - rate.CalculateBytesTxTime(bytes).GetNanoSeconds();
+    return std::max(tokens, 1 - MAX_BUFFER);
+}
+
+void
+HtbQueueDisc::Charge(uint32_t cl, uint8_t level, uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << cl << +level << bytes);
+
+    while (cl != NO_CLASS)
+    {
+        auto& c = m_state[cl];
+        int64_t diff = std::min(m_now - c.tc, MAX_BUFFER);
+        if (c.level >= level)
+        {
+            c.tokens = AccountTokens(c.tokens + diff, c.buffer, c.rate, bytes);
+        }
+        else
+        {
+            // the class borrowed the tokens, only account for the time elapsed
+            c.tokens += diff;
+        }
+        c.ctokens = AccountTokens(c.ctokens + diff, c.cbuffer, c.ceil, bytes);
+        c.tc = m_now;
+
+        const auto oldMode = c.mode;
+        diff = 0;
+        ChangeMode(cl, diff);
+        if (oldMode != c.mode)
+        {
+            if (oldMode != CAN_SEND)
+            {
+                m_waitQueue.erase({c.pqKey, cl});
+            }
+            if (c.mode != CAN_SEND)
+            {
+                AddToWaitQueue(cl, diff);
+            }
+        }
+        cl = c.parent;
+    }
+}
+
+int64_t
+HtbQueueDisc::DoEvents()
+{
+    while (!m_waitQueue.empty())
+    {
+        const auto [key, cl] = *m_waitQueue.begin();
+        if (key > m_now)
+        {
+            return key;
+        }
+        m_waitQueue.erase(m_waitQueue.begin());
+        int64_t diff = std::min(m_now - m_state[cl].tc, MAX_BUFFER);
+        ChangeMode(cl, diff);
+        if (m_state[cl].mode != CAN_SEND)
+        {
+            AddToWaitQueue(cl, diff);
+        }
+    }
+    return -1;
+}
+
+uint32_t
+HtbQueueDisc::LookupLeaf(uint8_t level, uint8_t prio)
+{
+    auto cl = m_row[level][prio].ptr;
+    while (m_state[cl].level > 0)
+    {
+        cl = RingGetPtr(m_state[cl].feed[prio], prio);
+    }
+    return cl;
+}
+
+void
+HtbQueueDisc::NextLeaf(uint32_t cl, uint8_t level, uint8_t prio)
+{
+    while (true)
+    {
+        // the class served from the row is at the level of the row, the others
+        // are in the feeds of their parents
+        const bool inRow = (m_state[cl].level == level);
+        auto& ring = inRow ? m_row[level][prio] : m_state[m_state[cl].parent].feed[prio];
+        ring.ptr = m_state[cl].next[prio];
+        if (inRow || ring.ptr != ring.first)
+        {
+            return;
+        }
+        // a round of the feed is complete, move to the next sibling of the parent
+        cl = m_state[cl].parent;
+    }
+}
+
+Ptr<QueueDiscItem>
+HtbQueueDisc::DequeueTree(uint8_t prio, uint8_t level)
+{
+    auto start = LookupLeaf(level, prio);
+    auto cl = start;
+    Ptr<QueueDiscItem> item;
+    Ptr<QueueDisc> qd;
+
+    while (true)
+    {
+        qd = GetQueueDiscClass(cl)->GetQueueDisc();
+        if (qd->GetNPackets() == 0)
+        {
+            // the child queue disc dropped its packets
+            Deactivate(cl);
+            if ((m_rowMask[level] & (1 << prio)) == 0)
+            {
+                return nullptr;
+            }
+            const auto next = LookupLeaf(level, prio);
+            if (cl == start)
+            {
+                start = next;
+            }
+            cl = next;
+            continue;
+        }
+        if ((item = qd->Dequeue()))
+        {
+            break;
+        }
+        NextLeaf(cl, level, prio);
+        cl = LookupLeaf(level, prio);
+        if (cl == start)
+        {
+            return nullptr;
+        }
+    }
+
+    auto& c = m_state[cl];
+    c.deficit[level] -= item->GetSize();
+    if (c.deficit[level] < 0)
+    {
+        c.deficit[level] += c.quantum;
+        NextLeaf(cl, level, prio);
+    }
+    if (qd->GetNPackets() == 0)
+    {
+        Deactivate(cl);
+    }
+    Charge(cl, level, item->GetSize());
+    return item;
+}
+
+bool
+HtbQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
+{
+    NS_LOG_FUNCTION(this << item);
+
+    int32_t ret = Classify(item);
+    uint32_t cl = (ret == PacketFilter::PF_NO_MATCH ? m_defaultClass : ret);
+
+    if (cl >= GetNQueueDiscClasses())
+    {
+        NS_LOG_DEBUG("No leaf class for this packet, dropping it");
+        DropBeforeEnqueue(item, UNCLASSIFIED_DROP);
+        return false;
+    }
+
+    bool retval = GetQueueDiscClass(cl)->GetQueueDisc()->Enqueue(item);
+
+    // If Queue::Enqueue fails, QueueDisc::Drop is called by the child queue disc
+    // because QueueDisc::AddQueueDiscClass sets the drop callback
+
+    if (retval && !m_state[cl].activity)
+    {
+        Activate(cl);
+    }
+    return retval;
+}
+
+Ptr<QueueDiscItem>
+HtbQueueDisc::DoDequeue()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (GetNPackets() == 0)
+    {
+        NS_LOG_LOGIC("Queue empty");
+        return nullptr;
+    }
+
+    m_now = Simulator::Now().GetNanoSeconds();
+    const auto nextEvent = DoEvents();
+
+    for (uint8_t level = 0; level < MAX_DEPTH; level++)
+    {
+        for (uint8_t m = m_rowMask[level]; m; m &= m - 1)
+        {
+            if (auto item = DequeueTree(std::countr_zero(m), level))
+            {
+                return item;
+            }
+        }
+    }
+
+    // no class can send, wake up when the first class changes mode
+    if (nextEvent >= 0)
+    {
+        const auto delay = NanoSeconds(nextEvent - m_now);
+        if (!m_watchdog.IsPending() || Simulator::GetDelayLeft(m_watchdog) > delay)
+        {
+            Simulator::Cancel(m_watchdog);
+            m_watchdog = Simulator::Schedule(delay, &QueueDisc::Run, this);
+            NS_LOG_LOGIC("Waking event scheduled in " << delay.As(Time::S));
+        }
+    }
+    return nullptr;
+}
+
+bool
+HtbQueueDisc::CheckConfig()
+{
+    NS_LOG_FUNCTION(this);
+    if (GetNInternalQueues() > 0)
+    {
+        NS_LOG_ERROR("HtbQueueDisc cannot have internal queues");
+        return false;
+    }
+
+    if (GetNQueueDiscClasses() == 0)
+    {
+        NS_LOG_ERROR("HtbQueueDisc needs at least one leaf class");
+        return false;
+    }
+
+    for (std::size_t i = 0; i < m_innerClasses.size(); i++)
+    {
+        if (m_innerClasses[i]->GetQueueDisc())
+        {
+            NS_LOG_ERROR("The inner class " << i << " cannot have a queue disc");
+            return false;
+        }
+        if (m_innerClasses[i]->GetParent() >= static_cast<int32_t>(i))
+        {
+            NS_LOG_ERROR("The parent of the inner class " << i << " must be added before it");
+            return false;
+        }
+    }
+
+    for (std::size_t i = 0; i < GetNQueueDiscClasses(); i++)
+    {
+        auto cl = DynamicCast<HtbQueueDiscClass>(GetQueueDiscClass(i));
+        if (!cl)
+        {
+            NS_LOG_ERROR("The class " << i << " is not an HtbQueueDiscClass");
+            return false;
+        }
+        if (cl->GetParent() >= static_cast<int32_t>(m_innerClasses.size()))
+        {
+            NS_LOG_ERROR("The parent of the class " << i << " is not an inner class");
+            return false;
+        }
+    }
+
+    // inner classes are assigned levels from the top, leaves are at level 0
+    std::vector<uint8_t> levels;
+    for (const auto& cl : m_innerClasses)
+    {
+        const auto parent = cl->GetParent();
+        const uint8_t parentLevel = (parent < 0 ? MAX_DEPTH : levels[parent]);
+        if (parentLevel <= 1)
+        {
+            NS_LOG_ERROR("The class tree of HtbQueueDisc cannot be deeper than "
+                         << +MAX_DEPTH << " levels");
+            return false;
+        }
+        levels.push_back(parentLevel - 1);
+    }
+
+    return true;
+}
+
+void
+HtbQueueDisc::InitializeParams()
+{
+    NS_LOG_FUNCTION(this);
+
+    const uint32_t nLeaves = GetNQueueDiscClasses();
+    const auto now = Simulator::Now().GetNanoSeconds();
+    m_state.assign(nLeaves + m_innerClasses.size(), Class{});
+
+    for (std::size_t i = 0; i < m_state.size(); i++)
+    {
+        Ptr<HtbQueueDiscClass> cl =
+            (i < nLeaves ? StaticCast<HtbQueueDiscClass>(GetQueueDiscClass(i))
+                         : m_innerClasses[i - nLeaves]);
+        auto& c = m_state[i];
+        c.parent = (cl->GetParent() < 0 ? NO_CLASS : nLeaves + cl->GetParent());
+        c.level = 0;
+        if (i >= nLeaves)
+        {
+            c.level = (c.parent == NO_CLASS ? MAX_DEPTH : m_state[c.parent].level) - 1;
+        }
+        c.prio = cl->GetPriority();
+        c.mode = CAN_SEND;
+        c.activity = 0;
+        c.rate = cl->GetRate();
+        c.ceil = (cl->GetCeil().GetBitRate() > 0 ? cl->GetCeil() : cl->GetRate());
+        c.buffer = c.rate.CalculateBytesTxTime(cl->GetBurst()).GetNanoSeconds();
+        c.cbuffer = c.ceil.CalculateBytesTxTime(cl->GetCburst()).GetNanoSeconds();
+        c.tokens = c.buffer;
+        c.ctokens = c.cbuffer;
+        c.tc = now;
+        c.pqKey = 0;
+        c.quantum = cl->GetQuantum();
+        if (c.quantum == 0)
+        {
+            c.quantum = std::clamp<uint64_t>(c.rate.GetBitRate() / 80, 1000, 200000);
+        }
+        c.deficit.fill(0);
+        c.next.fill(NO_CLASS);
+        c.prev.fill(NO_CLASS);
+    }
+
+    for (auto& row : m_row)
+    {
+        row.fill(Ring{});
+    }
+    m_rowMask.fill(0);
+    m_waitQueue.clear();
+    m_watchdog = EventId();
+}
+
+} // namespace ns3
@@ -0,0 +1,367 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef HTB_QUEUE_DISC_H
+#define HTB_QUEUE_DISC_H
+
+#include "queue-disc.h"
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+
+#include <array>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A class of an HTB queue disc.
+ *
+ * A class is guaranteed its rate and may borrow the bandwidth left unused by
+ * the other classes from its ancestors, up to its ceil rate. Leaf classes are
+ * the queue disc classes of HtbQueueDisc and store packets in their child queue
+ * disc. Inner classes are added through HtbQueueDisc::AddInnerClass and have no
+ * queue disc.
+ */
+class HtbQueueDiscClass : public QueueDiscClass
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    HtbQueueDiscClass();
+    ~HtbQueueDiscClass() override;
+
+    /**
+     * \return the rate guaranteed to the class
+     */
+    DataRate GetRate() const;
+
+    /**
+     * \return the maximum rate of the class, or zero if equal to the rate
+     */
+    DataRate GetCeil() const;
+
+    /**
+     * \return the size of the bucket of the rate, in bytes
+     */
+    uint32_t GetBurst() const;
+
+    /**
+     * \return the size of the bucket of the ceil rate, in bytes
+     */
+    uint32_t GetCburst() const;
+
+    /**
+     * \return the priority of the class (0 is the highest)
+     */
+    uint8_t GetPriority() const;
+
+    /**
+     * \return the quantum of the class, in bytes, or zero if computed from the rate
+     */
+    uint32_t GetQuantum() const;
+
+    /**
+     * \return the index of the parent inner class, or -1 if the class has no parent
+     */
+    int32_t GetParent() const;
+
+  private:
+    DataRate m_rate;    //!< Rate guaranteed to the class
+    DataRate m_ceil;    //!< Maximum rate of the class
+    uint32_t m_burst;   //!< Size of the bucket of the rate
+    uint32_t m_cburst;  //!< Size of the bucket of the ceil rate
+    uint8_t m_priority; //!< Priority of the class
+    uint32_t m_quantum; //!< Quantum of the class
+    int32_t m_parent;   //!< Index of the parent inner class
+};
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Hierarchical Token Bucket (HTB) queue disc.
+ *
+ * This class is modelled after the Linux HTB queueing discipline
+ * (net/sched/sch_htb.c). Classes form a tree whose leaves are the queue disc
+ * classes and whose inner nodes are the classes added through AddInnerClass.
+ * Each class has a token bucket filled at its rate and one filled at its ceil
+ * rate, and is in one of three modes: it can send (it has tokens for its rate),
+ * it may borrow from its parent (it only has tokens for its ceil rate) or it
+ * cannot send.
+ *
+ * A packet is dequeued from a leaf that can send or, if none can, from a leaf
+ * that borrows from the nearest ancestor able to send. Ties are broken by
+ * priority and then in deficit round robin order. The classes that can send at
+ * each level and priority, as well as the borrowing children of each inner
+ * class, are kept in circular lists sorted by class index and linked through
+ * a flat array, hence selecting a class takes constant time and activating it
+ * takes time linear in the number of its active siblings only. The
+ * times at which classes leave the modes in which they cannot send are kept
+ * in an ordered set, hence charging a class for a packet takes logarithmic time
+ * in the number of classes waiting for tokens.
+ *
+ * Packets are classified by the packet filters, which have to return the index
+ * of a leaf class. Packets not classified by any filter are enqueued in the
+ * default class, if set, and dropped otherwise.
+ */
+class HtbQueueDisc : public QueueDisc
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    HtbQueueDisc();
+    ~HtbQueueDisc() override;
+
+    /**
+     * \brief Add an inner class.
+     *
+     * The parent of an inner class, if any, must have been added before it.
+     * Inner classes cannot have a queue disc.
+     *
+     * \param cl the inner class
+     * \return the index of the inner class, to be used as the Parent attribute
+     *         of its children
+     */
+    uint32_t AddInnerClass(Ptr<HtbQueueDiscClass> cl);
+
+    /**
+     * \param i the index of an inner class
+     * \return the i-th inner class
+     */
+    Ptr<HtbQueueDiscClass> GetInnerClass(std::size_t i) const;
+
+    /**
+     * \return the number of inner classes
+     */
+    std::size_t GetNInnerClasses() const;
+
+    /// Maximum depth of the class tree, as TC_HTB_MAXDEPTH in Linux
+    static constexpr uint8_t MAX_DEPTH = 8;
+    /// Number of class priorities, as TC_HTB_NUMPRIO in Linux
+    static constexpr uint8_t N_PRIOS = 8;
+
+    // Reasons for dropping packets
+    static constexpr const char* UNCLASSIFIED_DROP = "Unclassified drop"; //!< No class
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    bool DoEnqueue(Ptr<QueueDiscItem> item) override;
+    Ptr<QueueDiscItem> DoDequeue() override;
+    bool CheckConfig() override;
+    void InitializeParams() override;
+
+    /// Modes of a class, as enum htb_cmode in Linux
+    enum Mode : uint8_t
+    {
+        CANT_SEND,  //!< The class has no tokens for its ceil rate
+        MAY_BORROW, //!< The class has no tokens for its rate, but has tokens for its ceil rate
+        CAN_SEND    //!< The class has tokens for its rate
+    };
+
+    /// Index of no class
+    static constexpr uint32_t NO_CLASS = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * \brief Circular list of classes sorted by index, linked through the Class::next
+     *        and Class::prev arrays, with a pointer to the class to serve next.
+     *
+     * As in Linux, if the class to serve next is removed from the list, the list
+     * remembers it and resumes from it (or from the class that follows it) later.
+     */
+    struct Ring
+    {
+        uint32_t first{NO_CLASS};   //!< First class of a round
+        uint32_t ptr{NO_CLASS};     //!< Class to serve next
+        uint32_t lastPtr{NO_CLASS}; //!< Class to serve next, removed from the list
+    };
+
+    /// State of a class, leaves first and then inner classes
+    struct Class
+    {
+        uint32_t parent;                        //!< Index of the parent class
+        uint8_t level;                          //!< Level of the class (0 for leaves)
+        uint8_t prio;                           //!< Priority of a leaf
+        Mode mode;                              //!< Current mode
+        uint8_t activity;                       //!< Priorities for which the class is active
+        DataRate rate;                          //!< Rate guaranteed to the class
+        DataRate ceil;                          //!< Maximum rate of the class
+        int64_t buffer;                         //!< Size of the bucket of the rate, in ns
+        int64_t cbuffer;                        //!< Size of the bucket of the ceil rate, in ns
+        int64_t tokens;                         //!< Tokens for the rate, in ns
+        int64_t ctokens;                        //!< Tokens for the ceil rate, in ns
+        int64_t tc;                             //!< Time of the last token update, in ns
+        int64_t pqKey;                          //!< Time of the next mode change, in ns
+        int32_t quantum;                        //!< Quantum of a leaf, in bytes
+        std::array<int32_t, MAX_DEPTH> deficit; //!< Deficit of a leaf at each level
+        std::array<Ring, N_PRIOS> feed;         //!< Borrowing children of an inner class
+        std::array<uint32_t, N_PRIOS> next;     //!< Next class in the list of each priority
+        std::array<uint32_t, N_PRIOS> prev;     //!< Previous class in the list of each priority
+    };
+
+    /**
+     * \brief Insert a class in a list.
+     * \param ring the list
+     * \param cl the class
+     * \param prio the priority of the list
+     */
+    void RingInsert(Ring& ring, uint32_t cl, uint8_t prio);
+
+    /**
+     * \brief Remove a class from a list.
+     * \param ring the list
+     * \param cl the class
+     * \param prio the priority of the list
+     * \param remember whether the list remembers the class, if it is the one to serve next
+     */
+    void RingRemove(Ring& ring, uint32_t cl, uint8_t prio, bool remember);
+
+    /**
+     * \brief Get the class to serve next from a list.
+     * \param ring the list
+     * \param prio the priority of the list
+     * \return the class to serve next
+     */
+    uint32_t RingGetPtr(Ring& ring, uint8_t prio);
+
+    /**
+     * Modelled after the Linux function htb_activate_prios. Add the class to the
+     * feeds of its ancestors, up to the one that can send, which is added to the
+     * row of its level, for the priorities the class is active for.
+     * \param cl the class
+     */
+    void ActivatePrios(uint32_t cl);
+
+    /**
+     * Modelled after the Linux function htb_deactivate_prios. Undo ActivatePrios.
+     * \param cl the class
+     */
+    void DeactivatePrios(uint32_t cl);
+
+    /**
+     * Activate a leaf that became backlogged.
+     * \param cl the leaf
+     */
+    void Activate(uint32_t cl);
+
+    /**
+     * Deactivate a leaf that became empty.
+     * \param cl the leaf
+     */
+    void Deactivate(uint32_t cl);
+
+    /**
+     * Modelled after the Linux function htb_class_mode.
+     * \param cl the class
+     * \param diff the time elapsed since the last token update, set to the time
+     *        after which the class can leave the returned mode
+     * \return the mode of the class after the given time
+     */
+    Mode GetMode(const Class& cl, int64_t& diff) const;
+
+    /**
+     * Modelled after the Linux function htb_change_class_mode.
+     * \param cl the class
+     * \param diff the time elapsed since the last token update, set to the time
+     *        after which the class can leave its new mode
+     */
+    void ChangeMode(uint32_t cl, int64_t& diff);
+
+    /**
+     * \brief Add a class to the wait queue.
+     * \param cl the class
+     * \param delay the time after which the class can change mode, in ns
+     */
+    void AddToWaitQueue(uint32_t cl, int64_t delay);
+
+    /**
+     * Modelled after the Linux function htb_charge_class. Charge a leaf and its
+     * ancestors for a packet.
+     * \param cl the leaf
+     * \param level the level of the class that lent the tokens
+     * \param bytes the size of the packet
+     */
+    void Charge(uint32_t cl, uint8_t level, uint32_t bytes);
+
+    /**
+     * \brief Update the tokens of a bucket for a packet.
+     * \param tokens the tokens, including the ones accumulated since the last update
+     * \param buffer the size of the bucket
+     * \param rate the rate of the bucket
+     * \param bytes the size of the packet
+     * \return the updated tokens
+     */
+    int64_t AccountTokens(int64_t tokens, int64_t buffer, DataRate rate, uint32_t bytes) const;
+
+    /**
+     * Modelled after the Linux function htb_do_events. Change the mode of the
+     * classes whose wait time has elapsed.
+     * \return the time of the next mode change, or -1 if no class is waiting
+     */
+    int64_t DoEvents();
+
+    /**
+     * Modelled after the Linux function htb_lookup_leaf.
+     * \param level the level
+     * \param prio the priority
+     * \return the leaf to serve next from the row of the given level and priority
+     */
+    uint32_t LookupLeaf(uint8_t level, uint8_t prio);
+
+    /**
+     * \brief Move the pointer of the list of a class to the next class, and that
+     *        of the list of its parent as well if a round is complete.
+     * \param cl the class
+     * \param level the level of the row the class is served from
+     * \param prio the priority
+     */
+    void NextLeaf(uint32_t cl, uint8_t level, uint8_t prio);
+
+    /**
+     * Modelled after the Linux function htb_dequeue_tree.
+     * \param prio the priority
+     * \param level the level
+     * \return a packet from the row of the given level and priority, if any
+     */
+    Ptr<QueueDiscItem> DequeueTree(uint8_t prio, uint8_t level);
+
+    std::vector<Ptr<HtbQueueDiscClass>> m_innerClasses;     //!< Inner classes
+    uint32_t m_defaultClass;                                //!< Class of unclassified packets
+    std::vector<Class> m_state;                             //!< State of the classes
+    std::array<std::array<Ring, N_PRIOS>, MAX_DEPTH> m_row; //!< Classes that can send
+    std::array<uint8_t, MAX_DEPTH> m_rowMask;               //!< Non-empty rows of each level
+    std::set<std::pair<int64_t, uint32_t>> m_waitQueue;     //!< Classes waiting for tokens
+    int64_t m_now;                                          //!< Time of the current dequeue
+    EventId m_watchdog;                                     //!< Event waking the queue disc
+};
+
+} // namespace ns3
+
+#endif /* HTB_QUEUE_DISC_H */
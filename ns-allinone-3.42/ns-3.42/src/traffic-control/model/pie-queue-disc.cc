@@ -34,6 +34,8 @@
 #include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <limits>
+
 namespace ns3
 {
 
@@ -133,22 +135,30 @@ PieQueueDisc::GetTypeId()
                           "True to use L4S (only ECT1 packets are marked at CE threshold)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PieQueueDisc::m_useL4s),
+                          MakeBooleanChecker())
+            .AddAttribute("SharedUpdateTimer",
+                          "True to update the drop probability of all the PIE queue discs "
+                          "with the same Tupdate in a single event, at the multiples of Tupdate",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PieQueueDisc::m_sharedUpdateTimer),
                           MakeBooleanChecker());
 
     return tid;
 }
 
 PieQueueDisc::PieQueueDisc()
-    : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE)
+    : QueueDisc(QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE),
+      m_sharedTimerIndex(std::numeric_limits<std::size_t>::max())
 {
     NS_LOG_FUNCTION(this);
     m_uv = CreateObject<UniformRandomVariable>();
-    m_rtrsEvent = Simulator::Schedule(m_sUpdate, &PieQueueDisc::CalculateP, this);
+    m_rtrsEvent = Simulator::Schedule(m_sUpdate, &PieQueueDisc::RunUpdateTimer, this);
 }
 
 PieQueueDisc::~PieQueueDisc()
 {
     NS_LOG_FUNCTION(this);
+    LeaveSharedUpdateTimer();
 }
 
 void
@@ -157,9 +167,93 @@ PieQueueDisc::DoDispose()
     NS_LOG_FUNCTION(this);
     m_uv = nullptr;
     m_rtrsEvent.Cancel();
+    LeaveSharedUpdateTimer();
     QueueDisc::DoDispose();
 }
 
+std::map<Time, PieQueueDisc::SharedUpdateTimer>&
+PieQueueDisc::GetSharedUpdateTimers()
+{
+    static std::map<Time, SharedUpdateTimer> timers;
+    return timers;
+}
+
+void
+PieQueueDisc::RunSharedUpdateTimer(Time tUpdate)
+{
+    NS_LOG_FUNCTION(tUpdate);
+    auto& timer = GetSharedUpdateTimers().at(tUpdate);
+    for (auto member : timer.members)
+    {
+        member->CalculateP();
+    }
+    timer.event = Simulator::Schedule(tUpdate, &PieQueueDisc::RunSharedUpdateTimer, tUpdate);
+}
+
+void
+PieQueueDisc::ClearSharedUpdateTimers()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    for (auto& [tUpdate, timer] : GetSharedUpdateTimers())
+    {
+        for (auto member : timer.members)
+        {
+            member->m_sharedTimerIndex = std::numeric_limits<std::size_t>::max();
+        }
+    }
+    GetSharedUpdateTimers().clear();
+}
+
+void
+PieQueueDisc::JoinSharedUpdateTimer()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(m_tUpdate.IsStrictlyPositive());
+    m_rtrsEvent.Cancel();
+
+    auto& timers = GetSharedUpdateTimers();
+    if (timers.empty())
+    {
+        Simulator::ScheduleDestroy(&PieQueueDisc::ClearSharedUpdateTimers);
+    }
+    auto& timer = timers[m_tUpdate];
+    m_sharedTimerIndex = timer.members.size();
+    timer.members.push_back(this);
+    if (!timer.event.IsPending())
+    {
+        // first expiration at the first multiple of the period after the start time
+        const auto start = Simulator::Now() + m_sUpdate;
+        const auto period = m_tUpdate.GetTimeStep();
+        const auto n = (start.GetTimeStep() + period - 1) / period;
+        timer.event = Simulator::Schedule(m_tUpdate * n - Simulator::Now(),
+                                          &PieQueueDisc::RunSharedUpdateTimer,
+                                          m_tUpdate);
+    }
+}
+
+void
+PieQueueDisc::LeaveSharedUpdateTimer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_sharedTimerIndex == std::numeric_limits<std::size_t>::max())
+    {
+        return;
+    }
+    auto& timers = GetSharedUpdateTimers();
+    auto it = timers.find(m_tUpdate);
+    NS_ASSERT(it != timers.end() && it->second.members[m_sharedTimerIndex] == this);
+    auto& members = it->second.members;
+    members[m_sharedTimerIndex] = members.back();
+    members[m_sharedTimerIndex]->m_sharedTimerIndex = m_sharedTimerIndex;
+    members.pop_back();
+    m_sharedTimerIndex = std::numeric_limits<std::size_t>::max();
+    if (members.empty())
+    {
+        it->second.event.Cancel();
+        timers.erase(it);
+    }
+}
+
 Time
 PieQueueDisc::GetQueueDelay()
 {
@@ -269,6 +363,10 @@ PieQueueDisc::InitializeParams()
     m_qDelayOld = Seconds(0);
     m_accuProb = 0.0;
     m_active = false;
+    if (m_sharedUpdateTimer)
+    {
+        JoinSharedUpdateTimer();
+    }
 }
 
 bool
@@ -464,7 +562,14 @@ PieQueueDisc::CalculateP()
     }
 
     m_qDelayOld = qDelay;
-    m_rtrsEvent = Simulator::Schedule(m_tUpdate, &PieQueueDisc::CalculateP, this);
+}
+
+void
+PieQueueDisc::RunUpdateTimer()
+{
+    NS_LOG_FUNCTION(this);
+    CalculateP();
+    m_rtrsEvent = Simulator::Schedule(m_tUpdate, &PieQueueDisc::RunUpdateTimer, this);
 }
 
 Ptr<QueueDiscItem>
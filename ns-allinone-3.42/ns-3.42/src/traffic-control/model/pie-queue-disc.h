@@ -36,6 +36,9 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/timer.h"
 
+#include <map>
+#include <vector>
+
 #define BURST_RESET_TIMEOUT 1.5
 
 class PieQueueDiscTestCase; // Forward declaration for unit test
@@ -138,6 +141,51 @@ class PieQueueDisc : public QueueDisc
      */
     void CalculateP();
 
+    /**
+     * Calculate the drop probability and reschedule the update timer of this queue disc
+     */
+    void RunUpdateTimer();
+
+    /**
+     * \brief Update timer shared by the PIE queue discs with the same update period.
+     *
+     * The shared timer fires at the multiples of the update period and updates the
+     * drop probability of all its members in a single event.
+     */
+    struct SharedUpdateTimer
+    {
+        EventId event;                      //!< Next expiration of the timer
+        std::vector<PieQueueDisc*> members; //!< Queue discs updated by the timer
+    };
+
+    /**
+     * \return the shared update timers, indexed by update period
+     */
+    static std::map<Time, SharedUpdateTimer>& GetSharedUpdateTimers();
+
+    /**
+     * Update the drop probability of the members of a shared update timer and
+     * reschedule the timer
+     * \param tUpdate the update period of the timer
+     */
+    static void RunSharedUpdateTimer(Time tUpdate);
+
+    /**
+     * Remove all the shared update timers, at the end of the simulation
+     */
+    static void ClearSharedUpdateTimers();
+
+    /**
+     * Use the shared update timer for the update period of this queue disc instead
+     * of its own timer
+     */
+    void JoinSharedUpdateTimer();
+
+    /**
+     * Stop using the shared update timer, if this queue disc uses it
+     */
+    void LeaveSharedUpdateTimer();
+
     static const uint64_t DQCOUNT_INVALID =
         std::numeric_limits<uint64_t>::max(); //!< Invalid dqCount value
 
@@ -160,6 +208,7 @@ class PieQueueDisc : public QueueDisc
     Time m_activeThreshold;    //!< Threshold for activating PIE (disabled by default)
     Time m_ceThreshold;        //!< Threshold above which to CE mark
     bool m_useL4s;             //!< True if L4S is used (ECT1 packets are marked at CE threshold)
+    bool m_sharedUpdateTimer;  //!< True to update the drop probability with a shared timer
 
     // ** Variables maintained by PIE
     double m_dropProb;        //!< Variable used in calculation of drop probability
@@ -178,6 +227,7 @@ class PieQueueDisc : public QueueDisc
     Ptr<UniformRandomVariable> m_uv; //!< Rng stream
     double m_accuProb;               //!< Accumulated drop probability
     bool m_active;                   //!< Indicates whether PIE is in active state or not
+    std::size_t m_sharedTimerIndex;  //!< Index among the members of the shared update timer
 };
 
 }; // namespace ns3
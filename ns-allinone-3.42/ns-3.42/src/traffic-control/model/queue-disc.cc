@@ -29,6 +29,8 @@
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -257,6 +259,12 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("BurstSize",
+                          "The maximum number of packets dequeued and sent together to the "
+                          "device, if the device queue has room for them",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&QueueDisc::m_burstSize),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -381,6 +389,8 @@ QueueDisc::DoDispose()
     m_classes.clear();
     m_devQueueIface = nullptr;
     m_send = nullptr;
+    m_sendBurst = nullptr;
+    m_burst.clear();
     m_requeued = nullptr;
     m_internalQueueDbeFunctor = nullptr;
     m_internalQueueDadFunctor = nullptr;
@@ -555,6 +565,20 @@ QueueDisc::GetSendCallback() const
     return m_send;
 }
 
+void
+QueueDisc::SetSendBurstCallback(SendBurstCallback func)
+{
+    NS_LOG_FUNCTION(this);
+    m_sendBurst = func;
+}
+
+QueueDisc::SendBurstCallback
+QueueDisc::GetSendBurstCallback() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_sendBurst;
+}
+
 void
 QueueDisc::SetQuota(const uint32_t quota)
 {
@@ -949,13 +973,27 @@ QueueDisc::Run()
     if (RunBegin())
     {
         uint32_t quota = m_quota;
-        while (Restart())
+        if (m_burstSize > 1 && m_sendBurst)
+        {
+            while (RestartBurst(quota))
+            {
+                if (quota == 0)
+                {
+                    /// \todo netif_schedule (q);
+                    break;
+                }
+            }
+        }
+        else
         {
-            quota -= 1;
-            if (quota <= 0)
+            while (Restart())
             {
-                /// \todo netif_schedule (q);
-                break;
+                quota -= 1;
+                if (quota <= 0)
+                {
+                    /// \todo netif_schedule (q);
+                    break;
+                }
             }
         }
         RunEnd();
@@ -996,6 +1034,88 @@ QueueDisc::Restart()
     return Transmit(item);
 }
 
+bool
+QueueDisc::RestartBurst(uint32_t& quota)
+{
+    NS_LOG_FUNCTION(this << quota);
+    Ptr<QueueDiscItem> item = DequeuePacket();
+    if (!item)
+    {
+        NS_LOG_LOGIC("No packet to send");
+        return false;
+    }
+
+    // each packet sent to a multi-queue device has to be checked against its own
+    // transmission queue, hence packets are sent one at a time
+    if (m_devQueueIface && m_devQueueIface->GetNTxQueues() > 1)
+    {
+        quota--;
+        return Transmit(item);
+    }
+
+    // DequeuePacket returned a packet, hence the device queue is not stopped and
+    // there is room for at least one packet
+    uint32_t limit = std::min(m_burstSize, quota);
+    if (m_devQueueIface)
+    {
+        limit = std::min(limit, m_devQueueIface->GetTxQueue(0)->GetBulkLimit());
+    }
+
+    uint32_t nItems = 1;
+    m_burst.push_back(item);
+    while (nItems < limit && GetNPackets() > 0)
+    {
+        item = Dequeue();
+        if (!item)
+        {
+            // Restart would not be called again after the queue disc failed to
+            // provide a packet
+            TransmitBurst();
+            quota -= nItems;
+            return false;
+        }
+        item->AddHeader();
+        nItems++;
+        // the packets of a burst share the destination address and the protocol number
+        if (item->GetAddress() != m_burst.front()->GetAddress() ||
+            item->GetProtocol() != m_burst.front()->GetProtocol())
+        {
+            TransmitBurst();
+        }
+        m_burst.push_back(item);
+    }
+    TransmitBurst();
+    quota -= nItems;
+
+    // if the queue disc is empty or the device queue is now stopped, return false so
+    // that the Run method does not attempt to dequeue other packets and exits
+    return !(GetNPackets() == 0 ||
+             (m_devQueueIface && m_devQueueIface->GetTxQueue(0)->IsStopped()));
+}
+
+void
+QueueDisc::TransmitBurst()
+{
+    NS_LOG_FUNCTION(this << m_burst.size());
+
+    // a single queue device makes no use of the priority tag
+    for (const auto& item : m_burst)
+    {
+        SocketPriorityTag priorityTag;
+        item->GetPacket()->RemovePacketTag(priorityTag);
+    }
+    if (m_burst.size() == 1)
+    {
+        NS_ASSERT_MSG(m_send, "Send callback not set");
+        m_send(m_burst.front());
+    }
+    else
+    {
+        m_sendBurst(m_burst);
+    }
+    m_burst.clear();
+}
+
 Ptr<QueueDiscItem>
 QueueDisc::DequeuePacket()
 {
@@ -378,6 +378,24 @@ class QueueDisc : public Object
      */
     SendCallback GetSendCallback() const;
 
+    /// Callback invoked to send a burst of packets to the receiving object when Run is called
+    typedef std::function<void(const std::vector<Ptr<QueueDiscItem>>&)> SendBurstCallback;
+
+    /**
+     * \param func the callback to send a burst of packets to the receiving object.
+     *
+     * Set the callback used by the Run method to send together the packets it
+     * dequeues, when the BurstSize attribute is greater than one. All the packets
+     * of a burst have the same destination address and protocol number. If this
+     * callback is not set, packets are always sent one at a time.
+     */
+    void SetSendBurstCallback(SendBurstCallback func);
+
+    /**
+     * \return the callback to send a burst of packets to the receiving object.
+     */
+    SendBurstCallback GetSendBurstCallback() const;
+
     /**
      * \brief Set the maximum number of dequeue operations following a packet enqueue
      * \param quota the maximum number of dequeue operations following a packet enqueue.
@@ -648,6 +666,22 @@ class QueueDisc : public Object
      */
     bool Restart();
 
+    /**
+     * Modelled after the Linux function qdisc_restart (net/sched/sch_generic.c) when
+     * bulk dequeue is enabled (try_bulk_dequeue_skb). Dequeue up to as many packets as
+     * the burst size, the quota and the room in the device queue allow (see
+     * NetDeviceQueue::GetBulkLimit), and send them to the device together.
+     * \param quota the number of packets that can still be dequeued in this run, decreased
+     *        by the number of dequeued packets
+     * \return true if the device queue is not stopped and the queue disc is not empty
+     */
+    bool RestartBurst(uint32_t& quota);
+
+    /**
+     * Send the packets of the current burst to the device and clear the burst.
+     */
+    void TransmitBurst();
+
     /**
      * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
      * \return the requeued packet, if any, or the packet dequeued by the queue disc, otherwise.
@@ -696,10 +730,13 @@ class QueueDisc : public Object
     TracedCallback<Time> m_sojourn;   //!< Sojourn time of the latest dequeued packet
     QueueSize m_maxSize;              //!< max queue size
 
-    Stats m_stats;    //!< The collected statistics
-    uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
+    Stats m_stats;                           //!< The collected statistics
+    uint32_t m_quota;                        //!< Maximum number of packets dequeued in a qdisc run
+    uint32_t m_burstSize;                    //!< Maximum number of packets sent together
+    std::vector<Ptr<QueueDiscItem>> m_burst; //!< Packets to send together to the device
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
+    SendBurstCallback m_sendBurst; //!< Callback used to send a burst to the receiving object
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
@@ -555,6 +555,9 @@ RedQueueDisc::InitializeParams()
         m_qW = 1.0 - std::exp(-10.0 / m_ptc);
     }
 
+    // fraction of the average queue left after 50 ms of idle time
+    m_cautiousFrac = std::pow((1 - m_qW), m_ptc * 0.05);
+
     if (m_bottom == 0)
     {
         m_bottom = 0.01;
@@ -634,7 +637,8 @@ RedQueueDisc::Estimator(uint32_t nQueued, uint32_t m, double qAvg, double qW)
 {
     NS_LOG_FUNCTION(this << nQueued << m << qAvg << qW);
 
-    double newAve = qAvg * std::pow(1.0 - qW, m);
+    // m is 1 unless the queue disc was idle, avoid calling pow for every packet
+    double newAve = qAvg * (m == 1 ? 1.0 - qW : std::pow(1.0 - qW, m));
     newAve += qW * nQueued;
 
     Time now = Simulator::Now();
@@ -665,12 +669,9 @@ RedQueueDisc::DropEarly(Ptr<QueueDiscItem> item, uint32_t qSize)
         /*
          * Don't drop/mark if the instantaneous queue is much below the average.
          * For experimental purposes only.
-         * pkts: the number of packets arriving in 50 ms
+         * m_cautiousFrac: (1 - m_qW) to the number of packets arriving in 50 ms
          */
-        double pkts = m_ptc * 0.05;
-        double fraction = std::pow((1 - m_qW), pkts);
-
-        if ((double)qSize < fraction * m_qAvg)
+        if ((double)qSize < m_cautiousFrac * m_qAvg)
         {
             // Queue could have been empty for 0.05 seconds
             return false;
@@ -685,11 +686,9 @@ RedQueueDisc::DropEarly(Ptr<QueueDiscItem> item, uint32_t qSize)
          * Decrease the drop probability if the instantaneous
          * queue is much below the average.
          * For experimental purposes only.
-         * pkts: the number of packets arriving in 50 ms
+         * m_cautiousFrac: (1 - m_qW) to the number of packets arriving in 50 ms
          */
-        double pkts = m_ptc * 0.05;
-        double fraction = std::pow((1 - m_qW), pkts);
-        double ratio = qSize / (fraction * m_qAvg);
+        double ratio = qSize / (m_cautiousFrac * m_qAvg);
 
         if (ratio < 1.0)
         {
@@ -293,6 +293,7 @@ class RedQueueDisc : public QueueDisc
     double m_vB;             //!< -m_minTh / (m_maxTh - m_minTh)
     double m_vC;             //!< (1.0 - m_curMaxP) / m_maxTh - used in "gentle" mode
     double m_vD;             //!< 2.0 * m_curMaxP - 1.0 - used in "gentle" mode
+    double m_cautiousFrac;   //!< (1 - m_qW)^(m_ptc * 0.05) - used in "cautious" modes 1 and 2
     double m_curMaxP;        //!< Current max_p
     Time m_lastSet;          //!< Last time m_curMaxP was updated
     double m_vProb;          //!< Prob. of packet drop
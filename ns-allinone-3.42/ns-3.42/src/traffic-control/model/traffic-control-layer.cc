@@ -23,6 +23,7 @@
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-map.h"
+#include "ns3/packet-burst.h"
 #include "ns3/packet.h"
 #include "ns3/socket.h"
 
@@ -212,6 +213,16 @@ TrafficControlLayer::ScanDevices()
                 q->SetSendCallback([dev](Ptr<QueueDiscItem> item) {
                     dev->Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
                 });
+                q->SetSendBurstCallback([dev](const std::vector<Ptr<QueueDiscItem>>& items) {
+                    auto burst = Create<PacketBurst>();
+                    for (const auto& item : items)
+                    {
+                        burst->AddPacket(item->GetPacket());
+                    }
+                    dev->SendBurst(burst,
+                                   items.front()->GetAddress(),
+                                   items.front()->GetProtocol());
+                });
             }
         }
     }
@@ -276,6 +287,7 @@ TrafficControlLayer::DeleteRootQueueDiscOnDevice(Ptr<NetDevice> device)
     {
         q->SetNetDeviceQueueInterface(nullptr);
         q->SetSendCallback(nullptr);
+        q->SetSendBurstCallback(nullptr);
     }
     ndi->second.m_queueDiscsToWake.clear();
 
@@ -0,0 +1,367 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/data-rate.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/htb-queue-disc.h"
+#include "ns3/integer.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-filter.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Item
+ */
+class HtbQueueDiscTestItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param p the packet
+     */
+    HtbQueueDiscTestItem(Ptr<Packet> p);
+    void AddHeader() override;
+    bool Mark() override;
+};
+
+HtbQueueDiscTestItem::HtbQueueDiscTestItem(Ptr<Packet> p)
+    : QueueDiscItem(p, Mac48Address(), 0)
+{
+}
+
+void
+HtbQueueDiscTestItem::AddHeader()
+{
+}
+
+bool
+HtbQueueDiscTestItem::Mark()
+{
+    return false;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Packet Filter
+ *
+ * Packets of 1000 bytes or more are classified in the class given by their size minus
+ * 1000; smaller packets are not classified.
+ */
+class HtbQueueDiscTestFilter : public PacketFilter
+{
+  private:
+    bool CheckProtocol(Ptr<QueueDiscItem> item) const override;
+    int32_t DoClassify(Ptr<QueueDiscItem> item) const override;
+};
+
+bool
+HtbQueueDiscTestFilter::CheckProtocol(Ptr<QueueDiscItem> item) const
+{
+    return true;
+}
+
+int32_t
+HtbQueueDiscTestFilter::DoClassify(Ptr<QueueDiscItem> item) const
+{
+    return item->GetSize() >= 1000 ? item->GetSize() - 1000 : PF_NO_MATCH;
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Classification Test Case
+ */
+class HtbQueueDiscClassifyTestCase : public TestCase
+{
+  public:
+    HtbQueueDiscClassifyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HtbQueueDiscClassifyTestCase::HtbQueueDiscClassifyTestCase()
+    : TestCase("Classification of packets into the leaf classes of HtbQueueDisc")
+{
+}
+
+void
+HtbQueueDiscClassifyTestCase::DoRun()
+{
+    auto qdisc = CreateObject<HtbQueueDisc>();
+    qdisc->AddPacketFilter(CreateObject<HtbQueueDiscTestFilter>());
+    auto root = CreateObject<HtbQueueDiscClass>();
+    root->SetAttribute("Rate", DataRateValue(DataRate("10Mbps")));
+    const auto rootIndex = qdisc->AddInnerClass(root);
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        auto cl = CreateObject<HtbQueueDiscClass>();
+        cl->SetAttribute("Parent", IntegerValue(rootIndex));
+        cl->SetQueueDisc(CreateObject<FifoQueueDisc>());
+        qdisc->AddQueueDiscClass(cl);
+    }
+    qdisc->Initialize();
+
+    NS_TEST_EXPECT_MSG_EQ(qdisc->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(1001))),
+                          true,
+                          "The packet should have been enqueued in the second class");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetQueueDiscClass(1)->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "The second class should store one packet");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(1002))),
+                          false,
+                          "A packet classified in a non existent class should be dropped");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(500))),
+                          false,
+                          "An unclassified packet should be dropped if there is no default class");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetStats().GetNDroppedPackets(HtbQueueDisc::UNCLASSIFIED_DROP),
+                          2,
+                          "Two packets should have been dropped because unclassified");
+
+    qdisc->SetAttribute("DefaultClass", UintegerValue(0));
+    NS_TEST_EXPECT_MSG_EQ(qdisc->Enqueue(Create<HtbQueueDiscTestItem>(Create<Packet>(500))),
+                          true,
+                          "An unclassified packet should be enqueued in the default class");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetQueueDiscClass(0)->GetQueueDisc()->GetNPackets(),
+                          1,
+                          "The first class should store one packet");
+
+    // both classes can send at their rate, packets are dequeued in round robin order
+    auto item = qdisc->Dequeue();
+    NS_TEST_ASSERT_MSG_NE(item, nullptr, "A packet should have been dequeued");
+    NS_TEST_EXPECT_MSG_EQ(item->GetSize(), 1001, "The packet of the second class comes first");
+    item = qdisc->Dequeue();
+    NS_TEST_ASSERT_MSG_NE(item, nullptr, "A packet should have been dequeued");
+    NS_TEST_EXPECT_MSG_EQ(item->GetSize(), 500, "The packet of the first class comes next");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->Dequeue(), nullptr, "The queue disc should be empty");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Configuration of a class of HtbQueueDisc
+ */
+struct HtbTestClass
+{
+    std::string rate;  //!< the rate of the class
+    std::string ceil;  //!< the ceil rate of the class
+    uint8_t priority;  //!< the priority of the class
+    int32_t parent;    //!< the index of the parent inner class
+};
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Rates Test Case
+ *
+ * Every leaf class receives 20 Mbps of 1000-byte packets for one second, the device
+ * transmits at 100 Mbps. The bytes sent by each leaf class must match its expected rate.
+ */
+class HtbQueueDiscRatesTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param name the name of the test
+     * \param inner the inner classes
+     * \param leaves the leaf classes
+     * \param expectedMbps the expected rate of each leaf class, in Mbps
+     */
+    HtbQueueDiscRatesTestCase(std::string name,
+                              std::vector<HtbTestClass> inner,
+                              std::vector<HtbTestClass> leaves,
+                              std::vector<double> expectedMbps);
+
+  private:
+    void DoRun() override;
+    /**
+     * Send a packet for a leaf class and schedule the next one
+     * \param dev the device
+     * \param leaf the leaf class
+     */
+    void SendPacket(Ptr<NetDevice> dev, uint32_t leaf);
+    /**
+     * Check the bytes sent by each leaf class
+     * \param qdisc the queue disc
+     */
+    void CheckRates(Ptr<QueueDisc> qdisc);
+
+    std::vector<HtbTestClass> m_inner;  //!< the inner classes
+    std::vector<HtbTestClass> m_leaves; //!< the leaf classes
+    std::vector<double> m_expectedMbps; //!< the expected rates of the leaf classes
+};
+
+HtbQueueDiscRatesTestCase::HtbQueueDiscRatesTestCase(std::string name,
+                                                     std::vector<HtbTestClass> inner,
+                                                     std::vector<HtbTestClass> leaves,
+                                                     std::vector<double> expectedMbps)
+    : TestCase("Rates of the classes of HtbQueueDisc: " + name),
+      m_inner(inner),
+      m_leaves(leaves),
+      m_expectedMbps(expectedMbps)
+{
+}
+
+void
+HtbQueueDiscRatesTestCase::SendPacket(Ptr<NetDevice> dev, uint32_t leaf)
+{
+    Ptr<TrafficControlLayer> tc = dev->GetNode()->GetObject<TrafficControlLayer>();
+    tc->Send(dev, Create<HtbQueueDiscTestItem>(Create<Packet>(1000 + leaf)));
+    if (Simulator::Now() < Seconds(1))
+    {
+        Simulator::Schedule(DataRate("20Mbps").CalculateBytesTxTime(1000),
+                            &HtbQueueDiscRatesTestCase::SendPacket,
+                            this,
+                            dev,
+                            leaf);
+    }
+}
+
+void
+HtbQueueDiscRatesTestCase::CheckRates(Ptr<QueueDisc> qdisc)
+{
+    for (uint32_t i = 0; i < m_leaves.size(); i++)
+    {
+        const auto sent = qdisc->GetQueueDiscClass(i)->GetQueueDisc()->GetStats().nTotalSentBytes;
+        const auto expected = m_expectedMbps[i] * 1e6 / 8;
+        NS_TEST_EXPECT_MSG_EQ_TOL(static_cast<double>(sent),
+                                  expected,
+                                  0.05 * expected,
+                                  "Unexpected rate of the leaf class " << i);
+    }
+}
+
+void
+HtbQueueDiscRatesTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    n.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Mbps")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("5p"));
+    Ptr<NetDevice> txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+
+    TrafficControlHelper tch;
+    uint16_t handle = tch.SetRootQueueDisc("ns3::HtbQueueDisc");
+    TrafficControlHelper::ClassIdList cls =
+        tch.AddQueueDiscClasses(handle, m_leaves.size(), "ns3::HtbQueueDiscClass");
+    tch.AddChildQueueDiscs(handle, cls, "ns3::FifoQueueDisc");
+    QueueDiscContainer qdiscs = tch.Install(txDev);
+
+    auto htb = DynamicCast<HtbQueueDisc>(qdiscs.Get(0));
+    htb->AddPacketFilter(CreateObject<HtbQueueDiscTestFilter>());
+    for (const auto& cfg : m_inner)
+    {
+        auto cl = CreateObject<HtbQueueDiscClass>();
+        cl->SetAttribute("Rate", DataRateValue(DataRate(cfg.rate)));
+        cl->SetAttribute("Ceil", DataRateValue(DataRate(cfg.ceil)));
+        cl->SetAttribute("Parent", IntegerValue(cfg.parent));
+        htb->AddInnerClass(cl);
+    }
+    for (uint32_t i = 0; i < m_leaves.size(); i++)
+    {
+        auto cl = htb->GetQueueDiscClass(i);
+        cl->SetAttribute("Rate", DataRateValue(DataRate(m_leaves[i].rate)));
+        cl->SetAttribute("Ceil", DataRateValue(DataRate(m_leaves[i].ceil)));
+        cl->SetAttribute("Priority", UintegerValue(m_leaves[i].priority));
+        cl->SetAttribute("Parent", IntegerValue(m_leaves[i].parent));
+        // equal quanta, so that the excess bandwidth is shared equally
+        cl->SetAttribute("Quantum", UintegerValue(1500));
+        Simulator::Schedule(Seconds(0), &HtbQueueDiscRatesTestCase::SendPacket, this, txDev, i);
+    }
+
+    Simulator::Schedule(Seconds(1), &HtbQueueDiscRatesTestCase::CheckRates, this, htb);
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Htb Queue Disc Test Suite
+ */
+static class HtbQueueDiscTestSuite : public TestSuite
+{
+  public:
+    HtbQueueDiscTestSuite()
+        : TestSuite("htb-queue-disc", Type::UNIT)
+    {
+        AddTestCase(new HtbQueueDiscClassifyTestCase(), TestCase::Duration::QUICK);
+        // the excess bandwidth of the parent is shared equally
+        AddTestCase(new HtbQueueDiscRatesTestCase("borrowing",
+                                                  {{"10Mbps", "10Mbps", 0, -1}},
+                                                  {{"2Mbps", "10Mbps", 0, 0},
+                                                   {"6Mbps", "10Mbps", 0, 0}},
+                                                  {3, 7}),
+                    TestCase::Duration::QUICK);
+        // a class cannot exceed its ceil rate
+        AddTestCase(new HtbQueueDiscRatesTestCase("ceil",
+                                                  {{"10Mbps", "10Mbps", 0, -1}},
+                                                  {{"1Mbps", "3Mbps", 0, 0},
+                                                   {"1Mbps", "10Mbps", 0, 0}},
+                                                  {3, 7}),
+                    TestCase::Duration::QUICK);
+        // the excess bandwidth is lent to the classes with the highest priority first
+        AddTestCase(new HtbQueueDiscRatesTestCase("priority",
+                                                  {{"10Mbps", "10Mbps", 0, -1}},
+                                                  {{"1Mbps", "10Mbps", 0, 0},
+                                                   {"1Mbps", "10Mbps", 1, 0}},
+                                                  {9, 1}),
+                    TestCase::Duration::QUICK);
+        // classes borrow from their nearest ancestor first
+        AddTestCase(new HtbQueueDiscRatesTestCase("hierarchy",
+                                                  {{"10Mbps", "10Mbps", 0, -1},
+                                                   {"3Mbps", "10Mbps", 0, 0},
+                                                   {"7Mbps", "10Mbps", 0, 0}},
+                                                  {{"1Mbps", "10Mbps", 0, 1},
+                                                   {"1Mbps", "10Mbps", 0, 2},
+                                                   {"1Mbps", "10Mbps", 0, 2}},
+                                                  {3, 3.5, 3.5}),
+                    TestCase::Duration::QUICK);
+        // a class with no parent cannot borrow
+        AddTestCase(new HtbQueueDiscRatesTestCase("no parent",
+                                                  {{"5Mbps", "5Mbps", 0, -1}},
+                                                  {{"2Mbps", "10Mbps", 0, -1},
+                                                   {"1Mbps", "10Mbps", 0, 0}},
+                                                  {2, 5}),
+                    TestCase::Duration::QUICK);
+    }
+} g_htbQueueDiscTestSuite; ///< the test suite
@@ -712,6 +712,48 @@ PieQueueDiscTestCase::RunPieTest(QueueSizeUnit mode)
     NS_TEST_ASSERT_MSG_EQ(st.GetNMarkedPackets(PieQueueDisc::UNFORCED_MARK),
                           0,
                           "There should be zero marks");
+
+    // test 17: same as test 2, with two queue discs using the shared update timer
+    std::vector<Ptr<PieQueueDisc>> queues;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        queue = CreateObject<PieQueueDisc>();
+        queue->SetAttributeFailSafe("MaxSize", QueueSizeValue(QueueSize(mode, qSize)));
+        queue->SetAttributeFailSafe("Tupdate", TimeValue(Seconds(0.03)));
+        queue->SetAttributeFailSafe("DequeueThreshold", UintegerValue(10000));
+        queue->SetAttributeFailSafe("QueueDelayReference", TimeValue(Seconds(0.02)));
+        queue->SetAttributeFailSafe("MaxBurstAllowance", TimeValue(Seconds(0.1)));
+        NS_TEST_ASSERT_MSG_EQ(queue->SetAttributeFailSafe("SharedUpdateTimer", BooleanValue(true)),
+                              true,
+                              "Verify that we can actually set the attribute SharedUpdateTimer");
+        queue->Initialize();
+        testAttributes = Create<PieQueueDiscTestItem>(Create<Packet>(pktSize), dest, false);
+        EnqueueWithDelay(queue, pktSize, 400, testAttributes);
+        DequeueWithDelay(queue, 0.012, 400);
+        queues.push_back(queue);
+    }
+    NS_TEST_ASSERT_MSG_EQ(PieQueueDisc::GetSharedUpdateTimers().size(),
+                          1,
+                          "The queue discs should share a single update timer");
+    NS_TEST_ASSERT_MSG_EQ(PieQueueDisc::GetSharedUpdateTimers().at(Seconds(0.03)).members.size(),
+                          2,
+                          "Both queue discs should be updated by the shared timer");
+    Simulator::Stop(Seconds(8.0));
+    Simulator::Run();
+    for (const auto& q : queues)
+    {
+        st = q->GetStats();
+        NS_TEST_ASSERT_MSG_NE(st.GetNDroppedPackets(PieQueueDisc::UNFORCED_DROP),
+                              0,
+                              "There should be some unforced drops");
+        NS_TEST_ASSERT_MSG_EQ(st.GetNDroppedPackets(PieQueueDisc::FORCED_DROP),
+                              0,
+                              "There should be zero forced drops");
+        q->Dispose();
+    }
+    NS_TEST_ASSERT_MSG_EQ(PieQueueDisc::GetSharedUpdateTimers().empty(),
+                          true,
+                          "The shared update timer should be removed with its last member");
 }
 
 void
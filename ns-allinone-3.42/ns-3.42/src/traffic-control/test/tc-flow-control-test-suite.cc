@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -492,6 +493,169 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup traffic-control-test
+ *
+ * \brief Traffic Control Burst Test Case
+ *
+ * Ten packets are enqueued in the queue disc installed on a device whose queue can store
+ * five packets, then the queue disc is run. The packets the queue disc can send to the device
+ * at once must be sent in bursts, without exceeding the room in the device queue, and the
+ * packets must be transmitted in order, as when they are sent one at a time.
+ */
+class TcBurstTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param burstSize the value of the BurstSize attribute of the queue disc
+     * \param expectedBursts the expected sizes of the bursts sent to the device
+     */
+    TcBurstTestCase(uint32_t burstSize, std::vector<std::size_t> expectedBursts);
+
+  private:
+    void DoRun() override;
+    /**
+     * Enqueue packets in the root queue disc installed on a device and run the queue disc
+     * \param dev the device
+     * \param nPackets the number of packets to enqueue
+     */
+    void EnqueueAndRun(Ptr<NetDevice> dev, uint16_t nPackets);
+    /**
+     * Check the number of packets stored in the device queue and in the queue disc
+     * \param dev the device
+     * \param deviceQueuePackets the expected number of packets in the device queue
+     * \param qdiscPackets the expected number of packets in the queue disc
+     */
+    void CheckPackets(Ptr<NetDevice> dev, uint32_t deviceQueuePackets, uint32_t qdiscPackets);
+    /**
+     * Promiscuous receive callback of the receiving device
+     * \param dev the device
+     * \param p the received packet
+     * \param protocol the protocol number
+     * \param from the address of the sender
+     * \param to the address of the receiver
+     * \param packetType the type of the packet
+     * \return true
+     */
+    bool Receive(Ptr<NetDevice> dev,
+                 Ptr<const Packet> p,
+                 uint16_t protocol,
+                 const Address& from,
+                 const Address& to,
+                 NetDevice::PacketType packetType);
+
+    uint32_t m_burstSize;                      //!< the BurstSize attribute of the queue disc
+    std::vector<std::size_t> m_expectedBursts; //!< the expected sizes of the bursts
+    std::vector<std::size_t> m_bursts;         //!< the sizes of the bursts sent to the device
+    std::vector<uint64_t> m_sentUids;          //!< UIDs of the enqueued packets
+    std::vector<uint64_t> m_receivedUids;      //!< UIDs of the received packets
+};
+
+TcBurstTestCase::TcBurstTestCase(uint32_t burstSize, std::vector<std::size_t> expectedBursts)
+    : TestCase("Test the transmission of bursts of " + std::to_string(burstSize) + " packets"),
+      m_burstSize(burstSize),
+      m_expectedBursts(expectedBursts)
+{
+}
+
+void
+TcBurstTestCase::EnqueueAndRun(Ptr<NetDevice> dev, uint16_t nPackets)
+{
+    Ptr<TrafficControlLayer> tc = dev->GetNode()->GetObject<TrafficControlLayer>();
+    Ptr<QueueDisc> qdisc = tc->GetRootQueueDiscOnDevice(dev);
+
+    // record the bursts sent to the device
+    auto sendBurst = qdisc->GetSendBurstCallback();
+    NS_TEST_ASSERT_MSG_EQ(bool(sendBurst), true, "The send burst callback has not been set");
+    qdisc->SetSendBurstCallback([this, sendBurst](const std::vector<Ptr<QueueDiscItem>>& items) {
+        m_bursts.push_back(items.size());
+        sendBurst(items);
+    });
+
+    for (uint16_t i = 0; i < nPackets; i++)
+    {
+        auto p = Create<Packet>(1000);
+        m_sentUids.push_back(p->GetUid());
+        qdisc->Enqueue(Create<QueueDiscTestItem>(p));
+    }
+    qdisc->Run();
+}
+
+void
+TcBurstTestCase::CheckPackets(Ptr<NetDevice> dev,
+                              uint32_t deviceQueuePackets,
+                              uint32_t qdiscPackets)
+{
+    PointerValue ptr;
+    dev->GetAttributeFailSafe("TxQueue", ptr);
+    Ptr<Queue<Packet>> queue = ptr.Get<Queue<Packet>>();
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(),
+                          deviceQueuePackets,
+                          "Unexpected number of packets in the device queue");
+
+    Ptr<TrafficControlLayer> tc = dev->GetNode()->GetObject<TrafficControlLayer>();
+    NS_TEST_EXPECT_MSG_EQ(tc->GetRootQueueDiscOnDevice(dev)->GetNPackets(),
+                          qdiscPackets,
+                          "Unexpected number of packets in the queue disc");
+}
+
+bool
+TcBurstTestCase::Receive(Ptr<NetDevice> dev,
+                         Ptr<const Packet> p,
+                         uint16_t protocol,
+                         const Address& from,
+                         const Address& to,
+                         NetDevice::PacketType packetType)
+{
+    m_receivedUids.push_back(p->GetUid());
+    return true;
+}
+
+void
+TcBurstTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+
+    n.Get(0)->AggregateObject(CreateObject<TrafficControlLayer>());
+    n.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+
+    SimpleNetDeviceHelper simple;
+
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+    rxDevC.Get(0)->SetPromiscReceiveCallback(MakeCallback(&TcBurstTestCase::Receive, this));
+
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("5p"));
+
+    Ptr<NetDevice> txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+    txDev->SetMtu(2500);
+
+    TrafficControlHelper tch = TrafficControlHelper::Default();
+    QueueDiscContainer qdiscs = tch.Install(txDev);
+    qdiscs.Get(0)->SetAttribute("BurstSize", UintegerValue(m_burstSize));
+
+    Simulator::Schedule(Seconds(0), &TcBurstTestCase::EnqueueAndRun, this, txDev, 10);
+
+    // The first packet is transmitted as soon as it is received by the device, which then
+    // stores the next five packets, hence four packets are left in the queue disc. The
+    // transmission of each packet takes 1000B/1Mbps = 8ms
+    Simulator::Schedule(MilliSeconds(1), &TcBurstTestCase::CheckPackets, this, txDev, 5, 4);
+    Simulator::Schedule(MilliSeconds(9), &TcBurstTestCase::CheckPackets, this, txDev, 5, 3);
+    Simulator::Schedule(MilliSeconds(81), &TcBurstTestCase::CheckPackets, this, txDev, 0, 0);
+
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ((m_bursts == m_expectedBursts), true, "Unexpected bursts");
+    NS_TEST_EXPECT_MSG_EQ((m_receivedUids == m_sentUids),
+                          true,
+                          "The packets must be received in the order they were enqueued");
+}
+
 /**
  * \ingroup traffic-control-test
  *
@@ -526,5 +690,9 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+
+        AddTestCase(new TcBurstTestCase(1, {}), TestCase::Duration::QUICK);
+        AddTestCase(new TcBurstTestCase(4, {4, 2}), TestCase::Duration::QUICK);
+        AddTestCase(new TcBurstTestCase(8, {5}), TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
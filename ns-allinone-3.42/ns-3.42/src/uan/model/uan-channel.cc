@@ -27,6 +27,7 @@
 #include "uan-transducer.h"
 #include "uan-tx-mode.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/net-device.h"
@@ -60,7 +61,15 @@ UanChannel::GetTypeId()
                                           "A pointer to the model of the channel ambient noise.",
                                           StringValue("ns3::UanNoiseModelDefault"),
                                           MakePointerAccessor(&UanChannel::m_noise),
-                                          MakePointerChecker<UanNoiseModel>());
+                                          MakePointerChecker<UanNoiseModel>())
+                            .AddAttribute("MaxRange",
+                                          "Distance, in meters, beyond which the transmissions "
+                                          "are not delivered to the receivers, neither as "
+                                          "signal nor as interference. Zero delivers them to "
+                                          "all the receivers.",
+                                          DoubleValue(0),
+                                          MakeDoubleAccessor(&UanChannel::m_maxRange),
+                                          MakeDoubleChecker<double>(0));
 
     return tid;
 }
@@ -68,6 +77,7 @@ UanChannel::GetTypeId()
 UanChannel::UanChannel()
     : Channel(),
       m_prop(nullptr),
+      m_maxRange(0),
       m_cleared(false)
 {
 }
@@ -167,6 +177,12 @@ UanChannel::TxPacket(Ptr<UanTransducer> src, Ptr<Packet> packet, double txPowerD
         {
             NS_LOG_DEBUG("Scheduling " << i->first->GetMac()->GetAddress());
             Ptr<MobilityModel> rcvrMobility = i->first->GetNode()->GetObject<MobilityModel>();
+            if (m_maxRange > 0 && senderMobility->GetDistanceFrom(rcvrMobility) > m_maxRange)
+            {
+                NS_LOG_DEBUG("Receiver out of range");
+                j++;
+                continue;
+            }
             Time delay = m_prop->GetDelay(senderMobility, rcvrMobility, txMode);
             UanPdp pdp = m_prop->GetPdp(senderMobility, rcvrMobility, txMode);
             double rxPowerDb =
@@ -118,6 +118,7 @@ class UanChannel : public Channel
     UanDeviceList m_devList;    //!< The list of devices on this channel.
     Ptr<UanPropModel> m_prop;   //!< The propagation model.
     Ptr<UanNoiseModel> m_noise; //!< The noise model.
+    double m_maxRange;          //!< Range beyond which transmissions are not delivered, in m.
     /** Has Clear ever been called on the channel. */
     bool m_cleared;
 
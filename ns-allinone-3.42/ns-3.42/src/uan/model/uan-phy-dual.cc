@@ -110,7 +110,7 @@ UanPhyCalcSinrDual::CalcSinrDb(Ptr<Packet> pkt,
                                         0.5);
                 }
             }
-            intKp += DbToKp(it->GetRxPowerDb());
+            intKp += it->GetRxPowerKp();
         }
     }
 
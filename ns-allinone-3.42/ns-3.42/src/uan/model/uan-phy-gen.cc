@@ -86,7 +86,7 @@ UanPhyCalcSinrDefault::CalcSinrDb(Ptr<Packet> pkt,
     auto it = arrivalList.begin();
     for (; it != arrivalList.end(); it++)
     {
-        intKp += DbToKp(it->GetRxPowerDb());
+        intKp += it->GetRxPowerKp();
     }
 
     double totalIntDb = KpToDb(intKp + DbToKp(ambNoiseDb));
@@ -202,7 +202,7 @@ UanPhyCalcSinrFhFsk::CalcSinrDb(Ptr<Packet> pkt,
             end = end + ts + clearingTime; // start + Seconds (ts);
             intPower += intPdp.SumTapsNc(start, end);
         }
-        intKp += DbToKp(it->GetRxPowerDb()) * intPower;
+        intKp += it->GetRxPowerKp() * intPower;
     }
 
     double totalIntDb = KpToDb(isiUpa + intKp + DbToKp(ambNoiseDb));
@@ -1094,7 +1094,7 @@ UanPhyGen::GetInterferenceDb(Ptr<Packet> pkt)
     {
         if (pkt != it->GetPacket())
         {
-            interfPower += DbToKp(it->GetRxPowerDb());
+            interfPower += it->GetRxPowerKp();
         }
     }
 
@@ -59,8 +59,14 @@ UanPropModelThorp::GetPathLossDb(Ptr<MobilityModel> a, Ptr<MobilityModel> b, Uan
 {
     double dist = a->GetDistanceFrom(b);
 
-    return m_SpreadCoef * 10.0 * std::log10(dist) +
-           (dist / 1000.0) * GetAttenDbKm(mode.GetCenterFreqHz() / 1000.0);
+    auto atten = m_attenDbKm.find(mode.GetCenterFreqHz());
+    if (atten == m_attenDbKm.end())
+    {
+        atten = m_attenDbKm
+                    .emplace(mode.GetCenterFreqHz(), GetAttenDbKm(mode.GetCenterFreqHz() / 1000.0))
+                    .first;
+    }
+    return m_SpreadCoef * 10.0 * std::log10(dist) + (dist / 1000.0) * atten->second;
 }
 
 UanPdp
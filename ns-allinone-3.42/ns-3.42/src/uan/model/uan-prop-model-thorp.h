@@ -22,6 +22,8 @@
 
 #include "uan-prop-model.h"
 
+#include <map>
+
 namespace ns3
 {
 
@@ -66,6 +68,8 @@ class UanPropModelThorp : public UanPropModel
     double GetAttenDbKm(double freqKhz);
 
     double m_SpreadCoef; //!< Spreading coefficient used in calculation of Thorp's approximation.
+    /// Attenuation in dB/km, by channel center frequency in Hz, computed once per frequency.
+    std::map<uint32_t, double> m_attenDbKm;
 
 }; // class UanPropModelThorp
 
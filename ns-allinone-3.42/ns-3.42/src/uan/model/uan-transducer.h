@@ -26,6 +26,7 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 
+#include <cmath>
 #include <list>
 
 namespace ns3
@@ -63,6 +64,7 @@ class UanPacketArrival
                      Time arrTime)
         : m_packet(packet),
           m_rxPowerDb(rxPowerDb),
+          m_rxPowerKp(std::pow(10, rxPowerDb / 10.0)),
           m_txMode(txMode),
           m_pdp(pdp),
           m_arrTime(arrTime)
@@ -95,6 +97,17 @@ class UanPacketArrival
         return m_rxPowerDb;
     }
 
+    /**
+     * Get the received signal strength in linear units, computed once on arrival
+     * so that the interference sums need not convert each arrival again.
+     *
+     * \return Received signal strength in kilopascals.
+     */
+    inline double GetRxPowerKp() const
+    {
+        return m_rxPowerKp;
+    }
+
     /**
      * Get the transmission mode of the packet.
      *
@@ -128,6 +141,7 @@ class UanPacketArrival
   private:
     Ptr<Packet> m_packet; //!< The arrived packet.
     double m_rxPowerDb;   //!< The received power, in dB.
+    double m_rxPowerKp;   //!< The received power, in kilopascals.
     UanTxMode m_txMode;   //!< The transmission mode.
     UanPdp m_pdp;         //!< The propagation delay profile.
     Time m_arrTime;       //!< The arrival time.
@@ -25,12 +25,14 @@
 #include "ns3/config.h"
 #include "ns3/ethernet-header.h"
 #include "ns3/log.h"
+#include "ns3/mobility-model.h"
 #include "ns3/node-list.h"
 #include "ns3/ppp-header.h"
 #include "ns3/simulator.h"
 #include "ns3/wifi-mac-header.h"
 #include "ns3/wifi-net-device.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 
@@ -38,24 +40,29 @@ NS_LOG_COMPONENT_DEFINE("PyViz");
 
 #define NUM_LAST_PACKETS 10
 
-static std::vector<std::string>
-PathSplit(std::string str)
+/**
+ * Parse the index held by an element of a trace context, e.g. the node index
+ * (element 1) or the device index (element 3) of
+ * "/NodeList/3/DeviceList/1/...", without splitting the whole context, since
+ * this is done for every traced packet.
+ * \param context the trace context
+ * \param element the index of the path element, empty elements excluded
+ * \returns the index held by the path element
+ */
+static int
+PathIndex(const std::string& context, std::size_t element)
 {
-    std::vector<std::string> results;
-    size_t cutAt;
-    while ((cutAt = str.find_first_of('/')) != std::string::npos)
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i <= element; i++)
     {
-        if (cutAt > 0)
+        pos = context.find_first_not_of('/', pos);
+        NS_ABORT_MSG_IF(pos == std::string::npos, "Unexpected trace context " << context);
+        if (i < element)
         {
-            results.push_back(str.substr(0, cutAt));
+            pos = context.find_first_of('/', pos);
         }
-        str = str.substr(cutAt + 1);
-    }
-    if (!str.empty())
-    {
-        results.push_back(str);
     }
-    return results;
+    return std::atoi(context.c_str() + pos);
 }
 
 namespace ns3
@@ -459,8 +466,7 @@ void
 PyViz::TraceDevQueueDrop(std::string context, Ptr<const Packet> packet)
 {
     NS_LOG_FUNCTION(context << packet->GetUid());
-    std::vector<std::string> splitPath = PathSplit(context);
-    int nodeIndex = std::stoi(splitPath[1]);
+    int nodeIndex = PathIndex(context, 1);
     Ptr<Node> node = NodeList::GetNode(nodeIndex);
 
     if (m_nodesOfInterest.find(nodeIndex) == m_nodesOfInterest.end())
@@ -524,9 +530,8 @@ PyViz::TraceNetDevTxCommon(const std::string& context,
 {
     NS_LOG_FUNCTION(context << packet->GetUid() << *packet);
 
-    std::vector<std::string> splitPath = PathSplit(context);
-    int nodeIndex = std::stoi(splitPath[1]);
-    int devIndex = std::stoi(splitPath[3]);
+    int nodeIndex = PathIndex(context, 1);
+    int devIndex = PathIndex(context, 3);
     Ptr<Node> node = NodeList::GetNode(nodeIndex);
     Ptr<NetDevice> device = node->GetDevice(devIndex);
 
@@ -647,9 +652,8 @@ PyViz::TraceNetDevRxCommon(const std::string& context,
     }
 
     NS_LOG_FUNCTION(context << uid);
-    std::vector<std::string> splitPath = PathSplit(context);
-    int nodeIndex = std::stoi(splitPath[1]);
-    int devIndex = std::stoi(splitPath[3]);
+    int nodeIndex = PathIndex(context, 1);
+    int devIndex = PathIndex(context, 3);
 
     // ---- statistics
     NetDeviceStatistics& stats = FindNetDeviceStatistics(nodeIndex, devIndex);
@@ -846,6 +850,7 @@ PyViz::GetTransmissionSamples() const
 {
     NS_LOG_DEBUG("GetTransmissionSamples BEGIN");
     TransmissionSampleList list;
+    list.reserve(m_transmissionSamples.size());
     for (auto iter = m_transmissionSamples.begin(); iter != m_transmissionSamples.end(); iter++)
     {
         TransmissionSample sample;
@@ -857,10 +862,28 @@ PyViz::GetTransmissionSamples() const
                              << ": " << sample.bytes << " bytes.");
         list.push_back(sample);
     }
+    if (m_maxTransmissionSamples > 0 && list.size() > m_maxTransmissionSamples)
+    {
+        // keep the busiest links, the view cannot draw an arrow per link of large topologies
+        NS_LOG_DEBUG("Keeping " << m_maxTransmissionSamples << " of " << list.size()
+                                << " transmission samples");
+        std::stable_sort(list.begin(),
+                         list.end(),
+                         [](const TransmissionSample& a, const TransmissionSample& b) {
+                             return a.bytes > b.bytes;
+                         });
+        list.resize(m_maxTransmissionSamples);
+    }
     NS_LOG_DEBUG("GetTransmissionSamples END");
     return list;
 }
 
+void
+PyViz::SetMaxTransmissionSamples(uint32_t maxSamples)
+{
+    m_maxTransmissionSamples = maxSamples;
+}
+
 PyViz::PacketDropSampleList
 PyViz::GetPacketDropSamples() const
 {
@@ -897,6 +920,40 @@ PyViz::GetNodesStatistics() const
     return retval;
 }
 
+std::vector<PyViz::NodePosition>
+PyViz::GetMovedNodePositions(double minDistance)
+{
+    std::vector<NodePosition> positions;
+    double minDistanceSquared = minDistance * minDistance;
+    for (auto iter = NodeList::Begin(); iter != NodeList::End(); iter++)
+    {
+        Ptr<MobilityModel> mobility = (*iter)->GetObject<MobilityModel>();
+        if (!mobility)
+        {
+            continue;
+        }
+        Vector position = mobility->GetPosition();
+        uint32_t nodeId = (*iter)->GetId();
+        auto reported = m_nodePositions.find(nodeId);
+        if (reported != m_nodePositions.end())
+        {
+            double dx = position.x - reported->second.x;
+            double dy = position.y - reported->second.y;
+            if (dx * dx + dy * dy <= minDistanceSquared)
+            {
+                continue;
+            }
+            reported->second = position;
+        }
+        else
+        {
+            m_nodePositions[nodeId] = position;
+        }
+        positions.push_back({nodeId, position.x, position.y});
+    }
+    return positions;
+}
+
 PyViz::LastPacketsSample
 PyViz::GetLastPackets(uint32_t nodeId) const
 {
@@ -30,6 +30,7 @@
 #include "ns3/node.h"
 #include "ns3/nstime.h"
 #include "ns3/packet.h"
+#include "ns3/vector.h"
 
 #include <map>
 #include <set>
@@ -110,6 +111,15 @@ class PyViz
      */
     TransmissionSampleList GetTransmissionSamples() const;
 
+    /**
+     * Set the maximum number of transmission samples returned by
+     * GetTransmissionSamples. When more links carried packets during the
+     * last period, only the samples of the links with the most bytes are
+     * returned.
+     * \param maxSamples the maximum number of samples, 0 for no limit
+     */
+    void SetMaxTransmissionSamples(uint32_t maxSamples);
+
     /// PacketDropSample structure
     struct PacketDropSample
     {
@@ -196,6 +206,25 @@ class PyViz
      */
     std::vector<NodeStatistics> GetNodesStatistics() const;
 
+    /// NodePosition structure
+    struct NodePosition
+    {
+        uint32_t nodeId; ///< node ID
+        double x;        ///< X coordinate, in meters
+        double y;        ///< Y coordinate, in meters
+    };
+
+    /**
+     * Get the positions of the nodes with a mobility model which moved by
+     * more than a given distance since their position was last returned, so
+     * that the view only moves the nodes whose displacement is visible.
+     * The first call returns the positions of all the nodes with a mobility
+     * model.
+     * \param minDistance the minimum displacement, in meters
+     * \returns the positions of the nodes which moved
+     */
+    std::vector<NodePosition> GetMovedNodePositions(double minDistance);
+
     /// PacketCaptureMode enumeration
     enum PacketCaptureMode
     {
@@ -315,6 +344,8 @@ class PyViz
     std::map<uint32_t, Time> m_packetsOfInterest; ///< list of packet UIDs that will be monitored
     std::map<uint32_t, LastPacketsSample> m_lastPackets;                    ///< last packets
     std::map<uint32_t, std::vector<NetDeviceStatistics>> m_nodesStatistics; ///< node statistics
+    uint32_t m_maxTransmissionSamples{0}; ///< maximum number of transmission samples, 0 if none
+    std::map<uint32_t, Vector> m_nodePositions; ///< node positions last returned, by node ID
 
     // Trace callbacks
     /**
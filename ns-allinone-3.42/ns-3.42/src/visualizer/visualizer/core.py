@@ -8,6 +8,9 @@ DEFAULT_TRANSMISSIONS_MEMORY = (
     5  # default number of of past intervals whose transmissions are remembered
 )
 BITRATE_FONT_SIZE = 10
+MAX_TRANSMISSION_ARROWS = (
+    500  # maximum number of links whose transmissions are drawn, the busiest ones; 0 for no limit
+)
 
 # internal constants, normally not meant to be changed
 SAMPLE_PERIOD = 0.1
@@ -683,6 +686,7 @@ class SimulationThread(threading.Thread):
         self.target_time = 0  # in seconds
         self.quit = False
         self.sim_helper = ns.PyViz()
+        self.sim_helper.SetMaxTransmissionSamples(MAX_TRANSMISSION_ARROWS)
         self.pause_messages = []
 
     def set_nodes_of_interest(self, nodes):
@@ -1318,20 +1322,20 @@ class Visualizer(GObject.GObject):
         self.emit("update-view")
 
     def _update_node_positions(self):
-        for node in self.nodes.values():
-            if node.has_mobility:
-                ns3_node = ns.NodeList.GetNode(node.node_index)
-                mobility = ns3_node.GetObject[ns.MobilityModel]()
-                if mobility:
-                    pos = ns3_node.GetObject[ns.MobilityModel]().__deref__().GetPosition()
-                    x, y = transform_point_simulation_to_canvas(pos.x, pos.y)
-                    node.set_position(x, y)
-                    if node is self.follow_node:
-                        hadj = self._scrolled_window.get_hadjustment()
-                        vadj = self._scrolled_window.get_vadjustment()
-                        px, py = self.canvas.convert_to_pixels(x, y)
-                        hadj.set_value(px - hadj.get_page_size() / 2)
-                        vadj.set_value(py - vadj.get_page_size() / 2)
+        # only move the nodes whose displacement is visible, i.e., more than half a pixel
+        min_distance = transform_distance_canvas_to_simulation(0.5 / self.canvas.get_scale())
+        for pos in self.simulation.sim_helper.GetMovedNodePositions(min_distance):
+            node = self.nodes.get(pos.nodeId)
+            if node is None:
+                continue
+            x, y = transform_point_simulation_to_canvas(pos.x, pos.y)
+            node.set_position(x, y)
+            if node is self.follow_node:
+                hadj = self._scrolled_window.get_hadjustment()
+                vadj = self._scrolled_window.get_vadjustment()
+                px, py = self.canvas.convert_to_pixels(x, y)
+                hadj.set_value(px - hadj.get_page_size() / 2)
+                vadj.set_value(py - vadj.get_page_size() / 2)
 
     def center_on_node(self, node):
         if isinstance(node, ns.Node):
@@ -46,6 +46,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -85,6 +86,19 @@ ApWifiMac::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&ApWifiMac::SetBeaconGeneration),
                           MakeBooleanChecker())
+            .AddAttribute(
+                "AbstractBeaconPeriod",
+                "Number of beacon intervals between two Beacon frames transmitted on a link "
+                "that has associated stations. While no station is associated, a Beacon frame "
+                "is transmitted every beacon interval, so that scanning stations discover the AP "
+                "as usual; afterwards, only one Beacon frame every AbstractBeaconPeriod beacon "
+                "intervals is transmitted, which models the airtime of beacons coarsely but "
+                "removes most of the beacon events in the steady state of large deployments. "
+                "Beacon and Probe Response frames advertise the interval between transmitted "
+                "beacons, so that the missed beacon watchdog of the stations scales accordingly.",
+                UintegerValue(1),
+                MakeUintegerAccessor(&ApWifiMac::SetAbstractBeaconPeriod),
+                MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("FdBeaconInterval6GHz",
                           "Time between a Beacon frame and a FILS Discovery (FD) frame or between "
                           "two FD frames to be sent on a 6GHz link. A value of zero disables the "
@@ -307,6 +321,24 @@ ApWifiMac::GetBeaconInterval() const
     return m_beaconInterval;
 }
 
+void
+ApWifiMac::SetAbstractBeaconPeriod(uint32_t period)
+{
+    NS_LOG_FUNCTION(this << period);
+    NS_ABORT_MSG_IF(period == 0, "The abstract beacon period must be at least one");
+    m_abstractBeaconPeriod = period;
+}
+
+uint64_t
+ApWifiMac::GetAdvertisedBeaconIntervalUs() const
+{
+    uint64_t intervalUs = GetBeaconInterval().GetMicroSeconds() * m_abstractBeaconPeriod;
+    NS_ABORT_MSG_IF(intervalUs > 1024 * 65535,
+                    "The beacon interval times the abstract beacon period ("
+                        << intervalUs << "us) exceeds the maximum beacon interval (65535 TUs)");
+    return intervalUs;
+}
+
 void
 ApWifiMac::SetLinkUpCallback(Callback<void> linkUp)
 {
@@ -1121,7 +1153,7 @@ ApWifiMac::SendProbeResp(Mac48Address to, uint8_t linkId)
     auto supportedRates = GetSupportedRates(linkId);
     probe.Get<SupportedRates>() = supportedRates.rates;
     probe.Get<ExtendedSupportedRatesIE>() = supportedRates.extendedRates;
-    probe.SetBeaconIntervalUs(GetBeaconInterval().GetMicroSeconds());
+    probe.SetBeaconIntervalUs(GetAdvertisedBeaconIntervalUs());
     probe.Capabilities() = GetCapabilities(linkId);
     GetWifiRemoteStationManager(linkId)->SetShortPreambleEnabled(
         GetLink(linkId).shortPreambleEnabled);
@@ -1523,7 +1555,7 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     auto supportedRates = GetSupportedRates(linkId);
     beacon.Get<SupportedRates>() = supportedRates.rates;
     beacon.Get<ExtendedSupportedRatesIE>() = supportedRates.extendedRates;
-    beacon.SetBeaconIntervalUs(GetBeaconInterval().GetMicroSeconds());
+    beacon.SetBeaconIntervalUs(GetAdvertisedBeaconIntervalUs());
     beacon.Capabilities() = GetCapabilities(linkId);
     GetWifiRemoteStationManager(linkId)->SetShortPreambleEnabled(link.shortPreambleEnabled);
     GetWifiRemoteStationManager(linkId)->SetShortSlotTimeEnabled(link.shortSlotTimeEnabled);
@@ -1597,8 +1629,13 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     NS_LOG_INFO("Generating beacon from " << link.feManager->GetAddress() << " linkID " << +linkId);
     // The beacon has it's own special queue, so we load it in there
     m_beaconTxop->Queue(packet, hdr);
-    link.beaconEvent =
-        Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
+    // in the steady state (i.e., once stations are associated), skip the Beacon frames
+    // of the next AbstractBeaconPeriod - 1 beacon intervals
+    const uint32_t nIntervals = link.staList.empty() ? 1 : m_abstractBeaconPeriod;
+    link.beaconEvent = Simulator::Schedule(GetBeaconInterval() * nIntervals,
+                                           &ApWifiMac::SendOneBeacon,
+                                           this,
+                                           linkId);
 
     ScheduleFilsDiscOrUnsolProbeRespFrames(linkId);
 
@@ -549,6 +549,18 @@ class ApWifiMac : public WifiMac
      * \param enable enable or disable beacon generation
      */
     void SetBeaconGeneration(bool enable);
+    /**
+     * Set the number of beacon intervals between two Beacon frames transmitted on a link
+     * that has associated stations.
+     *
+     * \param period the number of beacon intervals
+     */
+    void SetAbstractBeaconPeriod(uint32_t period);
+    /**
+     * \return the interval between two transmitted Beacon frames in the steady state (in
+     *         microseconds), which is advertised in Beacon and Probe Response frames
+     */
+    uint64_t GetAdvertisedBeaconIntervalUs() const;
 
     /**
      * Update whether short slot time should be enabled or not in the BSS
@@ -592,6 +604,9 @@ class ApWifiMac : public WifiMac
     Ptr<Txop> m_beaconTxop;        //!< Dedicated Txop for beacons
     bool m_enableBeaconGeneration; //!< Flag whether beacons are being generated
     Time m_beaconInterval;         //!< Beacon interval
+    /// Number of beacon intervals between two transmitted Beacon frames once stations are
+    /// associated
+    uint32_t m_abstractBeaconPeriod{1};
     Ptr<UniformRandomVariable>
         m_beaconJitter; //!< UniformRandomVariable used to randomize the time of the first beacon
     bool m_enableBeaconJitter; //!< Flag whether the first beacon should be generated at random time
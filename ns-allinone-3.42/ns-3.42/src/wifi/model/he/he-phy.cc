@@ -991,7 +991,7 @@ HePhy::GetRuBandForTx(const WifiTxVector& txVector, uint16_t staId) const
     HeRu::RuSpec ru = txVector.GetRu(staId);
     uint16_t channelWidth = txVector.GetChannelWidth();
     NS_ASSERT(channelWidth <= m_wifiPhy->GetChannelWidth());
-    HeRu::SubcarrierGroup group = HeRu::GetSubcarrierGroup(
+    const auto& group = HeRu::GetSubcarrierGroup(
         channelWidth,
         ru.GetRuType(),
         ru.GetPhyIndex(channelWidth, m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)));
@@ -1013,7 +1013,7 @@ HePhy::GetRuBandForRx(const WifiTxVector& txVector, uint16_t staId) const
     HeRu::RuSpec ru = txVector.GetRu(staId);
     uint16_t channelWidth = txVector.GetChannelWidth();
     NS_ASSERT(channelWidth <= m_wifiPhy->GetChannelWidth());
-    HeRu::SubcarrierGroup group = HeRu::GetSubcarrierGroup(
+    const auto& group = HeRu::GetSubcarrierGroup(
         channelWidth,
         ru.GetRuType(),
         ru.GetPhyIndex(channelWidth, m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)));
@@ -1043,7 +1043,7 @@ HePhy::GetNonOfdmaBand(const WifiTxVector& txVector, uint16_t staId) const
     HeRu::RuSpec nonOfdmaRu =
         HeRu::FindOverlappingRu(channelWidth, ru, HeRu::GetRuType(nonOfdmaWidth));
 
-    HeRu::SubcarrierGroup groupPreamble = HeRu::GetSubcarrierGroup(
+    const auto& groupPreamble = HeRu::GetSubcarrierGroup(
         channelWidth,
         nonOfdmaRu.GetRuType(),
         nonOfdmaRu.GetPhyIndex(channelWidth,
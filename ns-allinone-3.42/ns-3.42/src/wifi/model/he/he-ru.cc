@@ -22,6 +22,7 @@
 #include "ns3/abort.h"
 #include "ns3/assert.h"
 
+#include <array>
 #include <optional>
 #include <tuple>
 
@@ -511,12 +512,65 @@ HeRu::GetNRus(uint16_t bw, RuType ruType)
     return (bw == 160 ? 2 : 1) * it->second.size();
 }
 
+namespace
+{
+
+/// Number of channel widths (20, 40, 80 and 160 MHz) in the precomputed RU tables
+constexpr std::size_t N_RU_TABLE_WIDTHS = 4;
+
+/// Number of RU types in the precomputed RU tables
+constexpr std::size_t N_RU_TABLE_TYPES = HeRu::RU_2x996_TONE + 1;
+
+/**
+ * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+ * \return the index of the bandwidth in the precomputed RU tables
+ */
+std::size_t
+GetRuTableWidthIndex(uint16_t bw)
+{
+    switch (bw)
+    {
+    case 20:
+        return 0;
+    case 40:
+        return 1;
+    case 80:
+        return 2;
+    case 160:
+        return 3;
+    default:
+        NS_ABORT_MSG("Invalid HE PPDU bandwidth " << bw << " MHz");
+        return 0;
+    }
+}
+
+/// A table holding a value per channel width and RU type
+template <class T>
+using RuTable = std::array<std::array<T, N_RU_TABLE_TYPES>, N_RU_TABLE_WIDTHS>;
+
+/**
+ * RUs and subcarrier groups of every RU type in every channel width. They only depend on
+ * the static subcarrier tables of the standard, hence they are computed once, on first use,
+ * and the HeRu accessors return references to them instead of building vectors on every call.
+ */
+struct HeRuTables
+{
+    RuTable<std::vector<HeRu::RuSpec>> rusOfType;         //!< RUs of each type
+    RuTable<std::vector<HeRu::RuSpec>> central26TonesRus; //!< additional central 26-tone RUs
+    RuTable<std::vector<HeRu::SubcarrierGroup>>
+        subcarrierGroups; //!< subcarrier group of each RU, indexed by PHY index - 1
+};
+
+/**
+ * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+ * \param ruType the RU type (number of tones)
+ * \return the set of distinct RUs of the given type available
+ */
 std::vector<HeRu::RuSpec>
-HeRu::GetRusOfType(uint16_t bw, HeRu::RuType ruType)
+ComputeRusOfType(uint16_t bw, HeRu::RuType ruType)
 {
     if (ruType == HeRu::RU_2x996_TONE)
     {
-        NS_ASSERT(bw >= 160);
         return {{ruType, 1, true}};
     }
 
@@ -541,8 +595,13 @@ HeRu::GetRusOfType(uint16_t bw, HeRu::RuType ruType)
     return ret;
 }
 
+/**
+ * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+ * \param ruType the RU type (number of tones)
+ * \return the set of 26-tone RUs that can be additionally allocated
+ */
 std::vector<HeRu::RuSpec>
-HeRu::GetCentral26TonesRus(uint16_t bw, HeRu::RuType ruType)
+ComputeCentral26TonesRus(uint16_t bw, HeRu::RuType ruType)
 {
     std::vector<std::size_t> indices;
 
@@ -587,8 +646,14 @@ HeRu::GetCentral26TonesRus(uint16_t bw, HeRu::RuType ruType)
     return ret;
 }
 
+/**
+ * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
+ * \param ruType the RU type (number of tones)
+ * \param phyIndex the PHY index (starting at 1) of the RU
+ * \return the subcarrier range of the specified RU
+ */
 HeRu::SubcarrierGroup
-HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
+ComputeSubcarrierGroup(uint16_t bw, HeRu::RuType ruType, std::size_t phyIndex)
 {
     if (ruType == HeRu::RU_2x996_TONE) // handle special case of RU covering 160 MHz channel
     {
@@ -600,7 +665,7 @@ HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
     // m_heRuSubcarrierGroups contains indices for lower 80 MHz subchannel (i.e. from -500 to 500).
     // The phyIndex is used to that aim.
     std::size_t indexInLower80MHz = phyIndex;
-    std::size_t numRus = GetNRus(bw, ruType);
+    std::size_t numRus = HeRu::GetNRus(bw, ruType);
     int16_t shift = (bw == 160) ? -512 : 0;
     if (bw == 160 && phyIndex > (numRus / 2))
     {
@@ -609,12 +674,12 @@ HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
         shift = 512;
     }
 
-    auto it = m_heRuSubcarrierGroups.find({(bw == 160 ? 80 : bw), ruType});
+    auto it = HeRu::m_heRuSubcarrierGroups.find({(bw == 160 ? 80 : bw), ruType});
 
-    NS_ABORT_MSG_IF(it == m_heRuSubcarrierGroups.end(), "RU not found");
+    NS_ABORT_MSG_IF(it == HeRu::m_heRuSubcarrierGroups.end(), "RU not found");
     NS_ABORT_MSG_IF(indexInLower80MHz > it->second.size(), "RU index not available");
 
-    SubcarrierGroup group = it->second.at(indexInLower80MHz - 1);
+    HeRu::SubcarrierGroup group = it->second.at(indexInLower80MHz - 1);
     if (bw == 160)
     {
         for (auto& range : group)
@@ -626,6 +691,66 @@ HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
     return group;
 }
 
+/**
+ * \return the precomputed RU tables
+ */
+const HeRuTables&
+GetHeRuTables()
+{
+    static const HeRuTables tables = [] {
+        HeRuTables t;
+        for (uint16_t bw : {20, 40, 80, 160})
+        {
+            const auto bwIndex = GetRuTableWidthIndex(bw);
+            for (std::size_t type = 0; type < N_RU_TABLE_TYPES; type++)
+            {
+                const auto ruType = static_cast<HeRu::RuType>(type);
+                const auto nRus = HeRu::GetNRus(bw, ruType);
+                if (nRus == 0)
+                {
+                    // no RU of this type in this channel width
+                    continue;
+                }
+                t.rusOfType[bwIndex][type] = ComputeRusOfType(bw, ruType);
+                t.central26TonesRus[bwIndex][type] = ComputeCentral26TonesRus(bw, ruType);
+                auto& groups = t.subcarrierGroups[bwIndex][type];
+                groups.reserve(nRus);
+                for (std::size_t phyIndex = 1; phyIndex <= nRus; phyIndex++)
+                {
+                    groups.push_back(ComputeSubcarrierGroup(bw, ruType, phyIndex));
+                }
+            }
+        }
+        return t;
+    }();
+    return tables;
+}
+
+} // namespace
+
+const std::vector<HeRu::RuSpec>&
+HeRu::GetRusOfType(uint16_t bw, HeRu::RuType ruType)
+{
+    const auto& rus = GetHeRuTables().rusOfType[GetRuTableWidthIndex(bw)][ruType];
+    NS_ABORT_MSG_IF(rus.empty(), "No " << ruType << " RU in a " << bw << " MHz channel");
+    return rus;
+}
+
+const std::vector<HeRu::RuSpec>&
+HeRu::GetCentral26TonesRus(uint16_t bw, HeRu::RuType ruType)
+{
+    return GetHeRuTables().central26TonesRus[GetRuTableWidthIndex(bw)][ruType];
+}
+
+const HeRu::SubcarrierGroup&
+HeRu::GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex)
+{
+    const auto& groups = GetHeRuTables().subcarrierGroups[GetRuTableWidthIndex(bw)][ruType];
+    NS_ABORT_MSG_IF(groups.empty(), "RU not found");
+    NS_ABORT_MSG_IF(phyIndex == 0 || phyIndex > groups.size(), "RU index not available");
+    return groups[phyIndex - 1];
+}
+
 bool
 HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const std::vector<RuSpec>& v)
 {
@@ -639,7 +764,7 @@ HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const std::vector<RuSpec>& v)
     // not been set yet. Hence, we pass the "MAC" index to GetSubcarrierGroup instead
     // of the PHY index. This is fine because we compare the primary 80 MHz bands of
     // the two RUs below.
-    SubcarrierGroup rangesRu = GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetIndex());
+    const auto& rangesRu = GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetIndex());
     for (auto& p : v)
     {
         if (ru.GetPrimary80MHz() != p.GetPrimary80MHz())
@@ -649,7 +774,7 @@ HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const std::vector<RuSpec>& v)
         }
         for (const auto& rangeRu : rangesRu)
         {
-            SubcarrierGroup rangesP = GetSubcarrierGroup(bw, p.GetRuType(), p.GetIndex());
+            const auto& rangesP = GetSubcarrierGroup(bw, p.GetRuType(), p.GetIndex());
             for (auto& rangeP : rangesP)
             {
                 if (rangeP.second >= rangeRu.first && rangeRu.second >= rangeP.first)
@@ -672,7 +797,7 @@ HeRu::DoesOverlap(uint16_t bw, RuSpec ru, const SubcarrierGroup& toneRanges, uin
             return true;
         }
 
-        SubcarrierGroup rangesRu =
+        const auto& rangesRu =
             GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetPhyIndex(bw, p20Index));
         for (auto& r : rangesRu)
         {
@@ -178,9 +178,9 @@ class HeRu
      *
      * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
      * \param ruType the RU type (number of tones)
-     * \return the set of distinct RUs available
+     * \return the set of distinct RUs available (a reference to a precomputed table)
      */
-    static std::vector<HeRu::RuSpec> GetRusOfType(uint16_t bw, HeRu::RuType ruType);
+    static const std::vector<HeRu::RuSpec>& GetRusOfType(uint16_t bw, HeRu::RuType ruType);
 
     /**
      * Get the set of 26-tone RUs that can be additionally allocated if the given
@@ -188,9 +188,11 @@ class HeRu
      *
      * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
      * \param ruType the RU type (number of tones)
-     * \return the set of 26-tone RUs that can be additionally allocated
+     * \return the set of 26-tone RUs that can be additionally allocated (a reference to a
+     *         precomputed table)
      */
-    static std::vector<HeRu::RuSpec> GetCentral26TonesRus(uint16_t bw, HeRu::RuType ruType);
+    static const std::vector<HeRu::RuSpec>& GetCentral26TonesRus(uint16_t bw,
+                                                                 HeRu::RuType ruType);
 
     /**
      * Get the subcarrier group of the RU having the given PHY index among all the
@@ -204,9 +206,11 @@ class HeRu
      * \param bw the bandwidth (MHz) of the HE PPDU (20, 40, 80, 160)
      * \param ruType the RU type (number of tones)
      * \param phyIndex the PHY index (starting at 1) of the RU
-     * \return the subcarrier range of the specified RU
+     * \return the subcarrier range of the specified RU (a reference to a precomputed table)
      */
-    static SubcarrierGroup GetSubcarrierGroup(uint16_t bw, RuType ruType, std::size_t phyIndex);
+    static const SubcarrierGroup& GetSubcarrierGroup(uint16_t bw,
+                                                     RuType ruType,
+                                                     std::size_t phyIndex);
 
     /**
      * Check whether the given RU overlaps with the given set of RUs.
@@ -133,6 +133,7 @@ RrMultiUserScheduler::DoDispose()
     m_staListDl.clear();
     m_staListUl.clear();
     m_candidates.clear();
+    m_ruAllocations.clear();
     m_txParams.Clear();
     m_apMac->TraceDisconnectWithoutContext(
         "AssociatedSta",
@@ -185,9 +186,10 @@ RrMultiUserScheduler::GetTxVectorForUlMu(Func canBeSolicited)
     NS_LOG_FUNCTION(this);
 
     // determine RUs to allocate to stations
-    auto count = std::min<std::size_t>(m_nStations, m_staListUl.size());
-    std::size_t nCentral26TonesRus;
-    HeRu::GetEqualSizedRusForStations(m_allowedWidth, count, nCentral26TonesRus);
+    const auto& ruAllocation =
+        GetRuAllocation(m_allowedWidth, std::min<std::size_t>(m_nStations, m_staListUl.size()));
+    auto count = ruAllocation.nRus;
+    std::size_t nCentral26TonesRus = ruAllocation.nCentral26TonesRus;
     NS_ASSERT(count >= 1);
 
     if (!m_useCentral26TonesRus)
@@ -607,11 +609,13 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
         return TxFormat::SU_TX;
     }
 
-    std::size_t count =
-        std::min(static_cast<std::size_t>(m_nStations), m_staListDl[primaryAc].size());
-    std::size_t nCentral26TonesRus;
-    HeRu::RuType ruType =
-        HeRu::GetEqualSizedRusForStations(m_allowedWidth, count, nCentral26TonesRus);
+    const auto& ruAllocation =
+        GetRuAllocation(m_allowedWidth,
+                        std::min(static_cast<std::size_t>(m_nStations),
+                                 m_staListDl[primaryAc].size()));
+    std::size_t count = ruAllocation.nRus;
+    std::size_t nCentral26TonesRus = ruAllocation.nCentral26TonesRus;
+    HeRu::RuType ruType = ruAllocation.ruType;
     NS_ASSERT(count >= 1);
 
     if (!m_useCentral26TonesRus)
@@ -645,6 +649,16 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
         tids.push_back(currTid);
     }
 
+    // look up the QosTxop of each TID once rather than once per candidate station
+    std::vector<std::pair<uint8_t, Ptr<QosTxop>>> tidTxops;
+    tidTxops.reserve(tids.size());
+    for (uint8_t tid : tids)
+    {
+        AcIndex ac = QosUtilsMapTidToAc(tid);
+        NS_ASSERT(ac >= primaryAc);
+        tidTxops.emplace_back(tid, m_apMac->GetQosTxop(ac));
+    }
+
     Ptr<HeConfiguration> heConfiguration = m_apMac->GetHeConfiguration();
     NS_ASSERT(heConfiguration);
 
@@ -686,15 +700,13 @@ RrMultiUserScheduler::TrySendingDlMuPpdu()
         HeRu::RuType currRuType = (m_candidates.size() < count ? ruType : HeRu::RU_26_TONE);
 
         // check if the AP has at least one frame to be sent to the current station
-        for (uint8_t tid : tids)
+        for (const auto& [tid, qosTxop] : tidTxops)
         {
-            AcIndex ac = QosUtilsMapTidToAc(tid);
-            NS_ASSERT(ac >= primaryAc);
             // check that a BA agreement is established with the receiver for the
             // considered TID, since ack sequences for DL MU PPDUs require block ack
             if (m_apMac->GetBaAgreementEstablishedAsOriginator(staIt->address, tid))
             {
-                mpdu = m_apMac->GetQosTxop(ac)->PeekNextMpdu(m_linkId, tid, staIt->address);
+                mpdu = qosTxop->PeekNextMpdu(m_linkId, tid, staIt->address);
 
                 // we only check if the first frame of the current TID meets the size
                 // and duration constraints. We do not explore the queues further.
@@ -773,12 +785,12 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
     NS_ASSERT(txVector.GetHeMuUserInfoMap().size() == m_candidates.size());
 
     // compute how many stations can be granted an RU and the RU size
-    std::size_t nRusAssigned = m_candidates.size();
-    std::size_t nCentral26TonesRus;
-    HeRu::RuType ruType =
-        HeRu::GetEqualSizedRusForStations(m_allowedWidth, nRusAssigned, nCentral26TonesRus);
+    const auto& ruAllocation = GetRuAllocation(m_allowedWidth, m_candidates.size());
+    std::size_t nRusAssigned = ruAllocation.nRus;
+    std::size_t nCentral26TonesRus = ruAllocation.nCentral26TonesRus;
 
-    NS_LOG_DEBUG(nRusAssigned << " stations are being assigned a " << ruType << " RU");
+    NS_LOG_DEBUG(nRusAssigned << " stations are being assigned a " << ruAllocation.ruType
+                              << " RU");
 
     if (!m_useCentral26TonesRus || m_candidates.size() == nRusAssigned)
     {
@@ -795,10 +807,8 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
     std::swap(heMuUserInfoMap, txVector.GetHeMuUserInfoMap());
 
     auto candidateIt = m_candidates.begin(); // iterator over the list of candidate receivers
-    auto ruSet = HeRu::GetRusOfType(m_allowedWidth, ruType);
-    auto ruSetIt = ruSet.begin();
-    auto central26TonesRus = HeRu::GetCentral26TonesRus(m_allowedWidth, ruType);
-    auto central26TonesRusIt = central26TonesRus.begin();
+    auto ruSetIt = ruAllocation.rus.cbegin();
+    auto central26TonesRusIt = ruAllocation.central26TonesRus.cbegin();
 
     for (std::size_t i = 0; i < nRusAssigned + nCentral26TonesRus; i++)
     {
@@ -817,6 +827,25 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
     m_candidates.erase(candidateIt, m_candidates.end());
 }
 
+const RrMultiUserScheduler::RuAllocation&
+RrMultiUserScheduler::GetRuAllocation(uint16_t bandwidth, std::size_t nStations)
+{
+    auto [it, inserted] = m_ruAllocations.try_emplace({bandwidth, nStations});
+    if (inserted)
+    {
+        NS_LOG_DEBUG("Computing the RU allocation for " << nStations << " stations over "
+                                                        << bandwidth << " MHz");
+        auto& ruAllocation = it->second;
+        ruAllocation.nRus = nStations;
+        ruAllocation.ruType = HeRu::GetEqualSizedRusForStations(bandwidth,
+                                                                ruAllocation.nRus,
+                                                                ruAllocation.nCentral26TonesRus);
+        ruAllocation.rus = HeRu::GetRusOfType(bandwidth, ruAllocation.ruType);
+        ruAllocation.central26TonesRus = HeRu::GetCentral26TonesRus(bandwidth, ruAllocation.ruType);
+    }
+    return it->second;
+}
+
 void
 RrMultiUserScheduler::UpdateCredits(std::list<MasterInfo>& staList,
                                     Time txDuration,
@@ -23,6 +23,9 @@
 #include "multi-user-scheduler.h"
 
 #include <list>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -150,6 +153,29 @@ class RrMultiUserScheduler : public MultiUserScheduler
                        Time txDuration,
                        const WifiTxVector& txVector);
 
+    /**
+     * Equal-sized RUs that can be allocated to a number of stations over a channel width
+     */
+    struct RuAllocation
+    {
+        HeRu::RuType ruType;                         //!< the type of the equal-sized RUs
+        std::size_t nRus;                            //!< the number of equal-sized RUs
+        std::size_t nCentral26TonesRus;              //!< the number of central 26-tone RUs
+        std::vector<HeRu::RuSpec> rus;               //!< the equal-sized RUs
+        std::vector<HeRu::RuSpec> central26TonesRus; //!< the central 26-tone RUs
+    };
+
+    /**
+     * Get the RU allocation for the given channel width and number of stations,
+     * as computed by HeRu::GetEqualSizedRusForStations. The RU allocations are
+     * computed once per (channel width, number of stations) pair and then cached.
+     *
+     * \param bandwidth the channel width in MHz
+     * \param nStations the number of stations
+     * \return the RU allocation
+     */
+    const RuAllocation& GetRuAllocation(uint16_t bandwidth, std::size_t nStations);
+
     /**
      * Information stored for candidate stations
      */
@@ -165,11 +191,14 @@ class RrMultiUserScheduler : public MultiUserScheduler
     std::map<AcIndex, std::list<MasterInfo>>
         m_staListDl;                       //!< Per-AC list of stations (next to serve for DL first)
     std::list<MasterInfo> m_staListUl;     //!< List of stations to serve for UL
-    std::list<CandidateInfo> m_candidates; //!< Candidate stations for MU TX
     Time m_maxCredits;                     //!< Max amount of credits a station can have
     CtrlTriggerHeader m_trigger;           //!< Trigger Frame to send
     WifiMacHeader m_triggerMacHdr;         //!< MAC header for Trigger Frame
     WifiTxParameters m_txParams;           //!< TX parameters
+
+    std::vector<CandidateInfo> m_candidates; //!< Candidate stations for MU TX (reused buffer)
+    std::map<std::pair<uint16_t, std::size_t>, RuAllocation>
+        m_ruAllocations; //!< RU allocations per (channel width, number of stations)
 };
 
 } // namespace ns3
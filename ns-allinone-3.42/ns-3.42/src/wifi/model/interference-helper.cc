@@ -125,6 +125,12 @@ Event::UpdatePpdu(Ptr<const WifiPpdu> ppdu)
     m_ppdu = ppdu;
 }
 
+Event::PayloadPerCursor&
+Event::GetPayloadPerCursor(const WifiSpectrumBandInfo& band, uint16_t staId) const
+{
+    return m_payloadPerCursors[{band, staId}];
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Event& event)
 {
@@ -281,6 +287,7 @@ InterferenceHelper::UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
         if (!found)
         {
             // band does not belong to the new bands, erase it
+            ++m_niChangesVersion;
             m_firstPowers.erase(it->first);
             it->second.clear();
             it = m_niChanges.erase(it);
@@ -375,8 +382,11 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
         }
         auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
+        // the insertion of the end NiChange invalidates the iterators, but it happens after
+        // the start NiChange, hence its index does not change
+        auto firstIndex = std::distance(niIt->second.begin(), first);
         auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        for (auto i = niIt->second.begin() + firstIndex; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -388,6 +398,8 @@ InterferenceHelper::UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBan
 {
     NS_LOG_FUNCTION(this << event);
     // This is called for UL MU events, in order to scale power as long as UL MU PPDUs arrive
+    // NiChanges in the past are modified, hence the saved PER cursors are no longer valid
+    ++m_niChangesVersion;
     for (const auto& [band, power] : rxPower)
     {
         auto niIt = m_niChanges.find(band);
@@ -446,11 +458,23 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
+    const auto& niChanges = niIt->second;
+    // find the first NiChange at the start time of the event, if any
+    auto first = std::lower_bound(niChanges.cbegin(),
+                                  niChanges.cend(),
+                                  event->GetStartTime(),
+                                  [](const auto& change, Time moment) {
+                                      return change.first < moment;
+                                  });
+    if (first != niChanges.cend() && first->first != event->GetStartTime())
+    {
+        first = niChanges.cend();
+    }
+    auto it = first;
     double muMimoPowerW = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                               ? CalculateMuMimoPowerW(event, band)
                               : 0.0;
-    for (; it != niIt->second.end() && it->first < now; ++it)
+    for (; it != niChanges.cend() && it->first < now; ++it)
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
             (event != it->second.GetEvent()))
@@ -466,20 +490,22 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterferenceW = 0.0;
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    it = first;
+    NS_ABORT_IF(it == niChanges.cend());
+    for (; it != niChanges.cend() && it->second.GetEvent() != event; ++it)
     {
         ;
     }
+    // the NiChanges between the start and the end of the event are already sorted
+    auto end = std::find_if(std::next(it), niChanges.cend(), [&event](const auto& change) {
+        return change.second.GetEvent() == event;
+    });
     NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
-    {
-        ni.insert(*it);
-    }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis.insert({band, ni});
+    ni.reserve(std::distance(it, end) + 1);
+    ni.emplace_back(event->GetStartTime(), NiChange(0, event));
+    ni.insert(ni.end(), std::next(it), end);
+    ni.emplace_back(event->GetEndTime(), NiChange(0, event));
+    nis.insert({band, std::move(ni)});
     NS_ASSERT_MSG(noiseInterferenceW >= 0.0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
     return noiseInterferenceW;
@@ -597,6 +623,27 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     NS_ABORT_IF(!m_firstPowers.contains(band));
     double noiseInterferenceW = m_firstPowers.at(band);
     double powerW = event->GetRxPowerW(band);
+    const double firstPowerW = noiseInterferenceW;
+    const double initialMuMimoPowerW = muMimoPowerW;
+    const Time now = Simulator::Now();
+
+    // The NiChanges before the window do not contribute to the PER, they only determine the
+    // noise and interference at the start of the window. If a previous window (e.g. the
+    // previous MPDU of an A-MPDU) has been evaluated with the same NiChanges, resume from
+    // the last NiChange it reached before the start of this window.
+    auto& cursor = event->GetPayloadPerCursor(band, staId);
+    if (cursor.valid && cursor.time < windowStart && cursor.index < niIt.size() &&
+        niIt[cursor.index].first == cursor.time && cursor.version == m_niChangesVersion &&
+        cursor.firstPowerW == firstPowerW && cursor.initialMuMimoPowerW == initialMuMimoPowerW &&
+        cursor.rxPowerW == powerW && cursor.ppdu == event->GetPpdu())
+    {
+        NS_LOG_DEBUG("Resume from the NiChange at " << cursor.time);
+        j = niIt.cbegin() + cursor.index;
+        previous = cursor.time;
+        noiseInterferenceW = cursor.noiseInterferenceW;
+        muMimoPowerW = cursor.muMimoPowerW;
+    }
+
     while (++j != niIt.cend())
     {
         Time current = j->first;
@@ -636,6 +683,20 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
         }
         noiseInterferenceW -= muMimoPowerW;
         previous = j->first;
+        if (previous < windowEnd && previous <= now)
+        {
+            // NiChanges in the past do not move anymore, later windows can start from here
+            cursor = {true,
+                      static_cast<std::size_t>(std::distance(niIt.cbegin(), j)),
+                      previous,
+                      noiseInterferenceW,
+                      muMimoPowerW,
+                      firstPowerW,
+                      initialMuMimoPowerW,
+                      powerW,
+                      event->GetPpdu(),
+                      m_niChangesVersion};
+        }
         if (previous > windowEnd)
         {
             NS_LOG_DEBUG("Stop: new previous=" << previous
@@ -799,7 +860,10 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](Time t, const auto& change) { return t < change.first; });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -24,6 +24,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -109,11 +111,42 @@ class Event : public SimpleRefCount<Event>
      */
     void UpdatePpdu(Ptr<const WifiPpdu> ppdu);
 
+    /**
+     * State of the computation of the payload PER of this event at a given NiChange.
+     * It allows the InterferenceHelper to resume the computation for a later window
+     * of the payload (e.g. the next MPDU of an A-MPDU) without walking again through
+     * the NiChanges that precede the window.
+     */
+    struct PayloadPerCursor
+    {
+        bool valid{false};             //!< whether the cursor has been saved
+        std::size_t index{0};          //!< index of the NiChange in the NiChanges of the event
+        Time time;                     //!< time of the NiChange
+        double noiseInterferenceW{0};  //!< noise and interference after the NiChange (W)
+        double muMimoPowerW{0};        //!< power of the same MU-MIMO transmission (W)
+        double firstPowerW{0};         //!< first power of the band used for the computation (W)
+        double initialMuMimoPowerW{0}; //!< MU-MIMO power at the start of the computation (W)
+        double rxPowerW{0};            //!< received power of the event in the band (W)
+        Ptr<const WifiPpdu> ppdu;      //!< PPDU of the event used for the computation
+        uint64_t version{0};           //!< version of the NiChanges used for the computation
+    };
+
+    /**
+     * Return the cursor used to compute the payload PER of this event.
+     *
+     * \param band the band for which the PER is computed
+     * \param staId the station ID of the PSDU
+     * \return a reference to the cursor
+     */
+    PayloadPerCursor& GetPayloadPerCursor(const WifiSpectrumBandInfo& band, uint16_t staId) const;
+
   private:
     Ptr<const WifiPpdu> m_ppdu;           //!< PPDU
     Time m_startTime;                     //!< start time
     Time m_endTime;                       //!< end time
     RxPowerWattPerChannelBand m_rxPowerW; //!< received power in watts per band
+    mutable std::map<std::pair<WifiSpectrumBandInfo, uint16_t>, PayloadPerCursor>
+        m_payloadPerCursors; //!< cursors of the payload PER computation per band and STA-ID
 };
 
 /**
@@ -396,9 +429,10 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * typedef for a vector of NiChange sorted by time. NiChanges with the same
+     * time are stored in insertion order.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
 
     /**
      * Map of NiChanges per band
@@ -522,6 +556,7 @@ class InterferenceHelper : public Object
     uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
     NiChangesPerBand m_niChanges;    //!< NI Changes for each band
     FirstPowerPerBand m_firstPowers; //!< first power of each band in watts
+    uint64_t m_niChangesVersion{0};  //!< incremented when past NiChanges are modified
 
     /**
      * Returns an iterator to the first NiChange that is later than moment
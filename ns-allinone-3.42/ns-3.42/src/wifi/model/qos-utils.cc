@@ -30,25 +30,38 @@
 namespace ns3
 {
 
+/**
+ * Convert a MAC address into a 48-bit integer, which is much cheaper to hash than
+ * a string holding the six bytes of the address.
+ *
+ * \param address the MAC address
+ * \return the integer value of the MAC address
+ */
+static uint64_t
+AddressToUint64(const Mac48Address& address)
+{
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+
+    uint64_t value = 0;
+    for (auto byte : buffer)
+    {
+        value = (value << 8) | byte;
+    }
+    return value;
+}
+
 std::size_t
 WifiAddressTidHash::operator()(const WifiAddressTidPair& addressTidPair) const
 {
-    uint8_t buffer[7];
-    addressTidPair.first.CopyTo(buffer);
-    buffer[6] = addressTidPair.second;
-
-    std::string s(buffer, buffer + 7);
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}((AddressToUint64(addressTidPair.first) << 8) |
+                                 addressTidPair.second);
 }
 
 std::size_t
 WifiAddressHash::operator()(const Mac48Address& address) const
 {
-    uint8_t buffer[6];
-    address.CopyTo(buffer);
-
-    std::string s(buffer, buffer + 6);
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}(AddressToUint64(address));
 }
 
 WifiAc::WifiAc(uint8_t lowTid, uint8_t highTid)
@@ -1408,8 +1408,6 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_numSamplesSlow = 0;
     station->m_sampleCount = 0;
 
-    double tempProb;
-
     if (station->m_ampduPacketCount > 0)
     {
         uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1420,98 +1418,97 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     }
 
     /* Initialize global rate indexes */
-    station->m_maxTpRate = GetLowestIndex(station);
-    station->m_maxTpRate2 = GetLowestIndex(station);
-    station->m_maxProbRate = GetLowestIndex(station);
+    uint16_t lowestIndex = GetLowestIndex(station);
+    station->m_maxTpRate = lowestIndex;
+    station->m_maxTpRate2 = lowestIndex;
+    station->m_maxProbRate = lowestIndex;
 
-    /// Update throughput and EWMA for each rate inside each group.
+    /**
+     * Update throughput and EWMA for each rate inside each group, then look for the best
+     * rates among the rates of the group. The selection only compares the statistics of
+     * rates visited earlier (or of the lowest index rates, which are visited first), hence
+     * doing it after updating the statistics of the whole group gives the same result as
+     * interleaving the two, while keeping the update loop free of function calls.
+     */
     for (uint8_t j = 0; j < m_numGroups; j++)
     {
-        if (station->m_groupsTable[j].m_supported)
+        auto& group = station->m_groupsTable[j];
+        if (!group.m_supported)
         {
-            station->m_sampleCount++;
+            continue;
+        }
+        station->m_sampleCount++;
 
-            /* (re)Initialize group rate indexes */
-            station->m_groupsTable[j].m_maxTpRate = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxProbRate = GetLowestIndex(station, j);
+        /* (re)Initialize group rate indexes */
+        uint16_t groupLowestIndex = GetLowestIndex(station, j);
+        group.m_maxTpRate = groupLowestIndex;
+        group.m_maxTpRate2 = groupLowestIndex;
+        group.m_maxProbRate = groupLowestIndex;
 
-            for (uint8_t i = 0; i < m_numRates; i++)
+        for (uint8_t i = 0; i < m_numRates; i++)
+        {
+            auto& rate = group.m_ratesTable[i];
+            if (!rate.supported)
             {
-                if (station->m_groupsTable[j].m_ratesTable[i].supported)
-                {
-                    station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
-
-                    NS_LOG_DEBUG(
-                        +i << " "
-                           << GetMcsSupported(station,
-                                              station->m_groupsTable[j].m_ratesTable[i].mcsIndex)
-                           << "\t attempt="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt
-                           << "\t success="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
-
-                    /// If we've attempted something.
-                    if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                        /**
-                         * Calculate the probability of success.
-                         * Assume probability scales from 0 to 100.
-                         */
-                        tempProb =
-                            (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) /
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-
-                        /// Bookkeeping.
-                        station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
-
-                        if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                        else
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmsdProb =
-                                CalculateEwmsd(station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                               tempProb,
-                                               station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                               m_ewmaLevel);
-                            /// EWMA probability
-                            tempProb =
-                                (tempProb * (100 - m_ewmaLevel) +
-                                 station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel) /
-                                100;
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
+                continue;
+            }
+            rate.retryUpdated = false;
 
-                        station->m_groupsTable[j].m_ratesTable[i].throughput =
-                            CalculateThroughput(station, j, i, tempProb);
+            NS_LOG_DEBUG(+i << " " << GetMcsSupported(station, rate.mcsIndex)
+                            << "\t attempt=" << rate.numRateAttempt
+                            << "\t success=" << rate.numRateSuccess);
 
-                        station->m_groupsTable[j].m_ratesTable[i].successHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                        station->m_groupsTable[j].m_ratesTable[i].attemptHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                    else
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
+            /// If we've attempted something.
+            if (rate.numRateAttempt > 0)
+            {
+                rate.numSamplesSkipped = 0;
+                /**
+                 * Calculate the probability of success.
+                 * Assume probability scales from 0 to 100.
+                 */
+                double tempProb = (100 * rate.numRateSuccess) / rate.numRateAttempt;
 
-                    /// Bookkeeping.
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
+                /// Bookkeeping.
+                rate.prob = tempProb;
 
-                    if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                        SetBestStationThRates(station, GetIndex(j, i));
-                        SetBestProbabilityRate(station, GetIndex(j, i));
-                    }
+                if (rate.successHist == 0)
+                {
+                    rate.ewmaProb = tempProb;
                 }
+                else
+                {
+                    rate.ewmsdProb =
+                        CalculateEwmsd(rate.ewmsdProb, tempProb, rate.ewmaProb, m_ewmaLevel);
+                    /// EWMA probability
+                    tempProb =
+                        (tempProb * (100 - m_ewmaLevel) + rate.ewmaProb * m_ewmaLevel) / 100;
+                    rate.ewmaProb = tempProb;
+                }
+
+                rate.throughput = CalculateThroughput(station, j, i, tempProb);
+
+                rate.successHist += rate.numRateSuccess;
+                rate.attemptHist += rate.numRateAttempt;
+            }
+            else
+            {
+                rate.numSamplesSkipped++;
+            }
+
+            /// Bookkeeping.
+            rate.prevNumRateSuccess = rate.numRateSuccess;
+            rate.prevNumRateAttempt = rate.numRateAttempt;
+            rate.numRateSuccess = 0;
+            rate.numRateAttempt = 0;
+        }
+
+        for (uint8_t i = 0; i < m_numRates; i++)
+        {
+            const auto& rate = group.m_ratesTable[i];
+            if (rate.supported && rate.throughput != 0)
+            {
+                SetBestStationThRates(station, GetIndex(j, i));
+                SetBestProbabilityRate(station, GetIndex(j, i));
             }
         }
     }
@@ -1569,7 +1566,6 @@ void
 MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* station, uint16_t index)
 {
     GroupInfo* group;
-    MinstrelHtRateInfo rate;
     uint8_t tmpGroupId;
     uint8_t tmpRateId;
     double tmpTh;
@@ -1585,7 +1581,7 @@ MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* stati
     groupId = GetGroupId(index);
     rateId = GetRateId(index);
     group = &station->m_groupsTable[groupId];
-    rate = group->m_ratesTable[rateId];
+    const MinstrelHtRateInfo& rate = group->m_ratesTable[rateId];
 
     tmpGroupId = GetGroupId(station->m_maxProbRate);
     tmpRateId = GetRateId(station->m_maxProbRate);
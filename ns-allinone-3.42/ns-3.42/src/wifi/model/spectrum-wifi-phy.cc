@@ -165,7 +165,7 @@ SpectrumWifiPhy::GetHeRuBands(Ptr<WifiSpectrumPhyInterface> spectrumPhyInterface
                 std::size_t nRus = HeRu::GetNRus(bw, ruType);
                 for (std::size_t phyIndex = 1; phyIndex <= nRus; phyIndex++)
                 {
-                    HeRu::SubcarrierGroup group = HeRu::GetSubcarrierGroup(bw, ruType, phyIndex);
+                    const auto& group = HeRu::GetSubcarrierGroup(bw, ruType, phyIndex);
                     HeRu::SubcarrierRange subcarrierRange =
                         std::make_pair(group.front().first, group.back().second);
                     const auto bandIndices = HePhy::ConvertHeRuSubcarriers(bw,
@@ -434,6 +434,8 @@ SpectrumWifiPhy::StartRx(Ptr<SpectrumSignalParameters> rxParams,
     RxPowerWattPerChannelBand rxPowerW;
 
     const auto rxGainRatio = DbToRatio(GetRxGain());
+    // the running sum of the PSD is computed once and shared by all the bands and RUs below
+    const auto cumulativePsd = WifiSpectrumValueHelper::GetCumulativePsd(receivedSignalPsd);
 
     std::size_t index = 0;
     uint16_t prevBw = 0;
@@ -443,7 +445,7 @@ SpectrumWifiPhy::StartRx(Ptr<SpectrumSignalParameters> rxParams,
         NS_ASSERT(bw <= channelWidth);
         index = ((bw != prevBw) ? 0 : (index + 1));
         double rxPowerPerBandW =
-            WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd, band.indices);
+            WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd, cumulativePsd, band.indices);
         NS_LOG_DEBUG("Signal power received (watts) before antenna gain for "
                      << bw << " MHz channel band " << index << ": " << band);
         rxPowerPerBandW *= rxGainRatio;
@@ -466,7 +468,9 @@ SpectrumWifiPhy::StartRx(Ptr<SpectrumSignalParameters> rxParams,
         for (const auto& [band, ru] : heRuBands)
         {
             double rxPowerPerBandW =
-                WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd, band.indices);
+                WifiSpectrumValueHelper::GetBandPowerW(receivedSignalPsd,
+                                                       cumulativePsd,
+                                                       band.indices);
             rxPowerPerBandW *= rxGainRatio;
             rxPowerW.insert({band, rxPowerPerBandW});
         }
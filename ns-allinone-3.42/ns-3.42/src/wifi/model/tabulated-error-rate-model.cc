@@ -0,0 +1,295 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tabulated-error-rate-model.h"
+
+#include "nist-error-rate-model.h"
+#include "wifi-utils.h"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TabulatedErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED(TabulatedErrorRateModel);
+
+TypeId
+TabulatedErrorRateModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TabulatedErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<TabulatedErrorRateModel>()
+            .AddAttribute("ErrorRateModel",
+                          "The error rate model whose chunk success rates are tabulated",
+                          PointerValue(CreateObject<NistErrorRateModel>()),
+                          MakePointerAccessor(&TabulatedErrorRateModel::SetErrorRateModel,
+                                              &TabulatedErrorRateModel::GetErrorRateModel),
+                          MakePointerChecker<ErrorRateModel>())
+            .AddAttribute("Exact",
+                          "If true, the tables are not used and the chunk success rates are "
+                          "always computed by the tabulated error rate model",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TabulatedErrorRateModel::m_exact),
+                          MakeBooleanChecker())
+            .AddAttribute("MaxError",
+                          "The maximum error of the interpolated chunk success rate, checked at "
+                          "the middle of each interval of the SNR grid when the table is sampled. "
+                          "The intervals where it is exceeded are computed by the tabulated "
+                          "error rate model.",
+                          DoubleValue(1e-6),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::m_maxError),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("SnrResolution",
+                          "The resolution (in dB) of the SNR grid",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::SetSnrResolution,
+                                             &TabulatedErrorRateModel::GetSnrResolution),
+                          MakeDoubleChecker<double>(0.001))
+            .AddAttribute("MinSnr",
+                          "The minimum SNR (in dB) covered by the tables",
+                          DoubleValue(-10),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::SetMinSnr,
+                                             &TabulatedErrorRateModel::GetMinSnr),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxSnr",
+                          "The maximum SNR (in dB) covered by the tables",
+                          DoubleValue(60),
+                          MakeDoubleAccessor(&TabulatedErrorRateModel::SetMaxSnr,
+                                             &TabulatedErrorRateModel::GetMaxSnr),
+                          MakeDoubleChecker<double>());
+    return tid;
+}
+
+TabulatedErrorRateModel::TabulatedErrorRateModel()
+{
+    NS_LOG_FUNCTION(this);
+    UpdateGrid();
+}
+
+TabulatedErrorRateModel::~TabulatedErrorRateModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TabulatedErrorRateModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_errorRateModel = nullptr;
+    m_tables.clear();
+    ErrorRateModel::DoDispose();
+}
+
+void
+TabulatedErrorRateModel::SetErrorRateModel(Ptr<ErrorRateModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_errorRateModel = model;
+    m_tables.clear();
+}
+
+Ptr<ErrorRateModel>
+TabulatedErrorRateModel::GetErrorRateModel() const
+{
+    return m_errorRateModel;
+}
+
+void
+TabulatedErrorRateModel::SetSnrResolution(double resolution)
+{
+    NS_LOG_FUNCTION(this << resolution);
+    m_resolution = resolution;
+    UpdateGrid();
+}
+
+double
+TabulatedErrorRateModel::GetSnrResolution() const
+{
+    return m_resolution;
+}
+
+void
+TabulatedErrorRateModel::SetMinSnr(double minSnr)
+{
+    NS_LOG_FUNCTION(this << minSnr);
+    m_minSnr = minSnr;
+    UpdateGrid();
+}
+
+double
+TabulatedErrorRateModel::GetMinSnr() const
+{
+    return m_minSnr;
+}
+
+void
+TabulatedErrorRateModel::SetMaxSnr(double maxSnr)
+{
+    NS_LOG_FUNCTION(this << maxSnr);
+    m_maxSnr = maxSnr;
+    UpdateGrid();
+}
+
+double
+TabulatedErrorRateModel::GetMaxSnr() const
+{
+    return m_maxSnr;
+}
+
+void
+TabulatedErrorRateModel::UpdateGrid()
+{
+    NS_LOG_FUNCTION(this);
+    // an octave is a factor of 2, i.e. about 3 dB
+    m_intervalsPerOctave =
+        std::max<uint32_t>(1, std::ceil(RatioToDb(2) / m_resolution - 1e-9));
+    std::frexp(DbToRatio(m_minSnr), &m_minExponent);
+    std::frexp(DbToRatio(m_maxSnr), &m_maxExponent);
+    // the last octave contains the maximum SNR; if the range is empty, no SNR is tabulated
+    m_maxExponent = std::max(m_maxExponent + 1, m_minExponent);
+    m_tables.clear();
+}
+
+double
+TabulatedErrorRateModel::GetGridSnr(std::size_t index) const
+{
+    // the points of an octave are equally spaced in the mantissa, from 0.5 (included) to 1
+    int exponent = m_minExponent + static_cast<int>(index / m_intervalsPerOctave);
+    double mantissa = 0.5 + 0.5 * (index % m_intervalsPerOctave) / m_intervalsPerOctave;
+    return std::ldexp(mantissa, exponent);
+}
+
+const TabulatedErrorRateModel::Row&
+TabulatedErrorRateModel::GetRow(Table& table, uint8_t k) const
+{
+    if (k >= table.rows.size())
+    {
+        table.rows.resize(k + 1);
+    }
+    Row& row = table.rows[k];
+    if (!row.csr.empty())
+    {
+        return row;
+    }
+
+    NS_LOG_DEBUG("Sample the chunk success rates of " << (1ULL << k) << " bits for mode "
+                                                      << table.mode);
+    uint64_t nbits = 1ULL << k;
+    auto getCsr = [&](double snr) {
+        return m_errorRateModel->GetChunkSuccessRate(table.mode,
+                                                     table.txVector,
+                                                     snr,
+                                                     nbits,
+                                                     table.numRxAntennas,
+                                                     table.field,
+                                                     table.staId);
+    };
+    std::size_t numIntervals = (m_maxExponent - m_minExponent) * m_intervalsPerOctave;
+    row.csr.resize(numIntervals + 1);
+    row.exact.resize(numIntervals);
+    for (std::size_t i = 0; i <= numIntervals; ++i)
+    {
+        row.csr[i] = getCsr(GetGridSnr(i));
+    }
+    for (std::size_t i = 0; i < numIntervals; ++i)
+    {
+        double middle = (GetGridSnr(i) + GetGridSnr(i + 1)) / 2;
+        double interpolated = (row.csr[i] + row.csr[i + 1]) / 2;
+        row.exact[i] = std::abs(interpolated - getCsr(middle)) > m_maxError;
+    }
+    return row;
+}
+
+double
+TabulatedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
+                                               const WifiTxVector& txVector,
+                                               double snr,
+                                               uint64_t nbits,
+                                               uint8_t numRxAntennas,
+                                               WifiPpduField field,
+                                               uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
+    int exponent = 0;
+    double mantissa = std::frexp(snr, &exponent);
+    if (m_exact || nbits == 0 || !std::isfinite(snr) || snr <= 0 ||
+        exponent < m_minExponent || exponent >= m_maxExponent)
+    {
+        return m_errorRateModel
+            ->GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+    }
+
+    // locate the SNR in the grid
+    double position = (mantissa - 0.5) * 2 * m_intervalsPerOctave;
+    auto interval = std::min(static_cast<uint32_t>(position), m_intervalsPerOctave - 1);
+    double weight = position - interval;
+    std::size_t index = (exponent - m_minExponent) * m_intervalsPerOctave + interval;
+
+    // the PHY rate of the payload captures the parameters of the TXVECTOR that matter
+    bool isPayload = !(txVector.IsMu() && staId == SU_STA_ID) && mode == txVector.GetMode(staId);
+    TableKey key{mode.GetUid(),
+                 txVector.GetChannelWidth(),
+                 isPayload ? mode.GetPhyRate(txVector, staId) : 0,
+                 numRxAntennas,
+                 field};
+    auto it = m_tables.find(key);
+    if (it == m_tables.end())
+    {
+        it = m_tables.emplace(key, Table{mode, txVector, numRxAntennas, field, staId, {}}).first;
+    }
+
+    // the chunk is split in parts of 2^k bits according to the binary representation of nbits
+    double csr = 1;
+    uint8_t k = 0;
+    for (uint64_t bits = nbits; bits > 0; bits >>= 1, ++k)
+    {
+        if ((bits & 1) == 0)
+        {
+            continue;
+        }
+        const Row& row = GetRow(it->second, k);
+        if (row.exact[index])
+        {
+            return m_errorRateModel
+                ->GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+        }
+        csr *= row.csr[index] + weight * (row.csr[index + 1] - row.csr[index]);
+    }
+    return csr;
+}
+
+bool
+TabulatedErrorRateModel::IsAwgn() const
+{
+    return m_errorRateModel->IsAwgn();
+}
+
+int64_t
+TabulatedErrorRateModel::AssignStreams(int64_t stream)
+{
+    return m_errorRateModel->AssignStreams(stream);
+}
+
+} // namespace ns3
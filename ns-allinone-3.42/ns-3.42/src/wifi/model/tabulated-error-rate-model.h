@@ -0,0 +1,179 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABULATED_ERROR_RATE_MODEL_H
+#define TABULATED_ERROR_RATE_MODEL_H
+
+#include "error-rate-model.h"
+#include "wifi-tx-vector.h"
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * \brief an error rate model that tabulates the chunk success rates of another model
+ *
+ * The chunk success rates returned by the wrapped error rate model are sampled on
+ * a grid of SNR values, for chunks of 2^k bits. A chunk of any size is then
+ * evaluated as the product of the (linearly interpolated) success rates of the
+ * chunks of 2^k bits given by the binary representation of its size, which costs
+ * a few table lookups and multiplications. This assumes that the success rate of
+ * a chunk is the product of the success rates of its parts, as is the case for the
+ * NIST and YANS models.
+ *
+ * The SNR grid divides each octave (i.e. a factor of 2 in linear scale) in equal
+ * intervals, so that the resolution is about SnrResolution dB everywhere and the
+ * grid is indexed without computing logarithms. A table is built on first use for
+ * each combination of mode, channel width, PHY rate of the payload, number of RX
+ * antennas and PPDU field, and a row of the table is sampled the first time a chunk
+ * size needs it.
+ *
+ * The wrapped model is used instead of the tables for the SNRs outside of
+ * [MinSnr, MaxSnr], for the grid intervals where the interpolation error at the
+ * middle of the interval exceeds MaxError, and for all the chunks if Exact is true.
+ */
+class TabulatedErrorRateModel : public ErrorRateModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TabulatedErrorRateModel();
+    ~TabulatedErrorRateModel() override;
+
+    bool IsAwgn() const override;
+    int64_t AssignStreams(int64_t stream) override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoGetChunkSuccessRate(WifiMode mode,
+                                 const WifiTxVector& txVector,
+                                 double snr,
+                                 uint64_t nbits,
+                                 uint8_t numRxAntennas,
+                                 WifiPpduField field,
+                                 uint16_t staId) const override;
+
+    /**
+     * Set the error rate model whose chunk success rates are tabulated.
+     * \param model the error rate model
+     */
+    void SetErrorRateModel(Ptr<ErrorRateModel> model);
+    /**
+     * \return the error rate model whose chunk success rates are tabulated
+     */
+    Ptr<ErrorRateModel> GetErrorRateModel() const;
+
+    /**
+     * Set the resolution of the SNR grid.
+     * \param resolution the resolution in dB
+     */
+    void SetSnrResolution(double resolution);
+    /**
+     * \return the resolution of the SNR grid in dB
+     */
+    double GetSnrResolution() const;
+
+    /**
+     * Set the minimum SNR covered by the tables.
+     * \param minSnr the minimum SNR in dB
+     */
+    void SetMinSnr(double minSnr);
+    /**
+     * \return the minimum SNR covered by the tables in dB
+     */
+    double GetMinSnr() const;
+    /**
+     * Set the maximum SNR covered by the tables.
+     * \param maxSnr the maximum SNR in dB
+     */
+    void SetMaxSnr(double maxSnr);
+    /**
+     * \return the maximum SNR covered by the tables in dB
+     */
+    double GetMaxSnr() const;
+
+    /**
+     * Compute the SNR grid from the resolution and the range and clear the tables.
+     */
+    void UpdateGrid();
+
+    /**
+     * \param index the index of a point of the SNR grid
+     * \return the SNR (linear scale) of the point
+     */
+    double GetGridSnr(std::size_t index) const;
+
+    /**
+     * The chunk success rates of 2^k bits sampled on the SNR grid
+     */
+    struct Row
+    {
+        std::vector<double> csr; //!< chunk success rate at each point of the grid
+        std::vector<bool> exact; //!< whether each interval of the grid needs the exact model
+    };
+
+    /**
+     * The rows of the chunk success rates for a given mode, TXVECTOR and PPDU field
+     */
+    struct Table
+    {
+        WifiMode mode;         //!< the mode used to sample the rows
+        WifiTxVector txVector; //!< the TXVECTOR used to sample the rows
+        uint8_t numRxAntennas; //!< the number of RX antennas used to sample the rows
+        WifiPpduField field;   //!< the PPDU field used to sample the rows
+        uint16_t staId;        //!< the STA-ID used to sample the rows
+        std::vector<Row> rows; //!< the rows, indexed by k (empty if not sampled yet)
+    };
+
+    /**
+     * Return the row of the chunk success rates of 2^k bits, sampling it if needed.
+     * \param table the table
+     * \param k the base 2 logarithm of the chunk size
+     * \return the row
+     */
+    const Row& GetRow(Table& table, uint8_t k) const;
+
+    /**
+     * Key of the tables: mode UID, channel width, PHY rate of the payload (0 for the PHY
+     * header), number of RX antennas and PPDU field
+     */
+    using TableKey = std::tuple<uint32_t, uint16_t, uint64_t, uint8_t, WifiPpduField>;
+
+    Ptr<ErrorRateModel> m_errorRateModel;       //!< the error rate model that is tabulated
+    bool m_exact;                               //!< whether to always use the exact model
+    double m_maxError;                          //!< the maximum interpolation error
+    double m_resolution{0.1};                   //!< the resolution of the SNR grid in dB
+    double m_minSnr{-10};                       //!< the minimum SNR in dB
+    double m_maxSnr{60};                        //!< the maximum SNR in dB
+    int m_minExponent{0};                       //!< the binary exponent of the first octave
+    int m_maxExponent{0};                       //!< the binary exponent after the last octave
+    uint32_t m_intervalsPerOctave{1};           //!< the number of grid intervals in each octave
+    mutable std::map<TableKey, Table> m_tables; //!< the tables
+};
+
+} // namespace ns3
+
+#endif /* TABULATED_ERROR_RATE_MODEL_H */
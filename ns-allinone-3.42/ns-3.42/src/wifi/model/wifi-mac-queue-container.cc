@@ -25,32 +25,40 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
-#include <vector>
-
 namespace ns3
 {
 
+WifiMacQueueContainer::QueueInfo::QueueInfo(const ContainerQueue::allocator_type& allocator)
+    : queue(allocator)
+{
+}
+
+WifiMacQueueContainer::WifiMacQueueContainer()
+    : m_pool(std::make_shared<WifiMacQueueElemPool>()),
+      m_expiredQueue(ContainerQueue::allocator_type(m_pool))
+{
+}
+
 void
 WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& queueInfo = GetQueueInfo(queueId);
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == queueInfo.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    queueInfo.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    return queueInfo.queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -61,13 +69,12 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto it = m_queues.find(GetQueueId(pos->mpdu));
+    NS_ASSERT(it != m_queues.end());
+    NS_ASSERT(it->second.nBytes >= pos->mpdu->GetSize());
+    it->second.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    return it->second.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -99,31 +106,39 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
     return {WIFI_DATA_QUEUE, addrType, address, std::nullopt};
 }
 
+WifiMacQueueContainer::QueueInfo&
+WifiMacQueueContainer::GetQueueInfo(const WifiContainerQueueId& queueId) const
+{
+    return m_queues.try_emplace(queueId, ContainerQueue::allocator_type(m_pool)).first->second;
+}
+
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return GetQueueInfo(queueId).queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    auto it = m_queues.find(queueId);
+    if (it == m_queues.end() || it->second.queue.empty())
     {
         return 0;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return it->second.nBytes;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(GetQueueInfo(queueId));
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& queueInfo) const
 {
+    auto& queue = queueInfo.queue;
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
@@ -153,11 +168,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(queueInfo.nBytes >= lastExpiredIt->mpdu->GetSize());
+            queueInfo.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
@@ -179,9 +191,9 @@ WifiMacQueueContainer::ExtractAllExpiredMpdus() const
 {
     std::optional<WifiMacQueueContainer::iterator> firstExpiredIt;
 
-    for (auto& queue : m_queues)
+    for (auto& [queueId, queueInfo] : m_queues)
     {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
+        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queueInfo);
 
         if (firstIt != lastIt && !firstExpiredIt)
         {
@@ -199,6 +211,12 @@ WifiMacQueueContainer::GetAllExpiredMpdus() const
     return {m_expiredQueue.begin(), m_expiredQueue.end()};
 }
 
+const WifiMacQueueElemPool&
+WifiMacQueueContainer::GetPool() const
+{
+    return *m_pool;
+}
+
 } // namespace ns3
 
 /****************************************************
@@ -209,16 +227,17 @@ std::size_t
 std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queueId) const
 {
     auto [type, addrType, address, tid] = queueId;
-    const std::size_t size = tid.has_value() ? 8 : 7;
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
 
-    std::vector<uint8_t> buffer(size);
-    buffer[0] = type;
-    address.CopyTo(&buffer[1]);
-    if (tid.has_value())
+    // pack the queue ID in a 64-bit integer: 2 bits for the queue type, 1 bit for the
+    // address type, 48 bits for the address and 5 bits for the (optional) TID
+    uint64_t key = (static_cast<uint64_t>(type) << 1) | addrType;
+    for (auto byte : buffer)
     {
-        buffer[7] = *tid;
+        key = (key << 8) | byte;
     }
+    key = (key << 5) | (tid.has_value() ? 0x10 | (*tid & 0x0f) : 0);
 
-    std::string s(buffer.begin(), buffer.end());
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}(key);
 }
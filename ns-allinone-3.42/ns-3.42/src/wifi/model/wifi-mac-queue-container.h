@@ -25,6 +25,7 @@
 #include "ns3/mac48-address.h"
 
 #include <list>
+#include <memory>
 #include <optional>
 #include <tuple>
 #include <unordered_map>
@@ -109,17 +110,22 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ * The elements of all the container queues are allocated from a pool owned by the
+ * container, hence no memory is allocated when MPDUs are enqueued or dequeued
+ * once the pool has grown to the peak number of queued MPDUs.
  */
 class WifiMacQueueContainer
 {
   public:
     /// Type of a queue held by the container
-    using ContainerQueue = std::list<WifiMacQueueElem>;
+    using ContainerQueue = std::list<WifiMacQueueElem, WifiMacQueueElemAllocator<WifiMacQueueElem>>;
     /// iterator over elements in a container queue
     using iterator = ContainerQueue::iterator;
     /// const iterator over elements in a container queue
     using const_iterator = ContainerQueue::const_iterator;
 
+    WifiMacQueueContainer();
+
     /**
      * Erase all elements from the container.
      */
@@ -204,22 +210,49 @@ class WifiMacQueueContainer
      */
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
+    /**
+     * \return the pool the elements of the container queues are allocated from
+     */
+    const WifiMacQueueElemPool& GetPool() const;
+
   private:
+    /// A container queue and the total size of the MPDUs it stores
+    struct QueueInfo
+    {
+        /**
+         * Constructor.
+         *
+         * \param allocator the allocator for the elements of the container queue
+         */
+        QueueInfo(const ContainerQueue::allocator_type& allocator);
+
+        ContainerQueue queue; //!< the container queue
+        uint32_t nBytes{0};   //!< size in bytes of the container queue
+    };
+
+    /**
+     * Get the container queue identified by the given QueueId along with its size.
+     * The container queue is created if it does not exist.
+     *
+     * \param queueId the given QueueId
+     * \return the container queue identified by the given QueueId and its size
+     */
+    QueueInfo& GetQueueInfo(const WifiContainerQueueId& queueId) const;
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * \param queue the given container queue
+     * \param queueInfo the given container queue and its size
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& queueInfo) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    std::shared_ptr<WifiMacQueueElemPool> m_pool; //!< pool of the container queue elements
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
 };
 
 } // namespace ns3
@@ -21,6 +21,10 @@
 
 #include "wifi-mpdu.h"
 
+#include "ns3/assert.h"
+
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -38,4 +42,77 @@ WifiMacQueueElem::~WifiMacQueueElem()
     inflights.clear();
 }
 
+WifiMacQueueElemPool::~WifiMacQueueElemPool()
+{
+    NS_ASSERT_MSG(m_nFreeBlocks == m_nBlocks, "Destroying a pool whose blocks are in use");
+}
+
+std::size_t
+WifiMacQueueElemPool::GetBlockSize(std::size_t size)
+{
+    // blocks must be large enough to hold a free list entry and keep the alignment
+    const std::size_t align = alignof(std::max_align_t);
+    return (std::max(size, sizeof(FreeBlock)) + align - 1) / align * align;
+}
+
+void*
+WifiMacQueueElemPool::Allocate(std::size_t size)
+{
+    if (m_blockSize == 0)
+    {
+        m_blockSize = GetBlockSize(size);
+    }
+    if (GetBlockSize(size) != m_blockSize)
+    {
+        return ::operator new(size);
+    }
+
+    if (m_freeList == nullptr)
+    {
+        // double the number of blocks, up to 1024 blocks per chunk
+        const std::size_t nBlocks = std::clamp<std::size_t>(m_nBlocks, 16, 1024);
+        m_chunks.emplace_back(new std::byte[nBlocks * m_blockSize]);
+        std::byte* chunk = m_chunks.back().get();
+        for (std::size_t i = nBlocks; i > 0; --i)
+        {
+            auto block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_blockSize);
+            block->next = m_freeList;
+            m_freeList = block;
+        }
+        m_nBlocks += nBlocks;
+        m_nFreeBlocks += nBlocks;
+    }
+
+    FreeBlock* block = m_freeList;
+    m_freeList = block->next;
+    --m_nFreeBlocks;
+    return block;
+}
+
+void
+WifiMacQueueElemPool::Deallocate(void* block, std::size_t size)
+{
+    if (GetBlockSize(size) != m_blockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+    auto freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = m_freeList;
+    m_freeList = freeBlock;
+    ++m_nFreeBlocks;
+}
+
+std::size_t
+WifiMacQueueElemPool::GetNBlocks() const
+{
+    return m_nBlocks;
+}
+
+std::size_t
+WifiMacQueueElemPool::GetNFreeBlocks() const
+{
+    return m_nFreeBlocks;
+}
+
 } // namespace ns3
@@ -25,7 +25,10 @@
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
 
+#include <cstddef>
 #include <map>
+#include <memory>
+#include <vector>
 
 namespace ns3
 {
@@ -66,6 +69,166 @@ struct WifiMacQueueElem
     ~WifiMacQueueElem();
 };
 
+/**
+ * \ingroup wifi
+ * Pool of memory blocks of the same size from which the nodes of the container
+ * queues of a WifiMacQueueContainer are allocated.
+ *
+ * Blocks are carved out of chunks of increasing size and released blocks are kept
+ * in a free list to be reused, hence enqueuing and dequeuing MPDUs does not allocate
+ * memory once the pool has grown to the peak occupancy of the container. The block
+ * size is set by the first allocation; requests of a different size are served by
+ * the global operator new.
+ */
+class WifiMacQueueElemPool
+{
+  public:
+    WifiMacQueueElemPool() = default;
+    ~WifiMacQueueElemPool();
+
+    // delete copy constructor and assignment operator to avoid misuse
+    WifiMacQueueElemPool(const WifiMacQueueElemPool&) = delete;
+    WifiMacQueueElemPool& operator=(const WifiMacQueueElemPool&) = delete;
+
+    /**
+     * Allocate a block of memory.
+     *
+     * \param size the size in bytes of the block
+     * \return a pointer to the allocated block
+     */
+    void* Allocate(std::size_t size);
+
+    /**
+     * Release a block of memory that was returned by Allocate.
+     *
+     * \param block a pointer to the block
+     * \param size the size in bytes that was passed to Allocate
+     */
+    void Deallocate(void* block, std::size_t size);
+
+    /**
+     * \return the number of blocks carved out of the chunks of the pool
+     */
+    std::size_t GetNBlocks() const;
+
+    /**
+     * \return the number of blocks that are currently in the free list
+     */
+    std::size_t GetNFreeBlocks() const;
+
+  private:
+    /// A released block, linked to the next one in the free list
+    struct FreeBlock
+    {
+        FreeBlock* next; ///< the next block in the free list
+    };
+
+    /**
+     * \param size the size in bytes of a requested block
+     * \return the size of the block serving the request
+     */
+    static std::size_t GetBlockSize(std::size_t size);
+
+    std::size_t m_blockSize{0};                         //!< the size of the blocks
+    std::vector<std::unique_ptr<std::byte[]>> m_chunks; //!< the chunks blocks are carved out of
+    FreeBlock* m_freeList{nullptr};                     //!< head of the list of released blocks
+    std::size_t m_nBlocks{0};                           //!< number of blocks in the chunks
+    std::size_t m_nFreeBlocks{0};                       //!< number of blocks in the free list
+};
+
+/**
+ * \ingroup wifi
+ * Allocator drawing the nodes of the container queues from a WifiMacQueueElemPool.
+ *
+ * All the allocators copied from the same one share its pool and compare equal,
+ * hence elements can be spliced between the container queues of the same
+ * WifiMacQueueContainer. A default constructed allocator has no pool and uses
+ * the global operator new.
+ *
+ * \tparam T the type of the allocated objects
+ */
+template <class T>
+class WifiMacQueueElemAllocator
+{
+  public:
+    using value_type = T; ///< the type of the allocated objects
+
+    WifiMacQueueElemAllocator() = default;
+
+    /**
+     * Constructor.
+     *
+     * \param pool the pool to allocate objects from
+     */
+    explicit WifiMacQueueElemAllocator(std::shared_ptr<WifiMacQueueElemPool> pool)
+        : m_pool(std::move(pool))
+    {
+    }
+
+    /**
+     * Construct an allocator sharing the pool of an allocator for another type.
+     *
+     * \tparam U the type of objects allocated by the other allocator
+     * \param other the other allocator
+     */
+    template <class U>
+    WifiMacQueueElemAllocator(const WifiMacQueueElemAllocator<U>& other)
+        : m_pool(other.GetPool())
+    {
+    }
+
+    /**
+     * \param n the number of objects
+     * \return storage for the given number of objects
+     */
+    T* allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned type");
+        if (n == 1 && m_pool)
+        {
+            return static_cast<T*>(m_pool->Allocate(sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    /**
+     * \param p the storage to release
+     * \param n the number of objects that was passed to allocate
+     */
+    void deallocate(T* p, std::size_t n)
+    {
+        if (n == 1 && m_pool)
+        {
+            m_pool->Deallocate(p, sizeof(T));
+            return;
+        }
+        ::operator delete(p);
+    }
+
+    /**
+     * \return the pool objects are allocated from, if any
+     */
+    const std::shared_ptr<WifiMacQueueElemPool>& GetPool() const
+    {
+        return m_pool;
+    }
+
+  private:
+    std::shared_ptr<WifiMacQueueElemPool> m_pool; //!< the pool objects are allocated from
+};
+
+/**
+ * \param a the first allocator
+ * \param b the second allocator
+ * \return true if the given allocators share the same pool
+ */
+template <class T, class U>
+bool
+operator==(const WifiMacQueueElemAllocator<T>& a, const WifiMacQueueElemAllocator<U>& b)
+{
+    return a.GetPool() == b.GetPool();
+}
+
 } // namespace ns3
 
 #endif /* WIFI_MAC_QUEUE_ELEM_H */
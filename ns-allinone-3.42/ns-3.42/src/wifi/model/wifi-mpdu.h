@@ -158,7 +158,8 @@ class WifiMpdu : public SimpleRefCount<WifiMpdu>
     DeaggregatedMsdusCI end() const;
 
     /// Const iterator typedef
-    typedef std::list<WifiMacQueueElem>::iterator Iterator;
+    typedef std::list<WifiMacQueueElem, WifiMacQueueElemAllocator<WifiMacQueueElem>>::iterator
+        Iterator;
 
     /**
      * Set the queue iterator stored by this object.
@@ -46,6 +46,8 @@
 #include "ns3/vht-configuration.h"
 
 #include <algorithm>
+#include <array>
+#include <unordered_map>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                                                      \
@@ -788,6 +790,8 @@ WifiPhy::AddStaticPhyEntity(WifiModulationClass modulation, Ptr<PhyEntity> phyEn
                   "The PHY entity has already been added. The setting should only be done once per "
                   "modulation class");
     GetStaticPhyEntities()[modulation] = phyEntity;
+    // cached TX durations may have been computed by another PHY entity
+    ClearTxDurationCache();
 }
 
 void
@@ -1535,15 +1539,100 @@ WifiPhy::CalculatePhyPreambleAndHeaderDuration(const WifiTxVector& txVector)
         ->CalculatePhyPreambleAndHeaderDuration(txVector);
 }
 
+/**
+ * Cache of the TX durations of non-MU PPDUs computed by WifiPhy::CalculateTxDuration.
+ */
+struct TxDurationCache
+{
+    /// Key packing the PSDU size, the band and the TXVECTOR parameters a duration depends on
+    using Key = std::array<uint64_t, 3>;
+
+    /// Hash functor for the keys of the cache
+    struct KeyHash
+    {
+        /**
+         * \param key the key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t seed = 0;
+            for (auto value : key)
+            {
+                seed ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15 + (seed << 6) +
+                        (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+    /// Maximum number of cached durations, the cache is emptied when it is full
+    static constexpr std::size_t MAX_SIZE = 4096;
+
+    std::unordered_map<Key, Time, KeyHash> durations; //!< the cached durations
+    WifiPhy::TxDurationCacheStats stats;              //!< hit and miss counters
+};
+
+/// The cache of TX durations of the current thread
+static thread_local TxDurationCache g_txDurationCache;
+
+WifiPhy::TxDurationCacheStats
+WifiPhy::GetTxDurationCacheStats()
+{
+    return g_txDurationCache.stats;
+}
+
+void
+WifiPhy::ClearTxDurationCache()
+{
+    g_txDurationCache.durations.clear();
+    g_txDurationCache.stats = {};
+}
+
 Time
 WifiPhy::CalculateTxDuration(uint32_t size,
                              const WifiTxVector& txVector,
                              WifiPhyBand band,
                              uint16_t staId)
 {
+    if (txVector.IsMu() || !txVector.GetInactiveSubchannels().empty())
+    {
+        // the duration of MU PPDUs depends on the per-user parameters, which are not cached
+        Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+                        GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+        NS_ASSERT(duration.IsStrictlyPositive());
+        return duration;
+    }
+
+    const TxDurationCache::Key key{
+        (static_cast<uint64_t>(txVector.GetMode().GetUid()) << 32) | size,
+        (static_cast<uint64_t>(txVector.GetPreambleType()) << 56) |
+            (static_cast<uint64_t>(txVector.GetChannelWidth()) << 40) |
+            (static_cast<uint64_t>(txVector.GetGuardInterval()) << 24) |
+            (static_cast<uint64_t>(txVector.GetNss()) << 16) |
+            (static_cast<uint64_t>(txVector.GetNess()) << 8) | txVector.GetNTx(),
+        (static_cast<uint64_t>(band) << 32) | (static_cast<uint64_t>(txVector.IsStbc()) << 26) |
+            (static_cast<uint64_t>(txVector.IsLdpc()) << 25) |
+            (static_cast<uint64_t>(txVector.IsAggregation()) << 24) |
+            (static_cast<uint64_t>(txVector.GetEhtPpduType()) << 16) | txVector.GetLength()};
+
+    auto& cache = g_txDurationCache;
+    if (auto it = cache.durations.find(key); it != cache.durations.end())
+    {
+        ++cache.stats.hits;
+        return it->second;
+    }
+
     Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
                     GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+
+    ++cache.stats.misses;
+    if (cache.durations.size() >= TxDurationCache::MAX_SIZE)
+    {
+        cache.durations.clear();
+    }
+    cache.durations.emplace(key, duration);
     return duration;
 }
 
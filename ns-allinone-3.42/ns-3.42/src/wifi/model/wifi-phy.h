@@ -280,6 +280,28 @@ class WifiPhy : public Object
                                     const WifiTxVector& txVector,
                                     WifiPhyBand band);
 
+    /// Hit and miss counters of the cache of TX durations
+    struct TxDurationCacheStats
+    {
+        uint64_t hits{0};   //!< number of TX durations found in the cache
+        uint64_t misses{0}; //!< number of TX durations computed and stored in the cache
+    };
+
+    /**
+     * The TX durations of non-MU PPDUs returned by CalculateTxDuration are cached, because
+     * the frame exchange managers compute the same durations many times per TXOP (for the
+     * Duration/ID fields, timeouts and aggregation decisions). The cache belongs to the
+     * calling thread and its size is bounded.
+     *
+     * \return the hit and miss counters of the cache of TX durations of the calling thread
+     */
+    static TxDurationCacheStats GetTxDurationCacheStats();
+
+    /**
+     * Empty the cache of TX durations of the calling thread and reset its counters.
+     */
+    static void ClearTxDurationCache();
+
     /**
      * \param txVector the transmission parameters used for this packet
      *
@@ -21,6 +21,7 @@
 
 #include "wifi-tx-current-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/energy-source.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
@@ -82,6 +83,14 @@ WifiRadioEnergyModel::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&WifiRadioEnergyModel::m_txCurrentModel),
                           MakePointerChecker<WifiTxCurrentModel>())
+            .AddAttribute("LazyEnergyUpdate",
+                          "Schedule the switch to the OFF state only once the energy source "
+                          "reports its depletion, instead of at each state change and change of "
+                          "the remaining energy. The energy source must detect its depletion "
+                          "before the energy is exhausted.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&WifiRadioEnergyModel::m_lazyEnergyUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource(
                 "TotalEnergyConsumption",
                 "Total energy consumption of the radio device.",
@@ -94,7 +103,9 @@ WifiRadioEnergyModel::WifiRadioEnergyModel()
     : m_source(nullptr),
       m_currentState(WifiPhyState::IDLE),
       m_lastUpdateTime(Seconds(0.0)),
-      m_nPendingChangeState(0)
+      m_nPendingChangeState(0),
+      m_lazyEnergyUpdate(false),
+      m_sourceDepleted(false)
 {
     NS_LOG_FUNCTION(this);
     m_energyDepletionCallback.Nullify();
@@ -119,12 +130,8 @@ WifiRadioEnergyModel::SetEnergySource(const Ptr<energy::EnergySource> source)
     NS_LOG_FUNCTION(this << source);
     NS_ASSERT(source);
     m_source = source;
-    m_switchToOffEvent.Cancel();
-    Time durationToOff = GetMaximumTimeInState(m_currentState);
-    m_switchToOffEvent = Simulator::Schedule(durationToOff,
-                                             &WifiRadioEnergyModel::ChangeState,
-                                             this,
-                                             static_cast<int>(WifiPhyState::OFF));
+    m_sourceDepleted = false;
+    ScheduleSwitchToOff(m_currentState);
 }
 
 double
@@ -303,12 +310,7 @@ WifiRadioEnergyModel::ChangeState(int newState)
 
     if (newPhyState != WifiPhyState::OFF)
     {
-        m_switchToOffEvent.Cancel();
-        Time durationToOff = GetMaximumTimeInState(newPhyState);
-        m_switchToOffEvent = Simulator::Schedule(durationToOff,
-                                                 &WifiRadioEnergyModel::ChangeState,
-                                                 this,
-                                                 static_cast<int>(WifiPhyState::OFF));
+        ScheduleSwitchToOff(newPhyState);
     }
 
     Time duration = Simulator::Now() - m_lastUpdateTime;
@@ -353,6 +355,12 @@ WifiRadioEnergyModel::HandleEnergyDepletion()
 {
     NS_LOG_FUNCTION(this);
     NS_LOG_DEBUG("WifiRadioEnergyModel:Energy is depleted!");
+    m_sourceDepleted = true;
+    if (m_lazyEnergyUpdate && m_currentState != WifiPhyState::OFF)
+    {
+        // the switch to off was not scheduled while the source was not depleted
+        ScheduleSwitchToOff(m_currentState);
+    }
     // invoke energy depletion callback, if set.
     if (!m_energyDepletionCallback.IsNull())
     {
@@ -365,6 +373,11 @@ WifiRadioEnergyModel::HandleEnergyRecharged()
 {
     NS_LOG_FUNCTION(this);
     NS_LOG_DEBUG("WifiRadioEnergyModel:Energy is recharged!");
+    m_sourceDepleted = false;
+    if (m_lazyEnergyUpdate)
+    {
+        m_switchToOffEvent.Cancel();
+    }
     // invoke energy recharged callback, if set.
     if (!m_energyRechargedCallback.IsNull())
     {
@@ -379,15 +392,25 @@ WifiRadioEnergyModel::HandleEnergyChanged()
     NS_LOG_DEBUG("WifiRadioEnergyModel:Energy is changed!");
     if (m_currentState != WifiPhyState::OFF)
     {
-        m_switchToOffEvent.Cancel();
-        Time durationToOff = GetMaximumTimeInState(m_currentState);
-        m_switchToOffEvent = Simulator::Schedule(durationToOff,
-                                                 &WifiRadioEnergyModel::ChangeState,
-                                                 this,
-                                                 static_cast<int>(WifiPhyState::OFF));
+        ScheduleSwitchToOff(m_currentState);
     }
 }
 
+void
+WifiRadioEnergyModel::ScheduleSwitchToOff(WifiPhyState state)
+{
+    if (m_lazyEnergyUpdate && !m_sourceDepleted)
+    {
+        return;
+    }
+    m_switchToOffEvent.Cancel();
+    Time durationToOff = GetMaximumTimeInState(state);
+    m_switchToOffEvent = Simulator::Schedule(durationToOff,
+                                             &WifiRadioEnergyModel::ChangeState,
+                                             this,
+                                             static_cast<int>(WifiPhyState::OFF));
+}
+
 std::shared_ptr<WifiRadioEnergyModelPhyListener>
 WifiRadioEnergyModel::GetPhyListener()
 {
@@ -118,6 +118,16 @@ class WifiRadioEnergyModelPhyListener : public WifiPhyListener
  * object. The EnergySource object will query this model for the total current.
  * Then the EnergySource object uses the total current to calculate energy.
  *
+ * Switching off: the model schedules the switch to the OFF state at the time
+ * the remaining energy would be exhausted in the current state, and
+ * reschedules it at each state change and each change of the remaining
+ * energy. With the LazyEnergyUpdate attribute, the switch to the OFF state is
+ * only scheduled once the energy source reports its depletion, so that the
+ * state changes of the radio schedule no event before that; this relies on
+ * the energy source to detect its depletion (e.g., a BasicEnergySource with
+ * its AnalyticEnergyUpdate attribute), and on a low battery threshold of
+ * the energy source reached before the energy is exhausted.
+ *
  * Default values for power consumption are based on measurements reported in:
  *
  * Daniel Halperin, Ben Greenstein, Anmol Sheth, David Wetherall,
@@ -357,6 +367,15 @@ class WifiRadioEnergyModel : public energy::DeviceEnergyModel
      */
     void SetWifiRadioState(const WifiPhyState state);
 
+    /**
+     * Schedule the switch to the OFF state at the time the remaining energy
+     * would be exhausted in the given state, unless the switch is lazy and
+     * the energy source is not depleted.
+     *
+     * \param state the state the radio is switching to
+     */
+    void ScheduleSwitchToOff(WifiPhyState state);
+
     Ptr<energy::EnergySource> m_source; ///< energy source
 
     // Member variables for current draw in different radio modes.
@@ -387,6 +406,8 @@ class WifiRadioEnergyModel : public energy::DeviceEnergyModel
     std::shared_ptr<WifiRadioEnergyModelPhyListener> m_listener;
 
     EventId m_switchToOffEvent; ///< switch to off event
+    bool m_lazyEnergyUpdate;    ///< schedule the switch to off only once the source is depleted
+    bool m_sourceDepleted;      ///< whether the energy source reported its depletion
 };
 
 } // namespace ns3
@@ -1415,11 +1415,18 @@ std::shared_ptr<WifiRemoteStationState>
 WifiRemoteStationManager::LookupState(Mac48Address address) const
 {
     NS_LOG_FUNCTION(this << address);
+    if (m_lastState.second && m_lastState.first == address)
+    {
+        NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning last state");
+        return m_lastState.second;
+    }
+
     auto stateIt = m_states.find(address);
 
     if (stateIt != m_states.end())
     {
         NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning existing state");
+        m_lastState = {address, stateIt->second};
         return stateIt->second;
     }
 
@@ -1446,6 +1453,7 @@ WifiRemoteStationManager::LookupState(Mac48Address address) const
     state->m_isInPsMode = false;
     const_cast<WifiRemoteStationManager*>(this)->m_states.insert({address, state});
     NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning new state");
+    m_lastState = {address, state};
     return state;
 }
 
@@ -1455,10 +1463,16 @@ WifiRemoteStationManager::Lookup(Mac48Address address) const
     NS_LOG_FUNCTION(this << address);
     NS_ASSERT(!address.IsGroup());
     NS_ASSERT(address != m_wifiMac->GetAddress());
+    if (m_lastStation.second && m_lastStation.first == address)
+    {
+        return m_lastStation.second;
+    }
+
     auto stationIt = m_stations.find(address);
 
     if (stationIt != m_stations.end())
     {
+        m_lastStation = {address, stationIt->second};
         return stationIt->second;
     }
 
@@ -1466,6 +1480,7 @@ WifiRemoteStationManager::Lookup(Mac48Address address) const
     station->m_state = LookupState(address).get();
     station->m_rssiAndUpdateTimePair = std::make_pair(0, Seconds(0));
     const_cast<WifiRemoteStationManager*>(this)->m_stations.insert({address, station});
+    m_lastStation = {address, station};
     return station;
 }
 
@@ -1765,6 +1780,8 @@ WifiRemoteStationManager::Reset()
         delete (state.second);
     }
     m_stations.clear();
+    m_lastState = {};
+    m_lastStation = {Mac48Address(), nullptr};
     m_bssBasicRateSet.clear();
     m_bssBasicMcsSet.clear();
     m_ssrc.fill(0);
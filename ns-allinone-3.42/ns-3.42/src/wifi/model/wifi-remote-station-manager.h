@@ -1514,6 +1514,12 @@ class WifiRemoteStationManager : public Object
     StationStates m_states; //!< States of known stations
     Stations m_stations;    //!< Information for each known stations
 
+    /// The address and state of the station last returned by LookupState (which is
+    /// typically called several times in a row for the same station when handling a frame)
+    mutable std::pair<Mac48Address, std::shared_ptr<WifiRemoteStationState>> m_lastState;
+    /// The address and station last returned by Lookup
+    mutable std::pair<Mac48Address, WifiRemoteStation*> m_lastStation{Mac48Address(), nullptr};
+
     uint32_t m_maxSsrc;                //!< Maximum STA short retry count (SSRC)
     uint32_t m_maxSlrc;                //!< Maximum STA long retry count (SLRC)
     uint32_t m_rtsCtsThreshold;        //!< Threshold for RTS/CTS
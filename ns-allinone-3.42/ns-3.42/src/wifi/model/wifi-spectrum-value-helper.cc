@@ -27,6 +27,7 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <sstream>
@@ -810,6 +811,41 @@ WifiSpectrumValueHelper::GetBandPowerW(Ptr<SpectrumValue> psd, const WifiSpectru
     return power;
 }
 
+std::vector<long double>
+WifiSpectrumValueHelper::GetCumulativePsd(Ptr<const SpectrumValue> psd)
+{
+    std::vector<long double> cumulativePsd;
+    cumulativePsd.reserve(psd->GetValuesN() + 1);
+    long double sum{0.0};
+    cumulativePsd.push_back(sum);
+    for (auto valueIt = psd->ConstValuesBegin(); valueIt != psd->ConstValuesEnd(); ++valueIt)
+    {
+        NS_ASSERT_MSG(*valueIt >= 0.0,
+                      "Invalid power value " << *valueIt << " in subband "
+                                             << cumulativePsd.size() - 1);
+        sum += *valueIt;
+        cumulativePsd.push_back(sum);
+    }
+    return cumulativePsd;
+}
+
+double
+WifiSpectrumValueHelper::GetBandPowerW(Ptr<const SpectrumValue> psd,
+                                       const std::vector<long double>& cumulativePsd,
+                                       const WifiSpectrumBandIndices& band)
+{
+    NS_ASSERT(cumulativePsd.size() == psd->GetValuesN() + 1);
+    NS_ASSERT(band.first <= band.second && band.second < psd->GetValuesN());
+    auto bandIt = psd->ConstBandsBegin() + band.first; // all bands have same width
+    const auto bandWidth = (bandIt->fh - bandIt->fl);
+    NS_ASSERT_MSG(bandWidth >= 0.0,
+                  "Invalid width for subband [" << bandIt->fl << ";" << bandIt->fh << "]");
+    // the difference of the running sums can be slightly negative due to rounding errors
+    const auto powerWattPerHertz =
+        std::max(cumulativePsd[band.second + 1] - cumulativePsd[band.first], 0.0L);
+    return static_cast<double>(powerWattPerHertz) * bandWidth;
+}
+
 bool
 operator<(const FrequencyRange& left, const FrequencyRange& right)
 {
@@ -24,6 +24,8 @@
 
 #include <ns3/spectrum-value.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -323,6 +325,32 @@ class WifiSpectrumValueHelper
      * \return band power in W
      */
     static double GetBandPowerW(Ptr<SpectrumValue> psd, const WifiSpectrumBandIndices& band);
+
+    /**
+     * Compute the running sum of the values of the given PSD, so that the power of any band
+     * of the PSD can then be obtained in constant time by GetBandPowerW(). This is convenient
+     * when the power of many (possibly overlapping) bands has to be computed for the same PSD.
+     * The returned vector has one more element than the PSD, the first element being zero.
+     *
+     * \param psd Power Spectral Density in W/Hz
+     *
+     * \return the running sum of the values of the PSD
+     */
+    static std::vector<long double> GetCumulativePsd(Ptr<const SpectrumValue> psd);
+
+    /**
+     * Calculate the power of the specified band composed of uniformly-sized sub-bands, using
+     * the running sum of the values of the PSD returned by GetCumulativePsd().
+     *
+     * \param psd Power Spectral Density in W/Hz
+     * \param cumulativePsd the running sum of the values of the PSD
+     * \param band a pair of start and stop indexes that defines the band
+     *
+     * \return band power in W
+     */
+    static double GetBandPowerW(Ptr<const SpectrumValue> psd,
+                                const std::vector<long double>& cumulativePsd,
+                                const WifiSpectrumBandIndices& band);
 };
 
 /**
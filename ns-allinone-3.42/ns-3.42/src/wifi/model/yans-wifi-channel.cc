@@ -25,6 +25,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -57,11 +58,21 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "If strictly positive, the maximum distance in meters between "
+                          "the sender and a receiving PHY for a PPDU to be delivered to it. "
+                          "Farther PHYs are skipped before the propagation loss and delay "
+                          "models are called, and are found through a grid over the PHY "
+                          "positions. The default value of zero disables this cutoff.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_phyGrid(Create<MobilityGrid<YansWifiPhy>>())
 {
     NS_LOG_FUNCTION(this);
 }
@@ -70,6 +81,8 @@ YansWifiChannel::~YansWifiChannel()
 {
     NS_LOG_FUNCTION(this);
     m_phyList.clear();
+    m_phyGrid->Clear();
+    m_channelPhys.clear();
 }
 
 void
@@ -92,7 +105,14 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    PhyList inRange;
+    if (m_maxRange > 0)
+    {
+        inRange = m_phyGrid->GetInRange(senderMobility->GetPosition(), m_maxRange);
+    }
+    const PhyList& rxPhys =
+        m_maxRange > 0 ? inRange : GetPhysOnChannel(sender->GetChannelNumber());
+    for (auto i = rxPhys.begin(); i != rxPhys.end(); i++)
     {
         if (sender != (*i))
         {
@@ -130,6 +150,21 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     }
 }
 
+const YansWifiChannel::PhyList&
+YansWifiChannel::GetPhysOnChannel(uint8_t channelNumber) const
+{
+    if (m_channelPhys.empty())
+    {
+        for (const auto& phy : m_phyList)
+        {
+            m_channelPhys[phy->GetChannelNumber()].push_back(phy);
+        }
+    }
+    static const PhyList noPhys;
+    auto it = m_channelPhys.find(channelNumber);
+    return it != m_channelPhys.end() ? it->second : noPhys;
+}
+
 void
 YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
 {
@@ -167,6 +202,15 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    m_phyGrid->Add(phy);
+    m_channelPhys.clear();
+}
+
+void
+YansWifiChannel::NotifyChannelSwitch(Ptr<YansWifiPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    m_channelPhys.clear();
 }
 
 int64_t
@@ -21,6 +21,9 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/mobility-grid.h"
+
+#include <map>
 
 namespace ns3
 {
@@ -41,6 +44,11 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * The PHYs are grouped by channel number, so that a transmission only visits
+ * the PHYs tuned to the channel of the sender. If the MaxRange attribute is
+ * set, the PHYs farther than that from the sender are skipped as well, using
+ * a MobilityGrid over their positions.
  */
 class YansWifiChannel : public Channel
 {
@@ -64,6 +72,14 @@ class YansWifiChannel : public Channel
      */
     void Add(Ptr<YansWifiPhy> phy);
 
+    /**
+     * Notify the channel that the given YansWifiPhy switched to another
+     * operating channel.
+     *
+     * \param phy the YansWifiPhy that switched channel
+     */
+    void NotifyChannelSwitch(Ptr<YansWifiPhy> phy);
+
     /**
      * \param loss the new propagation loss model.
      */
@@ -113,9 +129,19 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
+    /**
+     * \param channelNumber a channel number
+     * \return the PHYs tuned to that channel, in the order of m_phyList
+     */
+    const PhyList& GetPhysOnChannel(uint8_t channelNumber) const;
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Range beyond which PHYs are skipped, if positive
+    Ptr<MobilityGrid<YansWifiPhy>> m_phyGrid; //!< Grid over the positions of m_phyList
+    /// PHYs of m_phyList grouped by channel number, built on the next Send if empty
+    mutable std::map<uint8_t, PhyList> m_channelPhys;
 };
 
 } // namespace ns3
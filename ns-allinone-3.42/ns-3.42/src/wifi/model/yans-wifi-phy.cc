@@ -88,6 +88,17 @@ YansWifiPhy::SetChannel(const Ptr<YansWifiChannel> channel)
     m_channel->Add(this);
 }
 
+void
+YansWifiPhy::DoChannelSwitch()
+{
+    NS_LOG_FUNCTION(this);
+    WifiPhy::DoChannelSwitch();
+    if (m_channel)
+    {
+        m_channel->NotifyChannelSwitch(this);
+    }
+}
+
 void
 YansWifiPhy::StartTx(Ptr<const WifiPpdu> ppdu)
 {
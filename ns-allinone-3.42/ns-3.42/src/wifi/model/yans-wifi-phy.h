@@ -98,6 +98,10 @@ class YansWifiPhy : public WifiPhy
     void DoDispose() override;
 
   private:
+    // The following method calls the base WifiPhy class method
+    // and tells the YansWifiChannel that the channel number changed
+    void DoChannelSwitch() override;
+
     Ptr<YansWifiChannel> m_channel; //!< YansWifiChannel that this YansWifiPhy is connected to
 
     TracedCallback<Ptr<const WifiPpdu>, double, Time>
@@ -1996,6 +1996,66 @@ SpectrumWifiPhyInterfacesHelperTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Band power computed from the running sum of a PSD
+ *
+ * This test checks that the power of a band computed from the running sum of the PSD matches
+ * the power obtained by integrating the PSD over the band, for bands of various widths spread
+ * over a 160 MHz HE PSD including its guard bands.
+ */
+class SpectrumWifiPhyCumulativeBandPowerTest : public TestCase
+{
+  public:
+    SpectrumWifiPhyCumulativeBandPowerTest();
+
+  private:
+    void DoRun() override;
+};
+
+SpectrumWifiPhyCumulativeBandPowerTest::SpectrumWifiPhyCumulativeBandPowerTest()
+    : TestCase("Check band power computed from the running sum of a PSD")
+{
+}
+
+void
+SpectrumWifiPhyCumulativeBandPowerTest::DoRun()
+{
+    const uint32_t centerFrequency = 5570; // MHz
+    const uint16_t channelWidth = 160;     // MHz
+    auto psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(centerFrequency,
+                                                                          channelWidth,
+                                                                          DbmToW(20),
+                                                                          channelWidth);
+    const auto cumulativePsd = WifiSpectrumValueHelper::GetCumulativePsd(psd);
+    NS_TEST_ASSERT_MSG_EQ(cumulativePsd.size(),
+                          psd->GetValuesN() + 1,
+                          "Unexpected size of the running sum of the PSD");
+
+    const uint32_t nBins = psd->GetValuesN();
+    for (uint32_t width : {1, 26, 242, 996, 2048})
+    {
+        for (uint32_t start = 0; start + width <= nBins; start += 97)
+        {
+            const WifiSpectrumBandIndices band{start, start + width - 1};
+            const auto expected = WifiSpectrumValueHelper::GetBandPowerW(psd, band);
+            const auto actual = WifiSpectrumValueHelper::GetBandPowerW(psd, cumulativePsd, band);
+            NS_TEST_ASSERT_MSG_EQ_TOL(actual,
+                                      expected,
+                                      expected * 1e-9,
+                                      "Unexpected power for band [" << band.first << ";"
+                                                                    << band.second << "]");
+        }
+    }
+    const WifiSpectrumBandIndices wholeBand{0, nBins - 1};
+    NS_TEST_ASSERT_MSG_EQ_TOL(WifiSpectrumValueHelper::GetBandPowerW(psd, cumulativePsd, wholeBand),
+                              DbmToW(20),
+                              DbmToW(20) * 1e-6,
+                              "Unexpected power for the whole PSD");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2027,6 +2087,7 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite()
                     SpectrumWifiPhyMultipleInterfacesTest::ChannelSwitchScenario::BETWEEN_TX_RX),
                 TestCase::Duration::QUICK);
     AddTestCase(new SpectrumWifiPhyInterfacesHelperTest, TestCase::Duration::QUICK);
+    AddTestCase(new SpectrumWifiPhyCumulativeBandPowerTest, TestCase::Duration::QUICK);
 }
 
 static SpectrumWifiPhyTestSuite spectrumWifiPhyTestSuite; ///< the test suite
@@ -1788,6 +1788,108 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief TX duration cache test
+ *
+ * Checks that the TX durations returned by WifiPhy::CalculateTxDuration for non-MU PPDUs
+ * are served from the cache once computed, that they match the sum of the preamble and
+ * payload durations, and that TX vectors differing in a single parameter are not mixed up.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("TX duration cache")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    WifiPhy::ClearTxDurationCache();
+
+    std::list<WifiTxVector> txVectors;
+    for (const auto& mode : {HePhy::GetHeMcs0(), HePhy::GetHeMcs7(), HePhy::GetHeMcs11()})
+    {
+        for (uint16_t width : {20, 80})
+        {
+            for (uint16_t gi : {800, 3200})
+            {
+                for (uint8_t nss : {1, 2})
+                {
+                    for (bool ldpc : {false, true})
+                    {
+                        // TX vectors only differing in the coding must not be mixed up
+                        txVectors.emplace_back(mode,
+                                               0,
+                                               WIFI_PREAMBLE_HE_SU,
+                                               gi,
+                                               nss,
+                                               nss,
+                                               0,
+                                               width,
+                                               false,
+                                               false,
+                                               ldpc);
+                    }
+                }
+            }
+        }
+    }
+    txVectors.emplace_back(VhtPhy::GetVhtMcs5(), 0, WIFI_PREAMBLE_VHT_SU, 400, 1, 1, 0, 40, false);
+    txVectors.emplace_back(OfdmPhy::GetOfdmRate6Mbps(),
+                           0,
+                           WIFI_PREAMBLE_LONG,
+                           800,
+                           1,
+                           1,
+                           0,
+                           20,
+                           false);
+    for (auto preamble : {WIFI_PREAMBLE_LONG, WIFI_PREAMBLE_SHORT})
+    {
+        txVectors.emplace_back(DsssPhy::GetDsssRate2Mbps(), 0, preamble, 800, 1, 1, 0, 22, false);
+    }
+
+    uint64_t nDurations = 0;
+    for (uint8_t pass = 0; pass < 2; ++pass)
+    {
+        for (const auto& txVector : txVectors)
+        {
+            auto band = (txVector.GetModulationClass() == WIFI_MOD_CLASS_DSSS)
+                            ? WIFI_PHY_BAND_2_4GHZ
+                            : WIFI_PHY_BAND_5GHZ;
+            for (uint32_t size : {14, 1536, 4000})
+            {
+                auto expected = WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector) +
+                                WifiPhy::GetPayloadDuration(size, txVector, band);
+                NS_TEST_EXPECT_MSG_EQ(WifiPhy::CalculateTxDuration(size, txVector, band),
+                                      expected,
+                                      "Unexpected TX duration for " << txVector << " and "
+                                                                    << size << " bytes");
+                nDurations += (pass == 0 ? 1 : 0);
+            }
+        }
+        auto stats = WifiPhy::GetTxDurationCacheStats();
+        NS_TEST_EXPECT_MSG_EQ(stats.misses, nDurations, "Durations computed more than once");
+        NS_TEST_EXPECT_MSG_EQ(stats.hits,
+                              pass * nDurations,
+                              "Durations not served by the cache");
+    }
+
+    WifiPhy::ClearTxDurationCache();
+    NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetTxDurationCacheStats().hits, 0, "Counters not reset");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1807,6 +1909,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::Duration::QUICK);
+
     // 20 MHz band, HeSigBDurationTest::OFDMA, even number of users per HE-SIG-B content channel
     AddTestCase(new HeSigBDurationTest(
                     {{{HeRu::RU_106_TONE, 1, true}, 11, 1}, {{HeRu::RU_106_TONE, 2, true}, 10, 4}},
@@ -25,17 +25,23 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/pointer.h"
 #include "ns3/table-based-error-rate-model.h"
+#include "ns3/tabulated-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
 #include "ns3/wifi-utils.h"
 #include "ns3/yans-error-rate-model.h"
 
+#include <bit>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("WifiErrorRateModelsTest");
@@ -1038,6 +1044,92 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Tabulated Error Rate Model Test Case
+ *
+ * Checks that the chunk success rates of the TabulatedErrorRateModel are within the
+ * configured error bound of the ones of the wrapped model, and that they are equal
+ * to them in exact mode and outside of the tabulated SNR range.
+ */
+class TabulatedErrorRateTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param testName the test name
+     * \param model the error rate model to tabulate
+     * \param mode the WifiMode to use for the test
+     */
+    TabulatedErrorRateTestCase(const std::string& testName,
+                               Ptr<ErrorRateModel> model,
+                               WifiMode mode);
+
+  private:
+    void DoRun() override;
+
+    Ptr<ErrorRateModel> m_model; ///< The error rate model to tabulate
+    WifiMode m_mode;             ///< The WifiMode to test
+};
+
+TabulatedErrorRateTestCase::TabulatedErrorRateTestCase(const std::string& testName,
+                                                       Ptr<ErrorRateModel> model,
+                                                       WifiMode mode)
+    : TestCase(testName),
+      m_model(model),
+      m_mode(mode)
+{
+}
+
+void
+TabulatedErrorRateTestCase::DoRun()
+{
+    double maxError = 1e-6;
+    Ptr<TabulatedErrorRateModel> tabulated = CreateObject<TabulatedErrorRateModel>();
+    tabulated->SetAttribute("ErrorRateModel", PointerValue(m_model));
+    tabulated->SetAttribute("MaxError", DoubleValue(maxError));
+    WifiTxVector txVector;
+    txVector.SetMode(m_mode);
+    txVector.SetChannelWidth(20);
+
+    for (uint64_t nbits : {1, 100, 1458 * 8, 65535 * 8})
+    {
+        // the error is bounded by the sum of the errors of the tabulated parts of the chunk
+        double tolerance = 2 * maxError * std::popcount(nbits);
+        for (double snr = -5; snr <= 40; snr += 0.37)
+        {
+            double expected =
+                m_model->GetChunkSuccessRate(m_mode, txVector, std::pow(10, snr / 10), nbits);
+            double csr =
+                tabulated->GetChunkSuccessRate(m_mode, txVector, std::pow(10, snr / 10), nbits);
+            NS_TEST_EXPECT_MSG_EQ_TOL(csr,
+                                      expected,
+                                      tolerance,
+                                      "Unexpected tabulated CSR at snr=" << snr
+                                                                         << "dB nbits=" << nbits);
+        }
+    }
+
+    // SNRs outside of the tables are computed by the wrapped model
+    double snr = std::pow(10, 70.0 / 10);
+    NS_TEST_EXPECT_MSG_EQ(tabulated->GetChunkSuccessRate(m_mode, txVector, snr, 1000),
+                          m_model->GetChunkSuccessRate(m_mode, txVector, snr, 1000),
+                          "Unexpected CSR outside of the tables");
+
+    // in exact mode, the chunk success rates are those of the wrapped model
+    tabulated->SetAttribute("Exact", BooleanValue(true));
+    for (double snr = -5; snr <= 40; snr += 1.13)
+    {
+        NS_TEST_EXPECT_MSG_EQ(
+            tabulated->GetChunkSuccessRate(m_mode, txVector, std::pow(10, snr / 10), 12000),
+            m_model->GetChunkSuccessRate(m_mode, txVector, std::pow(10, snr / 10), 12000),
+            "Unexpected CSR in exact mode at snr=" << snr << "dB");
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1105,6 +1197,18 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
                                                 HePhy::GetHeMcs11(),
                                                 1458),
                 TestCase::Duration::QUICK);
+    AddTestCase(new TabulatedErrorRateTestCase("TabulatedNistOfdm6Mbps",
+                                               CreateObject<NistErrorRateModel>(),
+                                               OfdmPhy::GetOfdmRate6Mbps()),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TabulatedErrorRateTestCase("TabulatedNistHeMcs7",
+                                               CreateObject<NistErrorRateModel>(),
+                                               HePhy::GetHeMcs7()),
+                TestCase::Duration::QUICK);
+    AddTestCase(new TabulatedErrorRateTestCase("TabulatedYansHeMcs11",
+                                               CreateObject<YansErrorRateModel>(),
+                                               HePhy::GetHeMcs11()),
+                TestCase::Duration::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
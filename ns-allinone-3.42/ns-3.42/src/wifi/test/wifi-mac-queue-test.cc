@@ -23,6 +23,7 @@
 #include "ns3/wifi-mac-queue.h"
 
 #include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -428,6 +429,114 @@ WifiExtractExpiredMpdusTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the reuse of the elements of the MAC queue container
+ *
+ * This test enqueues and dequeues MPDUs destined to several receivers into a
+ * WifiMacQueueContainer and verifies that the pool the container queue elements
+ * are allocated from does not grow beyond the peak number of queued MPDUs and that
+ * the size in bytes of the container queues is correctly tracked.
+ */
+class WifiMacQueueContainerPoolTest : public TestCase
+{
+  public:
+    WifiMacQueueContainerPoolTest();
+
+  private:
+    void DoRun() override;
+};
+
+WifiMacQueueContainerPoolTest::WifiMacQueueContainerPoolTest()
+    : TestCase("Test the reuse of the elements of the MAC queue container")
+{
+}
+
+void
+WifiMacQueueContainerPoolTest::DoRun()
+{
+    const std::size_t nReceivers = 8;
+    const std::size_t nMpdusPerReceiver = 10;
+    WifiMacQueueContainer container;
+
+    auto txAddr = Mac48Address::Allocate();
+    std::vector<Mac48Address> rxAddrs;
+    for (std::size_t i = 0; i < nReceivers; ++i)
+    {
+        rxAddrs.push_back(Mac48Address::Allocate());
+    }
+
+    uint16_t seqNo = 0;
+    std::size_t nBlocks = 0;
+
+    for (std::size_t round = 0; round < 20; ++round)
+    {
+        for (const auto& rxAddr : rxAddrs)
+        {
+            for (std::size_t i = 0; i < nMpdusPerReceiver; ++i)
+            {
+                WifiMacHeader header(WIFI_MAC_QOSDATA);
+                header.SetAddr1(rxAddr);
+                header.SetAddr2(txAddr);
+                header.SetQosTid(round % 8);
+                header.SetSequenceNumber(seqNo++);
+                auto mpdu = Create<WifiMpdu>(Create<Packet>(100), header);
+                auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+                auto elemIt = container.insert(container.GetQueue(queueId).cend(), mpdu);
+                elemIt->deleter = [](auto mpdu) {};
+            }
+        }
+
+        WifiMacHeader header(WIFI_MAC_QOSDATA);
+        header.SetAddr1(rxAddrs.front());
+        header.SetAddr2(txAddr);
+        header.SetQosTid(round % 8);
+        auto mpdu = Create<WifiMpdu>(Create<Packet>(100), header);
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        NS_TEST_EXPECT_MSG_EQ(container.GetNBytes(queueId),
+                              nMpdusPerReceiver * mpdu->GetSize(),
+                              "Unexpected size of the container queue");
+
+        if (round == 0)
+        {
+            nBlocks = container.GetPool().GetNBlocks();
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(nBlocks,
+                                        nReceivers * nMpdusPerReceiver,
+                                        "Too few blocks allocated by the pool");
+        }
+        NS_TEST_EXPECT_MSG_EQ(container.GetPool().GetNBlocks(),
+                              nBlocks,
+                              "The pool should not grow once the peak occupancy is reached");
+        NS_TEST_EXPECT_MSG_EQ(container.GetPool().GetNFreeBlocks(),
+                              nBlocks - nReceivers * nMpdusPerReceiver,
+                              "Unexpected number of free blocks in the pool");
+
+        // dequeue all the MPDUs
+        for (const auto& rxAddr : rxAddrs)
+        {
+            WifiContainerQueueId id{WIFI_QOSDATA_QUEUE,
+                                    WIFI_UNICAST,
+                                    rxAddr,
+                                    static_cast<uint8_t>(round % 8)};
+            while (!container.GetQueue(id).empty())
+            {
+                container.erase(container.GetQueue(id).cbegin());
+            }
+            NS_TEST_EXPECT_MSG_EQ(container.GetNBytes(id),
+                                  0,
+                                  "Unexpected size of the container queue");
+        }
+        NS_TEST_EXPECT_MSG_EQ(container.GetPool().GetNFreeBlocks(),
+                              nBlocks,
+                              "All the blocks should be back in the pool");
+    }
+
+    container.clear();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -445,6 +554,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiExtractExpiredMpdusTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiMacQueueContainerPoolTest, TestCase::Duration::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
@@ -0,0 +1,165 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/basic-energy-harvester.h"
+#include "ns3/basic-energy-source.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/wifi-radio-energy-model.h"
+
+#include <optional>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiRadioEnergyModelTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * WifiRadioEnergyModel recording the time it switches to the OFF state.
+ */
+class OffTimeWifiRadioEnergyModel : public WifiRadioEnergyModel
+{
+  public:
+    void ChangeState(int newState) override
+    {
+        WifiRadioEnergyModel::ChangeState(newState);
+        if (GetCurrentState() == WifiPhyState::OFF && !m_offTime)
+        {
+            m_offTime = Simulator::Now();
+        }
+    }
+
+    std::optional<Time> m_offTime; ///< the time the model switched to OFF, if it did
+};
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief WifiRadioEnergyModel LazyEnergyUpdate Test
+ *
+ * An idle radio drains a BasicEnergySource of 10 J, which reports its depletion
+ * at 10% of its initial energy. The radio must switch to OFF when the energy is
+ * exhausted, at the same time whether the switch is rescheduled at each change
+ * of the remaining energy or only once the source reports its depletion. With
+ * the LazyEnergyUpdate attribute set, a harvester then recharges the source after
+ * its depletion, which must cancel the pending switch to OFF.
+ */
+class WifiRadioEnergyModelLazyUpdateTest : public TestCase
+{
+  public:
+    WifiRadioEnergyModelLazyUpdateTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a simulation with an idle radio draining a basic energy source.
+     *
+     * \param lazy the value of the LazyEnergyUpdate attribute
+     * \param recharge whether the source is recharged after its depletion
+     * \return the time the radio switched to OFF, if it did
+     */
+    std::optional<Time> RunOne(bool lazy, bool recharge);
+};
+
+WifiRadioEnergyModelLazyUpdateTest::WifiRadioEnergyModelLazyUpdateTest()
+    : TestCase("Check the switch to OFF with the LazyEnergyUpdate attribute")
+{
+}
+
+std::optional<Time>
+WifiRadioEnergyModelLazyUpdateTest::RunOne(bool lazy, bool recharge)
+{
+    auto source = CreateObject<energy::BasicEnergySource>();
+    source->SetAttribute("BasicEnergySourceInitialEnergyJ", DoubleValue(10));
+    auto model = CreateObject<OffTimeWifiRadioEnergyModel>();
+    model->SetAttribute("LazyEnergyUpdate", BooleanValue(lazy));
+    model->SetEnergySource(source);
+    source->AppendDeviceEnergyModel(model);
+    source->Initialize();
+
+    // an idle radio consumes 0.273 A at 3 V, so the source is depleted at 11 s
+    // (periodic update) and the energy is exhausted at 12.21 s
+    if (recharge)
+    {
+        auto harvester = CreateObject<energy::BasicEnergyHarvester>();
+        harvester->SetHarvestDriven(true);
+        harvester->SetEnergySource(source);
+        source->ConnectEnergyHarvester(harvester);
+        // the source reports the recharge at its next periodic update (12 s)
+        Simulator::Schedule(Seconds(11.5),
+                            &energy::BasicEnergyHarvester::SetHarvestedPower,
+                            harvester,
+                            10.0);
+    }
+
+    Simulator::Stop(Seconds(15));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(model->GetCurrentState(),
+                          (recharge ? WifiPhyState::IDLE : WifiPhyState::OFF),
+                          "Unexpected state at the end of the simulation");
+    auto offTime = model->m_offTime;
+    Simulator::Destroy();
+    return offTime;
+}
+
+void
+WifiRadioEnergyModelLazyUpdateTest::DoRun()
+{
+    const auto eagerOffTime = RunOne(false, false);
+    NS_TEST_ASSERT_MSG_EQ(eagerOffTime.has_value(), true, "The radio did not switch to OFF");
+    NS_TEST_EXPECT_MSG_EQ_TOL(eagerOffTime->GetSeconds(),
+                              10 / (0.273 * 3),
+                              1e-6,
+                              "The radio did not switch to OFF when the energy was exhausted");
+
+    const auto lazyOffTime = RunOne(true, false);
+    NS_TEST_ASSERT_MSG_EQ(lazyOffTime.has_value(), true, "The lazy radio did not switch to OFF");
+    NS_TEST_EXPECT_MSG_EQ_TOL(*lazyOffTime,
+                              *eagerOffTime,
+                              NanoSeconds(1),
+                              "The lazy radio did not switch to OFF at the same time");
+
+    const auto rechargedOffTime = RunOne(true, true);
+    NS_TEST_EXPECT_MSG_EQ(rechargedOffTime.has_value(),
+                          false,
+                          "The recharge did not cancel the switch to OFF");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief WifiRadioEnergyModel Test Suite
+ */
+class WifiRadioEnergyModelTestSuite : public TestSuite
+{
+  public:
+    WifiRadioEnergyModelTestSuite();
+};
+
+WifiRadioEnergyModelTestSuite::WifiRadioEnergyModelTestSuite()
+    : TestSuite("wifi-radio-energy-model", Type::UNIT)
+{
+    AddTestCase(new WifiRadioEnergyModelLazyUpdateTest, TestCase::Duration::QUICK);
+}
+
+static WifiRadioEnergyModelTestSuite g_wifiRadioEnergyModelTestSuite; ///< the test suite
@@ -24,6 +24,7 @@
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -3806,6 +3807,150 @@ WifiMgtHeaderTest::DoRun()
     TestHeaderSerialization(frame);
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that YansWifiChannel delivers a PPDU only to the PHYs tuned
+ * to the channel of the sender, also after a PHY switched channel, and only to
+ * the PHYs within range of the sender if the MaxRange attribute is set.
+ */
+class YansWifiChannelReceiversTest : public TestCase
+{
+  public:
+    YansWifiChannelReceiversTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run one simulation where the first node broadcasts a packet before and
+     * after the last node switches to the channel of the other nodes.
+     *
+     * \param maxRange the MaxRange attribute of the channel
+     */
+    void RunOne(double maxRange);
+
+    /**
+     * Callback invoked when a PPDU arrives at a PHY.
+     *
+     * \param context the index of the node
+     * \param ppdu the PPDU
+     * \param rxPowerDbm the received power, in dBm
+     * \param duration the duration of the PPDU
+     */
+    void SignalArrival(std::string context,
+                       Ptr<const WifiPpdu> ppdu,
+                       double rxPowerDbm,
+                       Time duration);
+
+    std::vector<uint32_t> m_arrivals;                 //!< PPDU arrivals at each node
+    std::vector<std::vector<uint32_t>> m_perBroadcast; //!< m_arrivals after each broadcast
+};
+
+YansWifiChannelReceiversTest::YansWifiChannelReceiversTest()
+    : TestCase("Check the PHYs a YansWifiChannel delivers a PPDU to")
+{
+}
+
+void
+YansWifiChannelReceiversTest::SignalArrival(std::string context,
+                                            Ptr<const WifiPpdu> ppdu,
+                                            double rxPowerDbm,
+                                            Time duration)
+{
+    m_arrivals.at(std::stoi(context))++;
+}
+
+void
+YansWifiChannelReceiversTest::RunOne(double maxRange)
+{
+    m_arrivals.assign(4, 0);
+    m_perBroadcast.clear();
+
+    NodeContainer nodes;
+    nodes.Create(4);
+
+    Ptr<YansWifiChannel> channel = YansWifiChannelHelper::Default().Create();
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    phy.Set("ChannelSettings", StringValue("{36, 20, BAND_5GHZ, 0}"));
+    NetDeviceContainer devices =
+        wifi.Install(phy, mac, NodeContainer(nodes.Get(0), nodes.Get(1), nodes.Get(2)));
+    phy.Set("ChannelSettings", StringValue("{40, 20, BAND_5GHZ, 0}"));
+    devices.Add(wifi.Install(phy, mac, nodes.Get(3)));
+
+    // the last node is close to the sender, but on another channel
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(50.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(150.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(60.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    std::vector<Ptr<YansWifiPhy>> phys;
+    for (uint32_t i = 0; i < devices.GetN(); ++i)
+    {
+        phys.push_back(
+            DynamicCast<YansWifiPhy>(DynamicCast<WifiNetDevice>(devices.Get(i))->GetPhy()));
+        phys.back()->TraceConnect(
+            "SignalArrival",
+            std::to_string(i),
+            MakeCallback(&YansWifiChannelReceiversTest::SignalArrival, this));
+    }
+
+    Ptr<WifiNetDevice> sender = DynamicCast<WifiNetDevice>(devices.Get(0));
+    auto broadcast = [sender]() {
+        sender->Send(Create<Packet>(100), sender->GetBroadcast(), 1);
+    };
+    auto snapshot = [this]() { m_perBroadcast.push_back(m_arrivals); };
+    Simulator::Schedule(Seconds(1), broadcast);
+    Simulator::Schedule(Seconds(1.5), snapshot);
+    Simulator::Schedule(Seconds(2), [&phys]() {
+        phys[3]->SetOperatingChannel(WifiPhy::ChannelTuple{36, 20, WIFI_PHY_BAND_5GHZ, 0});
+    });
+    Simulator::Schedule(Seconds(3), broadcast);
+    Simulator::Schedule(Seconds(3.5), snapshot);
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+YansWifiChannelReceiversTest::DoRun()
+{
+    RunOne(0);
+    NS_TEST_ASSERT_MSG_EQ(m_perBroadcast.size(), 2, "Expected two broadcasts");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][0], 0, "The sender must not receive its PPDU");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][1], 1, "Node 1 is on the sender channel");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][2], 1, "Node 2 is on the sender channel");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][3], 0, "Node 3 is not on the sender channel yet");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[1][1], 2, "Node 1 is on the sender channel");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[1][2], 2, "Node 2 is on the sender channel");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[1][3], 1, "Node 3 switched to the sender channel");
+
+    RunOne(100);
+    NS_TEST_ASSERT_MSG_EQ(m_perBroadcast.size(), 2, "Expected two broadcasts");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][1], 1, "Node 1 is within range");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][2], 0, "Node 2 is out of range");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[0][3], 0, "Node 3 is not on the sender channel yet");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[1][1], 2, "Node 1 is within range");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[1][2], 0, "Node 2 is out of range");
+    NS_TEST_EXPECT_MSG_EQ(m_perBroadcast[1][3], 1, "Node 3 switched to the sender channel");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3839,6 +3984,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new IdealRateManagerMimoTest, TestCase::Duration::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelReceiversTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
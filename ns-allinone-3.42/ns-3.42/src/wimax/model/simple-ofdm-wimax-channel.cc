@@ -27,6 +27,7 @@
 #include "ns3/assert.h"
 #include "ns3/callback.h"
 #include "ns3/cost231-propagation-loss-model.h"
+#include "ns3/double.h"
 #include "ns3/event-id.h"
 #include "ns3/mobility-model.h"
 #include "ns3/net-device.h"
@@ -42,6 +43,7 @@ NS_LOG_COMPONENT_DEFINE("simpleOfdmWimaxChannel");
 // NS_OBJECT_ENSURE_REGISTERED (simpleOfdmWimaxChannel);
 
 SimpleOfdmWimaxChannel::SimpleOfdmWimaxChannel()
+    : m_maxRange(0)
 {
     m_loss = nullptr;
 }
@@ -58,11 +60,19 @@ SimpleOfdmWimaxChannel::GetTypeId()
     static TypeId tid = TypeId("ns3::SimpleOfdmWimaxChannel")
                             .SetParent<WimaxChannel>()
                             .SetGroupName("Wimax")
-                            .AddConstructor<SimpleOfdmWimaxChannel>();
+                            .AddConstructor<SimpleOfdmWimaxChannel>()
+                            .AddAttribute("MaxRange",
+                                          "Distance, in meters, beyond which the bursts are not "
+                                          "delivered to the receiving PHYs. Zero delivers them "
+                                          "to all the PHYs attached to the channel.",
+                                          DoubleValue(0),
+                                          MakeDoubleAccessor(&SimpleOfdmWimaxChannel::m_maxRange),
+                                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
 SimpleOfdmWimaxChannel::SimpleOfdmWimaxChannel(PropModel propModel)
+    : m_maxRange(0)
 {
     switch (propModel)
     {
@@ -165,9 +175,17 @@ SimpleOfdmWimaxChannel::Send(Time BlockTime,
         {
             double distance = 0;
             receiverMobility = (*iter)->GetDevice()->GetNode()->GetObject<MobilityModel>();
-            if (receiverMobility && senderMobility && m_loss)
+            if (receiverMobility && senderMobility && (m_loss || m_maxRange > 0))
             {
                 distance = senderMobility->GetDistanceFrom(receiverMobility);
+                if (m_maxRange > 0 && distance > m_maxRange)
+                {
+                    NS_LOG_LOGIC("Receiver out of range");
+                    continue;
+                }
+            }
+            if (receiverMobility && senderMobility && m_loss)
+            {
                 delay = Seconds(distance / 300000000.0);
                 rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
             }
@@ -132,6 +132,7 @@ class SimpleOfdmWimaxChannel : public WimaxChannel
      */
     Ptr<NetDevice> DoGetDevice(std::size_t i) const override;
     Ptr<PropagationLossModel> m_loss; ///< loss
+    double m_maxRange; ///< range beyond which bursts are not delivered, in m (0 to disable)
 };
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include "wimax-mac-header.h"
 #include "wimax-net-device.h"
 
+#include "ns3/abort.h"
 #include "ns3/double.h"
 #include "ns3/node.h"
 #include "ns3/packet-burst.h"
@@ -743,64 +744,20 @@ SimpleOfdmWimaxPhy::DoGetNrBytes(uint32_t symbols, WimaxPhy::ModulationType modu
 uint32_t
 SimpleOfdmWimaxPhy::GetFecBlockSize(WimaxPhy::ModulationType modulationType) const
 {
-    uint32_t blockSize = 0;
-    switch (modulationType)
-    {
-    case MODULATION_TYPE_BPSK_12:
-        blockSize = 12;
-        break;
-    case MODULATION_TYPE_QPSK_12:
-        blockSize = 24;
-        break;
-    case MODULATION_TYPE_QPSK_34:
-        blockSize = 36;
-        break;
-    case MODULATION_TYPE_QAM16_12:
-        blockSize = 48;
-        break;
-    case MODULATION_TYPE_QAM16_34:
-        blockSize = 72;
-        break;
-    case MODULATION_TYPE_QAM64_23:
-        blockSize = 96;
-        break;
-    case MODULATION_TYPE_QAM64_34:
-        blockSize = 108;
-        break;
-    default:
-        NS_FATAL_ERROR("Invalid modulation type");
-        break;
-    }
-    return blockSize * 8; // in bits
+    // Uncoded block size in bytes, indexed by modulation type
+    static constexpr uint32_t blockSizes[] = {12, 24, 36, 48, 72, 96, 108};
+    NS_ABORT_MSG_IF(modulationType > MODULATION_TYPE_QAM64_34, "Invalid modulation type");
+    return blockSizes[modulationType] * 8; // in bits
 }
 
 // Channel coding block size, Table 215, page 434
 uint32_t
 SimpleOfdmWimaxPhy::GetCodedFecBlockSize(WimaxPhy::ModulationType modulationType) const
 {
-    uint32_t blockSize = 0;
-    switch (modulationType)
-    {
-    case MODULATION_TYPE_BPSK_12:
-        blockSize = 24;
-        break;
-    case MODULATION_TYPE_QPSK_12:
-    case MODULATION_TYPE_QPSK_34:
-        blockSize = 48;
-        break;
-    case MODULATION_TYPE_QAM16_12:
-    case MODULATION_TYPE_QAM16_34:
-        blockSize = 96;
-        break;
-    case MODULATION_TYPE_QAM64_23:
-    case MODULATION_TYPE_QAM64_34:
-        blockSize = 144;
-        break;
-    default:
-        NS_FATAL_ERROR("Invalid modulation type");
-        break;
-    }
-    return blockSize * 8; // in bits
+    // Coded block size in bytes, indexed by modulation type
+    static constexpr uint32_t blockSizes[] = {24, 48, 48, 96, 96, 144, 144};
+    NS_ABORT_MSG_IF(modulationType > MODULATION_TYPE_QAM64_34, "Invalid modulation type");
+    return blockSizes[modulationType] * 8; // in bits
 }
 
 void
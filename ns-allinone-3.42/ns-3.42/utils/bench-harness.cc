@@ -0,0 +1,129 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "bench-harness.h"
+
+#include "ns3/abort.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace ns3
+{
+namespace bench
+{
+
+/// The results of all the benchmarks run so far
+static std::vector<BenchResult> g_results;
+
+void
+Record(BenchResult&& result)
+{
+    std::cerr << result.name << ": " << result.ops << " ops in " << result.wallMs << " ms"
+              << std::endl;
+    g_results.push_back(std::move(result));
+}
+
+/**
+ * Print a list of (name, value) pairs as a JSON object.
+ *
+ * \param os the output stream
+ * \param values the list of (name, value) pairs
+ */
+static void
+PrintJsonObject(std::ostream& os, const std::vector<std::pair<std::string, double>>& values)
+{
+    os << "{";
+    for (auto it = values.cbegin(); it != values.cend(); ++it)
+    {
+        os << (it == values.cbegin() ? "" : ", ") << "\"" << it->first << "\": " << it->second;
+    }
+    os << "}";
+}
+
+void
+PrintJson(std::ostream& os)
+{
+    os << "{\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < g_results.size(); ++i)
+    {
+        const auto& result = g_results[i];
+        const auto opsPerSec =
+            result.wallMs > 0 ? 1000.0 * result.ops / result.wallMs : static_cast<double>(0);
+        os << (i == 0 ? "" : ",") << "\n    {\"name\": \"" << result.name << "\", \"params\": ";
+        PrintJsonObject(os, result.params);
+        os << ", \"wall_ms\": " << result.wallMs << ", \"ops\": " << result.ops
+           << ", \"ops_per_s\": " << opsPerSec << ", \"metrics\": ";
+        PrintJsonObject(os, result.metrics);
+        os << "}";
+    }
+    os << "\n  ]\n}" << std::endl;
+}
+
+void
+WriteJson(const std::string& output)
+{
+    if (output.empty())
+    {
+        PrintJson(std::cout);
+    }
+    else
+    {
+        std::ofstream os(output);
+        NS_ABORT_MSG_IF(!os.is_open(), "Cannot open file " << output);
+        PrintJson(os);
+    }
+}
+
+std::vector<std::string>
+SplitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+double
+GetPeakRssMb()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1048576.0; // bytes
+#else
+        return usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+    }
+#endif
+    return 0;
+}
+
+} // namespace bench
+} // namespace ns3
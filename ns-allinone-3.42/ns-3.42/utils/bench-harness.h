@@ -0,0 +1,82 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+// The harness shared by the bench-* programs: it collects the outcome of
+// each benchmark and prints all of them in a common JSON format, so that
+// the results can be compared across revisions.
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+namespace bench
+{
+
+/// The outcome of a benchmark
+struct BenchResult
+{
+    std::string name;                                    //!< benchmark name
+    std::vector<std::pair<std::string, double>> params;  //!< benchmark parameters
+    int64_t wallMs{0};                                   //!< elapsed wall clock time (ms)
+    uint64_t ops{0};                                     //!< number of operations timed
+    std::vector<std::pair<std::string, double>> metrics; //!< additional metrics
+};
+
+/**
+ * Record the outcome of a benchmark and print a summary line on the standard error.
+ *
+ * \param result the outcome of the benchmark
+ */
+void Record(BenchResult&& result);
+
+/**
+ * Print the results of all the benchmarks recorded so far in JSON format.
+ *
+ * \param os the output stream
+ */
+void PrintJson(std::ostream& os);
+
+/**
+ * Print the results of all the benchmarks recorded so far in JSON format
+ * to the given file, or to the standard output if no file is given.
+ *
+ * \param output the name of the file, or an empty string
+ */
+void WriteJson(const std::string& output);
+
+/**
+ * Split a comma-separated list.
+ *
+ * \param list the comma-separated list
+ * \return the items of the list
+ */
+std::vector<std::string> SplitList(const std::string& list);
+
+/**
+ * \return the peak resident set size of the process (MB), or 0 if not available
+ */
+double GetPeakRssMb();
+
+} // namespace bench
+} // namespace ns3
+
+#endif /* BENCH_HARNESS_H */
@@ -0,0 +1,268 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the int64x64_t arithmetic and the Time
+// conversions built on it, for the int64x64_t implementation selected at
+// configuration time (./ns3 configure -- -DNS3_INT64X64=INT128|CAIRO|DOUBLE).
+// Sample usage:  ./ns3 run 'bench-int64x64 --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/core-config.h"
+#include "ns3/int64x64.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace ns3;
+
+/** The operands of the benchmarks. */
+struct Operands
+{
+    std::vector<double> doubles;       //!< Doubles, between 0 and 1000.
+    std::vector<int64x64_t> fractions; //!< int64x64_t with a fractional part.
+    std::vector<int64x64_t> integers;  //!< int64x64_t with an integer value.
+    std::vector<Time> times;           //!< Times, between 0 and 1000 s.
+};
+
+/** Sink of the results, so the compiler does not optimize them away. */
+static double g_sink = 0;
+
+/**
+ * Multiply int64x64_t values with a fractional part.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchMul(const Operands& ops, uint32_t n)
+{
+    int64x64_t sum;
+    std::size_t size = ops.fractions.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += ops.fractions[i % size] * ops.fractions[(i + 1) % size];
+    }
+    g_sink += sum.GetDouble();
+}
+
+/**
+ * Divide int64x64_t values by values with a fractional part.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchDiv(const Operands& ops, uint32_t n)
+{
+    int64x64_t sum;
+    std::size_t size = ops.fractions.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += ops.fractions[i % size] / ops.fractions[(i + 1) % size];
+    }
+    g_sink += sum.GetDouble();
+}
+
+/**
+ * Divide int64x64_t values by integer values.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchDivInteger(const Operands& ops, uint32_t n)
+{
+    int64x64_t sum;
+    std::size_t size = ops.fractions.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += ops.fractions[i % size] / ops.integers[(i + 1) % size];
+    }
+    g_sink += sum.GetDouble();
+}
+
+/**
+ * Convert doubles to int64x64_t and back.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchDouble(const Operands& ops, uint32_t n)
+{
+    double sum = 0;
+    std::size_t size = ops.doubles.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += int64x64_t(ops.doubles[i % size]).GetDouble();
+    }
+    g_sink += sum;
+}
+
+/**
+ * Convert Times to seconds, with Time::GetSeconds().
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchGetSeconds(const Operands& ops, uint32_t n)
+{
+    double sum = 0;
+    std::size_t size = ops.times.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += ops.times[i % size].GetSeconds();
+    }
+    g_sink += sum;
+}
+
+/**
+ * Convert seconds to Times, with Seconds(double).
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchSeconds(const Operands& ops, uint32_t n)
+{
+    int64_t sum = 0;
+    std::size_t size = ops.doubles.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += Seconds(ops.doubles[i % size]).GetTimeStep();
+    }
+    g_sink += sum;
+}
+
+/**
+ * Divide Times, as in the ratios of durations.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchTimeRatio(const Operands& ops, uint32_t n)
+{
+    int64x64_t sum;
+    std::size_t size = ops.times.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += ops.times[i % size] / ops.times[(i + 1) % size];
+    }
+    g_sink += sum.GetDouble();
+}
+
+/**
+ * Scale Times by doubles.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ */
+static void
+benchTimeScale(const Operands& ops, uint32_t n)
+{
+    int64_t sum = 0;
+    std::size_t size = ops.times.size();
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        sum += (ops.times[i % size] * ops.doubles[(i + 1) % size]).GetTimeStep();
+    }
+    g_sink += sum;
+}
+
+/**
+ * Run a benchmark, and print the best time per operation.
+ * \param [in] bench The benchmark.
+ * \param [in] ops The operands.
+ * \param [in] n The number of operations.
+ * \param [in] runs The number of runs to take the best of.
+ * \param [in] name The name of the benchmark.
+ */
+static void
+runBench(void (*bench)(const Operands&, uint32_t),
+         const Operands& ops,
+         uint32_t n,
+         uint32_t runs,
+         const char* name)
+{
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < runs; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        (*bench)(ops, n);
+        minDelay = std::min(minDelay, time.End());
+    }
+    std::cout << std::setw(10) << std::fixed << std::setprecision(2) << minDelay * 1e6 / n
+              << " ns/op\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t runs = 5;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the int64x64_t arithmetic and the Time conversions.");
+    cmd.AddValue("n", "number of operations per run", n);
+    cmd.AddValue("runs", "number of runs to take the best of", runs);
+    cmd.Parse(argc, argv);
+
+#if defined(INT64X64_USE_128)
+    const char* backend = "int128";
+#elif defined(INT64X64_USE_CAIRO)
+    const char* backend = "cairo";
+#else
+    const char* backend = "double";
+#endif
+    std::cout << "Running bench-int64x64 with n=" << n << ", int64x64_t implementation "
+              << backend << std::endl;
+
+    // Until the simulation runs, each Time is recorded in case the resolution
+    // changes, which would dominate the timings: stop it as Run() does.
+    Simulator::Run();
+
+    // Few enough operands to stay in the cache
+    const std::size_t size = 1024;
+    Operands ops;
+    std::mt19937_64 generator(1);
+    std::uniform_real_distribution<double> uniform(0.001, 1000);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        double value = uniform(generator);
+        ops.doubles.push_back(value);
+        ops.fractions.emplace_back(value);
+        ops.integers.emplace_back(static_cast<int64_t>(value) + 1);
+        ops.times.push_back(Seconds(uniform(generator)));
+    }
+
+    runBench(&benchMul, ops, n, runs, "int64x64_t * int64x64_t");
+    runBench(&benchDiv, ops, n, runs, "int64x64_t / int64x64_t");
+    runBench(&benchDivInteger, ops, n, runs, "int64x64_t / integer int64x64_t");
+    runBench(&benchDouble, ops, n, runs, "double to int64x64_t to double");
+    runBench(&benchGetSeconds, ops, n, runs, "Time::GetSeconds()");
+    runBench(&benchSeconds, ops, n, runs, "Seconds(double)");
+    runBench(&benchTimeRatio, ops, n, runs, "Time / Time");
+    runBench(&benchTimeScale, ops, n, runs, "Time * double");
+
+    // Keep the results alive
+    if (g_sink == 42)
+    {
+        std::cout << std::endl;
+    }
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,390 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark how the LoRaWAN learning policies scale with the number
+// of end devices. For each policy (UCB1-Tuned, QoC-A, DQoC-A and ToW by default), each number of
+// devices and each percentage of mobile devices, the devices send periodic uplinks to a gateway
+// at the center of a square area. Each uplink selects a (channel, spreading factor) arm with the
+// policy, computes the received power with a log-distance path loss, the time on air with the
+// LoraAirtimeTable and the collisions with the other uplinks of the same channel and spreading
+// factor, then updates the policy with the outcome. Mobile devices follow a random walk.
+//
+// Results are printed in JSON format, so that they can be compared across revisions to catch
+// performance regressions, or used to size cluster allocations. Each run reports the wall clock
+// time spent in Simulator::Run(), the number of events executed, the wall clock cost per uplink,
+// and how the wall clock time splits between the policy (selection and update), the PHY (path
+// loss, airtime and collisions), the mobility (position queries) and the rest (the simulator
+// itself and the random walk events). The split is measured with a steady clock around each
+// part of every uplink. The runs also report the packet delivery ratio, as a sanity check, the
+// memory used per device and the peak resident set size of the process. The peak RSS is a
+// process-wide high-water mark, hence the device counts are run in increasing order and the
+// peak RSS of a run is only meaningful if it is larger than the one of the previous run.
+// Sample usage:  ./ns3 run 'bench-lorawan --devices=100,10000 --mobile=0,50'
+
+#include "bench-harness.h"
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/lora-airtime.h"
+#include "ns3/lora-link-budget.h"
+#include "ns3/qoca-policy.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/random-walk-2d-mobility-model.h"
+#include "ns3/rectangle.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tow-policy.h"
+#include "ns3/ucb1-tuned-policy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace ns3;
+
+/**
+ * \return the current resident set size of the process (MB), or 0 if not available
+ */
+static double
+GetCurrentRssMb()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (statm >> size >> resident)
+    {
+        return resident * sysconf(_SC_PAGESIZE) / 1048576.0;
+    }
+#endif
+    return 0;
+}
+
+/// Number of channels the policies choose from
+static constexpr uint32_t N_CHANNELS = 8;
+/// Number of spreading factors the policies choose from (SF7 to SF12)
+static constexpr uint32_t N_SF = 6;
+/// Transmission power of the devices (dBm)
+static constexpr double TX_POWER = 14;
+
+/**
+ * Create a policy.
+ *
+ * \param algorithm the name of the algorithm
+ * \return the policy
+ */
+static Ptr<lorawan::BanditPolicy>
+CreatePolicy(const std::string& algorithm)
+{
+    if (algorithm == "UCB1-Tuned")
+    {
+        return CreateObject<lorawan::Ucb1TunedPolicy>();
+    }
+    if (algorithm == "QoC-A")
+    {
+        return CreateObject<lorawan::QocaPolicy>();
+    }
+    if (algorithm == "DQoC-A")
+    {
+        auto policy = CreateObject<lorawan::QocaPolicy>();
+        policy->SetLambda(0.98);
+        policy->SetLambdaG(0.90);
+        return policy;
+    }
+    if (algorithm == "ToW")
+    {
+        return CreateObject<lorawan::TowPolicy>();
+    }
+    NS_ABORT_MSG("Unknown algorithm " << algorithm);
+    return nullptr;
+}
+
+/// The devices and the gateway of a run, and where the wall clock time of the uplinks goes
+class LorawanBench
+{
+  public:
+    /**
+     * Create the devices.
+     *
+     * \param algorithm the name of the policy
+     * \param nDevices the number of devices
+     * \param mobilePercent the percentage of mobile devices
+     * \param side the side of the area (m)
+     * \param interval the time between two uplinks of a device
+     * \param payload the size of the uplinks (bytes)
+     */
+    LorawanBench(const std::string& algorithm,
+                 uint32_t nDevices,
+                 double mobilePercent,
+                 double side,
+                 Time interval,
+                 uint32_t payload);
+
+    /**
+     * Send an uplink from a device, and schedule its next uplink.
+     *
+     * \param device the device
+     */
+    void Uplink(uint32_t device);
+
+    /// Clock measuring the parts of the uplinks
+    using Clock = std::chrono::steady_clock;
+
+    Clock::duration m_policyTime{0};   //!< time spent in the policy
+    Clock::duration m_phyTime{0};      //!< time spent in the PHY
+    Clock::duration m_mobilityTime{0}; //!< time spent in the position queries
+    uint64_t m_uplinks{0};             //!< number of uplinks
+    uint64_t m_received{0};            //!< number of uplinks received by the gateway
+
+  private:
+    Ptr<lorawan::BanditPolicy> m_policy;        //!< the policy of all the devices
+    Ptr<lorawan::LoraLinkBudget> m_linkBudget;  //!< path loss and sensitivities
+    std::vector<double> m_sensitivities;        //!< gateway sensitivity, per SF (dBm)
+    std::vector<Ptr<MobilityModel>> m_mobility; //!< the mobility model of each device
+    Vector m_gateway;                           //!< the position of the gateway
+    Time m_interval;                            //!< time between two uplinks of a device
+    std::vector<Time> m_airtimes;               //!< time on air of the uplinks, per SF
+    std::vector<Time> m_busyUntil;              //!< end of the last uplink, per channel and SF
+};
+
+LorawanBench::LorawanBench(const std::string& algorithm,
+                           uint32_t nDevices,
+                           double mobilePercent,
+                           double side,
+                           Time interval,
+                           uint32_t payload)
+    : m_policy(CreatePolicy(algorithm)),
+      m_linkBudget(CreateObject<lorawan::LoraLinkBudget>()),
+      m_gateway(side / 2, side / 2, 15),
+      m_interval(interval),
+      m_busyUntil(N_CHANNELS * N_SF)
+{
+    m_policy->SetDimensions(nDevices, N_CHANNELS * N_SF);
+    for (uint32_t sf = 0; sf < N_SF; ++sf)
+    {
+        m_airtimes.push_back(
+            Seconds(lorawan::LoraAirtimeTable::GetTimeOnAir(sf + 7, 125000, 1, payload)));
+        m_sensitivities.push_back(lorawan::LoraLinkBudget::GetSensitivity(sf + 7, 125000));
+    }
+
+    auto coordinate = CreateObject<UniformRandomVariable>();
+    coordinate->SetAttribute("Max", DoubleValue(side));
+    auto start = CreateObject<UniformRandomVariable>();
+    start->SetAttribute("Max", DoubleValue(interval.GetSeconds()));
+    const auto nMobile = static_cast<uint32_t>(std::lround(nDevices * mobilePercent / 100));
+    for (uint32_t device = 0; device < nDevices; ++device)
+    {
+        Ptr<MobilityModel> mobility;
+        if (device < nMobile)
+        {
+            // pedestrians to vehicles in town, up to 60 km/h, changing direction every 10 s
+            mobility = CreateObject<RandomWalk2dMobilityModel>();
+            mobility->SetAttribute("Bounds", RectangleValue(Rectangle(0, side, 0, side)));
+            mobility->SetAttribute("Mode", StringValue("Time"));
+            mobility->SetAttribute("Time", TimeValue(Seconds(10)));
+            mobility->SetAttribute("Speed",
+                                   StringValue("ns3::UniformRandomVariable[Min=1.0|Max=16.7]"));
+        }
+        else
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        mobility->SetPosition(Vector(coordinate->GetValue(), coordinate->GetValue(), 1.5));
+        mobility->Initialize();
+        m_mobility.push_back(mobility);
+        Simulator::Schedule(Seconds(start->GetValue()), &LorawanBench::Uplink, this, device);
+    }
+}
+
+void
+LorawanBench::Uplink(uint32_t device)
+{
+    const auto t0 = Clock::now();
+    const auto arm = m_policy->SelectArm(device);
+    const auto t1 = Clock::now();
+    const auto distance = CalculateDistance(m_mobility[device]->GetPosition(), m_gateway);
+    const auto t2 = Clock::now();
+
+    const auto channel = arm / N_SF;
+    const auto sf = arm % N_SF;
+    const auto rxPower = m_linkBudget->GetRxPower(TX_POWER, distance);
+    const auto now = Simulator::Now();
+    auto& busyUntil = m_busyUntil[channel * N_SF + sf];
+    const bool collision = busyUntil > now;
+    busyUntil = std::max(busyUntil, now + m_airtimes[sf]);
+    const bool received = !collision && rxPower >= m_sensitivities[sf];
+    const auto quality = std::clamp((rxPower - m_sensitivities[sf]) / 30, 0.0, 1.0);
+    const auto t3 = Clock::now();
+
+    m_policy->Update(device, arm, received ? 1.0 : 0.0, quality);
+    const auto t4 = Clock::now();
+
+    m_policyTime += (t1 - t0) + (t4 - t3);
+    m_mobilityTime += t2 - t1;
+    m_phyTime += t3 - t2;
+    ++m_uplinks;
+    m_received += received;
+    Simulator::Schedule(m_interval, &LorawanBench::Uplink, this, device);
+}
+
+/**
+ * Convert a duration to milliseconds.
+ *
+ * \param duration the duration
+ * \return the duration (ms)
+ */
+static double
+ToMs(LorawanBench::Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/**
+ * Measure the time it takes to simulate the given number of devices using a policy.
+ *
+ * \param algorithm the name of the policy
+ * \param nDevices the number of devices
+ * \param mobilePercent the percentage of mobile devices
+ * \param side the side of the area (m)
+ * \param interval the time between two uplinks of a device
+ * \param payload the size of the uplinks (bytes)
+ * \param simTime the simulated time
+ */
+static void
+BenchLorawan(const std::string& algorithm,
+             uint32_t nDevices,
+             double mobilePercent,
+             double side,
+             Time interval,
+             uint32_t payload,
+             Time simTime)
+{
+    const auto rssBefore = GetCurrentRssMb();
+    SystemWallClockMs setupTimer;
+    setupTimer.Start();
+    LorawanBench bench(algorithm, nDevices, mobilePercent, side, interval, payload);
+    const auto setupMs = setupTimer.End();
+    const auto rssAfter = GetCurrentRssMb();
+
+    Simulator::Stop(simTime);
+    const auto eventsBefore = Simulator::GetEventCount();
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    const auto wallMs = timer.End();
+
+    const auto events = Simulator::GetEventCount() - eventsBefore;
+    const auto policyMs = ToMs(bench.m_policyTime);
+    const auto phyMs = ToMs(bench.m_phyTime);
+    const auto mobilityMs = ToMs(bench.m_mobilityTime);
+    const auto uplinks = bench.m_uplinks;
+    bench::Record({algorithm,
+            {{"devices", nDevices},
+             {"mobile_percent", mobilePercent},
+             {"side_m", side},
+             {"interval_s", interval.GetSeconds()},
+             {"payload_bytes", payload},
+             {"sim_s", simTime.GetSeconds()}},
+            wallMs,
+            uplinks,
+            {{"setup_ms", static_cast<double>(setupMs)},
+             {"events", static_cast<double>(events)},
+             {"ns_per_uplink", uplinks > 0 ? 1e6 * wallMs / uplinks : 0},
+             {"policy_ms", policyMs},
+             {"phy_ms", phyMs},
+             {"mobility_ms", mobilityMs},
+             {"other_ms", std::max(wallMs - policyMs - phyMs - mobilityMs, 0.0)},
+             {"pdr", uplinks > 0 ? static_cast<double>(bench.m_received) / uplinks : 0},
+             {"bytes_per_device", (rssAfter - rssBefore) * 1048576.0 / nDevices},
+             {"peak_rss_mb", bench::GetPeakRssMb()}}});
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string devices = "100,1000,5000,10000";
+    std::string algorithms = "UCB1-Tuned,QoC-A,DQoC-A,ToW";
+    std::string mobile = "0,50";
+    double side = 2000;
+    Time interval = Seconds(60);
+    uint32_t payload = 20;
+    Time simTime = Seconds(3600);
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("devices", "comma-separated list of the numbers of devices", devices);
+    cmd.AddValue("algorithms",
+                 "comma-separated list of the policies (UCB1-Tuned, QoC-A, DQoC-A, ToW)",
+                 algorithms);
+    cmd.AddValue("mobile", "comma-separated list of the percentages of mobile devices", mobile);
+    cmd.AddValue("side", "side of the square area (m)", side);
+    cmd.AddValue("interval", "time between two uplinks of a device", interval);
+    cmd.AddValue("payload", "size of the uplinks (bytes)", payload);
+    cmd.AddValue("simTime", "simulated time of each run", simTime);
+    cmd.AddValue("output", "file to write the JSON results to (default: stdout)", output);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> deviceCounts;
+    for (const auto& item : bench::SplitList(devices))
+    {
+        const auto nDevices = std::stoul(item);
+        NS_ABORT_MSG_IF(nDevices == 0, "The number of devices must be positive");
+        deviceCounts.push_back(nDevices);
+    }
+    // the peak RSS is a high-water mark, hence smaller runs must come first
+    std::sort(deviceCounts.begin(), deviceCounts.end());
+    NS_ABORT_MSG_IF(interval.IsZero(), "The uplink interval must be positive");
+    NS_ABORT_MSG_IF(payload > lorawan::LoraAirtimeTable::MAX_PAYLOAD,
+                    "The payload must be at most " << lorawan::LoraAirtimeTable::MAX_PAYLOAD
+                                                   << " bytes");
+
+    for (const auto nDevices : deviceCounts)
+    {
+        for (const auto& algorithm : bench::SplitList(algorithms))
+        {
+            for (const auto& item : bench::SplitList(mobile))
+            {
+                RngSeedManager::SetSeed(1);
+                RngSeedManager::SetRun(1);
+                BenchLorawan(algorithm,
+                             nDevices,
+                             std::stod(item),
+                             side,
+                             interval,
+                             payload,
+                             simTime);
+            }
+        }
+    }
+
+    bench::WriteJson(output);
+
+    return 0;
+}
@@ -0,0 +1,386 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the overhead of the mobility models, separately from
+// any PHY. For each mobility model and each number of nodes, the nodes move in a square area
+// and the positions of all of them are queried at a fixed interval, as a channel would do when
+// every node transmits once per interval. When buildings are requested, a grid of buildings
+// covers the area and each query also asks the MobilityBuildingInfo of the node whether it is
+// indoor, as the building-aware propagation loss models do.
+//
+// Results are printed in JSON format, so that they can be compared across revisions to catch
+// performance regressions. Each run reports the wall clock time spent in Simulator::Run(), the
+// number of position queries, the wall clock cost per query, the number of events and of
+// course changes per simulated second, the memory used per node and the peak resident set
+// size of the process. The memory per node is the growth of the resident set size during the
+// setup of the run, which underestimates it when the memory freed by the previous runs is
+// reused. The peak RSS is a process-wide high-water mark, hence the node counts are run in
+// increasing order and the peak RSS of a run is only meaningful if it is larger than the one of
+// the previous run.
+// Sample usage:  ./ns3 run 'bench-mobility --nodes=1000,100000 --buildings=0,100'
+
+#include "bench-harness.h"
+
+#include "ns3/abort.h"
+#include "ns3/box.h"
+#include "ns3/building.h"
+#include "ns3/buildings-helper.h"
+#include "ns3/command-line.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/mobility-building-info.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/pointer.h"
+#include "ns3/position-allocator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rectangle.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/waypoint-mobility-model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+using namespace ns3;
+
+/**
+ * \return the current resident set size of the process (MB), or 0 if not available
+ */
+static double
+GetCurrentRssMb()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (statm >> size >> resident)
+    {
+        return resident * sysconf(_SC_PAGESIZE) / 1048576.0;
+    }
+#endif
+    return 0;
+}
+
+/// Number of course changes notified during the current run
+static uint64_t g_courseChanges = 0;
+
+/**
+ * Count the course changes of a mobility model.
+ *
+ * \param model the mobility model
+ */
+static void
+CourseChange(Ptr<const MobilityModel> /* model */)
+{
+    ++g_courseChanges;
+}
+
+/// Number of position queries made during the current run
+static uint64_t g_queries = 0;
+/// Number of indoor nodes found by the queries of the current run
+static uint64_t g_indoor = 0;
+
+/**
+ * Query the position of all the nodes, as a channel would, and schedule the next queries.
+ *
+ * \param mobility the mobility models of the nodes
+ * \param buildingInfo the building information of the nodes, empty without buildings
+ * \param interval the time between two rounds of queries
+ */
+static void
+QueryPositions(const std::vector<Ptr<MobilityModel>>* mobility,
+               const std::vector<Ptr<MobilityBuildingInfo>>* buildingInfo,
+               Time interval)
+{
+    double sum = 0;
+    for (const auto& model : *mobility)
+    {
+        sum += model->GetPosition().x;
+    }
+    for (const auto& info : *buildingInfo)
+    {
+        g_indoor += info->IsIndoor();
+    }
+    g_queries += mobility->size();
+    // keep the queries from being optimized away
+    NS_ABORT_MSG_IF(std::isnan(sum), "Invalid position");
+    Simulator::Schedule(interval, &QueryPositions, mobility, buildingInfo, interval);
+}
+
+/**
+ * Create a grid of buildings covering half of a square area.
+ *
+ * \param nBuildings the number of buildings
+ * \param side the side of the area (m)
+ */
+static void
+CreateBuildings(uint32_t nBuildings, double side)
+{
+    const auto perRow = static_cast<uint32_t>(std::ceil(std::sqrt(nBuildings)));
+    const auto cell = side / perRow;
+    // each building covers half of the area of its cell, so that about half of the nodes are
+    // indoor
+    const auto size = cell / std::sqrt(2.0);
+    for (uint32_t i = 0; i < nBuildings; ++i)
+    {
+        const auto x = (i % perRow) * cell;
+        const auto y = (i / perRow) * cell;
+        auto building = CreateObject<Building>();
+        building->SetBoundaries(Box(x, x + size, y, y + size, 0, 30));
+        building->SetNFloors(10);
+        building->SetNRoomsX(4);
+        building->SetNRoomsY(4);
+    }
+}
+
+/**
+ * Install a mobility model on all the nodes.
+ *
+ * \param model the name of the model, without the MobilityModel suffix
+ * \param nodes the nodes
+ * \param side the side of the area (m)
+ * \param simTime the simulated time
+ */
+static void
+InstallMobility(const std::string& model, NodeContainer& nodes, double side, Time simTime)
+{
+    const auto sideValue = std::to_string(side);
+    const auto uniform = "ns3::UniformRandomVariable[Min=0.0|Max=" + sideValue + "]";
+    auto positions = CreateObject<RandomRectanglePositionAllocator>();
+    positions->SetAttribute("X", StringValue(uniform));
+    positions->SetAttribute("Y", StringValue(uniform));
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator(positions);
+    if (model == "ConstantVelocity" || model == "Waypoint")
+    {
+        mobility.SetMobilityModel("ns3::" + model + "MobilityModel");
+    }
+    else if (model == "RandomWalk2d")
+    {
+        mobility.SetMobilityModel("ns3::RandomWalk2dMobilityModel",
+                                  "Bounds",
+                                  RectangleValue(Rectangle(0, side, 0, side)),
+                                  "Speed",
+                                  StringValue("ns3::UniformRandomVariable[Min=1.0|Max=20.0]"));
+    }
+    else if (model == "RandomWaypoint")
+    {
+        mobility.SetMobilityModel("ns3::RandomWaypointMobilityModel",
+                                  "Speed",
+                                  StringValue("ns3::UniformRandomVariable[Min=1.0|Max=20.0]"),
+                                  "Pause",
+                                  StringValue("ns3::ConstantRandomVariable[Constant=2.0]"),
+                                  "PositionAllocator",
+                                  PointerValue(positions));
+    }
+    else if (model == "SteadyStateRandomWaypoint")
+    {
+        mobility.SetMobilityModel("ns3::SteadyStateRandomWaypointMobilityModel",
+                                  "MinSpeed",
+                                  DoubleValue(1.0),
+                                  "MaxSpeed",
+                                  DoubleValue(20.0),
+                                  "MaxX",
+                                  DoubleValue(side),
+                                  "MaxY",
+                                  DoubleValue(side));
+    }
+    else if (model == "GaussMarkov")
+    {
+        mobility.SetMobilityModel("ns3::GaussMarkovMobilityModel",
+                                  "Bounds",
+                                  BoxValue(Box(0, side, 0, side, 0, 30)));
+    }
+    else
+    {
+        NS_ABORT_MSG("Unknown mobility model " << model);
+    }
+    mobility.Install(nodes);
+
+    auto speed = CreateObject<UniformRandomVariable>();
+    speed->SetAttribute("Min", DoubleValue(-10.0));
+    speed->SetAttribute("Max", DoubleValue(10.0));
+    if (model == "ConstantVelocity")
+    {
+        for (auto it = nodes.Begin(); it != nodes.End(); ++it)
+        {
+            auto cv = (*it)->GetObject<ConstantVelocityMobilityModel>();
+            cv->SetVelocity(Vector(speed->GetValue(), speed->GetValue(), 0));
+        }
+    }
+    else if (model == "Waypoint")
+    {
+        // one waypoint every 10 s, for the whole run
+        auto coordinate = CreateObject<UniformRandomVariable>();
+        coordinate->SetAttribute("Max", DoubleValue(side));
+        for (auto it = nodes.Begin(); it != nodes.End(); ++it)
+        {
+            auto waypoints = (*it)->GetObject<WaypointMobilityModel>();
+            for (Time t; t <= simTime; t += Seconds(10))
+            {
+                waypoints->AddWaypoint(
+                    Waypoint(t, Vector(coordinate->GetValue(), coordinate->GetValue(), 0)));
+            }
+        }
+    }
+}
+
+/**
+ * Measure the time it takes to simulate the given number of nodes moving according to a
+ * mobility model, with their positions queried at a fixed interval.
+ *
+ * \param model the name of the model, without the MobilityModel suffix
+ * \param nNodes the number of nodes
+ * \param nBuildings the number of buildings, 0 for none
+ * \param side the side of the area (m)
+ * \param interval the time between two rounds of queries
+ * \param simTime the simulated time
+ */
+static void
+BenchMobility(const std::string& model,
+              uint32_t nNodes,
+              uint32_t nBuildings,
+              double side,
+              Time interval,
+              Time simTime)
+{
+    const auto rssBefore = GetCurrentRssMb();
+    SystemWallClockMs setupTimer;
+    setupTimer.Start();
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    InstallMobility(model, nodes, side, simTime);
+    if (nBuildings > 0)
+    {
+        CreateBuildings(nBuildings, side);
+        BuildingsHelper::Install(nodes);
+    }
+
+    std::vector<Ptr<MobilityModel>> mobility;
+    std::vector<Ptr<MobilityBuildingInfo>> buildingInfo;
+    for (auto it = nodes.Begin(); it != nodes.End(); ++it)
+    {
+        auto mm = (*it)->GetObject<MobilityModel>();
+        mm->TraceConnectWithoutContext("CourseChange", MakeCallback(&CourseChange));
+        mobility.push_back(mm);
+        if (nBuildings > 0)
+        {
+            buildingInfo.push_back(mm->GetObject<MobilityBuildingInfo>());
+        }
+    }
+    Simulator::Schedule(interval, &QueryPositions, &mobility, &buildingInfo, interval);
+    const auto setupMs = setupTimer.End();
+    const auto rssAfter = GetCurrentRssMb();
+
+    g_courseChanges = 0;
+    g_queries = 0;
+    g_indoor = 0;
+    Simulator::Stop(simTime);
+    const auto eventsBefore = Simulator::GetEventCount();
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    const auto wallMs = timer.End();
+
+    const auto events = Simulator::GetEventCount() - eventsBefore;
+    const auto simS = simTime.GetSeconds();
+    bench::Record({model + (nBuildings > 0 ? "-buildings" : ""),
+            {{"nodes", nNodes},
+             {"buildings", nBuildings},
+             {"side_m", side},
+             {"interval_s", interval.GetSeconds()},
+             {"sim_s", simS}},
+            wallMs,
+            g_queries,
+            {{"setup_ms", static_cast<double>(setupMs)},
+             {"ns_per_query", g_queries > 0 ? 1e6 * wallMs / g_queries : 0},
+             {"events_per_s", events / simS},
+             {"course_changes_per_s", g_courseChanges / simS},
+             {"indoor_ratio", g_queries > 0 ? static_cast<double>(g_indoor) / g_queries : 0},
+             {"bytes_per_node", (rssAfter - rssBefore) * 1048576.0 / nNodes},
+             {"peak_rss_mb", bench::GetPeakRssMb()}}});
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string nodes = "1000,10000,100000";
+    std::string models =
+        "ConstantVelocity,RandomWalk2d,RandomWaypoint,SteadyStateRandomWaypoint,GaussMarkov,"
+        "Waypoint";
+    std::string buildings = "0,100";
+    double side = 1000;
+    Time interval = Seconds(1);
+    Time simTime = Seconds(60);
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nodes", "comma-separated list of the numbers of nodes", nodes);
+    cmd.AddValue("models",
+                 "comma-separated list of the mobility models, without the MobilityModel suffix",
+                 models);
+    cmd.AddValue("buildings",
+                 "comma-separated list of the numbers of buildings, 0 for none",
+                 buildings);
+    cmd.AddValue("side", "side of the square area (m)", side);
+    cmd.AddValue("interval", "time between two queries of the position of all nodes", interval);
+    cmd.AddValue("simTime", "simulated time of each run", simTime);
+    cmd.AddValue("output", "file to write the JSON results to (default: stdout)", output);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> nodeCounts;
+    for (const auto& item : bench::SplitList(nodes))
+    {
+        const auto nNodes = std::stoul(item);
+        NS_ABORT_MSG_IF(nNodes == 0, "The number of nodes must be positive");
+        nodeCounts.push_back(nNodes);
+    }
+    // the peak RSS is a high-water mark, hence smaller runs must come first
+    std::sort(nodeCounts.begin(), nodeCounts.end());
+    NS_ABORT_MSG_IF(interval.IsZero(), "The query interval must be positive");
+
+    for (const auto nNodes : nodeCounts)
+    {
+        for (const auto& model : bench::SplitList(models))
+        {
+            for (const auto& item : bench::SplitList(buildings))
+            {
+                RngSeedManager::SetSeed(1);
+                RngSeedManager::SetRun(1);
+                BenchMobility(model, nNodes, std::stoul(item), side, interval, simTime);
+            }
+        }
+    }
+
+    bench::WriteJson(output);
+
+    return 0;
+}
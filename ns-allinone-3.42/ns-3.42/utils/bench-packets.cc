@@ -22,6 +22,7 @@
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
 
 #include "ns3/command-line.h"
+#include "ns3/llc-snap-header.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
@@ -32,6 +33,7 @@
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
+#include <type_traits>
 
 using namespace ns3;
 
@@ -147,6 +149,15 @@ BenchHeader<N>::Deserialize(Buffer::Iterator start)
     return N;
 }
 
+/// BenchHeader with a serialized size known at compile time
+template <int N>
+class FixedSizeBenchHeader final : public BenchHeader<N>
+{
+  public:
+    /// The serialized size of the header
+    static constexpr uint32_t SERIALIZED_SIZE = N;
+};
+
 /// BenchTag class used for benchmarking packet serialization/deserialization
 template <int N>
 class BenchTag : public Tag
@@ -350,6 +361,75 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchSmallFrames(uint32_t n)
+{
+    // A LoRa or 802.15.4 sized frame relayed over a few hops
+    BenchHeader<13> mac;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(20);
+        p->AddHeader(mac);
+        for (uint32_t hop = 0; hop < 3; hop++)
+        {
+            Ptr<Packet> o = p->Copy();
+            o->RemoveHeader(mac);
+            o->AddHeader(mac);
+            p = o;
+        }
+    }
+}
+
+/**
+ * Add and remove IPv4 and UDP sized headers, as benchA does.
+ *
+ * \tparam Ipv4 \explicit the type of the IPv4 sized header
+ * \tparam Udp \explicit the type of the UDP sized header
+ * \param n the number of packets
+ */
+template <typename Ipv4, typename Udp>
+static void
+benchHeaders(uint32_t n)
+{
+    Ipv4 ipv4;
+    Udp udp;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(2000);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        Ptr<Packet> o = p->Copy();
+        o->RemoveHeader(ipv4);
+        o->RemoveHeader(udp);
+    }
+}
+
+/**
+ * Add, peek and remove a LLC/SNAP header.
+ *
+ * \tparam Fixed \explicit whether the header is passed with its own type, which
+ *         selects the fixed size path, or as a Header
+ * \param n the number of packets
+ */
+template <bool Fixed>
+static void
+benchLlcSnap(uint32_t n)
+{
+    LlcSnapHeader llc;
+    llc.SetType(0x0800);
+    std::conditional_t<Fixed, LlcSnapHeader&, Header&> header = llc;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1500);
+        p->AddHeader(header);
+        p->PeekHeader(header);
+        p->RemoveHeader(header);
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -382,6 +462,7 @@ main(int argc, char* argv[])
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool enableLazyPrinting = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -390,6 +471,9 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("enable-lazy-printing",
+                 "enable packet printing from lazily built metadata",
+                 enableLazyPrinting);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -398,6 +482,15 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
+    if (enableLazyPrinting)
+    {
+        Packet::EnableLazyPrinting();
+    }
+    if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+
     std::cout << "Running bench-packets with n=" << n << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
@@ -407,6 +500,17 @@ main(int argc, char* argv[])
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
     runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchSmallFrames, n, minIterations, "Small frames copied over hops");
+    runBench(&benchHeaders<BenchHeader<20>, BenchHeader<8>>,
+             n,
+             minIterations,
+             "Copy packet, remove headers (virtual size)");
+    runBench(&benchHeaders<FixedSizeBenchHeader<20>, FixedSizeBenchHeader<8>>,
+             n,
+             minIterations,
+             "Copy packet, remove headers (fixed size)");
+    runBench(&benchLlcSnap<false>, n, minIterations, "LLC/SNAP header (virtual size)");
+    runBench(&benchLlcSnap<true>, n, minIterations, "LLC/SNAP header (fixed size)");
 
     return 0;
 }
@@ -390,26 +390,72 @@ BenchSuite::Log() const
 /**
  *  Create a RandomVariableStream to generate next event delays.
  *
- *  If the \p filename parameter is empty a default exponential time
- *  distribution will be used, with mean delay of 100 ns.
+ *  If the \p filename parameter is empty the delays are drawn from
+ *  the \p dist distribution, all with a mean delay of about 100 ns:
+ *
+ *  - `exp`:       exponential (the default),
+ *  - `uniform`:   uniform in [0, 200),
+ *  - `pareto`:    Pareto with shape 1.5, a heavy tail of far future events,
+ *  - `clustered`: 90% of the events clustered near the present
+ *                 (mean 10 ns), the rest far in the future (mean 910 ns).
  *
  *  If the \p filename is `-` standard input will be used.
  *
  *  \param [in] filename The delay interval source file name.
+ *  \param [in] dist The delay distribution, when no \p filename is given.
  *  \returns The RandomVariableStream.
  */
 Ptr<RandomVariableStream>
-GetRandomStream(std::string filename)
+GetRandomStream(std::string filename, std::string dist)
 {
     Ptr<RandomVariableStream> stream = nullptr;
 
-    if (filename.empty())
+    if (filename.empty() && (dist.empty() || dist == "exp"))
     {
         LOG("  Event time distribution:      default exponential");
         auto erv = CreateObject<ExponentialRandomVariable>();
         erv->SetAttribute("Mean", DoubleValue(100));
         stream = erv;
     }
+    else if (filename.empty() && dist == "uniform")
+    {
+        LOG("  Event time distribution:      uniform");
+        auto urv = CreateObject<UniformRandomVariable>();
+        urv->SetAttribute("Min", DoubleValue(0));
+        urv->SetAttribute("Max", DoubleValue(200));
+        stream = urv;
+    }
+    else if (filename.empty() && dist == "pareto")
+    {
+        LOG("  Event time distribution:      pareto");
+        auto prv = CreateObject<ParetoRandomVariable>();
+        prv->SetAttribute("Scale", DoubleValue(100.0 / 3));
+        prv->SetAttribute("Shape", DoubleValue(1.5));
+        stream = prv;
+    }
+    else if (filename.empty() && dist == "clustered")
+    {
+        LOG("  Event time distribution:      clustered");
+        auto choice = CreateObject<UniformRandomVariable>();
+        auto nearRv = CreateObject<ExponentialRandomVariable>();
+        nearRv->SetAttribute("Mean", DoubleValue(10));
+        auto farRv = CreateObject<ExponentialRandomVariable>();
+        farRv->SetAttribute("Mean", DoubleValue(910));
+        // Precompute the mixture, so drawing a delay costs the same
+        // as for the other distributions
+        std::vector<double> nsValues(1 << 20);
+        for (auto& value : nsValues)
+        {
+            value = (choice->GetValue() < 0.9) ? nearRv->GetValue() : farRv->GetValue();
+        }
+        auto drv = CreateObject<DeterministicRandomVariable>();
+        drv->SetValueArray(nsValues);
+        stream = drv;
+    }
+    else if (filename.empty())
+    {
+        NS_FATAL_ERROR("Unknown event time distribution: " << dist);
+    }
     else
     {
         std::istream* input;
@@ -457,6 +503,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -465,6 +512,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string dist = "exp";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -472,6 +520,8 @@ main(int argc, char* argv[])
               "\n"
               "Event intervals are taken from one of:\n"
               "  an exponential distribution, with mean 100 ns,\n"
+              "  another distribution with the same mean, chosen by the\n"
+              "    --dist=[exp|uniform|pareto|clustered] argument,\n"
               "  an ascii file, given by the --file=\"<filename>\" argument,\n"
               "  or standard input, by the argument --file=\"-\"\n"
               "In the case of either --file form, the input is expected\n"
@@ -482,6 +532,7 @@ main(int argc, char* argv[])
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -490,6 +541,7 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("dist", "event time distribution: exp, uniform, pareto or clustered", dist);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -505,15 +557,15 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    auto eventStream = GetRandomStream(filename, dist);
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -532,6 +584,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
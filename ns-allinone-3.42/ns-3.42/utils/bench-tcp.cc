@@ -0,0 +1,235 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark how the TCP stack scales with the number of flows.
+// For each congestion control variant and each number of flows, N bulk transfers share the
+// bottleneck of a dumbbell made of point-to-point links:
+//
+//   left hosts --- router 0 ===== router 1 --- right hosts
+//                        bottleneck
+//
+// Flows are spread over as many host pairs as needed to never run out of ephemeral ports.
+// Results are printed in JSON format, so that they can be compared across revisions to catch
+// performance regressions. Each run reports the wall clock time spent in Simulator::Run(),
+// the number of events executed, the wall clock cost per received packet and the peak
+// resident set size of the process. The latter is a process-wide high-water mark, hence the
+// flow counts are run in increasing order and the peak RSS of a run is only meaningful if it
+// is larger than the one of the previous run.
+// Sample usage:  ./ns3 run 'bench-tcp --flows=1,100,10000 --output=bench-tcp.json'
+
+#include "bench-harness.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/data-rate.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of packets received by the PacketSinks of the current run
+static uint64_t g_rxPackets = 0;
+/// Number of bytes received by the PacketSinks of the current run
+static uint64_t g_rxBytes = 0;
+
+/**
+ * Count the packets received by a PacketSink.
+ *
+ * \param packet the received packet
+ */
+static void
+SinkRx(Ptr<const Packet> packet, const Address& /* from */)
+{
+    ++g_rxPackets;
+    g_rxBytes += packet->GetSize();
+}
+
+/// Maximum number of flows originated by a single left host
+static const uint32_t FLOWS_PER_HOST = 10000;
+
+/**
+ * Measure the time it takes to simulate the given number of bulk transfers sharing the
+ * bottleneck of a dumbbell.
+ *
+ * \param variant the name of the TcpCongestionOps subclass, without the ns3:: prefix
+ * \param nFlows the number of flows
+ * \param bottleneck the data rate of the bottleneck link
+ * \param simTime the simulated time
+ */
+static void
+BenchDumbbell(const std::string& variant, uint32_t nFlows, DataRate bottleneck, Time simTime)
+{
+    const auto isBbr = (variant == "TcpBbr");
+    const auto isDctcp = (variant == "TcpDctcp");
+
+    // defaults are set for every run, as they would otherwise leak into the following runs.
+    // Socket buffers are left to their default size, so that memory usage stays bounded with
+    // a large number of flows.
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::" + variant));
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocketState::EnablePacing", BooleanValue(isBbr));
+    Config::SetDefault("ns3::TcpSocketBase::UseEcn", StringValue(isDctcp ? "On" : "Off"));
+    // DCTCP expects shallow CE marking at the bottleneck
+    Config::SetDefault("ns3::FqCoDelQueueDisc::UseEcn", BooleanValue(isDctcp));
+    Config::SetDefault("ns3::FqCoDelQueueDisc::CeThreshold",
+                       TimeValue(isDctcp ? MilliSeconds(1) : Time::Max()));
+
+    SystemWallClockMs setupTimer;
+    setupTimer.Start();
+
+    const uint32_t nHosts = (nFlows + FLOWS_PER_HOST - 1) / FLOWS_PER_HOST;
+    NodeContainer routers;
+    routers.Create(2);
+    NodeContainer leftHosts;
+    leftHosts.Create(nHosts);
+    NodeContainer rightHosts;
+    rightHosts.Create(nHosts);
+
+    InternetStackHelper internet;
+    internet.Install(routers);
+    internet.Install(leftHosts);
+    internet.Install(rightHosts);
+
+    PointToPointHelper bottleneckLink;
+    bottleneckLink.SetDeviceAttribute("DataRate", DataRateValue(bottleneck));
+    bottleneckLink.SetChannelAttribute("Delay", StringValue("10ms"));
+    PointToPointHelper accessLink;
+    accessLink.SetDeviceAttribute("DataRate",
+                                  DataRateValue(DataRate(10 * bottleneck.GetBitRate())));
+    accessLink.SetChannelAttribute("Delay", StringValue("1ms"));
+
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.252");
+    address.Assign(bottleneckLink.Install(routers));
+    std::vector<Ipv4Address> sinkAddresses;
+    for (uint32_t i = 0; i < nHosts; ++i)
+    {
+        address.NewNetwork();
+        address.Assign(accessLink.Install(leftHosts.Get(i), routers.Get(0)));
+        address.NewNetwork();
+        auto interfaces = address.Assign(accessLink.Install(rightHosts.Get(i), routers.Get(1)));
+        sinkAddresses.push_back(interfaces.GetAddress(0));
+    }
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    const uint16_t port = 5000;
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    auto sinks = sinkHelper.Install(rightHosts);
+    for (auto it = sinks.Begin(); it != sinks.End(); ++it)
+    {
+        (*it)->TraceConnectWithoutContext("Rx", MakeCallback(&SinkRx));
+    }
+
+    // flow starts are evenly spread over the first 100 ms, to avoid synchronized handshakes
+    for (uint32_t i = 0; i < nFlows; ++i)
+    {
+        const auto host = i / FLOWS_PER_HOST;
+        BulkSendHelper source("ns3::TcpSocketFactory",
+                              InetSocketAddress(sinkAddresses[host], port));
+        source.SetAttribute("MaxBytes", UintegerValue(0));
+        auto apps = source.Install(leftHosts.Get(host));
+        apps.Start(MicroSeconds(100000.0 * i / nFlows));
+    }
+    const auto setupMs = setupTimer.End();
+
+    g_rxPackets = 0;
+    g_rxBytes = 0;
+    Simulator::Stop(simTime);
+    const auto eventsBefore = Simulator::GetEventCount();
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    const auto wallMs = timer.End();
+
+    const auto events = Simulator::GetEventCount() - eventsBefore;
+    const auto usPerPacket = g_rxPackets > 0 ? 1000.0 * wallMs / g_rxPackets : 0;
+    bench::Record({"dumbbell-" + variant,
+            {{"flows", nFlows},
+             {"bottleneck_mbps", bottleneck.GetBitRate() / 1e6},
+             {"sim_s", simTime.GetSeconds()}},
+            wallMs,
+            events,
+            {{"setup_ms", static_cast<double>(setupMs)},
+             {"rx_packets", static_cast<double>(g_rxPackets)},
+             {"goodput_mbps", g_rxBytes * 8.0 / simTime.GetSeconds() / 1e6},
+             {"us_per_packet", usPerPacket},
+             {"events_per_packet",
+              g_rxPackets > 0 ? static_cast<double>(events) / g_rxPackets : 0},
+             {"peak_rss_mb", bench::GetPeakRssMb()}}});
+    Simulator::Destroy();
+    Ipv4AddressGenerator::Reset();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string flows = "1,10,100,1000";
+    std::string variants = "TcpNewReno,TcpCubic,TcpBbr,TcpDctcp";
+    DataRate bottleneck("1Gbps");
+    Time simTime = Seconds(2);
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("flows", "comma-separated list of the numbers of flows", flows);
+    cmd.AddValue("variants",
+                 "comma-separated list of the congestion control variants",
+                 variants);
+    cmd.AddValue("bottleneck", "data rate of the bottleneck link", bottleneck);
+    cmd.AddValue("simTime", "simulated time of each run", simTime);
+    cmd.AddValue("output", "file to write the JSON results to (default: stdout)", output);
+    cmd.Parse(argc, argv);
+
+    std::vector<uint32_t> flowCounts;
+    for (const auto& item : bench::SplitList(flows))
+    {
+        const auto nFlows = std::stoul(item);
+        NS_ABORT_MSG_IF(nFlows == 0, "The number of flows must be positive");
+        flowCounts.push_back(nFlows);
+    }
+    // the peak RSS is a high-water mark, hence smaller runs must come first
+    std::sort(flowCounts.begin(), flowCounts.end());
+
+    for (const auto nFlows : flowCounts)
+    {
+        for (const auto& variant : bench::SplitList(variants))
+        {
+            RngSeedManager::SetSeed(1);
+            RngSeedManager::SetRun(1);
+            BenchDumbbell(variant, nFlows, bottleneck, simTime);
+        }
+    }
+
+    bench::WriteJson(output);
+
+    return 0;
+}
@@ -0,0 +1,485 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the Wi-Fi hot paths: interference
+// tracking, A-MPDU and A-MSDU construction, MAC queue operations, rate
+// manager updates and the saturation throughput of a single BSS.
+// Results are printed in JSON format, so that they can be compared across
+// revisions to catch performance regressions. All the benchmarks use fixed
+// inputs and a fixed RNG seed, hence the simulated work is reproducible and
+// only the wall clock time is expected to vary across runs.
+// Sample usage:  ./ns3 run 'bench-wifi --rounds=200 --output=bench-wifi.json'
+
+#include "bench-harness.h"
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/interference-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/ofdm-phy.h"
+#include "ns3/ofdm-ppdu.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-mac.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-utils.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Create a QoS Data frame header for TID 0 sent by the given transmitter to the given receiver
+ * from the DS.
+ *
+ * \param receiver the receiver address
+ * \param transmitter the transmitter address
+ * \param seqNo the sequence number
+ * \return the MAC header
+ */
+static WifiMacHeader
+MakeQosDataHeader(Mac48Address receiver, Mac48Address transmitter, uint16_t seqNo)
+{
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    hdr.SetAddr1(receiver);
+    hdr.SetAddr2(transmitter);
+    hdr.SetAddr3(transmitter);
+    hdr.SetDsFrom();
+    hdr.SetDsNotTo();
+    hdr.SetSequenceNumber(seqNo);
+    return hdr;
+}
+
+/**
+ * Add the given number of overlapping signals to an InterferenceHelper and compute the SNR
+ * of each of them.
+ *
+ * \param nSignals the number of overlapping signals
+ * \param rounds the number of times the benchmark is repeated
+ */
+static void
+BenchInterference(uint32_t nSignals, uint32_t rounds)
+{
+    WifiPhyOperatingChannel channel;
+    channel.Set(36, 0, 20, WIFI_STANDARD_80211a, WIFI_PHY_BAND_5GHZ);
+    const WifiTxVector txVector(OfdmPhy::GetOfdmRate6Mbps(),
+                                0,
+                                WIFI_PREAMBLE_LONG,
+                                800,
+                                1,
+                                1,
+                                0,
+                                20,
+                                false);
+    const WifiSpectrumBandInfo band{{0, 0}, {5170e6, 5190e6}};
+
+    std::vector<Ptr<const WifiPpdu>> ppdus;
+    for (uint32_t i = 0; i < nSignals; ++i)
+    {
+        auto hdr = MakeQosDataHeader(Mac48Address::GetBroadcast(), Mac48Address(), i);
+        auto psdu = Create<WifiPsdu>(Create<Packet>(1000), hdr);
+        ppdus.push_back(Create<OfdmPpdu>(psdu, txVector, channel, i));
+    }
+
+    double snrSum = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        auto interference = CreateObject<InterferenceHelper>();
+        interference->SetNoiseFigure(DbToRatio(7));
+        interference->SetErrorRateModel(CreateObject<NistErrorRateModel>());
+        interference->AddBand(band);
+        std::vector<Ptr<Event>> events;
+        for (uint32_t i = 0; i < nSignals; ++i)
+        {
+            // signals start at the same time and end at distinct times
+            RxPowerWattPerChannelBand rxPower{{band, DbmToW(-60.0 - i % 20)}};
+            events.push_back(interference->Add(ppdus[i],
+                                               MicroSeconds(100 + 7 * i),
+                                               rxPower,
+                                               WIFI_SPECTRUM_5_GHZ));
+        }
+        for (const auto& event : events)
+        {
+            snrSum += interference->CalculateSnr(event, 20, 1, band);
+        }
+        interference->Dispose();
+    }
+    const auto wallMs = timer.End();
+
+    bench::Record({"interference-helper",
+            {{"signals", nSignals}, {"rounds", rounds}},
+            wallMs,
+            static_cast<uint64_t>(nSignals) * rounds,
+            {{"mean_snr_db", RatioToDb(snrSum / nSignals / rounds)}}});
+}
+
+/**
+ * Build A-MPDUs out of the given number of MPDUs.
+ *
+ * \param nMpdus the number of MPDUs per A-MPDU
+ * \param rounds the number of A-MPDUs to build
+ */
+static void
+BenchAmpdu(uint32_t nMpdus, uint32_t rounds)
+{
+    const auto receiver = Mac48Address("00:00:00:00:00:01");
+    const auto transmitter = Mac48Address("00:00:00:00:00:02");
+    uint64_t ampduBytes = 0;
+
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        std::vector<Ptr<WifiMpdu>> mpdus;
+        mpdus.reserve(nMpdus);
+        for (uint32_t i = 0; i < nMpdus; ++i)
+        {
+            mpdus.push_back(Create<WifiMpdu>(Create<Packet>(1500),
+                                             MakeQosDataHeader(receiver, transmitter, i)));
+        }
+        ampduBytes += Create<WifiPsdu>(std::move(mpdus))->GetPacket()->GetSize();
+    }
+    const auto wallMs = timer.End();
+
+    bench::Record({"ampdu-construction",
+            {{"mpdus", nMpdus}, {"rounds", rounds}},
+            wallMs,
+            static_cast<uint64_t>(nMpdus) * rounds,
+            {{"ampdu_bytes", static_cast<double>(ampduBytes / rounds)}}});
+}
+
+/**
+ * Build A-MSDUs out of the given number of MSDUs.
+ *
+ * \param nMsdus the number of MSDUs per A-MSDU
+ * \param rounds the number of A-MSDUs to build
+ */
+static void
+BenchAmsdu(uint32_t nMsdus, uint32_t rounds)
+{
+    const auto receiver = Mac48Address("00:00:00:00:00:01");
+    const auto transmitter = Mac48Address("00:00:00:00:00:02");
+    const auto hdr = MakeQosDataHeader(receiver, transmitter, 0);
+    uint64_t amsduBytes = 0;
+
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        auto amsdu = Create<WifiMpdu>(Create<Packet>(1500), hdr);
+        for (uint32_t i = 1; i < nMsdus; ++i)
+        {
+            amsdu->Aggregate(Create<WifiMpdu>(Create<Packet>(1500), hdr));
+        }
+        amsduBytes += amsdu->GetSize();
+    }
+    const auto wallMs = timer.End();
+
+    bench::Record({"amsdu-construction",
+            {{"msdus", nMsdus}, {"rounds", rounds}},
+            wallMs,
+            static_cast<uint64_t>(nMsdus) * rounds,
+            {{"amsdu_bytes", static_cast<double>(amsduBytes / rounds)}}});
+}
+
+/**
+ * Create an AP and a STA associated with it. Node 0 is the AP and node 1 is the STA.
+ *
+ * \param manager the name of the rate manager used by both devices
+ * \param nodes the nodes to install the devices on
+ * \return the AP and STA devices
+ */
+static NetDeviceContainer
+SetupBss(const std::string& manager, NodeContainer& nodes)
+{
+    nodes.Create(2);
+
+    auto channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{36, 20, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager(manager);
+
+    WifiMacHelper mac;
+    Ssid ssid("bench");
+    NetDeviceContainer devices;
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    devices.Add(wifi.Install(phy, mac, nodes.Get(0)));
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    devices.Add(wifi.Install(phy, mac, nodes.Get(1)));
+
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(5.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    return devices;
+}
+
+/**
+ * Enqueue MPDUs addressed to the given number of receivers in the BE queue of the given MAC
+ * and then remove them in the order selected by the MAC queue scheduler.
+ *
+ * \param mac the MAC owning the queue
+ * \param nPackets the number of MPDUs to enqueue per round
+ * \param nReceivers the number of receivers
+ * \param rounds the number of times the benchmark is repeated
+ */
+static void
+BenchMacQueue(Ptr<WifiMac> mac, uint32_t nPackets, uint32_t nReceivers, uint32_t rounds)
+{
+    auto queue = mac->GetTxopQueue(AC_BE);
+    queue->SetMaxSize(QueueSize(QueueSizeUnit::PACKETS, nPackets));
+
+    std::vector<Mac48Address> receivers;
+    for (uint32_t i = 0; i < nReceivers; ++i)
+    {
+        receivers.push_back(Mac48Address::Allocate());
+    }
+
+    uint64_t removed = 0;
+    SystemWallClockMs timer;
+    timer.Start();
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        for (uint32_t i = 0; i < nPackets; ++i)
+        {
+            queue->Enqueue(Create<WifiMpdu>(
+                Create<Packet>(1000),
+                MakeQosDataHeader(receivers[i % nReceivers], mac->GetAddress(), i / nReceivers)));
+        }
+        while (!queue->IsEmpty())
+        {
+            queue->Remove(queue->Peek());
+            ++removed;
+        }
+    }
+    const auto wallMs = timer.End();
+
+    bench::Record({"mac-queue",
+            {{"packets", nPackets}, {"receivers", nReceivers}, {"rounds", rounds}},
+            wallMs,
+            2 * removed,
+            {}});
+}
+
+/**
+ * Request a TXVECTOR to the given rate manager and report the transmission status of an
+ * A-MPDU sent with that TXVECTOR.
+ *
+ * \param manager the rate manager
+ * \param receiver the receiver of the A-MPDU
+ * \param transmitter the transmitter of the A-MPDU
+ * \param index the index of the update
+ */
+static void
+RateManagerUpdate(Ptr<WifiRemoteStationManager> manager,
+                  Mac48Address receiver,
+                  Mac48Address transmitter,
+                  uint32_t index)
+{
+    const auto hdr = MakeQosDataHeader(receiver, transmitter, index % 4096);
+    const auto txVector = manager->GetDataTxVector(hdr, 20);
+    // deterministic pattern of failures, heavier every few updates
+    const uint16_t nFailed = (index % 16 < 3) ? 12 : index % 4;
+    manager->ReportAmpduTxStatus(receiver, 32 - nFailed, nFailed, 300.0, 300.0, txVector);
+}
+
+/**
+ * Feed the rate manager of the AP with A-MPDU transmission reports for the associated STA.
+ * Consecutive updates are spaced by 1 ms of simulated time, so that the periodic updates of
+ * the statistics maintained by rate managers are exercised too.
+ *
+ * \param ap the AP device
+ * \param sta the STA device
+ * \param nUpdates the number of updates
+ */
+static void
+BenchRateManager(Ptr<WifiNetDevice> ap, Ptr<WifiNetDevice> sta, uint32_t nUpdates)
+{
+    auto manager = ap->GetRemoteStationManager();
+    const auto staAddress = sta->GetMac()->GetAddress();
+    const auto start = Simulator::Now();
+    for (uint32_t i = 0; i < nUpdates; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i),
+                            &RateManagerUpdate,
+                            manager,
+                            staAddress,
+                            ap->GetMac()->GetAddress(),
+                            i);
+    }
+    Simulator::Stop(MilliSeconds(nUpdates));
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    const auto wallMs = timer.End();
+
+    bench::Record({"rate-manager-" + manager->GetInstanceTypeId().GetName().substr(5),
+            {{"updates", nUpdates}},
+            wallMs,
+            nUpdates,
+            {{"sim_s", (Simulator::Now() - start).GetSeconds()}}});
+}
+
+/// Number of bytes received by the PacketSocketServer of the saturation benchmark
+static uint64_t g_rxBytes = 0;
+
+/**
+ * Count the bytes received by the PacketSocketServer.
+ *
+ * \param packet the received packet
+ */
+static void
+SaturationRx(Ptr<const Packet> packet, const Address& /* from */)
+{
+    g_rxBytes += packet->GetSize();
+}
+
+/**
+ * Measure the time it takes to simulate a saturated downlink flow in a single BSS.
+ *
+ * \param manager the name of the rate manager used by both devices
+ * \param simTime the simulated time
+ */
+static void
+BenchSaturation(const std::string& manager, Time simTime)
+{
+    NodeContainer nodes;
+    auto devices = SetupBss(manager, nodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(nodes);
+
+    PacketSocketAddress socketAddr;
+    socketAddr.SetSingleDevice(devices.Get(0)->GetIfIndex());
+    socketAddr.SetPhysicalAddress(devices.Get(1)->GetAddress());
+    socketAddr.SetProtocol(1);
+
+    auto client = CreateObject<PacketSocketClient>();
+    client->SetRemote(socketAddr);
+    client->SetAttribute("PacketSize", UintegerValue(1500));
+    client->SetAttribute("MaxPackets", UintegerValue(0));
+    client->SetAttribute("Interval", TimeValue(MicroSeconds(10)));
+    client->SetStartTime(Seconds(0.5));
+    nodes.Get(0)->AddApplication(client);
+
+    auto server = CreateObject<PacketSocketServer>();
+    server->SetLocal(socketAddr);
+    server->TraceConnectWithoutContext("Rx", MakeCallback(&SaturationRx));
+    nodes.Get(1)->AddApplication(server);
+
+    g_rxBytes = 0;
+    const auto stopTime = Seconds(0.5) + simTime;
+    Simulator::Stop(stopTime);
+    const auto eventsBefore = Simulator::GetEventCount();
+
+    SystemWallClockMs timer;
+    timer.Start();
+    Simulator::Run();
+    const auto wallMs = timer.End();
+
+    const auto events = Simulator::GetEventCount() - eventsBefore;
+    bench::Record({"saturation-single-bss",
+            {{"sim_s", simTime.GetSeconds()}},
+            wallMs,
+            events,
+            {{"throughput_mbps", g_rxBytes * 8.0 / simTime.GetSeconds() / 1e6},
+             {"events", static_cast<double>(events)}}});
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t rounds = 100;
+    uint32_t signals = 64;
+    uint32_t mpdus = 64;
+    uint32_t msdus = 4;
+    uint32_t packets = 4096;
+    uint32_t receivers = 16;
+    uint32_t updates = 20000;
+    Time simTime = Seconds(2);
+    std::string manager = "ns3::MinstrelHtWifiManager";
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("rounds", "number of rounds of the micro-benchmarks", rounds);
+    cmd.AddValue("signals", "number of overlapping signals in the InterferenceHelper", signals);
+    cmd.AddValue("mpdus", "number of MPDUs per A-MPDU", mpdus);
+    cmd.AddValue("msdus", "number of MSDUs per A-MSDU", msdus);
+    cmd.AddValue("packets", "number of MPDUs enqueued in the MAC queue per round", packets);
+    cmd.AddValue("receivers",
+                 "number of receivers of the MPDUs enqueued in the MAC queue",
+                 receivers);
+    cmd.AddValue("updates", "number of rate manager updates", updates);
+    cmd.AddValue("simTime", "simulated time of the saturation benchmark", simTime);
+    cmd.AddValue("manager", "rate manager used by the BSS benchmarks", manager);
+    cmd.AddValue("output", "file to write the JSON results to (default: stdout)", output);
+    cmd.Parse(argc, argv);
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    BenchInterference(signals, rounds);
+    BenchAmpdu(mpdus, rounds);
+    BenchAmsdu(msdus, rounds);
+
+    // let the STA associate before exercising the MAC queue and the rate manager of the AP
+    {
+        NodeContainer nodes;
+        auto devices = SetupBss(manager, nodes);
+        auto ap = DynamicCast<WifiNetDevice>(devices.Get(0));
+        auto sta = DynamicCast<WifiNetDevice>(devices.Get(1));
+        Simulator::Stop(Seconds(0.5));
+        Simulator::Run();
+        NS_ABORT_MSG_IF(!ap->GetRemoteStationManager()->IsAssociated(sta->GetMac()->GetAddress()),
+                        "The STA did not associate with the AP");
+        BenchMacQueue(ap->GetMac(), packets, receivers, rounds);
+        BenchRateManager(ap, sta, updates);
+        Simulator::Destroy();
+    }
+
+    BenchSaturation(manager, simTime);
+
+    bench::WriteJson(output);
+
+    return 0;
+}
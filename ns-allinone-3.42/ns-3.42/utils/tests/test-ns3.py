@@ -22,6 +22,7 @@ Test suite for the ns3 wrapper script
 """
 
 import glob
+import json
 import os
 import re
 import shutil
@@ -3175,6 +3176,62 @@ class NS3ExpectedUseTestCase(NS3BaseTestCase):
             shutil.rmtree(destination_src)
 
 
+    def test_19_ParameterSweep(self):
+        """!
+        Test if parameter sweeps run every point once and resume after an interruption
+        @return None
+        """
+        sweep_dir = os.path.join(ns3_path, "build", "test-sweep")
+        if os.path.exists(sweep_dir):
+            shutil.rmtree(sweep_dir)
+        os.makedirs(sweep_dir)
+        grid_file = os.path.join(sweep_dir, "grid.json")
+        with open(grid_file, "w", encoding="utf-8") as f:
+            json.dump(
+                {
+                    "output_directory": os.path.relpath(sweep_dir, ns3_path),
+                    "repetitions": 2,
+                    "studies": [
+                        {
+                            "name": "sample",
+                            "program": "sample-simulator",
+                            "grid": {"RngSeed": [1, 2]},
+                        }
+                    ],
+                },
+                f,
+            )
+        results_file = os.path.join(sweep_dir, "results.jsonl")
+
+        # Dry-runs list the commands without running them
+        return_code, stdout, stderr = run_ns3("sweep %s --dry-run" % grid_file)
+        self.assertEqual(return_code, 0)
+        self.assertEqual(stdout.count("sample-simulator"), 4)
+        self.assertIn("--RngRun=", stdout)
+        self.assertFalse(os.path.exists(results_file))
+
+        return_code, stdout, stderr = run_ns3("sweep %s -j2" % grid_file)
+        self.assertEqual(return_code, 0)
+        with open(results_file, "r", encoding="utf-8") as f:
+            records = [json.loads(line) for line in f]
+        self.assertEqual(len(records), 4)
+        self.assertTrue(all(record["status"] == "ok" for record in records))
+        # Every point has its own RngRun value and working directory
+        self.assertEqual(len(set(record["rng_run"] for record in records)), 4)
+        self.assertEqual(len(set(record["run_directory"] for record in records)), 4)
+
+        # Drop one record to simulate an interrupted sweep, then resume it
+        with open(results_file, "w", encoding="utf-8") as f:
+            for record in records[:-1]:
+                f.write(json.dumps(record) + "\n")
+            f.write('{"key": "trunc')
+        return_code, stdout, stderr = run_ns3("sweep %s --no-build" % grid_file)
+        self.assertEqual(return_code, 0)
+        self.assertIn("3 already finished, 1 to run", stdout)
+
+        shutil.rmtree(sweep_dir)
+
+
 class NS3QualityControlTestCase(unittest.TestCase):
     """!
     ns-3 tests to control the quality of the repository over time,